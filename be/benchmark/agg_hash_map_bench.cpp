@@ -0,0 +1,85 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "bench_util.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::vectorized {
+
+// The group by keys of the rows, see bench_util.h.
+static Columns int32_keys(const std::vector<uint32_t>& rows) {
+    return {bench::int32_column(rows, true)};
+}
+
+static Columns int64_keys(const std::vector<uint32_t>& rows) {
+    return {bench::int64_column(rows)};
+}
+
+// 1/16 of the rows are null
+static Columns nullable_int32_keys(const std::vector<uint32_t>& rows) {
+    return {bench::nullable_column(bench::int32_column(rows, true), 16)};
+}
+
+static Columns string_keys(const std::vector<uint32_t>& rows) {
+    return {bench::varchar_column(rows)};
+}
+
+static Columns nullable_string_keys(const std::vector<uint32_t>& rows) {
+    return {bench::nullable_column(bench::varchar_column(rows), 16)};
+}
+
+// two int keys packed into 8 bytes
+static Columns two_int32_keys(const std::vector<uint32_t>& rows) {
+    return {bench::int32_column(rows, true), bench::int32_column(rows)};
+}
+
+static Columns int32_string_keys(const std::vector<uint32_t>& rows) {
+    return {bench::int32_column(rows, true), bench::varchar_column(rows)};
+}
+
+static constexpr int kNumChunks = 16;
+
+// Args: the number of the groups, each iteration aggregates kNumChunks chunks into an empty hash map.
+template <typename HashMapWithKey, Columns (*make_keys)(const std::vector<uint32_t>&)>
+static void BM_AggHashMapComputeAggStates(benchmark::State& state) {
+    uint32_t num_groups = state.range(0);
+    size_t chunk_size = config::vector_chunk_size;
+    std::vector<Columns> chunks;
+    for (int i = 0; i < kNumChunks; i++) {
+        chunks.emplace_back(make_keys(bench::random_rows(chunk_size, num_groups, i)));
+    }
+    MemTracker tracker;
+    Buffer<AggDataPtr> agg_states(chunk_size);
+    for (auto _ : state) {
+        MemPool pool(&tracker);
+        HashMapWithKey hash_map_with_key;
+        for (const auto& key_columns : chunks) {
+            hash_map_with_key.compute_agg_states(
+                    chunk_size, key_columns, &pool, [&pool]() { return pool.allocate(16); }, &agg_states);
+        }
+        benchmark::DoNotOptimize(hash_map_with_key.hash_map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumChunks * chunk_size);
+}
+
+#define AGG_BENCHMARK(HASH_MAP, MAKE_KEYS) \
+    BENCHMARK_TEMPLATE(BM_AggHashMapComputeAggStates, HASH_MAP, MAKE_KEYS)->RangeMultiplier(32)->Range(16, 1 << 20);
+
+AGG_BENCHMARK(Int32AggHashMapWithOneNumberKey<PhmapSeed1>, int32_keys)
+AGG_BENCHMARK(Int64AggHashMapWithOneNumberKey<PhmapSeed1>, int64_keys)
+AGG_BENCHMARK(NullInt32AggHashMapWithOneNumberKey<PhmapSeed1>, nullable_int32_keys)
+AGG_BENCHMARK(Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>, int32_keys)
+AGG_BENCHMARK(OneStringAggHashMap<PhmapSeed1>, string_keys)
+AGG_BENCHMARK(NullOneStringAggHashMap<PhmapSeed1>, nullable_string_keys)
+AGG_BENCHMARK(SerializedKeyFixedSize8AggHashMap<PhmapSeed1>, two_int32_keys)
+AGG_BENCHMARK(SerializedKeyAggHashMap<PhmapSeed1>, int32_string_keys)
+AGG_BENCHMARK(SerializedKeyTwoLevelAggHashMap<PhmapSeed1>, int32_string_keys)
+
+#undef AGG_BENCHMARK
+
+} // namespace starrocks::vectorized
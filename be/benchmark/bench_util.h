@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
+namespace starrocks::vectorized::bench {
+
+// The data of the benchmarks is generated with fixed seeds, so the runs of different versions compare the kernels
+// on the same data.
+
+// |count| row numbers in [0, |cardinality|), the columns below map a row number to a distinct value.
+inline std::vector<uint32_t> random_rows(size_t count, uint32_t cardinality, uint32_t seed = 0) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> dist(0, cardinality - 1);
+    std::vector<uint32_t> rows(count);
+    for (auto& row : rows) {
+        row = dist(rng);
+    }
+    return rows;
+}
+
+inline std::vector<uint32_t> sequence_rows(uint32_t from, uint32_t count) {
+    std::vector<uint32_t> rows(count);
+    for (uint32_t i = 0; i < count; i++) {
+        rows[i] = from + i;
+    }
+    return rows;
+}
+
+// The values of the row numbers, or the row numbers scattered over the whole int32 range if |sparse|.
+inline ColumnPtr int32_column(const std::vector<uint32_t>& rows, bool sparse = false) {
+    auto column = Int32Column::create();
+    column->reserve(rows.size());
+    for (uint32_t row : rows) {
+        // the multiplier is odd, so the scattered values are still distinct
+        column->append(static_cast<int32_t>(sparse ? row * 2654435761U : row));
+    }
+    return column;
+}
+
+inline ColumnPtr int64_column(const std::vector<uint32_t>& rows, int64_t multiplier = 1000003) {
+    auto column = Int64Column::create();
+    column->reserve(rows.size());
+    for (uint32_t row : rows) {
+        column->append(static_cast<int64_t>(row) * multiplier);
+    }
+    return column;
+}
+
+inline ColumnPtr varchar_column(const std::vector<uint32_t>& rows, const std::string& prefix = "starrocks_") {
+    auto column = BinaryColumn::create();
+    column->reserve(rows.size());
+    for (uint32_t row : rows) {
+        column->append_string(prefix + std::to_string(row));
+    }
+    return column;
+}
+
+// Wraps |data| into a nullable column whose every |null_interval|-th row is null, no row is null if it's 0.
+inline ColumnPtr nullable_column(const ColumnPtr& data, size_t null_interval) {
+    auto nulls = NullColumn::create(data->size(), 0);
+    if (null_interval > 0) {
+        for (size_t i = 0; i < data->size(); i += null_interval) {
+            nulls->get_data()[i] = 1;
+        }
+    }
+    return NullableColumn::create(data, nulls);
+}
+
+} // namespace starrocks::vectorized::bench
@@ -0,0 +1,96 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "bench_util.h"
+#include "gen_cpp/data.pb.h"
+#include "runtime/types.h"
+
+namespace starrocks::vectorized {
+
+// A chunk of the columns of the common types, the slot 0 is an int column, the slot 1 is a bigint column, the slot
+// 2 is a varchar column and the slot 3 is a nullable int column.
+static ChunkPtr create_chunk(RuntimeChunkMeta* meta) {
+    auto rows = bench::random_rows(config::vector_chunk_size, config::vector_chunk_size);
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(bench::int32_column(rows, true), 0);
+    chunk->append_column(bench::int64_column(rows), 1);
+    chunk->append_column(bench::varchar_column(rows), 2);
+    chunk->append_column(bench::nullable_column(bench::int32_column(rows, true), 16), 3);
+
+    meta->types = {TypeDescriptor(TYPE_INT), TypeDescriptor(TYPE_BIGINT),
+                   TypeDescriptor::create_varchar_type(TypeDescriptor::MAX_VARCHAR_LENGTH), TypeDescriptor(TYPE_INT)};
+    meta->is_nulls = {false, false, false, true};
+    meta->is_consts.assign(chunk->num_columns(), false);
+    meta->slot_id_to_index.init(chunk->num_columns());
+    for (const auto& kv : chunk->get_slot_id_to_index_map()) {
+        meta->slot_id_to_index.insert(kv.first, kv.second);
+    }
+    meta->tuple_id_to_index.init(1);
+    return chunk;
+}
+
+static void BM_ChunkSerializeWithMeta(benchmark::State& state) {
+    RuntimeChunkMeta meta;
+    ChunkPtr chunk = create_chunk(&meta);
+    ChunkPB pb;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        bytes += chunk->serialize_with_meta(&pb);
+        benchmark::DoNotOptimize(pb.data().data());
+    }
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.iterations() * chunk->num_rows());
+}
+BENCHMARK(BM_ChunkSerializeWithMeta);
+
+// The chunk data in the version of the argument.
+static void BM_ChunkSerialize(benchmark::State& state) {
+    RuntimeChunkMeta meta;
+    ChunkPtr chunk = create_chunk(&meta);
+    std::string buffer;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        bytes += chunk->serialize(&buffer, state.range(0));
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.iterations() * chunk->num_rows());
+    state.counters["size"] = buffer.size();
+}
+BENCHMARK(BM_ChunkSerialize)->Arg(Chunk::kSerdeVersion1)->Arg(Chunk::kSerdeVersion2);
+
+// The ChunkPB serialized into the request of the rpc.
+static void BM_ChunkPBSerializeToString(benchmark::State& state) {
+    RuntimeChunkMeta meta;
+    ChunkPtr chunk = create_chunk(&meta);
+    ChunkPB pb;
+    chunk->serialize_with_meta(&pb);
+    std::string buffer;
+    for (auto _ : state) {
+        pb.SerializeToString(&buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_ChunkPBSerializeToString);
+
+static void BM_ChunkDeserialize(benchmark::State& state) {
+    RuntimeChunkMeta meta;
+    ChunkPtr chunk = create_chunk(&meta);
+    std::string buffer;
+    chunk->serialize(&buffer, state.range(0));
+    const auto* data = reinterpret_cast<const uint8_t*>(buffer.data());
+    for (auto _ : state) {
+        Chunk dst;
+        CHECK(dst.deserialize(data, buffer.size(), meta).ok());
+        benchmark::DoNotOptimize(dst.num_rows());
+    }
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+    state.SetItemsProcessed(state.iterations() * chunk->num_rows());
+}
+BENCHMARK(BM_ChunkDeserialize)->Arg(Chunk::kSerdeVersion1)->Arg(Chunk::kSerdeVersion2);
+
+} // namespace starrocks::vectorized
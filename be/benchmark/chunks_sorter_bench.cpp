@@ -0,0 +1,136 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "bench_util.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_topn.h"
+#include "exprs/expr_context.h"
+#include "exprs/slot_ref.h"
+
+namespace starrocks::vectorized {
+
+// The order by columns of the cases.
+enum class SortKeys {
+    // the int column
+    int32,
+    // the nullable varchar column
+    varchar,
+    // the int column then the nullable varchar column
+    int32_varchar
+};
+
+// The chunks of the random rows, the slot 0 is an int column and the slot 1 is a nullable varchar column.
+class ChunksSorterBench {
+public:
+    ChunksSorterBench(SortKeys keys, size_t num_rows)
+            : _int32_ref(TypeDescriptor(TYPE_INT), 0, 0), _varchar_ref(TypeDescriptor(TYPE_VARCHAR), 0, 1) {
+        if (keys != SortKeys::varchar) {
+            _sort_exprs.emplace_back(std::make_unique<ExprContext>(&_int32_ref));
+        }
+        if (keys != SortKeys::int32) {
+            _sort_exprs.emplace_back(std::make_unique<ExprContext>(&_varchar_ref));
+        }
+        for (const auto& ctx : _sort_exprs) {
+            _sort_expr_ptrs.emplace_back(ctx.get());
+        }
+        _is_asc.assign(_sort_exprs.size(), true);
+        _is_null_first.assign(_sort_exprs.size(), true);
+
+        size_t chunk_size = config::vector_chunk_size;
+        for (size_t from = 0, seed = 0; from < num_rows; from += chunk_size, seed++) {
+            size_t count = std::min(chunk_size, num_rows - from);
+            auto rows = bench::random_rows(count, num_rows * 16, seed);
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(bench::int32_column(rows, true), 0);
+            chunk->append_column(bench::nullable_column(bench::varchar_column(rows), 16), 1);
+            _chunks.emplace_back(std::move(chunk));
+        }
+    }
+
+    // The sorters keep or modify the chunks updated, so each run sorts the copies of them.
+    std::vector<ChunkPtr> copy_chunks() const {
+        std::vector<ChunkPtr> chunks;
+        for (const auto& chunk : _chunks) {
+            ChunkPtr copy = chunk->clone_empty(chunk->num_rows());
+            copy->append(*chunk);
+            chunks.emplace_back(std::move(copy));
+        }
+        return chunks;
+    }
+
+    // Sorts the chunks and returns the rows output.
+    size_t sort(ChunksSorter* sorter, const std::vector<ChunkPtr>& chunks) const {
+        for (const auto& chunk : chunks) {
+            CHECK(sorter->update(nullptr, chunk).ok());
+        }
+        CHECK(sorter->done(nullptr).ok());
+        size_t num_rows = 0;
+        bool eos = false;
+        while (!eos) {
+            ChunkPtr chunk;
+            CHECK(sorter->get_next(&chunk, &eos).ok());
+            if (chunk != nullptr) {
+                num_rows += chunk->num_rows();
+            }
+        }
+        return num_rows;
+    }
+
+    const std::vector<ExprContext*>* sort_exprs() const { return &_sort_expr_ptrs; }
+    const std::vector<bool>* is_asc() const { return &_is_asc; }
+    const std::vector<bool>* is_null_first() const { return &_is_null_first; }
+
+private:
+    SlotRef _int32_ref;
+    SlotRef _varchar_ref;
+    std::vector<std::unique_ptr<ExprContext>> _sort_exprs;
+    std::vector<ExprContext*> _sort_expr_ptrs;
+    std::vector<bool> _is_asc;
+    std::vector<bool> _is_null_first;
+    std::vector<ChunkPtr> _chunks;
+};
+
+// Args: the rows to sort.
+static void BM_ChunksSorterFullSort(benchmark::State& state, SortKeys keys) {
+    ChunksSorterBench sorter_bench(keys, state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto chunks = sorter_bench.copy_chunks();
+        ChunksSorterFullSort sorter(sorter_bench.sort_exprs(), sorter_bench.is_asc(), sorter_bench.is_null_first(),
+                                    config::vector_chunk_size);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(sorter_bench.sort(&sorter, chunks));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Args: the rows to sort, the limit.
+static void BM_ChunksSorterTopn(benchmark::State& state, SortKeys keys) {
+    ChunksSorterBench sorter_bench(keys, state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto chunks = sorter_bench.copy_chunks();
+        ChunksSorterTopn sorter(sorter_bench.sort_exprs(), sorter_bench.is_asc(), sorter_bench.is_null_first(), 0,
+                                state.range(1));
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(sorter_bench.sort(&sorter, chunks));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define SORTER_BENCHMARK(KEYS)                                                                        \
+    BENCHMARK_CAPTURE(BM_ChunksSorterFullSort, KEYS, SortKeys::KEYS)->Range(1 << 12, 1 << 20);        \
+    BENCHMARK_CAPTURE(BM_ChunksSorterTopn, KEYS, SortKeys::KEYS)->Ranges({{1 << 12, 1 << 20}, {10, 10000}});
+
+SORTER_BENCHMARK(int32)
+SORTER_BENCHMARK(varchar)
+SORTER_BENCHMARK(int32_varchar)
+
+#undef SORTER_BENCHMARK
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,109 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "bench_util.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks::vectorized {
+
+// The columns of the cases.
+enum class ColumnKind { int32, int64, varchar, nullable_int32, nullable_varchar };
+
+static ColumnPtr create_column(ColumnKind kind, const std::vector<uint32_t>& rows) {
+    switch (kind) {
+    case ColumnKind::int32:
+        return bench::int32_column(rows, true);
+    case ColumnKind::int64:
+        return bench::int64_column(rows);
+    case ColumnKind::varchar:
+        return bench::varchar_column(rows);
+    case ColumnKind::nullable_int32:
+        return bench::nullable_column(bench::int32_column(rows, true), 16);
+    case ColumnKind::nullable_varchar:
+        return bench::nullable_column(bench::varchar_column(rows), 16);
+    }
+    return nullptr;
+}
+
+static ColumnPtr create_chunk_column(ColumnKind kind) {
+    size_t chunk_size = config::vector_chunk_size;
+    return create_column(kind, bench::random_rows(chunk_size, chunk_size));
+}
+
+// Args: the percentage of the rows selected.
+static void BM_ColumnFilter(benchmark::State& state, ColumnKind kind) {
+    ColumnPtr src = create_chunk_column(kind);
+    Column::Filter filter(src->size());
+    auto rows = bench::random_rows(src->size(), 100, 1);
+    for (size_t i = 0; i < filter.size(); i++) {
+        filter[i] = rows[i] < state.range(0);
+    }
+    // filter() works in place, so the copies of a batch are filtered in a run to amortize the pause of the timer
+    constexpr int kBatch = 64;
+    std::vector<ColumnPtr> columns(kBatch);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (auto& column : columns) {
+            column = src->clone_shared();
+        }
+        state.ResumeTiming();
+        for (auto& column : columns) {
+            benchmark::DoNotOptimize(column->filter(filter));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch * src->size());
+}
+
+// Args: the percentage of the rows selected, the selected rows are random.
+static void BM_ColumnAppendSelective(benchmark::State& state, ColumnKind kind) {
+    ColumnPtr src = create_chunk_column(kind);
+    auto indexes = bench::random_rows(src->size() * state.range(0) / 100, src->size(), 1);
+    ColumnPtr dst = src->clone_empty();
+    for (auto _ : state) {
+        dst->reset_column();
+        dst->append_selective(*src, indexes.data(), 0, indexes.size());
+        benchmark::DoNotOptimize(dst->size());
+    }
+    state.SetItemsProcessed(state.iterations() * indexes.size());
+}
+
+static void BM_ColumnFnvHash(benchmark::State& state, ColumnKind kind) {
+    ColumnPtr column = create_chunk_column(kind);
+    std::vector<uint32_t> hashes(column->size());
+    for (auto _ : state) {
+        hashes.assign(column->size(), HashUtil::FNV_SEED);
+        column->fvn_hash(hashes.data(), 0, column->size());
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * column->size());
+}
+
+static void BM_ColumnCrc32Hash(benchmark::State& state, ColumnKind kind) {
+    ColumnPtr column = create_chunk_column(kind);
+    std::vector<uint32_t> hashes(column->size());
+    for (auto _ : state) {
+        hashes.assign(column->size(), 0);
+        column->crc32_hash(hashes.data(), 0, column->size());
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * column->size());
+}
+
+#define COLUMN_BENCHMARK(KIND)                                                                   \
+    BENCHMARK_CAPTURE(BM_ColumnFilter, KIND, ColumnKind::KIND)->Arg(10)->Arg(50)->Arg(90);          \
+    BENCHMARK_CAPTURE(BM_ColumnAppendSelective, KIND, ColumnKind::KIND)->Arg(10)->Arg(50)->Arg(100); \
+    BENCHMARK_CAPTURE(BM_ColumnFnvHash, KIND, ColumnKind::KIND);                                     \
+    BENCHMARK_CAPTURE(BM_ColumnCrc32Hash, KIND, ColumnKind::KIND);
+
+COLUMN_BENCHMARK(int32)
+COLUMN_BENCHMARK(int64)
+COLUMN_BENCHMARK(varchar)
+COLUMN_BENCHMARK(nullable_int32)
+COLUMN_BENCHMARK(nullable_varchar)
+
+#undef COLUMN_BENCHMARK
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,206 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "bench_util.h"
+#include "exec/vectorized/join_hash_map.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+// The join keys of the cases, named by the JoinHashMapType they choose.
+enum class JoinKeyKind {
+    // the int keys 0..N-1, which are dense enough to index the buckets directly
+    direct_mapping32,
+    // the int keys scattered over the int range
+    key32,
+    key64,
+    keystring,
+    // two int keys packed into 8 bytes
+    fixed64,
+    // two bigint keys packed into 16 bytes
+    fixed128,
+    // an int and a varchar key serialized
+    slice
+};
+
+static std::vector<PrimitiveType> join_key_types(JoinKeyKind kind) {
+    switch (kind) {
+    case JoinKeyKind::direct_mapping32:
+    case JoinKeyKind::key32:
+        return {TYPE_INT};
+    case JoinKeyKind::key64:
+        return {TYPE_BIGINT};
+    case JoinKeyKind::keystring:
+        return {TYPE_VARCHAR};
+    case JoinKeyKind::fixed64:
+        return {TYPE_INT, TYPE_INT};
+    case JoinKeyKind::fixed128:
+        return {TYPE_BIGINT, TYPE_BIGINT};
+    case JoinKeyKind::slice:
+        return {TYPE_INT, TYPE_VARCHAR};
+    }
+    return {};
+}
+
+// The rows of the build side are 0..N-1, and the probe side draws them at random, so every probe row matches one
+// build row.
+class JoinHashTableBench {
+public:
+    explicit JoinHashTableBench(JoinKeyKind kind) : _kind(kind), _types(join_key_types(kind)) {
+        TDescriptorTableBuilder desc_builder;
+        // the tuple 0 is the probe side and the tuple 1 is the build side, both have the key columns only
+        for (int t = 0; t < 2; t++) {
+            TTupleDescriptorBuilder tuple_builder;
+            for (size_t i = 0; i < _types.size(); i++) {
+                TSlotDescriptorBuilder slot_builder;
+                if (_types[i] == TYPE_VARCHAR) {
+                    slot_builder.string_type(255);
+                } else {
+                    slot_builder.type(_types[i]);
+                }
+                tuple_builder.add_slot(
+                        slot_builder.column_name("c" + std::to_string(i)).column_pos(i).nullable(false).build());
+            }
+            tuple_builder.build(&desc_builder);
+        }
+        DescriptorTbl* tbl = nullptr;
+        CHECK(DescriptorTbl::create(&_object_pool, desc_builder.desc_tbl(), &tbl).ok());
+        _row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0, 1}, std::vector<bool>{false, false});
+        _probe_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0}, std::vector<bool>{false});
+        _build_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{1}, std::vector<bool>{false});
+
+        _state = std::make_unique<RuntimeState>(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+        _state->init_instance_mem_tracker();
+        _mem_tracker = std::make_unique<MemTracker>();
+        _profile = std::make_unique<RuntimeProfile>("JoinHashTableBench");
+
+        _param.join_type = TJoinOp::INNER_JOIN;
+        _param.row_desc = _row_desc.get();
+        _param.probe_row_desc = _probe_row_desc.get();
+        _param.build_row_desc = _build_row_desc.get();
+        _param.mem_tracker = _mem_tracker.get();
+        for (PrimitiveType type : _types) {
+            _param.join_keys.emplace_back(JoinKeyDesc{type, false});
+        }
+        _param.search_ht_timer = ADD_TIMER(_profile, "SearchHashTableTimer");
+        _param.output_build_column_timer = ADD_TIMER(_profile, "OutputBuildColumnTimer");
+        _param.output_probe_column_timer = ADD_TIMER(_profile, "OutputProbeColumnTimer");
+        _param.output_tuple_column_timer = ADD_TIMER(_profile, "OutputTupleColumnTimer");
+    }
+
+    // The chunks of the rows, the slots of the key columns start from |first_slot|.
+    ChunkPtr create_chunk(const std::vector<uint32_t>& rows, SlotId first_slot) const {
+        auto chunk = std::make_shared<Chunk>();
+        for (size_t i = 0; i < _types.size(); i++) {
+            ColumnPtr column;
+            switch (_types[i]) {
+            case TYPE_INT:
+                column = bench::int32_column(rows, _kind == JoinKeyKind::key32);
+                break;
+            case TYPE_BIGINT:
+                // the second bigint key is dense, the first one is not
+                column = bench::int64_column(rows, i == 0 ? 1000003 : 1);
+                break;
+            default:
+                column = bench::varchar_column(rows);
+                break;
+            }
+            chunk->append_column(std::move(column), first_slot + i);
+        }
+        return chunk;
+    }
+
+    std::vector<ChunkPtr> create_build_chunks(uint32_t num_rows) const {
+        std::vector<ChunkPtr> chunks;
+        for (uint32_t from = 0; from < num_rows; from += config::vector_chunk_size) {
+            uint32_t count = std::min<uint32_t>(config::vector_chunk_size, num_rows - from);
+            chunks.emplace_back(create_chunk(bench::sequence_rows(from, count), _types.size()));
+        }
+        return chunks;
+    }
+
+    void build(JoinHashTable* table, const std::vector<ChunkPtr>& build_chunks) {
+        table->create(_param);
+        for (const auto& chunk : build_chunks) {
+            CHECK(table->append_chunk(_state.get(), chunk).ok());
+        }
+        for (size_t i = 0; i < _types.size(); i++) {
+            table->get_key_columns().emplace_back(table->get_build_chunk()->columns()[i]);
+        }
+        CHECK(table->build(_state.get()).ok());
+    }
+
+    // Probes a chunk and returns the rows output.
+    size_t probe(JoinHashTable* table, ChunkPtr probe_chunk) {
+        Columns key_columns(probe_chunk->columns().begin(), probe_chunk->columns().begin() + _types.size());
+        size_t num_rows = 0;
+        bool has_remain = true;
+        while (has_remain) {
+            ChunkPtr result = std::make_shared<Chunk>();
+            CHECK(table->probe(key_columns, &probe_chunk, &result, &has_remain).ok());
+            num_rows += result->num_rows();
+        }
+        return num_rows;
+    }
+
+private:
+    JoinKeyKind _kind;
+    std::vector<PrimitiveType> _types;
+    ObjectPool _object_pool;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::unique_ptr<RowDescriptor> _probe_row_desc;
+    std::unique_ptr<RowDescriptor> _build_row_desc;
+    std::unique_ptr<RuntimeState> _state;
+    std::unique_ptr<MemTracker> _mem_tracker;
+    std::unique_ptr<RuntimeProfile> _profile;
+    HashTableParam _param;
+};
+
+// Args: the build rows.
+static void BM_JoinHashTableBuild(benchmark::State& state, JoinKeyKind kind) {
+    JoinHashTableBench join(kind);
+    auto build_chunks = join.create_build_chunks(state.range(0));
+    for (auto _ : state) {
+        JoinHashTable table;
+        join.build(&table, build_chunks);
+        benchmark::DoNotOptimize(table.get_bucket_size());
+        table.close();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Args: the build rows, each iteration probes a chunk.
+static void BM_JoinHashTableProbe(benchmark::State& state, JoinKeyKind kind) {
+    JoinHashTableBench join(kind);
+    uint32_t build_rows = state.range(0);
+    JoinHashTable table;
+    join.build(&table, join.create_build_chunks(build_rows));
+    ChunkPtr probe_chunk = join.create_chunk(bench::random_rows(config::vector_chunk_size, build_rows), 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(join.probe(&table, probe_chunk));
+    }
+    state.SetItemsProcessed(state.iterations() * probe_chunk->num_rows());
+    table.close();
+}
+
+#define JOIN_BENCHMARK(KIND)                                                                                         \
+    BENCHMARK_CAPTURE(BM_JoinHashTableBuild, KIND, JoinKeyKind::KIND)->RangeMultiplier(16)->Range(1 << 12, 1 << 20); \
+    BENCHMARK_CAPTURE(BM_JoinHashTableProbe, KIND, JoinKeyKind::KIND)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+JOIN_BENCHMARK(direct_mapping32)
+JOIN_BENCHMARK(key32)
+JOIN_BENCHMARK(key64)
+JOIN_BENCHMARK(keystring)
+JOIN_BENCHMARK(fixed64)
+JOIN_BENCHMARK(fixed128)
+JOIN_BENCHMARK(slice)
+
+#undef JOIN_BENCHMARK
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,205 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "storage/rowset/segment_v2/alp_page.h"
+#include "storage/rowset/segment_v2/binary_dict_page.h"
+#include "storage/rowset/segment_v2/binary_plain_page.h"
+#include "storage/rowset/segment_v2/bitshuffle_page.h"
+#include "storage/rowset/segment_v2/frame_of_reference_page.h"
+#include "storage/rowset/segment_v2/options.h"
+#include "storage/rowset/segment_v2/plain_page.h"
+#include "storage/rowset/segment_v2/rle_page.h"
+
+namespace starrocks::segment_v2 {
+
+static constexpr size_t kPageValues = 16384;
+
+// The values of a page, the data sets are:
+//   0: sorted, with the runs of 4 equal values, like a sort key or a date column
+//   1: random in [0, 65536)
+template <typename CppType>
+static std::vector<CppType> page_values(int64_t data_set) {
+    std::mt19937 rng(0);
+    std::vector<CppType> values(kPageValues);
+    for (size_t i = 0; i < kPageValues; i++) {
+        int64_t v = data_set == 0 ? i / 4 : rng() % 65536;
+        if constexpr (std::is_floating_point_v<CppType>) {
+            // the decimals of 2 digits, which are encoded as integers by ALP
+            values[i] = v / 100.0;
+        } else {
+            values[i] = v;
+        }
+    }
+    return values;
+}
+
+template <typename Builder>
+static OwnedSlice build_page(Builder* builder, const void* values, size_t count) {
+    CHECK_EQ(count, builder->add(reinterpret_cast<const uint8_t*>(values), count));
+    return builder->finish()->build();
+}
+
+static PageBuilderOptions page_builder_options() {
+    PageBuilderOptions options;
+    options.data_page_size = 1024 * 1024;
+    options.dict_page_size = 1024 * 1024;
+    return options;
+}
+
+// Decodes the page initialized by the batches of vector_chunk_size into |column|, like the column iterators do.
+static void decode_page(PageDecoder* decoder, vectorized::Column* column) {
+    size_t remaining = decoder->count();
+    while (remaining > 0) {
+        column->reset_column();
+        size_t n = std::min<size_t>(config::vector_chunk_size, remaining);
+        CHECK(decoder->next_batch(&n, column).ok());
+        remaining -= n;
+    }
+}
+
+// Args: the data set, see page_values().
+template <FieldType Type, template <FieldType> class Builder, template <FieldType> class Decoder>
+static void BM_NumericPageDecode(benchmark::State& state) {
+    using CppType = typename TypeTraits<Type>::CppType;
+    auto values = page_values<CppType>(state.range(0));
+    Builder<Type> builder(page_builder_options());
+    OwnedSlice page = build_page(&builder, values.data(), values.size());
+    vectorized::FixedLengthColumn<CppType> column;
+    for (auto _ : state) {
+        Decoder<Type> decoder(page.slice(), PageDecoderOptions());
+        CHECK(decoder.init().ok());
+        decode_page(&decoder, &column);
+        benchmark::DoNotOptimize(column.get_data().data());
+    }
+    state.counters["page_bytes"] = page.slice().size;
+    state.SetItemsProcessed(state.iterations() * kPageValues);
+    state.SetBytesProcessed(state.iterations() * kPageValues * sizeof(CppType));
+}
+
+BENCHMARK_TEMPLATE(BM_NumericPageDecode, OLAP_FIELD_TYPE_INT, PlainPageBuilder, PlainPageDecoder)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_NumericPageDecode, OLAP_FIELD_TYPE_INT, BitshufflePageBuilder, BitShufflePageDecoder)
+        ->Arg(0)
+        ->Arg(1);
+BENCHMARK_TEMPLATE(BM_NumericPageDecode, OLAP_FIELD_TYPE_INT, FrameOfReferencePageBuilder,
+                   FrameOfReferencePageDecoder)
+        ->Arg(0)
+        ->Arg(1);
+BENCHMARK_TEMPLATE(BM_NumericPageDecode, OLAP_FIELD_TYPE_INT, RlePageBuilder, RlePageDecoder)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_NumericPageDecode, OLAP_FIELD_TYPE_BIGINT, BitshufflePageBuilder, BitShufflePageDecoder)
+        ->Arg(0)
+        ->Arg(1);
+BENCHMARK_TEMPLATE(BM_NumericPageDecode, OLAP_FIELD_TYPE_BIGINT, FrameOfReferencePageBuilder,
+                   FrameOfReferencePageDecoder)
+        ->Arg(0)
+        ->Arg(1);
+BENCHMARK_TEMPLATE(BM_NumericPageDecode, OLAP_FIELD_TYPE_DOUBLE, BitshufflePageBuilder, BitShufflePageDecoder)
+        ->Arg(0)
+        ->Arg(1);
+BENCHMARK_TEMPLATE(BM_NumericPageDecode, OLAP_FIELD_TYPE_DOUBLE, AlpPageBuilder, AlpPageDecoder)->Arg(0)->Arg(1);
+
+// The strings of a page and their storage, |cardinality| distinct ones at random.
+struct PageStrings {
+    explicit PageStrings(size_t cardinality) {
+        std::mt19937 rng(0);
+        strings.reserve(kPageValues);
+        for (size_t i = 0; i < kPageValues; i++) {
+            strings.emplace_back("starrocks_" + std::to_string(rng() % cardinality));
+        }
+        for (const auto& s : strings) {
+            slices.emplace_back(s);
+        }
+    }
+
+    std::vector<std::string> strings;
+    std::vector<Slice> slices;
+};
+
+// Args: the number of the distinct strings.
+static void BM_BinaryPlainPageDecode(benchmark::State& state) {
+    PageStrings strings(state.range(0));
+    BinaryPlainPageBuilder builder(page_builder_options());
+    OwnedSlice page = build_page(&builder, strings.slices.data(), strings.slices.size());
+    vectorized::BinaryColumn column;
+    for (auto _ : state) {
+        BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR> decoder(page.slice(), PageDecoderOptions());
+        CHECK(decoder.init().ok());
+        decode_page(&decoder, &column);
+        benchmark::DoNotOptimize(column.get_bytes().data());
+    }
+    state.counters["page_bytes"] = page.slice().size;
+    state.SetItemsProcessed(state.iterations() * kPageValues);
+}
+BENCHMARK(BM_BinaryPlainPageDecode)->Arg(16)->Arg(1024)->Arg(kPageValues);
+
+// The pages of the dict encoding, the dict page is decoded once for the pages of a column.
+class DictPages {
+public:
+    explicit DictPages(size_t cardinality) : _strings(cardinality) {
+        BinaryDictPageBuilder builder(page_builder_options());
+        _data_page = build_page(&builder, _strings.slices.data(), _strings.slices.size());
+        _dict_page = builder.get_dictionary_page()->build();
+        _dict_decoder = std::make_unique<BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR>>(_dict_page.slice(),
+                                                                                          PageDecoderOptions());
+        CHECK(_dict_decoder->init().ok());
+    }
+
+    std::unique_ptr<BinaryDictPageDecoder<OLAP_FIELD_TYPE_VARCHAR>> new_decoder() const {
+        auto decoder = std::make_unique<BinaryDictPageDecoder<OLAP_FIELD_TYPE_VARCHAR>>(_data_page.slice(),
+                                                                                       PageDecoderOptions());
+        CHECK(decoder->init().ok());
+        decoder->set_dict_decoder(_dict_decoder.get());
+        return decoder;
+    }
+
+    size_t data_page_bytes() const { return _data_page.slice().size; }
+
+private:
+    PageStrings _strings;
+    OwnedSlice _data_page;
+    OwnedSlice _dict_page;
+    std::unique_ptr<BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR>> _dict_decoder;
+};
+
+// Args: the number of the distinct strings.
+static void BM_BinaryDictPageDecode(benchmark::State& state) {
+    DictPages pages(state.range(0));
+    vectorized::BinaryColumn column;
+    for (auto _ : state) {
+        auto decoder = pages.new_decoder();
+        decode_page(decoder.get(), &column);
+        benchmark::DoNotOptimize(column.get_bytes().data());
+    }
+    state.counters["page_bytes"] = pages.data_page_bytes();
+    state.SetItemsProcessed(state.iterations() * kPageValues);
+}
+BENCHMARK(BM_BinaryDictPageDecode)->Arg(16)->Arg(1024);
+
+// Decodes the dict codes only, like the scans of the low cardinality columns do.
+static void BM_BinaryDictPageDecodeCodes(benchmark::State& state) {
+    DictPages pages(state.range(0));
+    vectorized::Int32Column codes;
+    for (auto _ : state) {
+        auto decoder = pages.new_decoder();
+        size_t remaining = decoder->count();
+        while (remaining > 0) {
+            codes.reset_column();
+            size_t n = std::min<size_t>(config::vector_chunk_size, remaining);
+            CHECK(decoder->next_dict_codes(&n, &codes).ok());
+            remaining -= n;
+        }
+        benchmark::DoNotOptimize(codes.get_data().data());
+    }
+    state.SetItemsProcessed(state.iterations() * kPageValues);
+}
+BENCHMARK(BM_BinaryDictPageDecodeCodes)->Arg(16)->Arg(1024);
+
+} // namespace starrocks::segment_v2
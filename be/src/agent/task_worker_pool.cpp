@@ -24,12 +24,14 @@
 #include <pthread.h>
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <chrono>
 #include <condition_variable>
 #include <csignal>
 #include <ctime>
 #include <mutex>
+#include <numeric>
 #include <sstream>
 #include <string>
 
@@ -674,60 +676,88 @@ void* TaskWorkerPool::_publish_version_worker_thread_callback(void* arg_this) {
 #ifndef BE_TEST
     while (true) {
 #endif
-        TAgentTaskRequest agent_task_req;
-        TPublishVersionRequest publish_version_req;
+        // take the pending tasks in a batch, whose tablets are published together
+        std::vector<TAgentTaskRequest> agent_task_reqs;
         {
             std::unique_lock l(worker_pool_this->_worker_thread_lock);
             while (worker_pool_this->_tasks.empty()) {
                 worker_pool_this->_worker_thread_condition_variable->wait(l);
             }
 
-            agent_task_req = worker_pool_this->_tasks.front();
-            publish_version_req = agent_task_req.publish_version_req;
-            worker_pool_this->_tasks.pop_front();
+            size_t batch_size = std::max(config::publish_version_batch_size, 1);
+            while (!worker_pool_this->_tasks.empty() && agent_task_reqs.size() < batch_size) {
+                agent_task_reqs.emplace_back(std::move(worker_pool_this->_tasks.front()));
+                worker_pool_this->_tasks.pop_front();
+            }
         }
 
-        StarRocksMetrics::instance()->publish_task_request_total.increment(1);
-        LOG(INFO) << "get publish version task, signature:" << agent_task_req.signature;
+        const size_t num_tasks = agent_task_reqs.size();
+        StarRocksMetrics::instance()->publish_task_request_total.increment(num_tasks);
+        for (auto& agent_task_req : agent_task_reqs) {
+            LOG(INFO) << "get publish version task, signature:" << agent_task_req.signature;
+        }
 
-        Status st;
-        std::vector<TTabletId> error_tablet_ids;
+        std::vector<std::vector<TTabletId>> error_tablet_ids(num_tasks);
+        std::vector<OLAPStatus> results(num_tasks, OLAP_SUCCESS);
+        // the tasks to publish, the failed ones are retried
+        std::vector<size_t> pending_tasks(num_tasks);
+        std::iota(pending_tasks.begin(), pending_tasks.end(), 0);
         uint32_t retry_time = 0;
-        OLAPStatus res = OLAP_SUCCESS;
         while (retry_time < PUBLISH_VERSION_MAX_RETRY) {
-            error_tablet_ids.clear();
-            EnginePublishVersionTask engine_task(publish_version_req, &error_tablet_ids);
-            res = worker_pool_this->_env->storage_engine()->execute_task(&engine_task);
-            if (res == OLAP_SUCCESS) {
+            std::vector<const TPublishVersionRequest*> publish_version_reqs;
+            for (size_t task : pending_tasks) {
+                publish_version_reqs.emplace_back(&agent_task_reqs[task].publish_version_req);
+            }
+            std::vector<std::vector<TTabletId>> task_error_tablet_ids;
+            std::vector<OLAPStatus> task_results;
+            EnginePublishVersionTask engine_task(publish_version_reqs, &task_error_tablet_ids, &task_results);
+            worker_pool_this->_env->storage_engine()->execute_task(&engine_task);
+
+            std::vector<size_t> failed_tasks;
+            for (size_t i = 0; i < pending_tasks.size(); ++i) {
+                size_t task = pending_tasks[i];
+                error_tablet_ids[task] = std::move(task_error_tablet_ids[i]);
+                results[task] = task_results[i];
+                if (results[task] != OLAP_SUCCESS) {
+                    LOG(WARNING) << "publish version error, retry. [transaction_id="
+                                 << agent_task_reqs[task].publish_version_req.transaction_id
+                                 << ", error_tablets_size=" << error_tablet_ids[task].size() << "]";
+                    failed_tasks.emplace_back(task);
+                }
+            }
+            if (failed_tasks.empty()) {
                 break;
-            } else {
-                LOG(WARNING) << "publish version error, retry. [transaction_id=" << publish_version_req.transaction_id
-                             << ", error_tablets_size=" << error_tablet_ids.size() << "]";
-                ++retry_time;
-                SleepFor(MonoDelta::FromSeconds(1));
             }
+            pending_tasks = std::move(failed_tasks);
+            ++retry_time;
+            SleepFor(MonoDelta::FromSeconds(1));
         }
 
-        TFinishTaskRequest finish_task_request;
-        if (res != OLAP_SUCCESS) {
-            StarRocksMetrics::instance()->publish_task_failed_total.increment(1);
-            // if publish failed, return failed, FE will ignore this error and
-            // check error tablet ids and FE will also republish this task
-            LOG(WARNING) << "publish version failed. signature:" << agent_task_req.signature << ", error_code=" << res;
-            st = Status::RuntimeError(strings::Substitute("publish version failed. error=$0", res));
-            finish_task_request.__set_error_tablet_ids(error_tablet_ids);
-        } else {
-            LOG(INFO) << "publish_version success. signature:" << agent_task_req.signature;
-        }
+        for (size_t task = 0; task < num_tasks; ++task) {
+            const TAgentTaskRequest& agent_task_req = agent_task_reqs[task];
+            Status st;
+            TFinishTaskRequest finish_task_request;
+            if (results[task] != OLAP_SUCCESS) {
+                StarRocksMetrics::instance()->publish_task_failed_total.increment(1);
+                // if publish failed, return failed, FE will ignore this error and
+                // check error tablet ids and FE will also republish this task
+                LOG(WARNING) << "publish version failed. signature:" << agent_task_req.signature
+                             << ", error_code=" << results[task];
+                st = Status::RuntimeError(strings::Substitute("publish version failed. error=$0", results[task]));
+                finish_task_request.__set_error_tablet_ids(error_tablet_ids[task]);
+            } else {
+                LOG(INFO) << "publish_version success. signature:" << agent_task_req.signature;
+            }
 
-        st.to_thrift(&finish_task_request.task_status);
-        finish_task_request.__set_backend(worker_pool_this->_backend);
-        finish_task_request.__set_task_type(agent_task_req.task_type);
-        finish_task_request.__set_signature(agent_task_req.signature);
-        finish_task_request.__set_report_version(_s_report_version);
+            st.to_thrift(&finish_task_request.task_status);
+            finish_task_request.__set_backend(worker_pool_this->_backend);
+            finish_task_request.__set_task_type(agent_task_req.task_type);
+            finish_task_request.__set_signature(agent_task_req.signature);
+            finish_task_request.__set_report_version(_s_report_version);
 
-        worker_pool_this->_finish_task(finish_task_request);
-        worker_pool_this->_remove_task_info(agent_task_req.task_type, agent_task_req.signature);
+            worker_pool_this->_finish_task(finish_task_request);
+            worker_pool_this->_remove_task_info(agent_task_req.task_type, agent_task_req.signature);
+        }
 #ifndef BE_TEST
     }
 #endif
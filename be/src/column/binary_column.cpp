@@ -2,13 +2,12 @@
 
 #include "column/binary_column.h"
 
-#include <immintrin.h>
-
 #include "column/bytes.h"
+#include "column/column_hash.h"
 #include "common/logging.h"
-#include "gutil/bits.h"
 #include "gutil/casts.h"
 #include "gutil/strings/fastmem.h"
+#include "simd/simd.h"
 #include "util/coding.h"
 #include "util/hash_util.hpp"
 #include "util/mysql_row_buffer.h"
@@ -182,6 +181,16 @@ void BinaryColumn::_build_slices() const {
     }
 
     _slices_cache = true;
+    _string_views_cache = false;
+}
+
+void BinaryColumn::_build_string_views() const {
+    DCHECK(_slices_cache);
+    _string_views.resize(_slices.size());
+    for (size_t i = 0; i < _slices.size(); ++i) {
+        _string_views[i] = StringView(_slices[i]);
+    }
+    _string_views_cache = true;
 }
 
 void BinaryColumn::assign(size_t n, size_t idx) {
@@ -235,78 +244,60 @@ ColumnPtr BinaryColumn::cut(size_t start, size_t length) const {
     return result;
 }
 
+// The surviving rows are compacted by the runs of consecutive rows, the bytes of a run are moved by a memmove and
+// the offsets of it are rebased in one pass. The runs are found from the bitmaps of 64 rows, and the runs adjacent
+// across the bitmaps are merged.
 size_t BinaryColumn::filter_range(const Column::Filter& filter, size_t from, size_t to) {
-    auto start_offset = from;
-    auto result_offset = from;
-
-    uint8_t* data = _bytes.data();
-
-#ifdef __AVX2__
     const uint8_t* f_data = filter.data();
-
-    int simd_bits = 256;
-    int batch_nums = simd_bits / (8 * (int)sizeof(uint8_t));
-    __m256i all0 = _mm256_setzero_si256();
-
-    while (start_offset + batch_nums < to) {
-        __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(f_data + start_offset));
-        uint32_t mask = _mm256_movemask_epi8(_mm256_cmpgt_epi8(f, all0));
-
-        if (mask == 0) {
-            // all no hit, pass
-        } else if (mask == 0xffffffff) {
-            // all hit, copy all
-
-            // copy data
-            uint32_t size = _offsets[start_offset + batch_nums] - _offsets[start_offset];
-            memmove(data + _offsets[result_offset], data + _offsets[start_offset], size);
-
-            // set offsets, try vectorized
-            uint32_t* offset_data = _offsets.data();
-            for (int i = 0; i < batch_nums; ++i) {
-                // TODO: performance, all sub one same offset ?
-                offset_data[result_offset + i + 1] = offset_data[result_offset + i] +
-                                                     offset_data[start_offset + i + 1] - offset_data[start_offset + i];
+    uint8_t* data = _bytes.data();
+    uint32_t* offsets = _offsets.data();
+    size_t result_offset = from;
+
+    auto move_run = [&](size_t start, size_t end) {
+        // the rows stay in place until a row is filtered out.
+        if (result_offset != start) {
+            uint32_t src_begin = offsets[start];
+            uint32_t dst_begin = offsets[result_offset];
+            memmove(data + dst_begin, data + src_begin, offsets[end] - src_begin);
+            uint32_t delta = src_begin - dst_begin;
+            for (size_t i = start; i < end; ++i) {
+                offsets[result_offset + i - start + 1] = offsets[i + 1] - delta;
             }
-
-            result_offset += batch_nums;
+        }
+        result_offset += end - start;
+    };
+
+    // the pending run [run_start, run_end).
+    size_t run_start = from;
+    size_t run_end = from;
+    auto add_run = [&](size_t start, size_t end) {
+        if (start == run_end) {
+            run_end = end;
         } else {
-            // skip not hit row, it's will reduce compare when filter layout is sparse,
-            // like "00010001...", but is ineffective when the filter layout is dense.
-
-            uint32_t zero_count = Bits::CountTrailingZerosNonZero32(mask);
-            uint32_t i = zero_count;
-            while (i < batch_nums) {
-                mask = zero_count < 31 ? mask >> (zero_count + 1) : 0;
-
-                uint32_t size = _offsets[start_offset + i + 1] - _offsets[start_offset + i];
-                // copy date
-                memmove(data + _offsets[result_offset], data + _offsets[start_offset + i], size);
-
-                // set offsets
-                _offsets[result_offset + 1] = _offsets[result_offset] + size;
-                zero_count = Bits::CountTrailingZeros32(mask);
-                result_offset += 1;
-                i += (zero_count + 1);
-            }
+            move_run(run_start, run_end);
+            run_start = start;
+            run_end = end;
+        }
+    };
+
+    size_t i = from;
+    for (; i + 64 <= to; i += 64) {
+        uint64_t mask;
+        SIMD::bytes_to_bitmap(f_data + i, 64, reinterpret_cast<uint8_t*>(&mask));
+        while (mask != 0) {
+            size_t begin = __builtin_ctzll(mask);
+            uint64_t rest = ~(mask >> begin);
+            size_t len = rest == 0 ? 64 : __builtin_ctzll(rest);
+            add_run(i + begin, i + begin + len);
+            mask = begin + len >= 64 ? 0 : mask & (~uint64_t(0) << (begin + len));
         }
-        start_offset += batch_nums;
     }
-#endif
-
-    for (auto i = start_offset; i < to; ++i) {
-        if (filter[i]) {
-            DCHECK_GE(_offsets[i + 1], _offsets[i]);
-            uint32_t size = _offsets[i + 1] - _offsets[i];
-            // copy date
-            memmove(data + _offsets[result_offset], data + _offsets[i], size);
-
-            // set offsets
-            _offsets[result_offset + 1] = _offsets[result_offset] + size;
-
-            result_offset++;
+    for (; i < to; ++i) {
+        if (f_data[i]) {
+            add_run(i, i + 1);
         }
     }
+    move_run(run_start, run_end);
 
     this->resize(result_offset);
     return result_offset;
@@ -418,6 +409,12 @@ void BinaryColumn::crc32_hash(uint32_t* hashes, uint16_t from, uint16_t to) cons
     }
 }
 
+void BinaryColumn::crc32c_hash(uint32_t* hashes, uint16_t from, uint16_t to) const {
+    for (uint16_t i = from; i < to; ++i) {
+        hashes[i] = crc_hash_32(_bytes.data() + _offsets[i], _offsets[i + 1] - _offsets[i], hashes[i]);
+    }
+}
+
 void BinaryColumn::put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const {
     uint32_t start = _offsets[idx];
     uint32_t len = _offsets[idx + 1] - start;
@@ -4,6 +4,7 @@
 
 #include "column/bytes.h"
 #include "column/column.h"
+#include "column/string_view.h"
 #include "util/slice.h"
 
 namespace starrocks::vectorized {
@@ -20,6 +21,7 @@ public:
     using Bytes = starrocks::raw::RawVectorPad16<uint8_t>;
 
     using Container = Buffer<Slice>;
+    using StringViews = Buffer<StringView>;
 
     // TODO(kks): when we create our own vector, we could let vector[-1] = 0,
     // and then we don't need explicitly emplace_back zero value
@@ -204,6 +206,8 @@ public:
 
     void crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
 
+    void crc32c_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
+
     void put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const override;
 
     std::string get_name() const override { return "binary"; }
@@ -221,6 +225,18 @@ public:
         return _slices;
     }
 
+    // The views of the strings for comparing the keys of sorts, they are built on the first call after the column
+    // changes, like get_data().
+    const StringViews& get_string_views() const {
+        if (!_slices_cache) {
+            _build_slices();
+        }
+        if (!_string_views_cache) {
+            _build_string_views();
+        }
+        return _string_views;
+    }
+
     Bytes& get_bytes() { return _bytes; }
 
     const Bytes& get_bytes() const { return _bytes; }
@@ -231,12 +247,13 @@ public:
     Datum get(size_t n) const override { return Datum(get_slice(n)); }
 
     size_t container_memory_usage() const override {
-        return _bytes.capacity() + _offsets.capacity() * sizeof(_offsets[0]) + _slices.capacity() * sizeof(_slices[0]);
+        return _bytes.capacity() + _offsets.capacity() * sizeof(_offsets[0]) + _slices.capacity() * sizeof(_slices[0]) +
+               _string_views.capacity() * sizeof(_string_views[0]);
     }
 
     size_t shrink_memory_usage() const override {
         return _bytes.size() * sizeof(uint8_t) + _offsets.size() * sizeof(_offsets[0]) +
-               _slices.size() * sizeof(_slices[0]);
+               _slices.size() * sizeof(_slices[0]) + _string_views.size() * sizeof(_string_views[0]);
     }
 
     void swap_column(Column& rhs) override {
@@ -247,6 +264,8 @@ public:
         swap(_offsets, r._offsets);
         swap(_slices, r._slices);
         swap(_slices_cache, r._slices_cache);
+        swap(_string_views, r._string_views);
+        swap(_string_views_cache, r._string_views_cache);
     }
 
     void reset_column() override {
@@ -256,6 +275,7 @@ public:
         _offsets.resize(1, 0);
         _slices.clear();
         _slices_cache = false;
+        _string_views.clear();
     }
 
     void invalidate_slice_cache() { _slices_cache = false; }
@@ -274,12 +294,16 @@ public:
 
 private:
     void _build_slices() const;
+    void _build_string_views() const;
 
     Bytes _bytes;
     Offsets _offsets;
 
     mutable Container _slices;
     mutable bool _slices_cache = false;
+    // Valid if |_slices_cache| is, they are invalidated whenever the slices are rebuilt.
+    mutable StringViews _string_views;
+    mutable bool _string_views_cache = false;
 };
 
 using Offsets = BinaryColumn::Offsets;
@@ -2,9 +2,13 @@
 
 #include "column/chunk.h"
 
+#include <algorithm>
+
+#include "column/column_encoder.h"
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
 #include "column/fixed_length_column.h"
+#include "common/config.h"
 #include "gen_cpp/data.pb.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
@@ -45,6 +49,8 @@ void Chunk::reset() {
         c->reset_column();
     }
     _delete_state = DEL_NOT_SATISFIED;
+    _has_selection = false;
+    _selection.clear();
 }
 
 void Chunk::swap_chunk(Chunk& other) {
@@ -54,12 +60,16 @@ void Chunk::swap_chunk(Chunk& other) {
     _slot_id_to_index.swap(other._slot_id_to_index);
     _tuple_id_to_index.swap(other._tuple_id_to_index);
     std::swap(_delete_state, other._delete_state);
+    std::swap(_has_selection, other._has_selection);
+    _selection.swap(other._selection);
 }
 
 void Chunk::set_num_rows(size_t count) {
     for (ColumnPtr& c : _columns) {
         c->resize(count);
     }
+    _has_selection = false;
+    _selection.clear();
 }
 
 std::string Chunk::get_column_name(size_t idx) const {
@@ -139,7 +149,8 @@ size_t Chunk::serialize_size() const {
 }
 
 void Chunk::serialize(uint8_t* dst) const {
-    uint32_t version = 1;
+    uint32_t version = kSerdeVersion1;
+    DCHECK(!_has_selection);
     encode_fixed32_le(dst, version);
     dst += sizeof(uint32_t);
 
@@ -151,6 +162,27 @@ void Chunk::serialize(uint8_t* dst) const {
     }
 }
 
+size_t Chunk::serialize(std::string* dst, uint32_t version) const {
+    if (version == kSerdeVersion1) {
+        size_t size = serialize_size();
+        // TODO(kks): resize without initializing the new bytes
+        dst->resize(size);
+        serialize(reinterpret_cast<uint8_t*>(dst->data()));
+        return size;
+    }
+    DCHECK_EQ(kSerdeVersion2, version);
+    DCHECK(!_has_selection);
+    dst->clear();
+    // The encoded columns are mostly smaller than the plain ones.
+    dst->reserve(serialize_size());
+    put_fixed32_le(dst, version);
+    put_fixed32_le(dst, num_rows());
+    for (const auto& column : _columns) {
+        ColumnEncoder::encode(*column, dst);
+    }
+    return dst->size();
+}
+
 size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
     chunk->clear_slot_id_map();
     chunk->mutable_slot_id_map()->Reserve(static_cast<int>(_slot_id_to_index.size()) * 2);
@@ -180,10 +212,7 @@ size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
 
     DCHECK_EQ(_columns.size(), _tuple_id_to_index.size() + _slot_id_to_index.size());
 
-    size_t size = serialize_size();
-    chunk->mutable_data()->resize(size);
-    serialize((uint8_t*)chunk->mutable_data()->data());
-    return size;
+    return serialize(chunk->mutable_data(), config::chunk_serde_version);
 }
 
 Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta& meta) {
@@ -191,8 +220,11 @@ Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta
     _tuple_id_to_index = meta.tuple_id_to_index;
     _columns.resize(_slot_id_to_index.size() + _tuple_id_to_index.size());
 
+    const uint8_t* begin = src;
     uint32_t version = decode_fixed32_le(src);
-    DCHECK_EQ(version, 1);
+    if (UNLIKELY(version != kSerdeVersion1 && version != kSerdeVersion2)) {
+        return Status::InternalError(strings::Substitute("unknown version of chunk data: $0", version));
+    }
     src += sizeof(uint32_t);
 
     size_t rows = decode_fixed32_le(src);
@@ -202,11 +234,19 @@ Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta
         _columns[i] = ColumnHelper::create_column(meta.types[i], meta.is_nulls[i], meta.is_consts[i], rows);
     }
 
-    for (const auto& column : _columns) {
-        src = column->deserialize_column(src);
+    if (version == kSerdeVersion1) {
+        for (const auto& column : _columns) {
+            src = column->deserialize_column(src);
+        }
+    } else {
+        for (const auto& column : _columns) {
+            src = ColumnEncoder::decode(src, column.get());
+        }
     }
 
-    size_t except = serialize_size();
+    // The size of the data deserialized, which may be encoded differently from serialize_size() of this BE,
+    // e.g. the null flags of another BE with config::serialize_null_bitmap.
+    size_t except = src - begin;
     if (UNLIKELY(len != except)) {
         return Status::InternalError(
                 strings::Substitute("deserialize chunk data failed. len: $0, except: $1", len, except));
@@ -270,12 +310,19 @@ std::unique_ptr<Chunk> Chunk::clone_empty_with_tuple(size_t size) const {
 
 void Chunk::append_selective(const Chunk& src, const uint32_t* indexes, uint32_t from, uint32_t size) {
     DCHECK_EQ(_columns.size(), src.columns().size());
+    DCHECK(!src.has_selection());
     for (size_t i = 0; i < _columns.size(); ++i) {
         _columns[i]->append_selective(*src.columns()[i].get(), indexes, from, size);
     }
 }
 
 size_t Chunk::filter(const Buffer<uint8_t>& selection) {
+    if (_has_selection) {
+        // The rows filtered lazily are removed together with the ones of |selection|.
+        select(selection);
+        materialize_selection();
+        return num_rows();
+    }
     for (auto& column : _columns) {
         column->filter(selection);
     }
@@ -283,12 +330,64 @@ size_t Chunk::filter(const Buffer<uint8_t>& selection) {
 }
 
 size_t Chunk::filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to) {
+    DCHECK(!_has_selection);
     for (auto& column : _columns) {
         column->filter_range(selection, from, to);
     }
     return num_rows();
 }
 
+void Chunk::set_selection(Buffer<uint32_t> selection) {
+    DCHECK(std::is_sorted(selection.begin(), selection.end()));
+    DCHECK(selection.empty() || selection.back() < num_rows());
+    _selection = std::move(selection);
+    _has_selection = true;
+}
+
+void Chunk::select(const Buffer<uint8_t>& filter) {
+    DCHECK_EQ(filter.size(), num_rows());
+    size_t n = 0;
+    if (_has_selection) {
+        for (uint32_t row : _selection) {
+            _selection[n] = row;
+            n += filter[row] != 0;
+        }
+    } else {
+        _selection.resize(filter.size());
+        for (uint32_t row = 0; row < filter.size(); row++) {
+            _selection[n] = row;
+            n += filter[row] != 0;
+        }
+        _has_selection = true;
+    }
+    if (n == 0) {
+        set_num_rows(0);
+        return;
+    }
+    _selection.resize(n);
+}
+
+void Chunk::materialize_selection() {
+    if (!_has_selection) {
+        return;
+    }
+    const size_t rows = num_rows();
+    if (_selection.size() < rows) {
+        Column::Filter filter(rows, 0);
+        for (uint32_t row : _selection) {
+            filter[row] = 1;
+        }
+        for (auto& column : _columns) {
+            // The columns shared by several slots, e.g. the outputs of a projection, are compacted only once.
+            if (column->size() == rows) {
+                column->filter(filter);
+            }
+        }
+    }
+    _has_selection = false;
+    _selection.clear();
+}
+
 DatumTuple Chunk::get(size_t n) const {
     DatumTuple res;
     res.reserve(_columns.size());
@@ -366,6 +465,11 @@ void Chunk::check_or_die() {
             CHECK_EQ(cid, _schema->field(idx)->id());
         }
     }
+
+    if (_has_selection) {
+        CHECK(std::is_sorted(_selection.begin(), _selection.end()));
+        CHECK(_selection.empty() || _selection.back() < num_rows());
+    }
 }
 #endif
 
@@ -382,6 +486,7 @@ std::string Chunk::debug_row(uint32_t index) const {
 
 void Chunk::append(const Chunk& src, size_t offset, size_t count) {
     DCHECK_EQ(num_columns(), src.num_columns());
+    DCHECK(!src.has_selection());
     const size_t n = src.num_columns();
     for (size_t i = 0; i < n; i++) {
         ColumnPtr& c = get_column_by_index(i);
@@ -391,6 +496,7 @@ void Chunk::append(const Chunk& src, size_t offset, size_t count) {
 
 void Chunk::append_safe(const Chunk& src, size_t offset, size_t count) {
     DCHECK_EQ(num_columns(), src.num_columns());
+    DCHECK(!src.has_selection());
     const size_t n = src.num_columns();
     size_t cur_rows = num_rows();
 
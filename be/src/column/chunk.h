@@ -103,10 +103,14 @@ public:
 
     void set_columns(const Columns& columns) { _columns = columns; }
 
+    // The versions of the format of the serialized chunk data.
+    static constexpr uint32_t kSerdeVersion1 = 1;
+    static constexpr uint32_t kSerdeVersion2 = 2;
+
     // The size for serialize chunk meta and chunk data
     size_t serialize_size() const;
 
-    // Serialize chunk data and meta to ChunkPB
+    // Serialize chunk data and meta to ChunkPB, in the version of config::chunk_serde_version
     // The result value is the chunk data serialize size
     size_t serialize_with_meta(starrocks::ChunkPB* chunk) const;
 
@@ -121,7 +125,16 @@ public:
     // Note: You should ensure the dst buffer size is enough
     void serialize(uint8_t* dst) const;
 
-    // Deserialize chunk by |src| (chunk data) and |meta| (chunk meta)
+    // Serialize chunk data to |dst| in the format of |version|, return the serialize size.
+    // The version 1 is the format above, and the version 2 is:
+    //     version(4 byte)
+    //     num_rows(4 byte)
+    //     column 1 encoded by ColumnEncoder
+    //     ...
+    //     column n encoded by ColumnEncoder
+    size_t serialize(std::string* dst, uint32_t version) const;
+
+    // Deserialize chunk by |src| (chunk data) of any version and |meta| (chunk meta)
     Status deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta& meta);
 
     // Create an empty chunk with the same meta and reserve it of size chunk _num_rows
@@ -174,6 +187,24 @@ public:
     // Return the number of rows after filter.
     size_t filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to);
 
+    // The selection vector of the lazy filter: the ascending indexes of the rows that survive the predicates, while
+    // the columns keep all the rows until materialize_selection(). Only the operators that understand the selection
+    // see a chunk with it, the pipeline driver materializes it before pushing the chunk to any other operator.
+    bool has_selection() const { return _has_selection; }
+    const Buffer<uint32_t>& selection() const { return _selection; }
+    // The number of rows seen by the operators, which is num_rows() if the chunk has no selection.
+    size_t num_selected_rows() const { return _has_selection ? _selection.size() : num_rows(); }
+
+    // Replace the selection by |selection|, which must be ascending and less than num_rows().
+    void set_selection(Buffer<uint32_t> selection);
+
+    // Narrow the selection down to the rows whose |filter| is nonzero, without moving any data.
+    // The size of |filter| must be equal to the number of rows, the chunk is emptied if no row is selected.
+    void select(const Buffer<uint8_t>& filter);
+
+    // Compact the columns to the selected rows and drop the selection.
+    void materialize_selection();
+
     // Return the data of n-th row.
     // This method is relatively slow and mainly used for unit tests now.
     DatumTuple get(size_t n) const;
@@ -244,6 +275,8 @@ private:
     butil::FlatMap<SlotId, size_t> _slot_id_to_index;
     butil::FlatMap<TupleId, size_t> _tuple_id_to_index;
     DelCondSatisfied _delete_state = DEL_NOT_SATISFIED;
+    bool _has_selection = false;
+    Buffer<uint32_t> _selection;
 };
 
 inline const ColumnPtr& Chunk::get_column_by_name(const std::string& column_name) const {
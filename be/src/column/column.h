@@ -268,6 +268,11 @@ public:
     // used by data loading compute tablet bucket
     virtual void crc32_hash(uint32_t* seed, uint16_t from, uint16_t to) const = 0;
 
+    // Compute the hash by the hardware CRC32 instructions, which is much cheaper than fvn_hash, used by the
+    // shuffles inside one BE such as the local exchanges. The shuffles among the BEs use fvn_hash, which all
+    // the BEs must agree on. The columns without it fall back to fvn_hash.
+    virtual void crc32c_hash(uint32_t* seed, uint16_t from, uint16_t to) const { fvn_hash(seed, from, to); }
+
     // Push one row to MysqlRowBuffer
     virtual void put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const = 0;
 
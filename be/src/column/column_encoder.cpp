@@ -0,0 +1,373 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/column_encoder.h"
+
+#include <limits>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/column_hash.h"
+#include "column/const_column.h"
+#include "column/dict_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "gutil/casts.h"
+#include "gutil/strings/fastmem.h"
+#include "simd/simd.h"
+#include "util/coding.h"
+#include "util/phmap/phmap.h"
+
+namespace starrocks::vectorized {
+
+namespace {
+
+// The columns of fewer rows are not checked for the same rows.
+constexpr size_t kConstantMinRows = 2;
+// The strings of a binary column are dictionary encoded if it has at least kDictMinRows rows, and each distinct
+// string is in kDictMinRepeats rows on average.
+constexpr size_t kDictMinRows = 64;
+constexpr size_t kDictMinRepeats = 4;
+
+uint8_t width_of(uint32_t max_value) {
+    if (max_value <= std::numeric_limits<uint8_t>::max()) {
+        return sizeof(uint8_t);
+    }
+    if (max_value <= std::numeric_limits<uint16_t>::max()) {
+        return sizeof(uint16_t);
+    }
+    return sizeof(uint32_t);
+}
+
+// Append the |size| values got by |get_value| in |width| bytes each.
+template <typename GetValue>
+void put_packed(std::string* dst, size_t size, uint8_t width, GetValue get_value) {
+    size_t offset = dst->size();
+    dst->resize(offset + size * width);
+    auto* p = reinterpret_cast<uint8_t*>(dst->data() + offset);
+    if (width == sizeof(uint8_t)) {
+        for (size_t i = 0; i < size; i++) {
+            p[i] = static_cast<uint8_t>(get_value(i));
+        }
+    } else if (width == sizeof(uint16_t)) {
+        for (size_t i = 0; i < size; i++) {
+            encode_fixed16_le(p + i * sizeof(uint16_t), static_cast<uint16_t>(get_value(i)));
+        }
+    } else {
+        for (size_t i = 0; i < size; i++) {
+            encode_fixed32_le(p + i * sizeof(uint32_t), get_value(i));
+        }
+    }
+}
+
+// Call |f| with the index and the value of the |size| values of |width| bytes each, return the end of them.
+template <typename F>
+const uint8_t* for_each_packed(const uint8_t* src, size_t size, uint8_t width, F f) {
+    if (width == sizeof(uint8_t)) {
+        for (size_t i = 0; i < size; i++) {
+            f(i, src[i]);
+        }
+    } else if (width == sizeof(uint16_t)) {
+        for (size_t i = 0; i < size; i++) {
+            f(i, decode_fixed16_le(src + i * sizeof(uint16_t)));
+        }
+    } else {
+        for (size_t i = 0; i < size; i++) {
+            f(i, decode_fixed32_le(src + i * sizeof(uint32_t)));
+        }
+    }
+    return src + size * width;
+}
+
+void put_binary(const BinaryColumn& column, std::string* dst) {
+    const auto& offsets = column.get_offset();
+    const auto& bytes = column.get_bytes();
+    const size_t num_rows = column.size();
+    uint32_t max_length = 0;
+    for (size_t i = 0; i < num_rows; i++) {
+        max_length = std::max(max_length, offsets[i + 1] - offsets[i]);
+    }
+    uint8_t width = width_of(max_length);
+    dst->push_back(ColumnEncoder::kBinary);
+    put_fixed32_le(dst, num_rows);
+    dst->push_back(width);
+    put_packed(dst, num_rows, width, [&](size_t i) { return offsets[i + 1] - offsets[i]; });
+    put_fixed32_le(dst, bytes.size());
+    dst->append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+// Append the |num_rows| strings got by |get_slice| as kBinary.
+template <typename GetSlice>
+void put_strings(std::string* dst, size_t num_rows, GetSlice get_slice) {
+    uint32_t max_length = 0;
+    size_t bytes_size = 0;
+    for (size_t i = 0; i < num_rows; i++) {
+        Slice str = get_slice(i);
+        max_length = std::max(max_length, static_cast<uint32_t>(str.size));
+        bytes_size += str.size;
+    }
+    uint8_t width = width_of(max_length);
+    dst->push_back(ColumnEncoder::kBinary);
+    put_fixed32_le(dst, num_rows);
+    dst->push_back(width);
+    put_packed(dst, num_rows, width, [&](size_t i) { return static_cast<uint32_t>(get_slice(i).size); });
+    put_fixed32_le(dst, bytes_size);
+    size_t offset = dst->size();
+    dst->resize(offset + bytes_size);
+    char* p = dst->data() + offset;
+    for (size_t i = 0; i < num_rows; i++) {
+        Slice str = get_slice(i);
+        strings::memcpy_inlined(p, str.data, str.size);
+        p += str.size;
+    }
+}
+
+void put_codes(size_t dict_size, const uint32_t* codes, size_t num_rows, std::string* dst) {
+    uint8_t width = width_of(dict_size > 0 ? dict_size - 1 : 0);
+    dst->push_back(width);
+    put_packed(dst, num_rows, width, [&](size_t i) { return codes[i]; });
+}
+
+// Append |column| as kDict if it has few distinct strings, or return false.
+bool try_put_dict(const BinaryColumn& column, std::string* dst) {
+    const size_t num_rows = column.size();
+    if (num_rows < kDictMinRows) {
+        return false;
+    }
+    const size_t max_dict_size = num_rows / kDictMinRepeats;
+    phmap::flat_hash_map<Slice, uint32_t, SliceHash, SliceNormalEqual> dict;
+    std::vector<Slice> strings;
+    std::vector<uint32_t> codes(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        Slice str = column.get_slice(i);
+        auto [iter, inserted] = dict.try_emplace(str, static_cast<uint32_t>(strings.size()));
+        if (inserted) {
+            if (strings.size() == max_dict_size) {
+                return false;
+            }
+            strings.emplace_back(str);
+        }
+        codes[i] = iter->second;
+    }
+    dst->push_back(ColumnEncoder::kDict);
+    put_fixed32_le(dst, num_rows);
+    put_strings(dst, strings.size(), [&](size_t i) { return strings[i]; });
+    put_codes(strings.size(), codes.data(), num_rows, dst);
+    return true;
+}
+
+void put_dict_column(const DictColumn& column, std::string* dst) {
+    const size_t num_rows = column.size();
+    const ColumnDict& dict = *column.dict();
+    if (dict.size() * kDictMinRepeats > num_rows) {
+        // Most of the strings of the dictionary are not in the rows.
+        put_strings(dst, num_rows, [&](size_t i) { return column.get_slice(i); });
+        return;
+    }
+    dst->push_back(ColumnEncoder::kDict);
+    put_fixed32_le(dst, num_rows);
+    put_binary(dict.strings(), dst);
+    static_assert(sizeof(int32_t) == sizeof(uint32_t));
+    put_codes(dict.size(), reinterpret_cast<const uint32_t*>(column.codes().data()), num_rows, dst);
+}
+
+} // namespace
+
+void ColumnEncoder::encode(const Column& column, std::string* dst) {
+    if (column.is_constant()) {
+        const ColumnPtr& data_column = down_cast<const ConstColumn&>(column).data_column();
+        if (data_column->size() == 1) {
+            _encode_constant(*data_column, column.size(), dst);
+        } else if (!data_column->empty()) {
+            auto first = data_column->clone_empty();
+            first->append(*data_column, 0, 1);
+            _encode_constant(*first, column.size(), dst);
+        } else {
+            _encode_plain(column, dst);
+        }
+    } else if (_is_constant(column)) {
+        auto first = column.clone_empty();
+        first->append(column, 0, 1);
+        _encode_constant(*first, column.size(), dst);
+    } else if (column.is_nullable()) {
+        _encode_nullable(column, dst);
+    } else if (column.low_cardinality()) {
+        put_dict_column(down_cast<const DictColumn&>(column), dst);
+    } else if (column.is_binary()) {
+        const auto& binary = down_cast<const BinaryColumn&>(column);
+        if (!config::chunk_serde_dict_encoding || !try_put_dict(binary, dst)) {
+            put_binary(binary, dst);
+        }
+    } else {
+        _encode_plain(column, dst);
+    }
+}
+
+void ColumnEncoder::_encode_constant(const Column& data_column, size_t num_rows, std::string* dst) {
+    DCHECK_EQ(1, data_column.size());
+    dst->push_back(kConstant);
+    put_fixed32_le(dst, num_rows);
+    encode(data_column, dst);
+}
+
+void ColumnEncoder::_encode_nullable(const Column& column, std::string* dst) {
+    const auto& nullable = down_cast<const NullableColumn&>(column);
+    dst->push_back(kNullable);
+    if (!nullable.has_null()) {
+        dst->push_back(kNoNull);
+    } else {
+        const size_t num_rows = nullable.size();
+        dst->push_back(kNullBitmap);
+        put_fixed32_le(dst, num_rows);
+        size_t offset = dst->size();
+        dst->resize(offset + (num_rows + 7) / 8);
+        SIMD::bytes_to_bitmap(nullable.immutable_null_column_data().data(), num_rows,
+                              reinterpret_cast<uint8_t*>(dst->data() + offset));
+    }
+    encode(*nullable.data_column(), dst);
+}
+
+void ColumnEncoder::_encode_plain(const Column& column, std::string* dst) {
+    dst->push_back(kPlain);
+    size_t offset = dst->size();
+    dst->resize(offset + column.serialize_size());
+    // serialize_column doesn't change the column.
+    [[maybe_unused]] uint8_t* end =
+            const_cast<Column&>(column).serialize_column(reinterpret_cast<uint8_t*>(dst->data() + offset));
+    DCHECK_EQ(reinterpret_cast<uint8_t*>(dst->data() + dst->size()), end);
+}
+
+bool ColumnEncoder::_is_constant(const Column& column) {
+    const size_t num_rows = column.size();
+    if (num_rows < kConstantMinRows) {
+        return false;
+    }
+    if (column.is_nullable()) {
+        const auto& nullable = down_cast<const NullableColumn&>(column);
+        if (!nullable.has_null()) {
+            return _is_constant(*nullable.data_column());
+        }
+        return SIMD::count_zero(nullable.immutable_null_column_data().data(), num_rows) == 0;
+    }
+    if (column.is_binary()) {
+        const auto& binary = down_cast<const BinaryColumn&>(column);
+        Slice first = binary.get_slice(0);
+        for (size_t i = 1; i < num_rows; i++) {
+            Slice str = binary.get_slice(i);
+            if (str.size != first.size || memcmp(str.data, first.data, first.size) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (column.is_numeric() || column.is_decimal() || column.is_date() || column.is_timestamp()) {
+        const uint8_t* data = column.raw_data();
+        const size_t width = column.type_size();
+        for (size_t i = 1; i < num_rows; i++) {
+            if (memcmp(data + i * width, data, width) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+const uint8_t* ColumnEncoder::decode(const uint8_t* src, Column* column) {
+    auto encoding = static_cast<Encoding>(*src++);
+    switch (encoding) {
+    case kConstant:
+        return _decode_constant(src, column);
+    case kNullable:
+        return _decode_nullable(src, column);
+    case kBinary:
+        return _decode_binary(src, column);
+    case kDict:
+        return _decode_dict(src, column);
+    case kPlain:
+        break;
+    }
+    DCHECK_EQ(kPlain, encoding);
+    return column->deserialize_column(src);
+}
+
+const uint8_t* ColumnEncoder::_decode_constant(const uint8_t* src, Column* column) {
+    uint32_t num_rows = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+    if (column->is_constant()) {
+        auto* const_column = down_cast<ConstColumn*>(column);
+        ColumnPtr data_column = const_column->data_column()->clone_empty();
+        src = decode(src, data_column.get());
+        *const_column->mutable_data_column() = std::move(data_column);
+        const_column->resize(num_rows);
+    } else {
+        auto first = column->clone_empty();
+        src = decode(src, first.get());
+        column->append_value_multiple_times(*first, 0, num_rows);
+    }
+    return src;
+}
+
+const uint8_t* ColumnEncoder::_decode_nullable(const uint8_t* src, Column* column) {
+    DCHECK(column->is_nullable());
+    auto* nullable = down_cast<NullableColumn*>(column);
+    auto null_encoding = static_cast<NullEncoding>(*src++);
+    if (null_encoding == kNullBitmap) {
+        uint32_t num_rows = decode_fixed32_le(src);
+        src += sizeof(uint32_t);
+        auto& null_data = nullable->null_column_data();
+        null_data.resize(num_rows);
+        SIMD::bitmap_to_bytes(src, num_rows, null_data.data());
+        src += (num_rows + 7) / 8;
+        src = decode(src, nullable->mutable_data_column());
+    } else {
+        DCHECK_EQ(kNoNull, null_encoding);
+        src = decode(src, nullable->mutable_data_column());
+        nullable->mutable_null_column()->resize(nullable->data_column()->size());
+    }
+    nullable->update_has_null();
+    DCHECK_EQ(nullable->null_column()->size(), nullable->data_column()->size());
+    return src;
+}
+
+const uint8_t* ColumnEncoder::_decode_binary(const uint8_t* src, Column* column) {
+    if (!column->is_binary()) {
+        // e.g. the strings of a DictColumn.
+        auto binary = BinaryColumn::create();
+        src = _decode_binary(src, binary.get());
+        column->append(*binary, 0, binary->size());
+        return src;
+    }
+    auto* binary = down_cast<BinaryColumn*>(column);
+    uint32_t num_rows = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+    uint8_t width = *src++;
+
+    auto& offsets = binary->get_offset();
+    const size_t old_rows = offsets.size() - 1;
+    offsets.resize(old_rows + num_rows + 1);
+    src = for_each_packed(src, num_rows, width, [&](size_t i, uint32_t length) {
+        offsets[old_rows + i + 1] = offsets[old_rows + i] + length;
+    });
+
+    uint32_t bytes_size = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+    auto& bytes = binary->get_bytes();
+    bytes.insert(bytes.end(), src, src + bytes_size);
+    binary->invalidate_slice_cache();
+    DCHECK_EQ(bytes.size(), offsets.back());
+    return src + bytes_size;
+}
+
+const uint8_t* ColumnEncoder::_decode_dict(const uint8_t* src, Column* column) {
+    uint32_t num_rows = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+    auto dict = BinaryColumn::create();
+    src = decode(src, dict.get());
+    uint8_t width = *src++;
+    std::vector<uint32_t> codes(num_rows);
+    src = for_each_packed(src, num_rows, width, [&](size_t i, uint32_t code) { codes[i] = code; });
+    column->append_selective(*dict, codes.data(), 0, num_rows);
+    return src;
+}
+
+} // namespace starrocks::vectorized
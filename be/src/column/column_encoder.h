@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "column/column.h"
+
+namespace starrocks::vectorized {
+
+// The encodings of the columns in the version 2 of the serialized chunks, for the exchanges and the spills.
+// A column is encoded as its 1-byte encoding followed by the payload:
+//   kPlain:    the payload of Column::serialize_column(), for the fixed width values, which are decoded by a memcpy
+//              into the column, and the types without a specific encoding.
+//   kConstant: num_rows(4 byte), followed by the column of the first row encoded. For the constant columns and the
+//              columns of the same rows, e.g. all nulls.
+//   kNullable: the null flags as kNoNull, or as kNullBitmap followed by num_rows(4 byte) and the bitmap of the
+//              flags, then the data column encoded.
+//   kBinary:   num_rows(4 byte), the width(1 byte) and the lengths of the strings in the width of 1, 2 or 4 bytes,
+//              i.e. the deltas of the offsets, then bytes_size(4 byte) and the bytes of the strings.
+//   kDict:     num_rows(4 byte), the distinct strings encoded as kBinary, then the width(1 byte) and the codes of
+//              the rows in the width of 1, 2 or 4 bytes. For the DictColumns and, if config::chunk_serde_dict_encoding,
+//              the binary columns of few distinct strings.
+class ColumnEncoder {
+public:
+    enum Encoding : uint8_t { kPlain = 0, kConstant = 1, kNullable = 2, kBinary = 3, kDict = 4 };
+
+    enum NullEncoding : uint8_t { kNoNull = 0, kNullBitmap = 1 };
+
+    // Append |column| encoded to |dst|.
+    static void encode(const Column& column, std::string* dst);
+
+    // Decode a column into |column|, an empty column of the type of the column encoded, e.g. created by
+    // ColumnHelper::create_column() by the chunk meta. Return the end of the column encoded.
+    static const uint8_t* decode(const uint8_t* src, Column* column);
+
+private:
+    static void _encode_constant(const Column& data_column, size_t num_rows, std::string* dst);
+    static void _encode_nullable(const Column& column, std::string* dst);
+    static void _encode_plain(const Column& column, std::string* dst);
+
+    static const uint8_t* _decode_constant(const uint8_t* src, Column* column);
+    static const uint8_t* _decode_nullable(const uint8_t* src, Column* column);
+    static const uint8_t* _decode_binary(const uint8_t* src, Column* column);
+    static const uint8_t* _decode_dict(const uint8_t* src, Column* column);
+
+    // Whether the rows of |column| are the same, so it could be encoded as a constant.
+    static bool _is_constant(const Column& column);
+};
+
+} // namespace starrocks::vectorized
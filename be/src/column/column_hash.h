@@ -219,4 +219,15 @@ public:
     std::size_t operator()(T value) const { return phmap_mix_with_seed<sizeof(size_t), seed>()(std::hash<T>()(value)); }
 };
 
+// std::hash of 128 bits integers only takes the low 64 bits, so both halves are mixed here.
+template <PhmapSeed seed>
+class UInt128HashWithSeed {
+public:
+    std::size_t operator()(uint128_t value) const {
+        auto low = static_cast<uint64_t>(value);
+        auto high = static_cast<uint64_t>(value >> 64u);
+        return phmap_mix_with_seed<sizeof(size_t), seed>()(low ^ phmap_mix<sizeof(size_t)>()(high));
+    }
+};
+
 } // namespace starrocks::vectorized
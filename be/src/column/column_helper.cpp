@@ -5,10 +5,14 @@
 #include <runtime/types.h>
 
 #include "column/array_column.h"
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 #include "common/config.h"
 #include "gutil/casts.h"
 #include "runtime/types.h"
 #include "simd/simd.h"
+#include "util/memcmp.h"
 
 namespace starrocks::vectorized {
 
@@ -93,6 +97,70 @@ void ColumnHelper::merge_two_filters(Column::Filter* __restrict filter, const ui
     }
 }
 
+template <typename T>
+static void mark_adjacent_differences_of(const T* __restrict data, size_t from, size_t to,
+                                         uint8_t* __restrict differences) {
+    for (size_t i = from; i < to; ++i) {
+        differences[i - from] |= data[i] != data[i - 1];
+    }
+}
+
+void ColumnHelper::mark_adjacent_differences(const Column& column, size_t from, size_t to, uint8_t* differences) {
+    DCHECK_GT(from, 0);
+    if (from >= to || column.is_constant()) {
+        return;
+    }
+    if (column.is_nullable()) {
+        const auto& nullable = down_cast<const NullableColumn&>(column);
+        if (!nullable.has_null()) {
+            mark_adjacent_differences(*nullable.data_column(), from, to, differences);
+            return;
+        }
+        // The data of the null rows are ignored.
+        Column::Filter data_differences(to - from, 0);
+        mark_adjacent_differences(*nullable.data_column(), from, to, data_differences.data());
+        const uint8_t* nulls = nullable.immutable_null_column_data().data();
+        for (size_t i = from; i < to; ++i) {
+            differences[i - from] |= (nulls[i] != nulls[i - 1]) | (!nulls[i] & data_differences[i - from]);
+        }
+        return;
+    }
+    if (column.is_binary()) {
+        const auto& binary = down_cast<const BinaryColumn&>(column);
+        Slice prev = binary.get_slice(from - 1);
+        for (size_t i = from; i < to; ++i) {
+            Slice cur = binary.get_slice(i);
+            differences[i - from] |= !memequal(prev.data, prev.size, cur.data, cur.size);
+            prev = cur;
+        }
+        return;
+    }
+    // The equal values of the integers, decimals, dates and datetimes are the equal bytes, but not of the floats,
+    // e.g. 0.0 and -0.0.
+    bool is_float = dynamic_cast<const FloatColumn*>(&column) != nullptr ||
+                    dynamic_cast<const DoubleColumn*>(&column) != nullptr;
+    if ((column.is_numeric() || column.is_decimal() || column.is_date() || column.is_timestamp()) && !is_float) {
+        const uint8_t* data = column.raw_data();
+        switch (column.type_size()) {
+        case sizeof(uint8_t):
+            return mark_adjacent_differences_of(data, from, to, differences);
+        case sizeof(uint16_t):
+            return mark_adjacent_differences_of(reinterpret_cast<const uint16_t*>(data), from, to, differences);
+        case sizeof(uint32_t):
+            return mark_adjacent_differences_of(reinterpret_cast<const uint32_t*>(data), from, to, differences);
+        case sizeof(uint64_t):
+            return mark_adjacent_differences_of(reinterpret_cast<const uint64_t*>(data), from, to, differences);
+        case sizeof(uint128_t):
+            return mark_adjacent_differences_of(reinterpret_cast<const uint128_t*>(data), from, to, differences);
+        default:
+            break;
+        }
+    }
+    for (size_t i = from; i < to; ++i) {
+        differences[i - from] |= column.compare_at(i - 1, i, column, 1) != 0;
+    }
+}
+
 size_t ColumnHelper::count_nulls(const starrocks::vectorized::ColumnPtr& col) {
     if (!col->is_nullable()) {
         return 0;
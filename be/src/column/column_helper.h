@@ -11,6 +11,7 @@
 #include "gutil/bits.h"
 #include "gutil/casts.h"
 #include "runtime/primitive_type.h"
+#include "simd/simd.h"
 
 namespace starrocks {
 struct TypeDescriptor;
@@ -171,52 +172,7 @@ public:
     static size_t compute_bytes_size(ColumnsConstIterator const& begin, ColumnsConstIterator const& end);
     template <typename T>
     static size_t filter_range(const Column::Filter& filter, T* data, size_t from, size_t to) {
-        auto start_offset = from;
-        auto result_offset = from;
-
-#ifdef __AVX2__
-        const uint8_t* f_data = filter.data();
-        size_t data_type_size = sizeof(T);
-
-        constexpr size_t kBatchNums = 256 / (8 * sizeof(uint8_t));
-        const __m256i all0 = _mm256_setzero_si256();
-
-        while (start_offset + kBatchNums < to) {
-            __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(f_data + start_offset));
-            uint32_t mask = _mm256_movemask_epi8(_mm256_cmpgt_epi8(f, all0));
-
-            if (mask == 0) {
-                // all no hit, pass
-            } else if (mask == 0xffffffff) {
-                // all hit, copy all
-                memmove(data + result_offset, data + start_offset, kBatchNums * data_type_size);
-                result_offset += kBatchNums;
-
-            } else {
-                // skip not hit row, it's will reduce compare when filter layout is sparse,
-                // like "00010001...", but is ineffective when the filter layout is dense.
-                int zero_count = Bits::CountTrailingZerosNonZero32(mask);
-                int i = zero_count;
-                while (i < kBatchNums) {
-                    mask = zero_count < 31 ? mask >> (zero_count + 1u) : 0;
-                    *(data + result_offset) = *(data + start_offset + i);
-                    zero_count = Bits::CountTrailingZeros32(mask);
-                    result_offset += 1;
-                    i += (zero_count + 1);
-                }
-            }
-
-            start_offset += kBatchNums;
-        }
-#endif
-        for (auto i = start_offset; i < to; ++i) {
-            if (filter[i]) {
-                *(data + result_offset) = *(data + i);
-                result_offset++;
-            }
-        }
-
-        return result_offset;
+        return SIMD::filter_range(filter.data(), data, from, to);
     }
 
     template <typename T>
@@ -226,6 +182,11 @@ public:
 
     static ColumnPtr create_const_null_column(size_t chunk_size);
 
+    // Set differences[i - from] to 1 if the rows i - 1 and i of |column| aren't equal, for each row i in
+    // [from, to), |from| should be positive. The equal rows are left as they are, so the differences of several
+    // columns could be merged into one boundary bitmap. Two nulls are equal.
+    static void mark_adjacent_differences(const Column& column, size_t from, size_t to, uint8_t* differences);
+
     static NullColumnPtr one_size_not_null_column;
 
     static NullColumnPtr one_size_null_column;
@@ -21,6 +21,7 @@ DIAGNOSTIC_POP
 #include "common/config.h"
 #include "common/type_list.h"
 #include "gutil/dynamic_annotations.h"
+#include "util/cpu_info.h"
 
 namespace starrocks::vectorized {
 
@@ -119,14 +120,14 @@ class CACHELINE_ALIGNED ColumnPool {
         static_assert(std::is_base_of<Column, T>::value, "Must_be_derived_of_Column");
 
     public:
-        explicit LocalPool(ColumnPool* pool) : _pool(pool) {
+        explicit LocalPool(ColumnPool* pool) : _pool(pool), _numa_node(pool->_current_numa_node()) {
             _curr_free.nfree = 0;
             _curr_free.bytes = 0;
         }
 
         ~LocalPool() {
             auto freed_bytes = _curr_free.bytes;
-            if (_curr_free.nfree > 0 && !_pool->_push_free_block(_curr_free)) {
+            if (_curr_free.nfree > 0 && !_pool->_push_free_block(_curr_free, _numa_node)) {
                 for (size_t i = 0; i < _curr_free.nfree; i++) {
                     ASAN_UNPOISON_MEMORY_REGION(_curr_free.ptrs[i], sizeof(T));
                     delete _curr_free.ptrs[i];
@@ -138,7 +139,7 @@ class CACHELINE_ALIGNED ColumnPool {
 
         inline T* get_object() {
             if (_curr_free.nfree == 0) {
-                if (_pool->_pop_free_block(&_curr_free)) {
+                if (_pool->_pop_free_block(&_curr_free, _numa_node)) {
                     UPDATE_BVAR(g_column_pool_total_local_bytes, _curr_free.bytes);
                 } else {
                     return nullptr;
@@ -166,7 +167,7 @@ class CACHELINE_ALIGNED ColumnPool {
                 UPDATE_BVAR(g_column_pool_total_local_bytes, bytes);
                 return;
             }
-            if (_pool->_push_free_block(_curr_free)) {
+            if (_pool->_push_free_block(_curr_free, _numa_node)) {
                 ASAN_POISON_MEMORY_REGION(ptr, sizeof(T));
                 UPDATE_BVAR(g_column_pool_total_local_bytes, -_curr_free.bytes);
                 _curr_free.nfree = 1;
@@ -193,6 +194,8 @@ class CACHELINE_ALIGNED ColumnPool {
 
     private:
         ColumnPool* _pool;
+        // the NUMA node of the thread when the pool is created
+        const int _numa_node;
         FreeBlock _curr_free;
     };
 
@@ -233,10 +236,12 @@ public:
         std::vector<DynamicFreeBlock*> tmp;
         if (now - _first_push_time > 3) {
             //    ^^^^^^^^^^^^^^^^ read without lock by intention.
-            std::lock_guard<std::mutex> l(_free_blocks_lock);
-            int n = implicit_cast<int>(_free_blocks.size() * (1 - free_ratio));
-            tmp.insert(tmp.end(), _free_blocks.begin() + n, _free_blocks.end());
-            _free_blocks.resize(n);
+            for (auto& node : _nodes) {
+                std::lock_guard<std::mutex> l(node->free_blocks_lock);
+                int n = implicit_cast<int>(node->free_blocks.size() * (1 - free_ratio));
+                tmp.insert(tmp.end(), node->free_blocks.begin() + n, node->free_blocks.end());
+                node->free_blocks.resize(n);
+            }
         }
         size_t freed_bytes = 0;
         for (DynamicFreeBlock* blk : tmp) {
@@ -268,18 +273,33 @@ public:
     inline ColumnPoolInfo describe_column_pool() {
         ColumnPoolInfo info;
         info.local_cnt = _nlocal.load(std::memory_order_relaxed);
-        if (_free_blocks.empty()) {
-            return info;
-        }
-        std::lock_guard<std::mutex> l(_free_blocks_lock);
-        for (DynamicFreeBlock* blk : _free_blocks) {
-            info.central_free_items += blk->nfree;
-            info.central_free_bytes += blk->bytes;
+        for (auto& node : _nodes) {
+            if (node->free_blocks.empty()) {
+                continue;
+            }
+            std::lock_guard<std::mutex> l(node->free_blocks_lock);
+            for (DynamicFreeBlock* blk : node->free_blocks) {
+                info.central_free_items += blk->nfree;
+                info.central_free_bytes += blk->bytes;
+            }
         }
         return info;
     }
 
 private:
+    // The central free blocks of a NUMA node.
+    struct CACHELINE_ALIGNED NodeFreeBlocks {
+        NodeFreeBlocks() { free_blocks.reserve(32); }
+
+        std::mutex free_blocks_lock;
+        std::vector<DynamicFreeBlock*> free_blocks;
+    };
+
+    inline int _current_numa_node() const {
+        const int num_nodes = static_cast<int>(_nodes.size());
+        return num_nodes > 1 ? CpuInfo::get_numa_node_of_core(CpuInfo::get_current_core()) % num_nodes : 0;
+    }
+
     static inline void _release_free_block(DynamicFreeBlock* blk) {
         for (size_t i = 0; i < blk->nfree; i++) {
             T* p = blk->ptrs[i];
@@ -326,7 +346,9 @@ private:
         release_free_columns(1.0);
     }
 
-    inline bool _push_free_block(const FreeBlock& blk) {
+    // The free blocks are pushed to the central list of the NUMA node of the local pool, and popped from it first,
+    // so the threads reuse the columns touched by the threads on the same node.
+    inline bool _push_free_block(const FreeBlock& blk, int numa_node) {
         DynamicFreeBlock* p =
                 (DynamicFreeBlock*)malloc(offsetof(DynamicFreeBlock, ptrs) + sizeof(*blk.ptrs) * blk.nfree);
         if (UNLIKELY(p == nullptr)) {
@@ -336,24 +358,30 @@ private:
         p->nfree = blk.nfree;
         p->bytes = blk.bytes;
         memcpy(p->ptrs, blk.ptrs, sizeof(*blk.ptrs) * blk.nfree);
-        std::lock_guard<std::mutex> l(_free_blocks_lock);
-        _first_push_time = _free_blocks.empty() ? butil::gettimeofday_s() : _first_push_time;
-        _free_blocks.push_back(p);
+        auto& node = _nodes[numa_node];
+        std::lock_guard<std::mutex> l(node->free_blocks_lock);
+        _first_push_time = node->free_blocks.empty() ? butil::gettimeofday_s() : _first_push_time;
+        node->free_blocks.push_back(p);
         return true;
     }
 
-    inline bool _pop_free_block(FreeBlock* blk) {
-        if (_free_blocks.empty()) {
-            return false;
+    inline bool _pop_free_block(FreeBlock* blk, int numa_node) {
+        const size_t num_nodes = _nodes.size();
+        DynamicFreeBlock* p = nullptr;
+        for (size_t i = 0; i < num_nodes && p == nullptr; i++) {
+            auto& node = _nodes[(numa_node + i) % num_nodes];
+            if (node->free_blocks.empty()) {
+                continue;
+            }
+            std::lock_guard<std::mutex> l(node->free_blocks_lock);
+            if (!node->free_blocks.empty()) {
+                p = node->free_blocks.back();
+                node->free_blocks.pop_back();
+            }
         }
-        _free_blocks_lock.lock();
-        if (_free_blocks.empty()) {
-            _free_blocks_lock.unlock();
+        if (p == nullptr) {
             return false;
         }
-        DynamicFreeBlock* p = _free_blocks.back();
-        _free_blocks.pop_back();
-        _free_blocks_lock.unlock();
         memcpy(blk->ptrs, p->ptrs, sizeof(*p->ptrs) * p->nfree);
         blk->nfree = p->nfree;
         blk->bytes = p->bytes;
@@ -363,7 +391,12 @@ private:
     }
 
 private:
-    ColumnPool() { _free_blocks.reserve(32); }
+    ColumnPool() {
+        const int num_nodes = std::max(CpuInfo::get_max_num_numa_nodes(), 1);
+        for (int i = 0; i < num_nodes; i++) {
+            _nodes.emplace_back(std::make_unique<NodeFreeBlocks>());
+        }
+    }
 
     ~ColumnPool() = default;
 
@@ -371,8 +404,7 @@ private:
     static std::atomic<long> _nlocal;       // NOLINT
     static std::mutex _change_thread_mutex; // NOLINT
 
-    mutable std::mutex _free_blocks_lock;
-    std::vector<DynamicFreeBlock*> _free_blocks;
+    std::vector<std::unique_ptr<NodeFreeBlocks>> _nodes;
     int64_t _first_push_time = 0;
 };
 
@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+
+#include "column/column.h"
+#include "column/vectorized_fwd.h"
+
+namespace starrocks::vectorized {
+
+// Reuses the columns of the chunks returned by a producer, e.g. the result columns of an aggregator, once the
+// consumers are done with them, so a steady pipeline doesn't allocate and free the buffers of every chunk.
+//
+// The ownership: the producer hands the columns of each output chunk to keep() and the consumers hold them as
+// usual. A consumer returns the columns by releasing its references, i.e. by destroying or resetting the chunk, and
+// reuse() hands them back to the producer only when the recycler holds their last references, so the columns kept
+// by a consumer, e.g. shared by the chunk of a projection, are never reset under it. The columns are the ones
+// created by the producer, so they have the types it expects.
+// Not thread safe, it's used by the producer only.
+class ColumnRecycler {
+public:
+    static constexpr size_t kDefaultCapacity = 2;
+
+    explicit ColumnRecycler(size_t capacity = kDefaultCapacity) : _capacity(capacity) {}
+
+    // Keep the columns of an output chunk, the oldest ones are released if there are more than |capacity|
+    // chunks kept.
+    void keep(Columns columns) {
+        if (_capacity == 0 || columns.empty()) {
+            return;
+        }
+        if (_kept.size() >= _capacity) {
+            _kept.pop_front();
+        }
+        _kept.emplace_back(std::move(columns));
+    }
+
+    // Return the columns of the oldest kept chunk released by the consumers, which are reset with their capacity
+    // kept, or false if there is none.
+    bool reuse(Columns* columns) {
+        for (auto iter = _kept.begin(); iter != _kept.end(); ++iter) {
+            if (_is_released(*iter)) {
+                // Pairs with the release of the consumers' references, their accesses happen before the reset.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                *columns = std::move(*iter);
+                _kept.erase(iter);
+                for (auto& column : *columns) {
+                    column->reset_column();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t num_kept() const { return _kept.size(); }
+
+    void clear() { _kept.clear(); }
+
+private:
+    static bool _is_released(const Columns& columns) {
+        for (const auto& column : columns) {
+            if (column.use_count() != 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const size_t _capacity;
+    std::deque<Columns> _kept;
+};
+
+} // namespace starrocks::vectorized
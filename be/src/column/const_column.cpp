@@ -45,6 +45,13 @@ void ConstColumn::crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) const {
     DCHECK(false) << "Const column shouldn't call crc32 hash";
 }
 
+void ConstColumn::crc32c_hash(uint32_t* hash, uint16_t from, uint16_t to) const {
+    DCHECK(_size > 0);
+    for (uint16_t i = from; i < to; ++i) {
+        _data->crc32c_hash(&hash[i], 0, 1);
+    }
+}
+
 size_t ConstColumn::filter_range(const Column::Filter& filter, size_t from, size_t to) {
     size_t count = SIMD::count_nonzero(&filter[from], to - from);
     this->resize(from + count);
@@ -169,6 +169,8 @@ public:
 
     void crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
 
+    void crc32c_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
+
     void put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const override { _data->put_mysql_row_buffer(buf, 0); }
 
     std::string get_name() const override { return "const-" + _data->get_name(); }
@@ -0,0 +1,275 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/dict_column.h"
+
+#include <sstream>
+
+#include "common/compiler_util.h"
+#include "gutil/casts.h"
+#include "gutil/strings/fastmem.h"
+#include "util/hash_util.hpp"
+#include "util/mysql_row_buffer.h"
+
+namespace starrocks::vectorized {
+
+ColumnDict::ColumnDict(BinaryColumn::Ptr strings) : _strings(std::move(strings)), _slices(_strings->get_data()) {
+    for (size_t i = 1; i < _slices.size() && _sorted; i++) {
+        _sorted = _slices[i - 1].compare(_slices[i]) < 0;
+    }
+}
+
+int32_t ColumnDict::find(const Slice& value) const {
+    std::call_once(_index_once, [this]() {
+        _index.reserve(_slices.size());
+        for (size_t code = 0; code < _slices.size(); code++) {
+            _index.emplace(_slices[code], static_cast<int32_t>(code));
+        }
+    });
+    auto iter = _index.find(value);
+    return iter == _index.end() ? -1 : iter->second;
+}
+
+ColumnDictPtr ColumnDict::extend(const std::vector<Slice>& values) const {
+    auto strings = BinaryColumn::create();
+    strings->reserve(_slices.size() + values.size(), _strings->get_bytes().size());
+    strings->append(*_strings, 0, _strings->size());
+    [[maybe_unused]] bool ok = strings->append_strings(values);
+    return std::make_shared<ColumnDict>(std::move(strings));
+}
+
+size_t ColumnDict::memory_usage() const {
+    return _strings->memory_usage() + _index.capacity() * (sizeof(Slice) + sizeof(int32_t));
+}
+
+void DictColumn::_append_strings(const Slice* strs, size_t size) {
+    auto& codes = _codes->get_data();
+    const size_t old_size = codes.size();
+    codes.resize(old_size + size);
+    std::vector<Slice> missing;
+    for (size_t i = 0; i < size; i++) {
+        codes[old_size + i] = _dict->find(strs[i]);
+        if (UNLIKELY(codes[old_size + i] < 0)) {
+            missing.emplace_back(strs[i]);
+        }
+    }
+    if (LIKELY(missing.empty())) {
+        return;
+    }
+
+    // Add the distinct strings out of the dictionary to a copy of it, and find their codes again.
+    phmap::flat_hash_set<Slice, SliceHash, SliceNormalEqual> distinct(missing.begin(), missing.end());
+    std::vector<Slice> values(distinct.begin(), distinct.end());
+    _dict = _dict->extend(values);
+    for (size_t i = 0; i < size; i++) {
+        if (codes[old_size + i] < 0) {
+            codes[old_size + i] = _dict->find(strs[i]);
+        }
+    }
+}
+
+Slice DictColumn::_slice_of(const Column& src, size_t idx) {
+    if (src.low_cardinality()) {
+        return down_cast<const DictColumn&>(src).get_slice(idx);
+    }
+    return down_cast<const BinaryColumn&>(src).get_slice(idx);
+}
+
+void DictColumn::resize(size_t n) {
+    if (n > size()) {
+        append_default(n - size());
+    } else {
+        _codes->resize(n);
+    }
+}
+
+void DictColumn::append(const Column& src, size_t offset, size_t count) {
+    if (_same_dict(src)) {
+        _codes->append(*down_cast<const DictColumn&>(src)._codes, offset, count);
+        return;
+    }
+    std::vector<Slice> strs(count);
+    for (size_t i = 0; i < count; i++) {
+        strs[i] = _slice_of(src, offset + i);
+    }
+    _append_strings(strs.data(), strs.size());
+}
+
+void DictColumn::append_selective(const Column& src, const uint32_t* indexes, uint32_t from, uint32_t size) {
+    if (_same_dict(src)) {
+        _codes->append_selective(*down_cast<const DictColumn&>(src)._codes, indexes, from, size);
+        return;
+    }
+    std::vector<Slice> strs(size);
+    for (uint32_t i = 0; i < size; i++) {
+        strs[i] = _slice_of(src, indexes[from + i]);
+    }
+    _append_strings(strs.data(), strs.size());
+}
+
+void DictColumn::append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) {
+    if (_same_dict(src)) {
+        _codes->append_value_multiple_times(*down_cast<const DictColumn&>(src)._codes, index, size);
+        return;
+    }
+    Slice str = _slice_of(src, index);
+    append_value_multiple_times(&str, size);
+}
+
+void DictColumn::append_value_multiple_times(const void* value, size_t count) {
+    const Slice* str = reinterpret_cast<const Slice*>(value);
+    _append_strings(str, 1);
+    int32_t code = _codes->get_data().back();
+    _codes->get_data().resize(_codes->size() + count - 1, code);
+}
+
+void DictColumn::append_default(size_t count) {
+    if (count == 0) {
+        return;
+    }
+    Slice empty;
+    append_value_multiple_times(&empty, count);
+}
+
+uint32_t DictColumn::max_one_element_serialize_size() const {
+    return _dict->strings().max_one_element_serialize_size();
+}
+
+uint32_t DictColumn::serialize(size_t idx, uint8_t* pos) {
+    Slice str = get_slice(idx);
+    uint32_t binary_size = str.size;
+    strings::memcpy_inlined(pos, &binary_size, sizeof(uint32_t));
+    strings::memcpy_inlined(pos + sizeof(uint32_t), str.data, binary_size);
+    return sizeof(uint32_t) + binary_size;
+}
+
+uint32_t DictColumn::serialize_default(uint8_t* pos) {
+    uint32_t binary_size = 0;
+    strings::memcpy_inlined(pos, &binary_size, sizeof(uint32_t));
+    return sizeof(uint32_t);
+}
+
+void DictColumn::serialize_batch(uint8_t* dst, Buffer<uint32_t>& slice_sizes, size_t chunk_size,
+                                 uint32_t max_one_row_size) {
+    for (size_t i = 0; i < chunk_size; ++i) {
+        slice_sizes[i] += serialize(i, dst + i * max_one_row_size + slice_sizes[i]);
+    }
+}
+
+const uint8_t* DictColumn::deserialize_and_append(const uint8_t* pos) {
+    uint32_t string_size{};
+    strings::memcpy_inlined(&string_size, pos, sizeof(uint32_t));
+    pos += sizeof(uint32_t);
+    Slice str(pos, string_size);
+    _append_strings(&str, 1);
+    return pos + string_size;
+}
+
+void DictColumn::deserialize_and_append_batch(std::vector<Slice>& srcs, size_t batch_size) {
+    for (size_t i = 0; i < batch_size; ++i) {
+        srcs[i].data = (char*)deserialize_and_append((uint8_t*)srcs[i].data);
+    }
+}
+
+uint8_t* DictColumn::serialize_column(uint8_t* dst) {
+    dst = _codes->serialize_column(dst);
+    // serialize_column doesn't change the column.
+    return const_cast<BinaryColumn&>(_dict->strings()).serialize_column(dst);
+}
+
+const uint8_t* DictColumn::deserialize_column(const uint8_t* src) {
+    src = _codes->deserialize_column(src);
+    auto strings = BinaryColumn::create();
+    src = strings->deserialize_column(src);
+    _dict = std::make_shared<ColumnDict>(std::move(strings));
+    return src;
+}
+
+int DictColumn::compare_at(size_t left, size_t right, const Column& rhs, int nan_direction_hint) const {
+    if (_same_dict(rhs)) {
+        int32_t left_code = _codes->get_data()[left];
+        int32_t right_code = down_cast<const DictColumn&>(rhs)._codes->get_data()[right];
+        if (left_code == right_code) {
+            return 0;
+        }
+        if (_dict->is_sorted()) {
+            return left_code < right_code ? -1 : 1;
+        }
+    }
+    return get_slice(left).compare(_slice_of(rhs, right));
+}
+
+void DictColumn::fvn_hash(uint32_t* hashes, uint16_t from, uint16_t to) const {
+    for (uint16_t i = from; i < to; ++i) {
+        Slice str = get_slice(i);
+        hashes[i] = HashUtil::fnv_hash(str.data, str.size, hashes[i]);
+    }
+}
+
+void DictColumn::crc32_hash(uint32_t* hashes, uint16_t from, uint16_t to) const {
+    for (uint16_t i = from; i < to; ++i) {
+        Slice str = get_slice(i);
+        // keep hash of the empty strings, like BinaryColumn.
+        if (str.size > 0) {
+            hashes[i] = HashUtil::zlib_crc_hash(str.data, str.size, hashes[i]);
+        }
+    }
+}
+
+void DictColumn::crc32c_hash(uint32_t* hashes, uint16_t from, uint16_t to) const {
+    for (uint16_t i = from; i < to; ++i) {
+        Slice str = get_slice(i);
+        hashes[i] = crc_hash_32(str.data, str.size, hashes[i]);
+    }
+}
+
+void DictColumn::put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const {
+    Slice str = get_slice(idx);
+    buf->push_string(str.data, str.size);
+}
+
+BinaryColumn::Ptr DictColumn::materialize() const {
+    const auto& codes = _codes->get_data();
+    size_t bytes_size = 0;
+    for (int32_t code : codes) {
+        bytes_size += _dict->get(code).size;
+    }
+    auto result = BinaryColumn::create();
+    auto& bytes = result->get_bytes();
+    auto& offsets = result->get_offset();
+    bytes.resize(bytes_size);
+    offsets.resize(codes.size() + 1);
+    size_t offset = 0;
+    for (size_t i = 0; i < codes.size(); i++) {
+        Slice str = _dict->get(codes[i]);
+        strings::memcpy_inlined(bytes.data() + offset, str.data, str.size);
+        offset += str.size;
+        offsets[i + 1] = offset;
+    }
+    result->invalidate_slice_cache();
+    return result;
+}
+
+std::string DictColumn::debug_item(uint32_t idx) const {
+    std::string s;
+    auto slice = get_slice(idx);
+    s.reserve(slice.size + 2);
+    s.push_back('\'');
+    s.append(slice.data, slice.size);
+    s.push_back('\'');
+    return s;
+}
+
+std::string DictColumn::debug_string() const {
+    std::stringstream ss;
+    ss << "[";
+    for (size_t i = 0; i < size(); ++i) {
+        if (i > 0) {
+            ss << ", ";
+        }
+        ss << debug_item(i);
+    }
+    ss << "]";
+    return ss.str();
+}
+
+} // namespace starrocks::vectorized
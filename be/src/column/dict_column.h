@@ -0,0 +1,230 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <mutex>
+
+#include "column/binary_column.h"
+#include "column/column.h"
+#include "column/column_hash.h"
+#include "column/fixed_length_column.h"
+#include "util/phmap/phmap.h"
+
+namespace starrocks::vectorized {
+
+// The dictionary of DictColumns, the code of a string is its index in the dictionary. A dictionary is immutable and
+// shared by the columns of the same strings, e.g. all the chunks decoded from the dictionary page of a segment
+// column, so the columns of a dictionary could be compared, hashed and grouped by their codes. The strings of a
+// dictionary must be distinct.
+class ColumnDict {
+public:
+    explicit ColumnDict(BinaryColumn::Ptr strings);
+
+    size_t size() const { return _slices.size(); }
+
+    Slice get(int32_t code) const { return _slices[code]; }
+
+    const BinaryColumn& strings() const { return *_strings; }
+
+    // Whether the strings are ascending, then the order of the codes is the order of the strings.
+    bool is_sorted() const { return _sorted; }
+
+    // Return the code of |value|, or -1 if it's not in the dictionary.
+    int32_t find(const Slice& value) const;
+
+    // Return a new dictionary of the strings of this one followed by |values|, which are not in this one.
+    std::shared_ptr<const ColumnDict> extend(const std::vector<Slice>& values) const;
+
+    size_t memory_usage() const;
+
+private:
+    BinaryColumn::Ptr _strings;
+    const Buffer<Slice>& _slices;
+    bool _sorted = true;
+
+    // Built on the first find(), the columns of a dictionary may be appended by several threads.
+    mutable std::once_flag _index_once;
+    mutable phmap::flat_hash_map<Slice, int32_t, SliceHash, SliceNormalEqual> _index;
+};
+
+using ColumnDictPtr = std::shared_ptr<const ColumnDict>;
+
+// A low cardinality string column, which holds the int codes of the strings of a shared dictionary. The filters,
+// hashes, comparisons and serialization work on the codes and the dictionary, the strings are materialized by
+// materialize() only for the expressions that need them.
+// The strings appended out of the dictionary, e.g. from a BinaryColumn or a DictColumn of another dictionary, are
+// added to a copy of the dictionary, so these columns are expected to be appended mostly by the codes.
+class DictColumn final : public ColumnFactory<Column, DictColumn> {
+    friend class ColumnFactory<Column, DictColumn>;
+
+public:
+    using ValueType = Slice;
+
+    explicit DictColumn(ColumnDictPtr dict) : _codes(Int32Column::create()), _dict(std::move(dict)) {}
+
+    DictColumn(Int32Column::Ptr codes, ColumnDictPtr dict) : _codes(std::move(codes)), _dict(std::move(dict)) {}
+
+    // Copy constructor, the dictionary is shared.
+    DictColumn(const DictColumn& rhs)
+            : _codes(std::static_pointer_cast<Int32Column>(rhs._codes->clone_shared())), _dict(rhs._dict) {}
+
+    // Move constructor
+    DictColumn(DictColumn&& rhs) noexcept : _codes(std::move(rhs._codes)), _dict(std::move(rhs._dict)) {}
+
+    // Copy assignment
+    DictColumn& operator=(const DictColumn& rhs) {
+        DictColumn tmp(rhs);
+        this->swap_column(tmp);
+        return *this;
+    }
+
+    // Move assignment
+    DictColumn& operator=(DictColumn&& rhs) {
+        DictColumn tmp(std::move(rhs));
+        this->swap_column(tmp);
+        return *this;
+    }
+
+    ~DictColumn() override = default;
+
+    bool low_cardinality() const override { return true; }
+
+    const uint8_t* raw_data() const override { return _codes->raw_data(); }
+
+    uint8_t* mutable_raw_data() override { return _codes->mutable_raw_data(); }
+
+    size_t size() const override { return _codes->size(); }
+
+    size_t type_size() const override { return sizeof(int32_t); }
+
+    size_t byte_size() const override { return _codes->byte_size(); }
+
+    size_t byte_size(size_t idx) const override { return sizeof(int32_t); }
+
+    void reserve(size_t n) override { _codes->reserve(n); }
+
+    void resize(size_t n) override;
+
+    void assign(size_t n, size_t idx) override { _codes->assign(n, idx); }
+
+    void append_datum(const Datum& datum) override { _append_strings(&datum.get_slice(), 1); }
+
+    void remove_first_n_values(size_t count) override { _codes->remove_first_n_values(count); }
+
+    void append(const Column& src, size_t offset, size_t count) override;
+
+    void append_selective(const Column& src, const uint32_t* indexes, uint32_t from, uint32_t size) override;
+
+    void append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) override;
+
+    bool append_nulls(size_t count) override { return false; }
+
+    bool append_strings(const std::vector<Slice>& strs) override {
+        _append_strings(strs.data(), strs.size());
+        return true;
+    }
+
+    size_t append_numbers(const void* buff, size_t length) override { return -1; }
+
+    void append_value_multiple_times(const void* value, size_t count) override;
+
+    void append_default() override { append_default(1); }
+
+    void append_default(size_t count) override;
+
+    // The rows are serialized like BinaryColumn, so they could be deserialized by a BinaryColumn.
+    uint32_t max_one_element_serialize_size() const override;
+
+    uint32_t serialize(size_t idx, uint8_t* pos) override;
+
+    uint32_t serialize_default(uint8_t* pos) override;
+
+    void serialize_batch(uint8_t* dst, Buffer<uint32_t>& slice_sizes, size_t chunk_size,
+                         uint32_t max_one_row_size) override;
+
+    const uint8_t* deserialize_and_append(const uint8_t* pos) override;
+
+    void deserialize_and_append_batch(std::vector<Slice>& srcs, size_t batch_size) override;
+
+    uint32_t serialize_size(size_t idx) const override { return sizeof(uint32_t) + get_slice(idx).size; }
+
+    // The column is serialized as its codes followed by the strings of its dictionary.
+    size_t serialize_size() const override { return _codes->serialize_size() + _dict->strings().serialize_size(); }
+
+    uint8_t* serialize_column(uint8_t* dst) override;
+
+    const uint8_t* deserialize_column(const uint8_t* src) override;
+
+    MutableColumnPtr clone_empty() const override { return create_mutable(_dict); }
+
+    size_t filter_range(const Column::Filter& filter, size_t from, size_t to) override {
+        return _codes->filter_range(filter, from, to);
+    }
+
+    // |rhs| is a DictColumn or a BinaryColumn, the rows of the same dictionary are compared by their codes if it
+    // is sorted.
+    int compare_at(size_t left, size_t right, const Column& rhs, int nan_direction_hint) const override;
+
+    // The hashes are the ones of the strings, like BinaryColumn.
+    void fvn_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
+
+    void crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
+
+    void crc32c_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
+
+    void put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const override;
+
+    std::string get_name() const override { return "dict"; }
+
+    Datum get(size_t n) const override { return Datum(get_slice(n)); }
+
+    Slice get_slice(size_t idx) const { return _dict->get(_codes->get_data()[idx]); }
+
+    const Int32Column::Container& codes() const { return _codes->get_data(); }
+
+    const Int32Column::Ptr& codes_column() const { return _codes; }
+
+    const ColumnDictPtr& dict() const { return _dict; }
+
+    // The strings of the rows.
+    BinaryColumn::Ptr materialize() const;
+
+    // The dictionary is shared, so only the codes are counted.
+    size_t container_memory_usage() const override { return _codes->container_memory_usage(); }
+
+    size_t shrink_memory_usage() const override { return _codes->shrink_memory_usage(); }
+
+    void swap_column(Column& rhs) override {
+        auto& r = down_cast<DictColumn&>(rhs);
+        using std::swap;
+        swap(_delete_state, r._delete_state);
+        swap(_codes, r._codes);
+        swap(_dict, r._dict);
+    }
+
+    void reset_column() override {
+        Column::reset_column();
+        _codes->reset_column();
+    }
+
+    std::string debug_item(uint32_t idx) const override;
+
+    std::string debug_string() const override;
+
+private:
+    // Append the codes of |strs|, the strings out of the dictionary are added to a copy of it.
+    void _append_strings(const Slice* strs, size_t size);
+
+    // The slice of the row |idx| of |src|, which is a DictColumn or a BinaryColumn.
+    static Slice _slice_of(const Column& src, size_t idx);
+
+    // Whether the codes of |src| could be appended as is.
+    bool _same_dict(const Column& src) const {
+        return src.low_cardinality() && down_cast<const DictColumn&>(src)._dict == _dict;
+    }
+
+    Int32Column::Ptr _codes;
+    ColumnDictPtr _dict;
+};
+
+} // namespace starrocks::vectorized
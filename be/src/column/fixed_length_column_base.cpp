@@ -2,10 +2,12 @@
 
 #include <gutil/strings/fastmem.h>
 
+#include "column/column_hash.h"
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "gutil/casts.h"
 #include "runtime/large_int_value.h"
+#include "simd/simd.h"
 #include "storage/decimal12.h"
 #include "storage/uint24.h"
 #include "util/coding.h"
@@ -27,9 +29,7 @@ void FixedLengthColumnBase<T>::append_selective(const Column& src, const uint32_
     const T* src_data = reinterpret_cast<const T*>(src.raw_data());
     size_t orig_size = _data.size();
     _data.resize(orig_size + size);
-    for (size_t i = 0; i < size; ++i) {
-        _data[orig_size + i] = src_data[indexes[from + i]];
-    }
+    SIMD::gather(src_data, indexes + from, size, _data.data() + orig_size);
 }
 
 template <typename T>
@@ -176,6 +176,13 @@ void FixedLengthColumnBase<T>::crc32_hash(uint32_t* hash, uint16_t from, uint16_
     }
 }
 
+template <typename T>
+void FixedLengthColumnBase<T>::crc32c_hash(uint32_t* hash, uint16_t from, uint16_t to) const {
+    for (uint16_t i = from; i < to; ++i) {
+        hash[i] = crc_hash_32(&_data[i], sizeof(ValueType), hash[i]);
+    }
+}
+
 template <typename T>
 void FixedLengthColumnBase<T>::put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const {
     if constexpr (IsDecimal<T>) {
@@ -155,6 +155,8 @@ public:
 
     void crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
 
+    void crc32c_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
+
     void put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const override;
 
     std::string get_name() const override;
@@ -0,0 +1,222 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "column/column_hash.h"
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+// The sets of the constant values of the IN predicates, which are built once and only probed afterwards.
+// Compared to the hash sets, they're cheaper to probe for the value sets of some shapes:
+//  - FixedArraySet: at most N values, compared with all N slots without branches, which could be vectorized.
+//  - DenseBitmapSet: the integers in a small range, one bit per integer in [min, max].
+//  - SlicePerfectHashSet: the strings, probed by one hash and at most one comparison.
+// The init() of each set returns false if the values don't fit the set, and the hash set should be used then.
+
+template <typename T, size_t N>
+class FixedArraySet {
+public:
+    using value_type = T;
+    using const_iterator = const T*;
+
+    static constexpr size_t kMaxSize = N;
+
+    bool init(const std::vector<T>& values) {
+        if (values.empty() || values.size() > N) {
+            return false;
+        }
+        std::copy(values.begin(), values.end(), _values.begin());
+        // The unused slots are filled with the first value, so all the slots could be compared.
+        std::fill(_values.begin() + values.size(), _values.end(), values[0]);
+        _size = values.size();
+        return true;
+    }
+
+    bool contains(const T& v) const {
+        bool found = false;
+        for (size_t i = 0; i < N; i++) {
+            found |= (v == _values[i]);
+        }
+        return found;
+    }
+
+    size_t size() const { return _size; }
+    const_iterator begin() const { return _values.data(); }
+    const_iterator end() const { return _values.data() + _size; }
+
+private:
+    std::array<T, N> _values{};
+    size_t _size = 0;
+};
+
+template <typename T>
+class DenseBitmapSet {
+public:
+    using value_type = T;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    static constexpr bool is_supported = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+    // 8KB at most, which always stays in the L1 cache.
+    static constexpr uint64_t kMaxBits = 64 * 1024;
+
+    bool init(const std::vector<T>& values) {
+        if constexpr (!is_supported) {
+            return false;
+        } else {
+            if (values.empty()) {
+                return false;
+            }
+            auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+            uint64_t range = static_cast<UnsignedT>(*max_it) - static_cast<UnsignedT>(*min_it);
+            if (range >= kMaxBits) {
+                return false;
+            }
+            _min = *min_it;
+            _range = range;
+            // One more zero bit after max for all the values out of range.
+            _bits.assign((range + 1) / 64 + 1, 0);
+            for (const T& v : values) {
+                uint64_t offset = _offset(v);
+                _bits[offset / 64] |= uint64_t(1) << (offset % 64);
+            }
+            _values = values;
+            return true;
+        }
+    }
+
+    bool contains(const T& v) const {
+        uint64_t offset = _offset(v);
+        offset = offset <= _range ? offset : _range + 1;
+        return (_bits[offset / 64] >> (offset % 64)) & 1;
+    }
+
+    size_t size() const { return _values.size(); }
+    const_iterator begin() const { return _values.begin(); }
+    const_iterator end() const { return _values.end(); }
+
+private:
+    using UnsignedT = std::make_unsigned_t<std::conditional_t<is_supported, T, int>>;
+
+    // The values less than min wrap around to the offsets larger than the range.
+    uint64_t _offset(const T& v) const {
+        return static_cast<UnsignedT>(static_cast<UnsignedT>(v) - static_cast<UnsignedT>(_min));
+    }
+
+    T _min{};
+    uint64_t _range = 0;
+    std::vector<uint64_t> _bits;
+    std::vector<T> _values;
+};
+
+// A two level perfect hash: the values are distributed into the buckets by their hashes, and the k values of
+// each bucket are then placed into k * k slots by a per-bucket seed without collisions, which takes about
+// two slots per value in total.
+class SlicePerfectHashSet {
+public:
+    using value_type = Slice;
+    using const_iterator = std::vector<Slice>::const_iterator;
+
+    static constexpr size_t kMaxSize = 4096;
+
+    // The duplicated values should have been removed, and the memory of the values should outlive the set.
+    bool init(const std::vector<Slice>& values) {
+        if (values.empty() || values.size() > kMaxSize) {
+            return false;
+        }
+        const size_t num_values = values.size();
+        std::vector<uint64_t> hashes(num_values);
+        std::vector<std::vector<uint32_t>> bucket_values(num_values);
+        for (size_t i = 0; i < num_values; i++) {
+            hashes[i] = _hash(values[i]);
+            bucket_values[_bucket(hashes[i], num_values)].emplace_back(i);
+        }
+
+        _buckets.assign(num_values, Bucket());
+        // The first slot is always empty, the empty buckets point to it.
+        _slots.assign(1, Slice());
+        _occupied.assign(1, 0);
+        std::vector<uint32_t> bucket_slots;
+        for (size_t b = 0; b < num_values; b++) {
+            const auto& ids = bucket_values[b];
+            if (ids.empty()) {
+                continue;
+            }
+            uint32_t num_slots = ids.size() * ids.size();
+            uint32_t seed = 0;
+            for (; seed < kMaxSeedTrials; seed++) {
+                bucket_slots.clear();
+                for (uint32_t id : ids) {
+                    bucket_slots.emplace_back(_slot(hashes[id], seed, num_slots));
+                }
+                std::sort(bucket_slots.begin(), bucket_slots.end());
+                if (std::adjacent_find(bucket_slots.begin(), bucket_slots.end()) == bucket_slots.end()) {
+                    break;
+                }
+            }
+            // The values with the same hash never fit.
+            if (seed == kMaxSeedTrials) {
+                return false;
+            }
+            Bucket& bucket = _buckets[b];
+            bucket.offset = _slots.size();
+            bucket.num_slots = num_slots;
+            bucket.seed = seed;
+            _slots.resize(_slots.size() + num_slots);
+            _occupied.resize(_occupied.size() + num_slots, 0);
+            for (uint32_t id : ids) {
+                uint32_t slot = bucket.offset + _slot(hashes[id], seed, num_slots);
+                _slots[slot] = values[id];
+                _occupied[slot] = 1;
+            }
+        }
+        _values = values;
+        return true;
+    }
+
+    bool contains(const Slice& v) const {
+        uint64_t hash = _hash(v);
+        const Bucket& bucket = _buckets[_bucket(hash, _buckets.size())];
+        uint32_t slot = bucket.offset + _slot(hash, bucket.seed, bucket.num_slots);
+        return _occupied[slot] && SliceNormalEqual()(_slots[slot], v);
+    }
+
+    size_t size() const { return _values.size(); }
+    const_iterator begin() const { return _values.begin(); }
+    const_iterator end() const { return _values.end(); }
+
+private:
+    static constexpr uint32_t kMaxSeedTrials = 64;
+
+    struct Bucket {
+        uint32_t offset = 0;
+        uint32_t num_slots = 1;
+        uint32_t seed = 0;
+    };
+
+    static uint64_t _hash(const Slice& v) { return phmap_mix<8>()(SliceHash()(v)); }
+
+    // Maps the hash into [0, n) by the high bits of the product, which is cheaper than the modulo.
+    static uint32_t _fast_range(uint64_t hash, uint64_t n) {
+        return static_cast<uint32_t>((static_cast<uint128_t>(hash) * n) >> 64);
+    }
+
+    static uint32_t _bucket(uint64_t hash, size_t num_buckets) { return _fast_range(hash, num_buckets); }
+
+    static uint32_t _slot(uint64_t hash, uint32_t seed, uint32_t num_slots) {
+        return _fast_range(phmap_mix<8>()(hash ^ (seed * 0x9E3779B97F4A7C15ULL)), num_slots);
+    }
+
+    std::vector<Bucket> _buckets;
+    std::vector<Slice> _slots;
+    std::vector<uint8_t> _occupied;
+    std::vector<Slice> _values;
+};
+
+} // namespace starrocks::vectorized
@@ -5,9 +5,12 @@
 #include <gutil/strings/fastmem.h>
 
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "gutil/casts.h"
 #include "simd/simd.h"
+#include "util/coding.h"
 #include "util/mysql_row_buffer.h"
+#include "util/raw_container.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -20,13 +23,13 @@ NullableColumn::NullableColumn(MutableColumnPtr&& data_column, MutableColumnPtr&
             << "nullable column's data must be single column";
     ColumnPtr ptr = std::move(null_column);
     _null_column = std::static_pointer_cast<NullColumn>(ptr);
-    _has_null = SIMD::count_nonzero(_null_column->get_data());
+    _has_null = SIMD::contain_nonzero(_null_column->get_data());
 }
 
 NullableColumn::NullableColumn(ColumnPtr data_column, NullColumnPtr null_column)
         : _data_column(std::move(data_column)),
           _null_column(std::move(null_column)),
-          _has_null(SIMD::count_nonzero(_null_column->get_data())) {
+          _has_null(SIMD::contain_nonzero(_null_column->get_data())) {
     DCHECK(!_data_column->is_constant() && !_data_column->is_nullable())
             << "nullable column's data must be single column";
     DCHECK(!_null_column->is_constant() && !_null_column->is_nullable())
@@ -53,7 +56,7 @@ void NullableColumn::append(const Column& src, size_t offset, size_t count) {
 
         _null_column->append(*c._null_column, offset, count);
         _data_column->append(*c._data_column, offset, count);
-        _has_null = _has_null || SIMD::count_nonzero(&(c._null_column->get_data()[offset]), count);
+        _has_null = _has_null || SIMD::contain_nonzero(&(c._null_column->get_data()[offset]), count);
     } else {
         _null_column->resize(_null_column->size() + count);
         _data_column->append(src, offset, count);
@@ -73,7 +76,7 @@ void NullableColumn::append_selective(const Column& src, const uint32_t* indexes
 
         _null_column->append_selective(*src_column._null_column, indexes, from, size);
         _data_column->append_selective(*src_column._data_column, indexes, from, size);
-        _has_null = _has_null || SIMD::count_nonzero(&_null_column->get_data()[orig_size], size);
+        _has_null = _has_null || SIMD::contain_nonzero(&_null_column->get_data()[orig_size], size);
     } else {
         _null_column->resize(orig_size + size);
         _data_column->append_selective(src, indexes, from, size);
@@ -93,7 +96,7 @@ void NullableColumn::append_value_multiple_times(const Column& src, uint32_t ind
 
         _null_column->append_value_multiple_times(*src_column._null_column, index, size);
         _data_column->append_value_multiple_times(*src_column._data_column, index, size);
-        _has_null = _has_null || SIMD::count_nonzero(&_null_column->get_data()[orig_size], size);
+        _has_null = _has_null || SIMD::contain_nonzero(&_null_column->get_data()[orig_size], size);
     } else {
         _null_column->resize(orig_size + size);
         _data_column->append_value_multiple_times(src, index, size);
@@ -240,14 +243,58 @@ void NullableColumn::deserialize_and_append_batch(std::vector<Slice>& srcs, size
     }
 }
 
+// With config::serialize_null_bitmap, the null flags are serialized as the number of rows with kNullBitmapFlag set
+// followed by their bitmap, or with kNoNullFlag set and no bitmap if there is no null. Otherwise the null column is
+// serialized as is, whose header is its byte size without these bits, so both of them could be deserialized.
+static constexpr uint32_t kNullBitmapFlag = 1U << 31;
+static constexpr uint32_t kNoNullFlag = 1U << 30;
+
+size_t NullableColumn::serialize_size() const {
+    if (!config::serialize_null_bitmap) {
+        return _data_column->serialize_size() + _null_column->serialize_size();
+    }
+    size_t bitmap_size = _has_null ? (_null_column->size() + 7) / 8 : 0;
+    return _data_column->serialize_size() + sizeof(uint32_t) + bitmap_size;
+}
+
 uint8_t* NullableColumn::serialize_column(uint8_t* dst) {
-    dst = _null_column->serialize_column(dst);
+    if (config::serialize_null_bitmap) {
+        const size_t rows = _null_column->size();
+        DCHECK_LT(rows, kNoNullFlag);
+        if (_has_null) {
+            encode_fixed32_le(dst, kNullBitmapFlag | rows);
+            dst += sizeof(uint32_t);
+            SIMD::bytes_to_bitmap(_null_column->get_data().data(), rows, dst);
+            dst += (rows + 7) / 8;
+        } else {
+            encode_fixed32_le(dst, kNoNullFlag | rows);
+            dst += sizeof(uint32_t);
+        }
+    } else {
+        dst = _null_column->serialize_column(dst);
+    }
     return _data_column->serialize_column(dst);
 }
 
 const uint8_t* NullableColumn::deserialize_column(const uint8_t* src) {
-    src = _null_column->deserialize_column(src);
-    _has_null = SIMD::count_nonzero(_null_column->get_data());
+    uint32_t header = decode_fixed32_le(src);
+    if ((header & (kNullBitmapFlag | kNoNullFlag)) != 0) {
+        src += sizeof(uint32_t);
+        const size_t rows = header & ~(kNullBitmapFlag | kNoNullFlag);
+        auto& nulls = _null_column->get_data();
+        raw::make_room(&nulls, rows);
+        if ((header & kNullBitmapFlag) != 0) {
+            SIMD::bitmap_to_bytes(src, rows, nulls.data());
+            src += (rows + 7) / 8;
+            _has_null = true;
+        } else {
+            memset(nulls.data(), 0, rows);
+            _has_null = false;
+        }
+    } else {
+        src = _null_column->deserialize_column(src);
+        _has_null = SIMD::contain_nonzero(_null_column->get_data());
+    }
     return _data_column->deserialize_column(src);
 }
 
@@ -303,6 +350,31 @@ void NullableColumn::crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) cons
     }
 }
 
+void NullableColumn::crc32c_hash(uint32_t* hash, uint16_t from, uint16_t to) const {
+    if (!_has_null) {
+        _data_column->crc32c_hash(hash, from, to);
+        return;
+    }
+
+    const auto& null_data = _null_column->get_data();
+    // The same as fvn_hash, the hashes of the nulls are mixed with a constant.
+    uint32_t value = 0x9e3779b9;
+    while (from < to) {
+        uint16_t new_from = from + 1;
+        while (new_from < to && null_data[from] == null_data[new_from]) {
+            ++new_from;
+        }
+        if (null_data[from]) {
+            for (uint16_t i = from; i < new_from; ++i) {
+                hash[i] = hash[i] ^ (value + (hash[i] << 6) + (hash[i] >> 2));
+            }
+        } else {
+            _data_column->crc32c_hash(hash, from, new_from);
+        }
+        from = new_from;
+    }
+}
+
 void NullableColumn::put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const {
     if (_has_null && _null_column->get_data()[idx]) {
         buf->push_null();
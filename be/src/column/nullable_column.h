@@ -161,7 +161,7 @@ public:
         return sizeof(uint8_t) + _data_column->serialize_size(idx);
     }
 
-    size_t serialize_size() const override { return _data_column->serialize_size() + _null_column->serialize_size(); }
+    size_t serialize_size() const override;
 
     uint8_t* serialize_column(uint8_t* dst) override;
 
@@ -182,6 +182,8 @@ public:
 
     void crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
 
+    void crc32c_hash(uint32_t* hash, uint16_t from, uint16_t to) const override;
+
     void put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const override;
 
     std::string get_name() const override { return "nullable-" + _data_column->get_name(); }
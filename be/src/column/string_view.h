@@ -0,0 +1,99 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+// A 16-byte view of a string for the comparisons, in the layout of the "German strings": the 4-byte size and the
+// first 4 bytes of the string, followed by the rest of the string inline if it's at most 12 bytes, or else by the
+// pointer to the string. The prefix decides the order or the inequality of most strings, without dereferencing the
+// pointer to the string.
+// The view of a long string is valid as long as the string is, e.g. until the BinaryColumn is changed.
+class StringView {
+public:
+    static constexpr uint32_t kPrefixSize = 4;
+    static constexpr uint32_t kInlineSize = 12;
+
+    StringView() = default;
+
+    explicit StringView(const Slice& s) : _size(static_cast<uint32_t>(s.size)) {
+        if (_size <= kInlineSize) {
+            // The bytes after the string are zero, so the inline strings are equal iff their bytes are.
+            if (_size > 0) {
+                memcpy(_bytes, s.data, _size);
+            }
+        } else {
+            memcpy(_bytes, s.data, kPrefixSize);
+            memcpy(_bytes + kPrefixSize, &s.data, sizeof(s.data));
+        }
+    }
+
+    bool is_inline() const { return _size <= kInlineSize; }
+
+    size_t size() const { return _size; }
+
+    const char* data() const {
+        if (is_inline()) {
+            return _bytes;
+        }
+        const char* ptr;
+        memcpy(&ptr, _bytes + kPrefixSize, sizeof(ptr));
+        return ptr;
+    }
+
+    Slice to_slice() const { return {data(), _size}; }
+
+    // The same order as Slice::compare.
+    int compare(const StringView& rhs) const {
+        // The prefixes padded with zeros are in the memcmp order of the strings, if they differ.
+        uint32_t lhs_prefix = _prefix();
+        uint32_t rhs_prefix = rhs._prefix();
+        if (lhs_prefix != rhs_prefix) {
+            return __builtin_bswap32(lhs_prefix) < __builtin_bswap32(rhs_prefix) ? -1 : 1;
+        }
+        size_t min_size = std::min(_size, rhs._size);
+        if (min_size > kPrefixSize) {
+            int res = memcmp(data() + kPrefixSize, rhs.data() + kPrefixSize, min_size - kPrefixSize);
+            if (res != 0) {
+                return res;
+            }
+        }
+        return _size < rhs._size ? -1 : (_size > rhs._size ? 1 : 0);
+    }
+
+    bool operator==(const StringView& rhs) const {
+        uint64_t lhs_head;
+        uint64_t rhs_head;
+        memcpy(&lhs_head, this, sizeof(lhs_head));
+        memcpy(&rhs_head, &rhs, sizeof(rhs_head));
+        if (lhs_head != rhs_head) {
+            return false;
+        }
+        if (is_inline()) {
+            return memcmp(_bytes + kPrefixSize, rhs._bytes + kPrefixSize, kInlineSize - kPrefixSize) == 0;
+        }
+        return memcmp(data() + kPrefixSize, rhs.data() + kPrefixSize, _size - kPrefixSize) == 0;
+    }
+
+    bool operator!=(const StringView& rhs) const { return !(*this == rhs); }
+
+private:
+    uint32_t _prefix() const {
+        uint32_t prefix;
+        memcpy(&prefix, _bytes, sizeof(prefix));
+        return prefix;
+    }
+
+    uint32_t _size = 0;
+    char _bytes[kInlineSize] = {};
+};
+
+static_assert(sizeof(StringView) == 16);
+
+} // namespace starrocks::vectorized
@@ -84,6 +84,12 @@ CONF_Int32(push_worker_count_normal_priority, "3");
 CONF_Int32(push_worker_count_high_priority, "3");
 // the count of thread to publish version
 CONF_Int32(publish_version_worker_count, "8");
+// the max number of the pending publish version tasks a publish thread takes at a time, whose rowset metas on the
+// same data dir are written in one batch.
+CONF_mInt32(publish_version_batch_size, "16");
+// the number of the threads shared by the publish threads to publish the tablets of the tasks in parallel,
+// 0 publishes the tablets on the publish thread one by one.
+CONF_Int32(publish_version_tablet_threads, "8");
 // the count of thread to clear transaction task
 CONF_Int32(clear_transaction_task_worker_count, "1");
 // the count of thread to delete
@@ -100,6 +106,10 @@ CONF_Int32(check_consistency_worker_count, "1");
 CONF_Int32(upload_worker_count, "1");
 // the count of thread to download
 CONF_Int32(download_worker_count, "1");
+// the count of the files of an upload or download task transferred concurrently via broker
+CONF_mInt32(snapshot_loader_transfer_concurrency, "4");
+// the max bytes per second transferred by all the upload and download tasks of a BE, 0 means no limit
+CONF_mInt64(snapshot_loader_max_bytes_per_sec, "0");
 // the count of thread to make snapshot
 CONF_Int32(make_snapshot_worker_count, "5");
 // the count of thread to release snapshot
@@ -110,6 +120,9 @@ CONF_mInt32(report_task_interval_seconds, "10");
 CONF_mInt32(report_disk_state_interval_seconds, "60");
 // the interval time(seconds) for agent report olap table to FE
 CONF_mInt32(report_tablet_interval_seconds, "60");
+// the tablets unchanged since the last report are reported by their cached infos, except in every n-th report,
+// which builds the infos of all the tablets as a consistency check, 1 builds them in every report
+CONF_mInt32(report_tablet_full_build_rounds, "10");
 // the interval time(seconds) for agent report plugin status to FE
 // CONF_Int32(report_plugin_interval_seconds, "120");
 // the timeout(seconds) for alter table
@@ -120,6 +133,11 @@ CONF_mInt32(report_tablet_interval_seconds, "60");
 // CONF_Int32(release_snapshot_timeout_seconds, "600");
 // the max download speed(KB/s)
 CONF_mInt32(max_download_speed_kbps, "50000");
+// The max number of the files or the ranges of the files downloaded concurrently by all the clones into a disk.
+// The max download speed is shared by the concurrent downloads of a clone.
+CONF_mInt32(clone_download_concurrency_per_disk, "4");
+// The files larger than it are downloaded by the ranges of this size concurrently by a clone.
+CONF_mInt64(clone_download_range_bytes, "67108864");
 // download low speed limit(KB/s)
 CONF_mInt32(download_low_speed_limit_kbps, "50");
 // download low speed time(seconds)
@@ -168,9 +186,42 @@ CONF_String(default_query_options, "");
 CONF_Int32(num_threads_per_core, "3");
 // if true, compresses tuple data in Serialize
 CONF_Bool(compress_rowbatches, "true");
+// if true, the null flags of the nullable columns are serialized as bitmaps in the chunks of the exchanges and the
+// spills. The bitmaps could be deserialized only by the BEs of this version or later, so enable it after all the BEs
+// are upgraded.
+CONF_Bool(serialize_null_bitmap, "false");
+// The version of the format of the chunks serialized for the exchanges. The version 2 encodes each column by its
+// values, e.g. the constant columns, the null bitmaps and the dictionaries of the strings, see column/column_encoder.h.
+// The version 2 could be deserialized only by the BEs of this version or later, so set it after all the BEs are
+// upgraded. The spills are always in the version 2.
+CONF_mInt32(chunk_serde_version, "1");
+// if true, the binary columns of few distinct strings are dictionary encoded in the version 2 of the chunks.
+CONF_mBool(chunk_serde_dict_encoding, "true");
 // compress ratio when shuffle row_batches in network, not in storage engine.
 // If ratio is less than this value, use uncompressed data instead
 CONF_mDouble(rpc_compress_ratio_threshold, "1.1");
+// whether to compress the transmitted chunks only if the time to compress them is less than the time saved to
+// transmit them, both of which are measured on the way, so the compression follows the data and the network.
+CONF_mBool(transmission_adaptive_compression, "true");
+// while the compression of the transmitted chunks is off adaptively, one of this number of chunks is still
+// compressed to measure the compression again.
+CONF_mInt32(transmission_compression_probe_interval, "16");
+// whether to pass the shuffled chunks to the receivers on the same BE directly, without serialization and rpc.
+CONF_mBool(enable_local_exchange_passthrough, "true");
+// the number of the threads merging the senders of a merging exchange in groups, whose sorted chunks are then
+// merged by the exchange node. the senders are merged by the exchange node only if there are less than twice as
+// many senders as the threads.
+CONF_mInt32(merging_exchange_parallelism, "4");
+// the number of the threads converting the sub-maps of the two-level hash map of a blocking aggregation to the
+// output chunks concurrently, each thread outputs the chunks of its sub-maps. the hash map is converted by the
+// calling thread if it's 1 or there are less than vector_chunk_size groups per thread.
+CONF_mInt32(agg_finalize_parallelism, "4");
+// the max number of groups a hash table of an aggregation or of the build rows of a join is pre-sized for by the
+// planner's estimates, to cap the memory reserved by an overestimate. 0 disables the pre-sizing.
+CONF_mInt64(hash_table_max_presize_rows, "4194304");
+// the number of input rows of an aggregation sampled to estimate the number of groups by the ratio of the groups to
+// the rows, if the planner estimates the input rows but not the number of groups.
+CONF_mInt64(agg_presize_sample_rows, "65536");
 // serialize and deserialize each returned row batch
 CONF_Bool(serialize_batch, "false");
 // interval between profile reports; in seconds
@@ -181,6 +232,9 @@ CONF_String(local_library_dir, "${UDF_RUNTIME_DIR}");
 CONF_Int32(doris_scanner_thread_pool_thread_num, "48");
 // number of olap scanner thread pool size
 CONF_Int32(doris_scanner_thread_pool_queue_size, "102400");
+// Whether to share the olap scanner threads among the queries by deficit round robin instead of the static
+// priority of the scanners.
+CONF_Bool(enable_fair_scan_scheduler, "false");
 // number of etl thread pool size
 CONF_Int32(etl_thread_pool_size, "8");
 // number of etl thread pool size
@@ -191,6 +245,10 @@ CONF_Int32(port, "20001");
 CONF_Int32(thrift_connect_timeout_seconds, "3");
 // broker write timeout in seconds
 CONF_Int32(broker_write_timeout_seconds, "30");
+// the readers of the broker opened for a file loaded via broker, which fetch the consecutive ranges of
+// broker_read_range_bytes of the file concurrently ahead of the scanner. 1 to read the file by a single reader.
+CONF_mInt32(broker_read_connections_per_file, "1");
+CONF_mInt64(broker_read_range_bytes, "8388608");
 // default thrift client retry interval (in milliseconds)
 CONF_mInt64(thrift_client_retry_interval_ms, "100");
 // max row count number for single scan range
@@ -199,6 +257,9 @@ CONF_mInt32(doris_scan_range_row_count, "524288");
 CONF_mInt32(doris_scanner_queue_size, "1024");
 // single read execute fragment row size
 CONF_mInt32(doris_scanner_row_num, "16384");
+// Whether to adjust the number of the running scanners of an olap scan node by how fast the chunks are consumed
+// and how much memory is left, instead of running as many scanners as possible.
+CONF_mBool(enable_adaptive_scanner_concurrency, "false");
 // number of max scan keys
 CONF_mInt32(doris_max_scan_key_num, "1024");
 // the max number of push down values of a single column.
@@ -206,6 +267,39 @@ CONF_mInt32(doris_max_scan_key_num, "1024");
 CONF_mInt32(max_pushdown_conditions_per_column, "1024");
 // return_row / total_row
 CONF_mInt32(doris_max_pushdown_conjuncts_return_rate, "90");
+// Whether to skip the pages of the parquet files filtered out by the page index (column index and offset index).
+CONF_mBool(parquet_page_index_enable, "true");
+// Whether to read the columns without the conjuncts of the parquet files only for the rows selected by the
+// conjuncts on the other columns.
+CONF_mBool(parquet_late_materialization_enable, "true");
+// The rows of a row group of the parquet files written by the export and the result sinks.
+CONF_mInt64(parquet_writer_row_group_rows, "1048576");
+// The buffers of the csv data of the result sinks queued for a background thread, which writes them to the files,
+// so the writes overlap with the formatting of the rows. 0 to write them on the sink thread.
+CONF_mInt32(file_result_writer_async_buffers, "0");
+// Whether to coalesce the reads of the column chunks of the parquet and orc files scanned from hdfs or the object
+// storage, and prefetch the next row group or stripe while the current one is being decoded.
+CONF_mBool(hdfs_scan_io_coalesce_enable, "true");
+// The byte ranges to read whose gap is at most this are read by one io.
+CONF_mInt64(hdfs_scan_io_coalesce_max_gap_bytes, "1048576");
+// The max size of the io merged from several byte ranges.
+CONF_mInt64(hdfs_scan_io_coalesce_max_bytes, "16777216");
+// The max bytes of the data prefetched for a file of a scanner.
+CONF_mInt64(hdfs_scan_io_buffer_max_bytes, "268435456");
+// The number of threads prefetching the data of the hdfs scans.
+CONF_Int32(hdfs_scan_io_thread_num, "16");
+// The local disk cache of the blocks of the files scanned from hdfs or the object storage, shared by all the
+// queries. The directories of the cache separated by ';', each followed by its capacity in GB after ',' like
+// storage_root_path, e.g. /disk1/block_cache,100;/disk2/block_cache,100. Empty disables the cache.
+CONF_String(block_cache_disks, "");
+// The size of a cached block, the reads missing the cache are extended to the whole blocks.
+CONF_Int64(block_cache_block_size, "1048576");
+// The eviction policy of the block cache, one of lru, slru and clock, see storage_cache_eviction_policy.
+CONF_String(block_cache_eviction_policy, "lru");
+// The number of threads writing the blocks missing the cache to the disks, and the max number of the blocks
+// waiting to be written, the blocks beyond it are not cached.
+CONF_Int32(block_cache_populate_thread_num, "4");
+CONF_Int32(block_cache_populate_queue_size, "256");
 // (Advanced) Maximum size of per-query receive-side buffer
 CONF_mInt32(exchg_node_buffer_size_bytes, "10485760");
 // insert sort threadhold for sorter
@@ -223,6 +317,11 @@ CONF_mInt64(column_dictionary_key_size_threshold, "0");
 //CONF_String(module_output, "");
 // memory_limitation_per_thread_for_schema_change unit GB
 CONF_mInt32(memory_limitation_per_thread_for_schema_change, "2");
+// Whether the schema change without sorting converts the chunks read by the vectorized reader, a column at a
+// time, it falls back to the row blocks if any column can't be converted so.
+CONF_mBool(enable_vectorized_schema_change, "true");
+// The max number of the rowsets converted concurrently by a vectorized schema change.
+CONF_mInt32(schema_change_max_parallel_rowsets, "4");
 
 // CONF_Int64(max_unpacked_row_block_size, "104857600");
 
@@ -261,6 +360,26 @@ CONF_Int64(index_stream_cache_capacity, "10737418240");
 CONF_String(storage_page_cache_limit, "0");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "true");
+// The eviction policy of the storage page cache and the index stream cache, one of
+//  - lru: least-recently-used.
+//  - slru: segmented LRU, a large scan only evicts the pages it reads once, instead of the pages hit
+//    repeatedly by the point queries.
+//  - clock: the hits don't take the exclusive lock of the cache shard, for the high-QPS point queries.
+CONF_String(storage_cache_eviction_policy, "lru");
+// The memory limit of the compressed tier of the storage page cache, which holds the compressed pages and
+// decompresses them on hit. 0 disables the tier.
+CONF_String(storage_compressed_page_cache_limit, "0");
+// Only the pages whose uncompressed size is at least this times of the compressed size are cached in the
+// compressed tier, the other pages are only cached decompressed.
+CONF_Double(storage_compressed_page_cache_min_ratio, "2.0");
+// The memory limit of the partition of the storage page cache reserved for the pages of the in_memory tables,
+// which are only evicted by each other, so they aren't evicted by the scans of the other tables. The pages of the
+// segments written by the loads and the compactions of the in_memory tables are inserted into it as they're
+// written. 0 disables the partition, the pages of the in_memory tables are cached with a higher priority instead.
+CONF_String(storage_in_memory_page_cache_limit, "0");
+// The capacity in bytes of the cache of the parsed segment footers, which speeds up reopening the segments
+// of the rowsets closed before. 0 disables the cache.
+CONF_Int64(segment_footer_cache_capacity, "268435456");
 
 CONF_mInt32(base_compaction_check_interval_seconds, "60");
 CONF_mInt64(base_compaction_num_cumulative_deltas, "5");
@@ -284,6 +403,23 @@ CONF_mInt32(cumulative_compaction_skip_window_seconds, "30");
 CONF_mInt32(update_compaction_check_interval_seconds, "60");
 CONF_Int32(update_compaction_num_threads_per_disk, "1");
 CONF_Int32(update_compaction_per_tablet_min_interval_seconds, "120"); // 2min
+// The max number of the shards of the primary index updated concurrently by the apply of a large rowset, and the
+// delete vectors of the segments are generated concurrently as well. 1 disables the concurrent apply.
+CONF_mInt32(update_apply_num_shards, "4");
+// The memory of the delete vectors cached for the applies and the reads of the primary-key tablets, over which the
+// least recently used ones are evicted and loaded from the meta again when they're used.
+CONF_mInt64(update_del_vec_cache_capacity_bytes, "1073741824");
+// The number of the threads loading the primary indexes of the primary-key tablets in the background after the BE
+// starts, the most recently written tablets first, so the first loads after a restart don't wait for the loads of
+// the indexes. 0 disables it.
+CONF_Int32(update_index_prewarm_num_threads, "4");
+
+// Whether to persist the primary index of the primary-key tablets into the files beside the tablet, so it's opened
+// from the files instead of rebuilt from all the primary keys after it's evicted or the BE restarts, and only the
+// recent changes and the bloom filters of the files are kept in memory.
+CONF_mBool(enable_persistent_index, "false");
+// The memory of the recent changes of a persistent primary index, over which they're flushed into a new file.
+CONF_mInt64(persistent_index_l0_max_mem_bytes, "67108864");
 
 // if compaction of a tablet failed, this tablet should not be chosen to
 // compaction until this interval passes.
@@ -296,6 +432,34 @@ CONF_mInt64(min_compaction_failure_interval_sec, "120"); // 2 min
 // This config can be set to 0, which means to forbid any compaction, for some special cases.
 CONF_Int32(max_compaction_concurrency, "-1");
 
+// Whether to compact the DUP_KEYS and the PRIMARY_KEYS tablets vertically, i.e. merge the key columns first and
+// then merge each group of the value columns by the order of the merged rows, so the memory is bounded by the
+// group instead of the width of the table. It's used if there are more value columns than one group.
+CONF_mBool(enable_vertical_compaction, "true");
+// The max number of the value columns merged together by the vertical compaction.
+CONF_mInt32(vertical_compaction_max_columns_per_group, "5");
+// The DUP_KEYS tablets with the cluster columns are compacted into the segments of the ranges of the Z-order
+// curve on the cluster columns, each of this many rows sorted by the key, so the zone maps of the segments prune
+// by all the cluster columns. The rows are reordered in memory, so the compactions of more rows than the max
+// are not clustered.
+CONF_mInt64(compaction_cluster_rows_per_segment, "262144");
+CONF_mInt64(compaction_cluster_max_rows, "16777216");
+
+// The IO budget in MB/s of the base and cumulative compactions on each data dir, shared with the queries: the
+// compactions are throttled to the budget less the recent read throughput of the queries on the data dir.
+// 0 means no limit.
+CONF_mInt64(compaction_io_budget_mb_per_sec, "0");
+// The compactions on a data dir are never throttled below this rate if the budget is set.
+CONF_mInt64(compaction_io_min_mb_per_sec, "10");
+// Whether to pick the tablet to compact by the compaction score gained per byte rewritten instead of the score,
+// which prefers the tablets compacting many small rowsets to the ones rewriting a big base rowset.
+CONF_mBool(enable_compaction_priority_by_rewrite_bytes, "true");
+
+// Whether to merge the sorted rows by a loser tree on their key columns encoded into the memcomparable binaries,
+// instead of a heap comparing the key columns one by one. It's only used if all the key columns are of the types
+// supported by the primary key encoding and not nullable.
+CONF_mBool(enable_normalized_key_merge, "true");
+
 // Threshold to logging compaction trace, in seconds.
 CONF_mInt32(base_compaction_trace_threshold, "120");
 CONF_mInt32(cumulative_compaction_trace_threshold, "60");
@@ -328,6 +492,14 @@ CONF_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_max_batch_size_mb, "100");
+// whether the json scanner loads the nested objects and arrays of the json data into the string columns in the
+// binary form of JsonBinaryValue instead of the json text, so get_json_xxx finds their paths without parsing them.
+// the values in the binary form are converted to the text by get_json_string('$').
+CONF_mBool(json_load_nested_as_binary, "false");
+// the threads decompressing the compressed files of a load concurrently, ahead of the parsing of the data. the zstd
+// and lz4 frames and the BGZF blocks of gzip are decompressed by the threads in parallel, and the rest of the data by
+// a single read-ahead thread. 0 to decompress the files on the scanner threads.
+CONF_mInt32(load_decompress_threads, "0");
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -335,6 +507,9 @@ CONF_Int32(streaming_load_rpc_max_alive_time_sec, "1200");
 // the timeout of a rpc to open the tablet writer in remote BE.
 // short operation time, can set a short timeout
 CONF_Int32(tablet_writer_open_rpc_timeout_sec, "60");
+// the max number of the add_chunk rpcs in flight of each node channel of the tablet sink,
+// the receiver writes them in the order of the packet sequences.
+CONF_Int32(tablet_sink_max_inflight_add_chunk_rpcs, "2");
 // Deprecated, use query_timeout instread
 // the timeout of a rpc to process one batch in tablet writer.
 // you may need to increase this timeout if using larger 'streaming_load_max_mb',
@@ -348,6 +523,17 @@ CONF_Int32(fragment_pool_thread_num_min, "64");
 CONF_Int32(fragment_pool_thread_num_max, "4096");
 CONF_Int32(fragment_pool_queue_size, "2048");
 
+// Admission of the fragments by their memory. Before prepared, a fragment reserves this percent of its
+// mem_limit, and waits for the release of the others when the reservations would exceed
+// fragment_admission_mem_limit. 0 disables the admission.
+CONF_mInt32(fragment_admission_mem_reserve_percent, "0");
+// The bytes the reservations of the fragments are granted against, -1 means the limit of the query pool.
+CONF_mInt64(fragment_admission_mem_limit, "-1");
+// The max number of the fragments waiting for the admission, the others are rejected.
+CONF_mInt32(fragment_admission_queue_size, "1024");
+// The max time a fragment waits for the admission.
+CONF_mInt32(fragment_admission_timeout_ms, "60000");
+
 //for cast
 // CONF_Bool(cast, "true");
 
@@ -380,6 +566,10 @@ CONF_Bool(disable_mem_pools, "false");
 // to a relative large number or the performace is very very bad.
 CONF_Bool(use_mmap_allocate_chunk, "false");
 
+// Whether the chunks of MemPool grow up to 2MB instead of 512KB, and the chunks of 2MB or larger are 2MB aligned
+// and backed by transparent huge pages, which cuts the TLB misses on the large hash tables and sorts.
+CONF_Bool(enable_huge_page_mem_pool, "false");
+
 // Chunk Allocator's reserved bytes limit,
 // Default value is 2GB, increase this variable can improve performance, but will
 // acquire more free memory which can not be used by other modules
@@ -389,8 +579,52 @@ CONF_Int64(chunk_reserved_bytes_limit, "2147483648");
 // Enable quadratic probing hash table
 CONF_Bool(enable_quadratic_probing, "false");
 
+// The number of probe rows the hash join looks ahead to prefetch the bucket heads and the build rows of.
+// 0 means no prefetch.
+CONF_mInt32(join_hash_table_prefetch_distance, "16");
+// the max bytes of the bucket heads of a hash join a partition of the build rows is inserted into at a time. the
+// build rows of a larger hash table are partitioned by the high bits of their buckets and inserted partition by
+// partition, so the inserts stay in the cache. 0 means the build rows are inserted in their order.
+CONF_mInt64(join_hash_table_radix_partition_bytes, "262144");
+// the min build rows of a bucket of a hash join to group its chain by the keys, so the probe rows of other keys
+// skip the rows of a key at once, e.g. of a key dominating the build side. 0 means the chains aren't grouped.
+CONF_mInt64(join_hash_table_heavy_bucket_rows, "4096");
+
+// Whether the hash join indexes the buckets by the int join key directly, if the range of the build keys
+// is small enough, e.g. the dense surrogate ids of a dimension table.
+CONF_mBool(enable_join_hash_table_direct_mapping, "true");
+
+// Whether the cross join sorts the build rows by a build column compared with the probe rows by the range
+// conjuncts, e.g. a.ts >= b.start, so each probe row is joined with the build rows in its range only, which are
+// found by binary search.
+CONF_mBool(enable_cross_join_range_probe, "true");
+
+// Whether the top-n node pushes the boundary of its top rows down to the olap scan node below it, which skips
+// the pages and the rows out of the boundary.
+CONF_mBool(enable_topn_runtime_predicate, "true");
+
+// Whether the aggregation of several COUNT(DISTINCT) per group counts the distinct values of all the columns
+// by one hash set of (distinct column, group by keys, value), instead of one hash set per column per group.
+CONF_mBool(enable_multi_distinct_count_single_hash_set, "true");
+
+// Whether the projection evaluates the identical sub exprs of its exprs only once per chunk.
+CONF_mBool(enable_project_common_sub_expr_elimination, "true");
+
+// The capacity in bytes of the cache of the partial aggregation results of the tablets, which the repeated
+// queries over the unchanged tablets reuse. 0 disables the cache.
+CONF_Int64(agg_result_cache_capacity, "536870912");
+// The partial results of a tablet larger than this are not cached.
+CONF_mInt64(agg_result_cache_max_entry_bytes, "16777216");
+
 // for pprof
 CONF_String(pprof_profile_dir, "${STARROCKS_HOME}/log");
+// The sampling CPU profiler running along with the process, whose flame graphs are served by /pprof/flamegraph.
+// It takes SIGPROF, which interrupts the blocking syscalls not restarted by SA_RESTART.
+CONF_Bool(enable_cpu_sampler, "false");
+// The samples per second of the CPU time consumed by the process.
+CONF_Int32(cpu_sampler_frequency, "10");
+// The number of the latest samples kept, each of which takes about 400 bytes.
+CONF_Int32(cpu_sampler_buffer_samples, "65536");
 
 // for partition
 // CONF_Bool(enable_partitioned_hash_join, "false")
@@ -425,6 +659,14 @@ CONF_String(scratch_dirs, "/tmp");
 // then only the first writable directory is used
 // CONF_Bool(allow_multiple_scratch_dirs_per_device, "false");
 
+// The number of threads writing and prefetching the chunks spilled by the vectorized operators to the scratch
+// directories. 0 means the chunks are written and read by the operators themselves.
+CONF_Int32(spill_io_thread_num, "4");
+// if true, the chunks spilled by the vectorized operators are compressed by LZ4.
+CONF_mBool(spill_compress_chunks, "false");
+// The max bytes spilled by all the vectorized operators of a query on a BE, -1 means no limit.
+CONF_mInt64(spill_max_bytes_per_query, "-1");
+
 // linux transparent huge page
 CONF_Bool(madvise_huge_pages, "false");
 
@@ -445,6 +687,10 @@ CONF_Int32(memory_max_alignment, "16");
 
 // write buffer size before flush
 CONF_mInt64(write_buffer_size, "104857600");
+// Whether to sort the rows of the memtable by the memcomparable encoding of the keys, by radix sort if the keys
+// are encoded into 8 bytes at most. The rows of the same key are deduplicated by the sort if all the value
+// columns are aggregated by REPLACE.
+CONF_mBool(enable_memtable_normalized_key_sort, "true");
 
 // following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
@@ -453,6 +699,9 @@ CONF_mInt64(write_buffer_size, "104857600");
 // user should set these configs properly if necessary.
 CONF_Int64(load_process_max_memory_limit_bytes, "107374182400"); // 100GB
 CONF_Int32(load_process_max_memory_limit_percent, "30");         // 30%
+// The largest memtables of all the loads are flushed asynchronously once the load mem consumption exceeds
+// this percent of the load memory limit, the writes are stalled only if the limit is exceeded.
+CONF_mInt32(load_mem_soft_limit_percent, "80");
 CONF_Int64(compaction_mem_limit, "2147483648");                  // 2G
 
 // update interval of tablet stat cache
@@ -460,12 +709,22 @@ CONF_mInt32(tablet_stat_cache_update_interval_second, "300");
 
 // result buffer cancelled time (unit: second)
 CONF_mInt32(result_buffer_cancelled_interval_time, "300");
+// The serialized bytes of the results buffered for the fetches of a query, the producer is stalled beyond it.
+CONF_mInt64(result_buffer_max_bytes, "33554432"); // 32MB
+// The pipeline result sink coalesces the small chunks into a batch up to these bytes before it's buffered,
+// unless a fetch is waiting for the results.
+CONF_mInt64(result_batch_target_bytes, "1048576"); // 1MB
 
 // the increased frequency of priority for remaining tasks in BlockingPriorityQueue
 CONF_mInt32(priority_queue_remaining_tasks_increased_frequency, "512");
 
 // sync tablet_meta when modifing meta
 CONF_mBool(sync_tablet_meta, "false");
+// When sync_tablet_meta is on, the meta writes of the threads arriving within this window are group committed
+// by one synced write to the meta of a data dir. 0 disables the group commit.
+CONF_mInt32(meta_group_commit_window_us, "200");
+// The max number of the meta writes group committed together.
+CONF_mInt32(meta_group_commit_max_writes, "1024");
 
 // default thrift rpc timeout ms
 CONF_mInt32(thrift_rpc_timeout_ms, "5000");
@@ -476,9 +735,19 @@ CONF_mInt32(txn_commit_rpc_timeout_ms, "10000");
 // If set to true, metric calculator will run
 CONF_Bool(enable_metric_calculator, "true");
 
+// Whether to record the spans of the queries, e.g. the fragment prepare, the driver slices and the scans, which are
+// exported as a chrome trace by /api/query_trace.
+CONF_mBool(enable_query_trace, "false");
+// The max number of the spans kept by each thread, the oldest ones are overwritten.
+CONF_Int32(query_trace_buffer_size, "4096");
+
 // max consumer num in one data consumer group, for routine load
 CONF_mInt32(max_consumer_num_per_group, "3");
 
+// the max number of the pipes of a routine load task, each one of which is parsed by a scanner thread.
+// it's capped by the number of the partitions consumed by the task.
+CONF_mInt32(routine_load_kafka_pipe_num, "4");
+
 // the size of thread pool for routine load task.
 // this should be larger than FE config 'max_concurrent_task_num_per_be' (default 5)
 CONF_Int32(routine_load_thread_pool_size, "10");
@@ -501,6 +770,13 @@ CONF_String(es_scroll_keepalive, "5m");
 // HTTP connection timeout for es
 CONF_Int32(es_http_timeout_ms, "5000");
 
+// the number of the slices of the sliced scroll of each es shard, which are scanned concurrently, 1 means
+// no slicing. the queries whose limit is pushed down to es aren't sliced.
+CONF_mInt32(es_scroll_slices_per_shard, "1");
+// the field to slice the documents of a shard by, empty means _id. a numeric field with doc values is
+// less costly for es.
+CONF_String(es_scroll_slice_field, "");
+
 // the max client cache number per each host
 // There are variety of client cache in BE, but currently we use the
 // same cache size configuration.
@@ -524,6 +800,14 @@ CONF_mInt32(storage_flood_stage_usage_percent, "95"); // 95%
 CONF_mInt64(storage_flood_stage_left_capacity_bytes, "1073741824"); // 1GB
 // number of thread for flushing memtable per store
 CONF_Int32(flush_thread_num_per_store, "2");
+// number of thread for flushing memtable per SSD store.
+CONF_Int32(flush_thread_num_per_ssd_store, "4");
+// The number of the threads to sort and aggregate the memtables before their flushes, so a memtable of a tablet
+// is finalized while the former ones are being written. 0 finalizes the memtables on the loading threads.
+CONF_Int32(memtable_finalize_threads, "4");
+// The number of the threads shared by the segment writers of the loads and the compactions to encode and compress
+// the pages of the columns in parallel, 0 encodes the columns on the writing thread one by one.
+CONF_Int32(segment_writer_encode_threads, "0");
 
 // config for tablet meta checkpoint
 CONF_mInt32(tablet_meta_checkpoint_min_new_rowsets_num, "10");
@@ -555,6 +839,10 @@ CONF_Int32(txn_shard_size, "1024");
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_load_tablet_failure, "false");
 
+// The number of the threads loading the tablet metas of a data dir when the BE starts, the data dirs are loaded
+// concurrently as well.
+CONF_Int32(load_tablet_meta_threads_per_dir, "8");
+
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_rowset_stale_unconsistent_delete, "false");
 
@@ -571,8 +859,17 @@ CONF_Int32(late_materialization_ratio, "10");
 // `1000` will enable late materialization always select metric type.
 CONF_Int32(metric_late_materialization_ratio, "1000");
 
+// valid range: [0-1000].
+// The selectivity and the read time of each predicate column are sampled on the first reads of a segment, and
+// the other predicate columns are fetched only for the rows selected by the first one, i.e. the one reading
+// less to filter out more rows, if it selects at most this ratio of the rows.
+// `0` will disable the ordering of the predicate columns.
+CONF_mInt32(lazy_predicate_column_ratio, "100");
+
 // Max batched bytes for each transmit request
 CONF_Int64(max_transmit_batched_bytes, "65536");
+// The max number of transmit_chunk rpcs in flight to each destination of a pipeline exchange sink.
+CONF_Int32(pipeline_sink_brpc_max_in_flight, "4");
 
 CONF_Int16(bitmap_max_filter_items, "30");
 
@@ -581,6 +878,58 @@ CONF_Int16(bitmap_max_filter_ratio, "1");
 
 CONF_Bool(bitmap_filter_enable_not_equal, "false");
 
+// the bitmap indexes of the columns of this number of distinct values or more in a segment are written with the
+// bit-sliced bitmaps of the dictionary ordinals besides, so the range predicates read O(bits) bitmaps instead of
+// one bitmap for each value of the range. 0 means never.
+CONF_mInt32(bitmap_index_bit_slice_min_cardinality, "64");
+// the predicates of a column aren't evaluated by its bitmap index if it needs to read more bitmaps than this,
+// but by the zone maps and the scan.
+CONF_mInt32(bitmap_max_read_bitmaps, "4096");
+
+// The number of the bytes of the n-grams in the n-gram bloom filter index, which is written besides the bloom
+// filter index of the CHAR/VARCHAR columns and prunes the pages by the infix `LIKE` predicates.
+// `0` will disable writing the n-gram bloom filter index.
+CONF_mInt32(ngram_bloom_filter_index_gram_size, "3");
+
+// Whether to write the HyperLogLog sketches of the distinct values of the columns into the segment footers and the
+// rowset metas by the loads and the compactions, so the statistics collection could merge them instead of scanning
+// the rows, see /api/meta/column_stats. A sketch takes up to 16KB for each column of each segment.
+CONF_mBool(enable_column_ndv_sketch, "false");
+
+// Whether to encode the FLOAT/DOUBLE columns by the adaptive lossless floating-point encoding by default,
+// which falls back to bitshuffle for the pages not benefit from it. The segments can't be read by the
+// versions before it's introduced.
+CONF_mBool(enable_alp_float_encoding, "false");
+
+// The max number of the data pages of each column read ahead asynchronously by the queries, which are
+// resolved from the row ranges left after the index filtering. It hides the IO latency of the HDDs and the
+// network-attached disks. 0 will disable the read-ahead.
+CONF_mInt32(segment_read_ahead_pages, "4");
+
+// Whether the concurrent scans of the same columns and key ranges of a tablet version share one storage reader.
+// A scan attached to a running one gets its chunks from the current position, and then reads the rows before
+// it by itself. The predicates are evaluated on the chunks by each scan instead of pushed down to the storage.
+CONF_mBool(enable_shared_scan, "false");
+// The max number of the chunks of a shared scan buffered for its slower scans, which read the rows they miss
+// by themselves.
+CONF_mInt32(shared_scan_max_buffered_chunks, "16");
+
+// Whether to read the batches of the pages of the local files by io_uring, which issues the reads of a batch
+// by one system call instead of blocking a thread on each of them. It falls back to pread if io_uring isn't
+// available, e.g. the kernel is older than 5.1.
+CONF_Bool(enable_io_uring, "false");
+// The number of the submission entries of the io_uring of each thread, i.e. the max in-flight reads.
+CONF_Int32(io_uring_queue_depth, "64");
+
+// The pages of the read-ahead window of a column are read by one IO if the gap between them is no more than
+// segment_coalesce_read_max_gap bytes and the IO is no larger than segment_coalesce_read_max_size bytes.
+// 0 segment_coalesce_read_max_size will disable the coalescing.
+CONF_mInt32(segment_coalesce_read_max_gap, "16384");
+CONF_mInt32(segment_coalesce_read_max_size, "4194304");
+// if true, the local segment files are read by mmap, and their uncompressed pages are used in the OS page cache
+// directly instead of being copied into the storage page cache.
+CONF_mBool(storage_read_by_mmap, "false");
+
 // Only 1 and 2 is valid.
 // When storage_format_version is 1, use origin storage format for Date, Datetime and Decimal
 // type.
@@ -588,8 +937,26 @@ CONF_Bool(bitmap_filter_enable_not_equal, "false");
 // storage format.
 CONF_mInt16(storage_format_version, "2");
 
+// the max bytes of the ZSTD dictionary trained for each CHAR/VARCHAR column of ZSTD compression in a segment, whose
+// pages are compressed by it, 0 means no dictionary. the segments written with the dictionaries can be read only by
+// the BEs of this version or later, so enable it after all the BEs are upgraded.
+CONF_mInt32(zstd_page_dict_size, "0");
+// the bytes of the first pages of a column kept uncompressed as the samples to train the ZSTD dictionary.
+CONF_mInt32(zstd_page_dict_sample_bytes, "1048576");
+
 // do pre-aggregate if effect great than the factor, factor range:[1-100].
 CONF_Int16(pre_aggregate_factor, "80");
+// Whether to materialize the delete predicates of the non-primary-key tablets into the delete bitmaps of the
+// segments in background, so the reads skip the deleted rows by the bitmaps instead of evaluating the predicates.
+CONF_mBool(enable_delete_bitmap_materialization, "true");
+// The memory limit of the delete bitmaps materialized.
+CONF_Int64(delete_bitmap_cache_capacity, "268435456");
+// The interval to materialize the delete predicates of the tablets.
+CONF_mInt32(delete_bitmap_materialize_interval_sec, "60");
+
+// Whether to merge the segments and fully pre-aggregate the rows of AGG_KEYS tables in storage when the key
+// columns read are a prefix of the sort key, instead of the adjacent rows only.
+CONF_mBool(enable_prefix_pre_aggregation, "true");
 
 // enable genearate minidump for crash
 CONF_Bool(sys_minidump_enable, "false");
@@ -619,6 +986,33 @@ CONF_Int64(pipeline_yield_max_chunks_moved, "100");
 // yield PipelineDriver when maximum time in nano-seconds has spent
 // in current execution round.
 CONF_Int64(pipeline_yield_max_time_spent, "100000000");
+// The max time in microseconds the driver poller waits for notifications before it re-checks the blocked drivers.
+CONF_Int64(pipeline_poller_max_wait_us, "1000");
+// Whether to add the CPU time of the operators and the time blocked and waiting in the queue of the drivers into
+// the profile of each pipeline.
+CONF_mBool(enable_pipeline_profile, "true");
+// Whether to add the hardware counters of the operators, e.g. the cycles, the instructions and the LLC misses, into
+// the profile of each pipeline, which costs a syscall around each push_chunk and pull_chunk.
+CONF_mBool(enable_pipeline_hardware_counters, "false");
+// The queue of ready PipelineDrivers used by the driver dispatcher:
+// query_shared: one queue shared by all the executor threads, which schedules drivers by their levels.
+// work_stealing: one local queue per executor thread, the idle threads steal drivers from others.
+// mlfq: one queue shared by all the executor threads, which schedules drivers by the CPU time of their queries.
+CONF_String(pipeline_driver_queue_type, "query_shared");
+// Whether the pipeline executor threads are bound to the NUMA nodes round robin, so the memory they touch first,
+// e.g. the hash tables built by the drivers, is local to them. The work_stealing queue steals the drivers from the
+// threads on the same node first.
+CONF_Bool(enable_pipeline_numa_affinity, "false");
+// Split the tablets scanned by pipeline into the row ranges of segments with at most this number of rows,
+// so that a large tablet can be scanned by several drivers. 0 means no split.
+CONF_Int64(pipeline_scan_morsel_split_rows, "1048576");
+// The max number of the buckets whose hash tables are built but not probed completely in a pipeline colocate
+// join of a fragment instance. 0 means the number of the drivers of a pipeline, i.e. query_threads.
+CONF_mInt32(pipeline_colocate_join_max_buckets_in_memory, "0");
+// The number of threads reading the storage for the pipeline scan operators.
+CONF_Int32(pipeline_io_thread_pool_thread_num, "4");
+// The max number of chunks each pipeline scan operator reads into its buffer by the io threads in advance.
+CONF_Int64(pipeline_scan_max_buffered_chunks, "4");
 } // namespace config
 
 } // namespace starrocks
@@ -57,6 +57,7 @@
 #include "runtime/memory/chunk_allocator.h"
 #include "runtime/user_function_cache.h"
 #include "runtime/vectorized/time_types.h"
+#include "simd/simd.h"
 #include "storage/options.h"
 #include "util/cpu_info.h"
 #include "util/debug_util.h"
@@ -301,6 +302,7 @@ void init_daemon(int argc, char** argv, const std::vector<StorePath>& paths) {
 
     init_thrift_logging();
     CpuInfo::init();
+    SIMD::init();
     DiskInfo::init();
     MemInfo::init();
     UserFunctionCache::instance()->init(config::user_function_dir);
@@ -2,6 +2,8 @@
 
 #include "env/compressed_file.h"
 
+#include <limits>
+
 #include "exec/decompressor.h"
 
 namespace starrocks {
@@ -58,4 +60,224 @@ Status CompressedSequentialFile::skip(uint64_t n) {
     return Status::OK();
 }
 
+// The frames are decompressed by a thread together until they have so many bytes.
+static constexpr size_t kMaxFramesBytes = 1024 * 1024;
+// The most bytes of a chunk of the data that can't be split.
+static constexpr size_t kMaxStreamChunkBytes = 1024 * 1024;
+
+// Decompress |input| by |dec| to the end of |output| until all of it is consumed, or |output| has |max_output|
+// bytes, or no progress is made without more input.
+static Status decompress_to(Decompressor* dec, const Slice& input, size_t max_output, raw::RawVector<uint8_t>* output,
+                            size_t* input_bytes_read, bool* stream_end) {
+    *input_bytes_read = 0;
+    while (*input_bytes_read < input.size && output->size() < max_output) {
+        size_t old_size = output->size();
+        output->resize(std::min(max_output, std::max(2 * old_size, old_size + 64 * 1024)));
+        size_t input_bytes = 0;
+        size_t output_bytes = 0;
+        Status st = dec->decompress((uint8_t*)input.data + *input_bytes_read, input.size - *input_bytes_read,
+                                    &input_bytes, output->data() + old_size, output->size() - old_size,
+                                    &output_bytes, stream_end);
+        output->resize(old_size + output_bytes);
+        RETURN_IF_ERROR(st);
+        *input_bytes_read += input_bytes;
+        if (input_bytes == 0 && output_bytes == 0) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+ParallelCompressedSequentialFile::ParallelCompressedSequentialFile(std::shared_ptr<SequentialFile> input_file,
+                                                                   CompressionTypePB type, int num_threads,
+                                                                   size_t compressed_data_cache_size)
+        : _filename("compressed-" + input_file->filename()),
+          _input_file(std::move(input_file)),
+          _type(type),
+          _max_chunks(std::max(num_threads, 1)),
+          _compressed_buff(BitUtil::round_up(compressed_data_cache_size, CACHELINE_SIZE)) {
+    _thread = std::thread([this] { _run(); });
+}
+
+ParallelCompressedSequentialFile::~ParallelCompressedSequentialFile() {
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _stopped = true;
+    }
+    _not_full.notify_all();
+    _thread.join();
+}
+
+void ParallelCompressedSequentialFile::_run() {
+    Status st = _read_ahead();
+    std::lock_guard<std::mutex> l(_mutex);
+    _status = st;
+    _finished = true;
+    _not_empty.notify_all();
+}
+
+bool ParallelCompressedSequentialFile::_push(std::unique_ptr<Chunk> chunk) {
+    std::unique_lock<std::mutex> l(_mutex);
+    _not_full.wait(l, [this] { return _chunks.size() < _max_chunks || _stopped; });
+    if (_stopped) {
+        return false;
+    }
+    _chunks.emplace_back(std::move(chunk));
+    _not_empty.notify_all();
+    return true;
+}
+
+Status ParallelCompressedSequentialFile::_read_ahead() {
+    bool eof = false;
+    while (!_stopped) {
+        // The whole frames at the beginning of the buffer.
+        Slice data = _compressed_buff.read_buffer();
+        size_t frames_bytes = 0;
+        int64_t size = 0;
+        while (frames_bytes < kMaxFramesBytes) {
+            size = Decompressor::frame_size(_type, (uint8_t*)data.data + frames_bytes, data.size - frames_bytes);
+            if (size <= 0) {
+                break;
+            }
+            frames_bytes += size;
+        }
+        bool full = _compressed_buff.full();
+        if (frames_bytes >= kMaxFramesBytes || (frames_bytes > 0 && (size < 0 || full || eof))) {
+            auto chunk = std::make_unique<Chunk>();
+            chunk->input.assign(data.data, data.data + frames_bytes);
+            _compressed_buff.skip(frames_bytes);
+            Chunk* c = chunk.get();
+            chunk->status = std::async(std::launch::async, [type = _type, c] {
+                Decompressor* dec = nullptr;
+                RETURN_IF_ERROR(Decompressor::create_decompressor(type, &dec));
+                std::unique_ptr<Decompressor> dec_ptr(dec);
+                size_t input_bytes_read = 0;
+                bool stream_end = false;
+                RETURN_IF_ERROR(decompress_to(dec, Slice(c->input.data(), c->input.size()),
+                                              std::numeric_limits<size_t>::max(), &c->data, &input_bytes_read,
+                                              &stream_end));
+                if (input_bytes_read != c->input.size()) {
+                    return Status::InternalError(strings::Substitute(
+                            "Failed to decompress frames. input_len:$0, input_bytes_read:$1", c->input.size(),
+                            input_bytes_read));
+                }
+                c->input.clear();
+                c->input.shrink_to_fit();
+                return Status::OK();
+            });
+            if (!_push(std::move(chunk))) {
+                return Status::OK();
+            }
+            continue;
+        }
+        if (size < 0 || full || (eof && data.size > 0)) {
+            // The next frame can't be split, or is larger than the buffer, or is truncated.
+            return _decompress_stream(eof);
+        }
+        if (eof) {
+            return Status::OK();
+        }
+        Status st = _compressed_buff.read(_input_file.get());
+        if (st.is_end_of_file()) {
+            eof = true;
+        } else {
+            RETURN_IF_ERROR(st);
+        }
+    }
+    return Status::OK();
+}
+
+Status ParallelCompressedSequentialFile::_decompress_stream(bool eof) {
+    Decompressor* dec = nullptr;
+    RETURN_IF_ERROR(Decompressor::create_decompressor(_type, &dec));
+    std::unique_ptr<Decompressor> dec_ptr(dec);
+    bool stream_end = false;
+    while (!_stopped) {
+        if (!eof && !_compressed_buff.full()) {
+            Status st = _compressed_buff.read(_input_file.get());
+            if (st.is_end_of_file()) {
+                eof = true;
+            } else {
+                RETURN_IF_ERROR(st);
+            }
+        }
+        Slice data = _compressed_buff.read_buffer();
+        if (data.size == 0 && eof) {
+            return Status::OK();
+        }
+        auto chunk = std::make_unique<Chunk>();
+        size_t input_bytes_read = 0;
+        RETURN_IF_ERROR(decompress_to(dec, data, kMaxStreamChunkBytes, &chunk->data, &input_bytes_read, &stream_end));
+        _compressed_buff.skip(input_bytes_read);
+        if (input_bytes_read == 0 && chunk->data.empty()) {
+            if (eof || _compressed_buff.full()) {
+                return Status::InternalError(strings::Substitute("Failed to decompress. input_len:$0", data.size));
+            }
+            continue;
+        }
+        std::promise<Status> decompressed;
+        decompressed.set_value(Status::OK());
+        chunk->status = decompressed.get_future();
+        if (!_push(std::move(chunk))) {
+            return Status::OK();
+        }
+    }
+    return Status::OK();
+}
+
+Status ParallelCompressedSequentialFile::_next_chunk() {
+    _chunk.reset();
+    _chunk_offset = 0;
+    RETURN_IF_ERROR(_read_status);
+    while (_chunk == nullptr || _chunk->data.empty()) {
+        {
+            std::unique_lock<std::mutex> l(_mutex);
+            _not_empty.wait(l, [this] { return !_chunks.empty() || _finished; });
+            if (_chunks.empty()) {
+                _chunk.reset();
+                return _status;
+            }
+            _chunk = std::move(_chunks.front());
+            _chunks.pop_front();
+            _not_full.notify_all();
+        }
+        _read_status = _chunk->status.get();
+        if (!_read_status.ok()) {
+            _chunk.reset();
+            return _read_status;
+        }
+    }
+    return Status::OK();
+}
+
+Status ParallelCompressedSequentialFile::read(Slice* result) {
+    if (_chunk == nullptr || _chunk_offset == _chunk->data.size()) {
+        Status st = _next_chunk();
+        if (!st.ok() || _chunk == nullptr) {
+            result->size = 0;
+            return st;
+        }
+    }
+    size_t n = std::min(result->size, _chunk->data.size() - _chunk_offset);
+    memcpy(result->data, _chunk->data.data() + _chunk_offset, n);
+    _chunk_offset += n;
+    result->size = n;
+    return Status::OK();
+}
+
+Status ParallelCompressedSequentialFile::skip(uint64_t n) {
+    while (n > 0) {
+        if (_chunk == nullptr || _chunk_offset == _chunk->data.size()) {
+            RETURN_IF_ERROR(_next_chunk());
+            if (_chunk == nullptr) {
+                return Status::OK();
+            }
+        }
+        size_t skipped = std::min<uint64_t>(n, _chunk->data.size() - _chunk_offset);
+        _chunk_offset += skipped;
+        n -= skipped;
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks
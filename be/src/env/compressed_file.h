@@ -2,7 +2,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
 #include "env/env.h"
+#include "gen_cpp/types.pb.h"
 #include "util/bit_util.h"
 #include "util/raw_container.h"
 
@@ -10,6 +18,51 @@ namespace starrocks {
 
 class Decompressor;
 
+// Used to store the compressed data read from an input file.
+class CompressedBuffer {
+public:
+    explicit CompressedBuffer(size_t buff_size)
+            : _compressed_data(BitUtil::round_up(buff_size, CACHELINE_SIZE)), _offset(0), _limit(0) {}
+
+    inline Slice read_buffer() const { return Slice(&_compressed_data[_offset], _limit - _offset); }
+
+    inline Slice write_buffer() const { return Slice(&_compressed_data[_limit], _compressed_data.size() - _limit); }
+
+    inline void skip(size_t n) {
+        _offset += n;
+        assert(_offset <= _limit);
+    }
+
+    inline Status read(SequentialFile* f) {
+        if (_offset > 0) {
+            // Copy the bytes between the buffer's current offset and limit to the beginning of
+            // the buffer.
+            memmove(&_compressed_data[0], &_compressed_data[_offset], available());
+            _limit -= _offset;
+            _offset = 0;
+        }
+        if (_limit >= _compressed_data.size()) {
+            return Status::InternalError("reached the buffer limit");
+        }
+        Slice buff(write_buffer());
+        Status st = f->read(&buff);
+        if (st.ok()) {
+            if (buff.size == 0) return Status::EndOfFile("read empty from " + f->filename());
+            _limit += buff.size;
+        }
+        return st;
+    }
+
+    inline size_t available() const { return _limit - _offset; }
+
+    inline bool full() const { return available() >= _compressed_data.size(); }
+
+private:
+    raw::RawVector<uint8_t> _compressed_data;
+    size_t _offset;
+    size_t _limit;
+};
+
 class CompressedSequentialFile final : public SequentialFile {
 public:
     CompressedSequentialFile(std::shared_ptr<SequentialFile> input_file, std::shared_ptr<Decompressor> decompressor,
@@ -26,54 +79,74 @@ public:
     const std::string& filename() const override { return _filename; }
 
 private:
-    // Used to store the compressed data read from |_input_file|.
-    class CompressedBuffer {
-    public:
-        explicit CompressedBuffer(size_t buff_size)
-                : _compressed_data(BitUtil::round_up(buff_size, CACHELINE_SIZE)), _offset(0), _limit(0) {}
+    std::string _filename;
+    std::shared_ptr<SequentialFile> _input_file;
+    std::shared_ptr<Decompressor> _decompressor;
+    CompressedBuffer _compressed_buff;
+    bool _stream_end = false;
+};
 
-        inline Slice read_buffer() const { return Slice(&_compressed_data[_offset], _limit - _offset); }
+// A compressed file whose data are decompressed by a background thread ahead of the reads, so the decompression
+// overlaps with the parsing of the data read. The independent frames of the data, i.e. the zstd or lz4 frames and
+// the BGZF blocks of gzip, are decompressed by up to |num_threads| threads concurrently, and the rest of the data
+// since the first frame that can't be split, e.g. the whole of a gzip file without BGZF, by the background thread.
+class ParallelCompressedSequentialFile final : public SequentialFile {
+public:
+    ParallelCompressedSequentialFile(std::shared_ptr<SequentialFile> input_file, CompressionTypePB type,
+                                     int num_threads, size_t compressed_data_cache_size = 8 * 1024 * 1024LU);
 
-        inline Slice write_buffer() const { return Slice(&_compressed_data[_limit], _compressed_data.size() - _limit); }
+    // Wait for the background thread, which may be blocked on reading |input_file|.
+    ~ParallelCompressedSequentialFile() override;
 
-        inline void skip(size_t n) {
-            _offset += n;
-            assert(_offset <= _limit);
-        }
+    Status read(Slice* result) override;
 
-        inline Status read(SequentialFile* f) {
-            if (_offset > 0) {
-                // Copy the bytes between the buffer's current offset and limit to the beginning of
-                // the buffer.
-                memmove(&_compressed_data[0], &_compressed_data[_offset], available());
-                _limit -= _offset;
-                _offset = 0;
-            }
-            if (_limit >= _compressed_data.size()) {
-                return Status::InternalError("reached the buffer limit");
-            }
-            Slice buff(write_buffer());
-            Status st = f->read(&buff);
-            if (st.ok()) {
-                if (buff.size == 0) return Status::EndOfFile("read empty from " + f->filename());
-                _limit += buff.size;
-            }
-            return st;
-        }
+    Status skip(uint64_t n) override;
 
-        inline size_t available() const { return _limit - _offset; }
+    const std::string& filename() const override { return _filename; }
 
-    private:
-        raw::RawVector<uint8_t> _compressed_data;
-        size_t _offset;
-        size_t _limit;
+private:
+    // The decompressed data of some frames, or of a part of the data that can't be split.
+    struct Chunk {
+        raw::RawVector<uint8_t> input;
+        raw::RawVector<uint8_t> data;
+        // Ready when |data| is decompressed. Destroyed first, so a decompressing thread is waited for.
+        std::future<Status> status;
     };
 
+    void _run();
+
+    // Split the data of |_input_file| and enqueue their chunks.
+    Status _read_ahead();
+
+    // Decompress the rest of the data of |_input_file| by a single decompressor.
+    Status _decompress_stream(bool eof);
+
+    // Enqueue |chunk|, return false if the file is being destroyed.
+    bool _push(std::unique_ptr<Chunk> chunk);
+
+    // Set |_chunk| to the next chunk, or nullptr at the end of the data.
+    Status _next_chunk();
+
     std::string _filename;
     std::shared_ptr<SequentialFile> _input_file;
-    std::shared_ptr<Decompressor> _decompressor;
+    const CompressionTypePB _type;
+    const size_t _max_chunks;
     CompressedBuffer _compressed_buff;
-    bool _stream_end = false;
+
+    std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::condition_variable _not_full;
+    std::deque<std::unique_ptr<Chunk>> _chunks;
+    // Set when the background thread exits, with its status.
+    bool _finished = false;
+    Status _status;
+    std::atomic<bool> _stopped{false};
+    std::thread _thread;
+
+    std::unique_ptr<Chunk> _chunk;
+    size_t _chunk_offset = 0;
+    // The first error of decompressing a chunk, returned by all the following reads.
+    Status _read_status;
 };
 
 } // namespace starrocks
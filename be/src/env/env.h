@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -212,6 +213,16 @@ public:
     virtual const std::string& filename() const = 0;
 };
 
+// A read of "buf.size" bytes starting at "offset" in a batch of RandomAccessFile::read_at_batch().
+struct ReadRequest {
+    uint64_t offset = 0;
+    Slice buf;
+    // The index of the io_uring registered buffer "buf" is in, or -1 if it's not registered.
+    int buf_index = -1;
+    // Set once the read completes.
+    Status status;
+};
+
 class RandomAccessFile {
 public:
     RandomAccessFile() = default;
@@ -248,6 +259,29 @@ public:
     // Safe for concurrent use by multiple threads.
     virtual Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // Hint that the "size" bytes starting at "offset" will be read soon, so that they're read
+    // into the OS page cache asynchronously. It never blocks on the IO.
+    virtual Status prefetch(uint64_t offset, uint64_t size) const { return Status::OK(); }
+
+    // Read the "n" requests, which may be submitted together and complete out of order. "on_complete" is
+    // invoked with the index of a request once its status is set. Returns the first error of the requests.
+    //
+    // Safe for concurrent use by multiple threads.
+    virtual Status read_at_batch(ReadRequest* reqs, size_t n,
+                                 const std::function<void(size_t)>& on_complete = nullptr) const {
+        Status first_error;
+        for (size_t i = 0; i < n; i++) {
+            reqs[i].status = read_at(reqs[i].offset, reqs[i].buf);
+            if (!reqs[i].status.ok() && first_error.ok()) {
+                first_error = reqs[i].status;
+            }
+            if (on_complete) {
+                on_complete(i);
+            }
+        }
+        return first_error;
+    }
+
     // Return the size of this file
     virtual Status size(uint64_t* size) const = 0;
 
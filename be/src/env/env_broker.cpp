@@ -5,10 +5,13 @@
 #include <brpc/uri.h>
 
 #include <chrono>
+#include <deque>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
 
+#include "common/config.h"
 #include "env/env.h"
 #include "gen_cpp/FileBrokerService_types.h"
 #include "gen_cpp/TFileBrokerService.h"
@@ -242,6 +245,114 @@ private:
     size_t _offset = 0;
 };
 
+// A sequential file read by some readers of the broker, each of them with its own fd, so the broker reads the
+// storage for them concurrently. The consecutive ranges of the file are fetched by the readers in turn, up to one
+// range for each reader ahead of the reads.
+class BrokerParallelSequentialFile : public SequentialFile {
+public:
+    BrokerParallelSequentialFile(std::vector<std::unique_ptr<RandomAccessFile>> files, uint64_t size,
+                                 size_t range_size)
+            : _files(std::move(files)), _size(size), _range_size(range_size) {}
+
+    // The pending ranges are waited for by the destructors of their futures.
+    ~BrokerParallelSequentialFile() override = default;
+
+    Status read(Slice* result) override {
+        if (_range == nullptr || _range_offset == _range->data.size()) {
+            RETURN_IF_ERROR(_next_range());
+            if (_range == nullptr) {
+                result->size = 0;
+                return Status::OK();
+            }
+        }
+        size_t n = std::min(result->size, _range->data.size() - _range_offset);
+        memcpy(result->data, _range->data.data() + _range_offset, n);
+        _range_offset += n;
+        result->size = n;
+        return Status::OK();
+    }
+
+    Status skip(uint64_t n) override {
+        if (_range != nullptr && n <= _range->data.size() - _range_offset) {
+            _range_offset += n;
+            return Status::OK();
+        }
+        // Restart the fetching from the new offset.
+        uint64_t offset = _offset() + n;
+        _ranges.clear();
+        _range.reset();
+        _range_offset = 0;
+        _next_offset = offset;
+        return Status::OK();
+    }
+
+    const std::string& filename() const override { return _files[0]->file_name(); }
+
+private:
+    struct Range {
+        uint64_t offset = 0;
+        std::string data;
+        // Ready when |data| is fetched. Destroyed first, so a fetching thread is waited for.
+        std::future<Status> status;
+    };
+
+    // The offset of the next byte to read.
+    uint64_t _offset() const { return _range != nullptr ? _range->offset + _range_offset : _next_offset; }
+
+    Status _next_range() {
+        _range.reset();
+        _range_offset = 0;
+        _fetch();
+        if (_ranges.empty()) {
+            return Status::OK();
+        }
+        _range = std::move(_ranges.front());
+        _ranges.pop_front();
+        Status st = _range->status.get();
+        if (!st.ok()) {
+            _range.reset();
+            _ranges.clear();
+            return st;
+        }
+        // Only the last range may be short, unless the file is truncated after it's listed.
+        if (_range->data.empty()) {
+            _range.reset();
+            _ranges.clear();
+        }
+        _fetch();
+        return Status::OK();
+    }
+
+    // Fetch the next ranges until there is one being fetched by each reader.
+    void _fetch() {
+        while (_ranges.size() < _files.size() && _next_offset < _size) {
+            auto range = std::make_unique<Range>();
+            range->offset = _next_offset;
+            range->data.resize(std::min<uint64_t>(_range_size, _size - _next_offset));
+            // The range k is fetched by the reader k % |_files|, which has fetched the range k - |_files|.
+            RandomAccessFile* file = _files[(_next_offset / _range_size) % _files.size()].get();
+            Range* r = range.get();
+            range->status = std::async(std::launch::async, [file, r] {
+                Slice buff(r->data);
+                RETURN_IF_ERROR(file->read(r->offset, &buff));
+                r->data.resize(buff.size);
+                return Status::OK();
+            });
+            _next_offset += range->data.size();
+            _ranges.emplace_back(std::move(range));
+        }
+    }
+
+    std::vector<std::unique_ptr<RandomAccessFile>> _files;
+    const uint64_t _size;
+    const size_t _range_size;
+    // The offset of the next range to fetch.
+    uint64_t _next_offset = 0;
+    std::deque<std::unique_ptr<Range>> _ranges;
+    std::unique_ptr<Range> _range;
+    size_t _range_offset = 0;
+};
+
 class BrokerWritableFile : public WritableFile {
 public:
     BrokerWritableFile(const TNetworkAddress& broker, std::string path, const TBrokerFD& fd, size_t offset,
@@ -312,7 +423,28 @@ private:
 Status EnvBroker::new_sequential_file(const std::string& path, std::unique_ptr<SequentialFile>* file) {
     std::unique_ptr<RandomAccessFile> random_file;
     RETURN_IF_ERROR(new_random_access_file(path, &random_file));
-    *file = std::make_unique<BrokerSequentialFile>(std::move(random_file));
+    uint64_t size = 0;
+    RETURN_IF_ERROR(random_file->size(&size));
+    const size_t range_size = std::max<int64_t>(config::broker_read_range_bytes, 1);
+    const uint64_t num_ranges = (size + range_size - 1) / range_size;
+    const size_t num_readers = std::min<uint64_t>(std::max(config::broker_read_connections_per_file, 1), num_ranges);
+    if (num_readers <= 1) {
+        *file = std::make_unique<BrokerSequentialFile>(std::move(random_file));
+        return Status::OK();
+    }
+    std::vector<std::unique_ptr<RandomAccessFile>> files;
+    files.emplace_back(std::move(random_file));
+    while (files.size() < num_readers) {
+        TBrokerFD fd;
+        Status st = _open_reader(path, &fd);
+        if (!st.ok()) {
+            // Read by the readers opened.
+            LOG(WARNING) << "Fail to open more readers of " << path << ": " << st;
+            break;
+        }
+        files.emplace_back(std::make_unique<BrokerRandomAccessFile>(_broker_addr, path, fd, size));
+    }
+    *file = std::make_unique<BrokerParallelSequentialFile>(std::move(files), size, range_size);
     return Status::OK();
 }
 
@@ -322,6 +454,21 @@ Status EnvBroker::new_random_access_file(const std::string& path, std::unique_pt
 
 Status EnvBroker::new_random_access_file(const RandomAccessFileOptions& opts, const std::string& path,
                                          std::unique_ptr<RandomAccessFile>* file) {
+    TBrokerFD fd;
+    RETURN_IF_ERROR(_open_reader(path, &fd));
+
+    // Get file size
+    uint64_t size;
+    Status st = _get_file_size(path, &size);
+    if (!st.ok()) {
+        broker_close_reader(_broker_addr, fd);
+        return st;
+    }
+    *file = std::make_unique<BrokerRandomAccessFile>(_broker_addr, path, fd, size);
+    return Status::OK();
+}
+
+Status EnvBroker::_open_reader(const std::string& path, TBrokerFD* fd) {
     TBrokerOpenReaderRequest request;
     TBrokerOpenReaderResponse response;
     request.__set_path(path);
@@ -339,11 +486,7 @@ Status EnvBroker::new_random_access_file(const RandomAccessFileOptions& opts, co
         LOG(WARNING) << "Fail to open " << path << ": " << response.opStatus.message;
         return to_status(response.opStatus);
     }
-
-    // Get file size
-    uint64_t size;
-    RETURN_IF_ERROR(_get_file_size(path, &size));
-    *file = std::make_unique<BrokerRandomAccessFile>(_broker_addr, path, response.fd, size);
+    *fd = response.fd;
     return Status::OK();
 }
 
@@ -9,6 +9,7 @@ namespace starrocks {
 
 const static int DEFAULT_TIMEOUT_MS = 10000;
 
+class TBrokerFD;
 class TBrokerFileStatus;
 class TFileBrokerServiceClient;
 class TNetworkAddress;
@@ -71,6 +72,7 @@ public:
 
 private:
     Status _get_file_size(const std::string& params, uint64_t* size);
+    Status _open_reader(const std::string& path, TBrokerFD* fd);
     Status _path_exists(const std::string& path);
     Status _delete_file(const std::string& path);
     Status _list_file(const std::string& path, TBrokerFileStatus* stat);
@@ -19,6 +19,7 @@
 
 #include "common/logging.h"
 #include "env/env.h"
+#include "env/io_uring.h"
 #include "gutil/gscoped_ptr.h"
 #include "gutil/macros.h"
 #include "gutil/port.h"
@@ -276,6 +277,24 @@ public:
     Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
         return do_readv_at(_fd, _filename, offset, res, res_cnt, nullptr);
     }
+
+    Status prefetch(uint64_t offset, uint64_t size) const override {
+        // posix_fadvise returns the error number instead of setting errno.
+        int res = posix_fadvise(_fd, offset, size, POSIX_FADV_WILLNEED);
+        if (res != 0) {
+            return io_error(_filename, res);
+        }
+        return Status::OK();
+    }
+
+    Status read_at_batch(ReadRequest* reqs, size_t n, const std::function<void(size_t)>& on_complete) const override {
+        IoUring* ring = IoUring::thread_local_ring();
+        if (ring == nullptr) {
+            return RandomAccessFile::read_at_batch(reqs, n, on_complete);
+        }
+        return ring->read(_fd, _filename, reqs, n, on_complete);
+    }
+
     Status size(uint64_t* size) const override {
         struct stat st;
         auto res = fstat(_fd, &st);
@@ -23,6 +23,10 @@ Status StreamPipeSequentialFile::read_one_message(std::unique_ptr<uint8_t[]>* bu
     return _file->read_one_message(buf, length);
 }
 
+Status StreamPipeSequentialFile::read_buffer(ByteBufferPtr* buf) {
+    return _file->read_buffer(buf);
+}
+
 Status StreamPipeSequentialFile::skip(uint64_t n) {
     return _file->seek(n);
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "env/env.h"
+#include "util/byte_buffer.h"
 
 namespace starrocks {
 class StreamLoadPipe;
@@ -17,6 +18,8 @@ public:
 
     Status read(Slice* result) override;
     Status read_one_message(std::unique_ptr<uint8_t[]>* buf, size_t* length);
+    // Take the next buffer of the pipe without copying, nullptr at the end of the stream.
+    Status read_buffer(ByteBufferPtr* buf);
 
     Status skip(uint64_t n) override;
     const std::string& filename() const override { return _filename; }
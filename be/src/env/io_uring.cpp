@@ -0,0 +1,312 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "env/io_uring.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define STARROCKS_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+
+namespace starrocks {
+
+static Status io_uring_error(const std::string& context, int err_number) {
+    return Status::IOError(context, static_cast<int16_t>(err_number), std::strerror(err_number));
+}
+
+IoUring* IoUring::thread_local_ring() {
+    if (!config::enable_io_uring) {
+        return nullptr;
+    }
+    static thread_local std::unique_ptr<IoUring> ring;
+    static thread_local bool initialized = false;
+    if (!initialized) {
+        initialized = true;
+        auto res = create(config::io_uring_queue_depth);
+        if (res.ok()) {
+            ring = std::move(res).value();
+        } else {
+            LOG(WARNING) << "Fail to create io_uring, fall back to pread: " << res.status().to_string();
+        }
+    }
+    return ring.get();
+}
+
+StatusOr<std::unique_ptr<IoUring>> IoUring::create(uint32_t queue_depth) {
+    std::unique_ptr<IoUring> ring(new IoUring());
+    RETURN_IF_ERROR(ring->_init(queue_depth));
+    return std::move(ring);
+}
+
+#ifdef STARROCKS_HAVE_IO_URING
+
+static int sys_io_uring_setup(uint32_t entries, struct io_uring_params* p) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int sys_io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int sys_io_uring_register(int fd, uint32_t opcode, const void* arg, uint32_t nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+IoUring::~IoUring() {
+    if (_sqes_ptr != nullptr) {
+        munmap(_sqes_ptr, _sqes_size);
+    }
+    if (_cq_ptr != nullptr && _cq_ptr != _sq_ptr) {
+        munmap(_cq_ptr, _cq_size);
+    }
+    if (_sq_ptr != nullptr) {
+        munmap(_sq_ptr, _sq_size);
+    }
+    if (_ring_fd >= 0) {
+        close(_ring_fd);
+    }
+}
+
+Status IoUring::_init(uint32_t queue_depth) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    _ring_fd = sys_io_uring_setup(std::max<uint32_t>(queue_depth, 1), &p);
+    if (_ring_fd < 0) {
+        _ring_fd = -1;
+        return Status::NotSupported(strings::Substitute("io_uring_setup failed: $0", std::strerror(errno)));
+    }
+
+    _sq_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    _cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+    if (single_mmap) {
+        _sq_size = _cq_size = std::max(_sq_size, _cq_size);
+    }
+    _sq_ptr = mmap(nullptr, _sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQ_RING);
+    if (_sq_ptr == MAP_FAILED) {
+        _sq_ptr = nullptr;
+        return io_uring_error("mmap io_uring submission ring", errno);
+    }
+    if (single_mmap) {
+        _cq_ptr = _sq_ptr;
+    } else {
+        _cq_ptr = mmap(nullptr, _cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                       IORING_OFF_CQ_RING);
+        if (_cq_ptr == MAP_FAILED) {
+            _cq_ptr = nullptr;
+            return io_uring_error("mmap io_uring completion ring", errno);
+        }
+    }
+    _sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    _sqes_ptr = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                     IORING_OFF_SQES);
+    if (_sqes_ptr == MAP_FAILED) {
+        _sqes_ptr = nullptr;
+        return io_uring_error("mmap io_uring submission entries", errno);
+    }
+
+    auto* sq = static_cast<uint8_t*>(_sq_ptr);
+    _sq_head = reinterpret_cast<uint32_t*>(sq + p.sq_off.head);
+    _sq_tail = reinterpret_cast<uint32_t*>(sq + p.sq_off.tail);
+    _sq_mask = *reinterpret_cast<uint32_t*>(sq + p.sq_off.ring_mask);
+    _sq_entries = p.sq_entries;
+    _sq_array = reinterpret_cast<uint32_t*>(sq + p.sq_off.array);
+    auto* cq = static_cast<uint8_t*>(_cq_ptr);
+    _cq_head = reinterpret_cast<uint32_t*>(cq + p.cq_off.head);
+    _cq_tail = reinterpret_cast<uint32_t*>(cq + p.cq_off.tail);
+    _cq_mask = *reinterpret_cast<uint32_t*>(cq + p.cq_off.ring_mask);
+    _cqes = cq + p.cq_off.cqes;
+    _sqes = _sqes_ptr;
+    return Status::OK();
+}
+
+Status IoUring::register_buffers(const Slice* bufs, size_t n) {
+    RETURN_IF_ERROR(unregister_buffers());
+    std::vector<struct iovec> iovecs(n);
+    for (size_t i = 0; i < n; i++) {
+        iovecs[i] = {bufs[i].data, bufs[i].size};
+    }
+    if (sys_io_uring_register(_ring_fd, IORING_REGISTER_BUFFERS, iovecs.data(), n) < 0) {
+        return io_uring_error("io_uring register buffers", errno);
+    }
+    _num_buffers = n;
+    return Status::OK();
+}
+
+Status IoUring::unregister_buffers() {
+    if (_num_buffers == 0) {
+        return Status::OK();
+    }
+    if (sys_io_uring_register(_ring_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0) < 0) {
+        return io_uring_error("io_uring unregister buffers", errno);
+    }
+    _num_buffers = 0;
+    return Status::OK();
+}
+
+bool IoUring::_prepare_read(int fd, ReadRequest* req, size_t index, size_t done) {
+    uint32_t tail = *_sq_tail;
+    if (tail - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) >= _sq_entries) {
+        return false;
+    }
+    uint32_t slot = tail & _sq_mask;
+    auto* sqe = static_cast<struct io_uring_sqe*>(_sqes) + slot;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->fd = fd;
+    sqe->off = req->offset + done;
+    sqe->user_data = index;
+    if (req->buf_index >= 0) {
+        DCHECK_LT(static_cast<size_t>(req->buf_index), _num_buffers);
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->addr = reinterpret_cast<uint64_t>(req->buf.data + done);
+        sqe->len = req->buf.size - done;
+        sqe->buf_index = req->buf_index;
+    } else {
+        // The iovec is kept until the completion, the kernel may copy it after the submission.
+        _iovecs[index] = {req->buf.data + done, req->buf.size - done};
+        sqe->opcode = IORING_OP_READV;
+        sqe->addr = reinterpret_cast<uint64_t>(&_iovecs[index]);
+        sqe->len = 1;
+    }
+    _sq_array[slot] = slot;
+    __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+Status IoUring::_submit_and_wait(uint32_t to_submit, uint32_t min_complete) {
+    while (true) {
+        int ret = sys_io_uring_enter(_ring_fd, to_submit, min_complete, IORING_ENTER_GETEVENTS);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return io_uring_error("io_uring_enter", errno);
+        }
+        // The entries not consumed by the kernel are still in the submission ring.
+        to_submit -= std::min<uint32_t>(ret, to_submit);
+        if (to_submit == 0) {
+            return Status::OK();
+        }
+    }
+}
+
+Status IoUring::read(int fd, const std::string& filename, ReadRequest* reqs, size_t n,
+                     const std::function<void(size_t)>& on_complete) {
+    _iovecs.resize(std::max(_iovecs.size(), n));
+    _done_bytes.assign(n, 0);
+    Status first_error;
+    auto complete = [&](size_t i, Status st) {
+        if (!st.ok() && first_error.ok()) {
+            first_error = st;
+        }
+        reqs[i].status = std::move(st);
+        if (on_complete) {
+            on_complete(i);
+        }
+    };
+
+    // The short reads to be resubmitted.
+    std::vector<size_t> requeued;
+    size_t next = 0;
+    size_t inflight = 0;
+    while (next < n || inflight > 0 || !requeued.empty()) {
+        uint32_t to_submit = 0;
+        // Keep the in-flight reads no more than the submission entries, so the completion ring never overflows.
+        while (!requeued.empty() && inflight < _sq_entries) {
+            size_t i = requeued.back();
+            if (!_prepare_read(fd, &reqs[i], i, _done_bytes[i])) {
+                break;
+            }
+            requeued.pop_back();
+            inflight++;
+            to_submit++;
+        }
+        while (next < n && inflight < _sq_entries) {
+            if (reqs[next].buf.size == 0) {
+                complete(next++, Status::OK());
+                continue;
+            }
+            if (!_prepare_read(fd, &reqs[next], next, 0)) {
+                break;
+            }
+            next++;
+            inflight++;
+            to_submit++;
+        }
+        if (inflight == 0) {
+            break;
+        }
+        RETURN_IF_ERROR(_submit_and_wait(to_submit, 1));
+
+        uint32_t head = *_cq_head;
+        uint32_t tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++) {
+            auto* cqe = static_cast<struct io_uring_cqe*>(_cqes) + (head & _cq_mask);
+            size_t i = cqe->user_data;
+            int res = cqe->res;
+            inflight--;
+            if (res == -EINTR || res == -EAGAIN) {
+                requeued.push_back(i);
+            } else if (res < 0) {
+                complete(i, io_uring_error(filename, -res));
+            } else if (res == 0) {
+                complete(i, Status::EndOfFile(strings::Substitute("EOF trying to read $0 bytes at offset $1",
+                                                                  reqs[i].buf.size, reqs[i].offset)));
+            } else if (_done_bytes[i] + res < reqs[i].buf.size) {
+                _done_bytes[i] += res;
+                requeued.push_back(i);
+            } else {
+                complete(i, Status::OK());
+            }
+        }
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+    }
+    return first_error;
+}
+
+#else
+
+IoUring::~IoUring() = default;
+
+Status IoUring::_init(uint32_t queue_depth) {
+    return Status::NotSupported("io_uring isn't supported by the platform");
+}
+
+Status IoUring::register_buffers(const Slice* bufs, size_t n) {
+    return Status::NotSupported("io_uring isn't supported by the platform");
+}
+
+Status IoUring::unregister_buffers() {
+    return Status::OK();
+}
+
+bool IoUring::_prepare_read(int fd, ReadRequest* req, size_t index, size_t done) {
+    return false;
+}
+
+Status IoUring::_submit_and_wait(uint32_t to_submit, uint32_t min_complete) {
+    return Status::NotSupported("io_uring isn't supported by the platform");
+}
+
+Status IoUring::read(int fd, const std::string& filename, ReadRequest* reqs, size_t n,
+                     const std::function<void(size_t)>& on_complete) {
+    return Status::NotSupported("io_uring isn't supported by the platform");
+}
+
+#endif
+
+} // namespace starrocks
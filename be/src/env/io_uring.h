@@ -0,0 +1,90 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/statusor.h"
+#include "gutil/macros.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+struct ReadRequest;
+
+// A minimal wrapper of the io_uring submission and completion rings, issuing the positional reads of a batch
+// by a single system call and reaping their completions. It talks to the kernel by the raw system calls
+// since liburing isn't in the thirdparty.
+//
+// A ring must only be used by one thread at a time, use IoUring::thread_local_ring() to get one for the
+// current thread.
+class IoUring {
+public:
+    ~IoUring();
+
+    // Create a ring of |queue_depth| submission entries. Returns NotSupported if io_uring isn't available,
+    // e.g. the kernel is older than 5.1 or it's forbidden by the seccomp of the container.
+    static StatusOr<std::unique_ptr<IoUring>> create(uint32_t queue_depth);
+
+    // The ring of the current thread created by config::io_uring_queue_depth, or nullptr if io_uring is
+    // disabled or not available. The failure to create it is only logged once per thread.
+    static IoUring* thread_local_ring();
+
+    // Register |bufs| as the fixed buffers of the ring, which are pinned once instead of by each read.
+    // A ReadRequest reading into the |i|-th buffer should set its buf_index to |i|. The buffers registered
+    // before are unregistered.
+    Status register_buffers(const Slice* bufs, size_t n);
+    Status unregister_buffers();
+
+    // Read the |n| requests from |fd|. At most queue_depth() requests are in flight, the rest are
+    // submitted as soon as the former ones complete. |on_complete| is invoked with the index of the request
+    // once it completes and its status is set. The short reads are resubmitted for the rest bytes.
+    // Returns the first error of the requests.
+    Status read(int fd, const std::string& filename, ReadRequest* reqs, size_t n,
+                const std::function<void(size_t)>& on_complete);
+
+    uint32_t queue_depth() const { return _sq_entries; }
+
+private:
+    IoUring() = default;
+
+    Status _init(uint32_t queue_depth);
+    // Queue the read of |req| from |done| bytes, returns false if the submission ring is full.
+    bool _prepare_read(int fd, ReadRequest* req, size_t index, size_t done);
+    Status _submit_and_wait(uint32_t to_submit, uint32_t min_complete);
+
+    int _ring_fd = -1;
+
+    void* _sq_ptr = nullptr;
+    size_t _sq_size = 0;
+    void* _cq_ptr = nullptr;
+    size_t _cq_size = 0;
+    void* _sqes_ptr = nullptr;
+    size_t _sqes_size = 0;
+
+    uint32_t* _sq_head = nullptr;
+    uint32_t* _sq_tail = nullptr;
+    uint32_t _sq_mask = 0;
+    uint32_t _sq_entries = 0;
+    uint32_t* _sq_array = nullptr;
+    uint32_t* _cq_head = nullptr;
+    uint32_t* _cq_tail = nullptr;
+    uint32_t _cq_mask = 0;
+    void* _cqes = nullptr;
+    void* _sqes = nullptr;
+
+    // The iovec of each in-flight request, indexed by the submission entry.
+    std::vector<struct iovec> _iovecs;
+    // The bytes already read of each request in the current batch.
+    std::vector<size_t> _done_bytes;
+    size_t _num_buffers = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+} // namespace starrocks
@@ -21,6 +21,8 @@
 
 #include "exec/decompressor.h"
 
+#include "util/coding.h"
+
 namespace starrocks {
 
 Status Decompressor::create_decompressor(CompressionTypePB type, Decompressor** decompressor) {
@@ -57,6 +59,85 @@ Status Decompressor::create_decompressor(CompressionTypePB type, Decompressor**
     return st;
 }
 
+static int64_t zstd_frame_size(const uint8_t* input, size_t input_len) {
+    size_t size = ZSTD_findFrameCompressedSize(input, input_len);
+    if (!ZSTD_isError(size)) {
+        return size;
+    }
+    return ZSTD_getErrorCode(size) == ZSTD_error_srcSize_wrong ? 0 : -1;
+}
+
+// See https://github.com/lz4/lz4/blob/dev/doc/lz4_Frame_format.md
+static int64_t lz4_frame_size(const uint8_t* input, size_t input_len) {
+    if (input_len < 8) {
+        return 0;
+    }
+    uint32_t magic = decode_fixed32_le(input);
+    if ((magic & 0xFFFFFFF0) == 0x184D2A50) {
+        // A skippable frame.
+        int64_t size = 8 + static_cast<int64_t>(decode_fixed32_le(input + 4));
+        return size <= input_len ? size : 0;
+    }
+    uint8_t flags = input[4];
+    if (magic != 0x184D2204 || (flags >> 6) != 1) {
+        return -1;
+    }
+    bool block_checksum = flags & 0x10;
+    bool content_size = flags & 0x08;
+    bool content_checksum = flags & 0x04;
+    bool dict_id = flags & 0x01;
+    size_t pos = 7 + (content_size ? 8 : 0) + (dict_id ? 4 : 0);
+    while (pos + 4 <= input_len) {
+        // The highest bit of the size of a block is set if the block is uncompressed.
+        uint32_t block_size = decode_fixed32_le(input + pos) & 0x7FFFFFFF;
+        pos += 4;
+        if (block_size == 0) {
+            // The end mark.
+            pos += content_checksum ? 4 : 0;
+            return pos <= input_len ? pos : 0;
+        }
+        pos += block_size + (block_checksum ? 4 : 0);
+    }
+    return 0;
+}
+
+// See the section 4 of https://samtools.github.io/hts-specs/SAMv1.pdf
+static int64_t bgzf_block_size(const uint8_t* input, size_t input_len) {
+    if (input_len < 12) {
+        return 0;
+    }
+    // ID1, ID2, CM and the FEXTRA bit of FLG.
+    if (input[0] != 0x1f || input[1] != 0x8b || input[2] != 8 || (input[3] & 0x04) == 0) {
+        return -1;
+    }
+    size_t xlen = decode_fixed16_le(input + 10);
+    if (input_len < 12 + xlen) {
+        return 0;
+    }
+    for (size_t pos = 12; pos + 4 <= 12 + xlen;) {
+        size_t slen = decode_fixed16_le(input + pos + 2);
+        if (input[pos] == 'B' && input[pos + 1] == 'C' && slen == 2 && pos + 6 <= 12 + xlen) {
+            int64_t size = static_cast<int64_t>(decode_fixed16_le(input + pos + 4)) + 1;
+            return size <= input_len ? size : 0;
+        }
+        pos += 4 + slen;
+    }
+    return -1;
+}
+
+int64_t Decompressor::frame_size(CompressionTypePB type, const uint8_t* input, size_t input_len) {
+    switch (type) {
+    case CompressionTypePB::ZSTD:
+        return zstd_frame_size(input, input_len);
+    case CompressionTypePB::LZ4_FRAME:
+        return lz4_frame_size(input, input_len);
+    case CompressionTypePB::GZIP:
+        return bgzf_block_size(input, input_len);
+    default:
+        return -1;
+    }
+}
+
 Decompressor::~Decompressor() {}
 
 std::string Decompressor::debug_info() {
@@ -54,6 +54,11 @@ public:
 public:
     static Status create_decompressor(CompressionTypePB type, Decompressor** decompressor);
 
+    // The bytes of the first frame of |input| of |type|, which is decompressed independently of the data around it,
+    // i.e. a zstd or lz4 frame or a BGZF block of gzip. Return 0 if the frame is not complete in |input|, or -1 if
+    // the end of the frame can't be found without decompressing it, e.g. a gzip member without the BGZF header.
+    static int64_t frame_size(CompressionTypePB type, const uint8_t* input, size_t input_len);
+
     virtual std::string debug_info();
 
     CompressionTypePB get_type() { return _ctype; }
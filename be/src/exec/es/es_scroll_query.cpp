@@ -23,6 +23,7 @@
 
 #include <sstream>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "exec/es/es_query_builder.h"
 #include "exec/es/es_scan_reader.h"
@@ -130,6 +131,21 @@ std::string ESScrollQueryBuilder::build(const std::map<std::string, std::string>
     es_query_dsl.AddMember("sort", sort_node, allocator);
     // number of docuements returned
     es_query_dsl.AddMember("size", size, allocator);
+    // scan a slice of the shard by the sliced scroll, the slices are scanned concurrently
+    if (properties.find(ESScanReader::KEY_SLICE_MAX) != properties.end() &&
+        properties.find(ESScanReader::KEY_TERMINATE_AFTER) == properties.end()) {
+        int slice_max = atoi(properties.at(ESScanReader::KEY_SLICE_MAX).c_str());
+        if (slice_max > 1) {
+            rapidjson::Value slice_node(rapidjson::kObjectType);
+            if (!config::es_scroll_slice_field.empty()) {
+                rapidjson::Value slice_field(config::es_scroll_slice_field.c_str(), allocator);
+                slice_node.AddMember("field", slice_field, allocator);
+            }
+            slice_node.AddMember("id", atoi(properties.at(ESScanReader::KEY_SLICE_ID).c_str()), allocator);
+            slice_node.AddMember("max", slice_max, allocator);
+            es_query_dsl.AddMember("slice", slice_node, allocator);
+        }
+    }
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
     es_query_dsl.Accept(writer);
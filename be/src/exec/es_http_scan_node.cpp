@@ -24,6 +24,7 @@
 #include <chrono>
 #include <sstream>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "exec/es/es_predicate.h"
 #include "exec/es/es_query_builder.h"
@@ -157,15 +158,23 @@ Status EsHttpScanNode::open(RuntimeState* state) {
 }
 
 Status EsHttpScanNode::start_scanners() {
+    // Each shard is split into the slices of the sliced scroll, which are scanned by the scanners concurrently,
+    // except for the search of the limit pushed down, which isn't scrolled.
+    int num_slices = std::max(config::es_scroll_slices_per_shard, 1);
+    if (limit() != -1 && limit() <= _runtime_state->batch_size()) {
+        num_slices = 1;
+    }
     {
         std::unique_lock<std::mutex> l(_batch_queue_lock);
-        _num_running_scanners = _scan_ranges.size();
+        _num_running_scanners = _scan_ranges.size() * num_slices;
     }
 
-    _scanners_status.resize(_scan_ranges.size());
+    _scanners_status.resize(_scan_ranges.size() * num_slices);
     for (int i = 0; i < _scan_ranges.size(); i++) {
-        _scanner_threads.emplace_back(&EsHttpScanNode::scanner_worker, this, i, _scan_ranges.size(),
-                                      std::ref(_scanners_status[i]));
+        for (int slice = 0; slice < num_slices; slice++) {
+            _scanner_threads.emplace_back(&EsHttpScanNode::scanner_worker, this, i, _scan_ranges.size(), slice,
+                                          num_slices, std::ref(_scanners_status[i * num_slices + slice]));
+        }
     }
     return Status::OK();
 }
@@ -404,7 +413,8 @@ static std::string get_host_port(const std::vector<TNetworkAddress>& es_hosts) {
     return host_port;
 }
 
-void EsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Status>& p_status) {
+void EsHttpScanNode::scanner_worker(int start_idx, int length, int slice_id, int num_slices,
+                                    std::promise<Status>& p_status) {
     // Clone expr context
     std::vector<ExprContext*> scanner_expr_ctxs;
     DCHECK(start_idx < length);
@@ -429,6 +439,10 @@ void EsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Stat
     if (limit() != -1 && limit() <= _runtime_state->batch_size()) {
         properties[ESScanReader::KEY_TERMINATE_AFTER] = std::to_string(limit());
     }
+    if (num_slices > 1) {
+        properties[ESScanReader::KEY_SLICE_ID] = std::to_string(slice_id);
+        properties[ESScanReader::KEY_SLICE_MAX] = std::to_string(num_slices);
+    }
 
     bool doc_value_mode = false;
     properties[ESScanReader::KEY_QUERY] =
@@ -77,8 +77,9 @@ private:
     // Collect all scanners 's status
     Status collect_scanners_status();
 
-    // One scanner worker, This scanner will hanle 'length' ranges start from start_idx
-    void scanner_worker(int start_idx, int length, std::promise<Status>& p_status);
+    // One scanner worker, This scanner will hanle the slice 'slice_id' of the 'num_slices' slices of the range
+    // start_idx of the 'length' ranges
+    void scanner_worker(int start_idx, int length, int slice_id, int num_slices, std::promise<Status>& p_status);
 
     // Scan one range
     Status scanner_scan(std::unique_ptr<EsHttpScanner> scanner, const std::vector<ExprContext*>& conjunct_ctxs,
@@ -60,11 +60,13 @@
 #include "exec/vectorized/analytic_node.h"
 #include "exec/vectorized/assert_num_rows_node.h"
 #include "exec/vectorized/cross_join_node.h"
+#include "exec/vectorized/dict_decode_node.h"
 #include "exec/vectorized/except_node.h"
 #include "exec/vectorized/file_scan_node.h"
 #include "exec/vectorized/hash_join_node.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "exec/vectorized/intersect_node.h"
+#include "exec/vectorized/merge_join_node.h"
 #include "exec/vectorized/mysql_scan_node.h"
 #include "exec/vectorized/olap_scan_node.h"
 #include "exec/vectorized/project_node.h"
@@ -497,6 +499,9 @@ Status ExecNode::create_vectorized_node(starrocks::RuntimeState* state, starrock
     case TPlanNodeType::HASH_JOIN_NODE:
         *node = pool->add(new vectorized::HashJoinNode(pool, tnode, descs));
         return Status::OK();
+    case TPlanNodeType::MERGE_JOIN_NODE:
+        *node = pool->add(new vectorized::MergeJoinNode(pool, tnode, descs));
+        return Status::OK();
     case TPlanNodeType::ANALYTIC_EVAL_NODE:
         *node = pool->add(new vectorized::AnalyticNode(pool, tnode, descs));
         return Status::OK();
@@ -533,6 +538,9 @@ Status ExecNode::create_vectorized_node(starrocks::RuntimeState* state, starrock
     case TPlanNodeType::TABLE_FUNCTION_NODE:
         *node = pool->add(new vectorized::TableFunctionNode(pool, tnode, descs));
         return Status::OK();
+    case TPlanNodeType::DECODE_NODE:
+        *node = pool->add(new vectorized::DictDecodeNode(pool, tnode, descs));
+        return Status::OK();
     case TPlanNodeType::HDFS_SCAN_NODE:
 #ifdef STARROCKS_WITH_HDFS
         *node = pool->add(new vectorized::HdfsScanNode(pool, tnode, descs));
@@ -827,6 +835,40 @@ void ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized:
     chunk->filter(*raw_filter);
 }
 
+void ExecNode::eval_conjuncts_lazily(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk) {
+    if (chunk->num_rows() == 0) {
+        return;
+    }
+
+    // The exprs are evaluated on all the rows of chunk, the rows out of its selection are ignored by the filter.
+    vectorized::Column::Filter filter(chunk->num_rows(), 1);
+    for (auto* ctx : ctxs) {
+        ColumnPtr column = ctx->evaluate(chunk);
+        size_t true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+
+        if (true_count == column->size()) {
+            // all hit, skip
+            continue;
+        } else if (0 == true_count) {
+            // all not hit, return
+            chunk->set_num_rows(0);
+            return;
+        } else {
+            bool all_zero = false;
+            vectorized::ColumnHelper::merge_two_filters(column, &filter, &all_zero);
+            if (all_zero) {
+                chunk->set_num_rows(0);
+                return;
+            }
+        }
+    }
+
+    if (SIMD::count_zero(filter) == 0) {
+        return;
+    }
+    chunk->select(filter);
+}
+
 void ExecNode::eval_join_runtime_filters(vectorized::Chunk* chunk) {
     if (chunk == nullptr) return;
     _runtime_filter_collector.evaluate(chunk);
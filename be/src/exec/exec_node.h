@@ -184,6 +184,10 @@ public:
     static void eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk,
                                vectorized::FilterPtr* filter_ptr = nullptr);
 
+    // evaluate exprs over chunk like eval_conjuncts, but narrow the selection of chunk instead of
+    // filtering its columns, see Chunk::select.
+    static void eval_conjuncts_lazily(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk);
+
     Status init_join_runtime_filters(const TPlanNode& tnode, RuntimeState* state);
     void register_runtime_filter_descriptor(RuntimeState* state, vectorized::RuntimeFilterProbeDescriptor* rf_desc);
     void eval_join_runtime_filters(vectorized::Chunk* chunk);
@@ -2,6 +2,7 @@
 
 #include "exec/parquet/column_chunk_reader.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/column.h"
@@ -103,10 +104,37 @@ Status ColumnChunkReader::init() {
 
 Status ColumnChunkReader::next_page() {
     RETURN_IF_ERROR(_parse_page_header());
+    _page_idx++;
+    _page_first_row += _num_values;
     RETURN_IF_ERROR(_parse_page_data());
     return Status::OK();
 }
 
+Status ColumnChunkReader::seek_to_page_of_row(uint64_t row) {
+    if (_opts.offset_index != nullptr) {
+        const auto& locations = _opts.offset_index->page_locations;
+        // the last page whose first row is not after the row
+        auto iter = std::upper_bound(locations.begin(), locations.end(), row,
+                                     [](uint64_t r, const tparquet::PageLocation& l) {
+                                         return r < static_cast<uint64_t>(l.first_row_index);
+                                     });
+        // the first page starts from row 0, so iter can't be the beginning
+        size_t page_idx = iter - locations.begin() - 1;
+        if (iter != locations.begin() && page_idx > _page_idx) {
+            _opts.stats->page_skip_count += page_idx - _page_idx - 1;
+            _page_reader->seek_to_offset(locations[page_idx].offset);
+            RETURN_IF_ERROR(_parse_page_header());
+            _page_idx = page_idx;
+            _page_first_row = locations[page_idx].first_row_index;
+            RETURN_IF_ERROR(_parse_page_data());
+        }
+    }
+    while (_page_first_row + _num_values <= row) {
+        RETURN_IF_ERROR(next_page());
+    }
+    return Status::OK();
+}
+
 Status ColumnChunkReader::_parse_page_header() {
     DCHECK(_page_parse_state == INITIALIZED || _page_parse_state == PAGE_DATA_PARSED);
     RETURN_IF_ERROR(_page_reader->next_header());
@@ -25,6 +25,8 @@ namespace starrocks::parquet {
 
 struct ColumnChunkReaderOptions {
     vectorized::HdfsScanStats* stats = nullptr;
+    // used to skip the pages without reading them if it's not nullptr
+    const tparquet::OffsetIndex* offset_index = nullptr;
 };
 
 class PageReader;
@@ -42,6 +44,15 @@ public:
 
     uint32_t num_values() const { return _num_values; }
 
+    // The index in the row group of the first row of the current page. Only meaningful for the
+    // non-repeated columns, whose pages have the same number of values and rows.
+    uint64_t page_first_row() const { return _page_first_row; }
+
+    // Move to the page containing the |row|-th row of the row group if it's after the current page,
+    // the pages between are skipped without being read if the offset index is provided. Only for the
+    // non-repeated columns.
+    Status seek_to_page_of_row(uint64_t row);
+
     // Try to decode n definition levels into 'levels'
     // return number of decoded levels.
     // If the returned value is less than input n, this means current page don't have
@@ -82,6 +93,9 @@ public:
         return _cur_decoder->next_batch(n, content_type, dst);
     }
 
+    // Skip the next n non-null values of the current page.
+    Status skip_values(size_t n) { return _cur_decoder->skip(n); }
+
     const tparquet::ColumnMetaData& metadata() const { return _chunk_metadata->meta_data; }
 
     Status get_dict_values(vectorized::Column* column) { return _cur_decoder->get_dict_values(column); }
@@ -129,6 +143,9 @@ private:
     LevelDecoder _rep_level_decoder;
 
     size_t _num_values = 0;
+    // the index of the current data page in the column chunk, and its first row in the row group
+    size_t _page_idx = 0;
+    uint64_t _page_first_row = 0;
 
     std::unique_ptr<uint8_t[]> _uncompressed_buf;
     size_t _uncompressed_buf_capacity = 0;
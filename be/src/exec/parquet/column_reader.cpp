@@ -325,6 +325,7 @@ public:
                 const TypeDescriptor& col_type) {
         StoredColumnReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.offset_index = _opts.offset_index;
         _field = field;
         _col_type = col_type;
 
@@ -347,7 +348,15 @@ public:
                 return status;
             }
 
-            RETURN_IF_ERROR(_converter->convert(column, dst));
+            // the converters overwrite the destination column, the values are appended like the ones read
+            // without converting
+            if (dst->empty()) {
+                RETURN_IF_ERROR(_converter->convert(column, dst));
+            } else {
+                auto converted = dst->clone_empty();
+                RETURN_IF_ERROR(_converter->convert(column, converted.get()));
+                dst->append(*converted);
+            }
 
             return Status::OK();
         }
@@ -359,6 +368,8 @@ public:
         _reader->get_levels(def_levels, rep_levels, num_levels);
     }
 
+    Status skip_rows(size_t num_rows) override { return _reader->skip_rows(num_rows); }
+
     Status get_dict_values(vectorized::Column* column) override { return _reader->get_dict_values(column); }
 
     Status get_dict_values(const std::vector<int32_t>& dict_codes, vectorized::Column* column) override {
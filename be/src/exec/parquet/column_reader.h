@@ -25,6 +25,8 @@ class ParquetField;
 struct ColumnReaderOptions {
     vectorized::HdfsScanStats* stats = nullptr;
     std::string timezone;
+    // the offset index of the column chunk, used to skip the pages without reading them
+    const tparquet::OffsetIndex* offset_index = nullptr;
 };
 
 class ColumnReader {
@@ -47,6 +49,9 @@ public:
 
     virtual void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) = 0;
 
+    // Skip the next num_rows rows, only supported by the non-repeated columns.
+    virtual Status skip_rows(size_t num_rows) { return Status::NotSupported("skip_rows is not supported"); }
+
     virtual Status get_dict_values(vectorized::Column* column) {
         return Status::NotSupported("get_dict_values is not supported");
     }
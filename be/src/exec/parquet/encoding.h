@@ -71,6 +71,9 @@ public:
     virtual Status next_batch(size_t count, uint8_t* dst) {
         return Status::NotSupported("next_batch is not supportted");
     }
+
+    // Skip the next count values, used to skip the rows filtered out by the page index.
+    virtual Status skip(size_t count) { return Status::NotSupported("skip is not supported"); }
 };
 
 class EncodingInfo {
@@ -125,6 +125,17 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override {
+        while (count > 0) {
+            size_t n = std::min(count, _indexes.size());
+            if (static_cast<size_t>(_index_batch_decoder.GetBatch(&_indexes[0], n)) != n) {
+                return Status::InternalError("going to skip out-of-bounds dict codes");
+            }
+            count -= n;
+        }
+        return Status::OK();
+    }
+
 private:
     enum { SIZE_OF_TYPE = sizeof(T) };
 
@@ -228,6 +239,17 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override {
+        while (count > 0) {
+            size_t n = std::min(count, _indexes.size());
+            if (static_cast<size_t>(_index_batch_decoder.GetBatch(&_indexes[0], n)) != n) {
+                return Status::InternalError("going to skip out-of-bounds dict codes");
+            }
+            count -= n;
+        }
+        return Status::OK();
+    }
+
 private:
     enum { SIZE_OF_DICT_CODE_TYPE = sizeof(int32_t) };
     std::unordered_map<Slice, int32_t, SliceHasher> _dict_code_by_value;
@@ -4,7 +4,10 @@
 
 #include <thrift/protocol/TDebugProtocol.h>
 
+#include <algorithm>
+
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "env/env.h"
 #include "exec/exec_node.h"
 #include "exec/parquet/encoding_plain.h"
@@ -23,6 +26,9 @@ static constexpr uint32_t kFooterSize = 8;
 
 FileReader::FileReader(RandomAccessFile* file, uint64_t file_size) : _file(file), _file_size(file_size) {}
 
+FileReader::FileReader(vectorized::CoalescedReadFile* file, uint64_t file_size)
+        : _file(file), _file_size(file_size), _coalesced_file(file) {}
+
 FileReader::~FileReader() = default;
 
 Status FileReader::init(const starrocks::vectorized::HdfsFileReaderParam& param) {
@@ -223,12 +229,7 @@ Status FileReader::_read_min_max_chunk(const tparquet::RowGroup& row_group, vect
             return Status::OK();
         } else {
             const ParquetField* field = _file_metadata->schema().resolve_by_name(slot->col_name());
-            const tparquet::ColumnOrder* column_order = nullptr;
-            if (_file_metadata->t_metadata().__isset.column_orders) {
-                const auto& column_orders = _file_metadata->t_metadata().column_orders;
-                int column_idx = field->physical_column_index;
-                column_order = column_idx < column_orders.size() ? &column_orders[column_idx] : nullptr;
-            }
+            const tparquet::ColumnOrder* column_order = _get_column_order(field->physical_column_index);
 
             Status status = _decode_min_max_column(*column_meta, column_order, &(*min_chunk)->columns()[i],
                                                    &(*max_chunk)->columns()[i]);
@@ -243,6 +244,151 @@ Status FileReader::_read_min_max_chunk(const tparquet::RowGroup& row_group, vect
     return Status::OK();
 }
 
+const tparquet::ColumnOrder* FileReader::_get_column_order(int column_idx) const {
+    if (!_file_metadata->t_metadata().__isset.column_orders) {
+        return nullptr;
+    }
+    const auto& column_orders = _file_metadata->t_metadata().column_orders;
+    return column_idx < column_orders.size() ? &column_orders[column_idx] : nullptr;
+}
+
+template <typename T>
+static Status read_page_index(RandomAccessFile* file, int64_t offset, int32_t length, T* index) {
+    std::vector<uint8_t> buf(length);
+    RETURN_IF_ERROR(file->read_at(offset, Slice(buf.data(), length)));
+    uint32_t len = length;
+    return deserialize_thrift_msg(buf.data(), &len, true, index);
+}
+
+Status FileReader::_init_page_index(const tparquet::RowGroup& row_group, GroupReaderParam* param) {
+    SCOPED_RAW_TIMER(&_param.stats->page_index_read_ns);
+    // the rows of the repeated columns can't be skipped
+    for (const auto& column : _read_cols) {
+        if (_file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet)->max_rep_level() > 0) {
+            return Status::OK();
+        }
+    }
+    if (_param.min_max_conjunct_ctxs.empty()) {
+        return Status::OK();
+    }
+
+    auto row_ranges = std::make_shared<vectorized::SparseRange>(0, row_group.num_rows);
+    const auto& slots = _param.min_max_tuple_desc->slots();
+    for (size_t i = 0; i < slots.size(); i++) {
+        // the conjuncts of only this slot
+        std::vector<ExprContext*> conjunct_ctxs;
+        for (ExprContext* ctx : _param.min_max_conjunct_ctxs) {
+            std::vector<SlotId> slot_ids;
+            ctx->root()->get_slot_ids(&slot_ids);
+            if (!slot_ids.empty() &&
+                std::all_of(slot_ids.begin(), slot_ids.end(), [&](SlotId id) { return id == slots[i]->id(); })) {
+                conjunct_ctxs.emplace_back(ctx);
+            }
+        }
+        if (conjunct_ctxs.empty()) {
+            continue;
+        }
+        const ParquetField* field = _file_metadata->schema().resolve_by_name(slots[i]->col_name());
+        if (field == nullptr || field->max_rep_level() > 0 || !field->children.empty()) {
+            continue;
+        }
+        const tparquet::ColumnChunk& chunk = row_group.columns[field->physical_column_index];
+        if (!chunk.__isset.column_index_offset || !chunk.__isset.offset_index_offset ||
+            !_can_use_stats(chunk.meta_data.type, _get_column_order(field->physical_column_index))) {
+            continue;
+        }
+
+        tparquet::ColumnIndex column_index;
+        RETURN_IF_ERROR(read_page_index(_file, chunk.column_index_offset, chunk.column_index_length, &column_index));
+        auto iter = param->offset_indexes.find(field->physical_column_index);
+        if (iter == param->offset_indexes.end()) {
+            iter = param->offset_indexes.emplace(field->physical_column_index, tparquet::OffsetIndex()).first;
+            RETURN_IF_ERROR(
+                    read_page_index(_file, chunk.offset_index_offset, chunk.offset_index_length, &iter->second));
+        }
+        vectorized::SparseRange page_ranges;
+        Status st = _select_pages(row_group, i, conjunct_ctxs, chunk.meta_data.type, column_index, iter->second,
+                                  &page_ranges);
+        if (!st.ok()) {
+            VLOG(1) << "can't select the pages of column " << slots[i]->col_name() << ": " << st.to_string();
+            continue;
+        }
+        *row_ranges &= page_ranges;
+    }
+    if (row_ranges->span_size() == row_group.num_rows) {
+        param->offset_indexes.clear();
+        return Status::OK();
+    }
+
+    // the offset indexes of the read columns to skip their pages
+    for (const auto& column : _read_cols) {
+        const tparquet::ColumnChunk& chunk = row_group.columns[column.col_idx_in_parquet];
+        if (chunk.__isset.offset_index_offset && param->offset_indexes.count(column.col_idx_in_parquet) == 0) {
+            RETURN_IF_ERROR(read_page_index(_file, chunk.offset_index_offset, chunk.offset_index_length,
+                                            &param->offset_indexes[column.col_idx_in_parquet]));
+        }
+    }
+    param->row_ranges = std::move(row_ranges);
+    return Status::OK();
+}
+
+Status FileReader::_select_pages(const tparquet::RowGroup& row_group, size_t slot_idx,
+                                 const std::vector<ExprContext*>& conjunct_ctxs, tparquet::Type::type type,
+                                 const tparquet::ColumnIndex& column_index, const tparquet::OffsetIndex& offset_index,
+                                 vectorized::SparseRange* page_ranges) const {
+    const auto& locations = offset_index.page_locations;
+    const size_t num_pages = locations.size();
+    if (column_index.null_pages.size() != num_pages || column_index.min_values.size() != num_pages ||
+        column_index.max_values.size() != num_pages) {
+        return Status::Corruption("column index doesn't match offset index");
+    }
+
+    // the min/max values of the pages, the other slots are never evaluated by the conjuncts
+    auto min_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, num_pages);
+    auto max_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, num_pages);
+    for (size_t i = 0; i < min_chunk->num_columns(); i++) {
+        if (i != slot_idx) {
+            min_chunk->columns()[i]->append_default(num_pages);
+            max_chunk->columns()[i]->append_default(num_pages);
+        }
+    }
+    vectorized::ColumnPtr& min_column = min_chunk->columns()[slot_idx];
+    vectorized::ColumnPtr& max_column = max_chunk->columns()[slot_idx];
+    for (size_t i = 0; i < num_pages; i++) {
+        if (column_index.null_pages[i]) {
+            if (!min_column->append_nulls(1) || !max_column->append_nulls(1)) {
+                return Status::NotSupported("null page of not nullable column");
+            }
+        } else {
+            RETURN_IF_ERROR(_decode_min_max_value(type, column_index.min_values[i], column_index.max_values[i],
+                                                  &min_column, &max_column));
+        }
+    }
+    if (min_column->size() != num_pages || max_column->size() != num_pages) {
+        return Status::NotSupported("min max values of pages not supported");
+    }
+
+    // the same as _filter_group, a page is filtered out if a conjunct is false on both its min and max
+    std::vector<uint8_t> selected(num_pages, 1);
+    for (ExprContext* ctx : conjunct_ctxs) {
+        auto min_result = ctx->evaluate(min_chunk.get());
+        auto max_result = ctx->evaluate(max_chunk.get());
+        for (size_t i = 0; i < num_pages; i++) {
+            if (!min_result->is_null(i) && !max_result->is_null(i) && min_result->get(i).get_int8() == 0 &&
+                max_result->get(i).get_int8() == 0) {
+                selected[i] = 0;
+            }
+        }
+    }
+    for (size_t i = 0; i < num_pages; i++) {
+        if (selected[i]) {
+            int64_t end = i + 1 < num_pages ? locations[i + 1].first_row_index : row_group.num_rows;
+            page_ranges->add(vectorized::Range(locations[i].first_row_index, end));
+        }
+    }
+    return Status::OK();
+}
+
 int FileReader::_get_partition_column_idx(const std::string& col_name) const {
     for (size_t i = 0; i < _param.partition_columns.size(); i++) {
         if (_param.partition_columns[i].col_name == col_name) {
@@ -259,17 +405,22 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
         return Status::NotSupported("min max statistics not supported");
     }
 
-    switch (column_meta.type) {
+    const tparquet::Statistics& statistics = column_meta.statistics;
+    if (statistics.__isset.min_value) {
+        return _decode_min_max_value(column_meta.type, statistics.min_value, statistics.max_value, min_column,
+                                     max_column);
+    }
+    return _decode_min_max_value(column_meta.type, statistics.min, statistics.max, min_column, max_column);
+}
+
+Status FileReader::_decode_min_max_value(tparquet::Type::type type, const std::string& min, const std::string& max,
+                                         vectorized::ColumnPtr* min_column, vectorized::ColumnPtr* max_column) {
+    switch (type) {
     case tparquet::Type::type::INT32: {
         int32_t min_value = 0;
         int32_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max, &max_value));
-        }
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(min, &min_value));
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(max, &max_value));
         (*min_column)->append_numbers(&min_value, sizeof(int32_t));
         (*max_column)->append_numbers(&max_value, sizeof(int32_t));
         return Status::OK();
@@ -277,13 +428,8 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
     case tparquet::Type::type::INT64: {
         int64_t min_value = 0;
         int64_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max, &max_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min, &min_value));
-        }
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(min, &min_value));
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(max, &max_value));
         (*min_column)->append_numbers(&min_value, sizeof(int64_t));
         (*max_column)->append_numbers(&max_value, sizeof(int64_t));
         return Status::OK();
@@ -291,13 +437,8 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
     case tparquet::Type::type::BYTE_ARRAY: {
         Slice min_slice;
         Slice max_slice;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min_value, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max_value, &max_slice));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max, &max_slice));
-        }
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(min, &min_slice));
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(max, &max_slice));
         (*min_column)->append_strings(std::vector<Slice>{min_slice});
         (*max_column)->append_strings(std::vector<Slice>{max_slice});
         return Status::OK();
@@ -344,8 +485,6 @@ bool FileReader::_is_integer_type(const tparquet::Type::type& type) {
 }
 
 Status FileReader::_create_and_init_group_reader(int row_group_number) {
-    auto row_group_reader = _row_group(row_group_number);
-
     GroupReaderParam param;
     param.tuple_desc = _param.tuple_desc;
     param.conjunct_ctxs_by_slot = _param.conjunct_ctxs_by_slot;
@@ -353,6 +492,19 @@ Status FileReader::_create_and_init_group_reader(int row_group_number) {
     param.timezone = _param.timezone;
     param.stats = _param.stats;
 
+    if (config::parquet_page_index_enable && !_read_cols.empty()) {
+        Status st = _init_page_index(_file_metadata->t_metadata().row_groups[row_group_number], &param);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to read page index of row group " << row_group_number << ": " << st.to_string();
+            param.row_ranges = nullptr;
+            param.offset_indexes.clear();
+        } else if (param.row_ranges != nullptr && param.row_ranges->empty()) {
+            LOG(INFO) << "row group " << row_group_number << " of file has been filtered by page index";
+            return Status::OK();
+        }
+    }
+
+    auto row_group_reader = _row_group(row_group_number);
     RETURN_IF_ERROR(row_group_reader->init(param));
     _row_group_readers.emplace_back(row_group_reader);
     return Status::OK();
@@ -374,6 +526,7 @@ bool FileReader::_select_row_group(const tparquet::RowGroup& row_group) {
 }
 
 Status FileReader::_init_group_reader() {
+    std::vector<size_t> row_groups;
     for (size_t i = 0; i < _file_metadata->t_metadata().row_groups.size(); i++) {
         bool selected = _select_row_group(_file_metadata->t_metadata().row_groups[i]);
 
@@ -384,19 +537,73 @@ Status FileReader::_init_group_reader() {
                 LOG(INFO) << "row group " << i << " of file has been filtered by min/max conjunct";
                 continue;
             }
+            row_groups.emplace_back(i);
+        }
+    }
 
-            RETURN_IF_ERROR(_create_and_init_group_reader(i));
+    // The column readers read the first pages when they are created, so the column chunks of all the row groups
+    // are prefetched before, as many as the buffer of the file allows.
+    std::vector<vectorized::CoalescedReadFile::IORange> io_ranges;
+    if (_coalesced_file != nullptr && !_read_cols.empty()) {
+        for (size_t i : row_groups) {
+            io_ranges.emplace_back(_plan_row_group_io(_file_metadata->t_metadata().row_groups[i]));
+        }
+        _coalesced_file->prefetch(0, _file_size);
+    }
 
-            _total_row_count += _file_metadata->t_metadata().row_groups[i].num_rows;
-        } else {
-            continue;
+    for (size_t k = 0; k < row_groups.size(); k++) {
+        size_t i = row_groups[k];
+        size_t num_readers = _row_group_readers.size();
+        RETURN_IF_ERROR(_create_and_init_group_reader(i));
+        if (!io_ranges.empty()) {
+            if (_row_group_readers.size() > num_readers) {
+                _row_group_io_ranges.emplace_back(io_ranges[k]);
+            } else {
+                // filtered by page index
+                _coalesced_file->release(io_ranges[k].offset, io_ranges[k].size);
+            }
         }
+
+        _total_row_count += _file_metadata->t_metadata().row_groups[i].num_rows;
     }
 
     _row_group_size = _row_group_readers.size();
     return Status::OK();
 }
 
+static void get_physical_column_indexes(const ParquetField* field, std::vector<int>* indexes) {
+    if (field->children.empty()) {
+        indexes->emplace_back(field->physical_column_index);
+        return;
+    }
+    for (const auto& child : field->children) {
+        get_physical_column_indexes(&child, indexes);
+    }
+}
+
+vectorized::CoalescedReadFile::IORange FileReader::_plan_row_group_io(const tparquet::RowGroup& row_group) {
+    std::vector<int> column_indexes;
+    for (const auto& column : _read_cols) {
+        const auto* field = _file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet);
+        get_physical_column_indexes(field, &column_indexes);
+    }
+
+    std::vector<vectorized::CoalescedReadFile::IORange> ranges;
+    uint64_t start = _file_size;
+    uint64_t end = 0;
+    for (int idx : column_indexes) {
+        const auto& column_meta = row_group.columns[idx].meta_data;
+        // the same as the start offset of ColumnChunkReader
+        int64_t offset = column_meta.__isset.dictionary_page_offset ? column_meta.dictionary_page_offset
+                                                                      : column_meta.data_page_offset;
+        ranges.emplace_back(offset, column_meta.total_compressed_size);
+        start = std::min<uint64_t>(start, offset);
+        end = std::max<uint64_t>(end, offset + column_meta.total_compressed_size);
+    }
+    _coalesced_file->plan(std::move(ranges));
+    return {start, end > start ? end - start : 0};
+}
+
 Status FileReader::_get_next_internal(vectorized::ChunkPtr* chunk) {
     if (_is_only_partition_scan) {
         RETURN_IF_ERROR(_exec_only_partition_scan(chunk));
@@ -414,6 +621,10 @@ Status FileReader::_get_next_internal(vectorized::ChunkPtr* chunk) {
                 _scan_row_count += (*chunk)->num_rows();
             }
             if (status.is_end_of_file()) {
+                if (!_row_group_io_ranges.empty()) {
+                    const auto& range = _row_group_io_ranges[_cur_row_group_idx];
+                    _coalesced_file->release(range.offset, range.size);
+                }
                 _cur_row_group_idx++;
                 return Status::OK();
             }
@@ -8,6 +8,7 @@
 #include "column/chunk.h"
 #include "common/status.h"
 #include "exec/parquet/group_reader.h"
+#include "exec/vectorized/coalesced_read_file.h"
 #include "gen_cpp/parquet_types.h"
 #include "util/runtime_profile.h"
 
@@ -28,6 +29,9 @@ class FileMetaData;
 class FileReader {
 public:
     FileReader(RandomAccessFile* file, uint64_t file_size);
+    // The column chunks of the row groups to read are planned on |file|, so they are read by coalesced ios and
+    // prefetched.
+    FileReader(vectorized::CoalescedReadFile* file, uint64_t file_size);
     ~FileReader();
 
     Status init(const starrocks::vectorized::HdfsFileReaderParam& param);
@@ -59,6 +63,10 @@ private:
     // init row group reader
     Status _init_group_reader();
 
+    // plan to read the column chunks of the read columns of the row group on _coalesced_file, and returns the
+    // byte range covering them
+    vectorized::CoalescedReadFile::IORange _plan_row_group_io(const tparquet::RowGroup& row_group);
+
     // filter row group by min/max conjuncts
     Status _filter_group(const tparquet::RowGroup& group, bool* is_filter);
 
@@ -67,6 +75,20 @@ private:
     // TODO: later modify the larger block should be read
     bool _select_row_group(const tparquet::RowGroup& row_group);
 
+    // read the page index of row group into param: the offset indexes of the read columns to skip the
+    // pages, and the rows selected by min/max conjuncts and the column indexes of the pages
+    Status _init_page_index(const tparquet::RowGroup& row_group, GroupReaderParam* param);
+
+    // select the pages of column chunk by the min/max conjuncts of the |slot_idx|-th slot of min_max_tuple_desc
+    // and the min/max values of the pages
+    Status _select_pages(const tparquet::RowGroup& row_group, size_t slot_idx,
+                         const std::vector<ExprContext*>& conjunct_ctxs, tparquet::Type::type type,
+                         const tparquet::ColumnIndex& column_index, const tparquet::OffsetIndex& offset_index,
+                         vectorized::SparseRange* page_ranges) const;
+
+    // get the column order of the column by its physical index, nullptr if it's not set
+    const tparquet::ColumnOrder* _get_column_order(int column_idx) const;
+
     // make min/max chunk from stats of row group meta
     // exist=true: group meta contain statistics info
     Status _read_min_max_chunk(const tparquet::RowGroup& row_group, vectorized::ChunkPtr* min_chunk,
@@ -94,6 +116,9 @@ private:
     static Status _decode_min_max_column(const tparquet::ColumnMetaData& column_meta,
                                          const tparquet::ColumnOrder* column_order, vectorized::ColumnPtr* min_column,
                                          vectorized::ColumnPtr* max_column);
+    // decode plain encoded min/max value of statistics or column index
+    static Status _decode_min_max_value(tparquet::Type::type type, const std::string& min, const std::string& max,
+                                        vectorized::ColumnPtr* min_column, vectorized::ColumnPtr* max_column);
     static bool _can_use_min_max_stats(const tparquet::ColumnMetaData& column_meta,
                                        const tparquet::ColumnOrder* column_order);
     // statistics.min_value max_value
@@ -111,10 +136,14 @@ private:
 
     RandomAccessFile* _file;
     uint64_t _file_size;
+    // it's _file if the reads are coalesced, or nullptr
+    vectorized::CoalescedReadFile* _coalesced_file = nullptr;
 
     starrocks::vectorized::HdfsFileReaderParam _param;
     std::shared_ptr<FileMetaData> _file_metadata;
     vector<std::shared_ptr<GroupReader>> _row_group_readers;
+    // the byte ranges planned of the row group readers, released after they are read
+    vector<vectorized::CoalescedReadFile::IORange> _row_group_io_ranges;
     size_t _cur_row_group_idx = 0;
     size_t _row_group_size = 0;
     vectorized::Schema _schema;
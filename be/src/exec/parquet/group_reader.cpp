@@ -4,8 +4,10 @@
 #include "exec/parquet/group_reader.h"
 
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "exec/exec_node.h"
 #include "exprs/expr.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/types.h"
 #include "simd/simd.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -14,6 +16,9 @@ namespace starrocks::parquet {
 
 constexpr static const PrimitiveType kDictCodePrimitiveType = TYPE_INT;
 constexpr static const FieldType kDictCodeFieldType = OLAP_FIELD_TYPE_INT;
+// The unselected rows between the selected ones are read and filtered out instead of being skipped by the lazy
+// columns if there are fewer of them, since skipping a few values costs more than decoding them.
+constexpr static const size_t kMinLazySkipRows = 64;
 
 GroupReader::GroupReader(RandomAccessFile* file, FileMetaData* file_metadata, int row_group_number)
         : _file(file), _file_metadata(file_metadata), _row_group_number(row_group_number) {
@@ -25,6 +30,9 @@ Status GroupReader::init(const GroupReaderParam& param) {
     _param = param;
     // the calling order matters, do not change unless you know why.
     RETURN_IF_ERROR(_init_column_readers());
+    if (_param.row_ranges != nullptr) {
+        _range_iter = _param.row_ranges->new_iterator();
+    }
     _pre_process_columns_and_conjunct_ctxs();
     RETURN_IF_ERROR(_rewrite_dict_column_predicates());
     _init_read_chunk();
@@ -53,19 +61,32 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
         }
     }
 
-    // dict filter
-    if (has_dict_filter) {
-        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
-        SCOPED_RAW_TIMER(&_param.stats->group_dict_filter_ns);
-        _dict_filter();
+    if (!_lazy_read_columns.empty()) {
+        // late materialization
+        {
+            SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+            _filter_active_columns(count);
+        }
+        {
+            SCOPED_RAW_TIMER(&_param.stats->group_chunk_read_ns);
+            RETURN_IF_ERROR(_read_lazy_columns(count));
+        }
         _read_chunk->check_or_die();
-    }
+    } else {
+        // dict filter
+        if (has_dict_filter) {
+            SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+            SCOPED_RAW_TIMER(&_param.stats->group_dict_filter_ns);
+            _dict_filter();
+            _read_chunk->check_or_die();
+        }
 
-    // other filter that not dict
-    if (has_more_filter) {
-        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
-        ExecNode::eval_conjuncts(_left_conjunct_ctxs, _read_chunk.get());
-        _read_chunk->check_or_die();
+        // other filter that not dict
+        if (has_more_filter) {
+            SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+            ExecNode::eval_conjuncts(_left_conjunct_ctxs, _read_chunk.get());
+            _read_chunk->check_or_die();
+        }
     }
 
     *row_count = _read_chunk->num_rows();
@@ -91,6 +112,10 @@ Status GroupReader::_create_column_reader(const GroupReaderParam::Column& column
     ColumnReaderOptions opts;
     opts.stats = _param.stats;
     opts.timezone = _param.timezone;
+    auto iter = _param.offset_indexes.find(schema_node->physical_column_index);
+    if (iter != _param.offset_indexes.end()) {
+        opts.offset_index = &iter->second;
+    }
     {
         SCOPED_RAW_TIMER(&_param.stats->column_reader_init_ns);
         RETURN_IF_ERROR(ColumnReader::create(_file, schema_node, *_row_group_metadata, column.col_type_in_chunk, opts,
@@ -120,6 +145,24 @@ void GroupReader::_pre_process_columns_and_conjunct_ctxs() {
             }
         }
     }
+
+    // The columns without conjuncts are read after the conjuncts are evaluated, only for the rows selected.
+    // The repeated columns can't skip rows, so they are read with the others.
+    if (!config::parquet_late_materialization_enable ||
+        (_dict_filter_columns.empty() && _left_conjunct_ctxs.empty())) {
+        return;
+    }
+    std::vector<GroupReaderParam::Column> active_columns;
+    for (const auto& column : _direct_read_columns) {
+        const auto* schema_node = _file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet);
+        if (conjunct_ctxs_by_slot.find(column.slot_id) == conjunct_ctxs_by_slot.end() &&
+            schema_node->type.type != TYPE_ARRAY && schema_node->max_rep_level() == 0) {
+            _lazy_read_columns.emplace_back(column);
+        } else {
+            active_columns.emplace_back(column);
+        }
+    }
+    _direct_read_columns.swap(active_columns);
 }
 
 bool GroupReader::_can_using_dict_filter(const SlotDescriptor* slot, const SlotIdExprContextsMap& conjunct_ctxs_by_slot,
@@ -274,9 +317,32 @@ void GroupReader::_init_read_chunk() {
         dict_code_column->reserve(chunk_size);
         _read_chunk->update_column(dict_code_column, slot_id);
     }
+
+    if (!_lazy_read_columns.empty()) {
+        // shares the columns with _read_chunk
+        _active_chunk = std::make_shared<vectorized::Chunk>();
+        for (const auto& column : _dict_filter_columns) {
+            _active_chunk->append_column(_read_chunk->get_column_by_slot_id(column.slot_id), column.slot_id);
+        }
+        for (const auto& column : _direct_read_columns) {
+            _active_chunk->append_column(_read_chunk->get_column_by_slot_id(column.slot_id), column.slot_id);
+        }
+    }
 }
 
 Status GroupReader::_read(size_t* row_count) {
+    if (_param.row_ranges != nullptr) {
+        if (!_range_iter.has_more()) {
+            *row_count = 0;
+            return Status::EndOfFile("");
+        }
+        vectorized::Range range = _range_iter.next(*row_count);
+        if (range.begin() > _next_row) {
+            RETURN_IF_ERROR(_skip_rows(range.begin() - _next_row));
+        }
+        _next_row = range.end();
+        *row_count = range.span_size();
+    }
     size_t count = *row_count;
 
     for (const auto& column : _dict_filter_columns) {
@@ -305,6 +371,16 @@ Status GroupReader::_read(size_t* row_count) {
     }
 
     *row_count = count;
+    if (_param.row_ranges != nullptr && !_range_iter.has_more()) {
+        return Status::EndOfFile("");
+    }
+    return Status::OK();
+}
+
+Status GroupReader::_skip_rows(size_t num_rows) {
+    for (auto& [slot_id, column_reader] : _column_readers) {
+        RETURN_IF_ERROR(column_reader->skip_rows(num_rows));
+    }
     return Status::OK();
 }
 
@@ -330,6 +406,111 @@ void GroupReader::_dict_filter() {
     }
 }
 
+void GroupReader::_filter_active_columns(size_t num_rows) {
+    _active_filter.assign(num_rows, 1);
+    if (num_rows == 0) {
+        return;
+    }
+
+    if (!_dict_filter_preds.empty()) {
+        SCOPED_RAW_TIMER(&_param.stats->group_dict_filter_ns);
+        for (const auto& [slot_id, pred] : _dict_filter_preds) {
+            pred->evaluate_and(_active_chunk->get_column_by_slot_id(slot_id).get(), _active_filter.data());
+        }
+    }
+
+    for (ExprContext* ctx : _left_conjunct_ctxs) {
+        vectorized::ColumnPtr column = ctx->evaluate(_active_chunk.get());
+        size_t true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+        if (true_count == column->size()) {
+            continue;
+        }
+        if (true_count == 0) {
+            _active_filter.assign(num_rows, 0);
+            break;
+        }
+        bool all_zero = false;
+        vectorized::ColumnHelper::merge_two_filters(column, &_active_filter, &all_zero);
+        if (all_zero) {
+            break;
+        }
+    }
+
+    auto hit_count = SIMD::count_nonzero(_active_filter.data(), num_rows);
+    if (hit_count == 0) {
+        _active_chunk->set_num_rows(0);
+    } else if (hit_count != num_rows) {
+        _active_chunk->filter(_active_filter);
+    }
+}
+
+Status GroupReader::_read_lazy_columns(size_t num_rows) {
+    const uint8_t* filter = _active_filter.data();
+    _lazy_ranges.clear();
+    size_t num_read_rows = 0;
+    size_t i = 0;
+    while (i < num_rows) {
+        if (!filter[i]) {
+            i++;
+            continue;
+        }
+        size_t begin = i;
+        while (i < num_rows && filter[i]) {
+            i++;
+        }
+        if (!_lazy_ranges.empty() && begin - _lazy_ranges.back().second < kMinLazySkipRows) {
+            num_read_rows += i - _lazy_ranges.back().second;
+            _lazy_ranges.back().second = i;
+        } else {
+            num_read_rows += i - begin;
+            _lazy_ranges.emplace_back(begin, i);
+        }
+    }
+    _param.stats->late_materialize_skip_rows += num_rows - num_read_rows;
+
+    // the unselected rows read are filtered out then
+    bool need_filter = num_read_rows != _active_chunk->num_rows();
+    if (need_filter) {
+        _lazy_filter.clear();
+        for (const auto& [begin, end] : _lazy_ranges) {
+            _lazy_filter.insert(_lazy_filter.end(), filter + begin, filter + end);
+        }
+    }
+
+    for (const auto& column : _lazy_read_columns) {
+        SlotId slot_id = column.slot_id;
+        ColumnReader* column_reader = _column_readers[slot_id].get();
+        vectorized::ColumnPtr& dst = _read_chunk->get_column_by_slot_id(slot_id);
+        size_t next_row = 0;
+        for (const auto& [begin, end] : _lazy_ranges) {
+            if (begin > next_row) {
+                RETURN_IF_ERROR(column_reader->skip_rows(begin - next_row));
+            }
+            size_t count = end - begin;
+            Status status = column_reader->next_batch(&count, ColumnContentType::VALUE, dst.get());
+            if (!status.ok() && !status.is_end_of_file()) {
+                return status;
+            }
+            if (count != end - begin) {
+                return Status::InternalError(
+                        strings::Substitute("read $0 rows of lazy column $1, expect $2", count, slot_id, end - begin));
+            }
+            next_row = end;
+        }
+        // keep the column at the same row as the others, it may reach the end of the row group
+        if (num_rows > next_row) {
+            Status status = column_reader->skip_rows(num_rows - next_row);
+            if (!status.ok() && !status.is_end_of_file()) {
+                return status;
+            }
+        }
+        if (need_filter) {
+            dst->filter(_lazy_filter);
+        }
+    }
+    return Status::OK();
+}
+
 Status GroupReader::_dict_decode(vectorized::ChunkPtr* chunk) {
     const auto& slots = _param.tuple_desc->slots();
 
@@ -359,6 +540,11 @@ Status GroupReader::_dict_decode(vectorized::ChunkPtr* chunk) {
         SlotId slot_id = column.slot_id;
         (*chunk)->get_column_by_slot_id(slot_id)->swap_column(*(_read_chunk->get_column_by_slot_id(slot_id)));
     }
+
+    for (const auto& column : _lazy_read_columns) {
+        SlotId slot_id = column.slot_id;
+        (*chunk)->get_column_by_slot_id(slot_id)->swap_column(*(_read_chunk->get_column_by_slot_id(slot_id)));
+    }
     return Status::OK();
 }
 } // namespace starrocks::parquet
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "gen_cpp/parquet_types.h"
 #include "runtime/descriptors.h"
 #include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/range.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks {
@@ -49,6 +50,13 @@ struct GroupReaderParam {
     std::string timezone;
 
     vectorized::HdfsScanStats* stats = nullptr;
+
+    // The rows of the row group selected by the page index, the others are skipped. All the rows
+    // are read if it's nullptr.
+    std::shared_ptr<vectorized::SparseRange> row_ranges;
+    // The offset indexes of the column chunks by the physical column index, used to skip the pages
+    // without reading them.
+    std::unordered_map<int, tparquet::OffsetIndex> offset_indexes;
 };
 
 class GroupReader {
@@ -74,7 +82,14 @@ private:
     void _init_read_chunk();
 
     Status _read(size_t* row_count);
+    // skip num_rows rows of all the columns
+    Status _skip_rows(size_t num_rows);
     void _dict_filter();
+    // Evaluate the conjuncts on the columns read by _read() into _active_filter, and filter out the rows
+    // unselected from them.
+    void _filter_active_columns(size_t num_rows);
+    // Read the lazy columns of the num_rows rows of the batch, only the rows selected by _active_filter.
+    Status _read_lazy_columns(size_t num_rows);
     Status _dict_decode(vectorized::ChunkPtr* chunk);
 
     RandomAccessFile* _file;
@@ -101,12 +116,25 @@ private:
     std::vector<GroupReaderParam::Column> _dict_filter_columns;
     // direct read conlumns
     std::vector<GroupReaderParam::Column> _direct_read_columns;
+    // columns without conjuncts, which are read only for the rows selected by the conjuncts on the
+    // dict filter columns and direct read columns
+    std::vector<GroupReaderParam::Column> _lazy_read_columns;
 
     // dict value is empty after conjunct eval, file group can be skipped
     bool _is_group_filtered = false;
 
     vectorized::ChunkPtr _read_chunk;
     vectorized::Buffer<uint8_t> _selection;
+    // the dict filter columns and direct read columns of _read_chunk, used when there are lazy columns
+    vectorized::ChunkPtr _active_chunk;
+    vectorized::Column::Filter _active_filter;
+    // the ranges of the rows of a batch read by the lazy columns, and the filter of the rows read
+    std::vector<std::pair<size_t, size_t>> _lazy_ranges;
+    vectorized::Column::Filter _lazy_filter;
+
+    // iterator of _param.row_ranges, and the next row to read by the column readers
+    vectorized::SparseRangeIterator _range_iter;
+    uint64_t _next_row = 0;
 
     // param for read row group
     GroupReaderParam _param;
@@ -20,6 +20,7 @@ public:
 
         ColumnChunkReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.offset_index = _opts.offset_index;
         _reader.reset(new ColumnChunkReader(_field->max_def_level(), _field->max_rep_level(), _field->type_length,
                                             chunk_metadata, file, opts));
         RETURN_IF_ERROR(_reader->init());
@@ -75,6 +76,7 @@ public:
 
         ColumnChunkReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.offset_index = _opts.offset_index;
         _reader.reset(new ColumnChunkReader(_field->max_def_level(), _field->max_rep_level(), _field->type_length,
                                             chunk_metadata, file, opts));
         RETURN_IF_ERROR(_reader->init());
@@ -93,6 +95,8 @@ public:
         }
     }
 
+    Status skip_rows(size_t num_rows) override;
+
     void set_needs_levels(bool needs_levels) { _needs_levels = needs_levels; }
 
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) override {
@@ -128,6 +132,7 @@ private:
 
     std::vector<uint8_t> _is_nulls;
     std::vector<level_t> _def_levels;
+    std::vector<level_t> _skipped_def_levels;
 };
 
 class RequiredStoredColumnReader : public StoredColumnReader {
@@ -140,9 +145,11 @@ public:
 
         ColumnChunkReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.offset_index = _opts.offset_index;
         _reader.reset(new ColumnChunkReader(_field->max_def_level(), _field->max_rep_level(), _field->type_length,
                                             chunk_metadata, file, opts));
         RETURN_IF_ERROR(_reader->init());
+        _num_values_left_in_cur_page = _reader->num_values();
         return Status::OK();
     }
 
@@ -150,6 +157,8 @@ public:
 
     Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) override;
 
+    Status skip_rows(size_t num_rows) override;
+
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) {
         *def_levels = nullptr;
         *rep_levels = nullptr;
@@ -430,6 +439,37 @@ Status OptionalStoredColumnReader::_read_records_only(size_t* num_records, Colum
     return Status::OK();
 }
 
+Status OptionalStoredColumnReader::skip_rows(size_t num_rows) {
+    if (_eof) {
+        return Status::EndOfFile("");
+    }
+    if (num_rows >= _num_values_left_in_cur_page) {
+        uint64_t row = _reader->page_first_row() + _reader->num_values() - _num_values_left_in_cur_page + num_rows;
+        RETURN_IF_ERROR(_reader->seek_to_page_of_row(row));
+        _num_values_left_in_cur_page = _reader->num_values();
+        _levels_parsed = _levels_decoded = 0;
+        num_rows = row - _reader->page_first_row();
+    }
+
+    // the levels decoded but not parsed yet are of the first rows to skip
+    size_t num_values = 0;
+    size_t num_levels = std::min(num_rows, _levels_decoded - _levels_parsed);
+    for (size_t i = 0; i < num_levels; ++i) {
+        num_values += _def_levels[_levels_parsed + i] >= _field->max_def_level();
+    }
+    _levels_parsed += num_levels;
+    if (num_rows > num_levels) {
+        _skipped_def_levels.resize(num_rows - num_levels);
+        _reader->decode_def_levels(_skipped_def_levels.size(), &_skipped_def_levels[0]);
+        for (level_t level : _skipped_def_levels) {
+            num_values += level >= _field->max_def_level();
+        }
+    }
+    RETURN_IF_ERROR(_reader->skip_values(num_values));
+    _num_values_left_in_cur_page -= num_rows;
+    return Status::OK();
+}
+
 Status OptionalStoredColumnReader::_next_page() {
     do {
         RETURN_IF_ERROR(_reader->next_page());
@@ -483,6 +523,18 @@ Status RequiredStoredColumnReader::read_records(size_t* num_records, ColumnConte
     return Status::OK();
 }
 
+Status RequiredStoredColumnReader::skip_rows(size_t num_rows) {
+    if (num_rows >= _num_values_left_in_cur_page) {
+        uint64_t row = _reader->page_first_row() + _reader->num_values() - _num_values_left_in_cur_page + num_rows;
+        RETURN_IF_ERROR(_reader->seek_to_page_of_row(row));
+        _num_values_left_in_cur_page = _reader->num_values();
+        num_rows = row - _reader->page_first_row();
+    }
+    RETURN_IF_ERROR(_reader->skip_values(num_rows));
+    _num_values_left_in_cur_page -= num_rows;
+    return Status::OK();
+}
+
 Status RequiredStoredColumnReader::_next_page() {
     do {
         RETURN_IF_ERROR(_reader->next_page());
@@ -26,6 +26,7 @@ class ColumnChunkReader;
 
 struct StoredColumnReaderOptions {
     vectorized::HdfsScanStats* stats = nullptr;
+    const tparquet::OffsetIndex* offset_index = nullptr;
 };
 
 class StoredColumnReader {
@@ -50,6 +51,10 @@ public:
     // this function will fill (1, 2, 3, 4, 5, 6) into 'dst'.
     virtual Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) = 0;
 
+    // Skip the next num_rows rows, the pages of them are skipped without being read if the offset
+    // index is provided. Not supported by the repeated columns.
+    virtual Status skip_rows(size_t num_rows) { return Status::NotSupported("skip_rows is not supported"); }
+
     // This function can only be called after calling read_values. This function returns the
     // levels for last read_values.
     virtual void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) = 0;
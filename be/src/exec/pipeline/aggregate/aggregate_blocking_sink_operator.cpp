@@ -0,0 +1,89 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "runtime/runtime_state.h"
+#include "simd/simd.h"
+
+namespace starrocks::pipeline {
+
+Status AggregateBlockingSinkOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    // The hash map outlives this operator, so its memory is accounted to the fragment instance.
+    RETURN_IF_ERROR(
+            _aggregator->prepare(state, state->obj_pool(), _runtime_profile.get(), state->instance_mem_tracker()));
+    return _aggregator->open(state);
+}
+
+Status AggregateBlockingSinkOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->unref(state));
+    return Operator::close(state);
+}
+
+void AggregateBlockingSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    if (_aggregator->is_multi_distinct_count()) {
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
+        _aggregator->finish_multi_distinct_set();
+    } else if (!_aggregator->is_none_group_by_exprs()) {
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        // If hash map is empty, we don't need to return value
+        if (_aggregator->hash_map_variant().size() == 0) {
+            _aggregator->set_finished();
+        }
+        _aggregator->init_hash_map_iterator();
+    } else {
+        // for aggregate no group by, if _num_input_rows is 0,
+        // In update phase, we directly return empty chunk.
+        // In merge phase, we will handle it.
+        if (_aggregator->num_input_rows() == 0 && !_aggregator->needs_finalize()) {
+            _aggregator->set_finished();
+        }
+    }
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+    _aggregator->sink_complete();
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateBlockingSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Not support");
+}
+
+Status AggregateBlockingSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    DCHECK_LE(chunk->num_rows(), config::vector_chunk_size);
+    // The evaluated columns have the selected rows of chunk only.
+    _aggregator->evaluate_exprs(chunk.get());
+    const size_t chunk_size = chunk->num_selected_rows();
+
+    {
+        SCOPED_TIMER(_aggregator->agg_compute_timer());
+        if (_aggregator->is_multi_distinct_count()) {
+            _aggregator->build_multi_distinct_set(chunk_size);
+            RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
+        } else {
+            if (_aggregator->reached_group_limit()) {
+                // Only update the groups in the hash map.
+                _aggregator->build_hash_map_with_selection(chunk_size);
+                if (SIMD::count_zero(_aggregator->streaming_selection()) > 0) {
+                    _aggregator->compute_batch_agg_states(chunk_size, _aggregator->streaming_selection());
+                }
+            } else {
+                if (!_aggregator->is_none_group_by_exprs()) {
+                    _aggregator->build_hash_map(chunk_size);
+                    RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+                    _aggregator->try_convert_to_two_level_map();
+                }
+                _aggregator->compute_agg_states(chunk_size);
+            }
+        }
+
+        _aggregator->update_num_input_rows(chunk_size);
+    }
+    return Status::OK();
+}
+} // namespace starrocks::pipeline
@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/aggregator.h"
+
+namespace starrocks::pipeline {
+// The sink side of the blocking aggregation, it consumes all the input and builds the hash map,
+// then the paired AggregateBlockingSourceOperator outputs the aggregated result.
+class AggregateBlockingSinkOperator final : public Operator {
+public:
+    AggregateBlockingSinkOperator(int32_t id, int32_t plan_node_id, vectorized::AggregatorPtr aggregator)
+            : Operator(id, "aggregate_blocking_sink", plan_node_id), _aggregator(std::move(aggregator)) {
+        _aggregator->ref();
+    }
+    ~AggregateBlockingSinkOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool need_input() override { return !is_finished(); }
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+    bool accept_selection() const override { return true; }
+
+private:
+    // It is used to perform aggregation algorithms
+    // shared by AggregateBlockingSourceOperator
+    vectorized::AggregatorPtr _aggregator = nullptr;
+    // Whether prev operator has no output
+    bool _is_finished = false;
+};
+
+class AggregateBlockingSinkOperatorFactory final : public OperatorFactory {
+public:
+    AggregateBlockingSinkOperatorFactory(int32_t id, int32_t plan_node_id,
+                                         vectorized::AggregatorFactoryPtr aggregator_factory)
+            : OperatorFactory(id, plan_node_id), _aggregator_factory(std::move(aggregator_factory)) {}
+
+    ~AggregateBlockingSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<AggregateBlockingSinkOperator>(_id, _plan_node_id,
+                                                               _aggregator_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    vectorized::AggregatorFactoryPtr _aggregator_factory = nullptr;
+};
+} // namespace starrocks::pipeline
@@ -0,0 +1,57 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+
+#include "column/chunk.h"
+#include "exec/exec_node.h"
+#include "exprs/expr.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status AggregateBlockingSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(SourceOperator::prepare(state));
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state, row_desc, get_memtracker()));
+    RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
+    return Status::OK();
+}
+
+Status AggregateBlockingSourceOperator::close(RuntimeState* state) {
+    Expr::close(_conjunct_ctxs, state);
+    RETURN_IF_ERROR(_aggregator->unref(state));
+    return SourceOperator::close(state);
+}
+
+bool AggregateBlockingSourceOperator::has_output() {
+    return _aggregator->is_sink_complete() && !_aggregator->is_finished();
+}
+
+bool AggregateBlockingSourceOperator::is_finished() const {
+    return _aggregator->is_sink_complete() && _aggregator->is_finished();
+}
+
+void AggregateBlockingSourceOperator::finish(RuntimeState* state) {
+    _aggregator->set_finished();
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateBlockingSourceOperator::pull_chunk(RuntimeState* state) {
+    vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
+    if (_aggregator->is_multi_distinct_count()) {
+        _aggregator->convert_multi_distinct_set_to_chunk(config::vector_chunk_size, &chunk);
+    } else if (_aggregator->is_none_group_by_exprs()) {
+        _aggregator->convert_to_chunk_no_groupby(&chunk);
+    } else {
+        _aggregator->convert_hash_map_to_chunk(config::vector_chunk_size, &chunk);
+    }
+
+    // For having
+    size_t old_size = chunk->num_rows();
+    ExecNode::eval_conjuncts(_conjunct_ctxs, chunk.get());
+    _aggregator->update_num_rows_returned(-static_cast<int64_t>(old_size - chunk->num_rows()));
+
+    DCHECK_CHUNK(chunk);
+    return std::move(chunk);
+}
+} // namespace starrocks::pipeline
@@ -0,0 +1,120 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_streaming_sink_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+#include "simd/simd.h"
+
+namespace starrocks::pipeline {
+
+Status AggregateStreamingSinkOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    // The hash map outlives this operator, so its memory is accounted to the fragment instance.
+    RETURN_IF_ERROR(
+            _aggregator->prepare(state, state->obj_pool(), _runtime_profile.get(), state->instance_mem_tracker()));
+    return _aggregator->open(state);
+}
+
+Status AggregateStreamingSinkOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->unref(state));
+    return Operator::close(state);
+}
+
+void AggregateStreamingSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    // The source operator reads the hash map only if it isn't empty.
+    if (_aggregator->hash_map_variant().size() == 0) {
+        _aggregator->set_ht_eos();
+    }
+    _aggregator->sink_complete();
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateStreamingSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Not support");
+}
+
+Status AggregateStreamingSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    size_t chunk_size = chunk->num_rows();
+    _aggregator->update_num_input_rows(chunk_size);
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+    RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+    _aggregator->evaluate_exprs(chunk.get());
+
+    if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING) {
+        return _push_chunk_by_force_streaming();
+    } else if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_PREAGGREGATION) {
+        return _push_chunk_by_force_preaggregation(chunk_size);
+    } else {
+        return _push_chunk_by_auto(chunk_size);
+    }
+}
+
+Status AggregateStreamingSinkOperator::_push_chunk_by_force_streaming() {
+    // force execute streaming
+    SCOPED_TIMER(_aggregator->streaming_timer());
+    vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
+    _aggregator->output_chunk_by_streaming(&chunk);
+    _aggregator->offer_chunk_to_buffer(chunk);
+    return Status::OK();
+}
+
+Status AggregateStreamingSinkOperator::_push_chunk_by_force_preaggregation(const size_t chunk_size) {
+    SCOPED_TIMER(_aggregator->agg_compute_timer());
+    _aggregator->build_hash_map(chunk_size);
+    _aggregator->compute_agg_states(chunk_size);
+
+    _aggregator->try_convert_to_two_level_map();
+    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+    return Status::OK();
+}
+
+Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const size_t chunk_size) {
+    // TODO: calc the real capacity of hashtable, will add one interface in the class of habletable
+    size_t real_capacity =
+            _aggregator->hash_map_variant().capacity() - _aggregator->hash_map_variant().capacity() / 8;
+    size_t remain_size = real_capacity - _aggregator->hash_map_variant().size();
+    bool ht_needs_expansion = remain_size < chunk_size;
+    // The rows of the groups out of the group limit are passed through.
+    if (!_aggregator->reached_group_limit() &&
+        (!ht_needs_expansion ||
+         _aggregator->should_expand_preagg_hash_tables(chunk_size, _aggregator->mem_pool()->total_allocated_bytes(),
+                                                       _aggregator->hash_map_variant().size()))) {
+        // hash table is not full or allow expand the hash table according reduction rate
+        return _push_chunk_by_force_preaggregation(chunk_size);
+    }
+
+    {
+        SCOPED_TIMER(_aggregator->agg_compute_timer());
+        _aggregator->build_hash_map_with_selection(chunk_size);
+    }
+
+    size_t zero_count = SIMD::count_zero(_aggregator->streaming_selection());
+    if (zero_count == 0) {
+        // All the rows missed the hash map, pass through them directly
+        return _push_chunk_by_force_streaming();
+    } else if (zero_count == _aggregator->streaming_selection().size()) {
+        // All the rows hit the hash map
+        SCOPED_TIMER(_aggregator->agg_compute_timer());
+        _aggregator->compute_batch_agg_states(chunk_size);
+    } else {
+        {
+            SCOPED_TIMER(_aggregator->agg_compute_timer());
+            _aggregator->compute_batch_agg_states(chunk_size, _aggregator->streaming_selection());
+        }
+        {
+            SCOPED_TIMER(_aggregator->streaming_timer());
+            vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
+            _aggregator->output_chunk_by_streaming_with_selection(&chunk);
+            _aggregator->offer_chunk_to_buffer(chunk);
+        }
+    }
+
+    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+    return Status::OK();
+}
+} // namespace starrocks::pipeline
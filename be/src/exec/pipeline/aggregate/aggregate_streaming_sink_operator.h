@@ -0,0 +1,64 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/aggregator.h"
+
+namespace starrocks::pipeline {
+// The sink side of the streaming aggregation, it pre-aggregates the input into the hash map
+// or passes the input through the chunk buffer of Aggregator to the paired
+// AggregateStreamingSourceOperator according to the reduction rate of the hash map.
+class AggregateStreamingSinkOperator final : public Operator {
+public:
+    AggregateStreamingSinkOperator(int32_t id, int32_t plan_node_id, vectorized::AggregatorPtr aggregator)
+            : Operator(id, "aggregate_streaming_sink", plan_node_id), _aggregator(std::move(aggregator)) {
+        _aggregator->ref();
+    }
+    ~AggregateStreamingSinkOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool need_input() override { return !is_finished() && !_aggregator->is_chunk_buffer_full(); }
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    // Invoked by push_chunk if current mode is TStreamingPreaggregationMode::FORCE_STREAMING
+    Status _push_chunk_by_force_streaming();
+
+    // Invoked by push_chunk  if current mode is TStreamingPreaggregationMode::FORCE_PREAGGREGATION
+    Status _push_chunk_by_force_preaggregation(const size_t chunk_size);
+
+    // Invoked by push_chunk  if current mode is TStreamingPreaggregationMode::AUTO
+    Status _push_chunk_by_auto(const size_t chunk_size);
+
+    // It is used to perform aggregation algorithms
+    // shared by AggregateStreamingSourceOperator
+    vectorized::AggregatorPtr _aggregator = nullptr;
+    // Whether prev operator has no output
+    bool _is_finished = false;
+};
+
+class AggregateStreamingSinkOperatorFactory final : public OperatorFactory {
+public:
+    AggregateStreamingSinkOperatorFactory(int32_t id, int32_t plan_node_id,
+                                          vectorized::AggregatorFactoryPtr aggregator_factory)
+            : OperatorFactory(id, plan_node_id), _aggregator_factory(std::move(aggregator_factory)) {}
+
+    ~AggregateStreamingSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<AggregateStreamingSinkOperator>(_id, _plan_node_id,
+                                                                _aggregator_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    vectorized::AggregatorFactoryPtr _aggregator_factory = nullptr;
+};
+} // namespace starrocks::pipeline
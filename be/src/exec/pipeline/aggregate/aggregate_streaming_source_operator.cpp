@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_streaming_source_operator.h"
+
+#include "column/chunk.h"
+#include "common/config.h"
+
+namespace starrocks::pipeline {
+
+bool AggregateStreamingSourceOperator::has_output() {
+    if (!_aggregator->is_chunk_buffer_empty()) {
+        // There are two cases where chunk buffer is not empty
+        // case1: streaming mode is 'FORCE_STREAMING'
+        // case2: streaming mode is 'AUTO'
+        //     case 2.1: very poor aggregation
+        //     case 2.2: middle cases, first aggregate locally and output by stream
+        return true;
+    }
+
+    // The hash map is only readable after the sink operator has consumed all the input.
+    return _aggregator->is_sink_complete() && !_aggregator->is_ht_eos();
+}
+
+bool AggregateStreamingSourceOperator::is_finished() const {
+    return _aggregator->is_sink_complete() && _aggregator->is_chunk_buffer_empty() && _aggregator->is_ht_eos();
+}
+
+void AggregateStreamingSourceOperator::finish(RuntimeState* state) {
+    _aggregator->set_ht_eos();
+}
+
+Status AggregateStreamingSourceOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->unref(state));
+    return SourceOperator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateStreamingSourceOperator::pull_chunk(RuntimeState* state) {
+    // It is no need to distinguish whether streaming or aggregation mode
+    // We just first read chunk from buffer and finally read chunk from hash table
+    if (!_aggregator->is_chunk_buffer_empty()) {
+        return _aggregator->poll_chunk_buffer();
+    }
+
+    // Even if it is streaming mode, the purpose of reading from hash table is to
+    // correctly process the state of hash table(_is_ht_eos)
+    vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
+    _output_chunk_from_hash_map(&chunk);
+    DCHECK_CHUNK(chunk);
+    return std::move(chunk);
+}
+
+void AggregateStreamingSourceOperator::_output_chunk_from_hash_map(vectorized::ChunkPtr* chunk) {
+    if (!_aggregator->it_hash().has_value()) {
+        _aggregator->init_hash_map_iterator();
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+    }
+
+    _aggregator->convert_hash_map_to_chunk(config::vector_chunk_size, chunk);
+}
+} // namespace starrocks::pipeline
@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/source_operator.h"
+#include "exec/vectorized/aggregator.h"
+
+namespace starrocks::pipeline {
+// The source side of the streaming aggregation, it outputs the pass-through chunks
+// offered by AggregateStreamingSinkOperator first, and outputs the pre-aggregated
+// hash map after the sink operator has consumed all the input.
+class AggregateStreamingSourceOperator final : public SourceOperator {
+public:
+    AggregateStreamingSourceOperator(int32_t id, int32_t plan_node_id, vectorized::AggregatorPtr aggregator)
+            : SourceOperator(id, "aggregate_streaming_source", plan_node_id), _aggregator(std::move(aggregator)) {
+        _aggregator->ref();
+    }
+    ~AggregateStreamingSourceOperator() override = default;
+
+    bool has_output() override;
+    bool is_finished() const override;
+    void finish(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    void _output_chunk_from_hash_map(vectorized::ChunkPtr* chunk);
+
+    // It is used to perform aggregation algorithms
+    // shared by AggregateStreamingSinkOperator
+    vectorized::AggregatorPtr _aggregator = nullptr;
+};
+
+class AggregateStreamingSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    AggregateStreamingSourceOperatorFactory(int32_t id, int32_t plan_node_id,
+                                            vectorized::AggregatorFactoryPtr aggregator_factory)
+            : SourceOperatorFactory(id, plan_node_id), _aggregator_factory(std::move(aggregator_factory)) {}
+
+    ~AggregateStreamingSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<AggregateStreamingSourceOperator>(_id, _plan_node_id,
+                                                                  _aggregator_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    vectorized::AggregatorFactoryPtr _aggregator_factory = nullptr;
+};
+} // namespace starrocks::pipeline
@@ -2,8 +2,6 @@
 
 #pragma once
 
-#include <future>
-
 #include "column/vectorized_fwd.h"
 #include "common/statusor.h"
 #include "exec/pipeline/morsel.h"
@@ -26,8 +24,16 @@ public:
     virtual bool has_next_chunk() = 0;
 
     virtual StatusOr<vectorized::ChunkUniquePtr> get_next_chunk() = 0;
-    virtual void cache_next_chunk_blocking() = 0;
-    virtual StatusOr<vectorized::ChunkUniquePtr> get_next_chunk_nonblocking() = 0;
+
+    // The following methods are used by the asynchronous io, in which an io thread reads chunks
+    // into the buffer of the chunk source, while the pipeline driver takes the chunks from the buffer.
+    // Read at most batch_size chunks into the buffer, it's called by io threads. It stops early when
+    // an error or the end of data is encountered, which can be got from get_next_chunk_from_buffer().
+    virtual void buffer_next_batch_chunks_blocking(size_t batch_size) = 0;
+    virtual size_t get_buffer_size() = 0;
+    // Take one chunk from the buffer. If the buffer is empty, it returns the error or EndOfFile
+    // encountered by the io, which is only valid when there is no io reading this chunk source.
+    virtual StatusOr<vectorized::ChunkUniquePtr> get_next_chunk_from_buffer() = 0;
 
 protected:
     // The morsel will own by pipeline driver
@@ -35,9 +41,5 @@ protected:
 };
 
 using ChunkSourcePtr = starrocks::exclusive_ptr<ChunkSource>;
-using ChunkSourcePromise = std::promise<ChunkSourcePtr>;
-using ChunkSourceFromisePtr = starrocks::exclusive_ptr<ChunkSourcePromise>;
-using ChunkSourceFuture = std::future<ChunkSourcePtr>;
-using OptionalChunkSourceFuture = std::optional<ChunkSourceFuture>;
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
@@ -0,0 +1,20 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/dict_decode_operator.h"
+
+#include "column/chunk.h"
+
+namespace starrocks::pipeline {
+
+StatusOr<vectorized::ChunkPtr> DictDecodeOperator::pull_chunk(RuntimeState* state) {
+    return std::move(_cur_chunk);
+}
+
+Status DictDecodeOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    RETURN_IF_ERROR(vectorized::decode_dict_slots(_decode_slots, chunk.get()));
+    _cur_chunk = chunk;
+    DCHECK_CHUNK(_cur_chunk);
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "runtime/vectorized/global_dict.h"
+
+namespace starrocks::pipeline {
+
+class DictDecodeOperator final : public Operator {
+public:
+    DictDecodeOperator(int32_t id, int32_t plan_node_id, const std::vector<vectorized::DictDecodeSlot>& decode_slots)
+            : Operator(id, "dict_decode", plan_node_id), _decode_slots(decode_slots) {}
+
+    ~DictDecodeOperator() override = default;
+
+    bool has_output() override { return _cur_chunk != nullptr; }
+
+    bool need_input() override { return _cur_chunk == nullptr; }
+
+    bool is_finished() const override { return _is_finished && _cur_chunk == nullptr; }
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    const std::vector<vectorized::DictDecodeSlot>& _decode_slots;
+
+    bool _is_finished = false;
+    vectorized::ChunkPtr _cur_chunk = nullptr;
+};
+
+class DictDecodeOperatorFactory final : public OperatorFactory {
+public:
+    DictDecodeOperatorFactory(int32_t id, int32_t plan_node_id,
+                              std::vector<vectorized::DictDecodeSlot>&& decode_slots)
+            : OperatorFactory(id, plan_node_id), _decode_slots(std::move(decode_slots)) {}
+
+    ~DictDecodeOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<DictDecodeOperator>(_id, _plan_node_id, _decode_slots);
+    }
+
+private:
+    std::vector<vectorized::DictDecodeSlot> _decode_slots;
+};
+
+} // namespace starrocks::pipeline
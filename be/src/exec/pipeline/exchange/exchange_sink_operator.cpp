@@ -51,12 +51,13 @@ public:
     Status init(RuntimeState* state);
 
     // Send one chunk to remote, this chunk may be batched in this channel.
+    // The batched chunks are sent in one request when their size exceeds _request_bytes_threshold.
     Status send_one_chunk(const vectorized::Chunk* chunk, bool eos);
 
     // Channel will sent input request directly without batch it.
     // This function is only used when broadcast, because request can be reused
     // by all the channels.
-    Status send_chunk_request(PTransmitChunkParams* params, const butil::IOBuf& attachment);
+    Status send_chunk_request(const PTransmitChunkParams& params, const butil::IOBuf& attachment);
 
     // Used when doing shuffle.
     // This function will copy selective rows in chunks to batch.
@@ -94,6 +95,8 @@ private:
 
     PBackendService_Stub* _brpc_stub = nullptr;
 
+    // The chunks batched to send in one request.
+    PTransmitChunkParams _chunk_request;
     size_t _current_request_bytes = 0;
 
     bool _is_inited = false;
@@ -143,15 +146,9 @@ Status ExchangeSinkOperator::Channel::add_rows_selective(vectorized::Chunk* chun
 }
 
 Status ExchangeSinkOperator::Channel::send_one_chunk(const vectorized::Chunk* chunk, bool eos) {
-    PTransmitChunkParams request;
-    request.set_allocated_finst_id(&_finst_id);
-    request.set_node_id(_dest_node_id);
-    request.set_sender_id(_parent->_sender_id);
-    request.set_be_number(_parent->_be_number);
-
     // If chunk is not null, append it to request
     if (chunk != nullptr) {
-        auto pchunk = request.add_chunks();
+        auto pchunk = _chunk_request.add_chunks();
         RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk));
         _current_request_bytes += pchunk->data().size();
     }
@@ -159,39 +156,44 @@ Status ExchangeSinkOperator::Channel::send_one_chunk(const vectorized::Chunk* ch
     // Try to accumulate enough bytes before sending a RPC. When eos is true we should send
     // last packet
     if (_current_request_bytes > _parent->_request_bytes_threshold || eos) {
-        request.set_eos(eos);
-        TransmitChunkInfo info = {std::move(request), _brpc_stub};
-        _parent->_buffer->add_request(info);
+        _chunk_request.mutable_finst_id()->CopyFrom(_finst_id);
+        _chunk_request.set_node_id(_dest_node_id);
+        _chunk_request.set_sender_id(_parent->_sender_id);
+        _chunk_request.set_be_number(_parent->_be_number);
+        _chunk_request.set_eos(eos);
+        _parent->_buffer->add_request({_fragment_instance_id, _brpc_stub, std::move(_chunk_request)});
+        _chunk_request.Clear();
         _current_request_bytes = 0;
-        // The original design is bad, we must release_finst_id here!
-        info.params.release_finst_id();
     }
 
     return Status::OK();
 }
 
-Status ExchangeSinkOperator::Channel::send_chunk_request(PTransmitChunkParams* params, const butil::IOBuf& attachment) {
-    params->set_allocated_finst_id(&_finst_id);
-    params->set_node_id(_dest_node_id);
-    params->set_sender_id(_parent->_sender_id);
-    params->set_be_number(_parent->_be_number);
-
-    params->set_eos(false);
-    TransmitChunkInfo info = {std::move(*params), _brpc_stub};
-    _parent->_buffer->add_request(info);
-
-    // The original design is bad, we must release_finst_id here!
-    info.params.release_finst_id();
-
+Status ExchangeSinkOperator::Channel::send_chunk_request(const PTransmitChunkParams& params,
+                                                         const butil::IOBuf& attachment) {
+    TransmitChunkInfo info = {_fragment_instance_id, _brpc_stub, params};
+    info.params.mutable_finst_id()->CopyFrom(_finst_id);
+    info.params.set_node_id(_dest_node_id);
+    info.params.set_sender_id(_parent->_sender_id);
+    info.params.set_be_number(_parent->_be_number);
+    info.params.set_eos(false);
+    _parent->_buffer->add_request(std::move(info));
     return Status::OK();
 }
 
 Status ExchangeSinkOperator::Channel::_close_internal() {
-    RETURN_IF_ERROR(send_one_chunk(nullptr, true));
-    return Status::OK();
+    // Flush the rows buffered for shuffle along with the eos.
+    if (_chunk != nullptr && _chunk->num_rows() > 0) {
+        return send_one_chunk(_chunk.get(), true);
+    }
+    return send_one_chunk(nullptr, true);
 }
 
 void ExchangeSinkOperator::Channel::close(RuntimeState* state) {
+    // For bucket shuffle, the dest is unreachable, nothing is sent to it.
+    if (_fragment_instance_id.lo == -1) {
+        return;
+    }
     state->log_error(_close_internal().get_error_msg());
 }
 
@@ -280,6 +282,7 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
     // It will be set to true when closing.
     _chunk_request.set_eos(false);
     _row_indexes.resize(config::vector_chunk_size);
+    _request_bytes_threshold = config::max_transmit_batched_bytes;
 
     return Status::OK();
 }
@@ -370,24 +373,33 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
         _current_request_bytes += pchunk->data().size();
         // 3. if request bytes exceede the threshold, send current request
         if (_current_request_bytes > _request_bytes_threshold) {
-            butil::IOBuf attachment;
-            // construct_brpc_attachment(&_chunk_request, &attachment);
-            for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, attachment));
-            }
-            _current_request_bytes = 0;
-            _chunk_request.clear_chunks();
+            RETURN_IF_ERROR(_send_broadcast_request());
         }
     }
     return Status::OK();
 }
 
+Status ExchangeSinkOperator::_send_broadcast_request() {
+    butil::IOBuf attachment;
+    // construct_brpc_attachment(&_chunk_request, &attachment);
+    for (auto& channel : _channels) {
+        RETURN_IF_ERROR(channel->send_chunk_request(_chunk_request, attachment));
+    }
+    _current_request_bytes = 0;
+    _chunk_request.clear_chunks();
+    return Status::OK();
+}
+
 void ExchangeSinkOperator::finish(RuntimeState* state) {
     if (_is_finished) {
         return;
     }
 
     _is_finished = true;
+    // Flush the chunks batched for broadcast before closing the channels.
+    if (_chunk_request.chunks_size() > 0) {
+        state->log_error(_send_broadcast_request().get_error_msg());
+    }
     for (int i = 0; i < _channels.size(); ++i) {
         _channels[i]->close(state);
     }
@@ -415,10 +427,7 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
             dst->clear_is_nulls();
             dst->clear_is_consts();
             dst->clear_slot_id_map();
-            uncompressed_size = src->serialize_size();
-            // TODO(kks): resize without initializing the new bytes
-            dst->mutable_data()->resize(uncompressed_size);
-            src->serialize((uint8_t*)dst->mutable_data()->data());
+            uncompressed_size = src->serialize(dst->mutable_data(), config::chunk_serde_version);
         }
     }
 
@@ -468,21 +477,11 @@ void ExchangeSinkOperator::construct_brpc_attachment(PTransmitChunkParams* param
 }
 
 OperatorPtr ExchangeSinkOperatorFactory::create(int32_t driver_instance_count, int32_t driver_sequence) {
+    // Every ExchangeSinkOperator sends its input to all the destinations, for shuffle, the rows
+    // are partitioned by their hash values, so the rows of the same key go to the same destination.
     _buffer->set_sinker_number(driver_instance_count);
-    if (_part_type == TPartitionType::UNPARTITIONED || _destinations.size() == 1) {
-        return std::make_shared<ExchangeSinkOperator>(_id, _plan_node_id, _buffer, _part_type, _destinations,
-                                                      _sender_id, _dest_node_id, _partition_expr_ctxs);
-    } else if (_part_type == TPartitionType::HASH_PARTITIONED ||
-               _part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED) {
-        // For shuffle, one ExchangeSinkOperator has one destination
-        std::vector<TPlanFragmentDestination> destination;
-        destination.emplace_back(_destinations[driver_sequence]);
-        return std::make_shared<ExchangeSinkOperator>(_id, _plan_node_id, _buffer, _part_type, destination, _sender_id,
-                                                      _dest_node_id, _partition_expr_ctxs);
-    } else {
-        DCHECK(false) << " Shouldn't reach here!";
-        return nullptr;
-    }
+    return std::make_shared<ExchangeSinkOperator>(_id, _plan_node_id, _buffer, _part_type, _destinations, _sender_id,
+                                                  _dest_node_id, _partition_expr_ctxs);
 }
 
 } // namespace starrocks::pipeline
@@ -59,6 +59,9 @@ public:
 private:
     class Channel;
 
+    // Send the chunks batched in _chunk_request to all the channels.
+    Status _send_broadcast_request();
+
     const std::shared_ptr<SinkBuffer>& _buffer;
 
     TPartitionType::type _part_type;
@@ -3,7 +3,9 @@
 #include "exec/pipeline/exchange/local_exchange.h"
 
 #include "column/chunk.h"
+#include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "runtime/descriptors.h"
 
 namespace starrocks::pipeline {
 
@@ -13,11 +15,29 @@ PartitionExchanger::PartitionExchanger(const std::shared_ptr<LocalExchangeMemory
         : LocalExchanger(memory_manager),
           _source(source),
           _is_shuffle(is_shuffle),
-          _partition_expr_ctxs(partition_expr_ctxs) {
-    _partitions_columns.resize(partition_expr_ctxs.size());
+          _partition_expr_ctxs(partition_expr_ctxs) {}
+
+Status PartitionExchanger::prepare(RuntimeState* state) {
+    // The partition expressions are evaluated on the chunks, the row descriptor is not used.
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(Expr::prepare(_partition_expr_ctxs, state, row_desc, state->instance_mem_tracker()));
+    return Expr::open(_partition_expr_ctxs, state);
+}
+
+void PartitionExchanger::finish(RuntimeState* state) {
+    if (decrement_sink_number() == 1) {
+        Expr::close(_partition_expr_ctxs, state);
+        for (auto* source : _source->get_sources()) {
+            source->finish(state);
+        }
+    }
+}
+
+void PartitionExchanger::set_num_sinks(int32_t num_sinks) {
+    _partitioners.resize(num_sinks);
 }
 
-Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
+Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) {
     uint16_t num_rows = chunk->num_rows();
     if (num_rows == 0) {
         return Status::OK();
@@ -27,49 +47,59 @@ Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
 
     // hash-partition batch's rows across channels
     int num_channels = _source->get_sources().size();
+    DCHECK_LT(static_cast<size_t>(sink_driver_sequence), _partitioners.size());
+    Partitioner& partitioner = _partitioners[sink_driver_sequence];
+    auto& partitions_columns = partitioner.partitions_columns;
+    auto& hash_values = partitioner.hash_values;
+    auto& channel_row_idx_start_points = partitioner.channel_row_idx_start_points;
+    auto& row_indexes = partitioner.row_indexes;
+    partitions_columns.resize(_partition_expr_ctxs.size());
+    row_indexes.resize(num_rows);
     {
         // SCOPED_TIMER(_shuffle_hash_timer);
-        for (size_t i = 0; i < _partitions_columns.size(); ++i) {
-            _partitions_columns[i] = _partition_expr_ctxs[i]->evaluate(chunk.get());
-            DCHECK(_partitions_columns[i] != nullptr);
+        for (size_t i = 0; i < partitions_columns.size(); ++i) {
+            partitions_columns[i] = _partition_expr_ctxs[i]->evaluate(chunk.get());
+            DCHECK(partitions_columns[i] != nullptr);
         }
 
         if (_is_shuffle) {
-            _hash_values.assign(num_rows, HashUtil::FNV_SEED);
-            for (const vectorized::ColumnPtr& column : _partitions_columns) {
-                column->fvn_hash(&_hash_values[0], 0, num_rows);
+            // The shuffle only happens inside this BE, so the cheaper CRC32 hash is used, which also
+            // distributes the rows shuffled by fvn_hash from the upstream exchange well.
+            hash_values.assign(num_rows, 0);
+            for (const vectorized::ColumnPtr& column : partitions_columns) {
+                column->crc32c_hash(&hash_values[0], 0, num_rows);
             }
         } else {
             // The data distribution was calculated using CRC32_HASH,
             // and bucket shuffle need to use the same hash function when sending data
-            _hash_values.assign(num_rows, 0);
-            for (const vectorized::ColumnPtr& column : _partitions_columns) {
-                column->crc32_hash(&_hash_values[0], 0, num_rows);
+            hash_values.assign(num_rows, 0);
+            for (const vectorized::ColumnPtr& column : partitions_columns) {
+                column->crc32_hash(&hash_values[0], 0, num_rows);
             }
         }
 
         // compute row indexes for each channel
-        _channel_row_idx_start_points.assign(num_channels + 1, 0);
+        channel_row_idx_start_points.assign(num_channels + 1, 0);
         for (uint16_t i = 0; i < num_rows; ++i) {
-            uint16_t channel_index = _hash_values[i] % num_channels;
-            _channel_row_idx_start_points[channel_index]++;
-            _hash_values[i] = channel_index;
+            uint16_t channel_index = hash_values[i] % num_channels;
+            channel_row_idx_start_points[channel_index]++;
+            hash_values[i] = channel_index;
         }
         // NOTE:
         // we make the last item equal with number of rows of this chunk
         for (int i = 1; i <= num_channels; ++i) {
-            _channel_row_idx_start_points[i] += _channel_row_idx_start_points[i - 1];
+            channel_row_idx_start_points[i] += channel_row_idx_start_points[i - 1];
         }
 
         for (int i = num_rows - 1; i >= 0; --i) {
-            _row_indexes[_channel_row_idx_start_points[_hash_values[i]] - 1] = i;
-            _channel_row_idx_start_points[_hash_values[i]]--;
+            row_indexes[channel_row_idx_start_points[hash_values[i]] - 1] = i;
+            channel_row_idx_start_points[hash_values[i]]--;
         }
     }
 
     for (int i = 0; i < num_channels; ++i) {
-        size_t from = _channel_row_idx_start_points[i];
-        size_t size = _channel_row_idx_start_points[i + 1] - from;
+        size_t from = channel_row_idx_start_points[i];
+        size_t size = channel_row_idx_start_points[i + 1] - from;
         if (size == 0) {
             // no data for this channel continue;
             continue;
@@ -79,20 +109,23 @@ Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
         //     // dest bucket is no used, continue
         //     continue;
         // }
-        RETURN_IF_ERROR(_source->get_sources()[i]->add_chunk(chunk.get(), _row_indexes.data(), from, size));
+        RETURN_IF_ERROR(_source->get_sources()[i]->add_chunk(chunk.get(), row_indexes.data(), from, size));
     }
+    // Don't keep the columns of the chunk alive until the next chunk.
+    partitions_columns.clear();
     return Status::OK();
 }
 
-Status BroadcastExchanger::accept(const vectorized::ChunkPtr& chunk) {
-    _memory_manager->update_row_count(chunk->num_rows());
+Status BroadcastExchanger::accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) {
+    // Each source operator releases the rows of the chunk after it pulls the chunk.
+    _memory_manager->update_row_count(chunk->num_rows() * _source->get_sources().size());
     for (auto* buffer : _source->get_sources()) {
         buffer->add_chunk(chunk);
     }
     return Status::OK();
 }
 
-Status PassthroughExchanger::accept(const vectorized::ChunkPtr& chunk) {
+Status PassthroughExchanger::accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) {
     _memory_manager->update_row_count(chunk->num_rows());
     _source->get_sources()[0]->add_chunk(chunk);
     return Status::OK();
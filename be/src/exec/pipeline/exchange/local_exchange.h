@@ -17,7 +17,13 @@ public:
     LocalExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager)
             : _memory_manager(memory_manager) {}
 
-    virtual Status accept(const vectorized::ChunkPtr& chunk) = 0;
+    virtual Status prepare(RuntimeState* state) { return Status::OK(); }
+
+    // Called by the factory of the sink operators before they are prepared, with the number of them.
+    virtual void set_num_sinks(int32_t num_sinks) {}
+
+    // Accept a chunk from the sink operator of |sink_driver_sequence|.
+    virtual Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) = 0;
 
     virtual void finish(RuntimeState* state) = 0;
 
@@ -32,40 +38,48 @@ protected:
     std::atomic<int32_t> _sink_number{0};
 };
 
-// Exchange the local data for shuffle
+// Exchange the local data for shuffle.
+// The rows are partitioned by the hash of the partition expressions, so each local source operator
+// receives a disjoint set of partition keys. The hash values of all the partition columns are combined
+// column by column into one buffer, and then the rows of each partition are fanned out by append_selective.
 class PartitionExchanger final : public LocalExchanger {
 public:
     PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                        LocalExchangeSourceOperatorFactory* source, bool is_shuffle,
                        const std::vector<ExprContext*>& _partition_expr_ctxs);
 
-    Status accept(const vectorized::ChunkPtr& chunk) override;
+    // The partition expressions are shared by all the sink operators, preparing them is idempotent,
+    // and they are closed by the last finished sink operator.
+    Status prepare(RuntimeState* state) override;
 
-    void finish(RuntimeState* state) override {
-        if (decrement_sink_number() == 1) {
-            for (auto* source : _source->get_sources()) {
-                source->finish(state);
-            }
-        }
-    }
+    void set_num_sinks(int32_t num_sinks) override;
+
+    Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) override;
+
+    void finish(RuntimeState* state) override;
 
 private:
+    // The buffers to partition the chunks, which are reused by the chunks of one sink operator.
+    struct Partitioner {
+        vectorized::Columns partitions_columns;
+        std::vector<uint32_t> hash_values;
+        // This array record the channel start point in row_indexes
+        // And the last item is the number of rows of the current shuffle chunk.
+        // It will easy to get number of rows belong to one channel by doing
+        // channel_row_idx_start_points[i + 1] - channel_row_idx_start_points[i]
+        std::vector<uint16_t> channel_row_idx_start_points;
+        // Record the row indexes for the current shuffle index. Sender will arrange the row indexes
+        // according to channels. For example, if there are 3 channels, this row_indexes will put
+        // channel 0's row first, then channel 1's row indexes, then put channel 2's row indexes in
+        // the last.
+        std::vector<uint32_t> row_indexes;
+    };
+
     LocalExchangeSourceOperatorFactory* _source;
     bool _is_shuffle = true;
     std::vector<ExprContext*> _partition_expr_ctxs; // compute per-row partition values
-
-    vectorized::Columns _partitions_columns;
-    std::vector<uint32_t> _hash_values;
-    // This array record the channel start point in _row_indexes
-    // And the last item is the number of rows of the current shuffle chunk.
-    // It will easy to get number of rows belong to one channel by doing
-    // _channel_row_idx_start_points[i + 1] - _channel_row_idx_start_points[i]
-    std::vector<uint16_t> _channel_row_idx_start_points;
-    // Record the row indexes for the current shuffle index. Sender will arrange the row indexes
-    // according to channels. For example, if there are 3 channels, this _row_indexes will put
-    // channel 0's row first, then channel 1's row indexes, then put channel 2's row indexes in
-    // the last.
-    std::vector<uint32_t> _row_indexes;
+    // The exchanger is shared by all the sink operators, each of them uses the partitioner of its driver sequence.
+    std::vector<Partitioner> _partitioners;
 };
 
 // Exchange the local data for broadcast
@@ -75,7 +89,7 @@ public:
                        LocalExchangeSourceOperatorFactory* source)
             : LocalExchanger(memory_manager), _source(source) {}
 
-    Status accept(const vectorized::ChunkPtr& chunk) override;
+    Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) override;
 
     void finish(RuntimeState* state) override {
         if (decrement_sink_number() == 1) {
@@ -95,7 +109,7 @@ public:
     PassthroughExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                          LocalExchangeSourceOperatorFactory* source)
             : LocalExchanger(memory_manager), _source(source) {}
-    Status accept(const vectorized::ChunkPtr& chunk) override;
+    Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) override;
 
     void finish(RuntimeState* state) override {
         if (decrement_sink_number() == 1) {
@@ -9,7 +9,7 @@ namespace starrocks::pipeline {
 Status LocalExchangeSinkOperator::prepare(RuntimeState* state) {
     _exchanger->increment_sink_number();
     Operator::prepare(state);
-    return Status::OK();
+    return _exchanger->prepare(state);
 }
 
 bool LocalExchangeSinkOperator::need_input() {
@@ -26,8 +26,7 @@ void LocalExchangeSinkOperator::finish(RuntimeState* state) {
 }
 
 Status LocalExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
-    _exchanger->accept(std::move(chunk));
-    return Status::OK();
+    return _exchanger->accept(chunk, _driver_sequence);
 }
 
 } // namespace starrocks::pipeline
@@ -8,8 +8,8 @@
 namespace starrocks::pipeline {
 class LocalExchangeSinkOperator final : public Operator {
 public:
-    LocalExchangeSinkOperator(int32_t id, const std::shared_ptr<LocalExchanger>& exchanger)
-            : Operator(id, "local_exchange_sink", -1), _exchanger(exchanger) {}
+    LocalExchangeSinkOperator(int32_t id, const std::shared_ptr<LocalExchanger>& exchanger, int32_t driver_sequence)
+            : Operator(id, "local_exchange_sink", -1), _exchanger(exchanger), _driver_sequence(driver_sequence) {}
 
     ~LocalExchangeSinkOperator() override = default;
 
@@ -30,6 +30,7 @@ public:
 private:
     bool _is_finished = false;
     const std::shared_ptr<LocalExchanger>& _exchanger;
+    int32_t _driver_sequence = 0;
 };
 
 class LocalExchangeSinkOperatorFactory final : public OperatorFactory {
@@ -40,7 +41,8 @@ public:
     ~LocalExchangeSinkOperatorFactory() override = default;
 
     OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
-        return std::make_shared<LocalExchangeSinkOperator>(_id, _exchanger);
+        _exchanger->set_num_sinks(driver_instance_count);
+        return std::make_shared<LocalExchangeSinkOperator>(_id, _exchanger, driver_sequence);
     }
 
 private:
@@ -3,22 +3,14 @@
 #include "exec/pipeline/exchange/local_exchange_source_operator.h"
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks::pipeline {
 
 Status LocalExchangeSourceOperator::add_chunk(vectorized::ChunkPtr chunk) {
     std::lock_guard<std::mutex> l(_chunk_lock);
-    if (_full_chunk == nullptr) {
-        _full_chunk = std::move(chunk);
-    } else {
-        vectorized::Columns& dest_columns = _full_chunk->columns();
-        vectorized::Columns& src_columns = chunk->columns();
-        size_t num_rows = chunk->num_rows();
-        for (size_t i = 0; i < dest_columns.size(); i++) {
-            dest_columns[i]->append(*src_columns[i], 0, num_rows);
-        }
-    }
+    _full_chunks.emplace(std::move(chunk));
     return Status::OK();
 }
 
@@ -29,28 +21,42 @@ Status LocalExchangeSourceOperator::add_chunk(vectorized::Chunk* chunk, const ui
         _partial_chunk = chunk->clone_empty_with_slot();
     }
 
-    if (_partial_chunk->num_rows() + size > config::vector_chunk_size) {
-        _full_chunk = std::move(_partial_chunk);
-    }
-
     _partial_chunk->append_selective(*chunk, indexes, from, size);
+    if (_partial_chunk->num_rows() >= config::vector_chunk_size) {
+        _full_chunks.emplace(std::move(_partial_chunk));
+        _partial_chunk = nullptr;
+    }
     return Status::OK();
 }
 
+void LocalExchangeSourceOperator::finish(RuntimeState* state) {
+    std::lock_guard<std::mutex> l(_chunk_lock);
+    _is_finished = true;
+}
+
 bool LocalExchangeSourceOperator::is_finished() const {
     std::lock_guard<std::mutex> l(_chunk_lock);
-    return _is_finished && _full_chunk == nullptr;
+    return _is_finished && _full_chunks.empty() && _partial_chunk == nullptr;
 }
 
 bool LocalExchangeSourceOperator::has_output() {
     std::lock_guard<std::mutex> l(_chunk_lock);
-    return _full_chunk != nullptr;
+    return !_full_chunks.empty() || (_is_finished && _partial_chunk != nullptr);
 }
 
 StatusOr<vectorized::ChunkPtr> LocalExchangeSourceOperator::pull_chunk(RuntimeState* state) {
     std::lock_guard<std::mutex> l(_chunk_lock);
-    _memory_manager->update_row_count(-_full_chunk->num_rows());
-    return std::move(_full_chunk);
+    vectorized::ChunkPtr chunk;
+    if (!_full_chunks.empty()) {
+        chunk = std::move(_full_chunks.front());
+        _full_chunks.pop();
+    } else {
+        DCHECK(_is_finished && _partial_chunk != nullptr);
+        chunk = std::move(_partial_chunk);
+        _partial_chunk = nullptr;
+    }
+    _memory_manager->update_row_count(-chunk->num_rows());
+    return std::move(chunk);
 }
 
 } // namespace starrocks::pipeline
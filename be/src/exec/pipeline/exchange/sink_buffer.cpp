@@ -0,0 +1,155 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/sink_buffer.h"
+
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "util/callback_closure.h"
+#include "util/query_trace.h"
+
+namespace starrocks::pipeline {
+
+SinkBuffer::SinkBuffer(const std::vector<TPlanFragmentDestination>& destinations, int32_t brpc_timeout_ms)
+        : _max_in_flight_rpcs(std::max<int32_t>(config::pipeline_sink_brpc_max_in_flight, 1)),
+          _brpc_timeout_ms(brpc_timeout_ms) {
+    for (const auto& destination : destinations) {
+        const auto& instance_id = destination.fragment_instance_id;
+        // For bucket shuffle, the dest is unreachable, there is no need to send data to it.
+        if (instance_id.lo == -1) {
+            continue;
+        }
+        _destinations.try_emplace(instance_id.lo);
+    }
+    _max_buffered_requests = std::max<size_t>(_destinations.size(), 1) * _max_in_flight_rpcs;
+}
+
+void SinkBuffer::set_sinker_number(int32_t sinker_number) {
+    std::lock_guard<std::mutex> l(_mutex);
+    for (auto& [_, context] : _destinations) {
+        context.num_remaining_eos = sinker_number;
+    }
+}
+
+void SinkBuffer::add_request(TransmitChunkInfo&& request) {
+    if (_is_cancelled) {
+        return;
+    }
+
+    const int64_t instance_lo = request.fragment_instance_id.lo;
+    std::vector<TransmitChunkInfo> requests;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        auto it = _destinations.find(instance_lo);
+        DCHECK(it != _destinations.end());
+        auto& context = it->second;
+        if (request.params.eos() && --context.num_remaining_eos > 0) {
+            // Only the last eos is sent to the destination, because the eos could be sent only once.
+            if (request.params.chunks_size() == 0) {
+                return;
+            }
+            request.params.set_eos(false);
+        }
+        context.pending_requests.emplace_back(std::move(request));
+        _num_buffered_requests++;
+        _pop_sendable_requests(context, &requests);
+    }
+
+    for (auto& sendable_request : requests) {
+        _send_rpc(instance_lo, sendable_request);
+    }
+}
+
+void SinkBuffer::_pop_sendable_requests(DestinationContext& context, std::vector<TransmitChunkInfo>* requests) {
+    while (!context.pending_requests.empty()) {
+        // The first request carries the chunk meta, which must be received before the others.
+        if (context.next_sequence == 0 && context.num_in_flight_rpcs > 0) {
+            break;
+        }
+        if (context.num_in_flight_rpcs >= _max_in_flight_rpcs) {
+            break;
+        }
+        auto& request = context.pending_requests.front();
+        // The eos request is sent after all the other requests are completed.
+        if (request.params.eos() && context.num_in_flight_rpcs > 0) {
+            break;
+        }
+        request.params.set_sequence(context.next_sequence++);
+        context.num_in_flight_rpcs++;
+        requests->emplace_back(std::move(request));
+        context.pending_requests.pop_front();
+    }
+}
+
+void SinkBuffer::_send_rpc(int64_t instance_lo, TransmitChunkInfo& request) {
+    auto* closure = new CallBackClosure<PTransmitChunkResult>();
+    closure->ref();
+    // The rpcs may be completed after the buffer is destroyed, e.g. the query is cancelled.
+    std::weak_ptr<SinkBuffer> weak_buffer = weak_from_this();
+    closure->addFailedHandler([weak_buffer, instance_lo]() {
+        if (auto buffer = weak_buffer.lock()) {
+            buffer->_process_rpc_done(instance_lo, Status::InternalError("transmit chunk rpc failed"));
+        }
+    });
+    // the span of the rpc lasts until it's completed
+    int64_t query_hi = request.params.finst_id().hi();
+    int64_t node_id = request.params.node_id();
+    int64_t start_ns = QueryTrace::enabled() ? MonotonicNanos() : 0;
+    closure->addSuccessHandler(
+            [weak_buffer, instance_lo, query_hi, node_id, start_ns](const PTransmitChunkResult& result) {
+                if (start_ns > 0) {
+                    QueryTrace::instance()->add(query_hi, "rpc", "send_chunk", start_ns, MonotonicNanos() - start_ns,
+                                                node_id);
+                }
+                if (auto buffer = weak_buffer.lock()) {
+                    buffer->_process_rpc_done(instance_lo, Status(result.status()));
+                }
+            });
+    closure->cntl.set_timeout_ms(_brpc_timeout_ms);
+    request.brpc_stub->transmit_chunk(&closure->cntl, &request.params, &closure->result, closure);
+}
+
+void SinkBuffer::_process_rpc_done(int64_t instance_lo, const Status& status) {
+    if (!status.ok()) {
+        LOG(WARNING) << " transmit chunk rpc failed, " << status.to_string();
+        _is_cancelled = true;
+    }
+
+    std::vector<TransmitChunkInfo> requests;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        auto& context = _destinations[instance_lo];
+        context.num_in_flight_rpcs--;
+        _num_buffered_requests--;
+        if (_is_cancelled) {
+            _num_buffered_requests -= context.pending_requests.size();
+            context.pending_requests.clear();
+        } else {
+            _pop_sendable_requests(context, &requests);
+        }
+    }
+    for (auto& request : requests) {
+        _send_rpc(instance_lo, request);
+    }
+
+    // The exchange sink operators blocked on the buffer are ready again.
+    // The dispatcher is absent if the rpc is completed while the BE is shutting down.
+    auto* driver_dispatcher = ExecEnv::GetInstance()->driver_dispatcher();
+    if (driver_dispatcher != nullptr) {
+        driver_dispatcher->notify_blocked_drivers();
+    }
+}
+
+bool SinkBuffer::is_full() const {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _num_buffered_requests >= _max_buffered_requests;
+}
+
+bool SinkBuffer::is_finished() const {
+    if (_is_cancelled) {
+        return true;
+    }
+    std::lock_guard<std::mutex> l(_mutex);
+    return _num_buffered_requests == 0;
+}
+
+} // namespace starrocks::pipeline
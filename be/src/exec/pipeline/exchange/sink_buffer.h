@@ -2,118 +2,75 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include "column/chunk.h"
 #include "gen_cpp/BackendService.h"
-#include "util/blocking_queue.hpp"
+#include "gen_cpp/DataSinks_types.h"
 #include "util/brpc_stub_cache.h"
-#include "util/callback_closure.h"
 
 namespace starrocks::pipeline {
 
 struct TransmitChunkInfo {
-    PTransmitChunkParams params;
+    // The id of the destination fragment instance, the requests to one destination are sent in order.
+    TUniqueId fragment_instance_id;
     PBackendService_Stub* brpc_stub;
+    PTransmitChunkParams params;
 };
 
-class SinkBuffer {
+// SinkBuffer is shared by all the ExchangeSinkOperators of a fragment instance, it sends their requests
+// by asynchronous brpc. At most pipeline_sink_brpc_max_in_flight transmit_chunk rpcs of each destination
+// are in flight, the other requests are pending and sent by the callbacks of the completed rpcs, so neither
+// the driver threads nor the brpc threads are blocked. If too many requests are buffered, it's full and
+// the ExchangeSinkOperators stop accepting input.
+//
+// The requests of a destination are numbered by contiguous sequences, by which the receiver deduplicates
+// them even if they arrive out of order. The first request of a destination carries the chunk meta,
+// so it's sent alone. The eos request of a destination is sent only once after all the sink operators
+// have sent their eos request to it, and after all the other requests to it are completed.
+class SinkBuffer : public std::enable_shared_from_this<SinkBuffer> {
 public:
-    SinkBuffer(size_t channel_number) : _closure_size(channel_number) {
-        for (size_t i = 0; i < channel_number; ++i) {
-            auto _chunk_closure = new CallBackClosure<PTransmitChunkResult>();
-            _chunk_closure->ref();
-            _chunk_closure->addFailedHandler([this]() {
-                _in_flight_rpc_num--;
-                _is_cancelled = true;
-                LOG(WARNING) << " transmit chunk rpc failed, ";
-            });
-
-            _chunk_closure->addSuccessHandler([this](const PTransmitChunkResult& result) {
-                _in_flight_rpc_num--;
-                Status status(result.status());
-                if (!status.ok()) {
-                    _is_cancelled = true;
-                    LOG(WARNING) << " transmit chunk rpc failed, ";
-                }
-            });
-            _closures.push_back(_chunk_closure);
-        }
-
-        _thread = std::thread{&SinkBuffer::process, this};
-    }
-
-    ~SinkBuffer() {
-        _pending_chunks.shutdown();
-        _thread.join();
-        for (auto* closure : _closures) {
-            if (closure->unref()) {
-                delete closure;
-            }
-        }
-    }
-
-    void add_request(TransmitChunkInfo request) {
-        _in_flight_rpc_num++;
-        _pending_chunks.put(request);
-    }
-
-    void process() {
-        while (true) {
-            // If the head closure has flight rpc, means all closures are busy
-            if (_closures.front()->has_in_flight_rpc()) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                continue;
-            }
-
-            TransmitChunkInfo info;
-            if (!_pending_chunks.blocking_get(&info)) {
-                break;
-            }
-            _send_rpc(info);
-
-            // The original design is bad, we must release_finst_id here!
-            info.params.release_finst_id();
-        }
-    }
-
-    bool is_full() const { return _in_flight_rpc_num >= _closure_size; }
-
-    bool is_finished() const { return _in_flight_rpc_num == 0 || _is_cancelled; }
+    SinkBuffer(const std::vector<TPlanFragmentDestination>& destinations, int32_t brpc_timeout_ms);
+    ~SinkBuffer() = default;
 
-    bool is_cancelled() const { return _is_cancelled; }
+    // It's called once for each sink operator, before any request is added.
+    void set_sinker_number(int32_t sinker_number);
 
-    void set_sinker_number(int64_t sinker_number) { _sinker_number = sinker_number; }
+    void add_request(TransmitChunkInfo&& request);
+
+    bool is_full() const;
+
+    bool is_finished() const;
+
+    bool is_cancelled() const { return _is_cancelled; }
 
 private:
-    void _send_rpc(TransmitChunkInfo& request) {
-        if (request.params.eos()) {
-            // Only send eos for last sinker, because we could only send eos once
-            if (--_sinker_number > 0) {
-                _in_flight_rpc_num--;
-                return;
-            }
-        }
-        request.params.set_sequence(_request_seq);
-        auto* closure = _closures.front();
-        DCHECK(!closure->has_in_flight_rpc());
-        // Move the closure has flight rpc to tail
-        _closures.pop_front();
-        _closures.push_back(closure);
-        closure->ref();
-        closure->cntl.Reset();
-        closure->cntl.set_timeout_ms(500);
-        request.brpc_stub->transmit_chunk(&closure->cntl, &request.params, &closure->result, closure);
-        _request_seq++;
-    }
-
-    // To avoid lock
-    const int32_t _closure_size;
-    int64_t _request_seq = 0;
-    int64_t _sinker_number = 0;
-    std::atomic<int32_t> _in_flight_rpc_num = 0;
+    struct DestinationContext {
+        int64_t next_sequence = 0;
+        int32_t num_in_flight_rpcs = 0;
+        int32_t num_remaining_eos = 0;
+        std::deque<TransmitChunkInfo> pending_requests;
+    };
+
+    // Pop the requests of the destination which can be sent now, and assign them sequences.
+    void _pop_sendable_requests(DestinationContext& context, std::vector<TransmitChunkInfo>* requests);
+    void _send_rpc(int64_t instance_lo, TransmitChunkInfo& request);
+    void _process_rpc_done(int64_t instance_lo, const Status& status);
+
+    const int32_t _max_in_flight_rpcs;
+    const int32_t _brpc_timeout_ms;
+    // The max number of pending and in-flight requests before the buffer is full.
+    size_t _max_buffered_requests = 0;
+
+    mutable std::mutex _mutex;
+    // fragment_instance_id.lo => context of the destination
+    std::unordered_map<int64_t, DestinationContext> _destinations;
+    size_t _num_buffered_requests = 0;
     std::atomic<bool> _is_cancelled{false};
-    std::deque<CallBackClosure<PTransmitChunkResult>*> _closures;
-    std::thread _thread;
-    UnboundedBlockingQueue<TransmitChunkInfo> _pending_chunks;
 };
 
-} // namespace starrocks::pipeline
\ No newline at end of file
+} // namespace starrocks::pipeline
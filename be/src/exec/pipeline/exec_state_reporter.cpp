@@ -11,6 +11,7 @@
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
 #include "service/backend_options.h"
+#include "util/uid_util.h"
 
 namespace starrocks {
 namespace pipeline {
@@ -173,6 +174,8 @@ void ExecStateReporter::submit(FragmentContext* fragment_ctx, const Status& stat
             auto* query_ctx = QueryContextManager::instance()->get_raw(query_id);
             DCHECK(query_ctx != nullptr);
             if (query_ctx->count_down_fragment()) {
+                LOG(INFO) << "[Driver] Query finished: query_id=" << print_id(query_id)
+                          << ", cpu_cost_ns=" << query_ctx->cpu_cost_ns();
                 QueryContextManager::instance()->unregister(query_id);
             }
         }
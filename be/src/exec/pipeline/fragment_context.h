@@ -83,6 +83,7 @@ public:
     bool is_canceled() { return _cancel_flag.load(std::memory_order_acquire) == true; }
 
     MorselQueueMap& morsel_queues() { return _morsel_queues; }
+    BucketMorselQueueMap& bucket_morsel_queues() { return _bucket_morsel_queues; }
 
 private:
     // Id of this query
@@ -100,6 +101,9 @@ private:
     // MorselQueue that is shared among drivers created from the same pipeline,
     // drivers contend for Morsels from MorselQueue.
     MorselQueueMap _morsel_queues;
+    // The drivers of the pipelines reading the bucketed scan nodes don't contend for the morsels, the
+    // i-th driver reads the morsels of the i-th bucket of the fragment instance.
+    BucketMorselQueueMap _bucket_morsel_queues;
     // when _num_root_drivers counts down to zero, means that all the root drivers are finished,
     // the fragment instance produces the entire result required, all the outstanding drivers
     // should finish computation.
@@ -2,25 +2,31 @@
 
 #include "exec/pipeline/fragment_executor.h"
 
+#include <set>
 #include <unordered_map>
 
+#include "common/config.h"
 #include "exec/exchange_node.h"
 #include "exec/pipeline/exchange/exchange_sink_operator.h"
 #include "exec/pipeline/exchange/local_exchange_source_operator.h"
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exec/pipeline/morsel.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/pipeline_profile.h"
 #include "exec/pipeline/result_sink_operator.h"
 #include "exec/pipeline/scan_operator.h"
 #include "exec/scan_node.h"
+#include "exec/vectorized/olap_scan_node.h"
 #include "gen_cpp/starrocks_internal_service.pb.h"
 #include "gutil/casts.h"
 #include "gutil/map_util.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/data_stream_sender.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/result_sink.h"
 #include "util/pretty_printer.h"
+#include "util/query_trace.h"
 #include "util/uid_util.h"
 
 namespace starrocks::pipeline {
@@ -37,6 +43,7 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     const TPlanFragmentExecParams& params = request.params;
     auto& query_id = params.query_id;
     auto& fragment_id = params.fragment_instance_id;
+    SCOPED_QUERY_TRACE(query_id, "fragment", "prepare", fragment_id.lo);
     _query_ctx = QueryContextManager::instance()->get_or_register(query_id);
     if (params.__isset.instances_number) {
         _query_ctx->set_num_fragments(params.instances_number);
@@ -121,13 +128,51 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     std::vector<TScanRangeParams> no_scan_ranges;
     plan->collect_scan_nodes(&scan_nodes);
 
+    // The scan nodes of the colocate joins are read per bucket.
+    std::set<int32_t> bucketed_scan_ids;
+    for (const auto& pipeline : _fragment_ctx->pipelines()) {
+        auto* source_factory = down_cast<SourceOperatorFactory*>(pipeline->get_op_factories()[0].get());
+        if (source_factory->need_morsels() && down_cast<ScanOperatorFactory*>(source_factory)->is_bucketed()) {
+            bucketed_scan_ids.insert(source_factory->plan_node_id());
+        }
+    }
+    // All the bucketed scan nodes of the fragment instance read the same buckets, by the drivers of the same
+    // sequences, so that the colocate joins pair the build and the probe of a bucket by the driver sequence.
+    std::set<int32_t> buckets;
+    for (int32_t scan_id : bucketed_scan_ids) {
+        for (const auto& scan_range : FindWithDefault(params.per_node_scan_ranges, scan_id, no_scan_ranges)) {
+            if (!scan_range.__isset.bucket_sequence) {
+                return Status::InternalError(
+                        strings::Substitute("The scan range of the colocate scan node $0 has no bucket", scan_id));
+            }
+            buckets.insert(scan_range.bucket_sequence);
+        }
+    }
+    // Keep at least one driver even if there is no bucket.
+    if (buckets.empty()) {
+        buckets.insert(0);
+    }
+
     MorselQueueMap& morsel_queues = _fragment_ctx->morsel_queues();
+    BucketMorselQueueMap& bucket_morsel_queues = _fragment_ctx->bucket_morsel_queues();
     for (int i = 0; i < scan_nodes.size(); ++i) {
         ScanNode* scan_node = down_cast<ScanNode*>(scan_nodes[i]);
         const std::vector<TScanRangeParams>& scan_ranges =
                 FindWithDefault(params.per_node_scan_ranges, scan_node->id(), no_scan_ranges);
+        if (bucketed_scan_ids.count(scan_node->id()) > 0) {
+            bucket_morsel_queues[scan_node->id()] = create_bucket_morsel_queues(scan_node->id(), scan_ranges, buckets);
+            continue;
+        }
         Morsels morsels = convert_scan_range_to_morsel(scan_ranges, scan_node->id());
-        morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(std::move(morsels)));
+        auto* olap_scan_node = dynamic_cast<vectorized::OlapScanNode*>(scan_node);
+        if (olap_scan_node != nullptr && config::pipeline_scan_morsel_split_rows > 0) {
+            bool skip_aggregation = olap_scan_node->thrift_olap_scan_node().is_preaggregation;
+            morsel_queues.emplace(scan_node->id(),
+                                  std::make_unique<PhysicalSplitMorselQueue>(std::move(morsels), skip_aggregation,
+                                                                             config::pipeline_scan_morsel_split_rows));
+        } else {
+            morsel_queues.emplace(scan_node->id(), std::make_unique<FixedMorselQueue>(std::move(morsels)));
+        }
     }
 
     Drivers drivers;
@@ -141,11 +186,27 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
         // post-order traversal.
         const bool is_root = (n == num_pipelines - 1);
         const auto driver_instance_count = pipeline->get_driver_instance_count();
+        // the drivers of a pipeline share the profile created with the operators of the first driver.
+        PipelineProfile* pipeline_profile = nullptr;
+        auto get_pipeline_profile = [&](const Operators& operators) {
+            if (pipeline_profile == nullptr && config::enable_pipeline_profile) {
+                pipeline_profile = obj_pool->add(
+                        new PipelineProfile(runtime_state->runtime_profile(), pipeline->get_id(), operators));
+            }
+            return pipeline_profile;
+        };
 
-        if (pipeline->get_op_factories()[0]->is_source()) {
-            auto source_id = pipeline->get_op_factories()[0]->plan_node_id();
-            auto& morsel_queue = morsel_queues[source_id];
-            const auto instance_count = std::min<size_t>(morsel_queue->num_morsels(), driver_instance_count);
+        auto* source_factory = down_cast<SourceOperatorFactory*>(pipeline->get_op_factories()[0].get());
+        if (source_factory->need_morsels()) {
+            auto source_id = source_factory->plan_node_id();
+            const bool is_bucketed = bucketed_scan_ids.count(source_id) > 0;
+            // Keep at least one driver even if there is no morsel, so that the pipeline can finish
+            // and notify its downstream.
+            size_t instance_count = buckets.size();
+            if (!is_bucketed) {
+                instance_count = std::max<size_t>(
+                        1, std::min<size_t>(morsel_queues[source_id]->num_morsels(), driver_instance_count));
+            }
             if (is_root) {
                 _fragment_ctx->set_num_root_drivers(instance_count);
             }
@@ -155,7 +216,9 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
                     operators.emplace_back(factory->create(instance_count, i));
                 }
                 DriverPtr driver = std::make_shared<PipelineDriver>(operators, _query_ctx, _fragment_ctx, 0, is_root);
-                driver->set_morsel_queue(morsel_queue.get());
+                driver->set_morsel_queue(is_bucketed ? bucket_morsel_queues[source_id][i].get()
+                                                     : morsel_queues[source_id].get());
+                driver->set_pipeline_profile(get_pipeline_profile(operators));
                 auto* scan_operator = down_cast<ScanOperator*>(driver->source_operator());
                 if (pipeline_scan_mode == 1) {
                     scan_operator->set_io_threads(exec_env->pipeline_io_thread_pool());
@@ -174,6 +237,7 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
                     operators.emplace_back(factory->create(driver_instance_count, i));
                 }
                 DriverPtr driver = std::make_shared<PipelineDriver>(operators, _query_ctx, _fragment_ctx, i, is_root);
+                driver->set_pipeline_profile(get_pipeline_profile(operators));
                 drivers.emplace_back(driver);
             }
         }
@@ -202,7 +266,10 @@ void FragmentExecutor::_convert_data_sink_to_operator(const TPlanFragmentExecPar
         _fragment_ctx->pipelines().back()->add_op_factory(op);
     } else if (typeid(*datasink) == typeid(starrocks::DataStreamSender)) {
         starrocks::DataStreamSender* sender = down_cast<starrocks::DataStreamSender*>(datasink);
-        std::shared_ptr<SinkBuffer> sink_buffer = std::make_shared<SinkBuffer>(sender->get_destinations_size());
+        // The same rpc timeout as DataStreamSender.
+        const int32_t brpc_timeout_ms =
+                std::min(3600, _fragment_ctx->runtime_state()->query_options().query_timeout) * 1000;
+        std::shared_ptr<SinkBuffer> sink_buffer = std::make_shared<SinkBuffer>(params.destinations, brpc_timeout_ms);
 
         OpFactoryPtr exchange_sink = std::make_shared<ExchangeSinkOperatorFactory>(
                 context->next_operator_id(), -1, sink_buffer, sender->get_partition_type(), params.destinations,
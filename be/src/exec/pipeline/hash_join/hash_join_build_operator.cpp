@@ -0,0 +1,74 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/hash_join/hash_join_build_operator.h"
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status HashJoinBuildOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    // The builder is shared by all the drivers, so it is prepared only once by the first driver, and
+    // the hash table outlives this operator, so its memory is accounted to the fragment instance.
+    if (_driver_sequence == 0 || _hash_joiner_factory->has_builder_per_driver()) {
+        RETURN_IF_ERROR(
+                _hash_joiner->prepare(state, state->obj_pool(), _runtime_profile.get(), state->instance_mem_tracker()));
+        RETURN_IF_ERROR(_hash_joiner->open(state));
+    }
+    return Status::OK();
+}
+
+Status HashJoinBuildOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_hash_joiner->unref(state));
+    return Operator::close(state);
+}
+
+bool HashJoinBuildOperator::need_input() {
+    if (is_finished()) {
+        return false;
+    }
+    // The bucket isn't read until its build is admitted.
+    return !_hash_joiner_factory->is_bucketed() || _hash_joiner_factory->is_bucket_admitted(_driver_sequence);
+}
+
+void HashJoinBuildOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    // Only the last finished build driver builds the hash table, after all the input is appended.
+    if (_hash_joiner->finish_one_build_driver()) {
+        _hash_joiner->build_complete(_build_ht(state));
+    }
+}
+
+Status HashJoinBuildOperator::_build_ht(RuntimeState* state) {
+    SCOPED_TIMER(_hash_joiner->build_timer());
+    RETURN_IF_ERROR(_hash_joiner->build_ht(state));
+
+    int64_t runtime_join_filter_pushdown_limit = 1024000;
+    if (state->query_options().__isset.runtime_join_filter_pushdown_limit) {
+        runtime_join_filter_pushdown_limit = state->query_options().runtime_join_filter_pushdown_limit;
+    }
+    // The hash table of a bucket or partition only covers its rows, the runtime filters are published after
+    // the hash tables of all the buckets or partitions are added into them.
+    if (_hash_joiner_factory->has_builder_per_driver()) {
+        return _hash_joiner_factory->publish_bucket_runtime_filters(state, _hash_joiner.get(),
+                                                                    runtime_join_filter_pushdown_limit);
+    }
+    // for global runtime filter, it must be published even if the hash table is empty.
+    return _hash_joiner->publish_runtime_filters(state, runtime_join_filter_pushdown_limit);
+}
+
+StatusOr<vectorized::ChunkPtr> HashJoinBuildOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Not support");
+}
+
+Status HashJoinBuildOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    SCOPED_TIMER(_hash_joiner->build_timer());
+    return _hash_joiner->append_chunk_to_ht(state, chunk);
+}
+} // namespace starrocks::pipeline
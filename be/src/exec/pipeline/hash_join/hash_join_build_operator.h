@@ -0,0 +1,64 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/hash_joiner.h"
+
+namespace starrocks::pipeline {
+// The build side of the pipeline hash join. The build operators of all the drivers append their input
+// into the hash table of one shared builder, and the last finished one builds the hash table, which is
+// then probed by all the HashJoinProbeOperators. In a colocate or shuffle join, each build operator builds
+// the hash table of its bucket or partition alone, see HashJoinerFactory.
+class HashJoinBuildOperator final : public Operator {
+public:
+    HashJoinBuildOperator(int32_t id, int32_t plan_node_id, vectorized::HashJoinerFactoryPtr hash_joiner_factory,
+                          int32_t driver_sequence)
+            : Operator(id, "hash_join_build", plan_node_id),
+              _hash_joiner_factory(std::move(hash_joiner_factory)),
+              _hash_joiner(_hash_joiner_factory->builder(driver_sequence)),
+              _driver_sequence(driver_sequence) {
+        _hash_joiner->ref();
+    }
+    ~HashJoinBuildOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool need_input() override;
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    Status _build_ht(RuntimeState* state);
+
+    vectorized::HashJoinerFactoryPtr _hash_joiner_factory = nullptr;
+    // shared by all the HashJoinBuildOperators and HashJoinProbeOperators, or by the ones of the same bucket
+    // or partition
+    vectorized::HashJoinerPtr _hash_joiner = nullptr;
+    int32_t _driver_sequence = 0;
+    bool _is_finished = false;
+};
+
+class HashJoinBuildOperatorFactory final : public OperatorFactory {
+public:
+    HashJoinBuildOperatorFactory(int32_t id, int32_t plan_node_id,
+                                 vectorized::HashJoinerFactoryPtr hash_joiner_factory)
+            : OperatorFactory(id, plan_node_id), _hash_joiner_factory(std::move(hash_joiner_factory)) {}
+
+    ~HashJoinBuildOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        const auto& builder = _hash_joiner_factory->builder(driver_sequence);
+        builder->set_num_build_drivers(_hash_joiner_factory->has_builder_per_driver() ? 1 : driver_instance_count);
+        return std::make_shared<HashJoinBuildOperator>(_id, _plan_node_id, _hash_joiner_factory, driver_sequence);
+    }
+
+private:
+    vectorized::HashJoinerFactoryPtr _hash_joiner_factory = nullptr;
+};
+} // namespace starrocks::pipeline
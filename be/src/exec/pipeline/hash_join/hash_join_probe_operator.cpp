@@ -0,0 +1,96 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/hash_join/hash_join_probe_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status HashJoinProbeOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RETURN_IF_ERROR(_prober->prepare(state, state->obj_pool(), _runtime_profile.get(), state->instance_mem_tracker()));
+    return _prober->open(state);
+}
+
+Status HashJoinProbeOperator::close(RuntimeState* state) {
+    // The prober must be closed before the builder, because it shares the hash table of the builder.
+    RETURN_IF_ERROR(_prober->close(state));
+    RETURN_IF_ERROR(_builder->unref(state));
+    if (_hash_joiner_factory->is_bucketed()) {
+        // The hash table of the bucket is released, admit the build of the next bucket.
+        _hash_joiner_factory->release_bucket();
+    }
+    return Operator::close(state);
+}
+
+bool HashJoinProbeOperator::_is_ready() {
+    if (_is_ht_shared) {
+        return true;
+    }
+    if (!_builder->is_build_complete()) {
+        return false;
+    }
+    if (_builder->build_status().ok()) {
+        _prober->share_build_ht(*_builder);
+        _is_short_circuit = _builder->is_short_circuit();
+    }
+    _is_ht_shared = true;
+    return true;
+}
+
+bool HashJoinProbeOperator::has_output() {
+    if (!_is_ready()) {
+        return false;
+    }
+    if (!_builder->build_status().ok()) {
+        // pull_chunk reports the error of building.
+        return true;
+    }
+    if (_is_short_circuit) {
+        return false;
+    }
+    if (_prober->has_probe_chunk()) {
+        return true;
+    }
+    return _is_input_finished && _prober->need_probe_remain() && !_prober->is_build_eos();
+}
+
+bool HashJoinProbeOperator::need_input() {
+    return _is_ready() && !_is_short_circuit && !_is_input_finished && !_prober->has_probe_chunk();
+}
+
+bool HashJoinProbeOperator::is_finished() const {
+    if (_is_short_circuit) {
+        return true;
+    }
+    if (!_is_input_finished || _prober->has_probe_chunk()) {
+        return false;
+    }
+    if (!_prober->need_probe_remain()) {
+        return true;
+    }
+    return _is_ht_shared && _prober->is_build_eos();
+}
+
+StatusOr<vectorized::ChunkPtr> HashJoinProbeOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_ERROR(_builder->build_status());
+    SCOPED_TIMER(_prober->probe_timer());
+
+    vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
+    if (_prober->has_probe_chunk()) {
+        RETURN_IF_ERROR(_prober->probe(&chunk));
+    } else {
+        // fetch the remain data of hash table
+        bool eos = false;
+        RETURN_IF_ERROR(_prober->probe_remain(&chunk, &eos));
+    }
+
+    DCHECK_CHUNK(chunk);
+    return std::move(chunk);
+}
+
+Status HashJoinProbeOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    return _prober->set_probe_chunk(chunk);
+}
+} // namespace starrocks::pipeline
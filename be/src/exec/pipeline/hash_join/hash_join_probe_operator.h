@@ -0,0 +1,68 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/hash_joiner.h"
+
+namespace starrocks::pipeline {
+// The probe side of the pipeline hash join. Each HashJoinProbeOperator owns a prober, which shares
+// the read-only hash table of the builder once all the HashJoinBuildOperators have finished, so all
+// the probe drivers probe one hash table concurrently. In a colocate join, each probe operator probes the
+// hash table of its bucket, which is released after the probe operator is closed.
+class HashJoinProbeOperator final : public Operator {
+public:
+    HashJoinProbeOperator(int32_t id, int32_t plan_node_id, vectorized::HashJoinerFactoryPtr hash_joiner_factory,
+                          int32_t driver_sequence)
+            : Operator(id, "hash_join_probe", plan_node_id),
+              _hash_joiner_factory(std::move(hash_joiner_factory)),
+              _builder(_hash_joiner_factory->builder(driver_sequence)),
+              _prober(_hash_joiner_factory->create_prober()) {
+        _builder->ref();
+    }
+    ~HashJoinProbeOperator() override = default;
+
+    bool has_output() override;
+    bool need_input() override;
+    bool is_finished() const override;
+    void finish(RuntimeState* state) override { _is_input_finished = true; }
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    // Whether the hash table of the builder is built, the prober starts to share it from then on.
+    bool _is_ready();
+
+    vectorized::HashJoinerFactoryPtr _hash_joiner_factory = nullptr;
+    // shared by all the HashJoinBuildOperators and HashJoinProbeOperators, or by the ones of the same bucket
+    // or partition
+    vectorized::HashJoinerPtr _builder = nullptr;
+    // owned by this operator
+    vectorized::HashJoinerPtr _prober = nullptr;
+
+    bool _is_ht_shared = false;
+    // The join outputs nothing, e.g. inner join with empty right table.
+    bool _is_short_circuit = false;
+    bool _is_input_finished = false;
+};
+
+class HashJoinProbeOperatorFactory final : public OperatorFactory {
+public:
+    HashJoinProbeOperatorFactory(int32_t id, int32_t plan_node_id,
+                                 vectorized::HashJoinerFactoryPtr hash_joiner_factory)
+            : OperatorFactory(id, plan_node_id), _hash_joiner_factory(std::move(hash_joiner_factory)) {}
+
+    ~HashJoinProbeOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<HashJoinProbeOperator>(_id, _plan_node_id, _hash_joiner_factory, driver_sequence);
+    }
+
+private:
+    vectorized::HashJoinerFactoryPtr _hash_joiner_factory = nullptr;
+};
+} // namespace starrocks::pipeline
@@ -0,0 +1,128 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/morsel.h"
+
+#include <limits>
+#include <shared_mutex>
+
+#include "gutil/casts.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+
+namespace starrocks::pipeline {
+
+std::vector<MorselQueuePtr> create_bucket_morsel_queues(int32_t node_id,
+                                                        const std::vector<TScanRangeParams>& scan_ranges,
+                                                        const std::set<int32_t>& buckets) {
+    std::vector<MorselQueuePtr> queues;
+    queues.reserve(buckets.size());
+    for (int32_t bucket : buckets) {
+        Morsels morsels;
+        for (const auto& scan_range : scan_ranges) {
+            if (scan_range.bucket_sequence == bucket) {
+                morsels.emplace_back(std::make_unique<OlapMorsel>(node_id, scan_range));
+            }
+        }
+        queues.emplace_back(std::make_unique<FixedMorselQueue>(std::move(morsels)));
+    }
+    return queues;
+}
+
+PhysicalSplitMorselQueue::PhysicalSplitMorselQueue(Morsels&& morsels, bool skip_aggregation, int64_t split_rows)
+        : _morsels(std::move(morsels)), _skip_aggregation(skip_aggregation), _split_rows(split_rows) {
+    DCHECK_GT(_split_rows, 0);
+    for (auto& morsel : _morsels) {
+        auto tablet = _get_splittable_tablet(down_cast<OlapMorsel*>(morsel.get()));
+        if (tablet == nullptr) {
+            _num_estimated_morsels += 1;
+        } else {
+            _num_estimated_morsels += std::max<int64_t>(1, (tablet->num_rows() + _split_rows - 1) / _split_rows);
+        }
+    }
+}
+
+std::optional<MorselPtr> PhysicalSplitMorselQueue::try_get() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    while (_tablet_index < _morsels.size()) {
+        auto* morsel = down_cast<OlapMorsel*>(_morsels[_tablet_index].get());
+        if (!_is_tablet_split) {
+            if (!_split_tablet(morsel)) {
+                // Hand out the tablet as a whole.
+                return std::move(_morsels[_tablet_index++]);
+            }
+            _is_tablet_split = true;
+        }
+        if (_split_index < _splits.size()) {
+            return _new_split_morsel(morsel, std::move(_splits[_split_index++]));
+        }
+        _is_tablet_split = false;
+        ++_tablet_index;
+    }
+    return {};
+}
+
+TabletSharedPtr PhysicalSplitMorselQueue::_get_splittable_tablet(OlapMorsel* morsel) const {
+    const TInternalScanRange* scan_range = morsel->get_scan_range();
+    SchemaHash schema_hash = strtoul(scan_range->schema_hash.c_str(), nullptr, 10);
+    std::string err;
+    // The tablet not found is reported by the OlapChunkSource scanning the whole tablet.
+    auto tablet =
+            StorageEngine::instance()->tablet_manager()->get_tablet(scan_range->tablet_id, schema_hash, true, &err);
+    if (tablet == nullptr) {
+        return nullptr;
+    }
+    // The rows of primary key tablets are captured by TabletUpdates, and the rows of aggregate and unique
+    // tablets need to be merged across segments unless the aggregation is skipped.
+    KeysType keys_type = tablet->keys_type();
+    if (keys_type == PRIMARY_KEYS || (keys_type != DUP_KEYS && !_skip_aggregation)) {
+        return nullptr;
+    }
+    return tablet;
+}
+
+bool PhysicalSplitMorselQueue::_split_tablet(OlapMorsel* morsel) {
+    _splits.clear();
+    _split_index = 0;
+
+    auto tablet = _get_splittable_tablet(morsel);
+    if (tablet == nullptr) {
+        return false;
+    }
+    int64_t version = strtoul(morsel->get_scan_range()->version.c_str(), nullptr, 10);
+    std::vector<RowsetSharedPtr> rowsets;
+    {
+        std::shared_lock rdlock(tablet->get_header_lock());
+        if (tablet->capture_consistent_rowsets(Version(0, version), &rowsets) != OLAP_SUCCESS) {
+            return false;
+        }
+    }
+
+    for (auto& rowset : rowsets) {
+        if (rowset->empty() || rowset->num_segments() == 0) {
+            continue;
+        }
+        // The number of rows of each segment is unknown until the rowset is loaded, so it's estimated
+        // by the average, and the last row range of each segment is unbounded to cover the remaining rows.
+        const int64_t num_segments = rowset->num_segments();
+        const int64_t rows_per_segment = (rowset->num_rows() + num_segments - 1) / num_segments;
+        const int64_t num_ranges = std::max<int64_t>(1, (rows_per_segment + _split_rows - 1) / _split_rows);
+        for (int64_t segment_id = 0; segment_id < num_segments; ++segment_id) {
+            for (int64_t i = 0; i < num_ranges; ++i) {
+                auto begin = static_cast<segment_v2::rowid_t>(i * _split_rows);
+                auto end = i + 1 == num_ranges ? std::numeric_limits<segment_v2::rowid_t>::max()
+                                               : static_cast<segment_v2::rowid_t>((i + 1) * _split_rows);
+                _splits.emplace_back(Split{rowset, std::make_shared<vectorized::RowidRangeOption>(
+                                                           segment_id, vectorized::SparseRange(begin, end))});
+            }
+        }
+    }
+    return true;
+}
+
+MorselPtr PhysicalSplitMorselQueue::_new_split_morsel(OlapMorsel* morsel, Split&& split) const {
+    auto split_morsel = std::make_unique<OlapMorsel>(morsel->get_plan_node_id(), *morsel->get_scan_range());
+    split_morsel->set_split({std::move(split.rowset)}, std::move(split.rowid_range_option));
+    return split_morsel;
+}
+
+} // namespace starrocks::pipeline
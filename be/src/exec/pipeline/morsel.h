@@ -2,10 +2,15 @@
 
 #pragma once
 
+#include <mutex>
 #include <optional>
+#include <set>
 
 #include "gen_cpp/InternalService_types.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/rowset.h"
+#include "storage/rowset/vectorized/rowid_range_option.h"
+#include "storage/tablet.h"
 
 namespace starrocks {
 namespace pipeline {
@@ -15,6 +20,8 @@ using Morsels = std::vector<MorselPtr>;
 class MorselQueue;
 using MorselQueuePtr = std::unique_ptr<MorselQueue>;
 using MorselQueueMap = std::unordered_map<int32_t, MorselQueuePtr>;
+// The morsel queues of the buckets of a bucketed scan node, one for each driver.
+using BucketMorselQueueMap = std::unordered_map<int32_t, std::vector<MorselQueuePtr>>;
 
 class Morsel {
 public:
@@ -31,19 +38,47 @@ public:
     OlapMorsel(int32_t plan_node_id, const TScanRangeParams& scan_range) : Morsel(plan_node_id) {
         _scan_range = std::make_unique<TInternalScanRange>(scan_range.scan_range.internal_scan_range);
     }
+    OlapMorsel(int32_t plan_node_id, const TInternalScanRange& internal_scan_range) : Morsel(plan_node_id) {
+        _scan_range = std::make_unique<TInternalScanRange>(internal_scan_range);
+    }
 
     TInternalScanRange* get_scan_range() { return _scan_range.get(); }
 
+    // A morsel split from the tablet only reads |rowsets|, rather than the rowsets captured by the version
+    // of scan range. And if |rowid_range_option| is set, only the row range of a segment is read.
+    void set_split(std::vector<RowsetSharedPtr> rowsets, vectorized::RowidRangeOptionPtr rowid_range_option) {
+        _rowsets = std::move(rowsets);
+        _rowid_range_option = std::move(rowid_range_option);
+    }
+    const std::vector<RowsetSharedPtr>& rowsets() const { return _rowsets; }
+    const vectorized::RowidRangeOptionPtr& rowid_range_option() const { return _rowid_range_option; }
+
 private:
     std::unique_ptr<TInternalScanRange> _scan_range;
+    std::vector<RowsetSharedPtr> _rowsets;
+    vectorized::RowidRangeOptionPtr _rowid_range_option;
 };
 
 class MorselQueue {
 public:
-    MorselQueue(Morsels&& morsels) : _morsels(std::move(morsels)), _num_morsels(_morsels.size()), _pop_index(0) {}
+    MorselQueue() = default;
+    virtual ~MorselQueue() = default;
+
+    // The number of morsels is used to decide the number of drivers, it's an estimation
+    // if the morsels are generated on demand.
+    virtual size_t num_morsels() const = 0;
+    virtual std::optional<MorselPtr> try_get() = 0;
+};
 
-    size_t num_morsels() const { return _num_morsels; }
-    std::optional<MorselPtr> try_get() {
+// FixedMorselQueue hands out the morsels given at construction.
+class FixedMorselQueue final : public MorselQueue {
+public:
+    explicit FixedMorselQueue(Morsels&& morsels)
+            : _morsels(std::move(morsels)), _num_morsels(_morsels.size()), _pop_index(0) {}
+    ~FixedMorselQueue() override = default;
+
+    size_t num_morsels() const override { return _num_morsels; }
+    std::optional<MorselPtr> try_get() override {
         auto idx = _pop_index.load();
         // prevent _num_morsels from superfluous addition
         if (idx >= _num_morsels) {
@@ -63,5 +98,50 @@ private:
     std::atomic<size_t> _pop_index;
 };
 
+// PhysicalSplitMorselQueue splits each tablet of the OlapMorsels into the row ranges of segments on demand,
+// each row range has at most |split_rows| rows, so that a large tablet can be scanned by several drivers.
+// The rowsets of a tablet are captured once when the first morsel of it is requested, and are shared by
+// all the morsels of the tablet, so that they read a consistent version.
+// A tablet is handed out as a whole if its rows cannot be read separately, i.e. the rows of different
+// segments need to be merged or aggregated, or its rowsets cannot be captured.
+class PhysicalSplitMorselQueue final : public MorselQueue {
+public:
+    PhysicalSplitMorselQueue(Morsels&& morsels, bool skip_aggregation, int64_t split_rows);
+    ~PhysicalSplitMorselQueue() override = default;
+
+    size_t num_morsels() const override { return _num_estimated_morsels; }
+    std::optional<MorselPtr> try_get() override;
+
+private:
+    struct Split {
+        RowsetSharedPtr rowset;
+        vectorized::RowidRangeOptionPtr rowid_range_option;
+    };
+
+    // Return nullptr if the tablet cannot be split.
+    TabletSharedPtr _get_splittable_tablet(OlapMorsel* morsel) const;
+    // Return false if the tablet cannot be split.
+    bool _split_tablet(OlapMorsel* morsel);
+    MorselPtr _new_split_morsel(OlapMorsel* morsel, Split&& split) const;
+
+    Morsels _morsels;
+    const bool _skip_aggregation;
+    const int64_t _split_rows;
+    size_t _num_estimated_morsels = 0;
+
+    std::mutex _mutex;
+    // The index of the tablet being split.
+    size_t _tablet_index = 0;
+    bool _is_tablet_split = false;
+    std::vector<Split> _splits;
+    size_t _split_index = 0;
+};
+
+// The morsel queues of a scan node read per bucket, one FixedMorselQueue of the scan ranges of each of |buckets| in
+// order, so that the i-th driver reads the i-th bucket.
+std::vector<MorselQueuePtr> create_bucket_morsel_queues(int32_t node_id,
+                                                        const std::vector<TScanRangeParams>& scan_ranges,
+                                                        const std::set<int32_t>& buckets);
+
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
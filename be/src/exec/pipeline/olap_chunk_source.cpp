@@ -3,9 +3,11 @@
 #include "exec/pipeline/olap_chunk_source.h"
 
 #include "column/column_helper.h"
+#include "exec/vectorized/olap_global_dict.h"
 #include "exec/vectorized/olap_scan_prepare.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
-#include "exprs/vectorized/runtime_filter.h"
+#include "exprs/vectorized/runtime_filter_bank.h"
+#include "gutil/casts.h"
 #include "gutil/map_util.h"
 #include "runtime/current_mem_tracker.h"
 #include "runtime/current_thread.h"
@@ -37,11 +39,13 @@ Status OlapChunkSource::prepare(RuntimeState* state) {
     const TupleDescriptor* tuple_desc = state->desc_tbl().get_tuple_descriptor(_tuple_id);
     _slots = &tuple_desc->slots();
     // 1. Convert conjuncts to ColumnValueRange in each column
-    RETURN_IF_ERROR(details::normalize_conjuncts(*_slots, _obj_pool, _conjunct_ctxs, _normalized_conjuncts,
+    std::vector<SlotDescriptor*> slots = slots_without_global_dicts(*_slots, _slot_global_dicts);
+    RETURN_IF_ERROR(details::normalize_conjuncts(slots, _obj_pool, _conjunct_ctxs, _normalized_conjuncts,
                                                  _runtime_filters, _is_null_vector, _column_value_ranges, &_status));
 
     // 2. Using ColumnValueRange to Build StorageEngine filters
     RETURN_IF_ERROR(details::build_olap_filters(_column_value_ranges, _olap_filter));
+    details::normalize_like_predicates(slots, _conjunct_ctxs, _normalized_conjuncts, _olap_filter);
 
     const TQueryOptions& query_options = state->query_options();
     int32_t max_scan_key_num;
@@ -60,9 +64,51 @@ Status OlapChunkSource::prepare(RuntimeState* state) {
 
     // 5. Init olap reader
     RETURN_IF_ERROR(_init_olap_reader(_runtime_state));
+
+    _init_row_runtime_filters();
     return Status::OK();
 }
 
+void OlapChunkSource::_init_row_runtime_filters() {
+    for (const auto& it : _runtime_filters.descriptors()) {
+        const RuntimeFilterProbeDescriptor* desc = it.second;
+        SlotId slot_id;
+        // the dict ids of the slots with global dicts can't be evaluated by the filters of the strings.
+        if (!desc->is_probe_slot_ref(&slot_id) || _slot_global_dicts.count(slot_id) > 0) {
+            continue;
+        }
+        for (const SlotDescriptor* slot : *_slots) {
+            if (slot->id() == slot_id && slot->type().type == desc->probe_expr_type()) {
+                _row_runtime_filters.push_back(RowRuntimeFilter{desc, slot_id, {}});
+                break;
+            }
+        }
+    }
+    if (!_row_runtime_filters.empty() && _runtime_profile != nullptr) {
+        _runtime_filter_timer = ADD_TIMER(_runtime_profile, "RuntimeFilterTime");
+        _runtime_filter_rows_counter = ADD_COUNTER(_runtime_profile, "RuntimeFilterRowsFiltered", TUnit::UNIT);
+    }
+}
+
+void OlapChunkSource::_eval_row_runtime_filters(vectorized::Chunk* chunk) {
+    SCOPED_TIMER(_runtime_filter_timer);
+    size_t input_rows = chunk->num_rows();
+    for (auto& filter : _row_runtime_filters) {
+        const JoinRuntimeFilter* rf = filter.desc->runtime_filter();
+        if (rf == nullptr) {
+            continue;
+        }
+        ColumnPtr& column = chunk->get_column_by_slot_id(filter.slot_id);
+        chunk->filter(rf->evaluate(column.get(), &filter.ctx));
+        if (chunk->num_rows() == 0) {
+            break;
+        }
+    }
+    if (_runtime_filter_rows_counter != nullptr) {
+        COUNTER_UPDATE(_runtime_filter_rows_counter, input_rows - chunk->num_rows());
+    }
+}
+
 Status OlapChunkSource::_build_scan_range(RuntimeState* state) {
     RETURN_IF_ERROR(_scan_keys.get_key_range(&_cond_ranges));
     if (_cond_ranges.empty()) {
@@ -120,6 +166,14 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
     params->runtime_state = _runtime_state;
     params->use_page_cache = !config::disable_storage_page_cache;
     params->chunk_size = config::vector_chunk_size;
+    params->read_ahead_pages = config::segment_read_ahead_pages;
+    if (!_global_dicts.empty()) {
+        params->global_dicts = &_global_dicts;
+    }
+    // The morsel split from the tablet only reads a part of the tablet.
+    auto* olap_morsel = down_cast<OlapMorsel*>(_morsel.get());
+    params->rowsets = olap_morsel->rowsets();
+    params->rowid_range_option = olap_morsel->rowid_range_option();
 
     PredicateParser parser(_tablet->tablet_schema());
 
@@ -206,16 +260,18 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
 
     RETURN_IF_ERROR(_get_tablet(_scan_range));
     RETURN_IF_ERROR(_init_scanner_columns(scanner_columns));
+    RETURN_IF_ERROR(
+            build_column_global_dicts(*_tablet, _skip_aggregation, *_slots, _slot_global_dicts, &_global_dicts));
     RETURN_IF_ERROR(_init_reader_params(_scanner_ranges, scanner_columns, reader_columns, &params));
     const TabletSchema& tablet_schema = _tablet->tablet_schema();
     starrocks::vectorized::Schema child_schema =
-            ChunkHelper::convert_schema_to_format_v2(tablet_schema, reader_columns);
+            ChunkHelper::convert_schema_to_format_v2(tablet_schema, reader_columns, _global_dicts);
     _reader = std::make_shared<Reader>(std::move(child_schema));
     if (reader_columns.size() == scanner_columns.size()) {
         _prj_iter = _reader;
     } else {
         starrocks::vectorized::Schema output_schema =
-                ChunkHelper::convert_schema_to_format_v2(tablet_schema, scanner_columns);
+                ChunkHelper::convert_schema_to_format_v2(tablet_schema, scanner_columns, _global_dicts);
         _prj_iter = new_projection_iterator(output_schema, _reader);
     }
 
@@ -236,6 +292,7 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
 bool OlapChunkSource::has_next_chunk() {
     // If we need and could get next chunk from storage engine,
     // the _status must be ok.
+    std::lock_guard<std::mutex> l(_mutex);
     return _status.ok();
 }
 
@@ -252,12 +309,34 @@ StatusOr<vectorized::ChunkUniquePtr> OlapChunkSource::get_next_chunk() {
     return std::move(chunk);
 }
 
-void OlapChunkSource::cache_next_chunk_blocking() {
-    _chunk = get_next_chunk();
+void OlapChunkSource::buffer_next_batch_chunks_blocking(size_t batch_size) {
+    // Only the io thread updates _status, so it's safe to read it without lock here.
+    for (size_t i = 0; i < batch_size && _status.ok(); ++i) {
+        ChunkUniquePtr chunk(ChunkHelper::new_chunk_pooled(_prj_iter->schema(), config::vector_chunk_size, true));
+        Status status = _read_chunk_from_storage(_runtime_state, chunk.get());
+
+        std::lock_guard<std::mutex> l(_mutex);
+        if (!status.ok()) {
+            _status = status;
+            break;
+        }
+        _chunk_buffer.emplace(std::move(chunk));
+    }
+}
+
+size_t OlapChunkSource::get_buffer_size() {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _chunk_buffer.size();
 }
 
-StatusOr<vectorized::ChunkUniquePtr> OlapChunkSource::get_next_chunk_nonblocking() {
-    return std::move(_chunk);
+StatusOr<vectorized::ChunkUniquePtr> OlapChunkSource::get_next_chunk_from_buffer() {
+    std::lock_guard<std::mutex> l(_mutex);
+    if (_chunk_buffer.empty()) {
+        return _status.ok() ? Status::InternalError("The chunk buffer of the chunk source is empty") : _status;
+    }
+    ChunkUniquePtr chunk = std::move(_chunk_buffer.front());
+    _chunk_buffer.pop();
+    return std::move(chunk);
 }
 
 Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized::Chunk* chunk) {
@@ -285,10 +364,16 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized
             CurrentMemTracker::consume((int64_t)chunk->memory_usage() - old_mem_usage);
             DCHECK_CHUNK(chunk);
         }
+        if (!_row_runtime_filters.empty() && chunk->num_rows() > 0) {
+            int64_t old_mem_usage = chunk->memory_usage();
+            _eval_row_runtime_filters(chunk);
+            CurrentMemTracker::consume((int64_t)chunk->memory_usage() - old_mem_usage);
+        }
         if (!_un_push_down_conjuncts.empty()) {
             int64_t old_mem_usage = chunk->memory_usage();
             SCOPED_TIMER(_expr_filter_timer);
-            ExecNode::eval_conjuncts(_un_push_down_conjuncts, chunk);
+            // The chunk is compacted by the first operator that doesn't accept the selection.
+            ExecNode::eval_conjuncts_lazily(_un_push_down_conjuncts, chunk);
             CurrentMemTracker::consume((int64_t)chunk->memory_usage() - old_mem_usage);
             DCHECK_CHUNK(chunk);
         }
@@ -297,7 +382,10 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized
 }
 
 Status OlapChunkSource::close(RuntimeState* state) {
-    _prj_iter->close();
+    // The _prj_iter is null if the chunk source fails to prepare.
+    if (_prj_iter != nullptr) {
+        _prj_iter->close();
+    }
     _reader.reset();
     return Status::OK();
 }
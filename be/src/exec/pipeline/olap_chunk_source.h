@@ -2,13 +2,18 @@
 
 #pragma once
 
+#include <mutex>
+#include <queue>
+
 #include "exec/olap_common.h"
 #include "exec/olap_utils.h"
 #include "exec/pipeline/chunk_source.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "exprs/vectorized/runtime_filter.h"
 #include "gen_cpp/InternalService_types.h"
 #include "runtime/runtime_state.h"
+#include "runtime/vectorized/global_dict.h"
 #include "storage/vectorized/conjunctive_predicates.h"
 #include "storage/vectorized/reader.h"
 #include "storage/vectorized/reader_params.h"
@@ -17,6 +22,7 @@ namespace starrocks {
 class SlotDescriptor;
 namespace vectorized {
 class RuntimeFilterProbeCollector;
+class RuntimeFilterProbeDescriptor;
 }
 namespace pipeline {
 
@@ -24,13 +30,16 @@ class OlapChunkSource final : public ChunkSource {
 public:
     OlapChunkSource(MorselPtr&& morsel, int32_t tuple_id, const std::vector<ExprContext*>& conjunct_ctxs,
                     const vectorized::RuntimeFilterProbeCollector& runtime_filters,
-                    const std::vector<std::string>& key_column_names, bool skip_aggregation)
+                    const std::vector<std::string>& key_column_names, bool skip_aggregation,
+                    const vectorized::GlobalDicts& slot_global_dicts, RuntimeProfile* runtime_profile)
             : ChunkSource(std::move(morsel)),
               _tuple_id(tuple_id),
               _conjunct_ctxs(conjunct_ctxs),
               _runtime_filters(runtime_filters),
               _key_column_names(key_column_names),
-              _skip_aggregation(skip_aggregation) {
+              _skip_aggregation(skip_aggregation),
+              _slot_global_dicts(slot_global_dicts),
+              _runtime_profile(runtime_profile) {
         OlapMorsel* olap_morsel = (OlapMorsel*)_morsel.get();
         _scan_range = olap_morsel->get_scan_range();
     }
@@ -44,8 +53,10 @@ public:
     bool has_next_chunk() override;
 
     StatusOr<vectorized::ChunkUniquePtr> get_next_chunk() override;
-    void cache_next_chunk_blocking() override;
-    StatusOr<vectorized::ChunkUniquePtr> get_next_chunk_nonblocking() override;
+
+    void buffer_next_batch_chunks_blocking(size_t batch_size) override;
+    size_t get_buffer_size() override;
+    StatusOr<vectorized::ChunkUniquePtr> get_next_chunk_from_buffer() override;
 
 private:
     Status _get_tablet(const TInternalScanRange* scan_range);
@@ -56,6 +67,8 @@ private:
     Status _init_olap_reader(RuntimeState* state);
     Status _build_scan_range(RuntimeState* state);
     Status _read_chunk_from_storage([[maybe_unused]] RuntimeState* state, vectorized::Chunk* chunk);
+    void _init_row_runtime_filters();
+    void _eval_row_runtime_filters(vectorized::Chunk* chunk);
 
     int32_t _tuple_id;
     std::vector<ExprContext*> _conjunct_ctxs;
@@ -63,10 +76,17 @@ private:
     const vectorized::RuntimeFilterProbeCollector& _runtime_filters;
     std::vector<std::string> _key_column_names;
     bool _skip_aggregation;
+    // The global dicts of the slots read as the dict ids.
+    const vectorized::GlobalDicts& _slot_global_dicts;
+    // The profile of the scan operator.
+    RuntimeProfile* _runtime_profile;
     TInternalScanRange* _scan_range;
 
+    // It's written by the io thread and read by the pipeline driver, so it's guarded by _mutex.
     Status _status = Status::OK();
-    StatusOr<vectorized::ChunkUniquePtr> _chunk;
+    std::mutex _mutex;
+    // The chunks read by the io thread, but not taken by the pipeline driver yet.
+    std::queue<vectorized::ChunkUniquePtr> _chunk_buffer;
     // Same size with |_conjunct_ctxs|, indicate which element has been normalized.
     std::vector<bool> _normalized_conjuncts;
     // The conjuncts couldn't push down to storage engine
@@ -74,9 +94,21 @@ private:
     vectorized::ConjunctivePredicates _un_push_down_predicates;
     std::vector<uint8_t> _selection;
 
+    // The runtime filters on the slots read from the storage. The ones arrived before prepare() prune the
+    // storage by their min/max, and the ones arriving later are evaluated on the rows read of this morsel.
+    struct RowRuntimeFilter {
+        const vectorized::RuntimeFilterProbeDescriptor* desc;
+        SlotId slot_id;
+        // The evaluation context of the io thread, the one of the descriptor is shared by the drivers.
+        vectorized::JoinRuntimeFilter::RunningContext ctx;
+    };
+    std::vector<RowRuntimeFilter> _row_runtime_filters;
+
     ObjectPool _obj_pool;
     TabletSharedPtr _tablet;
     int64_t _version = 0;
+    // The global dicts of the columns read as the dict ids.
+    vectorized::GlobalDicts _global_dicts;
 
     // Constructed from params
     RuntimeState* _runtime_state = nullptr;
@@ -132,6 +164,8 @@ private:
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
+    RuntimeProfile::Counter* _runtime_filter_timer = nullptr;
+    RuntimeProfile::Counter* _runtime_filter_rows_counter = nullptr;
 };
 } // namespace pipeline
 } // namespace starrocks
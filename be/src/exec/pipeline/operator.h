@@ -47,6 +47,10 @@ public:
     // Push chunk to this operator
     virtual Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) = 0;
 
+    // Whether push_chunk works on the selected rows of a lazily filtered chunk, see Chunk::selection.
+    // The driver materializes the selection before pushing a chunk to the operators that don't.
+    virtual bool accept_selection() const { return false; }
+
     int32_t get_id() const { return _id; }
 
     int32_t get_plan_node_id() const { return _plan_node_id; }
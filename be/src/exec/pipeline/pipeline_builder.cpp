@@ -2,12 +2,76 @@
 
 #include "exec/pipeline/pipeline_builder.h"
 
+#include "common/config.h"
 #include "exec/exec_node.h"
+#include "exec/pipeline/exchange/local_exchange.h"
+#include "exec/pipeline/exchange/local_exchange_sink_operator.h"
+#include "exec/pipeline/exchange/local_exchange_source_operator.h"
+#include "gutil/casts.h"
 
 namespace starrocks::pipeline {
+
+uint32_t PipelineBuilderContext::degree_of_parallelism(const OpFactories& operators) const {
+    DCHECK(!operators.empty());
+    if (operators[0]->is_source()) {
+        return down_cast<SourceOperatorFactory*>(operators[0].get())->degree_of_parallelism();
+    }
+    return _driver_instance_count;
+}
+
+OpFactories PipelineBuilderContext::maybe_interpolate_local_passthrough_exchange(OpFactories& pred_operators) {
+    DCHECK(!pred_operators.empty() && pred_operators[0]->is_source());
+    // The pipeline only has one driver, no need to gather its output.
+    if (degree_of_parallelism(pred_operators) == 1) {
+        return pred_operators;
+    }
+
+    auto memory_manager = std::make_shared<LocalExchangeMemoryManager>(config::vector_chunk_size);
+    auto local_exchange_source =
+            std::make_shared<LocalExchangeSourceOperatorFactory>(next_operator_id(), memory_manager);
+    local_exchange_source->set_degree_of_parallelism(1);
+    auto local_exchange = std::make_shared<PassthroughExchanger>(memory_manager, local_exchange_source.get());
+    auto local_exchange_sink = std::make_shared<LocalExchangeSinkOperatorFactory>(next_operator_id(), local_exchange);
+    // Add LocalExchangeSinkOperator to predecessor pipeline.
+    pred_operators.emplace_back(std::move(local_exchange_sink));
+    // predecessor pipeline comes to end.
+    add_pipeline(pred_operators);
+
+    OpFactories operators_source_with_local_exchange;
+    // Multiple LocalChangeSinkOperators pipe into one LocalChangeSourceOperator.
+    operators_source_with_local_exchange.emplace_back(std::move(local_exchange_source));
+    return operators_source_with_local_exchange;
+}
+
+OpFactories PipelineBuilderContext::maybe_interpolate_local_shuffle_exchange(
+        OpFactories& pred_operators, const std::vector<ExprContext*>& partition_expr_ctxs) {
+    DCHECK(!pred_operators.empty() && pred_operators[0]->is_source());
+    const size_t num_partitions = _driver_instance_count;
+    // The successor pipeline only has one driver, no need to partition the output.
+    if (num_partitions <= 1) {
+        return pred_operators;
+    }
+
+    // Every source buffers a partial chunk of less than vector_chunk_size rows, so the memory manager
+    // must hold at least such rows of all the sources, otherwise the sinks may be blocked forever.
+    auto memory_manager = std::make_shared<LocalExchangeMemoryManager>(config::vector_chunk_size * num_partitions);
+    auto local_exchange_source =
+            std::make_shared<LocalExchangeSourceOperatorFactory>(next_operator_id(), memory_manager);
+    local_exchange_source->set_degree_of_parallelism(num_partitions);
+    auto local_exchange = std::make_shared<PartitionExchanger>(memory_manager, local_exchange_source.get(), true,
+                                                               partition_expr_ctxs);
+    auto local_exchange_sink = std::make_shared<LocalExchangeSinkOperatorFactory>(next_operator_id(), local_exchange);
+    pred_operators.emplace_back(std::move(local_exchange_sink));
+    add_pipeline(pred_operators);
+
+    OpFactories operators_source_with_local_exchange;
+    operators_source_with_local_exchange.emplace_back(std::move(local_exchange_source));
+    return operators_source_with_local_exchange;
+}
+
 Pipelines PipelineBuilder::build(const FragmentContext& fragment, ExecNode* exec_node) {
     pipeline::OpFactories operators = exec_node->decompose_to_pipeline(&_context);
     _context.add_pipeline(operators);
     return _context.get_pipelines();
 }
-} // namespace starrocks::pipeline
\ No newline at end of file
+} // namespace starrocks::pipeline
@@ -7,6 +7,7 @@
 
 namespace starrocks {
 class ExecNode;
+class ExprContext;
 class MemTracker;
 namespace pipeline {
 
@@ -15,10 +16,23 @@ public:
     PipelineBuilderContext(const FragmentContext& fragment_context, uint32_t driver_instance_count)
             : _fragment_context(fragment_context), _driver_instance_count(driver_instance_count) {}
 
+    // The degree of parallelism of the pipeline is decided by its source operator factory.
     void add_pipeline(const OpFactories& operators) {
-        _pipelines.emplace_back(std::make_unique<Pipeline>(next_pipe_id(), _driver_instance_count, operators));
+        _pipelines.emplace_back(
+                std::make_unique<Pipeline>(next_pipe_id(), degree_of_parallelism(operators), operators));
     }
 
+    // Append a local passthrough exchange, which gathers the output of the pipeline
+    // into a new pipeline with only one driver. It returns the operators of the new pipeline,
+    // whose source is the local exchange source operator.
+    OpFactories maybe_interpolate_local_passthrough_exchange(OpFactories& pred_operators);
+
+    // Append a local shuffle exchange, which partitions the output of the pipeline by the hash of
+    // partition_expr_ctxs into a new pipeline with driver_instance_count() drivers, so each driver
+    // of the new pipeline processes a disjoint set of partition keys.
+    OpFactories maybe_interpolate_local_shuffle_exchange(OpFactories& pred_operators,
+                                                         const std::vector<ExprContext*>& partition_expr_ctxs);
+
     uint32_t next_pipe_id() { return _next_pipeline_id++; }
 
     uint32_t next_operator_id() { return _next_operator_id++; }
@@ -29,6 +43,8 @@ public:
 
     Pipelines get_pipelines() const { return _pipelines; }
 
+    uint32_t degree_of_parallelism(const OpFactories& operators) const;
+
 private:
     const FragmentContext& _fragment_context;
     Pipelines _pipelines;
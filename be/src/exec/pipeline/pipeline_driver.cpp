@@ -7,6 +7,7 @@
 #include "exec/pipeline/source_operator.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "util/query_trace.h"
 namespace starrocks {
 namespace pipeline {
 Status PipelineDriver::prepare(RuntimeState* runtime_state) {
@@ -20,9 +21,27 @@ Status PipelineDriver::prepare(RuntimeState* runtime_state) {
     return Status::OK();
 }
 StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
+    SCOPED_QUERY_TRACE(_fragment_ctx->query_id(), "pipeline", "driver", _driver_id);
+    const int64_t start_cycles = CycleClock::Now();
+    auto state = _process(runtime_state);
+    _yield_cycles = CycleClock::Now();
+    _cpu_cycles += _yield_cycles - start_cycles;
+    return state;
+}
+
+StatusOr<DriverState> PipelineDriver::_process(RuntimeState* runtime_state) {
     _state = DriverState::RUNNING;
     size_t total_chunks_moved = 0;
     int64_t time_spent = 0;
+    // the hardware counters of this thread are read around each pull_chunk and push_chunk if they're collected
+    ThreadHardwareCounters* hw_counters = nullptr;
+    if (_pipeline_profile != nullptr && _pipeline_profile->has_hardware_counters()) {
+        hw_counters = ThreadHardwareCounters::current();
+        if (hw_counters != nullptr && _operator_hw_values.empty()) {
+            _operator_hw_values.resize(_operators.size());
+        }
+    }
+    HardwareCounterValues hw_start;
     while (true) {
         size_t num_chunk_moved = 0;
         bool should_yield = false;
@@ -57,7 +76,13 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
 
                 // pull chunk from current operator and push the chunk onto next
                 // operator
+                bool hw_started = hw_counters != nullptr && hw_counters->read(&hw_start);
+                const int64_t pull_start_cycles = CycleClock::Now();
                 auto pulled_chunk = curr_op->pull_chunk(runtime_state);
+                _operator_cycles[i] += CycleClock::Now() - pull_start_cycles;
+                if (hw_started) {
+                    _add_hardware_counters(i, hw_counters, hw_start);
+                }
                 auto status = pulled_chunk.status();
                 if (!status.ok() && !status.is_end_of_file()) {
                     LOG(WARNING) << " status " << status.to_string();
@@ -72,7 +97,16 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
                 if (status.ok()) {
                     DCHECK(pulled_chunk.value());
                     if (pulled_chunk.value() && pulled_chunk.value()->num_rows() > 0) {
+                        if (!next_op->accept_selection()) {
+                            pulled_chunk.value()->materialize_selection();
+                        }
+                        hw_started = hw_counters != nullptr && hw_counters->read(&hw_start);
+                        const int64_t push_start_cycles = CycleClock::Now();
                         next_op->push_chunk(runtime_state, std::move(pulled_chunk.value()));
+                        _operator_cycles[i + 1] += CycleClock::Now() - push_start_cycles;
+                        if (hw_started) {
+                            _add_hardware_counters(i + 1, hw_counters, hw_start);
+                        }
                     }
                     num_chunk_moved += 1;
                     total_chunks_moved += 1;
@@ -141,6 +175,7 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
         DCHECK(false);
     }
     _state = state;
+    _update_pipeline_profile();
 
     // last root driver cancel the all drivers' execution and notify FE the
     // fragment's completion but do not unregister the FragmentContext because
@@ -163,5 +198,23 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
                                                                                            true);
     }
 }
+
+void PipelineDriver::_update_pipeline_profile() {
+    if (_pipeline_profile != nullptr) {
+        _pipeline_profile->update(_cpu_cycles, _input_empty_cycles, _output_full_cycles, _schedule_delay_cycles,
+                                  _operator_cycles);
+        if (!_operator_hw_values.empty()) {
+            _pipeline_profile->update_hardware_counters(_operator_hw_values);
+        }
+    }
+}
+
+void PipelineDriver::_add_hardware_counters(size_t op_index, ThreadHardwareCounters* counters,
+                                            const HardwareCounterValues& start) {
+    HardwareCounterValues end;
+    if (counters->read(&end)) {
+        _operator_hw_values[op_index] += end - start;
+    }
+}
 } // namespace pipeline
 } // namespace starrocks
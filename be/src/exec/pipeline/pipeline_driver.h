@@ -11,6 +11,7 @@
 #include "exec/pipeline/morsel.h"
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/pipeline_fwd.h"
+#include "exec/pipeline/pipeline_profile.h"
 #include "exec/pipeline/query_context.h"
 #include "exec/pipeline/source_operator.h"
 #include "runtime/mem_tracker.h"
@@ -113,11 +114,14 @@ public:
               _is_root(is_root),
               _state(DriverState::NOT_READY),
               _yield_max_chunks_moved(config::pipeline_yield_max_chunks_moved),
-              _yield_max_time_spent(config::pipeline_yield_max_time_spent) {}
+              _yield_max_time_spent(config::pipeline_yield_max_time_spent),
+              _operator_cycles(operators.size(), 0) {}
 
     PipelineDriver(const PipelineDriver& driver)
             : PipelineDriver(driver._operators, driver._query_ctx, driver._fragment_ctx, driver._driver_id,
-                             driver._is_root) {}
+                             driver._is_root) {
+        _pipeline_profile = driver._pipeline_profile;
+    }
 
     QueryContext* query_ctx() { return _query_ctx; }
     FragmentContext* fragment_ctx() { return _fragment_ctx; }
@@ -125,6 +129,8 @@ public:
     int32_t driver_id() const { return _driver_id; }
     DriverPtr clone() { return std::make_shared<PipelineDriver>(*this); }
     void set_morsel_queue(MorselQueue* morsel_queue) { _morsel_queue = morsel_queue; }
+    // The time of the driver is added into |pipeline_profile| on finalize if it's not null.
+    void set_pipeline_profile(PipelineProfile* pipeline_profile) { _pipeline_profile = pipeline_profile; }
     Status prepare(RuntimeState* runtime_state);
     StatusOr<DriverState> process(RuntimeState* runtime_state);
     void finalize(RuntimeState* runtime_state, DriverState state);
@@ -150,7 +156,30 @@ public:
 
     bool is_root() const { return _is_root; }
 
+    // Called before the driver is put into the ready queue of the dispatcher, which ends the time blocked.
+    void mark_ready() {
+        _ready_cycles = CycleClock::Now();
+        if (_state == DriverState::INPUT_EMPTY) {
+            _input_empty_cycles += _ready_cycles - _yield_cycles;
+        } else if (_state == DriverState::OUTPUT_FULL) {
+            _output_full_cycles += _ready_cycles - _yield_cycles;
+        }
+    }
+
+    // Called after the driver is taken from the ready queue by a dispatcher thread.
+    void mark_running() {
+        if (_ready_cycles > 0) {
+            _schedule_delay_cycles += CycleClock::Now() - _ready_cycles;
+            _ready_cycles = 0;
+        }
+    }
+
 private:
+    StatusOr<DriverState> _process(RuntimeState* runtime_state);
+    void _update_pipeline_profile();
+    // Add the hardware counters since |start| into the operator |op_index|.
+    void _add_hardware_counters(size_t op_index, ThreadHardwareCounters* counters, const HardwareCounterValues& start);
+
     Operators _operators;
     size_t _first_unfinished;
     QueryContext* _query_ctx;
@@ -167,6 +196,20 @@ private:
     std::shared_ptr<MemTracker> _mem_tracker = nullptr;
     const size_t _yield_max_chunks_moved;
     const int64_t _yield_max_time_spent;
+
+    // The time in the cycles of CycleClock.
+    PipelineProfile* _pipeline_profile = nullptr;
+    std::vector<int64_t> _operator_cycles;
+    // in the order of the operators, empty if the hardware counters are not collected
+    std::vector<HardwareCounterValues> _operator_hw_values;
+    int64_t _cpu_cycles = 0;
+    int64_t _input_empty_cycles = 0;
+    int64_t _output_full_cycles = 0;
+    int64_t _schedule_delay_cycles = 0;
+    // when the driver is put into the ready queue last time, 0 if it's taken since then.
+    int64_t _ready_cycles = 0;
+    // when the driver returns from process last time.
+    int64_t _yield_cycles = 0;
 };
 
 } // namespace pipeline
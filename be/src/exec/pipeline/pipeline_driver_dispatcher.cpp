@@ -2,11 +2,48 @@
 
 #include "exec/pipeline/pipeline_driver_dispatcher.h"
 
+#include <pthread.h>
+#include <sched.h>
+
+#include "common/config.h"
+#include "gutil/walltime.h"
 #include "gutil/strings/substitute.h"
+#include "util/cpu_info.h"
 namespace starrocks {
 namespace pipeline {
+
+static DriverQueue* create_driver_queue(int32_t max_num_threads) {
+    if (config::pipeline_driver_queue_type == "work_stealing") {
+        return new WorkStealingDriverQueue(std::max(max_num_threads, 1));
+    }
+    if (config::pipeline_driver_queue_type == "mlfq") {
+        return new MultiLevelFeedbackDriverQueue();
+    }
+    if (config::pipeline_driver_queue_type != "query_shared") {
+        LOG(WARNING) << "Unknown pipeline_driver_queue_type: " << config::pipeline_driver_queue_type
+                     << ", use query_shared instead";
+    }
+    return new QuerySharedDriverQueue();
+}
+
+// Bind the current thread to the cores of the NUMA node |index| % the number of nodes.
+static void bind_to_numa_node(int index) {
+    const int num_nodes = CpuInfo::get_max_num_numa_nodes();
+    if (num_nodes <= 1) {
+        return;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int core : CpuInfo::get_cores_of_numa_node(index % num_nodes)) {
+        CPU_SET(core, &cpu_set);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+        LOG(WARNING) << "fail to bind the pipeline executor thread to the numa node " << index % num_nodes;
+    }
+}
+
 GlobalDriverDispatcher::GlobalDriverDispatcher(std::unique_ptr<ThreadPool> thread_pool)
-        : _driver_queue(new QuerySharedDriverQueue()),
+        : _driver_queue(create_driver_queue(thread_pool->max_threads())),
           _thread_pool(std::move(thread_pool)),
           _blocked_driver_poller(new PipelineDriverPoller(_driver_queue.get())),
           _exec_state_reporter(new ExecStateReporter()) {}
@@ -30,6 +67,9 @@ void GlobalDriverDispatcher::change_num_threads(int32_t num_threads) {
 }
 
 void GlobalDriverDispatcher::run() {
+    if (config::enable_pipeline_numa_affinity) {
+        bind_to_numa_node(_next_numa_node_index.fetch_add(1));
+    }
     while (true) {
         if (_num_threads_setter.should_shrink()) {
             break;
@@ -38,6 +78,7 @@ void GlobalDriverDispatcher::run() {
         size_t queue_index;
         auto driver = this->_driver_queue->take(&queue_index);
         DCHECK(driver != nullptr);
+        driver->mark_running();
         auto* fragment_ctx = driver->fragment_ctx();
         auto* runtime_state = fragment_ctx->runtime_state();
 
@@ -52,8 +93,14 @@ void GlobalDriverDispatcher::run() {
             continue;
         }
 
+        int64_t start_cpu_time_us = GetThreadCpuTimeMicros();
         auto status = driver->process(runtime_state);
         this->_driver_queue->get_sub_queue(queue_index)->update_accu_time(driver);
+        // Charge the CPU time to the query before the driver is finalized, which may release the query context.
+        driver->query_ctx()->incr_cpu_cost((GetThreadCpuTimeMicros() - start_cpu_time_us) * 1000);
+        // The driver may have changed the state of the operators shared with other blocked drivers,
+        // e.g. pushed chunks into local exchangers, or finished the build side of a hash join.
+        _blocked_driver_poller->notify();
 
         if (!status.ok()) {
             VLOG_ROW << "[Driver] Process error: error=" << status.status().to_string();
@@ -72,6 +119,7 @@ void GlobalDriverDispatcher::run() {
         case RUNNING: {
             VLOG_ROW << strings::Substitute("[Driver] Push back again, source=$0, state=$1",
                                             driver->source_operator()->get_name(), ds_to_string(driver_state));
+            driver->mark_ready();
             this->_driver_queue->put_back(driver);
             break;
         }
@@ -99,9 +147,14 @@ void GlobalDriverDispatcher::run() {
 }
 
 void GlobalDriverDispatcher::dispatch(DriverPtr driver) {
+    driver->mark_ready();
     this->_driver_queue->put_back(driver);
 }
 
+void GlobalDriverDispatcher::notify_blocked_drivers() {
+    _blocked_driver_poller->notify();
+}
+
 void GlobalDriverDispatcher::report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done,
                                                bool clean) {
     this->_exec_state_reporter->submit(fragment_ctx, status, done, clean);
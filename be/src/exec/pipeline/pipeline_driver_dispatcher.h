@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 
@@ -28,6 +29,9 @@ public:
     virtual void initialize(int32_t num_threads) {}
     virtual void change_num_threads(int32_t num_threads) {}
     virtual void dispatch(DriverPtr driver){};
+    // Notify that the blocked drivers may become ready, it's thread-safe and cheap, so it can be
+    // called by exchange receivers, io threads and rpc callbacks when their state changes.
+    virtual void notify_blocked_drivers() {}
 
     // When all the root drivers (the drivers have no successors in the same fragment) have finished,
     // just notify FE timely the completeness of fragment via invocation of report_exec_state, but
@@ -49,6 +53,7 @@ public:
     void initialize(int32_t num_threads) override;
     void change_num_threads(int32_t num_threads) override;
     void dispatch(DriverPtr driver) override;
+    void notify_blocked_drivers() override;
     void report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done, bool clean) override;
 
 private:
@@ -60,6 +65,8 @@ private:
     std::unique_ptr<ThreadPool> _thread_pool;
     PipelineDriverPollerPtr _blocked_driver_poller;
     std::unique_ptr<ExecStateReporter> _exec_state_reporter;
+    // the executor threads are bound to the NUMA nodes round robin
+    std::atomic<int> _next_numa_node_index = 0;
 };
 
 } // namespace pipeline
@@ -2,9 +2,9 @@
 
 #include "pipeline_driver_poller.h"
 
-#include <emmintrin.h>
-
 #include <chrono>
+
+#include "common/config.h"
 namespace starrocks {
 namespace pipeline {
 
@@ -21,6 +21,10 @@ void PipelineDriverPoller::start() {
 }
 void PipelineDriverPoller::shutdown() {
     this->_is_shutdown.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_cond.notify_one();
+    }
     this->_polling_thread->join();
 }
 
@@ -28,14 +32,13 @@ void PipelineDriverPoller::run_internal() {
     this->_polling_thread = Thread::current_thread();
     this->_is_polling_thread_initialized.store(true, std::memory_order_release);
     typeof(this->_blocked_drivers) local_blocked_drivers;
-    int spin_count = 0;
     while (!_is_shutdown.load(std::memory_order_acquire)) {
         {
             std::unique_lock<std::mutex> lock(this->_mutex);
             local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
             if (local_blocked_drivers.empty() && _blocked_drivers.empty()) {
                 _cond.wait(lock, [this]() {
-                    return !this->_is_shutdown.load(std::memory_order_acquire) && !this->_blocked_drivers.empty();
+                    return this->_is_shutdown.load(std::memory_order_acquire) || !this->_blocked_drivers.empty();
                 });
                 if (_is_shutdown.load(std::memory_order_acquire)) {
                     break;
@@ -43,6 +46,8 @@ void PipelineDriverPoller::run_internal() {
                 local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
             }
         }
+        // The notifications after this point trigger another round of checking.
+        int64_t num_events = _num_events.load();
         size_t previous_num_blocked_drivers = local_blocked_drivers.size();
         auto driver_it = local_blocked_drivers.begin();
         while (driver_it != local_blocked_drivers.end()) {
@@ -55,33 +60,44 @@ void PipelineDriverPoller::run_internal() {
             // FragmentContext since FragmentContext is unregistered prematurely.
             if (driver->pending_finish() && !driver->source_operator()->pending_finish()) {
                 driver->set_driver_state(DriverState::FINISH);
+                driver->mark_ready();
                 _dispatch_queue->put_back(*driver_it);
                 local_blocked_drivers.erase(driver_it++);
             } else if (driver->is_finished()) {
                 local_blocked_drivers.erase(driver_it++);
             } else if (driver->fragment_ctx()->is_canceled() || driver->is_not_blocked()) {
+                driver->mark_ready();
                 _dispatch_queue->put_back(*driver_it);
                 local_blocked_drivers.erase(driver_it++);
             } else {
                 ++driver_it;
             }
         }
-        size_t curr_num_blocked_drivers = local_blocked_drivers.size();
-        if (curr_num_blocked_drivers == previous_num_blocked_drivers) {
-            spin_count += 1;
-        } else {
-            spin_count = 0;
-        }
-        if (spin_count != 0 && spin_count % 64 == 0) {
-            _mm_pause();
-        }
-        if (spin_count != 0 && spin_count == 640) {
-            spin_count = 0;
-            sched_yield();
+        // No driver becomes ready in this round, so wait until the poller is notified or new blocked
+        // drivers are added. The wait is bounded, because not all the sources of readiness notify the
+        // poller, e.g. the cancellation of a fragment.
+        if (local_blocked_drivers.size() == previous_num_blocked_drivers) {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            _is_waiting.store(true);
+            _cond.wait_for(lock, std::chrono::microseconds(config::pipeline_poller_max_wait_us), [&]() {
+                return this->_is_shutdown.load(std::memory_order_acquire) || !this->_blocked_drivers.empty() ||
+                       this->_num_events.load() != num_events;
+            });
+            _is_waiting.store(false);
         }
     }
 }
 
+void PipelineDriverPoller::notify() {
+    // Pairs with run_internal(), either the poller sees the new event before it waits,
+    // or it's waiting and is woken up here.
+    _num_events.fetch_add(1);
+    if (_is_waiting.load()) {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_cond.notify_one();
+    }
+}
+
 void PipelineDriverPoller::add_blocked_driver(DriverPtr driver) {
     std::unique_lock<std::mutex> lock(this->_mutex);
     this->_blocked_drivers.push_back(driver);
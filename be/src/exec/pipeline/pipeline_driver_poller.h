@@ -31,6 +31,10 @@ public:
     void shutdown();
     // add blocked driver to poller
     void add_blocked_driver(DriverPtr driver);
+    // Notify the poller that some blocked drivers may become ready, e.g. chunks arrive at an exchange
+    // receiver, or an io task completes. The poller re-checks the blocked drivers only when it's notified,
+    // or at least every pipeline_poller_max_wait_us, instead of spinning on them.
+    void notify();
 
 private:
     void run_internal();
@@ -45,6 +49,9 @@ private:
     Thread* _polling_thread;
     std::atomic<bool> _is_polling_thread_initialized;
     std::atomic<bool> _is_shutdown;
+    // The number of notifications, and whether the poller thread is waiting for them.
+    std::atomic<int64_t> _num_events = 0;
+    std::atomic<bool> _is_waiting = false;
 };
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
@@ -2,7 +2,11 @@
 
 #include "exec/pipeline/pipeline_driver_queue.h"
 
+#include <random>
+#include <thread>
+
 #include "gutil/strings/substitute.h"
+#include "util/cpu_info.h"
 namespace starrocks {
 namespace pipeline {
 void QuerySharedDriverQueue::put_back(const DriverPtr& driver) {
@@ -60,5 +64,191 @@ SubQuerySharedDriverQueue* QuerySharedDriverQueue::get_sub_queue(size_t index) {
     return _queues + index;
 }
 
+MultiLevelFeedbackDriverQueue::MultiLevelFeedbackDriverQueue() {
+    double factor = 1;
+    for (int i = QUEUE_SIZE - 1; i >= 0; --i) {
+        _queues[i].factor_for_normal = factor;
+        factor *= RATIO_OF_ADJACENT_QUEUE;
+    }
+}
+
+size_t MultiLevelFeedbackDriverQueue::_compute_level(const DriverPtr& driver) {
+    auto* query_ctx = driver->query_ctx();
+    int64_t cpu_cost_ns = query_ctx != nullptr ? query_ctx->cpu_cost_ns() : 0;
+    size_t level = Bits::Log2Floor64(cpu_cost_ns / LEVEL_TIME_SLICE_NS + 1);
+    return std::min(level, QUEUE_SIZE - 1);
+}
+
+void MultiLevelFeedbackDriverQueue::put_back(const DriverPtr& driver) {
+    size_t level = _compute_level(driver);
+    std::lock_guard<std::mutex> lock(_global_mutex);
+    _queues[level].queue.emplace(driver);
+    if (_is_empty) {
+        _is_empty = false;
+        _cv.notify_one();
+    }
+}
+
+DriverPtr MultiLevelFeedbackDriverQueue::take(size_t* queue_index) {
+    std::unique_lock<std::mutex> lock(_global_mutex);
+    int queue_idx = -1;
+    while (true) {
+        double target_accu_time = 0;
+        for (int i = 0; i < QUEUE_SIZE; ++i) {
+            if (!_queues[i].queue.empty()) {
+                double local_target_time = _queues[i].accu_time_after_divisor();
+                if (queue_idx < 0 || local_target_time < target_accu_time) {
+                    target_accu_time = local_target_time;
+                    queue_idx = i;
+                }
+            }
+        }
+        if (queue_idx >= 0) {
+            break;
+        }
+        _is_empty = true;
+        _cv.wait(lock);
+    }
+
+    *queue_index = queue_idx;
+    DriverPtr driver = std::move(_queues[queue_idx].queue.front());
+    _queues[queue_idx].queue.pop();
+    return driver;
+}
+
+// The local queue bound to current executor thread, a thread is bound to at most one queue.
+static thread_local const WorkStealingDriverQueue* tls_bound_queue = nullptr;
+static thread_local int tls_local_queue_index = -1;
+
+WorkStealingDriverQueue::WorkStealingDriverQueue(size_t num_workers) {
+    DCHECK_GT(num_workers, 0);
+    _local_queues.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        _local_queues.emplace_back(std::make_unique<LocalQueue>());
+    }
+    _accu_queue.factor_for_normal = 1;
+}
+
+int WorkStealingDriverQueue::_local_queue_index() const {
+    return tls_bound_queue == this ? tls_local_queue_index : -1;
+}
+
+int WorkStealingDriverQueue::_bind_local_queue() {
+    int index = _local_queue_index();
+    if (index < 0) {
+        // The executor threads exceeding the number of local queues share the local queues.
+        index = _next_local_queue_index.fetch_add(1) % _local_queues.size();
+        tls_bound_queue = this;
+        tls_local_queue_index = index;
+        if (CpuInfo::get_max_num_numa_nodes() > 1) {
+            _local_queues[index]->numa_node = CpuInfo::get_numa_node_of_core(CpuInfo::get_current_core());
+        }
+    }
+    return index;
+}
+
+void WorkStealingDriverQueue::put_back(const DriverPtr& driver) {
+    int index = _local_queue_index();
+    if (index >= 0) {
+        auto& local_queue = _local_queues[index];
+        std::lock_guard<std::mutex> lock(local_queue->mutex);
+        local_queue->drivers.emplace_back(driver);
+    } else {
+        std::lock_guard<std::mutex> lock(_injection_mutex);
+        _injection_queue.emplace_back(driver);
+    }
+
+    // _num_drivers must be increased before _num_waiting_threads is read, which pairs with take(),
+    // so either the waiting thread sees the new driver or it is notified here.
+    _num_drivers.fetch_add(1);
+    if (_num_waiting_threads.load() > 0) {
+        std::lock_guard<std::mutex> lock(_wait_mutex);
+        _cv.notify_one();
+    }
+}
+
+DriverPtr WorkStealingDriverQueue::_pop_local(size_t index) {
+    auto& local_queue = _local_queues[index];
+    std::lock_guard<std::mutex> lock(local_queue->mutex);
+    if (local_queue->drivers.empty()) {
+        return nullptr;
+    }
+    auto driver = std::move(local_queue->drivers.front());
+    local_queue->drivers.pop_front();
+    return driver;
+}
+
+DriverPtr WorkStealingDriverQueue::_pop_injection() {
+    std::lock_guard<std::mutex> lock(_injection_mutex);
+    if (_injection_queue.empty()) {
+        return nullptr;
+    }
+    auto driver = std::move(_injection_queue.front());
+    _injection_queue.pop_front();
+    return driver;
+}
+
+DriverPtr WorkStealingDriverQueue::_steal(size_t index) {
+    const size_t num_queues = _local_queues.size();
+    if (num_queues <= 1) {
+        return nullptr;
+    }
+    static thread_local std::minstd_rand rand_engine(std::random_device{}());
+    const size_t start = rand_engine() % num_queues;
+    const int numa_node = _local_queues[index]->numa_node.load(std::memory_order_relaxed);
+    // the victims on the same node in the first round, and the others in the second
+    for (size_t i = 0; i < 2 * num_queues; ++i) {
+        size_t victim = (start + i) % num_queues;
+        bool same_node = _local_queues[victim]->numa_node.load(std::memory_order_relaxed) == numa_node;
+        if (victim == index || same_node != (i < num_queues)) {
+            continue;
+        }
+        auto& local_queue = _local_queues[victim];
+        // Skip the victim being operated by others rather than waiting for it.
+        std::unique_lock<std::mutex> lock(local_queue->mutex, std::try_to_lock);
+        if (!lock.owns_lock() || local_queue->drivers.empty()) {
+            continue;
+        }
+        auto driver = std::move(local_queue->drivers.back());
+        local_queue->drivers.pop_back();
+        return driver;
+    }
+    return nullptr;
+}
+
+DriverPtr WorkStealingDriverQueue::_try_take(size_t index) {
+    DriverPtr driver = _pop_local(index);
+    if (driver == nullptr) {
+        driver = _pop_injection();
+    }
+    if (driver == nullptr) {
+        driver = _steal(index);
+    }
+    if (driver != nullptr) {
+        _num_drivers.fetch_sub(1);
+    }
+    return driver;
+}
+
+DriverPtr WorkStealingDriverQueue::take(size_t* queue_index) {
+    const size_t index = _bind_local_queue();
+    *queue_index = 0;
+    while (true) {
+        if (auto driver = _try_take(index); driver != nullptr) {
+            return driver;
+        }
+
+        // The drivers may be in the victims skipped by _steal(), just retry if _num_drivers is positive.
+        if (_num_drivers.load() > 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_wait_mutex);
+        _num_waiting_threads.fetch_add(1);
+        _cv.wait(lock, [this]() { return _num_drivers.load() > 0; });
+        _num_waiting_threads.fetch_sub(1);
+    }
+}
+
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
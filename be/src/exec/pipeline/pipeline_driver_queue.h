@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <queue>
 
 #include "exec/pipeline/pipeline_driver.h"
@@ -54,7 +56,7 @@ public:
     static const size_t QUEUE_SIZE = 8;
     // maybe other value for ratio.
     static constexpr double RATIO_OF_ADJACENT_QUEUE = 1.7;
-    void put_back(const DriverPtr& driver);
+    void put_back(const DriverPtr& driver) override;
     DriverPtr take(size_t* queue_index) override;
     SubQuerySharedDriverQueue* get_sub_queue(size_t) override;
 
@@ -65,5 +67,90 @@ private:
     std::atomic<bool> _is_empty;
 };
 
+// MultiLevelFeedbackDriverQueue schedules drivers by the CPU time consumed by their queries rather than
+// by the schedule times of each driver. All the drivers of a query are put into the same level, which is
+// lowered as the accumulated CPU time of the query grows, so the short queries stay in the high priority
+// levels and are not starved by the long running queries. As QuerySharedDriverQueue, a level is chosen by
+// the execution time it has consumed normalized by its factor, so the low priority levels still progress.
+class MultiLevelFeedbackDriverQueue : public FactoryMethod<DriverQueue, MultiLevelFeedbackDriverQueue> {
+    friend class FactoryMethod<DriverQueue, MultiLevelFeedbackDriverQueue>;
+
+public:
+    MultiLevelFeedbackDriverQueue();
+    ~MultiLevelFeedbackDriverQueue() override {}
+
+    static const size_t QUEUE_SIZE = 8;
+    static constexpr double RATIO_OF_ADJACENT_QUEUE = 1.7;
+    // A query of level i has consumed at least LEVEL_TIME_SLICE_NS * (2^i - 1) CPU time.
+    static constexpr int64_t LEVEL_TIME_SLICE_NS = 100'000'000L;
+
+    void put_back(const DriverPtr& driver) override;
+    DriverPtr take(size_t* queue_index) override;
+    SubQuerySharedDriverQueue* get_sub_queue(size_t index) override { return _queues + index; }
+
+private:
+    static size_t _compute_level(const DriverPtr& driver);
+
+    SubQuerySharedDriverQueue _queues[QUEUE_SIZE];
+    std::mutex _global_mutex;
+    std::condition_variable _cv;
+    bool _is_empty = true;
+};
+
+// WorkStealingDriverQueue avoids the contention of one global lock taken by all the executor threads.
+// Every executor thread owns a local queue, the drivers put back by an executor thread go to its own
+// local queue, and the drivers from other threads (dispatch of new drivers and the poller) go to the
+// global injection queue. An executor thread takes drivers from its local queue first, then from the
+// injection queue, and at last steals from the local queues of the other threads chosen randomly.
+// Executor threads are bound to local queues lazily at their first take(). The level of drivers is
+// not considered, all the drivers are scheduled in FIFO order.
+class WorkStealingDriverQueue : public FactoryMethod<DriverQueue, WorkStealingDriverQueue> {
+    friend class FactoryMethod<DriverQueue, WorkStealingDriverQueue>;
+
+public:
+    explicit WorkStealingDriverQueue(size_t num_workers);
+    ~WorkStealingDriverQueue() override {}
+
+    void put_back(const DriverPtr& driver) override;
+    DriverPtr take(size_t* queue_index) override;
+    // There is only one sub queue to accumulate the execution time of drivers.
+    SubQuerySharedDriverQueue* get_sub_queue(size_t) override { return &_accu_queue; }
+
+private:
+    struct LocalQueue {
+        std::mutex mutex;
+        std::deque<DriverPtr> drivers;
+        // the NUMA node of the thread bound to this queue
+        std::atomic<int> numa_node = 0;
+    };
+
+    // Return the index of local queue bound to current thread, or -1 if current thread is not an
+    // executor thread of this queue.
+    int _local_queue_index() const;
+    int _bind_local_queue();
+
+    // Pop from the front of the local queue of current thread.
+    DriverPtr _pop_local(size_t index);
+    DriverPtr _pop_injection();
+    // Steal from the back of local queues of other threads, starting from a random victim. The victims on the
+    // same NUMA node as current thread are tried first.
+    DriverPtr _steal(size_t index);
+    DriverPtr _try_take(size_t index);
+
+    std::vector<std::unique_ptr<LocalQueue>> _local_queues;
+    std::atomic<size_t> _next_local_queue_index = 0;
+
+    std::mutex _injection_mutex;
+    std::deque<DriverPtr> _injection_queue;
+
+    // The number of drivers in all the queues, and the number of threads waiting for drivers.
+    std::atomic<int64_t> _num_drivers = 0;
+    std::atomic<int64_t> _num_waiting_threads = 0;
+    std::mutex _wait_mutex;
+    std::condition_variable _cv;
+
+    SubQuerySharedDriverQueue _accu_queue;
+};
+
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/pipeline_profile.h"
+
+#include "common/config.h"
+#include "gutil/sysinfo.h"
+
+namespace starrocks::pipeline {
+
+int64_t cycles_to_ns(int64_t cycles) {
+    static const double ns_per_cycle = 1e9 / base::CyclesPerSecond();
+    return static_cast<int64_t>(cycles * ns_per_cycle);
+}
+
+PipelineProfile::PipelineProfile(RuntimeProfile* parent, uint32_t pipeline_id, const Operators& operators) {
+    auto* profile = parent->create_child("Pipeline (id=" + std::to_string(pipeline_id) + ")", true, false);
+    _driver_cpu_timer = ADD_TIMER(profile, "DriverCpuTime");
+    _input_empty_timer = ADD_TIMER(profile, "DriverInputEmptyTime");
+    _output_full_timer = ADD_TIMER(profile, "DriverOutputFullTime");
+    _schedule_delay_timer = ADD_TIMER(profile, "ScheduleDelayTime");
+    _operator_cpu_timers.reserve(operators.size());
+    for (const auto& op : operators) {
+        auto* op_profile = profile->create_child(op->get_name(), true, false);
+        _operator_cpu_timers.emplace_back(ADD_TIMER(op_profile, "CpuTime"));
+        if (config::enable_pipeline_hardware_counters) {
+            OperatorHardwareCounters counters;
+            counters.cycles = ADD_COUNTER(op_profile, "HwCycles", TUnit::UNIT);
+            counters.instructions = ADD_COUNTER(op_profile, "HwInstructions", TUnit::UNIT);
+            counters.llc_misses = ADD_COUNTER(op_profile, "HwLLCMisses", TUnit::UNIT);
+            counters.branch_misses = ADD_COUNTER(op_profile, "HwBranchMisses", TUnit::UNIT);
+            counters.ipc = ADD_COUNTER(op_profile, "IPC", TUnit::DOUBLE_VALUE);
+            counters.llc_mpki = ADD_COUNTER(op_profile, "LLCMissesPerKiloInstructions", TUnit::DOUBLE_VALUE);
+            counters.branch_mpki = ADD_COUNTER(op_profile, "BranchMissesPerKiloInstructions", TUnit::DOUBLE_VALUE);
+            _operator_hw_counters.emplace_back(counters);
+        }
+    }
+}
+
+void PipelineProfile::update(int64_t cpu_cycles, int64_t input_empty_cycles, int64_t output_full_cycles,
+                             int64_t schedule_delay_cycles, const std::vector<int64_t>& operator_cycles) {
+    COUNTER_UPDATE(_driver_cpu_timer, cycles_to_ns(cpu_cycles));
+    COUNTER_UPDATE(_input_empty_timer, cycles_to_ns(input_empty_cycles));
+    COUNTER_UPDATE(_output_full_timer, cycles_to_ns(output_full_cycles));
+    COUNTER_UPDATE(_schedule_delay_timer, cycles_to_ns(schedule_delay_cycles));
+    DCHECK_EQ(operator_cycles.size(), _operator_cpu_timers.size());
+    for (size_t i = 0; i < operator_cycles.size() && i < _operator_cpu_timers.size(); ++i) {
+        COUNTER_UPDATE(_operator_cpu_timers[i], cycles_to_ns(operator_cycles[i]));
+    }
+}
+
+void PipelineProfile::update_hardware_counters(const std::vector<HardwareCounterValues>& operator_values) {
+    std::lock_guard<std::mutex> l(_hw_lock);
+    for (size_t i = 0; i < operator_values.size() && i < _operator_hw_counters.size(); ++i) {
+        const auto& values = operator_values[i];
+        auto& counters = _operator_hw_counters[i];
+        COUNTER_UPDATE(counters.cycles, values.cycles);
+        COUNTER_UPDATE(counters.instructions, values.instructions);
+        COUNTER_UPDATE(counters.llc_misses, values.llc_misses);
+        COUNTER_UPDATE(counters.branch_misses, values.branch_misses);
+        double cycles = counters.cycles->value();
+        double kilo_instructions = counters.instructions->value() / 1000.0;
+        if (cycles > 0) {
+            counters.ipc->set(counters.instructions->value() / cycles);
+        }
+        if (kilo_instructions > 0) {
+            counters.llc_mpki->set(counters.llc_misses->value() / kilo_instructions);
+            counters.branch_mpki->set(counters.branch_misses->value() / kilo_instructions);
+        }
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,70 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "exec/pipeline/operator.h"
+#include "gutil/walltime.h"
+#include "util/hardware_counters.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::pipeline {
+
+// The drivers count the time in the cycles of CycleClock, which are cheap enough to be read around each
+// push_chunk and pull_chunk unlike the clock of MonotonicStopWatch, and convert them to nanoseconds once
+// they finish.
+int64_t cycles_to_ns(int64_t cycles);
+
+// The time spent by the drivers of a pipeline, each driver adds its time into the counters when it's
+// finalized.
+//
+// Pipeline (id=<id>)
+//   - DriverCpuTime: the time of the drivers running on the dispatcher threads
+//   - DriverInputEmptyTime: the time of the drivers blocked because the source has no output
+//   - DriverOutputFullTime: the time of the drivers blocked because the sink needs no input
+//   - ScheduleDelayTime: the time of the drivers ready but waiting in the queue of the dispatcher
+//   <operator name>
+//     - CpuTime: the time of push_chunk and pull_chunk of the operator
+//     - HwCycles, HwInstructions, HwLLCMisses, HwBranchMisses: the hardware counters of push_chunk and pull_chunk,
+//       if enable_pipeline_hardware_counters is on when the profile is created
+//     - IPC: the instructions per cycle, a low one with many LLC misses tells a memory-bound operator
+//     - LLCMissesPerKiloInstructions, BranchMissesPerKiloInstructions
+class PipelineProfile {
+public:
+    // |operators| are the operators of a driver of the pipeline, which have the same names in all the drivers.
+    PipelineProfile(RuntimeProfile* parent, uint32_t pipeline_id, const Operators& operators);
+
+    // Add the time of a driver in cycles, |operator_cycles| are in the order of the operators.
+    void update(int64_t cpu_cycles, int64_t input_empty_cycles, int64_t output_full_cycles,
+                int64_t schedule_delay_cycles, const std::vector<int64_t>& operator_cycles);
+
+    bool has_hardware_counters() const { return !_operator_hw_counters.empty(); }
+
+    // Add the hardware counters of the operators of a driver, in the order of the operators.
+    void update_hardware_counters(const std::vector<HardwareCounterValues>& operator_values);
+
+private:
+    RuntimeProfile::Counter* _driver_cpu_timer = nullptr;
+    RuntimeProfile::Counter* _input_empty_timer = nullptr;
+    RuntimeProfile::Counter* _output_full_timer = nullptr;
+    RuntimeProfile::Counter* _schedule_delay_timer = nullptr;
+    std::vector<RuntimeProfile::Counter*> _operator_cpu_timers;
+
+    struct OperatorHardwareCounters {
+        RuntimeProfile::Counter* cycles = nullptr;
+        RuntimeProfile::Counter* instructions = nullptr;
+        RuntimeProfile::Counter* llc_misses = nullptr;
+        RuntimeProfile::Counter* branch_misses = nullptr;
+        RuntimeProfile::Counter* ipc = nullptr;
+        RuntimeProfile::Counter* llc_mpki = nullptr;
+        RuntimeProfile::Counter* branch_mpki = nullptr;
+    };
+    // _hw_lock keeps the derived counters consistent with the sums updated by the drivers.
+    std::mutex _hw_lock;
+    std::vector<OperatorHardwareCounters> _operator_hw_counters;
+};
+
+} // namespace starrocks::pipeline
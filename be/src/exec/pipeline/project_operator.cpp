@@ -69,6 +69,10 @@ Status ProjectOperator::push_chunk(RuntimeState* state, const vectorized::ChunkP
     for (size_t i = 0; i < result_columns.size(); ++i) {
         _cur_chunk->append_column(result_columns[i], _column_ids[i]);
     }
+    // Only the projected columns are compacted when the selection is materialized.
+    if (chunk->has_selection()) {
+        _cur_chunk->set_selection(chunk->selection());
+    }
     DCHECK_CHUNK(_cur_chunk);
     return Status::OK();
 }
@@ -38,6 +38,8 @@ public:
 
     Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
 
+    bool accept_selection() const override { return true; }
+
 private:
     const std::vector<int32_t>& _column_ids;
     const std::vector<ExprContext*>& _expr_ctxs;
@@ -30,6 +30,11 @@ public:
     }
     bool count_down_fragment() { return _num_fragments.fetch_sub(1) == 1; }
 
+    // The CPU time consumed by all the drivers of this query in this BE, in nanoseconds.
+    // It's charged by the driver dispatcher after each execution of a driver.
+    void incr_cpu_cost(int64_t cpu_cost_ns) { _cpu_cost_ns.fetch_add(cpu_cost_ns, std::memory_order_relaxed); }
+    int64_t cpu_cost_ns() const { return _cpu_cost_ns.load(std::memory_order_relaxed); }
+
 private:
     std::unique_ptr<RuntimeState> _runtime_state;
     std::shared_ptr<RuntimeProfile> _runtime_profile;
@@ -38,6 +43,7 @@ private:
     TUniqueId _query_id;
     std::atomic<bool> _num_fragments_initialized;
     std::atomic<size_t> _num_fragments;
+    std::atomic<int64_t> _cpu_cost_ns = 0;
 };
 
 class QueryContextManager {
@@ -2,7 +2,10 @@
 
 #include "exec/pipeline/result_sink_operator.h"
 
+#include <limits>
+
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exprs/expr.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/exec_env.h"
@@ -23,7 +26,9 @@ Status ResultSinkOperator::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Expr::prepare(_output_expr_ctxs, state, row_desc, get_memtracker()));
 
     // Create sender
-    RETURN_IF_ERROR(state->exec_env()->result_mgr()->create_sender(state->fragment_instance_id(), 1024, &_sender));
+    // The buffer of the sender is limited by config::result_buffer_max_bytes rather than rows.
+    RETURN_IF_ERROR(state->exec_env()->result_mgr()->create_sender(state->fragment_instance_id(),
+                                                                   std::numeric_limits<int32_t>::max(), &_sender));
 
     // Create writer based on sink type
     switch (_sink_type) {
@@ -72,29 +77,51 @@ bool ResultSinkOperator::need_input() {
     if (!_fetch_data_result) {
         return true;
     }
+    if (!_is_finished && _fetch_data_bytes < config::result_batch_target_bytes && !_sender->has_waiting_rpc()) {
+        return true;
+    }
+    return _try_add_batch();
+}
+
+bool ResultSinkOperator::_try_add_batch() {
     auto* mysql_writer = down_cast<MysqlResultWriter*>(_writer.get());
     auto status = mysql_writer->try_add_batch(_fetch_data_result);
-    if (status.ok()) {
-        return status.value();
-    } else {
+    if (!status.ok()) {
         _last_error = status.status();
+        _fetch_data_bytes = 0;
         return true;
     }
+    if (status.value()) {
+        _fetch_data_bytes = 0;
+    }
+    return status.value();
 }
 
 Status ResultSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
     if (!_last_error.ok()) {
         return _last_error;
     }
-    DCHECK(!_fetch_data_result);
     auto* mysql_writer = down_cast<MysqlResultWriter*>(_writer.get());
     auto status = mysql_writer->process_chunk(chunk.get());
-    if (status.ok()) {
-        _fetch_data_result = std::move(status.value());
-        return mysql_writer->try_add_batch(_fetch_data_result).status();
-    } else {
+    if (!status.ok()) {
         return status.status();
     }
+    TFetchDataResultPtr result = std::move(status.value());
+    auto& rows = result->result_batch.rows;
+    for (const auto& row : rows) {
+        _fetch_data_bytes += row.size();
+    }
+    if (!_fetch_data_result) {
+        _fetch_data_result = std::move(result);
+    } else {
+        auto& pending_rows = _fetch_data_result->result_batch.rows;
+        pending_rows.insert(pending_rows.end(), std::make_move_iterator(rows.begin()),
+                            std::make_move_iterator(rows.end()));
+    }
+    if (_fetch_data_bytes >= config::result_batch_target_bytes || _sender->has_waiting_rpc()) {
+        _try_add_batch();
+    }
+    return _last_error;
 }
 
 } // namespace starrocks::pipeline
@@ -38,6 +38,9 @@ public:
     Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
 
 private:
+    // Add the pending batch to the sender, false if the sender is full.
+    bool _try_add_batch();
+
     TResultSinkType::type _sink_type;
     const std::vector<TExpr>& _t_output_expr;
 
@@ -45,7 +48,10 @@ private:
     std::shared_ptr<BufferControlBlock> _sender;
     std::shared_ptr<ResultWriter> _writer;
     std::unique_ptr<RuntimeProfile> _profile = nullptr;
+    // The rows of the small chunks are coalesced into it until config::result_batch_target_bytes, it's added to
+    // the sender at once only if a fetch is waiting or the input is finished.
     mutable TFetchDataResultPtr _fetch_data_result;
+    int64_t _fetch_data_bytes = 0;
     mutable Status _last_error;
     bool _is_finished = false;
 };
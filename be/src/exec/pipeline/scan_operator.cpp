@@ -3,12 +3,14 @@
 #include "exec/pipeline/scan_operator.h"
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exec/pipeline/olap_chunk_source.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "util/time.h"
 
 namespace starrocks::pipeline {
-void ScanOperator::_pickup_morsel(RuntimeState* state) {
+Status ScanOperator::_pickup_morsel(RuntimeState* state) {
     DCHECK(_morsel_queue != nullptr);
     if (_chunk_source) {
         _chunk_source->close(state);
@@ -18,39 +20,64 @@ void ScanOperator::_pickup_morsel(RuntimeState* state) {
         // release _chunk_source before _curr_morsel, because _chunk_source depends on _curr_morsel.
         _chunk_source = nullptr;
         _is_finished = true;
-    } else {
-        auto morsel = std::move(maybe_morsel.value());
-        DCHECK(morsel);
-        _chunk_source = starrocks::make_exclusive<OlapChunkSource>(
-                std::move(morsel), _olap_scan_node.tuple_id, _conjunct_ctxs, _runtime_filters,
-                _olap_scan_node.key_column_name, _olap_scan_node.is_preaggregation);
-        _chunk_source->prepare(state);
-        _trigger_read_chunk();
+        return Status::OK();
     }
-}
-void ScanOperator::_trigger_read_chunk() {
+
+    auto morsel = std::move(maybe_morsel.value());
+    DCHECK(morsel);
+    _chunk_source = starrocks::make_exclusive<OlapChunkSource>(
+            std::move(morsel), _olap_scan_node.tuple_id, _conjunct_ctxs, _runtime_filters,
+            _olap_scan_node.key_column_name, _olap_scan_node.is_preaggregation, _global_dicts,
+            _runtime_profile.get());
     if (_io_threads == nullptr) {
-        return;
+        return _chunk_source->prepare(state);
     }
-    DCHECK(!_pending_chunk_source_future.has_value());
-    // no io task is pending, so create a pending io task.
+    _is_chunk_source_prepared = false;
+    _trigger_next_scan(state);
+    return Status::OK();
+}
+
+void ScanOperator::_trigger_next_scan(RuntimeState* state) {
+    DCHECK(_io_threads != nullptr);
     DCHECK(_chunk_source);
-    auto chunk_source = _chunk_source;
-    auto chunk_source_promise = starrocks::make_exclusive<ChunkSourcePromise>();
-    _pending_chunk_source_future = chunk_source_promise->get_future();
-    PriorityThreadPool::Task task;
+    // The io task is still reading, the next one will be triggered when the driver takes a chunk after it.
+    if (_is_io_task_active.load(std::memory_order_acquire)) {
+        return;
+    }
+    // Error or EOS has been encountered, nothing to read.
+    if (!_io_task_status.ok() || !_chunk_source->has_next_chunk()) {
+        return;
+    }
+    size_t num_buffered_chunks = _chunk_source->get_buffer_size();
+    if (num_buffered_chunks >= _max_buffered_chunks) {
+        return;
+    }
 
-    task.work_function = [chunk_source, chunk_source_promise]() {
-        chunk_source->cache_next_chunk_blocking();
-        chunk_source_promise->set_value(chunk_source);
+    size_t batch_size = _max_buffered_chunks - num_buffered_chunks;
+    _is_io_task_active.store(true, std::memory_order_release);
+    PriorityThreadPool::Task task;
+    // The io task always completes before the operator is closed, see pending_finish().
+    task.work_function = [this, state, batch_size]() {
+        if (!_is_chunk_source_prepared) {
+            _io_task_status = _chunk_source->prepare(state);
+            _is_chunk_source_prepared = true;
+        }
+        if (_io_task_status.ok()) {
+            _chunk_source->buffer_next_batch_chunks_blocking(batch_size);
+        }
+        _is_io_task_active.store(false, std::memory_order_release);
+        // The scan operator is ready to output, or to finish if it's pending finish.
+        ExecEnv::GetInstance()->driver_dispatcher()->notify_blocked_drivers();
     };
     // TODO(by satanson): set a proper priority
     task.priority = 20;
     // try to submit io task, always return true except that _io_threads is shutdown.
-    _io_threads->try_offer(task);
-    // io task is pending
-    DCHECK(_pending_chunk_source_future.has_value());
+    if (!_io_threads->try_offer(task)) {
+        _io_task_status = Status::InternalError("Failed to submit io task of scan operator");
+        _is_io_task_active.store(false, std::memory_order_release);
+    }
 }
+
 Status ScanOperator::prepare(RuntimeState* state) {
     Operator::prepare(state);
     RowDescriptor row_desc;
@@ -64,12 +91,34 @@ Status ScanOperator::prepare(RuntimeState* state) {
                     strings::Substitute("num_scan_operators exceeds queue capacity($0) of pipeline_pool_thread",
                                         _io_threads->get_queue_capacity()));
         }
+        _max_buffered_chunks = std::max<int64_t>(config::pipeline_scan_max_buffered_chunks, 1);
+    }
+    const TQueryOptions& query_options = state->query_options();
+    if (!_runtime_filters.empty() && query_options.__isset.runtime_filter_wait_timeout_ms &&
+        query_options.runtime_filter_wait_timeout_ms > 0) {
+        _runtime_filter_wait_timer = ADD_TIMER(_runtime_profile, "RuntimeFilterWaitTime");
+        _is_waiting_runtime_filters = true;
+        _runtime_filter_wait_start_ns = MonotonicNanos();
+        _runtime_filter_wait_timeout_ns = query_options.runtime_filter_wait_timeout_ms * 1000000L;
+        return Status::OK();
+    }
+    return _pickup_morsel(state);
+}
+
+bool ScanOperator::_is_runtime_filters_ready() const {
+    if (MonotonicNanos() - _runtime_filter_wait_start_ns >= _runtime_filter_wait_timeout_ns) {
+        return true;
     }
-    _pickup_morsel(state);
-    return Status::OK();
+    for (const auto& it : _runtime_filters.descriptors()) {
+        if (it.second->runtime_filter() == nullptr && _unwaited_runtime_filters.count(it.first) == 0) {
+            return false;
+        }
+    }
+    return true;
 }
 
 Status ScanOperator::close(RuntimeState* state) {
+    DCHECK(!_is_io_task_active.load(std::memory_order_acquire));
     Expr::close(_conjunct_ctxs, state);
     if (_io_threads != nullptr) {
         state->exec_env()->decrement_num_scan_operators(1);
@@ -92,16 +141,19 @@ bool ScanOperator::_has_output_nonblocking() {
     if (_is_finished) {
         return false;
     }
-    DCHECK(_pending_chunk_source_future.has_value());
-    // submitted io task has not completed yet
-    if (_pending_chunk_source_future.value().wait_for(std::chrono::seconds::zero()) != std::future_status::ready) {
-        return false;
+    // The chunks read by the running io task can be taken.
+    if (_is_io_task_active.load(std::memory_order_acquire)) {
+        return _chunk_source->get_buffer_size() > 0;
     }
-    // submitted io task has already completed
+    // No io task is running, the driver takes a buffered chunk, or handles the error or EOS of the chunk source,
+    // or triggers the next io task.
     return true;
 }
 
 bool ScanOperator::has_output() {
+    if (_is_waiting_runtime_filters) {
+        return !_is_finished && _is_runtime_filters_ready();
+    }
     if (_io_threads != nullptr) {
         return _has_output_nonblocking();
     } else {
@@ -115,18 +167,7 @@ bool ScanOperator::pending_finish() {
         return false;
     }
     // pending io task has been submitted, but not complete yet.
-    if (_pending_chunk_source_future.has_value()) {
-        if (_pending_chunk_source_future.value().wait_for(std::chrono::seconds::zero()) == std::future_status::ready) {
-            _chunk_source = _pending_chunk_source_future.value().get();
-            _pending_chunk_source_future = {};
-            return false;
-        } else {
-            return true;
-        }
-    }
-    // no pending io task
-    DCHECK(!_pending_chunk_source_future.has_value());
-    return false;
+    return _is_io_task_active.load(std::memory_order_acquire);
 }
 
 bool ScanOperator::is_finished() const {
@@ -134,10 +175,8 @@ bool ScanOperator::is_finished() const {
 }
 
 void ScanOperator::finish(RuntimeState* state) {
+    // The chunk source may be read by the io task, so it's closed in close().
     _is_finished = true;
-    if (_chunk_source) {
-        _chunk_source->close(state);
-    }
 }
 
 StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_blocking(RuntimeState* state) {
@@ -150,7 +189,7 @@ StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_blocking(RuntimeState*
     if (chunk.ok() || !chunk.status().is_end_of_file()) {
         return chunk;
     }
-    _pickup_morsel(state);
+    RETURN_IF_ERROR(_pickup_morsel(state));
     return nullptr;
 }
 
@@ -160,25 +199,40 @@ StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_nonblocking(RuntimeStat
         return Status::EndOfFile("End-Of-Stream");
     }
 
-    _chunk_source = _pending_chunk_source_future.value().get();
-    _pending_chunk_source_future = {};
-    auto chunk = _chunk_source->get_next_chunk_nonblocking();
-    if (chunk.ok()) {
-        _trigger_read_chunk();
+    if (_chunk_source->get_buffer_size() > 0) {
+        auto chunk = _chunk_source->get_next_chunk_from_buffer();
+        // Read the next chunks into the buffer while this chunk is being processed.
+        _trigger_next_scan(state);
         return chunk;
     }
-    if (!chunk.status().is_end_of_file()) {
-        return chunk;
+
+    // The buffer is empty and no io task is running.
+    DCHECK(!_is_io_task_active.load(std::memory_order_acquire));
+    RETURN_IF_ERROR(_io_task_status);
+    if (_chunk_source->has_next_chunk()) {
+        // The last io task has completed after the last chunk is taken, trigger the next one.
+        _trigger_next_scan(state);
+        return nullptr;
+    }
+    auto status = _chunk_source->get_next_chunk_from_buffer().status();
+    if (!status.is_end_of_file()) {
+        return status;
     }
     // Now ScanOperator can process multiple morsels, when the non-last morsel is
     // processed and the EndOfFile is encountered, then ScanOperator has no chunk
     // to output and should pick up next morsel. so here return nullptr instead of
     // empty chunk.
-    _pickup_morsel(state);
+    RETURN_IF_ERROR(_pickup_morsel(state));
     return nullptr;
 }
 
 StatusOr<vectorized::ChunkPtr> ScanOperator::pull_chunk(RuntimeState* state) {
+    if (_is_waiting_runtime_filters) {
+        _is_waiting_runtime_filters = false;
+        COUNTER_SET(_runtime_filter_wait_timer, MonotonicNanos() - _runtime_filter_wait_start_ns);
+        RETURN_IF_ERROR(_pickup_morsel(state));
+        return nullptr;
+    }
     if (_io_threads == nullptr) {
         return _pull_chunk_blocking(state);
     } else {
@@ -2,10 +2,13 @@
 
 #pragma once
 
-#include <optional>
+#include <atomic>
+#include <map>
+#include <set>
 
 #include "exec/pipeline/source_operator.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
+#include "runtime/vectorized/global_dict.h"
 #include "util/priority_thread_pool.hpp"
 
 namespace starrocks {
@@ -17,11 +20,13 @@ class ScanOperator final : public SourceOperator {
 public:
     ScanOperator(int32_t id, int32_t plan_node_id, const TOlapScanNode& olap_scan_node,
                  const std::vector<ExprContext*>& conjunct_ctxs,
-                 const vectorized::RuntimeFilterProbeCollector& runtime_filters)
+                 const vectorized::RuntimeFilterProbeCollector& runtime_filters,
+                 const vectorized::GlobalDicts& global_dicts)
             : SourceOperator(id, "olap_scan", plan_node_id),
               _olap_scan_node(olap_scan_node),
               _conjunct_ctxs(conjunct_ctxs),
-              _runtime_filters(runtime_filters) {}
+              _runtime_filters(runtime_filters),
+              _global_dicts(global_dicts) {}
 
     ~ScanOperator() override = default;
 
@@ -39,10 +44,16 @@ public:
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
     void set_io_threads(PriorityThreadPool* io_threads) { _io_threads = io_threads; }
+    // The runtime filters not waited for before the first morsel, they are applied once they arrive.
+    void set_unwaited_runtime_filters(std::set<int32_t> filter_ids) {
+        _unwaited_runtime_filters = std::move(filter_ids);
+    }
 
 private:
-    void _pickup_morsel(RuntimeState* state);
-    void _trigger_read_chunk();
+    Status _pickup_morsel(RuntimeState* state);
+    // Whether all the runtime filters have arrived, or the time to wait for them is out.
+    bool _is_runtime_filters_ready() const;
+    void _trigger_next_scan(RuntimeState* state);
     bool _has_output_blocking();
     bool _has_output_nonblocking();
     StatusOr<vectorized::ChunkPtr> _pull_chunk_blocking(RuntimeState* state);
@@ -53,32 +64,79 @@ private:
     const TOlapScanNode& _olap_scan_node;
     const std::vector<ExprContext*>& _conjunct_ctxs;
     const vectorized::RuntimeFilterProbeCollector& _runtime_filters;
+    const vectorized::GlobalDicts& _global_dicts;
     PriorityThreadPool* _io_threads = nullptr;
-    OptionalChunkSourceFuture _pending_chunk_source_future;
+
+    // The first morsel isn't picked up until the runtime filters arrive or the wait times out, so that the
+    // filters prune the storage by the zone maps. The driver isn't blocked, it polls has_output() meanwhile.
+    bool _is_waiting_runtime_filters = false;
+    int64_t _runtime_filter_wait_start_ns = 0;
+    int64_t _runtime_filter_wait_timeout_ns = 0;
+    RuntimeProfile::Counter* _runtime_filter_wait_timer = nullptr;
+    std::set<int32_t> _unwaited_runtime_filters;
+
+    // The following fields are used when the chunks are read by _io_threads.
+    // The max number of chunks read into the buffer of _chunk_source in advance.
+    size_t _max_buffered_chunks = 1;
+    // At most one io task reads _chunk_source at a time. It's set by the driver when the io task
+    // is submitted, and reset by the io thread when the io task is completed.
+    std::atomic<bool> _is_io_task_active = false;
+    // The following two fields are accessed by the io task, and accessed by the driver only
+    // when no io task is active.
+    // The chunk source is prepared by the first io task of it, so that the driver isn't blocked
+    // by opening the segments.
+    bool _is_chunk_source_prepared = false;
+    Status _io_task_status;
 };
 
-class ScanOperatorFactory final : public OperatorFactory {
+class ScanOperatorFactory final : public SourceOperatorFactory {
 public:
     ScanOperatorFactory(int32_t id, int32_t plan_node_id, const TOlapScanNode& olap_scan_node,
                         std::vector<ExprContext*>&& conjunct_ctxs,
-                        vectorized::RuntimeFilterProbeCollector&& runtime_filters)
-            : OperatorFactory(id, plan_node_id),
+                        vectorized::RuntimeFilterProbeCollector&& runtime_filters,
+                        vectorized::GlobalDicts global_dicts)
+            : SourceOperatorFactory(id, plan_node_id),
               _olap_scan_node(olap_scan_node),
               _conjunct_ctxs(std::move(conjunct_ctxs)),
-              _runtime_filters(std::move(runtime_filters)) {}
+              _runtime_filters(std::move(runtime_filters)),
+              _global_dicts(std::move(global_dicts)) {}
 
     ~ScanOperatorFactory() override = default;
 
     OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
-        return std::make_shared<ScanOperator>(_id, _plan_node_id, _olap_scan_node, _conjunct_ctxs, _runtime_filters);
+        auto op = std::make_shared<ScanOperator>(_id, _plan_node_id, _olap_scan_node, _conjunct_ctxs, _runtime_filters,
+                                                 _global_dicts);
+        std::set<int32_t> unwaited_filters;
+        for (const auto& [filter_id, max_buckets_in_memory] : _bucket_join_runtime_filters) {
+            if (driver_instance_count > max_buckets_in_memory) {
+                unwaited_filters.insert(filter_id);
+            }
+        }
+        op->set_unwaited_runtime_filters(std::move(unwaited_filters));
+        return op;
     }
 
-    bool is_source() const override { return true; }
+    bool need_morsels() const override { return true; }
+
+    // The scan of a colocate join reads the tablets per bucket, each driver reads the morsels of one bucket.
+    void set_bucketed() { _is_bucketed = true; }
+    bool is_bucketed() const { return _is_bucketed; }
+    // The runtime filters of a colocate join probing this scan are published after the hash tables of all the
+    // buckets are built. If more than |max_buckets_in_memory| buckets are read, the last buckets aren't built
+    // until the first ones are probed, so the scan doesn't wait for these filters.
+    void add_bucket_join_runtime_filter(int32_t filter_id, int32_t max_buckets_in_memory) {
+        _bucket_join_runtime_filters[filter_id] = max_buckets_in_memory;
+    }
 
 private:
     TOlapScanNode _olap_scan_node;
     std::vector<ExprContext*> _conjunct_ctxs;
     vectorized::RuntimeFilterProbeCollector _runtime_filters;
+    // The global dicts of the slots read as the dict ids.
+    vectorized::GlobalDicts _global_dicts;
+    bool _is_bucketed = false;
+    // filter id -> the max buckets in memory of the colocate join building it.
+    std::map<int32_t, int32_t> _bucket_join_runtime_filters;
 };
 
 } // namespace pipeline
@@ -0,0 +1,85 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/sort/local_merge_sort_source_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status LocalMergeSortSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(SourceOperator::prepare(state));
+    _offset = _sort_context->offset();
+    return Status::OK();
+}
+
+Status LocalMergeSortSourceOperator::close(RuntimeState* state) {
+    // The merger refers to the chunks sorters owned by the SortContext, so it's released before unref.
+    _merger.reset();
+    _sort_context->unref(state);
+    return SourceOperator::close(state);
+}
+
+bool LocalMergeSortSourceOperator::has_output() {
+    return !_is_finished && _sort_context->is_partition_sort_finished();
+}
+
+Status LocalMergeSortSourceOperator::_init_merger() {
+    vectorized::ChunkSuppliers suppliers;
+    suppliers.reserve(_sort_context->chunks_sorters().size());
+    for (const auto& sorter : _sort_context->chunks_sorters()) {
+        vectorized::ChunksSorter* chunks_sorter = sorter.get();
+        suppliers.emplace_back([chunks_sorter](vectorized::Chunk** chunk) -> Status {
+            vectorized::ChunkPtr output;
+            bool eos = false;
+            RETURN_IF_ERROR(chunks_sorter->get_next(&output, &eos));
+            if (eos || output == nullptr) {
+                *chunk = nullptr;
+                return Status::OK();
+            }
+            // The cursor of the merger takes the ownership of the raw chunk.
+            *chunk = new vectorized::Chunk();
+            (*chunk)->swap_chunk(*output);
+            return Status::OK();
+        });
+    }
+
+    _merger = std::make_unique<vectorized::SortedChunksMerger>();
+    _merger->set_profile(_runtime_profile.get());
+    SortExecExprs* sort_exec_exprs = _sort_context->sort_exec_exprs();
+    return _merger->init(suppliers, &sort_exec_exprs->lhs_ordering_expr_ctxs(), &_sort_context->is_asc_order(),
+                         &_sort_context->is_null_first());
+}
+
+StatusOr<vectorized::ChunkPtr> LocalMergeSortSourceOperator::pull_chunk(RuntimeState* state) {
+    if (_merger == nullptr) {
+        RETURN_IF_ERROR(_sort_context->partition_sort_status());
+        RETURN_IF_ERROR(_init_merger());
+    }
+
+    vectorized::ChunkPtr chunk;
+    bool eos = false;
+    do {
+        RETURN_IF_ERROR(_merger->get_next(&chunk, &eos));
+        if (eos) {
+            _is_finished = true;
+            return Status::EndOfFile("End-Of-Stream");
+        }
+        if (_offset > 0) {
+            const int64_t num_rows = chunk->num_rows();
+            if (num_rows <= _offset) {
+                _offset -= num_rows;
+                chunk = nullptr;
+            } else {
+                vectorized::ChunkPtr remain = chunk->clone_empty(num_rows - _offset);
+                remain->append(*chunk, _offset, num_rows - _offset);
+                _offset = 0;
+                chunk = std::move(remain);
+            }
+        }
+    } while (chunk == nullptr);
+
+    DCHECK_CHUNK(chunk);
+    return std::move(chunk);
+}
+} // namespace starrocks::pipeline
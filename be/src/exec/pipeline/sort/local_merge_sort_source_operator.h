@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/sort/sort_context.h"
+#include "exec/pipeline/source_operator.h"
+#include "runtime/vectorized/sorted_chunks_merger.h"
+
+namespace starrocks::pipeline {
+// The source side of the pipeline sort, there is only one driver of it. After all the
+// PartitionSortSinkOperators are finished, it merges their sorted partitions into one
+// sorted stream, and skips the top OFFSET rows of the result.
+class LocalMergeSortSourceOperator final : public SourceOperator {
+public:
+    LocalMergeSortSourceOperator(int32_t id, int32_t plan_node_id, SortContextPtr sort_context)
+            : SourceOperator(id, "local_merge_sort_source", plan_node_id), _sort_context(std::move(sort_context)) {
+        _sort_context->ref();
+    }
+    ~LocalMergeSortSourceOperator() override = default;
+
+    bool has_output() override;
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    Status _init_merger();
+
+    // shared by all the PartitionSortSinkOperators
+    SortContextPtr _sort_context = nullptr;
+    std::unique_ptr<vectorized::SortedChunksMerger> _merger = nullptr;
+    // The number of rows to skip yet.
+    int64_t _offset = 0;
+    bool _is_finished = false;
+};
+
+class LocalMergeSortSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    LocalMergeSortSourceOperatorFactory(int32_t id, int32_t plan_node_id, SortContextPtr sort_context)
+            : SourceOperatorFactory(id, plan_node_id), _sort_context(std::move(sort_context)) {}
+
+    ~LocalMergeSortSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        DCHECK_EQ(driver_instance_count, 1);
+        return std::make_shared<LocalMergeSortSourceOperator>(_id, _plan_node_id, _sort_context);
+    }
+
+private:
+    SortContextPtr _sort_context = nullptr;
+};
+} // namespace starrocks::pipeline
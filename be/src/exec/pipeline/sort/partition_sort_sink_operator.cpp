@@ -0,0 +1,74 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/sort/partition_sort_sink_operator.h"
+
+#include "column/chunk.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_topn.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status PartitionSortSinkOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    // The sort expressions are shared by all the drivers, so they are prepared only once by the first driver.
+    SortExecExprs* sort_exec_exprs = _sort_context->sort_exec_exprs();
+    if (_driver_sequence == 0) {
+        RETURN_IF_ERROR(
+                sort_exec_exprs->prepare(state, _child_row_desc, _output_row_desc, state->instance_mem_tracker()));
+        RETURN_IF_ERROR(sort_exec_exprs->open(state));
+    }
+
+    // Each partition keeps its top OFFSET + LIMIT rows, the offset is skipped after merging.
+    const int64_t limit = _sort_context->limit();
+    if (limit > 0) {
+        _chunks_sorter = std::make_shared<vectorized::ChunksSorterTopn>(
+                &sort_exec_exprs->lhs_ordering_expr_ctxs(), &_sort_context->is_asc_order(),
+                &_sort_context->is_null_first(), 0, _sort_context->offset() + limit,
+                vectorized::ChunksSorter::SIZE_OF_CHUNK_FOR_TOPN);
+    } else {
+        _chunks_sorter = std::make_shared<vectorized::ChunksSorterFullSort>(
+                &sort_exec_exprs->lhs_ordering_expr_ctxs(), &_sort_context->is_asc_order(),
+                &_sort_context->is_null_first(), vectorized::ChunksSorter::SIZE_OF_CHUNK_FOR_FULL_SORT);
+    }
+    // The sorted data is outputted by the source operator, so its memory is accounted to the fragment instance.
+    _sort_timer = ADD_TIMER(_runtime_profile, "ChunksSorter");
+    _chunks_sorter->setup_runtime(state->instance_mem_tracker(), _runtime_profile.get(), "ChunksSorter");
+    _sort_context->add_partition_chunks_sorter(_driver_sequence, _chunks_sorter);
+    return Status::OK();
+}
+
+Status PartitionSortSinkOperator::close(RuntimeState* state) {
+    _chunks_sorter.reset();
+    _sort_context->unref(state);
+    return Operator::close(state);
+}
+
+void PartitionSortSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    if (_sort_status.ok()) {
+        SCOPED_TIMER(_sort_timer);
+        _sort_status = _chunks_sorter->done(state);
+    }
+    _sort_context->finish_partition(_sort_status);
+}
+
+StatusOr<vectorized::ChunkPtr> PartitionSortSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Not support");
+}
+
+Status PartitionSortSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    if (!_sort_status.ok() || chunk == nullptr || chunk->num_rows() == 0) {
+        return _sort_status;
+    }
+    SCOPED_TIMER(_sort_timer);
+    vectorized::ChunkPtr materialized_chunk = vectorized::ChunksSorter::materialize_chunk_before_sort(
+            chunk.get(), _materialized_tuple_desc, *_sort_context->sort_exec_exprs(), _order_by_types);
+    _sort_status = _chunks_sorter->update(state, materialized_chunk);
+    return _sort_status;
+}
+} // namespace starrocks::pipeline
@@ -0,0 +1,90 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/sort/sort_context.h"
+
+namespace starrocks {
+class RowDescriptor;
+class TupleDescriptor;
+} // namespace starrocks
+
+namespace starrocks::pipeline {
+// The sink side of the pipeline sort. Each driver sorts its own partition of the input with its own
+// ChunksSorter, the sorted partitions are merged by the LocalMergeSortSourceOperator.
+class PartitionSortSinkOperator final : public Operator {
+public:
+    PartitionSortSinkOperator(int32_t id, int32_t plan_node_id, SortContextPtr sort_context,
+                              const RowDescriptor& child_row_desc, const RowDescriptor& output_row_desc,
+                              TupleDescriptor* materialized_tuple_desc,
+                              const std::vector<vectorized::OrderByType>& order_by_types, int32_t driver_sequence)
+            : Operator(id, "partition_sort_sink", plan_node_id),
+              _sort_context(std::move(sort_context)),
+              _child_row_desc(child_row_desc),
+              _output_row_desc(output_row_desc),
+              _materialized_tuple_desc(materialized_tuple_desc),
+              _order_by_types(order_by_types),
+              _driver_sequence(driver_sequence) {
+        _sort_context->ref();
+    }
+    ~PartitionSortSinkOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool need_input() override { return !is_finished(); }
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    // shared by all the PartitionSortSinkOperators and the LocalMergeSortSourceOperator
+    SortContextPtr _sort_context = nullptr;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _output_row_desc;
+    TupleDescriptor* _materialized_tuple_desc;
+    const std::vector<vectorized::OrderByType>& _order_by_types;
+    int32_t _driver_sequence = 0;
+
+    std::shared_ptr<vectorized::ChunksSorter> _chunks_sorter = nullptr;
+    // The first error met when sorting, it's reported to the source operator on finish.
+    Status _sort_status;
+    bool _is_finished = false;
+
+    RuntimeProfile::Counter* _sort_timer = nullptr;
+};
+
+class PartitionSortSinkOperatorFactory final : public OperatorFactory {
+public:
+    PartitionSortSinkOperatorFactory(int32_t id, int32_t plan_node_id, SortContextPtr sort_context,
+                                     const RowDescriptor& child_row_desc, const RowDescriptor& output_row_desc,
+                                     TupleDescriptor* materialized_tuple_desc,
+                                     const std::vector<vectorized::OrderByType>& order_by_types)
+            : OperatorFactory(id, plan_node_id),
+              _sort_context(std::move(sort_context)),
+              _child_row_desc(child_row_desc),
+              _output_row_desc(output_row_desc),
+              _materialized_tuple_desc(materialized_tuple_desc),
+              _order_by_types(order_by_types) {}
+
+    ~PartitionSortSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        _sort_context->set_num_partition_sinkers(driver_instance_count);
+        return std::make_shared<PartitionSortSinkOperator>(_id, _plan_node_id, _sort_context, _child_row_desc,
+                                                           _output_row_desc, _materialized_tuple_desc,
+                                                           _order_by_types, driver_sequence);
+    }
+
+private:
+    SortContextPtr _sort_context = nullptr;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _output_row_desc;
+    TupleDescriptor* _materialized_tuple_desc;
+    const std::vector<vectorized::OrderByType> _order_by_types;
+};
+} // namespace starrocks::pipeline
@@ -0,0 +1,91 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "exec/sort_exec_exprs.h"
+#include "exec/vectorized/chunks_sorter.h"
+
+namespace starrocks::pipeline {
+
+class SortContext;
+using SortContextPtr = std::shared_ptr<SortContext>;
+
+// SortContext is shared by all the PartitionSortSinkOperators and the LocalMergeSortSourceOperator
+// of a sort node. Each sink operator sorts its own partition of the input with its own ChunksSorter,
+// and the source operator merges the sorted partitions after all of them are finished.
+class SortContext {
+public:
+    SortContext(SortExecExprs* sort_exec_exprs, const std::vector<bool>& is_asc_order,
+                const std::vector<bool>& is_null_first, int64_t offset, int64_t limit)
+            : _sort_exec_exprs(sort_exec_exprs),
+              _is_asc_order(is_asc_order),
+              _is_null_first(is_null_first),
+              _offset(offset),
+              _limit(limit) {}
+    ~SortContext() = default;
+
+    // Operators sharing the SortContext hold a reference of it, the last one who unref it
+    // is responsible to close it.
+    void ref() { _num_ref.fetch_add(1); }
+    void unref(RuntimeState* state) {
+        if (_num_ref.fetch_sub(1) == 1) {
+            _chunks_sorters.clear();
+            _sort_exec_exprs->close(state);
+        }
+    }
+
+    SortExecExprs* sort_exec_exprs() const { return _sort_exec_exprs; }
+    const std::vector<bool>& is_asc_order() const { return _is_asc_order; }
+    const std::vector<bool>& is_null_first() const { return _is_null_first; }
+    int64_t offset() const { return _offset; }
+    int64_t limit() const { return _limit; }
+
+    // It's called once for each sink operator, before any of them is prepared.
+    void set_num_partition_sinkers(int32_t num_partition_sinkers) {
+        _num_partition_sinkers = num_partition_sinkers;
+        _chunks_sorters.resize(num_partition_sinkers);
+    }
+    void add_partition_chunks_sorter(int32_t driver_sequence, std::shared_ptr<vectorized::ChunksSorter> sorter) {
+        _chunks_sorters[driver_sequence] = std::move(sorter);
+    }
+    const std::vector<std::shared_ptr<vectorized::ChunksSorter>>& chunks_sorters() const { return _chunks_sorters; }
+
+    // Each sink operator calls it once after its partition is sorted, the first error is kept.
+    void finish_partition(const Status& status) {
+        if (!status.ok()) {
+            std::lock_guard<std::mutex> l(_status_mutex);
+            if (_partition_sort_status.ok()) {
+                _partition_sort_status = status;
+            }
+        }
+        _num_partition_finished.fetch_add(1, std::memory_order_acq_rel);
+    }
+    bool is_partition_sort_finished() const {
+        return _num_partition_finished.load(std::memory_order_acquire) == _num_partition_sinkers;
+    }
+    // It's only valid after is_partition_sort_finished() returns true.
+    const Status& partition_sort_status() const { return _partition_sort_status; }
+
+private:
+    // Owned by the TopNNode, which outlives all the operators of the fragment instance.
+    SortExecExprs* _sort_exec_exprs;
+    const std::vector<bool> _is_asc_order;
+    const std::vector<bool> _is_null_first;
+    const int64_t _offset;
+    const int64_t _limit;
+
+    std::atomic<int32_t> _num_ref = 0;
+
+    int32_t _num_partition_sinkers = 0;
+    std::atomic<int32_t> _num_partition_finished = 0;
+    std::vector<std::shared_ptr<vectorized::ChunksSorter>> _chunks_sorters;
+
+    std::mutex _status_mutex;
+    Status _partition_sort_status;
+};
+
+} // namespace starrocks::pipeline
@@ -38,7 +38,9 @@
 #include "service/brpc.h"
 #include "simd/simd.h"
 #include "storage/hll.h"
+#include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
+#include "util/compression_utils.h"
 #include "util/monotime.h"
 #include "util/uid_util.h"
 
@@ -69,6 +71,10 @@ NodeChannel::~NodeChannel() {
         delete _add_batch_closure;
         _add_batch_closure = nullptr;
     }
+    for (auto* closure : _add_chunk_closures) {
+        delete closure;
+    }
+    _add_chunk_closures.clear();
     if (_is_vectorized) {
         _cur_add_chunk_request.release_id();
     } else {
@@ -170,15 +176,26 @@ Status NodeChannel::open_wait() {
         return status;
     }
 
+    if (_is_vectorized) {
+        int num_closures = std::max(1, config::tablet_sink_max_inflight_add_chunk_rpcs);
+        for (int i = 0; i < num_closures; ++i) {
+            _add_chunk_closures.push_back(_create_add_batch_closure());
+        }
+    }
     // add batch closure
-    _add_batch_closure = ReusableClosure<PTabletWriterAddBatchResult>::create();
-    _add_batch_closure->addFailedHandler([this]() {
+    _add_batch_closure = _create_add_batch_closure();
+    return status;
+}
+
+ReusableClosure<PTabletWriterAddBatchResult>* NodeChannel::_create_add_batch_closure() {
+    auto* closure = ReusableClosure<PTabletWriterAddBatchResult>::create();
+    closure->addFailedHandler([this]() {
         _cancelled = true;
         LOG(WARNING) << name() << " add batch req rpc failed, " << print_load_info() << ", node=" << node_info()->host
                      << ":" << node_info()->brpc_port;
     });
 
-    _add_batch_closure->addSuccessHandler([this](const PTabletWriterAddBatchResult& result, bool is_last_rpc) {
+    closure->addSuccessHandler([this](const PTabletWriterAddBatchResult& result, bool is_last_rpc) {
         Status status(result.status());
         if (status.ok()) {
             if (is_last_rpc) {
@@ -198,13 +215,13 @@ Status NodeChannel::open_wait() {
         }
 
         if (result.has_execution_time_us()) {
+            std::lock_guard<std::mutex> l(_add_batch_counter_lock);
             _add_batch_counter.add_batch_execution_time_us += result.execution_time_us();
             _add_batch_counter.add_batch_wait_lock_time_us += result.wait_lock_time_us();
             _add_batch_counter.add_batch_num++;
         }
     });
-
-    return status;
+    return closure;
 }
 
 Status NodeChannel::add_row(Tuple* input_tuple, int64_t tablet_id) {
@@ -428,12 +445,24 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
         return 0;
     }
 
-    if (!_add_batch_closure->is_packet_in_flight() && _pending_batches_num > 0) {
+    for (auto* closure : _add_chunk_closures) {
+        if (_cancelled || _send_finished || _pending_batches_num == 0) {
+            break;
+        }
+        if (closure->is_packet_in_flight()) {
+            continue;
+        }
         SCOPED_RAW_TIMER(&_actual_consume_ns);
         AddChunkReq send_chunk;
         {
             std::lock_guard<std::mutex> lg(_pending_batches_lock);
             DCHECK(!_pending_chunks.empty());
+            // eos request must be the last request, so it waits for the responses of the former ones.
+            if (_pending_chunks.front().second.eos() &&
+                std::any_of(_add_chunk_closures.begin(), _add_chunk_closures.end(),
+                            [](auto* c) { return c->is_packet_in_flight(); })) {
+                break;
+            }
             send_chunk = std::move(_pending_chunks.front());
             _pending_chunks.pop();
             _pending_batches_num--;
@@ -447,11 +476,18 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
         request.set_packet_seq(_next_packet_seq);
         if (chunk->num_rows() > 0) {
             SCOPED_RAW_TIMER(&_serialize_batch_ns);
-            chunk->serialize_with_meta(request.mutable_chunk());
+            auto st = _serialize_chunk(chunk.get(), request.mutable_chunk());
+            if (!st.ok()) {
+                _cancelled = true;
+                LOG(WARNING) << name() << " serialize chunk failed, " << print_load_info()
+                             << ", errmsg=" << st.get_error_msg();
+                _mem_tracker->release(chunk->memory_usage());
+                return 0;
+            }
         }
 
-        _add_batch_closure->reset();
-        _add_batch_closure->cntl.set_timeout_ms(_rpc_timeout_ms);
+        closure->reset();
+        closure->cntl.set_timeout_ms(_rpc_timeout_ms);
 
         if (request.eos()) {
             for (auto pid : _parent->_partition_ids) {
@@ -459,14 +495,13 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
             }
 
             // eos request must be the last request
-            _add_batch_closure->end_mark();
+            closure->end_mark();
             _send_finished = true;
             DCHECK(_pending_batches_num == 0);
         }
 
-        _add_batch_closure->set_in_flight();
-        _stub->tablet_writer_add_chunk(&_add_batch_closure->cntl, &request, &_add_batch_closure->result,
-                                       _add_batch_closure);
+        closure->set_in_flight();
+        _stub->tablet_writer_add_chunk(&closure->cntl, &request, &closure->result, closure);
         _mem_tracker->release(chunk->memory_usage());
         _next_packet_seq++;
     }
@@ -474,6 +509,28 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
     return _send_finished ? 0 : 1;
 }
 
+Status NodeChannel::_serialize_chunk(const vectorized::Chunk* src, ChunkPB* dst) {
+    dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
+    size_t uncompressed_size = src->serialize_with_meta(dst);
+
+    const BlockCompressionCodec* codec = _parent->_compress_codec;
+    if (codec == nullptr || uncompressed_size == 0 || codec->exceed_max_input_size(uncompressed_size)) {
+        return Status::OK();
+    }
+    // Try compressing data to _compression_scratch, swap if compressed data is smaller
+    _compression_scratch.resize(codec->max_compressed_len(uncompressed_size));
+    Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
+    RETURN_IF_ERROR(codec->compress(dst->data(), &compressed_slice));
+    double compress_ratio = static_cast<double>(uncompressed_size) / compressed_slice.size;
+    if (compress_ratio > config::rpc_compress_ratio_threshold) {
+        _compression_scratch.resize(compressed_slice.size);
+        dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
+        dst->set_compress_type(_parent->_compress_type);
+        dst->set_uncompressed_size(uncompressed_size);
+    }
+    return Status::OK();
+}
+
 Status NodeChannel::none_of(std::initializer_list<bool> vars) {
     bool none = std::none_of(vars.begin(), vars.end(), [](bool var) { return var; });
     Status st = Status::OK();
@@ -691,6 +748,13 @@ Status OlapTableSink::prepare(RuntimeState* state) {
     // validate all column in vectorized engine
     if (_is_vectorized) {
         _need_validate_data = true;
+        // Compress the chunks sent to the load channels as the exchange does
+        if (state->query_options().__isset.transmission_compression_type) {
+            _compress_type = CompressionUtils::to_compression_pb(state->query_options().transmission_compression_type);
+        } else if (config::compress_rowbatches) {
+            _compress_type = CompressionTypePB::LZ4;
+        }
+        RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
     }
 
     // add all counter
@@ -37,12 +37,14 @@
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "util/bitmap.h"
+#include "util/raw_container.h"
 #include "util/ref_count_closure.h"
 #include "util/thrift_util.h"
 
 namespace starrocks {
 
 class Bitmap;
+class BlockCompressionCodec;
 class MemTracker;
 class RuntimeProfile;
 class RowDescriptor;
@@ -176,6 +178,9 @@ public:
     // plz make sure, this func should be called after open_wait().
     int try_send_and_fetch_status();
 
+    // Same as try_send_and_fetch_status(), but allow config::tablet_sink_max_inflight_add_chunk_rpcs rpcs in
+    // flight, the receiver writes them in the order of packet_seq. The eos request is sent after all the
+    // former ones are responded.
     int try_send_chunk_and_fetch_status();
 
     void time_report(std::unordered_map<int64_t, AddBatchCounter>* add_batch_counter_map, int64_t* serialize_batch_ns,
@@ -197,6 +202,11 @@ public:
     void clear_all_batches();
 
 private:
+    ReusableClosure<PTabletWriterAddBatchResult>* _create_add_batch_closure();
+
+    // Serialize |src| into |dst|, and compress the data by the codec of the sink if it's worth.
+    Status _serialize_chunk(const vectorized::Chunk* src, ChunkPB* dst);
+
     std::unique_ptr<MemTracker> _mem_tracker = nullptr;
 
     OlapTableSink* _parent = nullptr;
@@ -238,10 +248,14 @@ private:
     PBackendService_Stub* _stub = nullptr;
     RefCountClosure<PTabletWriterOpenResult>* _open_closure = nullptr;
     ReusableClosure<PTabletWriterAddBatchResult>* _add_batch_closure = nullptr;
+    // The closures of the add_chunk rpcs which may be in flight at the same time.
+    std::vector<ReusableClosure<PTabletWriterAddBatchResult>*> _add_chunk_closures;
 
     std::vector<TTabletWithPartition> _all_tablets;
     std::vector<TTabletCommitInfo> _tablet_commit_infos;
 
+    // the callbacks of the add_chunk rpcs in flight may update the counter concurrently
+    std::mutex _add_batch_counter_lock;
     AddBatchCounter _add_batch_counter;
     int64_t _serialize_batch_ns = 0;
 
@@ -251,6 +265,7 @@ private:
     using AddChunkReq = std::pair<std::unique_ptr<vectorized::Chunk>, PTabletWriterAddChunkRequest>;
     std::queue<AddChunkReq> _pending_chunks;
     PTabletWriterAddChunkRequest _cur_add_chunk_request;
+    raw::RawString _compression_scratch;
 
     int64_t _mem_exceeded_block_ns = 0;
     int64_t _queue_push_lock_ns = 0;
@@ -410,6 +425,9 @@ private:
 
     // vectorized:
     bool _is_vectorized = false;
+    // the codec to compress the chunks sent to the load channels, null if they're not compressed
+    CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
+    const BlockCompressionCodec* _compress_codec = nullptr;
     std::vector<vectorized::OlapTablePartition*> _partitions;
     std::vector<uint32_t> _tablet_indexes;
     // one chunk selection index for partition validation and data validation
@@ -31,6 +31,8 @@ template <PhmapSeed seed>
 using TimeStampAggHashMap = phmap::flat_hash_map<TimestampValue, AggDataPtr, StdHashWithSeed<TimestampValue, seed>>;
 template <PhmapSeed seed>
 using SliceAggHashMap = phmap::flat_hash_map<Slice, AggDataPtr, SliceHashWithSeed<seed>, SliceEqual>;
+template <PhmapSeed seed>
+using UInt128AggHashMap = phmap::flat_hash_map<uint128_t, AggDataPtr, UInt128HashWithSeed<seed>>;
 
 template <PhmapSeed seed>
 using Int32AggTwoLevelHashMap = phmap::parallel_flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>>;
@@ -502,4 +504,71 @@ struct AggHashMapWithSerializedKey {
     uint8_t* buffer;
     ResultVector results;
 };
+
+// handle multi-column keys whose serialized size is fixed and not larger than the hash key, e.g. the
+// ints and the dates. The keys of a row are packed into one integer, a nullable key column takes one
+// more byte for its null flag, so there is neither a per-row serialization nor a hash of slice.
+template <typename HashMap>
+struct AggHashMapWithSerializedKeyFixedSize {
+    using KeyType = typename HashMap::key_type;
+    using Iterator = typename HashMap::iterator;
+    using ResultVector = typename std::vector<KeyType>;
+    HashMap hash_map;
+
+    template <typename Func>
+    void compute_agg_states(size_t chunk_size, const Columns& key_columns, MemPool* pool, Func&& allocate_func,
+                            Buffer<AggDataPtr>* agg_states) {
+        pack_keys(chunk_size, key_columns);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            KeyType key = packed_keys[i];
+            auto iter = hash_map.lazy_emplace(key, [&](const auto& ctor) { ctor(key, allocate_func()); });
+            (*agg_states)[i] = iter->second;
+        }
+    }
+
+    // Elements queried in HashMap will be added to HashMap,
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    template <typename Func>
+    void compute_agg_states(size_t chunk_size, const Columns& key_columns, Func&& allocate_func,
+                            Buffer<AggDataPtr>* agg_states, std::vector<uint8_t>* not_founds) {
+        pack_keys(chunk_size, key_columns);
+        not_founds->assign(chunk_size, 0);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            if (auto iter = hash_map.find(packed_keys[i]); iter != hash_map.end()) {
+                (*agg_states)[i] = iter->second;
+            } else {
+                (*not_founds)[i] = 1;
+            }
+        }
+    }
+
+    // The unused bytes of the keys are zero, so the equal keys are packed into the same integer.
+    void pack_keys(size_t chunk_size, const Columns& key_columns) {
+        packed_keys.assign(chunk_size, 0);
+        auto* buffer = reinterpret_cast<uint8_t*>(packed_keys.data());
+        size_t byte_offset = 0;
+        for (const auto& key_column : key_columns) {
+            byte_offset +=
+                    key_column->serialize_batch_at_interval(buffer, byte_offset, sizeof(KeyType), 0, chunk_size);
+        }
+        DCHECK_LE(byte_offset, sizeof(KeyType));
+    }
+
+    void insert_keys_to_columns(ResultVector& keys, const Columns& key_columns, size_t batch_size) {
+        key_slices.resize(batch_size);
+        for (size_t i = 0; i < batch_size; i++) {
+            key_slices[i] = {reinterpret_cast<const char*>(&keys[i]), sizeof(KeyType)};
+        }
+        for (const auto& key_column : key_columns) {
+            key_column->deserialize_and_append_batch(key_slices, batch_size);
+        }
+    }
+
+    static constexpr bool has_single_null_key = false;
+
+    Buffer<KeyType> packed_keys;
+    std::vector<Slice> key_slices;
+    ResultVector results;
+};
 } // namespace starrocks::vectorized
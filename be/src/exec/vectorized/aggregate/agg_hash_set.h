@@ -60,6 +60,8 @@ template <PhmapSeed seed>
 using SliceAggHashSet =
         phmap::flat_hash_set<TSliceWithHash<seed>, THashOnSliceWithHash<seed>, TEqualOnSliceWithHash<seed>>;
 template <PhmapSeed seed>
+using UInt128AggHashSet = phmap::flat_hash_set<uint128_t, UInt128HashWithSeed<seed>>;
+template <PhmapSeed seed>
 using Int32AggTwoLevelHashSet = phmap::parallel_flat_hash_set<int32_t, StdHashWithSeed<int32_t, seed>>;
 
 template <PhmapSeed seed>
@@ -430,4 +432,59 @@ struct AggHashSetOfSerializedKey {
     ResultVector results;
 };
 
+// The multi-column keys are packed into one integer, like AggHashMapWithSerializedKeyFixedSize.
+template <typename HashSet>
+struct AggHashSetOfSerializedKeyFixedSize {
+    using Iterator = typename HashSet::iterator;
+    using KeyType = typename HashSet::key_type;
+    using ResultVector = typename std::vector<KeyType>;
+    HashSet hash_set;
+
+    void build_set(size_t chunk_size, const Columns& key_columns, MemPool* pool) {
+        pack_keys(chunk_size, key_columns);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            hash_set.emplace(packed_keys[i]);
+        }
+    }
+
+    // Elements queried in HashSet will be added to HashSet
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    void build_set(size_t chunk_size, const Columns& key_columns, std::vector<uint8_t>* not_founds) {
+        pack_keys(chunk_size, key_columns);
+        not_founds->assign(chunk_size, 0);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            (*not_founds)[i] = !hash_set.contains(packed_keys[i]);
+        }
+    }
+
+    // The unused bytes of the keys are zero, so the equal keys are packed into the same integer.
+    void pack_keys(size_t chunk_size, const Columns& key_columns) {
+        packed_keys.assign(chunk_size, 0);
+        auto* buffer = reinterpret_cast<uint8_t*>(packed_keys.data());
+        size_t byte_offset = 0;
+        for (const auto& key_column : key_columns) {
+            byte_offset +=
+                    key_column->serialize_batch_at_interval(buffer, byte_offset, sizeof(KeyType), 0, chunk_size);
+        }
+        DCHECK_LE(byte_offset, sizeof(KeyType));
+    }
+
+    void insert_keys_to_columns(ResultVector& keys, const Columns& key_columns, size_t batch_size) {
+        key_slices.resize(batch_size);
+        for (size_t i = 0; i < batch_size; i++) {
+            key_slices[i] = {reinterpret_cast<const char*>(&keys[i]), sizeof(KeyType)};
+        }
+        for (const auto& key_column : key_columns) {
+            key_column->deserialize_and_append_batch(key_slices, batch_size);
+        }
+    }
+
+    static constexpr bool has_single_null_key = false;
+
+    Buffer<KeyType> packed_keys;
+    std::vector<Slice> key_slices;
+    ResultVector results;
+};
+
 } // namespace starrocks::vectorized
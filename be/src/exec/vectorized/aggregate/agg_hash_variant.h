@@ -21,6 +21,9 @@ namespace starrocks::vectorized {
     M(phase1_slice)                   \
     M(phase1_slice_two_level)         \
     M(phase1_int32_two_level)         \
+    M(phase1_slice_fx4)               \
+    M(phase1_slice_fx8)               \
+    M(phase1_slice_fx16)              \
     M(phase2_int8)                    \
     M(phase2_int16)                   \
     M(phase2_int32)                   \
@@ -30,7 +33,10 @@ namespace starrocks::vectorized {
     M(phase2_string)                  \
     M(phase2_slice)                   \
     M(phase2_slice_two_level)         \
-    M(phase2_int32_two_level)
+    M(phase2_int32_two_level)         \
+    M(phase2_slice_fx4)               \
+    M(phase2_slice_fx8)               \
+    M(phase2_slice_fx16)
 
 #define APPLY_FOR_VARIANT_NULL(M) \
     M(phase1_null_int8)           \
@@ -66,6 +72,9 @@ namespace starrocks::vectorized {
     M(phase1_null_string)        \
     M(phase1_slice_two_level)    \
     M(phase1_int32_two_level)    \
+    M(phase1_slice_fx4)          \
+    M(phase1_slice_fx8)          \
+    M(phase1_slice_fx16)         \
     M(phase2_int8)               \
     M(phase2_int16)              \
     M(phase2_int32)              \
@@ -82,6 +91,16 @@ namespace starrocks::vectorized {
     M(phase2_null_timestamp)     \
     M(phase2_null_string)        \
     M(phase2_slice_two_level)    \
+    M(phase2_int32_two_level)    \
+    M(phase2_slice_fx4)          \
+    M(phase2_slice_fx8)          \
+    M(phase2_slice_fx16)
+
+// The two-level hash maps, whose sub-maps could be iterated separately.
+#define APPLY_FOR_TWO_LEVEL_VARIANT(M) \
+    M(phase1_slice_two_level)          \
+    M(phase1_int32_two_level)          \
+    M(phase2_slice_two_level)          \
     M(phase2_int32_two_level)
 
 // Hash maps for phase1
@@ -121,6 +140,13 @@ template <PhmapSeed seed>
 using SerializedKeyTwoLevelAggHashMap = AggHashMapWithSerializedKey<SliceAggTwoLevelHashMap<seed>>;
 template <PhmapSeed seed>
 using Int32TwoLevelAggHashMapWithOneNumberKey = AggHashMapWithOneNumberKey<int32_t, Int32AggTwoLevelHashMap<seed>>;
+// For multi-column keys of fixed size, the keys are packed into an integer of 4, 8 or 16 bytes
+template <PhmapSeed seed>
+using SerializedKeyFixedSize4AggHashMap = AggHashMapWithSerializedKeyFixedSize<Int32AggHashMap<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize8AggHashMap = AggHashMapWithSerializedKeyFixedSize<Int64AggHashMap<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize16AggHashMap = AggHashMapWithSerializedKeyFixedSize<UInt128AggHashMap<seed>>;
 
 // 1) For different group by columns type, size, cardinality, volume, we should choose different
 // hash functions and different hashmaps.
@@ -153,6 +179,9 @@ struct HashMapVariant {
         phase1_slice,
         phase1_slice_two_level,
         phase1_int32_two_level,
+        phase1_slice_fx4,
+        phase1_slice_fx8,
+        phase1_slice_fx16,
         phase2_int8,
         phase2_int16,
         phase2_int32,
@@ -169,7 +198,10 @@ struct HashMapVariant {
         phase2_null_string,
         phase2_slice,
         phase2_slice_two_level,
-        phase2_int32_two_level
+        phase2_int32_two_level,
+        phase2_slice_fx4,
+        phase2_slice_fx8,
+        phase2_slice_fx16
     };
     Type type = Type::phase1_slice;
 
@@ -190,6 +222,9 @@ struct HashMapVariant {
     std::unique_ptr<SerializedKeyAggHashMap<PhmapSeed1>> phase1_slice;
     std::unique_ptr<SerializedKeyTwoLevelAggHashMap<PhmapSeed1>> phase1_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>> phase1_int32_two_level;
+    std::unique_ptr<SerializedKeyFixedSize4AggHashMap<PhmapSeed1>> phase1_slice_fx4;
+    std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed1>> phase1_slice_fx8;
+    std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed1>> phase1_slice_fx16;
 
     std::unique_ptr<Int8AggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int8;
     std::unique_ptr<Int16AggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int16;
@@ -208,6 +243,9 @@ struct HashMapVariant {
     std::unique_ptr<SerializedKeyAggHashMap<PhmapSeed2>> phase2_slice;
     std::unique_ptr<SerializedKeyTwoLevelAggHashMap<PhmapSeed2>> phase2_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int32_two_level;
+    std::unique_ptr<SerializedKeyFixedSize4AggHashMap<PhmapSeed2>> phase2_slice_fx4;
+    std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed2>> phase2_slice_fx8;
+    std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed2>> phase2_slice_fx16;
 
     void init(Type type_) {
         type = type_;
@@ -232,6 +270,18 @@ struct HashMapVariant {
         return 0;
     }
 
+    // Pre-size the hash map for |num_keys| keys, so it isn't rehashed until it holds more.
+    void reserve(size_t num_keys) {
+        switch (type) {
+#define M(NAME)                           \
+    case Type::NAME:                      \
+        NAME->hash_map.reserve(num_keys); \
+        break;
+            APPLY_FOR_VARIANT_ALL(M)
+#undef M
+        }
+    }
+
     size_t size() const {
         switch (type) {
 #define M(NAME)      \
@@ -298,6 +348,12 @@ template <PhmapSeed seed>
 using SerializedTwoLevelKeyAggHashSet = AggHashSetOfSerializedKey<SliceAggTwoLevelHashSet<seed>>;
 template <PhmapSeed seed>
 using Int32TwoLevelAggHashSetOfOneNumberKey = AggHashSetOfOneNumberKey<int32_t, Int32AggTwoLevelHashSet<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize4AggHashSet = AggHashSetOfSerializedKeyFixedSize<Int32AggHashSet<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize8AggHashSet = AggHashSetOfSerializedKeyFixedSize<Int64AggHashSet<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize16AggHashSet = AggHashSetOfSerializedKeyFixedSize<UInt128AggHashSet<seed>>;
 
 // 1) HashSetVariant is alike HashMapVariant, while a set only holds keys, no associated value.
 //
@@ -326,6 +382,9 @@ struct HashSetVariant {
         phase1_slice,
         phase1_slice_two_level,
         phase1_int32_two_level,
+        phase1_slice_fx4,
+        phase1_slice_fx8,
+        phase1_slice_fx16,
         phase2_int8,
         phase2_int16,
         phase2_int32,
@@ -342,7 +401,10 @@ struct HashSetVariant {
         phase2_null_string,
         phase2_slice,
         phase2_slice_two_level,
-        phase2_int32_two_level
+        phase2_int32_two_level,
+        phase2_slice_fx4,
+        phase2_slice_fx8,
+        phase2_slice_fx16
     };
     Type type = Type::phase1_slice;
 
@@ -363,6 +425,9 @@ struct HashSetVariant {
     std::unique_ptr<SerializedKeyAggHashSet<PhmapSeed1>> phase1_slice;
     std::unique_ptr<SerializedTwoLevelKeyAggHashSet<PhmapSeed1>> phase1_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashSetOfOneNumberKey<PhmapSeed1>> phase1_int32_two_level;
+    std::unique_ptr<SerializedKeyFixedSize4AggHashSet<PhmapSeed1>> phase1_slice_fx4;
+    std::unique_ptr<SerializedKeyFixedSize8AggHashSet<PhmapSeed1>> phase1_slice_fx8;
+    std::unique_ptr<SerializedKeyFixedSize16AggHashSet<PhmapSeed1>> phase1_slice_fx16;
 
     std::unique_ptr<Int8AggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int8;
     std::unique_ptr<Int16AggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int16;
@@ -381,6 +446,9 @@ struct HashSetVariant {
     std::unique_ptr<SerializedKeyAggHashSet<PhmapSeed2>> phase2_slice;
     std::unique_ptr<SerializedTwoLevelKeyAggHashSet<PhmapSeed2>> phase2_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int32_two_level;
+    std::unique_ptr<SerializedKeyFixedSize4AggHashSet<PhmapSeed2>> phase2_slice_fx4;
+    std::unique_ptr<SerializedKeyFixedSize8AggHashSet<PhmapSeed2>> phase2_slice_fx8;
+    std::unique_ptr<SerializedKeyFixedSize16AggHashSet<PhmapSeed2>> phase2_slice_fx16;
 
     void init(Type type_) {
         type = type_;
@@ -405,6 +473,18 @@ struct HashSetVariant {
         return 0;
     }
 
+    // Pre-size the hash set for |num_keys| keys, so it isn't rehashed until it holds more.
+    void reserve(size_t num_keys) {
+        switch (type) {
+#define M(NAME)                           \
+    case Type::NAME:                      \
+        NAME->hash_set.reserve(num_keys); \
+        break;
+            APPLY_FOR_VARIANT_ALL(M)
+#undef M
+        }
+    }
+
     size_t size() const {
         switch (type) {
 #define M(NAME)      \
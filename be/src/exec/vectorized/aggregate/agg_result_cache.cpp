@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/aggregate/agg_result_cache.h"
+
+#include "column/chunk.h"
+#include "common/config.h"
+
+namespace starrocks::vectorized {
+
+AggResultCache* AggResultCache::_s_instance = nullptr;
+
+void AggResultCache::create_global_cache(size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new AggResultCache(capacity);
+    }
+}
+
+void AggResultCache::release_global_cache() {
+    delete _s_instance;
+    _s_instance = nullptr;
+}
+
+AggResultCache::AggResultCache(size_t capacity)
+        : _cache(new_lru_cache(capacity, cache_policy_from_string(config::storage_cache_eviction_policy))) {}
+
+std::string AggResultCache::_encode_key(const std::string& digest, int64_t tablet_id, int64_t version) {
+    std::string key;
+    key.reserve(digest.size() + sizeof(tablet_id) + sizeof(version));
+    key.append(reinterpret_cast<const char*>(&tablet_id), sizeof(tablet_id));
+    key.append(reinterpret_cast<const char*>(&version), sizeof(version));
+    key.append(digest);
+    return key;
+}
+
+std::shared_ptr<const AggResultCache::Chunks> AggResultCache::lookup(const std::string& digest, int64_t tablet_id,
+                                                                     int64_t version) {
+    std::string key = _encode_key(digest, tablet_id, version);
+    auto* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    auto chunks = *static_cast<std::shared_ptr<const Chunks>*>(_cache->value(handle));
+    _cache->release(handle);
+    return chunks;
+}
+
+void AggResultCache::insert(const std::string& digest, int64_t tablet_id, int64_t version,
+                            std::shared_ptr<const Chunks> chunks) {
+    auto deleter = [](const CacheKey& key, void* value) { delete static_cast<std::shared_ptr<const Chunks>*>(value); };
+    size_t charge = 0;
+    for (const auto& chunk : *chunks) {
+        charge += chunk->memory_usage();
+    }
+    std::string key = _encode_key(digest, tablet_id, version);
+    auto* value = new std::shared_ptr<const Chunks>(std::move(chunks));
+    auto* handle = _cache->insert(CacheKey(key), value, charge, deleter);
+    _cache->release(handle);
+}
+
+} // namespace starrocks::vectorized
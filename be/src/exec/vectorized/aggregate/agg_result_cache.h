@@ -0,0 +1,53 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "gutil/macros.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks::vectorized {
+
+// A global cache of the partial aggregation results of the tablets, keyed by the digest of the plan of the
+// aggregation, the tablet id and the version of the tablet. A version of a tablet is immutable, so an entry never
+// gets stale, a new load makes a new version and the results of the old one are evicted at last.
+//
+// The repeated queries, e.g. the refreshes of the dashboards, take the partial results of the tablets unchanged
+// since the last run from this cache instead of scanning and aggregating them again.
+class AggResultCache {
+public:
+    using Chunks = std::vector<ChunkPtr>;
+
+    // Create the global instance, no instance is created if |capacity| is 0.
+    static void create_global_cache(size_t capacity);
+
+    static void release_global_cache();
+
+    // Return the global instance, or nullptr if the cache is disabled.
+    static AggResultCache* instance() { return _s_instance; }
+
+    explicit AggResultCache(size_t capacity);
+
+    // Return the cached result chunks, or nullptr if they aren't cached. The chunks must not be modified.
+    std::shared_ptr<const Chunks> lookup(const std::string& digest, int64_t tablet_id, int64_t version);
+
+    // Cache the result |chunks|, charged by their memory usage.
+    void insert(const std::string& digest, int64_t tablet_id, int64_t version, std::shared_ptr<const Chunks> chunks);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(AggResultCache);
+
+    static std::string _encode_key(const std::string& digest, int64_t tablet_id, int64_t version);
+
+    static AggResultCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks::vectorized
@@ -2,28 +2,56 @@
 
 #include "exec/vectorized/aggregate/aggregate_blocking_node.h"
 
+#include <thread>
+
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/vectorized/olap_scan_node.h"
+#include "runtime/current_thread.h"
+#include "simd/simd.h"
+#include "util/blocking_queue.hpp"
+
 namespace starrocks::vectorized {
 
+// The chunks converted from some sub-maps of the two-level hash map by a thread of its own.
+struct AggregateBlockingNode::PartitionStream {
+    // the thread keeps up to 2 chunks converted ahead
+    PartitionStream() : queue(2) {}
+
+    // the converted chunks followed by a nullptr
+    BlockingQueue<ChunkPtr> queue;
+    bool eos = false;
+    std::thread thread;
+};
+
+AggregateBlockingNode::~AggregateBlockingNode() {
+    _stop_partition_streams();
+}
+
 Status AggregateBlockingNode::open(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(Expr::open(_group_by_expr_ctxs, state));
-    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
-        RETURN_IF_ERROR(Expr::open(_agg_expr_ctxs[i], state));
-    }
+    RETURN_IF_ERROR(_aggregator->open(state));
+    RETURN_IF_ERROR(_children[0]->open(state));
+    _init_group_limit();
 
-    // Initial for FunctionContext of every aggregate functions
-    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
-        // initial const columns for i'th FunctionContext.
-        _evaluate_const_columns(i);
+    if (_init_result_cache_key()) {
+        _cached_chunks = AggResultCache::instance()->lookup(_tnode.agg_node.cache_digest, _cache_tablet_id,
+                                                            _cache_version);
+        _runtime_profile->add_info_string("ResultCache", _cached_chunks != nullptr ? "Hit" : "Miss");
+        if (_cached_chunks != nullptr) {
+            return Status::OK();
+        }
+        _chunks_to_cache = std::make_shared<AggResultCache::Chunks>();
     }
 
-    RETURN_IF_ERROR(_children[0]->open(state));
-
     ChunkPtr chunk;
 
-    VLOG_ROW << "_group_by_expr_ctxs size " << _group_by_expr_ctxs.size() << " _needs_finalize " << _needs_finalize;
+    VLOG_ROW << "group_by_expr_ctxs size " << _aggregator->group_by_expr_ctxs().size() << " needs_finalize "
+             << _aggregator->needs_finalize();
     while (true) {
         bool eos = false;
         RETURN_IF_CANCELLED(state);
@@ -39,51 +67,61 @@ Status AggregateBlockingNode::open(RuntimeState* state) {
 
         DCHECK_LE(chunk->num_rows(), config::vector_chunk_size);
 
-        _evaluate_exprs(chunk.get());
+        _aggregator->evaluate_exprs(chunk.get());
 
         {
-            SCOPED_TIMER(_agg_compute_timer);
-            if (!_group_by_expr_ctxs.empty()) {
-                if (false) {
+            SCOPED_TIMER(_aggregator->agg_compute_timer());
+            if (_aggregator->is_multi_distinct_count()) {
+                _aggregator->build_multi_distinct_set(chunk->num_rows());
+                RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
+            } else {
+                if (_aggregator->reached_group_limit()) {
+                    // Only update the groups in the hash map.
+                    _aggregator->build_hash_map_with_selection(chunk->num_rows());
+                    if (SIMD::count_zero(_aggregator->streaming_selection()) > 0) {
+                        _aggregator->compute_batch_agg_states(chunk->num_rows(), _aggregator->streaming_selection());
+                    }
+                } else {
+                    if (!_aggregator->is_none_group_by_exprs()) {
+                        _aggregator->build_hash_map(chunk->num_rows());
+                        RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+                        _aggregator->try_convert_to_two_level_map();
+                    }
+                    _aggregator->compute_agg_states(chunk->num_rows());
                 }
-#define HASH_MAP_METHOD(NAME)                                                                        \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                   \
-            _build_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, \
-                                                                            chunk->num_rows());
-                APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-
-                RETURN_IF_ERROR(_check_hash_map_memory_usage(state));
-                _try_convert_to_two_level_map();
             }
-            (this->*_compute_agg_states)(chunk->num_rows());
 
-            _num_input_rows += chunk->num_rows();
+            _aggregator->update_num_input_rows(chunk->num_rows());
         }
+        RETURN_IF_ERROR(_aggregator->try_spill_hash_map(state));
     }
 
-    if (!_group_by_expr_ctxs.empty()) {
-        COUNTER_SET(_hash_table_size, (int64_t)_hash_map_variant.size());
-        // If hash map is empty, we don't need to return value
-        if (_hash_map_variant.size() == 0) {
-            _is_finished = true;
-        }
-
-        if (false) {
+    if (_aggregator->is_multi_distinct_count()) {
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
+        _aggregator->finish_multi_distinct_set();
+    } else if (!_aggregator->is_none_group_by_exprs()) {
+        if (_aggregator->has_spilled()) {
+            // The groups are spread over the spilled partitions, which are aggregated again one by one.
+            RETURN_IF_ERROR(_aggregator->finish_spill(state));
+            RETURN_IF_ERROR(_aggregator->restore_next_spilled_partition(state));
+        } else {
+            // If hash map is empty, we don't need to return value
+            if (_aggregator->hash_map_variant().size() == 0) {
+                _aggregator->set_finished();
+            }
+            _aggregator->init_hash_map_iterator();
+            _start_partition_streams();
         }
-#define HASH_MAP_METHOD(NAME) \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME) _it_hash = _hash_map_variant.NAME->hash_map.begin();
-        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-    } else if (_group_by_expr_ctxs.empty()) {
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+    } else {
         // for aggregate no group by, if _num_input_rows is 0,
         // In update phase, we directly return empty chunk.
         // In merge phase, we will handle it.
-        if (_num_input_rows == 0 && !_needs_finalize) {
-            _is_finished = true;
+        if (_aggregator->num_input_rows() == 0 && !_aggregator->needs_finalize()) {
+            _aggregator->set_finished();
         }
     }
-    COUNTER_SET(_input_row_count, _num_input_rows);
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
     return Status::OK();
 }
 
@@ -93,25 +131,53 @@ Status AggregateBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     RETURN_IF_CANCELLED(state);
     *eos = false;
 
-    if (_is_finished) {
-        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    if (_cached_chunks != nullptr) {
+        if (_next_cached_chunk == _cached_chunks->size()) {
+            COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+            *eos = true;
+            return Status::OK();
+        }
+        // the cached chunks are shared, the parent gets a copy of them
+        const ChunkPtr& cached_chunk = (*_cached_chunks)[_next_cached_chunk++];
+        *chunk = cached_chunk->clone_empty_with_slot(cached_chunk->num_rows());
+        (*chunk)->append(*cached_chunk);
+        _num_rows_returned += (*chunk)->num_rows();
+        return Status::OK();
+    }
+
+    ChunkPtr partition_chunk;
+    if (!_partition_streams.empty() && !_aggregator->is_finished()) {
+        partition_chunk = _next_partition_chunk();
+        if (partition_chunk == nullptr) {
+            _aggregator->set_finished();
+        }
+    }
+
+    // Output the next spilled partition after the current one is output.
+    while (_aggregator->is_finished() && !reached_limit() && _aggregator->has_unrestored_spilled_partitions()) {
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(_aggregator->restore_next_spilled_partition(state));
+    }
+    if (_aggregator->is_finished()) {
+        COUNTER_SET(_rows_returned_counter, _aggregator->num_rows_returned());
+        if (_chunks_to_cache != nullptr) {
+            AggResultCache::instance()->insert(_tnode.agg_node.cache_digest, _cache_tablet_id, _cache_version,
+                                               std::move(_chunks_to_cache));
+        }
         *eos = true;
         return Status::OK();
     }
     int32_t chunk_size = config::vector_chunk_size;
 
-    if (_group_by_expr_ctxs.empty()) {
-        SCOPED_TIMER(_get_results_timer);
-        _convert_to_chunk_no_groupby(chunk);
+    if (partition_chunk != nullptr) {
+        _aggregator->update_num_rows_returned(partition_chunk->num_rows());
+        *chunk = std::move(partition_chunk);
+    } else if (_aggregator->is_multi_distinct_count()) {
+        _aggregator->convert_multi_distinct_set_to_chunk(chunk_size, chunk);
+    } else if (_aggregator->is_none_group_by_exprs()) {
+        _aggregator->convert_to_chunk_no_groupby(chunk);
     } else {
-        if (false) {
-        }
-#define HASH_MAP_METHOD(NAME)                                                                                   \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                              \
-            _convert_hash_map_to_chunk<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, \
-                                                                                       chunk_size, chunk);
-        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
+        _aggregator->convert_hash_map_to_chunk(chunk_size, chunk);
     }
 
     eval_join_runtime_filters(chunk->get());
@@ -119,12 +185,147 @@ Status AggregateBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     // For having
     size_t old_size = (*chunk)->num_rows();
     ExecNode::eval_conjuncts(_conjunct_ctxs, (*chunk).get());
-    _num_rows_returned -= (old_size - (*chunk)->num_rows());
+    _aggregator->update_num_rows_returned(-static_cast<int64_t>(old_size - (*chunk)->num_rows()));
 
     _process_limit(chunk);
 
+    if (_chunks_to_cache != nullptr) {
+        _add_chunk_to_cache(*chunk);
+    }
+
     DCHECK_CHUNK(*chunk);
     return Status::OK();
 }
 
-} // namespace starrocks::vectorized
\ No newline at end of file
+Status AggregateBlockingNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    // The threads convert the hash map of the aggregator.
+    _stop_partition_streams();
+    return AggregateBaseNode::close(state);
+}
+
+void AggregateBlockingNode::_start_partition_streams() {
+    const size_t num_partitions = _aggregator->num_hash_map_partitions();
+    const size_t parallelism = std::min<size_t>(std::max(config::agg_finalize_parallelism, 1), num_partitions);
+    if (parallelism <= 1 || _aggregator->hash_map_variant().size() < parallelism * config::vector_chunk_size) {
+        return;
+    }
+    const int32_t chunk_size = config::vector_chunk_size;
+    for (size_t i = 0; i < parallelism; i++) {
+        auto stream = std::make_unique<PartitionStream>();
+        stream->thread = std::thread([this, s = stream.get(), i, parallelism, num_partitions, chunk_size,
+                                      mem_tracker = CurrentThread::mem_tracker()]() {
+            CurrentThread::set_mem_tracker(mem_tracker);
+            bool running = true;
+            for (size_t partition = i; partition < num_partitions && running; partition += parallelism) {
+                _aggregator->convert_hash_map_partition_to_chunks(partition, chunk_size, [&](ChunkPtr chunk) {
+                    // false after the queue is shutdown
+                    running = s->queue.blocking_put(chunk);
+                    return running;
+                });
+            }
+            s->queue.blocking_put(nullptr);
+        });
+        _partition_streams.emplace_back(std::move(stream));
+    }
+}
+
+ChunkPtr AggregateBlockingNode::_next_partition_chunk() {
+    while (_num_finished_partition_streams < _partition_streams.size()) {
+        auto& stream = _partition_streams[_next_partition_stream];
+        _next_partition_stream = (_next_partition_stream + 1) % _partition_streams.size();
+        if (stream->eos) {
+            continue;
+        }
+        ChunkPtr chunk;
+        if (!stream->queue.blocking_get(&chunk) || chunk == nullptr) {
+            stream->eos = true;
+            _num_finished_partition_streams++;
+            continue;
+        }
+        return chunk;
+    }
+    return nullptr;
+}
+
+void AggregateBlockingNode::_stop_partition_streams() {
+    for (auto& stream : _partition_streams) {
+        stream->queue.shutdown();
+    }
+    for (auto& stream : _partition_streams) {
+        if (stream->thread.joinable()) {
+            stream->thread.join();
+        }
+    }
+}
+
+bool AggregateBlockingNode::_init_result_cache_key() {
+    if (AggResultCache::instance() == nullptr || !_tnode.agg_node.__isset.cache_digest ||
+        _aggregator->needs_finalize() || _limit != -1 || !_runtime_filter_collector.empty()) {
+        return false;
+    }
+    auto* scan_node = dynamic_cast<OlapScanNode*>(_children[0]);
+    if (scan_node == nullptr || !scan_node->runtime_filter_collector().empty() ||
+        scan_node->scan_ranges().size() != 1) {
+        return false;
+    }
+    const TInternalScanRange& range = *scan_node->scan_ranges()[0];
+    _cache_tablet_id = range.tablet_id;
+    _cache_version = strtoll(range.version.c_str(), nullptr, 10);
+    return true;
+}
+
+void AggregateBlockingNode::_add_chunk_to_cache(const ChunkPtr& chunk) {
+    if (chunk->is_empty()) {
+        return;
+    }
+    _bytes_to_cache += chunk->memory_usage();
+    if (_bytes_to_cache > config::agg_result_cache_max_entry_bytes) {
+        _chunks_to_cache.reset();
+        return;
+    }
+    ChunkPtr copy = chunk->clone_empty_with_slot(chunk->num_rows());
+    copy->append(*chunk);
+    _chunks_to_cache->emplace_back(std::move(copy));
+}
+
+pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    OpFactories operators_with_sink = _children[0]->decompose_to_pipeline(context);
+    // The blocking aggregation produces the final result of all the input, so the input streams are
+    // partitioned by the group by keys, each driver aggregates a disjoint set of groups. Without group by,
+    // the input streams must be gathered into one stream before piping into the sink operator.
+    if (_group_by_expr_ctxs.empty()) {
+        operators_with_sink = context->maybe_interpolate_local_passthrough_exchange(operators_with_sink);
+    } else {
+        operators_with_sink =
+                context->maybe_interpolate_local_shuffle_exchange(operators_with_sink, _group_by_expr_ctxs);
+    }
+
+    // shared by sink operator and source operator
+    auto aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    auto sink_operator = std::make_shared<AggregateBlockingSinkOperatorFactory>(context->next_operator_id(), id(),
+                                                                                aggregator_factory);
+    operators_with_sink.emplace_back(std::move(sink_operator));
+    context->add_pipeline(operators_with_sink);
+
+    OpFactories operators_with_source;
+    auto source_operator = std::make_shared<AggregateBlockingSourceOperatorFactory>(
+            context->next_operator_id(), id(), aggregator_factory, std::move(_conjunct_ctxs));
+    // Aggregator must be used by a pair of sink and source operators,
+    // so operators_with_source's degree of parallelism must be equal with operators_with_sink's
+    source_operator->set_degree_of_parallelism(
+            down_cast<SourceOperatorFactory*>(operators_with_sink[0].get())->degree_of_parallelism());
+    operators_with_source.emplace_back(std::move(source_operator));
+    if (limit() != -1) {
+        // The limit applies to the output of all the aggregators.
+        operators_with_source = context->maybe_interpolate_local_passthrough_exchange(operators_with_source);
+        operators_with_source.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators_with_source;
+}
+
+} // namespace starrocks::vectorized
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "exec/vectorized/aggregate/agg_result_cache.h"
 #include "exec/vectorized/aggregate/aggregate_base_node.h"
 
 // Aggregate means this node handle query with aggregate functions.
@@ -10,10 +11,43 @@ namespace starrocks::vectorized {
 class AggregateBlockingNode final : public AggregateBaseNode {
 public:
     AggregateBlockingNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-            : AggregateBaseNode(pool, tnode, descs) {
-        _aggr_phase = AggrPhase2;
-    };
+            : AggregateBaseNode(pool, tnode, descs){};
+    ~AggregateBlockingNode() override;
     Status open(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
+private:
+    struct PartitionStream;
+
+    // Convert the sub-maps of the two-level hash map to chunks by config::agg_finalize_parallelism threads, if there
+    // are enough groups.
+    void _start_partition_streams();
+    // The next chunk of the partition streams in turn, or nullptr if all of them are output.
+    ChunkPtr _next_partition_chunk();
+    void _stop_partition_streams();
+
+    // Return true and set the key of AggResultCache if the partial results are determined by the version of the
+    // single tablet scanned by the child, i.e. the FE sets the digest, and no runtime filter or limit applies.
+    bool _init_result_cache_key();
+
+    // Keep a copy of |chunk| to be cached at eos, give up caching if the results are too large.
+    void _add_chunk_to_cache(const ChunkPtr& chunk);
+
+    int64_t _cache_tablet_id = -1;
+    int64_t _cache_version = -1;
+    // the results hit the cache, which are output instead of aggregating the input
+    std::shared_ptr<const AggResultCache::Chunks> _cached_chunks;
+    size_t _next_cached_chunk = 0;
+    // the results output so far to be cached at eos, nullptr if not to be cached
+    std::shared_ptr<AggResultCache::Chunks> _chunks_to_cache;
+    size_t _bytes_to_cache = 0;
+
+    std::vector<std::unique_ptr<PartitionStream>> _partition_streams;
+    size_t _next_partition_stream = 0;
+    size_t _num_finished_partition_streams = 0;
 };
 } // namespace starrocks::vectorized
@@ -11,13 +11,14 @@ namespace starrocks::vectorized {
 class AggregateStreamingNode final : public AggregateBaseNode {
 public:
     AggregateStreamingNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-            : AggregateBaseNode(pool, tnode, descs) {
-        _aggr_phase = AggrPhase1;
-    };
+            : AggregateBaseNode(pool, tnode, descs){};
     Status open(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
 
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
 private:
     void _output_chunk_from_hash_map(ChunkPtr* chunk);
 };
-} // namespace starrocks::vectorized
\ No newline at end of file
+} // namespace starrocks::vectorized
@@ -10,9 +10,7 @@ namespace starrocks::vectorized {
 class DistinctBlockingNode final : public AggregateBaseNode {
 public:
     DistinctBlockingNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-            : AggregateBaseNode(pool, tnode, descs) {
-        _aggr_phase = AggrPhase2;
-    };
+            : AggregateBaseNode(pool, tnode, descs){};
     Status open(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
 };
@@ -11,9 +11,7 @@ namespace starrocks::vectorized {
 class DistinctStreamingNode final : public AggregateBaseNode {
 public:
     DistinctStreamingNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-            : AggregateBaseNode(pool, tnode, descs) {
-        _aggr_phase = AggrPhase1;
-    };
+            : AggregateBaseNode(pool, tnode, descs){};
     Status open(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
 
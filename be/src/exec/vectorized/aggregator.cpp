@@ -0,0 +1,1347 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/aggregator.h"
+
+#include "exprs/anyval_util.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::vectorized {
+
+Aggregator::Aggregator(const TPlanNode& tnode)
+        : _tnode(tnode),
+          _needs_finalize(tnode.agg_node.need_finalize),
+          _limit(tnode.limit),
+          _streaming_preaggregation_mode(tnode.agg_node.streaming_preaggregation_mode),
+          _intermediate_tuple_id(tnode.agg_node.intermediate_tuple_id),
+          _output_tuple_id(tnode.agg_node.output_tuple_id) {
+    // Streaming aggregation is always the first phase of a multi phase aggregation
+    bool is_streaming =
+            tnode.agg_node.__isset.use_streaming_preaggregation && tnode.agg_node.use_streaming_preaggregation;
+    _aggr_phase = is_streaming ? AggrPhase1 : AggrPhase2;
+}
+
+Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile,
+                           MemTracker* mem_tracker) {
+    _pool = pool;
+    _runtime_profile = runtime_profile;
+    _mem_tracker = mem_tracker;
+
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, _tnode.agg_node.grouping_exprs, &_group_by_expr_ctxs));
+    // add profile attributes
+    if (_tnode.agg_node.__isset.sql_grouping_keys) {
+        _runtime_profile->add_info_string("GroupingKeys", _tnode.agg_node.sql_grouping_keys);
+    }
+    if (_tnode.agg_node.__isset.sql_aggregate_functions) {
+        _runtime_profile->add_info_string("AggregateFunctions", _tnode.agg_node.sql_aggregate_functions);
+    }
+
+    bool has_outer_join_child = _tnode.agg_node.__isset.has_outer_join_child && _tnode.agg_node.has_outer_join_child;
+    VLOG_ROW << "has_outer_join_child " << has_outer_join_child;
+
+    size_t group_by_size = _group_by_expr_ctxs.size();
+    _group_by_columns.resize(group_by_size);
+    _group_by_types.resize(group_by_size);
+    for (size_t i = 0; i < group_by_size; ++i) {
+        TExprNode expr = _tnode.agg_node.grouping_exprs[i].nodes[0];
+        _group_by_types[i].result_type = TypeDescriptor::from_thrift(expr.type);
+        _group_by_types[i].is_nullable = expr.is_nullable || has_outer_join_child;
+        _has_nullable_key = _has_nullable_key || _group_by_types[i].is_nullable;
+        VLOG_ROW << "group by column " << i << " result_type " << _group_by_types[i].result_type << " is_nullable "
+                 << expr.is_nullable;
+    }
+    VLOG_ROW << "has_nullable_key " << _has_nullable_key;
+
+    _tmp_agg_states.resize(config::vector_chunk_size);
+
+    size_t agg_size = _tnode.agg_node.aggregate_functions.size();
+    _agg_fn_ctxs.resize(agg_size);
+    _agg_functions.resize(agg_size);
+    _batch_udafs.resize(agg_size);
+    _agg_expr_ctxs.resize(agg_size);
+    _agg_intput_columns.resize(agg_size);
+    _agg_input_raw_columns.resize(agg_size);
+    _agg_fn_types.resize(agg_size);
+    _agg_states_offsets.resize(agg_size);
+    _is_merge_funcs.resize(agg_size);
+
+    for (int i = 0; i < agg_size; ++i) {
+        const TExpr& desc = _tnode.agg_node.aggregate_functions[i];
+        const TFunction& fn = desc.nodes[0].fn;
+        _is_merge_funcs[i] = _tnode.agg_node.aggregate_functions[i].nodes[0].agg_expr.is_merge_agg;
+        VLOG_ROW << fn.name.function_name << " is arg nullable " << desc.nodes[0].has_nullable_child;
+        VLOG_ROW << fn.name.function_name << " is result nullable " << desc.nodes[0].is_nullable;
+        if (fn.name.function_name == "count") {
+            {
+                bool is_input_nullable =
+                        !fn.arg_types.empty() && (has_outer_join_child || desc.nodes[0].has_nullable_child);
+                auto* func = get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, is_input_nullable);
+                _agg_functions[i] = func;
+            }
+            std::vector<FunctionContext::TypeDesc> arg_typedescs;
+            _agg_fn_types[i] = {TypeDescriptor(TYPE_BIGINT), TypeDescriptor(TYPE_BIGINT), arg_typedescs, false, false};
+            // count(*) no input column, we manually resize it to 1 to process count(*)
+            // like other agg function.
+            _agg_intput_columns[i].resize(1);
+        } else {
+            TypeDescriptor return_type = TypeDescriptor::from_thrift(fn.ret_type);
+            TypeDescriptor serde_type = TypeDescriptor::from_thrift(fn.aggregate_fn.intermediate_type);
+
+            // collect arg_typedescs for aggregate function.
+            std::vector<FunctionContext::TypeDesc> arg_typedescs;
+            for (auto& type : fn.arg_types) {
+                arg_typedescs.push_back(AnyValUtil::column_type_to_type_desc(TypeDescriptor::from_thrift(type)));
+            }
+
+            TypeDescriptor arg_type = TypeDescriptor::from_thrift(fn.arg_types[0]);
+            // Because intersect_count has more two input types.
+            // intersect_count's first argument's type is alwasy Bitmap,
+            // So we get its second arguments type as input.
+            if (fn.name.function_name == "intersect_count") {
+                arg_type = TypeDescriptor::from_thrift(fn.arg_types[1]);
+            }
+
+            bool is_input_nullable = has_outer_join_child || desc.nodes[0].has_nullable_child;
+            const AggregateFunction* func = nullptr;
+            if (fn.binary_type == TFunctionBinaryType::NATIVE) {
+                RETURN_IF_ERROR(BatchUdaf::create(fn, return_type, &_batch_udafs[i]));
+                func = _batch_udafs[i].get();
+            } else {
+                func = get_aggregate_function(fn.name.function_name, arg_type.type, return_type.type,
+                                              is_input_nullable);
+            }
+            if (func == nullptr) {
+                return Status::InternalError(
+                        strings::Substitute("Invalid agg function plan: $0", fn.name.function_name));
+            }
+            VLOG_ROW << "get agg function " << func->get_name() << " serde_type " << serde_type << " return_type "
+                     << return_type;
+            _agg_functions[i] = func;
+            _agg_fn_types[i] = {return_type, serde_type, arg_typedescs, is_input_nullable, desc.nodes[0].is_nullable};
+        }
+
+        int node_idx = 0;
+        for (int j = 0; j < desc.nodes[0].num_children; ++j) {
+            ++node_idx;
+            Expr* expr = nullptr;
+            ExprContext* ctx = nullptr;
+            RETURN_IF_ERROR(Expr::create_tree_from_thrift(_pool, desc.nodes, nullptr, &node_idx, &expr, &ctx));
+            _agg_expr_ctxs[i].emplace_back(ctx);
+        }
+        _agg_intput_columns[i].resize(desc.nodes[0].num_children);
+        _agg_input_raw_columns[i].resize(desc.nodes[0].num_children);
+    }
+
+    // compute agg state total size and offsets
+    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
+        _agg_states_offsets[i] = _agg_states_total_size;
+        _agg_states_total_size += _agg_functions[i]->size();
+        _max_agg_state_align_size = std::max(_max_agg_state_align_size, _agg_functions[i]->alignof_size());
+
+        // If not the last aggregate_state, we need pad it so that next aggregate_state will be aligned.
+        if (i + 1 < _agg_fn_ctxs.size()) {
+            size_t next_state_align_size = _agg_functions[i + 1]->alignof_size();
+            // Extend total_size to next alignment requirement
+            // Add padding by rounding up '_agg_states_total_size' to be a multiplier of next_state_align_size.
+            _agg_states_total_size = (_agg_states_total_size + next_state_align_size - 1) / next_state_align_size *
+                                     next_state_align_size;
+        }
+    }
+
+    _is_only_group_by_columns = _agg_expr_ctxs.empty() && !_group_by_expr_ctxs.empty();
+
+    // The fused hash set can't be spilled.
+    _is_multi_distinct_count = config::enable_multi_distinct_count_single_hash_set && !_group_by_expr_ctxs.empty() &&
+                               !_agg_expr_ctxs.empty() && _needs_finalize && !state->enable_spill();
+    for (size_t i = 0; i < agg_size && _is_multi_distinct_count; ++i) {
+        _is_multi_distinct_count = _tnode.agg_node.aggregate_functions[i].nodes[0].fn.name.function_name ==
+                                           "multi_distinct_count" &&
+                                   !_is_merge_funcs[i] && _agg_expr_ctxs[i].size() == 1;
+    }
+
+    // The groups of an aggregation whose states are merged later can't be limited, as the rows skipped would miss
+    // the merged states, except the streaming ones, which pass the rows through instead of skipping them. Neither
+    // can the groups of a spilled aggregation, whose later rows of the groups spilled would be skipped.
+    const bool may_spill = state->enable_spill() && _aggr_phase == AggrPhase2 && !_is_only_group_by_columns;
+    _limits_groups = _limit > 0 && !_group_by_expr_ctxs.empty() && _tnode.conjuncts.empty() &&
+                     !_is_multi_distinct_count && !may_spill &&
+                     (_aggr_phase == AggrPhase1 || _needs_finalize || _is_only_group_by_columns);
+
+    _get_results_timer = ADD_TIMER(_runtime_profile, "GetResultsTime");
+    _iter_timer = ADD_TIMER(_runtime_profile, "ResultIteratorTime");
+    _agg_append_timer = ADD_TIMER(_runtime_profile, "ResultAggAppendTime");
+    _group_by_append_timer = ADD_TIMER(_runtime_profile, "ResultGroupByAppendTime");
+    //TODO: split agg_compute_timer to cunstruct_ht_time + agg_func_compute_time
+    _agg_compute_timer = ADD_TIMER(_runtime_profile, "AggComputeTime");
+    _streaming_timer = ADD_TIMER(_runtime_profile, "StreamingTime");
+    _expr_compute_timer = ADD_TIMER(_runtime_profile, "ExprComputeTime");
+    _expr_release_timer = ADD_TIMER(_runtime_profile, "ExprReleaseTime");
+
+    _input_row_count = ADD_COUNTER(_runtime_profile, "InputRowCount", TUnit::UNIT);
+    _hash_table_size = ADD_COUNTER(_runtime_profile, "HashTableSize", TUnit::UNIT);
+    _pass_through_row_count = ADD_COUNTER(_runtime_profile, "PassThroughRowCount", TUnit::UNIT);
+
+    _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
+    _output_tuple_desc = state->desc_tbl().get_tuple_descriptor(_output_tuple_id);
+    DCHECK_EQ(_intermediate_tuple_desc->slots().size(), _output_tuple_desc->slots().size());
+
+    // The vectorized exprs don't depend on the row descriptor
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(Expr::prepare(_group_by_expr_ctxs, state, row_desc, _mem_tracker));
+    for (const auto& ctx : _agg_expr_ctxs) {
+        RETURN_IF_ERROR(Expr::prepare(ctx, state, row_desc, _mem_tracker));
+    }
+
+    _mem_pool = std::make_unique<MemPool>(_mem_tracker);
+
+    // Initial for FunctionContext of every aggregate functions
+    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
+        _agg_fn_ctxs[i] = FunctionContextImpl::create_context(
+                state, _mem_pool.get(), AnyValUtil::column_type_to_type_desc(_agg_fn_types[i].result_type),
+                _agg_fn_types[i].arg_typedescs, 0, false);
+        state->obj_pool()->add(_agg_fn_ctxs[i]);
+        if (_batch_udafs[i] != nullptr) {
+            _batch_udafs[i]->set_context(_agg_fn_ctxs[i]);
+        }
+    }
+
+    if (_group_by_expr_ctxs.empty()) {
+        _single_agg_state = _allocate_agg_state();
+        if (_agg_expr_ctxs.empty()) {
+            return Status::InternalError("Invalid agg query plan");
+        }
+    }
+
+    // The hash table of the streaming pre-aggregation is bounded by the streaming, so it's not pre-sized.
+    const auto& agg_node = _tnode.agg_node;
+    if (_aggr_phase == AggrPhase2 && !_group_by_expr_ctxs.empty() && config::hash_table_max_presize_rows > 0) {
+        if (agg_node.__isset.estimated_ndv && agg_node.estimated_ndv > 0) {
+            _estimated_num_groups = std::min<int64_t>(agg_node.estimated_ndv, config::hash_table_max_presize_rows);
+        } else if (agg_node.__isset.estimated_input_rows && agg_node.estimated_input_rows > 0) {
+            _presize_input_rows = agg_node.estimated_input_rows;
+        }
+    }
+
+    // For SQL: select distinct id from table or select id from from table group by id;
+    // we don't need to allocate memory for agg states.
+    if (_is_only_group_by_columns) {
+        _init_agg_hash_variant(_hash_set_variant, _estimated_num_groups);
+    } else {
+        _init_agg_hash_variant(_hash_map_variant, _estimated_num_groups);
+    }
+    if (_is_multi_distinct_count) {
+        _hash_set_variant.init(HashSetVariant::Type::phase2_slice);
+    }
+
+    if (_group_by_expr_ctxs.empty()) {
+        _compute_agg_states = &Aggregator::compute_single_agg_state;
+    } else {
+        _compute_agg_states = &Aggregator::compute_batch_agg_states;
+    }
+
+    // determine serialize or finalize function
+    if (_needs_finalize) {
+        _serialize_or_finalize = &Aggregator::_finalize_to_chunk;
+    } else {
+        _serialize_or_finalize = &Aggregator::_serialize_to_chunk;
+    }
+    return Status::OK();
+}
+
+Status Aggregator::open(RuntimeState* state) {
+    RETURN_IF_ERROR(Expr::open(_group_by_expr_ctxs, state));
+    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
+        RETURN_IF_ERROR(Expr::open(_agg_expr_ctxs[i], state));
+    }
+
+    // Initial for FunctionContext of every aggregate functions
+    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
+        // initial const columns for i'th FunctionContext.
+        _evaluate_const_columns(i);
+    }
+    return Status::OK();
+}
+
+Status Aggregator::close(RuntimeState* state) {
+    if (_is_closed) {
+        return Status::OK();
+    }
+    _is_closed = true;
+
+    for (auto ctx : _agg_fn_ctxs) {
+        if (ctx != nullptr && ctx->impl()) {
+            ctx->impl()->close();
+        }
+    }
+
+    // _mem_pool is nullptr means prepare phase failed
+    if (_mem_pool != nullptr) {
+        // Note: we must free agg_states object before _mem_pool free_all;
+        if (_single_agg_state != nullptr) {
+            for (int i = 0; i < _agg_functions.size(); i++) {
+                _agg_functions[i]->destroy(_single_agg_state + _agg_states_offsets[i]);
+            }
+        } else if (!_is_only_group_by_columns) {
+            if (false) {
+            }
+#define HASH_MAP_METHOD(NAME)                                      \
+    else if (_hash_map_variant.type == HashMapVariant::Type::NAME) \
+            _release_agg_memory<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME);
+            APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+        }
+
+        _mem_pool->free_all();
+    }
+
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->release(_last_agg_func_memory_usage);
+        _mem_tracker->release(_last_ht_memory_usage);
+    }
+
+    Expr::close(_group_by_expr_ctxs, state);
+    for (const auto& i : _agg_expr_ctxs) {
+        Expr::close(i, state);
+    }
+    // Remove the temporary files of the spilled partitions
+    _spiller.reset();
+    return Status::OK();
+}
+
+bool Aggregator::is_chunk_buffer_empty() {
+    std::lock_guard<std::mutex> l(_buffer_mutex);
+    return _buffer.empty();
+}
+
+bool Aggregator::is_chunk_buffer_full() {
+    std::lock_guard<std::mutex> l(_buffer_mutex);
+    return _buffer.size() >= max_chunk_buffer_size;
+}
+
+ChunkPtr Aggregator::poll_chunk_buffer() {
+    std::lock_guard<std::mutex> l(_buffer_mutex);
+    if (_buffer.empty()) {
+        return nullptr;
+    }
+    ChunkPtr chunk = _buffer.front();
+    _buffer.pop();
+    return chunk;
+}
+
+void Aggregator::offer_chunk_to_buffer(const ChunkPtr& chunk) {
+    std::lock_guard<std::mutex> l(_buffer_mutex);
+    _buffer.push(chunk);
+}
+
+bool Aggregator::should_expand_preagg_hash_tables(size_t input_chunk_size, int64_t ht_mem, int64_t ht_rows) const {
+    // Need some rows in tables to have valid statistics.
+    if (ht_rows == 0) {
+        return true;
+    }
+
+    // Find the appropriate reduction factor in our table for the current hash table sizes.
+    int cache_level = 0;
+    while (cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE &&
+           ht_mem >= STREAMING_HT_MIN_REDUCTION[cache_level + 1].min_ht_mem) {
+        cache_level++;
+    }
+
+    // Compare the number of rows in the hash table with the number of input rows that
+    // were aggregated into it. Exclude passed through rows from this calculation since
+    // they were not in hash tables.
+    const int64_t input_rows = _num_input_rows - input_chunk_size;
+    const int64_t aggregated_input_rows = input_rows - _num_rows_returned;
+    double current_reduction = static_cast<double>(aggregated_input_rows) / ht_rows;
+
+    // inaccurate, which could lead to a divide by zero below.
+    if (aggregated_input_rows <= 0) {
+        return true;
+    }
+    // Extrapolate the current reduction factor (r) using the formula
+    // R = 1 + (N / n) * (r - 1), where R is the reduction factor over the full input data
+    // set, N is the number of input rows, excluding passed-through rows, and n is the
+    // number of rows inserted or merged into the hash tables. This is a very rough
+    // approximation but is good enough to be useful.
+    double min_reduction = STREAMING_HT_MIN_REDUCTION[cache_level].streaming_ht_min_reduction;
+    return current_reduction > min_reduction;
+}
+
+void Aggregator::_evaluate_const_columns(int i) {
+    // used for const columns.
+    std::vector<ColumnPtr> const_columns;
+    const_columns.reserve(_agg_expr_ctxs[i].size());
+    for (int j = 0; j < _agg_expr_ctxs[i].size(); ++j) {
+        const_columns.emplace_back(_agg_expr_ctxs[i][j]->root()->evaluate_const(_agg_expr_ctxs[i][j]));
+    }
+    _agg_fn_ctxs[i]->impl()->set_constant_columns(const_columns);
+}
+
+void Aggregator::compute_single_agg_state(size_t chunk_size) {
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        if (!_is_merge_funcs[i]) {
+            _agg_functions[i]->update_batch_single_state(_agg_fn_ctxs[i], chunk_size, _agg_input_raw_columns[i].data(),
+                                                         _single_agg_state + _agg_states_offsets[i]);
+        } else {
+            DCHECK_EQ(_agg_intput_columns[i].size(), 1);
+            _agg_functions[i]->merge_batch_single_state(_agg_fn_ctxs[i], chunk_size, _agg_intput_columns[i][0].get(),
+                                                        _single_agg_state + _agg_states_offsets[i]);
+        }
+    }
+}
+
+void Aggregator::compute_batch_agg_states(size_t chunk_size) {
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        if (!_is_merge_funcs[i]) {
+            _agg_functions[i]->update_batch(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
+                                            _agg_input_raw_columns[i].data(), _tmp_agg_states.data());
+        } else {
+            DCHECK_EQ(_agg_intput_columns[i].size(), 1);
+            _agg_functions[i]->merge_batch(_agg_fn_ctxs[i], _agg_intput_columns[i][0]->size(), _agg_states_offsets[i],
+                                           _agg_intput_columns[i][0].get(), _tmp_agg_states.data());
+        }
+    }
+}
+
+void Aggregator::compute_batch_agg_states(size_t chunk_size, const std::vector<uint8_t>& selection) {
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        _agg_functions[i]->update_batch_selectively(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
+                                                    _agg_input_raw_columns[i].data(), _tmp_agg_states.data(),
+                                                    selection);
+    }
+}
+
+void Aggregator::evaluate_exprs(Chunk* chunk) {
+    {
+        SCOPED_TIMER(_expr_release_timer);
+        for (size_t i = 0; i < _group_by_expr_ctxs.size(); i++) {
+            _group_by_columns[i] = nullptr;
+        }
+
+        for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+            for (size_t j = 0; j < _agg_expr_ctxs[i].size(); j++) {
+                _agg_intput_columns[i][j] = nullptr;
+                _agg_input_raw_columns[i][j] = nullptr;
+            }
+        }
+    }
+
+    {
+        SCOPED_TIMER(_expr_compute_timer);
+        // Compute group by columns
+        for (size_t i = 0; i < _group_by_expr_ctxs.size(); i++) {
+            _group_by_columns[i] = _group_by_expr_ctxs[i]->evaluate(chunk);
+            DCHECK(_group_by_columns[i] != nullptr);
+            if (_group_by_columns[i]->is_constant()) {
+                // If group by column is constant, we disable streaming aggregate.
+                // Because we don't want to send const column to exchange node
+                _streaming_preaggregation_mode = TStreamingPreaggregationMode::FORCE_PREAGGREGATION;
+                // All hash table could handle only null, and we don't know the real data
+                // type for only null column, so we don't unpack it.
+                if (!_group_by_columns[i]->only_null()) {
+                    ConstColumn* const_column = static_cast<ConstColumn*>(_group_by_columns[i].get());
+                    const_column->data_column()->assign(chunk->num_rows(), 0);
+                    _group_by_columns[i] = const_column->data_column();
+                } else if (_has_fixed_size_keys) {
+                    // The packed keys need the data of each column, which is known by the group by type.
+                    ColumnPtr column = ColumnHelper::create_column(_group_by_types[i].result_type, true);
+                    [[maybe_unused]] bool ok = column->append_nulls(chunk->num_rows());
+                    _group_by_columns[i] = std::move(column);
+                }
+            }
+            // Scalar function compute will return non-nullable column
+            // for nullable column when the real whole chunk data all not-null.
+            if (_group_by_types[i].is_nullable && !_group_by_columns[i]->is_nullable()) {
+                // TODO: optimized the memory usage
+                _group_by_columns[i] = NullableColumn::create(_group_by_columns[i],
+                                                              NullColumn::create(_group_by_columns[i]->size(), 0));
+            }
+        }
+
+        // Compute agg function columns
+        for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+            for (size_t j = 0; j < _agg_expr_ctxs[i].size(); j++) {
+                // For simplicity and don't change the overall processing flow,
+                // We handle const column as normal data column
+                // TODO(kks): improve const column aggregate later
+                if (j == 0) {
+                    _agg_intput_columns[i][j] = ColumnHelper::unpack_and_duplicate_const_column(
+                            chunk->num_rows(), _agg_expr_ctxs[i][j]->evaluate(chunk));
+                } else {
+                    _agg_intput_columns[i][j] = _agg_expr_ctxs[i][j]->evaluate(chunk);
+                }
+                _agg_input_raw_columns[i][j] = _agg_intput_columns[i][j].get();
+            }
+        }
+    }
+
+    // A lazily filtered chunk is compacted only in the evaluated columns, instead of all the columns of it.
+    if (chunk->has_selection()) {
+        SCOPED_TIMER(_expr_compute_timer);
+        const auto& selection = chunk->selection();
+        auto select = [&selection](const ColumnPtr& column) {
+            ColumnPtr selected = column->clone_empty();
+            selected->append_selective(*column, selection.data(), 0, selection.size());
+            return selected;
+        };
+        for (auto& column : _group_by_columns) {
+            column = select(column);
+        }
+        for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+            for (size_t j = 0; j < _agg_expr_ctxs[i].size(); j++) {
+                _agg_intput_columns[i][j] = select(_agg_intput_columns[i][j]);
+                _agg_input_raw_columns[i][j] = _agg_intput_columns[i][j].get();
+            }
+        }
+    }
+}
+
+void Aggregator::build_hash_map(size_t chunk_size) {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                                 \
+    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                            \
+            _build_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, chunk_size);
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    else {
+        DCHECK(false);
+    }
+    _presize_hash_map_by_sample(chunk_size);
+}
+
+void Aggregator::build_hash_map_with_selection(size_t chunk_size) {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                         \
+    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                    \
+            _build_hash_map<typename decltype(_hash_map_variant.NAME)::element_type>( \
+                    *_hash_map_variant.NAME, chunk_size, &_streaming_selection);
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    else {
+        DCHECK(false);
+    }
+}
+
+void Aggregator::build_hash_set(size_t chunk_size) {
+    if (false) {
+    }
+#define HASH_SET_METHOD(NAME)                                                                                 \
+    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                                            \
+            _build_hash_set<decltype(_hash_set_variant.NAME)::element_type>(*_hash_set_variant.NAME, chunk_size);
+    APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
+#undef HASH_SET_METHOD
+    else {
+        DCHECK(false);
+    }
+    _presize_hash_set_by_sample(chunk_size);
+}
+
+size_t Aggregator::_estimate_num_groups_by_sample(size_t num_sampled_groups, size_t chunk_size) {
+    const size_t num_sampled_rows = _num_input_rows + chunk_size;
+    if (_presize_input_rows == 0 || num_sampled_rows < config::agg_presize_sample_rows) {
+        return 0;
+    }
+    // The ratio of the first rows is about an upper bound of the ratio of all the rows, as the later rows mostly
+    // fall into the groups seen, so the estimate is capped to bound the memory reserved by an overestimate.
+    const double num_groups = static_cast<double>(num_sampled_groups) * _presize_input_rows / num_sampled_rows;
+    const size_t max_num_groups = std::min<size_t>(_presize_input_rows, config::hash_table_max_presize_rows);
+    _presize_input_rows = 0;
+    return std::min(static_cast<size_t>(num_groups), max_num_groups);
+}
+
+void Aggregator::_presize_hash_map_by_sample(size_t chunk_size) {
+    const size_t num_groups = _estimate_num_groups_by_sample(_hash_map_variant.size(), chunk_size);
+    if (num_groups <= _hash_map_variant.capacity()) {
+        return;
+    }
+    if (_is_two_level_size(num_groups) && (_hash_map_variant.type == HashMapVariant::Type::phase1_slice ||
+                                           _hash_map_variant.type == HashMapVariant::Type::phase2_slice)) {
+        _convert_to_two_level_map(num_groups);
+    } else {
+        _hash_map_variant.reserve(num_groups);
+    }
+}
+
+void Aggregator::_presize_hash_set_by_sample(size_t chunk_size) {
+    const size_t num_groups = _estimate_num_groups_by_sample(_hash_set_variant.size(), chunk_size);
+    if (num_groups > _hash_set_variant.capacity()) {
+        _hash_set_variant.reserve(num_groups);
+    }
+}
+
+void Aggregator::build_hash_set_with_selection(size_t chunk_size) {
+    if (false) {
+    }
+#define HASH_SET_METHOD(NAME)                                                         \
+    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                    \
+            _build_hash_set<typename decltype(_hash_set_variant.NAME)::element_type>( \
+                    *_hash_set_variant.NAME, chunk_size, &_streaming_selection);
+    APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
+#undef HASH_SET_METHOD
+    else {
+        DCHECK(false);
+    }
+}
+
+void Aggregator::init_hash_map_iterator() {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME) \
+    else if (_hash_map_variant.type == HashMapVariant::Type::NAME) _it_hash = _hash_map_variant.NAME->hash_map.begin();
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    else {
+        DCHECK(false);
+    }
+}
+
+void Aggregator::init_hash_set_iterator() {
+    if (false) {
+    }
+#define HASH_SET_METHOD(NAME) \
+    else if (_hash_set_variant.type == HashSetVariant::Type::NAME) _it_hash = _hash_set_variant.NAME->hash_set.begin();
+    APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
+#undef HASH_SET_METHOD
+    else {
+        DCHECK(false);
+    }
+}
+
+void Aggregator::convert_hash_map_to_chunk(int32_t chunk_size, ChunkPtr* chunk) {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                                   \
+    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                              \
+            _convert_hash_map_to_chunk<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, \
+                                                                                       chunk_size, chunk);
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    else {
+        DCHECK(false);
+    }
+}
+
+size_t Aggregator::num_hash_map_partitions() const {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME) \
+    else if (_hash_map_variant.type == HashMapVariant::Type::NAME) return _hash_map_variant.NAME->hash_map.subcnt();
+    APPLY_FOR_TWO_LEVEL_VARIANT(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    return 0;
+}
+
+void Aggregator::convert_hash_map_partition_to_chunks(size_t partition, int32_t chunk_size,
+                                                      const std::function<bool(ChunkPtr)>& consumer) {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                          \
+    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                     \
+            _convert_hash_map_partition_to_chunks<decltype(_hash_map_variant.NAME)::element_type>(     \
+                    *_hash_map_variant.NAME, partition, chunk_size, consumer);
+    APPLY_FOR_TWO_LEVEL_VARIANT(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    else {
+        DCHECK(false);
+    }
+}
+
+ChunkPtr Aggregator::_build_result_chunk(const Columns& group_by_columns, const Columns& agg_result_columns) const {
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    // For different agg phase, we should use different TupleDescriptor
+    TupleDescriptor* tuple_desc = _needs_finalize ? _output_tuple_desc : _intermediate_tuple_desc;
+    for (size_t i = 0; i < group_by_columns.size(); i++) {
+        result_chunk->append_column(group_by_columns[i], tuple_desc->slots()[i]->id());
+    }
+    for (size_t i = 0; i < agg_result_columns.size(); i++) {
+        size_t id = group_by_columns.size() + i;
+        result_chunk->append_column(agg_result_columns[i], tuple_desc->slots()[id]->id());
+    }
+    return result_chunk;
+}
+
+void Aggregator::convert_hash_set_to_chunk(int32_t chunk_size, ChunkPtr* chunk) {
+    if (false) {
+    }
+#define HASH_SET_METHOD(NAME)                                                                                   \
+    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                                              \
+            _convert_hash_set_to_chunk<decltype(_hash_set_variant.NAME)::element_type>(*_hash_set_variant.NAME, \
+                                                                                       chunk_size, chunk);
+    APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
+#undef HASH_SET_METHOD
+    else {
+        DCHECK(false);
+    }
+}
+
+void Aggregator::build_multi_distinct_set(size_t chunk_size) {
+    DCHECK(_is_multi_distinct_count);
+    auto& hash_set = *_hash_set_variant.phase2_slice;
+    const auto num_distinct = static_cast<int32_t>(_agg_fn_ctxs.size());
+
+    auto ids = Int32Column::create();
+    auto& id_data = ids->get_data();
+    Columns key_columns;
+    key_columns.reserve(_group_by_columns.size() + 2);
+    key_columns.emplace_back(ids);
+    key_columns.insert(key_columns.end(), _group_by_columns.begin(), _group_by_columns.end());
+    key_columns.emplace_back(nullptr);
+    for (int32_t i = 0; i < num_distinct; ++i) {
+        const ColumnPtr& values = _agg_intput_columns[i][0];
+        id_data.assign(chunk_size, i);
+        if (values->has_null()) {
+            const auto& nulls = down_cast<const NullableColumn*>(values.get())->immutable_null_column_data();
+            for (size_t row = 0; row < chunk_size; ++row) {
+                if (nulls[row]) {
+                    id_data[row] = num_distinct;
+                }
+            }
+        }
+        key_columns.back() = values;
+        hash_set.build_set(chunk_size, key_columns, _mem_pool.get());
+    }
+}
+
+void Aggregator::finish_multi_distinct_set() {
+    DCHECK(_is_multi_distinct_count);
+    SCOPED_TIMER(_get_results_timer);
+    auto& hash_set = _hash_set_variant.phase2_slice->hash_set;
+    const auto num_distinct = static_cast<int32_t>(_agg_fn_ctxs.size());
+
+    Columns group_by_columns = _create_group_by_columns();
+    std::vector<Int64Column::Ptr> counts(num_distinct);
+    for (auto& count : counts) {
+        count = Int64Column::create();
+    }
+    // The serialized group by keys of each group to its row in the result.
+    phmap::flat_hash_map<Slice, uint32_t, SliceHashWithSeed<PhmapSeed1>, SliceEqual> groups;
+    for (const auto& key : hash_set) {
+        int32_t id;
+        memcpy(&id, key.data, sizeof(int32_t));
+        const auto* group_start = reinterpret_cast<const uint8_t*>(key.data) + sizeof(int32_t);
+        const uint8_t* group_end = group_start;
+        for (auto& column : group_by_columns) {
+            group_end = column->deserialize_and_append(group_end);
+        }
+
+        auto [it, inserted] =
+                groups.emplace(Slice(group_start, group_end - group_start), static_cast<uint32_t>(groups.size()));
+        if (inserted) {
+            for (auto& count : counts) {
+                count->append(0);
+            }
+        } else {
+            // The group has been appended.
+            for (auto& column : group_by_columns) {
+                column->resize(column->size() - 1);
+            }
+        }
+        if (id < num_distinct) {
+            counts[id]->get_data()[it->second]++;
+        }
+    }
+
+    size_t num_groups = groups.size();
+    _multi_distinct_result = std::make_shared<Chunk>();
+    for (size_t i = 0; i < group_by_columns.size(); i++) {
+        _multi_distinct_result->append_column(group_by_columns[i], _output_tuple_desc->slots()[i]->id());
+    }
+    for (size_t i = 0; i < counts.size(); i++) {
+        ColumnPtr column = counts[i];
+        if (_agg_fn_types[i].has_nullable_child & _agg_fn_types[i].is_nullable) {
+            column = NullableColumn::create(column, NullColumn::create(num_groups, 0));
+        }
+        size_t id = group_by_columns.size() + i;
+        _multi_distinct_result->append_column(column, _output_tuple_desc->slots()[id]->id());
+    }
+    _multi_distinct_result_offset = 0;
+
+    // The keys in _mem_pool are released at close.
+    _hash_set_variant.init(HashSetVariant::Type::phase2_slice);
+    _mem_tracker->release(_last_ht_memory_usage);
+    _last_ht_memory_usage = 0;
+
+    if (num_groups == 0) {
+        _is_finished = true;
+    }
+}
+
+void Aggregator::convert_multi_distinct_set_to_chunk(int32_t chunk_size, ChunkPtr* chunk) {
+    DCHECK(_multi_distinct_result != nullptr);
+    size_t num_rows = std::min<size_t>(chunk_size, _multi_distinct_result->num_rows() - _multi_distinct_result_offset);
+    ChunkPtr result_chunk = _multi_distinct_result->clone_empty(num_rows);
+    result_chunk->append(*_multi_distinct_result, _multi_distinct_result_offset, num_rows);
+    _multi_distinct_result_offset += num_rows;
+
+    _is_finished = _multi_distinct_result_offset == _multi_distinct_result->num_rows();
+    _hash_table_eos = _is_finished;
+    if (_is_finished) {
+        _multi_distinct_result.reset();
+    }
+    _num_rows_returned += num_rows;
+    *chunk = std::move(result_chunk);
+}
+
+// When need finalize, create column by result type
+// otherwise, create column by serde type
+Columns Aggregator::_create_agg_result_columns() {
+    Columns agg_result_columns(_agg_fn_types.size());
+    if (_needs_finalize) {
+        for (size_t i = 0; i < _agg_fn_types.size(); ++i) {
+            // For count, count distinct, bitmap_union_int such as never return null function,
+            // we need to create a not-nullable column.
+            agg_result_columns[i] = ColumnHelper::create_column(
+                    _agg_fn_types[i].result_type, _agg_fn_types[i].has_nullable_child & _agg_fn_types[i].is_nullable);
+            agg_result_columns[i]->reserve(config::vector_chunk_size);
+        }
+    } else {
+        for (size_t i = 0; i < _agg_fn_types.size(); ++i) {
+            agg_result_columns[i] =
+                    ColumnHelper::create_column(_agg_fn_types[i].serde_type, _agg_fn_types[i].has_nullable_child);
+            agg_result_columns[i]->reserve(config::vector_chunk_size);
+        }
+    }
+    return agg_result_columns;
+}
+
+Columns Aggregator::_create_group_by_columns() {
+    Columns group_by_columns(_group_by_types.size());
+    for (size_t i = 0; i < _group_by_types.size(); ++i) {
+        group_by_columns[i] =
+                ColumnHelper::create_column(_group_by_types[i].result_type, _group_by_types[i].is_nullable);
+        group_by_columns[i]->reserve(config::vector_chunk_size);
+    }
+    return group_by_columns;
+}
+
+void Aggregator::_reuse_or_create_result_columns(Columns* group_by_columns, Columns* agg_result_columns) {
+    Columns columns;
+    if (_result_column_recycler.reuse(&columns)) {
+        const size_t num_group_by_columns = _group_by_types.size();
+        DCHECK_EQ(columns.size(), num_group_by_columns + _agg_fn_types.size());
+        group_by_columns->assign(columns.begin(), columns.begin() + num_group_by_columns);
+        agg_result_columns->assign(columns.begin() + num_group_by_columns, columns.end());
+        return;
+    }
+    *group_by_columns = _create_group_by_columns();
+    *agg_result_columns = _create_agg_result_columns();
+}
+
+void Aggregator::_keep_result_columns(const Columns& group_by_columns, const Columns& agg_result_columns) {
+    Columns columns;
+    columns.reserve(group_by_columns.size() + agg_result_columns.size());
+    columns.insert(columns.end(), group_by_columns.begin(), group_by_columns.end());
+    columns.insert(columns.end(), agg_result_columns.begin(), agg_result_columns.end());
+    _result_column_recycler.keep(std::move(columns));
+}
+
+void Aggregator::convert_to_chunk_no_groupby(ChunkPtr* chunk) {
+    SCOPED_TIMER(_get_results_timer);
+    // TODO(kks): we should approve memory allocate here
+    Columns agg_result_column = _create_agg_result_columns();
+    (this->*_serialize_or_finalize)(_single_agg_state, agg_result_column);
+
+    // For agg function column is non-nullable and table is empty
+    // sum(zero_row) should be null, not 0.
+    if (UNLIKELY(_num_input_rows == 0 && _group_by_expr_ctxs.empty() && _needs_finalize)) {
+        for (size_t i = 0; i < _agg_fn_types.size(); i++) {
+            if (_agg_fn_types[i].is_nullable) {
+                agg_result_column[i] = ColumnHelper::create_column(_agg_fn_types[i].result_type, true);
+                agg_result_column[i]->append_default();
+            }
+        }
+    }
+
+    TupleDescriptor* tuple_desc = nullptr;
+    if (_needs_finalize) {
+        tuple_desc = _output_tuple_desc;
+    } else {
+        tuple_desc = _intermediate_tuple_desc;
+    }
+
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    for (size_t i = 0; i < agg_result_column.size(); i++) {
+        result_chunk->append_column(std::move(agg_result_column[i]), tuple_desc->slots()[i]->id());
+    }
+    ++_num_rows_returned;
+    *chunk = std::move(result_chunk);
+    _is_finished = true;
+}
+
+void Aggregator::_serialize_to_chunk(ConstAggDataPtr state, const Columns& agg_result_columns) {
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        _agg_functions[i]->serialize_to_column(_agg_fn_ctxs[i], state + _agg_states_offsets[i],
+                                               agg_result_columns[i].get());
+    }
+}
+
+void Aggregator::_finalize_to_chunk(ConstAggDataPtr state, const Columns& agg_result_columns) {
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        _agg_functions[i]->finalize_to_column(_agg_fn_ctxs[i], state + _agg_states_offsets[i],
+                                              agg_result_columns[i].get());
+    }
+}
+
+void Aggregator::output_chunk_by_streaming(ChunkPtr* chunk) {
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    for (size_t i = 0; i < _group_by_columns.size(); i++) {
+        result_chunk->append_column(_group_by_columns[i], _intermediate_tuple_desc->slots()[i]->id());
+    }
+
+    if (!_agg_fn_ctxs.empty()) {
+        Columns agg_result_column = _create_agg_result_columns();
+        for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+            size_t id = _group_by_columns.size() + i;
+            _agg_functions[i]->convert_to_serialize_format(_agg_intput_columns[i], result_chunk->num_rows(),
+                                                           &agg_result_column[i]);
+            result_chunk->append_column(std::move(agg_result_column[i]), _intermediate_tuple_desc->slots()[id]->id());
+        }
+    }
+    _num_pass_through_rows += result_chunk->num_rows();
+    _num_rows_returned += result_chunk->num_rows();
+    *chunk = std::move(result_chunk);
+    COUNTER_SET(_pass_through_row_count, _num_pass_through_rows);
+}
+
+void Aggregator::output_chunk_by_streaming_with_selection(ChunkPtr* chunk) {
+    // Streaming aggregate at least has one group by column
+    size_t chunk_size = _group_by_columns[0]->size();
+    for (auto& _group_by_column : _group_by_columns) {
+        // Multi GroupColumn may be have the same SharedPtr
+        // If ColumnSize and ChunkSize are not equal,
+        // indicating that the Filter has been executed in previous GroupByColumn
+        // e.g.: select c1, cast(c1 as int) from t1 group by c1, cast(c1 as int);
+
+        // At present, the type of problem cannot be completely solved,
+        // and a new solution needs to be designed to solve it completely
+        if (_group_by_column->size() == chunk_size) {
+            _group_by_column->filter(_streaming_selection);
+        }
+    }
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        for (auto& agg_input_column : _agg_intput_columns[i]) {
+            // AggColumn and GroupColumn may be the same SharedPtr,
+            // If ColumnSize and ChunkSize are not equal,
+            // indicating that the Filter has been executed in GroupByColumn
+            // e.g.: select c1, count(distinct c1) from t1 group by c1;
+
+            // At present, the type of problem cannot be completely solved,
+            // and a new solution needs to be designed to solve it completely
+            if (agg_input_column->size() == chunk_size) {
+                agg_input_column->filter(_streaming_selection);
+            }
+        }
+    }
+    output_chunk_by_streaming(chunk);
+}
+
+Status Aggregator::check_hash_map_memory_usage(RuntimeState* state) {
+    if ((_num_input_rows & memory_check_batch_size) < config::vector_chunk_size) {
+        return _update_hash_map_memory_usage(state);
+    }
+    return Status::OK();
+}
+
+Status Aggregator::_update_hash_map_memory_usage(RuntimeState* state) {
+    int64_t delta_memory_usage = static_cast<int64_t>(_hash_map_variant.memory_usage()) - _last_ht_memory_usage;
+    _mem_tracker->consume(delta_memory_usage);
+    _last_ht_memory_usage = _hash_map_variant.memory_usage();
+
+    int64_t agg_func_memory_usage = 0;
+    for (auto& _agg_fn_ctx : _agg_fn_ctxs) {
+        agg_func_memory_usage += _agg_fn_ctx->impl()->mem_usage();
+    }
+    _mem_tracker->consume(agg_func_memory_usage - _last_agg_func_memory_usage);
+    _last_agg_func_memory_usage = agg_func_memory_usage;
+
+    return state->check_query_state("Aggregation Node");
+}
+
+Status Aggregator::check_hash_set_memory_usage(RuntimeState* state) {
+    if ((_num_input_rows & memory_check_batch_size) < config::vector_chunk_size) {
+        int64_t delta_memory_usage = static_cast<int64_t>(_hash_set_variant.memory_usage()) - _last_ht_memory_usage;
+        _mem_tracker->consume(delta_memory_usage);
+        _last_ht_memory_usage = _hash_set_variant.memory_usage();
+
+        RETURN_IF_ERROR(state->check_query_state("Aggregation Node"));
+    }
+    return Status::OK();
+}
+
+void Aggregator::try_convert_to_two_level_map() {
+    if (_last_ht_memory_usage > two_level_memory_threshold) {
+        _convert_to_two_level_map(0);
+    }
+}
+
+void Aggregator::_convert_to_two_level_map(size_t num_groups) {
+    if (_hash_map_variant.type == HashMapVariant::Type::phase1_slice) {
+        _hash_map_variant.phase1_slice_two_level = std::make_unique<SerializedKeyTwoLevelAggHashMap<PhmapSeed1>>();
+
+        _hash_map_variant.phase1_slice_two_level->hash_map.reserve(
+                std::max(num_groups, _hash_map_variant.phase1_slice->hash_map.capacity()));
+
+        _hash_map_variant.phase1_slice_two_level->hash_map.insert(_hash_map_variant.phase1_slice->hash_map.begin(),
+                                                                  _hash_map_variant.phase1_slice->hash_map.end());
+
+        _hash_map_variant.type = HashMapVariant::Type::phase1_slice_two_level;
+        _hash_map_variant.phase1_slice.reset();
+    } else if (_hash_map_variant.type == HashMapVariant::Type::phase2_slice) {
+        _hash_map_variant.phase2_slice_two_level = std::make_unique<SerializedKeyTwoLevelAggHashMap<PhmapSeed2>>();
+
+        _hash_map_variant.phase2_slice_two_level->hash_map.reserve(
+                std::max(num_groups, _hash_map_variant.phase2_slice->hash_map.capacity()));
+
+        _hash_map_variant.phase2_slice_two_level->hash_map.insert(_hash_map_variant.phase2_slice->hash_map.begin(),
+                                                                  _hash_map_variant.phase2_slice->hash_map.end());
+
+        _hash_map_variant.type = HashMapVariant::Type::phase2_slice_two_level;
+        _hash_map_variant.phase2_slice.reset();
+    }
+}
+
+Status Aggregator::try_spill_hash_map(RuntimeState* state) {
+    if (!state->enable_spill() || _group_by_expr_ctxs.empty() || _is_only_group_by_columns) {
+        return Status::OK();
+    }
+    // The memory usage is updated at the same pace as check_hash_map_memory_usage().
+    if ((_num_input_rows & memory_check_batch_size) >= config::vector_chunk_size) {
+        return Status::OK();
+    }
+    if (_mem_tracker->spare_capacity() >= _last_ht_memory_usage) {
+        return Status::OK();
+    }
+    return _spill_hash_map(state);
+}
+
+Status Aggregator::finish_spill(RuntimeState* state) {
+    DCHECK(_spiller != nullptr);
+    RETURN_IF_ERROR(_spill_hash_map(state));
+    return _spiller->flush();
+}
+
+Status Aggregator::restore_next_spilled_partition(RuntimeState* state) {
+    DCHECK(has_unrestored_spilled_partitions());
+    _reset_hash_map();
+
+    size_t partition = _num_restored_spilled_partitions++;
+    for (size_t i = 0;; ++i) {
+        ChunkPtr chunk;
+        RETURN_IF_ERROR(_spiller->read_chunk(partition, i, &chunk));
+        if (chunk == nullptr) {
+            break;
+        }
+        _merge_intermediate_chunk(chunk);
+        RETURN_IF_ERROR(_update_hash_map_memory_usage(state));
+        try_convert_to_two_level_map();
+    }
+    _spiller->remove_partition(partition);
+
+    if (_hash_map_variant.size() == 0) {
+        _is_finished = true;
+    } else {
+        init_hash_map_iterator();
+    }
+    return Status::OK();
+}
+
+void Aggregator::_set_needs_finalize(bool needs_finalize) {
+    _needs_finalize = needs_finalize;
+    // The result columns of the other phase have other types.
+    _result_column_recycler.clear();
+    if (_needs_finalize) {
+        _serialize_or_finalize = &Aggregator::_finalize_to_chunk;
+    } else {
+        _serialize_or_finalize = &Aggregator::_serialize_to_chunk;
+    }
+}
+
+RuntimeChunkMeta Aggregator::_create_intermediate_chunk_meta() const {
+    // Keep the same with the columns created by _create_group_by_columns and _create_agg_result_columns
+    // when the aggregate states are serialized.
+    size_t num_columns = _group_by_types.size() + _agg_fn_types.size();
+    RuntimeChunkMeta chunk_meta;
+    chunk_meta.types.reserve(num_columns);
+    chunk_meta.is_nulls.reserve(num_columns);
+    chunk_meta.is_consts.assign(num_columns, false);
+    chunk_meta.slot_id_to_index.init(num_columns);
+    chunk_meta.tuple_id_to_index.init(1);
+    for (const auto& group_by_type : _group_by_types) {
+        chunk_meta.types.emplace_back(group_by_type.result_type);
+        chunk_meta.is_nulls.emplace_back(group_by_type.is_nullable);
+    }
+    for (const auto& agg_fn_type : _agg_fn_types) {
+        chunk_meta.types.emplace_back(agg_fn_type.serde_type);
+        chunk_meta.is_nulls.emplace_back(agg_fn_type.has_nullable_child);
+    }
+    for (size_t i = 0; i < num_columns; ++i) {
+        chunk_meta.slot_id_to_index.insert(_intermediate_tuple_desc->slots()[i]->id(), i);
+    }
+    return chunk_meta;
+}
+
+Status Aggregator::_spill_hash_map(RuntimeState* state) {
+    if (_spiller == nullptr) {
+        _spiller = std::make_unique<ChunkSpiller>(state, _create_intermediate_chunk_meta(), _runtime_profile);
+        RETURN_IF_ERROR(_spiller->prepare());
+    }
+
+    // The spilled chunks hold the serialized aggregate states, which are merged when restored.
+    bool needs_finalize = _needs_finalize;
+    int64_t num_rows_returned = _num_rows_returned;
+    _set_needs_finalize(false);
+    Status status;
+    if (_hash_map_variant.size() > 0) {
+        init_hash_map_iterator();
+        while (!_is_finished && status.ok()) {
+            ChunkPtr chunk;
+            convert_hash_map_to_chunk(config::vector_chunk_size, &chunk);
+            if (!chunk->is_empty()) {
+                // The group by columns are the leading columns of the intermediate chunk.
+                const Columns& columns = chunk->columns();
+                status = _spiller->spill(chunk, Columns(columns.begin(), columns.begin() + _group_by_types.size()));
+            }
+        }
+    }
+    _set_needs_finalize(needs_finalize);
+    _num_rows_returned = num_rows_returned;
+    RETURN_IF_ERROR(status);
+
+    _reset_hash_map();
+    return Status::OK();
+}
+
+void Aggregator::_reset_hash_map() {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                      \
+    else if (_hash_map_variant.type == HashMapVariant::Type::NAME) \
+            _release_agg_memory<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME);
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    _mem_pool->free_all();
+
+    _hash_map_variant = HashMapVariant();
+    _init_agg_hash_variant(_hash_map_variant);
+    // The estimates are of all the input, not of a spilled partition.
+    _presize_input_rows = 0;
+    _mem_tracker->release(_last_ht_memory_usage);
+    _last_ht_memory_usage = 0;
+    _is_finished = false;
+    _hash_table_eos = false;
+}
+
+void Aggregator::_merge_intermediate_chunk(const ChunkPtr& chunk) {
+    size_t num_rows = chunk->num_rows();
+    for (size_t i = 0; i < _group_by_columns.size(); ++i) {
+        _group_by_columns[i] = chunk->get_column_by_index(i);
+    }
+    build_hash_map(num_rows);
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); ++i) {
+        const Column* column = chunk->get_column_by_index(_group_by_columns.size() + i).get();
+        _agg_functions[i]->merge_batch(_agg_fn_ctxs[i], num_rows, _agg_states_offsets[i], column,
+                                       _tmp_agg_states.data());
+    }
+}
+
+void Aggregator::process_limit(ChunkPtr* chunk) {
+    if (reached_limit()) {
+        int64_t num_rows_over = _num_rows_returned - _limit;
+        (*chunk)->set_num_rows((*chunk)->num_rows() - num_rows_over);
+        _num_rows_returned = _limit;
+        _is_finished = true;
+        LOG(INFO) << "Aggregate Node ReachedLimit " << _limit;
+    }
+}
+
+template <typename HashVariantType>
+void Aggregator::_init_agg_hash_variant(HashVariantType& hash_variant, size_t num_groups) {
+    auto type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice : HashVariantType::Type::phase2_slice;
+    if (_has_nullable_key) {
+        switch (_group_by_expr_ctxs.size()) {
+        case 0:
+            break;
+        case 1: {
+            auto group_by_expr = _group_by_expr_ctxs[0];
+            switch (group_by_expr->root()->type().type) {
+            case TYPE_TINYINT: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_null_int8
+                                                 : HashVariantType::Type::phase2_null_int8;
+                break;
+            }
+            case TYPE_SMALLINT: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_null_int16
+                                                 : HashVariantType::Type::phase2_null_int16;
+                break;
+            }
+            case TYPE_INT: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_null_int32
+                                                 : HashVariantType::Type::phase2_null_int32;
+                break;
+            }
+            case TYPE_BIGINT: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_null_int64
+                                                 : HashVariantType::Type::phase2_null_int64;
+                break;
+            }
+            case TYPE_DATE: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_null_date
+                                                 : HashVariantType::Type::phase2_null_date;
+                break;
+            }
+            case TYPE_DATETIME: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_null_timestamp
+                                                 : HashVariantType::Type::phase2_null_timestamp;
+                break;
+            }
+            case TYPE_CHAR:
+            case TYPE_VARCHAR: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_null_string
+                                                 : HashVariantType::Type::phase2_null_string;
+                break;
+            }
+            default: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice
+                                                 : HashVariantType::Type::phase2_slice;
+                break;
+            }
+            }
+            break;
+        }
+        default: {
+            type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice
+                                             : HashVariantType::Type::phase2_slice;
+            break;
+        }
+        }
+    } else {
+        switch (_group_by_expr_ctxs.size()) {
+        case 0:
+            break;
+        case 1: {
+            auto group_by_expr = _group_by_expr_ctxs[0];
+            switch (group_by_expr->root()->type().type) {
+            case TYPE_TINYINT: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_int8
+                                                 : HashVariantType::Type::phase2_int8;
+                break;
+            }
+            case TYPE_SMALLINT: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_int16
+                                                 : HashVariantType::Type::phase2_int16;
+                break;
+            }
+            case TYPE_INT: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_int32
+                                                 : HashVariantType::Type::phase2_int32;
+                break;
+            }
+            case TYPE_BIGINT: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_int64
+                                                 : HashVariantType::Type::phase2_int64;
+                break;
+            }
+            case TYPE_DATE: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_date
+                                                 : HashVariantType::Type::phase2_date;
+                break;
+            }
+            case TYPE_DATETIME: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_timestamp
+                                                 : HashVariantType::Type::phase2_timestamp;
+                break;
+            }
+            case TYPE_CHAR:
+            case TYPE_VARCHAR: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_string
+                                                 : HashVariantType::Type::phase2_string;
+                break;
+            }
+            default: {
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice
+                                                 : HashVariantType::Type::phase2_slice;
+                break;
+            }
+            }
+            break;
+        }
+        default: {
+            type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice
+                                             : HashVariantType::Type::phase2_slice;
+            break;
+        }
+        }
+    }
+
+    _has_fixed_size_keys = false;
+    if (_group_by_expr_ctxs.size() > 1) {
+        size_t fixed_size = _get_fixed_size_of_group_by_keys();
+        if (fixed_size > 0 && fixed_size <= 4) {
+            type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice_fx4
+                                             : HashVariantType::Type::phase2_slice_fx4;
+        } else if (fixed_size > 4 && fixed_size <= 8) {
+            type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice_fx8
+                                             : HashVariantType::Type::phase2_slice_fx8;
+        } else if (fixed_size > 8 && fixed_size <= 16) {
+            type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice_fx16
+                                             : HashVariantType::Type::phase2_slice_fx16;
+        }
+        _has_fixed_size_keys = fixed_size > 0 && fixed_size <= 16;
+    }
+    if (_is_two_level_size(num_groups)) {
+        if (type == HashVariantType::Type::phase1_slice) {
+            type = HashVariantType::Type::phase1_slice_two_level;
+        } else if (type == HashVariantType::Type::phase2_slice) {
+            type = HashVariantType::Type::phase2_slice_two_level;
+        }
+    }
+    VLOG_ROW << "hash type is "
+             << static_cast<typename std::underlying_type<typename HashVariantType::Type>::type>(type);
+    hash_variant.init(type);
+    if (num_groups > 0) {
+        hash_variant.reserve(num_groups);
+    }
+}
+
+size_t Aggregator::_get_fixed_size_of_group_by_keys() const {
+    size_t fixed_size = 0;
+    for (const auto& group_by_type : _group_by_types) {
+        // A nullable key is serialized with one byte of null flag before its data.
+        if (group_by_type.is_nullable) {
+            fixed_size += sizeof(uint8_t);
+        }
+        switch (group_by_type.result_type.type) {
+        case TYPE_BOOLEAN:
+        case TYPE_TINYINT:
+            fixed_size += sizeof(int8_t);
+            break;
+        case TYPE_SMALLINT:
+            fixed_size += sizeof(int16_t);
+            break;
+        case TYPE_INT:
+        case TYPE_DECIMAL32:
+            fixed_size += sizeof(int32_t);
+            break;
+        case TYPE_BIGINT:
+        case TYPE_DECIMAL64:
+            fixed_size += sizeof(int64_t);
+            break;
+        case TYPE_LARGEINT:
+        case TYPE_DECIMAL128:
+            fixed_size += sizeof(int128_t);
+            break;
+        case TYPE_DATE:
+            fixed_size += sizeof(DateValue);
+            break;
+        case TYPE_DATETIME:
+            fixed_size += sizeof(TimestampValue);
+            break;
+        default:
+            return 0;
+        }
+    }
+    return fixed_size;
+}
+
+} // namespace starrocks::vectorized
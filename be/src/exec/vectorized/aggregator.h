@@ -0,0 +1,687 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <any>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+
+#include "column/column_helper.h"
+#include "column/column_recycler.h"
+#include "column/type_traits.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "exec/vectorized/chunk_spiller.h"
+#include "exprs/agg/aggregate_factory.h"
+#include "exprs/expr.h"
+#include "exprs/vectorized/batch_udf.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_pool.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized {
+
+struct AggFunctionTypes {
+    TypeDescriptor result_type;
+    TypeDescriptor serde_type; // for serialize
+    std::vector<FunctionContext::TypeDesc> arg_typedescs;
+    bool has_nullable_child;
+    bool is_nullable; // agg function result whether is nullable
+};
+
+struct GroupByColumnTypes {
+    TypeDescriptor result_type;
+    bool is_nullable;
+};
+
+enum AggrPhase { AggrPhase1, AggrPhase2 };
+
+struct StreamingHtMinReductionEntry {
+    int min_ht_mem;
+    double streaming_ht_min_reduction;
+};
+
+static const StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
+        {0, 0.0},
+        {256 * 1024, 1.1},
+        {2 * 1024 * 1024, 2.0},
+};
+
+static const int STREAMING_HT_MIN_REDUCTION_SIZE =
+        sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
+
+class Aggregator;
+using AggregatorPtr = std::shared_ptr<Aggregator>;
+
+// Aggregator holds the whole state of a hash aggregation: group by and aggregate
+// expressions, aggregate function states and the hash map/set. It is used by the
+// aggregate ExecNodes and by the pipeline aggregate operators, in the later case one
+// Aggregator is shared by a pair of sink operator and source operator.
+class Aggregator {
+public:
+    Aggregator(const TPlanNode& tnode);
+    ~Aggregator() = default;
+
+    Status prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile, MemTracker* mem_tracker);
+    Status open(RuntimeState* state);
+    Status close(RuntimeState* state);
+
+    // The sink operator and the source operator both hold a reference of the Aggregator,
+    // the last one who unref it is responsible to close it.
+    void ref() { _num_ref.fetch_add(1); }
+    Status unref(RuntimeState* state) {
+        if (_num_ref.fetch_sub(1) == 1) {
+            return close(state);
+        }
+        return Status::OK();
+    }
+
+    const TPlanNode& tnode() const { return _tnode; }
+    const std::vector<ExprContext*>& group_by_expr_ctxs() const { return _group_by_expr_ctxs; }
+    const std::vector<starrocks_udf::FunctionContext*>& agg_fn_ctxs() const { return _agg_fn_ctxs; }
+    MemPool* mem_pool() const { return _mem_pool.get(); }
+    bool needs_finalize() const { return _needs_finalize; }
+    bool is_none_group_by_exprs() const { return _group_by_expr_ctxs.empty(); }
+    bool is_only_group_by_columns() const { return _is_only_group_by_columns; }
+    TStreamingPreaggregationMode::type streaming_preaggregation_mode() const {
+        return _streaming_preaggregation_mode;
+    }
+    HashMapVariant& hash_map_variant() { return _hash_map_variant; }
+    HashSetVariant& hash_set_variant() { return _hash_set_variant; }
+    std::any& it_hash() { return _it_hash; }
+    std::vector<uint8_t>& streaming_selection() { return _streaming_selection; }
+
+    bool is_finished() const { return _is_finished; }
+    void set_finished() { _is_finished = true; }
+    bool is_ht_eos() const { return _hash_table_eos; }
+    void set_ht_eos() { _hash_table_eos = true; }
+
+    int64_t num_input_rows() const { return _num_input_rows; }
+    void update_num_input_rows(int64_t num_input_rows) { _num_input_rows += num_input_rows; }
+    int64_t num_rows_returned() const { return _num_rows_returned; }
+    void update_num_rows_returned(int64_t increment) { _num_rows_returned += increment; }
+    int64_t num_pass_through_rows() const { return _num_pass_through_rows; }
+    int64_t limit() const { return _limit; }
+    bool reached_limit() const { return _limit != -1 && _num_rows_returned >= _limit; }
+
+    // For GROUP BY ... LIMIT n without HAVING, any n groups with their complete states are a result. So once the
+    // hash table has n groups, the blocking aggregations only update the groups in it and skip the rows of the
+    // other groups, or stop reading the input if there are no aggregate functions, and the streaming aggregations
+    // pass the rows of the other groups through. The node disables it if its output is filtered by runtime filters.
+    bool reached_group_limit() const {
+        if (!_limits_groups) {
+            return false;
+        }
+        const size_t num_groups = _is_only_group_by_columns ? _hash_set_variant.size() : _hash_map_variant.size();
+        return static_cast<int64_t>(num_groups) >= _limit;
+    }
+    void disable_group_limit() { _limits_groups = false; }
+
+    RuntimeProfile::Counter* get_results_timer() { return _get_results_timer; }
+    RuntimeProfile::Counter* agg_compute_timer() { return _agg_compute_timer; }
+    RuntimeProfile::Counter* streaming_timer() { return _streaming_timer; }
+    RuntimeProfile::Counter* input_row_count() { return _input_row_count; }
+    RuntimeProfile::Counter* hash_table_size() { return _hash_table_size; }
+    RuntimeProfile::Counter* pass_through_row_count() { return _pass_through_row_count; }
+
+    // The sink side of a pipeline aggregation marks the Aggregator as complete after all
+    // the input has been consumed, then the source side could read the hash table safely.
+    void sink_complete() { _is_sink_complete.store(true, std::memory_order_release); }
+    bool is_sink_complete() const { return _is_sink_complete.load(std::memory_order_acquire); }
+
+    // The chunk buffer is used by streaming aggregation in pipeline engine, the sink
+    // operator offers the pass-through chunks and the source operator polls them.
+    bool is_chunk_buffer_empty();
+    bool is_chunk_buffer_full();
+    ChunkPtr poll_chunk_buffer();
+    void offer_chunk_to_buffer(const ChunkPtr& chunk);
+
+    bool should_expand_preagg_hash_tables(size_t input_chunk_size, int64_t ht_mem, int64_t ht_rows) const;
+
+    // For aggregate without group by
+    void compute_single_agg_state(size_t chunk_size);
+    // For aggregate with group by
+    void compute_batch_agg_states(size_t chunk_size);
+    void compute_batch_agg_states(size_t chunk_size, const std::vector<uint8_t>& selection);
+    // Call compute_single_agg_state or compute_batch_agg_states according to group by exprs
+    void compute_agg_states(size_t chunk_size) { (this->*_compute_agg_states)(chunk_size); }
+
+    void evaluate_exprs(Chunk* chunk);
+
+    // Build hash map/set by group by columns of current chunk, the *_with_selection version
+    // only probes the hash table and records the missed rows in _streaming_selection.
+    void build_hash_map(size_t chunk_size);
+    void build_hash_map_with_selection(size_t chunk_size);
+    void build_hash_set(size_t chunk_size);
+    void build_hash_set_with_selection(size_t chunk_size);
+
+    // Point the hash table iterator to the first element of hash map/set
+    void init_hash_map_iterator();
+    void init_hash_set_iterator();
+
+    // Convert one row agg states to chunk
+    void convert_to_chunk_no_groupby(ChunkPtr* chunk);
+    void convert_hash_map_to_chunk(int32_t chunk_size, ChunkPtr* chunk);
+    void convert_hash_set_to_chunk(int32_t chunk_size, ChunkPtr* chunk);
+
+    // The number of the sub-maps of the hash map if it's two-level, or else 0.
+    size_t num_hash_map_partitions() const;
+    // Convert the groups of the sub-map |partition| of the two-level hash map to the chunks of at most |chunk_size|
+    // rows, which are passed to |consumer| until it returns false. The sub-maps could be converted by several
+    // threads concurrently, the agg states of a group are finalized or serialized only by the thread of its sub-map.
+    // It doesn't change the iterator of convert_hash_map_to_chunk nor the number of the rows returned.
+    void convert_hash_map_partition_to_chunks(size_t partition, int32_t chunk_size,
+                                              const std::function<bool(ChunkPtr)>& consumer);
+
+    void output_chunk_by_streaming(ChunkPtr* chunk);
+
+    // Elements queried in HashTable will be added to HashTable,
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    // selection[i] = 0: found in hash table
+    // selection[1] = 1: not found in hash table
+    void output_chunk_by_streaming_with_selection(ChunkPtr* chunk);
+
+    Status check_hash_map_memory_usage(RuntimeState* state);
+    Status check_hash_set_memory_usage(RuntimeState* state);
+
+    // At first, we use single hash map, if hash map is too big,
+    // we convert the single hash map to two level hash map.
+    // two level hash map is better in large data set.
+    void try_convert_to_two_level_map();
+
+    void process_limit(ChunkPtr* chunk);
+
+    // Spill to disk, it's only used by the blocking aggregation with group by columns when enable_spilling
+    // is set. If the memory left to the query isn't enough for the hash map to grow, which doubles the
+    // memory of the hash map, the hash map is spilled to the partitions of ChunkSpiller and reset.
+    Status try_spill_hash_map(RuntimeState* state);
+    bool has_spilled() const { return _spiller != nullptr; }
+    // After all the input is consumed, the rest of the hash map is also spilled, so that the groups
+    // could be aggregated again partition by partition.
+    Status finish_spill(RuntimeState* state);
+    bool has_unrestored_spilled_partitions() const {
+        return _spiller != nullptr && _num_restored_spilled_partitions < _spiller->num_partitions();
+    }
+    // Reset the hash map and merge the next spilled partition into it, then point the hash map iterator
+    // to its first element. The Aggregator is set finished if the partition is empty.
+    Status restore_next_spilled_partition(RuntimeState* state);
+
+    // The group by aggregation whose aggregate functions are all multi_distinct_count on the raw input,
+    // e.g. COUNT(DISTINCT a), COUNT(DISTINCT b), is computed by one hash set of the expanded rows
+    // (distinct_id, group_by_keys, value) instead of one hash set per function per group, which is kept in
+    // hash_set_variant(). The rows with null value are inserted with the distinct id of the number of
+    // functions, so each group is kept even if it only has null values, but they are not counted.
+    bool is_multi_distinct_count() const { return _is_multi_distinct_count; }
+    void build_multi_distinct_set(size_t chunk_size);
+    // After all the input is consumed, count the distinct values of each group by one pass over the hash set.
+    // The Aggregator is set finished if there is no group.
+    void finish_multi_distinct_set();
+    void convert_multi_distinct_set_to_chunk(int32_t chunk_size, ChunkPtr* chunk);
+
+private:
+    // initial const columns for i'th FunctionContext.
+    void _evaluate_const_columns(int i);
+
+    Status _update_hash_map_memory_usage(RuntimeState* state);
+
+    void _set_needs_finalize(bool needs_finalize);
+    // The chunk meta of the intermediate chunks converted from the hash map.
+    RuntimeChunkMeta _create_intermediate_chunk_meta() const;
+    Status _spill_hash_map(RuntimeState* state);
+    // Release the agg states and the memory of the hash map, then create an empty hash map.
+    void _reset_hash_map();
+    // Merge the intermediate chunk restored from the spilled partition into the hash map.
+    void _merge_intermediate_chunk(const ChunkPtr& chunk);
+
+    // Choose different agg hash map/set by different group by column's count, type, nullable.
+    // If |num_groups| is not 0, the hash map/set is reserved for so many groups, and it's two-level from the start
+    // if it would be converted to two-level by try_convert_to_two_level_map() once it's so large.
+    template <typename HashVariantType>
+    void _init_agg_hash_variant(HashVariantType& hash_variant, size_t num_groups = 0);
+    // If the planner only estimates the input rows, the number of groups is estimated once by the ratio of the
+    // groups to the rows of the first config::agg_presize_sample_rows input rows, and the hash map/set is reserved
+    // for it. |chunk_size| is the rows of the chunk just built into the hash map/set.
+    void _presize_hash_map_by_sample(size_t chunk_size);
+    void _presize_hash_set_by_sample(size_t chunk_size);
+    // Return the number of groups estimated by the sampled rows, or 0 if there are not enough rows sampled yet or
+    // the groups have been estimated.
+    size_t _estimate_num_groups_by_sample(size_t num_sampled_groups, size_t chunk_size);
+    // Convert the single serialized key hash map to the two level hash map, reserved for at least |num_groups|.
+    void _convert_to_two_level_map(size_t num_groups);
+    // Whether a serialized key hash map of |num_groups| groups exceeds two_level_memory_threshold.
+    static bool _is_two_level_size(size_t num_groups) {
+        return num_groups * (sizeof(Slice) + sizeof(AggDataPtr)) > two_level_memory_threshold;
+    }
+    // The packed size of the multi-column group by keys, or 0 if any of them isn't of fixed size.
+    size_t _get_fixed_size_of_group_by_keys() const;
+
+    AggDataPtr _allocate_agg_state() {
+        AggDataPtr agg_state = _mem_pool->allocate_aligned(_agg_states_total_size, _max_agg_state_align_size);
+        for (int i = 0; i < _agg_functions.size(); i++) {
+            _agg_functions[i]->create(agg_state + _agg_states_offsets[i]);
+        }
+        return agg_state;
+    }
+
+    template <typename HashMapWithKey>
+    void _build_hash_map(HashMapWithKey& hash_map_with_key, size_t chunk_size) {
+        hash_map_with_key.compute_agg_states(
+                chunk_size, _group_by_columns, _mem_pool.get(), [this]() { return _allocate_agg_state(); },
+                &_tmp_agg_states);
+    }
+
+    template <typename HashMapWithKey>
+    void _build_hash_map(HashMapWithKey& hash_map_with_key, size_t chunk_size, std::vector<uint8_t>* selection) {
+        hash_map_with_key.compute_agg_states(
+                chunk_size, _group_by_columns, [this]() { return _allocate_agg_state(); }, &_tmp_agg_states,
+                selection);
+    }
+
+    // Destroy the agg states in the hash map by batches, the memory is released with _mem_pool.
+    template <typename HashMapWithKey>
+    void _release_agg_memory(HashMapWithKey& hash_map_with_key) {
+        std::vector<size_t> destroyed_funcs;
+        for (size_t i = 0; i < _agg_functions.size(); i++) {
+            if (!_agg_functions[i]->is_state_trivially_destructible()) {
+                destroyed_funcs.emplace_back(i);
+            }
+        }
+        if (destroyed_funcs.empty()) {
+            return;
+        }
+
+        auto it = hash_map_with_key.hash_map.begin();
+        auto end = hash_map_with_key.hash_map.end();
+        while (it != end) {
+            size_t batch_size = 0;
+            while (it != end && batch_size < _tmp_agg_states.size()) {
+                _tmp_agg_states[batch_size++] = it->second;
+                ++it;
+            }
+            for (size_t i : destroyed_funcs) {
+                _agg_functions[i]->batch_destroy(batch_size, _tmp_agg_states.data(), _agg_states_offsets[i]);
+            }
+        }
+        if constexpr (HashMapWithKey::has_single_null_key) {
+            if (hash_map_with_key.null_key_data != nullptr) {
+                for (int i = 0; i < _agg_functions.size(); i++) {
+                    _agg_functions[i]->destroy(hash_map_with_key.null_key_data + _agg_states_offsets[i]);
+                }
+            }
+        }
+    }
+
+    template <typename HashSetWithKey>
+    void _build_hash_set(HashSetWithKey& hash_set, size_t chunk_size) {
+        hash_set.build_set(chunk_size, _group_by_columns, _mem_pool.get());
+    }
+
+    template <typename HashSetWithKey>
+    void _build_hash_set(HashSetWithKey& hash_set, size_t chunk_size, std::vector<uint8_t>* selection) {
+        hash_set.build_set(chunk_size, _group_by_columns, selection);
+    }
+
+    // Create new aggregate function result column by type
+    Columns _create_agg_result_columns();
+    Columns _create_group_by_columns();
+    // The chunk of the group by columns and the agg result columns, as the slots of the output or the intermediate
+    // tuple.
+    ChunkPtr _build_result_chunk(const Columns& group_by_columns, const Columns& agg_result_columns) const;
+    // Reuse the result columns of the output chunks released by the consumers, or create new ones.
+    void _reuse_or_create_result_columns(Columns* group_by_columns, Columns* agg_result_columns);
+    void _keep_result_columns(const Columns& group_by_columns, const Columns& agg_result_columns);
+
+    template <typename HashMapWithKey>
+    void _convert_hash_map_to_chunk(HashMapWithKey& hash_map_with_key, int32_t chunk_size, ChunkPtr* chunk) {
+        SCOPED_TIMER(_get_results_timer);
+        using Iterator = typename HashMapWithKey::Iterator;
+        auto it = std::any_cast<Iterator>(_it_hash);
+        auto end = hash_map_with_key.hash_map.end();
+
+        Columns group_by_columns;
+        Columns agg_result_column;
+        _reuse_or_create_result_columns(&group_by_columns, &agg_result_column);
+
+        int32_t read_index = 0;
+        {
+            SCOPED_TIMER(_iter_timer);
+            hash_map_with_key.results.resize(chunk_size);
+            while ((it != end) & (read_index < chunk_size)) {
+                hash_map_with_key.results[read_index] = it->first;
+                _tmp_agg_states[read_index] = it->second;
+                ++read_index;
+                ++it;
+            }
+        }
+
+        {
+            SCOPED_TIMER(_group_by_append_timer);
+            hash_map_with_key.insert_keys_to_columns(hash_map_with_key.results, group_by_columns, read_index);
+        }
+
+        {
+            SCOPED_TIMER(_agg_append_timer);
+            if (_needs_finalize) {
+                for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                    _agg_functions[i]->batch_finalize(_agg_fn_ctxs[i], read_index, _tmp_agg_states,
+                                                      _agg_states_offsets[i], agg_result_column[i].get());
+                }
+            } else {
+                for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                    _agg_functions[i]->batch_serialize(read_index, _tmp_agg_states, _agg_states_offsets[i],
+                                                       agg_result_column[i].get());
+                }
+            }
+        }
+
+        _is_finished = (it == end);
+        _hash_table_eos = _is_finished;
+
+        // If there is null key, output it last
+        if constexpr (HashMapWithKey::has_single_null_key) {
+            if (_is_finished && hash_map_with_key.null_key_data != nullptr) {
+                // The output chunk size couldn't larger than config::vector_chunk_size
+                if (read_index < config::vector_chunk_size) {
+                    // For multi group by key, we don't need to special handle null key
+                    DCHECK(group_by_columns.size() == 1);
+                    DCHECK(group_by_columns[0]->is_nullable());
+                    group_by_columns[0]->append_default();
+                    (this->*_serialize_or_finalize)(hash_map_with_key.null_key_data, agg_result_column);
+                    ++read_index;
+                } else {
+                    // Output null key in next round
+                    _hash_table_eos = false;
+                    _is_finished = false;
+                }
+            }
+        }
+
+        _it_hash = it;
+
+        ChunkPtr _result_chunk = _build_result_chunk(group_by_columns, agg_result_column);
+        _keep_result_columns(group_by_columns, agg_result_column);
+        _num_rows_returned += read_index;
+        *chunk = std::move(_result_chunk);
+    }
+
+    template <typename HashMapWithKey>
+    void _convert_hash_map_partition_to_chunks(HashMapWithKey& hash_map_with_key, size_t partition, int32_t chunk_size,
+                                               const std::function<bool(ChunkPtr)>& consumer) {
+        // The keys and the agg states of a thread.
+        typename HashMapWithKey::ResultVector keys(chunk_size);
+        Buffer<AggDataPtr> agg_states(chunk_size);
+        auto output = [&](int32_t num_rows) {
+            Columns group_by_columns = _create_group_by_columns();
+            Columns agg_result_columns = _create_agg_result_columns();
+            hash_map_with_key.insert_keys_to_columns(keys, group_by_columns, num_rows);
+            for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                if (_needs_finalize) {
+                    _agg_functions[i]->batch_finalize(_agg_fn_ctxs[i], num_rows, agg_states, _agg_states_offsets[i],
+                                                      agg_result_columns[i].get());
+                } else {
+                    _agg_functions[i]->batch_serialize(num_rows, agg_states, _agg_states_offsets[i],
+                                                       agg_result_columns[i].get());
+                }
+            }
+            return consumer(_build_result_chunk(group_by_columns, agg_result_columns));
+        };
+
+        hash_map_with_key.hash_map.with_submap(partition, [&](const auto& sub_map) {
+            int32_t num_rows = 0;
+            for (const auto& [key, agg_state] : sub_map) {
+                keys[num_rows] = key;
+                agg_states[num_rows] = agg_state;
+                if (++num_rows == chunk_size) {
+                    if (!output(num_rows)) {
+                        return;
+                    }
+                    num_rows = 0;
+                }
+            }
+            if (num_rows > 0) {
+                output(num_rows);
+            }
+        });
+    }
+
+    template <typename HashSetWithKey>
+    void _convert_hash_set_to_chunk(HashSetWithKey& hash_set, int32_t chunk_size, ChunkPtr* chunk) {
+        SCOPED_TIMER(_get_results_timer);
+        using Iterator = typename HashSetWithKey::Iterator;
+        auto it = std::any_cast<Iterator>(_it_hash);
+        auto end = hash_set.hash_set.end();
+
+        Columns group_by_columns;
+        Columns agg_result_column;
+        _reuse_or_create_result_columns(&group_by_columns, &agg_result_column);
+        DCHECK(agg_result_column.empty());
+
+        // Computer group by columns and aggregate result column
+        int32_t read_index = 0;
+        hash_set.results.resize(chunk_size);
+        while (it != end && read_index < chunk_size) {
+            // hash_set.insert_key_to_columns(*it, group_by_columns);
+            hash_set.results[read_index] = *it;
+            ++read_index;
+            ++it;
+        }
+
+        {
+            SCOPED_TIMER(_group_by_append_timer);
+            hash_set.insert_keys_to_columns(hash_set.results, group_by_columns, read_index);
+        }
+
+        _is_finished = (it == end);
+
+        // IF there is null key, output it last
+        if constexpr (HashSetWithKey::has_single_null_key) {
+            if (_is_finished && hash_set.has_null_key) {
+                // The output chunk size couldn't larger than config::vector_chunk_size
+                if (read_index < config::vector_chunk_size) {
+                    // For multi group by key, we don't need to special handle null key
+                    DCHECK(group_by_columns.size() == 1);
+                    DCHECK(group_by_columns[0]->is_nullable());
+                    group_by_columns[0]->append_default();
+                    ++read_index;
+                } else {
+                    // Output null key in next round
+                    _is_finished = false;
+                }
+            }
+        }
+
+        _hash_table_eos = _is_finished;
+        _it_hash = it;
+
+        ChunkPtr result_chunk = std::make_shared<Chunk>();
+        // For different agg phase, we should use different TupleDescriptor
+        if (_needs_finalize) {
+            for (size_t i = 0; i < group_by_columns.size(); i++) {
+                result_chunk->append_column(group_by_columns[i], _output_tuple_desc->slots()[i]->id());
+            }
+        } else {
+            for (size_t i = 0; i < group_by_columns.size(); i++) {
+                result_chunk->append_column(group_by_columns[i], _intermediate_tuple_desc->slots()[i]->id());
+            }
+        }
+        _keep_result_columns(group_by_columns, agg_result_column);
+        _num_rows_returned += read_index;
+        *chunk = std::move(result_chunk);
+    }
+
+    // When convert to chunk, we serialize the aggregate state
+    void _serialize_to_chunk(ConstAggDataPtr state, const Columns& agg_result_columns);
+
+    // When convert to chunk, we finalize the aggregate state
+    void _finalize_to_chunk(ConstAggDataPtr state, const Columns& agg_result_columns);
+
+    void (Aggregator::*_serialize_or_finalize)(ConstAggDataPtr state, const Columns& agg_result_columns) = nullptr;
+
+    void (Aggregator::*_compute_agg_states)(size_t chunk_size) = nullptr;
+
+#ifdef NDEBUG
+    static constexpr size_t two_level_memory_threshold = 33554432; // 32M, L3 Cache
+#else
+    static constexpr size_t two_level_memory_threshold = 64;
+#endif
+
+#ifdef NDEBUG
+    static constexpr size_t memory_check_batch_size = 65535;
+#else
+    static constexpr size_t memory_check_batch_size = 1;
+#endif
+
+    // The max number of pass-through chunks cached between streaming sink and source
+    static constexpr size_t max_chunk_buffer_size = 8;
+
+    const TPlanNode _tnode;
+
+    ObjectPool* _pool = nullptr;
+    RuntimeProfile* _runtime_profile = nullptr;
+    MemTracker* _mem_tracker = nullptr;
+    std::unique_ptr<MemPool> _mem_pool;
+
+    std::atomic<int32_t> _num_ref = 0;
+    bool _is_closed = false;
+
+    // Certain aggregates require a finalize step, which is the final step of the
+    // aggregate after consuming all input rows. The finalize step converts the aggregate
+    // value into its final form. This is true if this node contains aggregate that requires
+    // a finalize step.
+    bool _needs_finalize;
+
+    bool _is_finished = false;
+
+    bool _is_only_group_by_columns = false;
+
+    // At least one group by column is nullable
+    bool _has_nullable_key = false;
+    // The multi-column group by keys are packed into fixed size keys, see AggHashMapWithSerializedKeyFixedSize
+    bool _has_fixed_size_keys = false;
+
+    // The planner's estimates of the groups and of the input rows to pre-size the hash map/set, or 0 if unknown.
+    // _presize_input_rows is cleared once the groups are estimated by the sampled rows.
+    size_t _estimated_num_groups = 0;
+    size_t _presize_input_rows = 0;
+
+    int64_t _limit = -1;
+    // See reached_group_limit().
+    bool _limits_groups = false;
+    int64_t _num_input_rows = 0;
+    int64_t _num_rows_returned = 0;
+
+    // memory used for hashmap or hashset
+    int64_t _last_ht_memory_usage = 0;
+
+    // memory used for agg function
+    int64_t _last_agg_func_memory_usage = 0;
+
+    int64_t _num_pass_through_rows = 0;
+    bool _hash_table_eos = false;
+
+    std::atomic<bool> _is_sink_complete = false;
+    std::mutex _buffer_mutex;
+    std::queue<ChunkPtr> _buffer;
+
+    TStreamingPreaggregationMode::type _streaming_preaggregation_mode;
+    // The key is all group by column, the value is all agg function column
+    HashMapVariant _hash_map_variant;
+    HashSetVariant _hash_set_variant;
+    // The Iterator for hash table
+    std::any _it_hash;
+
+    // The offset of the n-th aggregate function in a row of aggregate functions.
+    std::vector<size_t> _agg_states_offsets;
+    // The total size of the row for the aggregate function state.
+    size_t _agg_states_total_size = 0;
+    // The max align size for all aggregate state
+    size_t _max_agg_state_align_size = 1;
+    // The followings are aggregate function information:
+    std::vector<starrocks_udf::FunctionContext*> _agg_fn_ctxs;
+    std::vector<const AggregateFunction*> _agg_functions;
+    // The batch UDAFs of the aggregate functions, null for the builtin ones.
+    std::vector<std::unique_ptr<BatchUdaf>> _batch_udafs;
+    // agg state when no group by columns
+    AggDataPtr _single_agg_state = nullptr;
+    // The expr used to evaluate agg input columns
+    // one agg function could have multi input exprs
+    std::vector<std::vector<ExprContext*>> _agg_expr_ctxs;
+    std::vector<std::vector<ColumnPtr>> _agg_intput_columns;
+    //raw pointers in order to get multi-column values
+    std::vector<std::vector<const Column*>> _agg_input_raw_columns;
+    // Indicates we should use update or merge method to process aggregate column data
+    std::vector<bool> _is_merge_funcs;
+    // In order batch update agg states
+    Buffer<AggDataPtr> _tmp_agg_states;
+    std::vector<AggFunctionTypes> _agg_fn_types;
+
+    // Exprs used to evaluate group by column
+    std::vector<ExprContext*> _group_by_expr_ctxs;
+    Columns _group_by_columns;
+    std::vector<GroupByColumnTypes> _group_by_types;
+
+    RuntimeProfile::Counter* _get_results_timer{};
+    RuntimeProfile::Counter* _iter_timer{};
+    RuntimeProfile::Counter* _agg_append_timer{};
+    RuntimeProfile::Counter* _group_by_append_timer{};
+    RuntimeProfile::Counter* _agg_compute_timer{};
+    RuntimeProfile::Counter* _streaming_timer{};
+    RuntimeProfile::Counter* _input_row_count{};
+    RuntimeProfile::Counter* _hash_table_size{};
+    RuntimeProfile::Counter* _pass_through_row_count{};
+    RuntimeProfile::Counter* _expr_compute_timer{};
+    RuntimeProfile::Counter* _expr_release_timer{};
+
+    // Tuple into which Update()/Merge()/Serialize() results are stored.
+    TupleId _intermediate_tuple_id;
+    TupleDescriptor* _intermediate_tuple_desc = nullptr;
+
+    // Tuple into which Finalize() results are stored. Possibly the same as
+    // the intermediate tuple.
+    TupleId _output_tuple_id;
+    TupleDescriptor* _output_tuple_desc = nullptr;
+
+    AggrPhase _aggr_phase = AggrPhase1;
+    std::vector<uint8_t> _streaming_selection;
+
+    // The result columns of the chunks converted from the hash map, reused once the consumers release them.
+    ColumnRecycler _result_column_recycler;
+
+    std::unique_ptr<ChunkSpiller> _spiller;
+    size_t _num_restored_spilled_partitions = 0;
+
+    bool _is_multi_distinct_count = false;
+    // The group by columns and the counts of all the groups, which are output chunk by chunk.
+    ChunkPtr _multi_distinct_result;
+    size_t _multi_distinct_result_offset = 0;
+};
+
+// AggregatorFactory is used by the pipeline aggregate operator factories, the sink operator and
+// the source operator created for the same driver sequence share the same Aggregator.
+class AggregatorFactory {
+public:
+    AggregatorFactory(const TPlanNode& tnode) : _tnode(tnode) {}
+
+    AggregatorPtr get_or_create(int32_t driver_sequence) {
+        auto it = _aggregators.find(driver_sequence);
+        if (it != _aggregators.end()) {
+            return it->second;
+        }
+        auto aggregator = std::make_shared<Aggregator>(_tnode);
+        _aggregators.emplace(driver_sequence, aggregator);
+        return aggregator;
+    }
+
+private:
+    const TPlanNode _tnode;
+    std::unordered_map<int32_t, AggregatorPtr> _aggregators;
+};
+
+using AggregatorFactoryPtr = std::shared_ptr<AggregatorFactory>;
+
+} // namespace starrocks::vectorized
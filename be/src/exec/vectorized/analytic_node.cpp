@@ -8,13 +8,16 @@
 
 #include "column/chunk.h"
 #include "column/column_helper.h"
+#include "column/nullable_column.h"
 #include "exprs/agg/count.h"
 #include "exprs/anyval_util.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "gutil/casts.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
+#include "simd/simd.h"
 #include "udf/udf.h"
 #include "util/runtime_profile.h"
 
@@ -101,6 +104,8 @@ Status AnalyticNode::init(const TPlanNode& tnode, RuntimeState* state) {
     _agg_intput_columns.resize(agg_size);
     _agg_fn_types.resize(agg_size);
     _agg_states_offsets.resize(agg_size);
+    _sliding_frame_modes.resize(agg_size, SlidingFrameMode::Recompute);
+    _sliding_frame_queues.resize(agg_size);
 
     bool has_outer_join_child = analytic_node.__isset.has_outer_join_child && analytic_node.has_outer_join_child;
 
@@ -183,12 +188,42 @@ Status AnalyticNode::init(const TPlanNode& tnode, RuntimeState* state) {
         if (_agg_functions[i]->get_name() == "lead-lag") {
             has_lead_lag_function = true;
         }
+        if (_agg_functions[i]->is_removable()) {
+            _sliding_frame_modes[i] = SlidingFrameMode::Removable;
+        } else if (fn.name.function_name == "max") {
+            _sliding_frame_modes[i] = SlidingFrameMode::MaxQueue;
+        } else if (fn.name.function_name == "min") {
+            _sliding_frame_modes[i] = SlidingFrameMode::MinQueue;
+        }
     }
 
     if (has_lead_lag_function) {
         _update_window_batch = &AnalyticNode::_update_window_batch_lead_lag;
     } else {
         _update_window_batch = &AnalyticNode::_update_window_batch_normal;
+        for (auto mode : _sliding_frame_modes) {
+            _has_incremental_sliding_frame |= (mode != SlidingFrameMode::Recompute);
+        }
+    }
+
+    // The ranking functions of the frames planned for them are computed by the peer group boundaries.
+    bool is_rows_frame = _get_next == &AnalyticNode::_get_next_for_unbounded_preceding_rows_frame;
+    bool is_range_frame = _get_next == &AnalyticNode::_get_next_for_unbounded_preceding_range_frame;
+    for (int i = 0; i < agg_size && (is_rows_frame || is_range_frame); ++i) {
+        const std::string& name = analytic_node.analytic_functions[i].nodes[0].fn.name.function_name;
+        if (is_rows_frame && name == "row_number") {
+            _ranking_functions.emplace_back(RankingFunction::RowNumber);
+        } else if (is_range_frame && name == "rank") {
+            _ranking_functions.emplace_back(RankingFunction::Rank);
+        } else if (is_range_frame && name == "dense_rank") {
+            _ranking_functions.emplace_back(RankingFunction::DenseRank);
+        } else {
+            _ranking_functions.clear();
+            break;
+        }
+    }
+    if (!_ranking_functions.empty()) {
+        _get_next = &AnalyticNode::_get_next_for_ranking_functions;
     }
 
     // compute agg state total size and offsets
@@ -317,6 +352,7 @@ size_t AnalyticNode::_compute_memory_usage() {
     for (size_t i = 0; i < _order_columns.size(); ++i) {
         memory_usage += _order_columns[i]->memory_usage();
     }
+    memory_usage += _partition_boundaries.capacity() + _peer_group_boundaries.capacity();
 
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         for (size_t j = 0; j < _agg_expr_ctxs[i].size(); j++) {
@@ -428,9 +464,7 @@ Status AnalyticNode::_get_next_for_sliding_frame(RuntimeState* state, ChunkPtr*
         _create_agg_result_columns(chunk_size);
 
         while (_current_row_position < _partition_end && _window_result_position < chunk_size) {
-            _reset_window_state();
-            FrameRange range = (this->*_get_sliding_frame_range)();
-            (this->*_update_window_batch)(_partition_start, _partition_end, range.start, range.end);
+            _update_sliding_frame((this->*_get_sliding_frame_range)());
             _window_result_position++;
             int64_t result_start =
                     _get_total_position(_current_row_position) - input_chunk_first_row_positions[_output_chunk_index];
@@ -485,6 +519,77 @@ Status AnalyticNode::_get_next_for_unbounded_preceding_rows_frame(RuntimeState*
     return Status::OK();
 }
 
+Status AnalyticNode::_get_next_for_ranking_functions(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    while (!_input_eos || _output_chunk_index < _input_chunks.size()) {
+        int64_t found_partition_end = 0;
+        RETURN_IF_ERROR(_try_fetch_next_partition_data(state, &found_partition_end));
+        if (_input_eos && _input_rows == 0) {
+            *eos = true;
+            return Status::OK();
+        }
+
+        SCOPED_TIMER(_compute_timer);
+
+        bool is_new_partition = _is_new_partition(found_partition_end);
+        if (is_new_partition) {
+            _reset_state_for_new_partition(found_partition_end);
+        }
+
+        size_t chunk_size = _input_chunks[_output_chunk_index]->num_rows();
+        _create_agg_result_columns(chunk_size);
+
+        DCHECK_EQ(_get_total_position(_current_row_position) - input_chunk_first_row_positions[_output_chunk_index],
+                  _window_result_position);
+        int64_t num_rows =
+                std::min<int64_t>(_partition_end - _current_row_position, chunk_size - _window_result_position);
+        if (num_rows > 0) {
+            _compute_ranking_functions(num_rows);
+            _current_row_position += num_rows;
+            _window_result_position += num_rows;
+        }
+
+        if (_window_result_position == _input_chunks[_output_chunk_index]->num_rows()) {
+            return _output_result_chunk(chunk);
+        }
+    }
+    return Status::OK();
+}
+
+void AnalyticNode::_compute_ranking_functions(int64_t num_rows) {
+    // The first row of a partition starts a peer group, whether it's equal to the last row of the previous
+    // partition or not. Without the order columns, the partition is one peer group.
+    const uint8_t* boundaries = _peer_group_boundaries.empty() ? nullptr : _peer_group_boundaries.data();
+    for (size_t i = 0; i < _ranking_functions.size(); ++i) {
+        int64_t* results = down_cast<Int64Column*>(_result_window_columns[i].get())->get_data().data() +
+                           _window_result_position;
+        int64_t rank = _last_rank;
+        int64_t dense_rank = _last_dense_rank;
+        for (int64_t j = 0; j < num_rows; ++j) {
+            int64_t row = _current_row_position + j;
+            int64_t row_number = row - _partition_start + 1;
+            bool is_boundary = (row == _partition_start) | (boundaries != nullptr && boundaries[row]);
+            switch (_ranking_functions[i]) {
+            case RankingFunction::RowNumber:
+                results[j] = row_number;
+                break;
+            case RankingFunction::Rank:
+                rank = is_boundary ? row_number : rank;
+                results[j] = rank;
+                break;
+            case RankingFunction::DenseRank:
+                dense_rank += is_boundary;
+                results[j] = dense_rank;
+                break;
+            }
+        }
+        if (_ranking_functions[i] == RankingFunction::Rank) {
+            _last_rank = rank;
+        } else if (_ranking_functions[i] == RankingFunction::DenseRank) {
+            _last_dense_rank = dense_rank;
+        }
+    }
+}
+
 bool AnalyticNode::_need_fetch_next_chunk(int64_t found_partition_end) {
     // current partition data don't consume finished
     if (_input_eos | (_current_row_position < _partition_end)) {
@@ -520,28 +625,30 @@ int64_t AnalyticNode::_find_partition_end() {
         return _input_rows;
     }
 
-    int64_t found_partition_end = _partition_columns[0]->size();
-    for (size_t i = 0; i < _partition_columns.size(); ++i) {
-        Column* column = _partition_columns[i].get();
-        found_partition_end = _find_first_not_equal(column, _partition_end, found_partition_end);
-    }
-    return found_partition_end;
+    return _find_first_boundary(_partition_boundaries, _partition_end, _partition_columns[0]->size());
 }
 
-int64_t AnalyticNode::_find_first_not_equal(Column* column, int64_t start, int64_t end) {
-    int64_t target = start;
-    while (start + 1 < end) {
-        int64_t mid = start + (end - start) / 2;
-        if (column->compare_at(target, mid, *column, 1) == 0) {
-            start = mid;
-        } else {
-            end = mid;
-        }
+void AnalyticNode::_mark_boundaries(const Columns& columns, Column::Filter* boundaries) {
+    if (columns.empty()) {
+        return;
+    }
+    size_t from = boundaries->size();
+    size_t to = columns[0]->size();
+    boundaries->resize(to, 0);
+    if (from == 0 && to > 0) {
+        (*boundaries)[0] = 1;
+        from = 1;
+    }
+    for (const auto& column : columns) {
+        ColumnHelper::mark_adjacent_differences(*column, from, to, boundaries->data() + from);
     }
-    if (column->compare_at(target, end - 1, *column, 1) == 0) {
+}
+
+int64_t AnalyticNode::_find_first_boundary(const Column::Filter& boundaries, int64_t start, int64_t end) {
+    if (start + 1 >= end) {
         return end;
     }
-    return end - 1;
+    return start + 1 + SIMD::find_nonzero(boundaries.data() + start + 1, end - start - 1);
 }
 
 void AnalyticNode::_find_peer_group_end() {
@@ -554,10 +661,7 @@ void AnalyticNode::_find_peer_group_end() {
     _peer_group_end = _partition_end;
     DCHECK(!_order_columns.empty());
 
-    for (size_t i = 0; i < _order_columns.size(); ++i) {
-        Column* column = _order_columns[i].get();
-        _peer_group_end = _find_first_not_equal(column, _peer_group_start, _peer_group_end);
-    }
+    _peer_group_end = _find_first_boundary(_peer_group_boundaries, _peer_group_start, _peer_group_end);
 }
 
 void AnalyticNode::_reset_state_for_new_partition(int64_t found_partition_end) {
@@ -565,6 +669,12 @@ void AnalyticNode::_reset_state_for_new_partition(int64_t found_partition_end) {
     _partition_end = found_partition_end;
     _current_row_position = _partition_start;
     _reset_window_state();
+    _last_rank = 0;
+    _last_dense_rank = 0;
+    _sliding_frame = {_partition_start, _partition_start};
+    for (auto& queue : _sliding_frame_queues) {
+        queue.clear();
+    }
     DCHECK_GE(_current_row_position, 0);
 }
 
@@ -628,6 +738,9 @@ Status AnalyticNode::_fetch_next_chunk(RuntimeState* state) {
             ColumnPtr column = _order_ctxs[i]->evaluate(child_chunk.get());
             _append_column(chunk_size, _order_columns[i].get(), column);
         }
+
+        _mark_boundaries(_partition_columns, &_partition_boundaries);
+        _mark_boundaries(_order_columns, &_peer_group_boundaries);
     }
 
     _input_chunks.emplace_back(std::move(child_chunk));
@@ -690,6 +803,12 @@ void AnalyticNode::_remove_unused_buffer_values() {
     for (size_t i = 0; i < _order_ctxs.size(); i++) {
         _order_columns[i]->remove_first_n_values(remove_count);
     }
+    if (!_partition_boundaries.empty()) {
+        _partition_boundaries.erase(_partition_boundaries.begin(), _partition_boundaries.begin() + remove_count);
+    }
+    if (!_peer_group_boundaries.empty()) {
+        _peer_group_boundaries.erase(_peer_group_boundaries.begin(), _peer_group_boundaries.begin() + remove_count);
+    }
 
     _removed_from_buffer_rows += remove_count;
     _partition_start -= remove_count;
@@ -697,6 +816,13 @@ void AnalyticNode::_remove_unused_buffer_values() {
     _current_row_position -= remove_count;
     _peer_group_start -= remove_count;
     _peer_group_end -= remove_count;
+    _sliding_frame.start -= remove_count;
+    _sliding_frame.end -= remove_count;
+    for (auto& queue : _sliding_frame_queues) {
+        for (auto& position : queue) {
+            position -= remove_count;
+        }
+    }
 
     _removed_chunk_index += BUFFER_CHUNK_NUMBER;
 
@@ -737,6 +863,70 @@ void AnalyticNode::_update_window_batch_normal(int64_t peer_group_start, int64_t
     }
 }
 
+void AnalyticNode::_update_sliding_frame(FrameRange range) {
+    if (!_has_incremental_sliding_frame) {
+        _reset_window_state();
+        (this->*_update_window_batch)(_partition_start, _partition_end, range.start, range.end);
+        return;
+    }
+
+    // Both bounds of the clamped frames never decrease in a partition, an empty frame is [start, start).
+    int64_t frame_start = std::max<int64_t>(range.start, _partition_start);
+    int64_t frame_end = std::max<int64_t>(std::min<int64_t>(range.end, _partition_end), frame_start);
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        const Column* agg_column = _agg_intput_columns[i][0].get();
+        AggDataPtr state = _managed_fn_states[0]->mutable_data() + _agg_states_offsets[i];
+        switch (_sliding_frame_modes[i]) {
+        case SlidingFrameMode::Removable:
+            _agg_functions[i]->slide_batch_single_state(_agg_fn_ctxs[i], state, &agg_column, _sliding_frame.start,
+                                                        _sliding_frame.end, frame_start, frame_end);
+            break;
+        case SlidingFrameMode::MaxQueue:
+            _slide_monotonic_queue<true>(i, frame_start, frame_end);
+            break;
+        case SlidingFrameMode::MinQueue:
+            _slide_monotonic_queue<false>(i, frame_start, frame_end);
+            break;
+        case SlidingFrameMode::Recompute:
+            _agg_functions[i]->reset(_agg_fn_ctxs[i], _agg_intput_columns[i], state);
+            _agg_functions[i]->update_batch_single_state(_agg_fn_ctxs[i], state, &agg_column, _partition_start,
+                                                         _partition_end, frame_start, frame_end);
+            break;
+        }
+    }
+    _sliding_frame = {frame_start, frame_end};
+}
+
+template <bool is_max>
+void AnalyticNode::_slide_monotonic_queue(size_t fn_idx, int64_t frame_start, int64_t frame_end) {
+    const Column* agg_column = _agg_intput_columns[fn_idx][0].get();
+    const Column* data_column = agg_column->is_nullable()
+                                        ? down_cast<const NullableColumn*>(agg_column)->data_column().get()
+                                        : agg_column;
+    // For max, a row is never the result once a later row of the frame is not less than it, and vice versa.
+    constexpr int sign = is_max ? 1 : -1;
+    auto& queue = _sliding_frame_queues[fn_idx];
+    for (int64_t i = std::max(frame_start, _sliding_frame.end); i < frame_end; ++i) {
+        if (agg_column->is_null(i)) {
+            continue;
+        }
+        while (!queue.empty() && sign * data_column->compare_at(queue.back(), i, *data_column, 1) <= 0) {
+            queue.pop_back();
+        }
+        queue.push_back(i);
+    }
+    while (!queue.empty() && queue.front() < frame_start) {
+        queue.pop_front();
+    }
+
+    AggDataPtr state = _managed_fn_states[0]->mutable_data() + _agg_states_offsets[fn_idx];
+    _agg_functions[fn_idx]->reset(_agg_fn_ctxs[fn_idx], _agg_intput_columns[fn_idx], state);
+    if (!queue.empty()) {
+        _agg_functions[fn_idx]->update_batch_single_state(_agg_fn_ctxs[fn_idx], state, &agg_column, _partition_start,
+                                                          _partition_end, queue.front(), queue.front() + 1);
+    }
+}
+
 void AnalyticNode::_reset_window_state() {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         _agg_functions[i]->reset(_agg_fn_ctxs[i], _agg_intput_columns[i],
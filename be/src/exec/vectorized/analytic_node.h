@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "exec/exec_node.h"
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/expr.h"
@@ -39,6 +41,23 @@ public:
 private:
     friend class ManagedFunctionStates;
 
+    // How the state of a window function is updated for the sliding frame of each row.
+    enum class SlidingFrameMode {
+        // Reset the state and update it by all the rows of the frame.
+        Recompute,
+        // Remove the rows leaving the frame from the state and update it by the rows entering the frame,
+        // e.g. sum and count.
+        Removable,
+        // The rows of the frame, which could be the result of max or min, are kept in a monotonic queue,
+        // whose front is the result of the frame.
+        MaxQueue,
+        MinQueue
+    };
+
+    // The ranking window functions, whose results only depend on the positions of the rows in their partitions
+    // and peer groups, see _get_next_for_ranking_functions.
+    enum class RankingFunction { RowNumber, Rank, DenseRank };
+
     enum FrameType {
         Unbounded,               // BETWEEN UNBOUNDED PRECEDING AND UNBOUNDED FOLLOWING
         UnboundedPrecedingRange, // RANGE BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW
@@ -54,6 +73,14 @@ private:
 
     Status _get_next_for_sliding_frame(RuntimeState* state, ChunkPtr* chunk, bool* eos);
 
+    // The window functions are all row_number for ROWS BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW, or rank and
+    // dense_rank for RANGE BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW. Their results of the rows of a partition in
+    // a chunk are computed together by the peer group boundaries, instead of the window states row by row or
+    // peer group by peer group.
+    Status _get_next_for_ranking_functions(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+
+    void _compute_ranking_functions(int64_t num_rows);
+
     Status (AnalyticNode::*_get_next)(RuntimeState* state, ChunkPtr* chunk, bool* eos) = nullptr;
 
     void _update_window_batch_normal(int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
@@ -69,6 +96,14 @@ private:
 
     void _reset_window_state();
 
+    // Update the states of the window functions to the sliding frame of the current row,
+    // the states of the functions which aren't SlidingFrameMode::Recompute are slid from the frame
+    // of the previous row.
+    void _update_sliding_frame(FrameRange range);
+
+    template <bool is_max>
+    void _slide_monotonic_queue(size_t fn_idx, int64_t frame_start, int64_t frame_end);
+
     bool _need_fetch_next_chunk(int64_t found_partition_end);
 
     Status _fetch_next_chunk(RuntimeState* state);
@@ -102,7 +137,12 @@ private:
     // Create new aggregate function result column by type
     void _create_agg_result_columns(int64_t chunk_size);
 
-    int64_t _find_first_not_equal(Column* column, int64_t start, int64_t end);
+    // Mark the boundaries of the rows appended to |columns| since the last call, a row is a boundary if it isn't
+    // equal to its previous row in any of the columns.
+    static void _mark_boundaries(const Columns& columns, Column::Filter* boundaries);
+
+    // The first boundary in (start, end), or |end| if there is none.
+    static int64_t _find_first_boundary(const Column::Filter& boundaries, int64_t start, int64_t end);
 
     size_t _compute_memory_usage();
 
@@ -161,12 +201,32 @@ private:
     std::vector<std::vector<ColumnPtr>> _agg_intput_columns;
     std::vector<FunctionTypes> _agg_fn_types;
 
+    std::vector<SlidingFrameMode> _sliding_frame_modes;
+    // Whether any window function isn't SlidingFrameMode::Recompute.
+    bool _has_incremental_sliding_frame = false;
+    // The sliding frame of the previous row in the current partition, clamped by the partition.
+    FrameRange _sliding_frame{0, 0};
+    // The monotonic queues of the rows of the SlidingFrameMode::MaxQueue and SlidingFrameMode::MinQueue
+    // functions, the values of the rows are decreasing for max and increasing for min.
+    std::vector<std::deque<int64_t>> _sliding_frame_queues;
+
     std::vector<ExprContext*> _partition_ctxs;
     Columns _partition_columns;
 
     std::vector<ExprContext*> _order_ctxs;
     Columns _order_columns;
 
+    // The boundaries of the buffered rows by the partition columns and by the order columns, so the ends of the
+    // partitions and of the peer groups are found by a scan of the bitmaps rather than comparing the rows.
+    Column::Filter _partition_boundaries;
+    Column::Filter _peer_group_boundaries;
+
+    // Not empty if all the window functions are computed by _get_next_for_ranking_functions.
+    std::vector<RankingFunction> _ranking_functions;
+    // The rank and the dense rank of the last row computed in the current partition.
+    int64_t _last_rank = 0;
+    int64_t _last_dense_rank = 0;
+
     // Tuple descriptor for storing results of analytic fn evaluation.
     const TupleDescriptor* _result_tuple_desc;
     // Tuple id of the buffered tuple (identical to the input child tuple, which is
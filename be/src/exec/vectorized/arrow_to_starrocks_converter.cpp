@@ -3,6 +3,7 @@
 #include "exec/vectorized/arrow_to_starrocks_converter.h"
 
 #include <arrow/array.h>
+#include <arrow/util/bit_util.h>
 
 #include "column/array_column.h"
 #include "column/nullable_column.h"
@@ -15,6 +16,7 @@
 #include "runtime/primitive_type.h"
 #include "runtime/runtime_state.h"
 #include "runtime/types.h"
+#include "simd/simd.h"
 #include "util/pred_guard.h"
 
 namespace starrocks::vectorized {
@@ -114,27 +116,45 @@ IS_ASSIGNABLE(ArrowTypeId::UINT64, TYPE_LARGEINT)
 IS_ASSIGNABLE(ArrowTypeId::HALF_FLOAT, TYPE_FLOAT, TYPE_DOUBLE)
 IS_ASSIGNABLE(ArrowTypeId::FLOAT, TYPE_DOUBLE)
 
+// Expand |num_bits| bits of the validity bitmap from |bit_offset| to one byte per bit in |dst|, the byte is 1
+// for a valid bit if is_null is false, and for an invalid bit otherwise. The bits are expanded by the SIMD kernels
+// once the bitmap is read from a byte boundary.
+template <bool is_null>
+static void expand_validity_bitmap(const uint8_t* bitmap, int64_t bit_offset, size_t num_bits, uint8_t* dst) {
+    size_t i = 0;
+    for (; i < num_bits && ((bit_offset + i) & 7) != 0; ++i) {
+        dst[i] = arrow::BitUtil::GetBit(bitmap, bit_offset + i) ^ is_null;
+    }
+    SIMD::bitmap_to_bytes(bitmap + (bit_offset + i) / 8, num_bits - i, dst + i, is_null);
+}
+
 size_t fill_null_column(const arrow::Array* array, size_t array_start_idx, size_t num_elements, NullColumn* null_column,
                         size_t column_start_idx) {
-    null_column->resize(null_column->size() + num_elements);
+    null_column->resize_uninitialized(null_column->size() + num_elements);
     auto* null_data = (&null_column->get_data().front()) + column_start_idx;
-    size_t null_count = 0;
-    for (size_t i = 0; i < num_elements; ++i) {
-        auto is_null = array->IsNull(array_start_idx + i);
-        null_data[i] = is_null;
-        null_count += is_null;
-    }
-    return null_count;
+    const uint8_t* bitmap = array->null_bitmap_data();
+    if (bitmap == nullptr) {
+        // no bitmap means either no nulls or all nulls, e.g. NullArray.
+        bool all_null = array->null_count() != 0;
+        memset(null_data, all_null ? DATUM_NULL : DATUM_NOT_NULL, num_elements);
+        return all_null ? num_elements : 0;
+    }
+    expand_validity_bitmap<true>(bitmap, array->offset() + array_start_idx, num_elements, null_data);
+    return num_elements - SIMD::count_zero(null_data, num_elements);
 }
 
 void fill_filter(const arrow::Array* array, size_t array_start_idx, size_t num_elements, Column::Filter* filter,
                  size_t column_start_idx) {
     DCHECK_EQ(filter->size(), column_start_idx + num_elements);
     auto* filter_data = (&filter->front()) + column_start_idx;
-    for (size_t i = 0; i < num_elements; ++i) {
-        filter_data[i] = array->IsValid(array_start_idx + i);
+    const uint8_t* bitmap = array->null_bitmap_data();
+    if (bitmap == nullptr) {
+        memset(filter_data, array->null_count() == 0, num_elements);
+        return;
     }
+    expand_validity_bitmap<false>(bitmap, array->offset() + array_start_idx, num_elements, filter_data);
 }
+
 // A general arrow converter for fixed length type
 //
 // case#1: is_directly_copy(AT, PT>==true
@@ -166,7 +186,12 @@ struct ArrowConverter {
                         [[maybe_unused]] uint8_t* filter_data, ArrowConvertContext* ctx) {
         auto concrete_array = down_cast<const ArrowArrayType*>(array);
         auto concrete_column = down_cast<ColumnType*>(column);
-        concrete_column->resize(column->size() + num_elements);
+        if constexpr (is_directly_copyable<AT, PT>) {
+            // every element is overwritten by the copy
+            concrete_column->resize_uninitialized(column->size() + num_elements);
+        } else {
+            concrete_column->resize(column->size() + num_elements);
+        }
         CppType* data = &concrete_column->get_data().front() + column_start_idx;
         if constexpr (is_directly_copyable<AT, PT>) {
             static_assert(sizeof(CppType) == sizeof(ArrowCppType));
@@ -0,0 +1,331 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/block_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/strings/numbers.h"
+#include "gutil/strings/split.h"
+#include "gutil/strings/strip.h"
+#include "gutil/strings/substitute.h"
+#include "storage/lru_cache.h"
+#include "storage/olap_define.h"
+#include "util/file_utils.h"
+#include "util/metrics.h"
+#include "util/priority_thread_pool.hpp"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks::vectorized {
+
+IntCounter g_block_cache_hit_bytes(MetricUnit::BYTES);      // NOLINT
+IntCounter g_block_cache_miss_bytes(MetricUnit::BYTES);     // NOLINT
+IntCounter g_block_cache_populate_bytes(MetricUnit::BYTES); // NOLINT
+
+static const std::string kCacheFileName = "block_cache.data";
+
+// The cache file and the index of the blocks of a disk.
+class BlockCache::CacheDisk {
+public:
+    CacheDisk(std::string dir, uint64_t capacity, size_t block_size)
+            : _dir(std::move(dir)), _capacity(capacity), _block_size(block_size) {}
+
+    Status init() {
+        uint64_t num_slots = _capacity / _block_size;
+        // Each populate thread takes a free slot before inserting its block and evicting others, so the index
+        // holds fewer blocks than the slots to keep a free slot for each of them.
+        uint64_t num_reserved_slots = std::max(config::block_cache_populate_thread_num, 1);
+        if (num_slots <= num_reserved_slots || num_slots > std::numeric_limits<uint32_t>::max()) {
+            return Status::InvalidArgument(
+                    strings::Substitute("invalid capacity of block cache disk, dir=$0, capacity=$1, block_size=$2",
+                                        _dir, _capacity, _block_size));
+        }
+        RETURN_IF_ERROR(FileUtils::create_dir(_dir));
+        // The index isn't persisted, so the blocks cached before the restart are dropped.
+        RandomRWFileOptions opts;
+        opts.mode = Env::CREATE_OR_OPEN_WITH_TRUNCATE;
+        RETURN_IF_ERROR(Env::Default()->new_random_rw_file(opts, _dir + "/" + kCacheFileName, &_file));
+
+        _free_slots.reserve(num_slots);
+        for (uint64_t i = num_slots; i > 0; i--) {
+            _free_slots.push_back(static_cast<uint32_t>(i - 1));
+        }
+        _index.reset(new_lru_cache((num_slots - num_reserved_slots) * _block_size,
+                                   cache_policy_from_string(config::block_cache_eviction_policy)));
+        LOG(INFO) << "init block cache disk, dir=" << _dir << ", capacity=" << _capacity
+                  << ", num_slots=" << num_slots;
+        return Status::OK();
+    }
+
+    bool read(const std::string& key, uint64_t offset, const Slice& buf) {
+        Cache::Handle* handle = _index->lookup(CacheKey(key));
+        if (handle == nullptr) {
+            return false;
+        }
+        auto* block = reinterpret_cast<Block*>(_index->value(handle));
+        bool hit = offset + buf.size <= block->size;
+        bool failed = false;
+        if (hit) {
+            Status st = _file->read_at(static_cast<uint64_t>(block->slot) * _block_size + offset, buf);
+            if (!st.ok()) {
+                LOG(WARNING) << "fail to read block cache, dir=" << _dir << ", error=" << st.to_string();
+                hit = false;
+                failed = true;
+            }
+        }
+        _index->release(handle);
+        if (failed) {
+            _index->erase(CacheKey(key));
+        }
+        return hit;
+    }
+
+    void write(const std::string& key, const std::string& data) {
+        Cache::Handle* handle = _index->lookup(CacheKey(key));
+        if (handle != nullptr) {
+            // populated by another scan
+            _index->release(handle);
+            return;
+        }
+        uint32_t slot = 0;
+        if (!_alloc_slot(&slot)) {
+            // all the free slots are taken by the blocks still being read after they're evicted
+            return;
+        }
+        Status st = _file->write_at(static_cast<uint64_t>(slot) * _block_size, Slice(data));
+        if (!st.ok()) {
+            LOG(WARNING) << "fail to write block cache, dir=" << _dir << ", error=" << st.to_string();
+            _free_slot(slot);
+            return;
+        }
+        auto* block = new Block{this, slot, static_cast<uint32_t>(data.size())};
+        handle = _index->insert(CacheKey(key), block, _block_size, _delete_block);
+        _index->release(handle);
+        g_block_cache_populate_bytes.increment(data.size());
+    }
+
+    size_t num_blocks() {
+        std::lock_guard l(_mutex);
+        return _capacity / _block_size - _free_slots.size();
+    }
+
+private:
+    struct Block {
+        CacheDisk* disk;
+        uint32_t slot;
+        uint32_t size;
+    };
+
+    // Called when the block is evicted and not read by anyone.
+    static void _delete_block(const CacheKey& key, void* value) {
+        auto* block = reinterpret_cast<Block*>(value);
+        block->disk->_free_slot(block->slot);
+        delete block;
+    }
+
+    bool _alloc_slot(uint32_t* slot) {
+        std::lock_guard l(_mutex);
+        if (_free_slots.empty()) {
+            return false;
+        }
+        *slot = _free_slots.back();
+        _free_slots.pop_back();
+        return true;
+    }
+
+    void _free_slot(uint32_t slot) {
+        std::lock_guard l(_mutex);
+        _free_slots.push_back(slot);
+    }
+
+    std::string _dir;
+    uint64_t _capacity;
+    size_t _block_size;
+    std::unique_ptr<RandomRWFile> _file;
+
+    std::mutex _mutex;
+    std::vector<uint32_t> _free_slots;
+    // Declared last to be destroyed first, which frees the slots of the blocks.
+    std::unique_ptr<Cache> _index;
+};
+
+BlockCache* BlockCache::_s_instance = nullptr;
+
+Status BlockCache::create_global_cache() {
+    if (_s_instance != nullptr || config::block_cache_disks.empty()) {
+        return Status::OK();
+    }
+    auto cache = std::make_unique<BlockCache>(config::block_cache_disks, config::block_cache_block_size);
+    RETURN_IF_ERROR(cache->init());
+    _s_instance = cache.release();
+#ifndef BE_TEST
+    MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
+    reg->register_metric("block_cache_hit_bytes", &g_block_cache_hit_bytes);
+    reg->register_metric("block_cache_miss_bytes", &g_block_cache_miss_bytes);
+    reg->register_metric("block_cache_populate_bytes", &g_block_cache_populate_bytes);
+#endif
+    return Status::OK();
+}
+
+void BlockCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+BlockCache::BlockCache(std::string disks, size_t block_size)
+        : _disks_config(std::move(disks)), _block_size(block_size) {}
+
+BlockCache::~BlockCache() = default;
+
+Status BlockCache::init() {
+    if (_block_size == 0 || _block_size > std::numeric_limits<uint32_t>::max()) {
+        return Status::InvalidArgument(strings::Substitute("invalid block cache block size $0", _block_size));
+    }
+    // /disk1/block_cache,100;/disk2/block_cache,100
+    std::vector<std::string> items = strings::Split(_disks_config, ";", strings::SkipWhitespace());
+    for (const auto& item : items) {
+        std::vector<std::string> parts = strings::Split(item, ",", strings::SkipWhitespace());
+        for (auto& part : parts) {
+            StripWhiteSpace(&part);
+        }
+        int64_t capacity_gb = 0;
+        if (parts.size() != 2 || parts[0].empty() || !safe_strto64(parts[1], &capacity_gb) || capacity_gb <= 0) {
+            return Status::InvalidArgument(strings::Substitute("invalid block cache disk: $0", item));
+        }
+        auto disk = std::make_unique<CacheDisk>(parts[0], capacity_gb * GB_EXCHANGE_BYTE, _block_size);
+        RETURN_IF_ERROR(disk->init());
+        _disks.emplace_back(std::move(disk));
+    }
+    if (_disks.empty()) {
+        return Status::InvalidArgument(strings::Substitute("no block cache disk in $0", _disks_config));
+    }
+    _populate_threads = std::make_unique<PriorityThreadPool>(config::block_cache_populate_thread_num,
+                                                             config::block_cache_populate_queue_size);
+    return Status::OK();
+}
+
+std::string BlockCache::_encode_key(const std::string& path, int64_t mtime, uint64_t block_index) {
+    std::string key(path);
+    key.append(reinterpret_cast<const char*>(&mtime), sizeof(mtime));
+    key.append(reinterpret_cast<const char*>(&block_index), sizeof(block_index));
+    return key;
+}
+
+BlockCache::CacheDisk* BlockCache::_get_disk(const std::string& key) const {
+    return _disks[std::hash<std::string>()(key) % _disks.size()].get();
+}
+
+bool BlockCache::read_block(const std::string& path, int64_t mtime, uint64_t block_index, uint64_t offset,
+                            const Slice& buf) {
+    std::string key = _encode_key(path, mtime, block_index);
+    if (_get_disk(key)->read(key, offset, buf)) {
+        g_block_cache_hit_bytes.increment(buf.size);
+        return true;
+    }
+    g_block_cache_miss_bytes.increment(buf.size);
+    return false;
+}
+
+void BlockCache::populate_block(const std::string& path, int64_t mtime, uint64_t block_index, const Slice& data) {
+    auto key = std::make_shared<std::string>(_encode_key(path, mtime, block_index));
+    auto block = std::make_shared<std::string>(data.data, data.size);
+    PriorityThreadPool::Task task;
+    task.work_function = [this, key, block] { _write_block(*key, *block); };
+    _populate_threads->try_offer(task);
+}
+
+void BlockCache::_write_block(const std::string& key, const std::string& data) {
+    _get_disk(key)->write(key, data);
+}
+
+size_t BlockCache::num_cached_blocks() const {
+    size_t num_blocks = 0;
+    for (const auto& disk : _disks) {
+        num_blocks += disk->num_blocks();
+    }
+    return num_blocks;
+}
+
+BlockCacheFile::BlockCacheFile(std::shared_ptr<RandomAccessFile> file, BlockCache* cache, int64_t mtime,
+                               uint64_t file_size)
+        : _file(std::move(file)), _cache(cache), _mtime(mtime), _file_size(file_size) {}
+
+Status BlockCacheFile::read(uint64_t offset, Slice* res) const {
+    if (offset >= _file_size) {
+        res->size = 0;
+        return Status::OK();
+    }
+    res->size = std::min<uint64_t>(res->size, _file_size - offset);
+    return read_at(offset, *res);
+}
+
+Status BlockCacheFile::read_at(uint64_t offset, const Slice& res) const {
+    if (res.size == 0) {
+        return Status::OK();
+    }
+    if (offset + res.size > _file_size) {
+        return _file->read_at(offset, res);
+    }
+    const uint64_t block_size = _cache->block_size();
+    const uint64_t end = offset + res.size;
+    const uint64_t last_block = (end - 1) / block_size;
+    // the first block of the run of the missing blocks, or -1 if the last block is hit
+    int64_t first_missing = -1;
+    for (uint64_t block = offset / block_size; block <= last_block; block++) {
+        uint64_t block_start = block * block_size;
+        uint64_t copy_start = std::max(offset, block_start);
+        uint64_t copy_end = std::min(end, block_start + block_size);
+        Slice dst(res.data + (copy_start - offset), copy_end - copy_start);
+        if (_cache->read_block(_file->file_name(), _mtime, block, copy_start - block_start, dst)) {
+            _hit_bytes += dst.size;
+            if (first_missing >= 0) {
+                RETURN_IF_ERROR(_read_missing_blocks(first_missing, block - 1, offset, res.size, res.data));
+                first_missing = -1;
+            }
+        } else if (first_missing < 0) {
+            first_missing = block;
+        }
+    }
+    if (first_missing >= 0) {
+        RETURN_IF_ERROR(_read_missing_blocks(first_missing, last_block, offset, res.size, res.data));
+    }
+    return Status::OK();
+}
+
+Status BlockCacheFile::readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const {
+    for (size_t i = 0; i < res_cnt; ++i) {
+        RETURN_IF_ERROR(read_at(offset, res[i]));
+        offset += res[i].size;
+    }
+    return Status::OK();
+}
+
+Status BlockCacheFile::_read_missing_blocks(uint64_t first_block, uint64_t last_block, uint64_t offset,
+                                            uint64_t size, char* dst) const {
+    const uint64_t block_size = _cache->block_size();
+    uint64_t start = first_block * block_size;
+    uint64_t stop = std::min((last_block + 1) * block_size, _file_size);
+    std::unique_ptr<char[]> buf(new char[stop - start]);
+    RETURN_IF_ERROR(_file->read_at(start, Slice(buf.get(), stop - start)));
+
+    uint64_t copy_start = std::max(offset, start);
+    uint64_t copy_end = std::min(offset + size, stop);
+    memcpy(dst + (copy_start - offset), buf.get() + (copy_start - start), copy_end - copy_start);
+    _miss_bytes += copy_end - copy_start;
+
+    for (uint64_t block = first_block; block <= last_block; block++) {
+        uint64_t block_start = block * block_size;
+        uint64_t block_end = std::min(block_start + block_size, _file_size);
+        _cache->populate_block(_file->file_name(), _mtime, block,
+                               Slice(buf.get() + (block_start - start), block_end - block_start));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,120 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "env/env.h"
+#include "gutil/macros.h"
+
+namespace starrocks {
+class PriorityThreadPool;
+}
+
+namespace starrocks::vectorized {
+
+// A global cache of the blocks of the files scanned from hdfs or the object storage on the local disks, so
+// the repeated queries over the same files don't pay the network cost again. A block is keyed by the path
+// and the modification time of its file, and its index in the file. A file rewritten has a new modification
+// time, so the blocks of the old one are never hit again and are evicted at last.
+//
+// Each disk of config::block_cache_disks has a cache file split into the slots of a block, and an index in
+// the memory from the keys to the slots, which evicts the blocks by config::block_cache_eviction_policy. The
+// slot of an evicted block is reused after the readers of it finish. The blocks missing the cache are
+// written to the disks by the populate threads, the scans don't wait for them.
+class BlockCache {
+public:
+    // Create the global instance of config::block_cache_disks, no instance is created if it's empty.
+    static Status create_global_cache();
+
+    static void release_global_cache();
+
+    // Return the global instance, or nullptr if the cache is disabled.
+    static BlockCache* instance() { return _s_instance; }
+
+    // |disks| is in the format of config::block_cache_disks.
+    BlockCache(std::string disks, size_t block_size);
+
+    ~BlockCache();
+
+    Status init();
+
+    size_t block_size() const { return _block_size; }
+
+    // Read [offset, offset + buf.size) of the block |block_index| of the file into |buf|, the offset is in
+    // the block. Return false if the block isn't cached, or it's shorter than the range.
+    bool read_block(const std::string& path, int64_t mtime, uint64_t block_index, uint64_t offset,
+                    const Slice& buf);
+
+    // Cache |data| as the block |block_index| of the file asynchronously. The data is copied, and it's not
+    // cached if the populate threads are busy.
+    void populate_block(const std::string& path, int64_t mtime, uint64_t block_index, const Slice& data);
+
+    // The number of the blocks cached, for test.
+    size_t num_cached_blocks() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(BlockCache);
+
+    class CacheDisk;
+
+    static std::string _encode_key(const std::string& path, int64_t mtime, uint64_t block_index);
+
+    CacheDisk* _get_disk(const std::string& key) const;
+
+    void _write_block(const std::string& key, const std::string& data);
+
+    static BlockCache* _s_instance;
+
+    std::string _disks_config;
+    size_t _block_size;
+    std::vector<std::unique_ptr<CacheDisk>> _disks;
+    // Declared after the disks to stop writing before the disks are closed.
+    std::unique_ptr<PriorityThreadPool> _populate_threads;
+};
+
+// BlockCacheFile serves the reads of a remote file by a BlockCache, and reads the blocks missing
+// the cache from the remote file once for each run of the adjacent missing blocks, then populates them.
+class BlockCacheFile final : public RandomAccessFile {
+public:
+    BlockCacheFile(std::shared_ptr<RandomAccessFile> file, BlockCache* cache, int64_t mtime, uint64_t file_size);
+
+    ~BlockCacheFile() override = default;
+
+    Status read(uint64_t offset, Slice* res) const override;
+
+    Status read_at(uint64_t offset, const Slice& res) const override;
+
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override;
+
+    Status size(uint64_t* size) const override {
+        *size = _file_size;
+        return Status::OK();
+    }
+
+    const std::string& file_name() const override { return _file->file_name(); }
+
+    // The bytes read from the cache and the remote file. They're counted atomically since the file may be
+    // read by the io threads of CoalescedReadFile too.
+    int64_t hit_bytes() const { return _hit_bytes; }
+    int64_t miss_bytes() const { return _miss_bytes; }
+
+private:
+    // Read the blocks [first_block, last_block] from the remote file, copy the part in [offset, offset + size)
+    // to |dst| and populate them.
+    Status _read_missing_blocks(uint64_t first_block, uint64_t last_block, uint64_t offset, uint64_t size,
+                                char* dst) const;
+
+    std::shared_ptr<RandomAccessFile> _file;
+    BlockCache* _cache;
+    int64_t _mtime;
+    uint64_t _file_size;
+    mutable std::atomic<int64_t> _hit_bytes{0};
+    mutable std::atomic<int64_t> _miss_bytes{0};
+};
+
+} // namespace starrocks::vectorized
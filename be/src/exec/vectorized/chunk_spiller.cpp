@@ -0,0 +1,384 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/chunk_spiller.h"
+
+#include <unordered_map>
+
+#include "column/column.h"
+#include "column/column_helper.h"
+#include "common/config.h"
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "util/block_compression.h"
+#include "util/hash_util.hpp"
+#include "util/priority_thread_pool.hpp"
+#include "util/query_trace.h"
+#include "util/uid_util.h"
+
+namespace starrocks::vectorized {
+
+RuntimeChunkMeta create_spill_chunk_meta(RuntimeState* state, const Chunk& layout) {
+    RuntimeChunkMeta chunk_meta;
+    size_t num_columns = layout.num_columns();
+    chunk_meta.types.resize(num_columns);
+    chunk_meta.is_nulls.resize(num_columns);
+    chunk_meta.is_consts.assign(num_columns, false);
+    chunk_meta.slot_id_to_index.init(std::max<size_t>(layout.get_slot_id_to_index_map().size(), 1));
+    chunk_meta.tuple_id_to_index.init(std::max<size_t>(layout.get_tuple_id_to_index_map().size(), 1));
+    for (const auto& kv : layout.get_slot_id_to_index_map()) {
+        SlotDescriptor* slot = state->desc_tbl().get_slot_descriptor(kv.first);
+        chunk_meta.types[kv.second] = slot->type();
+        chunk_meta.is_nulls[kv.second] = slot->is_nullable() || layout.get_column_by_index(kv.second)->is_nullable();
+        chunk_meta.slot_id_to_index.insert(kv.first, kv.second);
+    }
+    // The tuple columns tell whether the tuples of the rows are null.
+    for (const auto& kv : layout.get_tuple_id_to_index_map()) {
+        chunk_meta.types[kv.second] = TypeDescriptor(TYPE_BOOLEAN);
+        chunk_meta.is_nulls[kv.second] = false;
+        chunk_meta.tuple_id_to_index.insert(kv.first, kv.second);
+    }
+    return chunk_meta;
+}
+
+std::shared_ptr<SpillQuota> SpillQuota::get(const TUniqueId& query_id) {
+    static std::mutex mutex;
+    static std::unordered_map<UniqueId, std::weak_ptr<SpillQuota>> quotas;
+    std::lock_guard<std::mutex> l(mutex);
+    std::shared_ptr<SpillQuota> quota = quotas[UniqueId(query_id)].lock();
+    if (quota == nullptr) {
+        quota = std::make_shared<SpillQuota>();
+        quotas[UniqueId(query_id)] = quota;
+        // The quotas of the queries whose spill files are all removed.
+        for (auto iter = quotas.begin(); iter != quotas.end();) {
+            iter = iter->second.expired() ? quotas.erase(iter) : std::next(iter);
+        }
+    }
+    return quota;
+}
+
+Status SpillQuota::acquire(size_t bytes) {
+    int64_t limit = config::spill_max_bytes_per_query;
+    int64_t total = _bytes.fetch_add(bytes) + bytes;
+    if (limit >= 0 && total > limit) {
+        _bytes.fetch_sub(bytes);
+        return Status::InternalError(
+                strings::Substitute("The spilled bytes of the query exceed spill_max_bytes_per_query $0", limit));
+    }
+    return Status::OK();
+}
+
+Status ChunkSpillFile::create(RuntimeState* state, size_t device_hint, std::unique_ptr<ChunkSpillFile>* file) {
+    TmpFileMgr* tmp_file_mgr = state->exec_env()->tmp_file_mgr();
+    std::vector<TmpFileMgr::DeviceId> tmp_devices = tmp_file_mgr->active_tmp_devices();
+    if (tmp_devices.empty()) {
+        return Status::InternalError(
+                "No spilling directories configured. Cannot spill. Set --scratch_dirs"
+                " or see log for previous errors that prevented use of provided directories");
+    }
+    TmpFileMgr::File* tmp_file = nullptr;
+    RETURN_IF_ERROR(
+            tmp_file_mgr->get_file(tmp_devices[device_hint % tmp_devices.size()], state->query_id(), &tmp_file));
+    *file = std::make_unique<ChunkSpillFile>(std::unique_ptr<TmpFileMgr::File>(tmp_file),
+                                             SpillQuota::get(state->query_id()));
+    (*file)->_io_pool = state->exec_env()->spill_io_thread_pool();
+    return Status::OK();
+}
+
+ChunkSpillFile::ChunkSpillFile(std::unique_ptr<TmpFileMgr::File> tmp_file, std::shared_ptr<SpillQuota> quota)
+        : _tmp_file(std::move(tmp_file)), _quota(std::move(quota)) {}
+
+ChunkSpillFile::~ChunkSpillFile() {
+    remove();
+}
+
+Status ChunkSpillFile::write_chunk(const Chunk& chunk, std::string* buffer) {
+    RETURN_IF_ERROR(_wait_writes(_io_pool != nullptr ? kMaxPendingWrites - 1 : 0));
+    size_t size = chunk.serialize(buffer, Chunk::kSerdeVersion2);
+
+    std::string compressed;
+    size_t uncompressed_size = 0;
+    if (config::spill_compress_chunks) {
+        const BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_block_compression_codec(CompressionTypePB::LZ4, &codec));
+        compressed.resize(codec->max_compressed_len(size));
+        Slice output(compressed);
+        RETURN_IF_ERROR(codec->compress(Slice(*buffer), &output));
+        // The chunks which aren't smaller after the compression are written as they are.
+        if (output.size < size) {
+            compressed.resize(output.size);
+            uncompressed_size = size;
+        }
+    }
+    const std::string& data = uncompressed_size > 0 ? compressed : *buffer;
+
+    RETURN_IF_ERROR(_quota->acquire(data.size()));
+    _bytes += data.size();
+    int64_t offset = 0;
+    RETURN_IF_ERROR(_tmp_file->allocate_space(data.size(), &offset));
+    if (_file == nullptr) {
+        // The file is created by the first allocate_space().
+        RandomRWFileOptions opts;
+        opts.mode = Env::CREATE_OR_OPEN;
+        RETURN_IF_ERROR(Env::Default()->new_random_rw_file(opts, _tmp_file->path(), &_file));
+    }
+    _blocks.push_back(Block{offset, data.size(), uncompressed_size});
+
+    if (_io_pool == nullptr) {
+        return _write_block(offset, data);
+    }
+    // The buffer is reused by the caller, so the chunk is written from a copy of it.
+    auto block = std::make_shared<std::string>(uncompressed_size > 0 ? std::move(compressed) : *buffer);
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _pending_writes++;
+    }
+    auto write = [this, offset, block]() {
+        Status status = _write_block(offset, *block);
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_write_status.ok()) {
+            _write_status = status;
+        }
+        _pending_writes--;
+        _cv.notify_all();
+    };
+    if (!_io_pool->offer(write)) {
+        // The pool is shutting down.
+        write();
+    }
+    return Status::OK();
+}
+
+Status ChunkSpillFile::_write_block(int64_t offset, const std::string& data) {
+    Status status = _file->write_at(offset, Slice(data));
+    if (!status.ok()) {
+        _tmp_file->report_io_error(status.get_error_msg());
+    }
+    return status;
+}
+
+Status ChunkSpillFile::_wait_writes(int max_pending) {
+    std::unique_lock<std::mutex> l(_mutex);
+    _cv.wait(l, [&] { return _pending_writes <= max_pending; });
+    return _write_status;
+}
+
+bool ChunkSpillFile::_take_prefetched(size_t idx, std::string* data, Status* status) {
+    std::unique_lock<std::mutex> l(_mutex);
+    if (_prefetch_idx < 0) {
+        return false;
+    }
+    _cv.wait(l, [&] { return _prefetch_done; });
+    bool hit = _prefetch_idx == static_cast<int64_t>(idx);
+    if (hit) {
+        data->swap(_prefetch_data);
+        *status = _prefetch_status;
+    }
+    _prefetch_idx = -1;
+    _prefetch_data.clear();
+    return hit;
+}
+
+void ChunkSpillFile::_prefetch(size_t idx) {
+    if (_io_pool == nullptr || idx >= _blocks.size()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _prefetch_idx = idx;
+        _prefetch_done = false;
+    }
+    const Block& block = _blocks[idx];
+    auto read = [this, offset = block.offset, size = block.size]() {
+        std::string data(size, '\0');
+        Status status = _file->read_at(offset, Slice(data));
+        std::lock_guard<std::mutex> l(_mutex);
+        _prefetch_data.swap(data);
+        _prefetch_status = status;
+        _prefetch_done = true;
+        _cv.notify_all();
+    };
+    if (!_io_pool->try_offer(PriorityThreadPool::Task{0, std::move(read)})) {
+        // The chunk will be read by the caller.
+        std::lock_guard<std::mutex> l(_mutex);
+        _prefetch_idx = -1;
+    }
+}
+
+Status ChunkSpillFile::read_chunk(size_t idx, const RuntimeChunkMeta& chunk_meta, std::string* buffer,
+                                  ChunkPtr* chunk) {
+    DCHECK_LT(idx, _blocks.size());
+    RETURN_IF_ERROR(_wait_writes(0));
+    const Block& block = _blocks[idx];
+    std::string data;
+    Status status;
+    if (_take_prefetched(idx, &data, &status)) {
+        RETURN_IF_ERROR(status);
+    } else {
+        data.resize(block.size);
+        RETURN_IF_ERROR(_file->read_at(block.offset, Slice(data)));
+    }
+    // The next chunk is read while this one is deserialized and processed.
+    _prefetch(idx + 1);
+
+    if (block.uncompressed_size > 0) {
+        const BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_block_compression_codec(CompressionTypePB::LZ4, &codec));
+        buffer->resize(block.uncompressed_size);
+        Slice output(*buffer);
+        RETURN_IF_ERROR(codec->decompress(Slice(data), &output));
+        if (output.size != block.uncompressed_size) {
+            return Status::Corruption("The spilled chunk is corrupted");
+        }
+    } else {
+        buffer->swap(data);
+    }
+    *chunk = std::make_shared<Chunk>();
+    return (*chunk)->deserialize(reinterpret_cast<const uint8_t*>(buffer->data()), buffer->size(), chunk_meta);
+}
+
+void ChunkSpillFile::remove() {
+    // The io thread pool mustn't access the file any more.
+    (void)_wait_writes(0);
+    std::string data;
+    Status status;
+    (void)_take_prefetched(_blocks.size(), &data, &status);
+    if (_quota != nullptr) {
+        _quota->release(_bytes);
+    }
+    _bytes = 0;
+    if (_file != nullptr) {
+        _file->close();
+        _file.reset();
+    }
+    if (_tmp_file != nullptr) {
+        _tmp_file->remove();
+        _tmp_file.reset();
+    }
+    _blocks.clear();
+}
+
+ChunkSpiller::ChunkSpiller(RuntimeState* state, RuntimeChunkMeta&& chunk_meta, RuntimeProfile* runtime_profile,
+                           size_t partition_level)
+        : _state(state), _chunk_meta(std::move(chunk_meta)), _partition_level(partition_level) {
+    DCHECK_LT(_partition_level, max_partition_levels);
+    _spill_timer = ADD_TIMER(runtime_profile, "SpillTime");
+    _spill_rows = ADD_COUNTER(runtime_profile, "SpilledRows", TUnit::UNIT);
+    _spill_bytes = ADD_COUNTER(runtime_profile, "SpilledBytes", TUnit::BYTES);
+    _restore_timer = ADD_TIMER(runtime_profile, "SpillRestoreTime");
+}
+
+ChunkSpiller::~ChunkSpiller() {
+    for (size_t i = 0; i < _partitions.size(); ++i) {
+        remove_partition(i);
+    }
+}
+
+Status ChunkSpiller::prepare() {
+    // The partitions are spread over all the temporary devices.
+    _partitions.resize(1 << num_partitions_bits);
+    for (size_t i = 0; i < _partitions.size(); ++i) {
+        RETURN_IF_ERROR(ChunkSpillFile::create(_state, i, &_partitions[i].file));
+    }
+    _hash_values.reserve(config::vector_chunk_size);
+    _row_indexes.resize(config::vector_chunk_size);
+    return Status::OK();
+}
+
+Status ChunkSpiller::spill(const ChunkPtr& chunk, const Columns& partition_columns) {
+    SCOPED_TIMER(_spill_timer);
+    size_t num_rows = chunk->num_rows();
+    DCHECK_LE(num_rows, config::vector_chunk_size);
+    COUNTER_UPDATE(_spill_rows, num_rows);
+
+    _hash_values.assign(num_rows, HashUtil::FNV_SEED);
+    for (const auto& column : partition_columns) {
+        column->fvn_hash(_hash_values.data(), 0, num_rows);
+    }
+
+    // Compute row indexes for each partition, by the bits of the hash values of this level,
+    // starting from the high bits.
+    size_t num_partitions = _partitions.size();
+    size_t shift = 32 - (_partition_level + 1) * num_partitions_bits;
+    _partition_row_idx_start_points.assign(num_partitions + 1, 0);
+    for (size_t i = 0; i < num_rows; ++i) {
+        uint32_t partition_index = (_hash_values[i] >> shift) & (num_partitions - 1);
+        _partition_row_idx_start_points[partition_index]++;
+        _hash_values[i] = partition_index;
+    }
+    for (size_t i = 1; i <= num_partitions; ++i) {
+        _partition_row_idx_start_points[i] += _partition_row_idx_start_points[i - 1];
+    }
+    for (int i = num_rows - 1; i >= 0; --i) {
+        _row_indexes[_partition_row_idx_start_points[_hash_values[i]] - 1] = i;
+        _partition_row_idx_start_points[_hash_values[i]]--;
+    }
+
+    for (size_t i = 0; i < num_partitions; ++i) {
+        uint32_t from = _partition_row_idx_start_points[i];
+        uint32_t size = _partition_row_idx_start_points[i + 1] - from;
+        if (size == 0) {
+            continue;
+        }
+        auto& partition = _partitions[i];
+        if (partition.buffered_chunk == nullptr) {
+            partition.buffered_chunk = _create_buffered_chunk();
+        } else if (partition.buffered_chunk->num_rows() + size > config::vector_chunk_size) {
+            RETURN_IF_ERROR(_write_chunk(&partition, *partition.buffered_chunk));
+            partition.buffered_chunk->reset();
+        }
+        partition.buffered_chunk->append_selective(*chunk, _row_indexes.data(), from, size);
+    }
+    return Status::OK();
+}
+
+Status ChunkSpiller::flush() {
+    SCOPED_TIMER(_spill_timer);
+    for (auto& partition : _partitions) {
+        if (partition.buffered_chunk != nullptr && partition.buffered_chunk->num_rows() > 0) {
+            RETURN_IF_ERROR(_write_chunk(&partition, *partition.buffered_chunk));
+        }
+        partition.buffered_chunk.reset();
+    }
+    return Status::OK();
+}
+
+ChunkUniquePtr ChunkSpiller::_create_buffered_chunk() const {
+    // The columns are created by the chunk meta rather than the spilled chunks, so that all the written
+    // chunks could be deserialized by it, e.g. a not nullable column is appended to a nullable one.
+    Columns columns(_chunk_meta.types.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        columns[i] = ColumnHelper::create_column(_chunk_meta.types[i], _chunk_meta.is_nulls[i]);
+        columns[i]->reserve(config::vector_chunk_size);
+    }
+    return std::make_unique<Chunk>(std::move(columns), _chunk_meta.slot_id_to_index, _chunk_meta.tuple_id_to_index);
+}
+
+Status ChunkSpiller::_write_chunk(Partition* partition, const Chunk& chunk) {
+    SCOPED_QUERY_TRACE(_state->query_id(), "spill", "write_chunk");
+    size_t bytes = partition->file->bytes();
+    RETURN_IF_ERROR(partition->file->write_chunk(chunk, &_serialize_buffer));
+    COUNTER_UPDATE(_spill_bytes, partition->file->bytes() - bytes);
+    return Status::OK();
+}
+
+Status ChunkSpiller::read_chunk(size_t partition_index, size_t idx, ChunkPtr* chunk) {
+    SCOPED_TIMER(_restore_timer);
+    SCOPED_QUERY_TRACE(_state->query_id(), "spill", "read_chunk", partition_index);
+    auto& partition = _partitions[partition_index];
+    if (partition.file == nullptr || idx >= partition.file->num_chunks()) {
+        *chunk = nullptr;
+        return Status::OK();
+    }
+    return partition.file->read_chunk(idx, _chunk_meta, &_serialize_buffer, chunk);
+}
+
+void ChunkSpiller::remove_partition(size_t partition_index) {
+    auto& partition = _partitions[partition_index];
+    partition.file.reset();
+    partition.buffered_chunk.reset();
+}
+
+} // namespace starrocks::vectorized
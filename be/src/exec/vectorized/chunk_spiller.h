@@ -0,0 +1,171 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+class PriorityThreadPool;
+class RandomRWFile;
+class RuntimeState;
+
+namespace vectorized {
+
+// Create the chunk meta to deserialize the spilled chunks of the layout, i.e. the slots and the tuples
+// of the chunk, the nullable slots are always deserialized as nullable columns.
+RuntimeChunkMeta create_spill_chunk_meta(RuntimeState* state, const Chunk& layout);
+
+// SpillQuota is the bytes spilled by all the operators of a query on this BE, which are limited by
+// config::spill_max_bytes_per_query. It's shared by all the spill files of the query.
+class SpillQuota {
+public:
+    static std::shared_ptr<SpillQuota> get(const TUniqueId& query_id);
+
+    // Return an error if the quota would be exceeded.
+    Status acquire(size_t bytes);
+    void release(size_t bytes) { _bytes.fetch_sub(bytes); }
+
+private:
+    std::atomic<int64_t> _bytes{0};
+};
+
+// ChunkSpillFile is a temporary file of TmpFileMgr holding a sequence of chunks, which are serialized
+// column by column and compressed if config::spill_compress_chunks. The chunks could be read back in any
+// order, but only all at once could be removed.
+//
+// If there is the spill io thread pool of ExecEnv, the chunks are written by it asynchronously, at most
+// kMaxPendingWrites of them of a file at once, and the next chunk is prefetched by it when a chunk is read,
+// so the chunks read in order don't wait for the disk. The errors of the writes are returned by the next
+// calls on the file.
+class ChunkSpillFile {
+public:
+    // Create a file on an active temporary device, the files with different device hints are spread
+    // over all the devices.
+    static Status create(RuntimeState* state, size_t device_hint, std::unique_ptr<ChunkSpillFile>* file);
+
+    ChunkSpillFile(std::unique_ptr<TmpFileMgr::File> tmp_file, std::shared_ptr<SpillQuota> quota);
+    ~ChunkSpillFile();
+
+    // The buffer is used to serialize the chunk, it could be shared by files.
+    Status write_chunk(const Chunk& chunk, std::string* buffer);
+    size_t num_chunks() const { return _blocks.size(); }
+    // The bytes of the written chunks in the file.
+    size_t bytes() const { return _bytes; }
+    // Read the idx-th written chunk, it's deserialized by the chunk meta.
+    Status read_chunk(size_t idx, const RuntimeChunkMeta& chunk_meta, std::string* buffer, ChunkPtr* chunk);
+    // Remove the temporary file, the chunks couldn't be read any more.
+    void remove();
+
+    static constexpr int kMaxPendingWrites = 2;
+
+private:
+    struct Block {
+        int64_t offset;
+        size_t size;
+        // 0 if the block isn't compressed.
+        size_t uncompressed_size;
+    };
+
+    Status _write_block(int64_t offset, const std::string& data);
+    // Wait until the pending writes are at most |max_pending|, return the first error of the writes.
+    Status _wait_writes(int max_pending);
+    // Wait for the prefetch and take the data if it's the idx-th block.
+    bool _take_prefetched(size_t idx, std::string* data, Status* status);
+    void _prefetch(size_t idx);
+
+    std::unique_ptr<TmpFileMgr::File> _tmp_file;
+    std::shared_ptr<SpillQuota> _quota;
+    std::unique_ptr<RandomRWFile> _file;
+    // The offset and size of the written chunks in the file.
+    std::vector<Block> _blocks;
+    size_t _bytes = 0;
+
+    PriorityThreadPool* _io_pool = nullptr;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    int _pending_writes = 0;
+    Status _write_status;
+    // The block read by the io thread pool ahead, -1 if none.
+    int64_t _prefetch_idx = -1;
+    bool _prefetch_done = false;
+    std::string _prefetch_data;
+    Status _prefetch_status;
+};
+
+// ChunkSpiller writes chunks to the temporary files of TmpFileMgr when an operator runs out of
+// memory. The rows are radix partitioned by the hash values of the given partition columns, e.g. the
+// group by columns of an aggregation or the join keys of a hash join, so the rows with the same keys
+// are in the same partition, and the partitions could be processed again one at a time.
+//
+// A partition which is still too large could be partitioned again by a spiller of the next level,
+// which partitions the rows by the next bits of the same hash values.
+//
+// The spilled chunks are serialized without chunk meta, they are deserialized by the chunk meta
+// given by the owner, and all the spilled chunks must have the same layout as it.
+class ChunkSpiller {
+public:
+    ChunkSpiller(RuntimeState* state, RuntimeChunkMeta&& chunk_meta, RuntimeProfile* runtime_profile,
+                 size_t partition_level = 0);
+    // Remove all the temporary files.
+    ~ChunkSpiller();
+
+    Status prepare();
+
+    // Partition the rows of the chunk by the hash values of the partition columns, which are computed
+    // from the chunk row by row, and append them to the partitions.
+    Status spill(const ChunkPtr& chunk, const Columns& partition_columns);
+    // Write the rows buffered in memory of all the partitions, it must be called after the last spill().
+    Status flush();
+
+    size_t partition_level() const { return _partition_level; }
+    size_t num_partitions() const { return _partitions.size(); }
+    // Read the idx-th chunk of the partition, set *chunk to nullptr if all the chunks have been read.
+    Status read_chunk(size_t partition, size_t idx, ChunkPtr* chunk);
+    // Remove the temporary file of the partition, which has been read.
+    void remove_partition(size_t partition);
+
+    static constexpr size_t num_partitions_bits = 5;
+    // The hash values are 32 bits, the bits of a level are not reused by the next levels.
+    static constexpr size_t max_partition_levels = 32 / num_partitions_bits;
+
+private:
+    struct Partition {
+        std::unique_ptr<ChunkSpillFile> file;
+        // The rows of this partition which are not written yet.
+        ChunkUniquePtr buffered_chunk;
+    };
+
+    ChunkUniquePtr _create_buffered_chunk() const;
+    Status _write_chunk(Partition* partition, const Chunk& chunk);
+
+    RuntimeState* _state;
+    RuntimeChunkMeta _chunk_meta;
+    const size_t _partition_level;
+
+    std::vector<Partition> _partitions;
+
+    std::vector<uint32_t> _hash_values;
+    std::vector<uint32_t> _row_indexes;
+    std::vector<uint32_t> _partition_row_idx_start_points;
+    std::string _serialize_buffer;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_rows = nullptr;
+    RuntimeProfile::Counter* _spill_bytes = nullptr;
+    RuntimeProfile::Counter* _restore_timer = nullptr;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -7,6 +7,7 @@
 #include "gutil/casts.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
+#include "util/bit_util.h"
 #include "util/orlp/pdqsort.h"
 #include "util/stopwatch.hpp"
 
@@ -71,7 +72,123 @@ public:
         pdqsort(perm.begin(), perm.end(), cmp_fn);
     }
 
+    // The normalized key of a row encodes all its order-by values into a fixed-width byte string, whose
+    // memcmp order is the order of the rows. Like KeyCoder, a value is encoded in big endian with the sign
+    // bit flipped, and all its bits are flipped for the descending order. A nullable value is prefixed by
+    // a byte, which orders the null before or after all the values.
+
+    // The width of the normalized key of a column, or 0 if the type couldn't be normalized.
+    static size_t normalized_key_width(PrimitiveType type, bool is_nullable) {
+        size_t width = 0;
+        switch (type) {
+        case TYPE_BOOLEAN:
+        case TYPE_TINYINT:
+            width = 1;
+            break;
+        case TYPE_SMALLINT:
+            width = 2;
+            break;
+        case TYPE_INT:
+        case TYPE_DECIMAL32:
+        case TYPE_DATE:
+            width = 4;
+            break;
+        case TYPE_BIGINT:
+        case TYPE_DECIMAL64:
+        case TYPE_DATETIME:
+            width = 8;
+            break;
+        case TYPE_LARGEINT:
+        case TYPE_DECIMAL128:
+            width = 16;
+            break;
+        default:
+            return 0;
+        }
+        return width + is_nullable;
+    }
+
+    // Encode the column into the normalized keys at |offset|, the row i's key starts at keys + i * key_size.
+    template <PrimitiveType PT>
+    static void encode_normalized_keys(const Column* column, bool is_asc_order, bool is_null_first, size_t offset,
+                                       size_t key_size, uint8_t* keys) {
+        using CppTypeName = RunTimeCppType<PT>;
+        using UnsignedType = UnsignedTypeOfSize<sizeof(CppTypeName)>;
+        // The dates and datetimes are compared by their non-negative julian days and timestamps, the booleans
+        // are 0 or 1, so flipping the MSB keeps their order as the signed integers.
+        const UnsignedType sign_bit = static_cast<UnsignedType>(1) << (sizeof(UnsignedType) * CHAR_BIT - 1);
+        const UnsignedType flip_mask = is_asc_order ? static_cast<UnsignedType>(0) : ~static_cast<UnsignedType>(0);
+
+        const Column* data_column = column;
+        const uint8_t* nulls = nullptr;
+        if (column->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(column);
+            data_column = nullable_column->data_column().get();
+            nulls = nullable_column->null_column()->get_data().data();
+        }
+        const auto* data = reinterpret_cast<const CppTypeName*>(data_column->raw_data());
+        const size_t row_num = column->size();
+        for (size_t i = 0; i < row_num; ++i) {
+            uint8_t* key = keys + i * key_size + offset;
+            if (nulls != nullptr) {
+                const bool is_null = nulls[i] != 0;
+                *key++ = is_null != is_null_first;
+                if (is_null) {
+                    // The keys are zero initialized.
+                    continue;
+                }
+            }
+            UnsignedType value;
+            memcpy(&value, &data[i], sizeof(value));
+            value = BitUtil::big_endian(static_cast<UnsignedType>(value ^ sign_bit ^ flip_mask));
+            memcpy(key, &value, sizeof(value));
+        }
+    }
+
+    // Sort by the normalized keys of NUM_WORDS * 8 bytes, which are compared word by word, and the rows
+    // with the same keys are kept in their original order.
+    template <size_t NUM_WORDS>
+    static void sort_by_normalized_keys(const uint8_t* keys, Permutation& perm) {
+        struct KeyItem {
+            uint64_t words[NUM_WORDS];
+            uint32_t index_in_chunk;
+        };
+        const size_t row_num = perm.size();
+        std::vector<KeyItem> sort_items(row_num);
+        for (uint32_t i = 0; i < row_num; ++i) {
+            const uint8_t* key = keys + i * NUM_WORDS * sizeof(uint64_t);
+            for (size_t w = 0; w < NUM_WORDS; ++w) {
+                uint64_t word;
+                memcpy(&word, key + w * sizeof(uint64_t), sizeof(word));
+                sort_items[i].words[w] = BitUtil::big_endian_to_host(word);
+            }
+            sort_items[i].index_in_chunk = i;
+        }
+        auto less_fn = [](const KeyItem& l, const KeyItem& r) -> bool {
+            for (size_t w = 0; w < NUM_WORDS; ++w) {
+                if (l.words[w] != r.words[w]) {
+                    return l.words[w] < r.words[w];
+                }
+            }
+            return l.index_in_chunk < r.index_in_chunk;
+        };
+        pdqsort(sort_items.begin(), sort_items.end(), less_fn);
+        for (size_t i = 0; i < row_num; ++i) {
+            perm[i].index_in_chunk = perm[i].permutation_index = sort_items[i].index_in_chunk;
+        }
+    }
+
+    // The normalized keys longer than it are not sorted as words.
+    static constexpr size_t MAX_NORMALIZED_KEY_WORDS = 4;
+
 private:
+    template <size_t N>
+    using UnsignedTypeOfSize = std::conditional_t<
+            N == 1, uint8_t,
+            std::conditional_t<N == 2, uint16_t,
+                               std::conditional_t<N == 4, uint32_t,
+                                                  std::conditional_t<N == 8, uint64_t, unsigned __int128>>>>;
+
     // Sort on type-known column, and the column has no NULL value in sorting range.
     template <PrimitiveType PT, bool stable>
     static void sort_on_not_null_column_within_range(Column* column, bool is_asc_order, Permutation& perm,
@@ -139,12 +256,13 @@ private:
                                                size_t count = 0) {
         const size_t row_num = (count == 0 || offset + count > perm.size()) ? (perm.size() - offset) : count;
         auto* binary_column = reinterpret_cast<BinaryColumn*>(column);
-        auto& data = binary_column->get_data();
-        std::vector<SortItem<Slice>> sort_items(row_num);
+        // The order of most strings is decided by the prefixes of their views.
+        const auto& data = binary_column->get_string_views();
+        std::vector<SortItem<StringView>> sort_items(row_num);
         for (uint32_t i = 0; i < row_num; ++i) {
             sort_items[i] = {data[perm[i + offset].index_in_chunk], perm[i + offset].index_in_chunk, i};
         }
-        auto less_fn = [](const SortItem<Slice>& l, const SortItem<Slice>& r) -> bool {
+        auto less_fn = [](const SortItem<StringView>& l, const SortItem<StringView>& r) -> bool {
             if constexpr (stable) {
                 int res = l.value.compare(r.value);
                 if (res == 0) {
@@ -157,7 +275,7 @@ private:
                 return res < 0;
             }
         };
-        auto greater_fn = [](const SortItem<Slice>& l, const SortItem<Slice>& r) -> bool {
+        auto greater_fn = [](const SortItem<StringView>& l, const SortItem<StringView>& r) -> bool {
             if constexpr (stable) {
                 int res = l.value.compare(r.value);
                 if (res == 0) {
@@ -230,13 +348,19 @@ private:
 
 ChunksSorterFullSort::ChunksSorterFullSort(const std::vector<ExprContext*>* sort_exprs, const std::vector<bool>* is_asc,
                                            const std::vector<bool>* is_null_first, size_t size_of_chunk_batch)
-        : ChunksSorter(sort_exprs, is_asc, is_null_first, size_of_chunk_batch) {
+        : ChunksSorter(sort_exprs, is_asc, is_null_first, size_of_chunk_batch),
+          _is_asc(is_asc),
+          _is_null_first(is_null_first) {
     _selective_values.resize(config::vector_chunk_size);
 }
 
 ChunksSorterFullSort::~ChunksSorterFullSort() = default;
 
 Status ChunksSorterFullSort::update(RuntimeState* state, const ChunkPtr& chunk) {
+    if (_big_chunk != nullptr && _need_spill(state)) {
+        RETURN_IF_ERROR(_spill_sorted_run(state));
+    }
+
     // Calculate the memory of BigChunk, but every time the mem_usage() of BigChunk is called,
     // the performance may be poor for the Object type.
     // So accumulate the memory of each small Chunk to estimate the total memory.
@@ -265,30 +389,114 @@ Status ChunksSorterFullSort::done(RuntimeState* state) {
     }
 
     DCHECK_EQ(_next_output_row, 0);
+    if (!_sorted_runs.empty()) {
+        RETURN_IF_ERROR(_init_merger());
+    }
     return Status::OK();
 }
 
-void ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
+Status ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
     SCOPED_TIMER(_output_timer);
+    if (_merger != nullptr) {
+        RETURN_IF_ERROR(_merger->get_next(chunk, eos));
+        return _merge_status;
+    }
+
+    ChunkUniquePtr sorted_chunk = _next_sorted_chunk();
+    *eos = sorted_chunk == nullptr;
+    chunk->reset(sorted_chunk.release());
+    return Status::OK();
+}
+
+ChunkUniquePtr ChunksSorterFullSort::_next_sorted_chunk() {
     if (_next_output_row >= _sorted_permutation.size()) {
-        *chunk = nullptr;
-        *eos = true;
-        return;
+        return nullptr;
     }
-    *eos = false;
     size_t count = std::min(size_t(config::vector_chunk_size), _sorted_permutation.size() - _next_output_row);
-    chunk->reset(_sorted_segment->chunk->clone_empty(count).release());
-    _append_rows_to_chunk(chunk->get(), _sorted_segment->chunk.get(), _sorted_permutation, _next_output_row, count);
+    ChunkUniquePtr chunk = _sorted_segment->chunk->clone_empty(count);
+    _append_rows_to_chunk(chunk.get(), _sorted_segment->chunk.get(), _sorted_permutation, _next_output_row, count);
     _next_output_row += count;
+    return chunk;
+}
+
+bool ChunksSorterFullSort::_need_spill(RuntimeState* state) const {
+    if (state == nullptr || !state->enable_spill() || _mem_tracker == nullptr) {
+        return false;
+    }
+    // Sorting the buffered chunks needs the memory of the permutation and the sorted columns,
+    // so they are spilled before the memory left couldn't hold another copy of them.
+    return _mem_tracker->spare_capacity() < _last_memory_usage;
+}
+
+Status ChunksSorterFullSort::_spill_sorted_run(RuntimeState* state) {
+    RETURN_IF_ERROR(_sort_chunks(state));
+
+    SCOPED_TIMER(_spill_timer);
+    if (_sorted_runs.empty()) {
+        // All the chunks are materialized by the same tuple descriptor.
+        _sorted_run_chunk_meta = create_spill_chunk_meta(state, *_sorted_segment->chunk);
+    }
+    std::unique_ptr<ChunkSpillFile> file;
+    RETURN_IF_ERROR(ChunkSpillFile::create(state, _sorted_runs.size(), &file));
+    while (ChunkUniquePtr chunk = _next_sorted_chunk()) {
+        RETURN_IF_ERROR(file->write_chunk(*chunk, &_serialize_buffer));
+    }
+    _sorted_runs.emplace_back(std::move(file));
+
+    // Release the memory of the sorted rows, the next chunks are buffered from scratch.
+    _sorted_segment.reset();
+    Permutation().swap(_sorted_permutation);
+    _next_output_row = 0;
+    _mem_tracker->release(_last_memory_usage);
+    _last_memory_usage = 0;
+    return Status::OK();
+}
+
+Status ChunksSorterFullSort::_init_merger() {
+    ChunkSuppliers suppliers;
+    suppliers.reserve(_sorted_runs.size() + 1);
+    for (auto& run : _sorted_runs) {
+        ChunkSpillFile* file = run.get();
+        size_t next_chunk_idx = 0;
+        suppliers.emplace_back([this, file, next_chunk_idx](Chunk** chunk) mutable -> Status {
+            *chunk = nullptr;
+            if (!_merge_status.ok() || next_chunk_idx >= file->num_chunks()) {
+                return Status::OK();
+            }
+            ChunkPtr read_chunk;
+            _merge_status = file->read_chunk(next_chunk_idx++, _sorted_run_chunk_meta, &_serialize_buffer, &read_chunk);
+            if (_merge_status.ok()) {
+                // The cursor of the merger takes the ownership of the raw chunk.
+                *chunk = new Chunk();
+                (*chunk)->swap_chunk(*read_chunk);
+            }
+            return _merge_status;
+        });
+    }
+    // The rows which are not spilled, they are sorted in memory.
+    if (_next_output_row < _sorted_permutation.size()) {
+        suppliers.emplace_back([this](Chunk** chunk) -> Status {
+            *chunk = _next_sorted_chunk().release();
+            return Status::OK();
+        });
+    }
+
+    _merger = std::make_unique<SortedChunksMerger>();
+    return _merger->init(suppliers, _sort_exprs, _is_asc, _is_null_first);
 }
 
 Status ChunksSorterFullSort::_sort_chunks(RuntimeState* state) {
     // Step1: construct permutation
     RETURN_IF_ERROR(_build_sorting_data(state));
 
-    // Step2: sort by columns or row
+    // Step2: sort by normalized keys, columns or row
+    // Multiple order-by columns of fixed-width types are encoded into normalized keys, which are compared
+    // as integers instead of column by column.
     // For no more than three order-by columns, sorting by columns can benefit from reducing
     // the cost of calling virtual functions of Column::compare_at.
+    if (_get_number_of_order_by_columns() > 1 && _sort_by_normalized_keys()) {
+        return Status::OK();
+    }
     if (_get_number_of_order_by_columns() <= 3) {
         _sort_by_columns();
     } else {
@@ -353,6 +561,82 @@ void ChunksSorterFullSort::_sort_by_row_cmp() {
     }
 }
 
+#define CASE_FOR_NORMALIZED_KEY_ENCODE(PrimitiveTypeName)                                                   \
+    case PrimitiveTypeName: {                                                                               \
+        SortHelper::encode_normalized_keys<PrimitiveTypeName>(column, is_asc_order, is_null_first, offset, \
+                                                              key_size, keys.data());                       \
+        break;                                                                                              \
+    }
+
+bool ChunksSorterFullSort::_sort_by_normalized_keys() {
+    const size_t num_columns = _get_number_of_order_by_columns();
+    std::vector<size_t> key_offsets(num_columns, 0);
+    size_t key_width = 0;
+    for (size_t col_index = 0; col_index < num_columns; ++col_index) {
+        const Column* column = _sorted_segment->order_by_columns[col_index].get();
+        // all the rows are equal on a constant column.
+        if (column->is_constant()) {
+            continue;
+        }
+        size_t width =
+                SortHelper::normalized_key_width((*_sort_exprs)[col_index]->root()->type().type, column->is_nullable());
+        if (width == 0) {
+            return false;
+        }
+        key_offsets[col_index] = key_width;
+        key_width += width;
+    }
+    const size_t num_words = (key_width + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    if (num_words == 0 || num_words > SortHelper::MAX_NORMALIZED_KEY_WORDS) {
+        return false;
+    }
+
+    SCOPED_TIMER(_sort_timer);
+    const size_t key_size = num_words * sizeof(uint64_t);
+    std::vector<uint8_t> keys(_sorted_permutation.size() * key_size, 0);
+    for (size_t col_index = 0; col_index < num_columns; ++col_index) {
+        const Column* column = _sorted_segment->order_by_columns[col_index].get();
+        if (column->is_constant()) {
+            continue;
+        }
+        const bool is_asc_order = (*_is_asc)[col_index];
+        const bool is_null_first = (*_is_null_first)[col_index];
+        const size_t offset = key_offsets[col_index];
+        switch ((*_sort_exprs)[col_index]->root()->type().type) {
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_BOOLEAN)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_TINYINT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_SMALLINT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_INT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_BIGINT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_LARGEINT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DECIMAL32)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DECIMAL64)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DECIMAL128)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DATE)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DATETIME)
+        default:
+            DCHECK(false) << "unsupported type of normalized key";
+            return false;
+        }
+    }
+
+    switch (num_words) {
+    case 1:
+        SortHelper::sort_by_normalized_keys<1>(keys.data(), _sorted_permutation);
+        break;
+    case 2:
+        SortHelper::sort_by_normalized_keys<2>(keys.data(), _sorted_permutation);
+        break;
+    case 3:
+        SortHelper::sort_by_normalized_keys<3>(keys.data(), _sorted_permutation);
+        break;
+    default:
+        SortHelper::sort_by_normalized_keys<4>(keys.data(), _sorted_permutation);
+        break;
+    }
+    return true;
+}
+
 #define CASE_FOR_NULLABLE_COLUMN_SORT(PrimitiveTypeName)                                                       \
     case PrimitiveTypeName: {                                                                                  \
         if (stable) {                                                                                          \
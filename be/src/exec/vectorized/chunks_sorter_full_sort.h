@@ -3,11 +3,17 @@
 #pragma once
 
 #include "column/vectorized_fwd.h"
+#include "exec/vectorized/chunk_spiller.h"
 #include "exec/vectorized/chunks_sorter.h"
 #include "exprs/expr_context.h"
+#include "runtime/vectorized/sorted_chunks_merger.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::vectorized {
+
+// If spilling is enabled and the buffered chunks are about to exceed the memory limit, they are sorted
+// and written to a temporary file as a sorted run, then all the runs, together with the last one left in
+// memory, are merged by a SortedChunksMerger streamingly in get_next().
 class ChunksSorterFullSort : public ChunksSorter {
 public:
     /**
@@ -24,7 +30,7 @@ public:
     // Append a Chunk for sort.
     Status update(RuntimeState* state, const ChunkPtr& chunk) override;
     Status done(RuntimeState* state) override;
-    void get_next(ChunkPtr* chunk, bool* eos) override;
+    Status get_next(ChunkPtr* chunk, bool* eos) override;
 
     friend class SortHelper;
 
@@ -34,13 +40,33 @@ private:
 
     void _sort_by_row_cmp();
     void _sort_by_columns();
+    // Sort by the normalized keys if all the order-by columns are of fixed-width types and the keys are short
+    // enough, return false if it's not sorted.
+    bool _sort_by_normalized_keys();
 
     void _append_rows_to_chunk(Chunk* dest, Chunk* src, const Permutation& permutation, size_t offset, size_t count);
+    // Output the next chunk of the sorted rows in memory, return nullptr if all the rows are output.
+    ChunkUniquePtr _next_sorted_chunk();
+
+    bool _need_spill(RuntimeState* state) const;
+    // Sort the buffered chunks and write them to a new sorted run.
+    Status _spill_sorted_run(RuntimeState* state);
+    Status _init_merger();
+
+    const std::vector<bool>* _is_asc;
+    const std::vector<bool>* _is_null_first;
 
     ChunkUniquePtr _big_chunk;
     std::unique_ptr<DataSegment> _sorted_segment;
     Permutation _sorted_permutation;
     std::vector<uint32_t> _selective_values; // for appending selective values to sorted rows
+
+    std::vector<std::unique_ptr<ChunkSpillFile>> _sorted_runs;
+    RuntimeChunkMeta _sorted_run_chunk_meta;
+    std::string _serialize_buffer;
+    std::unique_ptr<SortedChunksMerger> _merger;
+    // The first error of reading the sorted runs, which couldn't be returned by the chunk suppliers.
+    Status _merge_status;
 };
 
 } // namespace starrocks::vectorized
@@ -2,11 +2,13 @@
 
 #include "chunks_sorter_topn.h"
 
+#include "column/datum.h"
 #include "column/type_traits.h"
 #include "exprs/expr.h"
 #include "gutil/casts.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
+#include "storage/vectorized/runtime_column_predicate.h"
 #include "util/orlp/pdqsort.h"
 #include "util/stopwatch.hpp"
 
@@ -83,18 +85,19 @@ Status ChunksSorterTopn::done(RuntimeState* state) {
     return Status::OK();
 }
 
-void ChunksSorterTopn::get_next(ChunkPtr* chunk, bool* eos) {
+Status ChunksSorterTopn::get_next(ChunkPtr* chunk, bool* eos) {
     ScopedTimer<MonotonicStopWatch> timer(_output_timer);
     if (_next_output_row >= _merged_segment.chunk->num_rows()) {
         *chunk = nullptr;
         *eos = true;
-        return;
+        return Status::OK();
     }
     *eos = false;
     size_t count = std::min(size_t(config::vector_chunk_size), _merged_segment.chunk->num_rows() - _next_output_row);
     chunk->reset(_merged_segment.chunk->clone_empty(count).release());
     (*chunk)->append_safe(*_merged_segment.chunk, _next_output_row, count);
     _next_output_row += count;
+    return Status::OK();
 }
 
 Status ChunksSorterTopn::_sort_chunks(RuntimeState* state) {
@@ -130,9 +133,30 @@ Status ChunksSorterTopn::_sort_chunks(RuntimeState* state) {
     size_t memory_in_use = sizeof(DataSegment) + _merged_segment.chunk->memory_usage();
     RETURN_IF_ERROR(_consume_and_check_memory_limit(state, memory_in_use - _last_memory_usage));
 
+    if (_runtime_predicate != nullptr) {
+        _update_runtime_predicate();
+    }
     return Status::OK();
 }
 
+void ChunksSorterTopn::_update_runtime_predicate() {
+    // The rows after the last one of the top rows are never output, nor are the rows out of its bound on the first
+    // order-by column. The null rows are kept by the predicate itself if they are ordered before the boundary.
+    const size_t number_of_rows_to_sort = _get_number_of_rows_to_sort();
+    if (_merged_segment.chunk->num_rows() < number_of_rows_to_sort) {
+        return;
+    }
+    Datum boundary = _merged_segment.order_by_columns[0]->get(number_of_rows_to_sort - 1);
+    if (boundary.is_null()) {
+        return;
+    }
+    std::string bound = RuntimeColumnPredicate::format_bound(_runtime_predicate_type, boundary);
+    if (bound != _runtime_predicate_bound) {
+        _runtime_predicate_bound = bound;
+        _runtime_predicate->update(std::move(bound));
+    }
+}
+
 Status ChunksSorterTopn::_build_sorting_data(RuntimeState* state, Permutation& permutation_second,
                                              DataSegments& segments) {
     ScopedTimer<MonotonicStopWatch> timer(_build_timer);
@@ -8,6 +8,9 @@
 #include "util/runtime_profile.h"
 
 namespace starrocks::vectorized {
+
+class RuntimeColumnPredicate;
+
 // Sort Chunks in memory with specified order by rules.
 class ChunksSorterTopn : public ChunksSorter {
 public:
@@ -30,13 +33,22 @@ public:
     // Finish seeding Chunk, and get sorted data with top OFFSET rows have been skipped.
     Status done(RuntimeState* state) override;
     // get_next only works after done().
-    void get_next(ChunkPtr* chunk, bool* eos) override;
+    Status get_next(ChunkPtr* chunk, bool* eos) override;
+
+    // Publish the boundary of the top rows on the first order-by column of |type| by |runtime_predicate|
+    // once there are enough rows, and publish it again whenever it's tightened.
+    void set_runtime_predicate(RuntimeColumnPredicate* runtime_predicate, PrimitiveType type) {
+        _runtime_predicate = runtime_predicate;
+        _runtime_predicate_type = type;
+    }
 
 private:
     inline size_t _get_number_of_rows_to_sort() const { return _offset + _limit; }
 
     Status _sort_chunks(RuntimeState* state);
 
+    void _update_runtime_predicate();
+
     // build data for top-n
     Status _build_sorting_data(RuntimeState* state, Permutation& permutation_second, DataSegments& segments);
 
@@ -82,6 +94,11 @@ private:
 
     bool _init_merged_segment;
     DataSegment _merged_segment;
+
+    RuntimeColumnPredicate* _runtime_predicate = nullptr;
+    PrimitiveType _runtime_predicate_type = INVALID_TYPE;
+    // The last published boundary.
+    std::string _runtime_predicate_bound;
 };
 
 } // namespace starrocks::vectorized
@@ -0,0 +1,190 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/coalesced_read_file.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/config.h"
+#include "exec/vectorized/hdfs_scanner.h"
+#include "util/priority_thread_pool.hpp"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized {
+
+CoalescedReadFile::CoalescedReadFile(std::shared_ptr<RandomAccessFile> file, PriorityThreadPool* io_threads,
+                                     HdfsScanStats* stats)
+        : _file(std::move(file)), _io_threads(io_threads), _stats(stats) {}
+
+CoalescedReadFile::~CoalescedReadFile() {
+    for (auto& range : _ranges) {
+        std::unique_lock l(range->mutex);
+        if (range->state == CoalescedRange::PREFETCHING) {
+            range->state = CoalescedRange::CANCELLED;
+        }
+        range->cond.wait(l, [&] { return range->state != CoalescedRange::READING; });
+    }
+}
+
+void CoalescedReadFile::plan(std::vector<IORange> ranges) {
+    std::sort(ranges.begin(), ranges.end(), [](const IORange& a, const IORange& b) { return a.offset < b.offset; });
+    std::vector<CoalescedRangePtr> merged;
+    for (const auto& r : ranges) {
+        if (r.size == 0) {
+            continue;
+        }
+        if (!merged.empty()) {
+            CoalescedRange* last = merged.back().get();
+            uint64_t last_end = last->offset + last->size;
+            uint64_t end = r.offset + r.size;
+            if (r.offset <= last_end + config::hdfs_scan_io_coalesce_max_gap_bytes &&
+                (r.offset < last_end || end - last->offset <= config::hdfs_scan_io_coalesce_max_bytes)) {
+                last->size = std::max(last_end, end) - last->offset;
+                continue;
+            }
+        }
+        auto range = std::make_shared<CoalescedRange>();
+        range->offset = r.offset;
+        range->size = r.size;
+        merged.emplace_back(std::move(range));
+    }
+
+    for (auto& range : merged) {
+        auto iter = std::upper_bound(_ranges.begin(), _ranges.end(), range->offset,
+                                     [](uint64_t offset, const CoalescedRangePtr& r) { return offset < r->offset; });
+        if (iter != _ranges.end() && (*iter)->offset < range->offset + range->size) {
+            continue;
+        }
+        if (iter != _ranges.begin() && (*(iter - 1))->offset + (*(iter - 1))->size > range->offset) {
+            continue;
+        }
+        _ranges.insert(iter, std::move(range));
+    }
+}
+
+void CoalescedReadFile::prefetch(uint64_t offset, uint64_t size) {
+    for (auto& range : _ranges) {
+        if (range->offset < offset || range->offset + range->size > offset + size || range->prefetched) {
+            continue;
+        }
+        if (_prefetched_bytes + range->size > config::hdfs_scan_io_buffer_max_bytes) {
+            continue;
+        }
+        range->prefetched = true;
+        _prefetched_bytes += range->size;
+        {
+            std::lock_guard l(range->mutex);
+            range->state = CoalescedRange::PREFETCHING;
+        }
+        if (_io_threads != nullptr) {
+            // It's read by the caller if the io threads are busy.
+            PriorityThreadPool::Task task;
+            task.work_function = [file = _file, range] { _read_range(file.get(), range.get()); };
+            _io_threads->try_offer(task);
+        }
+    }
+}
+
+void CoalescedReadFile::release(uint64_t offset, uint64_t size) {
+    auto iter = std::remove_if(_ranges.begin(), _ranges.end(), [&](const CoalescedRangePtr& range) {
+        if (range->offset < offset || range->offset + range->size > offset + size) {
+            return false;
+        }
+        if (range->prefetched) {
+            _prefetched_bytes -= range->size;
+        }
+        std::lock_guard l(range->mutex);
+        if (range->state == CoalescedRange::PREFETCHING) {
+            range->state = CoalescedRange::CANCELLED;
+        }
+        return true;
+    });
+    _ranges.erase(iter, _ranges.end());
+}
+
+void CoalescedReadFile::_read_range(RandomAccessFile* file, CoalescedRange* range) {
+    {
+        std::lock_guard l(range->mutex);
+        if (range->state != CoalescedRange::PREFETCHING) {
+            return;
+        }
+        range->state = CoalescedRange::READING;
+    }
+    std::unique_ptr<char[]> data(new char[range->size]);
+    Status st = file->read_at(range->offset, Slice(data.get(), range->size));
+    {
+        std::lock_guard l(range->mutex);
+        range->data = std::move(data);
+        range->status = std::move(st);
+        range->state = CoalescedRange::DONE;
+    }
+    range->cond.notify_all();
+}
+
+CoalescedReadFile::CoalescedRange* CoalescedReadFile::_find_range(uint64_t offset, uint64_t size) const {
+    auto iter = std::upper_bound(_ranges.begin(), _ranges.end(), offset,
+                                 [](uint64_t offset, const CoalescedRangePtr& r) { return offset < r->offset; });
+    if (iter == _ranges.begin()) {
+        return nullptr;
+    }
+    CoalescedRange* range = (iter - 1)->get();
+    if (!range->prefetched || offset + size > range->offset + range->size) {
+        return nullptr;
+    }
+    return range;
+}
+
+Status CoalescedReadFile::_wait_range(CoalescedRange* range) const {
+    _read_range(_file.get(), range);
+    {
+        SCOPED_RAW_TIMER(&_stats->io_prefetch_wait_ns);
+        std::unique_lock l(range->mutex);
+        range->cond.wait(l, [&] { return range->state == CoalescedRange::DONE; });
+    }
+    if (!range->used) {
+        range->used = true;
+        _stats->io_coalesced_count += 1;
+        _stats->io_coalesced_bytes += range->size;
+    }
+    return range->status;
+}
+
+Status CoalescedReadFile::read(uint64_t offset, Slice* res) const {
+    CoalescedRange* range = _find_range(offset, res->size);
+    if (range == nullptr) {
+        return _file->read(offset, res);
+    }
+    RETURN_IF_ERROR(_wait_range(range));
+    memcpy(res->data, range->data.get() + (offset - range->offset), res->size);
+    return Status::OK();
+}
+
+Status CoalescedReadFile::read_at(uint64_t offset, const Slice& res) const {
+    CoalescedRange* range = _find_range(offset, res.size);
+    if (range == nullptr) {
+        return _file->read_at(offset, res);
+    }
+    RETURN_IF_ERROR(_wait_range(range));
+    memcpy(res.data, range->data.get() + (offset - range->offset), res.size);
+    return Status::OK();
+}
+
+Status CoalescedReadFile::readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const {
+    size_t total_size = 0;
+    for (size_t i = 0; i < res_cnt; ++i) {
+        total_size += res[i].size;
+    }
+    CoalescedRange* range = _find_range(offset, total_size);
+    if (range == nullptr) {
+        return _file->readv_at(offset, res, res_cnt);
+    }
+    RETURN_IF_ERROR(_wait_range(range));
+    const char* data = range->data.get() + (offset - range->offset);
+    for (size_t i = 0; i < res_cnt; ++i) {
+        memcpy(res[i].data, data, res[i].size);
+        data += res[i].size;
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,107 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "env/env.h"
+
+namespace starrocks {
+class PriorityThreadPool;
+}
+
+namespace starrocks::vectorized {
+
+struct HdfsScanStats;
+
+// CoalescedReadFile reads the byte ranges of a file planned in advance, usually the column chunks of the row
+// groups or stripes to scan, by a few large reads instead of the small ones of the readers, since each read of
+// HDFS or the object storage pays the remote latency.
+//
+// The planned ranges whose gap is at most config::hdfs_scan_io_coalesce_max_gap_bytes are merged into one read
+// of at most config::hdfs_scan_io_coalesce_max_bytes. The merged reads are started by prefetch() in the io
+// threads, so the next row group can be read while the current one is being decoded, and are read by the
+// caller if they haven't been started when they are needed. The reads out of the prefetched ranges go to the
+// underlying file directly.
+//
+// It's used by one scanner, and it's not thread-safe except the prefetches.
+class CoalescedReadFile final : public RandomAccessFile {
+public:
+    struct IORange {
+        IORange() = default;
+        IORange(uint64_t offset_, uint64_t size_) : offset(offset_), size(size_) {}
+
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    // The prefetches are read by the caller if |io_threads| is nullptr.
+    CoalescedReadFile(std::shared_ptr<RandomAccessFile> file, PriorityThreadPool* io_threads, HdfsScanStats* stats);
+
+    // Waits for the running prefetches.
+    ~CoalescedReadFile() override;
+
+    // Plan to read |ranges|. The ones overlapping the planned ranges are ignored.
+    void plan(std::vector<IORange> ranges);
+
+    // Start reading the planned ranges in [offset, offset + size) by the io threads. The ranges exceeding
+    // config::hdfs_scan_io_buffer_max_bytes with the ones prefetched before are not read in advance.
+    void prefetch(uint64_t offset, uint64_t size);
+
+    // Release the planned ranges in [offset, offset + size) and the data read of them.
+    void release(uint64_t offset, uint64_t size);
+
+    Status read(uint64_t offset, Slice* res) const override;
+
+    Status read_at(uint64_t offset, const Slice& res) const override;
+
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override;
+
+    Status size(uint64_t* size) const override { return _file->size(size); }
+
+    const std::string& file_name() const override { return _file->file_name(); }
+
+private:
+    // A merged read of the planned ranges.
+    struct CoalescedRange {
+        enum State { PLANNED, PREFETCHING, READING, DONE, CANCELLED };
+
+        uint64_t offset = 0;
+        uint64_t size = 0;
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        State state = PLANNED;
+        Status status;
+        std::unique_ptr<char[]> data;
+
+        // Only accessed by the caller.
+        bool prefetched = false;
+        bool used = false;
+    };
+    using CoalescedRangePtr = std::shared_ptr<CoalescedRange>;
+
+    static void _read_range(RandomAccessFile* file, CoalescedRange* range);
+
+    // Returns the prefetched range containing [offset, offset + size), or nullptr.
+    CoalescedRange* _find_range(uint64_t offset, uint64_t size) const;
+
+    // Wait for |range| to be read, or read it if its prefetch hasn't been started.
+    Status _wait_range(CoalescedRange* range) const;
+
+    std::shared_ptr<RandomAccessFile> _file;
+    PriorityThreadPool* _io_threads;
+    HdfsScanStats* _stats;
+
+    // Sorted by the offsets, and not overlapped.
+    std::vector<CoalescedRangePtr> _ranges;
+    // The bytes of the ranges prefetched and not released.
+    uint64_t _prefetched_bytes = 0;
+};
+
+} // namespace starrocks::vectorized
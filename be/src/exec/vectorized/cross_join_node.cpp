@@ -2,9 +2,13 @@
 
 #include "exec/vectorized/cross_join_node.h"
 
+#include <algorithm>
+
 #include "column/chunk.h"
 #include "column/column_helper.h"
+#include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "exprs/vectorized/column_ref.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks::vectorized {
@@ -25,9 +29,92 @@ Status CrossJoinNode::prepare(RuntimeState* state) {
     _probe_rows_counter = ADD_COUNTER(runtime_profile(), "ProbeRows", TUnit::UNIT);
 
     _init_row_desc();
+    if (config::enable_cross_join_range_probe) {
+        _init_range_conjuncts();
+    }
     return Status::OK();
 }
 
+static TExprOpcode::type _reverse_op(TExprOpcode::type op) {
+    switch (op) {
+    case TExprOpcode::LT:
+        return TExprOpcode::GT;
+    case TExprOpcode::LE:
+        return TExprOpcode::GE;
+    case TExprOpcode::GT:
+        return TExprOpcode::LT;
+    default:
+        return TExprOpcode::LE;
+    }
+}
+
+// The values of the types are compared by Column::compare_at() as the conjuncts compare them, unlike the NaNs of
+// the floating points.
+static bool _is_range_comparable_type(PrimitiveType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_DECIMALV2:
+    case TYPE_DECIMAL32:
+    case TYPE_DECIMAL64:
+    case TYPE_DECIMAL128:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void CrossJoinNode::_init_range_conjuncts() {
+    std::vector<TupleId> probe_tuple_ids;
+    for (const auto* tuple_desc : child(0)->row_desc().tuple_descriptors()) {
+        probe_tuple_ids.emplace_back(tuple_desc->id());
+    }
+    const RowDescriptor& build_row_desc = child(1)->row_desc();
+
+    for (ExprContext* ctx : _conjunct_ctxs) {
+        Expr* root = ctx->root();
+        if (root->node_type() != TExprNodeType::BINARY_PRED || root->get_num_children() != 2) {
+            continue;
+        }
+        TExprOpcode::type op = root->op();
+        if (op != TExprOpcode::LT && op != TExprOpcode::LE && op != TExprOpcode::GT && op != TExprOpcode::GE) {
+            continue;
+        }
+        // Normalize it to "probe_expr op build_slot".
+        Expr* build_expr = root->get_child(1);
+        Expr* probe_expr = root->get_child(0);
+        if (!build_expr->is_slotref() ||
+            build_row_desc.get_tuple_idx(down_cast<ColumnRef*>(build_expr)->tuple_id()) == RowDescriptor::INVALID_IDX) {
+            std::swap(build_expr, probe_expr);
+            op = _reverse_op(op);
+        }
+        if (!build_expr->is_slotref() ||
+            build_row_desc.get_tuple_idx(down_cast<ColumnRef*>(build_expr)->tuple_id()) == RowDescriptor::INVALID_IDX) {
+            continue;
+        }
+        std::vector<SlotId> probe_slot_ids;
+        if (probe_expr->get_slot_ids(&probe_slot_ids) == 0 || !probe_expr->is_bound(probe_tuple_ids)) {
+            continue;
+        }
+        const TypeDescriptor& type = build_expr->type();
+        if (!(type == probe_expr->type()) || !_is_range_comparable_type(type.type)) {
+            continue;
+        }
+        SlotId slot_id = down_cast<ColumnRef*>(build_expr)->slot_id();
+        if (_range_conjuncts.empty()) {
+            _range_build_slot_id = slot_id;
+        } else if (slot_id != _range_build_slot_id) {
+            continue;
+        }
+        _range_conjuncts.push_back({ctx, probe_expr, op, nullptr});
+    }
+}
+
 Status CrossJoinNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
@@ -60,6 +147,14 @@ Status CrossJoinNode::_get_next_probe_chunk(RuntimeState* state) {
     _build_chunks_index = 0;
     _probe_chunk_index = 0;
 
+    for (auto& conjunct : _range_conjuncts) {
+        conjunct.probe_values = ColumnHelper::unpack_and_duplicate_const_column(
+                _probe_chunk->num_rows(), conjunct.ctx->evaluate(conjunct.probe_expr, _probe_chunk.get()));
+    }
+    _range_next_probe_row = 0;
+    _range_build_index = 0;
+    _range_build_end = 0;
+
     return Status::OK();
 }
 
@@ -306,7 +401,9 @@ Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bo
         // once _probe_chunk_index == _probe_chunk->num_rows() is true,
         // this condition will always true for this _probe_chunk,
         // Until _probe_chunk be done.
-        if (_probe_chunk_index == _probe_chunk->num_rows()) {
+        if (_sorted_build_column != nullptr) {
+            _copy_joined_rows_in_build_ranges(*chunk, row_count);
+        } else if (_probe_chunk_index == _probe_chunk->num_rows()) {
             // step 2:
             // if left chunk is bigger than right, we shuld scan left based on right.
             if (_probe_chunk_index > _number_of_build_rows - _build_chunks_size) {
@@ -480,6 +577,10 @@ Status CrossJoinNode::_build(RuntimeState* state) {
         }
     }
 
+    if (_build_chunk != nullptr && !_range_conjuncts.empty()) {
+        _sort_build_chunk();
+    }
+
     // Should not call num_rows on nullptr.
     if (_build_chunk != nullptr) {
         _number_of_build_rows = _build_chunk->num_rows();
@@ -490,6 +591,93 @@ Status CrossJoinNode::_build(RuntimeState* state) {
     return Status::OK();
 }
 
+void CrossJoinNode::_sort_build_chunk() {
+    const ColumnPtr& column = _build_chunk->get_column_by_slot_id(_range_build_slot_id);
+    if (column->is_constant()) {
+        _range_conjuncts.clear();
+        return;
+    }
+    const Column* data_column = ColumnHelper::get_data_column(column.get());
+    std::vector<uint32_t> rows;
+    rows.reserve(column->size());
+    for (uint32_t row = 0; row < column->size(); row++) {
+        if (!column->is_null(row)) {
+            rows.emplace_back(row);
+        }
+    }
+    std::stable_sort(rows.begin(), rows.end(), [data_column](uint32_t lhs, uint32_t rhs) {
+        return data_column->compare_at(lhs, rhs, *data_column, 1) < 0;
+    });
+
+    ChunkPtr sorted_chunk = _build_chunk->clone_empty_with_tuple(rows.size());
+    sorted_chunk->append_selective(*_build_chunk, rows.data(), 0, rows.size());
+    _build_chunk = std::move(sorted_chunk);
+    const ColumnPtr& sorted_column = _build_chunk->get_column_by_slot_id(_range_build_slot_id);
+    _sorted_build_column = ColumnHelper::get_data_column(sorted_column.get());
+}
+
+size_t CrossJoinNode::_build_bound(const Column& values, size_t row, bool upper) const {
+    size_t begin = 0;
+    size_t end = _build_chunk->num_rows();
+    while (begin < end) {
+        size_t mid = begin + (end - begin) / 2;
+        int cmp = _sorted_build_column->compare_at(mid, row, values, 1);
+        if (cmp < 0 || (upper && cmp == 0)) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    return begin;
+}
+
+void CrossJoinNode::_find_build_range(size_t probe_row, size_t* begin, size_t* end) const {
+    *begin = 0;
+    *end = _build_chunk->num_rows();
+    for (const auto& conjunct : _range_conjuncts) {
+        const Column& values = *conjunct.probe_values;
+        if (values.is_null(probe_row)) {
+            *end = 0;
+            break;
+        }
+        const Column& data_values = *ColumnHelper::get_data_column(&values);
+        switch (conjunct.op) {
+        case TExprOpcode::GE:
+            // build_slot <= probe_expr
+            *end = std::min(*end, _build_bound(data_values, probe_row, true));
+            break;
+        case TExprOpcode::GT:
+            *end = std::min(*end, _build_bound(data_values, probe_row, false));
+            break;
+        case TExprOpcode::LE:
+            // build_slot >= probe_expr
+            *begin = std::max(*begin, _build_bound(data_values, probe_row, false));
+            break;
+        default:
+            *begin = std::max(*begin, _build_bound(data_values, probe_row, true));
+            break;
+        }
+    }
+    *begin = std::min(*begin, *end);
+}
+
+void CrossJoinNode::_copy_joined_rows_in_build_ranges(ChunkPtr& chunk, size_t row_count) {
+    // Find the range of the next probe row till one with build rows.
+    while (_range_build_index == _range_build_end) {
+        if (_range_next_probe_row == _probe_chunk->num_rows()) {
+            // _probe_chunk is done with _build_chunk.
+            _probe_chunk = nullptr;
+            return;
+        }
+        _range_probe_row = _range_next_probe_row++;
+        _find_build_range(_range_probe_row, &_range_build_index, &_range_build_end);
+    }
+
+    row_count = std::min(row_count, _range_build_end - _range_build_index);
+    _copy_joined_rows_with_index_base_probe(chunk, row_count, _range_probe_row, _range_build_index);
+    _range_build_index += row_count;
+}
+
 void CrossJoinNode::_init_chunk(ChunkPtr* chunk) {
     ChunkPtr new_chunk = std::make_shared<Chunk>();
 
@@ -4,6 +4,7 @@
 
 #include "column/chunk.h"
 #include "exec/exec_node.h"
+#include "gen_cpp/Opcodes_types.h"
 
 namespace starrocks::vectorized {
 class CrossJoinNode : public ExecNode {
@@ -45,6 +46,40 @@ private:
     void _init_row_desc();
     void _init_chunk(ChunkPtr* chunk);
 
+    // The range conjuncts "probe_expr op build_slot" of the build slot compared by the first of them, see
+    // config::enable_cross_join_range_probe.
+    void _init_range_conjuncts();
+    // Sort the build rows by the build slot of the range conjuncts, the rows of null build slots are removed since
+    // they can't pass the conjuncts.
+    void _sort_build_chunk();
+    // Append the joined rows of the probe rows and the build rows in their ranges to |chunk|, at most |row_count|.
+    void _copy_joined_rows_in_build_ranges(ChunkPtr& chunk, size_t row_count);
+    // Set [*begin, *end) to the sorted build rows that the probe row |probe_row| may be joined with.
+    void _find_build_range(size_t probe_row, size_t* begin, size_t* end) const;
+    // The first sorted build row of a value not less than (or greater than if |upper|) the value of |row| of
+    // |values|.
+    size_t _build_bound(const Column& values, size_t row, bool upper) const;
+
+    // A conjunct "probe_expr op build_slot", op is one of <, <=, > and >=, e.g. a.ts >= b.start for a.ts BETWEEN
+    // b.start AND b.end.
+    struct RangeConjunct {
+        ExprContext* ctx;
+        Expr* probe_expr;
+        TExprOpcode::type op;
+        // The values of probe_expr of the probe chunk.
+        ColumnPtr probe_values;
+    };
+    std::vector<RangeConjunct> _range_conjuncts;
+    SlotId _range_build_slot_id = -1;
+    // The data column of the build slot of the sorted build chunk.
+    const Column* _sorted_build_column = nullptr;
+    // The probe row to find the range of next, the probe row being joined and the range of the build rows the
+    // probe row is being joined with.
+    size_t _range_next_probe_row = 0;
+    size_t _range_probe_row = 0;
+    size_t _range_build_index = 0;
+    size_t _range_build_end = 0;
+
     // previsou saved chunk.
     ChunkPtr _pre_output_chunk = nullptr;
     // used as right table's chunk.
@@ -5,6 +5,8 @@
 #include "column/column_helper.h"
 #include "column/hash_set.h"
 #include "env/env.h"
+#include "env/env_stream_pipe.h"
+#include "formats/csv/delimiter_finder.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/runtime_state.h"
 #include "util/utf8_check.h"
@@ -12,31 +14,79 @@
 namespace starrocks::vectorized {
 
 /// CSVScanner::CSVReader
-Status CSVScanner::CSVReader::next_record(Record* record) {
+CSVScanner::CSVReader::CSVReader(std::shared_ptr<SequentialFile> file, char record_delimiter, char field_delimiter)
+        : _file(std::move(file)),
+          _pipe_file(dynamic_cast<StreamPipeSequentialFile*>(_file.get())),
+          _record_delimiter(record_delimiter),
+          _field_delimiter(field_delimiter),
+          _storage(kMinBufferSize),
+          _buff(_storage.data(), _storage.size()) {}
+
+Status CSVScanner::CSVReader::next_record(Record* record, Fields* fields) {
     if (_limit > 0 && _parsed_bytes > _limit) {
         return Status::EndOfFile("Reached limit");
     }
-    char* d;
-    size_t pos = 0;
-    while ((d = _buff.find(_record_delimiter, pos)) == nullptr) {
-        pos = _buff.available();
-        _buff.compact();
-        if (_buff.free_space() == 0) {
-            RETURN_IF_ERROR(_expand_buffer());
+    const char* base = _buff.begin();
+    const char* field_start = _buff.position();
+    size_t num_fields = fields != nullptr ? fields->size() : 0;
+    for (;;) {
+        while (_next_delimiter < _delimiters.size()) {
+            const char* d = base + _delimiters[_next_delimiter++];
+            if (*d == _record_delimiter) {
+                if (fields != nullptr) {
+                    fields->emplace_back(field_start, d - field_start);
+                }
+                size_t l = d - _buff.position();
+                *record = Record(_buff.position(), l);
+                _buff.skip(l + 1);
+                //               ^^ skip record delimiter.
+                _indexed_size -= l + 1;
+                _parsed_bytes += l + 1;
+                return Status::OK();
+            }
+            if (fields != nullptr) {
+                fields->emplace_back(field_start, d - field_start);
+            }
+            field_start = d + 1;
+        }
+        if (_indexed_size == _buff.available()) {
+            // No record delimiter in the buffer, the partial record is indexed again after the buffer is
+            // compacted or expanded.
+            if (fields != nullptr) {
+                fields->resize(num_fields);
+            }
+            _reset_index();
+            RETURN_IF_ERROR(_fill_buffer());
+            base = _buff.begin();
+            field_start = _buff.position();
         }
-        RETURN_IF_ERROR(_fill_buffer());
+        _index_delimiters();
     }
-    size_t l = d - _buff.position();
-    *record = Record(_buff.position(), l);
-    _buff.skip(l + 1);
-    //               ^^ skip record delimiter.
-    _parsed_bytes += l + 1;
-    return Status::OK();
+}
+
+void CSVScanner::CSVReader::_index_delimiters() {
+    const char* begin = _buff.position() + _indexed_size;
+    size_t size = _buff.available() - _indexed_size;
+    csv::find_delimiters(begin, size, _record_delimiter, _field_delimiter, begin - _buff.begin(), &_delimiters);
+    _indexed_size += size;
+}
+
+void CSVScanner::CSVReader::_reset_index() {
+    _delimiters.clear();
+    _next_delimiter = 0;
+    _indexed_size = 0;
 }
 
 Status CSVScanner::CSVReader::_fill_buffer() {
-    SCOPED_RAW_TIMER(&_counter->file_read_ns);
+    if (_pipe_file != nullptr) {
+        return _fill_buffer_from_pipe();
+    }
+    _buff.compact();
+    if (_buff.free_space() == 0) {
+        RETURN_IF_ERROR(_expand_buffer());
+    }
 
+    SCOPED_RAW_TIMER(&_counter->file_read_ns);
     DCHECK(_buff.free_space() > 0);
     Slice s(_buff.limit(), _buff.free_space());
     Status st = _file->read(&s);
@@ -61,6 +111,75 @@ Status CSVScanner::CSVReader::_fill_buffer() {
     return Status::OK();
 }
 
+Status CSVScanner::CSVReader::_fill_buffer_from_pipe() {
+    SCOPED_RAW_TIMER(&_counter->file_read_ns);
+
+    ByteBufferPtr segment = std::move(_pending_segment);
+    while (segment == nullptr || !segment->has_remaining()) {
+        RETURN_IF_ERROR(_pipe_file->read_buffer(&segment));
+        if (segment == nullptr) {
+            break;
+        }
+    }
+    size_t n = _buff.available();
+    if (segment == nullptr) {
+        if (n == 0) {
+            // Has reached the end of stream and the buffer is empty.
+            return Status::EndOfFile(_file->filename());
+        }
+        // The last record has no record delimiter, add it ourself.
+        RETURN_IF_ERROR(_move_to_storage(1));
+        _buff.append(_record_delimiter);
+        return Status::OK();
+    }
+    if (n == 0) {
+        // All the records of the last buffer are consumed, parse the next one in place.
+        _segment = std::move(segment);
+        _buff = Buffer(_segment->ptr + _segment->pos, _segment->remaining());
+        _buff.add_limit(_segment->remaining());
+        return Status::OK();
+    }
+    // Join the partial record with the head of the buffer up to the first record delimiter of it, the rest is
+    // parsed in place after the joined record is consumed.
+    const char* data = segment->ptr + segment->pos;
+    const char* d = static_cast<const char*>(memchr(data, _record_delimiter, segment->remaining()));
+    size_t size = d != nullptr ? d - data + 1 : segment->remaining();
+    RETURN_IF_ERROR(_move_to_storage(size));
+    memcpy(_buff.limit(), data, size);
+    _buff.add_limit(size);
+    segment->pos += size;
+    if (segment->has_remaining()) {
+        _pending_segment = std::move(segment);
+    }
+    return Status::OK();
+}
+
+Status CSVScanner::CSVReader::_move_to_storage(size_t size) {
+    size_t n = _buff.available();
+    if (_segment == nullptr) {
+        _buff.compact();
+        while (_buff.free_space() < size) {
+            RETURN_IF_ERROR(_expand_buffer());
+        }
+        return Status::OK();
+    }
+    if (UNLIKELY(n + size > kMaxBufferSize)) {
+        return Status::InternalError("CSV line length exceed limit " + std::to_string(kMaxBufferSize));
+    }
+    if (_storage.size() < n + size) {
+        size_t new_capacity = _storage.size();
+        while (new_capacity < n + size) {
+            new_capacity *= 2;
+        }
+        _storage.resize(std::min(new_capacity, kMaxBufferSize));
+    }
+    memcpy(_storage.data(), _buff.position(), n);
+    _buff = Buffer(_storage.data(), _storage.size());
+    _buff.add_limit(n);
+    _segment.reset();
+    return Status::OK();
+}
+
 Status CSVScanner::CSVReader::_expand_buffer() {
     if (UNLIKELY(_storage.size() >= kMaxBufferSize)) {
         return Status::InternalError("CSV line length exceed limit " + std::to_string(kMaxBufferSize));
@@ -76,19 +195,6 @@ Status CSVScanner::CSVReader::_expand_buffer() {
     return Status::OK();
 }
 
-void CSVScanner::CSVReader::split_record(const Record& record, Fields* fields) const {
-    const char* value = record.data;
-    const char* ptr = record.data;
-    const size_t size = record.size;
-    for (size_t i = 0; i < size; ++i, ++ptr) {
-        if (*ptr == _field_delimiter) {
-            fields->emplace_back(value, ptr - value);
-            value = ptr + 1;
-        }
-    }
-    fields->emplace_back(value, ptr - value);
-}
-
 CSVScanner::CSVScanner(RuntimeState* state, RuntimeProfile* profile, const TBrokerScanRange& scan_range,
                        ScannerCounter* counter)
         : FileScanner(state, profile, scan_range.params, counter),
@@ -219,7 +325,8 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
     csv::Converter::Options options{.invalid_field_as_null = !_strict_mode};
 
     for (size_t num_rows = chunk->num_rows(); num_rows < capacity; /**/) {
-        status = _curr_reader->next_record(&record);
+        fields.clear();
+        status = _curr_reader->next_record(&record, &fields);
         if (status.is_end_of_file()) {
             break;
         } else if (!status.ok()) {
@@ -229,9 +336,6 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
             continue;
         }
 
-        fields.clear();
-        _curr_reader->split_record(record, &fields);
-
         if (fields.size() != _num_fields_in_csv) {
             std::stringstream error_msg;
             error_msg << "column count mismatch, expect=" << _num_fields_in_csv << " real=" << fields.size();
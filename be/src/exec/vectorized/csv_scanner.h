@@ -7,12 +7,14 @@
 
 #include "exec/vectorized/file_scanner.h"
 #include "formats/csv/converter.h"
+#include "util/byte_buffer.h"
 #include "util/logging.h"
 #include "util/raw_container.h"
 
 namespace starrocks {
 class SequentialFile;
-}
+class StreamPipeSequentialFile;
+} // namespace starrocks
 
 namespace starrocks::vectorized {
 
@@ -52,6 +54,9 @@ private:
         // Returns this buffer's capacity.
         size_t capacity() const { return _end - _begin; }
 
+        // Returns the beginning of this buffer.
+        char* begin() { return _begin; }
+
         // Returns this buffer's read position.
         char* position() { return _position; }
 
@@ -60,11 +65,6 @@ private:
 
         void add_limit(size_t n) { _limit += n; }
 
-        // Finds the first character equal to the given character |c|. Search begins at |pos|.
-        // Return: address of the first character of the found character or NULL if no such
-        // character is found.
-        char* find(char c, size_t pos = 0) { return (char*)memchr(position() + pos, c, available() - pos); }
-
         void skip(size_t n) { _position += n; }
 
         // Compacts this buffer.
@@ -90,30 +90,44 @@ private:
         using Field = Slice;
         using Fields = std::vector<Field>;
 
-        CSVReader(std::shared_ptr<SequentialFile> file, char record_delimiter, char field_delimiter)
-                : _file(std::move(file)),
-                  _record_delimiter(record_delimiter),
-                  _field_delimiter(field_delimiter),
-                  _storage(kMinBufferSize),
-                  _buff(_storage.data(), _storage.size()) {}
+        CSVReader(std::shared_ptr<SequentialFile> file, char record_delimiter, char field_delimiter);
 
-        Status next_record(Record* record);
+        // Read the next record, and split it into |fields| if it's not nullptr.
+        Status next_record(Record* record, Fields* fields = nullptr);
 
         void set_limit(size_t limit) { _limit = limit; }
 
-        void split_record(const Record& record, Fields* fields) const;
-
         void set_counter(ScannerCounter* counter) { _counter = counter; }
 
     private:
         Status _expand_buffer();
+        // Compact the buffer and fill it, or take the next buffer of the stream load pipe.
         Status _fill_buffer();
+        Status _fill_buffer_from_pipe();
+        // Move the bytes available to the beginning of _storage, with at least |size| bytes of free space
+        // after them.
+        Status _move_to_storage(size_t size);
+        // Index the delimiters of the bytes filled after the last index.
+        void _index_delimiters();
+        // Clear the index, the buffer is compacted or expanded next.
+        void _reset_index();
 
         std::shared_ptr<SequentialFile> _file;
+        // Not nullptr if the file is a stream load pipe, whose buffers are parsed in place without copying
+        // them to _storage, except the records across two buffers.
+        StreamPipeSequentialFile* _pipe_file;
+        // The buffer of the pipe _buff is on, and the rest of the next one after its first record delimiter.
+        ByteBufferPtr _segment;
+        ByteBufferPtr _pending_segment;
         char _record_delimiter;
         char _field_delimiter;
         raw::RawVector<char> _storage;
         Buffer _buff;
+        // The offsets from _storage.data() of the record and the field delimiters in
+        // [_buff.position(), _buff.position() + _indexed_size), the ones before _next_delimiter are consumed.
+        std::vector<uint32_t> _delimiters;
+        size_t _next_delimiter = 0;
+        size_t _indexed_size = 0;
         size_t _parsed_bytes = 0;
         size_t _limit = 0;
         ScannerCounter* _counter = nullptr;
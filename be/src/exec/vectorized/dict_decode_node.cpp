@@ -0,0 +1,112 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/dict_decode_node.h"
+
+#include "column/chunk.h"
+#include "exec/pipeline/dict_decode_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+DictDecodeNode::DictDecodeNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs) {}
+
+Status DictDecodeNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    GlobalDicts dicts;
+    RETURN_IF_ERROR(parse_global_dicts(tnode.decode_node.global_dicts, &dicts));
+    for (const auto& [id_slot, string_slot] : tnode.decode_node.dict_id_to_string_ids) {
+        auto iter = dicts.find(id_slot);
+        if (iter == dicts.end()) {
+            return Status::InternalError(strings::Substitute("no global dict of the slot $0", id_slot));
+        }
+        DictDecodeSlot slot;
+        slot.id_slot = id_slot;
+        slot.string_slot = string_slot;
+        slot.dict = iter->second;
+        _decode_slots.emplace_back(std::move(slot));
+    }
+    return Status::OK();
+}
+
+Status DictDecodeNode::prepare(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+    _decode_timer = ADD_TIMER(runtime_profile(), "DictDecodeTime");
+    return Status::OK();
+}
+
+Status DictDecodeNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_CANCELLED(state);
+    RETURN_IF_ERROR(_children[0]->open(state));
+    return Status::OK();
+}
+
+Status DictDecodeNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    RETURN_IF_CANCELLED(state);
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+
+    if (reached_limit()) {
+        *chunk = nullptr;
+        *eos = true;
+        return Status::OK();
+    }
+
+    *eos = false;
+    do {
+        RETURN_IF_ERROR(_children[0]->get_next(state, chunk, eos));
+    } while (!(*eos) && ((*chunk)->num_rows() == 0));
+
+    if (*eos) {
+        *chunk = nullptr;
+        return Status::OK();
+    }
+
+    {
+        SCOPED_TIMER(_decode_timer);
+        RETURN_IF_ERROR(decode_dict_slots(_decode_slots, (*chunk).get()));
+    }
+
+    _num_rows_returned += (*chunk)->num_rows();
+    if (reached_limit()) {
+        int64_t num_rows_over = _num_rows_returned - _limit;
+        (*chunk)->set_num_rows((*chunk)->num_rows() - num_rows_over);
+        COUNTER_SET(_rows_returned_counter, _limit);
+        DCHECK_CHUNK(*chunk);
+        return Status::OK();
+    }
+
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    DCHECK_CHUNK(*chunk);
+    return Status::OK();
+}
+
+Status DictDecodeNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("Vector query engine don't support row_batch");
+}
+
+Status DictDecodeNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(ExecNode::close(state));
+    return Status::OK();
+}
+
+pipeline::OpFactories DictDecodeNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    OpFactories operators = _children[0]->decompose_to_pipeline(context);
+    operators.emplace_back(
+            std::make_shared<DictDecodeOperatorFactory>(context->next_operator_id(), id(), std::move(_decode_slots)));
+    if (limit() != -1) {
+        operators.emplace_back(std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators;
+}
+
+} // namespace starrocks::vectorized
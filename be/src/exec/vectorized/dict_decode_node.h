@@ -0,0 +1,38 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "column/vectorized_fwd.h"
+#include "exec/exec_node.h"
+#include "runtime/vectorized/global_dict.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized {
+
+// DictDecodeNode decodes the global dict ids of the low cardinality string columns back to the strings,
+// it's planned right before the result sink, so the nodes below it process the INT ids instead.
+class DictDecodeNode final : public ExecNode {
+public:
+    DictDecodeNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+
+    ~DictDecodeNode() override = default;
+
+    Status init(const TPlanNode& tnode, RuntimeState* state) override;
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+    // Only for compatibility
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override;
+
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
+private:
+    std::vector<DictDecodeSlot> _decode_slots;
+
+    RuntimeProfile::Counter* _decode_timer = nullptr;
+};
+
+} // namespace starrocks::vectorized
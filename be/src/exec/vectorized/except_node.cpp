@@ -74,7 +74,16 @@ Status ExceptNode::open(RuntimeState* state) {
     }
 
     // initial build hash table used for remove duplicted
-    _hash_set.reset(new HashSerializeSet());
+    size_t fixed_size = _get_fixed_size_of_keys();
+    if (fixed_size == 0 || fixed_size > sizeof(uint128_t)) {
+        _hash_set = std::make_unique<HashSerializeSet>();
+    } else if (fixed_size <= sizeof(uint32_t)) {
+        _hash_set = std::make_unique<FixedSizeHashSetFromExprs<uint32_t>>();
+    } else if (fixed_size <= sizeof(uint64_t)) {
+        _hash_set = std::make_unique<FixedSizeHashSetFromExprs<uint64_t>>();
+    } else {
+        _hash_set = std::make_unique<FixedSizeHashSetFromExprs<uint128_t>>();
+    }
 
     ChunkPtr chunk = nullptr;
     RETURN_IF_ERROR(child(0)->open(state));
@@ -85,9 +94,14 @@ Status ExceptNode::open(RuntimeState* state) {
     if (!eos) {
         ScopedTimer<MonotonicStopWatch> build_timer(_build_set_timer);
         std::vector<ExceptColumnTypes>* types = &_types;
-        RETURN_IF_ERROR(_hash_set->build_set(
-                state, chunk, _child_expr_lists[0], _build_pool.get(),
-                [=](const ColumnPtr& column, int i) -> void { (*types)[i].is_nullable = column->is_nullable(); }));
+        RETURN_IF_ERROR(std::visit(
+                [&](auto& hash_set) {
+                    return hash_set->build_set(state, chunk, _child_expr_lists[0], _build_pool.get(),
+                                               [=](const ColumnPtr& column, int i) -> void {
+                                                   (*types)[i].is_nullable = column->is_nullable();
+                                               });
+                },
+                _hash_set));
         while (true) {
             RETURN_IF_CANCELLED(state);
             build_timer.stop();
@@ -98,15 +112,19 @@ Status ExceptNode::open(RuntimeState* state) {
             } else if (chunk->num_rows() == 0) {
                 continue;
             } else {
-                RETURN_IF_ERROR(_hash_set->build_set(state, chunk, _child_expr_lists[0], _build_pool.get(),
-                                                     [](const ColumnPtr& column, int i) -> void {}));
+                RETURN_IF_ERROR(std::visit(
+                        [&](auto& hash_set) {
+                            return hash_set->build_set(state, chunk, _child_expr_lists[0], _build_pool.get(),
+                                                       [](const ColumnPtr& column, int i) -> void {});
+                        },
+                        _hash_set));
             }
         }
     }
 
     // if a table is empty, the result must be empty
-    if (_hash_set->hash_set->size() == 0) {
-        _hash_set_iterator = _hash_set->begin();
+    if (std::visit([](auto& hash_set) { return hash_set->size(); }, _hash_set) == 0) {
+        std::visit([](auto& hash_set) { hash_set->init_results(); }, _hash_set);
         return Status::OK();
     }
 
@@ -122,13 +140,18 @@ Status ExceptNode::open(RuntimeState* state) {
                 continue;
             } else {
                 SCOPED_TIMER(_erase_duplicate_row_timer);
-                RETURN_IF_ERROR(_hash_set->erase_duplicate_row(state, chunk->num_rows(), chunk, _child_expr_lists[i]));
+                RETURN_IF_ERROR(std::visit(
+                        [&](auto& hash_set) {
+                            return hash_set->erase_duplicate_row(state, chunk->num_rows(), chunk,
+                                                                 _child_expr_lists[i]);
+                        },
+                        _hash_set));
             }
         }
         // TODO: optimize, when hash set has no values, direct return
     }
 
-    _hash_set_iterator = _hash_set->begin();
+    std::visit([](auto& hash_set) { hash_set->init_results(); }, _hash_set);
     return Status::OK();
 }
 
@@ -147,15 +170,9 @@ Status ExceptNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         return Status::OK();
     }
 
-    int32_t read_index = 0;
-    _hash_set->_results.resize(config::vector_chunk_size);
-    while (_hash_set_iterator != _hash_set->end() && read_index < config::vector_chunk_size) {
-        if (!_hash_set_iterator->deleted) {
-            _hash_set->_results[read_index] = _hash_set_iterator->slice;
-            ++read_index;
-        }
-        ++_hash_set_iterator;
-    }
+    _results.resize(config::vector_chunk_size);
+    int32_t read_index = std::visit(
+            [&](auto& hash_set) { return hash_set->fetch_results(&_results, config::vector_chunk_size); }, _hash_set);
     ChunkPtr result_chunk = std::make_shared<Chunk>();
     if (read_index > 0) {
         Columns result_columns(_types.size());
@@ -167,7 +184,7 @@ Status ExceptNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
 
         {
             SCOPED_TIMER(_get_result_timer);
-            _hash_set->insert_keys_to_columns(_hash_set->_results, result_columns, read_index);
+            HashSerializeSet::insert_keys_to_columns(_results, result_columns, read_index);
         }
 
         for (size_t i = 0; i < result_columns.size(); i++) {
@@ -192,6 +209,44 @@ Status ExceptNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     return Status::OK();
 }
 
+size_t ExceptNode::_get_fixed_size_of_keys() const {
+    size_t fixed_size = 0;
+    for (const auto& type : _types) {
+        // Each column is serialized with one byte of null flag before its data, even if it isn't nullable.
+        fixed_size += sizeof(bool);
+        switch (type.result_type.type) {
+        case TYPE_BOOLEAN:
+        case TYPE_TINYINT:
+            fixed_size += sizeof(int8_t);
+            break;
+        case TYPE_SMALLINT:
+            fixed_size += sizeof(int16_t);
+            break;
+        case TYPE_INT:
+        case TYPE_DECIMAL32:
+            fixed_size += sizeof(int32_t);
+            break;
+        case TYPE_BIGINT:
+        case TYPE_DECIMAL64:
+            fixed_size += sizeof(int64_t);
+            break;
+        case TYPE_LARGEINT:
+        case TYPE_DECIMAL128:
+            fixed_size += sizeof(int128_t);
+            break;
+        case TYPE_DATE:
+            fixed_size += sizeof(DateValue);
+            break;
+        case TYPE_DATETIME:
+            fixed_size += sizeof(TimestampValue);
+            break;
+        default:
+            return 0;
+        }
+    }
+    return fixed_size;
+}
+
 Status ExceptNode::close(RuntimeState* state) {
     if (is_closed()) {
         return Status::OK();
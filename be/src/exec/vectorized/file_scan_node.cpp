@@ -84,8 +84,21 @@ Status FileScanNode::start_scanners() {
     {
         std::unique_lock<std::mutex> l(_chunk_queue_lock);
 
-        _num_running_scanners = 1;
-        _scanner_threads.emplace_back(&FileScanNode::scanner_worker, this, 0, _scan_ranges.size());
+        // the pipes of a routine load task are read by a scanner thread each, the files are scanned by one thread
+        bool all_streams = _scan_ranges.size() > 1;
+        for (const auto& scan_range : _scan_ranges) {
+            const auto& ranges = scan_range.scan_range.broker_scan_range.ranges;
+            all_streams &= ranges.size() == 1 && ranges[0].file_type == TFileType::FILE_STREAM;
+        }
+        if (all_streams) {
+            _num_running_scanners = _scan_ranges.size();
+            for (int i = 0; i < _scan_ranges.size(); ++i) {
+                _scanner_threads.emplace_back(&FileScanNode::scanner_worker, this, i, 1);
+            }
+        } else {
+            _num_running_scanners = 1;
+            _scanner_threads.emplace_back(&FileScanNode::scanner_worker, this, 0, _scan_ranges.size());
+        }
     }
     return Status::OK();
 }
@@ -4,6 +4,7 @@
 
 #include "column/column_helper.h"
 #include "column/hash_set.h"
+#include "common/config.h"
 #include "env/compressed_file.h"
 #include "env/env.h"
 #include "env/env_broker.h"
@@ -276,6 +277,12 @@ Status FileScanner::create_sequential_file(const TBrokerRangeDesc& range_desc, c
         return Status::OK();
     }
 
+    if (config::load_decompress_threads > 0) {
+        *file = std::make_shared<ParallelCompressedSequentialFile>(std::move(src_file), compression,
+                                                                  config::load_decompress_threads);
+        return Status::OK();
+    }
+
     using DecompressorPtr = std::shared_ptr<Decompressor>;
     Decompressor* dec = nullptr;
     RETURN_IF_ERROR(Decompressor::create_decompressor(compression, &dec));
@@ -9,6 +9,12 @@
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
+#include "exec/pipeline/hash_join/hash_join_build_operator.h"
+#include "exec/pipeline/hash_join/hash_join_probe_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/scan_operator.h"
 #include "exprs/expr.h"
 #include "exprs/in_predicate.h"
 #include "exprs/vectorized/column_ref.h"
@@ -21,7 +27,7 @@
 namespace starrocks::vectorized {
 
 HashJoinNode::HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-        : ExecNode(pool, tnode, descs), _join_type(tnode.hash_join_node.join_op) {
+        : ExecNode(pool, tnode, descs), _tnode(tnode), _join_type(tnode.hash_join_node.join_op) {
     _is_push_down = tnode.hash_join_node.is_push_down;
     if (_join_type == TJoinOp::LEFT_ANTI_JOIN && tnode.hash_join_node.is_rewritten_from_not_in) {
         _join_type = TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
@@ -35,35 +41,19 @@ HashJoinNode::HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const Descr
 Status HashJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::init(tnode, state));
 
-    if (tnode.hash_join_node.__isset.sql_join_predicates) {
-        _runtime_profile->add_info_string("JoinPredicates", tnode.hash_join_node.sql_join_predicates);
-    }
-    if (tnode.hash_join_node.__isset.sql_predicates) {
-        _runtime_profile->add_info_string("Predicates", tnode.hash_join_node.sql_predicates);
-    }
-
-    const std::vector<TEqJoinCondition>& eq_join_conjuncts = tnode.hash_join_node.eq_join_conjuncts;
-    for (const auto& eq_join_conjunct : eq_join_conjuncts) {
+    for (const auto& eq_join_conjunct : tnode.hash_join_node.eq_join_conjuncts) {
         ExprContext* ctx = nullptr;
         RETURN_IF_ERROR(Expr::create_expr_tree(_pool, eq_join_conjunct.left, &ctx));
         _probe_expr_ctxs.push_back(ctx);
         RETURN_IF_ERROR(Expr::create_expr_tree(_pool, eq_join_conjunct.right, &ctx));
         _build_expr_ctxs.push_back(ctx);
-
-        if (eq_join_conjunct.__isset.opcode && eq_join_conjunct.opcode == TExprOpcode::EQ_FOR_NULL) {
-            _is_null_safes.emplace_back(true);
-        } else {
-            _is_null_safes.emplace_back(false);
-        }
     }
 
-    RETURN_IF_ERROR(
-            Expr::create_expr_trees(_pool, tnode.hash_join_node.other_join_conjuncts, &_other_join_conjunct_ctxs));
-
-    for (const auto& desc : tnode.hash_join_node.build_runtime_filters) {
-        auto* rf_desc = _pool->add(new RuntimeFilterBuildDescriptor());
-        RETURN_IF_ERROR(rf_desc->init(_pool, desc));
-        _build_runtime_filters.emplace_back(rf_desc);
+    if (tnode.hash_join_node.__isset.sql_join_predicates) {
+        _runtime_profile->add_info_string("JoinPredicates", tnode.hash_join_node.sql_join_predicates);
+    }
+    if (tnode.hash_join_node.__isset.sql_predicates) {
+        _runtime_profile->add_info_string("Predicates", tnode.hash_join_node.sql_predicates);
     }
 
     return Status::OK();
@@ -72,72 +62,20 @@ Status HashJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
 Status HashJoinNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::prepare(state));
 
-    _build_timer = ADD_TIMER(_runtime_profile, "BuildTime");
-
-    _copy_right_table_chunk_timer = ADD_CHILD_TIMER(_runtime_profile, "1-CopyRightTableChunkTime", "BuildTime");
-    _build_ht_timer = ADD_CHILD_TIMER(_runtime_profile, "2-BuildHashTableTime", "BuildTime");
-    _build_push_down_expr_timer = ADD_CHILD_TIMER(_runtime_profile, "3-BuildPushDownExprTime", "BuildTime");
-    _build_conjunct_evaluate_timer = ADD_CHILD_TIMER(_runtime_profile, "4-BuildConjunctEvaluateTime", "BuildTime");
-
-    _probe_timer = ADD_TIMER(_runtime_profile, "ProbeTime");
+    _hash_joiner = std::make_shared<HashJoiner>(_tnode, child(1)->row_desc(), child(0)->row_desc(), _row_descriptor,
+                                                &_conjunct_ctxs);
+    RETURN_IF_ERROR(_hash_joiner->prepare(state, _pool, runtime_profile(), mem_tracker()));
     _merge_input_chunk_timer = ADD_CHILD_TIMER(_runtime_profile, "1-MergeInputChunkTimer", "ProbeTime");
-    _search_ht_timer = ADD_CHILD_TIMER(_runtime_profile, "2-SearchHashTableTimer", "ProbeTime");
-    _output_build_column_timer = ADD_CHILD_TIMER(_runtime_profile, "3-OutputBuildColumnTimer", "ProbeTime");
-    _output_probe_column_timer = ADD_CHILD_TIMER(_runtime_profile, "4-OutputProbeColumnTimer", "ProbeTime");
-    _output_tuple_column_timer = ADD_CHILD_TIMER(_runtime_profile, "5-OutputTupleColumnTimer", "ProbeTime");
-    _probe_conjunct_evaluate_timer = ADD_CHILD_TIMER(_runtime_profile, "6-ProbeConjunctEvaluateTime", "ProbeTime");
-    _other_join_conjunct_evaluate_timer =
-            ADD_CHILD_TIMER(_runtime_profile, "7-OtherJoinConjunctEvaluateTime", "ProbeTime");
-    _where_conjunct_evaluate_timer = ADD_CHILD_TIMER(_runtime_profile, "8-WhereConjunctEvaluateTime", "ProbeTime");
-
-    _probe_rows_counter = ADD_COUNTER(_runtime_profile, "ProbeRows", TUnit::UNIT);
-    _build_rows_counter = ADD_COUNTER(_runtime_profile, "BuildRows", TUnit::UNIT);
-    _build_buckets_counter = ADD_COUNTER(_runtime_profile, "BuildBuckets", TUnit::UNIT);
-    _push_down_expr_num = ADD_COUNTER(_runtime_profile, "PushDownExprNum", TUnit::UNIT);
-    _avg_input_probe_chunk_size = ADD_COUNTER(_runtime_profile, "AvgInputProbeChunkSize", TUnit::UNIT);
-    _avg_output_chunk_size = ADD_COUNTER(_runtime_profile, "AvgOutputChunkSize", TUnit::UNIT);
-    _runtime_profile->add_info_string("JoinType", _get_join_type_str(_join_type));
-
-    RETURN_IF_ERROR(Expr::prepare(_build_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
-    RETURN_IF_ERROR(Expr::prepare(_probe_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
-    RETURN_IF_ERROR(Expr::prepare(_other_join_conjunct_ctxs, state, _row_descriptor, expr_mem_tracker()));
-
-    HashTableParam param;
-    _init_hash_table_param(&param);
-    _ht.create(param);
-
-    _probe_column_count = _ht.get_probe_column_count();
-    _build_column_count = _ht.get_build_column_count();
-
     return Status::OK();
 }
 
-void HashJoinNode::_init_hash_table_param(HashTableParam* param) {
-    param->with_other_conjunct = !_other_join_conjunct_ctxs.empty();
-    param->join_type = _join_type;
-    param->row_desc = &_row_descriptor;
-    param->mem_tracker = _mem_tracker.get();
-    param->build_row_desc = &child(1)->row_desc();
-    param->probe_row_desc = &child(0)->row_desc();
-    param->search_ht_timer = _search_ht_timer;
-    param->output_build_column_timer = _output_build_column_timer;
-    param->output_probe_column_timer = _output_probe_column_timer;
-    param->output_tuple_column_timer = _output_tuple_column_timer;
-
-    for (auto i = 0; i < _probe_expr_ctxs.size(); i++) {
-        param->join_keys.emplace_back(JoinKeyDesc{_probe_expr_ctxs[i]->root()->type().type, _is_null_safes[i]});
-    }
-}
-
 Status HashJoinNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
-    ScopedTimer<MonotonicStopWatch> build_timer(_build_timer);
+    ScopedTimer<MonotonicStopWatch> build_timer(_hash_joiner->build_timer());
     RETURN_IF_CANCELLED(state);
 
     RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(Expr::open(_build_expr_ctxs, state));
-    RETURN_IF_ERROR(Expr::open(_probe_expr_ctxs, state));
-    RETURN_IF_ERROR(Expr::open(_other_join_conjunct_ctxs, state));
+    RETURN_IF_ERROR(_hash_joiner->open(state));
 
     {
         build_timer.stop();
@@ -163,24 +101,36 @@ Status HashJoinNode::open(RuntimeState* state) {
             }
         }
 
-        if (_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX) {
-            return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
+        if (_build_spiller != nullptr) {
+            RETURN_IF_ERROR(_spill_build_chunk(_build_spiller.get(), chunk));
+            continue;
         }
 
-        {
-            // copy chunk of right table
-            SCOPED_TIMER(_copy_right_table_chunk_timer);
-            RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
+        RETURN_IF_ERROR(_hash_joiner->append_chunk_to_ht(state, chunk));
+        if (_need_spill(state)) {
+            // The build side degrades to a grace hash join, the runtime filters aren't built then,
+            // because the rows of the build side are never in memory at the same time.
+            _build_spill_layout = _hash_joiner->hash_table().get_build_chunk()->clone_empty_with_tuple(0);
+            RETURN_IF_ERROR(_create_spiller(state, *_build_spill_layout, 0, &_build_spiller));
+            RETURN_IF_ERROR(_spill_hash_table(_build_spiller.get()));
         }
     }
 
-    {
-        // build hash table: compute key columns, and then build the hash table.
-        RETURN_IF_ERROR(_build(state));
-        COUNTER_SET(_build_rows_counter, static_cast<int64_t>(_ht.get_row_count()));
-        COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
+    if (_build_spiller != nullptr) {
+        RETURN_IF_ERROR(_build_spiller->flush());
+        build_timer.stop();
+        RETURN_IF_ERROR(child(0)->open(state));
+        RETURN_IF_ERROR(_spill_probe_side(state));
+        build_timer.start();
+        _add_spilled_partitions(_build_spiller, _probe_spiller);
+        _build_spiller.reset();
+        _probe_spiller.reset();
+        return _restore_next_spilled_partition(state);
     }
 
+    // build hash table: compute key columns, and then build the hash table.
+    RETURN_IF_ERROR(_hash_joiner->build_ht(state));
+
     uint64_t runtime_join_filter_pushdown_limit = 1024000;
     if (state->query_options().__isset.runtime_join_filter_pushdown_limit) {
         runtime_join_filter_pushdown_limit = state->query_options().runtime_join_filter_pushdown_limit;
@@ -190,7 +140,7 @@ Status HashJoinNode::open(RuntimeState* state) {
         if (_children[0]->type() == TPlanNodeType::EXCHANGE_NODE &&
             _children[1]->type() == TPlanNodeType::EXCHANGE_NODE) {
             _is_push_down = false;
-        } else if (_ht.get_row_count() > runtime_join_filter_pushdown_limit) {
+        } else if (_hash_joiner->hash_table().get_row_count() > runtime_join_filter_pushdown_limit) {
             _is_push_down = false;
         }
 
@@ -205,30 +155,15 @@ Status HashJoinNode::open(RuntimeState* state) {
     // "inner-join with empty right table". because for global runtime filter
     // merge node is waiting for all partitioned runtime filter, so even hash row count is zero
     // we still have to build it.
-    RETURN_IF_ERROR(_do_publish_runtime_filters(state, runtime_join_filter_pushdown_limit));
+    RETURN_IF_ERROR(_hash_joiner->publish_runtime_filters(state, runtime_join_filter_pushdown_limit));
 
     build_timer.stop();
     RETURN_IF_ERROR(child(0)->open(state));
     build_timer.start();
 
     // special cases of short-circuit break.
-    if (_ht.get_row_count() == 0 && (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN)) {
+    if (_hash_joiner->is_short_circuit()) {
         _eos = true;
-        return Status::OK();
-    }
-
-    if (_ht.get_row_count() > 0) {
-        if (_join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN && _ht.get_key_columns().size() == 1 &&
-            _has_null(_ht.get_key_columns()[0])) {
-            // The current implementation of HashTable will reserve a row for judging the end of the linked list.
-            // When performing expression calculations (such as cast string to int),
-            // it is possible that this reserved row will generate Null,
-            // so Column::has_null() cannot be used to judge whether there is Null in the right table.
-            // TODO: This reserved field will be removed in the implementation mechanism in the future.
-            // at that time, you can directly use Column::has_null() to judge
-            _eos = true;
-            return Status::OK();
-        }
     }
 
     return Status::OK();
@@ -241,7 +176,7 @@ Status HashJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eo
 Status HashJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     RETURN_IF_CANCELLED(state);
     SCOPED_TIMER(_runtime_profile->total_time_counter());
-    ScopedTimer<MonotonicStopWatch> probe_timer(_probe_timer);
+    ScopedTimer<MonotonicStopWatch> probe_timer(_hash_joiner->probe_timer());
 
     if (reached_limit()) {
         _eos = true;
@@ -258,51 +193,35 @@ Status HashJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
 
     *chunk = std::make_shared<Chunk>();
 
-    bool tmp_eos = false;
-    if (!_probe_eos || _ht_has_remain) {
-        RETURN_IF_ERROR(_probe(state, probe_timer, chunk, tmp_eos));
-        if (tmp_eos) {
-            if (_join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-                _join_type == TJoinOp::FULL_OUTER_JOIN) {
-                // fetch the remain data of hash table
-                RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
-                if (tmp_eos) {
-                    _eos = true;
-                    *eos = true;
-                    _final_update_profile();
-                    return Status::OK();
-                }
-            } else {
-                _eos = true;
-                *eos = true;
-                _final_update_profile();
-                return Status::OK();
+    while (true) {
+        bool tmp_eos = false;
+        if (!_probe_eos || _hash_joiner->has_probe_chunk()) {
+            RETURN_IF_ERROR(_probe(state, probe_timer, chunk, tmp_eos));
+            if (!tmp_eos) {
+                break;
             }
         }
-    } else {
-        if (!_build_eos) {
-            if (_join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-                _join_type == TJoinOp::FULL_OUTER_JOIN) {
-                // fetch the remain data of hash table
-                RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
-                if (tmp_eos) {
-                    _eos = true;
-                    *eos = true;
-                    _final_update_profile();
-                    return Status::OK();
-                }
-            } else {
-                _eos = true;
-                *eos = true;
-                _final_update_profile();
-                return Status::OK();
+
+        if (_hash_joiner->need_probe_remain() && !_hash_joiner->is_build_eos()) {
+            // fetch the remain data of hash table
+            RETURN_IF_ERROR(_hash_joiner->probe_remain(chunk, &tmp_eos));
+            if (!tmp_eos) {
+                break;
             }
-        } else {
+        }
+
+        if (_spilled_partitions.empty()) {
             _eos = true;
             *eos = true;
             _final_update_profile();
             return Status::OK();
         }
+
+        // The current partition has been joined, join the next spilled partition.
+        probe_timer.stop();
+        RETURN_IF_ERROR(_restore_next_spilled_partition(state));
+        probe_timer.start();
+        *chunk = std::make_shared<Chunk>();
     }
 
     DCHECK_LE((*chunk)->num_rows(), config::vector_chunk_size);
@@ -329,63 +248,91 @@ Status HashJoinNode::close(RuntimeState* state) {
         return Status::OK();
     }
 
-    Expr::close(_build_expr_ctxs, state);
-    Expr::close(_probe_expr_ctxs, state);
-    Expr::close(_other_join_conjunct_ctxs, state);
+    // Remove the temporary files of the spilled partitions which haven't been joined.
+    _spilled_partitions.clear();
+    _probing_partition = SpilledPartition();
+    _build_spiller.reset();
+    _probe_spiller.reset();
 
-    _ht.close();
+    if (_hash_joiner != nullptr) {
+        _hash_joiner->close(state);
+    }
 
     return ExecNode::close(state);
 }
 
-bool HashJoinNode::_has_null(const ColumnPtr& column) {
-    if (column->is_nullable()) {
-        const auto& null_column = ColumnHelper::as_raw_column<NullableColumn>(column)->null_column();
-        DCHECK_GT(null_column->size(), 0);
-        return null_column->contain_value(1, null_column->size(), 1);
-    }
-    return false;
-}
-
-Status HashJoinNode::_build(RuntimeState* state) {
-    {
-        SCOPED_TIMER(_build_conjunct_evaluate_timer);
-        for (auto& _build_expr_ctx : _build_expr_ctxs) {
-            const TypeDescriptor& data_type = _build_expr_ctx->root()->type();
-            ColumnPtr column_ptr = _build_expr_ctx->evaluate(_ht.get_build_chunk().get());
-            if (column_ptr->is_nullable() && column_ptr->is_constant()) {
-                ColumnPtr column = ColumnHelper::create_column(data_type, true);
-                column->append_nulls(_ht.get_build_chunk()->num_rows());
-                _ht.get_key_columns().emplace_back(column);
-            } else if (column_ptr->is_constant()) {
-                auto* const_column = ColumnHelper::as_raw_column<ConstColumn>(column_ptr);
-                const_column->data_column()->assign(_ht.get_build_chunk()->num_rows(), 0);
-                _ht.get_key_columns().emplace_back(const_column->data_column());
-            } else {
-                _ht.get_key_columns().emplace_back(column_ptr);
-            }
+pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    // All the build operators append into one hash table, which is built only once and shared by
+    // all the probe operators, so the build table isn't copied for every driver.
+    auto hash_joiner_factory =
+            std::make_shared<HashJoinerFactory>(_tnode, child(1)->row_desc(), child(0)->row_desc(), _row_descriptor);
+
+    // In a shuffle join, the rows of the two sides are partitioned by the join keys across the drivers, and
+    // each driver joins its partition independently, so the hash tables are built in parallel.
+    const bool is_partitioned = _tnode.hash_join_node.__isset.distribution_mode &&
+                                _tnode.hash_join_node.distribution_mode == TJoinDistributionMode::PARTITIONED &&
+                                !_build_expr_ctxs.empty() && context->driver_instance_count() > 1;
+
+    OpFactories build_operators = _children[1]->decompose_to_pipeline(context);
+    if (is_partitioned) {
+        hash_joiner_factory->set_partitioned();
+        build_operators = context->maybe_interpolate_local_shuffle_exchange(build_operators, _build_expr_ctxs);
+    }
+    build_operators.emplace_back(
+            std::make_shared<HashJoinBuildOperatorFactory>(context->next_operator_id(), id(), hash_joiner_factory));
+    context->add_pipeline(build_operators);
+
+    OpFactories probe_operators = _children[0]->decompose_to_pipeline(context);
+    if (is_partitioned) {
+        probe_operators = context->maybe_interpolate_local_shuffle_exchange(probe_operators, _probe_expr_ctxs);
+    }
+    // In a colocate join reading the scans directly, the buckets are joined by the drivers independently.
+    auto* build_scan = dynamic_cast<ScanOperatorFactory*>(build_operators[0].get());
+    auto* probe_scan = dynamic_cast<ScanOperatorFactory*>(probe_operators[0].get());
+    if (_tnode.hash_join_node.__isset.distribution_mode &&
+        _tnode.hash_join_node.distribution_mode == TJoinDistributionMode::COLOCATE && build_scan != nullptr &&
+        probe_scan != nullptr) {
+        build_scan->set_bucketed();
+        probe_scan->set_bucketed();
+        int32_t max_buckets_in_memory = config::pipeline_colocate_join_max_buckets_in_memory;
+        if (max_buckets_in_memory <= 0) {
+            max_buckets_in_memory = context->driver_instance_count();
+        }
+        hash_joiner_factory->set_bucketed(max_buckets_in_memory);
+        for (const auto& desc : _tnode.hash_join_node.build_runtime_filters) {
+            probe_scan->add_bucket_join_runtime_filter(desc.filter_id, max_buckets_in_memory);
         }
     }
-
-    {
-        SCOPED_TIMER(_build_ht_timer);
-        RETURN_IF_ERROR(_ht.build(state));
-    }
-
-    return Status::OK();
+    // The matched rows of the right table are recorded by each prober, so the joins that output
+    // according to them must be probed by only one driver, unless each bucket or partition is probed by one driver.
+    if (!hash_joiner_factory->has_builder_per_driver() &&
+        (_join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_SEMI_JOIN ||
+         _join_type == TJoinOp::RIGHT_ANTI_JOIN || _join_type == TJoinOp::FULL_OUTER_JOIN)) {
+        probe_operators = context->maybe_interpolate_local_passthrough_exchange(probe_operators);
+    }
+    probe_operators.emplace_back(
+            std::make_shared<HashJoinProbeOperatorFactory>(context->next_operator_id(), id(), hash_joiner_factory));
+    if (limit() != -1) {
+        // The limit applies to the output of all the probe drivers.
+        probe_operators = context->maybe_interpolate_local_passthrough_exchange(probe_operators);
+        probe_operators.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return probe_operators;
 }
 
 Status HashJoinNode::_probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk,
                             bool& eos) {
     while (true) {
-        if (!_ht_has_remain) {
+        if (!_hash_joiner->has_probe_chunk()) {
             while (true) {
                 {
                     // if current chunk size >= vector_chunk_size / 2, direct return the current chunk
                     // if current chunk size < vector_chunk_size and pre chunk size + cur chunk size <= 1024, merge the two chunk
                     // if current chunk size < vector_chunk_size and pre chunk size + cur chunk size > 1024, return pre chunk
                     probe_timer.stop();
-                    RETURN_IF_ERROR(child(0)->get_next(state, &_cur_left_input_chunk, &_probe_eos));
+                    RETURN_IF_ERROR(_fetch_probe_chunk(state, &_cur_left_input_chunk, &_probe_eos));
                     probe_timer.start();
                     {
                         SCOPED_TIMER(_merge_input_chunk_timer);
@@ -432,40 +379,14 @@ Status HashJoinNode::_probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>
                     }
                 }
 
-                COUNTER_UPDATE(_probe_rows_counter, _probing_chunk->num_rows());
-
-                {
-                    SCOPED_TIMER(_probe_conjunct_evaluate_timer);
-                    _key_columns.resize(0);
-                    for (auto& probe_expr_ctx : _probe_expr_ctxs) {
-                        ColumnPtr column_ptr = probe_expr_ctx->evaluate(_probing_chunk.get());
-                        if (column_ptr->is_nullable() && column_ptr->is_constant()) {
-                            ColumnPtr column = ColumnHelper::create_column(probe_expr_ctx->root()->type(), true);
-                            column->append_nulls(_probing_chunk->num_rows());
-                            _key_columns.emplace_back(column);
-                        } else if (column_ptr->is_constant()) {
-                            auto* const_column = ColumnHelper::as_raw_column<ConstColumn>(column_ptr);
-                            const_column->data_column()->assign(_probing_chunk->num_rows(), 0);
-                            _key_columns.emplace_back(const_column->data_column());
-                        } else {
-                            _key_columns.emplace_back(column_ptr);
-                        }
-                    }
-                }
-
-                DCHECK_GT(_key_columns.size(), 0);
-                DCHECK_NOTNULL(_key_columns[0].get());
-                if (!_key_columns[0]->empty()) {
+                RETURN_IF_ERROR(_hash_joiner->set_probe_chunk(std::move(_probing_chunk)));
+                if (_hash_joiner->has_probe_chunk()) {
                     break;
                 }
             }
         }
 
-        RETURN_IF_ERROR(_ht.probe(_key_columns, &_probing_chunk, chunk, &_ht_has_remain));
-        if (!_ht_has_remain) {
-            _probing_chunk = nullptr;
-        }
-
+        RETURN_IF_ERROR(_hash_joiner->probe(chunk));
         if ((*chunk)->num_rows() <= 0) {
             // TODO: It's better to reuse the chunk object.
             // Use a new chunk to continue call _ht.probe.
@@ -473,215 +394,225 @@ Status HashJoinNode::_probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>
             continue;
         }
 
-        if (!_other_join_conjunct_ctxs.empty()) {
-            SCOPED_TIMER(_other_join_conjunct_evaluate_timer);
-            _process_other_conjunct(chunk);
-
-            if ((*chunk)->num_rows() <= 0) {
-                // TODO: It's better to reuse the chunk object.
-                // Use a new chunk to continue call _ht.probe.
-                *chunk = std::make_shared<Chunk>();
-                continue;
-            }
-        }
-
-        if (!_conjunct_ctxs.empty()) {
-            SCOPED_TIMER(_where_conjunct_evaluate_timer);
-            eval_conjuncts(_conjunct_ctxs, (*chunk).get());
-
-            if ((*chunk)->num_rows() <= 0) {
-                // TODO: It's better to reuse the chunk object.
-                // Use a new chunk to continue call _ht.probe.
-                *chunk = std::make_shared<Chunk>();
-                continue;
-            }
-        }
-
         break;
     }
 
     return Status::OK();
 }
 
-Status HashJoinNode::_probe_remain(ChunkPtr* chunk, bool& eos) {
-    ScopedTimer<MonotonicStopWatch> probe_timer(_probe_timer);
-
-    while (!_build_eos) {
-        RETURN_IF_ERROR(_ht.probe_remain(chunk, &_right_table_has_remain));
+Status HashJoinNode::_fetch_probe_chunk(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    if (_probing_partition.build_spiller == nullptr) {
+        return child(0)->get_next(state, chunk, eos);
+    }
+    if (_probing_partition.probe_spiller == nullptr) {
+        *eos = true;
+        return Status::OK();
+    }
+    auto& spiller = _probing_partition.probe_spiller;
+    RETURN_IF_ERROR(spiller->read_chunk(_probing_partition.index, _next_probe_chunk_idx++, chunk));
+    *eos = *chunk == nullptr;
+    return Status::OK();
+}
 
-        if ((*chunk)->num_rows() <= 0) {
-            // right table already have no remain data
-            _build_eos = true;
-            eos = true;
-            return Status::OK();
-        }
+bool HashJoinNode::_need_spill(RuntimeState* state) const {
+    // A null key of the build side makes the whole null aware anti join output nothing, it can't be
+    // decided by one partition.
+    if (!state->enable_spill() || _join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN) {
+        return false;
+    }
+    // It's about to spill if the memory left couldn't hold another hash table, since building
+    // the hash table needs the memory of its key columns and buckets besides the build chunk.
+    return mem_tracker()->spare_capacity() < static_cast<int64_t>(_hash_joiner->hash_table().mem_usage());
+}
 
-        if (!_conjunct_ctxs.empty()) {
-            eval_conjuncts(_conjunct_ctxs, (*chunk).get());
+Status HashJoinNode::_create_spiller(RuntimeState* state, const Chunk& layout, size_t partition_level,
+                                     std::shared_ptr<ChunkSpiller>* spiller) {
+    *spiller = std::make_shared<ChunkSpiller>(state, create_spill_chunk_meta(state, layout), runtime_profile(),
+                                              partition_level);
+    return (*spiller)->prepare();
+}
 
-            if ((*chunk)->num_rows() <= 0) {
-                // TODO: It's better to reuse the chunk object.
-                // Use a new chunk to continue call _ht.probe_remain.
-                *chunk = std::make_shared<Chunk>();
-                _build_eos = !_right_table_has_remain;
-                continue;
-            }
+// Returns a chunk of the layout of the spilled chunks, which shares the columns of the chunk.
+static ChunkPtr to_spill_layout(const Chunk& layout, const Chunk& chunk) {
+    Columns columns(layout.num_columns());
+    for (const auto& kv : layout.get_slot_id_to_index_map()) {
+        columns[kv.second] = chunk.get_column_by_slot_id(kv.first);
+    }
+    for (const auto& kv : layout.get_tuple_id_to_index_map()) {
+        if (chunk.is_tuple_exist(kv.first)) {
+            columns[kv.second] = chunk.get_tuple_column_by_id(kv.first);
+        } else {
+            columns[kv.second] = BooleanColumn::create(chunk.num_rows(), 1);
         }
-
-        eos = false;
-        _build_eos = !_right_table_has_remain;
-        return Status::OK();
     }
+    return std::make_shared<Chunk>(std::move(columns), layout.get_slot_id_to_index_map(),
+                                   layout.get_tuple_id_to_index_map());
+}
 
-    eos = true;
+Status HashJoinNode::_spill_hash_table(ChunkSpiller* build_spiller) {
+    const JoinHashTable& ht = _hash_joiner->hash_table();
+    const ChunkPtr& build_chunk = ht.get_build_chunk();
+    // The first row of the build chunk is reserved by the hash table.
+    size_t num_rows = ht.get_row_count();
+    for (size_t from = 1; from <= num_rows; from += config::vector_chunk_size) {
+        size_t size = std::min<size_t>(config::vector_chunk_size, num_rows + 1 - from);
+        ChunkPtr chunk = build_chunk->clone_empty_with_tuple(size);
+        chunk->append(*build_chunk, from, size);
+        RETURN_IF_ERROR(_spill_build_chunk(build_spiller, chunk));
+    }
+    _hash_joiner->reset_hash_table();
     return Status::OK();
 }
 
-void HashJoinNode::_calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all,
-                                                   bool& hit_all) {
-    filter_all = false;
-    hit_all = false;
-    filter.assign((*chunk)->num_rows(), 1);
+Status HashJoinNode::_spill_build_chunk(ChunkSpiller* build_spiller, const ChunkPtr& chunk) {
+    ChunkPtr spill_chunk = to_spill_layout(*_build_spill_layout, *chunk);
+    Columns key_columns;
+    _hash_joiner->evaluate_build_key_columns(spill_chunk.get(), &key_columns);
+    return build_spiller->spill(spill_chunk, key_columns);
+}
 
-    for (auto* ctx : _other_join_conjunct_ctxs) {
-        ColumnPtr column = ctx->evaluate((*chunk).get());
-        size_t true_count = ColumnHelper::count_true_with_notnull(column);
+Status HashJoinNode::_spill_probe_chunk(ChunkSpiller* probe_spiller, const ChunkPtr& chunk) {
+    ChunkPtr spill_chunk = to_spill_layout(*_probe_spill_layout, *chunk);
+    Columns key_columns;
+    _hash_joiner->evaluate_probe_key_columns(spill_chunk.get(), &key_columns);
+    return probe_spiller->spill(spill_chunk, key_columns);
+}
 
-        if (true_count == column->size()) {
-            // all hit, skip
-            continue;
-        } else if (0 == true_count) {
-            // all not hit, return
-            filter_all = true;
-            filter.assign((*chunk)->num_rows(), 0);
+Status HashJoinNode::_spill_probe_side(RuntimeState* state) {
+    while (true) {
+        RETURN_IF_CANCELLED(state);
+        ChunkPtr chunk = nullptr;
+        bool eos = false;
+        RETURN_IF_ERROR(child(0)->get_next(state, &chunk, &eos));
+        if (eos) {
             break;
-        } else {
-            bool all_zero = false;
-            ColumnHelper::merge_two_filters(column, &filter, &all_zero);
-            if (all_zero) {
-                filter_all = true;
-                break;
-            }
         }
-    }
-
-    if (!filter_all) {
-        int zero_count = SIMD::count_zero(filter.data(), filter.size());
-        if (zero_count == 0) {
-            hit_all = true;
+        if (chunk->num_rows() <= 0) {
+            continue;
         }
+        if (_probe_spiller == nullptr) {
+            _probe_spill_layout = chunk->clone_empty_with_tuple(0);
+            RETURN_IF_ERROR(_create_spiller(state, *_probe_spill_layout, 0, &_probe_spiller));
+        }
+        RETURN_IF_ERROR(_spill_probe_chunk(_probe_spiller.get(), chunk));
+    }
+    if (_probe_spiller != nullptr) {
+        RETURN_IF_ERROR(_probe_spiller->flush());
     }
+    return Status::OK();
 }
 
-void HashJoinNode::_process_row_for_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count,
-                                                   bool filter_all, bool hit_all, const Column::Filter& filter) {
-    if (filter_all) {
-        for (size_t i = start_column; i < start_column + column_count; i++) {
-            auto* null_column = ColumnHelper::as_raw_column<NullableColumn>((*chunk)->columns()[i]);
-            auto& null_data = null_column->mutable_null_column()->get_data();
-            for (size_t j = 0; j < (*chunk)->num_rows(); j++) {
-                null_data[j] = 1;
-                null_column->set_has_null(true);
-            }
-        }
-    } else {
-        if (hit_all) {
-            return;
+Status HashJoinNode::_repartition(RuntimeState* state, const SpilledPartition& partition, size_t build_chunk_idx) {
+    size_t partition_level = partition.build_spiller->partition_level() + 1;
+    std::shared_ptr<ChunkSpiller> build_spiller;
+    RETURN_IF_ERROR(_create_spiller(state, *_build_spill_layout, partition_level, &build_spiller));
+    RETURN_IF_ERROR(_spill_hash_table(build_spiller.get()));
+    ChunkPtr chunk;
+    for (size_t i = build_chunk_idx;; ++i) {
+        RETURN_IF_ERROR(partition.build_spiller->read_chunk(partition.index, i, &chunk));
+        if (chunk == nullptr) {
+            break;
         }
+        RETURN_IF_ERROR(_spill_build_chunk(build_spiller.get(), chunk));
+    }
+    RETURN_IF_ERROR(build_spiller->flush());
 
-        for (size_t i = start_column; i < start_column + column_count; i++) {
-            auto* null_column = ColumnHelper::as_raw_column<NullableColumn>((*chunk)->columns()[i]);
-            auto& null_data = null_column->mutable_null_column()->get_data();
-            for (size_t j = 0; j < filter.size(); j++) {
-                if (filter[j] == 0) {
-                    null_data[j] = 1;
-                    null_column->set_has_null(true);
-                }
+    std::shared_ptr<ChunkSpiller> probe_spiller;
+    if (partition.probe_spiller != nullptr) {
+        RETURN_IF_ERROR(_create_spiller(state, *_probe_spill_layout, partition_level, &probe_spiller));
+        for (size_t i = 0;; ++i) {
+            RETURN_IF_CANCELLED(state);
+            RETURN_IF_ERROR(partition.probe_spiller->read_chunk(partition.index, i, &chunk));
+            if (chunk == nullptr) {
+                break;
             }
+            RETURN_IF_ERROR(_spill_probe_chunk(probe_spiller.get(), chunk));
         }
+        RETURN_IF_ERROR(probe_spiller->flush());
+        partition.probe_spiller->remove_partition(partition.index);
     }
-}
-
-void HashJoinNode::_process_outer_join_with_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count) {
-    bool filter_all = false;
-    bool hit_all = false;
-    Column::Filter filter;
-
-    _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
-    _process_row_for_other_conjunct(chunk, start_column, column_count, filter_all, hit_all, filter);
 
-    _ht.remove_duplicate_index(&filter);
-    (*chunk)->filter(filter);
+    _add_spilled_partitions(build_spiller, probe_spiller);
+    return Status::OK();
 }
 
-void HashJoinNode::_process_semi_join_with_other_conjunct(ChunkPtr* chunk) {
-    bool filter_all = false;
-    bool hit_all = false;
-    Column::Filter filter;
-
-    _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
-
-    _ht.remove_duplicate_index(&filter);
-    (*chunk)->filter(filter);
+void HashJoinNode::_add_spilled_partitions(const std::shared_ptr<ChunkSpiller>& build_spiller,
+                                           const std::shared_ptr<ChunkSpiller>& probe_spiller) {
+    for (size_t i = build_spiller->num_partitions(); i > 0; --i) {
+        _spilled_partitions.push_back({build_spiller, probe_spiller, i - 1});
+    }
 }
 
-void HashJoinNode::_process_right_anti_join_with_other_conjunct(ChunkPtr* chunk) {
-    bool filter_all = false;
-    bool hit_all = false;
-    Column::Filter filter;
+Status HashJoinNode::_restore_next_spilled_partition(RuntimeState* state) {
+    // The probing partition has been joined.
+    if (_probing_partition.probe_spiller != nullptr) {
+        _probing_partition.probe_spiller->remove_partition(_probing_partition.index);
+    }
+    _probing_partition = SpilledPartition();
 
-    _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
+    while (!_spilled_partitions.empty()) {
+        RETURN_IF_CANCELLED(state);
+        SpilledPartition partition = std::move(_spilled_partitions.back());
+        _spilled_partitions.pop_back();
+        _hash_joiner->reset_hash_table();
 
-    _ht.remove_duplicate_index(&filter);
-    (*chunk)->set_num_rows(0);
-}
+        bool is_repartitioned = false;
+        ChunkPtr chunk;
+        for (size_t i = 0;; ++i) {
+            RETURN_IF_ERROR(partition.build_spiller->read_chunk(partition.index, i, &chunk));
+            if (chunk == nullptr) {
+                break;
+            }
+            RETURN_IF_ERROR(_hash_joiner->append_chunk_to_ht(state, chunk));
+            if (partition.build_spiller->partition_level() + 1 < ChunkSpiller::max_partition_levels &&
+                _need_spill(state)) {
+                RETURN_IF_ERROR(_repartition(state, partition, i + 1));
+                is_repartitioned = true;
+                break;
+            }
+        }
+        partition.build_spiller->remove_partition(partition.index);
+        if (is_repartitioned) {
+            continue;
+        }
 
-void HashJoinNode::_process_other_conjunct(ChunkPtr* chunk) {
-    switch (_join_type) {
-    case TJoinOp::LEFT_OUTER_JOIN:
-    case TJoinOp::FULL_OUTER_JOIN:
-        _process_outer_join_with_other_conjunct(chunk, _probe_column_count, _build_column_count);
-        break;
-    case TJoinOp::RIGHT_OUTER_JOIN:
-    case TJoinOp::LEFT_SEMI_JOIN:
-    case TJoinOp::LEFT_ANTI_JOIN:
-    case TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN:
-    case TJoinOp::RIGHT_SEMI_JOIN:
-        _process_semi_join_with_other_conjunct(chunk);
-        break;
-    case TJoinOp::RIGHT_ANTI_JOIN:
-        _process_right_anti_join_with_other_conjunct(chunk);
-        break;
-    default:
-        // the other join conjunct for inner join will be convert to other predicate
-        // so can't reach here
-        eval_conjuncts(_other_join_conjunct_ctxs, (*chunk).get());
+        RETURN_IF_ERROR(_hash_joiner->build_ht(state));
+        _probing_partition = std::move(partition);
+        _next_probe_chunk_idx = 0;
+        // The inner join and the left semi join of an empty build partition output nothing.
+        _probe_eos = _hash_joiner->is_short_circuit();
+        return Status::OK();
     }
+    // A repartitioned partition always adds the partitions of the next level.
+    return Status::InternalError("no spilled partition to restore in hash join");
 }
 
 Status HashJoinNode::_push_down_in_filter(RuntimeState* state) {
-    SCOPED_TIMER(_build_push_down_expr_timer);
+    SCOPED_TIMER(_hash_joiner->build_push_down_expr_timer());
 
-    if (_ht.get_row_count() > 1024) {
+    const JoinHashTable& ht = _hash_joiner->hash_table();
+    if (ht.get_row_count() > 1024) {
         return Status::OK();
     }
 
-    if (_ht.get_row_count() > 0) {
+    const auto& build_expr_ctxs = _hash_joiner->build_expr_ctxs();
+    const auto& probe_expr_ctxs = _hash_joiner->probe_expr_ctxs();
+    if (ht.get_row_count() > 0) {
         // there is a bug (DSDB-3860) in old planner if probe_expr is not slot-ref, and this fix is workaround.
-        size_t size = _build_expr_ctxs.size();
+        size_t size = build_expr_ctxs.size();
         std::vector<bool> to_build(size, true);
         for (int i = 0; i < size; i++) {
-            ExprContext* expr_ctx = _probe_expr_ctxs[i];
+            ExprContext* expr_ctx = probe_expr_ctxs[i];
             to_build[i] = (expr_ctx->root()->is_slotref());
         }
 
         for (size_t i = 0; i < size; i++) {
             if (!to_build[i]) continue;
-            ColumnPtr column = _ht.get_key_columns()[i];
-            Expr* probe_expr = _probe_expr_ctxs[i]->root();
+            ColumnPtr column = ht.get_key_columns()[i];
+            Expr* probe_expr = probe_expr_ctxs[i]->root();
             // create and fill runtime IN filter.
-            ExprContext* filter =
-                    RuntimeFilterHelper::create_runtime_in_filter(state, _pool, probe_expr, _is_null_safes[i]);
+            ExprContext* filter = RuntimeFilterHelper::create_runtime_in_filter(state, _pool, probe_expr,
+                                                                                _hash_joiner->is_null_safes()[i]);
             if (filter == nullptr) continue;
             RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_in_filter(column, probe_expr, filter));
             _runtime_in_filters.push_back(filter);
@@ -692,38 +623,12 @@ Status HashJoinNode::_push_down_in_filter(RuntimeState* state) {
         return Status::OK();
     }
 
-    COUNTER_UPDATE(_push_down_expr_num, static_cast<int64_t>(_runtime_in_filters.size()));
+    COUNTER_UPDATE(_hash_joiner->push_down_expr_num(), static_cast<int64_t>(_runtime_in_filters.size()));
     push_down_predicate(state, &_runtime_in_filters, true);
 
     return Status::OK();
 }
 
-Status HashJoinNode::_do_publish_runtime_filters(RuntimeState* state, int64_t limit) {
-    SCOPED_TIMER(_build_push_down_expr_timer);
-
-    // we build it even if hash table row count is 0
-    // because for global runtime filter, we have to send that.
-    for (auto* rf_desc : _build_runtime_filters) {
-        // skip if it does not have consumer.
-        if (!rf_desc->has_consumer()) continue;
-        // skip if ht.size() > limit and it's only for local.
-        if (!rf_desc->has_remote_targets() && _ht.get_row_count() > limit) continue;
-        PrimitiveType build_type = rf_desc->build_expr_type();
-        JoinRuntimeFilter* filter = RuntimeFilterHelper::create_runtime_bloom_filter(_pool, build_type);
-        if (filter == nullptr) continue;
-        filter->set_join_mode(rf_desc->join_mode());
-        filter->init(_ht.get_row_count());
-        ColumnPtr column = _ht.get_key_columns()[rf_desc->build_expr_order()];
-        RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter(column, build_type, filter));
-        rf_desc->set_runtime_filter(filter);
-    }
-
-    // publish runtime filters
-    state->runtime_filter_port()->publish_runtime_filters(_build_runtime_filters);
-    COUNTER_UPDATE(_push_down_expr_num, static_cast<int64_t>(_build_runtime_filters.size()));
-    return Status::OK();
-}
-
 Status HashJoinNode::_create_implicit_local_join_runtime_filters(RuntimeState* state) {
     if (_build_runtime_filters_from_planner) return Status::OK();
     VLOG_FILE << "create implicit local join runtime filters";
@@ -731,22 +636,25 @@ Status HashJoinNode::_create_implicit_local_join_runtime_filters(RuntimeState* s
     // to avoid filter id collision between multiple hash join nodes.
     const int implicit_runtime_filter_id_offset = 1000000 * (_id + 1);
 
+    const auto& build_expr_ctxs = _hash_joiner->build_expr_ctxs();
+    const auto& probe_expr_ctxs = _hash_joiner->probe_expr_ctxs();
+
     // build publish side.
-    for (int i = 0; i < _build_expr_ctxs.size(); i++) {
+    for (int i = 0; i < build_expr_ctxs.size(); i++) {
         auto* desc = _pool->add(new RuntimeFilterBuildDescriptor());
         desc->_filter_id = implicit_runtime_filter_id_offset + i;
-        desc->_build_expr_ctx = _build_expr_ctxs[i];
+        desc->_build_expr_ctx = build_expr_ctxs[i];
         desc->_build_expr_order = i;
         desc->_has_remote_targets = false;
         desc->_has_consumer = true;
-        _build_runtime_filters.push_back(desc);
+        _hash_joiner->build_runtime_filters().push_back(desc);
     }
 
     // build consume side.
-    for (int i = 0; i < _probe_expr_ctxs.size(); i++) {
+    for (int i = 0; i < probe_expr_ctxs.size(); i++) {
         auto* desc = _pool->add(new RuntimeFilterProbeDescriptor());
         desc->_filter_id = implicit_runtime_filter_id_offset + i;
-        RETURN_IF_ERROR(_probe_expr_ctxs[i]->clone(state, &desc->_probe_expr_ctx));
+        RETURN_IF_ERROR(probe_expr_ctxs[i]->clone(state, &desc->_probe_expr_ctx));
         desc->_runtime_filter.store(nullptr);
         child(0)->register_runtime_filter_descriptor(state, desc);
     }
@@ -757,33 +665,4 @@ Status HashJoinNode::_create_implicit_local_join_runtime_filters(RuntimeState* s
     return Status::OK();
 }
 
-std::string HashJoinNode::_get_join_type_str(TJoinOp::type join_type) {
-    switch (join_type) {
-    case TJoinOp::INNER_JOIN:
-        return "InnerJoin";
-    case TJoinOp::LEFT_OUTER_JOIN:
-        return "LeftOuterJoin";
-    case TJoinOp::LEFT_SEMI_JOIN:
-        return "LeftSemiJoin";
-    case TJoinOp::RIGHT_OUTER_JOIN:
-        return "RightOuterJoin";
-    case TJoinOp::FULL_OUTER_JOIN:
-        return "FullOuterJoin";
-    case TJoinOp::CROSS_JOIN:
-        return "CrossJoin";
-    case TJoinOp::MERGE_JOIN:
-        return "MergeJoin";
-    case TJoinOp::RIGHT_SEMI_JOIN:
-        return "RightSemiJoin";
-    case TJoinOp::LEFT_ANTI_JOIN:
-        return "LeftAntiJoin";
-    case TJoinOp::RIGHT_ANTI_JOIN:
-        return "RightAntiJoin";
-    case TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN:
-        return "NullAwareLeftAntiJoin";
-    default:
-        return "";
-    }
-}
-
 } // namespace starrocks::vectorized
@@ -5,7 +5,8 @@
 #include "column/chunk.h"
 #include "column/fixed_length_column.h"
 #include "exec/exec_node.h"
-#include "exec/vectorized/join_hash_map.h"
+#include "exec/vectorized/chunk_spiller.h"
+#include "exec/vectorized/hash_joiner.h"
 #include "util/phmap/phmap.h"
 
 namespace starrocks {
@@ -18,7 +19,6 @@ class ExprContext;
 
 namespace vectorized {
 class ColumnRef;
-class RuntimeFilterBuildDescriptor;
 
 class HashJoinNode : public ExecNode {
 public:
@@ -32,97 +32,98 @@ public:
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
     Status close(RuntimeState* state) override;
 
-private:
-    static bool _has_null(const ColumnPtr& column);
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
 
-    void _init_hash_table_param(HashTableParam* param);
+private:
     // local join includes: broadcast join and colocate join.
     Status _create_implicit_local_join_runtime_filters(RuntimeState* state);
     void _final_update_profile() {
         if (_probe_chunk_count > 0) {
-            COUNTER_SET(_avg_input_probe_chunk_size, int64_t(_probe_rows_counter->value() / _probe_chunk_count));
+            COUNTER_SET(_hash_joiner->avg_input_probe_chunk_size(),
+                        int64_t(_hash_joiner->probe_rows_counter()->value() / _probe_chunk_count));
         } else {
-            COUNTER_SET(_avg_input_probe_chunk_size, int64_t(0));
+            COUNTER_SET(_hash_joiner->avg_input_probe_chunk_size(), int64_t(0));
         }
         if (_output_chunk_count > 0) {
-            COUNTER_SET(_avg_output_chunk_size, int64_t(_num_rows_returned / _output_chunk_count));
+            COUNTER_SET(_hash_joiner->avg_output_chunk_size(), int64_t(_num_rows_returned / _output_chunk_count));
         } else {
-            COUNTER_SET(_avg_output_chunk_size, int64_t(0));
+            COUNTER_SET(_hash_joiner->avg_output_chunk_size(), int64_t(0));
         }
     }
-    Status _build(RuntimeState* state);
     Status _probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk, bool& eos);
-    Status _probe_remain(ChunkPtr* chunk, bool& eos);
-
-    void _calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all, bool& hit_all);
-    static void _process_row_for_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count,
-                                                bool filter_all, bool hit_all, const Column::Filter& filter);
 
-    void _process_outer_join_with_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count);
-    void _process_semi_join_with_other_conjunct(ChunkPtr* chunk);
-    void _process_right_anti_join_with_other_conjunct(ChunkPtr* chunk);
-    void _process_other_conjunct(ChunkPtr* chunk);
-
-    Status _do_publish_runtime_filters(RuntimeState* state, int64_t limit);
     Status _push_down_in_filter(RuntimeState* state);
 
-    static std::string _get_join_type_str(TJoinOp::type join_type);
+    // Grace hash join: when the hash table of the build side is about to exceed the memory limit, the rows
+    // of both sides are partitioned by the hash values of the join keys and spilled, and then the pairs of
+    // partitions are joined one by one. A build partition which still doesn't fit in memory is partitioned
+    // again, with its probe partition, by the next bits of the hash values.
+    struct SpilledPartition {
+        std::shared_ptr<ChunkSpiller> build_spiller;
+        // It's nullptr if the probe side is empty.
+        std::shared_ptr<ChunkSpiller> probe_spiller;
+        size_t index = 0;
+    };
+
+    bool _need_spill(RuntimeState* state) const;
+    Status _create_spiller(RuntimeState* state, const Chunk& layout, size_t partition_level,
+                           std::shared_ptr<ChunkSpiller>* spiller);
+    // Spill the rows of the hash table, and then reset it.
+    Status _spill_hash_table(ChunkSpiller* build_spiller);
+    Status _spill_build_chunk(ChunkSpiller* build_spiller, const ChunkPtr& chunk);
+    Status _spill_probe_chunk(ChunkSpiller* probe_spiller, const ChunkPtr& chunk);
+    // Spill all the chunks of the probe side, which is called after the build side has been spilled.
+    Status _spill_probe_side(RuntimeState* state);
+    // Partition the spilled partition again, the first build_chunk_idx chunks of its build partition
+    // have been appended to the hash table.
+    Status _repartition(RuntimeState* state, const SpilledPartition& partition, size_t build_chunk_idx);
+    void _add_spilled_partitions(const std::shared_ptr<ChunkSpiller>& build_spiller,
+                                 const std::shared_ptr<ChunkSpiller>& probe_spiller);
+    // Build the hash table of the next spilled partition, whose probe partition is probed then.
+    Status _restore_next_spilled_partition(RuntimeState* state);
+    // Fetch a chunk of the probe side, from the left child or from the probing spilled partition.
+    Status _fetch_probe_chunk(RuntimeState* state, ChunkPtr* chunk, bool* eos);
 
     friend ExecNode;
 
-    std::vector<ExprContext*> _probe_expr_ctxs;
-    std::vector<ExprContext*> _build_expr_ctxs;
-    std::vector<ExprContext*> _other_join_conjunct_ctxs;
-    std::vector<bool> _is_null_safes;
+    const TPlanNode _tnode;
+    HashJoinerPtr _hash_joiner = nullptr;
 
     std::list<ExprContext*> _runtime_in_filters;
-    std::list<RuntimeFilterBuildDescriptor*> _build_runtime_filters;
     bool _build_runtime_filters_from_planner;
 
     TJoinOp::type _join_type = TJoinOp::INNER_JOIN;
 
     bool _is_push_down = false;
 
-    JoinHashTable _ht;
+    // The join keys of the two sides, which partition the input of a shuffle join by the local shuffle
+    // exchanges in the pipeline engine.
+    std::vector<ExprContext*> _probe_expr_ctxs;
+    std::vector<ExprContext*> _build_expr_ctxs;
 
     ChunkPtr _cur_left_input_chunk = nullptr;
     ChunkPtr _pre_left_input_chunk = nullptr;
     ChunkPtr _probing_chunk = nullptr;
 
-    Columns _key_columns;
-    size_t _probe_column_count = 0;
-    size_t _build_column_count = 0;
     size_t _probe_chunk_count = 0;
     size_t _output_chunk_count = 0;
 
     bool _eos = false;
-    // hash table doesn't have reserved data
-    bool _ht_has_remain = false;
-    // right table have not output data for right outer join/right semi join/right anti join/full outer join
-    bool _right_table_has_remain = false;
-    bool _build_eos = false;
     bool _probe_eos = false; // probe table scan finished;
 
-    RuntimeProfile::Counter* _build_timer = nullptr;
-    RuntimeProfile::Counter* _build_ht_timer = nullptr;
-    RuntimeProfile::Counter* _copy_right_table_chunk_timer = nullptr;
-    RuntimeProfile::Counter* _build_push_down_expr_timer = nullptr;
+    // The spillers of the first level, they are only valid while the two sides are being spilled.
+    std::shared_ptr<ChunkSpiller> _build_spiller;
+    std::shared_ptr<ChunkSpiller> _probe_spiller;
+    // The empty chunks of the layouts of the spilled chunks.
+    ChunkUniquePtr _build_spill_layout;
+    ChunkUniquePtr _probe_spill_layout;
+    // The partitions to join, the last one is joined first.
+    std::vector<SpilledPartition> _spilled_partitions;
+    SpilledPartition _probing_partition;
+    size_t _next_probe_chunk_idx = 0;
+
     RuntimeProfile::Counter* _merge_input_chunk_timer = nullptr;
-    RuntimeProfile::Counter* _probe_timer = nullptr;
-    RuntimeProfile::Counter* _search_ht_timer = nullptr;
-    RuntimeProfile::Counter* _output_build_column_timer = nullptr;
-    RuntimeProfile::Counter* _output_probe_column_timer = nullptr;
-    RuntimeProfile::Counter* _output_tuple_column_timer = nullptr;
-    RuntimeProfile::Counter* _build_rows_counter = nullptr;
-    RuntimeProfile::Counter* _probe_rows_counter = nullptr;
-    RuntimeProfile::Counter* _build_buckets_counter = nullptr;
-    RuntimeProfile::Counter* _push_down_expr_num = nullptr;
-    RuntimeProfile::Counter* _avg_input_probe_chunk_size = nullptr;
-    RuntimeProfile::Counter* _avg_output_chunk_size = nullptr;
-    RuntimeProfile::Counter* _build_conjunct_evaluate_timer = nullptr;
-    RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
-    RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
-    RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
 };
 
 } // namespace vectorized
@@ -0,0 +1,583 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hash_joiner.h"
+
+#include <memory>
+
+#include "column/column_helper.h"
+#include "column/vectorized_fwd.h"
+#include "exec/exec_node.h"
+#include "exprs/expr.h"
+#include "exprs/vectorized/runtime_filter_bank.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/runtime_filter_worker.h"
+#include "runtime/runtime_state.h"
+#include "simd/simd.h"
+
+namespace starrocks::vectorized {
+
+HashJoiner::HashJoiner(const TPlanNode& tnode, const RowDescriptor& build_row_desc,
+                       const RowDescriptor& probe_row_desc, const RowDescriptor& row_descriptor,
+                       const std::vector<ExprContext*>* conjunct_ctxs)
+        : _tnode(tnode),
+          _build_row_desc(build_row_desc),
+          _probe_row_desc(probe_row_desc),
+          _row_descriptor(row_descriptor),
+          _conjunct_ctxs(conjunct_ctxs),
+          _join_type(tnode.hash_join_node.join_op) {
+    if (_join_type == TJoinOp::LEFT_ANTI_JOIN && tnode.hash_join_node.is_rewritten_from_not_in) {
+        _join_type = TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
+    }
+}
+
+Status HashJoiner::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile,
+                           MemTracker* mem_tracker) {
+    _pool = pool;
+    _runtime_profile = runtime_profile;
+    _mem_tracker = mem_tracker;
+
+    const std::vector<TEqJoinCondition>& eq_join_conjuncts = _tnode.hash_join_node.eq_join_conjuncts;
+    for (const auto& eq_join_conjunct : eq_join_conjuncts) {
+        ExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, eq_join_conjunct.left, &ctx));
+        _probe_expr_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, eq_join_conjunct.right, &ctx));
+        _build_expr_ctxs.push_back(ctx);
+
+        if (eq_join_conjunct.__isset.opcode && eq_join_conjunct.opcode == TExprOpcode::EQ_FOR_NULL) {
+            _is_null_safes.emplace_back(true);
+        } else {
+            _is_null_safes.emplace_back(false);
+        }
+    }
+
+    RETURN_IF_ERROR(
+            Expr::create_expr_trees(_pool, _tnode.hash_join_node.other_join_conjuncts, &_other_join_conjunct_ctxs));
+
+    if (_conjunct_ctxs == nullptr) {
+        RETURN_IF_ERROR(Expr::create_expr_trees(_pool, _tnode.conjuncts, &_owned_conjunct_ctxs));
+        _conjunct_ctxs = &_owned_conjunct_ctxs;
+    }
+
+    for (const auto& desc : _tnode.hash_join_node.build_runtime_filters) {
+        auto* rf_desc = _pool->add(new RuntimeFilterBuildDescriptor());
+        RETURN_IF_ERROR(rf_desc->init(_pool, desc));
+        _build_runtime_filters.emplace_back(rf_desc);
+    }
+
+    _build_timer = ADD_TIMER(_runtime_profile, "BuildTime");
+
+    _copy_right_table_chunk_timer = ADD_CHILD_TIMER(_runtime_profile, "1-CopyRightTableChunkTime", "BuildTime");
+    _build_ht_timer = ADD_CHILD_TIMER(_runtime_profile, "2-BuildHashTableTime", "BuildTime");
+    _build_push_down_expr_timer = ADD_CHILD_TIMER(_runtime_profile, "3-BuildPushDownExprTime", "BuildTime");
+    _build_conjunct_evaluate_timer = ADD_CHILD_TIMER(_runtime_profile, "4-BuildConjunctEvaluateTime", "BuildTime");
+
+    _probe_timer = ADD_TIMER(_runtime_profile, "ProbeTime");
+    _search_ht_timer = ADD_CHILD_TIMER(_runtime_profile, "2-SearchHashTableTimer", "ProbeTime");
+    _output_build_column_timer = ADD_CHILD_TIMER(_runtime_profile, "3-OutputBuildColumnTimer", "ProbeTime");
+    _output_probe_column_timer = ADD_CHILD_TIMER(_runtime_profile, "4-OutputProbeColumnTimer", "ProbeTime");
+    _output_tuple_column_timer = ADD_CHILD_TIMER(_runtime_profile, "5-OutputTupleColumnTimer", "ProbeTime");
+    _probe_conjunct_evaluate_timer = ADD_CHILD_TIMER(_runtime_profile, "6-ProbeConjunctEvaluateTime", "ProbeTime");
+    _other_join_conjunct_evaluate_timer =
+            ADD_CHILD_TIMER(_runtime_profile, "7-OtherJoinConjunctEvaluateTime", "ProbeTime");
+    _where_conjunct_evaluate_timer = ADD_CHILD_TIMER(_runtime_profile, "8-WhereConjunctEvaluateTime", "ProbeTime");
+
+    _probe_rows_counter = ADD_COUNTER(_runtime_profile, "ProbeRows", TUnit::UNIT);
+    _build_rows_counter = ADD_COUNTER(_runtime_profile, "BuildRows", TUnit::UNIT);
+    _build_buckets_counter = ADD_COUNTER(_runtime_profile, "BuildBuckets", TUnit::UNIT);
+    _heavy_buckets_counter = ADD_COUNTER(_runtime_profile, "HeavyBuckets", TUnit::UNIT);
+    _push_down_expr_num = ADD_COUNTER(_runtime_profile, "PushDownExprNum", TUnit::UNIT);
+    _avg_input_probe_chunk_size = ADD_COUNTER(_runtime_profile, "AvgInputProbeChunkSize", TUnit::UNIT);
+    _avg_output_chunk_size = ADD_COUNTER(_runtime_profile, "AvgOutputChunkSize", TUnit::UNIT);
+    _runtime_profile->add_info_string("JoinType", _get_join_type_str(_join_type));
+
+    RETURN_IF_ERROR(Expr::prepare(_build_expr_ctxs, state, _build_row_desc, _mem_tracker));
+    RETURN_IF_ERROR(Expr::prepare(_probe_expr_ctxs, state, _probe_row_desc, _mem_tracker));
+    RETURN_IF_ERROR(Expr::prepare(_other_join_conjunct_ctxs, state, _row_descriptor, _mem_tracker));
+    RETURN_IF_ERROR(Expr::prepare(_owned_conjunct_ctxs, state, _row_descriptor, _mem_tracker));
+
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    _ht.create(param);
+
+    _probe_column_count = _ht.get_probe_column_count();
+    _build_column_count = _ht.get_build_column_count();
+
+    return Status::OK();
+}
+
+void HashJoiner::_init_late_build_slots(HashTableParam* param) const {
+    // The build columns are materialized after the conjuncts only if the conjuncts filter the joined rows
+    // as a whole, the other join conjuncts of the outer and semi joins need the build columns as probed.
+    bool filter_as_whole = _join_type == TJoinOp::INNER_JOIN ||
+                           (_join_type == TJoinOp::LEFT_OUTER_JOIN && _other_join_conjunct_ctxs.empty());
+    if (!filter_as_whole || (_other_join_conjunct_ctxs.empty() && _conjunct_ctxs->empty())) {
+        return;
+    }
+
+    std::vector<SlotId> referenced_slots;
+    for (ExprContext* ctx : _other_join_conjunct_ctxs) {
+        ctx->root()->get_slot_ids(&referenced_slots);
+    }
+    for (ExprContext* ctx : *_conjunct_ctxs) {
+        ctx->root()->get_slot_ids(&referenced_slots);
+    }
+    for (const auto& tuple_desc : _build_row_desc.tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            if (std::find(referenced_slots.begin(), referenced_slots.end(), slot->id()) == referenced_slots.end()) {
+                param->late_build_slots.emplace_back(slot->id());
+            }
+        }
+    }
+}
+
+void HashJoiner::_init_hash_table_param(HashTableParam* param) {
+    param->with_other_conjunct = !_other_join_conjunct_ctxs.empty();
+    _init_late_build_slots(param);
+    param->join_type = _join_type;
+    param->row_desc = &_row_descriptor;
+    param->mem_tracker = _mem_tracker;
+    param->build_row_desc = &_build_row_desc;
+    param->probe_row_desc = &_probe_row_desc;
+    param->search_ht_timer = _search_ht_timer;
+    param->output_build_column_timer = _output_build_column_timer;
+    param->output_probe_column_timer = _output_probe_column_timer;
+    param->output_tuple_column_timer = _output_tuple_column_timer;
+    if (_tnode.hash_join_node.__isset.estimated_build_rows && _tnode.hash_join_node.estimated_build_rows > 0) {
+        param->estimated_build_rows = _tnode.hash_join_node.estimated_build_rows;
+    }
+
+    for (auto i = 0; i < _probe_expr_ctxs.size(); i++) {
+        param->join_keys.emplace_back(JoinKeyDesc{_probe_expr_ctxs[i]->root()->type().type, _is_null_safes[i]});
+    }
+}
+
+Status HashJoiner::open(RuntimeState* state) {
+    RETURN_IF_ERROR(Expr::open(_build_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_probe_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_other_join_conjunct_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_owned_conjunct_ctxs, state));
+    return Status::OK();
+}
+
+Status HashJoiner::close(RuntimeState* state) {
+    if (_is_closed) {
+        return Status::OK();
+    }
+    _is_closed = true;
+
+    Expr::close(_build_expr_ctxs, state);
+    Expr::close(_probe_expr_ctxs, state);
+    Expr::close(_other_join_conjunct_ctxs, state);
+    Expr::close(_owned_conjunct_ctxs, state);
+
+    _ht.close();
+    return Status::OK();
+}
+
+Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk) {
+    std::lock_guard<std::mutex> l(_build_mutex);
+    if (_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX) {
+        return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
+    }
+
+    // copy chunk of right table
+    SCOPED_TIMER(_copy_right_table_chunk_timer);
+    return _ht.append_chunk(state, chunk);
+}
+
+Status HashJoiner::build_ht(RuntimeState* state) {
+    {
+        SCOPED_TIMER(_build_conjunct_evaluate_timer);
+        _evaluate_key_columns(_build_expr_ctxs, _ht.get_build_chunk().get(), &_ht.get_key_columns());
+    }
+
+    {
+        SCOPED_TIMER(_build_ht_timer);
+        RETURN_IF_ERROR(_ht.build(state));
+    }
+
+    COUNTER_SET(_build_rows_counter, static_cast<int64_t>(_ht.get_row_count()));
+    COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
+    COUNTER_SET(_heavy_buckets_counter, static_cast<int64_t>(_ht.get_heavy_bucket_count()));
+    return Status::OK();
+}
+
+Status HashJoiner::publish_runtime_filters(RuntimeState* state, int64_t limit) {
+    // we build it even if hash table row count is 0
+    // because for global runtime filter, we have to send that.
+    std::vector<JoinRuntimeFilter*> filters(_build_runtime_filters.size(), nullptr);
+    RETURN_IF_ERROR(add_to_runtime_filters(&filters, _ht.get_row_count(), limit));
+    return publish_runtime_filters(state, filters);
+}
+
+Status HashJoiner::add_to_runtime_filters(std::vector<JoinRuntimeFilter*>* filters, size_t estimated_rows,
+                                          int64_t limit) {
+    SCOPED_TIMER(_build_push_down_expr_timer);
+    DCHECK_EQ(filters->size(), _build_runtime_filters.size());
+    size_t i = 0;
+    for (auto* rf_desc : _build_runtime_filters) {
+        JoinRuntimeFilter*& filter = (*filters)[i++];
+        // skip if it does not have consumer.
+        if (!rf_desc->has_consumer()) continue;
+        // skip if ht.size() > limit and it's only for local.
+        if (!rf_desc->has_remote_targets() && static_cast<int64_t>(estimated_rows) > limit) continue;
+        PrimitiveType build_type = rf_desc->build_expr_type();
+        if (filter == nullptr) {
+            filter = RuntimeFilterHelper::create_runtime_bloom_filter(_pool, build_type);
+            if (filter == nullptr) continue;
+            filter->set_join_mode(rf_desc->join_mode());
+            filter->init(estimated_rows);
+        }
+        ColumnPtr column = _ht.get_key_columns()[rf_desc->build_expr_order()];
+        RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter(column, build_type, filter));
+    }
+    return Status::OK();
+}
+
+Status HashJoiner::publish_runtime_filters(RuntimeState* state, const std::vector<JoinRuntimeFilter*>& filters) {
+    DCHECK_EQ(filters.size(), _build_runtime_filters.size());
+    size_t i = 0;
+    for (auto* rf_desc : _build_runtime_filters) {
+        if (filters[i] != nullptr) {
+            rf_desc->set_runtime_filter(filters[i]);
+        }
+        i++;
+    }
+
+    // publish runtime filters
+    state->runtime_filter_port()->publish_runtime_filters(_build_runtime_filters);
+    COUNTER_UPDATE(_push_down_expr_num, static_cast<int64_t>(_build_runtime_filters.size()));
+    return Status::OK();
+}
+
+Status HashJoinerFactory::publish_bucket_runtime_filters(RuntimeState* state, HashJoiner* builder, int64_t limit) {
+    std::lock_guard<std::mutex> l(_bucket_runtime_filters_mutex);
+    if (_num_built_buckets == 0) {
+        _bucket_runtime_filters.assign(builder->build_runtime_filters().size(), nullptr);
+        _bucket_runtime_filter_rows = builder->hash_table().get_row_count() * _bucket_builders.size();
+    }
+    RETURN_IF_ERROR(builder->add_to_runtime_filters(&_bucket_runtime_filters, _bucket_runtime_filter_rows, limit));
+    if (++_num_built_buckets < _bucket_builders.size()) {
+        return Status::OK();
+    }
+    return builder->publish_runtime_filters(state, _bucket_runtime_filters);
+}
+
+void HashJoiner::reset_hash_table() {
+    DCHECK(_probing_chunk == nullptr);
+    _ht.close();
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    // The estimated build rows are of all the build side, not of a spilled partition.
+    param.estimated_build_rows = 0;
+    _ht.create(param);
+    _ht_has_remain = false;
+    _right_table_has_remain = false;
+    _build_eos = false;
+}
+
+bool HashJoiner::is_short_circuit() const {
+    if (_ht.get_row_count() == 0 && (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN)) {
+        return true;
+    }
+
+    if (_ht.get_row_count() > 0) {
+        if (_join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN && _ht.get_key_columns().size() == 1 &&
+            _has_null(_ht.get_key_columns()[0])) {
+            // The current implementation of HashTable will reserve a row for judging the end of the linked list.
+            // When performing expression calculations (such as cast string to int),
+            // it is possible that this reserved row will generate Null,
+            // so Column::has_null() cannot be used to judge whether there is Null in the right table.
+            // TODO: This reserved field will be removed in the implementation mechanism in the future.
+            // at that time, you can directly use Column::has_null() to judge
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool HashJoiner::_has_null(const ColumnPtr& column) {
+    if (column->is_nullable()) {
+        const auto& null_column = ColumnHelper::as_raw_column<NullableColumn>(column)->null_column();
+        DCHECK_GT(null_column->size(), 0);
+        return null_column->contain_value(1, null_column->size(), 1);
+    }
+    return false;
+}
+
+void HashJoiner::_evaluate_key_columns(const std::vector<ExprContext*>& expr_ctxs, Chunk* chunk,
+                                       Columns* key_columns) {
+    for (auto* expr_ctx : expr_ctxs) {
+        ColumnPtr column_ptr = expr_ctx->evaluate(chunk);
+        if (column_ptr->is_nullable() && column_ptr->is_constant()) {
+            ColumnPtr column = ColumnHelper::create_column(expr_ctx->root()->type(), true);
+            column->append_nulls(chunk->num_rows());
+            key_columns->emplace_back(column);
+        } else if (column_ptr->is_constant()) {
+            auto* const_column = ColumnHelper::as_raw_column<ConstColumn>(column_ptr);
+            const_column->data_column()->assign(chunk->num_rows(), 0);
+            key_columns->emplace_back(const_column->data_column());
+        } else {
+            key_columns->emplace_back(column_ptr);
+        }
+    }
+}
+
+Status HashJoiner::set_probe_chunk(ChunkPtr chunk) {
+    DCHECK(_probing_chunk == nullptr);
+    _probing_chunk = std::move(chunk);
+    COUNTER_UPDATE(_probe_rows_counter, _probing_chunk->num_rows());
+
+    {
+        SCOPED_TIMER(_probe_conjunct_evaluate_timer);
+        _key_columns.resize(0);
+        _evaluate_key_columns(_probe_expr_ctxs, _probing_chunk.get(), &_key_columns);
+    }
+
+    DCHECK_GT(_key_columns.size(), 0);
+    DCHECK_NOTNULL(_key_columns[0].get());
+    if (_key_columns[0]->empty()) {
+        // nothing to probe
+        _probing_chunk = nullptr;
+    }
+    return Status::OK();
+}
+
+Status HashJoiner::probe(ChunkPtr* chunk) {
+    DCHECK(_probing_chunk != nullptr);
+    RETURN_IF_ERROR(_ht.probe(_key_columns, &_probing_chunk, chunk, &_ht_has_remain));
+    if (!_ht_has_remain) {
+        _probing_chunk = nullptr;
+    }
+
+    bool late_materialize = _ht.has_late_build_columns() && (*chunk)->num_rows() > 0;
+    if (late_materialize) {
+        if (_late_build_index == nullptr) {
+            _late_build_index = UInt32Column::create();
+        }
+        _late_build_index->resize(0);
+        _ht.append_output_build_index(_late_build_index.get());
+    }
+
+    if ((*chunk)->num_rows() > 0 && !_other_join_conjunct_ctxs.empty()) {
+        SCOPED_TIMER(_other_join_conjunct_evaluate_timer);
+        _process_other_conjunct(chunk);
+    }
+
+    if ((*chunk)->num_rows() > 0 && !_conjunct_ctxs->empty()) {
+        SCOPED_TIMER(_where_conjunct_evaluate_timer);
+        _eval_conjuncts(*_conjunct_ctxs, chunk);
+    }
+
+    if (late_materialize && (*chunk)->num_rows() > 0) {
+        DCHECK_EQ(_late_build_index->size(), (*chunk)->num_rows());
+        _ht.materialize_late_build_columns(_late_build_index->get_data(), chunk);
+    }
+
+    return Status::OK();
+}
+
+void HashJoiner::_eval_conjuncts(const std::vector<ExprContext*>& conjunct_ctxs, ChunkPtr* chunk) {
+    if (!_ht.has_late_build_columns()) {
+        ExecNode::eval_conjuncts(conjunct_ctxs, (*chunk).get());
+        return;
+    }
+    // Keep the build rows of the late build columns in step with the filtered rows.
+    FilterPtr filter;
+    ExecNode::eval_conjuncts(conjunct_ctxs, (*chunk).get(), &filter);
+    if ((*chunk)->num_rows() == 0) {
+        _late_build_index->resize(0);
+    } else if (_late_build_index->size() != (*chunk)->num_rows()) {
+        DCHECK(filter != nullptr);
+        _late_build_index->filter(*filter);
+    }
+}
+
+Status HashJoiner::probe_remain(ChunkPtr* chunk, bool* eos) {
+    ScopedTimer<MonotonicStopWatch> probe_timer(_probe_timer);
+
+    while (!_build_eos) {
+        RETURN_IF_ERROR(_ht.probe_remain(chunk, &_right_table_has_remain));
+
+        if ((*chunk)->num_rows() <= 0) {
+            // right table already have no remain data
+            _build_eos = true;
+            *eos = true;
+            return Status::OK();
+        }
+
+        if (!_conjunct_ctxs->empty()) {
+            ExecNode::eval_conjuncts(*_conjunct_ctxs, (*chunk).get());
+
+            if ((*chunk)->num_rows() <= 0) {
+                // TODO: It's better to reuse the chunk object.
+                // Use a new chunk to continue call _ht.probe_remain.
+                *chunk = std::make_shared<Chunk>();
+                _build_eos = !_right_table_has_remain;
+                continue;
+            }
+        }
+
+        *eos = false;
+        _build_eos = !_right_table_has_remain;
+        return Status::OK();
+    }
+
+    *eos = true;
+    return Status::OK();
+}
+
+void HashJoiner::_calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all,
+                                                 bool& hit_all) {
+    filter_all = false;
+    hit_all = false;
+    filter.assign((*chunk)->num_rows(), 1);
+
+    for (auto* ctx : _other_join_conjunct_ctxs) {
+        ColumnPtr column = ctx->evaluate((*chunk).get());
+        size_t true_count = ColumnHelper::count_true_with_notnull(column);
+
+        if (true_count == column->size()) {
+            // all hit, skip
+            continue;
+        } else if (0 == true_count) {
+            // all not hit, return
+            filter_all = true;
+            filter.assign((*chunk)->num_rows(), 0);
+            break;
+        } else {
+            bool all_zero = false;
+            ColumnHelper::merge_two_filters(column, &filter, &all_zero);
+            if (all_zero) {
+                filter_all = true;
+                break;
+            }
+        }
+    }
+
+    if (!filter_all) {
+        int zero_count = SIMD::count_zero(filter.data(), filter.size());
+        if (zero_count == 0) {
+            hit_all = true;
+        }
+    }
+}
+
+void HashJoiner::_process_row_for_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count,
+                                                 bool filter_all, bool hit_all, const Column::Filter& filter) {
+    if (filter_all) {
+        for (size_t i = start_column; i < start_column + column_count; i++) {
+            auto* null_column = ColumnHelper::as_raw_column<NullableColumn>((*chunk)->columns()[i]);
+            auto& null_data = null_column->mutable_null_column()->get_data();
+            for (size_t j = 0; j < (*chunk)->num_rows(); j++) {
+                null_data[j] = 1;
+                null_column->set_has_null(true);
+            }
+        }
+    } else {
+        if (hit_all) {
+            return;
+        }
+
+        for (size_t i = start_column; i < start_column + column_count; i++) {
+            auto* null_column = ColumnHelper::as_raw_column<NullableColumn>((*chunk)->columns()[i]);
+            auto& null_data = null_column->mutable_null_column()->get_data();
+            for (size_t j = 0; j < filter.size(); j++) {
+                if (filter[j] == 0) {
+                    null_data[j] = 1;
+                    null_column->set_has_null(true);
+                }
+            }
+        }
+    }
+}
+
+void HashJoiner::_process_outer_join_with_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count) {
+    bool filter_all = false;
+    bool hit_all = false;
+    Column::Filter filter;
+
+    _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
+    _process_row_for_other_conjunct(chunk, start_column, column_count, filter_all, hit_all, filter);
+
+    _ht.remove_duplicate_index(&filter);
+    (*chunk)->filter(filter);
+}
+
+void HashJoiner::_process_semi_join_with_other_conjunct(ChunkPtr* chunk) {
+    bool filter_all = false;
+    bool hit_all = false;
+    Column::Filter filter;
+
+    _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
+
+    _ht.remove_duplicate_index(&filter);
+    (*chunk)->filter(filter);
+}
+
+void HashJoiner::_process_right_anti_join_with_other_conjunct(ChunkPtr* chunk) {
+    bool filter_all = false;
+    bool hit_all = false;
+    Column::Filter filter;
+
+    _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
+
+    _ht.remove_duplicate_index(&filter);
+    (*chunk)->set_num_rows(0);
+}
+
+void HashJoiner::_process_other_conjunct(ChunkPtr* chunk) {
+    switch (_join_type) {
+    case TJoinOp::LEFT_OUTER_JOIN:
+    case TJoinOp::FULL_OUTER_JOIN:
+        _process_outer_join_with_other_conjunct(chunk, _probe_column_count, _build_column_count);
+        break;
+    case TJoinOp::RIGHT_OUTER_JOIN:
+    case TJoinOp::LEFT_SEMI_JOIN:
+    case TJoinOp::LEFT_ANTI_JOIN:
+    case TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN:
+    case TJoinOp::RIGHT_SEMI_JOIN:
+        _process_semi_join_with_other_conjunct(chunk);
+        break;
+    case TJoinOp::RIGHT_ANTI_JOIN:
+        _process_right_anti_join_with_other_conjunct(chunk);
+        break;
+    default:
+        // the other join conjunct for inner join will be convert to other predicate
+        // so can't reach here
+        _eval_conjuncts(_other_join_conjunct_ctxs, chunk);
+    }
+}
+
+std::string HashJoiner::_get_join_type_str(TJoinOp::type join_type) {
+    switch (join_type) {
+    case TJoinOp::INNER_JOIN:
+        return "InnerJoin";
+    case TJoinOp::LEFT_OUTER_JOIN:
+        return "LeftOuterJoin";
+    case TJoinOp::LEFT_SEMI_JOIN:
+        return "LeftSemiJoin";
+    case TJoinOp::RIGHT_OUTER_JOIN:
+        return "RightOuterJoin";
+    case TJoinOp::FULL_OUTER_JOIN:
+        return "FullOuterJoin";
+    case TJoinOp::CROSS_JOIN:
+        return "CrossJoin";
+    case TJoinOp::MERGE_JOIN:
+        return "MergeJoin";
+    case TJoinOp::RIGHT_SEMI_JOIN:
+        return "RightSemiJoin";
+    case TJoinOp::LEFT_ANTI_JOIN:
+        return "LeftAntiJoin";
+    case TJoinOp::RIGHT_ANTI_JOIN:
+        return "RightAntiJoin";
+    case TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN:
+        return "NullAwareLeftAntiJoin";
+    default:
+        return "";
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,303 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+
+#include "column/chunk.h"
+#include "exec/vectorized/join_hash_map.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+class ExprContext;
+class MemTracker;
+class ObjectPool;
+class RowDescriptor;
+class RuntimeState;
+
+namespace vectorized {
+class JoinRuntimeFilter;
+class RuntimeFilterBuildDescriptor;
+
+class HashJoiner;
+using HashJoinerPtr = std::shared_ptr<HashJoiner>;
+
+// HashJoiner holds the whole state of a hash join: join key expressions, other join conjuncts,
+// runtime filters and the JoinHashTable. It is used by HashJoinNode and by the pipeline hash join
+// operators. In the later case, one HashJoiner acts as the builder shared by all the build operators,
+// and each probe operator owns a HashJoiner as prober, which probes the hash table of the builder
+// after it is built.
+class HashJoiner {
+public:
+    // The where conjuncts are evaluated on the joined chunks. If conjunct_ctxs is nullptr,
+    // they are created from tnode.conjuncts in prepare(), so that each prober has its own copy.
+    HashJoiner(const TPlanNode& tnode, const RowDescriptor& build_row_desc, const RowDescriptor& probe_row_desc,
+               const RowDescriptor& row_descriptor, const std::vector<ExprContext*>* conjunct_ctxs = nullptr);
+    ~HashJoiner() = default;
+
+    Status prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile, MemTracker* mem_tracker);
+    Status open(RuntimeState* state);
+    Status close(RuntimeState* state);
+
+    // Operators sharing the HashJoiner hold a reference of it, the last one who unref it
+    // is responsible to close it.
+    void ref() { _num_ref.fetch_add(1); }
+    Status unref(RuntimeState* state) {
+        if (_num_ref.fetch_sub(1) == 1) {
+            return close(state);
+        }
+        return Status::OK();
+    }
+
+    TJoinOp::type join_type() const { return _join_type; }
+    const JoinHashTable& hash_table() const { return _ht; }
+    const std::vector<ExprContext*>& build_expr_ctxs() const { return _build_expr_ctxs; }
+    const std::vector<ExprContext*>& probe_expr_ctxs() const { return _probe_expr_ctxs; }
+    const std::vector<bool>& is_null_safes() const { return _is_null_safes; }
+    std::list<RuntimeFilterBuildDescriptor*>& build_runtime_filters() { return _build_runtime_filters; }
+
+    RuntimeProfile::Counter* build_timer() { return _build_timer; }
+    RuntimeProfile::Counter* build_push_down_expr_timer() { return _build_push_down_expr_timer; }
+    RuntimeProfile::Counter* probe_timer() { return _probe_timer; }
+    RuntimeProfile::Counter* probe_rows_counter() { return _probe_rows_counter; }
+    RuntimeProfile::Counter* push_down_expr_num() { return _push_down_expr_num; }
+    RuntimeProfile::Counter* avg_input_probe_chunk_size() { return _avg_input_probe_chunk_size; }
+    RuntimeProfile::Counter* avg_output_chunk_size() { return _avg_output_chunk_size; }
+
+    // Build side.
+    // append_chunk_to_ht is thread-safe, the build operators of all the drivers append into
+    // the same hash table of the builder.
+    Status append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk);
+    // Compute key columns, and then build the hash table.
+    Status build_ht(RuntimeState* state);
+    Status publish_runtime_filters(RuntimeState* state, int64_t limit);
+    // Add the build keys of the hash table into |filters|, one for each runtime filter. The filters missing are
+    // created for |estimated_rows| rows, and the local ones are skipped if |estimated_rows| exceeds |limit|.
+    Status add_to_runtime_filters(std::vector<JoinRuntimeFilter*>* filters, size_t estimated_rows, int64_t limit);
+    // Publish |filters| built by add_to_runtime_filters() as the runtime filters of this join.
+    Status publish_runtime_filters(RuntimeState* state, const std::vector<JoinRuntimeFilter*>& filters);
+    // Release the hash table and create an empty one, which could be appended and built again,
+    // e.g. for each partition of a spilled hash join.
+    void reset_hash_table();
+    // Whether the join must output nothing, e.g. inner join with empty right table.
+    // It's only valid after build_ht().
+    bool is_short_circuit() const;
+
+    // The pipeline build operators count down the unfinished build drivers, and the last one
+    // builds the hash table and then marks the build as complete with the status of building.
+    void set_num_build_drivers(int32_t num_build_drivers) { _num_unfinished_build_drivers = num_build_drivers; }
+    bool finish_one_build_driver() { return _num_unfinished_build_drivers.fetch_sub(1) == 1; }
+    void build_complete(const Status& status) {
+        _build_status = status;
+        _is_build_complete.store(true, std::memory_order_release);
+    }
+    bool is_build_complete() const { return _is_build_complete.load(std::memory_order_acquire); }
+    // It's only valid after is_build_complete() returns true.
+    const Status& build_status() const { return _build_status; }
+
+    // Probe side.
+    // Make this prober probe the hash table of the builder, which must be built.
+    void share_build_ht(const HashJoiner& builder) { _ht.share_readable_table(builder._ht); }
+    // Set the chunk to probe and compute its key columns.
+    Status set_probe_chunk(ChunkPtr chunk);
+    // Whether the current probe chunk hasn't been probed completely.
+    bool has_probe_chunk() const { return _probing_chunk != nullptr; }
+    // Probe the hash table with the current probe chunk, the other join conjuncts and the where
+    // conjuncts are applied to the output chunk, which may be empty.
+    Status probe(ChunkPtr* chunk);
+    // Whether the join has to output the unmatched rows of the right table after probing.
+    bool need_probe_remain() const {
+        return _join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+               _join_type == TJoinOp::FULL_OUTER_JOIN;
+    }
+    // Fetch the remain data of hash table for right outer join/right anti join/full outer join.
+    Status probe_remain(ChunkPtr* chunk, bool* eos);
+    bool is_build_eos() const { return _build_eos; }
+
+    // Evaluate the join keys of a chunk of the build side or the probe side, the constant keys are unfolded.
+    void evaluate_build_key_columns(Chunk* chunk, Columns* key_columns) const {
+        _evaluate_key_columns(_build_expr_ctxs, chunk, key_columns);
+    }
+    void evaluate_probe_key_columns(Chunk* chunk, Columns* key_columns) const {
+        _evaluate_key_columns(_probe_expr_ctxs, chunk, key_columns);
+    }
+
+private:
+    static bool _has_null(const ColumnPtr& column);
+
+    void _init_hash_table_param(HashTableParam* param);
+    // The build slots which aren't referenced by the other join conjuncts and the where conjuncts are
+    // materialized after them, so the build columns of the filtered rows are never copied.
+    void _init_late_build_slots(HashTableParam* param) const;
+    // Evaluate the conjuncts on the joined chunk, and filter the build rows of the late build columns too.
+    void _eval_conjuncts(const std::vector<ExprContext*>& conjunct_ctxs, ChunkPtr* chunk);
+    static void _evaluate_key_columns(const std::vector<ExprContext*>& expr_ctxs, Chunk* chunk, Columns* key_columns);
+
+    void _calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all, bool& hit_all);
+    static void _process_row_for_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count,
+                                                bool filter_all, bool hit_all, const Column::Filter& filter);
+
+    void _process_outer_join_with_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count);
+    void _process_semi_join_with_other_conjunct(ChunkPtr* chunk);
+    void _process_right_anti_join_with_other_conjunct(ChunkPtr* chunk);
+    void _process_other_conjunct(ChunkPtr* chunk);
+
+    static std::string _get_join_type_str(TJoinOp::type join_type);
+
+    const TPlanNode _tnode;
+    const RowDescriptor& _build_row_desc;
+    const RowDescriptor& _probe_row_desc;
+    const RowDescriptor& _row_descriptor;
+
+    ObjectPool* _pool = nullptr;
+    RuntimeProfile* _runtime_profile = nullptr;
+    MemTracker* _mem_tracker = nullptr;
+
+    std::atomic<int32_t> _num_ref = 0;
+    bool _is_closed = false;
+
+    std::vector<ExprContext*> _probe_expr_ctxs;
+    std::vector<ExprContext*> _build_expr_ctxs;
+    std::vector<ExprContext*> _other_join_conjunct_ctxs;
+    std::vector<bool> _is_null_safes;
+    // Points to either the conjuncts given by the owner or _owned_conjunct_ctxs.
+    const std::vector<ExprContext*>* _conjunct_ctxs = nullptr;
+    std::vector<ExprContext*> _owned_conjunct_ctxs;
+
+    std::list<RuntimeFilterBuildDescriptor*> _build_runtime_filters;
+
+    TJoinOp::type _join_type = TJoinOp::INNER_JOIN;
+
+    JoinHashTable _ht;
+    std::mutex _build_mutex;
+    std::atomic<int32_t> _num_unfinished_build_drivers = 1;
+    std::atomic<bool> _is_build_complete = false;
+    Status _build_status;
+
+    ChunkPtr _probing_chunk = nullptr;
+    Columns _key_columns;
+    // The build rows of the rows of the current output chunk, if some build columns are materialized late.
+    UInt32Column::Ptr _late_build_index;
+    size_t _probe_column_count = 0;
+    size_t _build_column_count = 0;
+
+    // hash table doesn't have reserved data
+    bool _ht_has_remain = false;
+    // right table have not output data for right outer join/right semi join/right anti join/full outer join
+    bool _right_table_has_remain = false;
+    bool _build_eos = false;
+
+    RuntimeProfile::Counter* _build_timer = nullptr;
+    RuntimeProfile::Counter* _build_ht_timer = nullptr;
+    RuntimeProfile::Counter* _copy_right_table_chunk_timer = nullptr;
+    RuntimeProfile::Counter* _build_push_down_expr_timer = nullptr;
+    RuntimeProfile::Counter* _probe_timer = nullptr;
+    RuntimeProfile::Counter* _search_ht_timer = nullptr;
+    RuntimeProfile::Counter* _output_build_column_timer = nullptr;
+    RuntimeProfile::Counter* _output_probe_column_timer = nullptr;
+    RuntimeProfile::Counter* _output_tuple_column_timer = nullptr;
+    RuntimeProfile::Counter* _build_rows_counter = nullptr;
+    RuntimeProfile::Counter* _probe_rows_counter = nullptr;
+    RuntimeProfile::Counter* _build_buckets_counter = nullptr;
+    RuntimeProfile::Counter* _heavy_buckets_counter = nullptr;
+    RuntimeProfile::Counter* _push_down_expr_num = nullptr;
+    RuntimeProfile::Counter* _avg_input_probe_chunk_size = nullptr;
+    RuntimeProfile::Counter* _avg_output_chunk_size = nullptr;
+    RuntimeProfile::Counter* _build_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
+};
+
+// HashJoinerFactory is used by the pipeline hash join operator factories. All the build operators
+// share the builder, and each probe operator creates its own prober.
+//
+// In a colocate join, both sides are read per bucket, and the build operator and the probe operator of
+// each driver sequence share the builder of their bucket instead, so the buckets are joined independently
+// and the hash table of a bucket is released once its probe completes. To bound the memory, the builds of
+// the buckets are admitted in the order of the driver sequences, at most |max_buckets_in_memory| ones
+// beyond the released ones. Since every colocate join admits the buckets in the same order, the first
+// unreleased bucket is always admitted by all the joins of a fragment, which never deadlocks.
+class HashJoinerFactory {
+public:
+    HashJoinerFactory(const TPlanNode& tnode, const RowDescriptor& build_row_desc, const RowDescriptor& probe_row_desc,
+                      const RowDescriptor& row_descriptor)
+            : _tnode(tnode),
+              _build_row_desc(build_row_desc),
+              _probe_row_desc(probe_row_desc),
+              _row_descriptor(row_descriptor),
+              _builder(std::make_shared<HashJoiner>(tnode, build_row_desc, probe_row_desc, row_descriptor)) {}
+
+    void set_bucketed(int32_t max_buckets_in_memory) {
+        _is_bucketed = true;
+        _max_buckets_in_memory = std::max<int32_t>(max_buckets_in_memory, 1);
+    }
+    bool is_bucketed() const { return _is_bucketed; }
+
+    // Both sides of a shuffle join are partitioned by the join keys across the drivers by the local shuffle
+    // exchanges, so each driver builds and probes the hash table of its partition alone, like a bucket.
+    void set_partitioned() { _is_partitioned = true; }
+    bool is_partitioned() const { return _is_partitioned; }
+
+    // Whether each driver has its own builder, otherwise all the drivers share one builder.
+    bool has_builder_per_driver() const { return _is_bucketed || _is_partitioned; }
+
+    const HashJoinerPtr& builder() const { return _builder; }
+
+    // The builder of the bucket or partition of |driver_sequence|, otherwise the shared one.
+    // The operators are created by one thread, so the builders are created without lock.
+    const HashJoinerPtr& builder(int32_t driver_sequence) {
+        if (!has_builder_per_driver()) {
+            return _builder;
+        }
+        if (static_cast<size_t>(driver_sequence) >= _bucket_builders.size()) {
+            _bucket_builders.resize(driver_sequence + 1);
+        }
+        if (_bucket_builders[driver_sequence] == nullptr) {
+            _bucket_builders[driver_sequence] =
+                    std::make_shared<HashJoiner>(_tnode, _build_row_desc, _probe_row_desc, _row_descriptor);
+        }
+        return _bucket_builders[driver_sequence];
+    }
+
+    HashJoinerPtr create_prober() {
+        return std::make_shared<HashJoiner>(_tnode, _build_row_desc, _probe_row_desc, _row_descriptor);
+    }
+
+    bool is_bucket_admitted(int32_t driver_sequence) const {
+        return driver_sequence < _max_buckets_in_memory + _num_released_buckets.load(std::memory_order_acquire);
+    }
+    void release_bucket() { _num_released_buckets.fetch_add(1, std::memory_order_release); }
+
+    // The runtime filters of a colocate or shuffle join cover all the buckets or partitions: each one adds
+    // its hash table into them after it's built, and the last one publishes them, because the global runtime
+    // filters must always be published. The filters are sized by the first one built, they are of similar sizes.
+    Status publish_bucket_runtime_filters(RuntimeState* state, HashJoiner* builder, int64_t limit);
+
+private:
+    const TPlanNode _tnode;
+    const RowDescriptor& _build_row_desc;
+    const RowDescriptor& _probe_row_desc;
+    const RowDescriptor& _row_descriptor;
+    HashJoinerPtr _builder;
+
+    bool _is_bucketed = false;
+    bool _is_partitioned = false;
+    int32_t _max_buckets_in_memory = 1;
+    std::vector<HashJoinerPtr> _bucket_builders;
+    std::atomic<int32_t> _num_released_buckets{0};
+
+    std::mutex _bucket_runtime_filters_mutex;
+    std::vector<JoinRuntimeFilter*> _bucket_runtime_filters;
+    size_t _bucket_runtime_filter_rows = 0;
+    size_t _num_built_buckets = 0;
+};
+
+using HashJoinerFactoryPtr = std::shared_ptr<HashJoinerFactory>;
+
+} // namespace vectorized
+} // namespace starrocks
@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "env/env_hdfs.h"
+#include "exec/vectorized/block_cache.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "exprs/vectorized/runtime_filter.h"
@@ -167,6 +168,7 @@ Status HdfsScanNode::_create_and_init_scanner(RuntimeState* state, const HdfsFil
     scanner_params.runtime_filter_collector = &_runtime_filter_collector;
     scanner_params.scan_ranges = hdfs_file_desc.splits;
     scanner_params.fs = hdfs_file_desc.fs;
+    scanner_params.modification_time = hdfs_file_desc.modification_time;
     scanner_params.tuple_desc = _tuple_desc;
     scanner_params.materialize_slots = _materialize_slots;
     scanner_params.materialize_index_in_chunk = _materialize_index_in_chunk;
@@ -557,6 +559,14 @@ Status HdfsScanNode::_find_and_insert_hdfs_file(const THdfsScanRange& scan_range
         hdfs_file_desc->partition_id = scan_range.partition_id;
         hdfs_file_desc->path = scan_range.relative_path;
         hdfs_file_desc->file_length = scan_range.file_length;
+        if (BlockCache::instance() != nullptr) {
+            // The cached blocks of a file are keyed by its modification time, it's not cached if it's unknown.
+            hdfsFileInfo* file_info = hdfsGetPathInfo(hdfs, native_file_path.c_str());
+            if (file_info != nullptr) {
+                hdfs_file_desc->modification_time = file_info->mLastMod;
+                hdfsFreeFileInfo(file_info, 1);
+            }
+        }
         hdfs_file_desc->splits.emplace_back(&scan_range);
         hdfs_file_desc->hdfs_file_format = scan_range.file_format;
         _hdfs_files.emplace_back(hdfs_file_desc);
@@ -609,6 +619,11 @@ void HdfsScanNode::_init_counter(RuntimeState* state) {
     _io_timer = ADD_TIMER(_runtime_profile, "IoTime");
     _io_counter = ADD_COUNTER(_runtime_profile, "IoCounter", TUnit::UNIT);
     _bytes_read_from_disk_counter = ADD_COUNTER(_runtime_profile, "BytesReadFromDisk", TUnit::BYTES);
+    _io_coalesced_counter = ADD_COUNTER(_runtime_profile, "IOCoalescedCounter", TUnit::UNIT);
+    _io_coalesced_bytes = ADD_COUNTER(_runtime_profile, "IOCoalescedBytes", TUnit::BYTES);
+    _io_prefetch_wait_timer = ADD_TIMER(_runtime_profile, "IOPrefetchWaitTime");
+    _block_cache_hit_bytes = ADD_COUNTER(_runtime_profile, "BlockCacheHitBytes", TUnit::BYTES);
+    _block_cache_miss_bytes = ADD_COUNTER(_runtime_profile, "BlockCacheMissBytes", TUnit::BYTES);
     _column_read_timer = ADD_TIMER(_runtime_profile, "ColumnReadTime");
     _level_decode_timer = ADD_TIMER(_runtime_profile, "LevelDecodeTime");
     _value_decode_timer = ADD_TIMER(_runtime_profile, "ValueDecodeTime");
@@ -624,11 +639,18 @@ void HdfsScanNode::_init_counter(RuntimeState* state) {
     // reader init
     _footer_read_timer = ADD_TIMER(_runtime_profile, "ReaderInitFooterRead");
     _column_reader_init_timer = ADD_TIMER(_runtime_profile, "ReaderInitColumnReaderInit");
+    _page_index_read_timer = ADD_TIMER(_runtime_profile, "ReaderInitPageIndexRead");
+
+    // page index
+    _page_skip_counter = ADD_COUNTER(_runtime_profile, "PageSkipCounter", TUnit::UNIT);
 
     // dict filter
     _group_chunk_read_timer = ADD_TIMER(_runtime_profile, "GroupChunkRead");
     _group_dict_filter_timer = ADD_TIMER(_runtime_profile, "GroupDictFilter");
     _group_dict_decode_timer = ADD_TIMER(_runtime_profile, "GroupDictDecode");
+
+    // late materialization
+    _late_materialize_skip_rows = ADD_COUNTER(_runtime_profile, "LateMaterializeSkipRows", TUnit::UNIT);
 }
 
 } // namespace starrocks::vectorized
@@ -22,6 +22,8 @@ struct HdfsFileDesc {
     int partition_id = 0;
     std::string path;
     int64_t file_length = 0;
+    // the modification time of a remote file, which is only got if the block cache is enabled
+    int64_t modification_time = 0;
     std::vector<const THdfsScanRange*> splits;
 };
 
@@ -160,6 +162,11 @@ private:
     RuntimeProfile::Counter* _io_timer = nullptr;
     RuntimeProfile::Counter* _io_counter = nullptr;
     RuntimeProfile::Counter* _bytes_read_from_disk_counter = nullptr;
+    RuntimeProfile::Counter* _io_coalesced_counter = nullptr;
+    RuntimeProfile::Counter* _io_coalesced_bytes = nullptr;
+    RuntimeProfile::Counter* _io_prefetch_wait_timer = nullptr;
+    RuntimeProfile::Counter* _block_cache_hit_bytes = nullptr;
+    RuntimeProfile::Counter* _block_cache_miss_bytes = nullptr;
     RuntimeProfile::Counter* _column_read_timer = nullptr;
     RuntimeProfile::Counter* _level_decode_timer = nullptr;
     RuntimeProfile::Counter* _value_decode_timer = nullptr;
@@ -175,10 +182,17 @@ private:
     // reader init
     RuntimeProfile::Counter* _footer_read_timer = nullptr;
     RuntimeProfile::Counter* _column_reader_init_timer = nullptr;
+    RuntimeProfile::Counter* _page_index_read_timer = nullptr;
+
+    // page index
+    RuntimeProfile::Counter* _page_skip_counter = nullptr;
 
     // dict filter
     RuntimeProfile::Counter* _group_chunk_read_timer = nullptr;
     RuntimeProfile::Counter* _group_dict_filter_timer = nullptr;
     RuntimeProfile::Counter* _group_dict_decode_timer = nullptr;
+
+    // late materialization
+    RuntimeProfile::Counter* _late_materialize_skip_rows = nullptr;
 };
 } // namespace starrocks::vectorized
@@ -6,11 +6,15 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "env/env_hdfs.h"
 #include "exec/exec_node.h"
 #include "exec/parquet/file_reader.h"
+#include "exec/vectorized/block_cache.h"
+#include "exec/vectorized/coalesced_read_file.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "exprs/expr.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/runtime_profile.h"
@@ -117,6 +121,13 @@ Status HdfsScanner::open(RuntimeState* runtime_state) {
         return Status::OK();
     }
     _build_file_read_param();
+    _file = _scanner_params.fs;
+    if (BlockCache::instance() != nullptr && _scanner_params.modification_time > 0) {
+        _block_cache_file = std::make_shared<BlockCacheFile>(_scanner_params.fs, BlockCache::instance(),
+                                                             _scanner_params.modification_time,
+                                                             _scanner_params.scan_ranges[0]->file_length);
+        _file = _block_cache_file;
+    }
     auto status = do_open(runtime_state);
     if (status.ok()) {
         _is_open = true;
@@ -177,6 +188,10 @@ void HdfsScanner::update_counter() {
     COUNTER_UPDATE(_scanner_params.parent->_bytes_read_short_circuit, hdfs_stats.bytes_read_short_circuit);
     COUNTER_UPDATE(_scanner_params.parent->_bytes_read_dn_cache, hdfs_stats.bytes_read_dn_cache);
     COUNTER_UPDATE(_scanner_params.parent->_bytes_read_remote, hdfs_stats.bytes_read_remote);
+    if (_block_cache_file != nullptr) {
+        COUNTER_UPDATE(_scanner_params.parent->_block_cache_hit_bytes, _block_cache_file->hit_bytes());
+        COUNTER_UPDATE(_scanner_params.parent->_block_cache_miss_bytes, _block_cache_file->miss_bytes());
+    }
 #endif
 }
 
@@ -186,8 +201,14 @@ Status HdfsParquetScanner::do_init(RuntimeState* runtime_state, const HdfsScanne
 
 Status HdfsParquetScanner::do_open(RuntimeState* runtime_state) {
     // create file reader
-    _reader = std::make_shared<parquet::FileReader>(_scanner_params.fs.get(),
-                                                    _scanner_params.scan_ranges[0]->file_length);
+    if (config::hdfs_scan_io_coalesce_enable) {
+        _coalesced_file = std::make_shared<CoalescedReadFile>(
+                _file, ExecEnv::GetInstance()->hdfs_scan_io_thread_pool(), &_stats);
+        _reader = std::make_shared<parquet::FileReader>(_coalesced_file.get(),
+                                                        _scanner_params.scan_ranges[0]->file_length);
+    } else {
+        _reader = std::make_shared<parquet::FileReader>(_file.get(), _scanner_params.scan_ranges[0]->file_length);
+    }
 #ifndef BE_TEST
     SCOPED_TIMER(_scanner_params.parent->_reader_init_timer);
 #endif
@@ -212,6 +233,9 @@ void HdfsParquetScanner::update_counter() {
     COUNTER_UPDATE(_scanner_params.parent->_io_timer, _stats.io_ns);
     COUNTER_UPDATE(_scanner_params.parent->_io_counter, _stats.io_count);
     COUNTER_UPDATE(_scanner_params.parent->_bytes_read_from_disk_counter, _stats.bytes_read_from_disk);
+    COUNTER_UPDATE(_scanner_params.parent->_io_coalesced_counter, _stats.io_coalesced_count);
+    COUNTER_UPDATE(_scanner_params.parent->_io_coalesced_bytes, _stats.io_coalesced_bytes);
+    COUNTER_UPDATE(_scanner_params.parent->_io_prefetch_wait_timer, _stats.io_prefetch_wait_ns);
     COUNTER_UPDATE(_scanner_params.parent->_column_read_timer, _stats.column_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_column_convert_timer, _stats.column_convert_ns);
     COUNTER_UPDATE(_scanner_params.parent->_value_decode_timer, _stats.value_decode_ns);
@@ -219,9 +243,12 @@ void HdfsParquetScanner::update_counter() {
     COUNTER_UPDATE(_scanner_params.parent->_page_read_timer, _stats.page_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_footer_read_timer, _stats.footer_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_column_reader_init_timer, _stats.column_reader_init_ns);
+    COUNTER_UPDATE(_scanner_params.parent->_page_index_read_timer, _stats.page_index_read_ns);
+    COUNTER_UPDATE(_scanner_params.parent->_page_skip_counter, _stats.page_skip_count);
     COUNTER_UPDATE(_scanner_params.parent->_group_chunk_read_timer, _stats.group_chunk_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_group_dict_filter_timer, _stats.group_dict_filter_ns);
     COUNTER_UPDATE(_scanner_params.parent->_group_dict_decode_timer, _stats.group_dict_decode_ns);
+    COUNTER_UPDATE(_scanner_params.parent->_late_materialize_skip_rows, _stats.late_materialize_skip_rows);
 #endif
 }
 
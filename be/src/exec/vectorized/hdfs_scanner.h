@@ -14,6 +14,8 @@ class FileReader;
 }
 namespace starrocks::vectorized {
 
+class BlockCacheFile;
+class CoalescedReadFile;
 class HdfsScanNode;
 class RuntimeFilterProbeCollector;
 
@@ -23,6 +25,10 @@ struct HdfsScanStats {
     int64_t io_ns = 0;
     int64_t io_count = 0;
     int64_t bytes_read_from_disk = 0;
+    // coalesced io
+    int64_t io_coalesced_count = 0;
+    int64_t io_coalesced_bytes = 0;
+    int64_t io_prefetch_wait_ns = 0;
     int64_t column_read_ns = 0;
     int64_t level_decode_ns = 0;
     int64_t value_decode_ns = 0;
@@ -31,10 +37,15 @@ struct HdfsScanStats {
     // reader init
     int64_t footer_read_ns = 0;
     int64_t column_reader_init_ns = 0;
+    int64_t page_index_read_ns = 0;
+    // page index
+    int64_t page_skip_count = 0;
     // dict filter
     int64_t group_chunk_read_ns = 0;
     int64_t group_dict_filter_ns = 0;
     int64_t group_dict_decode_ns = 0;
+    // late materialization
+    int64_t late_materialize_skip_rows = 0;
 };
 
 struct HdfsScannerParams {
@@ -52,6 +63,8 @@ struct HdfsScannerParams {
 
     // file fd (local file or hdfs file)
     std::shared_ptr<RandomAccessFile> fs = nullptr;
+    // the modification time of the hdfs file, 0 if it's unknown
+    int64_t modification_time = 0;
 
     const TupleDescriptor* tuple_desc;
 
@@ -162,6 +175,9 @@ private:
 protected:
     HdfsFileReaderParam _file_read_param;
     HdfsScannerParams _scanner_params;
+    // the file to read, which is _scanner_params.fs or _block_cache_file
+    std::shared_ptr<RandomAccessFile> _file = nullptr;
+    std::shared_ptr<BlockCacheFile> _block_cache_file = nullptr;
     RuntimeState* _runtime_state = nullptr;
     HdfsScanStats _stats;
     // predicate collections.
@@ -186,6 +202,8 @@ public:
     Status do_init(RuntimeState* runtime_state, const HdfsScannerParams& scanner_params) override;
 
 private:
+    // reads the column chunks of the file if the ios are coalesced, outlives _reader
+    std::shared_ptr<CoalescedReadFile> _coalesced_file = nullptr;
     std::shared_ptr<parquet::FileReader> _reader = nullptr;
 };
 
@@ -2,9 +2,15 @@
 
 #include "exec/vectorized/hdfs_scanner_orc.h"
 
+#include <limits>
+#include <set>
+
+#include "common/config.h"
 #include "env/env.h"
+#include "exec/vectorized/coalesced_read_file.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "gen_cpp/orc_proto.pb.h"
+#include "runtime/exec_env.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/runtime_profile.h"
 
@@ -58,7 +64,19 @@ public:
     virtual void onStartingPickRowGroups() override;
     virtual void onEndingPickRowGroups() override;
 
+    // Plan the streams of the selected columns of the stripes to read on |file| when they are opened.
+    void set_coalesced_file(CoalescedReadFile* file, const orc::Reader* reader, std::vector<bool> selected_columns) {
+        _coalesced_file = file;
+        _orc_reader = reader;
+        _selected_columns = std::move(selected_columns);
+    }
+
 private:
+    bool _in_scan_ranges(uint64_t offset) const;
+    // Plan and prefetch the current stripe and the next one to read, and release the stripes before.
+    void _prefetch_stripes(uint64_t stripe_index, uint64_t offset);
+    void _plan_stripe(uint64_t stripe_index);
+
     const HdfsScannerParams& _scanner_params;
     const HdfsFileReaderParam& _reader_params;
     uint64_t _current_stripe_index;
@@ -75,6 +93,11 @@ private:
     // 2. and check if range.start <= `offset`
     std::map<uint64_t, uint64_t> _scan_ranges;
     OrcScannerAdapter* _adapter;
+
+    CoalescedReadFile* _coalesced_file = nullptr;
+    const orc::Reader* _orc_reader = nullptr;
+    std::vector<bool> _selected_columns;
+    std::set<uint64_t> _planned_stripes;
 };
 
 void OrcRowReaderFilter::onStartingPickRowGroups() {}
@@ -112,14 +135,52 @@ bool OrcRowReaderFilter::filterOnOpeningStripe(uint64_t stripeIndex,
                                                const orc::proto::StripeInformation* stripeInformation) {
     _current_stripe_index = stripeIndex;
     uint64_t offset = stripeInformation->offset();
-    // range end must > offset
-    auto it = _scan_ranges.upper_bound(offset);
-    if ((it != _scan_ranges.end()) && (offset >= it->second) && (offset < it->first)) {
+    if (_in_scan_ranges(offset)) {
+        if (_coalesced_file != nullptr) {
+            _prefetch_stripes(stripeIndex, offset);
+        }
         return false;
     }
     return true;
 }
 
+bool OrcRowReaderFilter::_in_scan_ranges(uint64_t offset) const {
+    // range end must > offset
+    auto it = _scan_ranges.upper_bound(offset);
+    return (it != _scan_ranges.end()) && (offset >= it->second) && (offset < it->first);
+}
+
+void OrcRowReaderFilter::_prefetch_stripes(uint64_t stripe_index, uint64_t offset) {
+    _coalesced_file->release(0, offset);
+    _plan_stripe(stripe_index);
+    uint64_t next = stripe_index + 1;
+    if (next < _orc_reader->getNumberOfStripes() && _in_scan_ranges(_orc_reader->getStripe(next)->getOffset())) {
+        _plan_stripe(next);
+    }
+    _coalesced_file->prefetch(offset, std::numeric_limits<uint64_t>::max() - offset);
+}
+
+void OrcRowReaderFilter::_plan_stripe(uint64_t stripe_index) {
+    if (!_planned_stripes.insert(stripe_index).second) {
+        return;
+    }
+    try {
+        // reads the stripe footer to get the layout of the streams
+        auto stripe = _orc_reader->getStripe(stripe_index);
+        std::vector<CoalescedReadFile::IORange> ranges;
+        for (uint64_t i = 0; i < stripe->getNumberOfStreams(); i++) {
+            auto stream = stripe->getStreamInformation(i);
+            uint64_t column_id = stream->getColumnId();
+            if (column_id < _selected_columns.size() && _selected_columns[column_id]) {
+                ranges.emplace_back(stream->getOffset(), stream->getLength());
+            }
+        }
+        _coalesced_file->plan(std::move(ranges));
+    } catch (std::exception& e) {
+        LOG(WARNING) << "failed to plan the io of stripe " << stripe_index << ": " << e.what();
+    }
+}
+
 bool OrcRowReaderFilter::filterMinMax(size_t rowGroupIdx,
                                       const std::unordered_map<uint64_t, orc::proto::RowIndex>& rowIndexes,
                                       const std::map<uint32_t, orc::BloomFilterIndex>& bloomFilter) {
@@ -292,6 +353,9 @@ void HdfsOrcScanner::update_counter() {
     COUNTER_UPDATE(_scanner_params.parent->_io_timer, _stats.io_ns);
     COUNTER_UPDATE(_scanner_params.parent->_io_counter, _stats.io_count);
     COUNTER_UPDATE(_scanner_params.parent->_bytes_read_from_disk_counter, _stats.bytes_read_from_disk);
+    COUNTER_UPDATE(_scanner_params.parent->_io_coalesced_counter, _stats.io_coalesced_count);
+    COUNTER_UPDATE(_scanner_params.parent->_io_coalesced_bytes, _stats.io_coalesced_bytes);
+    COUNTER_UPDATE(_scanner_params.parent->_io_prefetch_wait_timer, _stats.io_prefetch_wait_ns);
     COUNTER_UPDATE(_scanner_params.parent->_column_read_timer, _stats.column_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_column_convert_timer, _stats.column_convert_ns);
     COUNTER_UPDATE(_scanner_params.parent->_value_decode_timer, _stats.value_decode_ns);
@@ -305,8 +369,14 @@ Status HdfsParquetScanner::do_close(RuntimeState* runtime_state) {
 }
 
 Status HdfsOrcScanner::do_open(RuntimeState* runtime_state) {
-    auto input_stream = std::make_unique<ORCHdfsFileStream>(_scanner_params.fs,
-                                                            _scanner_params.scan_ranges[0]->file_length, &_stats);
+    std::shared_ptr<RandomAccessFile> file = _file;
+    if (config::hdfs_scan_io_coalesce_enable) {
+        _coalesced_file = std::make_shared<CoalescedReadFile>(
+                _file, ExecEnv::GetInstance()->hdfs_scan_io_thread_pool(), &_stats);
+        file = _coalesced_file;
+    }
+    auto input_stream =
+            std::make_unique<ORCHdfsFileStream>(file, _scanner_params.scan_ranges[0]->file_length, &_stats);
     std::unique_ptr<orc::Reader> reader;
     try {
         orc::ReaderOptions options;
@@ -353,7 +423,12 @@ Status HdfsOrcScanner::do_open(RuntimeState* runtime_state) {
         _orc_adapter->set_conjuncts_and_runtime_filters(conjuncts, _scanner_params.runtime_filter_collector);
     }
     _orc_adapter->set_hive_column_names(_scanner_params.hive_column_names);
+    const orc::Reader* orc_reader = reader.get();
     RETURN_IF_ERROR(_orc_adapter->init(std::move(reader)));
+    if (_coalesced_file != nullptr) {
+        _orc_row_reader_filter->set_coalesced_file(_coalesced_file.get(), orc_reader,
+                                                   _orc_adapter->get_selected_columns());
+    }
     return Status::OK();
 }
 
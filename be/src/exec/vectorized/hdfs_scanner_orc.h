@@ -9,6 +9,7 @@
 
 namespace starrocks::vectorized {
 
+class CoalescedReadFile;
 class OrcRowReaderFilter;
 
 class HdfsOrcScanner final : public HdfsScanner {
@@ -37,6 +38,8 @@ private:
     std::vector<SlotDescriptor*> _src_slot_descriptors;
     std::unique_ptr<OrcScannerAdapter> _orc_adapter;
     std::shared_ptr<OrcRowReaderFilter> _orc_row_reader_filter;
+    // reads the streams of the file if the ios are coalesced
+    std::shared_ptr<CoalescedReadFile> _coalesced_file = nullptr;
 };
 
 } // namespace starrocks::vectorized
\ No newline at end of file
@@ -77,7 +77,16 @@ Status IntersectNode::open(RuntimeState* state) {
     }
 
     // initial build hash table used for record hitting.
-    _hash_set = std::make_unique<HashSerializeSet>();
+    size_t fixed_size = _get_fixed_size_of_keys();
+    if (fixed_size == 0 || fixed_size > sizeof(uint128_t)) {
+        _hash_set = std::make_unique<HashSerializeSet>();
+    } else if (fixed_size <= sizeof(uint32_t)) {
+        _hash_set = std::make_unique<FixedSizeHashSetFromExprs<uint32_t>>();
+    } else if (fixed_size <= sizeof(uint64_t)) {
+        _hash_set = std::make_unique<FixedSizeHashSetFromExprs<uint64_t>>();
+    } else {
+        _hash_set = std::make_unique<FixedSizeHashSetFromExprs<uint128_t>>();
+    }
 
     ChunkPtr chunk = nullptr;
     RETURN_IF_ERROR(child(0)->open(state));
@@ -88,9 +97,14 @@ Status IntersectNode::open(RuntimeState* state) {
     if (!eos) {
         ScopedTimer<MonotonicStopWatch> build_timer(_build_set_timer);
         std::vector<IntersectColumnTypes>* types = &_types;
-        RETURN_IF_ERROR(_hash_set->build_set(
-                state, chunk, _child_expr_lists[0], _build_pool.get(),
-                [=](const ColumnPtr& column, int i) -> void { (*types)[i].is_nullable = column->is_nullable(); }));
+        RETURN_IF_ERROR(std::visit(
+                [&](auto& hash_set) {
+                    return hash_set->build_set(state, chunk, _child_expr_lists[0], _build_pool.get(),
+                                               [=](const ColumnPtr& column, int i) -> void {
+                                                   (*types)[i].is_nullable = column->is_nullable();
+                                               });
+                },
+                _hash_set));
         while (true) {
             RETURN_IF_CANCELLED(state);
             build_timer.stop();
@@ -103,14 +117,18 @@ Status IntersectNode::open(RuntimeState* state) {
             if (chunk->num_rows() == 0) {
                 continue;
             }
-            RETURN_IF_ERROR(_hash_set->build_set(state, chunk, _child_expr_lists[0], _build_pool.get(),
-                                                 [](const ColumnPtr& column, int i) -> void {}));
+            RETURN_IF_ERROR(std::visit(
+                    [&](auto& hash_set) {
+                        return hash_set->build_set(state, chunk, _child_expr_lists[0], _build_pool.get(),
+                                                   [](const ColumnPtr& column, int i) -> void {});
+                    },
+                    _hash_set));
         }
     }
 
     // if a table is empty, the result must be empty
-    if (_hash_set->hash_set->empty()) {
-        _hash_set_iterator = _hash_set->begin();
+    if (std::visit([](auto& hash_set) { return hash_set->empty(); }, _hash_set)) {
+        std::visit([](auto& hash_set) { hash_set->init_results(); }, _hash_set);
         return Status::OK();
     }
 
@@ -128,18 +146,22 @@ Status IntersectNode::open(RuntimeState* state) {
             }
             {
                 SCOPED_TIMER(_refine_intersect_row_timer);
-                RETURN_IF_ERROR(_hash_set->refine_intersect_row(state, chunk, _child_expr_lists[i], i));
+                RETURN_IF_ERROR(std::visit(
+                        [&](auto& hash_set) {
+                            return hash_set->refine_intersect_row(state, chunk, _child_expr_lists[i], i);
+                        },
+                        _hash_set));
             }
         }
 
         // if a table is empty, the result must be empty
-        if (_hash_set->hash_set->empty()) {
-            _hash_set_iterator = _hash_set->begin();
+        if (std::visit([](auto& hash_set) { return hash_set->empty(); }, _hash_set)) {
+            std::visit([](auto& hash_set) { hash_set->init_results(); }, _hash_set);
             return Status::OK();
         }
     }
 
-    _hash_set_iterator = _hash_set->begin();
+    std::visit([](auto& hash_set) { hash_set->init_results(); }, _hash_set);
     return Status::OK();
 }
 
@@ -158,15 +180,12 @@ Status IntersectNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
         return Status::OK();
     }
 
-    int32_t read_index = 0;
-    _hash_set->_results.resize(config::vector_chunk_size);
-    while (_hash_set_iterator != _hash_set->end() && read_index < config::vector_chunk_size) {
-        if (_hash_set_iterator->hit_times == _intersect_times) {
-            _hash_set->_results[read_index] = _hash_set_iterator->slice;
-            ++read_index;
-        }
-        ++_hash_set_iterator;
-    }
+    _results.resize(config::vector_chunk_size);
+    int32_t read_index = std::visit(
+            [&](auto& hash_set) {
+                return hash_set->fetch_results(&_results, config::vector_chunk_size, _intersect_times);
+            },
+            _hash_set);
 
     ChunkPtr result_chunk = std::make_shared<Chunk>();
     if (read_index > 0) {
@@ -179,7 +198,7 @@ Status IntersectNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
 
         {
             SCOPED_TIMER(_get_result_timer);
-            _hash_set->insert_keys_to_columns(_hash_set->_results, result_columns, read_index);
+            HashSerializeSet::insert_keys_to_columns(_results, result_columns, read_index);
         }
 
         for (size_t i = 0; i < result_columns.size(); i++) {
@@ -204,6 +223,44 @@ Status IntersectNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
     return Status::OK();
 }
 
+size_t IntersectNode::_get_fixed_size_of_keys() const {
+    size_t fixed_size = 0;
+    for (const auto& type : _types) {
+        // Each column is serialized with one byte of null flag before its data, even if it isn't nullable.
+        fixed_size += sizeof(bool);
+        switch (type.result_type.type) {
+        case TYPE_BOOLEAN:
+        case TYPE_TINYINT:
+            fixed_size += sizeof(int8_t);
+            break;
+        case TYPE_SMALLINT:
+            fixed_size += sizeof(int16_t);
+            break;
+        case TYPE_INT:
+        case TYPE_DECIMAL32:
+            fixed_size += sizeof(int32_t);
+            break;
+        case TYPE_BIGINT:
+        case TYPE_DECIMAL64:
+            fixed_size += sizeof(int64_t);
+            break;
+        case TYPE_LARGEINT:
+        case TYPE_DECIMAL128:
+            fixed_size += sizeof(int128_t);
+            break;
+        case TYPE_DATE:
+            fixed_size += sizeof(DateValue);
+            break;
+        case TYPE_DATETIME:
+            fixed_size += sizeof(TimestampValue);
+            break;
+        default:
+            return 0;
+        }
+    }
+    return fixed_size;
+}
+
 Status IntersectNode::close(RuntimeState* state) {
     if (is_closed()) {
         return Status::OK();
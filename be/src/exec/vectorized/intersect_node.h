@@ -3,6 +3,7 @@
 #pragma once
 
 #include <unordered_set>
+#include <variant>
 
 #include "column/chunk.h"
 #include "column/column_hash.h"
@@ -46,6 +47,34 @@ class IntersectNode : public ExecNode {
         }
     };
 
+    // The serialized row of the fixed size key columns packed into one integer, see FixedSizeHashSetFromExprs.
+    template <typename KeyType>
+    class FixedSizeFlag {
+    public:
+        explicit FixedSizeFlag(KeyType k) : key(k), hit_times(0) {}
+
+        KeyType key;
+        mutable uint16_t hit_times;
+    };
+
+    template <typename KeyType>
+    struct FixedSizeFlagEqual {
+        bool operator()(const FixedSizeFlag<KeyType>& x, const FixedSizeFlag<KeyType>& y) const {
+            return x.key == y.key;
+        }
+    };
+
+    template <typename KeyType>
+    struct FixedSizeFlagHash {
+        std::size_t operator()(const FixedSizeFlag<KeyType>& x) const {
+            if constexpr (sizeof(KeyType) == sizeof(uint128_t)) {
+                return UInt128HashWithSeed<PhmapSeed1>()(x.key);
+            } else {
+                return StdHash<KeyType>()(x.key);
+            }
+        }
+    };
+
     template <typename HashSet>
     struct HashSetFromExprs {
         using Iterator = typename HashSet::iterator;
@@ -62,6 +91,22 @@ class IntersectNode : public ExecNode {
 
         Iterator end() { return hash_set->end(); }
 
+        bool empty() const { return hash_set->empty(); }
+
+        void init_results() { _iterator = hash_set->begin(); }
+
+        // Fill |results| with at most |max_rows| keys hit |hit_times|, from the last one filled.
+        size_t fetch_results(ResultVector* results, size_t max_rows, size_t hit_times) {
+            size_t num_rows = 0;
+            while (_iterator != hash_set->end() && num_rows < max_rows) {
+                if (_iterator->hit_times == hit_times) {
+                    (*results)[num_rows++] = _iterator->slice;
+                }
+                ++_iterator;
+            }
+            return num_rows;
+        }
+
         void serialize_columns(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs, size_t chunk_size,
                                const std::function<void(const ColumnPtr&, int)>& get_type) {
             const bool null = false;
@@ -159,7 +204,7 @@ class IntersectNode : public ExecNode {
             return max_size;
         }
 
-        void insert_keys_to_columns(ResultVector& keys, const Columns& key_columns, int32_t batch_size) {
+        static void insert_keys_to_columns(ResultVector& keys, const Columns& key_columns, int32_t batch_size) {
             for (const auto& key_column : key_columns) {
                 if (!key_column->is_nullable()) {
                     for (auto& key : keys) {
@@ -178,7 +223,92 @@ class IntersectNode : public ExecNode {
         std::unique_ptr<MemTracker> _tracker;
         std::unique_ptr<MemPool> _mem_pool;
         uint8_t* _buffer;
-        ResultVector _results;
+        Iterator _iterator;
+    };
+
+    // If the key columns are of fixed size and their serialized row, a null flag and the value of each column as
+    // HashSetFromExprs::serialize_columns, fits in KeyType, the rows are serialized into the zeroed integer keys.
+    // So the equal rows are the equal integers, which are neither copied into the pool nor hashed as slices.
+    template <typename KeyType>
+    struct FixedSizeHashSetFromExprs {
+        using HashSet =
+                phmap::flat_hash_set<FixedSizeFlag<KeyType>, FixedSizeFlagHash<KeyType>, FixedSizeFlagEqual<KeyType>>;
+        using Iterator = typename HashSet::iterator;
+        using ResultVector = typename std::vector<Slice>;
+        HashSet hash_set;
+
+        bool empty() const { return hash_set.empty(); }
+
+        void init_results() { _iterator = hash_set.begin(); }
+
+        size_t fetch_results(ResultVector* results, size_t max_rows, size_t hit_times) {
+            size_t num_rows = 0;
+            while (_iterator != hash_set.end() && num_rows < max_rows) {
+                if (_iterator->hit_times == hit_times) {
+                    (*results)[num_rows++] = {reinterpret_cast<const char*>(&_iterator->key), sizeof(KeyType)};
+                }
+                ++_iterator;
+            }
+            return num_rows;
+        }
+
+        Status build_set(RuntimeState* state, const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs,
+                         MemPool* pool, const std::function<void(const ColumnPtr&, int)>& get_type) {
+            size_t chunk_size = chunkPtr->num_rows();
+            RETURN_IF_ERROR(pack_keys(chunkPtr, exprs, chunk_size, get_type));
+            for (size_t i = 0; i < chunk_size; ++i) {
+                hash_set.emplace(_packed_keys[i]);
+            }
+            RETURN_IF_LIMIT_EXCEEDED(state, "Intersect, while build hash table.");
+            return Status::OK();
+        }
+
+        Status refine_intersect_row(RuntimeState* state, const ChunkPtr& chunkPtr,
+                                    const std::vector<ExprContext*>& exprs, int hit_times) {
+            size_t chunk_size = chunkPtr->num_rows();
+            RETURN_IF_ERROR(pack_keys(chunkPtr, exprs, chunk_size, [](const ColumnPtr& column, int i) -> void {}));
+            for (size_t i = 0; i < chunk_size; ++i) {
+                auto iter = hash_set.find(FixedSizeFlag<KeyType>(_packed_keys[i]));
+                if (iter != hash_set.end() && iter->hit_times == hit_times - 1) {
+                    iter->hit_times = hit_times;
+                }
+            }
+            return Status::OK();
+        }
+
+        // The unused bytes of the keys are zero, so the equal rows are packed into the same integer.
+        Status pack_keys(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs, size_t chunk_size,
+                         const std::function<void(const ColumnPtr&, int)>& get_type) {
+            _packed_keys.assign(chunk_size, 0);
+            _slice_sizes.assign(chunk_size, 0);
+            auto* buffer = reinterpret_cast<uint8_t*>(_packed_keys.data());
+            const bool null = false;
+            size_t max_size = 0;
+            for (size_t i = 0; i < exprs.size(); i++) {
+                ColumnPtr key_column = exprs[i]->evaluate(chunkPtr.get());
+                get_type(key_column, i);
+                max_size += key_column->max_one_element_serialize_size() + (key_column->is_nullable() ? 0 : 1);
+                if (UNLIKELY(max_size > sizeof(KeyType))) {
+                    return Status::InternalError("Intersect, the key columns exceed the fixed size keys");
+                }
+                if (key_column->is_nullable()) {
+                    key_column->serialize_batch(buffer, _slice_sizes, chunk_size, sizeof(KeyType));
+                } else {
+                    size_t row_step = key_column->is_constant() ? 0 : 1;
+                    for (size_t j = 0; j < chunk_size; ++j) {
+                        memcpy(buffer + j * sizeof(KeyType) + _slice_sizes[j], &null, sizeof(bool));
+                        _slice_sizes[j] += sizeof(bool);
+                        _slice_sizes[j] +=
+                                key_column->serialize(j * row_step, buffer + j * sizeof(KeyType) + _slice_sizes[j]);
+                    }
+                }
+            }
+            return Status::OK();
+        }
+
+        Buffer<KeyType> _packed_keys;
+        Buffer<uint32_t> _slice_sizes;
+        Iterator _iterator;
     };
 
 public:
@@ -207,9 +337,16 @@ private:
     std::vector<IntersectColumnTypes> _types;
     size_t _intersect_times = 0;
 
+    // The packed size of the serialized rows if all the columns are of fixed size, otherwise 0.
+    size_t _get_fixed_size_of_keys() const;
+
     using HashSerializeSet = HashSetFromExprs<phmap::flat_hash_set<SliceFlag, SliceFlagHash, SliceFlagEqual>>;
-    std::unique_ptr<HashSerializeSet> _hash_set;
-    HashSerializeSet::Iterator _hash_set_iterator;
+    using HashSetVariant = std::variant<std::unique_ptr<HashSerializeSet>,
+                                        std::unique_ptr<FixedSizeHashSetFromExprs<uint32_t>>,
+                                        std::unique_ptr<FixedSizeHashSetFromExprs<uint64_t>>,
+                                        std::unique_ptr<FixedSizeHashSetFromExprs<uint128_t>>>;
+    HashSetVariant _hash_set;
+    HashSerializeSet::ResultVector _results;
 
     // pool for allocate key.
     std::unique_ptr<MemPool> _build_pool;
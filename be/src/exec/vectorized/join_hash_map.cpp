@@ -11,6 +11,47 @@
 
 namespace starrocks::vectorized {
 
+void JoinHashMapHelper::insert_partitioned_rows(JoinHashTableItems* table_items) {
+    const uint32_t row_count = table_items->row_count;
+    const uint32_t* buckets = table_items->build_buckets.data();
+    const uint32_t bucket_bits = table_items->bucket_size > 1 ? 32 - __builtin_clz(table_items->bucket_size - 1) : 0;
+    const uint32_t radix_bits = std::min(table_items->radix_bits, bucket_bits);
+    const uint32_t shift = bucket_bits - radix_bits;
+    const uint32_t num_partitions = 1U << radix_bits;
+
+    // The begin of each partition in the partitioned rows.
+    std::vector<uint32_t> offsets(num_partitions + 1, 0);
+    for (uint32_t row = 1; row < row_count + 1; row++) {
+        if (buckets[row] != kNullBucket) {
+            offsets[(buckets[row] >> shift) + 1]++;
+        }
+    }
+    for (uint32_t i = 0; i < num_partitions; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    // Scatter the rows and their buckets to their partitions, in the order of the rows.
+    Buffer<uint32_t> partitioned_rows(offsets[num_partitions]);
+    Buffer<uint32_t> partitioned_buckets(offsets[num_partitions]);
+    std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+    for (uint32_t row = 1; row < row_count + 1; row++) {
+        if (buckets[row] != kNullBucket) {
+            uint32_t& cursor = cursors[buckets[row] >> shift];
+            partitioned_rows[cursor] = row;
+            partitioned_buckets[cursor] = buckets[row];
+            cursor++;
+        }
+    }
+
+    uint32_t* first = table_items->first.data();
+    uint32_t* next = table_items->next.data();
+    for (size_t i = 0; i < partitioned_rows.size(); i++) {
+        next[partitioned_rows[i]] = first[partitioned_buckets[i]];
+        first[partitioned_buckets[i]] = partitioned_rows[i];
+    }
+    Buffer<uint32_t>().swap(table_items->build_buckets);
+}
+
 Status SerializedJoinBuildFunc::prepare(RuntimeState* state, JoinHashTableItems* table_items,
                                         HashTableProbeState* probe_state) {
     size_t serialize_mem_usage = sizeof(Slice) * (table_items->row_count + 1);
@@ -90,10 +131,7 @@ void SerializedJoinBuildFunc::_build_columns(JoinHashTableItems* table_items, Ha
         *ptr += table_items->build_slice[start + i].size;
     }
 
-    for (size_t i = 0; i < count; i++) {
-        table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-        table_items->first[probe_state->buckets[i]] = start + i;
-    }
+    JoinHashMapHelper::insert_rows(table_items, probe_state->buckets.data(), start, count);
 }
 
 void SerializedJoinBuildFunc::_build_nullable_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
@@ -117,12 +155,8 @@ void SerializedJoinBuildFunc::_build_nullable_columns(JoinHashTableItems* table_
         }
     }
 
-    for (size_t i = 0; i < count; i++) {
-        if (probe_state->is_nulls[i] == 0) {
-            table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-            table_items->first[probe_state->buckets[i]] = start + i;
-        }
-    }
+    JoinHashMapHelper::insert_rows(table_items, probe_state->buckets.data(), start, count,
+                                   probe_state->is_nulls.data());
 }
 
 Status SerializedJoinProbeFunc::lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state) {
@@ -149,7 +183,7 @@ Status SerializedJoinProbeFunc::lookup_init(const JoinHashTableItems& table_item
     for (const auto& data_column : data_columns) {
         serialize_size += data_column->serialize_size();
     }
-    uint8_t* ptr = table_items.probe_pool->allocate(serialize_size);
+    uint8_t* ptr = probe_state->probe_pool->allocate(serialize_size);
     if (UNLIKELY(ptr == nullptr)) {
         return Status::InternalError("Mem usage has exceed the limit of BE");
     }
@@ -174,9 +208,7 @@ void SerializedJoinProbeFunc::_probe_column(const JoinHashTableItems& table_item
         ptr += probe_state->probe_slice[i].size;
     }
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, row_count);
 }
 
 void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& table_items,
@@ -204,64 +236,81 @@ void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& t
         if (probe_state->is_nulls[i] == 0) {
             probe_state->buckets[i] =
                     JoinHashMapHelper::calc_bucket_num<Slice>(probe_state->probe_slice[i], table_items.bucket_size);
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
         } else {
-            probe_state->next[i] = 0;
+            probe_state->buckets[i] = 0;
         }
     }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, row_count, probe_state->is_nulls.data());
 }
 
 JoinHashTable::~JoinHashTable() {
-    _table_items.mem_tracker->release(_table_items.last_memory_usage);
+    if (_table_items != nullptr && _is_table_owner) {
+        _table_items->mem_tracker->release(_table_items->last_memory_usage);
+    }
 }
 
 void JoinHashTable::close() {
-    _table_items.build_pool.reset();
-    _table_items.probe_pool.reset();
+    if (_table_items != nullptr && _is_table_owner) {
+        _table_items->build_pool.reset();
+        _table_items->mem_tracker->release(_table_items->last_memory_usage);
+        _table_items->last_memory_usage = 0;
+    }
+    _probe_state.probe_pool.reset();
 }
 
 void JoinHashTable::create(const HashTableParam& param) {
-    _table_items.row_count = 0;
-    _table_items.bucket_size = 0;
-    _table_items.build_chunk = std::make_shared<Chunk>();
-    _table_items.mem_tracker = param.mem_tracker;
-    _table_items.build_pool = std::make_unique<MemPool>(_table_items.mem_tracker);
-    _table_items.probe_pool = std::make_unique<MemPool>(_table_items.mem_tracker);
-    _table_items.with_other_conjunct = param.with_other_conjunct;
-    _table_items.join_type = param.join_type;
-    _table_items.row_desc = param.row_desc;
-    if (_table_items.join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items.join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-        _table_items.join_type == TJoinOp::RIGHT_OUTER_JOIN) {
-        _table_items.left_to_nullable = true;
-    } else if (_table_items.join_type == TJoinOp::LEFT_SEMI_JOIN || _table_items.join_type == TJoinOp::LEFT_ANTI_JOIN ||
-               _table_items.join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
-               _table_items.join_type == TJoinOp::LEFT_OUTER_JOIN) {
-        _table_items.right_to_nullable = true;
-    } else if (_table_items.join_type == TJoinOp::FULL_OUTER_JOIN) {
-        _table_items.left_to_nullable = true;
-        _table_items.right_to_nullable = true;
-    }
-    _table_items.search_ht_timer = param.search_ht_timer;
-    _table_items.output_build_column_timer = param.output_build_column_timer;
-    _table_items.output_probe_column_timer = param.output_probe_column_timer;
-    _table_items.output_tuple_column_timer = param.output_tuple_column_timer;
-    _table_items.join_keys = param.join_keys;
+    // The table could be created again after close(), e.g. for each partition of a spilled hash join.
+    _probe_state = HashTableProbeState();
+    _table_items = std::make_shared<JoinHashTableItems>();
+    _is_table_owner = true;
+    _table_items->row_count = 0;
+    _table_items->bucket_size = 0;
+    _table_items->build_chunk = std::make_shared<Chunk>();
+    _table_items->mem_tracker = param.mem_tracker;
+    _table_items->build_pool = std::make_unique<MemPool>(_table_items->mem_tracker);
+    _probe_state.probe_pool = std::make_unique<MemPool>(_table_items->mem_tracker);
+    _table_items->with_other_conjunct = param.with_other_conjunct;
+    _table_items->join_type = param.join_type;
+    _table_items->row_desc = param.row_desc;
+    if (_table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+        _table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN) {
+        _table_items->left_to_nullable = true;
+    } else if (_table_items->join_type == TJoinOp::LEFT_SEMI_JOIN ||
+               _table_items->join_type == TJoinOp::LEFT_ANTI_JOIN ||
+               _table_items->join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
+               _table_items->join_type == TJoinOp::LEFT_OUTER_JOIN) {
+        _table_items->right_to_nullable = true;
+    } else if (_table_items->join_type == TJoinOp::FULL_OUTER_JOIN) {
+        _table_items->left_to_nullable = true;
+        _table_items->right_to_nullable = true;
+    }
+    _table_items->search_ht_timer = param.search_ht_timer;
+    _table_items->output_build_column_timer = param.output_build_column_timer;
+    _table_items->output_probe_column_timer = param.output_probe_column_timer;
+    _table_items->output_tuple_column_timer = param.output_tuple_column_timer;
+    _table_items->join_keys = param.join_keys;
 
     const auto& probe_desc = *param.probe_row_desc;
     for (const auto& tuple_desc : probe_desc.tuple_descriptors()) {
         for (const auto& slot : tuple_desc->slots()) {
-            _table_items.probe_slots.emplace_back(slot);
-            _table_items.probe_column_count++;
+            _table_items->probe_slots.emplace_back(slot);
+            _table_items->probe_column_count++;
         }
-        if (_table_items.row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
-            _table_items.output_probe_tuple_ids.emplace_back(tuple_desc->id());
+        if (_table_items->row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _table_items->output_probe_tuple_ids.emplace_back(tuple_desc->id());
         }
     }
 
+    // The build rows follow the default row 0 of the build chunk.
+    const size_t reserved_rows = std::min<size_t>(param.estimated_build_rows, config::hash_table_max_presize_rows) + 1;
     const auto& build_desc = *param.build_row_desc;
     for (const auto& tuple_desc : build_desc.tuple_descriptors()) {
         for (const auto& slot : tuple_desc->slots()) {
-            _table_items.build_slots.emplace_back(slot);
+            bool is_late = std::find(param.late_build_slots.begin(), param.late_build_slots.end(), slot->id()) !=
+                           param.late_build_slots.end();
+            _table_items->is_late_build_column.emplace_back(is_late);
+            _table_items->has_late_build_columns |= is_late;
+            _table_items->build_slots.emplace_back(slot);
             ColumnPtr column = ColumnHelper::create_column(slot->type(), slot->is_nullable());
             if (slot->is_nullable()) {
                 auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
@@ -269,23 +318,34 @@ void JoinHashTable::create(const HashTableParam& param) {
             } else {
                 column->append_default();
             }
-            _table_items.build_chunk->append_column(std::move(column), slot->id());
-            _table_items.build_column_count++;
+            if (reserved_rows > 1) {
+                column->reserve(reserved_rows);
+            }
+            _table_items->build_chunk->append_column(std::move(column), slot->id());
+            _table_items->build_column_count++;
         }
-        if (_table_items.row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
-            _table_items.output_build_tuple_ids.emplace_back(tuple_desc->id());
+        if (_table_items->row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _table_items->output_build_tuple_ids.emplace_back(tuple_desc->id());
         }
     }
 }
 
 Status JoinHashTable::build(RuntimeState* state) {
     _hash_map_type = _choose_join_hash_map();
-    _table_items.bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items.row_count + 1);
-    _table_items.first.resize(_table_items.bucket_size, 0);
-    _table_items.next.resize(_table_items.row_count + 1, 0);
-    if (_table_items.join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items.join_type == TJoinOp::FULL_OUTER_JOIN ||
-        _table_items.join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items.join_type == TJoinOp::RIGHT_ANTI_JOIN) {
-        _probe_state.build_match_index.resize(_table_items.row_count + 1, 0);
+    if (_hash_map_type == JoinHashMapType::direct_mapping32 || _hash_map_type == JoinHashMapType::direct_mapping64) {
+        _table_items->bucket_size = _table_items->direct_mapping_max - _table_items->direct_mapping_min + 1;
+    } else {
+        _table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items->row_count + 1);
+    }
+    _table_items->first.resize(_table_items->bucket_size, 0);
+    _table_items->next.resize(_table_items->row_count + 1, 0);
+    _table_items->radix_bits = JoinHashMapHelper::calc_radix_bits(_table_items->bucket_size);
+    if (_table_items->radix_bits > 0) {
+        _table_items->build_buckets.resize(_table_items->row_count + 1, JoinHashMapHelper::kNullBucket);
+    }
+    if (_table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items->join_type == TJoinOp::FULL_OUTER_JOIN ||
+        _table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN) {
+        _probe_state.build_match_index.resize(_table_items->row_count + 1, 0);
         _probe_state.build_match_index[0] = 1;
     }
 
@@ -293,15 +353,15 @@ Status JoinHashTable::build(RuntimeState* state) {
 
     // size of hashtable index
     RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(
-            state, &_table_items, (_table_items.first.size() + _table_items.row_count + 1) * sizeof(uint32_t)));
+            state, _table_items.get(), (_table_items->first.size() + _table_items->row_count + 1) * sizeof(uint32_t)));
 
     switch (_hash_map_type) {
     case JoinHashMapType::empty:
         break;
-#define M(NAME)                                                                                             \
-    case JoinHashMapType::NAME:                                                                             \
-        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(&_table_items, &_probe_state); \
-        RETURN_IF_ERROR(_##NAME->build(state));                                                             \
+#define M(NAME)                                                                                                  \
+    case JoinHashMapType::NAME:                                                                                  \
+        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(_table_items.get(), &_probe_state); \
+        RETURN_IF_ERROR(_##NAME->build(state));                                                                  \
         break;
         APPLY_FOR_JOIN_VARIANTS(M)
 #undef M
@@ -312,6 +372,65 @@ Status JoinHashTable::build(RuntimeState* state) {
     return Status::OK();
 }
 
+void JoinHashTable::append_output_build_index(UInt32Column* build_index) const {
+    const uint32_t* data = _probe_state.build_index.data();
+    build_index->get_data().insert(build_index->get_data().end(), data, data + _probe_state.count);
+}
+
+void JoinHashTable::materialize_late_build_columns(const Buffer<uint32_t>& build_index, ChunkPtr* chunk) const {
+    SCOPED_TIMER(_table_items->output_build_column_timer);
+    size_t num_rows = build_index.size();
+    bool has_null_build_row = std::find(build_index.begin(), build_index.end(), 0) != build_index.end();
+    for (size_t i = 0; i < _table_items->build_column_count; i++) {
+        if (!_table_items->is_late_build_column[i]) {
+            continue;
+        }
+        SlotDescriptor* slot = _table_items->build_slots[i];
+        const ColumnPtr& src_column = _table_items->build_chunk->columns()[i];
+        bool to_nullable = _table_items->right_to_nullable || src_column->is_nullable();
+        ColumnPtr dest_column = ColumnHelper::create_column(slot->type(), to_nullable);
+        dest_column->append_selective(*src_column, build_index.data(), 0, num_rows);
+        if (to_nullable && has_null_build_row) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(dest_column);
+            for (size_t j = 0; j < num_rows; j++) {
+                if (build_index[j] == 0) {
+                    nullable_column->set_null(j);
+                }
+            }
+        }
+        (*chunk)->append_column(std::move(dest_column), slot->id());
+    }
+}
+
+void JoinHashTable::share_readable_table(const JoinHashTable& table) {
+    DCHECK(table._table_items != nullptr);
+    _table_items = table._table_items;
+    _is_table_owner = false;
+    _hash_map_type = table._hash_map_type;
+    _probe_state.probe_pool = std::make_unique<MemPool>(_table_items->mem_tracker);
+    _probe_state.is_nulls.resize(config::vector_chunk_size);
+    if (_table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items->join_type == TJoinOp::FULL_OUTER_JOIN ||
+        _table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN) {
+        _probe_state.build_match_index.resize(_table_items->row_count + 1, 0);
+        _probe_state.build_match_index[0] = 1;
+    }
+
+    JoinHashMapHelper::prepare_map_index(&_probe_state);
+
+    switch (_hash_map_type) {
+    case JoinHashMapType::empty:
+        break;
+#define M(NAME)                                                                                                  \
+    case JoinHashMapType::NAME:                                                                                  \
+        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(_table_items.get(), &_probe_state); \
+        break;
+        APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    default:
+        break;
+    }
+}
+
 Status JoinHashTable::probe(const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk, bool* eos) {
     switch (_hash_map_type) {
     case JoinHashMapType::empty:
@@ -345,11 +464,11 @@ Status JoinHashTable::probe_remain(ChunkPtr* chunk, bool* eos) {
 }
 
 Status JoinHashTable::append_chunk(RuntimeState* state, const ChunkPtr& chunk) {
-    Columns& columns = _table_items.build_chunk->columns();
+    Columns& columns = _table_items->build_chunk->columns();
     size_t chunk_memory_size = 0;
 
-    for (size_t i = 0; i < _table_items.build_column_count; i++) {
-        SlotDescriptor* slot = _table_items.build_slots[i];
+    for (size_t i = 0; i < _table_items->build_column_count; i++) {
+        SlotDescriptor* slot = _table_items->build_slots[i];
         ColumnPtr& column = chunk->get_column_by_slot_id(slot->id());
         chunk_memory_size += column->memory_usage();
 
@@ -366,30 +485,30 @@ Status JoinHashTable::append_chunk(RuntimeState* state, const ChunkPtr& chunk) {
 
     const auto& tuple_id_map = chunk->get_tuple_id_to_index_map();
     for (auto iter = tuple_id_map.begin(); iter != tuple_id_map.end(); iter++) {
-        if (_table_items.row_desc->get_tuple_idx(iter->first) != RowDescriptor::INVALID_IDX) {
-            if (_table_items.build_chunk->is_tuple_exist(iter->first)) {
+        if (_table_items->row_desc->get_tuple_idx(iter->first) != RowDescriptor::INVALID_IDX) {
+            if (_table_items->build_chunk->is_tuple_exist(iter->first)) {
                 ColumnPtr& src_column = chunk->get_tuple_column_by_id(iter->first);
-                ColumnPtr& dest_column = _table_items.build_chunk->get_tuple_column_by_id(iter->first);
+                ColumnPtr& dest_column = _table_items->build_chunk->get_tuple_column_by_id(iter->first);
                 dest_column->append(*src_column, 0, src_column->size());
                 chunk_memory_size += src_column->memory_usage();
             } else {
                 ColumnPtr& src_column = chunk->get_tuple_column_by_id(iter->first);
-                ColumnPtr dest_column = BooleanColumn::create(_table_items.row_count + 1, 1);
+                ColumnPtr dest_column = BooleanColumn::create(_table_items->row_count + 1, 1);
                 dest_column->append(*src_column, 0, src_column->size());
-                _table_items.build_chunk->append_tuple_column(dest_column, iter->first);
+                _table_items->build_chunk->append_tuple_column(dest_column, iter->first);
                 chunk_memory_size += src_column->memory_usage();
             }
         }
     }
 
-    RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(state, &_table_items, chunk_memory_size));
+    RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(state, _table_items.get(), chunk_memory_size));
 
-    _table_items.row_count += chunk->num_rows();
+    _table_items->row_count += chunk->num_rows();
     return Status::OK();
 }
 
 void JoinHashTable::remove_duplicate_index(Column::Filter* filter) {
-    switch (_table_items.join_type) {
+    switch (_table_items->join_type) {
     case TJoinOp::LEFT_OUTER_JOIN:
         _remove_duplicate_index_for_left_outer_join(filter);
         break;
@@ -417,18 +536,57 @@ void JoinHashTable::remove_duplicate_index(Column::Filter* filter) {
     }
 }
 
+template <PrimitiveType PT>
+bool JoinHashTable::_can_use_direct_mapping() {
+    using ColumnType = typename RunTimeTypeTraits<PT>::ColumnType;
+
+    if (!config::enable_join_hash_table_direct_mapping || _table_items->row_count == 0) {
+        return false;
+    }
+
+    const Column* key_column = _table_items->key_columns[0].get();
+    const Buffer<uint8_t>* null_array = nullptr;
+    if (key_column->is_nullable()) {
+        const auto* nullable_column = down_cast<const NullableColumn*>(key_column);
+        null_array = &nullable_column->null_column()->get_data();
+        key_column = nullable_column->data_column().get();
+    }
+    const auto& data = down_cast<const ColumnType*>(key_column)->get_data();
+
+    // The row 0 is reserved, it's not a build row.
+    int64_t min_value = std::numeric_limits<int64_t>::max();
+    int64_t max_value = std::numeric_limits<int64_t>::min();
+    for (size_t i = 1; i < _table_items->row_count + 1; i++) {
+        if (null_array == nullptr || (*null_array)[i] == 0) {
+            min_value = std::min<int64_t>(min_value, data[i]);
+            max_value = std::max<int64_t>(max_value, data[i]);
+        }
+    }
+    if (min_value > max_value) {
+        return false;
+    }
+
+    uint64_t range = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+    if (range >= JoinHashMapHelper::calc_bucket_size(_table_items->row_count + 1)) {
+        return false;
+    }
+    _table_items->direct_mapping_min = min_value;
+    _table_items->direct_mapping_max = max_value;
+    return true;
+}
+
 JoinHashMapType JoinHashTable::_choose_join_hash_map() {
-    size_t size = _table_items.join_keys.size();
+    size_t size = _table_items->join_keys.size();
     DCHECK_GT(size, 0);
 
-    for (size_t i = 0; i < _table_items.join_keys.size(); i++) {
-        if (!_table_items.key_columns[i]->has_null()) {
-            _table_items.join_keys[i].is_null_safe_equal = false;
+    for (size_t i = 0; i < _table_items->join_keys.size(); i++) {
+        if (!_table_items->key_columns[i]->has_null()) {
+            _table_items->join_keys[i].is_null_safe_equal = false;
         }
     }
 
-    if (size == 1 && !_table_items.join_keys[0].is_null_safe_equal) {
-        switch (_table_items.join_keys[0].type) {
+    if (size == 1 && !_table_items->join_keys[0].is_null_safe_equal) {
+        switch (_table_items->join_keys[0].type) {
         case PrimitiveType::TYPE_BOOLEAN:
             return JoinHashMapType::keyboolean;
         case PrimitiveType::TYPE_TINYINT:
@@ -436,9 +594,9 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
         case PrimitiveType::TYPE_SMALLINT:
             return JoinHashMapType::key16;
         case PrimitiveType::TYPE_INT:
-            return JoinHashMapType::key32;
+            return _can_use_direct_mapping<TYPE_INT>() ? JoinHashMapType::direct_mapping32 : JoinHashMapType::key32;
         case PrimitiveType::TYPE_BIGINT:
-            return JoinHashMapType::key64;
+            return _can_use_direct_mapping<TYPE_BIGINT>() ? JoinHashMapType::direct_mapping64 : JoinHashMapType::key64;
         case PrimitiveType::TYPE_LARGEINT:
             return JoinHashMapType::key128;
         case PrimitiveType::TYPE_FLOAT:
@@ -469,7 +627,7 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
 
     size_t total_size_in_byte = 0;
 
-    for (auto& join_key : _table_items.join_keys) {
+    for (auto& join_key : _table_items->join_keys) {
         if (join_key.is_null_safe_equal) {
             total_size_in_byte += 1;
         }
@@ -33,7 +33,9 @@ namespace starrocks::vectorized {
     M(slice)                       \
     M(fixed32)                     \
     M(fixed64)                     \
-    M(fixed128)
+    M(fixed128)                    \
+    M(direct_mapping32)            \
+    M(direct_mapping64)
 
 enum class JoinHashMapType {
     empty,
@@ -55,7 +57,10 @@ enum class JoinHashMapType {
     slice,
     fixed32, // 4 bytes
     fixed64, // 8 bytes
-    fixed128 // 16 bytes
+    fixed128, // 16 bytes
+    // The int key of a dense small range indexes the buckets directly.
+    direct_mapping32,
+    direct_mapping64
 };
 
 enum class JoinMatchFlag { NORMAL, ALL_NOT_MATCH, ALL_MATCH_ONE, MOST_MATCH_ONE };
@@ -83,13 +88,31 @@ struct JoinHashTableItems {
     // about the bucket-chained hash table of this kind.
     Buffer<uint32_t> first;
     Buffer<uint32_t> next;
+    // The heavy buckets are the buckets of many rows, e.g. of a key dominating the build side, their chains are
+    // grouped by the keys. "key_next" is "next" but the first row of a key in a heavy bucket is followed by the
+    // first row of the next key, so a probe row of another key skips the rows of the key at once. It's empty if
+    // there is no heavy bucket.
+    Buffer<uint32_t> key_next;
+    uint32_t heavy_bucket_count = 0;
+    // If not 0, the build rows are inserted into the buckets partition by partition, the partition of a row is
+    // the high |radix_bits| bits of its bucket, see JoinHashMapHelper::insert_rows(). "build_buckets" holds the
+    // buckets of the rows till they are inserted.
+    uint32_t radix_bits = 0;
+    Buffer<uint32_t> build_buckets;
     Buffer<Slice> build_slice;
     ColumnPtr build_key_column;
     uint32_t bucket_size = 0;
     uint32_t row_count = 0; // real row count
+    // The min and max build keys of a direct mapping table, the key k is in the bucket k - direct_mapping_min.
+    int64_t direct_mapping_min = 0;
+    int64_t direct_mapping_max = 0;
     size_t build_column_count = 0;
     size_t probe_column_count = 0;
     bool with_other_conjunct = false;
+    // The build columns which aren't referenced by the conjuncts evaluated on the joined chunk, they aren't
+    // output by the probe but materialized after the conjuncts by materialize_late_build_columns().
+    std::vector<bool> is_late_build_column;
+    bool has_late_build_columns = false;
     bool left_to_nullable = false;
     bool right_to_nullable = false;
 
@@ -97,14 +120,19 @@ struct JoinHashTableItems {
 
     MemTracker* mem_tracker = nullptr;
     std::unique_ptr<MemPool> build_pool = nullptr;
-    std::unique_ptr<MemPool> probe_pool = nullptr;
     uint64_t last_memory_usage = 0;
     std::vector<JoinKeyDesc> join_keys;
+    // The estimated rows of the build side, the build columns are reserved for them so they aren't reallocated
+    // as the build chunks are appended, or 0 if unknown. The buckets are sized by the rows appended anyway.
+    size_t estimated_build_rows = 0;
 
     RuntimeProfile::Counter* search_ht_timer = nullptr;
     RuntimeProfile::Counter* output_build_column_timer = nullptr;
     RuntimeProfile::Counter* output_probe_column_timer = nullptr;
     RuntimeProfile::Counter* output_tuple_column_timer = nullptr;
+
+    // The row to follow a build row in the bucket chain when the probe key doesn't equal its key.
+    const uint32_t* mismatch_next() const { return key_next.empty() ? next.data() : key_next.data(); }
 };
 
 struct HashTableProbeState {
@@ -116,6 +144,8 @@ struct HashTableProbeState {
     Buffer<uint32_t> next;
     Buffer<Slice> probe_slice;
     Buffer<uint8_t>* null_array = nullptr;
+    // Per-prober buffer of serialized probe keys, so several probers can share one JoinHashTableItems.
+    std::unique_ptr<MemPool> probe_pool = nullptr;
     ColumnPtr probe_key_column;
     const Columns* key_columns = nullptr;
     std::vector<JoinKeyDesc> join_keys;
@@ -143,10 +173,16 @@ struct HashTableProbeState {
     // cur_probe_index records the position of the last probe
     uint32_t cur_probe_index = 0;
     uint32_t cur_row_match_count = 0;
+
+    // The number of rows to look ahead when probing, it's config::join_hash_table_prefetch_distance
+    // when the probe chunk is set.
+    uint32_t prefetch_distance = 0;
 };
 
 struct HashTableParam {
     bool with_other_conjunct = false;
+    // The build slots to be materialized after the conjuncts on the joined chunk, see JoinHashTableItems.
+    std::vector<SlotId> late_build_slots;
     TJoinOp::type join_type = TJoinOp::INNER_JOIN;
     const RowDescriptor* row_desc = nullptr;
     MemTracker* mem_tracker = nullptr;
@@ -222,6 +258,85 @@ public:
         }
     }
 
+    static constexpr uint32_t kMaxRadixBits = 10;
+    static constexpr uint32_t kNullBucket = UINT32_MAX;
+    // The build rows sampled to find the heavy buckets, and the max keys of a heavy bucket to be grouped.
+    static constexpr uint32_t kHeavyBucketSampleRows = 65536;
+    static constexpr size_t kMaxHeavyBucketKeys = 16;
+
+    // The radix bits of the partitions of the build rows, so the bucket heads of a partition fit in
+    // config::join_hash_table_radix_partition_bytes, or 0 if all of them fit. The partitions are at most
+    // 2^kMaxRadixBits, so the rows are partitioned by one pass over them.
+    static uint32_t calc_radix_bits(uint32_t bucket_size) {
+        const int64_t partition_bytes = config::join_hash_table_radix_partition_bytes;
+        const int64_t bucket_bytes = static_cast<int64_t>(bucket_size) * static_cast<int64_t>(sizeof(uint32_t));
+        uint32_t radix_bits = 0;
+        while (partition_bytes > 0 && radix_bits < kMaxRadixBits && (bucket_bytes >> radix_bits) > partition_bytes) {
+            radix_bits++;
+        }
+        return radix_bits;
+    }
+
+    // Insert the build rows [start, start + count) of the buckets |buckets| into the heads of the bucket chains,
+    // the rows whose |is_nulls| are set aren't inserted. If the rows are radix partitioned, their buckets are
+    // saved and the rows are inserted by insert_partitioned_rows() after all the rows.
+    static void insert_rows(JoinHashTableItems* table_items, const uint32_t* buckets, uint32_t start, uint32_t count,
+                            const uint8_t* is_nulls = nullptr) {
+        if (table_items->radix_bits > 0) {
+            uint32_t* build_buckets = table_items->build_buckets.data() + start;
+            for (uint32_t i = 0; i < count; i++) {
+                build_buckets[i] = (is_nulls == nullptr || is_nulls[i] == 0) ? buckets[i] : kNullBucket;
+            }
+            return;
+        }
+        uint32_t* first = table_items->first.data();
+        uint32_t* next = table_items->next.data();
+        for (uint32_t i = 0; i < count; i++) {
+            if (is_nulls == nullptr || is_nulls[i] == 0) {
+                next[start + i] = first[buckets[i]];
+                first[buckets[i]] = start + i;
+            }
+        }
+    }
+
+    // Insert the rows saved by insert_rows() partition by partition. The rows of a partition keep their order, so
+    // the bucket chains are the same as the ones of the rows inserted in order. The partitions own disjoint
+    // ranges of "first" and disjoint rows of "next", so they could be inserted independently.
+    static void insert_partitioned_rows(JoinHashTableItems* table_items);
+
+    // Find the heavy buckets, whose chains have config::join_hash_table_heavy_bucket_rows rows at least, by the
+    // buckets of the sampled build rows, and group their chains by the keys |build_data|, see
+    // JoinHashTableItems::key_next. The buckets of more than kMaxHeavyBucketKeys keys are left as they are.
+    template <typename CppType>
+    static void group_heavy_buckets(JoinHashTableItems* table_items, const Buffer<CppType>& build_data);
+
+    // Set probe_state->next[i] to the head of the bucket chain of the i-th probe row, or 0 if is_nulls[i] is set.
+    // The bucket heads are random accesses to the large first[] of the build side, so the one which is
+    // prefetch_distance rows ahead is prefetched, to overlap the cache misses of the rows.
+    static void lookup_bucket_heads(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
+                                    uint32_t row_count, const uint8_t* is_nulls = nullptr) {
+        const uint32_t* buckets = probe_state->buckets.data();
+        const uint32_t* first = table_items.first.data();
+        uint32_t* next = probe_state->next.data();
+        const uint32_t distance = probe_state->prefetch_distance;
+
+        if (distance > 0) {
+            for (uint32_t i = 0; i < std::min(distance, row_count); i++) {
+                __builtin_prefetch(first + buckets[i]);
+            }
+        }
+        for (uint32_t i = 0; i < row_count; i++) {
+            if (distance > 0 && i + distance < row_count) {
+                __builtin_prefetch(first + buckets[i + distance]);
+            }
+            if (is_nulls == nullptr || is_nulls[i] == 0) {
+                next[i] = first[buckets[i]];
+            } else {
+                next[i] = 0;
+            }
+        }
+    }
+
     static void prepare_map_index(HashTableProbeState* probe_state) {
         probe_state->build_index.resize(config::vector_chunk_size + 8);
         probe_state->probe_index.resize(config::vector_chunk_size + 8);
@@ -280,6 +395,16 @@ public:
     static Status construct_hash_table(JoinHashTableItems* table_items, HashTableProbeState* probe_state);
 };
 
+// DirectMappingJoinBuildFunc puts the rows into the buckets indexed by their keys minus the min key,
+// so there is no hashing, and all the rows in a bucket chain have the same key.
+template <PrimitiveType PT>
+class DirectMappingJoinBuildFunc : public JoinBuildFunc<PT> {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+
+    static Status construct_hash_table(JoinHashTableItems* table_items, HashTableProbeState* probe_state);
+};
+
 template <PrimitiveType PT>
 class FixedSizeJoinBuildFunc {
 public:
@@ -330,6 +455,19 @@ public:
     static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state);
 };
 
+template <PrimitiveType PT>
+class DirectMappingJoinProbeFunc : public JoinProbeFunc<PT> {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+
+    static void prepare(JoinHashTableItems* table_items, HashTableProbeState* probe_state) {
+        probe_state->is_nulls.resize(config::vector_chunk_size);
+    }
+
+    // The probe keys out of the range of the build keys don't match any row.
+    static Status lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
+};
+
 template <PrimitiveType PT>
 class FixedSizeJoinProbeFunc {
 public:
@@ -361,7 +499,7 @@ public:
     static const Buffer<Slice>& get_key_data(const HashTableProbeState& probe_state) { return probe_state.probe_slice; }
 
     static void prepare(JoinHashTableItems* table_items, HashTableProbeState* probe_state) {
-        table_items->probe_pool->clear();
+        probe_state->probe_pool->clear();
         probe_state->probe_slice.resize(probe_state->probe_row_count);
         probe_state->is_nulls.resize(config::vector_chunk_size);
     }
@@ -484,6 +622,7 @@ private:
 #define JoinHashMapForOneKey(PT) JoinHashMap<PT, JoinBuildFunc<PT>, JoinProbeFunc<PT>>
 #define JoinHashMapForFixedSizeKey(PT) JoinHashMap<PT, FixedSizeJoinBuildFunc<PT>, FixedSizeJoinProbeFunc<PT>>
 #define JoinHashMapForSerializedKey(PT) JoinHashMap<PT, SerializedJoinBuildFunc, SerializedJoinProbeFunc>
+#define JoinHashMapForDirectMapping(PT) JoinHashMap<PT, DirectMappingJoinBuildFunc<PT>, DirectMappingJoinProbeFunc<PT>>
 
 class JoinHashTable {
 public:
@@ -493,22 +632,43 @@ public:
     void close();
 
     Status build(RuntimeState* state);
+    // Make this table a prober of the already built |table|: the build side is shared read-only,
+    // while the probe state is private, so several probers can run concurrently against one build.
+    // Must be called after |table| has been built, and instead of create() and build().
+    void share_readable_table(const JoinHashTable& table);
     Status probe(const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk, bool* eos);
     Status probe_remain(ChunkPtr* chunk, bool* eos);
 
     Status append_chunk(RuntimeState* state, const ChunkPtr& chunk);
 
-    const ChunkPtr& get_build_chunk() const { return _table_items.build_chunk; }
-    Columns& get_key_columns() { return _table_items.key_columns; }
-    uint32_t get_row_count() const { return _table_items.row_count; }
-    size_t get_probe_column_count() const { return _table_items.probe_column_count; }
-    size_t get_build_column_count() const { return _table_items.build_column_count; }
-    size_t get_bucket_size() const { return _table_items.bucket_size; }
+    const ChunkPtr& get_build_chunk() const { return _table_items->build_chunk; }
+    Columns& get_key_columns() { return _table_items->key_columns; }
+    const Columns& get_key_columns() const { return _table_items->key_columns; }
+    uint32_t get_row_count() const { return _table_items->row_count; }
+    size_t get_probe_column_count() const { return _table_items->probe_column_count; }
+    size_t get_build_column_count() const { return _table_items->build_column_count; }
+    size_t get_bucket_size() const { return _table_items->bucket_size; }
+    uint32_t get_heavy_bucket_count() const { return _table_items->heavy_bucket_count; }
+    // The memory consumed by the build side of this table.
+    size_t mem_usage() const { return _table_items->last_memory_usage; }
 
     void remove_duplicate_index(Column::Filter* filter);
 
+    // Whether some build columns are materialized late, then the chunks output by probe() lack them, and
+    // the caller has to keep the build rows of the output rows through its filters to materialize them.
+    bool has_late_build_columns() const { return _table_items->has_late_build_columns; }
+    // Append the build rows of the rows output by the last probe() to |build_index|.
+    void append_output_build_index(UInt32Column* build_index) const;
+    // Append the late build columns of the build rows |build_index| to |chunk|. The row 0 of the build chunk
+    // means that there is no matched build row, and its columns are null.
+    void materialize_late_build_columns(const Buffer<uint32_t>& build_index, ChunkPtr* chunk) const;
+
 private:
     JoinHashMapType _choose_join_hash_map();
+    // Whether the range of the build keys is small enough to index the buckets directly, it's not larger
+    // than the buckets of a hash table of the rows. If so, the min and max key are saved in the table items.
+    template <PrimitiveType PT>
+    bool _can_use_direct_mapping();
     static size_t _get_size_of_fixed_and_contiguous_type(PrimitiveType data_type);
 
     void _remove_duplicate_index_for_left_outer_join(Column::Filter* filter);
@@ -538,10 +698,14 @@ private:
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_INT)> _fixed32 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_BIGINT)> _fixed64 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_LARGEINT)> _fixed128 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMapping(TYPE_INT)> _direct_mapping32 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMapping(TYPE_BIGINT)> _direct_mapping64 = nullptr;
 
     JoinHashMapType _hash_map_type = JoinHashMapType::empty;
 
-    JoinHashTableItems _table_items;
+    std::shared_ptr<JoinHashTableItems> _table_items;
+    // Only the table that built the items accounts their memory and releases the build pool.
+    bool _is_table_owner = false;
     HashTableProbeState _probe_state;
 };
 } // namespace starrocks::vectorized
@@ -3,6 +3,70 @@
 #include "simd/simd.h"
 
 namespace starrocks::vectorized {
+template <typename CppType>
+void JoinHashMapHelper::group_heavy_buckets(JoinHashTableItems* table_items, const Buffer<CppType>& build_data) {
+    const int64_t min_rows = config::join_hash_table_heavy_bucket_rows;
+    const uint32_t row_count = table_items->row_count;
+    if (min_rows <= 0 || row_count < min_rows) {
+        return;
+    }
+
+    // The sampled rows of a bucket estimate the rows of its chain. The rows of the null keys aren't in the chains,
+    // so the rows of a chain are counted when it's grouped.
+    const uint32_t stride = std::max<uint32_t>(1, row_count / kHeavyBucketSampleRows);
+    phmap::flat_hash_map<uint32_t, uint32_t> sampled_rows;
+    for (uint32_t row = 1; row < row_count + 1; row += stride) {
+        sampled_rows[calc_bucket_num<CppType>(build_data[row], table_items->bucket_size)]++;
+    }
+
+    uint32_t* first = table_items->first.data();
+    uint32_t* next = table_items->next.data();
+    std::vector<std::vector<uint32_t>> key_rows;
+    for (const auto& [bucket, num_sampled_rows] : sampled_rows) {
+        if (static_cast<int64_t>(num_sampled_rows) * stride < min_rows) {
+            continue;
+        }
+        // The rows of each key of the chain, the keys are in the order of their first rows.
+        key_rows.clear();
+        int64_t chain_rows = 0;
+        bool too_many_keys = false;
+        for (uint32_t row = first[bucket]; row != 0 && !too_many_keys; row = next[row]) {
+            auto iter = std::find_if(key_rows.begin(), key_rows.end(), [&](const std::vector<uint32_t>& rows) {
+                return JoinKeyEqual<CppType>()(build_data[rows[0]], build_data[row]);
+            });
+            if (iter != key_rows.end()) {
+                iter->emplace_back(row);
+            } else if (key_rows.size() < kMaxHeavyBucketKeys) {
+                key_rows.push_back({row});
+            } else {
+                too_many_keys = true;
+            }
+            chain_rows++;
+        }
+        if (too_many_keys || chain_rows < min_rows) {
+            continue;
+        }
+
+        if (table_items->key_next.empty()) {
+            table_items->key_next = table_items->next;
+        }
+        uint32_t* key_next = table_items->key_next.data();
+        first[bucket] = key_rows[0][0];
+        for (size_t k = 0; k < key_rows.size(); k++) {
+            const auto& rows = key_rows[k];
+            const uint32_t next_key_row = k + 1 < key_rows.size() ? key_rows[k + 1][0] : 0;
+            for (size_t j = 0; j + 1 < rows.size(); j++) {
+                next[rows[j]] = rows[j + 1];
+                key_next[rows[j]] = rows[j + 1];
+            }
+            next[rows.back()] = next_key_row;
+            key_next[rows.back()] = next_key_row;
+            key_next[rows[0]] = next_key_row;
+        }
+        table_items->heavy_bucket_count++;
+    }
+}
+
 template <PrimitiveType PT>
 const Buffer<typename JoinBuildFunc<PT>::CppType>& JoinBuildFunc<PT>::get_key_data(
         const JoinHashTableItems& table_items) {
@@ -18,25 +82,44 @@ template <PrimitiveType PT>
 Status JoinBuildFunc<PT>::construct_hash_table(JoinHashTableItems* table_items,
                                                HashTableProbeState* probe_state) {
     auto& data = get_key_data(*table_items);
+    const uint8_t* null_data = nullptr;
     if (table_items->key_columns[0]->is_nullable()) {
         auto* nullable_column =
                 ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
-        auto& null_array = nullable_column->null_column()->get_data();
-        for (size_t i = 1; i < table_items->row_count + 1; i++) {
-            if (null_array[i] == 0) {
-                uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(
-                        data[i], table_items->bucket_size);
-                table_items->next[i] = table_items->first[bucket_num];
-                table_items->first[bucket_num] = i;
-            }
-        }
-    } else {
-        for (size_t i = 1; i < table_items->row_count + 1; i++) {
-            uint32_t bucket_num =
-                    JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size);
-            table_items->next[i] = table_items->first[bucket_num];
-            table_items->first[bucket_num] = i;
+        null_data = nullable_column->null_column()->get_data().data();
+    }
+    const uint32_t end = table_items->row_count + 1;
+    for (uint32_t start = 1; start < end; start += config::vector_chunk_size) {
+        uint32_t count = std::min<uint32_t>(config::vector_chunk_size, end - start);
+        JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size,
+                                                     &probe_state->buckets, start, count);
+        JoinHashMapHelper::insert_rows(table_items, probe_state->buckets.data(), start, count,
+                                       null_data == nullptr ? nullptr : null_data + start);
+    }
+    return Status::OK();
+}
+
+template <PrimitiveType PT>
+Status DirectMappingJoinBuildFunc<PT>::construct_hash_table(JoinHashTableItems* table_items,
+                                                            HashTableProbeState* probe_state) {
+    auto& data = JoinBuildFunc<PT>::get_key_data(*table_items);
+    const Buffer<uint8_t>* null_array = nullptr;
+    if (table_items->key_columns[0]->is_nullable()) {
+        auto* nullable_column =
+                ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
+        null_array = &nullable_column->null_column()->get_data();
+    }
+
+    const int64_t min_value = table_items->direct_mapping_min;
+    const uint32_t end = table_items->row_count + 1;
+    for (uint32_t start = 1; start < end; start += config::vector_chunk_size) {
+        uint32_t count = std::min<uint32_t>(config::vector_chunk_size, end - start);
+        for (uint32_t i = 0; i < count; i++) {
+            probe_state->buckets[i] =
+                    static_cast<uint32_t>(static_cast<int64_t>(data[start + i]) - min_value);
         }
+        JoinHashMapHelper::insert_rows(table_items, probe_state->buckets.data(), start, count,
+                                       null_array == nullptr ? nullptr : null_array->data() + start);
     }
     return Status::OK();
 }
@@ -115,10 +198,7 @@ void FixedSizeJoinBuildFunc<PT>::_build_columns(JoinHashTableItems* table_items,
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size,
                                                  &probe_state->buckets, start, count);
 
-    for (uint32_t i = 0; i < count; i++) {
-        table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-        table_items->first[probe_state->buckets[i]] = start + i;
-    }
+    JoinHashMapHelper::insert_rows(table_items, probe_state->buckets.data(), start, count);
 }
 
 template <PrimitiveType PT>
@@ -142,12 +222,8 @@ void FixedSizeJoinBuildFunc<PT>::_build_nullable_columns(JoinHashTableItems* tab
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size,
                                                  &probe_state->buckets, start, count);
 
-    for (size_t i = 0; i < count; i++) {
-        if (probe_state->is_nulls[i] == 0) {
-            table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-            table_items->first[probe_state->buckets[i]] = start + i;
-        }
-    }
+    JoinHashMapHelper::insert_rows(table_items, probe_state->buckets.data(), start, count,
+                                   probe_state->is_nulls.data());
 }
 
 template <PrimitiveType PT>
@@ -164,26 +240,17 @@ Status JoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
 
         if (nullable_column->has_null()) {
             auto& null_array = nullable_column->null_column()->get_data();
-            for (size_t i = 0; i < probe_row_count; i++) {
-                if (null_array[i] == 0) {
-                    probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-                } else {
-                    probe_state->next[i] = 0;
-                }
-            }
+            JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, probe_row_count,
+                                                   null_array.data());
             probe_state->null_array = &nullable_column->null_column()->get_data();
         } else {
-            for (size_t i = 0; i < probe_row_count; i++) {
-                probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-            }
+            JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, probe_row_count);
             probe_state->null_array = nullptr;
         }
         return Status::OK();
     }
 
-    for (size_t i = 0; i < probe_row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, probe_row_count);
     probe_state->null_array = nullptr;
     return Status::OK();
 }
@@ -200,6 +267,39 @@ const Buffer<typename JoinProbeFunc<PT>::CppType>& JoinProbeFunc<PT>::get_key_da
     return ColumnHelper::as_raw_column<ColumnType>((*probe_state.key_columns)[0])->get_data();
 }
 
+template <PrimitiveType PT>
+Status DirectMappingJoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
+                                                   HashTableProbeState* probe_state) {
+    size_t probe_row_count = probe_state->probe_row_count;
+    auto& data = JoinProbeFunc<PT>::get_key_data(*probe_state);
+
+    probe_state->null_array = nullptr;
+    if ((*probe_state->key_columns)[0]->is_nullable()) {
+        auto* nullable_column =
+                ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
+        if (nullable_column->has_null()) {
+            probe_state->null_array = &nullable_column->null_column()->get_data();
+        }
+    }
+
+    // Both the null keys and the keys out of range are marked in is_nulls, which have no bucket.
+    const int64_t min_value = table_items.direct_mapping_min;
+    const int64_t max_value = table_items.direct_mapping_max;
+    const Buffer<uint8_t>* null_array = probe_state->null_array;
+    for (size_t i = 0; i < probe_row_count; i++) {
+        auto value = static_cast<int64_t>(data[i]);
+        uint8_t miss = (value < min_value) | (value > max_value);
+        if (null_array != nullptr) {
+            miss |= (*null_array)[i];
+        }
+        probe_state->is_nulls[i] = miss;
+        probe_state->buckets[i] = miss ? 0 : static_cast<uint32_t>(value - min_value);
+    }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, probe_row_count,
+                                           probe_state->is_nulls.data());
+    return Status::OK();
+}
+
 template <PrimitiveType PT>
 Status FixedSizeJoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
                                                HashTableProbeState* probe_state) {
@@ -250,9 +350,7 @@ void FixedSizeJoinProbeFunc<PT>::_probe_column(const JoinHashTableItems& table_i
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, row_count);
 }
 
 template <PrimitiveType PT>
@@ -277,13 +375,8 @@ void FixedSizeJoinProbeFunc<PT>::_probe_nullable_column(const JoinHashTableItems
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        if (probe_state->is_nulls[i] == 0) {
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
-            probe_state->next[i] = 0;
-        }
-    }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, row_count,
+                                           probe_state->is_nulls.data());
 }
 
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
@@ -293,6 +386,18 @@ Status JoinHashMap<PT, BuildFunc, ProbeFunc>::build(RuntimeState* state) {
 
     // construct hash table
     RETURN_IF_ERROR(BuildFunc().construct_hash_table(_table_items, _probe_state));
+    if (_table_items->radix_bits > 0) {
+        JoinHashMapHelper::insert_partitioned_rows(_table_items);
+    }
+
+    // The chain of a direct mapping bucket holds the rows of a key.
+    if constexpr (!std::is_same_v<BuildFunc, DirectMappingJoinBuildFunc<PT>>) {
+        JoinHashMapHelper::group_heavy_buckets<CppType>(_table_items, BuildFunc().get_key_data(*_table_items));
+        if (!_table_items->key_next.empty()) {
+            RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(
+                    state, _table_items, _table_items->key_next.size() * sizeof(uint32_t)));
+        }
+    }
 
     return Status::OK();
 }
@@ -477,6 +582,9 @@ template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 Status JoinHashMap<PT, BuildFunc, ProbeFunc>::_build_output(ChunkPtr* chunk) {
     bool to_nullable = _table_items->right_to_nullable;
     for (size_t i = 0; i < _table_items->build_column_count; i++) {
+        if (_table_items->has_late_build_columns && _table_items->is_late_build_column[i]) {
+            continue;
+        }
         SlotDescriptor* slot = _table_items->build_slots[i];
         ColumnPtr& column = _table_items->build_chunk->columns()[i];
         if (!column->is_nullable()) {
@@ -655,6 +763,7 @@ template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 Status JoinHashMap<PT, BuildFunc, ProbeFunc>::_search_ht(ChunkPtr* probe_chunk) {
     if (!_probe_state->has_remain) {
         _probe_state->probe_row_count = (*probe_chunk)->num_rows();
+        _probe_state->prefetch_distance = std::max(config::join_hash_table_prefetch_distance, 0);
         ProbeFunc().prepare(_table_items, _probe_state);
         RETURN_IF_ERROR(ProbeFunc().lookup_init(*_table_items, _probe_state));
 
@@ -813,6 +922,16 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_search_ht_impl(const Buffer<CppType
     _probe_state->count = match_count; \
     _probe_state->cur_row_match_count = 0;
 
+// Prefetch the first build row in the bucket chain of the probe row which is
+// prefetch_distance rows ahead, and the link to the next build row of it.
+#define PREFETCH_BUILD_ROW()                                                             \
+    if (_probe_state->prefetch_distance > 0 &&                                           \
+        i + _probe_state->prefetch_distance < probe_row_count) {                         \
+        size_t prefetch_index = _probe_state->next[i + _probe_state->prefetch_distance]; \
+        __builtin_prefetch(&build_data[prefetch_index]);                                 \
+        __builtin_prefetch(&_table_items->next[prefetch_index]);                         \
+    }
+
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 template <bool first_probe>
 void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht(const Buffer<CppType>& build_data,
@@ -834,6 +953,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht(const Buffer<CppType>
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         if constexpr (first_probe) {
             _probe_state->probe_match_filter[i] = 0;
         }
@@ -850,8 +970,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht(const Buffer<CppType>
                         _probe_state->probe_match_filter[i] = 1;
                     }
                     RETURN_IF_CHUNK_FULL()
+                    build_index = _table_items->next[build_index];
+                } else {
+                    build_index = _table_items->mismatch_next()[build_index];
                 }
-                build_index = _table_items->next[build_index];
             } while (build_index != 0);
 
             if constexpr (first_probe) {
@@ -893,6 +1015,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_outer_join(
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             _probe_state->probe_index[match_count] = i;
@@ -910,8 +1033,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_outer_join(
                     _probe_state->cur_row_match_count++;
 
                     RETURN_IF_CHUNK_FULL()
+                    build_index = _table_items->next[build_index];
+                } else {
+                    build_index = _table_items->mismatch_next()[build_index];
                 }
-                build_index = _table_items->next[build_index];
             }
             if (_probe_state->cur_row_match_count <= 0) {
                 // one key of left table match none key of right table
@@ -944,6 +1069,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_semi_join(
     size_t match_count = 0;
     size_t probe_row_count = _probe_state->probe_row_count;
     for (size_t i = 0; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t index = _probe_state->next[i];
         if (index == 0) {
             continue;
@@ -955,7 +1081,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_semi_join(
                 match_count++;
                 break;
             }
-            index = _table_items->next[index];
+            index = _table_items->mismatch_next()[index];
         }
     }
 
@@ -974,6 +1100,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_anti_join(
         _probe_state->null_array != nullptr && _table_items->row_count != 0) {
         // process left anti join from not in
         for (size_t i = 0; i < probe_row_count; i++) {
+            PREFETCH_BUILD_ROW()
             size_t index = _probe_state->next[i];
             if ((*_probe_state->null_array)[i] == 1) {
                 continue;
@@ -991,7 +1118,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_anti_join(
                     found = true;
                     break;
                 }
-                index = _table_items->next[index];
+                index = _table_items->mismatch_next()[index];
             }
             if (!found) {
                 _probe_state->probe_index[match_count] = i;
@@ -1000,6 +1127,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_anti_join(
         }
     } else {
         for (size_t i = 0; i < probe_row_count; i++) {
+            PREFETCH_BUILD_ROW()
             size_t index = _probe_state->next[i];
             if (index == 0) {
                 _probe_state->probe_index[match_count] = i;
@@ -1012,7 +1140,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_anti_join(
                     found = true;
                     break;
                 }
-                index = _table_items->next[index];
+                index = _table_items->mismatch_next()[index];
             }
             if (!found) {
                 _probe_state->probe_index[match_count] = i;
@@ -1043,6 +1171,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_outer_join(
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -1056,8 +1185,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_outer_join(
                 match_count++;
 
                 RETURN_IF_CHUNK_FULL()
+                build_index = _table_items->next[build_index];
+            } else {
+                build_index = _table_items->mismatch_next()[build_index];
             }
-            build_index = _table_items->next[build_index];
         }
     }
 
@@ -1080,6 +1211,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_semi_join(
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -1095,8 +1227,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_semi_join(
 
                     RETURN_IF_CHUNK_FULL()
                 }
+                build_index = _table_items->next[build_index];
+            } else {
+                build_index = _table_items->mismatch_next()[build_index];
             }
-            build_index = _table_items->next[build_index];
         }
     }
 
@@ -1109,6 +1243,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_anti_join(
         const Buffer<CppType>& build_data, const Buffer<CppType>& probe_data) {
     size_t probe_row_count = _probe_state->probe_row_count;
     for (size_t i = 0; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t index = _probe_state->next[i];
         if (index == 0) {
             continue;
@@ -1117,8 +1252,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_anti_join(
         while (index != 0) {
             if (JoinKeyEqual<CppType>()(build_data[index], probe_data[i])) {
                 _probe_state->build_match_index[index] = 1;
+                index = _table_items->next[index];
+            } else {
+                index = _table_items->mismatch_next()[index];
             }
-            index = _table_items->next[index];
         }
     }
     _probe_state->count = 0;
@@ -1145,6 +1282,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_full_outer_join(
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             _probe_state->probe_index[match_count] = i;
@@ -1162,8 +1300,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_full_outer_join(
                     match_count++;
 
                     RETURN_IF_CHUNK_FULL()
+                    build_index = _table_items->next[build_index];
+                } else {
+                    build_index = _table_items->mismatch_next()[build_index];
                 }
-                build_index = _table_items->next[build_index];
             }
             if (_probe_state->cur_row_match_count <= 0) {
                 _probe_state->probe_index[match_count] = i;
@@ -1203,6 +1343,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_outer_join_w
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             _probe_state->probe_index[match_count] = i;
@@ -1222,8 +1363,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_outer_join_w
                 _probe_state->cur_row_match_count++;
 
                 RETURN_IF_CHUNK_FULL()
+                build_index = _table_items->next[build_index];
+            } else {
+                build_index = _table_items->mismatch_next()[build_index];
             }
-            build_index = _table_items->next[build_index];
         }
         if (_probe_state->cur_row_match_count <= 0) {
             _probe_state->probe_index[match_count] = i;
@@ -1262,6 +1405,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_semi_join_wi
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -1274,8 +1418,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_semi_join_wi
                 match_count++;
 
                 RETURN_IF_CHUNK_FULL()
+                build_index = _table_items->next[build_index];
+            } else {
+                build_index = _table_items->mismatch_next()[build_index];
             }
-            build_index = _table_items->next[build_index];
         }
     }
 
@@ -1307,6 +1453,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_anti_join_wi
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             _probe_state->probe_index[match_count] = i;
@@ -1326,8 +1473,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_anti_join_wi
                 _probe_state->cur_row_match_count++;
 
                 RETURN_IF_CHUNK_FULL()
+                build_index = _table_items->next[build_index];
+            } else {
+                build_index = _table_items->mismatch_next()[build_index];
             }
-            build_index = _table_items->next[build_index];
         }
         if (_probe_state->cur_row_match_count <= 0) {
             _probe_state->probe_index[match_count] = i;
@@ -1354,6 +1503,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_outer_join_
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -1366,8 +1516,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_outer_join_
                 match_count++;
 
                 RETURN_IF_CHUNK_FULL()
+                build_index = _table_items->next[build_index];
+            } else {
+                build_index = _table_items->mismatch_next()[build_index];
             }
-            build_index = _table_items->next[build_index];
         }
     }
 
@@ -1385,6 +1537,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_semi_join_w
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -1397,8 +1550,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_semi_join_w
                 match_count++;
 
                 RETURN_IF_CHUNK_FULL()
+                build_index = _table_items->next[build_index];
+            } else {
+                build_index = _table_items->mismatch_next()[build_index];
             }
-            build_index = _table_items->next[build_index];
         }
     }
 
@@ -1416,6 +1571,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_anti_join_w
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -1428,8 +1584,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_anti_join_w
                 match_count++;
 
                 RETURN_IF_CHUNK_FULL()
+                build_index = _table_items->next[build_index];
+            } else {
+                build_index = _table_items->mismatch_next()[build_index];
             }
-            build_index = _table_items->next[build_index];
         }
     }
 
@@ -1460,6 +1618,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_full_outer_join_w
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW()
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             _probe_state->probe_index[match_count] = i;
@@ -1477,8 +1636,10 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_probe_from_ht_for_full_outer_join_w
                     match_count++;
 
                     RETURN_IF_CHUNK_FULL()
+                    build_index = _table_items->next[build_index];
+                } else {
+                    build_index = _table_items->mismatch_next()[build_index];
                 }
-                build_index = _table_items->next[build_index];
             }
             if (_probe_state->cur_row_match_count <= 0) {
                 _probe_state->probe_index[match_count] = i;
@@ -7,8 +7,10 @@
 #include <ryu/ryu.h>
 
 #include <algorithm>
+#include <cstring>
 
 #include "column/array_column.h"
+#include "column/binary_column.h"
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
@@ -22,6 +24,7 @@
 #include "gutil/strings/substitute.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "util/json_binary.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::vectorized {
@@ -231,7 +234,64 @@ JsonReader::JsonReader(starrocks::RuntimeState* state, starrocks::vectorized::Sc
           _next_line(0),
           _total_lines(0),
           _closed(false),
-          _buf(_buf_size) {}
+          _buf(_buf_size) {
+    _column_hints.resize(_scanner->_src_slot_descriptors.size(), 0);
+    const auto& json_paths = _scanner->_json_paths;
+    _simple_paths.resize(json_paths.size());
+    _path_hints.resize(json_paths.size());
+    for (size_t i = 0; i < json_paths.size(); i++) {
+        // $.a.b, without any array index
+        bool simple = json_paths[i].size() > 1 && json_paths[i][0].is_valid;
+        for (size_t k = 1; k < json_paths[i].size() && simple; k++) {
+            simple = json_paths[i][k].is_valid && !json_paths[i][k].key.empty() && json_paths[i][k].idx == -1;
+        }
+        _simple_paths[i] = simple;
+        _path_hints[i].resize(json_paths[i].size(), 0);
+    }
+}
+
+// Find the member |name| of the object |obj|. It tries the position where the member is found last time
+// first, since the objects of a load usually have the same members in the same order.
+static rapidjson::Value* find_member(rapidjson::Value* obj, const std::string& name, uint32_t* hint) {
+    const uint32_t num_members = obj->MemberCount();
+    auto members = obj->MemberBegin();
+    auto equals = [&](uint32_t i) {
+        const rapidjson::Value& key = members[i].name;
+        return key.GetStringLength() == name.size() && memcmp(key.GetString(), name.data(), name.size()) == 0;
+    };
+    if (*hint < num_members && equals(*hint)) {
+        return &members[*hint].value;
+    }
+    for (uint32_t i = 0; i < num_members; i++) {
+        if (equals(i)) {
+            *hint = i;
+            return &members[i].value;
+        }
+    }
+    return nullptr;
+}
+
+rapidjson::Value* JsonReader::_get_json_value(size_t path_index, rapidjson::Value* value) {
+    const std::vector<JsonPath>& path = _scanner->_json_paths[path_index];
+    if (!_simple_paths[path_index]) {
+        return JsonFunctions::get_json_object_from_parsed_json(path, value, _origin_json_doc.GetAllocator());
+    }
+    rapidjson::Value* root = value;
+    for (size_t k = 1; k < path.size(); k++) {
+        if (root->IsObject()) {
+            root = find_member(root, path[k].key, &_path_hints[path_index][k]);
+            if (root == nullptr) {
+                return nullptr;
+            }
+        } else if (root->IsArray()) {
+            // the members of the objects in the array are collected into a new array
+            return JsonFunctions::get_json_object_from_parsed_json(path, value, _origin_json_doc.GetAllocator());
+        } else {
+            return nullptr;
+        }
+    }
+    return root;
+}
 
 JsonReader::~JsonReader() {
     close();
@@ -285,16 +345,20 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
                 objectValue = &(*_json_doc)[_next_line];
             }
             if (_scanner->_json_paths.empty()) {
-                for (SlotDescriptor* slot_desc : slot_descs) {
+                for (size_t i = 0; i < slot_descs.size(); i++) {
+                    SlotDescriptor* slot_desc = slot_descs[i];
                     if (slot_desc == nullptr) {
                         continue;
                     }
                     ColumnPtr& column = chunk->get_column_by_slot_id(slot_desc->id());
-                    const char* column_name = slot_desc->col_name().c_str();
-                    if (!objectValue->IsObject() || !objectValue->HasMember(column_name)) {
+                    rapidjson::Value* value = nullptr;
+                    if (objectValue->IsObject()) {
+                        value = find_member(objectValue, slot_desc->col_name(), &_column_hints[i]);
+                    }
+                    if (value == nullptr) {
                         column->append_nulls(1);
                     } else {
-                        _construct_column((*objectValue)[column_name], column.get(), slot_desc->type());
+                        _construct_column(*value, column.get(), slot_desc->type());
                     }
                 }
             } else {
@@ -309,8 +373,7 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
                         column->append_nulls(1);
                         continue;
                     }
-                    rapidjson::Value* json_values = JsonFunctions::get_json_object_from_parsed_json(
-                            _scanner->_json_paths[i], objectValue, _origin_json_doc.GetAllocator());
+                    rapidjson::Value* json_values = _get_json_value(i, objectValue);
                     if (json_values == nullptr) {
                         column->append_nulls(1);
                     } else {
@@ -384,6 +447,26 @@ Status JsonReader::_read_and_parse_json() {
     return Status::OK();
 }
 
+// Append |str| to |column|, which is always a nullable binary column, without building a vector of one slice.
+static void append_string(Column* column, const Slice& str) {
+    auto* nullable_column = down_cast<NullableColumn*>(column);
+    down_cast<BinaryColumn*>(nullable_column->mutable_data_column())->append(str);
+    nullable_column->null_column_data().emplace_back(0);
+}
+
+// Append the text of the object or array |value| to |column|, or its binary form by
+// config::json_load_nested_as_binary.
+static void append_nested_value(Column* column, const rapidjson::Value& value) {
+    if (config::json_load_nested_as_binary) {
+        std::string binary;
+        JsonBinaryValue::encode(value, &binary);
+        append_string(column, Slice(binary));
+    } else {
+        std::string json_str = JsonFunctions::get_raw_json_string(value);
+        append_string(column, Slice(json_str.c_str(), json_str.length()));
+    }
+}
+
 void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column* column,
                                    const TypeDescriptor& type_desc) {
     if (objectValue.GetType() != rapidjson::kArrayType && type_desc.type == TYPE_ARRAY) {
@@ -398,35 +481,35 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
         break;
     }
     case rapidjson::Type::kFalseType: {
-        column->append_strings(std::vector<Slice>{Slice("0")});
+        append_string(column, Slice("0"));
         break;
     }
     case rapidjson::Type::kTrueType: {
-        column->append_strings(std::vector<Slice>{Slice("1")});
+        append_string(column, Slice("1"));
         break;
     }
     case rapidjson::Type::kNumberType: {
         if (objectValue.IsUint()) {
             auto f = fmt::format_int(objectValue.GetUint());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsInt()) {
             auto f = fmt::format_int(objectValue.GetInt());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsUint64()) {
             auto f = fmt::format_int(objectValue.GetUint64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsInt64()) {
             auto f = fmt::format_int(objectValue.GetInt64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            append_string(column, Slice(f.data(), f.size()));
         } else {
             int len = d2s_buffered_n(objectValue.GetDouble(), buf);
-            column->append_strings(std::vector<Slice>{Slice(buf, len)});
+            append_string(column, Slice(buf, len));
         }
         break;
     }
     case rapidjson::Type::kStringType: {
         const char* str_value = objectValue.GetString();
-        column->append_strings(std::vector<Slice>{Slice(str_value, objectValue.GetStringLength())});
+        append_string(column, Slice(str_value, objectValue.GetStringLength()));
         break;
     }
     case rapidjson::Type::kArrayType: {
@@ -444,14 +527,12 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
             uint32_t size = offsets->get_data().back() + objectValue.Size();
             offsets->append_numbers(&size, 4);
         } else {
-            std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-            column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+            append_nested_value(column, objectValue);
         }
         break;
     }
     case rapidjson::Type::kObjectType: {
-        std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-        column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+        append_nested_value(column, objectValue);
         break;
     }
     }
@@ -84,6 +84,8 @@ public:
 private:
     Status _read_and_parse_json();
     void _construct_column(const rapidjson::Value& objectValue, Column* column, const TypeDescriptor& type_desc);
+    // Return the value of the |path_index|-th json path in |value|, or nullptr if it's not found.
+    rapidjson::Value* _get_json_value(size_t path_index, rapidjson::Value* value);
 
 private:
     RuntimeState* _state = nullptr;
@@ -99,6 +101,12 @@ private:
     std::vector<std::vector<JsonPath>> _json_paths;
     std::vector<JsonPath> _root_paths;
 
+    // The json paths without array indexes, which are resolved member by member.
+    std::vector<uint8_t> _simple_paths;
+    // The positions where the members of the columns or the json paths are found in the last row.
+    std::vector<uint32_t> _column_hints;
+    std::vector<std::vector<uint32_t>> _path_hints;
+
     rapidjson::Document _origin_json_doc;  // origin json document object from parsed json string
     rapidjson::Value* _json_doc = nullptr; // _json_doc equals _final_json_doc iff not set `json_root`
 
@@ -0,0 +1,418 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/merge_join_node.h"
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+MergeJoinNode::MergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs) {}
+
+Status MergeJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    DCHECK(tnode.__isset.merge_join_node);
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    const TMergeJoinNode& merge_join_node = tnode.merge_join_node;
+
+    for (const auto& eq_join_conjunct : merge_join_node.cmp_conjuncts) {
+        if (eq_join_conjunct.__isset.opcode && eq_join_conjunct.opcode == TExprOpcode::EQ_FOR_NULL) {
+            return Status::NotSupported("merge join doesn't support null safe equal join conjuncts");
+        }
+        ExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, eq_join_conjunct.left, &ctx));
+        _left_expr_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, eq_join_conjunct.right, &ctx));
+        _right_expr_ctxs.push_back(ctx);
+    }
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, merge_join_node.other_join_conjuncts, &_other_join_conjunct_ctxs));
+
+    if (merge_join_node.__isset.join_op) {
+        _join_type = merge_join_node.join_op;
+    }
+    switch (_join_type) {
+    case TJoinOp::INNER_JOIN:
+        break;
+    case TJoinOp::LEFT_OUTER_JOIN:
+    case TJoinOp::LEFT_SEMI_JOIN:
+    case TJoinOp::LEFT_ANTI_JOIN:
+        if (!_other_join_conjunct_ctxs.empty()) {
+            return Status::NotSupported(strings::Substitute(
+                    "merge join doesn't support other join conjuncts for join type $0", _join_type));
+        }
+        break;
+    default:
+        return Status::NotSupported(strings::Substitute("merge join doesn't support join type $0", _join_type));
+    }
+    return Status::OK();
+}
+
+Status MergeJoinNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+
+    _join_timer = ADD_TIMER(runtime_profile(), "JoinTime");
+    _probe_rows_counter = ADD_COUNTER(runtime_profile(), "ProbeRows", TUnit::UNIT);
+    _build_rows_counter = ADD_COUNTER(runtime_profile(), "BuildRows", TUnit::UNIT);
+    _build_group_rows_counter = ADD_COUNTER(runtime_profile(), "MaxBuildGroupRows", TUnit::UNIT);
+
+    RETURN_IF_ERROR(Expr::prepare(_left_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(Expr::prepare(_right_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(Expr::prepare(_other_join_conjunct_ctxs, state, _row_descriptor, expr_mem_tracker()));
+    for (size_t i = 0; i < _left_expr_ctxs.size(); i++) {
+        // The keys are compared column by column, so both sides must have the same type.
+        if (!(_left_expr_ctxs[i]->root()->type() == _right_expr_ctxs[i]->root()->type())) {
+            return Status::NotSupported(strings::Substitute("merge join keys have different types: $0 and $1",
+                                                            _left_expr_ctxs[i]->root()->type().debug_string(),
+                                                            _right_expr_ctxs[i]->root()->type().debug_string()));
+        }
+    }
+
+    for (const auto& tuple_desc : child(0)->row_desc().tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            _probe_slots.emplace_back(slot);
+        }
+        if (_row_descriptor.get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _output_probe_tuple_ids.emplace_back(tuple_desc->id());
+        }
+    }
+    if (_output_build_columns()) {
+        for (const auto& tuple_desc : child(1)->row_desc().tuple_descriptors()) {
+            for (const auto& slot : tuple_desc->slots()) {
+                _build_slots.emplace_back(slot);
+            }
+            if (_row_descriptor.get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+                _output_build_tuple_ids.emplace_back(tuple_desc->id());
+            }
+        }
+    }
+
+    // The unmatched left rows of LEFT_OUTER_JOIN are joined with the null row 0 of the build group.
+    bool to_nullable = _join_type == TJoinOp::LEFT_OUTER_JOIN;
+    _build_group = std::make_shared<Chunk>();
+    for (const auto& slot : _build_slots) {
+        ColumnPtr column = ColumnHelper::create_column(slot->type(), slot->is_nullable() || to_nullable);
+        if (to_nullable) {
+            column->append_nulls(1);
+        }
+        _build_group->append_column(std::move(column), slot->id());
+    }
+    for (TupleId tuple_id : _output_build_tuple_ids) {
+        _build_group->append_tuple_column(BooleanColumn::create(to_nullable ? 1 : 0, 0), tuple_id);
+    }
+    _build_group_start = to_nullable ? 1 : 0;
+    return Status::OK();
+}
+
+Status MergeJoinNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_ERROR(Expr::open(_left_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_right_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_other_join_conjunct_ctxs, state));
+    RETURN_IF_ERROR(child(0)->open(state));
+    RETURN_IF_ERROR(child(1)->open(state));
+    return Status::OK();
+}
+
+Status MergeJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("get_next for row_batch is not supported");
+}
+
+Status MergeJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    RETURN_IF_CANCELLED(state);
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+
+    while (!_eos && !reached_limit()) {
+        _init_output_chunk();
+        while (_num_output_rows() < config::vector_chunk_size) {
+            RETURN_IF_ERROR(_fetch_if_needed(state, 0, &_left, _left_expr_ctxs));
+            if (!_left.has_row()) {
+                _eos = true;
+                break;
+            }
+
+            const size_t row = _left.row;
+            bool matched = false;
+            if (!_has_null_key(_left.keys, row)) {
+                if (!_has_build_group || _compare_keys(_left.key_data, row, _build_group_key_data, 0) > 0) {
+                    RETURN_IF_ERROR(_seek_build_group(state));
+                }
+                matched = _has_build_group && _compare_keys(_left.key_data, row, _build_group_key_data, 0) == 0;
+            }
+
+            if (!matched) {
+                if (_join_type == TJoinOp::LEFT_OUTER_JOIN || _join_type == TJoinOp::LEFT_ANTI_JOIN) {
+                    _probe_index.emplace_back(row);
+                    _build_index.emplace_back(0);
+                }
+                _left.row++;
+                continue;
+            }
+
+            if (_join_type == TJoinOp::LEFT_SEMI_JOIN) {
+                _probe_index.emplace_back(row);
+                _build_index.emplace_back(0);
+            } else if (_join_type != TJoinOp::LEFT_ANTI_JOIN) {
+                // Join the left row with the build group, which could be split into several output chunks.
+                size_t group_rows = _build_group->num_rows() - _build_group_start;
+                size_t count = std::min(group_rows - _build_group_offset,
+                                        config::vector_chunk_size - _num_output_rows());
+                uint32_t build_start = _build_group_start + _build_group_offset;
+                for (uint32_t i = 0; i < count; i++) {
+                    _probe_index.emplace_back(row);
+                    _build_index.emplace_back(build_start + i);
+                }
+                _build_group_offset += count;
+                if (_build_group_offset < group_rows) {
+                    continue;
+                }
+                _build_group_offset = 0;
+            }
+            _left.row++;
+        }
+        _flush_joined_rows();
+
+        {
+            SCOPED_TIMER(_join_timer);
+            if (!_other_join_conjunct_ctxs.empty()) {
+                eval_conjuncts(_other_join_conjunct_ctxs, _output_chunk.get());
+            }
+            eval_conjuncts(_conjunct_ctxs, _output_chunk.get());
+        }
+        if (!_output_chunk->is_empty()) {
+            break;
+        }
+    }
+
+    if (_output_chunk == nullptr || _output_chunk->is_empty()) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    *chunk = std::move(_output_chunk);
+    _num_rows_returned += (*chunk)->num_rows();
+    if (reached_limit()) {
+        (*chunk)->set_num_rows((*chunk)->num_rows() - (_num_rows_returned - _limit));
+        _num_rows_returned = _limit;
+        COUNTER_SET(_rows_returned_counter, _limit);
+    } else {
+        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    }
+    DCHECK_CHUNK(*chunk);
+    *eos = false;
+    return Status::OK();
+}
+
+Status MergeJoinNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    Expr::close(_left_expr_ctxs, state);
+    Expr::close(_right_expr_ctxs, state);
+    Expr::close(_other_join_conjunct_ctxs, state);
+    _left = ChildCursor();
+    _right = ChildCursor();
+    _build_group.reset();
+    _output_chunk.reset();
+    return ExecNode::close(state);
+}
+
+Status MergeJoinNode::_fetch_if_needed(RuntimeState* state, int child_idx, ChildCursor* cursor,
+                                       const std::vector<ExprContext*>& key_ctxs) {
+    if (cursor->has_row() || cursor->eos) {
+        return Status::OK();
+    }
+    // The pending joined rows refer to the current left chunk.
+    if (child_idx == 0) {
+        _flush_joined_rows();
+    }
+
+    cursor->chunk.reset();
+    cursor->row = 0;
+    ChunkPtr chunk;
+    do {
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(child(child_idx)->get_next(state, &chunk, &cursor->eos));
+    } while (!cursor->eos && chunk->is_empty());
+    if (cursor->eos) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_join_timer);
+    COUNTER_UPDATE(child_idx == 0 ? _probe_rows_counter : _build_rows_counter, chunk->num_rows());
+    Columns keys;
+    for (auto* ctx : key_ctxs) {
+        ColumnPtr key = ctx->evaluate(chunk.get());
+        keys.emplace_back(ColumnHelper::unpack_and_duplicate_const_column(chunk->num_rows(), key));
+    }
+    _set_keys(std::move(keys), &cursor->keys, &cursor->key_data);
+    cursor->chunk = std::move(chunk);
+    return Status::OK();
+}
+
+void MergeJoinNode::_set_keys(Columns keys, Columns* dst_keys, std::vector<const Column*>* dst_key_data) {
+    dst_key_data->clear();
+    for (const auto& key : keys) {
+        dst_key_data->emplace_back(key->is_nullable() ? down_cast<NullableColumn*>(key.get())->data_column().get()
+                                                      : key.get());
+    }
+    *dst_keys = std::move(keys);
+}
+
+bool MergeJoinNode::_has_null_key(const Columns& keys, size_t row) {
+    for (const auto& key : keys) {
+        if (key->is_null(row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int MergeJoinNode::_compare_keys(const std::vector<const Column*>& lhs, size_t lhs_row,
+                                 const std::vector<const Column*>& rhs, size_t rhs_row) {
+    for (size_t i = 0; i < lhs.size(); i++) {
+        int res = lhs[i]->compare_at(lhs_row, rhs_row, *rhs[i], 1);
+        if (res != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+Status MergeJoinNode::_seek_build_group(RuntimeState* state) {
+    if (_has_build_group) {
+        // The pending joined rows refer to the current build group.
+        _flush_joined_rows();
+        _reset_build_group();
+    }
+
+    const size_t left_row = _left.row;
+    while (true) {
+        RETURN_IF_ERROR(_fetch_if_needed(state, 1, &_right, _right_expr_ctxs));
+        if (!_right.has_row()) {
+            return Status::OK();
+        }
+
+        size_t num_rows = _right.chunk->num_rows();
+        if (!_has_build_group) {
+            // Skip the right rows less than the left row, which match no left rows any more.
+            while (_right.row < num_rows &&
+                   (_has_null_key(_right.keys, _right.row) ||
+                    _compare_keys(_right.key_data, _right.row, _left.key_data, left_row) < 0)) {
+                _right.row++;
+            }
+            if (_right.row == num_rows) {
+                continue;
+            }
+            if (_compare_keys(_right.key_data, _right.row, _left.key_data, left_row) > 0) {
+                return Status::OK();
+            }
+
+            Columns group_keys;
+            for (const auto& key : _right.keys) {
+                auto group_key = key->clone_empty();
+                group_key->append(*key, _right.row, 1);
+                group_keys.emplace_back(std::move(group_key));
+            }
+            _set_keys(std::move(group_keys), &_build_group_keys, &_build_group_key_data);
+            _has_build_group = true;
+        }
+
+        // The rows with null keys aren't in the middle of the same keys, because the rows are sorted.
+        size_t end = _right.row;
+        while (end < num_rows && _compare_keys(_right.key_data, end, _build_group_key_data, 0) == 0 &&
+               !_has_null_key(_right.keys, end)) {
+            end++;
+        }
+        _append_to_build_group(_right.row, end - _right.row);
+        _right.row = end;
+        if (end < num_rows) {
+            break;
+        }
+        // The group may continue in the next right chunk.
+    }
+
+    int64_t group_rows = _build_group->num_rows() - _build_group_start;
+    if (group_rows > _build_group_rows_counter->value()) {
+        COUNTER_SET(_build_group_rows_counter, group_rows);
+    }
+    return Status::OK();
+}
+
+void MergeJoinNode::_append_to_build_group(size_t from, size_t size) {
+    for (const auto& slot : _build_slots) {
+        const ColumnPtr& src_column = _right.chunk->get_column_by_slot_id(slot->id());
+        _build_group->get_column_by_slot_id(slot->id())->append(*src_column, from, size);
+    }
+    for (TupleId tuple_id : _output_build_tuple_ids) {
+        auto* dest_column = ColumnHelper::as_raw_column<BooleanColumn>(_build_group->get_tuple_column_by_id(tuple_id));
+        if (_right.chunk->is_tuple_exist(tuple_id)) {
+            dest_column->append(*_right.chunk->get_tuple_column_by_id(tuple_id), from, size);
+        } else {
+            dest_column->get_data().resize(dest_column->size() + size, 1);
+        }
+    }
+}
+
+void MergeJoinNode::_reset_build_group() {
+    _build_group->set_num_rows(_build_group_start);
+    _build_group_keys.clear();
+    _build_group_key_data.clear();
+    _has_build_group = false;
+    _build_group_offset = 0;
+}
+
+void MergeJoinNode::_init_output_chunk() {
+    _output_chunk = std::make_shared<Chunk>();
+    for (const auto& slot : _probe_slots) {
+        _output_chunk->append_column(ColumnHelper::create_column(slot->type(), slot->is_nullable()), slot->id());
+    }
+    for (TupleId tuple_id : _output_probe_tuple_ids) {
+        _output_chunk->append_tuple_column(BooleanColumn::create(), tuple_id);
+    }
+    for (const auto& slot : _build_slots) {
+        _output_chunk->append_column(_build_group->get_column_by_slot_id(slot->id())->clone_empty(), slot->id());
+    }
+    for (TupleId tuple_id : _output_build_tuple_ids) {
+        _output_chunk->append_tuple_column(BooleanColumn::create(), tuple_id);
+    }
+    _output_chunk->reserve(config::vector_chunk_size);
+}
+
+void MergeJoinNode::_flush_joined_rows() {
+    if (_probe_index.empty()) {
+        return;
+    }
+    SCOPED_TIMER(_join_timer);
+    const uint32_t count = _probe_index.size();
+    for (const auto& slot : _probe_slots) {
+        const ColumnPtr& src_column = _left.chunk->get_column_by_slot_id(slot->id());
+        _output_chunk->get_column_by_slot_id(slot->id())->append_selective(*src_column, _probe_index.data(), 0, count);
+    }
+    for (TupleId tuple_id : _output_probe_tuple_ids) {
+        auto* dest_column = ColumnHelper::as_raw_column<BooleanColumn>(_output_chunk->get_tuple_column_by_id(tuple_id));
+        if (_left.chunk->is_tuple_exist(tuple_id)) {
+            dest_column->append_selective(*_left.chunk->get_tuple_column_by_id(tuple_id), _probe_index.data(), 0,
+                                          count);
+        } else {
+            dest_column->get_data().resize(dest_column->size() + count, 1);
+        }
+    }
+    for (const auto& slot : _build_slots) {
+        const ColumnPtr& src_column = _build_group->get_column_by_slot_id(slot->id());
+        _output_chunk->get_column_by_slot_id(slot->id())->append_selective(*src_column, _build_index.data(), 0, count);
+    }
+    for (TupleId tuple_id : _output_build_tuple_ids) {
+        const ColumnPtr& src_column = _build_group->get_tuple_column_by_id(tuple_id);
+        _output_chunk->get_tuple_column_by_id(tuple_id)->append_selective(*src_column, _build_index.data(), 0, count);
+    }
+    _probe_index.clear();
+    _build_index.clear();
+}
+
+} // namespace starrocks::vectorized
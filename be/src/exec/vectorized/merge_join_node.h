@@ -0,0 +1,106 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "column/chunk.h"
+#include "exec/exec_node.h"
+
+namespace starrocks::vectorized {
+
+// MergeJoinNode joins two children whose chunks are sorted by the join keys in ascending order, e.g. the
+// tablets scanned in the order of their sort keys or the outputs of the sort nodes, without hashing either
+// side. Both children stream through the join, only the rows of the right child with the same keys as the
+// current left row are buffered, so the memory is bounded by the largest group of duplicate keys.
+//
+// The rows with null keys match nothing, so they could be sorted either first or last.
+// INNER_JOIN, LEFT_OUTER_JOIN, LEFT_SEMI_JOIN and LEFT_ANTI_JOIN are supported, and the other join conjuncts
+// are only supported by INNER_JOIN.
+class MergeJoinNode final : public ExecNode {
+public:
+    MergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~MergeJoinNode() override = default;
+
+    Status init(const TPlanNode& tnode, RuntimeState* state = nullptr) override;
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override;
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+private:
+    // The current chunk of a child and its evaluated join keys.
+    struct ChildCursor {
+        ChunkPtr chunk;
+        // The join keys, whose const columns are unpacked.
+        Columns keys;
+        // The data columns of the keys.
+        std::vector<const Column*> key_data;
+        size_t row = 0;
+        bool eos = false;
+
+        bool has_row() const { return chunk != nullptr && row < chunk->num_rows(); }
+    };
+
+    bool _output_build_columns() const {
+        return _join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_OUTER_JOIN;
+    }
+
+    // Fetch the next non-empty chunk of the child into the cursor if all its rows have been consumed.
+    Status _fetch_if_needed(RuntimeState* state, int child_idx, ChildCursor* cursor,
+                            const std::vector<ExprContext*>& key_ctxs);
+
+    static void _set_keys(Columns keys, Columns* dst_keys, std::vector<const Column*>* dst_key_data);
+    static bool _has_null_key(const Columns& keys, size_t row);
+    static int _compare_keys(const std::vector<const Column*>& lhs, size_t lhs_row,
+                             const std::vector<const Column*>& rhs, size_t rhs_row);
+
+    // Skip the right rows less than the current left row, and buffer the right rows equal to it as the group.
+    Status _seek_build_group(RuntimeState* state);
+    void _append_to_build_group(size_t from, size_t size);
+    void _reset_build_group();
+
+    void _init_output_chunk();
+    // Append the pending joined rows of the current left chunk and the build group to the output chunk.
+    void _flush_joined_rows();
+    size_t _num_output_rows() const { return _output_chunk->num_rows() + _probe_index.size(); }
+
+    TJoinOp::type _join_type = TJoinOp::INNER_JOIN;
+
+    std::vector<ExprContext*> _left_expr_ctxs;
+    std::vector<ExprContext*> _right_expr_ctxs;
+    std::vector<ExprContext*> _other_join_conjunct_ctxs;
+
+    std::vector<SlotDescriptor*> _probe_slots;
+    std::vector<SlotDescriptor*> _build_slots;
+    std::vector<TupleId> _output_probe_tuple_ids;
+    std::vector<TupleId> _output_build_tuple_ids;
+
+    ChildCursor _left;
+    ChildCursor _right;
+
+    // The buffered right rows with the same keys, whose row 0 is a null row to be joined with the unmatched
+    // left rows of LEFT_OUTER_JOIN, so the real rows are [_build_group_start, num_rows()).
+    ChunkPtr _build_group;
+    size_t _build_group_start = 0;
+    // The keys of the build group, which have one row.
+    Columns _build_group_keys;
+    std::vector<const Column*> _build_group_key_data;
+    bool _has_build_group = false;
+    // The rows of the build group which have been joined with the current left row, if the joined rows
+    // of a left row don't fit in one output chunk.
+    size_t _build_group_offset = 0;
+
+    ChunkPtr _output_chunk;
+    // The pending joined rows, the row of the current left chunk and the row of the build group.
+    std::vector<uint32_t> _probe_index;
+    std::vector<uint32_t> _build_index;
+
+    bool _eos = false;
+
+    RuntimeProfile::Counter* _join_timer = nullptr;
+    RuntimeProfile::Counter* _probe_rows_counter = nullptr;
+    RuntimeProfile::Counter* _build_rows_counter = nullptr;
+    RuntimeProfile::Counter* _build_group_rows_counter = nullptr;
+};
+
+} // namespace starrocks::vectorized
@@ -82,206 +82,132 @@ Status MysqlScanNode::open(RuntimeState* state) {
     RETURN_IF_ERROR(_mysql_scanner->open());
     RETURN_IF_ERROR(_mysql_scanner->query(_table_name, _columns, _filters));
     // check materialize slot num
-    int materialize_num = 0;
-
+    // because the fe planner filter the non_materialize column
+    _materialized_slots.clear();
     for (const auto& slot : _tuple_desc->slots()) {
         if (slot->is_materialized()) {
-            materialize_num++;
+            _materialized_slots.emplace_back(slot);
         }
     }
 
-    if (_mysql_scanner->field_num() != materialize_num) {
+    if (_mysql_scanner->field_num() != static_cast<int>(_materialized_slots.size())) {
         return Status::InternalError("input and output not equal.");
     }
+    _field_texts.clear();
+    for (size_t i = 0; i < _materialized_slots.size(); i++) {
+        _field_texts.emplace_back(BinaryColumn::create());
+    }
+    _field_nulls.resize(_materialized_slots.size());
 
     return Status::OK();
 }
 
-Status MysqlScanNode::append_text_to_column(const char* data, const int& len, const SlotDescriptor* slot_desc,
-                                            Column* column) {
-    // only \N will be treated as NULL
-    if (slot_desc->is_nullable()) {
-        if (len == 2 && data[0] == '\\' && data[1] == 'N') {
-            column->append_nulls(1);
-            return Status::OK();
-        }
-    }
-
-    Column* data_column = column;
-    if (data_column->is_nullable()) {
-        auto* nullable_column = down_cast<NullableColumn*>(data_column);
-        data_column = nullable_column->data_column().get();
+// Parse a MySQL text field to |value|, return false if it's malformed.
+template <PrimitiveType PT>
+static bool parse_text(const Slice& text, const TypeDescriptor& type, RunTimeCppType<PT>* value) {
+    const char* data = text.data;
+    int len = static_cast<int>(text.size);
+    StringParser::ParseResult parse_result = StringParser::PARSE_SUCCESS;
+    if constexpr (PT == TYPE_BOOLEAN) {
+        *value = StringParser::string_to_bool(data, len, &parse_result);
+    } else if constexpr (PT == TYPE_TINYINT || PT == TYPE_SMALLINT || PT == TYPE_INT || PT == TYPE_BIGINT ||
+                         PT == TYPE_LARGEINT) {
+        *value = StringParser::string_to_int<RunTimeCppType<PT>>(data, len, &parse_result);
+    } else if constexpr (PT == TYPE_FLOAT || PT == TYPE_DOUBLE) {
+        *value = StringParser::string_to_float<RunTimeCppType<PT>>(data, len, &parse_result);
+    } else if constexpr (PT == TYPE_DATE || PT == TYPE_DATETIME) {
+        return value->from_string(data, len);
+    } else if constexpr (PT == TYPE_DECIMALV2) {
+        return value->parse_from_str(data, len) == DecimalError::E_DEC_OK;
+    } else {
+        static_assert(PT == TYPE_DECIMAL32 || PT == TYPE_DECIMAL64 || PT == TYPE_DECIMAL128);
+        return !DecimalV3Cast::from_string<RunTimeCppType<PT>>(value, type.precision, type.scale, data, len);
     }
+    return parse_result == StringParser::PARSE_SUCCESS;
+}
 
-    bool parse_success = true;
-
-    // Parse the raw-text data. Translate the text string to internal format.
-    switch (slot_desc->type().type) {
-    case TYPE_VARCHAR:
-    case TYPE_CHAR: {
-        Slice value(data, len);
-        dynamic_cast<BinaryColumn*>(data_column)->append(value);
-        break;
-    }
-    case TYPE_BOOLEAN: {
-        StringParser::ParseResult parse_result = StringParser::PARSE_SUCCESS;
-        auto value = StringParser::string_to_bool(data, len, &parse_result);
-        if (parse_result == StringParser::PARSE_SUCCESS)
-            append_value_to_column<TYPE_BOOLEAN>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_TINYINT: {
-        StringParser::ParseResult parse_result = StringParser::PARSE_SUCCESS;
-        auto value = StringParser::string_to_int<int8_t>(data, len, &parse_result);
-        if (parse_result == StringParser::PARSE_SUCCESS)
-            append_value_to_column<TYPE_TINYINT>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_SMALLINT: {
-        StringParser::ParseResult parse_result = StringParser::PARSE_SUCCESS;
-        auto value = StringParser::string_to_int<int16_t>(data, len, &parse_result);
-        if (parse_result == StringParser::PARSE_SUCCESS)
-            append_value_to_column<TYPE_SMALLINT>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_INT: {
-        StringParser::ParseResult parse_result = StringParser::PARSE_SUCCESS;
-        auto value = StringParser::string_to_int<int32_t>(data, len, &parse_result);
-        if (parse_result == StringParser::PARSE_SUCCESS)
-            append_value_to_column<TYPE_INT>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_BIGINT: {
-        StringParser::ParseResult parse_result = StringParser::PARSE_SUCCESS;
-        auto value = StringParser::string_to_int<int64_t>(data, len, &parse_result);
-        if (parse_result == StringParser::PARSE_SUCCESS)
-            append_value_to_column<TYPE_BIGINT>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_LARGEINT: {
-        StringParser::ParseResult parse_result = StringParser::PARSE_SUCCESS;
-        auto value = StringParser::string_to_int<__int128>(data, len, &parse_result);
-        if (parse_result == StringParser::PARSE_SUCCESS)
-            append_value_to_column<TYPE_LARGEINT>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_FLOAT: {
-        StringParser::ParseResult parse_result = StringParser::PARSE_SUCCESS;
-        auto value = StringParser::string_to_float<float>(data, len, &parse_result);
-        if (parse_result == StringParser::PARSE_SUCCESS)
-            append_value_to_column<TYPE_FLOAT>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_DOUBLE: {
-        StringParser::ParseResult parse_result = StringParser::PARSE_SUCCESS;
-        auto value = StringParser::string_to_float<double>(data, len, &parse_result);
-        if (parse_result == StringParser::PARSE_SUCCESS)
-            append_value_to_column<TYPE_DOUBLE>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_DATE: {
-        DateValue value{};
-        if (value.from_string(data, len))
-            append_value_to_column<TYPE_DATE>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_DATETIME: {
-        TimestampValue value{};
-        if (value.from_string(data, len))
-            append_value_to_column<TYPE_DATETIME>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_DECIMALV2: {
-        DecimalV2Value value;
-        if (value.parse_from_str(data, len) == DecimalError::E_DEC_OK)
-            append_value_to_column<TYPE_DECIMALV2>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_DECIMAL32: {
-        int32_t value;
-        if (!DecimalV3Cast::from_string<int32_t>(&value, slot_desc->type().precision, slot_desc->type().scale, data,
-                                                 len))
-            append_value_to_column<TYPE_DECIMAL32>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_DECIMAL64: {
-        int64_t value;
-        if (!DecimalV3Cast::from_string<int64_t>(&value, slot_desc->type().precision, slot_desc->type().scale, data,
-                                                 len))
-            append_value_to_column<TYPE_DECIMAL64>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    case TYPE_DECIMAL128: {
-        int128_t value;
-        if (!DecimalV3Cast::from_string<int128_t>(&value, slot_desc->type().precision, slot_desc->type().scale, data,
-                                                  len))
-            append_value_to_column<TYPE_DECIMAL128>(data_column, value);
-        else
-            parse_success = false;
-        break;
-    }
-    default:
-        parse_success = false;
-        DCHECK(false) << "bad column type: " << slot_desc->type();
-        break;
-    }
+// Append the text fields of a batch of rows to |column|, converting them by a loop of the type of the column.
+template <PrimitiveType PT>
+static Status append_texts(const SlotDescriptor* slot_desc, const BinaryColumn& texts,
+                           const std::vector<uint8_t>& nulls, Column* column) {
+    const size_t num_rows = texts.size();
+    auto* nullable_column = column->is_nullable() ? down_cast<NullableColumn*>(column) : nullptr;
+    Column* data_column = nullable_column != nullptr ? nullable_column->data_column().get() : column;
+    const size_t old_size = data_column->size();
+    // only \N will be treated as NULL
+    auto is_null = [&](size_t i) {
+        return nulls[i] || (slot_desc->is_nullable() && texts.get_slice(i) == Slice("\\N", 2));
+    };
 
-    if (column->is_nullable()) {
-        if (parse_success) {
-            // if parse success, data_column has been appended through 'append_value_to_column'
-            // and not we should append flag value into null_column
-            auto* nullable_column = down_cast<NullableColumn*>(column);
+    if constexpr (PT == TYPE_VARCHAR || PT == TYPE_CHAR) {
+        data_column->append(texts, 0, num_rows);
+        if (nullable_column != nullptr) {
             NullData& null_data = nullable_column->null_column_data();
-            null_data.push_back(0);
-            return Status::OK();
-        } else {
+            null_data.resize(old_size + num_rows);
+            for (size_t i = 0; i < num_rows; i++) {
+                null_data[old_size + i] = is_null(i);
+            }
+        }
+    } else {
+        auto& data = down_cast<RunTimeColumnType<PT>*>(data_column)->get_data();
+        data.resize(old_size + num_rows);
+        NullData* null_data = nullable_column != nullptr ? &nullable_column->null_column_data() : nullptr;
+        if (null_data != nullptr) {
+            null_data->resize(old_size + num_rows);
+        }
+        for (size_t i = 0; i < num_rows; i++) {
+            if (!is_null(i) && parse_text<PT>(texts.get_slice(i), slot_desc->type(), &data[old_size + i])) {
+                if (null_data != nullptr) {
+                    (*null_data)[old_size + i] = 0;
+                }
+                continue;
+            }
+            if (null_data == nullptr) {
+                std::stringstream ss;
+                ss << "mysql row data parse error, column_data_type=" << slot_desc->type().type << std::endl;
+                return Status::InternalError(ss.str());
+            }
             // if column is nullable, just append null to it when parse error
-            column->append_nulls(1);
-            return Status::OK();
+            data[old_size + i] = RunTimeCppType<PT>();
+            (*null_data)[old_size + i] = 1;
         }
     }
+    if (nullable_column != nullptr) {
+        nullable_column->update_has_null();
+    }
+    return Status::OK();
+}
 
-    if (!parse_success) {
+Status MysqlScanNode::append_texts_to_column(const SlotDescriptor* slot_desc, const BinaryColumn& texts,
+                                             const std::vector<uint8_t>& nulls, Column* column) {
+    switch (slot_desc->type().type) {
+#define APPEND_TEXTS(PT) \
+    case PT:             \
+        return append_texts<PT>(slot_desc, texts, nulls, column);
+        APPEND_TEXTS(TYPE_VARCHAR)
+        APPEND_TEXTS(TYPE_CHAR)
+        APPEND_TEXTS(TYPE_BOOLEAN)
+        APPEND_TEXTS(TYPE_TINYINT)
+        APPEND_TEXTS(TYPE_SMALLINT)
+        APPEND_TEXTS(TYPE_INT)
+        APPEND_TEXTS(TYPE_BIGINT)
+        APPEND_TEXTS(TYPE_LARGEINT)
+        APPEND_TEXTS(TYPE_FLOAT)
+        APPEND_TEXTS(TYPE_DOUBLE)
+        APPEND_TEXTS(TYPE_DATE)
+        APPEND_TEXTS(TYPE_DATETIME)
+        APPEND_TEXTS(TYPE_DECIMALV2)
+        APPEND_TEXTS(TYPE_DECIMAL32)
+        APPEND_TEXTS(TYPE_DECIMAL64)
+        APPEND_TEXTS(TYPE_DECIMAL128)
+#undef APPEND_TEXTS
+    default: {
+        DCHECK(false) << "bad column type: " << slot_desc->type();
         std::stringstream ss;
         ss << "mysql row data parse error, column_data_type=" << slot_desc->type().type << std::endl;
         return Status::InternalError(ss.str());
     }
-
-    return Status::OK();
-}
-
-template <PrimitiveType PT, typename CppType>
-void MysqlScanNode::append_value_to_column(Column* column, CppType& value) {
-    using ColumnType = typename vectorized::RunTimeColumnType<PT>;
-
-    ColumnType* runtime_column = down_cast<ColumnType*>(column);
-    runtime_column->append(value);
+    }
 }
 
 Status MysqlScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
@@ -308,72 +234,66 @@ Status MysqlScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
         (*chunk)->append_column(std::move(column), slot_desc->id());
     }
 
+    // The rows fetched by mysql_use_result are invalidated by the next fetch, so the fields of a batch of rows are
+    // copied to the texts of their columns, which are converted column by column.
+    const size_t num_fields = _materialized_slots.size();
+    for (size_t i = 0; i < num_fields; i++) {
+        _field_texts[i]->reset_column();
+        _field_nulls[i].clear();
+    }
+
     // indicates whether there are more rows to process. Set in _hbase_scanner.next().
     bool mysql_eos = false;
     int row_num = 0;
 
-    while (true) {
+    while (row_num < config::vector_chunk_size && !reached_limit()) {
         RETURN_IF_CANCELLED(state);
 
-        if (reached_limit()) {
-            _is_finished = true;
-            // if row_num is greater than 0, in this call, eos = false, and eos will be set to true
-            // in the next call
-            if (row_num == 0) {
-                *eos = true;
-            }
-            return Status::OK();
-        }
-
-        if (row_num >= config::vector_chunk_size) {
-            return Status::OK();
-        }
-
         // read mysql
         char** data = nullptr;
         size_t* length = nullptr;
         RETURN_IF_ERROR(_mysql_scanner->get_next_row(&data, &length, &mysql_eos));
         if (mysql_eos) {
-            _is_finished = true;
-            // if row_num is greater than 0, in this call, eos = false, and eos will be set to true
-            // in the next call
-            if (row_num == 0) {
-                *eos = true;
-            }
-            return Status::OK();
+            break;
         }
 
-        ++row_num;
-
-        int materialized_col_idx = -1;
-        for (size_t col_idx = 0; col_idx < _slot_num; ++col_idx) {
-            SlotDescriptor* slot_desc = slot_descs[col_idx];
-            ColumnPtr column = (*chunk)->get_column_by_slot_id(slot_desc->id());
-
-            // because the fe planner filter the non_materialize column
-            if (!slot_desc->is_materialized()) {
-                continue;
-            }
-
-            ++materialized_col_idx;
-
-            if (data[materialized_col_idx] == nullptr) {
-                if (slot_desc->is_nullable()) {
-                    column->append_nulls(1);
-                } else {
+        for (size_t i = 0; i < num_fields; ++i) {
+            if (data[i] == nullptr) {
+                const SlotDescriptor* slot_desc = _materialized_slots[i];
+                if (!slot_desc->is_nullable()) {
                     std::stringstream ss;
                     ss << "nonnull column contains NULL. table=" << _table_name << ", column=" << slot_desc->col_name();
                     return Status::InternalError(ss.str());
                 }
+                _field_texts[i]->append(Slice());
+                _field_nulls[i].push_back(1);
             } else {
-                RETURN_IF_ERROR(append_text_to_column(data[materialized_col_idx], length[materialized_col_idx],
-                                                      slot_desc, column.get()));
+                _field_texts[i]->append(Slice(data[i], length[i]));
+                _field_nulls[i].push_back(0);
             }
         }
 
+        ++row_num;
         ++_num_rows_returned;
-        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
     }
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+
+    if (mysql_eos || reached_limit()) {
+        _is_finished = true;
+        // if row_num is greater than 0, in this call, eos = false, and eos will be set to true
+        // in the next call
+        if (row_num == 0) {
+            *eos = true;
+            return Status::OK();
+        }
+    }
+
+    for (size_t i = 0; i < num_fields; ++i) {
+        const SlotDescriptor* slot_desc = _materialized_slots[i];
+        ColumnPtr column = (*chunk)->get_column_by_slot_id(slot_desc->id());
+        RETURN_IF_ERROR(append_texts_to_column(slot_desc, *_field_texts[i], _field_nulls[i], column.get()));
+    }
+    return Status::OK();
 }
 
 Status MysqlScanNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
@@ -4,6 +4,7 @@
 
 #include <memory>
 
+#include "column/binary_column.h"
 #include "column/chunk.h"
 #include "column/vectorized_fwd.h"
 #include "exec/convert_scan_node.h"
@@ -52,11 +53,9 @@ protected:
     void debug_string(int indentation_level, std::stringstream* out) const override;
 
 private:
-    Status append_text_to_column(const char* value, const int& value_length, const SlotDescriptor* slot_desc,
-                                 Column* column);
-
-    template <PrimitiveType PT, typename CppType = RunTimeCppType<PT>>
-    void append_value_to_column(Column* column, CppType& value);
+    // Convert the text fields of a batch of rows of |slot_desc|, which are NULL if |nulls| are set, to |column|.
+    Status append_texts_to_column(const SlotDescriptor* slot_desc, const BinaryColumn& texts,
+                                  const std::vector<uint8_t>& nulls, Column* column);
 
     bool _is_init;
     bool _is_finished = false;
@@ -75,6 +74,11 @@ private:
 
     // Descriptor of tuples read from MySQL table.
     const TupleDescriptor* _tuple_desc;
+    // The slots of the fields of the rows, i.e. the materialized slots.
+    std::vector<const SlotDescriptor*> _materialized_slots;
+    // The texts of the fields of each slot of the rows of a chunk, and whether they are NULL.
+    std::vector<BinaryColumn::Ptr> _field_texts;
+    std::vector<std::vector<uint8_t>> _field_nulls;
     // Tuple index in tuple row.
     size_t _slot_num = 0;
     // Pool for allocating tuple data, including all varying-length slots.
@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/olap_global_dict.h"
+
+#include "gutil/strings/substitute.h"
+#include "runtime/descriptors.h"
+#include "storage/tablet.h"
+
+namespace starrocks::vectorized {
+
+std::vector<SlotDescriptor*> slots_without_global_dicts(const std::vector<SlotDescriptor*>& slots,
+                                                        const GlobalDicts& slot_dicts) {
+    std::vector<SlotDescriptor*> result;
+    result.reserve(slots.size());
+    for (SlotDescriptor* slot : slots) {
+        if (slot_dicts.count(slot->id()) == 0) {
+            result.emplace_back(slot);
+        }
+    }
+    return result;
+}
+
+Status build_column_global_dicts(const Tablet& tablet, bool skip_aggregation,
+                                 const std::vector<SlotDescriptor*>& slots, const GlobalDicts& slot_dicts,
+                                 GlobalDicts* column_dicts) {
+    if (slot_dicts.empty()) {
+        return Status::OK();
+    }
+    const KeysType keys_type = tablet.keys_type();
+    const bool need_merge = keys_type != DUP_KEYS && keys_type != PRIMARY_KEYS && !skip_aggregation;
+    for (const SlotDescriptor* slot : slots) {
+        auto iter = slot_dicts.find(slot->id());
+        if (iter == slot_dicts.end()) {
+            continue;
+        }
+        int32_t index = tablet.field_index(slot->col_name());
+        if (index < 0) {
+            return Status::InternalError(strings::Substitute("invalid field name: $0", slot->col_name()));
+        }
+        const TabletColumn& column = tablet.tablet_schema().column(index);
+        if (column.type() != OLAP_FIELD_TYPE_VARCHAR && column.type() != OLAP_FIELD_TYPE_CHAR) {
+            return Status::InternalError(
+                    strings::Substitute("the global dict of a non-string column: $0", slot->col_name()));
+        }
+        if (need_merge) {
+            return Status::NotSupported(
+                    strings::Substitute("the global dict of a merged column: $0", slot->col_name()));
+        }
+        column_dicts->emplace(index, iter->second);
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,28 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "common/status.h"
+#include "runtime/vectorized/global_dict.h"
+
+namespace starrocks {
+class SlotDescriptor;
+class Tablet;
+} // namespace starrocks
+
+namespace starrocks::vectorized {
+
+// The slots in |slot_dicts| are read as the ids of their global dicts, so their conjuncts are evaluated on
+// the ids by the scan, instead of being pushed down to the storage like the ones on the strings.
+std::vector<SlotDescriptor*> slots_without_global_dicts(const std::vector<SlotDescriptor*>& slots,
+                                                        const GlobalDicts& slot_dicts);
+
+// Maps the global dicts of |slots| to the ids of the columns of |tablet|. The ids don't keep the order of the
+// strings, so the columns which are merged or aggregated by the storage can't be read as the ids.
+Status build_column_global_dicts(const Tablet& tablet, bool skip_aggregation,
+                                 const std::vector<SlotDescriptor*>& slots, const GlobalDicts& slot_dicts,
+                                 GlobalDicts* column_dicts);
+
+} // namespace starrocks::vectorized
@@ -12,6 +12,7 @@
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/scan_operator.h"
+#include "exec/vectorized/olap_global_dict.h"
 #include "exec/vectorized/olap_scan_prepare.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
@@ -24,7 +25,10 @@
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/runtime_column_predicate.h"
+#include "util/fair_thread_pool.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/query_trace.h"
 
 namespace starrocks::vectorized {
 
@@ -42,6 +46,9 @@ Status OlapScanNode::init(const TPlanNode& tnode, RuntimeState* state) {
         _max_scan_key_num = config::doris_max_scan_key_num;
     }
 
+    if (tnode.olap_scan_node.__isset.global_dicts) {
+        RETURN_IF_ERROR(parse_global_dicts(tnode.olap_scan_node.global_dicts, &_global_dicts));
+    }
     return Status::OK();
 }
 
@@ -110,6 +117,10 @@ Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
 
     (*chunk).reset();
 
+    if (!_late_runtime_filters.empty()) {
+        _publish_late_runtime_filters();
+    }
+
     Status status = _get_status();
     if (!status.ok()) {
         *eos = true;
@@ -118,16 +129,21 @@ Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
 
     {
         std::unique_lock<std::mutex> l(_mtx);
-        const int32_t num_closed = _closed_scanners.load(std::memory_order_acquire);
         const int32_t num_pending = _pending_scanners.size();
-        const int32_t num_running = _num_scanners - num_pending - num_closed;
-        if ((num_pending > 0) && (num_running < kMaxConcurrency)) {
+        const int32_t num_running = _num_running_scanners();
+        const int32_t concurrency = _adjust_scanner_concurrency(num_running);
+        if ((num_pending > 0) && (num_running < concurrency)) {
             // before we submit a new scanner to run, check whether it can fetch
             // at least _chunks_per_scanner chunks from _chunk_pool.
             if (_chunk_pool.size() >= (num_running + 1) * _chunks_per_scanner) {
                 OlapScanner* scanner = _pending_scanners.pop();
                 l.unlock();
                 (void)_submit_scanner(scanner, true);
+            } else if (_chunk_buffer_capacity < concurrency * _chunks_per_scanner) {
+                // the concurrency has grown, create the chunks for one more scanner.
+                l.unlock();
+                _fill_chunk_pool(_chunks_per_scanner, false);
+                _chunk_buffer_capacity += _chunks_per_scanner;
             }
         }
     }
@@ -145,7 +161,12 @@ Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         // is the first time of calling `get_next`, pass the second argument of `_fill_chunk_pool` as
         // true to ensure that the newly allocated column objects will be returned back into the column
         // pool.
-        _fill_chunk_pool(1, first_call);
+        if (_chunk_buffer_capacity > _chunks_per_scanner * _scanner_concurrency.load(std::memory_order_relaxed)) {
+            // the concurrency has shrunk, drop the chunk instead of putting a new one into the pool.
+            _chunk_buffer_capacity--;
+        } else {
+            _fill_chunk_pool(1, first_call);
+        }
         mem_tracker()->release(ptr->memory_usage());
         *chunk = std::shared_ptr<Chunk>(ptr);
         eval_join_runtime_filters(chunk);
@@ -201,6 +222,8 @@ Status OlapScanNode::close(RuntimeState* state) {
     // Reduce the memory usage if the the average string size is greater than 512.
     release_large_columns<BinaryColumn>(config::vector_chunk_size * 512);
 
+    // commit the bytes consumed by this thread since open().
+    CurrentThread::set_mem_tracker(nullptr);
     return ScanNode::close(state);
 }
 
@@ -222,6 +245,7 @@ void OlapScanNode::_fill_chunk_pool(int count, bool force_column_pool) {
 void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
     CurrentThread::set_query_id(scanner->runtime_state()->query_id());
     CurrentThread::set_mem_tracker(mem_tracker());
+    SCOPED_QUERY_TRACE(scanner->runtime_state()->query_id(), "scan", "olap_scanner", scanner->tablet_id());
 
     Status status = scanner->open(_runtime_state);
     if (!status.ok()) {
@@ -274,7 +298,16 @@ void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
     Status global_status = _get_status();
     if (global_status.ok()) {
         if (status.ok() && resubmit) {
-            if (!_submit_scanner(scanner, false)) {
+            bool parked = false;
+            {
+                std::lock_guard<std::mutex> l(_mtx);
+                if (_num_running_scanners() > _scanner_concurrency.load(std::memory_order_relaxed)) {
+                    // the concurrency has shrunk, wait in _pending_scanners until get_next submits it again.
+                    _pending_scanners.push(scanner);
+                    parked = true;
+                }
+            }
+            if (!parked && !_submit_scanner(scanner, false)) {
                 std::lock_guard<std::mutex> l(_mtx);
                 _pending_scanners.push(scanner);
             }
@@ -287,7 +320,8 @@ void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
             _closed_scanners.fetch_add(1, std::memory_order_release);
             // pick next scanner to run.
             std::lock_guard<std::mutex> l(_mtx);
-            scanner = _pending_scanners.empty() ? nullptr : _pending_scanners.pop();
+            const bool can_run = _num_running_scanners() < _scanner_concurrency.load(std::memory_order_relaxed);
+            scanner = (_pending_scanners.empty() || !can_run) ? nullptr : _pending_scanners.pop();
             if (scanner != nullptr && !_submit_scanner(scanner, false)) {
                 _pending_scanners.push(scanner);
             }
@@ -310,9 +344,10 @@ void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
     if (_closed_scanners.load(std::memory_order_acquire) == _num_scanners) {
         _result_chunks.shutdown();
     }
+    // commit the bytes consumed by this thread before the tracker may be destructed.
+    CurrentThread::set_mem_tracker(nullptr);
     _running_threads.fetch_sub(1, std::memory_order_release);
     CurrentThread::set_query_id(TUniqueId());
-    CurrentThread::set_mem_tracker(nullptr);
     // DO NOT touch any shared variables since here, as they may have been destructed.
 }
 
@@ -336,12 +371,80 @@ Status OlapScanNode::collect_query_statistics(QueryStatistics* statistics) {
     return Status::OK();
 }
 
+void OlapScanNode::_add_late_runtime_filters() {
+    for (const auto& it : _runtime_filter_collector.descriptors()) {
+        const RuntimeFilterProbeDescriptor* desc = it.second;
+        SlotId slot_id;
+        if (desc->runtime_filter() != nullptr || !desc->is_probe_slot_ref(&slot_id)) {
+            continue;
+        }
+        for (const SlotDescriptor* slot : _tuple_desc->slots()) {
+            if (slot->id() != slot_id || !slot->is_materialized() || slot->type().type != desc->probe_expr_type() ||
+                !RuntimeColumnPredicate::support_type(slot->type().type) || _global_dicts.count(slot_id) > 0) {
+                continue;
+            }
+            LateRuntimeFilter filter;
+            filter.desc = desc;
+            filter.type = slot->type().type;
+            // The rows with null keys never pass a runtime filter without null.
+            filter.lower_bound = _obj_pool.add(new RuntimeColumnPredicate(slot->col_name(), false, false));
+            filter.upper_bound = _obj_pool.add(new RuntimeColumnPredicate(slot->col_name(), true, false));
+            _runtime_column_predicates.push_back(filter.lower_bound);
+            _runtime_column_predicates.push_back(filter.upper_bound);
+            _late_runtime_filters.push_back(filter);
+            break;
+        }
+    }
+}
+
+template <PrimitiveType PT>
+static void publish_runtime_filter_bounds(const JoinRuntimeFilter* rf, RuntimeColumnPredicate* lower_bound,
+                                          RuntimeColumnPredicate* upper_bound) {
+    const auto* filter = down_cast<const RuntimeBloomFilter<PT>*>(rf);
+    lower_bound->update(RuntimeColumnPredicate::format_bound(PT, Datum(filter->min_value())));
+    upper_bound->update(RuntimeColumnPredicate::format_bound(PT, Datum(filter->max_value())));
+}
+
+void OlapScanNode::_publish_late_runtime_filters() {
+    auto it = _late_runtime_filters.begin();
+    while (it != _late_runtime_filters.end()) {
+        const JoinRuntimeFilter* rf = it->desc->runtime_filter();
+        if (rf == nullptr) {
+            ++it;
+            continue;
+        }
+        if (!rf->has_null()) {
+            switch (it->type) {
+            case TYPE_TINYINT:
+                publish_runtime_filter_bounds<TYPE_TINYINT>(rf, it->lower_bound, it->upper_bound);
+                break;
+            case TYPE_SMALLINT:
+                publish_runtime_filter_bounds<TYPE_SMALLINT>(rf, it->lower_bound, it->upper_bound);
+                break;
+            case TYPE_INT:
+                publish_runtime_filter_bounds<TYPE_INT>(rf, it->lower_bound, it->upper_bound);
+                break;
+            case TYPE_BIGINT:
+                publish_runtime_filter_bounds<TYPE_BIGINT>(rf, it->lower_bound, it->upper_bound);
+                break;
+            case TYPE_DATE:
+                publish_runtime_filter_bounds<TYPE_DATE>(rf, it->lower_bound, it->upper_bound);
+                break;
+            default:
+                DCHECK(false) << "unsupported type of runtime filter: " << it->type;
+            }
+        }
+        it = _late_runtime_filters.erase(it);
+    }
+}
+
 Status OlapScanNode::_start_scan(RuntimeState* state) {
     RETURN_IF_CANCELLED(state);
 
     // 1. Convert conjuncts to ColumnValueRange in each column
     Status status;
-    RETURN_IF_ERROR(details::normalize_conjuncts(_tuple_desc->slots(), _obj_pool, _conjunct_ctxs, _normalized_conjuncts,
+    std::vector<SlotDescriptor*> slots = slots_without_global_dicts(_tuple_desc->slots(), _global_dicts);
+    RETURN_IF_ERROR(details::normalize_conjuncts(slots, _obj_pool, _conjunct_ctxs, _normalized_conjuncts,
                                                  _runtime_filter_collector, _is_null_vector, _column_value_ranges,
                                                  &status));
     if (!status.ok()) {
@@ -350,6 +453,10 @@ Status OlapScanNode::_start_scan(RuntimeState* state) {
 
     // 2. Using ColumnValueRange to Build StorageEngine filters
     RETURN_IF_ERROR(details::build_olap_filters(_column_value_ranges, _olap_filter));
+    details::normalize_like_predicates(slots, _conjunct_ctxs, _normalized_conjuncts, _olap_filter);
+
+    // 3. Prune the zone maps by the runtime filters arriving during the scan
+    _add_late_runtime_filters();
 
     // 4. Using `Key Column`'s ColumnValueRange to split ScanRange to sererval `Sub ScanRange`
     RETURN_IF_ERROR(details::build_scan_key(_olap_scan_node.key_column_name, _column_value_ranges, _scan_keys,
@@ -362,6 +469,7 @@ Status OlapScanNode::_start_scan(RuntimeState* state) {
 
 void OlapScanNode::_init_counter(RuntimeState* state) {
     _scan_timer = ADD_TIMER(_runtime_profile, "ScanTime");
+    _peak_scanner_concurrency_counter = ADD_COUNTER(_runtime_profile, "PeakScannerConcurrency", TUnit::UNIT);
 
     _scan_profile = _runtime_profile->create_child("SCAN", true, false);
 
@@ -374,6 +482,9 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _raw_rows_counter = ADD_COUNTER(_scan_profile, "RawRowsRead", TUnit::UNIT);
     _total_pages_num_counter = ADD_COUNTER(_scan_profile, "TotalPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_scan_profile, "CachedPagesNum", TUnit::UNIT);
+    _compressed_cached_pages_num_counter = ADD_COUNTER(_scan_profile, "CompressedCachedPagesNum", TUnit::UNIT);
+    _mapped_pages_num_counter = ADD_COUNTER(_scan_profile, "MappedPagesNum", TUnit::UNIT);
+    _meta_aggregated_segments_counter = ADD_COUNTER(_scan_profile, "MetaAggregatedSegments", TUnit::UNIT);
     _pushdown_predicates_counter = ADD_COUNTER(_scan_profile, "PushdownPredicates", TUnit::UNIT);
 
     /// SegmentInit
@@ -431,7 +542,60 @@ int OlapScanNode::_compute_priority(int32_t num_submitted_tasks) {
     return 0;
 }
 
+int32_t OlapScanNode::_num_running_scanners() const {
+    const int32_t num_pending = _pending_scanners.size();
+    return _num_scanners - num_pending - _closed_scanners.load(std::memory_order_acquire);
+}
+
+// Grow the concurrency by one if the consumer is waiting for the chunks, and shrink it by one if the chunks
+// pile up or the memory is running out, so the parallelism of IO follows the speed of the consumer.
+int32_t OlapScanNode::_adjust_scanner_concurrency(int32_t num_running) {
+    int32_t concurrency = _scanner_concurrency.load(std::memory_order_relaxed);
+    if (!config::enable_adaptive_scanner_concurrency) {
+        return concurrency;
+    }
+    const int64_t num_buffered = _result_chunks.get_size();
+    // the memory held by a running scanner on average
+    const int64_t scanner_bytes = mem_tracker()->consumption() / std::max(1, num_running);
+    if (mem_tracker()->spare_capacity() < scanner_bytes || num_buffered > num_running * _chunks_per_scanner / 2) {
+        concurrency = std::max(1, concurrency - 1);
+    } else if (num_buffered == 0 && num_running >= concurrency) {
+        concurrency = std::min(std::min<int32_t>(kMaxConcurrency, _num_scanners), concurrency + 1);
+    }
+    _scanner_concurrency.store(concurrency, std::memory_order_relaxed);
+    if (concurrency > _peak_scanner_concurrency_counter->value()) {
+        COUNTER_SET(_peak_scanner_concurrency_counter, concurrency);
+    }
+    return concurrency;
+}
+
+// The more chunks are buffered and not consumed yet, the less share of the scanner threads the query needs.
+int OlapScanNode::_compute_fair_weight() const {
+    const int64_t capacity = std::max(1, _chunk_buffer_capacity.load());
+    const int64_t free = std::max<int64_t>(0, capacity - static_cast<int64_t>(_result_chunks.get_size()));
+    return std::max<int>(1, kMaxFairWeight * free / capacity);
+}
+
 bool OlapScanNode::_submit_scanner(OlapScanner* scanner, bool blockable) {
+    FairThreadPool* fair_pool = _runtime_state->exec_env()->fair_scan_thread_pool();
+    if (fair_pool != nullptr) {
+        // the fragment instances of a query share the high part of the query id
+        int64_t group = _runtime_state->query_id().hi;
+        int weight = _compute_fair_weight();
+        auto func = [this, scanner] { _scanner_thread(scanner); };
+        _running_threads.fetch_add(1, std::memory_order_release);
+        if (LIKELY(fair_pool->try_offer(group, weight, func))) {
+            return true;
+        } else if (blockable) {
+            CHECK(fair_pool->offer(group, weight, func));
+            return true;
+        } else {
+            LOG(WARNING) << "thread pool busy";
+            _running_threads.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+    }
+
     PriorityThreadPool* thread_pool = _runtime_state->exec_env()->thread_pool();
     int delta = !scanner->keep_priority();
     int32_t num_submit = _scanner_submit_count.fetch_add(delta, std::memory_order_relaxed);
@@ -506,7 +670,15 @@ Status OlapScanNode::_start_scan_thread(RuntimeState* state) {
     _chunks_per_scanner = config::doris_scanner_row_num / config::vector_chunk_size;
     _chunks_per_scanner += (config::doris_scanner_row_num % config::vector_chunk_size != 0);
     int concurrency = std::min<int>(kMaxConcurrency, _num_scanners);
+    if (config::enable_adaptive_scanner_concurrency) {
+        // the parent may stop reading after a few chunks with a limit, so start with one scanner and let
+        // get_next grow the concurrency if more chunks are wanted.
+        concurrency = _limit != -1 ? 1 : concurrency;
+        _scanner_concurrency.store(concurrency, std::memory_order_relaxed);
+        COUNTER_SET(_peak_scanner_concurrency_counter, concurrency);
+    }
     int chunks = _chunks_per_scanner * concurrency;
+    _chunk_buffer_capacity = chunks;
     _chunk_pool.reserve(chunks);
     _fill_chunk_pool(chunks, true);
     std::lock_guard<std::mutex> l(_mtx);
@@ -551,9 +723,12 @@ void OlapScanNode::_close_pending_scanners() {
 pipeline::OpFactories OlapScanNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators;
-    operators.emplace_back(std::make_shared<ScanOperatorFactory>(context->next_operator_id(), id(), _olap_scan_node,
-                                                                 std::move(_conjunct_ctxs),
-                                                                 std::move(_runtime_filter_collector)));
+    auto scan_operator = std::make_shared<ScanOperatorFactory>(context->next_operator_id(), id(), _olap_scan_node,
+                                                               std::move(_conjunct_ctxs),
+                                                               std::move(_runtime_filter_collector), _global_dicts);
+    // The number of scan drivers is bounded by the number of morsels in FragmentExecutor.
+    scan_operator->set_degree_of_parallelism(context->driver_instance_count());
+    operators.emplace_back(std::move(scan_operator));
     if (limit() != -1) {
         operators.emplace_back(std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
     }
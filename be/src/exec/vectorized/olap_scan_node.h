@@ -59,10 +59,22 @@ public:
     std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
             pipeline::PipelineBuilderContext* context) override;
 
+    const TOlapScanNode& thrift_olap_scan_node() const { return _olap_scan_node; }
+
+    const std::vector<std::unique_ptr<TInternalScanRange>>& scan_ranges() const { return _scan_ranges; }
+
+    // Add a predicate whose bound is tightened by the parent during the scan, e.g. by the top-n node, it's applied
+    // to the zone maps and the rows read after each update. It must be added before open().
+    void add_runtime_column_predicate(const RuntimeColumnPredicate* predicate) {
+        _runtime_column_predicates.push_back(predicate);
+    }
+
 private:
     friend class OlapScanner;
 
     constexpr static const int kMaxConcurrency = 50;
+    // the weight of a query in the fair scan scheduler when none of its chunks are buffered.
+    constexpr static const int kMaxFairWeight = 8;
 
     template <typename T>
     class Stack {
@@ -97,6 +109,13 @@ private:
 
     void _init_counter(RuntimeState* state);
 
+    // The join runtime filters which haven't arrived when the scan starts are applied to the zone maps of
+    // the rest of the scan by a pair of runtime column predicates on their min and max values, as the filters
+    // arrived before are applied by the scan ranges.
+    void _add_late_runtime_filters();
+    // Publish the min and max values of the late runtime filters which have arrived.
+    void _publish_late_runtime_filters();
+
     void _update_status(const Status& status);
     Status _get_status();
 
@@ -104,6 +123,10 @@ private:
     bool _submit_scanner(OlapScanner* scanner, bool blockable);
     void _close_pending_scanners();
     int _compute_priority(int32_t num_submitted_tasks);
+    int _compute_fair_weight() const;
+    // _mtx must be held.
+    int32_t _num_running_scanners() const;
+    int32_t _adjust_scanner_concurrency(int32_t num_running);
 
     // params
     TOlapScanNode _olap_scan_node;
@@ -116,6 +139,16 @@ private:
     OlapScanKeys _scan_keys;                                          // from _column_value_ranges
     std::vector<TCondition> _olap_filter;                             // from _column_value_ranges
     std::vector<TCondition> _is_null_vector;                          // from expr
+    RuntimeColumnPredicates _runtime_column_predicates;               // from parent and late runtime filters
+    GlobalDicts _global_dicts;                                        // from params, by the slot ids
+
+    struct LateRuntimeFilter {
+        const RuntimeFilterProbeDescriptor* desc = nullptr;
+        PrimitiveType type = INVALID_TYPE;
+        RuntimeColumnPredicate* lower_bound = nullptr;
+        RuntimeColumnPredicate* upper_bound = nullptr;
+    };
+    std::vector<LateRuntimeFilter> _late_runtime_filters;
 
     ObjectPool _obj_pool;
 
@@ -124,6 +157,8 @@ private:
     std::vector<bool> _normalized_conjuncts;
     int32_t _num_scanners = 0;
     int32_t _chunks_per_scanner = 10;
+    // the number of chunks created for the scanners, used to compute the weight of the fair scan scheduler.
+    std::atomic<int32_t> _chunk_buffer_capacity{0};
     int32_t _max_scan_key_num = 1024;
     bool _start = false;
 
@@ -141,11 +176,15 @@ private:
     std::atomic<int32_t> _scanner_submit_count{0};
     std::atomic<int32_t> _running_threads{0};
     std::atomic<int32_t> _closed_scanners{0};
+    // the number of scanners allowed to run at the same time, adjusted by get_next if
+    // config::enable_adaptive_scanner_concurrency is on.
+    std::atomic<int32_t> _scanner_concurrency{kMaxConcurrency};
 
     // profile
     RuntimeProfile* _scan_profile = nullptr;
 
     RuntimeProfile::Counter* _scan_timer = nullptr;
+    RuntimeProfile::Counter* _peak_scanner_concurrency_counter = nullptr;
     RuntimeProfile::Counter* _capture_rowset_timer = nullptr;
     RuntimeProfile::Counter* _tablet_counter = nullptr;
     RuntimeProfile::Counter* _reader_init_timer = nullptr;
@@ -170,6 +209,9 @@ private:
     RuntimeProfile::Counter* _index_load_timer = nullptr;
     RuntimeProfile::Counter* _total_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _compressed_cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _mapped_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _meta_aggregated_segments_counter = nullptr;
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
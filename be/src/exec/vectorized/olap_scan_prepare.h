@@ -690,6 +690,64 @@ static Status build_olap_filters(const std::map<std::string, ColumnValueRangeTyp
     return Status::OK();
 }
 
+// Push down the fragments without wildcards of the LIKE patterns as the `contains` conditions, which prune the
+// pages by the n-gram bloom filter indexes, e.g. `c LIKE '%abc%def'` pushes down `contains(c, 'abc')` and
+// `contains(c, 'def')`. They're only index filters, so the LIKE predicates are still evaluated by the scan node.
+static void normalize_like_predicates(const std::vector<SlotDescriptor*>& slots,
+                                      const std::vector<ExprContext*>& conjunct_ctxs,
+                                      const std::vector<bool>& normalized_conjuncts,
+                                      std::vector<TCondition>& olap_filter) {
+    for (size_t i = 0; i < conjunct_ctxs.size(); i++) {
+        if (normalized_conjuncts[i]) {
+            continue;
+        }
+        Expr* root_expr = conjunct_ctxs[i]->root();
+        if (root_expr->node_type() != TExprNodeType::FUNCTION_CALL || root_expr->fn().name.function_name != "like" ||
+            root_expr->get_num_children() != 2) {
+            continue;
+        }
+        Expr* l = root_expr->get_child(0);
+        Expr* r = root_expr->get_child(1);
+        if (l->node_type() != TExprNodeType::SLOT_REF || !r->is_constant()) {
+            continue;
+        }
+        std::vector<SlotId> slot_ids;
+        if (l->get_slot_ids(&slot_ids) != 1) {
+            continue;
+        }
+        auto slot = std::find_if(slots.begin(), slots.end(), [&](const SlotDescriptor* s) {
+            return s->id() == slot_ids[0] && s->type().is_string_type();
+        });
+        if (slot == slots.end()) {
+            continue;
+        }
+
+        ColumnPtr column_ptr = conjunct_ctxs[i]->evaluate(r, nullptr);
+        if (column_ptr == nullptr || column_ptr->size() != 1 || column_ptr->only_null() || column_ptr->is_null(0)) {
+            continue;
+        }
+        const std::string pattern = column_ptr->get(0).get_slice().to_string();
+        // The escaped wildcards are not worth handling.
+        if (pattern.find('\\') != std::string::npos) {
+            continue;
+        }
+        size_t start = 0;
+        while (start < pattern.size()) {
+            size_t end = pattern.find_first_of("%_", start);
+            end = (end == std::string::npos) ? pattern.size() : end;
+            if (end > start) {
+                TCondition contains;
+                contains.column_name = (*slot)->col_name();
+                contains.condition_op = "contains";
+                contains.condition_values.emplace_back(pattern.substr(start, end - start));
+                contains.__set_is_index_filter_only(true);
+                olap_filter.emplace_back(std::move(contains));
+            }
+            start = end + 1;
+        }
+    }
+}
+
 // Try to convert the ranges predicates applied on key columns to in predicates to increase
 // the scan concurrency, i.e, the number of OlapScanners.
 // For example, if the original query is `select * from t where c0 between 1 and 3 and c1 between 12 and 13`,
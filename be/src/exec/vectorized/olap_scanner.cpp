@@ -2,17 +2,23 @@
 
 #include "exec/vectorized/olap_scanner.h"
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
 
 #include "column/column_helper.h"
 #include "column/column_pool.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exec/vectorized/olap_global_dict.h"
 #include "exec/vectorized/olap_scan_node.h"
 #include "runtime/current_mem_tracker.h"
 #include "storage/storage_engine.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/predicate_parser.h"
 #include "storage/vectorized/projection_iterator.h"
+#include "util/starrocks_metrics.h"
+#include "util/time.h"
 
 namespace starrocks::vectorized {
 
@@ -25,19 +31,30 @@ Status OlapScanner::init(RuntimeState* runtime_state, const OlapScannerParams& p
 
     RETURN_IF_ERROR(Expr::clone_if_not_exists(*params.conjunct_ctxs, runtime_state, &_conjunct_ctxs));
     RETURN_IF_ERROR(_get_tablet(params.scan_range));
-    RETURN_IF_ERROR(_init_return_columns());
+    if (!_parent->_olap_scan_node.pushdown_aggs.empty()) {
+        if (!_conjunct_ctxs.empty()) {
+            return Status::NotSupported("pushdown aggregates with the conjuncts not pushed down to the storage");
+        }
+        RETURN_IF_ERROR(_init_pushdown_aggs());
+    } else {
+        RETURN_IF_ERROR(_init_return_columns());
+        RETURN_IF_ERROR(build_column_global_dicts(*_tablet, _skip_aggregation, _query_slots,
+                                                  _parent->_global_dicts, &_global_dicts));
+    }
     RETURN_IF_ERROR(_init_reader_params(params.key_ranges));
+    _init_shared_scan();
     const TabletSchema& tablet_schema = _tablet->tablet_schema();
-    Schema child_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, _reader_columns);
+    Schema child_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, _reader_columns, _global_dicts);
     _reader = std::make_shared<Reader>(std::move(child_schema));
     if (_reader_columns.size() == _scanner_columns.size()) {
         _prj_iter = _reader;
     } else {
-        Schema output_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, _scanner_columns);
+        Schema output_schema =
+                ChunkHelper::convert_schema_to_format_v2(tablet_schema, _scanner_columns, _global_dicts);
         _prj_iter = new_projection_iterator(output_schema, _reader);
     }
 
-    if (!_conjunct_ctxs.empty() || !_predicates.empty()) {
+    if (!_conjunct_ctxs.empty() || !_predicates.empty() || !_parent->_runtime_column_predicates.empty()) {
         _expr_filter_timer = ADD_TIMER(_parent->_runtime_profile, "ExprFilterTime");
     }
     return Status::OK();
@@ -50,7 +67,16 @@ Status OlapScanner::open([[maybe_unused]] RuntimeState* runtime_state) {
 
     SCOPED_TIMER(_parent->_reader_init_timer);
 
-    Status res = _reader->init(_params);
+    Status res;
+    if (_use_shared_scan) {
+        auto consumer = SharedScanManager::instance()->attach(_shared_scan_key(), _reader->schema(), _params);
+        res = consumer.status();
+        if (res.ok()) {
+            _shared_scan = std::move(consumer).value();
+        }
+    } else {
+        res = _reader->init(_params);
+    }
     if (!res.ok()) {
         std::stringstream ss;
         ss << "failed to initialize storage reader. tablet=" << _params.tablet->full_name()
@@ -59,6 +85,7 @@ Status OlapScanner::open([[maybe_unused]] RuntimeState* runtime_state) {
         return Status::InternalError(ss.str().c_str());
     }
     _is_open = true;
+    _open_time_ns = MonotonicNanos();
     return Status::OK();
 }
 
@@ -66,8 +93,12 @@ Status OlapScanner::close(RuntimeState* state) {
     if (_is_closed) {
         return Status::OK();
     }
+    if (_is_open) {
+        StarRocksMetrics::instance()->tablet_scan_latency_us.add((MonotonicNanos() - _open_time_ns) / 1000);
+    }
     _prj_iter->close();
     update_counter();
+    _shared_scan.reset();
     _reader.reset();
     Expr::close(_conjunct_ctxs, state);
     // Reduce the memory usage if the the average string size is greater than 512.
@@ -106,6 +137,10 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
     _params.need_agg_finalize = _need_agg_finalize;
     _params.use_page_cache = !config::disable_storage_page_cache;
     _params.chunk_size = config::vector_chunk_size;
+    _params.read_ahead_pages = config::segment_read_ahead_pages;
+    if (!_global_dicts.empty()) {
+        _params.global_dicts = &_global_dicts;
+    }
 
     PredicateParser parser(_tablet->tablet_schema());
 
@@ -130,6 +165,26 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
         }
     }
 
+    // The runtime predicates on the columns of aggregation could only be applied to the rows after aggregation,
+    // which are filtered by `get_chunk`. They're only optional filters, so they're ignored by the pushdown
+    // aggregates, whose output has no columns to apply them.
+    for (auto* runtime_pred : _parent->_runtime_column_predicates) {
+        if (!_pushdown_aggs.empty()) {
+            break;
+        }
+        int32_t index = _tablet->field_index(runtime_pred->column_name());
+        // The bounds are strings, but the column is read as the global dict ids.
+        if (_global_dicts.count(index) > 0) {
+            continue;
+        }
+        const TabletColumn& column = _tablet->tablet_schema().column(index);
+        if (_tablet->keys_type() == KeysType::PRIMARY_KEYS ||
+            column.aggregation() == FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE) {
+            _params.runtime_predicates.push_back(runtime_pred);
+        }
+    }
+    _runtime_predicate_versions.resize(_parent->_runtime_column_predicates.size(), 0);
+
     // Range
     for (auto key_range : *key_ranges) {
         if (key_range->begin_scan_range.size() == 1 && key_range->begin_scan_range.get_value(0) == NEGATIVE_INFINITY) {
@@ -144,6 +199,31 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
     }
 
     // Return columns
+    if (!_pushdown_aggs.empty()) {
+        // The predicate columns are read to filter the rows of the segments not answered by the metadata.
+        for (const auto& p : _predicate_free_pool) {
+            _scanner_columns.push_back(p->column_id());
+        }
+        std::sort(_scanner_columns.begin(), _scanner_columns.end());
+        _scanner_columns.erase(std::unique(_scanner_columns.begin(), _scanner_columns.end()), _scanner_columns.end());
+
+        // The non-pushed-down predicates are evaluated on the rows, so the segments can't be answered by the
+        // metadata.
+        if (_predicates.empty()) {
+            const TabletSchema& tablet_schema = _tablet->tablet_schema();
+            std::vector<ColumnId> min_max_columns;
+            for (const PushdownAgg& agg : _pushdown_aggs) {
+                if (agg.op != TPushdownAggOp::COUNT) {
+                    min_max_columns.push_back(agg.column);
+                }
+            }
+            std::sort(min_max_columns.begin(), min_max_columns.end());
+            min_max_columns.erase(std::unique(min_max_columns.begin(), min_max_columns.end()), min_max_columns.end());
+            Schema min_max_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, min_max_columns);
+            _meta_aggregates = std::make_unique<MetaAggregates>(min_max_schema);
+            _params.meta_aggregates = _meta_aggregates.get();
+        }
+    }
 
     if (_skip_aggregation) {
         _reader_columns = _scanner_columns;
@@ -164,6 +244,71 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
     return Status::OK();
 }
 
+void OlapScanner::_init_shared_scan() {
+    // The pushdown aggregates and the global dicts are of each query.
+    if (!config::enable_shared_scan || !_pushdown_aggs.empty() || !_global_dicts.empty() ||
+        _reader_columns.size() != _scanner_columns.size()) {
+        return;
+    }
+    _use_shared_scan = true;
+    // The predicates are evaluated on the chunks of the shared reader by each scan, and the ones only for the
+    // index filtering are redundant then. The runtime predicates are still evaluated by get_chunk().
+    for (const ColumnPredicate* p : _params.predicates) {
+        if (!p->is_index_filter_only()) {
+            _predicates.add(p);
+        }
+    }
+    _params.predicates.clear();
+    _params.runtime_predicates.clear();
+}
+
+std::string OlapScanner::_shared_scan_key() const {
+    std::stringstream ss;
+    ss << _params.to_string() << " need_agg_finalize=" << _params.need_agg_finalize
+       << " use_page_cache=" << _params.use_page_cache << " chunk_size=" << _params.chunk_size << " columns=";
+    for (uint32_t cid : _reader_columns) {
+        ss << cid << ",";
+    }
+    return ss.str();
+}
+
+Status OlapScanner::_read_chunk(Chunk* chunk) {
+    if (!_use_shared_scan) {
+        return _prj_iter->get_next(chunk);
+    }
+    if (_shared_scan != nullptr) {
+        Status st = _shared_scan->get_next(chunk);
+        if (!st.is_end_of_file()) {
+            return st;
+        }
+        _shared_begin_row = _shared_scan->begin_row();
+        _shared_end_row = _shared_scan->end_row();
+        _shared_reached_end = _shared_scan->reached_end();
+        _shared_scan.reset();
+        // The rows before the shared scan are all read by it, nothing is left to read.
+        if (_shared_begin_row == 0 && _shared_reached_end) {
+            return Status::EndOfFile("end of the shared scan");
+        }
+        RETURN_IF_ERROR(_reader->init(_params));
+    }
+    if (_shared_reached_end && _private_rows_read >= _shared_begin_row) {
+        return Status::EndOfFile("end of the rows not read by the shared scan");
+    }
+    RETURN_IF_ERROR(_prj_iter->get_next(chunk));
+    // Skip the rows read from the shared scan.
+    int64_t first_row = _private_rows_read;
+    auto num_rows = static_cast<int64_t>(chunk->num_rows());
+    _private_rows_read += num_rows;
+    int64_t skip_begin = std::max(first_row, _shared_begin_row);
+    int64_t skip_end = std::min(first_row + num_rows, _shared_end_row);
+    if (skip_begin < skip_end) {
+        _selection.assign(num_rows, 1);
+        std::fill(_selection.begin() + (skip_begin - first_row), _selection.begin() + (skip_end - first_row), 0);
+        chunk->filter(_selection);
+    }
+    return Status::OK();
+}
+
 Status OlapScanner::_init_return_columns() {
     for (auto slot : _parent->_tuple_desc->slots()) {
         if (!slot->is_materialized()) {
@@ -188,13 +333,149 @@ Status OlapScanner::_init_return_columns() {
     return Status::OK();
 }
 
+Status OlapScanner::_init_pushdown_aggs() {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    for (const TPushdownAgg& t_agg : _parent->_olap_scan_node.pushdown_aggs) {
+        PushdownAgg agg;
+        agg.op = t_agg.op;
+        agg.slot_id = t_agg.slot_id;
+        std::string name = "pushdown_agg_" + std::to_string(t_agg.slot_id);
+        ColumnId id = _pushdown_aggs.size();
+        if (agg.op == TPushdownAggOp::COUNT) {
+            _pushdown_schema.append(std::make_shared<Field>(id, name, get_type_info(OLAP_FIELD_TYPE_BIGINT), false));
+        } else {
+            int32_t index = _tablet->field_index(t_agg.column_name);
+            if (index < 0) {
+                return Status::InternalError("invalid field name: " + t_agg.column_name);
+            }
+            agg.column = index;
+            Field field = ChunkHelper::convert_field_to_format_v2(index, tablet_schema.column(index));
+            _pushdown_schema.append(std::make_shared<Field>(id, name, field.type(), true));
+            _scanner_columns.push_back(index);
+        }
+        _pushdown_aggs.push_back(std::move(agg));
+    }
+    // For COUNT(*) only, the first column is read for the rows not answered by the metadata.
+    if (_scanner_columns.empty()) {
+        _scanner_columns.push_back(0);
+    }
+    std::sort(_scanner_columns.begin(), _scanner_columns.end());
+    _scanner_columns.erase(std::unique(_scanner_columns.begin(), _scanner_columns.end()), _scanner_columns.end());
+    return Status::OK();
+}
+
+void OlapScanner::_update_pushdown_aggs(const Chunk& rows) {
+    for (PushdownAgg& agg : _pushdown_aggs) {
+        if (agg.op == TPushdownAggOp::COUNT) {
+            continue;
+        }
+        const Column* column = rows.get_column_by_id(agg.column).get();
+        // Compare the data columns, the columns of the rows and the ones of the metadata differ in nullability.
+        const Column* data = column;
+        if (column->is_nullable()) {
+            data = down_cast<const NullableColumn*>(column)->data_column().get();
+        }
+        if (agg.value == nullptr) {
+            agg.value = data->clone_empty();
+        }
+        for (size_t i = 0; i < column->size(); i++) {
+            if (column->is_null(i)) {
+                continue;
+            }
+            if (!agg.value->empty()) {
+                int r = data->compare_at(i, 0, *agg.value, 1);
+                if (agg.op == TPushdownAggOp::MIN ? r >= 0 : r <= 0) {
+                    continue;
+                }
+                agg.value->resize(0);
+            }
+            agg.value->append(*data, i, 1);
+        }
+    }
+}
+
+Status OlapScanner::_get_pushdown_chunk(RuntimeState* state, Chunk* chunk) {
+    if (_pushdown_done) {
+        return Status::EndOfFile("no more partial aggregates");
+    }
+    ChunkPtr rows = ChunkHelper::new_chunk(_prj_iter->schema(), _params.chunk_size);
+    while (true) {
+        if (state->is_cancelled()) {
+            return Status::Cancelled("canceled state");
+        }
+        rows->reset();
+        Status status = _prj_iter->get_next(rows.get());
+        if (status.is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(status);
+        if (!_predicates.empty()) {
+            SCOPED_TIMER(_expr_filter_timer);
+            size_t nrows = rows->num_rows();
+            _selection.resize(nrows);
+            _predicates.evaluate(rows.get(), _selection.data(), 0, nrows);
+            rows->filter(_selection);
+        }
+        _pushdown_count += rows->num_rows();
+        _update_pushdown_aggs(*rows);
+        _update_realtime_counter();
+    }
+    if (_meta_aggregates != nullptr) {
+        _pushdown_count += _meta_aggregates->count();
+        _update_pushdown_aggs(*_meta_aggregates->min_max_rows());
+    }
+
+    for (size_t i = 0; i < _pushdown_aggs.size(); i++) {
+        const PushdownAgg& agg = _pushdown_aggs[i];
+        Column* column = chunk->get_column_by_index(i).get();
+        if (agg.op == TPushdownAggOp::COUNT) {
+            column->append_datum(Datum(_pushdown_count));
+        } else if (agg.value == nullptr || agg.value->empty()) {
+            column->append_nulls(1);
+        } else {
+            column->append_datum(agg.value->get(0));
+        }
+        chunk->set_slot_id_to_index(agg.slot_id, i);
+    }
+    _pushdown_done = true;
+    return Status::OK();
+}
+
+void OlapScanner::_update_runtime_predicates() {
+    const RuntimeColumnPredicates& runtime_preds = _parent->_runtime_column_predicates;
+    bool updated = false;
+    for (size_t i = 0; i < runtime_preds.size(); i++) {
+        updated |= runtime_preds[i]->version() != _runtime_predicate_versions[i];
+    }
+    if (!updated) {
+        return;
+    }
+    _runtime_predicates.clear();
+    _runtime_predicate_pool.clear();
+    for (size_t i = 0; i < runtime_preds.size(); i++) {
+        FieldPtr field = chunk_schema().get_field_by_name(runtime_preds[i]->column_name());
+        DCHECK(field != nullptr);
+        if (_global_dicts.count(field->id()) > 0) {
+            continue;
+        }
+        const ColumnPredicate* pred = runtime_preds[i]->new_predicate(
+                field->type(), field->id(), &_runtime_predicate_pool, &_runtime_predicate_versions[i]);
+        if (pred != nullptr) {
+            _runtime_predicates.push_back(pred);
+        }
+    }
+}
+
 Status OlapScanner::get_chunk(RuntimeState* state, Chunk* chunk) {
     if (state->is_cancelled()) {
         return Status::Cancelled("canceled state");
     }
     SCOPED_TIMER(_parent->_scan_timer);
+    if (!_pushdown_aggs.empty()) {
+        return _get_pushdown_chunk(state, chunk);
+    }
     do {
-        if (Status status = _prj_iter->get_next(chunk); !status.ok()) {
+        if (Status status = _read_chunk(chunk); !status.ok()) {
             return status;
         }
         for (auto slot : _query_slots) {
@@ -212,6 +493,27 @@ Status OlapScanner::get_chunk(RuntimeState* state, Chunk* chunk) {
             CurrentMemTracker::consume((int64_t)chunk->memory_usage() - old_mem_usage);
             DCHECK_CHUNK(chunk);
         }
+        if (!_parent->_runtime_column_predicates.empty()) {
+            _update_runtime_predicates();
+        }
+        if (!_runtime_predicates.empty() && chunk->num_rows() > 0) {
+            int64_t old_mem_usage = chunk->memory_usage();
+            SCOPED_TIMER(_expr_filter_timer);
+            size_t nrows = chunk->num_rows();
+            _selection.resize(nrows);
+            for (size_t i = 0; i < _runtime_predicates.size(); i++) {
+                const ColumnPredicate* pred = _runtime_predicates[i];
+                const Column* column = chunk->get_column_by_id(pred->column_id()).get();
+                if (i == 0) {
+                    pred->evaluate(column, _selection.data(), 0, nrows);
+                } else {
+                    pred->evaluate_and(column, _selection.data(), 0, nrows);
+                }
+            }
+            chunk->filter(_selection);
+            CurrentMemTracker::consume((int64_t)chunk->memory_usage() - old_mem_usage);
+            DCHECK_CHUNK(chunk);
+        }
         if (!_conjunct_ctxs.empty()) {
             int64_t old_mem_usage = chunk->memory_usage();
             SCOPED_TIMER(_expr_filter_timer);
@@ -227,6 +529,7 @@ Status OlapScanner::get_chunk(RuntimeState* state, Chunk* chunk) {
 void OlapScanner::_update_realtime_counter() {
     COUNTER_UPDATE(_parent->_read_compressed_counter, _reader->stats().compressed_bytes_read);
     _compressed_bytes_read += _reader->stats().compressed_bytes_read;
+    _tablet->data_dir()->compaction_io_budget()->add_query_bytes(_reader->stats().compressed_bytes_read);
     _reader->mutable_stats()->compressed_bytes_read = 0;
 
     COUNTER_UPDATE(_parent->_raw_rows_counter, _reader->stats().raw_rows_read);
@@ -244,6 +547,7 @@ void OlapScanner::update_counter() {
     COUNTER_UPDATE(_parent->_io_timer, _reader->stats().io_ns);
     COUNTER_UPDATE(_parent->_read_compressed_counter, _reader->stats().compressed_bytes_read);
     _compressed_bytes_read += _reader->stats().compressed_bytes_read;
+    _tablet->data_dir()->compaction_io_budget()->add_query_bytes(_reader->stats().compressed_bytes_read);
     COUNTER_UPDATE(_parent->_decompress_timer, _reader->stats().decompress_ns);
     COUNTER_UPDATE(_parent->_read_uncompressed_counter, _reader->stats().uncompressed_bytes_read);
     COUNTER_UPDATE(_parent->bytes_read_counter(), _reader->stats().bytes_read);
@@ -270,6 +574,11 @@ void OlapScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_total_pages_num_counter, _reader->stats().total_pages_num);
     COUNTER_UPDATE(_parent->_cached_pages_num_counter, _reader->stats().cached_pages_num);
+    COUNTER_UPDATE(_parent->_compressed_cached_pages_num_counter, _reader->stats().compressed_cached_pages_num);
+    COUNTER_UPDATE(_parent->_mapped_pages_num_counter, _reader->stats().mapped_pages_num);
+    if (_meta_aggregates != nullptr) {
+        COUNTER_UPDATE(_parent->_meta_aggregated_segments_counter, _meta_aggregates->num_segments());
+    }
 
     COUNTER_UPDATE(_parent->_bi_filtered_counter, _reader->stats().rows_bitmap_index_filtered);
     COUNTER_UPDATE(_parent->_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
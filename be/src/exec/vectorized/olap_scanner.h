@@ -5,12 +5,16 @@
 #include <vector>
 
 #include "column/chunk.h"
+#include "common/object_pool.h"
 #include "common/status.h"
 #include "exec/olap_utils.h"
+#include "exec/vectorized/shared_scan.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "gen_cpp/InternalService_types.h"
+#include "gen_cpp/PlanNodes_types.h"
 #include "runtime/runtime_state.h"
+#include "storage/rowset/vectorized/meta_aggregates.h"
 #include "storage/vectorized/conjunctive_predicates.h"
 #include "storage/vectorized/reader.h"
 #include "storage/vectorized/reader_params.h"
@@ -45,9 +49,11 @@ public:
 
     RuntimeState* runtime_state() { return _runtime_state; }
     int64_t raw_rows_read() const { return _raw_rows_read; }
+    // REQUIRES: `init(RuntimeState*, const OlapScannerParams&)` has been called.
+    int64_t tablet_id() const { return _tablet->tablet_id(); }
 
     // REQUIRES: `init(RuntimeState*, const OlapScannerParams&)` has been called.
-    const Schema& chunk_schema() const { return _prj_iter->schema(); }
+    const Schema& chunk_schema() const { return _pushdown_aggs.empty() ? _prj_iter->schema() : _pushdown_schema; }
 
     void set_keep_priority(bool v) { _keep_priority = v; }
     bool keep_priority() const { return _keep_priority; }
@@ -56,6 +62,18 @@ private:
     Status _get_tablet(const TInternalScanRange* scan_range);
     Status _init_reader_params(const std::vector<OlapScanRange*>* key_ranges);
     Status _init_return_columns();
+    Status _init_pushdown_aggs();
+    // Whether to share the reader with the concurrent scans, see config::enable_shared_scan.
+    void _init_shared_scan();
+    std::string _shared_scan_key() const;
+    // Read the next chunk of the rows of the reader, which may have no rows.
+    Status _read_chunk(Chunk* chunk);
+    // Output one row of the partial aggregates over all the rows read by |_reader| and the segments answered
+    // by |_meta_aggregates|.
+    Status _get_pushdown_chunk(RuntimeState* state, Chunk* chunk);
+    void _update_pushdown_aggs(const Chunk& rows);
+    // Rebuild |_runtime_predicates| if the bounds of the runtime predicates are tightened.
+    void _update_runtime_predicates();
     void _update_realtime_counter();
     void update_counter();
 
@@ -71,8 +89,15 @@ private:
     // for release memory.
     std::vector<PredicatePtr> _predicate_free_pool;
 
+    // The predicates of the latest bounds of the runtime predicates of |_parent|, which are owned by
+    // |_runtime_predicate_pool|.
+    std::vector<const ColumnPredicate*> _runtime_predicates;
+    std::vector<int64_t> _runtime_predicate_versions;
+    ObjectPool _runtime_predicate_pool;
+
     bool _is_open = false;
     bool _is_closed = false;
+    int64_t _open_time_ns = 0;
     bool _skip_aggregation = false;
     bool _need_agg_finalize = false;
     bool _has_update_counter = false;
@@ -80,6 +105,15 @@ private:
     ReaderParams _params;
     std::shared_ptr<Reader> _reader;
 
+    // The rows of the shared scan are read by |_shared_scan| until it's finished or detached, and then the rows
+    // not read from it, [0, _shared_begin_row) and [_shared_end_row, end), are read by |_reader|.
+    bool _use_shared_scan = false;
+    std::unique_ptr<SharedScanConsumer> _shared_scan;
+    int64_t _shared_begin_row = 0;
+    int64_t _shared_end_row = 0;
+    bool _shared_reached_end = false;
+    int64_t _private_rows_read = 0;
+
     TabletSharedPtr _tablet;
     int64_t _version = 0;
 
@@ -91,6 +125,8 @@ private:
     std::shared_ptr<ChunkIterator> _prj_iter;
     // slot descriptors for each one of |_scanner_columns|.
     std::vector<SlotDescriptor*> _query_slots;
+    // the global dicts of the columns read as the dict ids, a mapping from column id to the dict.
+    GlobalDicts _global_dicts;
 
     int64_t _num_rows_read = 0;
     int64_t _raw_rows_read = 0;
@@ -99,6 +135,23 @@ private:
     // non-pushed-down predicates filter time.
     RuntimeProfile::Counter* _expr_filter_timer = nullptr;
 
+    // The partial aggregates output instead of the rows, see TOlapScanNode.pushdown_aggs.
+    struct PushdownAgg {
+        TPushdownAggOp::type op = TPushdownAggOp::COUNT;
+        // The column of MIN and MAX.
+        ColumnId column = 0;
+        SlotId slot_id = 0;
+        // The min or the max so far, which is empty until a non-null value is met.
+        ColumnPtr value;
+    };
+    std::vector<PushdownAgg> _pushdown_aggs;
+    // The schema of the output chunk of |_pushdown_aggs|, the i-th field is of the i-th aggregate.
+    Schema _pushdown_schema;
+    // The segments answered by their metadata, it's only used if all the predicates are pushed down.
+    std::unique_ptr<MetaAggregates> _meta_aggregates;
+    int64_t _pushdown_count = 0;
+    bool _pushdown_done = false;
+
     bool _keep_priority = false;
 };
 } // namespace starrocks::vectorized
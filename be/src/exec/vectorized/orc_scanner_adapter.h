@@ -59,6 +59,8 @@ public:
                                        ColumnPtr max_col);
     Status apply_dict_filter_eval_cache(const std::unordered_map<SlotId, FilterPtr>& dict_filter_eval_cache);
     size_t get_cvb_size();
+    // the columns selected of the orc file by the column ids, call it after init.
+    std::vector<bool> get_selected_columns() const { return _row_reader->getSelectedColumns(); }
     int64_t tzoffset_in_seconds() { return _tzoffset_in_seconds; }
     const cctz::time_zone& tzinfo() { return _tzinfo; }
     void drop_nanoseconds_in_datetime() { _drop_nanoseconds_in_datetime = true; }
@@ -0,0 +1,323 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/parquet_chunk_writer.h"
+
+#include <arrow/table.h>
+#include <arrow/util/decimal.h>
+#include <parquet/properties.h>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "common/config.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/date_value.h"
+#include "runtime/large_int_value.h"
+#include "runtime/timestamp_value.h"
+
+namespace starrocks::vectorized {
+
+static Status to_status(const arrow::Status& st) {
+    if (!st.ok()) {
+        return Status::InternalError(st.ToString());
+    }
+    return Status::OK();
+}
+
+static Status to_arrow_type(const TypeDescriptor& type, std::shared_ptr<arrow::DataType>* arrow_type) {
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+        *arrow_type = arrow::boolean();
+        break;
+    case TYPE_TINYINT:
+        *arrow_type = arrow::int8();
+        break;
+    case TYPE_SMALLINT:
+        *arrow_type = arrow::int16();
+        break;
+    case TYPE_INT:
+        *arrow_type = arrow::int32();
+        break;
+    case TYPE_BIGINT:
+        *arrow_type = arrow::int64();
+        break;
+    case TYPE_FLOAT:
+        *arrow_type = arrow::float32();
+        break;
+    case TYPE_DOUBLE:
+        *arrow_type = arrow::float64();
+        break;
+    case TYPE_LARGEINT:
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        *arrow_type = arrow::utf8();
+        break;
+    case TYPE_DATE:
+        *arrow_type = arrow::date32();
+        break;
+    case TYPE_DATETIME:
+        *arrow_type = arrow::timestamp(arrow::TimeUnit::MICRO);
+        break;
+    case TYPE_DECIMALV2:
+        *arrow_type = arrow::decimal(27, 9);
+        break;
+    case TYPE_DECIMAL32:
+    case TYPE_DECIMAL64:
+    case TYPE_DECIMAL128:
+        *arrow_type = arrow::decimal(type.precision, type.scale);
+        break;
+    default:
+        return Status::NotSupported(strings::Substitute("Can't write $0 to parquet", type.debug_string()));
+    }
+    return Status::OK();
+}
+
+static arrow::Decimal128 to_decimal128(int128_t value) {
+    return arrow::Decimal128(static_cast<int64_t>(value >> 64), static_cast<uint64_t>(value));
+}
+
+template <PrimitiveType PT, typename BuilderType>
+static Status append_numbers(arrow::ArrayBuilder* builder, const Column* column, const uint8_t* valid) {
+    const auto& data = down_cast<const RunTimeColumnType<PT>*>(column)->get_data();
+    return to_status(down_cast<BuilderType*>(builder)->AppendValues(data.data(), data.size(), valid));
+}
+
+// Convert the values by |convert| into a buffer, then append them at once.
+template <PrimitiveType PT, typename BuilderType, typename ArrowCppType, typename Convert>
+static Status append_converted(arrow::ArrayBuilder* builder, const Column* column, const uint8_t* valid,
+                               Convert convert) {
+    const auto& data = down_cast<const RunTimeColumnType<PT>*>(column)->get_data();
+    std::vector<ArrowCppType> values(data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+        values[i] = convert(data[i]);
+    }
+    return to_status(down_cast<BuilderType*>(builder)->AppendValues(values.data(), values.size(), valid));
+}
+
+template <typename Get>
+static Status append_strings(arrow::ArrayBuilder* builder, size_t num_rows, size_t num_bytes, const uint8_t* valid,
+                             Get get) {
+    auto* string_builder = down_cast<arrow::StringBuilder*>(builder);
+    RETURN_IF_ERROR(to_status(string_builder->Reserve(num_rows)));
+    RETURN_IF_ERROR(to_status(string_builder->ReserveData(num_bytes)));
+    for (size_t i = 0; i < num_rows; i++) {
+        if (valid != nullptr && !valid[i]) {
+            RETURN_IF_ERROR(to_status(string_builder->AppendNull()));
+        } else {
+            Slice s = get(i);
+            RETURN_IF_ERROR(to_status(string_builder->Append(s.data, s.size)));
+        }
+    }
+    return Status::OK();
+}
+
+template <PrimitiveType PT>
+static Status append_decimals(arrow::ArrayBuilder* builder, const Column* column, const uint8_t* valid) {
+    auto* decimal_builder = down_cast<arrow::Decimal128Builder*>(builder);
+    const auto& data = down_cast<const RunTimeColumnType<PT>*>(column)->get_data();
+    RETURN_IF_ERROR(to_status(decimal_builder->Reserve(data.size())));
+    for (size_t i = 0; i < data.size(); i++) {
+        if (valid != nullptr && !valid[i]) {
+            RETURN_IF_ERROR(to_status(decimal_builder->AppendNull()));
+        } else if constexpr (PT == TYPE_DECIMALV2) {
+            RETURN_IF_ERROR(to_status(decimal_builder->Append(to_decimal128(data[i].value()))));
+        } else {
+            RETURN_IF_ERROR(to_status(decimal_builder->Append(to_decimal128(data[i]))));
+        }
+    }
+    return Status::OK();
+}
+
+ParquetOutputFile::ParquetOutputFile(std::unique_ptr<WritableFile> file) : _file(std::move(file)) {
+    set_mode(arrow::io::FileMode::WRITE);
+}
+
+ParquetOutputFile::~ParquetOutputFile() {
+    Close();
+}
+
+arrow::Status ParquetOutputFile::Write(const void* data, int64_t nbytes) {
+    Status st = _file->append(Slice(static_cast<const char*>(data), nbytes));
+    if (!st.ok()) {
+        return arrow::Status::IOError(st.get_error_msg());
+    }
+    _cur_pos += nbytes;
+    return arrow::Status::OK();
+}
+
+arrow::Status ParquetOutputFile::Tell(int64_t* position) const {
+    *position = _cur_pos;
+    return arrow::Status::OK();
+}
+
+arrow::Status ParquetOutputFile::Close() {
+    if (_is_closed) {
+        return arrow::Status::OK();
+    }
+    _is_closed = true;
+    Status st = _file->close();
+    if (!st.ok()) {
+        return arrow::Status::IOError(st.get_error_msg());
+    }
+    return arrow::Status::OK();
+}
+
+ParquetChunkWriter::ParquetChunkWriter(std::shared_ptr<arrow::io::OutputStream> output,
+                                       std::vector<TypeDescriptor> types)
+        : _output(std::move(output)), _types(std::move(types)) {}
+
+ParquetChunkWriter::~ParquetChunkWriter() {
+    close();
+}
+
+Status ParquetChunkWriter::init() {
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    for (size_t i = 0; i < _types.size(); i++) {
+        std::shared_ptr<arrow::DataType> arrow_type;
+        RETURN_IF_ERROR(to_arrow_type(_types[i], &arrow_type));
+        fields.emplace_back(arrow::field(strings::Substitute("col_$0", i), arrow_type));
+        std::unique_ptr<arrow::ArrayBuilder> builder;
+        RETURN_IF_ERROR(to_status(arrow::MakeBuilder(arrow::default_memory_pool(), arrow_type, &builder)));
+        _builders.emplace_back(std::move(builder));
+    }
+    _schema = arrow::schema(fields);
+    auto properties = parquet::WriterProperties::Builder().compression(parquet::Compression::SNAPPY)->build();
+    return to_status(
+            parquet::arrow::FileWriter::Open(*_schema, arrow::default_memory_pool(), _output, properties, &_writer));
+}
+
+Status ParquetChunkWriter::write(const Columns& columns) {
+    if (columns.size() != _types.size()) {
+        return Status::InternalError(
+                strings::Substitute("Unmatched number of columns expected=$0 real=$1", _types.size(), columns.size()));
+    }
+    if (columns.empty() || columns[0]->size() == 0) {
+        return Status::OK();
+    }
+    for (size_t i = 0; i < columns.size(); i++) {
+        RETURN_IF_ERROR(_append_column(i, columns[i]));
+    }
+    _num_buffered_rows += columns[0]->size();
+    if (_num_buffered_rows >= config::parquet_writer_row_group_rows) {
+        return _flush_row_group();
+    }
+    return Status::OK();
+}
+
+Status ParquetChunkWriter::_append_column(size_t index, const ColumnPtr& column) {
+    const TypeDescriptor& type = _types[index];
+    arrow::ArrayBuilder* builder = _builders[index].get();
+    size_t num_rows = column->size();
+    ColumnPtr col = ColumnHelper::unfold_const_column(type, num_rows, column);
+    const Column* data_column = ColumnHelper::get_data_column(col.get());
+
+    std::vector<uint8_t> valid_bytes;
+    const uint8_t* valid = nullptr;
+    if (col->is_nullable() && col->has_null()) {
+        const auto& nulls = down_cast<const NullableColumn*>(col.get())->immutable_null_column_data();
+        valid_bytes.resize(num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            valid_bytes[i] = !nulls[i];
+        }
+        valid = valid_bytes.data();
+    }
+
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+        return append_numbers<TYPE_BOOLEAN, arrow::BooleanBuilder>(builder, data_column, valid);
+    case TYPE_TINYINT:
+        return append_numbers<TYPE_TINYINT, arrow::Int8Builder>(builder, data_column, valid);
+    case TYPE_SMALLINT:
+        return append_numbers<TYPE_SMALLINT, arrow::Int16Builder>(builder, data_column, valid);
+    case TYPE_INT:
+        return append_numbers<TYPE_INT, arrow::Int32Builder>(builder, data_column, valid);
+    case TYPE_BIGINT:
+        return append_numbers<TYPE_BIGINT, arrow::Int64Builder>(builder, data_column, valid);
+    case TYPE_FLOAT:
+        return append_numbers<TYPE_FLOAT, arrow::FloatBuilder>(builder, data_column, valid);
+    case TYPE_DOUBLE:
+        return append_numbers<TYPE_DOUBLE, arrow::DoubleBuilder>(builder, data_column, valid);
+    case TYPE_DATE:
+        return append_converted<TYPE_DATE, arrow::Date32Builder, int32_t>(
+                builder, data_column, valid,
+                [](const DateValue& v) { return static_cast<int32_t>(v.julian() - date::UNIX_EPOCH_JULIAN); });
+    case TYPE_DATETIME:
+        return append_converted<TYPE_DATETIME, arrow::TimestampBuilder, int64_t>(
+                builder, data_column, valid, [](const TimestampValue& v) {
+                    Timestamp ts = v.timestamp();
+                    return (timestamp::to_julian(ts) - date::UNIX_EPOCH_JULIAN) * USECS_PER_DAY +
+                           timestamp::to_time(ts);
+                });
+    case TYPE_CHAR:
+    case TYPE_VARCHAR: {
+        const auto* binary = down_cast<const BinaryColumn*>(data_column);
+        return append_strings(builder, num_rows, binary->get_bytes().size(), valid,
+                              [binary](size_t i) { return binary->get_slice(i); });
+    }
+    case TYPE_LARGEINT: {
+        const auto& data = down_cast<const Int128Column*>(data_column)->get_data();
+        std::vector<std::string> values(num_rows);
+        size_t num_bytes = 0;
+        for (size_t i = 0; i < num_rows; i++) {
+            values[i] = LargeIntValue::to_string(data[i]);
+            num_bytes += values[i].size();
+        }
+        return append_strings(builder, num_rows, num_bytes, valid, [&values](size_t i) { return Slice(values[i]); });
+    }
+    case TYPE_DECIMALV2:
+        return append_decimals<TYPE_DECIMALV2>(builder, data_column, valid);
+    case TYPE_DECIMAL32:
+        return append_decimals<TYPE_DECIMAL32>(builder, data_column, valid);
+    case TYPE_DECIMAL64:
+        return append_decimals<TYPE_DECIMAL64>(builder, data_column, valid);
+    case TYPE_DECIMAL128:
+        return append_decimals<TYPE_DECIMAL128>(builder, data_column, valid);
+    default:
+        return Status::NotSupported(strings::Substitute("Can't write $0 to parquet", type.debug_string()));
+    }
+}
+
+Status ParquetChunkWriter::_flush_row_group() {
+    if (_num_buffered_rows == 0) {
+        return Status::OK();
+    }
+    std::vector<std::shared_ptr<arrow::Array>> arrays(_builders.size());
+    for (size_t i = 0; i < _builders.size(); i++) {
+        RETURN_IF_ERROR(to_status(_builders[i]->Finish(&arrays[i])));
+    }
+    auto table = arrow::Table::Make(_schema, arrays, _num_buffered_rows);
+    // all the rows buffered are written as one row group
+    RETURN_IF_ERROR(to_status(_writer->WriteTable(*table, _num_buffered_rows)));
+    _num_buffered_rows = 0;
+    return Status::OK();
+}
+
+Status ParquetChunkWriter::close() {
+    if (_closed) {
+        return Status::OK();
+    }
+    _closed = true;
+    Status st;
+    if (_writer != nullptr) {
+        st = _flush_row_group();
+        auto close_st = to_status(_writer->Close());
+        if (st.ok()) {
+            st = close_st;
+        }
+        _writer.reset();
+    }
+    auto close_st = to_status(_output->Close());
+    _output.reset();
+    return st.ok() ? close_st : st;
+}
+
+int64_t ParquetChunkWriter::written_bytes() const {
+    int64_t position = 0;
+    if (_output != nullptr) {
+        _output->Tell(&position);
+    }
+    return position;
+}
+
+} // namespace starrocks::vectorized
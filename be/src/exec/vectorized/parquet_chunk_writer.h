@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <arrow/builder.h>
+#include <arrow/io/interfaces.h>
+#include <parquet/arrow/writer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "env/env.h"
+#include "runtime/types.h"
+
+namespace starrocks::vectorized {
+
+// An arrow output stream over a WritableFile, which owns the file.
+class ParquetOutputFile : public arrow::io::OutputStream {
+public:
+    explicit ParquetOutputFile(std::unique_ptr<WritableFile> file);
+    ~ParquetOutputFile() override;
+
+    arrow::Status Write(const void* data, int64_t nbytes) override;
+    arrow::Status Tell(int64_t* position) const override;
+    arrow::Status Close() override;
+
+    bool closed() const override { return _is_closed; }
+
+private:
+    std::unique_ptr<WritableFile> _file;
+    int64_t _cur_pos = 0;
+    bool _is_closed = false;
+};
+
+// ParquetChunkWriter writes the columns of the chunks to a parquet file. The columns are appended to the arrow
+// builders of them column by column in bulk, and a row group is written once config::parquet_writer_row_group_rows
+// rows are buffered.
+//
+// DATE is written as date32, DATETIME as timestamp in microseconds, the decimals as decimal128 and LARGEINT
+// as string.
+class ParquetChunkWriter {
+public:
+    // |types| are the types of the columns written, the columns are named col_0, col_1, ...
+    ParquetChunkWriter(std::shared_ptr<arrow::io::OutputStream> output, std::vector<TypeDescriptor> types);
+
+    ~ParquetChunkWriter();
+
+    Status init();
+
+    // Append the rows of |columns|, which are in the order of the types.
+    Status write(const Columns& columns);
+
+    // Write the rows buffered and the footer, and close the output.
+    Status close();
+
+    // The bytes written to the output, the rows buffered are exclusive.
+    int64_t written_bytes() const;
+
+private:
+    Status _append_column(size_t index, const ColumnPtr& column);
+
+    Status _flush_row_group();
+
+    std::shared_ptr<arrow::io::OutputStream> _output;
+    std::vector<TypeDescriptor> _types;
+    std::shared_ptr<arrow::Schema> _schema;
+    std::vector<std::unique_ptr<arrow::ArrayBuilder>> _builders;
+    std::unique_ptr<parquet::arrow::FileWriter> _writer;
+    size_t _num_buffered_rows = 0;
+    bool _closed = false;
+};
+
+} // namespace starrocks::vectorized
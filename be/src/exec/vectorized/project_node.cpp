@@ -8,11 +8,13 @@
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/project_operator.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/common_sub_expr_eliminator.h"
 #include "exprs/vectorized/runtime_filter.h"
 #include "runtime/runtime_state.h"
 
@@ -36,7 +38,14 @@ Status ProjectNode::init(const TPlanNode& tnode, RuntimeState* state) {
         slot_null_mapping[slot->id()] = slot->is_nullable();
     }
 
-    for (auto const& [key, val] : tnode.project_node.slot_map) {
+    std::map<SlotId, TExpr> slot_map = tnode.project_node.slot_map;
+    CommonSubExprEliminator::CommonSubExprs common_sub_exprs(tnode.project_node.common_slot_map.begin(),
+                                                             tnode.project_node.common_slot_map.end());
+    if (config::enable_project_common_sub_expr_elimination) {
+        RETURN_IF_ERROR(CommonSubExprEliminator::eliminate(&slot_map, &common_sub_exprs));
+    }
+
+    for (auto const& [key, val] : slot_map) {
         _slot_ids.emplace_back(key);
         ExprContext* context;
         RETURN_IF_ERROR(Expr::create_expr_tree(_pool, val, &context));
@@ -44,11 +53,11 @@ Status ProjectNode::init(const TPlanNode& tnode, RuntimeState* state) {
         _type_is_nullable.emplace_back(slot_null_mapping[key]);
     }
 
-    size_t common_sub_column_size = tnode.project_node.common_slot_map.size();
+    size_t common_sub_column_size = common_sub_exprs.size();
     _common_sub_expr_ctxs.reserve(common_sub_column_size);
     _common_sub_slot_ids.reserve(common_sub_column_size);
 
-    for (auto const& [key, val] : tnode.project_node.common_slot_map) {
+    for (auto const& [key, val] : common_sub_exprs) {
         ExprContext* context;
         RETURN_IF_ERROR(Expr::create_expr_tree(_pool, val, &context));
         _common_sub_slot_ids.emplace_back(key);
@@ -0,0 +1,102 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/shared_scan.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks::vectorized {
+
+SharedScanConsumer::SharedScanConsumer(std::shared_ptr<SharedScan> scan) : _scan(std::move(scan)) {
+    std::lock_guard<std::mutex> l(_scan->_lock);
+    _seq = _scan->_first_seq;
+    _begin_row = _scan->_chunks.empty() ? _scan->_num_rows_read : _scan->_chunks.front().second;
+    _end_row = _begin_row;
+}
+
+Status SharedScanConsumer::get_next(Chunk* chunk) {
+    SharedScan* scan = _scan.get();
+    std::lock_guard<std::mutex> l(scan->_lock);
+    if (_seq < scan->_first_seq) {
+        return Status::EndOfFile("detached from the shared scan");
+    }
+    if (_seq == scan->_first_seq + static_cast<int64_t>(scan->_chunks.size())) {
+        if (scan->_eof) {
+            _reached_end = true;
+            return Status::EndOfFile("end of the shared scan");
+        }
+        RETURN_IF_ERROR(scan->_status);
+        ChunkPtr next = ChunkHelper::new_chunk(scan->_reader->schema(), scan->_params.chunk_size);
+        Status st = scan->_reader->get_next(next.get());
+        if (st.is_end_of_file()) {
+            scan->_eof = true;
+            _reached_end = true;
+            return st;
+        } else if (!st.ok()) {
+            scan->_status = st;
+            return st;
+        }
+        scan->_chunks.emplace_back(next, scan->_num_rows_read);
+        scan->_num_rows_read += next->num_rows();
+        auto max_chunks = static_cast<size_t>(std::max(1, config::shared_scan_max_buffered_chunks));
+        while (scan->_chunks.size() > max_chunks) {
+            scan->_chunks.pop_front();
+            scan->_first_seq++;
+        }
+    }
+    const auto& [src, first_row] = scan->_chunks[_seq - scan->_first_seq];
+    chunk->append(*src);
+    _seq++;
+    _end_row = first_row + src->num_rows();
+    return Status::OK();
+}
+
+SharedScanManager* SharedScanManager::instance() {
+    static SharedScanManager manager;
+    return &manager;
+}
+
+StatusOr<std::unique_ptr<SharedScanConsumer>> SharedScanManager::attach(const std::string& key, const Schema& schema,
+                                                                        const ReaderParams& params) {
+    std::shared_ptr<SharedScan> scan;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        for (auto iter = _scans.begin(); iter != _scans.end();) {
+            if (iter->second.expired()) {
+                iter = _scans.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+        auto iter = _scans.find(key);
+        if (iter != _scans.end()) {
+            scan = iter->second.lock();
+            std::lock_guard<std::mutex> sl(scan->_lock);
+            if (scan->_eof || !scan->_status.ok()) {
+                scan.reset();
+            }
+        }
+    }
+    if (scan != nullptr) {
+        return std::make_unique<SharedScanConsumer>(std::move(scan));
+    }
+
+    ReaderParams shared_params = params;
+    shared_params.runtime_state = nullptr;
+    shared_params.profile = nullptr;
+    scan = std::make_shared<SharedScan>(key, schema, shared_params);
+    RETURN_IF_ERROR(scan->_reader->init(scan->_params));
+    auto consumer = std::make_unique<SharedScanConsumer>(scan);
+    std::lock_guard<std::mutex> l(_lock);
+    // Replace the one finished, or keep the one started by another scan meanwhile.
+    auto& registered = _scans[key];
+    auto running = registered.lock();
+    if (running == nullptr || running->_eof) {
+        registered = scan;
+    }
+    return consumer;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,91 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "column/chunk.h"
+#include "common/status.h"
+#include "common/statusor.h"
+#include "storage/vectorized/reader.h"
+#include "storage/vectorized/reader_params.h"
+
+namespace starrocks::vectorized {
+
+class SharedScanConsumer;
+
+// A storage reader of a tablet version shared by the concurrent OlapScanners reading the same columns and key
+// ranges, see config::enable_shared_scan. The chunks are read by the consumers in turn, i.e. the consumer
+// needing the next chunk reads it, and the latest chunks are buffered for the other consumers. The buffer is
+// bounded by config::shared_scan_max_buffered_chunks, so a consumer falling behind it is detached.
+//
+// A consumer attached to a running scan gets the chunks from the oldest one buffered, and the rows it misses,
+// i.e. the rows before it's attached or after it's detached, are read by its own reader of the same params,
+// which reads the rows in the same order.
+class SharedScan {
+public:
+    SharedScan(std::string key, const Schema& schema, const ReaderParams& params)
+            : _key(std::move(key)), _params(params), _reader(std::make_shared<Reader>(schema)) {}
+
+    const std::string& key() const { return _key; }
+
+private:
+    friend class SharedScanConsumer;
+    friend class SharedScanManager;
+
+    const std::string _key;
+    const ReaderParams _params;
+    std::mutex _lock;
+    std::shared_ptr<Reader> _reader;
+    // The chunks buffered and the rows of the scan before each of them, the first one is the |_first_seq|-th
+    // chunk read.
+    std::deque<std::pair<ChunkPtr, int64_t>> _chunks;
+    int64_t _first_seq = 0;
+    int64_t _num_rows_read = 0;
+    bool _eof = false;
+    Status _status;
+};
+
+// A consumer of a SharedScan, which reads the rows [begin_row(), end_row()) of the scan.
+class SharedScanConsumer {
+public:
+    explicit SharedScanConsumer(std::shared_ptr<SharedScan> scan);
+
+    // Append the next chunk of the scan to |chunk|, of the schema of the reader. Return EndOfFile if all the rows
+    // of the scan are read, i.e. reached_end(), or the consumer is detached.
+    Status get_next(Chunk* chunk);
+
+    int64_t begin_row() const { return _begin_row; }
+    int64_t end_row() const { return _end_row; }
+    bool reached_end() const { return _reached_end; }
+
+private:
+    std::shared_ptr<SharedScan> _scan;
+    // The sequence of the next chunk to get.
+    int64_t _seq = 0;
+    int64_t _begin_row = 0;
+    int64_t _end_row = 0;
+    bool _reached_end = false;
+};
+
+class SharedScanManager {
+public:
+    static SharedScanManager* instance();
+
+    // Attach a consumer to the running scan of |key|, or start a scan of a reader of |schema| initialized by
+    // |params|, which should reference nothing of the query, e.g. the runtime state or the profile.
+    StatusOr<std::unique_ptr<SharedScanConsumer>> attach(const std::string& key, const Schema& schema,
+                                                         const ReaderParams& params);
+
+private:
+    std::mutex _lock;
+    // The running scans, removed as all of their consumers are gone or they're finished.
+    std::unordered_map<std::string, std::weak_ptr<SharedScan>> _scans;
+};
+
+} // namespace starrocks::vectorized
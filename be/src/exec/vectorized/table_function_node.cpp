@@ -87,8 +87,8 @@ Status TableFunctionNode::get_next(RuntimeState* state, RowBatch* row_batch, boo
 Status TableFunctionNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     RETURN_IF_CANCELLED(state);
     SCOPED_TIMER(_runtime_profile->total_time_counter());
-    int chunk_size = config::vector_chunk_size;
-    int reserve_chunk_size = chunk_size;
+    size_t chunk_size = config::vector_chunk_size;
+    size_t num_rows = 0;
     std::vector<ColumnPtr> output_columns;
 
     if (reached_limit()) {
@@ -110,39 +110,6 @@ Status TableFunctionNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* e
         output_columns.emplace_back(_table_function_result.first[result_idx]->clone_empty());
     }
 
-    //If _outer_column_remain_repeat_times > 0, first use the remaining data of the previous chunk to construct this data
-    if (_outer_column_remain_repeat_times > 0) {
-        size_t repeat_times = std::min(_outer_column_remain_repeat_times, chunk_size);
-        //Build outer data, repeat multiple times
-        for (int outer_idx = 0; outer_idx < _outer_slots.size(); ++outer_idx) {
-            ColumnPtr& input_column_ptr = _input_chunk_ptr->get_column_by_slot_id(_outer_slots[outer_idx]);
-            Datum value = input_column_ptr->get(_input_chunk_seek_rows);
-            if (value.is_null()) {
-                //The output_columns[outer_idx] is must Nullable, if value has null
-                down_cast<NullableColumn*>(output_columns[outer_idx].get())->append_nulls(repeat_times);
-            } else {
-                output_columns[outer_idx]->append_value_multiple_times(&value, repeat_times);
-            }
-        }
-        //Build table function result
-        for (int result_idx = 0; result_idx < _fn_result_slots.size(); ++result_idx) {
-            int tvf_offset_start = _table_function_result.second->get(_input_chunk_seek_rows + 1).get_int32() -
-                                   _outer_column_remain_repeat_times;
-            output_columns[_outer_slots.size() + result_idx]->append(*(_table_function_result.first[result_idx]),
-                                                                     tvf_offset_start, repeat_times);
-        }
-
-        reserve_chunk_size -= repeat_times;
-        _outer_column_remain_repeat_times -= repeat_times;
-        if (_outer_column_remain_repeat_times == 0) {
-            ++_input_chunk_seek_rows;
-        }
-
-        if (reserve_chunk_size == 0) {
-            return build_chunk(chunk, output_columns);
-        }
-    }
-
     while (true) {
         if (_input_chunk_ptr == nullptr || !_table_function_result_eos) {
             RETURN_IF_ERROR(get_next_input_chunk(state, eos));
@@ -153,46 +120,66 @@ Status TableFunctionNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* e
             }
         }
 
-        while (_input_chunk_seek_rows < _input_chunk_ptr->num_rows()) {
-            int tvf_result_size = _table_function_result.second->get(_input_chunk_seek_rows + 1).get_int32() -
-                                  _table_function_result.second->get(_input_chunk_seek_rows).get_int32();
-            int repeat_times = std::min(tvf_result_size, reserve_chunk_size);
-            if (repeat_times == 0) {
-                ++_input_chunk_seek_rows;
-                continue;
-            }
-            //Build outer data, repeat multiple times
-            for (int outer_idx = 0; outer_idx < _outer_slots.size(); ++outer_idx) {
-                ColumnPtr& input_column_ptr = _input_chunk_ptr->get_column_by_slot_id(_outer_slots[outer_idx]);
-                Datum value = input_column_ptr->get(_input_chunk_seek_rows);
-                if (value.is_null()) {
-                    //The output_columns[outer_idx] is must Nullable, if value has null
-                    down_cast<NullableColumn*>(output_columns[outer_idx].get())->append_nulls(repeat_times);
-                } else {
-                    output_columns[outer_idx]->append_value_multiple_times(&value, repeat_times);
-                }
-            }
-            //Build table function result
-            for (int result_idx = 0; result_idx < _fn_result_slots.size(); ++result_idx) {
-                output_columns[_outer_slots.size() + result_idx]->append(
-                        *(_table_function_result.first[result_idx]),
-                        _table_function_result.second->get(_input_chunk_seek_rows).get_int32(), repeat_times);
-            }
-
-            reserve_chunk_size -= repeat_times;
+        bool shared_result = false;
+        num_rows += _append_table_function_result(&output_columns, chunk_size - num_rows, &shared_result);
+        if (num_rows == chunk_size || shared_result) {
+            return build_chunk(chunk, output_columns);
+        }
 
-            _outer_column_remain_repeat_times = tvf_result_size - repeat_times;
-            if (_outer_column_remain_repeat_times == 0) {
-                ++_input_chunk_seek_rows;
-            }
+        _input_chunk_ptr = nullptr;
+    }
+}
 
-            if (reserve_chunk_size == 0) {
-                return build_chunk(chunk, output_columns);
-            }
+size_t TableFunctionNode::_append_table_function_result(std::vector<ColumnPtr>* output_columns, size_t max_rows,
+                                                        bool* shared_result) {
+    const auto& offsets = down_cast<const UInt32Column*>(_table_function_result.second.get())->get_data();
+    const size_t num_input_rows = _input_chunk_ptr->num_rows();
+
+    if (_input_chunk_seek_rows >= num_input_rows) {
+        return 0;
+    }
+    // The results of the consecutive input rows are consecutive, so only the start of them is needed, and
+    // the outer rows are gathered by the input row of each result.
+    uint32_t result_start = _outer_column_remain_repeat_times > 0
+                                    ? offsets[_input_chunk_seek_rows + 1] - _outer_column_remain_repeat_times
+                                    : offsets[_input_chunk_seek_rows];
+    size_t num_rows = 0;
+    _outer_row_index.clear();
+    while (_input_chunk_seek_rows < num_input_rows && num_rows < max_rows) {
+        uint32_t row_end = offsets[_input_chunk_seek_rows + 1];
+        uint32_t row_start = _outer_column_remain_repeat_times > 0 ? row_end - _outer_column_remain_repeat_times
+                                                                    : offsets[_input_chunk_seek_rows];
+        size_t repeat_times = std::min<size_t>(row_end - row_start, max_rows - num_rows);
+        _outer_row_index.insert(_outer_row_index.end(), repeat_times, _input_chunk_seek_rows);
+        num_rows += repeat_times;
+
+        _outer_column_remain_repeat_times = row_end - row_start - repeat_times;
+        if (_outer_column_remain_repeat_times == 0) {
+            ++_input_chunk_seek_rows;
         }
+    }
+    if (num_rows == 0) {
+        return 0;
+    }
 
-        _input_chunk_ptr = nullptr;
+    //Build outer data, gather the rows of all the input rows at once
+    for (int outer_idx = 0; outer_idx < _outer_slots.size(); ++outer_idx) {
+        const ColumnPtr& input_column_ptr = _input_chunk_ptr->get_column_by_slot_id(_outer_slots[outer_idx]);
+        (*output_columns)[outer_idx]->append_selective(*input_column_ptr, _outer_row_index.data(), 0, num_rows);
+    }
+
+    //Build table function result, share the result columns if they are output as a whole
+    *shared_result = !_fn_result_slots.empty() && (*output_columns)[_outer_slots.size()]->empty() &&
+                     result_start == 0 && _table_function_result.first[0]->size() == num_rows;
+    for (int result_idx = 0; result_idx < _fn_result_slots.size(); ++result_idx) {
+        ColumnPtr& output_column = (*output_columns)[_outer_slots.size() + result_idx];
+        if (*shared_result) {
+            output_column = _table_function_result.first[result_idx];
+        } else {
+            output_column->append(*(_table_function_result.first[result_idx]), result_start, num_rows);
+        }
     }
+    return num_rows;
 }
 
 Status TableFunctionNode::reset(RuntimeState* state) {
@@ -33,6 +33,13 @@ public:
     Status get_next_input_chunk(RuntimeState* state, bool* eos);
 
 private:
+    // Append at most |max_rows| rows of the current input chunk joined with their table function results to
+    // |output_columns|, and return the number of the appended rows. If the whole result columns are output
+    // at once, they are shared by |output_columns| and |shared_result| is set, then no more rows could be
+    // appended to |output_columns|.
+    size_t _append_table_function_result(std::vector<ColumnPtr>* output_columns, size_t max_rows,
+                                         bool* shared_result);
+
     const TableFunction* _table_function;
 
     //Slots of output by table function
@@ -56,6 +63,8 @@ private:
     bool _table_function_result_eos;
     //table function param and return offset
     TableFunctionState* _table_function_state;
+    //The input row of each output row, to gather the outer columns
+    std::vector<uint32_t> _outer_row_index;
 
     //Profile
     RuntimeProfile::Counter* _table_function_exec_timer = nullptr;
@@ -5,11 +5,17 @@
 #include <memory>
 
 #include "column/column_helper.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/sort/local_merge_sort_source_operator.h"
+#include "exec/pipeline/sort/partition_sort_sink_operator.h"
 #include "exec/vectorized/chunks_sorter.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
+#include "exec/vectorized/olap_scan_node.h"
 #include "gutil/casts.h"
 #include "runtime/mem_tracker.h"
+#include "storage/vectorized/runtime_column_predicate.h"
 
 namespace starrocks::vectorized {
 
@@ -60,9 +66,49 @@ Status TopNNode::prepare(RuntimeState* state) {
     _abort_on_default_limit_exceeded = _abort_on_default_limit_exceeded && state->abort_on_default_limit_exceeded();
 
     _sort_timer = ADD_TIMER(runtime_profile(), "ChunksSorter");
+    if (_limit > 0 && config::enable_topn_runtime_predicate) {
+        _init_runtime_predicate(state);
+    }
     return Status::OK();
 }
 
+void TopNNode::_init_runtime_predicate(RuntimeState* state) {
+    auto* scan_node = dynamic_cast<OlapScanNode*>(child(0));
+    const auto& ordering_expr_ctxs = _sort_exec_exprs.lhs_ordering_expr_ctxs();
+    if (scan_node == nullptr || ordering_expr_ctxs.empty()) {
+        return;
+    }
+    std::vector<SlotId> slot_ids;
+    Expr* ordering_expr = ordering_expr_ctxs[0]->root();
+    if (!ordering_expr->is_slotref() || ordering_expr->get_slot_ids(&slot_ids) != 1) {
+        return;
+    }
+    // The ordering expressions refer to the materialized tuple, find the expression materializing the slot.
+    const auto& materialized_slots = _materialized_tuple_desc->slots();
+    const auto& slot_expr_ctxs = _sort_exec_exprs.sort_tuple_slot_expr_ctxs();
+    Expr* slot_expr = nullptr;
+    for (size_t i = 0; i < materialized_slots.size() && i < slot_expr_ctxs.size(); ++i) {
+        if (materialized_slots[i]->id() == slot_ids[0]) {
+            slot_expr = slot_expr_ctxs[i]->root();
+            break;
+        }
+    }
+    slot_ids.clear();
+    if (slot_expr == nullptr || !slot_expr->is_slotref() || slot_expr->get_slot_ids(&slot_ids) != 1) {
+        return;
+    }
+    SlotDescriptor* scan_slot = state->desc_tbl().get_slot_descriptor(slot_ids[0]);
+    if (scan_slot == nullptr || !scan_slot->is_materialized() ||
+        !RuntimeColumnPredicate::support_type(scan_slot->type().type)) {
+        return;
+    }
+    // An ascending top-n keeps the rows <= its boundary, and the null rows are kept if they are ordered first.
+    _runtime_predicate =
+            _pool->add(new RuntimeColumnPredicate(scan_slot->col_name(), _is_asc_order[0], _is_null_first[0]));
+    _runtime_predicate_type = scan_slot->type().type;
+    scan_node->add_runtime_column_predicate(_runtime_predicate);
+}
+
 Status TopNNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
@@ -98,7 +144,7 @@ Status TopNNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
 
     {
         SCOPED_TIMER(_sort_timer);
-        _chunks_sorter->get_next(chunk, eos);
+        RETURN_IF_ERROR(_chunks_sorter->get_next(chunk, eos));
     }
     if (*eos) {
         _chunks_sorter = nullptr;
@@ -124,19 +170,45 @@ Status TopNNode::close(RuntimeState* state) {
     return ExecNode::close(state);
 }
 
-Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
-    static const uint SIZE_OF_CHUNK_FOR_TOPN = 3000;
-    static const uint SIZE_OF_CHUNK_FOR_FULL_SORT = 5000;
+pipeline::OpFactories TopNNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    // Each sink driver sorts its own part of the input, so the input isn't gathered into one stream,
+    // and the sorted parts are merged by one source driver.
+    auto sort_context =
+            std::make_shared<SortContext>(&_sort_exec_exprs, _is_asc_order, _is_null_first, _offset, _limit);
+
+    OpFactories operators_with_sink = _children[0]->decompose_to_pipeline(context);
+    operators_with_sink.emplace_back(std::make_shared<PartitionSortSinkOperatorFactory>(
+            context->next_operator_id(), id(), sort_context, child(0)->row_desc(), _row_descriptor,
+            _materialized_tuple_desc, _order_by_types));
+    context->add_pipeline(operators_with_sink);
+
+    OpFactories operators_with_source;
+    auto source_operator =
+            std::make_shared<LocalMergeSortSourceOperatorFactory>(context->next_operator_id(), id(), sort_context);
+    source_operator->set_degree_of_parallelism(1);
+    operators_with_source.emplace_back(std::move(source_operator));
+    if (limit() != -1) {
+        operators_with_source.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators_with_source;
+}
 
+Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
     ScopedTimer<MonotonicStopWatch> timer(_sort_timer);
     if (_limit > 0) {
-        _chunks_sorter =
-                std::make_unique<ChunksSorterTopn>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order,
-                                                   &_is_null_first, _offset, _limit, SIZE_OF_CHUNK_FOR_TOPN);
+        auto chunks_sorter = std::make_unique<ChunksSorterTopn>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()),
+                                                                &_is_asc_order, &_is_null_first, _offset, _limit,
+                                                                ChunksSorter::SIZE_OF_CHUNK_FOR_TOPN);
+        if (_runtime_predicate != nullptr) {
+            chunks_sorter->set_runtime_predicate(_runtime_predicate, _runtime_predicate_type);
+        }
+        _chunks_sorter = std::move(chunks_sorter);
     } else {
-        _chunks_sorter =
-                std::make_unique<ChunksSorterFullSort>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order,
-                                                       &_is_null_first, SIZE_OF_CHUNK_FOR_FULL_SORT);
+        _chunks_sorter = std::make_unique<ChunksSorterFullSort>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()),
+                                                                &_is_asc_order, &_is_null_first,
+                                                                ChunksSorter::SIZE_OF_CHUNK_FOR_FULL_SORT);
     }
 
     bool eos = false;
@@ -151,7 +223,8 @@ Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
         }
         timer.start();
         if (chunk != nullptr && chunk->num_rows() > 0) {
-            ChunkPtr materialize_chunk = _materialize_chunk_before_sort(chunk.get());
+            ChunkPtr materialize_chunk = ChunksSorter::materialize_chunk_before_sort(
+                    chunk.get(), _materialized_tuple_desc, _sort_exec_exprs, _order_by_types);
             RETURN_IF_ERROR(_chunks_sorter->update(state, materialize_chunk));
         }
     } while (!eos);
@@ -159,56 +232,4 @@ Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
     return Status::OK();
 }
 
-ChunkPtr TopNNode::_materialize_chunk_before_sort(Chunk* chunk) {
-    ChunkPtr materialize_chunk = std::make_shared<Chunk>();
-
-    // materialize all sorting columns: replace old columns with evaluated columns
-    const size_t row_num = chunk->num_rows();
-    const auto& slots_in_row_descriptor = _materialized_tuple_desc->slots();
-    const auto& slots_in_sort_exprs = _sort_exec_exprs.sort_tuple_slot_expr_ctxs();
-
-    DCHECK_EQ(slots_in_row_descriptor.size(), slots_in_sort_exprs.size());
-
-    for (size_t i = 0; i < slots_in_sort_exprs.size(); ++i) {
-        ExprContext* expr_ctx = slots_in_sort_exprs[i];
-        ColumnPtr col = expr_ctx->evaluate(chunk);
-        if (col->is_constant()) {
-            if (col->is_nullable()) {
-                // Constant null column doesn't have original column data type information,
-                // so replace it by a nullable column of original data type filled with all NULLs.
-                ColumnPtr new_col = ColumnHelper::create_column(_order_by_types[i].type_desc, true);
-                new_col->append_nulls(row_num);
-                materialize_chunk->append_column(new_col, slots_in_row_descriptor[i]->id());
-            } else {
-                // Case 1: an expression may generate a constant column which will be reused by
-                // another call of evaluate(). We clone its data column to resize it as same as
-                // the size of the chunk, so that Chunk::num_rows() can return the right number
-                // if this ConstColumn is the first column of the chunk.
-                // Case 2: an expression may generate a constant column for one Chunk, but a
-                // non-constant one for another Chunk, we replace them all by non-constant columns.
-                auto* const_col = down_cast<ConstColumn*>(col.get());
-                const auto& data_col = const_col->data_column();
-                auto new_col = data_col->clone_empty();
-                new_col->append(*data_col, 0, 1);
-                new_col->assign(row_num, 0);
-                if (_order_by_types[i].is_nullable) {
-                    ColumnPtr null_col =
-                            NullableColumn::create(ColumnPtr(new_col.release()), NullColumn::create(row_num, 0));
-                    materialize_chunk->append_column(null_col, slots_in_row_descriptor[i]->id());
-                } else {
-                    materialize_chunk->append_column(ColumnPtr(new_col.release()), slots_in_row_descriptor[i]->id());
-                }
-            }
-        } else {
-            // When get a non-null column, but it should be nullable, we wrap it with a NullableColumn.
-            if (!col->is_nullable() && _order_by_types[i].is_nullable) {
-                col = NullableColumn::create(col, NullColumn::create(col->size(), 0));
-            }
-            materialize_chunk->append_column(col, slots_in_row_descriptor[i]->id());
-        }
-    }
-
-    return materialize_chunk;
-}
-
 } // namespace starrocks::vectorized
@@ -4,10 +4,11 @@
 
 #include "exec/exec_node.h"
 #include "exec/sort_exec_exprs.h"
+#include "exec/vectorized/chunks_sorter.h"
 
 namespace starrocks::vectorized {
 
-class ChunksSorter;
+class RuntimeColumnPredicate;
 
 // Node for in-memory TopN (ORDER BY ... LIMIT).
 //
@@ -27,9 +28,14 @@ public:
 
     Status close(RuntimeState* state) override;
 
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
 private:
     Status _consume_chunks(RuntimeState* state, ExecNode* child);
-    ChunkPtr _materialize_chunk_before_sort(Chunk* chunk);
+    // Push the boundary of the top rows down to the olap scan node below as a runtime predicate,
+    // if the first order-by expression is a column of it.
+    void _init_runtime_predicate(RuntimeState* state);
 
     int64_t _offset;
 
@@ -38,10 +44,6 @@ private:
     std::vector<bool> _is_asc_order;
     std::vector<bool> _is_null_first;
 
-    struct OrderByType {
-        TypeDescriptor type_desc;
-        bool is_nullable;
-    };
     std::vector<OrderByType> _order_by_types;
 
     // Cached descriptor for the materialized tuple. Assigned in Prepare().
@@ -53,6 +55,9 @@ private:
 
     std::unique_ptr<ChunksSorter> _chunks_sorter;
 
+    RuntimeColumnPredicate* _runtime_predicate = nullptr;
+    PrimitiveType _runtime_predicate_type = INVALID_TYPE;
+
     RuntimeProfile::Counter* _sort_timer;
 };
 
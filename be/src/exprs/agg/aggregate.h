@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "column/column.h"
 
 namespace starrocks_udf {
@@ -88,6 +90,17 @@ public:
     virtual void create(AggDataPtr ptr) const = 0;
     virtual void destroy(AggDataPtr ptr) const = 0;
 
+    // Whether destroy() is a no-op, e.g. the state is a number or its memory is allocated from the MemPool
+    // of the aggregation, see aggregate_state_allocator.h, so the states needn't be destroyed one by one.
+    virtual bool is_state_trivially_destructible() const { return false; }
+
+    // Destroy the states of a batch to reduce virtual function call
+    virtual void batch_destroy(size_t batch_size, const AggDataPtr* states, size_t state_offset) const {
+        for (size_t i = 0; i < batch_size; i++) {
+            destroy(states[i] + state_offset);
+        }
+    }
+
     // Contains a loop with calls to "update" function.
     // You can collect arguments into array "states"
     // and do a single call to "update_batch" for devirtualization and inlining.
@@ -110,6 +123,31 @@ public:
                                            int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                            int64_t frame_end) const {}
 
+    // For window functions with sliding frames
+    // Whether the rows updated to a state could be removed from it by remove_batch_single_state, e.g. sum and
+    // count, so the state of a sliding frame could be slid from the previous frame instead of being recomputed.
+    virtual bool is_removable() const { return false; }
+
+    // For window functions with sliding frames
+    // Remove the rows [frame_start, frame_end), which have been updated to the state, from the state.
+    virtual void remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                           int64_t frame_start, int64_t frame_end) const {}
+
+    // For window functions with sliding frames, only for the removable functions
+    // The state has been updated by the rows of the frame [prev_frame_start, prev_frame_end), slide it to the
+    // frame [frame_start, frame_end) by removing the rows leaving the frame and updating the rows entering it.
+    // Neither bound of the frame could be less than the previous one.
+    virtual void slide_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                          int64_t prev_frame_start, int64_t prev_frame_end, int64_t frame_start,
+                                          int64_t frame_end) const {
+        DCHECK_LE(prev_frame_start, frame_start);
+        DCHECK_LE(prev_frame_end, frame_end);
+        remove_batch_single_state(ctx, state, columns, prev_frame_start, std::min(frame_start, prev_frame_end));
+        // The peer group isn't used by the removable functions.
+        update_batch_single_state(ctx, state, columns, frame_start, frame_end, std::max(frame_start, prev_frame_end),
+                                  frame_end);
+    }
+
     // Contains a loop with calls to "merge" function.
     // You can collect arguments into array "states"
     // and do a single call to "merge_batch" for devirtualization and inlining.
@@ -132,6 +170,16 @@ public:
 
     void destroy(AggDataPtr ptr) const final { data(ptr).~State(); }
 
+    bool is_state_trivially_destructible() const final { return std::is_trivially_destructible_v<State>; }
+
+    void batch_destroy(size_t batch_size, const AggDataPtr* states, size_t state_offset) const final {
+        if constexpr (!std::is_trivially_destructible_v<State>) {
+            for (size_t i = 0; i < batch_size; i++) {
+                data(states[i] + state_offset).~State();
+            }
+        }
+    }
+
     size_t size() const final { return sizeof(State); }
 
     size_t alignof_size() const final { return alignof(State); }
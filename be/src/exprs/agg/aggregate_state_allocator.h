@@ -0,0 +1,62 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "runtime/mem_pool.h"
+#include "udf/udf_internal.h"
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+// The variable-length part of the aggregate states, e.g. the string of group_concat, could be allocated from
+// the MemPool of the aggregation instead of the heap. The MemPool also holds the states themselves and is
+// released as a whole when the aggregation is closed, so such states are trivially destructible, and there is
+// neither malloc nor free per group, and the memory is accounted to the MemTracker of the aggregation.
+inline MemPool* agg_state_mem_pool(FunctionContext* ctx) {
+    DCHECK(ctx->impl()->mem_pool() != nullptr);
+    return ctx->impl()->mem_pool();
+}
+
+// A growable byte buffer of an aggregate state allocated from the MemPool. The memory isn't reused after the
+// buffer grows, the capacity is at least doubled each time, so the wasted memory is less than the used one.
+struct AggStateBuffer {
+    static constexpr size_t kMinCapacity = 16;
+
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+
+    void reserve(MemPool* pool, size_t new_capacity) {
+        if (new_capacity <= capacity) {
+            return;
+        }
+        new_capacity = std::max(new_capacity, std::max(capacity * 2, kMinCapacity));
+        uint8_t* new_data = pool->allocate(new_capacity);
+        if (size > 0) {
+            memcpy(new_data, data, size);
+        }
+        data = new_data;
+        capacity = new_capacity;
+    }
+
+    AggStateBuffer& append(MemPool* pool, const void* src, size_t len) {
+        reserve(pool, size + len);
+        if (len > 0) {
+            memcpy(data + size, src, len);
+            size += len;
+        }
+        return *this;
+    }
+
+    AggStateBuffer& append(MemPool* pool, const Slice& src) { return append(pool, src.data, src.size); }
+
+    // Keep the memory for the next appends, e.g. when the state of a window function is reset.
+    void clear() { size = 0; }
+
+    Slice slice() const { return {data, size}; }
+};
+
+} // namespace starrocks::vectorized
@@ -75,6 +75,10 @@ public:
     using ResultType = RunTimeCppType<ResultPT>;
     using ResultColumnType = RunTimeColumnType<ResultPT>;
 
+    // The integers are summed up as doubles, whose removal is exact only for the integers of at most 32 bits.
+    static constexpr bool IsRemovable =
+            (pt_is_sum_bigint<PT> && !pt_is_bigint<PT>) || pt_is_decimal<PT> || pt_is_decimalv2<PT>;
+
     void update(FunctionContext* ctx, const Column** columns, AggDataPtr state, size_t row_num) const override {
         DCHECK(!columns[0]->is_nullable());
         [[maybe_unused]] const InputColumnType* column = down_cast<const InputColumnType*>(columns[0]);
@@ -102,6 +106,20 @@ public:
         }
     }
 
+    bool is_removable() const override { return IsRemovable; }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                   int64_t frame_start, int64_t frame_end) const override {
+        if constexpr (IsRemovable) {
+            const auto* column = down_cast<const InputColumnType*>(columns[0]);
+            const auto* data = column->get_data().data();
+            for (size_t i = frame_start; i < frame_end; ++i) {
+                this->data(state).sum = this->data(state).sum - data[i];
+            }
+            this->data(state).count -= (frame_end - frame_start);
+        }
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(column->is_binary());
         Slice slice = column->get(row_num).get_slice();
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "column/object_column.h"
 #include "column/vectorized_fwd.h"
 #include "exprs/agg/aggregate.h"
@@ -42,6 +44,17 @@ public:
         this->data(state) |= *(col->get_object(row_num));
     }
 
+    // The bitmaps of the batch are unioned at once to the single state.
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override {
+        _fast_union(columns[0], batch_size, state);
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column* column,
+                                  AggDataPtr state) const override {
+        _fast_union(column, batch_size, state);
+    }
+
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
         BitmapColumn* col = down_cast<BitmapColumn*>(to);
         col->append(&(this->data(state)));
@@ -57,6 +70,16 @@ public:
     }
 
     std::string get_name() const override { return "bitmap_union_count"; }
+
+private:
+    void _fast_union(const Column* column, size_t batch_size, AggDataPtr state) const {
+        const auto& pool = down_cast<const BitmapColumn*>(column)->get_pool();
+        std::vector<const BitmapValue*> values(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            values[i] = &pool[i];
+        }
+        this->data(state).fast_union(values);
+    }
 };
 
 } // namespace starrocks::vectorized
@@ -7,6 +7,7 @@
 #include "column/column_helper.h"
 #include "column/type_traits.h"
 #include "exprs/agg/aggregate.h"
+#include "exprs/agg/aggregate_state_allocator.h"
 #include "gutil/casts.h"
 
 namespace starrocks::vectorized {
@@ -16,7 +17,8 @@ inline constexpr PrimitiveType GroupConcatResultPT = TYPE_VARCHAR;
 struct GroupConcatAggregateState {
     // intermediate_string.
     // concat with sep_length first.
-    std::string intermediate_string{};
+    // It's allocated from the MemPool of the aggregation, so no string is allocated per group.
+    AggStateBuffer intermediate_string{};
     // is initial
     bool initial{};
 };
@@ -31,19 +33,20 @@ public:
     using ResultColumnType = InputColumnType;
 
     void reset(FunctionContext* ctx, const Columns& args, AggDataPtr state) const override {
-        this->data(state).intermediate_string = {};
+        this->data(state).intermediate_string.clear();
         this->data(state).initial = false;
     }
 
     void update(FunctionContext* ctx, const Column** columns, AggDataPtr state, size_t row_num) const override {
         DCHECK(columns[0]->is_binary());
+        MemPool* pool = agg_state_mem_pool(ctx);
         if (ctx->get_num_args() > 1) {
             auto const_column_sep = ctx->get_constant_column(1);
             if (const_column_sep == nullptr) {
                 const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
                 const InputColumnType* column_sep = down_cast<const InputColumnType*>(columns[1]);
 
-                std::string& result = this->data(state).intermediate_string;
+                AggStateBuffer& result = this->data(state).intermediate_string;
 
                 Slice val = column_val->get_slice(row_num);
                 Slice sep = column_sep->get_slice(row_num);
@@ -52,15 +55,13 @@ public:
 
                     // separator's length;
                     uint32_t size = sep.get_size();
-                    result.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t))
-                            .append(sep.get_data(), sep.get_size())
-                            .append(val.get_data(), val.get_size());
+                    result.append(pool, &size, sizeof(uint32_t)).append(pool, sep).append(pool, val);
                 } else {
-                    result.append(sep.get_data(), sep.get_size()).append(val.get_data(), val.get_size());
+                    result.append(pool, sep).append(pool, val);
                 }
             } else {
                 const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-                std::string& result = this->data(state).intermediate_string;
+                AggStateBuffer& result = this->data(state).intermediate_string;
 
                 Slice val = column_val->get_slice(row_num);
                 Slice sep = ColumnHelper::get_const_value<TYPE_VARCHAR>(const_column_sep);
@@ -70,16 +71,14 @@ public:
 
                     // separator's length;
                     uint32_t size = sep.get_size();
-                    result.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t))
-                            .append(sep.get_data(), sep.get_size())
-                            .append(val.get_data(), val.get_size());
+                    result.append(pool, &size, sizeof(uint32_t)).append(pool, sep).append(pool, val);
                 } else {
-                    result.append(sep.get_data(), sep.get_size()).append(val.get_data(), val.get_size());
+                    result.append(pool, sep).append(pool, val);
                 }
             }
         } else {
             const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-            std::string& result = this->data(state).intermediate_string;
+            AggStateBuffer& result = this->data(state).intermediate_string;
 
             Slice val = column_val->get_slice(row_num);
             //DEFAULT sep_length.
@@ -88,11 +87,9 @@ public:
 
                 // separator's length;
                 uint32_t size = 2;
-                result.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t))
-                        .append(", ")
-                        .append(val.get_data(), val.get_size());
+                result.append(pool, &size, sizeof(uint32_t)).append(pool, ", ", 2).append(pool, val);
             } else {
-                result.append(", ").append(val.get_data(), val.get_size());
+                result.append(pool, ", ", 2).append(pool, val);
             }
         }
     }
@@ -102,11 +99,14 @@ public:
         if (ctx->get_num_args() > 1) {
             const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
             const InputColumnType* column_sep = down_cast<const InputColumnType*>(columns[1]);
-            this->data(state).intermediate_string.reserve(column_val->get_bytes().size() +
-                                                          column_sep->get_bytes().size());
+            this->data(state).intermediate_string.reserve(
+                    agg_state_mem_pool(ctx), this->data(state).intermediate_string.size + sizeof(uint32_t) +
+                                                     column_val->get_bytes().size() + column_sep->get_bytes().size());
         } else {
             const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-            this->data(state).intermediate_string.reserve(column_val->get_bytes().size() + 2 * batch_size);
+            this->data(state).intermediate_string.reserve(
+                    agg_state_mem_pool(ctx), this->data(state).intermediate_string.size + sizeof(uint32_t) +
+                                                     column_val->get_bytes().size() + 2 * batch_size);
         }
 
         for (size_t i = 0; i < batch_size; ++i) {
@@ -128,13 +128,14 @@ public:
         uint32_t size_value = *reinterpret_cast<uint32_t*>(data);
         data += sizeof(uint32_t);
 
+        MemPool* pool = agg_state_mem_pool(ctx);
         if (!this->data(state).initial) {
             this->data(state).initial = true;
-            this->data(state).intermediate_string.append(data, size_value);
+            this->data(state).intermediate_string.append(pool, data, size_value);
         } else {
             data += sizeof(uint32_t);
 
-            this->data(state).intermediate_string.append(data, size_value - sizeof(uint32_t));
+            this->data(state).intermediate_string.append(pool, data, size_value - sizeof(uint32_t));
         }
     }
 
@@ -144,15 +145,15 @@ public:
         auto* column = down_cast<BinaryColumn*>(to);
         Bytes& bytes = column->get_bytes();
 
-        const std::string& value = this->data(state).intermediate_string;
+        Slice value = this->data(state).intermediate_string.slice();
 
         size_t old_size = bytes.size();
-        size_t new_size = old_size + sizeof(uint32_t) + value.size();
+        size_t new_size = old_size + sizeof(uint32_t) + value.size;
         bytes.resize(new_size);
 
-        uint32_t size_value = value.size();
+        uint32_t size_value = value.size;
         memcpy(bytes.data() + old_size, &size_value, sizeof(uint32_t));
-        memcpy(bytes.data() + old_size + sizeof(uint32_t), value.data(), size_value);
+        memcpy(bytes.data() + old_size + sizeof(uint32_t), value.data, size_value);
 
         column->get_offset().emplace_back(new_size);
     }
@@ -253,10 +254,10 @@ public:
     }
 
     void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
-        const std::string& value = this->data(state).intermediate_string;
+        Slice value = this->data(state).intermediate_string.slice();
         // Remove first sep_length.
-        const char* data = value.data();
-        uint32_t size = value.size();
+        const char* data = value.data;
+        uint32_t size = value.size;
 
         uint32_t sep_size = *reinterpret_cast<const uint32_t*>(data);
         uint32_t offset = sizeof(uint32_t) + sep_size;
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "column/object_column.h"
 #include "column/vectorized_fwd.h"
 #include "exprs/agg/aggregate.h"
@@ -53,6 +55,11 @@ public:
         }
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override {
+        _merge_many(columns[0], batch_size, state);
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(column->is_object());
 
@@ -60,6 +67,11 @@ public:
         this->data(state).merge(*(hll_column->get_object(row_num)));
     }
 
+    void merge_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column* column,
+                                  AggDataPtr state) const override {
+        _merge_many(column, batch_size, state);
+    }
+
     void get_values(FunctionContext* ctx, ConstAggDataPtr state, Column* dst, size_t start, size_t end) const override {
         DCHECK_GT(end, start);
         DCHECK(dst->is_object());
@@ -91,6 +103,16 @@ public:
     }
 
     std::string get_name() const override { return "hll_union"; }
+
+private:
+    void _merge_many(const Column* column, size_t batch_size, AggDataPtr state) const {
+        const auto& pool = down_cast<const HyperLogLogColumn*>(column)->get_pool();
+        std::vector<const HyperLogLog*> others(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            others[i] = &pool[i];
+        }
+        this->data(state).merge_many(others);
+    }
 };
 
 } // namespace starrocks::vectorized
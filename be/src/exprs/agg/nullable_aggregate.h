@@ -428,6 +428,67 @@ public:
                                                              peer_group_start, peer_group_end, frame_start, frame_end);
         }
     }
+
+    bool is_removable() const override { return this->nested_function->is_removable(); }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                   int64_t frame_start, int64_t frame_end) const override {
+        if (frame_start >= frame_end) {
+            return;
+        }
+
+        if (columns[0]->is_nullable()) {
+            const auto* column = down_cast<const NullableColumn*>(columns[0]);
+            const Column* data_column = &column->data_column_ref();
+
+            if (!column->has_null()) {
+                this->nested_function->remove_batch_single_state(ctx, this->data(state).mutable_nest_state(),
+                                                                 &data_column, frame_start, frame_end);
+                return;
+            }
+
+            const uint8_t* f_data = column->null_column()->raw_data();
+            for (size_t i = frame_start; i < frame_end; ++i) {
+                if (f_data[i] == 0) {
+                    this->nested_function->remove_batch_single_state(ctx, this->data(state).mutable_nest_state(),
+                                                                     &data_column, i, i + 1);
+                }
+            }
+        } else {
+            this->nested_function->remove_batch_single_state(ctx, this->data(state).mutable_nest_state(), columns,
+                                                             frame_start, frame_end);
+        }
+    }
+
+    void slide_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                  int64_t prev_frame_start, int64_t prev_frame_end, int64_t frame_start,
+                                  int64_t frame_end) const override {
+        DCHECK_LE(prev_frame_start, frame_start);
+        DCHECK_LE(prev_frame_end, frame_end);
+        int64_t remove_end = std::min(frame_start, prev_frame_end);
+        int64_t update_start = std::max(frame_start, prev_frame_end);
+        if (prev_frame_start < remove_end) {
+            remove_batch_single_state(ctx, state, columns, prev_frame_start, remove_end);
+            // The state becomes null again if all the rows [frame_start, update_start) kept from the previous
+            // frame are null.
+            if (!this->data(state).is_null) {
+                this->data(state).is_null = _count_not_null(columns[0], frame_start, update_start) == 0;
+            }
+        }
+        update_batch_single_state(ctx, state, columns, frame_start, frame_end, update_start, frame_end);
+    }
+
+private:
+    static size_t _count_not_null(const Column* column, int64_t start, int64_t end) {
+        if (start >= end) {
+            return 0;
+        }
+        if (column->is_nullable() && column->has_null()) {
+            const uint8_t* f_data = down_cast<const NullableColumn*>(column)->null_column()->raw_data();
+            return SIMD::count_zero(f_data + start, end - start);
+        }
+        return end - start;
+    }
 };
 
 template <typename State>
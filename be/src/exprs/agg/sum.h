@@ -58,6 +58,10 @@ public:
     using InputColumnType = RunTimeColumnType<PT>;
     using ResultColumnType = RunTimeColumnType<ResultPT>;
 
+    // The sums of floating point numbers aren't removable, because the rounding errors are accumulated.
+    static constexpr bool IsRemovable = pt_is_boolean<PT> || pt_is_integer<PT> || pt_is_decimal<PT> ||
+                                        pt_is_decimalv2<PT>;
+
     void reset(FunctionContext* ctx, const Columns& args, AggDataPtr state) const override {
         this->data(state).sum = {};
     }
@@ -87,6 +91,19 @@ public:
         }
     }
 
+    bool is_removable() const override { return IsRemovable; }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                   int64_t frame_start, int64_t frame_end) const override {
+        if constexpr (IsRemovable) {
+            const auto* column = down_cast<const InputColumnType*>(columns[0]);
+            const auto* data = column->get_data().data();
+            for (size_t i = frame_start; i < frame_end; ++i) {
+                this->data(state).sum = this->data(state).sum - data[i];
+            }
+        }
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(column->is_numeric() || column->is_decimal());
         const auto* input_column = down_cast<const ResultColumnType*>(column);
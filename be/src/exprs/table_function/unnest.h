@@ -20,30 +20,37 @@ class Unnest final : public TableFunction {
         auto* col_array = down_cast<ArrayColumn*>(ColumnHelper::get_data_column(arg0));
         Columns result;
         if (arg0->has_null()) {
-            NullableColumn* nullable_array_column = down_cast<NullableColumn*>(arg0);
+            const auto& null_data = down_cast<NullableColumn*>(arg0)->immutable_null_column_data();
+            const auto& offsets = col_array->offsets().get_data();
+            const ColumnPtr& elements = col_array->elements_column();
 
-            auto offset_column = col_array->offsets_column();
-            ColumnPtr compacted_offset_column = offset_column->clone_empty();
-            compacted_offset_column->append_datum(Datum(0));
-
-            ColumnPtr compacted_array_elements = col_array->elements_column()->clone_empty();
-            int compact_offset = 0;
-
-            for (int row_idx = 0; row_idx < nullable_array_column->size(); ++row_idx) {
-                if (nullable_array_column->is_null(row_idx)) {
-                    compact_offset +=
-                            offset_column->get(row_idx + 1).get_int32() - offset_column->get(row_idx).get_int32();
-                    int32 offset = offset_column->get(row_idx + 1).get_int32();
-                    compacted_offset_column->append_datum(offset - compact_offset);
-                } else {
-                    int32 offset = offset_column->get(row_idx + 1).get_int32();
-                    compacted_offset_column->append_datum(offset - compact_offset);
+            // The null rows usually have no elements, then the elements could be used without copy.
+            bool has_null_elements = false;
+            for (size_t row_idx = 0; row_idx < null_data.size() && !has_null_elements; ++row_idx) {
+                has_null_elements = null_data[row_idx] && offsets[row_idx] != offsets[row_idx + 1];
+            }
+            if (!has_null_elements) {
+                result.emplace_back(elements);
+                return std::make_pair(result, col_array->offsets_column());
+            }
 
-                    compacted_array_elements->append(
-                            *(col_array->elements_column()), offset_column->get(row_idx).get_int32(),
-                            offset_column->get(row_idx + 1).get_int32() - offset_column->get(row_idx).get_int32());
+            // Remove the elements of the null rows, the elements of the consecutive not null rows are copied at once.
+            auto compacted_offset_column = UInt32Column::create();
+            auto& compacted_offsets = compacted_offset_column->get_data();
+            compacted_offsets.reserve(offsets.size());
+            compacted_offsets.emplace_back(0);
+            ColumnPtr compacted_array_elements = elements->clone_empty();
+            uint32_t copy_start = offsets[0];
+            uint32_t removed_elements = 0;
+            for (size_t row_idx = 0; row_idx < null_data.size(); ++row_idx) {
+                if (null_data[row_idx]) {
+                    compacted_array_elements->append(*elements, copy_start, offsets[row_idx] - copy_start);
+                    copy_start = offsets[row_idx + 1];
+                    removed_elements += offsets[row_idx + 1] - offsets[row_idx];
                 }
+                compacted_offsets.emplace_back(offsets[row_idx + 1] - removed_elements);
             }
+            compacted_array_elements->append(*elements, copy_start, offsets.back() - copy_start);
 
             result.emplace_back(compacted_array_elements);
             return std::make_pair(result, compacted_offset_column);
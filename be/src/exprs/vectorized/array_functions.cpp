@@ -2,7 +2,11 @@
 
 #include "exprs/vectorized/array_functions.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "column/array_column.h"
+#include "column/hash_set.h"
 #include "util/raw_container.h"
 
 namespace starrocks::vectorized {
@@ -133,6 +137,13 @@ private:
         auto targets_ptr = (const ValueType*)(targets.raw_data());
         auto& first_target = *targets_ptr;
 
+        if constexpr (ConstTarget && !NullableTarget && !std::is_same_v<ArrayColumn, ElementColumn> &&
+                      !std::is_same_v<BinaryColumn, ElementColumn>) {
+            _find_const_target<NullableElement>(elements_ptr, offsets_ptr, num_array, first_target, null_map_elements,
+                                                result_ptr);
+            return result;
+        }
+
         [[maybe_unused]] auto is_null = [](const NullColumn::Container* null_map, size_t idx) -> bool {
             return (*null_map)[idx] != 0;
         };
@@ -179,6 +190,30 @@ private:
         return result;
     }
 
+    // Compare all the elements of the arrays to the constant target in one flat loop, which is vectorized by the
+    // compiler, and then search the matches of each array by memchr.
+    template <bool NullableElement, typename ValueType>
+    static void _find_const_target(const ValueType* elements, const uint32_t* offsets, size_t num_array,
+                                   const ValueType& target, const NullColumn::Container* null_map_elements,
+                                   uint8_t* result) {
+        const size_t num_elements = offsets[num_array];
+        std::vector<uint8_t> matches(num_elements);
+        uint8_t* matches_ptr = matches.data();
+        for (size_t i = 0; i < num_elements; i++) {
+            matches_ptr[i] = (elements[i] == target);
+        }
+        if constexpr (NullableElement) {
+            // The data of a null element may be anything.
+            const uint8_t* nulls = null_map_elements->data();
+            for (size_t i = 0; i < num_elements; i++) {
+                matches_ptr[i] &= !nulls[i];
+            }
+        }
+        for (size_t i = 0; i < num_array; i++) {
+            result[i] = memchr(matches_ptr + offsets[i], 1, offsets[i + 1] - offsets[i]) != nullptr;
+        }
+    }
+
     template <bool NullableElement, bool NullableTarget, bool ConstTarget>
     static ColumnPtr _array_contains(const Column& array_elements, const UInt32Column& array_offsets,
                                      const Column& argument) {
@@ -311,6 +346,177 @@ ColumnPtr ArrayFunctions::array_contains([[maybe_unused]] FunctionContext* conte
     return ArrayContainsImpl::evaluate(*arg0, *arg1);
 }
 
+// The result arrays of array_distinct and array_sort are built by selecting the indexes of the elements of all the
+// arrays into one buffer and appending them at once, instead of building the arrays row by row.
+class ArrayReorderImpl {
+public:
+    // The indexes of the distinct elements of each array in the order of their first occurrences, a null at most once.
+    struct Distinct {
+        template <typename ElementColumn>
+        static void select(const ElementColumn& data, const NullColumn::Container* nulls, const uint32_t* offsets,
+                           size_t num_array, std::vector<uint32_t>* indexes, uint32_t* result_offsets) {
+            const auto& values = data.get_data();
+            // Reused by all the arrays, clear() keeps the slots of a small set.
+            PhSet<typename ElementColumn::ValueType> set;
+            for (size_t i = 0; i < num_array; i++) {
+                set.clear();
+                bool has_null = false;
+                for (uint32_t j = offsets[i]; j < offsets[i + 1]; j++) {
+                    if (nulls != nullptr && (*nulls)[j] != 0) {
+                        if (!has_null) {
+                            has_null = true;
+                            indexes->push_back(j);
+                        }
+                    } else if (set.insert(values[j]).second) {
+                        indexes->push_back(j);
+                    }
+                }
+                result_offsets[i + 1] = indexes->size();
+            }
+        }
+
+        // For the elements without the hash, e.g. the nested arrays.
+        static void select_generic(const Column& elements, const uint32_t* offsets, size_t num_array,
+                                   std::vector<uint32_t>* indexes, uint32_t* result_offsets) {
+            for (size_t i = 0; i < num_array; i++) {
+                size_t begin = indexes->size();
+                for (uint32_t j = offsets[i]; j < offsets[i + 1]; j++) {
+                    auto first = std::find_if(indexes->begin() + begin, indexes->end(), [&](uint32_t k) {
+                        return elements.compare_at(j, k, elements, -1) == 0;
+                    });
+                    if (first == indexes->end()) {
+                        indexes->push_back(j);
+                    }
+                }
+                result_offsets[i + 1] = indexes->size();
+            }
+        }
+    };
+
+    // The indexes of the elements of each array in the ascending order, the nulls first.
+    struct Sort {
+        template <typename ElementColumn>
+        static void select(const ElementColumn& data, const NullColumn::Container* nulls, const uint32_t* offsets,
+                           size_t num_array, std::vector<uint32_t>* indexes, uint32_t* result_offsets) {
+            const auto& values = data.get_data();
+            _sort(offsets, num_array, indexes, result_offsets, [&](uint32_t lhs, uint32_t rhs) {
+                if (nulls != nullptr && ((*nulls)[lhs] != 0 || (*nulls)[rhs] != 0)) {
+                    return (*nulls)[lhs] > (*nulls)[rhs];
+                }
+                return values[lhs] < values[rhs];
+            });
+        }
+
+        static void select_generic(const Column& elements, const uint32_t* offsets, size_t num_array,
+                                   std::vector<uint32_t>* indexes, uint32_t* result_offsets) {
+            _sort(offsets, num_array, indexes, result_offsets,
+                  [&](uint32_t lhs, uint32_t rhs) { return elements.compare_at(lhs, rhs, elements, -1) < 0; });
+        }
+
+    private:
+        template <typename Less>
+        static void _sort(const uint32_t* offsets, size_t num_array, std::vector<uint32_t>* indexes,
+                          uint32_t* result_offsets, Less less) {
+            indexes->resize(offsets[num_array] - offsets[0]);
+            std::iota(indexes->begin(), indexes->end(), offsets[0]);
+            for (size_t i = 0; i < num_array; i++) {
+                std::sort(indexes->begin() + offsets[i] - offsets[0], indexes->begin() + offsets[i + 1] - offsets[0],
+                          less);
+                result_offsets[i + 1] = offsets[i + 1] - offsets[0];
+            }
+        }
+    };
+
+    template <typename Select>
+    static ColumnPtr evaluate(const ColumnPtr& arg) {
+        // array_distinct(NULL) -> NULL, array_sort(NULL) -> NULL
+        if (arg->only_null()) {
+            return ColumnHelper::create_const_null_column(arg->size());
+        }
+        ColumnPtr column = ColumnHelper::unpack_and_duplicate_const_column(arg->size(), arg);
+        if (column->is_nullable()) {
+            const auto& nullable = down_cast<const NullableColumn&>(*column);
+            auto result = _evaluate_non_nullable<Select>(down_cast<const ArrayColumn&>(*nullable.data_column()));
+            return NullableColumn::create(std::move(result), nullable.null_column());
+        }
+        return _evaluate_non_nullable<Select>(down_cast<const ArrayColumn&>(*column));
+    }
+
+private:
+    template <typename Select>
+    static ColumnPtr _evaluate_non_nullable(const ArrayColumn& array) {
+        const Column& elements = array.elements();
+        const uint32_t* offsets = array.offsets().get_data().data();
+        const size_t num_array = array.size();
+
+        auto result_offsets = UInt32Column::create();
+        result_offsets->resize(num_array + 1);
+        uint32_t* result_offsets_ptr = result_offsets->get_data().data();
+        result_offsets_ptr[0] = 0;
+
+        std::vector<uint32_t> indexes;
+        indexes.reserve(offsets[num_array] - offsets[0]);
+
+        const Column* data = &elements;
+        const NullColumn::Container* nulls = nullptr;
+        if (elements.is_nullable()) {
+            const auto& nullable = down_cast<const NullableColumn&>(elements);
+            data = nullable.data_column().get();
+            nulls = nullable.has_null() ? &nullable.null_column()->get_data() : nullptr;
+        }
+
+        _select<Select>(elements, *data, nulls, offsets, num_array, &indexes, result_offsets_ptr);
+
+        auto result_elements = elements.clone_empty();
+        result_elements->append_selective(elements, indexes.data(), 0, indexes.size());
+        return ArrayColumn::create(std::move(result_elements), std::move(result_offsets));
+    }
+
+    template <typename Select>
+    static void _select(const Column& elements, const Column& data, const NullColumn::Container* nulls,
+                        const uint32_t* offsets, size_t num_array, std::vector<uint32_t>* indexes,
+                        uint32_t* result_offsets) {
+#undef HANDLE_ELEMENT_TYPE
+#define HANDLE_ELEMENT_TYPE(ElementType)                                                                      \
+    do {                                                                                                      \
+        if (typeid(data) == typeid(ElementType)) {                                                            \
+            Select::select(down_cast<const ElementType&>(data), nulls, offsets, num_array, indexes,           \
+                           result_offsets);                                                                   \
+            return;                                                                                           \
+        }                                                                                                     \
+    } while (0)
+
+        HANDLE_ELEMENT_TYPE(BooleanColumn);
+        HANDLE_ELEMENT_TYPE(Int8Column);
+        HANDLE_ELEMENT_TYPE(Int16Column);
+        HANDLE_ELEMENT_TYPE(Int32Column);
+        HANDLE_ELEMENT_TYPE(Int64Column);
+        HANDLE_ELEMENT_TYPE(Int128Column);
+        HANDLE_ELEMENT_TYPE(FloatColumn);
+        HANDLE_ELEMENT_TYPE(DoubleColumn);
+        HANDLE_ELEMENT_TYPE(DecimalColumn);
+        HANDLE_ELEMENT_TYPE(Decimal32Column);
+        HANDLE_ELEMENT_TYPE(Decimal64Column);
+        HANDLE_ELEMENT_TYPE(Decimal128Column);
+        HANDLE_ELEMENT_TYPE(BinaryColumn);
+        HANDLE_ELEMENT_TYPE(DateColumn);
+        HANDLE_ELEMENT_TYPE(TimestampColumn);
+#undef HANDLE_ELEMENT_TYPE
+
+        Select::select_generic(elements, offsets, num_array, indexes, result_offsets);
+    }
+};
+
+ColumnPtr ArrayFunctions::array_distinct([[maybe_unused]] FunctionContext* context, const Columns& columns) {
+    DCHECK_EQ(1, columns.size());
+    return ArrayReorderImpl::evaluate<ArrayReorderImpl::Distinct>(columns[0]);
+}
+
+ColumnPtr ArrayFunctions::array_sort([[maybe_unused]] FunctionContext* context, const Columns& columns) {
+    DCHECK_EQ(1, columns.size());
+    return ArrayReorderImpl::evaluate<ArrayReorderImpl::Sort>(columns[0]);
+}
+
 class ArrayArithmeticImpl {
 public:
     using ArithmeticType = typename ArrayFunctions::ArithmeticType;
@@ -343,21 +549,36 @@ public:
             ResultType sum{};
 
             bool has_data = false;
-            for (size_t j = 0; j < array_size; j++) {
-                if constexpr (has_null) {
-                    if ((*null_elements)[offset + j] != 0) {
-                        continue;
+            if constexpr (pt_is_arithmetic<value_type>) {
+                // Free of branches, so the sums of the integers are vectorized.
+                size_t non_nulls = array_size;
+                for (size_t j = 0; j < array_size; j++) {
+                    if constexpr (has_null) {
+                        uint8_t is_null = (*null_elements)[offset + j] != 0;
+                        sum += is_null ? ResultType{} : static_cast<ResultType>(elements_ptr[offset + j]);
+                        non_nulls -= is_null;
+                    } else {
+                        sum += elements_ptr[offset + j];
                     }
                 }
+                has_data = non_nulls > 0;
+            } else {
+                for (size_t j = 0; j < array_size; j++) {
+                    if constexpr (has_null) {
+                        if ((*null_elements)[offset + j] != 0) {
+                            continue;
+                        }
+                    }
 
-                has_data = true;
-                auto& value = elements_ptr[offset + j];
-                if constexpr (pt_is_datetime<value_type>) {
-                    sum += value.to_unix_second();
-                } else if constexpr (pt_is_date<value_type>) {
-                    sum += value.julian();
-                } else {
-                    sum += value;
+                    has_data = true;
+                    auto& value = elements_ptr[offset + j];
+                    if constexpr (pt_is_datetime<value_type>) {
+                        sum += value.to_unix_second();
+                    } else if constexpr (pt_is_date<value_type>) {
+                        sum += value.julian();
+                    } else {
+                        sum += value;
+                    }
                 }
             }
 
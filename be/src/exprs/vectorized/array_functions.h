@@ -16,6 +16,10 @@ public:
 
     DEFINE_VECTORIZED_FN(array_contains);
 
+    DEFINE_VECTORIZED_FN(array_distinct);
+
+    DEFINE_VECTORIZED_FN(array_sort);
+
     DEFINE_VECTORIZED_FN(array_sum_boolean);
     DEFINE_VECTORIZED_FN(array_sum_tinyint);
     DEFINE_VECTORIZED_FN(array_sum_smallint);
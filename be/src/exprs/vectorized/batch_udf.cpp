@@ -0,0 +1,200 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/batch_udf.h"
+
+#include "column/column_helper.h"
+#include "gen_cpp/Types_types.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/user_function_cache.h"
+
+namespace starrocks::vectorized {
+
+static Status get_function_ptr(const TFunction& fn, const std::string& symbol, void** fn_ptr,
+                               UserFunctionCacheEntry** entry) {
+    Status status = UserFunctionCache::instance()->get_function_ptr(fn.id, symbol, fn.hdfs_location, fn.checksum,
+                                                                    fn_ptr, entry);
+    if (!status.ok()) {
+        return Status::InternalError(strings::Substitute("Problem loading the batch UDF $0, symbol: $1, $2",
+                                                         fn.name.function_name, symbol, status.get_error_msg()));
+    }
+    return Status::OK();
+}
+
+Status BatchUdf::load(const TFunction& fn, std::shared_ptr<FunctionDescriptor>* desc,
+                      UserFunctionCacheEntry** entry) {
+    if (!fn.__isset.scalar_fn) {
+        return Status::InternalError("The batch UDF " + fn.name.function_name + " has no symbol");
+    }
+    void* scalar_fn = nullptr;
+    RETURN_IF_ERROR(get_function_ptr(fn, fn.scalar_fn.symbol, &scalar_fn, entry));
+    void* prepare_fn = nullptr;
+    if (fn.scalar_fn.__isset.prepare_fn_symbol && !fn.scalar_fn.prepare_fn_symbol.empty()) {
+        RETURN_IF_ERROR(get_function_ptr(fn, fn.scalar_fn.prepare_fn_symbol, &prepare_fn, entry));
+    }
+    void* close_fn = nullptr;
+    if (fn.scalar_fn.__isset.close_fn_symbol && !fn.scalar_fn.close_fn_symbol.empty()) {
+        RETURN_IF_ERROR(get_function_ptr(fn, fn.scalar_fn.close_fn_symbol, &close_fn, entry));
+    }
+    *desc = std::make_shared<FunctionDescriptor>(fn.name.function_name, fn.arg_types.size(),
+                                                 reinterpret_cast<ScalarFunction>(scalar_fn),
+                                                 reinterpret_cast<PrepareFunction>(prepare_fn),
+                                                 reinterpret_cast<CloseFunction>(close_fn));
+    return Status::OK();
+}
+
+BatchUdaf::~BatchUdaf() {
+    if (_cache_entry != nullptr) {
+        UserFunctionCache::instance()->release_entry(_cache_entry);
+    }
+}
+
+Status BatchUdaf::create(const TFunction& fn, const TypeDescriptor& result_type, std::unique_ptr<BatchUdaf>* udaf) {
+    const TAggregateFunction& agg_fn = fn.aggregate_fn;
+    if (agg_fn.init_fn_symbol.empty() || agg_fn.update_fn_symbol.empty() || agg_fn.merge_fn_symbol.empty() ||
+        agg_fn.serialize_fn_symbol.empty() || agg_fn.finalize_fn_symbol.empty()) {
+        return Status::InternalError("The batch UDAF " + fn.name.function_name +
+                                     " should have the init, update, merge, serialize and finalize symbols");
+    }
+    std::unique_ptr<BatchUdaf> result(new BatchUdaf());
+    result->_name = fn.name.function_name;
+    result->_result_type = result_type;
+    void* fn_ptr = nullptr;
+    RETURN_IF_ERROR(get_function_ptr(fn, agg_fn.init_fn_symbol, &fn_ptr, &result->_cache_entry));
+    result->_init_fn = reinterpret_cast<BatchUdafInitFunction>(fn_ptr);
+    RETURN_IF_ERROR(get_function_ptr(fn, agg_fn.update_fn_symbol, &fn_ptr, &result->_cache_entry));
+    result->_update_fn = reinterpret_cast<BatchUdafUpdateFunction>(fn_ptr);
+    RETURN_IF_ERROR(get_function_ptr(fn, agg_fn.merge_fn_symbol, &fn_ptr, &result->_cache_entry));
+    result->_merge_fn = reinterpret_cast<BatchUdafMergeFunction>(fn_ptr);
+    RETURN_IF_ERROR(get_function_ptr(fn, agg_fn.serialize_fn_symbol, &fn_ptr, &result->_cache_entry));
+    result->_serialize_fn = reinterpret_cast<BatchUdafSerializeFunction>(fn_ptr);
+    RETURN_IF_ERROR(get_function_ptr(fn, agg_fn.finalize_fn_symbol, &fn_ptr, &result->_cache_entry));
+    result->_finalize_fn = reinterpret_cast<BatchUdafFinalizeFunction>(fn_ptr);
+    *udaf = std::move(result);
+    return Status::OK();
+}
+
+void BatchUdaf::create(AggDataPtr ptr) const {
+    DCHECK(_context != nullptr);
+    _state(ptr) = _init_fn(_context);
+}
+
+void BatchUdaf::destroy(AggDataPtr ptr) const {
+    batch_destroy(1, &ptr, 0);
+}
+
+void BatchUdaf::batch_destroy(size_t batch_size, const AggDataPtr* states, size_t state_offset) const {
+    std::vector<void*> alive_states;
+    for (size_t i = 0; i < batch_size; i++) {
+        if (_state(states[i] + state_offset) != nullptr) {
+            alive_states.emplace_back(_state(states[i] + state_offset));
+            _state(states[i] + state_offset) = nullptr;
+        }
+    }
+    if (!alive_states.empty()) {
+        ColumnPtr discarded = ColumnHelper::create_column(_result_type, true);
+        _finalize_fn(_context, alive_states.data(), alive_states.size(), discarded.get());
+    }
+}
+
+std::vector<void*> BatchUdaf::_take_states(size_t batch_size, const AggDataPtr* agg_states, size_t state_offset) {
+    std::vector<void*> states(batch_size);
+    for (size_t i = 0; i < batch_size; i++) {
+        states[i] = _state(agg_states[i] + state_offset);
+        _state(agg_states[i] + state_offset) = nullptr;
+    }
+    return states;
+}
+
+void BatchUdaf::update(FunctionContext* ctx, const Column** columns, AggDataPtr state, size_t row_num) const {
+    std::vector<void*> states(row_num + 1, nullptr);
+    states[row_num] = _state(state);
+    _update_fn(ctx, columns, states.size(), states.data());
+}
+
+void BatchUdaf::update_batch(FunctionContext* ctx, size_t batch_size, size_t state_offset, const Column** columns,
+                             AggDataPtr* states) const {
+    std::vector<void*> udaf_states(batch_size);
+    for (size_t i = 0; i < batch_size; i++) {
+        udaf_states[i] = _state(states[i] + state_offset);
+    }
+    _update_fn(ctx, columns, batch_size, udaf_states.data());
+}
+
+void BatchUdaf::update_batch_selectively(FunctionContext* ctx, size_t batch_size, size_t state_offset,
+                                         const Column** columns, AggDataPtr* states,
+                                         const std::vector<uint8_t>& filter) const {
+    std::vector<void*> udaf_states(batch_size, nullptr);
+    for (size_t i = 0; i < batch_size; i++) {
+        if (filter[i] == 0) {
+            udaf_states[i] = _state(states[i] + state_offset);
+        }
+    }
+    _update_fn(ctx, columns, batch_size, udaf_states.data());
+}
+
+void BatchUdaf::update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                          AggDataPtr state) const {
+    std::vector<void*> udaf_states(batch_size, _state(state));
+    _update_fn(ctx, columns, batch_size, udaf_states.data());
+}
+
+void BatchUdaf::merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const {
+    std::vector<void*> states(row_num + 1, nullptr);
+    states[row_num] = _state(state);
+    _merge_fn(ctx, column, states.size(), states.data());
+}
+
+void BatchUdaf::merge_batch(FunctionContext* ctx, size_t batch_size, size_t state_offset, const Column* column,
+                            AggDataPtr* states) const {
+    std::vector<void*> udaf_states(batch_size);
+    for (size_t i = 0; i < batch_size; i++) {
+        udaf_states[i] = _state(states[i] + state_offset);
+    }
+    _merge_fn(ctx, column, batch_size, udaf_states.data());
+}
+
+void BatchUdaf::merge_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column* column,
+                                         AggDataPtr state) const {
+    std::vector<void*> udaf_states(batch_size, _state(state));
+    _merge_fn(ctx, column, batch_size, udaf_states.data());
+}
+
+void BatchUdaf::serialize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const {
+    // The state is freed by the UDAF.
+    auto ptr = const_cast<AggDataPtr>(state);
+    std::vector<void*> states = _take_states(1, &ptr, 0);
+    _serialize_fn(ctx, states.data(), states.size(), to);
+}
+
+void BatchUdaf::batch_serialize(size_t batch_size, const Buffer<AggDataPtr>& agg_states, size_t state_offsets,
+                                Column* to) const {
+    std::vector<void*> states = _take_states(batch_size, agg_states.data(), state_offsets);
+    _serialize_fn(_context, states.data(), states.size(), to);
+}
+
+void BatchUdaf::finalize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const {
+    auto ptr = const_cast<AggDataPtr>(state);
+    std::vector<void*> states = _take_states(1, &ptr, 0);
+    _finalize_fn(ctx, states.data(), states.size(), to);
+}
+
+void BatchUdaf::batch_finalize(FunctionContext* ctx, size_t batch_size, const Buffer<AggDataPtr>& agg_states,
+                               size_t state_offsets, Column* to) const {
+    std::vector<void*> states = _take_states(batch_size, agg_states.data(), state_offsets);
+    _finalize_fn(ctx, states.data(), states.size(), to);
+}
+
+void BatchUdaf::convert_to_serialize_format(const Columns& src, size_t chunk_size, ColumnPtr* dst) const {
+    std::vector<const Column*> columns(src.size());
+    for (size_t i = 0; i < src.size(); i++) {
+        columns[i] = src[i].get();
+    }
+    std::vector<void*> states(chunk_size);
+    for (size_t i = 0; i < chunk_size; i++) {
+        states[i] = _init_fn(_context);
+    }
+    _update_fn(_context, columns.data(), chunk_size, states.data());
+    _serialize_fn(_context, states.data(), chunk_size, dst->get());
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,138 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/column.h"
+#include "common/status.h"
+#include "exprs/agg/aggregate.h"
+#include "exprs/vectorized/builtin_functions.h"
+#include "runtime/types.h"
+
+namespace starrocks {
+class TFunction;
+struct UserFunctionCacheEntry;
+} // namespace starrocks
+
+namespace starrocks::vectorized {
+
+// The batch UDFs and UDAFs of the vectorized engine, the functions of a native library (TFunctionBinaryType::NATIVE)
+// called once per chunk with the columns of the arguments, rather than once per row with the AnyVals of udf.h.
+// The functions are looked up by the symbols of the CREATE FUNCTION as they are, so they should be declared
+// extern "C".
+//
+// A batch UDF has the signature of a builtin function, see builtin_functions.h:
+//   ColumnPtr symbol(FunctionContext* context, const Columns& columns);
+// The columns of the arguments have the same number of rows, and may be ConstColumns and NullableColumns, whose
+// null columns are the null maps of the arguments. It returns a column of the return type of the rows, which may
+// be a NullableColumn for the null results. The prepare and the close functions, if any, are PrepareFunction and
+// CloseFunction.
+//
+// A batch UDAF keeps the state of each group as a pointer created by its init function, and takes a selection of
+// the states of the groups, the state of each row, to update or merge a batch of rows.
+//   init:      void* (FunctionContext* context), create a state.
+//   update:    void (FunctionContext* context, const Column** columns, size_t num_rows, void** states), update
+//              the state states[i] by the row i of the columns of the arguments, the rows of the null states are
+//              skipped.
+//   merge:     void (FunctionContext* context, const Column* column, size_t num_rows, void** states), merge the
+//              row i of the column of the intermediates into states[i], likewise.
+//   serialize: void (FunctionContext* context, void** states, size_t num_states, Column* dst), append the
+//              intermediates of the states to |dst|, and free the states.
+//   finalize:  void (FunctionContext* context, void** states, size_t num_states, Column* dst), append the
+//              results of the states to |dst|, and free the states.
+// The columns of the intermediates are of the intermediate type, and are NullableColumns if any argument is
+// nullable, as the results if the function is nullable as well.
+using BatchUdafInitFunction = void* (*)(FunctionContext* context);
+using BatchUdafUpdateFunction = void (*)(FunctionContext* context, const Column** columns, size_t num_rows,
+                                         void** states);
+using BatchUdafMergeFunction = void (*)(FunctionContext* context, const Column* column, size_t num_rows,
+                                        void** states);
+using BatchUdafSerializeFunction = void (*)(FunctionContext* context, void** states, size_t num_states, Column* dst);
+using BatchUdafFinalizeFunction = void (*)(FunctionContext* context, void** states, size_t num_states, Column* dst);
+
+class BatchUdf {
+public:
+    // Load the functions of the batch UDF |fn| into |desc|, the library is referenced by |entry| until it's
+    // released by UserFunctionCache::release_entry().
+    static Status load(const TFunction& fn, std::shared_ptr<FunctionDescriptor>* desc,
+                       UserFunctionCacheEntry** entry);
+};
+
+// The AggregateFunction of a batch UDAF, whose state is the pointer to the state of the UDAF. The states not
+// serialized nor finalized, e.g. of a cancelled query, are finalized into a column discarded when they are
+// destroyed, so the UDAF frees them.
+class BatchUdaf final : public AggregateFunction {
+public:
+    ~BatchUdaf() override;
+
+    // Load the functions of the batch UDAF |fn|, which returns |result_type|.
+    static Status create(const TFunction& fn, const TypeDescriptor& result_type, std::unique_ptr<BatchUdaf>* udaf);
+
+    // The context of the states created and destroyed, which should be set before any of them.
+    void set_context(FunctionContext* context) { _context = context; }
+
+    void update(FunctionContext* ctx, const Column** columns, AggDataPtr state, size_t row_num) const override;
+
+    void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override;
+
+    void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override;
+
+    void batch_serialize(size_t batch_size, const Buffer<AggDataPtr>& agg_states, size_t state_offsets,
+                         Column* to) const override;
+
+    void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override;
+
+    void batch_finalize(FunctionContext* ctx, size_t batch_size, const Buffer<AggDataPtr>& agg_states,
+                        size_t state_offsets, Column* to) const override;
+
+    void convert_to_serialize_format(const Columns& src, size_t chunk_size, ColumnPtr* dst) const override;
+
+    std::string get_name() const override { return _name; }
+
+    size_t size() const override { return sizeof(void*); }
+    size_t alignof_size() const override { return alignof(void*); }
+    void create(AggDataPtr ptr) const override;
+    void destroy(AggDataPtr ptr) const override;
+    void batch_destroy(size_t batch_size, const AggDataPtr* states, size_t state_offset) const override;
+
+    void update_batch(FunctionContext* ctx, size_t batch_size, size_t state_offset, const Column** columns,
+                      AggDataPtr* states) const override;
+
+    void update_batch_selectively(FunctionContext* ctx, size_t batch_size, size_t state_offset,
+                                  const Column** columns, AggDataPtr* states,
+                                  const std::vector<uint8_t>& filter) const override;
+
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override;
+
+    void merge_batch(FunctionContext* ctx, size_t batch_size, size_t state_offset, const Column* column,
+                     AggDataPtr* states) const override;
+
+    void merge_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column* column,
+                                  AggDataPtr state) const override;
+
+private:
+    BatchUdaf() = default;
+
+    static void*& _state(AggDataPtr ptr) { return *reinterpret_cast<void**>(ptr); }
+    static void* _state(ConstAggDataPtr ptr) { return *reinterpret_cast<void* const*>(ptr); }
+
+    // Take the states of the rows out of the aggregation states, which are serialized or finalized then.
+    static std::vector<void*> _take_states(size_t batch_size, const AggDataPtr* agg_states, size_t state_offset);
+
+    std::string _name;
+    TypeDescriptor _result_type;
+    FunctionContext* _context = nullptr;
+    UserFunctionCacheEntry* _cache_entry = nullptr;
+
+    BatchUdafInitFunction _init_fn = nullptr;
+    BatchUdafUpdateFunction _update_fn = nullptr;
+    BatchUdafMergeFunction _merge_fn = nullptr;
+    BatchUdafSerializeFunction _serialize_fn = nullptr;
+    BatchUdafFinalizeFunction _finalize_fn = nullptr;
+};
+
+} // namespace starrocks::vectorized
@@ -2,11 +2,14 @@
 
 #include "exprs/vectorized/case_expr.h"
 
+#include <algorithm>
+
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
 #include "common/object_pool.h"
 #include "exprs/vectorized/function_helper.h"
+#include "gutil/casts.h"
 
 namespace starrocks::vectorized {
 
@@ -47,7 +50,28 @@ public:
         return _children.size() % 2 == 1 ? Status::OK() : Status::InvalidArgument("case when children is error!");
     }
 
+    Status prepare(RuntimeState* state, const RowDescriptor& row_desc, ExprContext* context) override {
+        RETURN_IF_ERROR(Expr::prepare(state, row_desc, context));
+        // The cheap THEN and ELSE, i.e. the slots and the constants, are always evaluated on the whole chunk.
+        _branch_slot_ids.assign(_num_branches(), {});
+        for (uint32_t b = 0; b < _num_branches(); b++) {
+            Expr* branch = _branch_expr(b);
+            if (branch == nullptr || branch->is_slotref() || branch->is_constant()) {
+                continue;
+            }
+            std::vector<SlotId> slot_ids;
+            branch->get_slot_ids(&slot_ids);
+            std::sort(slot_ids.begin(), slot_ids.end());
+            slot_ids.erase(std::unique(slot_ids.begin(), slot_ids.end()), slot_ids.end());
+            _branch_slot_ids[b] = std::move(slot_ids);
+        }
+        return Status::OK();
+    }
+
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* chunk) override {
+        if (chunk != nullptr && chunk->num_rows() > 0) {
+            return evaluate_branches(context, chunk);
+        }
         if (_has_case_expr) {
             return evaluate_case(context, chunk);
         } else {
@@ -280,9 +304,208 @@ private:
         return builder.build(ColumnHelper::is_all_const(when_columns) && ColumnHelper::is_all_const(then_columns));
     }
 
+    // The WHENs are evaluated on the whole chunk to find the branch of each row, and then each THEN and ELSE is
+    // evaluated only if it has rows. The expensive ones are evaluated on their own rows only, and the cheap
+    // ones are evaluated on the whole chunk and blended into the result.
+    ColumnPtr evaluate_branches(ExprContext* context, vectorized::Chunk* chunk) {
+        const size_t num_rows = chunk->num_rows();
+        const uint32_t else_branch = _num_branches() - 1;
+        std::vector<uint32_t> branches(num_rows, else_branch);
+        size_t unassigned_rows = num_rows;
+
+        if (_has_case_expr) {
+            ColumnPtr case_column = _children[0]->evaluate(context, chunk);
+            ColumnViewer<WhenType> case_viewer(case_column);
+            if (ColumnHelper::count_nulls(case_column) == case_column->size()) {
+                unassigned_rows = 0;
+            }
+            for (uint32_t b = 0; b < else_branch && unassigned_rows > 0; b++) {
+                ColumnPtr when_column = _children[1 + 2 * b]->evaluate(context, chunk);
+                ColumnViewer<WhenType> when_viewer(when_column);
+                for (size_t row = 0; row < num_rows; row++) {
+                    if (branches[row] == else_branch && !case_viewer.is_null(row) && !when_viewer.is_null(row) &&
+                        when_viewer.value(row) == case_viewer.value(row)) {
+                        branches[row] = b;
+                        unassigned_rows--;
+                    }
+                }
+            }
+        } else {
+            for (uint32_t b = 0; b < else_branch && unassigned_rows > 0; b++) {
+                ColumnPtr when_column = _children[2 * b]->evaluate(context, chunk);
+                if (ColumnHelper::count_true_with_notnull(when_column) == 0) {
+                    continue;
+                }
+                ColumnViewer<TYPE_BOOLEAN> when_viewer(when_column);
+                for (size_t row = 0; row < num_rows; row++) {
+                    if (branches[row] == else_branch && !when_viewer.is_null(row) && when_viewer.value(row)) {
+                        branches[row] = b;
+                        unassigned_rows--;
+                    }
+                }
+            }
+        }
+
+        // The position of each row in the rows of its branch.
+        std::vector<uint32_t> positions(num_rows);
+        std::vector<uint32_t> branch_rows(_num_branches(), 0);
+        for (size_t row = 0; row < num_rows; row++) {
+            positions[row] = branch_rows[branches[row]]++;
+        }
+
+        Columns branch_columns(_num_branches());
+        std::vector<uint8_t> selective(_num_branches(), 0);
+        bool has_selective = false;
+        std::vector<uint32_t> selection;
+        for (uint32_t b = 0; b < _num_branches(); b++) {
+            if (branch_rows[b] == 0) {
+                continue;
+            }
+            Expr* branch = _branch_expr(b);
+            if (branch_rows[b] == num_rows) {
+                if (branch == nullptr) {
+                    return ColumnHelper::create_const_null_column(num_rows);
+                }
+                return branch->evaluate(context, chunk)->clone();
+            }
+            if (branch == nullptr) {
+                branch_columns[b] = ColumnHelper::create_const_null_column(num_rows);
+            } else if (branch_rows[b] <= num_rows * kMaxSelectiveRatio && _can_evaluate_selectively(b, chunk)) {
+                selection.clear();
+                for (uint32_t row = 0; row < num_rows; row++) {
+                    if (branches[row] == b) {
+                        selection.emplace_back(row);
+                    }
+                }
+                branch_columns[b] = _evaluate_selectively(context, b, chunk, selection);
+                selective[b] = 1;
+                has_selective = true;
+            } else {
+                branch_columns[b] = branch->evaluate(context, chunk);
+            }
+        }
+
+        if constexpr (isArithmeticPT<ResultType>) {
+            if (!has_selective && this->type().type == ResultType) {
+                return _blend(branches, branch_columns);
+            }
+        }
+
+        std::vector<ColumnViewer<ResultType>> viewers;
+        viewers.reserve(_num_branches());
+        for (uint32_t b = 0; b < _num_branches(); b++) {
+            viewers.emplace_back(branch_columns[b] != nullptr ? branch_columns[b]
+                                                              : ColumnHelper::create_const_null_column(1));
+        }
+        ColumnBuilder<ResultType> builder(this->type().precision, this->type().scale);
+        builder.reserve(num_rows);
+        for (size_t row = 0; row < num_rows; row++) {
+            const uint32_t b = branches[row];
+            const size_t index = selective[b] ? positions[row] : row;
+            if (viewers[b].is_null(index)) {
+                builder.append_null();
+            } else {
+                builder.append(viewers[b].value(index));
+            }
+        }
+        return builder.build(false);
+    }
+
+    // Selects the value of each row from the columns of the branches without any branch in the loops, the
+    // branches without rows are nullptr.
+    ColumnPtr _blend(const std::vector<uint32_t>& branches, const Columns& branch_columns) {
+        const size_t num_rows = branches.size();
+        ColumnPtr result = ColumnHelper::create_column(this->type(), false);
+        auto& data = ColumnHelper::cast_to_raw<ResultType>(result)->get_data();
+        data.resize(num_rows);
+        auto nulls = NullColumn::create(num_rows, 0);
+        auto& null_data = nulls->get_data();
+        bool has_null = false;
+
+        for (uint32_t b = 0; b < branch_columns.size(); b++) {
+            const ColumnPtr& column = branch_columns[b];
+            if (column == nullptr) {
+                continue;
+            }
+            if (column->only_null()) {
+                has_null = true;
+                for (size_t row = 0; row < num_rows; row++) {
+                    null_data[row] |= (branches[row] == b);
+                }
+                continue;
+            }
+            if (column->is_constant()) {
+                const auto value = ColumnHelper::get_const_value<ResultType>(column);
+                for (size_t row = 0; row < num_rows; row++) {
+                    data[row] = branches[row] == b ? value : data[row];
+                }
+                continue;
+            }
+            const auto* data_column =
+                    down_cast<const RunTimeColumnType<ResultType>*>(ColumnHelper::get_data_column(column.get()));
+            const auto* values = data_column->get_data().data();
+            for (size_t row = 0; row < num_rows; row++) {
+                data[row] = branches[row] == b ? values[row] : data[row];
+            }
+            if (column->has_null()) {
+                has_null = true;
+                const auto* nullable_column = down_cast<const NullableColumn*>(column.get());
+                const uint8_t* column_nulls = nullable_column->immutable_null_column_data().data();
+                for (size_t row = 0; row < num_rows; row++) {
+                    null_data[row] = branches[row] == b ? column_nulls[row] : null_data[row];
+                }
+            }
+        }
+        if (has_null) {
+            return NullableColumn::create(std::move(result), std::move(nulls));
+        }
+        return result;
+    }
+
+    bool _can_evaluate_selectively(uint32_t branch, const vectorized::Chunk* chunk) const {
+        if (branch >= _branch_slot_ids.size() || _branch_slot_ids[branch].empty() || chunk->has_tuple_columns()) {
+            return false;
+        }
+        for (SlotId slot_id : _branch_slot_ids[branch]) {
+            if (!chunk->is_slot_exist(slot_id)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Evaluates the THEN or ELSE on a chunk of the |selection| rows and the slots it references only.
+    ColumnPtr _evaluate_selectively(ExprContext* context, uint32_t branch, vectorized::Chunk* chunk,
+                                    const std::vector<uint32_t>& selection) {
+        vectorized::Chunk selected_chunk;
+        for (SlotId slot_id : _branch_slot_ids[branch]) {
+            const ColumnPtr& column = chunk->get_column_by_slot_id(slot_id);
+            ColumnPtr selected = column->clone_empty();
+            selected->append_selective(*column, selection.data(), 0, selection.size());
+            selected_chunk.append_column(std::move(selected), slot_id);
+        }
+        return _branch_expr(branch)->evaluate(context, &selected_chunk);
+    }
+
+    // The THENs and then the ELSE, which is a branch even if there is no ELSE.
+    uint32_t _num_branches() const { return (_children.size() - _has_case_expr - _has_else_expr) / 2 + 1; }
+
+    // Returns nullptr for the ELSE if there is no ELSE.
+    Expr* _branch_expr(uint32_t branch) const {
+        if (branch == _num_branches() - 1) {
+            return _has_else_expr ? _children.back() : nullptr;
+        }
+        return _children[(_has_case_expr ? 2 : 1) + 2 * branch];
+    }
+
+    // The THENs and the ELSE are evaluated on their own rows only, if they're at most this ratio of the chunk.
+    static constexpr double kMaxSelectiveRatio = 0.5;
+
 private:
     const bool _has_case_expr;
     const bool _has_else_expr;
+    // The slots of the expensive THENs and ELSE, which are empty for the cheap ones.
+    std::vector<std::vector<SlotId>> _branch_slot_ids;
 };
 
 #define CASE_WHEN_RESULT_TYPE(WHEN_TYPE, RESULT_TYPE)                \
@@ -422,12 +422,49 @@ CUSTOMIZE_FN_CAST(TYPE_DECIMALV2, TYPE_DATE, cast_to_date_fn);
 UNARY_FN_CAST(TYPE_DATETIME, TYPE_DATE, TimestampToDate);
 // Time to date need rewrite CastExpr
 
+// The strings loaded from the CSV files usually share one layout. If all the strings of |column| have
+// |length| chars and a space at |space_pos| if any, their layout isn't detected row by row.
+static bool is_standard_layout_column(const ColumnPtr& column, size_t length, int space_pos) {
+    if (column->is_constant() || column->has_null()) {
+        return false;
+    }
+    const auto* binary = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(column.get()));
+    const auto& offsets = binary->get_offset();
+    const auto& bytes = binary->get_bytes();
+    for (size_t i = 0; i < binary->size(); ++i) {
+        if (offsets[i + 1] - offsets[i] != length || (space_pos >= 0 && bytes[offsets[i] + space_pos] != ' ')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A column of "%Y-%m-%d".
+static void cast_standard_date_column(const ColumnPtr& column, ColumnBuilder<TYPE_DATE>* builder) {
+    const auto* binary = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(column.get()));
+    for (size_t row = 0; row < binary->size(); ++row) {
+        Slice value = binary->get_slice(row);
+        DateValue v;
+        int year, month, day;
+        if (date::from_string_to_date_internal(value.data, &year, &month, &day) && date::check(year, month, day)) {
+            v.from_date(year, month, day);
+            builder->append(v);
+        } else {
+            // The other layouts of the same length, e.g. "20210101  ".
+            bool right = v.from_string(value.data, value.size);
+            builder->append(v, !right);
+        }
+    }
+}
+
 template <>
 ColumnPtr cast_fn<TYPE_VARCHAR, TYPE_DATE>(ColumnPtr& column) {
     ColumnBuilder<TYPE_DATE> builder;
     ColumnViewer<TYPE_VARCHAR> viewer(column);
 
-    if (!column->has_null()) {
+    if (is_standard_layout_column(column, 10, -1)) {
+        cast_standard_date_column(column, &builder);
+    } else if (!column->has_null()) {
         for (int row = 0; row < viewer.size(); ++row) {
             auto value = viewer.value(row);
             DateValue v;
@@ -492,12 +529,33 @@ CUSTOMIZE_FN_CAST(TYPE_DECIMALV2, TYPE_DATETIME, cast_to_timestamp_fn);
 UNARY_FN_CAST(TYPE_DATE, TYPE_DATETIME, DateToTimestmap);
 // Time to datetime need rewrite CastExpr
 
+// A column of "%Y-%m-%d %H:%i:%s".
+static void cast_standard_datetime_column(const ColumnPtr& column, ColumnBuilder<TYPE_DATETIME>* builder) {
+    const auto* binary = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(column.get()));
+    for (size_t row = 0; row < binary->size(); ++row) {
+        Slice value = binary->get_slice(row);
+        TimestampValue v;
+        int year, month, day, hour, minute, second, microsecond;
+        if (date::from_string_to_datetime_internal(value.data, value.data + 11, &year, &month, &day, &hour, &minute,
+                                                   &second, &microsecond) &&
+            timestamp::check(year, month, day, hour, minute, second, microsecond)) {
+            v.from_timestamp(year, month, day, hour, minute, second, microsecond);
+            builder->append(v);
+        } else {
+            bool right = v.from_string(value.data, value.size);
+            builder->append(v, !right);
+        }
+    }
+}
+
 template <>
 ColumnPtr cast_fn<TYPE_VARCHAR, TYPE_DATETIME>(ColumnPtr& column) {
     ColumnBuilder<TYPE_DATETIME> builder;
     ColumnViewer<TYPE_VARCHAR> viewer(column);
 
-    if (!column->has_null()) {
+    if (is_standard_layout_column(column, 19, 10)) {
+        cast_standard_datetime_column(column, &builder);
+    } else if (!column->has_null()) {
         for (int row = 0; row < viewer.size(); ++row) {
             auto value = viewer.value(row);
             TimestampValue v;
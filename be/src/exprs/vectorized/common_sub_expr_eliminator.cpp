@@ -0,0 +1,217 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/common_sub_expr_eliminator.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "util/thrift_util.h"
+
+namespace starrocks::vectorized {
+
+namespace {
+
+// The functions returning different results for the same arguments.
+const std::unordered_set<std::string> kNonDeterministicFunctions = {"rand", "random", "uuid", "sleep"};
+
+struct SubExprInfo {
+    size_t end = 0;
+    bool has_slot_ref = false;
+    bool is_deterministic = true;
+};
+
+// Fill the info of the sub expr rooted at nodes[i] and its children, return the end of the sub expr.
+size_t fill_sub_expr_infos(const std::vector<TExprNode>& nodes, size_t i, std::vector<SubExprInfo>* infos) {
+    const TExprNode& node = nodes[i];
+    SubExprInfo& info = (*infos)[i];
+    info.has_slot_ref = node.node_type == TExprNodeType::SLOT_REF;
+    info.is_deterministic = !(node.__isset.fn && kNonDeterministicFunctions.count(node.fn.name.function_name) > 0);
+
+    size_t end = i + 1;
+    for (int c = 0; c < node.num_children; ++c) {
+        size_t child = end;
+        end = fill_sub_expr_infos(nodes, child, infos);
+        info.has_slot_ref |= (*infos)[child].has_slot_ref;
+        info.is_deterministic &= (*infos)[child].is_deterministic;
+    }
+    info.end = end;
+    return end;
+}
+
+bool is_candidate(const TExprNode& root, const SubExprInfo& info) {
+    if (root.num_children == 0 || !info.has_slot_ref || !info.is_deterministic) {
+        return false;
+    }
+    switch (root.node_type) {
+    case TExprNodeType::AGG_EXPR:
+    case TExprNodeType::INFO_FUNC:
+    case TExprNodeType::TABLE_FUNCTION_EXPR:
+        return false;
+    default:
+        return true;
+    }
+}
+
+// The occurrences of a candidate sub expr.
+struct SubExprOccurrences {
+    size_t size = 0;
+    size_t count = 0;
+    // The first occurrence.
+    const std::vector<TExprNode>* nodes = nullptr;
+    size_t begin = 0;
+};
+
+} // namespace
+
+Status CommonSubExprEliminator::eliminate(std::map<SlotId, TExpr>* slot_map, CommonSubExprs* common_sub_exprs) {
+    ThriftSerializer serializer(false, 1024);
+    SlotId next_slot_id = -1;
+    bool has_new_common_sub_expr = false;
+    while (true) {
+        std::vector<std::vector<TExprNode>*> exprs;
+        for (auto& [slot_id, expr] : *slot_map) {
+            exprs.emplace_back(&expr.nodes);
+        }
+        for (auto& [slot_id, expr] : *common_sub_exprs) {
+            exprs.emplace_back(&expr.nodes);
+        }
+
+        // The sub exprs are identified by their serialized nodes.
+        std::unordered_map<std::string, SubExprOccurrences> sub_exprs;
+        for (const auto* nodes : exprs) {
+            if (nodes->empty()) {
+                continue;
+            }
+            std::vector<std::string> node_keys(nodes->size());
+            for (size_t i = 0; i < nodes->size(); ++i) {
+                RETURN_IF_ERROR(serializer.serialize(const_cast<TExprNode*>(&(*nodes)[i]), &node_keys[i]));
+            }
+            std::vector<SubExprInfo> infos(nodes->size());
+            fill_sub_expr_infos(*nodes, 0, &infos);
+
+            for (size_t i = 0; i < nodes->size(); ++i) {
+                if (!is_candidate((*nodes)[i], infos[i])) {
+                    continue;
+                }
+                std::string key;
+                for (size_t j = i; j < infos[i].end; ++j) {
+                    key.append(node_keys[j]);
+                }
+                auto& occurrences = sub_exprs[key];
+                if (occurrences.count++ == 0) {
+                    occurrences.size = infos[i].end - i;
+                    occurrences.nodes = nodes;
+                    occurrences.begin = i;
+                }
+            }
+        }
+
+        // Extract the largest repeated sub expr first, the repeated sub exprs inside it are extracted from the
+        // common sub expr in the next rounds if they're still repeated.
+        const SubExprOccurrences* best = nullptr;
+        for (const auto& [key, occurrences] : sub_exprs) {
+            if (occurrences.count > 1 && (best == nullptr || occurrences.size > best->size)) {
+                best = &occurrences;
+            }
+        }
+        if (best == nullptr) {
+            break;
+        }
+
+        std::vector<TExprNode> sub_expr(best->nodes->begin() + best->begin,
+                                        best->nodes->begin() + best->begin + best->size);
+        TExprNode slot_ref = _make_slot_ref(sub_expr[0], next_slot_id);
+        for (auto* nodes : exprs) {
+            _replace_sub_expr(sub_expr, slot_ref, nodes);
+        }
+        TExpr common_sub_expr;
+        common_sub_expr.nodes = std::move(sub_expr);
+        common_sub_exprs->emplace_back(next_slot_id--, std::move(common_sub_expr));
+        has_new_common_sub_expr = true;
+    }
+
+    if (has_new_common_sub_expr) {
+        _sort_common_sub_exprs(common_sub_exprs);
+    }
+    return Status::OK();
+}
+
+TExprNode CommonSubExprEliminator::_make_slot_ref(const TExprNode& root, SlotId slot_id) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = root.type;
+    node.num_children = 0;
+    node.output_scale = root.output_scale;
+    TSlotRef slot_ref;
+    slot_ref.slot_id = slot_id;
+    slot_ref.tuple_id = 0;
+    node.__set_slot_ref(slot_ref);
+    if (root.__isset.is_nullable) {
+        node.__set_is_nullable(root.is_nullable);
+    }
+    return node;
+}
+
+void CommonSubExprEliminator::_replace_sub_expr(const std::vector<TExprNode>& sub_expr, const TExprNode& slot_ref,
+                                                 std::vector<TExprNode>* nodes) {
+    if (nodes->size() < sub_expr.size()) {
+        return;
+    }
+    std::vector<TExprNode> result;
+    result.reserve(nodes->size());
+    size_t i = 0;
+    while (i < nodes->size()) {
+        // The nodes equal to a whole sub expr are always a whole sub expr too.
+        if (i + sub_expr.size() <= nodes->size() &&
+            std::equal(sub_expr.begin(), sub_expr.end(), nodes->begin() + i)) {
+            result.emplace_back(slot_ref);
+            i += sub_expr.size();
+        } else {
+            result.emplace_back((*nodes)[i]);
+            ++i;
+        }
+    }
+    *nodes = std::move(result);
+}
+
+void CommonSubExprEliminator::_sort_common_sub_exprs(CommonSubExprs* common_sub_exprs) {
+    std::unordered_map<SlotId, size_t> slot_to_index;
+    for (size_t i = 0; i < common_sub_exprs->size(); ++i) {
+        slot_to_index.emplace((*common_sub_exprs)[i].first, i);
+    }
+
+    // Depth first, the common sub exprs referenced by an expr are output before it.
+    std::vector<bool> visited(common_sub_exprs->size(), false);
+    std::vector<size_t> order;
+    order.reserve(common_sub_exprs->size());
+    std::function<void(size_t)> visit = [&](size_t i) {
+        visited[i] = true;
+        for (const auto& node : (*common_sub_exprs)[i].second.nodes) {
+            if (node.node_type != TExprNodeType::SLOT_REF) {
+                continue;
+            }
+            auto it = slot_to_index.find(node.slot_ref.slot_id);
+            if (it != slot_to_index.end() && !visited[it->second]) {
+                visit(it->second);
+            }
+        }
+        order.emplace_back(i);
+    };
+    for (size_t i = 0; i < common_sub_exprs->size(); ++i) {
+        if (!visited[i]) {
+            visit(i);
+        }
+    }
+
+    CommonSubExprs sorted;
+    sorted.reserve(common_sub_exprs->size());
+    for (size_t i : order) {
+        sorted.emplace_back(std::move((*common_sub_exprs)[i]));
+    }
+    *common_sub_exprs = std::move(sorted);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,38 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "common/global_types.h"
+#include "common/status.h"
+#include "gen_cpp/Exprs_types.h"
+
+namespace starrocks::vectorized {
+
+// CommonSubExprEliminator finds the identical sub exprs evaluated more than once by the exprs of a projection,
+// e.g. the same CASE or substr() in several output columns of the generated BI SQL, and extracts each of them
+// into a common sub expr, which is evaluated once per chunk into a new slot and referenced by all the exprs.
+//
+// Only the deterministic sub exprs referencing at least one slot are extracted, the constant sub exprs are
+// kept in place, because the functions could prepare their constant arguments in advance.
+class CommonSubExprEliminator {
+public:
+    // The common sub exprs in the order of evaluation, and the slots they are evaluated into.
+    using CommonSubExprs = std::vector<std::pair<SlotId, TExpr>>;
+
+    // The extracted sub exprs in |slot_map| and |common_sub_exprs| are replaced by the slot refs to the new
+    // slots with negative ids, which are never used by the planner, and appended to |common_sub_exprs|, which
+    // is then sorted so that each expr is evaluated after the common sub exprs it references.
+    static Status eliminate(std::map<SlotId, TExpr>* slot_map, CommonSubExprs* common_sub_exprs);
+
+private:
+    static TExprNode _make_slot_ref(const TExprNode& root, SlotId slot_id);
+    static void _replace_sub_expr(const std::vector<TExprNode>& sub_expr, const TExprNode& slot_ref,
+                                  std::vector<TExprNode>* nodes);
+    static void _sort_common_sub_exprs(CommonSubExprs* common_sub_exprs);
+};
+
+} // namespace starrocks::vectorized
@@ -2,10 +2,23 @@
 
 #include "exprs/vectorized/compound_predicate.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <numeric>
+#include <set>
+
+#include "column/column_viewer.h"
 #include "common/object_pool.h"
+#include "exprs/expr_context.h"
 #include "exprs/predicate.h"
 #include "exprs/vectorized/binary_function.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/like_predicate.h"
 #include "exprs/vectorized/unary_function.h"
+#include "gutil/casts.h"
+#include "runtime/vectorized/Volnitsky.h"
+#include "util/stopwatch.hpp"
 
 namespace starrocks {
 namespace vectorized {
@@ -31,8 +44,26 @@ DEFINE_BINARY_FUNCTION_WITH_IMPL(AndImpl, l_value, r_value) {
 
 class VectorizedAndCompoundPredicate final : public Predicate {
 public:
-    DEFINE_COMPOUND_CONSTRUCT(VectorizedAndCompoundPredicate);
+    VectorizedAndCompoundPredicate(const TExprNode& node) : Predicate(node) {}
+    // The operands point to the children of this tree, they're collected again by the open() of the copy.
+    VectorizedAndCompoundPredicate(const VectorizedAndCompoundPredicate& other) : Predicate(other) {}
+    ~VectorizedAndCompoundPredicate() override = default;
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new VectorizedAndCompoundPredicate(*this)); }
+
+    Status open(RuntimeState* state, ExprContext* context, FunctionContext::FunctionStateScope scope) override {
+        RETURN_IF_ERROR(Expr::open(state, context, scope));
+        // The expr tree is shared by the cloned contexts, the operands are read only after they're collected.
+        if (scope == FunctionContext::FRAGMENT_LOCAL) {
+            _prepare_operands();
+        }
+        return Status::OK();
+    }
+
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
+        if (!_operands.empty() && ptr != nullptr && ptr->num_rows() > 0) {
+            return _evaluate_operands(context, ptr);
+        }
+
         auto l = _children[0]->evaluate(context, ptr);
         int l_falses = ColumnHelper::count_false_with_notnull(l);
 
@@ -45,6 +76,185 @@ public:
 
         return VectorizedLogicPredicateBinaryFunction<AndNullImpl, AndImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
+
+private:
+    // The operands are evaluated only on the rows which are not false for the operands evaluated before them,
+    // if these rows are at most this ratio of the chunk.
+    static constexpr double kMaxSelectiveRatio = 0.5;
+
+    // The observed cost and selectivity of an operand, which are shared by all the threads evaluating this
+    // tree, so they're updated without any ordering.
+    struct OperandStats {
+        std::atomic<uint64_t> rows{0};
+        std::atomic<uint64_t> false_rows{0};
+        std::atomic<uint64_t> cost_ns{0};
+    };
+
+    struct Operand {
+        Expr* expr = nullptr;
+        // The slots referenced by |expr|, whose columns are copied for the selective evaluation.
+        std::vector<SlotId> slot_ids;
+        std::unique_ptr<OperandStats> stats;
+    };
+
+    static bool _is_and(const Expr* expr) {
+        return expr->node_type() == TExprNodeType::COMPOUND_PRED && expr->op() == TExprOpcode::COMPOUND_AND;
+    }
+
+    // Collect the operands of this AND and the nested ANDs, e.g. a, b and c of (a AND b) AND c.
+    static void _collect_operands(Expr* expr, std::vector<Expr*>* operands,
+                                  std::vector<VectorizedAndCompoundPredicate*>* nested_ands) {
+        for (Expr* child : expr->children()) {
+            if (_is_and(child)) {
+                nested_ands->emplace_back(down_cast<VectorizedAndCompoundPredicate*>(child));
+                _collect_operands(child, operands, nested_ands);
+            } else {
+                operands->emplace_back(child);
+            }
+        }
+    }
+
+    void _prepare_operands() {
+        std::vector<Expr*> operands;
+        std::vector<VectorizedAndCompoundPredicate*> nested_ands;
+        _collect_operands(this, &operands, &nested_ands);
+
+        _operands.clear();
+        for (Expr* expr : operands) {
+            Operand& operand = _operands.emplace_back();
+            operand.expr = expr;
+            // The operands without slots, e.g. rand() < 0.5, aren't evaluated selectively, since the size of
+            // their results is the row number of the chunk.
+            if (!expr->is_slotref() && !expr->is_constant()) {
+                std::set<SlotId> slot_ids;
+                std::vector<SlotId> ids;
+                expr->get_slot_ids(&ids);
+                slot_ids.insert(ids.begin(), ids.end());
+                operand.slot_ids.assign(slot_ids.begin(), slot_ids.end());
+            }
+            operand.stats = std::make_unique<OperandStats>();
+        }
+        // The nested ANDs are evaluated by this one now.
+        for (auto* nested_and : nested_ands) {
+            nested_and->_operands.clear();
+        }
+    }
+
+    // The operands which are cheap to evaluate and filter out most of the rows go first, i.e. in the ascending
+    // order of cost / (1 - selectivity). The operands without stats keep their order and are evaluated first.
+    std::vector<size_t> _evaluation_order() const {
+        std::vector<double> ranks(_operands.size(), 0);
+        for (size_t i = 0; i < _operands.size(); i++) {
+            const OperandStats& stats = *_operands[i].stats;
+            uint64_t rows = stats.rows.load(std::memory_order_relaxed);
+            if (rows == 0) {
+                continue;
+            }
+            double cost = static_cast<double>(stats.cost_ns.load(std::memory_order_relaxed)) / rows;
+            double false_ratio = static_cast<double>(stats.false_rows.load(std::memory_order_relaxed)) / rows;
+            ranks[i] = cost / std::max(false_ratio, 1e-3);
+        }
+        std::vector<size_t> order(_operands.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return ranks[a] < ranks[b]; });
+        return order;
+    }
+
+    bool _can_evaluate_selectively(const Operand& operand, const vectorized::Chunk* chunk) const {
+        if (operand.slot_ids.empty() || chunk->has_tuple_columns()) {
+            return false;
+        }
+        for (SlotId slot_id : operand.slot_ids) {
+            if (!chunk->is_slot_exist(slot_id)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Evaluates |expr| on the |selection| rows of |chunk| only, the other rows of the result are true, so the
+    // result is AND-ed with the results of the other operands as is.
+    static ColumnPtr _evaluate_selectively(ExprContext* context, const Operand& operand, vectorized::Chunk* chunk,
+                                           const std::vector<uint32_t>& selection, size_t* false_rows) {
+        vectorized::Chunk selected_chunk;
+        for (SlotId slot_id : operand.slot_ids) {
+            const ColumnPtr& column = chunk->get_column_by_slot_id(slot_id);
+            ColumnPtr selected = column->clone_empty();
+            selected->append_selective(*column, selection.data(), 0, selection.size());
+            selected_chunk.append_column(std::move(selected), slot_id);
+        }
+        ColumnPtr selected_result = operand.expr->evaluate(context, &selected_chunk);
+        *false_rows = ColumnHelper::count_false_with_notnull(selected_result);
+
+        const size_t num_rows = chunk->num_rows();
+        auto data = BooleanColumn::create(num_rows, 1);
+        auto nulls = NullColumn::create(num_rows, 0);
+        auto& data_values = data->get_data();
+        auto& null_values = nulls->get_data();
+        ColumnViewer<TYPE_BOOLEAN> viewer(selected_result);
+        for (size_t i = 0; i < selection.size(); i++) {
+            data_values[selection[i]] = viewer.value(i);
+            null_values[selection[i]] = viewer.is_null(i);
+        }
+        return NullableColumn::create(std::move(data), std::move(nulls));
+    }
+
+    ColumnPtr _evaluate_operands(ExprContext* context, vectorized::Chunk* ptr) {
+        const size_t num_rows = ptr->num_rows();
+        ColumnPtr result;
+        // Whether |result| is the column of an operand, which may be a column of the chunk.
+        bool result_is_operand = false;
+        std::vector<uint32_t> selection;
+        for (size_t index : _evaluation_order()) {
+            const Operand& operand = _operands[index];
+            MonotonicStopWatch watch;
+            watch.start();
+
+            ColumnPtr column;
+            size_t evaluated_rows = num_rows;
+            size_t false_rows = 0;
+            if (result == nullptr) {
+                column = operand.expr->evaluate(context, ptr);
+                false_rows = ColumnHelper::count_false_with_notnull(column);
+            } else {
+                // The rows of the false results are false whatever the other operands are.
+                selection.clear();
+                ColumnViewer<TYPE_BOOLEAN> viewer(result);
+                for (uint32_t i = 0; i < num_rows; i++) {
+                    if (viewer.is_null(i) || viewer.value(i)) {
+                        selection.emplace_back(i);
+                    }
+                }
+                if (selection.empty()) {
+                    break;
+                }
+                if (selection.size() <= num_rows * kMaxSelectiveRatio && _can_evaluate_selectively(operand, ptr)) {
+                    evaluated_rows = selection.size();
+                    column = _evaluate_selectively(context, operand, ptr, selection, &false_rows);
+                } else {
+                    column = operand.expr->evaluate(context, ptr);
+                    false_rows = ColumnHelper::count_false_with_notnull(column);
+                }
+            }
+
+            OperandStats& stats = *operand.stats;
+            stats.rows.fetch_add(evaluated_rows, std::memory_order_relaxed);
+            stats.false_rows.fetch_add(false_rows, std::memory_order_relaxed);
+            stats.cost_ns.fetch_add(watch.elapsed_time(), std::memory_order_relaxed);
+
+            if (result == nullptr) {
+                result = std::move(column);
+                result_is_operand = true;
+            } else {
+                result = VectorizedLogicPredicateBinaryFunction<AndNullImpl, AndImpl>::template evaluate<TYPE_BOOLEAN>(
+                        result, column);
+                result_is_operand = false;
+            }
+        }
+        return result_is_operand ? result->clone() : result;
+    }
+
+    std::vector<Operand> _operands;
 };
 
 /**
@@ -64,7 +274,21 @@ DEFINE_BINARY_FUNCTION_WITH_IMPL(OrImpl, l_value, r_value) {
 class VectorizedOrCompoundPredicate final : public Predicate {
 public:
     DEFINE_COMPOUND_CONSTRUCT(VectorizedOrCompoundPredicate);
+
+    Status open(RuntimeState* state, ExprContext* context, FunctionContext::FunctionStateScope scope) override {
+        RETURN_IF_ERROR(Expr::open(state, context, scope));
+        // The expr tree is shared by the cloned contexts, the searcher is read only after it's built.
+        if (scope == FunctionContext::FRAGMENT_LOCAL) {
+            _prepare_multi_substring_match(context);
+        }
+        return Status::OK();
+    }
+
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
+        if (_substring_searcher != nullptr) {
+            return _evaluate_multi_substring_match(context, ptr);
+        }
+
         auto l = _children[0]->evaluate(context, ptr);
 
         int l_trues = ColumnHelper::count_true_with_notnull(l);
@@ -77,6 +301,115 @@ public:
 
         return VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
+
+private:
+    static bool _is_or(const Expr* expr) {
+        return expr->node_type() == TExprNodeType::COMPOUND_PRED && expr->op() == TExprOpcode::COMPOUND_OR;
+    }
+
+    // Collect the operands of this OR and the nested ORs, e.g. a, b and c of (a OR b) OR c.
+    static void _collect_operands(Expr* expr, std::vector<Expr*>* operands,
+                                  std::vector<VectorizedOrCompoundPredicate*>* nested_ors) {
+        for (Expr* child : expr->children()) {
+            if (_is_or(child)) {
+                nested_ors->emplace_back(down_cast<VectorizedOrCompoundPredicate*>(child));
+                _collect_operands(child, operands, nested_ors);
+            } else {
+                operands->emplace_back(child);
+            }
+        }
+    }
+
+    // Whether |expr| is `slot LIKE '%xxxx%'` or `slot REGEXP 'xxxx'` with a non-empty constant substring.
+    static bool _is_substring_match(ExprContext* context, Expr* expr, SlotId* slot_id, std::string* search_string) {
+        if (expr->node_type() != TExprNodeType::FUNCTION_CALL || expr->get_num_children() != 2) {
+            return false;
+        }
+        const std::string& fn_name = expr->fn().name.function_name;
+        if (fn_name != "like" && fn_name != "regexp") {
+            return false;
+        }
+        if (!expr->get_child(0)->is_slotref() || !expr->get_child(1)->is_constant()) {
+            return false;
+        }
+        ColumnPtr pattern = expr->get_child(1)->evaluate_const(context);
+        if (pattern == nullptr || pattern->only_null() || pattern->is_null(0)) {
+            return false;
+        }
+        std::string pattern_str = ColumnHelper::get_const_value<TYPE_VARCHAR>(pattern).to_string();
+        if (!LikePredicate::is_substring_pattern(pattern_str, fn_name == "like", search_string) ||
+            search_string->empty()) {
+            return false;
+        }
+        *slot_id = down_cast<ColumnRef*>(expr->get_child(0))->slot_id();
+        return true;
+    }
+
+    // The log search queries have many ORs of LIKE '%xxxx%' on the same column, whose substrings are searched by
+    // one MultiVolnitsky in one pass over each string instead of one pass per LIKE.
+    void _prepare_multi_substring_match(ExprContext* context) {
+        std::vector<Expr*> operands;
+        std::vector<VectorizedOrCompoundPredicate*> nested_ors;
+        _collect_operands(this, &operands, &nested_ors);
+
+        std::map<SlotId, std::vector<std::pair<Expr*, std::string>>> slot_substrings;
+        for (Expr* operand : operands) {
+            SlotId slot_id;
+            std::string search_string;
+            if (_is_substring_match(context, operand, &slot_id, &search_string)) {
+                slot_substrings[slot_id].emplace_back(operand, std::move(search_string));
+            }
+        }
+        const std::vector<std::pair<Expr*, std::string>>* substrings = nullptr;
+        for (const auto& [slot_id, matches] : slot_substrings) {
+            if (substrings == nullptr || matches.size() > substrings->size()) {
+                substrings = &matches;
+            }
+        }
+        if (substrings == nullptr || substrings->size() < 2 || substrings->size() > MultiVolnitsky::max_needles) {
+            return;
+        }
+
+        std::vector<std::string> needles;
+        std::set<Expr*> matched;
+        for (const auto& [operand, search_string] : *substrings) {
+            needles.emplace_back(search_string);
+            matched.emplace(operand);
+        }
+        _substring_value = substrings->front().first->get_child(0);
+        _substring_searcher = std::make_shared<MultiVolnitsky>(std::move(needles));
+        _other_operands.clear();
+        for (Expr* operand : operands) {
+            if (matched.count(operand) == 0) {
+                _other_operands.emplace_back(operand);
+            }
+        }
+        // The nested ORs are evaluated by this one now.
+        for (auto* nested_or : nested_ors) {
+            nested_or->_substring_searcher.reset();
+        }
+    }
+
+    ColumnPtr _evaluate_multi_substring_match(ExprContext* context, vectorized::Chunk* ptr) {
+        ColumnPtr value = context->evaluate(_substring_value, ptr);
+        ColumnPtr result = LikePredicate::multi_substring_match(*_substring_searcher, value);
+        for (Expr* operand : _other_operands) {
+            // all true and not null
+            if (ColumnHelper::count_true_with_notnull(result) == result->size()) {
+                break;
+            }
+            auto r = operand->evaluate(context, ptr);
+            result = VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(
+                    result, r);
+        }
+        return result;
+    }
+
+    std::shared_ptr<MultiVolnitsky> _substring_searcher;
+    // The string operand of the substring matches.
+    Expr* _substring_value = nullptr;
+    // The operands of the ORs other than the substring matches.
+    std::vector<Expr*> _other_operands;
 };
 
 DEFINE_UNARY_FN_WITH_IMPL(CompoundPredNot, l) {
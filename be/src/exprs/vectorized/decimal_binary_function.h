@@ -5,6 +5,7 @@
 #include "column/column_builder.h"
 #include "exprs/vectorized/arithmetic_operation.h"
 #include "exprs/vectorized/binary_function.h"
+#include "runtime/decimalv3.h"
 #include "runtime/primitive_type.h"
 
 namespace starrocks::vectorized {
@@ -86,6 +87,41 @@ struct DecimalBinaryFunction {
         return false;
     }
 
+    // The add/sub/mul of the operands of the same type as the result are evaluated by the batch kernels.
+    template <PrimitiveType LhsType, PrimitiveType RhsType, PrimitiveType ResultType>
+    static constexpr bool is_batch_op =
+            (is_add_op<Op> || is_sub_op<Op> || is_mul_op<Op>) && LhsType == ResultType && RhsType == ResultType;
+
+    // The overflows are checked once per batch, and the overflowed rows are found by the per row operators only if
+    // there are any.
+    template <bool lhs_is_const, bool rhs_is_const, PrimitiveType Type, typename CppType>
+    static inline void batch_evaluate(size_t num_rows, const CppType* lhs_data, const CppType* rhs_data,
+                                      CppType* result_data, NullColumn::ValueType* nulls, bool* has_null) {
+        using BatchOperators = DecimalV3BatchArithmetics<CppType>;
+        bool overflow = false;
+        if constexpr (is_add_op<Op>) {
+            overflow = BatchOperators::template add<lhs_is_const, rhs_is_const>(lhs_data, rhs_data, result_data,
+                                                                                num_rows);
+        } else if constexpr (is_sub_op<Op>) {
+            overflow = BatchOperators::template sub<lhs_is_const, rhs_is_const>(lhs_data, rhs_data, result_data,
+                                                                                num_rows);
+        } else {
+            overflow = BatchOperators::template mul<lhs_is_const, rhs_is_const>(lhs_data, rhs_data, result_data,
+                                                                                num_rows);
+        }
+        if constexpr (check_overflow) {
+            if (UNLIKELY(overflow)) {
+                using BinaryOperator = ArithmeticBinaryOperator<Op, Type>;
+                CppType value;
+                for (size_t i = 0; i < num_rows; i++) {
+                    nulls[i] = BinaryOperator::template apply<true, CppType, CppType, CppType>(
+                            lhs_data[lhs_is_const ? 0 : i], rhs_data[rhs_is_const ? 0 : i], &value);
+                }
+                *has_null = true;
+            }
+        }
+    }
+
     template <bool lhs_is_const, bool rhs_is_const, PrimitiveType LhsType, PrimitiveType RhsType,
               PrimitiveType ResultType>
     static inline ColumnPtr evaluate(const ColumnPtr& lhs, const ColumnPtr& rhs) {
@@ -121,8 +157,13 @@ struct DecimalBinaryFunction {
             // add/sub operation
             if (adjust_scale == 0) {
                 // S(lhs)==S(rhs) no need to adjust
-                all_null = adjust_evaluate<lhs_is_const, rhs_is_const, false, BinaryOperator>(
-                        num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+                if constexpr (is_batch_op<LhsType, RhsType, ResultType>) {
+                    batch_evaluate<lhs_is_const, rhs_is_const, ResultType>(num_rows, lhs_data, rhs_data,
+                                                                           result_data, nulls, &has_null);
+                } else {
+                    all_null = adjust_evaluate<lhs_is_const, rhs_is_const, false, BinaryOperator>(
+                            num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+                }
             } else if (lhs_scale < rhs_scale) {
                 // S(lhs) < S(rhs), scale lhs up by S(rhs)-S(lhs)
                 all_null = adjust_evaluate<lhs_is_const, rhs_is_const, true, BinaryOperator>(
@@ -149,8 +190,13 @@ struct DecimalBinaryFunction {
             }
         } else if constexpr (is_mul_op<Op>) {
             // mul operation, no need to adjust scale
-            all_null = adjust_evaluate<lhs_is_const, rhs_is_const, false, BinaryOperator>(
-                    num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+            if constexpr (is_batch_op<LhsType, RhsType, ResultType>) {
+                batch_evaluate<lhs_is_const, rhs_is_const, ResultType>(num_rows, lhs_data, rhs_data, result_data,
+                                                                       nulls, &has_null);
+            } else {
+                all_null = adjust_evaluate<lhs_is_const, rhs_is_const, false, BinaryOperator>(
+                        num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+            }
         } else if constexpr (is_div_op<Op>) {
             // div operation, scale lhs up by S(rhs)
             if (adjust_scale == 0) {
@@ -6,7 +6,9 @@
 #include "column/const_column.h"
 #include "column/fixed_length_column.h"
 #include "exprs/anyval_util.h"
+#include "exprs/vectorized/batch_udf.h"
 #include "exprs/vectorized/builtin_functions.h"
+#include "exprs/vectorized/function_helper.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/user_function_cache.h"
 
@@ -18,12 +20,16 @@ Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, const
                                            starrocks::ExprContext* context) {
     RETURN_IF_ERROR(Expr::prepare(state, row_desc, context));
 
-    if (!_fn.__isset.fid) {
-        return Status::InternalError("Vectorized engine doesn't implement function " + _fn.name.function_name);
+    if (_fn.binary_type == TFunctionBinaryType::NATIVE) {
+        RETURN_IF_ERROR(BatchUdf::load(_fn, &_user_fn_desc, &_cache_entry));
+        _fn_desc = _user_fn_desc.get();
+    } else {
+        if (!_fn.__isset.fid) {
+            return Status::InternalError("Vectorized engine doesn't implement function " + _fn.name.function_name);
+        }
+        _fn_desc = BuiltinFunctions::find_builtin_function(_fn.fid);
     }
 
-    _fn_desc = BuiltinFunctions::find_builtin_function(_fn.fid);
-
     if (_fn_desc == nullptr || _fn_desc->scalar_function == nullptr) {
         return Status::InternalError("Vectorized engine doesn't implement function " + _fn.name.function_name);
     }
@@ -34,6 +40,10 @@ Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, const
                                                          _children.size()));
     }
 
+    // The user functions and the functions with side effects may not return the same result for the same arguments.
+    const std::string& name = _fn.name.function_name;
+    _is_deterministic = _user_fn_desc == nullptr && name != "rand" && name != "random" && name != "sleep";
+
     FunctionContext::TypeDesc return_type = AnyValUtil::column_type_to_type_desc(_type);
     std::vector<FunctionContext::TypeDesc> args_types;
 
@@ -142,6 +152,14 @@ ColumnPtr VectorizedFunctionCallExpr::evaluate(starrocks::ExprContext* context,
     }
 #endif
 
+    // The function of constant arguments is computed on one row only, rather than on every row of the constants
+    // unpacked by the function.
+    if (_is_deterministic && FunctionHelper::is_all_const(args) && args[0]->size() > 1) {
+        size_t num_rows = args[0]->size();
+        ColumnPtr result = _fn_desc->scalar_function(fn_ctx, FunctionHelper::shrink_const_columns(args));
+        return FunctionHelper::wrap_const_result(result, num_rows);
+    }
+
     ColumnPtr result = _fn_desc->scalar_function(fn_ctx, args);
     // For no args function call (pi, e)
     if (result->is_constant() && ptr != nullptr) {
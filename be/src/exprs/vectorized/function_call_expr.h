@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "common/object_pool.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/builtin_functions.h"
@@ -30,9 +32,14 @@ protected:
 
 private:
     const FunctionDescriptor* _fn_desc;
+    // the descriptor of the batch UDF, which _fn_desc points to.
+    std::shared_ptr<FunctionDescriptor> _user_fn_desc;
 
     // is rand/random function.
     bool _is_rand_function = false;
+
+    // Whether the function always returns the same result for the same arguments.
+    bool _is_deterministic = false;
 };
 
 } // namespace vectorized
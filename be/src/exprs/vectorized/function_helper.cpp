@@ -16,11 +16,11 @@ NullColumnPtr FunctionHelper::union_nullable_column(const ColumnPtr& v1, const C
         const auto& n2 = ColumnHelper::as_raw_column<NullableColumn>(v2)->null_column();
         if (!v1->has_null()) {
             result = std::move(n2->clone());
-        }
-        if (!v2->has_null()) {
+        } else if (!v2->has_null()) {
             result = std::move(n1->clone());
+        } else {
+            return union_null_column(n1, n2);
         }
-        return union_null_column(n1, n2);
     } else if (v1->is_nullable()) {
         result = std::move(ColumnHelper::as_raw_column<NullableColumn>(v1)->null_column()->clone());
     } else if (v2->is_nullable()) {
@@ -94,5 +94,42 @@ NullColumnPtr FunctionHelper::union_null_column(const NullColumnPtr& v1, const N
     return null_result;
 }
 
+bool FunctionHelper::is_all_const(const Columns& columns) {
+    if (columns.empty()) {
+        return false;
+    }
+    for (const auto& column : columns) {
+        if (!column->is_constant()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Columns FunctionHelper::shrink_const_columns(const Columns& columns) {
+    Columns shrunk;
+    shrunk.reserve(columns.size());
+    for (const auto& column : columns) {
+        DCHECK(column->is_constant());
+        shrunk.emplace_back(ConstColumn::create(down_cast<ConstColumn*>(column.get())->data_column(), 1));
+    }
+    return shrunk;
+}
+
+ColumnPtr FunctionHelper::wrap_const_result(const ColumnPtr& result, size_t num_rows) {
+    // The result may be one of the arguments, which mustn't be resized.
+    if (result->is_constant()) {
+        return ConstColumn::create(down_cast<ConstColumn*>(result.get())->data_column(), num_rows);
+    }
+    DCHECK_EQ(1, result->size());
+    if (result->is_nullable()) {
+        if (result->is_null(0)) {
+            return ColumnHelper::create_const_null_column(num_rows);
+        }
+        return ConstColumn::create(down_cast<NullableColumn*>(result.get())->data_column(), num_rows);
+    }
+    return ConstColumn::create(result, num_rows);
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -39,6 +39,27 @@ public:
                                               NullColumnPtr* produce_null_column);
 
     static NullColumnPtr union_null_column(const NullColumnPtr& v1, const NullColumnPtr& v2);
+
+    /**
+     * Whether the function of the columns can be computed on their first rows only,
+     * i.e. all of them are constant.
+     * @param columns
+     */
+    static bool is_all_const(const Columns& columns);
+
+    /**
+     * Take the constant columns of one row, the function of them is computed only once.
+     * @param columns the constant columns
+     */
+    static Columns shrink_const_columns(const Columns& columns);
+
+    /**
+     * Wrap the result of the function computed on the shrunk constant columns
+     * as a constant column of num_rows rows.
+     * @param result
+     * @param num_rows
+     */
+    static ColumnPtr wrap_const_result(const ColumnPtr& result, size_t num_rows);
 };
 
 #define DEFINE_VECTORIZED_FN(NAME) static ColumnPtr NAME(FunctionContext* context, const Columns& columns)
@@ -7,6 +7,7 @@
 #include "column/column_viewer.h"
 #include "common/logging.h"
 #include "geo/geo_types.h"
+#include "gutil/casts.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -327,6 +328,9 @@ Status GeoFunctions::st_contains_prepare(FunctionContext* ctx, FunctionContext::
                 contains_ctx->shapes[i] = GeoShape::from_encoded(str_value.data, str_value.size);
                 if (contains_ctx->shapes[i] == nullptr) {
                     contains_ctx->is_null = true;
+                } else if (i == 0 && contains_ctx->shapes[i]->type() == GEO_SHAPE_POLYGON) {
+                    // A constant polygon is tested against all the rows.
+                    down_cast<GeoPolygon*>(contains_ctx->shapes[i])->build_coverings();
                 }
             }
         }
@@ -347,6 +351,10 @@ ColumnPtr GeoFunctions::st_contains(FunctionContext* context, const Columns& col
         return ColumnHelper::create_const_null_column(columns[0]->size());
     }
 
+    // The shapes decoded for the last rows, which are reused by the following rows of the same values, e.g. the rows
+    // of a build side polygon in a cross join, so a polygon and the index built by its first test are reused.
+    std::unique_ptr<GeoShape> last_shapes[2];
+    Slice last_values[2];
     auto size = columns[0]->size();
     for (int row = 0; row < size; ++row) {
         if (lhs_viewer.is_null(row) || rhs_viewer.is_null(row)) {
@@ -354,22 +362,22 @@ ColumnPtr GeoFunctions::st_contains(FunctionContext* context, const Columns& col
             continue;
         }
 
-        GeoShape* shapes[2] = {nullptr, nullptr};
-        auto lhs_value = lhs_viewer.value(row);
-        auto rhs_value = rhs_viewer.value(row);
-        const Slice* strs[2] = {&lhs_value, &rhs_value};
-        // use this to delete new
-        StContainsState local_state;
+        const GeoShape* shapes[2] = {nullptr, nullptr};
+        Slice values[2] = {lhs_viewer.value(row), rhs_viewer.value(row)};
         int i;
         for (i = 0; i < 2; ++i) {
             if (state != nullptr && state->shapes[i] != nullptr) {
                 shapes[i] = state->shapes[i];
-            } else {
-                shapes[i] = local_state.shapes[i] = GeoShape::from_encoded(strs[i]->data, strs[i]->size);
-                if (shapes[i] == nullptr) {
-                    result.append_null();
-                    break;
-                }
+                continue;
+            }
+            if (last_shapes[i] == nullptr || values[i] != last_values[i]) {
+                last_shapes[i].reset(GeoShape::from_encoded(values[i].data, values[i].size));
+                last_values[i] = values[i];
+            }
+            shapes[i] = last_shapes[i].get();
+            if (shapes[i] == nullptr) {
+                result.append_null();
+                break;
             }
         }
 
@@ -5,6 +5,7 @@
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "column/fixed_value_set.h"
 #include "column/hash_set.h"
 #include "common/object_pool.h"
 #include "exprs/predicate.h"
@@ -121,6 +122,10 @@ public:
             }
         }
 
+        // The values of the join runtime filters are inserted later.
+        if (scope == FunctionContext::FRAGMENT_LOCAL && !_is_join_runtime_filter) {
+            _build_value_set();
+        }
         return Status::OK();
     }
 
@@ -144,13 +149,11 @@ public:
         auto data3 = result->get_data().data();
 
         if (!lhs->is_constant()) {
-            for (int row = 0; row < size; ++row) {
-                if (_hash_set.contains(data[row])) {
-                    data3[row] = yes_value;
-                } else {
-                    data3[row] = no_value;
+            _visit_value_set([&](const auto& value_set) {
+                for (int row = 0; row < size; ++row) {
+                    data3[row] = value_set.contains(data[row]) ? yes_value : no_value;
                 }
-            }
+            });
         } else {
             if (size > 0) {
                 bool value = _hash_set.contains(data[0]) ? yes_value : no_value;
@@ -173,26 +176,28 @@ public:
 
         const bool yes_value = !_is_not_in;
         const bool no_value = _is_not_in;
-        for (int row = 0; row < viewer.size(); ++row) {
-            if (viewer.is_null(row)) {
-                if constexpr (equal_null) {
+        _visit_value_set([&](const auto& value_set) {
+            for (int row = 0; row < viewer.size(); ++row) {
+                if (viewer.is_null(row)) {
+                    if constexpr (equal_null) {
+                        builder.append(yes_value);
+                    } else {
+                        builder.append_null();
+                    }
+                    continue;
+                }
+                // find value
+                if (value_set.contains(viewer.value(row))) {
                     builder.append(yes_value);
+                    continue;
+                }
+                if constexpr (!null_in_set || equal_null) {
+                    builder.append(no_value);
                 } else {
                     builder.append_null();
                 }
-                continue;
-            }
-            // find value
-            if (_hash_set.contains(viewer.value(row))) {
-                builder.append(yes_value);
-                continue;
             }
-            if constexpr (!null_in_set || equal_null) {
-                builder.append(no_value);
-            } else {
-                builder.append_null();
-            }
-        }
+        });
 
         return builder.build(lhs->is_constant());
     }
@@ -237,6 +242,56 @@ public:
     void set_eq_null(bool value) { _eq_null = value; }
 
 private:
+    using CppType = RunTimeCppType<Type>;
+
+    // The representations of the constant values, which are cheaper to probe than the hash set.
+    enum ValueSetType { HASH_SET, FIXED_ARRAY_SET, DENSE_BITMAP_SET, PERFECT_HASH_SET };
+
+    static constexpr size_t kMaxFixedArraySetSize = 8;
+
+    void _build_value_set() {
+        _value_set_type = HASH_SET;
+        if (_hash_set.empty()) {
+            return;
+        }
+        std::vector<CppType> values(_hash_set.begin(), _hash_set.end());
+        if constexpr (isSlicePT<Type>) {
+            if (_perfect_hash_set.init(values)) {
+                _value_set_type = PERFECT_HASH_SET;
+            }
+        } else {
+            if constexpr (DenseBitmapSet<CppType>::is_supported) {
+                if (_bitmap_set.init(values)) {
+                    _value_set_type = DENSE_BITMAP_SET;
+                    return;
+                }
+            }
+            if (_array_set.init(values)) {
+                _value_set_type = FIXED_ARRAY_SET;
+            }
+        }
+    }
+
+    // Calls func with the chosen set, so that the set is probed without dispatching per row.
+    template <typename Func>
+    void _visit_value_set(Func&& func) const {
+        if constexpr (isSlicePT<Type>) {
+            if (_value_set_type == PERFECT_HASH_SET) {
+                return func(_perfect_hash_set);
+            }
+        } else {
+            if constexpr (DenseBitmapSet<CppType>::is_supported) {
+                if (_value_set_type == DENSE_BITMAP_SET) {
+                    return func(_bitmap_set);
+                }
+            }
+            if (_value_set_type == FIXED_ARRAY_SET) {
+                return func(_array_set);
+            }
+        }
+        return func(_hash_set);
+    }
+
     const bool _is_not_in;
     bool _is_prepare;
     bool _null_in_set;
@@ -244,6 +299,10 @@ private:
     bool _eq_null = false;
 
     PHashSetType<Type> _hash_set;
+    ValueSetType _value_set_type = HASH_SET;
+    FixedArraySet<CppType, kMaxFixedArraySetSize> _array_set;
+    DenseBitmapSet<CppType> _bitmap_set;
+    SlicePerfectHashSet _perfect_hash_set;
     // Ensure the string memory don't early free
     std::vector<ColumnPtr> _string_values;
 };
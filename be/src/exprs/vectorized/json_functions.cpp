@@ -14,6 +14,7 @@
 #include "column/column_viewer.h"
 #include "common/status.h"
 #include "rapidjson/error/en.h"
+#include "util/json_binary.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -247,57 +248,78 @@ void JsonFunctions::parse_json_paths(const std::string& path_string, std::vector
     get_parsed_paths(paths, parsed_paths);
 }
 
-rapidjson::Value* JsonFunctions::get_json_object(FunctionContext* context, const std::string& json_string,
-                                                 const std::string& path_string, const JsonFunctionType& fntype,
-                                                 rapidjson::Document* document) {
-    // split path by ".", and escape quota by "\"
-    // eg:
-    //    '$.text#abc.xyz'  ->  [$, text#abc, xyz]
-    //    '$."text.abc".xyz'  ->  [$, text.abc, xyz]
-    //    '$."text.abc"[1].xyz'  ->  [$, text.abc[1], xyz]
-    std::vector<JsonPath>* parsed_paths;
-    std::vector<JsonPath> tmp_parsed_paths;
-#ifndef BE_TEST
-    parsed_paths =
-            reinterpret_cast<std::vector<JsonPath>*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
-    if (parsed_paths == nullptr) {
-        boost::tokenizer<boost::escaped_list_separator<char> > tok(
-                path_string, boost::escaped_list_separator<char>("\\", ".", "\""));
-        std::vector<std::string> paths(tok.begin(), tok.end());
-        get_parsed_paths(paths, &tmp_parsed_paths);
-        parsed_paths = &tmp_parsed_paths;
-    }
-#else
-    boost::tokenizer<boost::escaped_list_separator<char> > tok(path_string,
-                                                               boost::escaped_list_separator<char>("\\", ".", "\""));
-    std::vector<std::string> paths(tok.begin(), tok.end());
-    get_parsed_paths(paths, &tmp_parsed_paths);
-    parsed_paths = &tmp_parsed_paths;
-#endif
-
-    VLOG(10) << "first parsed path: " << (*parsed_paths)[0].debug_string();
+rapidjson::Value* JsonFunctions::get_json_object(const Slice& json, const std::vector<JsonPath>& parsed_paths,
+                                                 const JsonFunctionType& fntype, rapidjson::Document* document) {
+    VLOG(10) << "first parsed path: " << parsed_paths[0].debug_string();
 
-    if (!(*parsed_paths)[0].is_valid) {
-        return document;
+    if (!parsed_paths[0].is_valid) {
+        return nullptr;
     }
 
-    if (UNLIKELY((*parsed_paths).size() == 1)) {
-        if (fntype == JSON_FUN_STRING) {
-            document->SetString(json_string.c_str(), document->GetAllocator());
-        } else {
-            return document;
-        }
+    if (UNLIKELY(parsed_paths.size() == 1) && fntype != JSON_FUN_STRING) {
+        return nullptr;
     }
 
-    //rapidjson::Document document;
-    document->Parse(json_string.c_str());
+    document->Parse(json.data, json.size);
     if (UNLIKELY(document->HasParseError())) {
         VLOG(1) << "Error at offset " << document->GetErrorOffset() << ": "
                 << GetParseError_En(document->GetParseError());
         document->SetNull();
         return document;
     }
-    return match_value(*parsed_paths, document, document->GetAllocator());
+    return match_value(parsed_paths, document, document->GetAllocator());
+}
+
+rapidjson::Value* JsonFunctions::get_json_object_from_binary(const Slice& json,
+                                                             const std::vector<JsonPath>& parsed_paths,
+                                                             const JsonFunctionType& fntype,
+                                                             rapidjson::Document* document) {
+    if (!parsed_paths[0].is_valid) {
+        return nullptr;
+    }
+
+    if (UNLIKELY(parsed_paths.size() == 1) && fntype != JSON_FUN_STRING) {
+        return nullptr;
+    }
+
+    JsonBinaryValue root;
+    if (UNLIKELY(!JsonBinaryValue::from_binary(json, &root))) {
+        document->SetNull();
+        return document;
+    }
+    // The keys of the objects and the indexes of the arrays are found in the binary form, the other paths, i.e.
+    // [*] and the keys of the arrays of objects, are matched in the DOM.
+    for (int i = 1; i < parsed_paths.size(); i++) {
+        const JsonPath& path = parsed_paths[i];
+        if (root.type() == JsonBinaryValue::NULL_VALUE || UNLIKELY(!path.is_valid)) {
+            return nullptr;
+        }
+        if (path.idx == -2 || (!path.key.empty() && root.type() == JsonBinaryValue::ARRAY)) {
+            JsonBinaryValue::from_binary(json, &root);
+            if (UNLIKELY(!root.to_rapidjson(document, document->GetAllocator()))) {
+                document->SetNull();
+                return document;
+            }
+            return match_value(parsed_paths, document, document->GetAllocator());
+        }
+        JsonBinaryValue child;
+        if (!path.key.empty()) {
+            if (!root.find_member(Slice(path.key), &child)) {
+                return nullptr;
+            }
+            root = child;
+        }
+        if (path.idx != -1) {
+            if (!root.element_at(path.idx, &child)) {
+                return nullptr;
+            }
+            root = child;
+        }
+    }
+    if (UNLIKELY(!root.to_rapidjson(document, document->GetAllocator()))) {
+        document->SetNull();
+    }
+    return document;
 }
 
 JsonFunctionType JsonTypeTraits<TYPE_INT>::JsonType = JSON_FUN_INT;
@@ -309,6 +331,20 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
     auto json_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto path_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
 
+    // The constant path is compiled once in json_path_prepare, the other paths are compiled again only if they're
+    // different from the path of the previous row.
+    auto* const_parsed_paths =
+            reinterpret_cast<std::vector<JsonPath>*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+    std::string path_string;
+    std::vector<JsonPath> row_parsed_paths;
+
+    // The DOMs of all the rows are allocated from the same buffer, which is cleared before parsing each row,
+    // instead of allocating and freeing the memory of a new DOM for each row.
+    std::unique_ptr<char[]> parse_buffer(new char[kJsonParseBufferSize]);
+    rapidjson::MemoryPoolAllocator<> allocator(parse_buffer.get(), kJsonParseBufferSize);
+    rapidjson::Document document(&allocator);
+    rapidjson::StringBuffer buf;
+
     ColumnBuilder<primitive_type> result;
     auto size = columns[0]->size();
     for (int row = 0; row < size; ++row) {
@@ -322,20 +358,35 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
             result.append_null();
             continue;
         }
-        std::string json_string(json_value.data, json_value.size);
 
-        auto path_value = path_viewer.value(row);
-        std::string path_string(path_value.data, path_value.size);
-        // Must remove or replace the escape sequence.
-        path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
-        if (path_string.empty()) {
-            result.append_null();
-            continue;
+        const std::vector<JsonPath>* parsed_paths = const_parsed_paths;
+        if (parsed_paths == nullptr) {
+            auto path_value = path_viewer.value(row);
+            if (row_parsed_paths.empty() || path_value != Slice(path_string)) {
+                path_string.assign(path_value.data, path_value.size);
+                // Must remove or replace the escape sequence.
+                std::string path_str = path_string;
+                path_str.erase(std::remove(path_str.begin(), path_str.end(), '\\'), path_str.end());
+                row_parsed_paths.clear();
+                if (!path_str.empty()) {
+                    parse_json_paths(path_str, &row_parsed_paths);
+                }
+            }
+            if (row_parsed_paths.empty()) {
+                result.append_null();
+                continue;
+            }
+            parsed_paths = &row_parsed_paths;
         }
 
-        rapidjson::Document document;
-        rapidjson::Value* root = JsonFunctions::get_json_object(context, json_string, path_string,
-                                                                JsonTypeTraits<primitive_type>::JsonType, &document);
+        allocator.Clear();
+        rapidjson::Value* root = nullptr;
+        if (JsonBinaryValue::is_binary(json_value)) {
+            root = get_json_object_from_binary(json_value, *parsed_paths, JsonTypeTraits<primitive_type>::JsonType,
+                                               &document);
+        } else {
+            root = get_json_object(json_value, *parsed_paths, JsonTypeTraits<primitive_type>::JsonType, &document);
+        }
 
         if constexpr (primitive_type == TYPE_INT) {
             if (root != nullptr && root->IsInt()) {
@@ -357,12 +408,12 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
             if (root == nullptr || root->IsNull()) {
                 result.append_null();
             } else if (root->IsString()) {
-                result.append(Slice(root->GetString()));
+                result.append(Slice(root->GetString(), root->GetStringLength()));
             } else {
-                rapidjson::StringBuffer buf;
+                buf.Clear();
                 rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
                 root->Accept(writer);
-                result.append(Slice(buf.GetString()));
+                result.append(Slice(buf.GetString(), buf.GetSize()));
             }
         }
     }
@@ -382,6 +433,40 @@ ColumnPtr JsonFunctions::get_json_string(FunctionContext* context, const Columns
     return JsonFunctions::template iterate_rows<TYPE_VARCHAR>(context, columns);
 }
 
+ColumnPtr JsonFunctions::json_binary(FunctionContext* context, const Columns& columns) {
+    auto json_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
+
+    std::unique_ptr<char[]> parse_buffer(new char[kJsonParseBufferSize]);
+    rapidjson::MemoryPoolAllocator<> allocator(parse_buffer.get(), kJsonParseBufferSize);
+    rapidjson::Document document(&allocator);
+    std::string binary;
+
+    ColumnBuilder<TYPE_VARCHAR> result;
+    auto size = columns[0]->size();
+    for (int row = 0; row < size; ++row) {
+        if (json_viewer.is_null(row)) {
+            result.append_null();
+            continue;
+        }
+        auto json_value = json_viewer.value(row);
+        if (JsonBinaryValue::is_binary(json_value)) {
+            result.append(json_value);
+            continue;
+        }
+        allocator.Clear();
+        document.Parse(json_value.data, json_value.size);
+        if (document.HasParseError()) {
+            result.append_null();
+            continue;
+        }
+        binary.clear();
+        JsonBinaryValue::encode(document, &binary);
+        result.append(Slice(binary));
+    }
+
+    return result.build(ColumnHelper::is_all_const(columns));
+}
+
 std::string JsonFunctions::get_raw_json_string(const rapidjson::Value& value) {
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
@@ -98,6 +98,15 @@ public:
      */
     DEFINE_VECTORIZED_FN(get_json_string);
 
+    /**
+     * Convert the json strings to the binary form of JsonBinaryValue, whose paths are found by get_json_xxx
+     * without parsing them. The strings in the binary form are unchanged, the invalid ones are null.
+     * @param: [json_string]
+     * @paramType: [BinaryColumn]
+     * @return: BinaryColumn
+     */
+    DEFINE_VECTORIZED_FN(json_binary);
+
     /**
      * The `document` parameter must be has parsed.
      * return Value Is Array object
@@ -119,13 +128,21 @@ public:
 
     static std::string get_raw_json_string(const rapidjson::Value& value);
 
+    // The size of the buffer reused by the DOMs of the rows, the DOMs larger than it allocate more memory.
+    static constexpr size_t kJsonParseBufferSize = 64 * 1024;
+
 private:
     template <PrimitiveType primitive_type>
     static ColumnPtr iterate_rows(FunctionContext* context, const Columns& columns);
 
-    static rapidjson::Value* get_json_object(FunctionContext* context, const std::string& json_string,
-                                             const std::string& path_string, const JsonFunctionType& fntype,
-                                             rapidjson::Document* document);
+    // Parse |json| into |document| and return the value of the path, nullptr if the path is invalid.
+    static rapidjson::Value* get_json_object(const Slice& json, const std::vector<JsonPath>& parsed_paths,
+                                             const JsonFunctionType& fntype, rapidjson::Document* document);
+
+    // The same as get_json_object for |json| in the binary form of JsonBinaryValue, which is converted to
+    // |document| only if the path can't be found in it, e.g. [*].
+    static rapidjson::Value* get_json_object_from_binary(const Slice& json, const std::vector<JsonPath>& parsed_paths,
+                                                         const JsonFunctionType& fntype, rapidjson::Document* document);
 
     static rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjson::Value* document,
                                          rapidjson::Document::AllocatorType& mem_allocator,
@@ -320,6 +320,57 @@ ColumnPtr LikePredicate::constant_substring_fn(FunctionContext* context,
     return res;
 }
 
+bool LikePredicate::is_substring_pattern(const std::string& pattern, bool is_like, std::string* search_string) {
+    if (is_like) {
+        // The other patterns are checked first in like_prepare.
+        if (RE2::FullMatch(pattern, LIKE_ENDS_WITH_RE) || RE2::FullMatch(pattern, LIKE_STARTS_WITH_RE) ||
+            RE2::FullMatch(pattern, LIKE_EQUALS_RE) || !RE2::FullMatch(pattern, LIKE_SUBSTRING_RE, search_string)) {
+            return false;
+        }
+        remove_escape_character(search_string);
+        return true;
+    }
+    // The other patterns are checked first in regex_prepare.
+    return !RE2::FullMatch(pattern, EQUALS_RE) && !RE2::FullMatch(pattern, STARTS_WITH_RE) &&
+           !RE2::FullMatch(pattern, ENDS_WITH_RE) && RE2::FullMatch(pattern, SUBSTRING_RE, search_string);
+}
+
+ColumnPtr LikePredicate::multi_substring_match(const MultiVolnitsky& searcher, const ColumnPtr& value) {
+    if (value->only_null()) {
+        return value;
+    }
+
+    auto res = RunTimeColumnType<TYPE_BOOLEAN>::create();
+    if (value->is_constant()) {
+        Slice haystack = ColumnHelper::get_const_value<TYPE_VARCHAR>(value);
+        res->append(searcher.search_any(haystack.data, haystack.size));
+        return ConstColumn::create(res, value->size());
+    }
+
+    BinaryColumn* haystack = nullptr;
+    NullColumnPtr res_null = nullptr;
+    if (value->is_nullable()) {
+        auto haystack_null = ColumnHelper::as_column<NullableColumn>(value);
+        haystack = ColumnHelper::as_raw_column<BinaryColumn>(haystack_null->data_column());
+        res_null = haystack_null->null_column();
+    } else {
+        haystack = ColumnHelper::as_raw_column<BinaryColumn>(value);
+    }
+
+    const std::vector<uint32_t>& offsets = haystack->get_offset();
+    const uint8_t* bytes = haystack->get_bytes().data();
+    res->resize(haystack->size());
+    auto& res_data = res->get_data();
+    for (size_t i = 0; i < haystack->size(); ++i) {
+        res_data[i] = searcher.search_any(bytes + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+    if (value->has_null()) {
+        return NullableColumn::create(res, res_null);
+    }
+    return res;
+}
+
 // regex_match
 ColumnPtr LikePredicate::regex_match(FunctionContext* context, const starrocks::vectorized::Columns& columns,
                                      bool is_like_pattern) {
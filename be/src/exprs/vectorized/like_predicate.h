@@ -13,6 +13,8 @@
 namespace starrocks {
 namespace vectorized {
 
+class MultiVolnitsky;
+
 class LikePredicate {
 public:
     // Like method
@@ -47,6 +49,22 @@ public:
      */
     DEFINE_VECTORIZED_FN(regex);
 
+    // Whether the constant pattern of LIKE, or REGEXP if |is_like| is false, is equivalent to searching for a
+    // constant substring, e.g. '%xxxx%', and the substring is returned in |search_string|.
+    static bool is_substring_pattern(const std::string& pattern, bool is_like, std::string* search_string);
+
+    /**
+     * use for:
+     *  a like "%xxxx%" or a like "%yyyy%" or ...
+     *
+     * all the substrings are searched by |searcher| in one pass over each string
+     *
+     * @param: [string_value]
+     * @paramType: [BinaryColumn]
+     * @return: BooleanColumn
+     */
+    static ColumnPtr multi_substring_match(const MultiVolnitsky& searcher, const ColumnPtr& value);
+
 private:
     /**
      * use for:
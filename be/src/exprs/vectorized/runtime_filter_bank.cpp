@@ -2,6 +2,7 @@
 
 #include "exprs/vectorized/runtime_filter_bank.h"
 
+#include <sstream>
 #include <thread>
 
 #include "column/column.h"
@@ -406,8 +407,16 @@ void RuntimeFilterProbeCollector::evaluate(vectorized::Chunk* chunk) {
     }
 }
 
+// The filter passing more rows than this ratio costs more than it saves, and is disabled.
+static constexpr double kMaxUsefulSelectivity = 0.5;
+// The filter passing less rows than this ratio is used alone.
+static constexpr double kVeryUsefulSelectivity = 0.05;
+// The number of the most selective filters to use.
+static constexpr size_t kMaxUsedFilters = 3;
+
 void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk) {
     _selectivity.clear();
+    std::map<int32_t, double> sampled_selectivity;
     size_t chunk_size = chunk->num_rows();
     vectorized::Column::Filter* selection = nullptr;
     for (auto& it : _descriptors) {
@@ -419,16 +428,18 @@ void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk) {
         _run_filter_nums += 1;
         size_t true_count = SIMD::count_nonzero(new_selection);
         double selectivity = true_count * 1.0 / chunk_size;
-        if (selectivity <= 0.5) {     // useful filter
-            if (selectivity < 0.05) { // very useful filter, could early return
+        sampled_selectivity.emplace(rf_desc->filter_id(), selectivity);
+        if (selectivity <= kMaxUsefulSelectivity) { // useful filter
+            if (selectivity < kVeryUsefulSelectivity) { // very useful filter, could early return
                 _selectivity.clear();
                 _selectivity.emplace(selectivity, rf_desc);
                 chunk->filter(new_selection);
+                update_selectivity_profile(sampled_selectivity);
                 return;
             }
 
-            // Only choose three most selective runtime filters
-            if (_selectivity.size() < 3) {
+            // Only choose the most selective runtime filters
+            if (_selectivity.size() < kMaxUsedFilters) {
                 _selectivity.emplace(selectivity, rf_desc);
             } else {
                 auto it = _selectivity.end();
@@ -454,6 +465,22 @@ void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk) {
     if (!_selectivity.empty()) {
         chunk->filter(*selection);
     }
+    update_selectivity_profile(sampled_selectivity);
+}
+
+void RuntimeFilterProbeCollector::update_selectivity_profile(const std::map<int32_t, double>& sampled_selectivity) {
+    std::stringstream ss;
+    size_t num_disabled = 0;
+    for (const auto& [filter_id, selectivity] : sampled_selectivity) {
+        bool used = false;
+        for (const auto& kv : _selectivity) {
+            used |= kv.second->filter_id() == filter_id;
+        }
+        num_disabled += !used;
+        ss << "[" << filter_id << ": " << selectivity << (used ? " used" : " disabled") << "]";
+    }
+    COUNTER_SET(_join_runtime_filter_disabled_counter, static_cast<int64_t>(num_disabled));
+    _runtime_profile->add_info_string("JoinRuntimeFilterSelectivity", ss.str());
 }
 
 void RuntimeFilterProbeCollector::push_down(RuntimeFilterProbeCollector* parent,
@@ -493,6 +520,7 @@ void RuntimeFilterProbeCollector::init_counter() {
     _join_runtime_filter_input_counter = ADD_COUNTER(_runtime_profile, "JoinRuntimeFilterInputRows", TUnit::UNIT);
     _join_runtime_filter_output_counter = ADD_COUNTER(_runtime_profile, "JoinRuntimeFilterOutputRows", TUnit::UNIT);
     _join_runtime_filter_eval_counter = ADD_COUNTER(_runtime_profile, "JoinRuntimeFilterEvaluate", TUnit::UNIT);
+    _join_runtime_filter_disabled_counter = ADD_COUNTER(_runtime_profile, "JoinRuntimeFilterDisabled", TUnit::UNIT);
 }
 
 void RuntimeFilterProbeCollector::wait() {
@@ -143,11 +143,15 @@ public:
 
 private:
     void update_selectivity(vectorized::Chunk* chunk);
+    // Show the selectivities of the last sampled chunk and whether each filter is used in the profile.
+    void update_selectivity_profile(const std::map<int32_t, double>& sampled_selectivity);
     void do_evaluate(vectorized::Chunk* chunk);
     void init_counter();
     // mapping from filter id to runtime filter descriptor.
     std::map<int32_t, RuntimeFilterProbeDescriptor*> _descriptors;
-    std::map<double, RuntimeFilterProbeDescriptor*> _selectivity;
+    // The filters to evaluate, in the ascending order of their selectivities on the last sampled chunk. The
+    // filters passing most of the rows are disabled until the next sampled chunk.
+    std::multimap<double, RuntimeFilterProbeDescriptor*> _selectivity;
     size_t _input_chunk_nums = 0;
     int _run_filter_nums = 0;
     int _wait_timeout_ms = 0;
@@ -157,6 +161,7 @@ private:
     RuntimeProfile::Counter* _join_runtime_filter_input_counter = nullptr;
     RuntimeProfile::Counter* _join_runtime_filter_output_counter = nullptr;
     RuntimeProfile::Counter* _join_runtime_filter_eval_counter = nullptr;
+    RuntimeProfile::Counter* _join_runtime_filter_disabled_counter = nullptr;
 };
 
 } // namespace vectorized
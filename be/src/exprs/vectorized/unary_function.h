@@ -57,7 +57,7 @@ public:
             }
         }
 
-        if (SIMD::count_nonzero(nulls->get_data())) {
+        if (SIMD::contain_nonzero(nulls->get_data())) {
             return NullableColumn::create(result, nulls);
         }
         return result;
@@ -0,0 +1,36 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "formats/csv/delimiter_finder.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "gutil/bits.h"
+
+namespace starrocks::vectorized::csv {
+
+void find_delimiters(const char* data, size_t size, char d1, char d2, uint32_t base, std::vector<uint32_t>* offsets) {
+    size_t i = 0;
+#ifdef __AVX2__
+    const __m256i v1 = _mm256_set1_epi8(d1);
+    const __m256i v2 = _mm256_set1_epi8(d2);
+    for (; i + 32 <= size; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, v1), _mm256_cmpeq_epi8(bytes, v2));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        while (mask != 0) {
+            offsets->push_back(base + i + Bits::CountTrailingZerosNonZero32(mask));
+            // clear the lowest set bit
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < size; i++) {
+        if (data[i] == d1 || data[i] == d2) {
+            offsets->push_back(base + i);
+        }
+    }
+}
+
+} // namespace starrocks::vectorized::csv
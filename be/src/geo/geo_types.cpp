@@ -22,6 +22,7 @@
 #include "geo/geo_types.h"
 
 #include <s2/s2cap.h>
+#include <s2/s2cell_union.h>
 
 #include "common/compiler_util.h"
 DIAGNOSTIC_PUSH
@@ -33,6 +34,7 @@ DIAGNOSTIC_POP
 #include <s2/s2latlng.h>
 #include <s2/s2polygon.h>
 #include <s2/s2polyline.h>
+#include <s2/s2region_coverer.h>
 #include <s2/util/coding/coder.h>
 #include <s2/util/units/length-units.h>
 #include <stdio.h>
@@ -309,6 +311,8 @@ void GeoPolygon::encode(std::string* buf) {
 bool GeoPolygon::decode(const void* data, size_t size) {
     Decoder decoder(data, size);
     _polygon.reset(new S2Polygon());
+    _exterior_covering.reset();
+    _interior_covering.reset();
     return _polygon->Decode(&decoder);
 }
 
@@ -349,10 +353,28 @@ std::string GeoPolygon::as_wkt() const {
     return ss.str();
 }
 
+void GeoPolygon::build_coverings() {
+    S2RegionCoverer::Options options;
+    // More cells cover the polygon more tightly, and leave less points to the exact test.
+    options.set_max_cells(64);
+    S2RegionCoverer coverer(options);
+    _exterior_covering = std::make_unique<S2CellUnion>(coverer.GetCovering(*_polygon));
+    _interior_covering = std::make_unique<S2CellUnion>(coverer.GetInteriorCovering(*_polygon));
+}
+
 bool GeoPolygon::contains(const GeoShape* rhs) const {
     switch (rhs->type()) {
     case GEO_SHAPE_POINT: {
         const GeoPoint* point = (const GeoPoint*)rhs;
+        if (_exterior_covering != nullptr) {
+            S2CellId cell_id(*point->point());
+            if (!_exterior_covering->Contains(cell_id)) {
+                return false;
+            }
+            if (_interior_covering->Contains(cell_id)) {
+                return true;
+            }
+        }
         return _polygon->Contains(*point->point());
 #if 0
         if (_polygon->Contains(point->point())) {
@@ -31,6 +31,7 @@
 class S2Polyline;
 class S2Polygon;
 class S2Cap;
+class S2CellUnion;
 
 template <typename T>
 class Vector3;
@@ -126,12 +127,19 @@ public:
     bool contains(const GeoShape* rhs) const override;
     std::string as_wkt() const override;
 
+    // Cover the polygon by the S2 cells, by which contains() decides most of the points with a binary search of
+    // their cell ids instead of the exact test. It's worth for a polygon tested against many points.
+    void build_coverings();
+
 protected:
     void encode(std::string* buf) override;
     bool decode(const void* data, size_t size) override;
 
 private:
     std::unique_ptr<S2Polygon> _polygon;
+    // The cells covering the polygon and the cells inside it, null if they're not built.
+    std::unique_ptr<S2CellUnion> _exterior_covering;
+    std::unique_ptr<S2CellUnion> _interior_covering;
 };
 
 class GeoCircle : public GeoShape {
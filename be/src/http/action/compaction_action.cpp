@@ -21,6 +21,9 @@
 
 #include "http/action/compaction_action.h"
 
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
 #include <sstream>
 #include <string>
 
@@ -31,9 +34,11 @@
 #include "http/http_request.h"
 #include "http/http_response.h"
 #include "http/http_status.h"
+#include "storage/data_dir.h"
 #include "storage/olap_define.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
+#include "storage/tablet_manager.h"
 #include "util/json_util.h"
 
 namespace starrocks {
@@ -68,6 +73,66 @@ Status CompactionAction::_handle_show_compaction(HttpRequest* req, std::string*
     return Status::OK();
 }
 
+static rapidjson::Value candidates_to_json(const std::vector<CompactionCandidate>& candidates,
+                                           rapidjson::Document::AllocatorType& allocator) {
+    rapidjson::Value arr(rapidjson::kArrayType);
+    for (const auto& candidate : candidates) {
+        rapidjson::Value item(rapidjson::kObjectType);
+        item.AddMember("tablet_id", candidate.tablet->tablet_id(), allocator);
+        item.AddMember("score", candidate.score, allocator);
+        item.AddMember("rewrite_bytes", candidate.rewrite_bytes, allocator);
+        item.AddMember("priority", candidate.priority, allocator);
+        arr.PushBack(item, allocator);
+    }
+    return arr;
+}
+
+// for viewing the scheduler of the base and cumulative compactions
+Status CompactionAction::_handle_show_scheduler(HttpRequest* req, std::string* json_result) {
+    size_t limit = 10;
+    std::string req_limit = req->param("limit");
+    if (!req_limit.empty()) {
+        try {
+            limit = std::stoull(req_limit);
+        } catch (const std::exception& e) {
+            return Status::InvalidArgument(strings::Substitute("invalid limit $0", req_limit));
+        }
+    }
+
+    rapidjson::Document root;
+    root.SetObject();
+    auto& allocator = root.GetAllocator();
+    rapidjson::Value dirs(rapidjson::kArrayType);
+    auto* tablet_manager = StorageEngine::instance()->tablet_manager();
+    for (DataDir* data_dir : StorageEngine::instance()->get_stores()) {
+        rapidjson::Value dir(rapidjson::kObjectType);
+        rapidjson::Value path;
+        path.SetString(data_dir->path().c_str(), data_dir->path().length(), allocator);
+        dir.AddMember("path", path, allocator);
+
+        CompactionIOBudget::Stats stats = data_dir->compaction_io_budget()->get_stats();
+        dir.AddMember("io_budget_bytes_per_sec", stats.rate, allocator);
+        dir.AddMember("io_budget_tokens", stats.tokens, allocator);
+        dir.AddMember("query_bytes_per_sec", stats.query_bytes_per_sec, allocator);
+        dir.AddMember("compaction_bytes_per_sec", stats.compaction_bytes_per_sec, allocator);
+        dir.AddMember("throttled", stats.throttled, allocator);
+
+        auto base = tablet_manager->get_compaction_candidates(CompactionType::BASE_COMPACTION, data_dir, limit);
+        dir.AddMember("base_compaction_queue", candidates_to_json(base, allocator), allocator);
+        auto cumulative =
+                tablet_manager->get_compaction_candidates(CompactionType::CUMULATIVE_COMPACTION, data_dir, limit);
+        dir.AddMember("cumulative_compaction_queue", candidates_to_json(cumulative, allocator), allocator);
+        dirs.PushBack(dir, allocator);
+    }
+    root.AddMember("data_dirs", dirs, allocator);
+
+    rapidjson::StringBuffer strbuf;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(strbuf);
+    root.Accept(writer);
+    *json_result = std::string(strbuf.GetString());
+    return Status::OK();
+}
+
 void CompactionAction::handle(HttpRequest* req) {
     req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
 
@@ -79,6 +144,14 @@ void CompactionAction::handle(HttpRequest* req) {
         } else {
             HttpChannel::send_reply(req, HttpStatus::OK, json_result);
         }
+    } else if (_type == CompactionActionType::SHOW_SCHEDULER) {
+        std::string json_result;
+        Status st = _handle_show_scheduler(req, &json_result);
+        if (!st.ok()) {
+            HttpChannel::send_reply(req, HttpStatus::OK, to_json(st));
+        } else {
+            HttpChannel::send_reply(req, HttpStatus::OK, json_result);
+        }
     } else {
         HttpChannel::send_reply(req, HttpStatus::OK, to_json(Status::NotSupported("Action not supported")));
     }
@@ -26,7 +26,7 @@
 
 namespace starrocks {
 
-enum CompactionActionType { SHOW_INFO = 1, RUN_COMPACTION = 2 };
+enum CompactionActionType { SHOW_INFO = 1, RUN_COMPACTION = 2, SHOW_SCHEDULER = 3 };
 
 // This action is used for viewing the compaction status.
 // See compaction-action.md for details.
@@ -40,6 +40,8 @@ public:
 
 private:
     Status _handle_show_compaction(HttpRequest* req, std::string* json_result);
+    // Show the IO budget and the queues of the compaction candidates of each data dir.
+    Status _handle_show_scheduler(HttpRequest* req, std::string* json_result);
 
 private:
     CompactionActionType _type;
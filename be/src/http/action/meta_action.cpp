@@ -21,6 +21,9 @@
 
 #include "http/action/meta_action.h"
 
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
 #include <sstream>
 #include <string>
 
@@ -31,6 +34,7 @@
 #include "http/http_request.h"
 #include "http/http_status.h"
 #include "storage/olap_define.h"
+#include "storage/rowset/vectorized/rowset_ndv_sketch.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_meta.h"
@@ -40,8 +44,7 @@ namespace starrocks {
 
 const static std::string HEADER_JSON = "application/json";
 
-Status MetaAction::_handle_header(HttpRequest* req, std::string* json_meta) {
-    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+Status MetaAction::_get_tablet(HttpRequest* req, std::shared_ptr<Tablet>* tablet) {
     std::string req_tablet_id = req->param(TABLET_ID_KEY);
     std::string req_schema_hash = req->param(TABLET_SCHEMA_HASH_KEY);
     uint64_t tablet_id = 0;
@@ -54,11 +57,18 @@ Status MetaAction::_handle_header(HttpRequest* req, std::string* json_meta) {
         return Status::InternalError(strings::Substitute("convert failed, $0", e.what()));
     }
 
-    TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, schema_hash);
-    if (tablet == nullptr) {
+    *tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, schema_hash);
+    if (*tablet == nullptr) {
         LOG(WARNING) << "no tablet for tablet_id:" << tablet_id << " schema hash:" << schema_hash;
         return Status::InternalError("no tablet exist");
     }
+    return Status::OK();
+}
+
+Status MetaAction::_handle_header(HttpRequest* req, std::string* json_meta) {
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    TabletSharedPtr tablet;
+    RETURN_IF_ERROR(_get_tablet(req, &tablet));
     auto mem_tracker = std::make_unique<MemTracker>();
     TabletMetaSharedPtr tablet_meta(new TabletMeta(mem_tracker.get()));
     tablet->generate_tablet_meta_copy(tablet_meta);
@@ -68,17 +78,75 @@ Status MetaAction::_handle_header(HttpRequest* req, std::string* json_meta) {
     return Status::OK();
 }
 
+// The ndv and the nulls of the columns of the latest version, merged from the ndv sketches of its rowsets. A column
+// has no ndv if a rowset with rows has no sketch of it.
+Status MetaAction::_handle_column_stats(HttpRequest* req, std::string* json_result) {
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    TabletSharedPtr tablet;
+    RETURN_IF_ERROR(_get_tablet(req, &tablet));
+    std::vector<RowsetSharedPtr> rowsets;
+    Version version;
+    {
+        std::shared_lock rdlock(tablet->get_header_lock());
+        version = tablet->max_version();
+        if (tablet->capture_consistent_rowsets(Version(0, version.second), &rowsets) != OLAP_SUCCESS) {
+            return Status::InternalError("fail to capture the rowsets of the latest version");
+        }
+    }
+    std::vector<const RowsetMetaPB*> rowset_metas;
+    int64_t num_rows = 0;
+    for (const auto& rowset : rowsets) {
+        rowset_metas.push_back(&rowset->rowset_meta()->get_meta_pb());
+        num_rows += rowset->num_rows();
+    }
+
+    rapidjson::Document root;
+    root.SetObject();
+    auto& allocator = root.GetAllocator();
+    root.AddMember("tablet_id", tablet->tablet_id(), allocator);
+    root.AddMember("version", version.second, allocator);
+    root.AddMember("num_rows", num_rows, allocator);
+    rapidjson::Value columns(rapidjson::kArrayType);
+    const TabletSchema& tablet_schema = tablet->tablet_schema();
+    for (size_t i = 0; i < tablet_schema.num_columns(); i++) {
+        const TabletColumn& column = tablet_schema.column(i);
+        rapidjson::Value item(rapidjson::kObjectType);
+        rapidjson::Value name;
+        name.SetString(column.name().c_str(), column.name().length(), allocator);
+        item.AddMember("name", name, allocator);
+        HyperLogLog hll;
+        int64_t num_nulls = 0;
+        if (vectorized::merge_rowset_ndv_sketches(rowset_metas, column.unique_id(), &hll, &num_nulls)) {
+            item.AddMember("ndv", hll.estimate_cardinality(), allocator);
+            item.AddMember("num_nulls", num_nulls, allocator);
+        }
+        columns.PushBack(item, allocator);
+    }
+    root.AddMember("columns", columns, allocator);
+
+    rapidjson::StringBuffer strbuf;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(strbuf);
+    root.Accept(writer);
+    *json_result = std::string(strbuf.GetString());
+    return Status::OK();
+}
+
 void MetaAction::handle(HttpRequest* req) {
+    std::string json_result;
+    Status status;
     if (_meta_type == META_TYPE::HEADER) {
-        std::string json_meta;
-        Status status = _handle_header(req, &json_meta);
-        std::string status_result = to_json(status);
-        LOG(INFO) << "handle request result:" << status_result;
-        if (status.ok()) {
-            HttpChannel::send_reply(req, HttpStatus::OK, json_meta);
-        } else {
-            HttpChannel::send_reply(req, HttpStatus::INTERNAL_SERVER_ERROR, status_result);
-        }
+        status = _handle_header(req, &json_result);
+    } else if (_meta_type == META_TYPE::COLUMN_STATS) {
+        status = _handle_column_stats(req, &json_result);
+    } else {
+        return;
+    }
+    std::string status_result = to_json(status);
+    LOG(INFO) << "handle request result:" << status_result;
+    if (status.ok()) {
+        HttpChannel::send_reply(req, HttpStatus::OK, json_result);
+    } else {
+        HttpChannel::send_reply(req, HttpStatus::INTERNAL_SERVER_ERROR, status_result);
     }
 }
 
@@ -22,15 +22,20 @@
 #ifndef STARROCKS_BE_SRC_HTTP_ACTION_META_ACTION_H
 #define STARROCKS_BE_SRC_HTTP_ACTION_META_ACTION_H
 
+#include <memory>
+
 #include "common/status.h"
 #include "http/http_handler.h"
 
 namespace starrocks {
 
 class ExecEnv;
+class Tablet;
 
 enum META_TYPE {
     HEADER = 1,
+    // the ndv and the nulls of the columns of the latest version, merged from the ndv sketches of the rowsets
+    COLUMN_STATS = 2,
 };
 
 // Get Meta Info
@@ -43,7 +48,9 @@ public:
     void handle(HttpRequest* req) override;
 
 private:
+    static Status _get_tablet(HttpRequest* req, std::shared_ptr<Tablet>* tablet);
     static Status _handle_header(HttpRequest* req, std::string* json_header);
+    static Status _handle_column_stats(HttpRequest* req, std::string* json_result);
 
     META_TYPE _meta_type;
 };
@@ -45,6 +45,8 @@ public:
 
 private:
     void _visit_simple_metric(const std::string& name, const MetricLabels& labels, Metric* metric);
+    void _visit_summary_metric(const std::string& name, const MetricLabels& labels, HistogramMetric* metric);
+    void _write_labels(const MetricLabels& labels, const std::string& extra_label);
 
 private:
     std::stringstream _ss;
@@ -97,6 +99,11 @@ void PrometheusMetricsVisitor::visit(const std::string& prefix, const std::strin
             _visit_simple_metric(metric_name, it.first, (Metric*)it.second);
         }
         break;
+    case MetricType::SUMMARY:
+        for (auto& it : collector->metrics()) {
+            _visit_summary_metric(metric_name, it.first, (HistogramMetric*)it.second);
+        }
+        break;
     default:
         break;
     }
@@ -105,19 +112,53 @@ void PrometheusMetricsVisitor::visit(const std::string& prefix, const std::strin
 void PrometheusMetricsVisitor::_visit_simple_metric(const std::string& name, const MetricLabels& labels,
                                                     Metric* metric) {
     _ss << name;
-    // labels
-    if (!labels.empty()) {
-        _ss << "{";
-        int i = 0;
-        for (auto& label : labels.labels) {
-            if (i++ > 0) {
-                _ss << ",";
-            }
-            _ss << label.name << "=\"" << label.value << "\"";
+    _write_labels(labels, "");
+    _ss << " " << metric->to_string() << "\n";
+}
+
+// eg:
+// starrocks_be_fragment_request_latency_us{quantile="0.5"} 1024
+// starrocks_be_fragment_request_latency_us{quantile="0.99"} 6144
+// starrocks_be_fragment_request_latency_us_sum 1048576
+// starrocks_be_fragment_request_latency_us_count 512
+void PrometheusMetricsVisitor::_visit_summary_metric(const std::string& name, const MetricLabels& labels,
+                                                     HistogramMetric* metric) {
+    const auto& quantiles = HistogramMetric::exported_quantiles();
+    auto values = metric->percentiles(quantiles);
+    for (size_t i = 0; i < quantiles.size(); ++i) {
+        std::stringstream quantile;
+        quantile << "quantile=\"" << quantiles[i] << "\"";
+        _ss << name;
+        _write_labels(labels, quantile.str());
+        _ss << " " << values[i] << "\n";
+    }
+    _ss << name << "_sum";
+    _write_labels(labels, "");
+    _ss << " " << metric->sum() << "\n";
+    _ss << name << "_count";
+    _write_labels(labels, "");
+    _ss << " " << metric->count() << "\n";
+}
+
+void PrometheusMetricsVisitor::_write_labels(const MetricLabels& labels, const std::string& extra_label) {
+    if (labels.empty() && extra_label.empty()) {
+        return;
+    }
+    _ss << "{";
+    int i = 0;
+    for (auto& label : labels.labels) {
+        if (i++ > 0) {
+            _ss << ",";
         }
-        _ss << "}";
+        _ss << label.name << "=\"" << label.value << "\"";
     }
-    _ss << " " << metric->to_string() << "\n";
+    if (!extra_label.empty()) {
+        if (i > 0) {
+            _ss << ",";
+        }
+        _ss << extra_label;
+    }
+    _ss << "}";
 }
 
 void SimpleCoreMetricsVisitor::visit(const std::string& prefix, const std::string& name, MetricCollector* collector) {
@@ -168,6 +209,7 @@ void JsonMetricsVisitor::visit(const std::string& prefix, const std::string& nam
     switch (collector->type()) {
     case MetricType::COUNTER:
     case MetricType::GAUGE:
+    case MetricType::SUMMARY:
         for (auto& it : collector->metrics()) {
             const MetricLabels& labels = it.first;
             Metric* metric = reinterpret_cast<Metric*>(it.second);
@@ -25,10 +25,14 @@
 #include <gperftools/malloc_extension.h>
 #include <gperftools/profiler.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <sstream>
+#include <vector>
 
 #include "common/config.h"
 #include "http/ev_http_server.h"
@@ -39,6 +43,7 @@
 #include "http/http_response.h"
 #include "runtime/exec_env.h"
 #include "util/bfd_parser.h"
+#include "util/cpu_sampler.h"
 #include "util/file_utils.h"
 
 namespace starrocks {
@@ -136,9 +141,16 @@ void ProfileAction::handle(HttpRequest* req) {
     std::ostringstream tmp_prof_file_name;
     // Build a temporary file name that is hopefully unique.
     tmp_prof_file_name << config::pprof_profile_dir << "/starrocks_profile." << getpid() << "." << rand();
+    // both of the profilers take SIGPROF.
+    bool sampler_running = CpuSampler::instance()->running();
+    CpuSampler::instance()->stop();
     ProfilerStart(tmp_prof_file_name.str().c_str());
     sleep(seconds);
     ProfilerStop();
+    if (sampler_running) {
+        WARN_IF_ERROR(CpuSampler::instance()->start(config::cpu_sampler_frequency, config::cpu_sampler_buffer_samples),
+                      "Fail to restart the cpu sampler");
+    }
     std::ifstream prof_file(tmp_prof_file_name.str().c_str(), std::ios::in);
     std::stringstream ss;
     if (!prof_file.is_open()) {
@@ -155,6 +167,80 @@ void ProfileAction::handle(HttpRequest* req) {
 #endif
 }
 
+// The samples of the last 5 minutes by default.
+static const int kSamplerDefaultSecs = 300;
+static const std::string QUERY_ID_KEY = "query_id";
+
+static int sampler_seconds(HttpRequest* req) {
+    const std::string& seconds_str = req->param(SECOND_KEY);
+    return seconds_str.empty() ? kSamplerDefaultSecs : std::atoi(seconds_str.c_str());
+}
+
+// The folded stacks of the samples of CpuSampler, of the query 'query_id' if it's given, e.g.
+// curl "http://be:8040/pprof/flamegraph?seconds=60&query_id=xxx-yyy" | flamegraph.pl > query.svg
+class FlameGraphAction : public HttpHandler {
+public:
+    FlameGraphAction(BfdParser* parser) : _parser(parser) {}
+    ~FlameGraphAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    std::string _symbolize(void* pc);
+
+    BfdParser* _parser;
+};
+
+std::string FlameGraphAction::_symbolize(void* pc) {
+    char addr[32];
+    snprintf(addr, sizeof(addr), "%lx", reinterpret_cast<uintptr_t>(pc));
+    std::string file_name;
+    std::string func_name;
+    unsigned int lineno = 0;
+    const char* end = nullptr;
+    if (_parser == nullptr || _parser->decode_address(addr, &end, &file_name, &func_name, &lineno) != 0) {
+        return std::string("0x") + addr;
+    }
+    return func_name;
+}
+
+void FlameGraphAction::handle(HttpRequest* req) {
+    std::unique_ptr<UniqueId> query_id;
+    const std::string& query_id_str = req->param(QUERY_ID_KEY);
+    if (!query_id_str.empty()) {
+        size_t pos = query_id_str.find('-');
+        if (pos == std::string::npos) {
+            HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, "Invalid query_id " + query_id_str);
+            return;
+        }
+        query_id = std::make_unique<UniqueId>(query_id_str.substr(0, pos), query_id_str.substr(pos + 1));
+    }
+    std::string stacks;
+    CpuSampler::instance()->folded_stacks(sampler_seconds(req), query_id.get(),
+                                          [this](void* pc) { return _symbolize(pc); }, &stacks);
+    HttpChannel::send_reply(req, stacks);
+}
+
+// The number of the samples of each query, the busiest first.
+class SampledQueriesAction : public HttpHandler {
+public:
+    SampledQueriesAction() = default;
+    ~SampledQueriesAction() override = default;
+
+    void handle(HttpRequest* req) override;
+};
+
+void SampledQueriesAction::handle(HttpRequest* req) {
+    auto samples = CpuSampler::instance()->query_samples(sampler_seconds(req));
+    std::vector<std::pair<UniqueId, int64_t>> queries(samples.begin(), samples.end());
+    std::stable_sort(queries.begin(), queries.end(), [](const auto& l, const auto& r) { return l.second > r.second; });
+    std::stringstream ss;
+    for (const auto& [query_id, count] : queries) {
+        ss << (query_id == UniqueId(0, 0) ? "none" : query_id.to_string()) << " " << count << "\n";
+    }
+    HttpChannel::send_reply(req, ss.str());
+}
+
 class PmuProfileAction : public HttpHandler {
 public:
     PmuProfileAction() {}
@@ -254,6 +340,8 @@ Status PprofActions::setup(ExecEnv* exec_env, EvHttpServer* http_server) {
     http_server->register_handler(HttpMethod::GET, "/pprof/pmuprofile", new PmuProfileAction());
     http_server->register_handler(HttpMethod::GET, "/pprof/contention", new ContentionAction());
     http_server->register_handler(HttpMethod::GET, "/pprof/cmdline", new CmdlineAction());
+    http_server->register_handler(HttpMethod::GET, "/pprof/flamegraph", new FlameGraphAction(exec_env->bfd_parser()));
+    http_server->register_handler(HttpMethod::GET, "/pprof/sampled_queries", new SampledQueriesAction());
     auto action = new SymbolAction(exec_env->bfd_parser());
     http_server->register_handler(HttpMethod::GET, "/pprof/symbol", action);
     http_server->register_handler(HttpMethod::HEAD, "/pprof/symbol", action);
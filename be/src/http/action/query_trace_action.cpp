@@ -0,0 +1,32 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "http/action/query_trace_action.h"
+
+#include <string>
+
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "util/query_trace.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+
+void QueryTraceAction::handle(HttpRequest* req) {
+    const std::string& query_id_str = req->param("query_id");
+    auto pos = query_id_str.find('-');
+    if (pos == std::string::npos || pos == 0 || pos + 1 == query_id_str.size()) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, "invalid query_id, e.g. query_id=<hi>-<lo> in hex\n");
+        return;
+    }
+    UniqueId id(query_id_str.substr(0, pos), query_id_str.substr(pos + 1));
+    std::string result = QueryTrace::instance()->to_chrome_trace(id.to_thrift());
+
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, result);
+}
+
+} // namespace starrocks
@@ -0,0 +1,19 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+// Export the spans of a query as a chrome trace, which can be opened by chrome://tracing or perfetto.
+// e.g. GET /api/query_trace?query_id=b5b9c1a1b4d84f5e-8c1f3c2279ef1b3a
+class QueryTraceAction : public HttpHandler {
+public:
+    QueryTraceAction() = default;
+    ~QueryTraceAction() override = default;
+
+    void handle(HttpRequest* req) override;
+};
+
+} // namespace starrocks
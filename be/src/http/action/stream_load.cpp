@@ -24,6 +24,7 @@
 #include <deque>
 #include <future>
 #include <sstream>
+#include <vector>
 
 // use string iequal
 #include <event2/buffer.h>
@@ -293,18 +294,23 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     auto evbuf = evhttp_request_get_input_buffer(ev_req);
 
     int64_t start_read_data_time = MonotonicNanos();
-    while (evbuffer_get_length(evbuf) > 0) {
-        auto bb = ByteBuffer::allocate(4096);
-        auto remove_bytes = evbuffer_remove(evbuf, bb->ptr, bb->capacity);
-        bb->pos = remove_bytes;
-        bb->flip();
-        auto st = ctx->body_sink->append(bb);
-        if (!st.ok()) {
-            LOG(WARNING) << "append body content failed. errmsg=" << st.get_error_msg() << ctx->brief();
-            ctx->status = st;
-            return;
+    size_t length = evbuffer_get_length(evbuf);
+    if (length > 0) {
+        // Append the segments of the evbuffer in place, the pipe packs them into the buffers of at least
+        // min_chunk_size, which the scanner parses without copying them again.
+        int num_segments = evbuffer_peek(evbuf, -1, nullptr, nullptr, 0);
+        std::vector<evbuffer_iovec> segments(num_segments);
+        evbuffer_peek(evbuf, -1, nullptr, segments.data(), num_segments);
+        for (const auto& segment : segments) {
+            auto st = ctx->body_sink->append(static_cast<const char*>(segment.iov_base), segment.iov_len);
+            if (!st.ok()) {
+                LOG(WARNING) << "append body content failed. errmsg=" << st.get_error_msg() << ctx->brief();
+                ctx->status = st;
+                return;
+            }
+            ctx->receive_bytes += segment.iov_len;
         }
-        ctx->receive_bytes += remove_bytes;
+        evbuffer_drain(evbuf, length);
     }
     ctx->read_data_cost_nanos += (MonotonicNanos() - start_read_data_time);
 }
@@ -49,7 +49,9 @@ public:
 
     static void send_reply(HttpRequest* request, HttpStatus status, const std::string& content);
 
-    static void send_file(HttpRequest* request, int fd, size_t off, size_t size);
+    // send |size| bytes of the file from |off| and close |fd| after it's sent
+    static void send_file(HttpRequest* request, int fd, size_t off, size_t size,
+                          HttpStatus status = HttpStatus::OK);
 };
 
 } // namespace starrocks
@@ -21,7 +21,15 @@
 
 #include "http/http_client.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+
 #include "common/config.h"
+#include "http/http_status.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -202,6 +210,56 @@ Status HttpClient::download(const std::string& local_path) {
     return status;
 }
 
+Status HttpClient::download_range(const std::string& local_path, uint64_t offset, uint64_t length,
+                                  int64_t max_speed_kbps) {
+    set_method(GET);
+    curl_easy_setopt(_curl, CURLOPT_LOW_SPEED_LIMIT, config::download_low_speed_limit_kbps * 1024);
+    curl_easy_setopt(_curl, CURLOPT_LOW_SPEED_TIME, config::download_low_speed_time);
+    curl_easy_setopt(_curl, CURLOPT_MAX_RECV_SPEED_LARGE, (curl_off_t)max_speed_kbps * 1024);
+    std::string range = std::to_string(offset) + "-" + std::to_string(offset + length - 1);
+    curl_easy_setopt(_curl, CURLOPT_RANGE, range.c_str());
+
+    int fd = open(local_path.c_str(), O_WRONLY | O_CREAT, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        LOG(WARNING) << "open file failed, file=" << local_path << ", error=" << errno;
+        return Status::InternalError("open file failed");
+    }
+    DeferOp close_fd([fd] { close(fd); });
+    Status status;
+    uint64_t written = 0;
+    auto callback = [&](const void* data, size_t size) {
+        if (get_http_status() != HttpStatus::PARTIAL_CONTENT) {
+            status = Status::NotSupported("range is not supported by the server");
+            return false;
+        }
+        if (written + size > length) {
+            status = Status::InternalError("received more data than the range");
+            return false;
+        }
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t res = pwrite(fd, p, size, offset + written);
+            if (res < 0) {
+                LOG(WARNING) << "fail to write data to file, file=" << local_path << ", error=" << errno;
+                status = Status::InternalError("fail to write data when download");
+                return false;
+            }
+            p += res;
+            size -= res;
+            written += res;
+        }
+        return true;
+    };
+    Status st = execute(callback);
+    RETURN_IF_ERROR(status);
+    RETURN_IF_ERROR(st);
+    if (written != length) {
+        LOG(WARNING) << "mismatched range size, file=" << local_path << ", range=" << range << ", size=" << written;
+        return Status::InternalError("mismatched range size");
+    }
+    return Status::OK();
+}
+
 Status HttpClient::execute(std::string* response) {
     auto callback = [response](const void* data, size_t length) {
         response->append((char*)data, length);
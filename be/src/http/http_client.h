@@ -113,6 +113,11 @@ public:
     // a file to local_path
     Status download(const std::string& local_path);
 
+    // Download the |length| bytes from |offset| of the remote file into the same range of |local_path| by the Range
+    // header, at most |max_speed_kbps| KB/s. The file is created if it doesn't exist, and isn't truncated, so the
+    // ranges of a file can be downloaded concurrently. Returns NotSupported if the server ignores the range.
+    Status download_range(const std::string& local_path, uint64_t offset, uint64_t length, int64_t max_speed_kbps);
+
     Status execute_post_request(const std::string& payload, std::string* response);
 
     Status execute_delete_request(const std::string& payload, std::string* response);
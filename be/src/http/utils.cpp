@@ -24,6 +24,10 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+
 #include "common/logging.h"
 #include "common/status.h"
 #include "common/utils.h"
@@ -138,13 +142,19 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
     int64_t file_size = st.st_size;
 
     // TODO(lingbin): process "IF_MODIFIED_SINCE" header
-    // TODO(lingbin): process "RANGE" header
+    int64_t offset = 0;
+    int64_t length = file_size;
     const std::string& range_header = req->header(HttpHeaders::RANGE);
-    if (!range_header.empty()) {
-        // analyse range header
+    if (!range_header.empty() && !parse_range_header(range_header, file_size, &offset, &length)) {
+        close(fd);
+        LOG(WARNING) << "Invalid range " << range_header << " of file: " << file_path << ", size=" << file_size;
+        req->add_output_header(HttpHeaders::CONTENT_RANGE, ("bytes */" + std::to_string(file_size)).c_str());
+        HttpChannel::send_error(req, HttpStatus::REQUESTED_RANGE_NOT_SATISFIED);
+        return;
     }
 
     req->add_output_header(HttpHeaders::CONTENT_TYPE, get_content_type(file_path).c_str());
+    req->add_output_header(HttpHeaders::ACCEPT_RANGES, "bytes");
 
     if (req->method() == HttpMethod::HEAD) {
         close(fd);
@@ -153,7 +163,45 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
         return;
     }
 
-    HttpChannel::send_file(req, fd, 0, file_size);
+    if (range_header.empty()) {
+        HttpChannel::send_file(req, fd, 0, file_size);
+    } else {
+        std::string content_range = "bytes " + std::to_string(offset) + "-" + std::to_string(offset + length - 1) +
+                                    "/" + std::to_string(file_size);
+        req->add_output_header(HttpHeaders::CONTENT_RANGE, content_range.c_str());
+        HttpChannel::send_file(req, fd, offset, length, HttpStatus::PARTIAL_CONTENT);
+    }
+}
+
+bool parse_range_header(const std::string& range_header, int64_t file_size, int64_t* offset, int64_t* length) {
+    static const std::string kPrefix = "bytes=";
+    if (range_header.compare(0, kPrefix.size(), kPrefix) != 0) {
+        return false;
+    }
+    std::string spec = range_header.substr(kPrefix.size());
+    size_t dash = spec.find('-');
+    // The suffix ranges "-<n>" and the multiple ranges aren't supported.
+    if (dash == 0 || dash == std::string::npos || spec.find(',') != std::string::npos) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    int64_t first = strtoll(spec.c_str(), &end, 10);
+    if (errno != 0 || end != spec.c_str() + dash || first < 0 || first >= file_size) {
+        return false;
+    }
+    int64_t last = file_size - 1;
+    if (dash + 1 < spec.size()) {
+        const char* last_str = spec.c_str() + dash + 1;
+        last = strtoll(last_str, &end, 10);
+        if (errno != 0 || *end != '\0' || last < first) {
+            return false;
+        }
+        last = std::min(last, file_size - 1);
+    }
+    *offset = first;
+    *length = last - first + 1;
+    return true;
 }
 
 void do_dir_response(const std::string& dir_path, HttpRequest* req) {
@@ -39,6 +39,12 @@ bool parse_basic_auth(const HttpRequest& req, std::string* user, std::string* pa
 
 bool parse_basic_auth(const HttpRequest& req, AuthInfo* auth);
 
+// Parse the single range "bytes=<first>-[<last>]" of the Range header for a file of |file_size| bytes. Returns false
+// if it's malformed or not satisfiable.
+bool parse_range_header(const std::string& range_header, int64_t file_size, int64_t* offset, int64_t* length);
+
+// Respond the file, or the range of it if the request has a Range header. The content is sent by sendfile() of
+// the event buffer without being copied into the user space.
 void do_file_response(const std::string& dir_path, HttpRequest* req);
 
 void do_dir_response(const std::string& dir_path, HttpRequest* req);
@@ -21,6 +21,7 @@
 
 #include "runtime/buffer_control_block.h"
 
+#include "common/config.h"
 #include "gen_cpp/InternalService_types.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "runtime/raw_value.h"
@@ -48,19 +49,12 @@ void GetResultBatchCtx::on_close(int64_t packet_seq, QueryStatistics* statistics
     delete this;
 }
 
-void GetResultBatchCtx::on_data(TFetchDataResult* t_result, int64_t packet_seq, bool eos) {
-    uint8_t* buf = nullptr;
-    uint32_t len = 0;
-    ThriftSerializer ser(false, 4096);
-    auto st = ser.serialize(&t_result->result_batch, &len, &buf);
-    if (st.ok()) {
-        cntl->response_attachment().append(buf, len);
-        result->set_packet_seq(packet_seq);
-        result->set_eos(eos);
-    } else {
-        LOG(WARNING) << "TFetchDataResult serialize failed, errmsg=" << st.get_error_msg();
-    }
-    st.to_protobuf(result->mutable_status());
+void GetResultBatchCtx::on_data(const std::string& data, int64_t packet_seq, bool eos) {
+    cntl->response_attachment().append(data);
+    result->set_packet_seq(packet_seq);
+    result->set_eos(eos);
+    Status status;
+    status.to_protobuf(result->mutable_status());
     done->Run();
     delete this;
 }
@@ -71,81 +65,97 @@ BufferControlBlock::BufferControlBlock(const TUniqueId& id, int buffer_size)
           _is_cancelled(false),
           _buffer_rows(0),
           _buffer_limit(buffer_size),
+          _buffer_bytes(0),
+          _max_buffer_bytes(config::result_buffer_max_bytes),
           _packet_num(0) {}
 
 BufferControlBlock::~BufferControlBlock() {
     cancel();
-
-    for (ResultQueue::iterator iter = _batch_queue.begin(); _batch_queue.end() != iter; ++iter) {
-        delete *iter;
-        *iter = NULL;
-    }
 }
 
 Status BufferControlBlock::init() {
     return Status::OK();
 }
 
-Status BufferControlBlock::add_batch(TFetchDataResult* result) {
-    std::unique_lock<std::mutex> l(_lock);
+Status BufferControlBlock::_serialize(TFetchDataResult* result, SerializedResultBatch* batch) {
+    ThriftSerializer ser(false, 4096);
+    RETURN_IF_ERROR(ser.serialize(&result->result_batch, &batch->data));
+    batch->num_rows = result->result_batch.rows.size();
+    return Status::OK();
+}
 
-    if (_is_cancelled) {
-        return Status::Cancelled("Cancelled BufferControlBlock::add_batch");
+GetResultBatchCtx* BufferControlBlock::_add_batch(SerializedResultBatch* batch, int64_t* packet_seq) {
+    if (_waiting_rpc.empty()) {
+        _buffer_rows += batch->num_rows;
+        _buffer_bytes += batch->data.size();
+        _batch_queue.push_back(std::move(*batch));
+        _data_arriaval.notify_one();
+        return nullptr;
     }
+    auto* ctx = _waiting_rpc.front();
+    _waiting_rpc.pop_front();
+    *packet_seq = _packet_num++;
+    return ctx;
+}
 
-    int num_rows = result->result_batch.rows.size();
-
-    while ((!_batch_queue.empty() && (num_rows + _buffer_rows) > _buffer_limit) && !_is_cancelled) {
-        _data_removal.wait(l);
-    }
+Status BufferControlBlock::add_batch(TFetchDataResult* result) {
+    SerializedResultBatch batch;
+    RETURN_IF_ERROR(_serialize(result, &batch));
 
-    if (_is_cancelled) {
-        return Status::Cancelled("Cancelled BufferControlBlock::add_batch");
+    GetResultBatchCtx* ctx = nullptr;
+    int64_t packet_seq = 0;
+    {
+        std::unique_lock<std::mutex> l(_lock);
+        while (_is_full(batch.num_rows) && !_is_cancelled) {
+            _data_removal.wait(l);
+        }
+        if (_is_cancelled) {
+            return Status::Cancelled("Cancelled BufferControlBlock::add_batch");
+        }
+        ctx = _add_batch(&batch, &packet_seq);
     }
-
-    if (_waiting_rpc.empty()) {
-        _buffer_rows += num_rows;
-        _batch_queue.push_back(result);
-        _data_arriaval.notify_one();
-    } else {
-        auto* ctx = _waiting_rpc.front();
-        _waiting_rpc.pop_front();
-        ctx->on_data(result, _packet_num);
-        delete result;
-        _packet_num++;
+    delete result;
+    if (ctx != nullptr) {
+        ctx->on_data(batch.data, packet_seq);
     }
     return Status::OK();
 }
 
 StatusOr<bool> BufferControlBlock::try_add_batch(TFetchDataResult* result) {
-    std::unique_lock<std::mutex> l(_lock);
-
-    if (_is_cancelled) {
-        return Status::Cancelled("Cancelled BufferControlBlock::add_batch");
+    int num_rows = result->result_batch.rows.size();
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_is_cancelled) {
+            return Status::Cancelled("Cancelled BufferControlBlock::add_batch");
+        }
+        // check before the serialization, which would be repeated by every retry otherwise.
+        if (_is_full(num_rows)) {
+            return false;
+        }
     }
 
-    int num_rows = result->result_batch.rows.size();
+    SerializedResultBatch batch;
+    RETURN_IF_ERROR(_serialize(result, &batch));
 
-    if ((!_batch_queue.empty() && (num_rows + _buffer_rows) > _buffer_limit) && !_is_cancelled) {
-        return false;
+    GetResultBatchCtx* ctx = nullptr;
+    int64_t packet_seq = 0;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_is_cancelled) {
+            return Status::Cancelled("Cancelled BufferControlBlock::add_batch");
+        }
+        // the other producers may have filled the buffer meanwhile, the limits are soft.
+        ctx = _add_batch(&batch, &packet_seq);
     }
-
-    if (_waiting_rpc.empty()) {
-        _buffer_rows += num_rows;
-        _batch_queue.push_back(result);
-        _data_arriaval.notify_one();
-    } else {
-        auto* ctx = _waiting_rpc.front();
-        _waiting_rpc.pop_front();
-        ctx->on_data(result, _packet_num);
-        delete result;
-        _packet_num++;
+    delete result;
+    if (ctx != nullptr) {
+        ctx->on_data(batch.data, packet_seq);
     }
     return true;
 }
 
 Status BufferControlBlock::get_batch(TFetchDataResult* result) {
-    TFetchDataResult* item = NULL;
+    SerializedResultBatch batch;
     {
         std::unique_lock<std::mutex> l(_lock);
 
@@ -175,52 +185,53 @@ Status BufferControlBlock::get_batch(TFetchDataResult* result) {
         }
 
         // get result
-        item = _batch_queue.front();
+        batch = std::move(_batch_queue.front());
         _batch_queue.pop_front();
-        _buffer_rows -= item->result_batch.rows.size();
+        _buffer_rows -= batch.num_rows;
+        _buffer_bytes -= batch.data.size();
         _data_removal.notify_one();
+        result->__set_packet_num(_packet_num);
+        _packet_num++;
     }
-    swap(*result, *item);
-    result->__set_packet_num(_packet_num);
-    _packet_num++;
-    // destruct item new from Result writer
-    delete item;
-    item = NULL;
-
+    uint32_t len = batch.data.size();
+    RETURN_IF_ERROR(deserialize_thrift_msg(reinterpret_cast<const uint8_t*>(batch.data.data()), &len, false,
+                                           &result->result_batch));
+    result->eos = false;
     return Status::OK();
 }
 
 void BufferControlBlock::get_batch(GetResultBatchCtx* ctx) {
-    std::lock_guard<std::mutex> l(_lock);
-    if (!_status.ok()) {
-        ctx->on_failure(_status);
-        return;
-    }
-    if (_is_cancelled) {
-        ctx->on_failure(Status::Cancelled("Cancelled BufferControlBlock::get_batch"));
-        return;
-    }
-    if (!_batch_queue.empty()) {
+    SerializedResultBatch batch;
+    int64_t packet_seq = 0;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (!_status.ok()) {
+            ctx->on_failure(_status);
+            return;
+        }
+        if (_is_cancelled) {
+            ctx->on_failure(Status::Cancelled("Cancelled BufferControlBlock::get_batch"));
+            return;
+        }
+        if (_batch_queue.empty()) {
+            if (_is_close) {
+                ctx->on_close(_packet_num, _query_statistics.get());
+                return;
+            }
+            // no ready data, push ctx to waiting list, the rpcs are answered in order by the next batches.
+            _waiting_rpc.push_back(ctx);
+            return;
+        }
         // get result
-        TFetchDataResult* result = _batch_queue.front();
+        batch = std::move(_batch_queue.front());
         _batch_queue.pop_front();
-        _buffer_rows -= result->result_batch.rows.size();
+        _buffer_rows -= batch.num_rows;
+        _buffer_bytes -= batch.data.size();
         _data_removal.notify_one();
-
-        ctx->on_data(result, _packet_num);
-        _packet_num++;
-
-        delete result;
-        result = nullptr;
-
-        return;
-    }
-    if (_is_close) {
-        ctx->on_close(_packet_num, _query_statistics.get());
-        return;
+        packet_seq = _packet_num++;
     }
-    // no ready data, push ctx to waiting list
-    _waiting_rpc.push_back(ctx);
+    // the batch is copied into the response out of the lock, so the producers aren't stalled by it.
+    ctx->on_data(batch.data, packet_seq);
 }
 
 Status BufferControlBlock::close(Status exec_status) {
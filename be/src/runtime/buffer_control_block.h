@@ -26,6 +26,7 @@
 #include <deque>
 #include <list>
 #include <mutex>
+#include <string>
 
 #include "common/status.h"
 #include "common/statusor.h"
@@ -57,10 +58,20 @@ struct GetResultBatchCtx {
 
     void on_failure(const Status& status);
     void on_close(int64_t packet_seq, QueryStatistics* statistics = nullptr);
-    void on_data(TFetchDataResult* t_result, int64_t packet_seq, bool eos = false);
+    // |data| is the serialized TResultBatch.
+    void on_data(const std::string& data, int64_t packet_seq, bool eos = false);
 };
 
-// buffer used for result customer and productor
+// The result batch serialized by the producer, so that a fetch only has to copy it into the response.
+struct SerializedResultBatch {
+    std::string data;
+    int num_rows = 0;
+};
+
+// buffer used for result customer and productor.
+// The batches are serialized on the producer threads out of the lock, and the buffer is full once it holds more
+// than |buffer_size| rows or config::result_buffer_max_bytes bytes. The fetch rpcs wait in a queue while there's
+// no batch, each of them is answered by the next batch added, and the answers are sent out of the lock.
 class BufferControlBlock {
 public:
     BufferControlBlock(const TUniqueId& id, int buffer_size);
@@ -76,6 +87,12 @@ public:
 
     void get_batch(GetResultBatchCtx* ctx);
 
+    // whether a fetch rpc is waiting for the next batch, the producer sends a small batch at once if so.
+    bool has_waiting_rpc() {
+        std::lock_guard<std::mutex> l(_lock);
+        return !_waiting_rpc.empty();
+    }
+
     // close buffer block, set _status to exec_status and set _is_close to true;
     // called because data has been read or error happend.
     Status close(Status exec_status);
@@ -96,7 +113,16 @@ public:
     }
 
 private:
-    typedef std::list<TFetchDataResult*> ResultQueue;
+    typedef std::list<SerializedResultBatch> ResultQueue;
+
+    static Status _serialize(TFetchDataResult* result, SerializedResultBatch* batch);
+
+    bool _is_full(int num_rows) const {
+        return !_batch_queue.empty() && (_buffer_rows + num_rows > _buffer_limit || _buffer_bytes >= _max_buffer_bytes);
+    }
+
+    // Queue |batch|, or take the waiting rpc to answer with it out of the lock.
+    GetResultBatchCtx* _add_batch(SerializedResultBatch* batch, int64_t* packet_seq);
 
     // result's query id
     TUniqueId _fragment_id;
@@ -105,6 +131,8 @@ private:
     Status _status;
     int _buffer_rows;
     int _buffer_limit;
+    int64_t _buffer_bytes;
+    int64_t _max_buffer_bytes;
     int64_t _packet_num;
 
     // blocking queue for batch
@@ -7,20 +7,12 @@
 #include "runtime/mem_tracker.h"
 
 namespace starrocks {
+// The consumption is accumulated in the thread and committed to the tracker in batches,
+// see CurrentThread::mem_consume.
 class CurrentMemTracker {
 public:
-    inline static void consume(int64_t size) {
-        MemTracker* tracker = CurrentThread::mem_tracker();
-        if (tracker != nullptr && size != 0) {
-            tracker->consume(size);
-        }
-    }
+    inline static void consume(int64_t size) { CurrentThread::mem_consume(size); }
 
-    inline static void release(int64_t size) {
-        MemTracker* tracker = CurrentThread::mem_tracker();
-        if (tracker != nullptr && size != 0) {
-            tracker->release(size);
-        }
-    }
+    inline static void release(int64_t size) { CurrentThread::mem_consume(-size); }
 };
 } // namespace starrocks
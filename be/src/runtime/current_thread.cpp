@@ -0,0 +1,21 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/current_thread.h"
+
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+void CurrentThread::_commit_untracked_bytes() {
+    int64_t bytes = s_tls_untracked_bytes;
+    s_tls_untracked_bytes = 0;
+    if (s_tls_mem_tracker == nullptr) {
+        return;
+    }
+    s_tls_mem_tracker->consume(bytes);
+    // The spare capacity is rechecked on every commit, so a thread switches to exact accounting within one batch
+    // after the consumption approaches a limit, and back to batching after it drops.
+    s_tls_mem_batch_bytes = s_tls_mem_tracker->spare_capacity() < kMemExactMarginBytes ? 0 : kMemBatchBytes;
+}
+
+} // namespace starrocks
@@ -19,22 +19,45 @@ public:
     static void set_query_id(const starrocks::TUniqueId& query_id);
     static const starrocks::TUniqueId& query_id();
     static const std::string& query_id_string();
+    // The query id in the plain integers, which is safe to read in a signal handler.
+    static void query_id_for_signal(int64_t* hi, int64_t* lo);
 
-    // Return old memory tracker.
+    // Return old memory tracker. The bytes consumed but not committed to the old tracker are committed first.
     static starrocks::MemTracker* set_mem_tracker(starrocks::MemTracker* tracker);
     // Return current memory tracker in this thread.
     static starrocks::MemTracker* mem_tracker();
 
+    // Consume |bytes| by the current memory tracker, a negative value releases them. The bytes are accumulated in
+    // the thread and committed to the tracker and its ancestors once they reach kMemBatchBytes, so the threads
+    // don't contend on the consumption of the shared ancestors on every call. Once the spare capacity of the limits
+    // is less than kMemExactMarginBytes, every call commits the bytes to keep the limit checks exact.
+    static void mem_consume(int64_t bytes);
+    // Commit the bytes accumulated in this thread to the current memory tracker.
+    static void mem_tracker_flush();
+
+    static constexpr int64_t kMemBatchBytes = 1024 * 1024;
+    static constexpr int64_t kMemExactMarginBytes = 256 * 1024 * 1024;
+
 private:
+    static void _commit_untracked_bytes();
+
     // `__thread` is faster than `thread_local`.
     static inline __thread starrocks::MemTracker* s_tls_mem_tracker{nullptr}; // NOLINT
+    // the bytes consumed by this thread but not committed to s_tls_mem_tracker yet
+    static inline __thread int64_t s_tls_untracked_bytes{0}; // NOLINT
+    // the bytes accumulated before they're committed, 0 near the limits
+    static inline __thread int64_t s_tls_mem_batch_bytes{kMemBatchBytes}; // NOLINT
     static inline thread_local starrocks::TUniqueId s_tls_query_id{};         // NOLINT
     static inline thread_local std::string s_tls_str_query_id{};              // NOLINT
+    static inline __thread int64_t s_tls_query_id_hi{0};                      // NOLINT
+    static inline __thread int64_t s_tls_query_id_lo{0};                      // NOLINT
 };
 
 inline void CurrentThread::set_query_id(const starrocks::TUniqueId& query_id) {
     s_tls_query_id = query_id;
     s_tls_str_query_id = starrocks::print_id(query_id);
+    s_tls_query_id_hi = query_id.hi;
+    s_tls_query_id_lo = query_id.lo;
 }
 
 inline const starrocks::TUniqueId& CurrentThread::query_id() {
@@ -45,9 +68,16 @@ inline const std::string& CurrentThread::query_id_string() {
     return s_tls_str_query_id;
 }
 
+inline void CurrentThread::query_id_for_signal(int64_t* hi, int64_t* lo) {
+    *hi = s_tls_query_id_hi;
+    *lo = s_tls_query_id_lo;
+}
+
 inline starrocks::MemTracker* CurrentThread::set_mem_tracker(starrocks::MemTracker* tracker) {
+    mem_tracker_flush();
     auto* r = s_tls_mem_tracker;
     s_tls_mem_tracker = tracker;
+    s_tls_mem_batch_bytes = kMemBatchBytes;
     return r;
 }
 
@@ -55,4 +85,20 @@ inline starrocks::MemTracker* CurrentThread::mem_tracker() {
     return s_tls_mem_tracker;
 }
 
+inline void CurrentThread::mem_consume(int64_t bytes) {
+    if (s_tls_mem_tracker == nullptr) {
+        return;
+    }
+    s_tls_untracked_bytes += bytes;
+    if (s_tls_untracked_bytes >= s_tls_mem_batch_bytes || s_tls_untracked_bytes <= -s_tls_mem_batch_bytes) {
+        _commit_untracked_bytes();
+    }
+}
+
+inline void CurrentThread::mem_tracker_flush() {
+    if (s_tls_untracked_bytes != 0) {
+        _commit_untracked_bytes();
+    }
+}
+
 } // namespace starrocks
@@ -128,7 +128,8 @@ Status DataStreamMgr::transmit_data(const PTransmitDataParams* request, ::google
     return Status::OK();
 }
 
-Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, const butil::IOBuf* attachment,
+                                     ::google::protobuf::Closure** done) {
     const PUniqueId& finst_id = request.finst_id();
     // TODO(zc): Use PUniqueId directly
     // We can use PUniqueId directly, because old version StarRocks has already use
@@ -157,7 +158,7 @@ Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::goog
 
     bool eos = request.eos();
     if (request.chunks_size() > 0) {
-        RETURN_IF_ERROR(recvr->add_chunks(request, eos ? nullptr : done));
+        RETURN_IF_ERROR(recvr->add_chunks(request, attachment, eos ? nullptr : done));
     }
     if (eos) {
         recvr->remove_sender(request.sender_id(), request.be_number());
@@ -165,6 +166,27 @@ Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::goog
     return Status::OK();
 }
 
+Status DataStreamMgr::transmit_local_chunk(const TUniqueId& fragment_instance_id, PlanNodeId node_id, int sender_id,
+                                           int be_number, vectorized::ChunkUniquePtr chunk, bool eos,
+                                           const PQueryStatistics* query_statistics,
+                                           ::google::protobuf::Closure** done) {
+    std::shared_ptr<DataStreamRecvr> recvr = find_recvr(fragment_instance_id, node_id);
+    if (recvr == nullptr) {
+        // the receiver may have removed itself, see transmit_chunk
+        return Status::OK();
+    }
+    if (query_statistics != nullptr) {
+        recvr->add_sub_plan_statistics(*query_statistics, sender_id);
+    }
+    if (chunk != nullptr) {
+        RETURN_IF_ERROR(recvr->add_local_chunk(sender_id, be_number, std::move(chunk), eos ? nullptr : done));
+    }
+    if (eos) {
+        recvr->remove_sender(sender_id, be_number);
+    }
+    return Status::OK();
+}
+
 Status DataStreamMgr::deregister_recvr(const TUniqueId& fragment_instance_id, PlanNodeId node_id) {
     std::shared_ptr<DataStreamRecvr> targert_recvr;
     VLOG_QUERY << "deregister_recvr(): fragment_instance_id=" << fragment_instance_id << ", node=" << node_id;
@@ -28,6 +28,7 @@
 #include <mutex>
 #include <set>
 
+#include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "gen_cpp/Types_types.h" // for TUniqueId
@@ -37,6 +38,10 @@
 #include "runtime/query_statistics.h"
 #include "util/runtime_profile.h"
 
+namespace butil {
+class IOBuf;
+}
+
 namespace google {
 namespace protobuf {
 class Closure;
@@ -84,7 +89,15 @@ public:
 
     Status transmit_data(const PTransmitDataParams* request, ::google::protobuf::Closure** done);
 
-    Status transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    // The data of the chunks is in |attachment| if it's not nullptr, see DataStreamRecvr::add_chunks.
+    Status transmit_chunk(const PTransmitChunkParams& request, const butil::IOBuf* attachment,
+                          ::google::protobuf::Closure** done);
+
+    // Pass |chunk| of a sender on this BE to the receiver directly, without serializing it. |chunk| and
+    // |query_statistics| may be nullptr, and |done| is delayed as the one of transmit_chunk.
+    Status transmit_local_chunk(const TUniqueId& fragment_instance_id, PlanNodeId node_id, int sender_id,
+                                int be_number, vectorized::ChunkUniquePtr chunk, bool eos,
+                                const PQueryStatistics* query_statistics, ::google::protobuf::Closure** done);
     // Closes all receivers registered for fragment_instance_id immediately.
     void cancel(const TUniqueId& fragment_instance_id);
 
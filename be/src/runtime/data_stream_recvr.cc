@@ -21,8 +21,10 @@
 
 #include "runtime/data_stream_recvr.h"
 
+#include <butil/iobuf.h>
 #include <google/protobuf/stubs/common.h>
 
+#include <algorithm>
 #include <condition_variable>
 #include <deque>
 #include <unordered_map>
@@ -30,8 +32,10 @@
 #include <utility>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "gen_cpp/data.pb.h"
 #include "runtime/data_stream_mgr.h"
+#include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/sorted_run_merger.h"
 #include "runtime/vectorized/sorted_chunks_merger.h"
@@ -40,6 +44,7 @@
 #include "util/faststring.h"
 #include "util/logging.h"
 #include "util/runtime_profile.h"
+#include "util/slice.h"
 
 using std::list;
 using std::vector;
@@ -50,6 +55,15 @@ namespace starrocks {
 
 using vectorized::ChunkUniquePtr;
 
+// The pipeline drivers don't wait on _data_arrival_cv, they are polled by the driver poller,
+// so notify it when the state of a sender queue changes.
+static void notify_pipeline_drivers() {
+    auto* dispatcher = ExecEnv::GetInstance()->driver_dispatcher();
+    if (dispatcher != nullptr) {
+        dispatcher->notify_blocked_drivers();
+    }
+}
+
 // Implements a blocking queue of row batches from one or more senders. One queue
 // is maintained per sender if _is_merging is true for the enclosing receiver, otherwise
 // rows from all senders are placed in the same queue.
@@ -78,7 +92,11 @@ public:
     // blocks if this will make the stream exceed its buffer limit.
     // If the total size of the chunks in this queue would exceed the allowed buffer size,
     // the queue is considered full and the call blocks until a chunk is dequeued.
-    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    Status add_chunks(const PTransmitChunkParams& request, const butil::IOBuf* attachment,
+                      ::google::protobuf::Closure** done);
+
+    // Adds a chunk of a sender on the same BE, which is not serialized. The same as add_chunks otherwise.
+    Status add_local_chunk(int32_t be_number, vectorized::ChunkUniquePtr chunk, ::google::protobuf::Closure** done);
 
     // Decrement the number of remaining senders for this queue and signal eos ("new data")
     // if the count drops to 0. The number of senders will be 1 for a merging
@@ -101,7 +119,9 @@ public:
 
 private:
     Status _build_chunk_meta(const ChunkPB& pb_chunk);
-    Status _deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk, faststring* uncompressed_buffer);
+    // |data| is the serialized data of |pchunk|.
+    Status _deserialize_chunk(const ChunkPB& pchunk, const Slice& data, vectorized::Chunk* chunk,
+                              faststring* uncompressed_buffer);
 
     // Receiver of which this queue is a member.
     DataStreamRecvr* _recvr;
@@ -140,6 +160,27 @@ private:
     std::unordered_set<int> _sender_eos_set;          // sender_id
     std::unordered_map<int, int64_t> _packet_seq_map; // be_number => packet_seq
 
+    // The sequences of the chunk requests from one sender, which start from 0 and are contiguous.
+    // A sender may have several requests in flight, so they may arrive out of order.
+    struct ChunkSequences {
+        // All the sequences not greater than it have been received.
+        int64_t max_contiguous_sequence = -1;
+        // The received sequences greater than max_contiguous_sequence.
+        std::unordered_set<int64_t> received_sequences;
+
+        // Return false if the sequence has been received.
+        bool receive(int64_t sequence) {
+            if (sequence <= max_contiguous_sequence || !received_sequences.insert(sequence).second) {
+                return false;
+            }
+            while (received_sequences.erase(max_contiguous_sequence + 1) > 0) {
+                ++max_contiguous_sequence;
+            }
+            return true;
+        }
+    };
+    std::unordered_map<int, ChunkSequences> _chunk_sequences; // be_number => received sequences
+
     std::deque<std::pair<google::protobuf::Closure*, MonotonicStopWatch>> _pending_closures;
 };
 
@@ -360,7 +401,7 @@ Status DataStreamRecvr::SenderQueue::_build_chunk_meta(const ChunkPB& pb_chunk)
     return Status::OK();
 }
 
-Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& request,
+Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& request, const butil::IOBuf* attachment,
                                                 ::google::protobuf::Closure** done) {
     DCHECK(request.chunks_size() > 0);
 
@@ -373,17 +414,10 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
         if (_is_cancelled) {
             return Status::OK();
         }
-        // TODO(zc): Do we really need this check?
-        auto iter = _packet_seq_map.find(be_number);
-        if (iter != _packet_seq_map.end()) {
-            if (iter->second >= sequence) {
-                LOG(WARNING) << "packet already exist [cur_packet_id= " << iter->second
-                             << " receive_packet_id=" << sequence << "]";
-                return Status::OK();
-            }
-            iter->second = sequence;
-        } else {
-            _packet_seq_map.emplace(be_number, sequence);
+        if (!_chunk_sequences[be_number].receive(sequence)) {
+            LOG(WARNING) << "packet already exist [be_number=" << be_number << " receive_packet_id=" << sequence
+                         << "]";
+            return Status::OK();
         }
 
         // Following situation will match the following condition.
@@ -406,10 +440,31 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
     ChunkQueue chunks;
     size_t total_chunk_bytes = 0;
     faststring uncompressed_buffer;
+    // The chunks are decoded from the blocks of the attachment in place, only the ones across the blocks are
+    // copied to |chunk_buffer| to be contiguous.
+    butil::IOBuf remaining;
+    faststring chunk_buffer;
+    if (attachment != nullptr) {
+        remaining = *attachment;
+    }
     for (auto& pchunk : request.chunks()) {
-        size_t chunk_bytes = pchunk.data().size();
+        Slice data;
+        if (attachment != nullptr) {
+            size_t data_size = pchunk.data_size();
+            if (UNLIKELY(remaining.size() < data_size)) {
+                return Status::InternalError("the attachment is shorter than the chunks");
+            }
+            chunk_buffer.resize(data_size);
+            data = Slice(static_cast<const char*>(remaining.fetch(chunk_buffer.data(), data_size)), data_size);
+        } else {
+            data = Slice(pchunk.data());
+        }
+        size_t chunk_bytes = data.size;
         ChunkUniquePtr chunk = std::make_unique<vectorized::Chunk>();
-        RETURN_IF_ERROR(_deserialize_chunk(pchunk, chunk.get(), &uncompressed_buffer));
+        RETURN_IF_ERROR(_deserialize_chunk(pchunk, data, chunk.get(), &uncompressed_buffer));
+        if (attachment != nullptr) {
+            remaining.pop_front(data.size);
+        }
 
         // TODO(zc): review this chunk_bytes
         chunks.emplace_back(chunk_bytes, std::move(chunk));
@@ -436,14 +491,46 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
         _recvr->_num_buffered_bytes += total_chunk_bytes;
     }
     _data_arrival_cv.notify_one();
+    notify_pipeline_drivers();
+    return Status::OK();
+}
+
+Status DataStreamRecvr::SenderQueue::add_local_chunk(int32_t be_number, vectorized::ChunkUniquePtr chunk,
+                                                     ::google::protobuf::Closure** done) {
+    size_t chunk_bytes = chunk->memory_usage();
+    ScopedTimer<MonotonicStopWatch> wait_timer(_recvr->_sender_wait_lock_timer);
+    {
+        std::unique_lock<std::mutex> l(_lock);
+        wait_timer.stop();
+        if (_is_cancelled) {
+            return Status::OK();
+        }
+        if (_num_remaining_senders <= 0) {
+            DCHECK(_sender_eos_set.end() != _sender_eos_set.find(be_number));
+            return Status::OK();
+        }
+
+        _chunk_queue.emplace_back(chunk_bytes, std::move(chunk));
+        // if done is nullptr, this function can't delay this response
+        if (done != nullptr && _recvr->exceeds_limit(chunk_bytes)) {
+            MonotonicStopWatch monotonicStopWatch;
+            DCHECK(*done != nullptr);
+            _pending_closures.emplace_back(*done, monotonicStopWatch);
+            *done = nullptr;
+        }
+        _recvr->_num_buffered_bytes += chunk_bytes;
+    }
+    COUNTER_UPDATE(_recvr->_bytes_received_counter, chunk_bytes);
+    _data_arrival_cv.notify_one();
+    notify_pipeline_drivers();
     return Status::OK();
 }
 
-Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk,
-                                                        faststring* uncompressed_buffer) {
+Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, const Slice& data,
+                                                        vectorized::Chunk* chunk, faststring* uncompressed_buffer) {
     if (pchunk.compress_type() == CompressionTypePB::NO_COMPRESSION) {
         SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
-        RETURN_IF_ERROR(chunk->deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+        RETURN_IF_ERROR(chunk->deserialize((const uint8_t*)data.data, data.size, _chunk_meta));
     } else {
         size_t uncompressed_size = 0;
         {
@@ -453,7 +540,7 @@ Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, v
             uncompressed_size = pchunk.uncompressed_size();
             uncompressed_buffer->resize(uncompressed_size);
             Slice output{uncompressed_buffer->data(), uncompressed_size};
-            RETURN_IF_ERROR(codec->decompress(pchunk.data(), &output));
+            RETURN_IF_ERROR(codec->decompress(data, &output));
         }
         {
             SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
@@ -475,6 +562,7 @@ void DataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
               << " node_id=" << _recvr->dest_node_id() << " #senders=" << _num_remaining_senders;
     if (_num_remaining_senders == 0) {
         _data_arrival_cv.notify_one();
+        notify_pipeline_drivers();
     }
 }
 
@@ -491,6 +579,7 @@ void DataStreamRecvr::SenderQueue::cancel() {
     // Wake up all threads waiting to produce/consume batches.  They will all
     // notice that the stream is cancelled and handle it.
     _data_arrival_cv.notify_all();
+    notify_pipeline_drivers();
 
     {
         std::lock_guard<std::mutex> l(_lock);
@@ -514,6 +603,8 @@ void DataStreamRecvr::SenderQueue::close() {
         }
         _pending_closures.clear();
     }
+    // wake up the threads merging the chunks of this queue
+    _data_arrival_cv.notify_all();
 
     // Delete any batches queued in _batch_queue
     for (RowBatchQueue::iterator it = _batch_queue.begin(); it != _batch_queue.end(); ++it) {
@@ -539,7 +630,7 @@ Status DataStreamRecvr::create_merger(const TupleRowComparator& less_than) {
     return Status::OK();
 }
 
-Status DataStreamRecvr::create_merger(const SortExecExprs* exprs, const std::vector<bool>* is_asc,
+Status DataStreamRecvr::create_merger(RuntimeState* state, const SortExecExprs* exprs, const std::vector<bool>* is_asc,
                                       const std::vector<bool>* is_null_first) {
     DCHECK(_is_merging);
     _chunks_merger = std::make_unique<vectorized::SortedChunksMerger>();
@@ -548,7 +639,13 @@ Status DataStreamRecvr::create_merger(const SortExecExprs* exprs, const std::vec
         auto f = [q](vectorized::Chunk** chunk) -> Status { return q->get_chunk(chunk); };
         chunk_suppliers.emplace_back(std::move(f));
     }
-    RETURN_IF_ERROR(_chunks_merger->init(chunk_suppliers, &(exprs->lhs_ordering_expr_ctxs()), is_asc, is_null_first));
+    // merge the senders in groups in parallel if there are many ones
+    size_t num_groups = std::max(config::merging_exchange_parallelism, 1);
+    if (chunk_suppliers.size() < 2 * num_groups) {
+        num_groups = 1;
+    }
+    RETURN_IF_ERROR(_chunks_merger->init(chunk_suppliers, &(exprs->lhs_ordering_expr_ctxs()), is_asc, is_null_first,
+                                         state, num_groups));
     _chunks_merger->set_profile(_profile.get());
     return Status::OK();
 }
@@ -622,12 +719,22 @@ void DataStreamRecvr::add_batch(const PRowBatch& batch, int sender_id, int be_nu
     _sender_queues[use_sender_id]->add_batch(batch, be_number, packet_seq, done);
 }
 
-Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, const butil::IOBuf* attachment,
+                                   ::google::protobuf::Closure** done) {
     SCOPED_TIMER(_sender_total_timer);
     COUNTER_UPDATE(_request_received_counter, 1);
     int use_sender_id = _is_merging ? request.sender_id() : 0;
     // Add all batches to the same queue if _is_merging is false.
-    return _sender_queues[use_sender_id]->add_chunks(request, done);
+    return _sender_queues[use_sender_id]->add_chunks(request, attachment, done);
+}
+
+Status DataStreamRecvr::add_local_chunk(int sender_id, int be_number, vectorized::ChunkUniquePtr chunk,
+                                        ::google::protobuf::Closure** done) {
+    SCOPED_TIMER(_sender_total_timer);
+    COUNTER_UPDATE(_request_received_counter, 1);
+    int use_sender_id = _is_merging ? sender_id : 0;
+    // Add all chunks to the same queue if _is_merging is false.
+    return _sender_queues[use_sender_id]->add_local_chunk(be_number, std::move(chunk), done);
 }
 
 void DataStreamRecvr::remove_sender(int sender_id, int be_number) {
@@ -30,6 +30,10 @@
 #include "runtime/query_statistics.h"
 #include "util/tuple_row_compare.h"
 
+namespace butil {
+class IOBuf;
+}
+
 namespace google {
 namespace protobuf {
 class Closure;
@@ -47,6 +51,7 @@ class SortedRunMerger;
 class MemTracker;
 class RowBatch;
 class RuntimeProfile;
+class RuntimeState;
 class PRowBatch;
 class PTransmitChunkParams;
 
@@ -95,7 +100,8 @@ public:
     // specified row comparator. Fetches the first batches from the individual sender
     // queues. The exprs used in less_than must have already been prepared and opened.
     Status create_merger(const TupleRowComparator& less_than);
-    Status create_merger(const SortExecExprs* exprs, const std::vector<bool>* is_asc,
+    // The senders are merged in groups in parallel if there are many ones, whose sort exprs are cloned by state.
+    Status create_merger(RuntimeState* state, const SortExecExprs* exprs, const std::vector<bool>* is_asc,
                          const std::vector<bool>* is_null_first);
 
     // Fill output_batch with the next batch of rows obtained by merging the per-sender
@@ -133,8 +139,15 @@ private:
     void add_batch(const PRowBatch& batch, int sender_id, int be_number, int64_t packet_seq,
                    ::google::protobuf::Closure** done);
 
-    // If receive queue is full, done is enqueue pending, and return with *done is nullptr
-    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    // If receive queue is full, done is enqueue pending, and return with *done is nullptr.
+    // The data of the chunks is in |attachment| one after another, or in the chunks if it's nullptr.
+    Status add_chunks(const PTransmitChunkParams& request, const butil::IOBuf* attachment,
+                      ::google::protobuf::Closure** done);
+
+    // Adds a chunk of a sender on the same BE, which is passed without serialization.
+    // If receive queue is full, done is enqueue pending, and return with *done is nullptr.
+    Status add_local_chunk(int sender_id, int be_number, vectorized::ChunkUniquePtr chunk,
+                           ::google::protobuf::Closure** done);
 
     // Indicate that a particular sender is done. Delegated to the appropriate
     // sender queue. Called from DataStreamMgr.
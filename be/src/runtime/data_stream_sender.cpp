@@ -25,7 +25,9 @@
 #include <thrift/protocol/TDebugProtocol.h>
 
 #include <algorithm>
+#include <atomic>
 #include <boost/thread/thread.hpp>
+#include <condition_variable>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -36,6 +38,7 @@
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/Types_types.h"
 #include "runtime/client_cache.h"
+#include "runtime/data_stream_mgr.h"
 #include "runtime/descriptors.h"
 #include "runtime/dpp_sink_internal.h"
 #include "runtime/exec_env.h"
@@ -44,12 +47,14 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "service/backend_options.h"
 #include "service/brpc.h"
 #include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
 #include "util/compression_utils.h"
 #include "util/debug_util.h"
 #include "util/network_util.h"
+#include "util/query_trace.h"
 #include "util/ref_count_closure.h"
 #include "util/thrift_client.h"
 #include "util/thrift_util.h"
@@ -57,6 +62,36 @@
 namespace starrocks {
 
 // A channel sends data asynchronously via calls to transmit_data
+// The closure of a chunk passed to the receiver on the same BE, which is run once the receiver accepts more
+// chunks, like the response of a transmit_chunk rpc. It's referenced by the sender and the receiver.
+class LocalChunkClosure : public google::protobuf::Closure {
+public:
+    void Run() override {
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            _done = true;
+        }
+        _cond.notify_all();
+        if (unref()) {
+            delete this;
+        }
+    }
+
+    // Return false if it isn't run in |timeout_ms|.
+    bool wait(int64_t timeout_ms) {
+        std::unique_lock<std::mutex> l(_lock);
+        return _cond.wait_for(l, std::chrono::milliseconds(timeout_ms), [this] { return _done; });
+    }
+
+    bool unref() { return _refs.fetch_sub(1) == 1; }
+
+private:
+    std::atomic<int> _refs{2};
+    std::mutex _lock;
+    std::condition_variable _cond;
+    bool _done = false;
+};
+
 // to a single destination ipaddress/node.
 // It has a fixed-capacity buffer and allows the caller either to add rows to
 // that buffer individually (AddRow()), or circumvent the buffer altogether and send
@@ -96,6 +131,10 @@ public:
             delete _chunk_closure;
         }
         _chunk_request.release_finst_id();
+
+        if (_local_closure != nullptr && _local_closure->unref()) {
+            delete _local_closure;
+        }
     }
 
     // Initialize channel.
@@ -110,8 +149,9 @@ public:
     // Used when doing shuffle.
     // This function will copy selective rows in chunks to batch.
     // indexes contains row index of chunk and this function will copy from input
-    // 'from' and copy 'size' rows
-    Status add_rows_selective(vectorized::Chunk* chunk, const uint32_t* row_indexes, uint32_t from, uint32_t size);
+    // 'from' and copy 'size' rows, each of which takes about 'row_bytes' bytes
+    Status add_rows_selective(vectorized::Chunk* chunk, const uint32_t* row_indexes, uint32_t from, uint32_t size,
+                              size_t row_bytes);
 
     // Asynchronously sends a row batch.
     // Returns the status of the most recently finished transmit_data
@@ -174,6 +214,8 @@ private:
                          << ", error_text=" << cntl->ErrorText();
             return Status::ThriftRpcError("fail to send batch");
         }
+        _parent->_compression_strategy.update_transmission(_last_request_bytes, cntl->latency_us() * 1000);
+        _last_request_bytes = 0;
         return {_chunk_closure->result.status()};
     }
 
@@ -182,6 +224,9 @@ private:
     // Returns send_batch() status.
     Status send_current_batch(bool eos = false);
     Status _send_current_chunk(bool eos);
+    // Pass _chunk to the receiver on this BE without serialization, once the last chunk passed is accepted.
+    Status _send_local_chunk(bool eos);
+    Status _wait_local_closure();
 
     Status _do_send_chunk_rpc(PTransmitChunkParams* request, const butil::IOBuf& attachment);
 
@@ -201,6 +246,8 @@ private:
     // we're accumulating rows into this batch
     std::unique_ptr<RowBatch> _batch;
     std::unique_ptr<vectorized::Chunk> _chunk;
+    // the estimated bytes of the rows in _chunk
+    size_t _chunk_bytes = 0;
     bool _is_first_chunk = true;
 
     bool _need_close;
@@ -220,6 +267,13 @@ private:
     RefCountClosure<PTransmitChunkResult>* _chunk_closure = nullptr;
 
     size_t _current_request_bytes = 0;
+    // the bytes of the attachment of the last transmit_chunk rpc, which are measured once it returns
+    size_t _last_request_bytes = 0;
+
+    // whether the receiver is on this BE, to which the chunks are passed directly
+    bool _is_local = false;
+    DataStreamMgr* _stream_mgr = nullptr;
+    LocalChunkClosure* _local_closure = nullptr;
 
     PBackendService_Stub* _brpc_stub = nullptr;
     RefCountClosure<PTransmitDataResult>* _closure = nullptr;
@@ -268,6 +322,13 @@ Status DataStreamSender::Channel::init(RuntimeState* state) {
         return Status::OK();
     }
     _brpc_stub = state->exec_env()->brpc_stub_cache()->get_stub(_brpc_dest_addr);
+    // only the shuffled chunks are passed directly, the chunks broadcast are serialized once for all the channels
+    bool is_shuffle = _parent->_part_type == TPartitionType::HASH_PARTITIONED ||
+                      _parent->_part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED;
+    _is_local = _parent->_is_vectorized && is_shuffle && _parent->_channels.size() > 1 &&
+                config::enable_local_exchange_passthrough && _brpc_dest_addr.port == config::brpc_port &&
+                _brpc_dest_addr.hostname == BackendOptions::get_localhost();
+    _stream_mgr = state->exec_env()->stream_mgr();
 
     _need_close = true;
     _is_inited = true;
@@ -349,6 +410,7 @@ Status DataStreamSender::Channel::send_chunk_request(PTransmitChunkParams* param
 
 Status DataStreamSender::Channel::_do_send_chunk_rpc(PTransmitChunkParams* request, const butil::IOBuf& attachment) {
     SCOPED_TIMER(_parent->_send_request_timer);
+    SCOPED_QUERY_TRACE(request->finst_id().hi(), "rpc", "send_chunk", _dest_node_id);
 
     request->set_sequence(_request_seq);
     if (_is_transfer_chain && (_send_query_statistics_with_every_batch || request->eos())) {
@@ -359,6 +421,7 @@ Status DataStreamSender::Channel::_do_send_chunk_rpc(PTransmitChunkParams* reque
     _chunk_closure->cntl.Reset();
     _chunk_closure->cntl.set_timeout_ms(_brpc_timeout_ms);
     _chunk_closure->cntl.request_attachment().append(attachment);
+    _last_request_bytes = attachment.size();
     _brpc_stub->transmit_chunk(&_chunk_closure->cntl, request, &_chunk_closure->result, _chunk_closure);
     _request_seq++;
     return Status::OK();
@@ -392,13 +455,16 @@ Status DataStreamSender::Channel::add_row(TupleRow* row) {
 }
 
 Status DataStreamSender::Channel::add_rows_selective(vectorized::Chunk* chunk, const uint32_t* indexes, uint32_t from,
-                                                     uint32_t size) {
+                                                     uint32_t size, size_t row_bytes) {
     // TODO(kks): find a way to remove this if condition
     if (UNLIKELY(_chunk == nullptr)) {
         _chunk = chunk->clone_empty_with_tuple();
     }
 
-    if (_chunk->num_rows() + size > config::vector_chunk_size) {
+    // With many receivers each channel gets a few rows of a chunk, so _chunk is sized by bytes as well as by
+    // rows, to send it once it's worth a request instead of buffering up to vector_chunk_size rows.
+    if (_chunk->num_rows() + size > config::vector_chunk_size ||
+        (_chunk->num_rows() > 0 && _chunk_bytes + size * row_bytes > _parent->_request_bytes_threshold)) {
         // _chunk is full, let's send it; but first wait for an ongoing
         // transmission to finish before modifying _pb_chunk
         RETURN_IF_ERROR(_send_current_chunk(false));
@@ -406,6 +472,7 @@ Status DataStreamSender::Channel::add_rows_selective(vectorized::Chunk* chunk, c
     }
 
     _chunk->append_selective(*chunk, indexes, from, size);
+    _chunk_bytes += size * row_bytes;
     return Status::OK();
 }
 
@@ -417,6 +484,9 @@ Status DataStreamSender::Channel::send_current_batch(bool eos) {
 }
 
 Status DataStreamSender::Channel::_send_current_chunk(bool eos) {
+    if (_is_local) {
+        return _send_local_chunk(eos);
+    }
     bool is_real_sent = false;
     RETURN_IF_ERROR(send_one_chunk(_chunk.get(), eos, &is_real_sent));
 
@@ -424,6 +494,49 @@ Status DataStreamSender::Channel::_send_current_chunk(bool eos) {
     for (ColumnPtr& column : _chunk->columns()) {
         column->resize(0);
     }
+    _chunk_bytes = 0;
+    return Status::OK();
+}
+
+Status DataStreamSender::Channel::_send_local_chunk(bool eos) {
+    RETURN_IF_ERROR(_wait_local_closure());
+
+    vectorized::ChunkUniquePtr chunk;
+    if (_chunk != nullptr && _chunk->num_rows() > 0) {
+        chunk = std::move(_chunk);
+        _chunk = chunk->clone_empty_with_tuple();
+        _chunk_bytes = 0;
+    }
+    std::unique_ptr<PQueryStatistics> statistics;
+    if (_is_transfer_chain && (_send_query_statistics_with_every_batch || eos)) {
+        statistics = std::make_unique<PQueryStatistics>();
+        _parent->_query_statistics->to_pb(statistics.get());
+    }
+
+    _local_closure = new LocalChunkClosure();
+    google::protobuf::Closure* done = _local_closure;
+    Status st = _stream_mgr->transmit_local_chunk(_fragment_instance_id, _dest_node_id, _parent->_sender_id,
+                                                  _parent->_be_number, std::move(chunk), eos, statistics.get(), &done);
+    // the receiver holds done while its buffer is full
+    if (done != nullptr) {
+        done->Run();
+    }
+    return st;
+}
+
+Status DataStreamSender::Channel::_wait_local_closure() {
+    if (_local_closure == nullptr) {
+        return Status::OK();
+    }
+    SCOPED_TIMER(_parent->_wait_response_timer);
+    bool done = _local_closure->wait(_brpc_timeout_ms);
+    if (_local_closure->unref()) {
+        delete _local_closure;
+    }
+    _local_closure = nullptr;
+    if (!done) {
+        return Status::TimedOut("wait for the local receiver to accept the chunks timeout");
+    }
     return Status::OK();
 }
 
@@ -435,7 +548,7 @@ Status DataStreamSender::Channel::close_internal() {
     if (_parent->_is_vectorized) {
         VLOG_RPC << "_chunk Channel::close() instance_id=" << _fragment_instance_id << " dest_node=" << _dest_node_id
                  << " #rows= " << ((_chunk == nullptr) ? 0 : _chunk->num_rows());
-        if (_chunk != nullptr && _chunk->num_rows() > 0) {
+        if (_is_local || (_chunk != nullptr && _chunk->num_rows() > 0)) {
             RETURN_IF_ERROR(_send_current_chunk(true));
         } else {
             bool is_real_sent = false;
@@ -574,6 +687,7 @@ Status DataStreamSender::prepare(RuntimeState* state) {
         _compress_type = CompressionTypePB::LZ4;
     }
     RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
+    _compression_strategy = AdaptiveCompressionStrategy(config::transmission_compression_probe_interval);
 
     std::string instances;
     for (const auto& channel : _channels) {
@@ -609,6 +723,7 @@ Status DataStreamSender::prepare(RuntimeState* state) {
     _ignore_rows = ADD_COUNTER(profile(), "IgnoreRows", TUnit::UNIT);
     _serialize_batch_timer = ADD_TIMER(profile(), "SerializeBatchTime");
     _compress_timer = ADD_TIMER(profile(), "CompressTime");
+    _compress_skipped_counter = ADD_COUNTER(profile(), "CompressSkippedChunks", TUnit::UNIT);
     _send_request_timer = ADD_TIMER(profile(), "SendRequestTime");
     _wait_response_timer = ADD_TIMER(profile(), "WaitResponseTime");
     _shuffle_dispatch_timer = ADD_TIMER(profile(), "ShuffleDispatchTime");
@@ -783,6 +898,7 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
             }
         }
 
+        size_t row_bytes = chunk->bytes_usage() / num_rows;
         for (int i = 0; i < num_channels; ++i) {
             size_t from = _channel_row_idx_start_points[i];
             size_t size = _channel_row_idx_start_points[i + 1] - from;
@@ -794,7 +910,7 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
                 // dest bucket is no used, continue
                 continue;
             }
-            RETURN_IF_ERROR(_channels[i]->add_rows_selective(chunk, _row_indexes.data(), from, size));
+            RETURN_IF_ERROR(_channels[i]->add_rows_selective(chunk, _row_indexes.data(), from, size, row_bytes));
         }
     } else {
         DCHECK(false) << "shouldn't go to here";
@@ -974,10 +1090,7 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
             dst->clear_is_nulls();
             dst->clear_is_consts();
             dst->clear_slot_id_map();
-            uncompressed_size = src->serialize_size();
-            // TODO(kks): resize without initializing the new bytes
-            dst->mutable_data()->resize(uncompressed_size);
-            src->serialize((uint8_t*)dst->mutable_data()->data());
+            uncompressed_size = src->serialize(dst->mutable_data(), config::chunk_serde_version);
         }
     }
 
@@ -987,9 +1100,17 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
     }
 
     dst->set_uncompressed_size(uncompressed_size);
-    // try compress the ChunkPB data
-    if (_compress_codec != nullptr && uncompressed_size > 0) {
+    // try compress the ChunkPB data, unless it doesn't pay off on the network
+    bool compress = _compress_codec != nullptr && uncompressed_size > 0;
+    if (compress && config::transmission_adaptive_compression &&
+        !_compression_strategy.should_compress(num_receivers)) {
+        COUNTER_UPDATE(_compress_skipped_counter, 1);
+        compress = false;
+    }
+    if (compress) {
         SCOPED_TIMER(_compress_timer);
+        MonotonicStopWatch watch;
+        watch.start();
 
         // Try compressing data to _compression_scratch, swap if compressed data is smaller
         int max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
@@ -1000,6 +1121,7 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
 
         Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
         _compress_codec->compress(dst->data(), &compressed_slice);
+        _compression_strategy.update_compression(uncompressed_size, compressed_slice.size, watch.elapsed_time());
         double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
         if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
             _compression_scratch.resize(compressed_slice.size);
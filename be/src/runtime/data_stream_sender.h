@@ -32,6 +32,7 @@
 #include "exec/data_sink.h"
 #include "gen_cpp/data.pb.h" // for PRowBatch
 #include "gen_cpp/internal_service.pb.h"
+#include "util/adaptive_compression_strategy.h"
 #include "util/raw_container.h"
 #include "util/runtime_profile.h"
 
@@ -195,6 +196,8 @@ private:
 
     CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
     const BlockCompressionCodec* _compress_codec = nullptr;
+    // decides whether to compress a chunk by the cost of the compression and the transmission
+    AdaptiveCompressionStrategy _compression_strategy{1};
 
     // Because we should close all channels even if fail to close some channel.
     // We use a global _close_status to record the error close status.
@@ -204,6 +207,7 @@ private:
     RuntimeProfile* _profile; // Allocated from _pool
     RuntimeProfile::Counter* _serialize_batch_timer;
     RuntimeProfile::Counter* _compress_timer{};
+    RuntimeProfile::Counter* _compress_skipped_counter{};
     RuntimeProfile::Counter* _bytes_sent_counter;
     RuntimeProfile::Counter* _uncompressed_bytes_counter{};
     RuntimeProfile::Counter* _ignore_rows{};
@@ -3,6 +3,9 @@
 #pragma once
 
 #include <fmt/format.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 #include <cstddef>
 #include <cstdint>
@@ -88,6 +91,120 @@ public:
     }
 };
 
+// The add/sub/mul of the decimals of the same scale over a batch. The loops don't branch on the overflows,
+// which are accumulated and returned once per batch, so the callers only look for the overflowed rows if
+// there are any. The 32-bit and 64-bit add/sub are vectorized by AVX2 explicitly.
+template <typename T>
+class DecimalV3BatchArithmetics {
+public:
+    using Type = std::enable_if_t<starrocks::is_underlying_type_of_decimal<T>, T>;
+
+    // Returns true if any of the results overflows.
+    template <bool lhs_is_const, bool rhs_is_const>
+    static bool add(const Type* lhs, const Type* rhs, Type* result, size_t num_rows) {
+        return _add_sub<true, lhs_is_const, rhs_is_const>(lhs, rhs, result, num_rows);
+    }
+
+    template <bool lhs_is_const, bool rhs_is_const>
+    static bool sub(const Type* lhs, const Type* rhs, Type* result, size_t num_rows) {
+        return _add_sub<false, lhs_is_const, rhs_is_const>(lhs, rhs, result, num_rows);
+    }
+
+    template <bool lhs_is_const, bool rhs_is_const>
+    static bool mul(const Type* lhs, const Type* rhs, Type* result, size_t num_rows) {
+        bool overflow = false;
+        if constexpr (std::is_same_v<Type, int32_t>) {
+            for (size_t i = 0; i < num_rows; i++) {
+                int64_t product = static_cast<int64_t>(lhs[lhs_is_const ? 0 : i]) * rhs[rhs_is_const ? 0 : i];
+                result[i] = static_cast<int32_t>(product);
+                overflow |= product != result[i];
+            }
+        } else {
+            // mul_overflow of int128_t is the multi3 of int128_arithmetics_x86_64.h.
+            for (size_t i = 0; i < num_rows; i++) {
+                overflow |= mul_overflow(lhs[lhs_is_const ? 0 : i], rhs[rhs_is_const ? 0 : i], &result[i]);
+            }
+        }
+        return overflow;
+    }
+
+private:
+    using UnsignedType = typename unsigned_type<Type>::type;
+
+    template <bool is_add, bool lhs_is_const, bool rhs_is_const>
+    static bool _add_sub(const Type* lhs, const Type* rhs, Type* result, size_t num_rows) {
+        size_t i = 0;
+        bool overflow = false;
+        if constexpr (std::is_same_v<Type, int128_t>) {
+            for (; i < num_rows; i++) {
+                if constexpr (is_add) {
+                    overflow |= add_overflow(lhs[lhs_is_const ? 0 : i], rhs[rhs_is_const ? 0 : i], &result[i]);
+                } else {
+                    overflow |= sub_overflow(lhs[lhs_is_const ? 0 : i], rhs[rhs_is_const ? 0 : i], &result[i]);
+                }
+            }
+            return overflow;
+        } else {
+#ifdef __AVX2__
+            i = _avx2_add_sub<is_add, lhs_is_const, rhs_is_const>(lhs, rhs, result, num_rows, &overflow);
+#endif
+            // The sign bit of |overflows| is set if any of the results overflows.
+            Type overflows = 0;
+            for (; i < num_rows; i++) {
+                const Type a = lhs[lhs_is_const ? 0 : i];
+                const Type b = rhs[rhs_is_const ? 0 : i];
+                const Type c = is_add ? static_cast<Type>(static_cast<UnsignedType>(a) + static_cast<UnsignedType>(b))
+                                      : static_cast<Type>(static_cast<UnsignedType>(a) - static_cast<UnsignedType>(b));
+                result[i] = c;
+                overflows |= is_add ? ((a ^ c) & (b ^ c)) : ((a ^ b) & (a ^ c));
+            }
+            return overflow || overflows < 0;
+        }
+    }
+
+#ifdef __AVX2__
+    static __m256i _broadcast(Type value) {
+        if constexpr (sizeof(Type) == 4) {
+            return _mm256_set1_epi32(value);
+        } else {
+            return _mm256_set1_epi64x(value);
+        }
+    }
+
+    // Returns the number of rows evaluated, which is a multiple of the lanes.
+    template <bool is_add, bool lhs_is_const, bool rhs_is_const>
+    static size_t _avx2_add_sub(const Type* lhs, const Type* rhs, Type* result, size_t num_rows, bool* overflow) {
+        constexpr size_t kLanes = sizeof(__m256i) / sizeof(Type);
+        constexpr bool is_32bit = sizeof(Type) == 4;
+        const __m256i lhs_const = lhs_is_const ? _broadcast(lhs[0]) : _mm256_setzero_si256();
+        const __m256i rhs_const = rhs_is_const ? _broadcast(rhs[0]) : _mm256_setzero_si256();
+        __m256i overflows = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + kLanes <= num_rows; i += kLanes) {
+            const __m256i a =
+                    lhs_is_const ? lhs_const : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+            const __m256i b =
+                    rhs_is_const ? rhs_const : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+            __m256i c;
+            if constexpr (is_add) {
+                c = is_32bit ? _mm256_add_epi32(a, b) : _mm256_add_epi64(a, b);
+                overflows = _mm256_or_si256(
+                        overflows, _mm256_and_si256(_mm256_xor_si256(a, c), _mm256_xor_si256(b, c)));
+            } else {
+                c = is_32bit ? _mm256_sub_epi32(a, b) : _mm256_sub_epi64(a, b);
+                overflows = _mm256_or_si256(
+                        overflows, _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, c)));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), c);
+        }
+        // The sign bits of the lanes.
+        *overflow = is_32bit ? _mm256_movemask_ps(_mm256_castsi256_ps(overflows)) != 0
+                             : _mm256_movemask_pd(_mm256_castsi256_pd(overflows)) != 0;
+        return i;
+    }
+#endif
+};
+
 enum DecimalRoundRule {
     ROUND_HALF_UP,
     ROUND_HALF_EVEN,
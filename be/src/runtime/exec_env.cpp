@@ -25,6 +25,8 @@
 
 #include "common/config.h"
 #include "common/logging.h"
+#include "exec/vectorized/aggregate/agg_result_cache.h"
+#include "exec/vectorized/block_cache.h"
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/FrontendService.h"
 #include "gen_cpp/HeartbeatService_types.h"
@@ -52,11 +54,13 @@
 #include "runtime/thread_resource_mgr.h"
 #include "runtime/tmp_file_mgr.h"
 #include "storage/page_cache.h"
+#include "storage/rowset/segment_v2/segment_footer_cache.h"
 #include "storage/storage_engine.h"
 #include "storage/update_manager.h"
 #include "util/bfd_parser.h"
 #include "util/brpc_stub_cache.h"
 #include "util/debug_util.h"
+#include "util/fair_thread_pool.h"
 #include "util/mem_info.h"
 #include "util/metrics.h"
 #include "util/network_util.h"
@@ -94,7 +98,18 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _thread_mgr = new ThreadResourceMgr();
     _thread_pool = new PriorityThreadPool(config::doris_scanner_thread_pool_thread_num,
                                           config::doris_scanner_thread_pool_queue_size);
-    _pipeline_io_thread_pool = new PriorityThreadPool(4, config::doris_scanner_thread_pool_queue_size);
+    if (config::enable_fair_scan_scheduler) {
+        _fair_scan_thread_pool = new FairThreadPool(config::doris_scanner_thread_pool_thread_num,
+                                                    config::doris_scanner_thread_pool_queue_size);
+    }
+    _pipeline_io_thread_pool = new PriorityThreadPool(config::pipeline_io_thread_pool_thread_num,
+                                                      config::doris_scanner_thread_pool_queue_size);
+    _hdfs_scan_io_thread_pool = new PriorityThreadPool(config::hdfs_scan_io_thread_num,
+                                                       config::doris_scanner_thread_pool_queue_size);
+    if (config::spill_io_thread_num > 0) {
+        _spill_io_thread_pool = new PriorityThreadPool(config::spill_io_thread_num,
+                                                       config::doris_scanner_thread_pool_queue_size);
+    }
     _num_scan_operators = 0;
     _etl_thread_pool = new PriorityThreadPool(config::etl_thread_pool_size, config::etl_thread_pool_queue_size);
     _fragment_mgr = new FragmentMgr(this);
@@ -140,6 +155,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
 
     RETURN_IF_ERROR(_load_channel_mgr->init(_load_mem_tracker));
     _heartbeat_flags = new HeartbeatFlags();
+    RETURN_IF_ERROR(vectorized::BlockCache::create_global_cache());
     return Status::OK();
 }
 
@@ -225,7 +241,15 @@ Status ExecEnv::_init_mem_tracker() {
         LOG(WARNING) << "Config storage_page_cache_limit is greater than memory size, config="
                      << config::storage_page_cache_limit << ", memory=" << MemInfo::physical_mem();
     }
-    StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit);
+    int64_t compressed_cache_limit =
+            ParseUtil::parse_mem_spec(config::storage_compressed_page_cache_limit, &is_percent);
+    int64_t in_memory_cache_limit =
+            ParseUtil::parse_mem_spec(config::storage_in_memory_page_cache_limit, &is_percent);
+    StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit,
+                                          std::max<int64_t>(compressed_cache_limit, 0),
+                                          std::max<int64_t>(in_memory_cache_limit, 0));
+    segment_v2::SegmentFooterCache::create_global_cache(config::segment_footer_cache_capacity);
+    vectorized::AggResultCache::create_global_cache(std::max<int64_t>(config::agg_result_cache_capacity, 0));
 
     // TODO(zc): The current memory usage configuration is a bit confusing,
     // we need to sort out the use of memory
@@ -251,9 +275,16 @@ void ExecEnv::_destory() {
     delete _load_path_mgr;
     delete _master_info;
     delete _driver_dispatcher;
+    // The rpcs of the sink buffers may be completed after the dispatcher is destroyed.
+    _driver_dispatcher = nullptr;
     delete _fragment_mgr;
     delete _etl_thread_pool;
+    delete _hdfs_scan_io_thread_pool;
+    delete _spill_io_thread_pool;
+    vectorized::BlockCache::release_global_cache();
+    vectorized::AggResultCache::release_global_cache();
     delete _thread_pool;
+    delete _fair_scan_thread_pool;
     delete _thread_mgr;
     delete _update_mem_tracker;
     delete _page_cache_mem_tracker;
@@ -48,6 +48,7 @@ class MetricRegistry;
 class StorageEngine;
 class ThreadPool;
 class PriorityThreadPool;
+class FairThreadPool;
 class ReservationTracker;
 class ResultBufferMgr;
 class ResultQueueMgr;
@@ -127,7 +128,12 @@ public:
 
     ThreadResourceMgr* thread_mgr() { return _thread_mgr; }
     PriorityThreadPool* thread_pool() { return _thread_pool; }
+    // Not null if config::enable_fair_scan_scheduler is on, the olap scanners are submitted to it instead.
+    FairThreadPool* fair_scan_thread_pool() { return _fair_scan_thread_pool; }
     PriorityThreadPool* pipeline_io_thread_pool() { return _pipeline_io_thread_pool; }
+    PriorityThreadPool* hdfs_scan_io_thread_pool() { return _hdfs_scan_io_thread_pool; }
+    // nullptr if the spilled chunks are written and read synchronously.
+    PriorityThreadPool* spill_io_thread_pool() { return _spill_io_thread_pool; }
     size_t increment_num_scan_operators(size_t n) { return _num_scan_operators.fetch_add(n); }
     size_t decrement_num_scan_operators(size_t n) { return _num_scan_operators.fetch_sub(n); }
     PriorityThreadPool* etl_thread_pool() { return _etl_thread_pool; }
@@ -214,11 +220,14 @@ private:
 
     ThreadResourceMgr* _thread_mgr = nullptr;
     PriorityThreadPool* _thread_pool = nullptr;
+    FairThreadPool* _fair_scan_thread_pool = nullptr;
     PriorityThreadPool* _pipeline_io_thread_pool = nullptr;
+    PriorityThreadPool* _hdfs_scan_io_thread_pool = nullptr;
+    PriorityThreadPool* _spill_io_thread_pool = nullptr;
     std::atomic<size_t> _num_scan_operators;
     PriorityThreadPool* _etl_thread_pool = nullptr;
     FragmentMgr* _fragment_mgr = nullptr;
-    starrocks::pipeline::DriverDispatcher* _driver_dispatcher;
+    starrocks::pipeline::DriverDispatcher* _driver_dispatcher = nullptr;
     TMasterInfo* _master_info = nullptr;
     LoadPathMgr* _load_path_mgr = nullptr;
     DiskIoMgr* _disk_io_mgr = nullptr;
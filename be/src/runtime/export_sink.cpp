@@ -27,6 +27,7 @@
 #include "column/column.h"
 #include "env/env_broker.h"
 #include "exec/broker_writer.h"
+#include "exec/vectorized/parquet_chunk_writer.h"
 #include "exprs/expr.h"
 #include "formats/csv/converter.h"
 #include "formats/csv/output_stream_file.h"
@@ -53,6 +54,8 @@ ExportSink::ExportSink(ObjectPool* pool, const RowDescriptor& row_desc, const st
           _rows_written_counter(nullptr),
           _write_timer(nullptr) {}
 
+ExportSink::~ExportSink() = default;
+
 Status ExportSink::init(const TDataSink& t_sink) {
     RETURN_IF_ERROR(DataSink::init(t_sink));
     _t_export_sink = t_sink.export_sink;
@@ -98,6 +101,9 @@ Status ExportSink::open(RuntimeState* state) {
 
 Status ExportSink::send(RuntimeState* state, RowBatch* batch) {
     SCOPED_TIMER(_profile->total_time_counter());
+    if (is_parquet()) {
+        return Status::NotSupported("Parquet files are only exported from chunks");
+    }
     int num_rows = batch->num_rows();
     // we send at most 1024 rows at a time
     int batch_send_rows = num_rows > 1024 ? 1024 : num_rows;
@@ -234,6 +240,11 @@ Status ExportSink::gen_row_buffer(TupleRow* row, std::stringstream* ss) {
 
 Status ExportSink::close(RuntimeState* state, Status exec_status) {
     Expr::close(_output_expr_ctxs, state);
+    if (_parquet_writer != nullptr) {
+        Status st = _parquet_writer->close();
+        _parquet_writer.reset();
+        return st;
+    }
     if (_output_stream != nullptr) {
         Status st = _output_stream->finalize();
         _output_stream.reset();
@@ -264,6 +275,18 @@ Status ExportSink::open_file_writer(int timeout_ms) {
         return Status::NotSupported(strings::Substitute("Unsupported file type $0", file_type));
     }
 
+    if (is_parquet()) {
+        std::vector<TypeDescriptor> types;
+        for (auto* ctx : _output_expr_ctxs) {
+            types.emplace_back(ctx->root()->type());
+        }
+        auto output = std::make_shared<vectorized::ParquetOutputFile>(std::move(output_file));
+        _parquet_writer = std::make_unique<vectorized::ParquetChunkWriter>(std::move(output), std::move(types));
+        RETURN_IF_ERROR(_parquet_writer->init());
+        _state->add_export_output_file(file_path);
+        return Status::OK();
+    }
+
     using WriteBufferFile = vectorized::csv::OutputStreamFile;
     _output_stream = std::make_unique<WriteBufferFile>(std::move(output_file), 1024 * 1024);
     _converters.reserve(_output_expr_ctxs.size());
@@ -288,13 +311,20 @@ Status ExportSink::gen_file_name(std::string* file_name) {
 
     std::stringstream file_name_ss;
     // now file-number is 0.
-    // <file-name-prefix>_<file-number>.csv.<timestamp>
-    file_name_ss << _t_export_sink.file_name_prefix << "0.csv." << UnixMillis();
+    // <file-name-prefix>_<file-number>.<csv|parquet>.<timestamp>
+    file_name_ss << _t_export_sink.file_name_prefix << (is_parquet() ? "0.parquet." : "0.csv.") << UnixMillis();
     *file_name = file_name_ss.str();
     return Status::OK();
 }
 
+bool ExportSink::is_parquet() const {
+    return _t_export_sink.__isset.file_format && _t_export_sink.file_format == TFileFormatType::FORMAT_PARQUET;
+}
+
 Status ExportSink::send_chunk(RuntimeState* state, vectorized::Chunk* chunk) {
+    if (_parquet_writer != nullptr) {
+        return send_chunk_as_parquet(chunk);
+    }
     const size_t num_rows = chunk->num_rows();
     const size_t num_cols = chunk->num_columns();
     if (num_cols != _converters.size()) {
@@ -322,4 +352,24 @@ Status ExportSink::send_chunk(RuntimeState* state, vectorized::Chunk* chunk) {
     return Status::OK();
 }
 
+Status ExportSink::send_chunk_as_parquet(vectorized::Chunk* chunk) {
+    SCOPED_TIMER(_write_timer);
+    const size_t num_cols = chunk->num_columns();
+    if (num_cols != _output_expr_ctxs.size()) {
+        auto err = strings::Substitute("Unmatched number of columns expected=$0 real=$1", _output_expr_ctxs.size(),
+                                       num_cols);
+        return Status::InternalError(err);
+    }
+    vectorized::Columns columns;
+    columns.reserve(num_cols);
+    for (int i = 0; i < num_cols; i++) {
+        columns.emplace_back(chunk->get_column_by_index(i));
+    }
+    int64_t written_bytes = _parquet_writer->written_bytes();
+    RETURN_IF_ERROR(_parquet_writer->write(columns));
+    COUNTER_UPDATE(_bytes_written_counter, _parquet_writer->written_bytes() - written_bytes);
+    COUNTER_UPDATE(_rows_written_counter, chunk->num_rows());
+    return Status::OK();
+}
+
 } // namespace starrocks
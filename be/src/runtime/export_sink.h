@@ -42,12 +42,16 @@ class FileWriter;
 class Status;
 class TupleRow;
 
+namespace vectorized {
+class ParquetChunkWriter;
+}
+
 // This class is a sinker, which put export data to external storage by broker.
 class ExportSink : public DataSink {
 public:
     ExportSink(ObjectPool* pool, const RowDescriptor& row_desc, const std::vector<TExpr>& t_exprs);
 
-    ~ExportSink() override = default;
+    ~ExportSink() override;
 
     Status init(const TDataSink& thrift_sink) override;
 
@@ -69,6 +73,8 @@ private:
     Status open_file_writer(int timeout_ms);
     Status gen_row_buffer(TupleRow* row, std::stringstream* ss);
     Status gen_file_name(std::string* file_name);
+    Status send_chunk_as_parquet(vectorized::Chunk* chunk);
+    bool is_parquet() const;
 
     RuntimeState* _state;
 
@@ -91,6 +97,7 @@ private:
 
     std::unique_ptr<vectorized::csv::OutputStreamFile> _output_stream;
     std::vector<ConverterPtr> _converters;
+    std::unique_ptr<vectorized::ParquetChunkWriter> _parquet_writer;
 };
 
 } // end namespace starrocks
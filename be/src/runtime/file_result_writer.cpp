@@ -21,15 +21,26 @@
 
 #include "runtime/file_result_writer.h"
 
+#include <fmt/format.h>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "common/config.h"
 #include "exec/broker_writer.h"
 #include "exec/local_file_writer.h"
 #include "exec/parquet_writer.h"
+#include "exec/vectorized/parquet_chunk_writer.h"
 #include "exprs/expr.h"
 #include "gen_cpp/InternalService_types.h"
+#include "runtime/decimalv3.h"
+#include "runtime/large_int_value.h"
 #include "runtime/primitive_type.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "runtime/vectorized/time_types.h"
 #include "util/date_func.h"
 #include "util/types.h"
 #include "util/uid_util.h"
@@ -43,6 +54,7 @@ FileResultWriter::FileResultWriter(const ResultFileOptions* file_opts,
         : _file_opts(file_opts), _output_expr_ctxs(output_expr_ctxs), _parent_profile(parent_profile) {}
 
 FileResultWriter::~FileResultWriter() {
+    (void)_stop_write_thread();
     _close_file_writer(true);
 }
 
@@ -51,6 +63,12 @@ Status FileResultWriter::init(RuntimeState* state) {
     _init_profile();
 
     RETURN_IF_ERROR(_create_file_writer());
+    if (_file_opts->file_format == TFileFormatType::FORMAT_CSV_PLAIN) {
+        _max_write_buffers = std::max(config::file_result_writer_async_buffers, 0);
+    }
+    if (_max_write_buffers > 0) {
+        _write_thread = std::thread([this] { _write_plain_text_loop(); });
+    }
     return Status::OK();
 }
 
@@ -78,9 +96,16 @@ Status FileResultWriter::_create_file_writer() {
     case TFileFormatType::FORMAT_CSV_PLAIN:
         // just use file writer is enough
         break;
-    case TFileFormatType::FORMAT_PARQUET:
-        _parquet_writer = new ParquetWriterWrapper(_file_writer, _output_expr_ctxs);
+    case TFileFormatType::FORMAT_PARQUET: {
+        std::vector<TypeDescriptor> types;
+        for (auto* ctx : _output_expr_ctxs) {
+            types.emplace_back(ctx->root()->type());
+        }
+        _parquet_writer = std::make_unique<vectorized::ParquetChunkWriter>(
+                std::make_shared<ParquetOutputStream>(_file_writer), std::move(types));
+        RETURN_IF_ERROR(_parquet_writer->init());
         break;
+    }
     default:
         return Status::InternalError(strings::Substitute("unsupport file format: $0", _file_opts->file_format));
     }
@@ -114,19 +139,188 @@ Status FileResultWriter::append_row_batch(const RowBatch* batch) {
 
     SCOPED_TIMER(_append_row_batch_timer);
     if (_parquet_writer != nullptr) {
-        RETURN_IF_ERROR(_parquet_writer->write(*batch));
-    } else {
-        RETURN_IF_ERROR(_write_csv_file(*batch));
+        return Status::NotSupported("Parquet files are only written from chunks");
     }
+    RETURN_IF_ERROR(_write_csv_file(*batch));
 
     _written_rows += batch->num_rows();
     return Status::OK();
 }
 
 Status FileResultWriter::append_chunk(vectorized::Chunk* chunk) {
+    if (nullptr == chunk || 0 == chunk->num_rows()) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_append_row_batch_timer);
+    if (_parquet_writer != nullptr) {
+        RETURN_IF_ERROR(_write_parquet_file(chunk));
+    } else {
+        RETURN_IF_ERROR(_write_csv_file(chunk));
+    }
+    _written_rows += chunk->num_rows();
+    return Status::OK();
+}
+
+// Format the cells of |data_column| into |buf| one after another, and append the end offset of each cell to |ends|.
+// The loop is specialized for the type of the column, so the cells are formatted without a virtual call per cell.
+template <PrimitiveType PT>
+static void put_csv_cells(const vectorized::Column& data_column, const uint8_t* nulls, const TypeDescriptor& type,
+                          int output_scale, std::string* buf, std::vector<uint32_t>* ends) {
+    using ColumnType = vectorized::RunTimeColumnType<PT>;
+    const auto& column = down_cast<const ColumnType&>(data_column);
+    const size_t num_rows = column.size();
+    [[maybe_unused]] char str[64];
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (nulls != nullptr && nulls[i]) {
+            buf->append(ResultWriter::NULL_IN_CSV);
+        } else if constexpr (pt_is_binary<PT>) {
+            Slice s = column.get_slice(i);
+            buf->append(s.data, s.size);
+        } else if constexpr (PT == TYPE_BOOLEAN || PT == TYPE_TINYINT || PT == TYPE_SMALLINT || PT == TYPE_INT ||
+                             PT == TYPE_BIGINT) {
+            auto f = fmt::format_int(static_cast<int64_t>(column.get_data()[i]));
+            buf->append(f.data(), f.size());
+        } else if constexpr (PT == TYPE_LARGEINT) {
+            int len = sizeof(str);
+            char* s = LargeIntValue::to_string(column.get_data()[i], str, &len);
+            buf->append(s, len);
+        } else if constexpr (PT == TYPE_FLOAT) {
+            int len = FloatToBuffer(column.get_data()[i], MAX_FLOAT_STR_LENGTH, str);
+            buf->append(str, len);
+        } else if constexpr (PT == TYPE_DOUBLE) {
+            // see the row format for why the doubles aren't output by the stream
+            int len = DoubleToBuffer(column.get_data()[i], MAX_DOUBLE_STR_LENGTH, str);
+            buf->append(str, len);
+        } else if constexpr (PT == TYPE_DATE) {
+            int year, month, day;
+            vectorized::date::to_date_with_cache(column.get_data()[i].julian(), &year, &month, &day);
+            vectorized::date::to_string(year, month, day, str);
+            buf->append(str, 10);
+        } else if constexpr (PT == TYPE_DATETIME) {
+            int len = column.get_data()[i].to_string(str, sizeof(str));
+            buf->append(str, len);
+        } else if constexpr (PT == TYPE_DECIMALV2) {
+            const DecimalV2Value& value = column.get_data()[i];
+            buf->append(output_scale > 0 && output_scale <= 30 ? value.to_string(output_scale) : value.to_string());
+        } else {
+            static_assert(PT == TYPE_DECIMAL32 || PT == TYPE_DECIMAL64 || PT == TYPE_DECIMAL128);
+            buf->append(DecimalV3Cast::to_string<vectorized::RunTimeCppType<PT>>(column.get_data()[i], type.precision,
+                                                                                  type.scale));
+        }
+        ends->push_back(buf->size());
+    }
+}
+
+static void put_csv_cells(ExprContext* ctx, const vectorized::Column& column, std::string* buf,
+                          std::vector<uint32_t>* ends) {
+    const TypeDescriptor& type = ctx->root()->type();
+    int output_scale = ctx->root()->output_scale();
+    const vectorized::Column* data_column = &column;
+    const uint8_t* nulls = nullptr;
+    if (column.is_nullable()) {
+        const auto& nullable_column = down_cast<const vectorized::NullableColumn&>(column);
+        data_column = nullable_column.data_column().get();
+        if (nullable_column.has_null()) {
+            nulls = nullable_column.null_column()->get_data().data();
+        }
+    }
+    switch (type.type) {
+#define M(PT)                                                                  \
+    case PT:                                                                   \
+        put_csv_cells<PT>(*data_column, nulls, type, output_scale, buf, ends); \
+        return;
+        M(TYPE_BOOLEAN)
+        M(TYPE_TINYINT)
+        M(TYPE_SMALLINT)
+        M(TYPE_INT)
+        M(TYPE_BIGINT)
+        M(TYPE_LARGEINT)
+        M(TYPE_FLOAT)
+        M(TYPE_DOUBLE)
+        M(TYPE_CHAR)
+        M(TYPE_VARCHAR)
+        M(TYPE_DATE)
+        M(TYPE_DATETIME)
+        M(TYPE_DECIMALV2)
+        M(TYPE_DECIMAL32)
+        M(TYPE_DECIMAL64)
+        M(TYPE_DECIMAL128)
+#undef M
+    default:
+        break;
+    }
+    // not supported type, like BITMAP, HLL, just export null
+    for (size_t i = 0; i < column.size(); ++i) {
+        buf->append(ResultWriter::NULL_IN_CSV);
+        ends->push_back(buf->size());
+    }
+}
+
+Status FileResultWriter::_write_csv_file(vectorized::Chunk* chunk) {
+    {
+        SCOPED_TIMER(_convert_tuple_timer);
+        const size_t num_rows = chunk->num_rows();
+        const size_t num_columns = _output_expr_ctxs.size();
+        _column_buffers.resize(num_columns);
+        _column_ends.resize(num_columns);
+        for (size_t j = 0; j < num_columns; ++j) {
+            auto* ctx = _output_expr_ctxs[j];
+            ColumnPtr column = vectorized::ColumnHelper::unfold_const_column(ctx->root()->type(), num_rows,
+                                                                            ctx->evaluate(chunk));
+            _column_buffers[j].clear();
+            _column_ends[j].clear();
+            _column_ends[j].reserve(num_rows);
+            put_csv_cells(ctx, *column, &_column_buffers[j], &_column_ends[j]);
+            DCHECK_EQ(num_rows, _column_ends[j].size());
+        }
+
+        const std::string& separator = _file_opts->column_separator;
+        const std::string& delimiter = _file_opts->row_delimiter;
+        size_t size = _csv_buffer.size() + num_rows * delimiter.size();
+        for (size_t j = 0; j < num_columns; ++j) {
+            size += _column_buffers[j].size() + (j + 1 < num_columns ? num_rows * separator.size() : 0);
+        }
+        _csv_buffer.reserve(size);
+        for (size_t i = 0; i < num_rows; ++i) {
+            for (size_t j = 0; j < num_columns; ++j) {
+                uint32_t start = i == 0 ? 0 : _column_ends[j][i - 1];
+                _csv_buffer.append(_column_buffers[j].data() + start, _column_ends[j][i] - start);
+                if (j + 1 < num_columns) {
+                    _csv_buffer.append(separator);
+                }
+            }
+            _csv_buffer.append(delimiter);
+        }
+    }
+    if (_csv_buffer.size() >= OUTSTREAM_BUFFER_SIZE_BYTES) {
+        std::string data;
+        data.swap(_csv_buffer);
+        RETURN_IF_ERROR(_write_plain_text(std::move(data)));
+    }
     return Status::OK();
 }
 
+Status FileResultWriter::_write_parquet_file(vectorized::Chunk* chunk) {
+    vectorized::Columns columns;
+    {
+        SCOPED_TIMER(_convert_tuple_timer);
+        columns.reserve(_output_expr_ctxs.size());
+        for (auto* ctx : _output_expr_ctxs) {
+            columns.emplace_back(ctx->evaluate(chunk));
+        }
+    }
+    {
+        SCOPED_TIMER(_file_write_timer);
+        RETURN_IF_ERROR(_parquet_writer->write(columns));
+    }
+    // the bytes are written to the file by row groups
+    int64_t written_bytes = _parquet_writer->written_bytes();
+    COUNTER_UPDATE(_written_data_bytes, written_bytes - _current_written_bytes);
+    _current_written_bytes = written_bytes;
+    return _create_new_file_if_exceed_size();
+}
+
 Status FileResultWriter::_write_csv_file(const RowBatch& batch) {
     int num_rows = batch.num_rows();
     for (int i = 0; i < num_rows; ++i) {
@@ -255,28 +449,80 @@ Status FileResultWriter::_write_one_row_as_csv(TupleRow* row) {
 }
 
 Status FileResultWriter::_flush_plain_text_outstream(bool eos) {
-    SCOPED_TIMER(_file_write_timer);
     size_t pos = _plain_text_outstream.tellp();
     if (pos == 0 || (pos < OUTSTREAM_BUFFER_SIZE_BYTES && !eos)) {
         return Status::OK();
     }
 
-    const std::string& buf = _plain_text_outstream.str();
-    size_t written_len = 0;
-    RETURN_IF_ERROR(_file_writer->write(reinterpret_cast<const uint8_t*>(buf.c_str()), buf.size(), &written_len));
-    COUNTER_UPDATE(_written_data_bytes, written_len);
-    _current_written_bytes += written_len;
+    std::string buf = _plain_text_outstream.str();
 
     // clear the stream
     _plain_text_outstream.str("");
     _plain_text_outstream.clear();
 
+    return _write_plain_text(std::move(buf));
+}
+
+Status FileResultWriter::_write_plain_text(std::string data) {
+    if (_max_write_buffers == 0) {
+        return _write_plain_text_to_file(data);
+    }
+    std::unique_lock<std::mutex> l(_write_mutex);
+    _write_cv.wait(l, [this] { return _write_buffers.size() < _max_write_buffers || !_write_status.ok(); });
+    RETURN_IF_ERROR(_write_status);
+    _write_buffers.emplace_back(std::move(data));
+    _write_cv.notify_all();
+    return Status::OK();
+}
+
+Status FileResultWriter::_write_plain_text_to_file(const std::string& data) {
+    SCOPED_TIMER(_file_write_timer);
+    size_t written_len = 0;
+    RETURN_IF_ERROR(_file_writer->write(reinterpret_cast<const uint8_t*>(data.data()), data.size(), &written_len));
+    COUNTER_UPDATE(_written_data_bytes, written_len);
+    _current_written_bytes += written_len;
+
     // split file if exceed limit
     RETURN_IF_ERROR(_create_new_file_if_exceed_size());
 
     return Status::OK();
 }
 
+void FileResultWriter::_write_plain_text_loop() {
+    std::unique_lock<std::mutex> l(_write_mutex);
+    while (true) {
+        _write_cv.wait(l, [this] { return !_write_buffers.empty() || _write_done; });
+        if (_write_buffers.empty()) {
+            return;
+        }
+        std::string data = std::move(_write_buffers.front());
+        _write_buffers.pop_front();
+        _write_cv.notify_all();
+        l.unlock();
+        Status st = _write_plain_text_to_file(data);
+        l.lock();
+        if (!st.ok()) {
+            _write_status = st;
+            _write_buffers.clear();
+            _write_cv.notify_all();
+            return;
+        }
+    }
+}
+
+Status FileResultWriter::_stop_write_thread() {
+    if (!_write_thread.joinable()) {
+        return Status::OK();
+    }
+    {
+        std::lock_guard<std::mutex> l(_write_mutex);
+        _write_done = true;
+        _write_cv.notify_all();
+    }
+    _write_thread.join();
+    return _write_status;
+}
+
 Status FileResultWriter::_create_new_file_if_exceed_size() {
     if (_current_written_bytes < _file_opts->max_file_size_bytes) {
         return Status::OK();
@@ -292,19 +538,20 @@ Status FileResultWriter::_create_new_file_if_exceed_size() {
 }
 
 Status FileResultWriter::_close_file_writer(bool done) {
+    Status st;
     if (_parquet_writer != nullptr) {
-        _parquet_writer->close();
-        delete _parquet_writer;
-        _parquet_writer = nullptr;
-        if (!done) {
-            //TODO(cmy): implement parquet writer later
-        }
-    } else if (_file_writer != nullptr) {
+        // the file writer is closed with the parquet writer, which must be released before it.
+        st = _parquet_writer->close();
+        _parquet_writer.reset();
+    }
+    if (_file_writer != nullptr) {
         _file_writer->close();
         delete _file_writer;
         _file_writer = nullptr;
     }
 
+    RETURN_IF_ERROR(st);
+
     if (!done) {
         // not finished, create new file writer for next file
         RETURN_IF_ERROR(_create_file_writer());
@@ -320,8 +567,17 @@ Status FileResultWriter::close() {
     // so does the profile in RuntimeState.
     COUNTER_SET(_written_rows_counter, _written_rows);
     SCOPED_TIMER(_writer_close_timer);
-    RETURN_IF_ERROR(_close_file_writer(true));
-    return Status::OK();
+    Status st;
+    if (!_csv_buffer.empty()) {
+        std::string data;
+        data.swap(_csv_buffer);
+        st = _write_plain_text(std::move(data));
+    }
+    Status write_st = _stop_write_thread();
+    st = st.ok() ? write_st : st;
+    Status close_st = _close_file_writer(true);
+    RETURN_IF_ERROR(st);
+    return close_st;
 }
 
 } // namespace starrocks
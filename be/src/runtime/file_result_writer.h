@@ -21,6 +21,11 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "gen_cpp/DataSinks_types.h"
 #include "runtime/result_writer.h"
 #include "runtime/runtime_state.h"
@@ -29,11 +34,14 @@ namespace starrocks {
 
 class ExprContext;
 class FileWriter;
-class ParquetWriterWrapper;
 class RowBatch;
 class RuntimeProfile;
 class TupleRow;
 
+namespace vectorized {
+class ParquetChunkWriter;
+}
+
 struct ResultFileOptions {
     bool is_local_file;
     std::string file_path;
@@ -76,11 +84,20 @@ public:
 
 private:
     Status _write_csv_file(const RowBatch& batch);
+    // format the columns of the chunk to text column by column, and then assemble the rows in _csv_buffer
+    Status _write_csv_file(vectorized::Chunk* chunk);
+    Status _write_parquet_file(vectorized::Chunk* chunk);
     Status _write_one_row_as_csv(TupleRow* row);
 
     // if buffer exceed the limit, write the data buffered in _plain_text_outstream via file_writer
     // if eos, write the data even if buffer is not full.
     Status _flush_plain_text_outstream(bool eos);
+    // write the csv data via file_writer, or queue it for _write_thread
+    Status _write_plain_text(std::string data);
+    Status _write_plain_text_to_file(const std::string& data);
+    void _write_plain_text_loop();
+    // wait for _write_thread to write the queued data, return its first error
+    Status _stop_write_thread();
     void _init_profile();
 
     Status _create_file_writer();
@@ -96,11 +113,10 @@ private:
     const ResultFileOptions* _file_opts;
     const std::vector<ExprContext*>& _output_expr_ctxs;
 
-    // If the result file format is plain text, like CSV, this _file_writer is owned by this FileResultWriter.
-    // If the result file format is Parquet, this _file_writer is owned by _parquet_writer.
+    // this _file_writer is owned by this FileResultWriter.
     FileWriter* _file_writer = nullptr;
-    // parquet file writer
-    ParquetWriterWrapper* _parquet_writer = nullptr;
+    // parquet file writer, which writes to _file_writer
+    std::unique_ptr<vectorized::ParquetChunkWriter> _parquet_writer;
     // Used to buffer the export data of plain text
     // TODO(cmy): I simply use a stringstrteam to buffer the data, to avoid calling
     // file writer's write() for every single row.
@@ -109,6 +125,19 @@ private:
     // And the speed is relative low, in my test, is about 6.5MB/s.
     std::stringstream _plain_text_outstream;
     static const size_t OUTSTREAM_BUFFER_SIZE_BYTES;
+    // the csv data of the chunks, and the text of the cells of each column of a chunk with their end offsets
+    std::string _csv_buffer;
+    std::vector<std::string> _column_buffers;
+    std::vector<std::vector<uint32_t>> _column_ends;
+
+    // the thread writing the queued csv data to the files, when file_result_writer_async_buffers > 0
+    std::thread _write_thread;
+    size_t _max_write_buffers = 0;
+    std::mutex _write_mutex;
+    std::condition_variable _write_cv;
+    std::deque<std::string> _write_buffers;
+    bool _write_done = false;
+    Status _write_status;
 
     // current written bytes, used for split data
     int64_t _current_written_bytes = 0;
@@ -24,6 +24,7 @@
 #include <gperftools/profiler.h>
 #include <thrift/protocol/TDebugProtocol.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <sstream>
@@ -42,6 +43,7 @@
 #include "runtime/datetime_value.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
 #include "runtime/plan_fragment_executor.h"
 #include "runtime/runtime_filter_worker.h"
 #include "service/backend_options.h"
@@ -78,7 +80,8 @@ public:
 
     ~FragmentExecState();
 
-    Status prepare(const TExecPlanFragmentParams& params);
+    Status prepare(const TExecPlanFragmentParams& params, const TPlanFragment& fragment,
+                   std::shared_ptr<DescriptorTbl> desc_tbl);
 
     // just no use now
     void callback(const Status& status, RuntimeProfile* profile, bool done);
@@ -165,7 +168,8 @@ FragmentExecState::FragmentExecState(const TUniqueId& query_id, const TUniqueId&
 
 FragmentExecState::~FragmentExecState() {}
 
-Status FragmentExecState::prepare(const TExecPlanFragmentParams& params) {
+Status FragmentExecState::prepare(const TExecPlanFragmentParams& params, const TPlanFragment& fragment,
+                                  std::shared_ptr<DescriptorTbl> desc_tbl) {
     if (params.__isset.query_options) {
         _timeout_second = params.query_options.query_timeout;
     }
@@ -174,6 +178,9 @@ Status FragmentExecState::prepare(const TExecPlanFragmentParams& params) {
         set_group(params.resource_info);
     }
 
+    if (desc_tbl != nullptr) {
+        return _executor.prepare(params, fragment, std::move(desc_tbl));
+    }
     return _executor.prepare(params);
 }
 
@@ -187,6 +194,7 @@ Status FragmentExecState::execute() {
     }
     StarRocksMetrics::instance()->fragment_requests_total.increment(1);
     StarRocksMetrics::instance()->fragment_request_duration_us.increment(duration_ns / 1000);
+    StarRocksMetrics::instance()->fragment_request_latency_us.add(duration_ns / 1000);
     return Status::OK();
 }
 
@@ -333,6 +341,14 @@ FragmentMgr::FragmentMgr(ExecEnv* exec_env)
         std::lock_guard<std::mutex> lock(_lock);
         return _fragment_map.size();
     });
+    REGISTER_GAUGE_STARROCKS_METRIC(fragment_admission_queue_length, [this]() {
+        std::lock_guard<std::mutex> lock(_admission_lock);
+        return _num_admission_waiters;
+    });
+    REGISTER_GAUGE_STARROCKS_METRIC(fragment_admission_reserved_bytes, [this]() {
+        std::lock_guard<std::mutex> lock(_admission_lock);
+        return _reserved_bytes;
+    });
     // TODO(zc): we need a better thread-pool
     // now one user can use all the thread pool, others have no resource.
     ThreadPoolBuilder("FragmentMgrThreadPool")
@@ -359,8 +375,10 @@ FragmentMgr::~FragmentMgr() {
 
 static void empty_function(PlanFragmentExecutor* exec) {}
 
-void FragmentMgr::exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb) {
+void FragmentMgr::exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb,
+                              int64_t reserved_bytes) {
     exec_state->execute();
+    _release(reserved_bytes);
 
     {
         std::lock_guard<std::mutex> lock(_lock);
@@ -383,6 +401,104 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params) {
 }
 
 Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, FinishCallback cb) {
+    return _exec_plan_fragment(params, params.fragment, nullptr, std::move(cb));
+}
+
+Status FragmentMgr::exec_batch_plan_fragments(const TExecBatchPlanFragmentsParams& batch_params) {
+    const TExecPlanFragmentParams& common_params = batch_params.common_param;
+    if (!common_params.__isset.fragment || !common_params.__isset.desc_tbl) {
+        return Status::InvalidArgument("fragment and desc_tbl are required by the batch of fragment instances");
+    }
+    // the descriptor table is parsed once and lives as long as the last instance using it.
+    auto desc_pool = std::make_shared<ObjectPool>();
+    DescriptorTbl* desc_tbl = nullptr;
+    RETURN_IF_ERROR(DescriptorTbl::create(desc_pool.get(), common_params.desc_tbl, &desc_tbl));
+    std::shared_ptr<DescriptorTbl> shared_desc_tbl(desc_pool, desc_tbl);
+
+    // copy the common fields but the big fragment and desc_tbl once for all the instances.
+    TExecPlanFragmentParams instance_params = common_params;
+    instance_params.fragment = TPlanFragment();
+    instance_params.__isset.fragment = false;
+    instance_params.desc_tbl = TDescriptorTable();
+    instance_params.__isset.desc_tbl = false;
+    for (const auto& unique_params : batch_params.unique_param_per_instance) {
+        instance_params.__set_params(unique_params.params);
+        instance_params.__set_backend_num(unique_params.backend_num);
+        RETURN_IF_ERROR(_exec_plan_fragment(instance_params, common_params.fragment, shared_desc_tbl,
+                                            std::bind<void>(&empty_function, std::placeholders::_1)));
+    }
+    return Status::OK();
+}
+
+int64_t FragmentMgr::_admission_bytes(const TExecPlanFragmentParams& params, int64_t mem_limit) {
+    int32_t percent = config::fragment_admission_mem_reserve_percent;
+    if (percent <= 0 || mem_limit <= 0) {
+        return 0;
+    }
+    // the same limit as the one of the query mem tracker of the fragment.
+    int64_t bytes_limit = params.query_options.mem_limit;
+    if (bytes_limit <= 0) {
+        bytes_limit = 2 * 1024 * 1024 * 1024L;
+    }
+    return std::min(bytes_limit, mem_limit) * std::min(percent, 100) / 100;
+}
+
+int64_t FragmentMgr::_admission_mem_limit() const {
+    if (config::fragment_admission_mem_limit > 0) {
+        return config::fragment_admission_mem_limit;
+    }
+    if (_exec_env != nullptr && _exec_env->query_pool_mem_tracker() != nullptr) {
+        return _exec_env->query_pool_mem_tracker()->limit();
+    }
+    return -1;
+}
+
+Status FragmentMgr::_admit(const TUniqueId& fragment_instance_id, int64_t* bytes) {
+    if (*bytes <= 0) {
+        *bytes = 0;
+        return Status::OK();
+    }
+    int64_t mem_limit = _admission_mem_limit();
+    std::unique_lock<std::mutex> l(_admission_lock);
+    // always admit a fragment when nothing is reserved, in case of the ones larger than the limit.
+    auto granted = [&]() { return _reserved_bytes == 0 || _reserved_bytes + *bytes <= mem_limit; };
+    if (!granted()) {
+        if (_num_admission_waiters >= config::fragment_admission_queue_size) {
+            StarRocksMetrics::instance()->fragment_admission_rejected_total.increment(1);
+            return Status::TooManyTasks(strings::Substitute(
+                    "Reject fragment $0 for the $1 fragments waiting for the admission of the memory",
+                    print_id(fragment_instance_id), _num_admission_waiters));
+        }
+        StarRocksMetrics::instance()->fragment_admission_queued_total.increment(1);
+        _num_admission_waiters++;
+        bool admitted = _admission_cv.wait_for(
+                l, std::chrono::milliseconds(config::fragment_admission_timeout_ms), granted);
+        _num_admission_waiters--;
+        if (!admitted) {
+            StarRocksMetrics::instance()->fragment_admission_timeout_total.increment(1);
+            return Status::TimedOut(strings::Substitute(
+                    "Fragment $0 waits for the admission of $1 bytes memory for more than $2ms, reserved: $3",
+                    print_id(fragment_instance_id), *bytes, config::fragment_admission_timeout_ms,
+                    _reserved_bytes));
+        }
+    }
+    _reserved_bytes += *bytes;
+    return Status::OK();
+}
+
+void FragmentMgr::_release(int64_t bytes) {
+    if (bytes <= 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> l(_admission_lock);
+        _reserved_bytes -= bytes;
+    }
+    _admission_cv.notify_all();
+}
+
+Status FragmentMgr::_exec_plan_fragment(const TExecPlanFragmentParams& params, const TPlanFragment& fragment,
+                                        std::shared_ptr<DescriptorTbl> desc_tbl, FinishCallback cb) {
     const TUniqueId& fragment_instance_id = params.params.fragment_instance_id;
     std::shared_ptr<FragmentExecState> exec_state;
     {
@@ -393,23 +509,34 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, Fi
             return Status::OK();
         }
     }
+    int64_t reserved_bytes = _admission_bytes(params, _admission_mem_limit());
+    RETURN_IF_ERROR(_admit(fragment_instance_id, &reserved_bytes));
+
     exec_state.reset(new FragmentExecState(params.params.query_id, fragment_instance_id, params.backend_num, _exec_env,
                                            params.coord));
-    RETURN_IF_ERROR_WITH_WARN(exec_state->prepare(params), "Fail to prepare Fragment");
+    auto prepare_st = exec_state->prepare(params, fragment, std::move(desc_tbl));
+    if (!prepare_st.ok()) {
+        _release(reserved_bytes);
+        LOG(WARNING) << "Fail to prepare Fragment, error: " << prepare_st.to_string();
+        return prepare_st;
+    }
 
     {
         std::lock_guard<std::mutex> lock(_lock);
         auto iter = _fragment_map.find(fragment_instance_id);
         if (iter != _fragment_map.end()) {
             // Duplicated
+            _release(reserved_bytes);
             return Status::InternalError("Double execute");
         }
         // register exec_state before starting exec thread
         _fragment_map.insert(std::make_pair(fragment_instance_id, exec_state));
     }
 
-    auto st = _thread_pool->submit_func(std::bind<void>(&FragmentMgr::exec_actual, this, exec_state, cb));
+    auto st = _thread_pool->submit_func(
+            std::bind<void>(&FragmentMgr::exec_actual, this, exec_state, cb, reserved_bytes));
     if (!st.ok()) {
+        _release(reserved_bytes);
         {
             // Remove the exec state added
             std::lock_guard<std::mutex> lock(_lock);
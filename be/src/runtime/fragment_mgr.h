@@ -22,6 +22,7 @@
 #ifndef STARROCKS_BE_RUNTIME_FRAGMENT_MGR_H
 #define STARROCKS_BE_RUNTIME_FRAGMENT_MGR_H
 
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -40,7 +41,10 @@ namespace starrocks {
 
 class ExecEnv;
 class FragmentExecState;
+class DescriptorTbl;
+class TExecBatchPlanFragmentsParams;
 class TExecPlanFragmentParams;
+class TPlanFragment;
 class TUniqueId;
 class PlanFragmentExecutor;
 class ThreadPool;
@@ -64,6 +68,10 @@ public:
     // TODO(zc): report this is over
     Status exec_plan_fragment(const TExecPlanFragmentParams& params, FinishCallback cb);
 
+    // execute the instances of a fragment launched in a batch, which share the plan and the descriptor table
+    // parsed once.
+    Status exec_batch_plan_fragments(const TExecBatchPlanFragmentsParams& batch_params);
+
     Status cancel(const TUniqueId& fragment_id) {
         return cancel(fragment_id, PPlanFragmentCancelReason::INTERNAL_ERROR);
     }
@@ -86,7 +94,25 @@ public:
                                        std::vector<TScanColumnDesc>* selected_columns);
 
 private:
-    void exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb);
+    void exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb, int64_t reserved_bytes);
+
+    // The memory a fragment reserves before it's prepared, 0 if it needs no admission.
+    static int64_t _admission_bytes(const TExecPlanFragmentParams& params, int64_t mem_limit);
+
+    // The bytes the reservations are granted against, -1 if unlimited.
+    int64_t _admission_mem_limit() const;
+
+    // Reserves |*bytes| of memory for the fragment, waiting for the release of the others for at most
+    // config::fragment_admission_timeout_ms if the reservation can't be granted. |*bytes| is set to 0 if
+    // nothing is reserved.
+    Status _admit(const TUniqueId& fragment_instance_id, int64_t* bytes);
+
+    void _release(int64_t bytes);
+
+    // |fragment| is the plan of the instance, and |desc_tbl| is the descriptor table shared by the instances of
+    // a batch, or null if it's parsed from |params|.
+    Status _exec_plan_fragment(const TExecPlanFragmentParams& params, const TPlanFragment& fragment,
+                               std::shared_ptr<DescriptorTbl> desc_tbl, FinishCallback cb);
 
     // This is input params
     ExecEnv* _exec_env;
@@ -101,6 +127,12 @@ private:
     std::thread _cancel_thread;
     // every job is a pool
     std::unique_ptr<ThreadPool> _thread_pool;
+
+    // The admission of the fragments by their memory.
+    std::mutex _admission_lock;
+    std::condition_variable _admission_cv;
+    int64_t _reserved_bytes = 0;
+    size_t _num_admission_waiters = 0;
 };
 
 } // namespace starrocks
@@ -195,12 +195,22 @@ void LoadChannel::_handle_mem_exceed_limit() {
               << ", current mem consumption=" << _mem_tracker->consumption() << ", limit=" << _mem_tracker->limit();
 }
 
-void LoadChannel::reduce_mem_usage_async(const std::set<int64_t>& flush_tablet_ids,
-                                         std::shared_ptr<TabletsChannel>* tablets_channel, int64_t* tablet_id,
-                                         int64_t* tablet_mem_consumption) {
-    // lock so that only one thread can check mem limit
-    std::lock_guard<std::mutex> l(_lock);
-    _reduce_mem_usage_async_internal(flush_tablet_ids, tablets_channel, tablet_id, tablet_mem_consumption);
+void LoadChannel::get_tablet_writer_mem_consumptions(std::vector<TabletWriterMemConsumption>* consumptions) {
+    std::vector<std::shared_ptr<TabletsChannel>> tablets_channels;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        for (auto& it : _tablets_channels) {
+            tablets_channels.push_back(it.second);
+        }
+    }
+    std::vector<std::pair<int64_t, int64_t>> tablet_mem_consumptions;
+    for (auto& tablets_channel : tablets_channels) {
+        tablet_mem_consumptions.clear();
+        tablets_channel->get_tablet_mem_consumptions(&tablet_mem_consumptions);
+        for (auto& [tablet_id, mem_consumption] : tablet_mem_consumptions) {
+            consumptions->push_back({tablets_channel, tablet_id, mem_consumption});
+        }
+    }
 }
 
 void LoadChannel::_reduce_mem_usage_async_internal(const std::set<int64_t>& flush_tablet_ids,
@@ -48,6 +48,13 @@ struct FlushTablet {
             : load_channel(load_channel), tablets_channel(tablets_channel), tablet_id(tablet_id) {}
 };
 
+// The mem consumption of a tablet writer, used to pick the writers to flush under memory pressure.
+struct TabletWriterMemConsumption {
+    std::shared_ptr<TabletsChannel> tablets_channel;
+    int64_t tablet_id;
+    int64_t mem_consumption;
+};
+
 // A LoadChannel manages tablets channels for all indexes
 // corresponding to a certain load job
 class LoadChannel {
@@ -74,10 +81,8 @@ public:
 
     const UniqueId& load_id() const { return _load_id; }
 
-    // reduce memory with lock, for handle mem exceed limit in load channel mgr.
-    void reduce_mem_usage_async(const std::set<int64_t>& flush_tablet_ids,
-                                std::shared_ptr<TabletsChannel>* tablets_channel, int64_t* tablet_id,
-                                int64_t* tablet_mem_consumption);
+    // Append the mem consumptions of all the tablet writers of this load channel to |consumptions|.
+    void get_tablet_writer_mem_consumptions(std::vector<TabletWriterMemConsumption>* consumptions);
 
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
     bool mem_limit_exceeded() const { return _mem_tracker->limit_exceeded(); }
@@ -21,6 +21,7 @@
 
 #include "runtime/load_channel_mgr.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "gutil/strings/substitute.h"
@@ -129,7 +130,7 @@ Status LoadChannelMgr::add_batch(const PTabletWriterAddBatchRequest& request,
     }
 
     // 2. check if mem consumption exceed limit
-    _handle_mem_exceed_limit(channel);
+    _handle_mem_exceed_limit();
 
     // 3. add batch to load channel
     // batch may not exist in request(eg: eos request without batch),
@@ -175,7 +176,7 @@ Status LoadChannelMgr::add_chunk(const PTabletWriterAddChunkRequest& request,
     }
 
     // 2. check if mem consumption exceed limit
-    _handle_mem_exceed_limit(channel);
+    _handle_mem_exceed_limit();
 
     // 3. add batch to load channel
     // batch may not exist in request(eg: eos request without batch),
@@ -196,93 +197,70 @@ Status LoadChannelMgr::add_chunk(const PTabletWriterAddChunkRequest& request,
     return Status::OK();
 }
 
-void LoadChannelMgr::_handle_mem_exceed_limit(const std::shared_ptr<LoadChannel>& data_channel) {
-    // lock so that only one thread can check mem limit
-    std::lock_guard<std::mutex> l(_lock);
-    if (!_mem_tracker->any_limit_exceeded()) {
+void LoadChannelMgr::_handle_mem_exceed_limit() {
+    int64_t limit = _mem_tracker->limit();
+    if (limit <= 0) {
+        return;
+    }
+    int64_t soft_limit = limit * std::clamp(config::load_mem_soft_limit_percent, 0, 100) / 100;
+    if (_mem_tracker->consumption() < soft_limit && !_mem_tracker->any_limit_exceeded()) {
         return;
     }
 
-    LOG(INFO) << "Reducing memory because total load mem consumption=" << _mem_tracker->consumption()
-              << " has exceeded limit=" << _mem_tracker->limit();
-
-    // TODO: ancestors exceeded?
-    int64_t exceeded_mem = _mem_tracker->consumption() - _mem_tracker->limit();
-    std::vector<FlushTablet> flush_tablets;
-    std::set<int64_t> flush_tablet_ids;
-    int64_t tablet_mem_consumption;
-    do {
-        std::shared_ptr<LoadChannel> load_channel;
-        std::shared_ptr<TabletsChannel> tablets_channel;
-        int64_t tablet_id = -1;
-        if (!_find_candidate_load_channel(data_channel, &load_channel)) {
-            // should not happen, add log to observe
-            LOG(WARNING) << "Fail to find suitable load channel when total load mem limit exceed";
-            break;
-        }
-        DCHECK(load_channel.get() != nullptr);
-
-        // reduce mem usage of the selected load channel
-        load_channel->reduce_mem_usage_async(flush_tablet_ids, &tablets_channel, &tablet_id, &tablet_mem_consumption);
-        if (tablet_id != -1) {
-            flush_tablets.emplace_back(load_channel.get(), tablets_channel.get(), tablet_id);
-            flush_tablet_ids.insert(tablet_id);
-            exceeded_mem -= tablet_mem_consumption;
-            VLOG(3) << "Flush " << *load_channel.get() << ", tablet id=" << tablet_id
-                    << ", mem consumption=" << tablet_mem_consumption;
-        } else {
-            break;
-        }
-    } while (exceeded_mem > 0);
+    std::lock_guard<std::mutex> reduce_lock(_reduce_mem_lock);
+    int64_t consumption = _mem_tracker->consumption();
+    bool hard_limit_exceeded = _mem_tracker->any_limit_exceeded();
+    if (consumption < soft_limit && !hard_limit_exceeded) {
+        // reduced by another thread
+        return;
+    }
 
-    // wait flush finish
-    for (const FlushTablet& flush_tablet : flush_tablets) {
-        Status st = flush_tablet.tablets_channel->wait_mem_usage_reduced(flush_tablet.tablet_id);
-        if (!st.ok()) {
-            // wait may return failed, but no need to handle it here, just log.
-            // tablet_vec will only contains success tablet, and then let FE judge it.
-            LOG(WARNING) << "Fail to wait memory reduced. err=" << st.to_string();
+    std::vector<std::shared_ptr<LoadChannel>> load_channels;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        for (auto& kv : _load_channels) {
+            load_channels.push_back(kv.second);
         }
     }
-    LOG(INFO) << "Reduce memory finish. flush tablets num=" << flush_tablet_ids.size()
-              << ", current mem consumption=" << _mem_tracker->consumption() << ", limit=" << _mem_tracker->limit();
-}
-
-bool LoadChannelMgr::_find_candidate_load_channel(const std::shared_ptr<LoadChannel>& data_channel,
-                                                  std::shared_ptr<LoadChannel>* candidate_channel) {
-    // 1. select the load channel that consume this batch data if limit exceeded.
-    if (data_channel->mem_limit_exceeded()) {
-        *candidate_channel = data_channel;
-        return true;
+    std::vector<TabletWriterMemConsumption> writers;
+    for (auto& load_channel : load_channels) {
+        load_channel->get_tablet_writer_mem_consumptions(&writers);
     }
-
-    int64_t max_consume = 0;
-    int64_t max_exceeded_consume = 0;
-    std::shared_ptr<LoadChannel> max_channel;
-    std::shared_ptr<LoadChannel> max_exceeded_channel;
-    for (auto& kv : _load_channels) {
-        if (kv.second->mem_consumption() > max_consume) {
-            max_consume = kv.second->mem_consumption();
-            max_channel = kv.second;
+    // Flush the largest memtables of all the loads first, so the memtables are written as fewer and larger segments.
+    std::sort(writers.begin(), writers.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.mem_consumption > rhs.mem_consumption; });
+
+    int64_t exceeded_mem = consumption - soft_limit;
+    std::vector<const TabletWriterMemConsumption*> flushed_writers;
+    for (const auto& writer : writers) {
+        if (exceeded_mem <= 0) {
+            break;
         }
-
-        if (kv.second->mem_limit_exceeded() && kv.second->mem_consumption() > max_exceeded_consume) {
-            max_exceeded_consume = kv.second->mem_consumption();
-            max_exceeded_channel = kv.second;
+        Status st = writer.tablets_channel->flush_tablet_async(writer.tablet_id);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to flush tablet " << writer.tablet_id << " to reduce memory. err=" << st.to_string();
+            continue;
         }
+        VLOG(3) << "Flush tablet id=" << writer.tablet_id << ", mem consumption=" << writer.mem_consumption;
+        flushed_writers.push_back(&writer);
+        exceeded_mem -= writer.mem_consumption;
     }
 
-    // 2. select the largest limit exceeded load channel.
-    if (max_exceeded_consume > 0) {
-        *candidate_channel = max_exceeded_channel;
-        return true;
-    }
-    // 3. select the largest consumption load channel.
-    if (max_consume > 0) {
-        *candidate_channel = max_channel;
-        return true;
+    if (hard_limit_exceeded) {
+        // Stall the writes until the flushes are finished
+        for (const auto* writer : flushed_writers) {
+            Status st = writer->tablets_channel->wait_mem_usage_reduced(writer->tablet_id);
+            if (!st.ok()) {
+                // wait may return failed, but no need to handle it here, just log.
+                // tablet_vec will only contains success tablet, and then let FE judge it.
+                LOG(WARNING) << "Fail to wait memory reduced. err=" << st.to_string();
+            }
+        }
     }
-    return false;
+    LOG(INFO) << "Reduce memory finish. flush tablets num=" << flushed_writers.size()
+              << ", hard limit exceeded=" << hard_limit_exceeded << ", mem consumption before=" << consumption
+              << ", current mem consumption=" << _mem_tracker->consumption() << ", soft limit=" << soft_limit
+              << ", limit=" << limit;
 }
 
 Status LoadChannelMgr::cancel(const PTabletWriterCancelRequest& params) {
@@ -61,21 +61,18 @@ public:
     Status cancel(const PTabletWriterCancelRequest& request);
 
 private:
-    // check if the total load mem consumption exceeds limit.
-    // If yes, it will pick several load channels to try to reduce memory consumption to limit.
-    void _handle_mem_exceed_limit(const std::shared_ptr<LoadChannel>& data_channel);
-
-    // find a load channel to reduce memory consumption
-    // 1. select the load channel that consume this batch data if limit exceeded.
-    // 2. select the largest limit exceeded load channel.
-    // 3. select the largest consumption load channel.
-    bool _find_candidate_load_channel(const std::shared_ptr<LoadChannel>& data_channel,
-                                      std::shared_ptr<LoadChannel>* candidate_channel);
+    // Check if the total load mem consumption exceeds the soft limit, config::load_mem_soft_limit_percent of
+    // the limit. If yes, flush the largest memtables of all the load channels asynchronously until the
+    // consumption is expected to be below the soft limit. If the hard limit is exceeded too, the caller
+    // is stalled until the flushes are finished, which slows the senders down instead of failing the load.
+    void _handle_mem_exceed_limit();
 
     Status _start_bg_worker();
 
     // lock protect the load channel map
     std::mutex _lock;
+    // only one thread reduces the load mem consumption at a time
+    std::mutex _reduce_mem_lock;
     // load id -> load channel
     std::unordered_map<UniqueId, std::shared_ptr<LoadChannel>> _load_channels;
     Cache* _lastest_success_channel = nullptr;
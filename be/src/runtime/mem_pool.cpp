@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <sstream>
 
+#include "common/config.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/memory/chunk_allocator.h"
 #include "util/bit_util.h"
@@ -37,6 +38,11 @@ namespace starrocks {
 
 const int MemPool::INITIAL_CHUNK_SIZE;
 const int MemPool::MAX_CHUNK_SIZE;
+const int MemPool::HUGE_PAGE_MAX_CHUNK_SIZE;
+
+int MemPool::max_chunk_size() {
+    return config::enable_huge_page_mem_pool ? HUGE_PAGE_MAX_CHUNK_SIZE : MAX_CHUNK_SIZE;
+}
 
 const int MemPool::DEFAULT_ALIGNMENT;
 uint32_t MemPool::k_zero_length_region_ alignas(std::max_align_t) = MEM_POOL_POISON;
@@ -107,7 +113,7 @@ bool MemPool::find_chunk(size_t min_size, bool check_limits) {
 
     // Didn't find a big enough free chunk - need to allocate new chunk.
     size_t chunk_size = 0;
-    DCHECK_LE(next_chunk_size_, MAX_CHUNK_SIZE);
+    DCHECK_LE(next_chunk_size_, max_chunk_size());
 
     if (config::disable_mem_pools) {
         // Disable pooling by sizing the chunk to fit only this allocation.
@@ -142,7 +148,7 @@ bool MemPool::find_chunk(size_t min_size, bool check_limits) {
     total_reserved_bytes_ += chunk_size;
     // Don't increment the chunk size until the allocation succeeds: if an attempted
     // large allocation fails we don't want to increase the chunk size further.
-    next_chunk_size_ = static_cast<int>(std::min<int64_t>(chunk_size * 2, MAX_CHUNK_SIZE));
+    next_chunk_size_ = static_cast<int>(std::min<int64_t>(chunk_size * 2, max_chunk_size()));
 
     DCHECK(check_integrity(true));
     return true;
@@ -177,6 +177,11 @@ private:
     /// size will get their own individual chunk.
     static const int MAX_CHUNK_SIZE = 512 * 1024;
 
+    /// The maximum size of chunk if config::enable_huge_page_mem_pool is true, which is a huge page.
+    static const int HUGE_PAGE_MAX_CHUNK_SIZE = 2 * 1024 * 1024;
+
+    static int max_chunk_size();
+
     struct ChunkInfo {
         Chunk chunk;
         /// bytes allocated via Allocate() in this chunk
@@ -21,6 +21,7 @@
 
 #include "runtime/memory/system_allocator.h"
 
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
@@ -33,11 +34,17 @@ namespace starrocks {
 #define PAGE_SIZE (4 * 1024) // 4K
 
 uint8_t* SystemAllocator::allocate(size_t length) {
+    bool huge_page = config::enable_huge_page_mem_pool && length >= HUGE_PAGE_SIZE;
+    uint8_t* ptr = nullptr;
     if (config::use_mmap_allocate_chunk) {
-        return allocate_via_mmap(length);
+        ptr = allocate_via_mmap(length);
     } else {
-        return allocate_via_malloc(length);
+        ptr = allocate_via_malloc(length, huge_page ? HUGE_PAGE_SIZE : PAGE_SIZE);
     }
+    if (ptr != nullptr && huge_page) {
+        advise_huge_page(ptr, length);
+    }
+    return ptr;
 }
 
 void SystemAllocator::free(uint8_t* ptr, size_t length) {
@@ -51,10 +58,10 @@ void SystemAllocator::free(uint8_t* ptr, size_t length) {
     }
 }
 
-uint8_t* SystemAllocator::allocate_via_malloc(size_t length) {
+uint8_t* SystemAllocator::allocate_via_malloc(size_t length, size_t alignment) {
     void* ptr = nullptr;
     // try to use a whole page instead of parts of one page
-    int res = posix_memalign(&ptr, PAGE_SIZE, length);
+    int res = posix_memalign(&ptr, alignment, length);
     if (res != 0) {
         PLOG(ERROR) << "fail to allocate mem via posix_memalign, res=" << res;
         return nullptr;
@@ -71,4 +78,14 @@ uint8_t* SystemAllocator::allocate_via_mmap(size_t length) {
     return ptr;
 }
 
+void SystemAllocator::advise_huge_page(uint8_t* ptr, size_t length) {
+    // Only the huge pages entirely in the range can be advised, mmap doesn't align the range to them.
+    auto begin = (reinterpret_cast<uintptr_t>(ptr) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    auto end = (reinterpret_cast<uintptr_t>(ptr) + length) & ~(HUGE_PAGE_SIZE - 1);
+    if (begin < end && madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) != 0) {
+        // e.g. the transparent huge pages are disabled in the kernel, fall back to the normal pages silently
+        VLOG(3) << "fail to advise huge pages, errno=" << errno;
+    }
+}
+
 } // namespace starrocks
@@ -34,9 +34,14 @@ public:
 
     static void free(uint8_t* ptr, size_t length);
 
+    // The size of a huge page. If config::enable_huge_page_mem_pool is true, the allocations of this size or
+    // larger are aligned to it and advised to be backed by transparent huge pages.
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
 private:
     static uint8_t* allocate_via_mmap(size_t length);
-    static uint8_t* allocate_via_malloc(size_t length);
+    static uint8_t* allocate_via_malloc(size_t length, size_t alignment);
+    static void advise_huge_page(uint8_t* ptr, size_t length);
 };
 
 } // namespace starrocks
@@ -26,6 +26,7 @@
 
 #include <sstream>
 
+#include "column/chunk.h"
 #include "common/logging.h"
 #include "exprs/expr.h"
 #include "gen_cpp/DorisExternalService_types.h"
@@ -36,6 +37,7 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "util/arrow/chunk.h"
 #include "util/arrow/row_batch.h"
 #include "util/date_func.h"
 #include "util/types.h"
@@ -53,6 +55,9 @@ Status MemoryScratchSink::prepare_exprs(RuntimeState* state) {
     RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _t_output_expr, &_output_expr_ctxs));
     // Prepare the exprs to run.
     RETURN_IF_ERROR(Expr::prepare(_output_expr_ctxs, state, _row_desc, _expr_mem_tracker.get()));
+    for (auto* ctx : _output_expr_ctxs) {
+        _output_types.push_back(ctx->root()->type());
+    }
     // generate the arrow schema
     RETURN_IF_ERROR(convert_to_arrow_schema(_row_desc, &_arrow_schema));
     return Status::OK();
@@ -83,6 +88,31 @@ Status MemoryScratchSink::send(RuntimeState* state, RowBatch* batch) {
     return Status::OK();
 }
 
+Status MemoryScratchSink::send_chunk(RuntimeState* state, vectorized::Chunk* chunk) {
+    if (chunk == nullptr || chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    if (_chunk_arrow_schema == nullptr) {
+        // keep the names of the row batch schema if the output columns are the slots of it
+        std::vector<std::string> names;
+        for (size_t i = 0; i < _output_types.size(); ++i) {
+            bool has_name = _arrow_schema->num_fields() == _output_types.size();
+            names.push_back(has_name ? _arrow_schema->field(i)->name() : "col_" + std::to_string(i));
+        }
+        RETURN_IF_ERROR(convert_to_arrow_schema(_output_types, names, &_chunk_arrow_schema));
+    }
+    vectorized::Columns columns;
+    columns.reserve(_output_expr_ctxs.size());
+    for (auto* ctx : _output_expr_ctxs) {
+        columns.emplace_back(ctx->evaluate(chunk));
+    }
+    std::shared_ptr<arrow::RecordBatch> result;
+    RETURN_IF_ERROR(
+            convert_to_arrow_batch(columns, _output_types, _chunk_arrow_schema, arrow::default_memory_pool(), &result));
+    _queue->blocking_put(result);
+    return Status::OK();
+}
+
 Status MemoryScratchSink::open(RuntimeState* state) {
     return Expr::open(_output_expr_ctxs, state);
 }
@@ -26,6 +26,7 @@
 #include "gen_cpp/DorisExternalService_types.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/result_queue_mgr.h"
+#include "runtime/types.h"
 #include "util/blocking_queue.hpp"
 
 namespace arrow {
@@ -68,6 +69,10 @@ public:
     // Blocks until all rows in batch are pushed to the queue
     virtual Status send(RuntimeState* state, RowBatch* batch);
 
+    // send the columns of 'chunk' evaluated by the output exprs to this backend queue mgr
+    // as an arrow record batch, blocks until the batch is pushed to the queue
+    Status send_chunk(RuntimeState* state, vectorized::Chunk* chunk) override;
+
     virtual Status close(RuntimeState* state, Status exec_status);
 
     virtual RuntimeProfile* profile() { return _profile; }
@@ -79,6 +84,8 @@ private:
     // Owned by the RuntimeState.
     const RowDescriptor& _row_desc;
     std::shared_ptr<arrow::Schema> _arrow_schema;
+    // the schema of the record batches converted from the chunks, created on the first chunk
+    std::shared_ptr<arrow::Schema> _chunk_arrow_schema;
 
     BlockQueueSharedPtr _queue;
 
@@ -87,5 +94,6 @@ private:
     // Owned by the RuntimeState.
     const std::vector<TExpr>& _t_output_expr;
     std::vector<ExprContext*> _output_expr_ctxs;
+    std::vector<TypeDescriptor> _output_types;
 };
 } // namespace starrocks
@@ -26,14 +26,17 @@
 #include "column/binary_column.h"
 #include "column/const_column.h"
 #include "column/nullable_column.h"
+#include "column/type_traits.h"
 #include "exprs/expr.h"
 #include "gen_cpp/InternalService_types.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/primitive_type.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
+#include "runtime/vectorized/time_types.h"
 #include "util/date_func.h"
 #include "util/mysql_row_buffer.h"
+#include "util/raw_container.h"
 #include "util/types.h"
 
 namespace starrocks {
@@ -294,6 +297,80 @@ Status MysqlResultWriter::close() {
     return Status::OK();
 }
 
+// Format the cells of |data_column| into |buf| one after another, and append the end offset of each cell to |ends|.
+// The loop is specialized for the type of the column, so the cells are formatted without a virtual call per cell.
+template <PrimitiveType PT>
+static void put_mysql_cells(const vectorized::Column& data_column, const uint8_t* nulls, MysqlRowBuffer* buf,
+                            std::vector<uint32_t>* ends) {
+    using ColumnType = vectorized::RunTimeColumnType<PT>;
+    const auto& column = down_cast<const ColumnType&>(data_column);
+    const size_t num_rows = column.size();
+    [[maybe_unused]] char str[32];
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (nulls != nullptr && nulls[i]) {
+            buf->push_null();
+        } else if constexpr (pt_is_binary<PT>) {
+            buf->push_string(column.get_slice(i));
+        } else if constexpr (PT == TYPE_DATE) {
+            int year, month, day;
+            vectorized::date::to_date_with_cache(column.get_data()[i].julian(), &year, &month, &day);
+            vectorized::date::to_string(year, month, day, str);
+            buf->push_string(str, 10);
+        } else if constexpr (PT == TYPE_DATETIME) {
+            int len = column.get_data()[i].to_string(str, sizeof(str));
+            buf->push_string(str, len);
+        } else if constexpr (PT == TYPE_DECIMALV2) {
+            column.ColumnType::put_mysql_row_buffer(buf, i);
+        } else {
+            buf->push_number(column.get_data()[i]);
+        }
+        ends->push_back(buf->length());
+    }
+}
+
+static void put_mysql_cells(PrimitiveType type, const vectorized::Column& column, MysqlRowBuffer* buf,
+                            std::vector<uint32_t>* ends) {
+    const vectorized::Column* data_column = &column;
+    const uint8_t* nulls = nullptr;
+    if (column.is_nullable()) {
+        const auto& nullable_column = down_cast<const vectorized::NullableColumn&>(column);
+        data_column = nullable_column.data_column().get();
+        if (nullable_column.has_null()) {
+            nulls = nullable_column.null_column()->get_data().data();
+        }
+    }
+    if (!column.is_constant()) {
+        switch (type) {
+#define M(PT)                                                \
+    case PT:                                                 \
+        put_mysql_cells<PT>(*data_column, nulls, buf, ends); \
+        return;
+            M(TYPE_BOOLEAN)
+            M(TYPE_TINYINT)
+            M(TYPE_SMALLINT)
+            M(TYPE_INT)
+            M(TYPE_BIGINT)
+            M(TYPE_LARGEINT)
+            M(TYPE_FLOAT)
+            M(TYPE_DOUBLE)
+            M(TYPE_CHAR)
+            M(TYPE_VARCHAR)
+            M(TYPE_DATE)
+            M(TYPE_DATETIME)
+            M(TYPE_DECIMALV2)
+#undef M
+        default:
+            break;
+        }
+    }
+    // the constant columns and the other types
+    const size_t num_rows = column.size();
+    for (size_t i = 0; i < num_rows; ++i) {
+        column.put_mysql_row_buffer(buf, i);
+        ends->push_back(buf->length());
+    }
+}
+
 StatusOr<TFetchDataResultPtr> MysqlResultWriter::process_chunk(vectorized::Chunk* chunk) {
     SCOPED_TIMER(_append_row_batch_timer);
     int num_rows = chunk->num_rows();
@@ -345,18 +422,37 @@ StatusOr<TFetchDataResultPtr> MysqlResultWriter::process_chunk(vectorized::Chunk
         result_columns.emplace_back(std::move(column));
     }
 
-    // Step 2: convert chunk to mysql row format row by row
+    // Step 2: convert chunk to mysql row format column by column, and then assemble the cells of each row
     {
-        _row_buffer->reserve(128);
         SCOPED_TIMER(_convert_tuple_timer);
+        _column_buffers.resize(num_columns);
+        _column_ends.resize(num_columns);
+        for (int j = 0; j < num_columns; ++j) {
+            PrimitiveType type = _output_expr_ctxs[j]->root()->type().type;
+            if (type == TYPE_TIME) {
+                // converted to strings above
+                type = TYPE_VARCHAR;
+            }
+            _column_buffers[j].reset();
+            _column_ends[j].clear();
+            _column_ends[j].reserve(num_rows);
+            put_mysql_cells(type, *result_columns[j], &_column_buffers[j], &_column_ends[j]);
+            DCHECK_EQ(num_rows, _column_ends[j].size());
+        }
         for (int i = 0; i < num_rows; ++i) {
-            DCHECK_EQ(0, _row_buffer->length());
-            for (size_t j = 0; j < result_columns.size(); ++j) {
-                result_columns[j]->put_mysql_row_buffer(_row_buffer, i);
+            size_t len = 0;
+            for (int j = 0; j < num_columns; ++j) {
+                len += _column_ends[j][i] - (i == 0 ? 0 : _column_ends[j][i - 1]);
+            }
+            std::string& row = result_rows[i];
+            raw::make_room(&row, len);
+            char* pos = row.data();
+            for (int j = 0; j < num_columns; ++j) {
+                uint32_t start = i == 0 ? 0 : _column_ends[j][i - 1];
+                uint32_t size = _column_ends[j][i] - start;
+                memcpy(pos, _column_buffers[j].data().data() + start, size);
+                pos += size;
             }
-            size_t len = _row_buffer->length();
-            _row_buffer->move_content(&result_rows[i]);
-            _row_buffer->reserve(len * 1.1);
         }
     }
     return result;
@@ -24,13 +24,13 @@
 #include "common/statusor.h"
 #include "runtime/result_writer.h"
 #include "runtime/runtime_state.h"
+#include "util/mysql_row_buffer.h"
 
 namespace starrocks {
 
 class TupleRow;
 class RowBatch;
 class ExprContext;
-class MysqlRowBuffer;
 class BufferControlBlock;
 class RuntimeProfile;
 using TFetchDataResultPtr = std::unique_ptr<TFetchDataResult>;
@@ -70,6 +70,9 @@ private:
     BufferControlBlock* _sinker;
     const std::vector<ExprContext*>& _output_expr_ctxs;
     MysqlRowBuffer* _row_buffer;
+    // the cells of each result column formatted by process_chunk, and the end offsets of them
+    std::vector<MysqlRowBuffer> _column_buffers;
+    std::vector<std::vector<uint32_t>> _column_ends;
 
     RuntimeProfile* _parent_profile; // parent profile from result sink. not owned
     // total time cost on append batch opertion
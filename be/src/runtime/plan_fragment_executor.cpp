@@ -40,6 +40,7 @@
 #include "runtime/runtime_filter_worker.h"
 #include "util/parse_util.h"
 #include "util/pretty_printer.h"
+#include "util/query_trace.h"
 #include "util/uid_util.h"
 
 namespace starrocks {
@@ -61,9 +62,16 @@ PlanFragmentExecutor::~PlanFragmentExecutor() {
 }
 
 Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request) {
+    DCHECK(request.__isset.fragment);
+    return prepare(request, request.fragment, nullptr);
+}
+
+Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request, const TPlanFragment& fragment,
+                                     std::shared_ptr<DescriptorTbl> shared_desc_tbl) {
     const TPlanFragmentExecParams& params = request.params;
     _is_vectorized = params.use_vectorized;
     _query_id = params.query_id;
+    SCOPED_QUERY_TRACE(_query_id, "fragment", "prepare", params.fragment_instance_id.lo);
 
     LOG(INFO) << "Prepare(): query_id=" << print_id(_query_id)
               << " fragment_instance_id=" << print_id(params.fragment_instance_id)
@@ -127,13 +135,17 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request) {
 
     // set up desc tbl
     DescriptorTbl* desc_tbl = NULL;
-    DCHECK(request.__isset.desc_tbl);
-    RETURN_IF_ERROR(DescriptorTbl::create(obj_pool(), request.desc_tbl, &desc_tbl));
+    if (shared_desc_tbl != nullptr) {
+        desc_tbl = shared_desc_tbl.get();
+        _shared_desc_tbl = std::move(shared_desc_tbl);
+    } else {
+        DCHECK(request.__isset.desc_tbl);
+        RETURN_IF_ERROR(DescriptorTbl::create(obj_pool(), request.desc_tbl, &desc_tbl));
+    }
     _runtime_state->set_desc_tbl(desc_tbl);
 
     // set up plan
-    DCHECK(request.__isset.fragment);
-    RETURN_IF_ERROR(ExecNode::create_tree(_runtime_state.get(), obj_pool(), request.fragment.plan, *desc_tbl, &_plan));
+    RETURN_IF_ERROR(ExecNode::create_tree(_runtime_state.get(), obj_pool(), fragment.plan, *desc_tbl, &_plan));
     _runtime_state->set_fragment_root_id(_plan->id());
 
     if (request.params.__isset.debug_node_id) {
@@ -183,9 +195,9 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request) {
     _runtime_state->set_num_per_fragment_instances(params.num_senders);
 
     // set up sink, if required
-    if (request.fragment.__isset.output_sink) {
-        RETURN_IF_ERROR(DataSink::create_data_sink(obj_pool(), request.fragment.output_sink,
-                                                   request.fragment.output_exprs, params, row_desc(), &_sink));
+    if (fragment.__isset.output_sink) {
+        RETURN_IF_ERROR(DataSink::create_data_sink(obj_pool(), fragment.output_sink, fragment.output_exprs, params,
+                                                   row_desc(), &_sink));
         RETURN_IF_ERROR(_sink->prepare(runtime_state()));
 
         RuntimeProfile* sink_profile = _sink->profile();
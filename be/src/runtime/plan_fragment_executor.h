@@ -40,6 +40,7 @@ class ExecNode;
 class RowDescriptor;
 class RowBatch;
 class DataSink;
+class DescriptorTbl;
 class DataStreamMgr;
 class RuntimeProfile;
 class RuntimeState;
@@ -95,6 +96,11 @@ public:
     // The query will be aborted (MEM_LIMIT_EXCEEDED) if it goes over that limit.
     Status prepare(const TExecPlanFragmentParams& request);
 
+    // Same as above for an instance launched in a batch, whose plan |fragment| and parsed descriptor table
+    // |desc_tbl| are shared by the instances of the batch. The fragment and desc_tbl of |request| are unused.
+    Status prepare(const TExecPlanFragmentParams& request, const TPlanFragment& fragment,
+                   std::shared_ptr<DescriptorTbl> desc_tbl);
+
     // Start execution. Call this prior to get_next().
     // If this fragment has a sink, open() will send all rows produced
     // by the fragment to that sink. Therefore, open() may block until
@@ -178,6 +184,10 @@ private:
     // 2. _status_lock
     std::mutex _status_lock;
 
+    // the descriptor table shared by the instances launched in a batch, which must be destructed after
+    // the plan, so it's declared before `_runtime_state'.
+    std::shared_ptr<DescriptorTbl> _shared_desc_tbl;
+
     // note that RuntimeState should be constructed before and destructed after `_sink' and `_row_batch',
     // therefore we declare it before `_sink' and `_row_batch'
     std::unique_ptr<RuntimeState> _runtime_state;
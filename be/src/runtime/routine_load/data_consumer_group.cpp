@@ -96,7 +96,13 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     int64_t received_rows = 0;
     int64_t left_bytes = ctx->max_batch_size;
 
-    std::shared_ptr<KafkaConsumerPipe> kafka_pipe = std::static_pointer_cast<KafkaConsumerPipe>(ctx->body_sink);
+    auto pipe_group = std::static_pointer_cast<KafkaConsumerPipeGroup>(ctx->body_sink);
+    // the partitions are spread over the pipes, the messages of a partition are appended to the same pipe
+    std::map<int32_t, KafkaConsumerPipe*> partition_pipes;
+    size_t pipe_idx = 0;
+    for (auto& kv : ctx->kafka_info->begin_offset) {
+        partition_pipes[kv.first] = pipe_group->pipe(pipe_idx++ % pipe_group->size()).get();
+    }
 
     LOG(INFO) << "start consumer group: " << _grp_id << ". max time(ms): " << left_time
               << ", batch size: " << left_bytes << ". " << ctx->brief();
@@ -154,11 +160,11 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
             if (left_bytes == ctx->max_batch_size) {
                 // nothing to be consumed, we have to cancel it, because
                 // we do not allow finishing stream load pipe without data
-                kafka_pipe->cancel();
+                pipe_group->cancel();
                 return Status::Cancelled("Cancelled");
             } else {
                 DCHECK(left_bytes < ctx->max_batch_size);
-                kafka_pipe->finish();
+                pipe_group->finish();
                 ctx->kafka_info->cmt_offset = std::move(cmt_offset);
                 ctx->receive_bytes = ctx->max_batch_size - left_bytes;
                 return Status::OK();
@@ -171,8 +177,10 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
             VLOG(3) << "get kafka message"
                     << ", partition: " << msg->partition() << ", offset: " << msg->offset() << ", len: " << msg->len();
 
-            (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()), static_cast<size_t>(msg->len()),
-                                             row_delimiter);
+            auto it = partition_pipes.find(msg->partition());
+            KafkaConsumerPipe* pipe = it != partition_pipes.end() ? it->second : pipe_group->pipe(0).get();
+            st = (pipe->*append_data)(static_cast<const char*>(msg->payload()), static_cast<size_t>(msg->len()),
+                                      row_delimiter);
 
             if (st.ok()) {
                 received_rows++;
@@ -24,6 +24,7 @@
 #include <stdint.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -55,4 +56,39 @@ public:
     Status append_json(const char* data, size_t size, char row_delimiter) { return append_and_flush(data, size); }
 };
 
+// The pipes of a routine load task, each one of which is read by a scanner of its own, so the messages are
+// parsed in parallel. The messages of a partition are always appended to the same pipe to keep their order.
+class KafkaConsumerPipeGroup : public MessageBodySink {
+public:
+    explicit KafkaConsumerPipeGroup(std::vector<std::shared_ptr<KafkaConsumerPipe>> pipes)
+            : _pipes(std::move(pipes)) {}
+
+    ~KafkaConsumerPipeGroup() override = default;
+
+    // the messages are appended to the pipes directly
+    Status append(const char* data, size_t size) override {
+        return Status::NotSupported("append to the pipe of the partition instead");
+    }
+
+    Status finish() override {
+        for (auto& pipe : _pipes) {
+            RETURN_IF_ERROR(pipe->finish());
+        }
+        return Status::OK();
+    }
+
+    void cancel() override {
+        for (auto& pipe : _pipes) {
+            pipe->cancel();
+        }
+    }
+
+    size_t size() const { return _pipes.size(); }
+
+    const std::shared_ptr<KafkaConsumerPipe>& pipe(size_t i) const { return _pipes[i]; }
+
+private:
+    std::vector<std::shared_ptr<KafkaConsumerPipe>> _pipes;
+};
+
 } // end namespace starrocks
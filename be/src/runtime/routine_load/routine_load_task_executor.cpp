@@ -21,9 +21,12 @@
 
 #include "runtime/routine_load/routine_load_task_executor.h"
 
+#include <algorithm>
 #include <functional>
 #include <thread>
+#include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gen_cpp/BackendService_types.h"
 #include "gen_cpp/FrontendService_types.h"
@@ -38,6 +41,26 @@
 
 namespace starrocks {
 
+// Add a copy of the stream scan range of the task for each one of |pipe_ids|, so each one of the pipes is read by
+// a scanner of its own. Return false if the plan doesn't scan exactly one stream.
+static bool add_pipe_scan_ranges(StreamLoadContext* ctx, const std::vector<UniqueId>& pipe_ids) {
+    auto& per_node_scan_ranges = ctx->put_result.params.params.per_node_scan_ranges;
+    if (per_node_scan_ranges.size() != 1 || per_node_scan_ranges.begin()->second.size() != 1) {
+        return false;
+    }
+    auto& scan_ranges = per_node_scan_ranges.begin()->second;
+    const auto& ranges = scan_ranges[0].scan_range.broker_scan_range.ranges;
+    if (ranges.size() != 1 || ranges[0].file_type != TFileType::FILE_STREAM) {
+        return false;
+    }
+    TScanRangeParams origin = scan_ranges[0];
+    for (const auto& id : pipe_ids) {
+        auto& scan_range = scan_ranges.emplace_back(origin);
+        scan_range.scan_range.broker_scan_range.ranges[0].__set_load_id(id.to_thrift());
+    }
+    return true;
+}
+
 Status RoutineLoadTaskExecutor::get_kafka_partition_meta(const PKafkaMetaProxyRequest& request,
                                                          std::vector<int32_t>* partition_ids) {
     DCHECK(request.has_kafka_info());
@@ -226,11 +249,22 @@ void RoutineLoadTaskExecutor::exec_task(StreamLoadContext* ctx, DataConsumerPool
     std::shared_ptr<DataConsumerGroup> consumer_grp;
     HANDLE_ERROR(consumer_pool->get_consumer_grp(ctx, &consumer_grp), "failed to get consumers");
 
-    // create and set pipe
-    std::shared_ptr<StreamLoadPipe> pipe;
+    // create and set pipes, the first one of which is registered by the id of the task
+    std::vector<std::shared_ptr<KafkaConsumerPipe>> pipes;
+    std::vector<UniqueId> pipe_ids{ctx->id};
     switch (ctx->load_src_type) {
     case TLoadSourceType::KAFKA: {
-        pipe = std::make_shared<KafkaConsumerPipe>();
+        int num_pipes = std::min<int>(config::routine_load_kafka_pipe_num, ctx->kafka_info->begin_offset.size());
+        std::vector<UniqueId> extra_pipe_ids;
+        for (int i = 1; i < num_pipes; ++i) {
+            extra_pipe_ids.emplace_back(UniqueId::gen_uid());
+        }
+        if (add_pipe_scan_ranges(ctx, extra_pipe_ids)) {
+            pipe_ids.insert(pipe_ids.end(), extra_pipe_ids.begin(), extra_pipe_ids.end());
+        }
+        for (size_t i = 0; i < pipe_ids.size(); ++i) {
+            pipes.emplace_back(std::make_shared<KafkaConsumerPipe>());
+        }
         Status st = std::static_pointer_cast<KafkaDataConsumerGroup>(consumer_grp)->assign_topic_partitions(ctx);
         if (!st.ok()) {
             err_handler(ctx, st, st.get_error_msg());
@@ -247,10 +281,12 @@ void RoutineLoadTaskExecutor::exec_task(StreamLoadContext* ctx, DataConsumerPool
         return;
     }
     }
-    ctx->body_sink = pipe;
+    ctx->body_sink = std::make_shared<KafkaConsumerPipeGroup>(pipes);
 
-    // must put pipe before executing plan fragment
-    HANDLE_ERROR(_exec_env->load_stream_mgr()->put(ctx->id, pipe), "failed to add pipe");
+    // must put pipes before executing plan fragment
+    for (size_t i = 0; i < pipes.size(); ++i) {
+        HANDLE_ERROR(_exec_env->load_stream_mgr()->put(pipe_ids[i], pipes[i]), "failed to add pipe");
+    }
 
 #ifndef BE_TEST
     // execute plan fragment, async
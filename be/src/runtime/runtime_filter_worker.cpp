@@ -9,6 +9,7 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/runtime_state.h"
 #include "service/backend_options.h"
+#include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
 #include "util/defer_op.h"
 #include "util/ref_count_closure.h"
@@ -23,6 +24,59 @@ public:
 
 static const int default_send_rpc_runtime_filter_timeout_ms = 1000;
 
+// The bit arrays of the bloom filters built from a few keys are sparse, so the filters are compressed
+// by LZ4 if it saves enough bytes, as the chunks sent by DataStreamSender.
+static void serialize_runtime_filter(const vectorized::JoinRuntimeFilter* rf, PTransmitRuntimeFilterParams* params) {
+    std::string* rf_data = params->mutable_data();
+    size_t max_size = vectorized::RuntimeFilterHelper::max_runtime_filter_serialized_size(rf);
+    rf_data->resize(max_size);
+    size_t actual_size =
+            vectorized::RuntimeFilterHelper::serialize_runtime_filter(rf, reinterpret_cast<uint8_t*>(rf_data->data()));
+    rf_data->resize(actual_size);
+
+    const BlockCompressionCodec* codec = nullptr;
+    if (!get_block_compression_codec(CompressionTypePB::LZ4, &codec).ok() || codec == nullptr ||
+        codec->exceed_max_input_size(actual_size)) {
+        return;
+    }
+    std::string compressed_data;
+    compressed_data.resize(codec->max_compressed_len(actual_size));
+    Slice compressed_slice(compressed_data.data(), compressed_data.size());
+    if (!codec->compress(Slice(*rf_data), &compressed_slice).ok()) {
+        return;
+    }
+    double compress_ratio = static_cast<double>(actual_size) / compressed_slice.size;
+    if (compress_ratio > config::rpc_compress_ratio_threshold) {
+        compressed_data.resize(compressed_slice.size);
+        rf_data->swap(compressed_data);
+        params->set_compress_type(CompressionTypePB::LZ4);
+        params->set_uncompressed_size(actual_size);
+    }
+}
+
+// Return nullptr if the filter couldn't be deserialized.
+static vectorized::JoinRuntimeFilter* deserialize_runtime_filter(ObjectPool* pool,
+                                                                 const PTransmitRuntimeFilterParams& params) {
+    const std::string* rf_data = &params.data();
+    std::string uncompressed_data;
+    if (params.has_compress_type() && params.compress_type() != CompressionTypePB::NO_COMPRESSION) {
+        const BlockCompressionCodec* codec = nullptr;
+        if (!get_block_compression_codec(params.compress_type(), &codec).ok() || codec == nullptr) {
+            return nullptr;
+        }
+        uncompressed_data.resize(params.uncompressed_size());
+        Slice output(uncompressed_data.data(), uncompressed_data.size());
+        if (!codec->decompress(Slice(params.data()), &output).ok() || output.size != uncompressed_data.size()) {
+            return nullptr;
+        }
+        rf_data = &uncompressed_data;
+    }
+    vectorized::JoinRuntimeFilter* rf = nullptr;
+    vectorized::RuntimeFilterHelper::deserialize_runtime_filter(
+            pool, &rf, reinterpret_cast<const uint8_t*>(rf_data->data()), rf_data->size());
+    return rf;
+}
+
 static void send_rpc_runtime_filter(PBackendService_Stub* stub, RuntimeFilterRpcClosure* rpc_closure, int timeout_ms,
                                     const PTransmitRuntimeFilterParams& request) {
     if (rpc_closure->seq != 0) {
@@ -87,12 +141,7 @@ void RuntimeFilterPort::publish_runtime_filters(std::list<vectorized::RuntimeFil
                   << ", filter_size = " << filter->size() << ", query_id = " << params.query_id()
                   << ", finst_id = " << params.finst_id() << ", be_number = " << params.build_be_number();
 
-        std::string* rf_data = params.mutable_data();
-        size_t max_size = vectorized::RuntimeFilterHelper::max_runtime_filter_serialized_size(filter);
-        rf_data->resize(max_size);
-        size_t actual_size = vectorized::RuntimeFilterHelper::serialize_runtime_filter(
-                filter, reinterpret_cast<uint8_t*>(rf_data->data()));
-        rf_data->resize(actual_size);
+        serialize_runtime_filter(filter, &params);
 
         state->exec_env()->runtime_filter_worker()->send_part_runtime_filter(std::move(params), rf_desc->merge_nodes(),
                                                                              timeout_ms);
@@ -175,9 +224,7 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
 
     // to merge runtime filters
     ObjectPool* pool = &(status->pool);
-    vectorized::JoinRuntimeFilter* rf = nullptr;
-    vectorized::RuntimeFilterHelper::deserialize_runtime_filter(
-            pool, &rf, reinterpret_cast<const uint8_t*>(params.data().data()), params.data().size());
+    vectorized::JoinRuntimeFilter* rf = deserialize_runtime_filter(pool, params);
     if (rf == nullptr) {
         // something wrong with deserialization.
         return;
@@ -227,13 +274,7 @@ void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeF
     query_id->set_hi(_query_id.hi);
     query_id->set_lo(_query_id.lo);
 
-    std::string* send_data = request.mutable_data();
-    size_t max_size = vectorized::RuntimeFilterHelper::max_runtime_filter_serialized_size(out);
-    send_data->resize(max_size);
-
-    size_t actual_size = vectorized::RuntimeFilterHelper::serialize_runtime_filter(
-            out, reinterpret_cast<uint8_t*>(send_data->data()));
-    send_data->resize(actual_size);
+    serialize_runtime_filter(out, &request);
     int timeout_ms = default_send_rpc_runtime_filter_timeout_ms;
     if (_query_options.__isset.runtime_filter_send_timeout_ms) {
         timeout_ms = _query_options.runtime_filter_send_timeout_ms;
@@ -407,10 +448,7 @@ void RuntimeFilterWorker::receive_runtime_filter(const PTransmitRuntimeFilterPar
 void RuntimeFilterWorker::_receive_total_runtime_filter(PTransmitRuntimeFilterParams& request,
                                                         RuntimeFilterRpcClosure* rpc_closure) {
     // deserialize once, and all fragment instance shared that runtime filter.
-    vectorized::JoinRuntimeFilter* rf = nullptr;
-    const std::string& data = request.data();
-    vectorized::RuntimeFilterHelper::deserialize_runtime_filter(
-            nullptr, &rf, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    vectorized::JoinRuntimeFilter* rf = deserialize_runtime_filter(nullptr, request);
     if (rf == nullptr) {
         return;
     }
@@ -23,8 +23,15 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
+#include <mutex>
+#include <set>
+#include <thread>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
 #include "env/env_broker.h"
@@ -40,6 +47,7 @@
 #include "storage/tablet.h"
 #include "util/file_utils.h"
 #include "util/thrift_rpc_helper.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -68,6 +76,44 @@ SnapshotLoader::SnapshotLoader(ExecEnv* env, int64_t job_id, int64_t task_id)
 
 SnapshotLoader::~SnapshotLoader() {}
 
+// Sleep to keep the bytes transferred by all the snapshot loaders of the BE under
+// config::snapshot_loader_max_bytes_per_sec, each transfer of |bytes| takes its turn after the previous ones.
+static void throttle_transfer(size_t bytes) {
+    int64_t max_bytes_per_sec = config::snapshot_loader_max_bytes_per_sec;
+    if (max_bytes_per_sec <= 0) {
+        return;
+    }
+    static std::mutex s_lock;
+    static int64_t s_next_ns = 0;
+    int64_t now = MonotonicNanos();
+    int64_t start_ns;
+    {
+        std::lock_guard<std::mutex> l(s_lock);
+        start_ns = std::max(s_next_ns, now);
+        s_next_ns = start_ns + static_cast<int64_t>(static_cast<double>(bytes) * 1e9 / max_bytes_per_sec);
+    }
+    if (start_ns > now) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(start_ns - now));
+    }
+}
+
+// Same as FileUtils::copy, throttled by config::snapshot_loader_max_bytes_per_sec.
+static StatusOr<int64_t> copy_file(SequentialFile* src, WritableFile* dest, size_t buff_size) {
+    std::unique_ptr<char[]> buf(new char[buff_size]);
+    int64_t ncopy = 0;
+    while (true) {
+        Slice read_buf(buf.get(), buff_size);
+        RETURN_IF_ERROR(src->read(&read_buf));
+        if (read_buf.size == 0) {
+            break;
+        }
+        throttle_transfer(read_buf.size);
+        ncopy += read_buf.size;
+        RETURN_IF_ERROR(dest->append(read_buf));
+    }
+    return ncopy;
+}
+
 Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_dest_path,
                               const TNetworkAddress& broker_addr, const std::map<std::string, std::string>& broker_prop,
                               std::map<int64_t, std::vector<std::string>>* tablet_files) {
@@ -92,101 +138,123 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
         return Status::InternalError(ss.str());
     }
 
-    // 3. for each src path, upload it to remote storage
-    // we report to frontend for every 10 files, and we will cancel the job if
-    // the job has already been cancelled in frontend.
-    int report_counter = 0;
-    int total_num = src_to_dest_path.size();
-    int finished_num = 0;
-    for (auto iter = src_to_dest_path.begin(); iter != src_to_dest_path.end(); iter++) {
+    // 3. for each src path, list the local files to upload, the files of all the tablets are checked and
+    // uploaded concurrently.
+    struct TabletUpload {
+        int64_t tablet_id = 0;
+        std::map<std::string, FileStat> remote_files;
+        std::vector<std::string> local_files;
+        std::vector<std::string> local_files_with_checksum;
+    };
+    std::vector<TabletUpload> uploads(src_to_dest_path.size());
+    std::vector<std::function<Status()>> transfers;
+    std::vector<int> transfer_tablets;
+    int tablet_index = 0;
+    for (auto iter = src_to_dest_path.begin(); iter != src_to_dest_path.end(); iter++, tablet_index++) {
         const std::string& src_path = iter->first;
         const std::string& dest_path = iter->second;
+        TabletUpload& upload = uploads[tablet_index];
 
-        int64_t tablet_id = 0;
         int32_t schema_hash = 0;
-        RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(src_path, &tablet_id, &schema_hash));
+        RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(src_path, &upload.tablet_id, &schema_hash));
 
-        // 2.1 get existing files from remote path
-        std::map<std::string, FileStat> remote_files;
-        RETURN_IF_ERROR(_get_existing_files_from_remote(client, dest_path, broker_prop, &remote_files));
+        // 3.1 get existing files from remote path
+        RETURN_IF_ERROR(_get_existing_files_from_remote(client, dest_path, broker_prop, &upload.remote_files));
 
-        for (auto& tmp : remote_files) {
+        for (auto& tmp : upload.remote_files) {
             VLOG(2) << "get remote file: " << tmp.first << ", checksum: " << tmp.second.md5;
         }
 
-        // 2.2 list local files
-        std::vector<std::string> local_files;
-        std::vector<std::string> local_files_with_checksum;
-        RETURN_IF_ERROR(_get_existing_files_from_local(src_path, &local_files));
-
-        // 2.3 iterate local files
-        for (auto it = local_files.begin(); it != local_files.end(); it++) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::UPLOAD));
-
-            const std::string& local_file = *it;
-            // calc md5sum of localfile
-            std::string md5sum;
-            status = FileUtils::md5sum(src_path + "/" + local_file, &md5sum);
-            if (!status.ok()) {
-                std::stringstream ss;
-                ss << "failed to get md5sum of file: " << local_file << ": " << status.get_error_msg();
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-            VLOG(2) << "get file checksum: " << local_file << ": " << md5sum;
-            local_files_with_checksum.push_back(local_file + "." + md5sum);
-
-            // check if this local file need upload
-            bool need_upload = false;
-            auto find = remote_files.find(local_file);
-            if (find != remote_files.end()) {
-                if (md5sum != find->second.md5) {
-                    // remote storage file exist, but with different checksum
-                    LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first << ", local: " << md5sum;
-                    // TODO(cmy): save these files and delete them later
-                    need_upload = true;
-                }
-            } else {
-                need_upload = true;
-            }
+        // 3.2 list local files
+        RETURN_IF_ERROR(_get_existing_files_from_local(src_path, &upload.local_files));
+        upload.local_files_with_checksum.resize(upload.local_files.size());
+        for (size_t i = 0; i < upload.local_files.size(); i++) {
+            transfers.emplace_back([&, &src_path = src_path, &dest_path = dest_path, &upload = upload, i]() {
+                return _upload_file(broker_addr, broker_prop, src_path, dest_path, upload.local_files[i],
+                                    upload.remote_files, &upload.local_files_with_checksum[i]);
+            });
+            transfer_tablets.push_back(tablet_index);
+        }
+    }
 
-            if (!need_upload) {
-                VLOG(2) << "file exist in remote path, no need to upload: " << local_file;
-                continue;
-            }
+    // 4. upload the files, we report to frontend for every 10 files, and we will cancel the job if
+    // the job has already been cancelled in frontend.
+    RETURN_IF_ERROR(_run_transfers(transfers, transfer_tablets, uploads.size(), TTaskType::type::UPLOAD));
+    for (auto& upload : uploads) {
+        tablet_files->emplace(upload.tablet_id, std::move(upload.local_files_with_checksum));
+    }
+
+    LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
+    return status;
+}
+
+Status SnapshotLoader::_upload_file(const TNetworkAddress& broker_addr,
+                                    const std::map<std::string, std::string>& broker_prop, const std::string& src_path,
+                                    const std::string& dest_path, const std::string& local_file,
+                                    const std::map<std::string, FileStat>& remote_files,
+                                    std::string* local_file_with_checksum) {
+    // calc md5sum of localfile
+    std::string md5sum;
+    Status status = FileUtils::md5sum(src_path + "/" + local_file, &md5sum);
+    if (!status.ok()) {
+        std::stringstream ss;
+        ss << "failed to get md5sum of file: " << local_file << ": " << status.get_error_msg();
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    VLOG(2) << "get file checksum: " << local_file << ": " << md5sum;
+    *local_file_with_checksum = local_file + "." + md5sum;
+
+    // check if this local file need upload
+    bool need_upload = false;
+    auto find = remote_files.find(local_file);
+    if (find != remote_files.end()) {
+        if (md5sum != find->second.md5) {
+            // remote storage file exist, but with different checksum
+            LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first << ", local: " << md5sum;
+            // TODO(cmy): save these files and delete them later
+            need_upload = true;
+        }
+    } else {
+        need_upload = true;
+    }
+
+    if (!need_upload) {
+        VLOG(2) << "file exist in remote path, no need to upload: " << local_file;
+        return Status::OK();
+    }
 
-            // upload
-            // open broker writer. file name end with ".part"
-            // it will be renamed to ".md5sum" after upload finished
-            auto full_remote_file = dest_path + "/" + local_file;
-            auto tmp_broker_file_name = full_remote_file + ".part";
-            auto local_file_path = src_path + "/" + local_file;
+    // upload
+    // open broker writer. file name end with ".part"
+    // it will be renamed to ".md5sum" after upload finished
+    auto full_remote_file = dest_path + "/" + local_file;
+    auto tmp_broker_file_name = full_remote_file + ".part";
+    auto local_file_path = src_path + "/" + local_file;
 
-            EnvBroker env_broker(broker_addr, broker_prop);
-            std::unique_ptr<WritableFile> broker_file;
-            RETURN_IF_ERROR(env_broker.new_writable_file(tmp_broker_file_name, &broker_file));
+    EnvBroker env_broker(broker_addr, broker_prop);
+    std::unique_ptr<WritableFile> broker_file;
+    RETURN_IF_ERROR(env_broker.new_writable_file(tmp_broker_file_name, &broker_file));
 
-            std::unique_ptr<SequentialFile> input_file;
-            RETURN_IF_ERROR(Env::Default()->new_sequential_file(local_file_path, &input_file));
+    std::unique_ptr<SequentialFile> input_file;
+    RETURN_IF_ERROR(Env::Default()->new_sequential_file(local_file_path, &input_file));
 
-            auto res = FileUtils::copy(input_file.get(), broker_file.get(), 1024 * 1024);
-            if (!res.ok()) {
-                return res.status();
-            }
-            LOG(INFO) << "finished to write file via broker. file: " << local_file_path << ", length: " << *res;
-            RETURN_IF_ERROR(broker_file->close());
-            // rename file to end with ".md5sum"
-            RETURN_IF_ERROR(_rename_remote_file(client, full_remote_file + ".part", full_remote_file + "." + md5sum,
-                                                broker_prop));
-        } // end for each tablet's local files
-
-        tablet_files->emplace(tablet_id, local_files_with_checksum);
-        finished_num++;
-        LOG(INFO) << "finished to write tablet to remote. local path: " << src_path << ", remote path: " << dest_path;
-    } // end for each tablet path
+    auto res = copy_file(input_file.get(), broker_file.get(), 1024 * 1024);
+    if (!res.ok()) {
+        return res.status();
+    }
+    LOG(INFO) << "finished to write file via broker. file: " << local_file_path << ", length: " << *res;
+    RETURN_IF_ERROR(broker_file->close());
 
-    LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
-    return status;
+    // rename file to end with ".md5sum", by a broker client of this thread.
+    BrokerServiceConnection client(client_cache(_env), broker_addr, 10000, &status);
+    if (!status.ok()) {
+        std::stringstream ss;
+        ss << "failed to get broker client. "
+           << "broker addr: " << broker_addr << ". msg: " << status.get_error_msg();
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    return _rename_remote_file(client, full_remote_file + ".part", full_remote_file + "." + md5sum, broker_prop);
 }
 
 /*
@@ -219,156 +287,91 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
         return Status::InternalError(ss.str());
     }
 
-    std::vector<TNetworkAddress> broker_addrs;
-    broker_addrs.push_back(broker_addr);
-    // 3. for each src path, download it to local storage
-    int report_counter = 0;
-    int total_num = src_to_dest_path.size();
-    int finished_num = 0;
-    for (auto iter = src_to_dest_path.begin(); iter != src_to_dest_path.end(); iter++) {
+    // 3. for each src path, list the remote files to download, the files of all the tablets are checked and
+    // downloaded concurrently.
+    struct TabletDownload {
+        int64_t local_tablet_id = 0;
+        int64_t remote_tablet_id = 0;
+        DataDir* data_dir = nullptr;
+        std::map<std::string, FileStat> remote_files;
+        std::set<std::string> local_files;
+    };
+    std::vector<TabletDownload> downloads(src_to_dest_path.size());
+    std::vector<std::function<Status()>> transfers;
+    std::vector<int> transfer_tablets;
+    int tablet_index = 0;
+    for (auto iter = src_to_dest_path.begin(); iter != src_to_dest_path.end(); iter++, tablet_index++) {
         const std::string& remote_path = iter->first;
         const std::string& local_path = iter->second;
+        TabletDownload& download = downloads[tablet_index];
 
-        int64_t local_tablet_id = 0;
         int32_t schema_hash = 0;
-        RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(local_path, &local_tablet_id, &schema_hash));
-        downloaded_tablet_ids->push_back(local_tablet_id);
+        RETURN_IF_ERROR(
+                _get_tablet_id_and_schema_hash_from_file_path(local_path, &download.local_tablet_id, &schema_hash));
+        downloaded_tablet_ids->push_back(download.local_tablet_id);
 
-        int64_t remote_tablet_id;
-        RETURN_IF_ERROR(_get_tablet_id_from_remote_path(remote_path, &remote_tablet_id));
-        VLOG(2) << "get local tablet id: " << local_tablet_id << ", schema hash: " << schema_hash
-                << ", remote tablet id: " << remote_tablet_id;
+        RETURN_IF_ERROR(_get_tablet_id_from_remote_path(remote_path, &download.remote_tablet_id));
+        VLOG(2) << "get local tablet id: " << download.local_tablet_id << ", schema hash: " << schema_hash
+                << ", remote tablet id: " << download.remote_tablet_id;
 
-        // 1. get local files
+        // 3.1 get local files
         std::vector<std::string> local_files;
         RETURN_IF_ERROR(_get_existing_files_from_local(local_path, &local_files));
+        download.local_files.insert(local_files.begin(), local_files.end());
 
-        // 2. get remote files
-        std::map<std::string, FileStat> remote_files;
-        RETURN_IF_ERROR(_get_existing_files_from_remote(client, remote_path, broker_prop, &remote_files));
-        if (remote_files.empty()) {
+        // 3.2 get remote files
+        RETURN_IF_ERROR(_get_existing_files_from_remote(client, remote_path, broker_prop, &download.remote_files));
+        if (download.remote_files.empty()) {
             std::stringstream ss;
             ss << "get nothing from remote path: " << remote_path;
             LOG(WARNING) << ss.str();
             return Status::InternalError(ss.str());
         }
 
-        TabletSharedPtr tablet = _env->storage_engine()->tablet_manager()->get_tablet(local_tablet_id, schema_hash);
+        TabletSharedPtr tablet =
+                _env->storage_engine()->tablet_manager()->get_tablet(download.local_tablet_id, schema_hash);
         if (tablet == nullptr) {
             std::stringstream ss;
-            ss << "failed to get local tablet: " << local_tablet_id;
+            ss << "failed to get local tablet: " << download.local_tablet_id;
             LOG(WARNING) << ss.str();
             return Status::InternalError(ss.str());
         }
-        DataDir* data_dir = tablet->data_dir();
-
-        for (auto& iter : remote_files) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::DOWNLOAD));
-
-            bool need_download = false;
-            const std::string& remote_file = iter.first;
-            const FileStat& file_stat = iter.second;
-            auto find = std::find(local_files.begin(), local_files.end(), remote_file);
-            if (find == local_files.end()) {
-                // remote file does not exist in local, download it
-                need_download = true;
-            } else {
-                if (_end_with(remote_file, ".hdr")) {
-                    // this is a header file, download it.
-                    need_download = true;
-                } else {
-                    // check checksum
-                    std::string local_md5sum;
-                    Status st = FileUtils::md5sum(local_path + "/" + remote_file, &local_md5sum);
-                    if (!st.ok()) {
-                        LOG(WARNING) << "failed to get md5sum of local file: " << remote_file
-                                     << ". msg: " << st.get_error_msg() << ". download it";
-                        need_download = true;
-                    } else {
-                        VLOG(2) << "get local file checksum: " << remote_file << ": " << local_md5sum;
-                        if (file_stat.md5 != local_md5sum) {
-                            // file's checksum does not equal, download it.
-                            need_download = true;
-                        }
-                    }
-                }
-            }
-
-            if (!need_download) {
-                LOG(INFO) << "remote file already exist in local, no need to download."
-                          << ", file: " << remote_file;
-                continue;
-            }
-
-            // begin to download
-            std::string full_remote_file = remote_path + "/" + remote_file + "." + file_stat.md5;
-            std::string local_file_name;
-            // we need to replace the tablet_id in remote file name with local tablet id
-            RETURN_IF_ERROR(_replace_tablet_id(remote_file, local_tablet_id, &local_file_name));
-            std::string full_local_file = local_path + "/" + local_file_name;
-            LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
-            size_t file_len = file_stat.size;
-
-            // check disk capacity
-            if (data_dir->reach_capacity_limit(file_len)) {
-                return Status::InternalError("capacity limit reached");
-            }
-
-            EnvBroker env_broker(broker_addr, broker_prop);
-            std::unique_ptr<SequentialFile> broker_file;
-            RETURN_IF_ERROR(env_broker.new_sequential_file(full_remote_file, &broker_file));
-
-            // remove file which will be downloaded now.
-            // this file will be added to local_files if it be downloaded successfully.
-            local_files.erase(find);
-
-            // 3. open local file for write
-            std::unique_ptr<WritableFile> local_file;
-            RETURN_IF_ERROR(Env::Default()->new_writable_file(full_local_file, &local_file));
-
-            auto res = FileUtils::copy(broker_file.get(), local_file.get(), 1024 * 1024);
-            if (!res.ok()) {
-                return res.status();
-            }
-            RETURN_IF_ERROR(local_file->close());
-
-            // 5. check md5 of the downloaded file
-            std::string downloaded_md5sum;
-            status = FileUtils::md5sum(full_local_file, &downloaded_md5sum);
-            if (!status.ok()) {
-                std::stringstream ss;
-                ss << "failed to get md5sum of file: " << full_local_file;
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-            VLOG(2) << "get downloaded file checksum: " << full_local_file << ": " << downloaded_md5sum;
-            if (downloaded_md5sum != file_stat.md5) {
-                std::stringstream ss;
-                ss << "invalid md5 of downloaded file: " << full_local_file << ", expected: " << file_stat.md5
-                   << ", get: " << downloaded_md5sum;
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
+        download.data_dir = tablet->data_dir();
+
+        for (const auto& remote : download.remote_files) {
+            transfers.emplace_back([&, &remote_path = remote_path, &local_path = local_path, &download = download,
+                                    &remote_file = remote.first, &file_stat = remote.second]() {
+                return _download_file(broker_addr, broker_prop, remote_path, local_path, remote_file, file_stat,
+                                      download.local_tablet_id, download.data_dir,
+                                      download.local_files.count(remote_file) > 0);
+            });
+            transfer_tablets.push_back(tablet_index);
+        }
+    }
 
-            // local_files always keep the updated local files
-            local_files.push_back(local_file_name);
-            LOG(INFO) << "finished to download file via broker. file: " << full_local_file << ", length: " << file_len;
-        } // end for all remote files
+    // 4. download the files
+    RETURN_IF_ERROR(_run_transfers(transfers, transfer_tablets, downloads.size(), TTaskType::type::DOWNLOAD));
 
-        // finally, delete local files which are not in remote
+    // 5. finally, delete local files which are not in remote
+    tablet_index = 0;
+    for (auto iter = src_to_dest_path.begin(); iter != src_to_dest_path.end(); iter++, tablet_index++) {
+        const std::string& local_path = iter->second;
+        const TabletDownload& download = downloads[tablet_index];
+        std::vector<std::string> local_files;
+        RETURN_IF_ERROR(_get_existing_files_from_local(local_path, &local_files));
         for (const auto& local_file : local_files) {
             // replace the tablet id in local file name with the remote tablet id,
             // in order to compare the file name.
             std::string new_name;
-            Status st = _replace_tablet_id(local_file, remote_tablet_id, &new_name);
+            Status st = _replace_tablet_id(local_file, download.remote_tablet_id, &new_name);
             if (!st.ok()) {
                 LOG(WARNING) << "failed to replace tablet id. unknown local file: " << st.get_error_msg()
                              << ". ignore it";
                 continue;
             }
             VLOG(2) << "new file name after replace tablet id: " << new_name;
-            const auto& find = remote_files.find(new_name);
-            if (find != remote_files.end()) {
+            const auto& find = download.remote_files.find(new_name);
+            if (find != download.remote_files.end()) {
                 continue;
             }
 
@@ -379,14 +382,174 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
                 LOG(WARNING) << "failed to delete unknown local file: " << full_local_file << ", ignore it";
             }
         }
-
-        finished_num++;
-    } // end for src_to_dest_path
+    }
 
     LOG(INFO) << "finished to download snapshots. job: " << _job_id << ", task id: " << _task_id;
     return status;
 }
 
+Status SnapshotLoader::_download_file(const TNetworkAddress& broker_addr,
+                                      const std::map<std::string, std::string>& broker_prop,
+                                      const std::string& remote_path, const std::string& local_path,
+                                      const std::string& remote_file, const FileStat& file_stat,
+                                      int64_t local_tablet_id, DataDir* data_dir, bool exists_in_local) {
+    bool need_download = false;
+    if (!exists_in_local) {
+        // remote file does not exist in local, download it
+        need_download = true;
+    } else {
+        if (_end_with(remote_file, ".hdr")) {
+            // this is a header file, download it.
+            need_download = true;
+        } else {
+            // check checksum
+            std::string local_md5sum;
+            Status st = FileUtils::md5sum(local_path + "/" + remote_file, &local_md5sum);
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to get md5sum of local file: " << remote_file << ". msg: " << st.get_error_msg()
+                             << ". download it";
+                need_download = true;
+            } else {
+                VLOG(2) << "get local file checksum: " << remote_file << ": " << local_md5sum;
+                if (file_stat.md5 != local_md5sum) {
+                    // file's checksum does not equal, download it.
+                    need_download = true;
+                }
+            }
+        }
+    }
+
+    if (!need_download) {
+        LOG(INFO) << "remote file already exist in local, no need to download."
+                  << ", file: " << remote_file;
+        return Status::OK();
+    }
+
+    // begin to download
+    std::string full_remote_file = remote_path + "/" + remote_file + "." + file_stat.md5;
+    std::string local_file_name;
+    // we need to replace the tablet_id in remote file name with local tablet id
+    RETURN_IF_ERROR(_replace_tablet_id(remote_file, local_tablet_id, &local_file_name));
+    std::string full_local_file = local_path + "/" + local_file_name;
+    LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
+    size_t file_len = file_stat.size;
+
+    // check disk capacity
+    if (data_dir->reach_capacity_limit(file_len)) {
+        return Status::InternalError("capacity limit reached");
+    }
+
+    EnvBroker env_broker(broker_addr, broker_prop);
+    std::unique_ptr<SequentialFile> broker_file;
+    RETURN_IF_ERROR(env_broker.new_sequential_file(full_remote_file, &broker_file));
+
+    // open local file for write, the file is written as ".part" and renamed after its checksum is verified,
+    // so a file failed to download is never taken as a downloaded one.
+    std::string tmp_local_file = full_local_file + ".part";
+    std::unique_ptr<WritableFile> local_file;
+    RETURN_IF_ERROR(Env::Default()->new_writable_file(tmp_local_file, &local_file));
+
+    auto res = copy_file(broker_file.get(), local_file.get(), 1024 * 1024);
+    if (!res.ok()) {
+        return res.status();
+    }
+    RETURN_IF_ERROR(local_file->close());
+
+    // check md5 of the downloaded file
+    std::string downloaded_md5sum;
+    Status status = FileUtils::md5sum(tmp_local_file, &downloaded_md5sum);
+    if (!status.ok()) {
+        std::stringstream ss;
+        ss << "failed to get md5sum of file: " << tmp_local_file;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    VLOG(2) << "get downloaded file checksum: " << tmp_local_file << ": " << downloaded_md5sum;
+    if (downloaded_md5sum != file_stat.md5) {
+        std::stringstream ss;
+        ss << "invalid md5 of downloaded file: " << tmp_local_file << ", expected: " << file_stat.md5
+           << ", get: " << downloaded_md5sum;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    RETURN_IF_ERROR(Env::Default()->rename_file(tmp_local_file, full_local_file));
+
+    LOG(INFO) << "finished to download file via broker. file: " << full_local_file << ", length: " << file_len;
+    return Status::OK();
+}
+
+Status SnapshotLoader::_run_transfers(const std::vector<std::function<Status()>>& transfers,
+                                      const std::vector<int>& transfer_tablets, int num_tablets,
+                                      TTaskType::type type) {
+    // The transfers left of each tablet, a tablet is finished when all of its transfers are done.
+    std::vector<int> num_transfers_left(num_tablets, 0);
+    for (int tablet : transfer_tablets) {
+        num_transfers_left[tablet]++;
+    }
+    int finished_num = std::count(num_transfers_left.begin(), num_transfers_left.end(), 0);
+
+    std::mutex lock;
+    std::condition_variable cv;
+    size_t next = 0;
+    size_t num_done = 0;
+    Status status;
+    auto transfer = [&]() {
+        while (true) {
+            size_t i;
+            {
+                std::lock_guard<std::mutex> l(lock);
+                if (!status.ok() || next >= transfers.size()) {
+                    return;
+                }
+                i = next++;
+            }
+            Status st = transfers[i]();
+            {
+                std::lock_guard<std::mutex> l(lock);
+                num_done++;
+                if (!st.ok() && status.ok()) {
+                    status = st;
+                }
+                if (--num_transfers_left[transfer_tablets[i]] == 0) {
+                    finished_num++;
+                }
+            }
+            cv.notify_one();
+        }
+    };
+    size_t num_threads = std::min<size_t>(std::max(config::snapshot_loader_transfer_concurrency, 1), transfers.size());
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back(transfer);
+    }
+
+    // Report the progress to the frontend for every 10 files, and cancel the transfers not started if the job has
+    // already been cancelled in frontend.
+    int report_counter = 0;
+    size_t num_reported = 0;
+    {
+        std::unique_lock<std::mutex> l(lock);
+        while (status.ok() && num_reported < transfers.size()) {
+            cv.wait(l, [&] { return num_done > num_reported || !status.ok(); });
+            while (status.ok() && num_reported < num_done) {
+                num_reported++;
+                int finished = finished_num;
+                l.unlock();
+                Status st = _report_every(10, &report_counter, finished, num_tablets, type);
+                l.lock();
+                if (!st.ok() && status.ok()) {
+                    status = st;
+                }
+            }
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return status;
+}
+
 // move the snapshot files in snapshot_path
 // to tablet_path
 // If overwrite, just replace the tablet_path with snapshot_path,
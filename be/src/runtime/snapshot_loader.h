@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -57,6 +58,11 @@ struct FileStat {
  * to local snapshot dir via broker.
  * It will also only download files which does not exist in local dir.
  *
+ * The files of all the tablets are checked and transferred by
+ * config::snapshot_loader_transfer_concurrency threads, and the bytes
+ * transferred by all the loaders of a BE are limited by
+ * config::snapshot_loader_max_bytes_per_sec.
+ *
  * Move:
  * move() is the final step of restore process. it will replace the 
  * old tablet data dir with the newly downloaded snapshot dir.
@@ -79,6 +85,24 @@ public:
     Status move(const std::string& snapshot_path, TabletSharedPtr tablet, bool overwrite);
 
 private:
+    // Upload |local_file| of |src_path| to |dest_path| if it's not in |remote_files| with the same checksum, and
+    // set |local_file_with_checksum| to its name with the checksum.
+    Status _upload_file(const TNetworkAddress& broker_addr, const std::map<std::string, std::string>& broker_prop,
+                        const std::string& src_path, const std::string& dest_path, const std::string& local_file,
+                        const std::map<std::string, FileStat>& remote_files, std::string* local_file_with_checksum);
+
+    // Download |remote_file| of |remote_path| to |local_path| if it's not in local with the same checksum.
+    Status _download_file(const TNetworkAddress& broker_addr, const std::map<std::string, std::string>& broker_prop,
+                          const std::string& remote_path, const std::string& local_path,
+                          const std::string& remote_file, const FileStat& file_stat, int64_t local_tablet_id,
+                          DataDir* data_dir, bool exists_in_local);
+
+    // Run |transfers| concurrently, the i-th of which transfers a file of the |transfer_tablets[i]|-th tablet of
+    // the |num_tablets| tablets, and report the finished tablets to the frontend. Return the first error, the
+    // transfers not started are cancelled after it.
+    Status _run_transfers(const std::vector<std::function<Status()>>& transfers,
+                          const std::vector<int>& transfer_tablets, int num_tablets, TTaskType::type type);
+
     Status _get_tablet_id_and_schema_hash_from_file_path(const std::string& src_path, int64_t* tablet_id,
                                                          int32_t* schema_hash);
 
@@ -149,6 +149,30 @@ public:
         return Status::OK();
     }
 
+    // Take the next buffer received without copying it, the bytes in [buf->pos, buf->limit) are unread.
+    // |buf| is set to nullptr if the producer finished and all the data is read.
+    Status read_buffer(ByteBufferPtr* buf) {
+        std::unique_lock<std::mutex> l(_lock);
+        while (!_cancelled && !_finished && _buf_queue.empty()) {
+            _get_cond.wait(l);
+        }
+        // cancelled
+        if (_cancelled) {
+            return Status::InternalError("cancelled");
+        }
+        // finished
+        if (_buf_queue.empty()) {
+            DCHECK(_finished);
+            buf->reset();
+            return Status::OK();
+        }
+        *buf = std::move(_buf_queue.front());
+        _buf_queue.pop_front();
+        _buffered_bytes -= (*buf)->limit;
+        _put_cond.notify_one();
+        return Status::OK();
+    }
+
     Status readat(int64_t position, int64_t nbytes, int64_t* bytes_read, void* out) override {
         return Status::InternalError("Not implemented");
     }
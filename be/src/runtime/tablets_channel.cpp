@@ -30,6 +30,8 @@
 #include "storage/memtable.h"
 #include "storage/vectorized/delta_writer.h"
 #include "storage/vectorized/memtable.h"
+#include "util/block_compression.h"
+#include "util/faststring.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks {
@@ -133,9 +135,6 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
             LOG(INFO) << "packet has already recept before, expect_seq=" << next_seq
                       << ", recept_seq=" << params.packet_seq();
             return Status::OK();
-        } else if (params.packet_seq() > next_seq) {
-            LOG(WARNING) << "lost data packet, expect_seq=" << next_seq << ", recept_seq=" << params.packet_seq();
-            return Status::InternalError("lost data packet");
         }
     }
 
@@ -147,18 +146,63 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
         }
     }
 
-    vectorized::Chunk chunk;
-    RETURN_IF_ERROR(chunk.deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
-    DCHECK_EQ(params.tablet_ids_size(), chunk.num_rows());
+    // The chunk is decompressed and deserialized before its turn, so the rpcs in flight of a sender overlap.
+    auto chunk = std::make_unique<vectorized::Chunk>();
+    RETURN_IF_ERROR(_deserialize_chunk(pchunk, chunk.get()));
+    DCHECK_EQ(params.tablet_ids_size(), chunk->num_rows());
+    std::vector<int64_t> tablet_ids(params.tablet_ids().begin(), params.tablet_ids().end());
 
+    {
+        std::lock_guard<std::mutex> l(_global_lock);
+        if (_state == kFinished) {
+            return _close_status;
+        }
+        // The former packets of the sender are still in flight, they'll write this one after themselves.
+        if (params.packet_seq() > _next_seqs[params.sender_id()]) {
+            _reordered_chunks[params.sender_id()].emplace(params.packet_seq(),
+                                                          ReorderedChunk{std::move(chunk), std::move(tablet_ids)});
+            return Status::OK();
+        }
+    }
+
+    while (true) {
+        RETURN_IF_ERROR(_write_chunk(chunk.get(), tablet_ids));
+        std::lock_guard<std::mutex> l(_global_lock);
+        int64_t next_seq = ++_next_seqs[params.sender_id()];
+        auto& reordered = _reordered_chunks[params.sender_id()];
+        auto iter = reordered.find(next_seq);
+        if (iter == reordered.end()) {
+            break;
+        }
+        chunk = std::move(iter->second.chunk);
+        tablet_ids = std::move(iter->second.tablet_ids);
+        reordered.erase(iter);
+    }
+    return Status::OK();
+}
+
+Status TabletsChannel::_deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk) {
+    if (pchunk.compress_type() == CompressionTypePB::NO_COMPRESSION) {
+        return chunk->deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta);
+    }
+    const BlockCompressionCodec* codec = nullptr;
+    RETURN_IF_ERROR(get_block_compression_codec(pchunk.compress_type(), &codec));
+    faststring uncompressed_buffer;
+    uncompressed_buffer.resize(pchunk.uncompressed_size());
+    Slice output{uncompressed_buffer.data(), uncompressed_buffer.size()};
+    RETURN_IF_ERROR(codec->decompress(pchunk.data(), &output));
+    return chunk->deserialize(uncompressed_buffer.data(), uncompressed_buffer.size(), _chunk_meta);
+}
+
+Status TabletsChannel::_write_chunk(vectorized::Chunk* chunk, const std::vector<int64_t>& tablet_ids) {
     size_t channel_size = _tablet_id_to_sorted_indexes.size();
-    std::vector<uint32_t> row_indexes(chunk.num_rows());
+    std::vector<uint32_t> row_indexes(chunk->num_rows());
     std::vector<uint32_t> channel_row_idx_start_points(channel_size + 1);
     {
         // compute row indexes for each channel
         channel_row_idx_start_points.assign(channel_size + 1, 0);
-        for (uint32_t i = 0; i < params.tablet_ids_size(); ++i) {
-            uint32_t channel_index = _tablet_id_to_sorted_indexes[params.tablet_ids(i)];
+        for (uint32_t i = 0; i < tablet_ids.size(); ++i) {
+            uint32_t channel_index = _tablet_id_to_sorted_indexes[tablet_ids[i]];
             channel_row_idx_start_points[channel_index]++;
         }
 
@@ -167,8 +211,8 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
             channel_row_idx_start_points[i] += channel_row_idx_start_points[i - 1];
         }
 
-        for (int i = params.tablet_ids_size() - 1; i >= 0; --i) {
-            uint32_t channel_index = _tablet_id_to_sorted_indexes[params.tablet_ids(i)];
+        for (int i = tablet_ids.size() - 1; i >= 0; --i) {
+            uint32_t channel_index = _tablet_id_to_sorted_indexes[tablet_ids[i]];
             row_indexes[channel_row_idx_start_points[channel_index] - 1] = i;
             channel_row_idx_start_points[channel_index]--;
         }
@@ -181,24 +225,19 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
             // no data for this channel continue;
             continue;
         }
-        auto tablet_id = params.tablet_ids(row_indexes[from]);
+        auto tablet_id = tablet_ids[row_indexes[from]];
         auto it = _vectorized_tablet_writers.find(tablet_id);
         if (it == std::end(_vectorized_tablet_writers)) {
             return Status::InternalError(strings::Substitute("unknown tablet to append data, tablet=$0", tablet_id));
         }
         {
             std::lock_guard<std::mutex> l(_tablet_locks[tablet_id & k_shard_size]);
-            auto st = it->second->write(&chunk, row_indexes.data(), from, size);
+            auto st = it->second->write(chunk, row_indexes.data(), from, size);
             if (!st.ok()) {
                 return st;
             }
         }
     }
-
-    {
-        std::lock_guard<std::mutex> l(_global_lock);
-        _next_seqs[params.sender_id()]++;
-    }
     return Status::OK();
 }
 
@@ -396,6 +435,47 @@ Status TabletsChannel::reduce_mem_usage_async(const std::set<int64_t>& flush_tab
     return Status::OK();
 }
 
+void TabletsChannel::get_tablet_mem_consumptions(std::vector<std::pair<int64_t, int64_t>>* tablet_mem_consumptions) {
+    std::lock_guard<std::mutex> l(_global_lock);
+    if (_state == kFinished) {
+        return;
+    }
+    if (_is_vectorized) {
+        for (auto& it : _vectorized_tablet_writers) {
+            if (it.second->mem_consumption() > 0) {
+                tablet_mem_consumptions->emplace_back(it.first, it.second->mem_consumption());
+            }
+        }
+    } else {
+        for (auto& it : _tablet_writers) {
+            if (it.second->mem_consumption() > 0) {
+                tablet_mem_consumptions->emplace_back(it.first, it.second->mem_consumption());
+            }
+        }
+    }
+}
+
+Status TabletsChannel::flush_tablet_async(int64_t tablet_id) {
+    vectorized::DeltaWriter* vectorized_writer = nullptr;
+    {
+        std::lock_guard<std::mutex> l(_global_lock);
+        if (_state == kFinished) {
+            return _close_status;
+        }
+        if (!_is_vectorized) {
+            auto it = _tablet_writers.find(tablet_id);
+            return it == _tablet_writers.end() ? Status::OK() : it->second->flush_memtable_async();
+        }
+        auto it = _vectorized_tablet_writers.find(tablet_id);
+        if (it == _vectorized_tablet_writers.end()) {
+            return Status::OK();
+        }
+        vectorized_writer = it->second;
+    }
+    std::lock_guard<std::mutex> l(_tablet_locks[tablet_id & k_shard_size]);
+    return vectorized_writer->flush_memtable_async();
+}
+
 Status TabletsChannel::wait_mem_usage_reduced(int64_t tablet_id) {
     vectorized::DeltaWriter* vectorized_writer = nullptr;
     {
@@ -20,6 +20,7 @@
 // under the License.
 
 #include <cstdint>
+#include <map>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -92,6 +93,14 @@ public:
     // wait tablet memtables in flush queue to be flushed.
     Status wait_mem_usage_reduced(int64_t tablet_id);
 
+    // Append the ids and the mem consumptions of the tablet writers consuming memory to |tablet_mem_consumptions|.
+    // no-op when this channel has been closed or cancelled.
+    void get_tablet_mem_consumptions(std::vector<std::pair<int64_t, int64_t>>* tablet_mem_consumptions);
+
+    // Flush the memtable of the writer of |tablet_id| asynchronously, no-op if there is a memtable of it in the
+    // flush queue already.
+    Status flush_tablet_async(int64_t tablet_id);
+
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
 
 private:
@@ -100,6 +109,11 @@ private:
 
     Status _build_chunk_meta(const ChunkPB& pb_chunk);
 
+    // Decompress |pchunk| if it's compressed and deserialize it into |chunk|.
+    Status _deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk);
+
+    Status _write_chunk(vectorized::Chunk* chunk, const std::vector<int64_t>& tablet_ids);
+
     // id of this load channel
     TabletsChannelKey _key;
 
@@ -143,6 +157,12 @@ private:
     bool _is_vectorized = false;
     vectorized::RuntimeChunkMeta _chunk_meta;
     std::unordered_map<int64_t, uint32_t> _tablet_id_to_sorted_indexes;
+    // The chunks arrived before the former packets of their senders, sender_id -> packet_seq -> chunk.
+    struct ReorderedChunk {
+        std::unique_ptr<vectorized::Chunk> chunk;
+        std::vector<int64_t> tablet_ids;
+    };
+    std::unordered_map<int, std::map<int64_t, ReorderedChunk>> _reordered_chunks;
     // tablet_id -> TabletChannel
     std::unordered_map<int64_t, vectorized::DeltaWriter*> _vectorized_tablet_writers;
 };
@@ -5,7 +5,11 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
+#include <limits>
+#include <string>
+#include <vector>
 
 #include "StringSearcher.h"
 
@@ -153,6 +157,95 @@ protected:
 
 using VolnitskyUTF8 = VolnitskyBase<StringSearcher>;
 
+/// Search for any of multiple substrings in a string, e.g. for `a LIKE '%x%' OR a LIKE '%y%' OR ...`.
+/// The bigrams of all the needles are put in one hash table with the index of the needle, so a haystack is
+/// scanned once no matter how many needles there are. The needles too short or too long for the hash table
+/// are searched one by one by StringSearcher.
+class MultiVolnitsky {
+public:
+    static constexpr size_t max_needles = std::numeric_limits<VolnitskyTraits::Id>::max() + 1;
+
+    /// At most max_needles needles.
+    explicit MultiVolnitsky(std::vector<std::string> needles_) : needles{std::move(needles_)} {
+        for (size_t id = 0; id < needles.size(); ++id) {
+            const std::string& needle = needles[id];
+            if (VolnitskyTraits::isFallbackNeedle(needle.size())) {
+                fallback_searchers.emplace_back(needle.data(), needle.size());
+            } else {
+                step = std::min(step, needle.size() - sizeof(VolnitskyTraits::Ngram) + 1);
+                min_hashed_needle_size = std::min(min_hashed_needle_size, needle.size());
+                hashed_ids.emplace_back(id);
+            }
+        }
+        if (hashed_ids.empty()) return;
+
+        /// At most 256 needles and 253 bigrams of each needle, so the hash table never gets full.
+        hash = std::unique_ptr<Cell[]>(new Cell[VolnitskyTraits::hash_size]{});
+        for (size_t id : hashed_ids) {
+            const auto* needle = reinterpret_cast<const uint8_t*>(needles[id].data());
+            for (size_t i = 0; i + sizeof(VolnitskyTraits::Ngram) <= needles[id].size(); ++i) {
+                putNGram(VolnitskyTraits::toNGram(needle + i), static_cast<VolnitskyTraits::Offset>(i + 1),
+                         static_cast<VolnitskyTraits::Id>(id));
+            }
+        }
+    }
+
+    MultiVolnitsky(const MultiVolnitsky&) = delete;
+    MultiVolnitsky& operator=(const MultiVolnitsky&) = delete;
+
+    /// Whether any of the needles occurs in the haystack.
+    bool search_any(const uint8_t* const haystack, const size_t haystack_size) const {
+        const auto* const haystack_end = haystack + haystack_size;
+        for (const auto& searcher : fallback_searchers) {
+            if (searcher.search(haystack, haystack_end) != haystack_end) return true;
+        }
+        if (hash == nullptr || haystack_size < min_hashed_needle_size) return false;
+
+        /// An occurrence of a needle of size n covers n - 1 bigrams of the haystack, and the step is not greater
+        /// than that, so at least one bigram of each occurrence is looked up.
+        for (size_t pos = 0; pos + sizeof(VolnitskyTraits::Ngram) <= haystack_size; pos += step) {
+            for (size_t cell_num = VolnitskyTraits::toNGram(haystack + pos) % VolnitskyTraits::hash_size;
+                 hash[cell_num].offset; cell_num = (cell_num + 1) % VolnitskyTraits::hash_size) {
+                const Cell& cell = hash[cell_num];
+                const std::string& needle = needles[cell.id];
+                if (cell.offset - 1 > pos) continue;
+                const size_t res = pos - (cell.offset - 1);
+                if (res + needle.size() <= haystack_size && memcmp(haystack + res, needle.data(), needle.size()) == 0)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    bool search_any(const char* haystack, size_t haystack_size) const {
+        return search_any(reinterpret_cast<const uint8_t*>(haystack), haystack_size);
+    }
+
+private:
+    struct Cell {
+        /// The position of the bigram in the needle + 1, zero means an empty cell.
+        VolnitskyTraits::Offset offset;
+        VolnitskyTraits::Id id;
+    };
+
+    void putNGram(const VolnitskyTraits::Ngram ngram, const VolnitskyTraits::Offset offset,
+                  const VolnitskyTraits::Id id) {
+        size_t cell_num = ngram % VolnitskyTraits::hash_size;
+        while (hash[cell_num].offset) {
+            cell_num = (cell_num + 1) % VolnitskyTraits::hash_size;
+        }
+        hash[cell_num] = {offset, id};
+    }
+
+    /// The searchers of the fallback needles point to the needles, which are never modified.
+    const std::vector<std::string> needles;
+    std::vector<size_t> hashed_ids;
+    std::vector<StringSearcher> fallback_searchers;
+    std::unique_ptr<Cell[]> hash;
+    size_t step = std::numeric_limits<size_t>::max();
+    size_t min_hashed_needle_size = std::numeric_limits<size_t>::max();
+};
+
 } //namespace vectorized
 
 } //namespace starrocks
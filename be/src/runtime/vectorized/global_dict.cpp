@@ -0,0 +1,169 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/vectorized/global_dict.h"
+
+#include <algorithm>
+
+#include "column/column_helper.h"
+#include "column/const_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+
+namespace starrocks::vectorized {
+
+Status GlobalDict::init(const TGlobalDict& tdict) {
+    return init(tdict.strings, tdict.ids);
+}
+
+Status GlobalDict::init(const std::vector<std::string>& strings, const std::vector<DictId>& ids) {
+    if (strings.size() != ids.size()) {
+        return Status::InvalidArgument(strings::Substitute("the global dict has $0 strings but $1 ids", strings.size(),
+                                                           ids.size()));
+    }
+    DictId max_id = 0;
+    for (DictId id : ids) {
+        if (id < 0 || id >= kMaxDictSize) {
+            return Status::InvalidArgument(strings::Substitute("invalid id of the global dict: $0", id));
+        }
+        max_id = std::max(max_id, id);
+    }
+
+    // The id 0 always exists, it's the id of the nulls.
+    std::vector<const std::string*> id_strings(max_id + 1, nullptr);
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (id_strings[ids[i]] != nullptr) {
+            return Status::InvalidArgument(strings::Substitute("duplicated id of the global dict: $0", ids[i]));
+        }
+        id_strings[ids[i]] = &strings[i];
+    }
+    _words.reserve(id_strings.size());
+    _valid_ids.assign(id_strings.size(), 0);
+    for (size_t id = 0; id < id_strings.size(); id++) {
+        if (id_strings[id] != nullptr) {
+            _words.append(Slice(*id_strings[id]));
+            _valid_ids[id] = 1;
+        } else {
+            _words.append(Slice());
+        }
+    }
+
+    _dict.reserve(ids.size());
+    for (DictId id : ids) {
+        if (!_dict.emplace(_words.get_slice(id), id).second) {
+            return Status::InvalidArgument(strings::Substitute("duplicated string of the global dict: $0",
+                                                               _words.get_slice(id).to_string()));
+        }
+    }
+    return Status::OK();
+}
+
+Status GlobalDict::encode(const Column& words, Column* ids) const {
+    DCHECK(!words.is_nullable() || ids->is_nullable());
+    const auto* binary = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(&words));
+    const uint8_t* nulls = nullptr;
+    if (words.is_nullable()) {
+        nulls = down_cast<const NullableColumn*>(&words)->immutable_null_column_data().data();
+    }
+    const size_t num_rows = words.size();
+
+    auto& id_data = down_cast<Int32Column*>(ColumnHelper::get_data_column(ids))->get_data();
+    id_data.resize(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        if (nulls != nullptr && nulls[i]) {
+            id_data[i] = 0;
+            continue;
+        }
+        const Slice word = binary->get_slice(i);
+        DictId id = lookup(word);
+        if (UNLIKELY(id < 0)) {
+            return Status::InternalError(strings::Substitute("$0 is not in the global dict", word.to_string()));
+        }
+        id_data[i] = id;
+    }
+
+    if (ids->is_nullable()) {
+        auto* nullable_ids = down_cast<NullableColumn*>(ids);
+        auto& null_data = nullable_ids->null_column_data();
+        if (nulls != nullptr) {
+            null_data.assign(nulls, nulls + num_rows);
+        } else {
+            null_data.assign(num_rows, 0);
+        }
+        nullable_ids->update_has_null();
+    }
+    return Status::OK();
+}
+
+Status GlobalDict::decode(const Column& ids, Column* words) const {
+    DCHECK(!ids.is_nullable() || words->is_nullable());
+    const auto& id_data = down_cast<const Int32Column*>(ColumnHelper::get_data_column(&ids))->get_data();
+    const uint8_t* nulls = nullptr;
+    if (ids.is_nullable()) {
+        nulls = down_cast<const NullableColumn*>(&ids)->immutable_null_column_data().data();
+    }
+    const size_t num_rows = ids.size();
+
+    std::vector<uint32_t> indexes(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        auto id = static_cast<uint32_t>(id_data[i]);
+        if (UNLIKELY(id >= _valid_ids.size() || !_valid_ids[id])) {
+            if (nulls != nullptr && nulls[i]) {
+                id = 0;
+            } else {
+                return Status::InternalError(strings::Substitute("invalid id of the global dict: $0", id_data[i]));
+            }
+        }
+        indexes[i] = id;
+    }
+
+    auto* binary = down_cast<BinaryColumn*>(ColumnHelper::get_data_column(words));
+    binary->resize(0);
+    binary->append_selective(_words, indexes.data(), 0, num_rows);
+
+    if (words->is_nullable()) {
+        auto* nullable_words = down_cast<NullableColumn*>(words);
+        auto& null_data = nullable_words->null_column_data();
+        if (nulls != nullptr) {
+            null_data.assign(nulls, nulls + num_rows);
+        } else {
+            null_data.assign(num_rows, 0);
+        }
+        nullable_words->update_has_null();
+    }
+    return Status::OK();
+}
+
+Status parse_global_dicts(const std::vector<TGlobalDict>& tdicts, GlobalDicts* dicts) {
+    for (const auto& tdict : tdicts) {
+        auto dict = std::make_shared<GlobalDict>();
+        RETURN_IF_ERROR(dict->init(tdict));
+        dicts->emplace(tdict.column_id, std::move(dict));
+    }
+    return Status::OK();
+}
+
+Status decode_dict_slots(const std::vector<DictDecodeSlot>& slots, Chunk* chunk) {
+    for (const auto& slot : slots) {
+        const ColumnPtr& ids = chunk->get_column_by_slot_id(slot.id_slot);
+        // The constant ids are decoded only once.
+        const Column* id_data = ids.get();
+        if (ids->is_constant()) {
+            id_data = down_cast<const ConstColumn*>(ids.get())->data_column().get();
+        }
+        ColumnPtr words = BinaryColumn::create();
+        if (id_data->is_nullable()) {
+            words = NullableColumn::create(words, NullColumn::create());
+        }
+        RETURN_IF_ERROR(slot.dict->decode(*id_data, words.get()));
+        if (ids->is_constant()) {
+            words = ConstColumn::create(words, ids->size());
+        }
+        chunk->append_column(std::move(words), slot.string_slot);
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,80 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/column_hash.h"
+#include "common/status.h"
+#include "util/phmap/phmap.h"
+#include "util/slice.h"
+
+namespace starrocks {
+class TGlobalDict;
+}
+
+namespace starrocks::vectorized {
+
+using DictId = int32_t;
+
+// The global dictionary of a low cardinality string column. The strings are encoded into the ids by the
+// scan, i.e. the column flows through the filters, the aggregations, the joins and the exchanges as an INT
+// column, and the ids are decoded back to the strings by the DecodeNode before the result sink.
+class GlobalDict {
+public:
+    // The ids are in [0, kMaxDictSize), so that they're decoded by an array lookup.
+    static constexpr DictId kMaxDictSize = 64 * 1024;
+
+    GlobalDict() = default;
+    GlobalDict(const GlobalDict&) = delete;
+    GlobalDict& operator=(const GlobalDict&) = delete;
+
+    Status init(const TGlobalDict& tdict);
+    Status init(const std::vector<std::string>& strings, const std::vector<DictId>& ids);
+
+    size_t size() const { return _dict.size(); }
+
+    // Returns -1 if |word| is not in the dict.
+    DictId lookup(const Slice& word) const {
+        auto iter = _dict.find(word);
+        return iter != _dict.end() ? iter->second : -1;
+    }
+
+    // Encodes the strings of the BinaryColumn |words| into the Int32Column |ids|, both of them could be nullable.
+    // The ids of the nulls are 0, and the strings not in the dict are errors.
+    Status encode(const Column& words, Column* ids) const;
+
+    // Decodes the Int32Column |ids| into the BinaryColumn |words|, both of them could be nullable.
+    Status decode(const Column& ids, Column* words) const;
+
+private:
+    using DictMap = phmap::flat_hash_map<Slice, DictId, SliceHashWithSeed<PhmapSeed1>, SliceEqual>;
+
+    // Indexed by the ids, the ids not in the dict are empty strings.
+    BinaryColumn _words;
+    std::vector<uint8_t> _valid_ids;
+    // The slices point to the strings of |_words|.
+    DictMap _dict;
+};
+
+// The global dicts of the slots or the columns read as the dict ids.
+using GlobalDicts = std::unordered_map<int32_t, std::shared_ptr<const GlobalDict>>;
+
+Status parse_global_dicts(const std::vector<TGlobalDict>& tdicts, GlobalDicts* dicts);
+
+// The slot of the dict ids and the slot of the strings decoded from them.
+struct DictDecodeSlot {
+    int32_t id_slot = 0;
+    int32_t string_slot = 0;
+    std::shared_ptr<const GlobalDict> dict;
+};
+
+// Appends the columns of the strings decoded from the dict ids of |slots| to |chunk|.
+Status decode_dict_slots(const std::vector<DictDecodeSlot>& slots, Chunk* chunk);
+
+} // namespace starrocks::vectorized
@@ -2,16 +2,82 @@
 
 #include "sorted_chunks_merger.h"
 
+#include <thread>
+
+#include "column/chunk.h"
 #include "exec/sort_exec_exprs.h"
+#include "exprs/expr.h"
+#include "runtime/current_thread.h"
+#include "util/blocking_queue.hpp"
 
 namespace starrocks::vectorized {
 
+// The chunks of a group merged by a thread of its own.
+struct SortedChunksMerger::MergeGroup {
+    // the thread keeps up to 2 chunks merged ahead
+    MergeGroup() : queue(2) {}
+
+    std::vector<ExprContext*> sort_exprs;
+    SortedChunksMerger merger;
+    // the merged chunks followed by a nullptr
+    BlockingQueue<ChunkPtr> queue;
+    // set before the nullptr is put
+    Status status;
+    bool eos = false;
+    std::thread thread;
+};
+
 SortedChunksMerger::SortedChunksMerger() {}
 
-SortedChunksMerger::~SortedChunksMerger() {}
+SortedChunksMerger::~SortedChunksMerger() {
+    for (auto& group : _groups) {
+        group->queue.shutdown();
+    }
+    for (auto& group : _groups) {
+        if (group->thread.joinable()) {
+            group->thread.join();
+        }
+        if (_state != nullptr) {
+            Expr::close(group->sort_exprs, _state);
+        }
+    }
+}
 
 Status SortedChunksMerger::init(const ChunkSuppliers& suppliers, const std::vector<ExprContext*>* sort_exprs,
-                                const std::vector<bool>* is_asc, const std::vector<bool>* is_null_first) {
+                                const std::vector<bool>* is_asc, const std::vector<bool>* is_null_first,
+                                RuntimeState* state, size_t num_groups) {
+    if (num_groups > 1 && suppliers.size() > num_groups) {
+        _state = state;
+        size_t group_size = (suppliers.size() + num_groups - 1) / num_groups;
+        ChunkSuppliers group_suppliers;
+        for (size_t start = 0; start < suppliers.size(); start += group_size) {
+            auto group = std::make_unique<MergeGroup>();
+            if (state != nullptr) {
+                RETURN_IF_ERROR(Expr::clone_if_not_exists(*sort_exprs, state, &group->sort_exprs));
+            } else {
+                group->sort_exprs = *sort_exprs;
+            }
+            ChunkSuppliers sub_suppliers(suppliers.begin() + start,
+                                         suppliers.begin() + std::min(start + group_size, suppliers.size()));
+            group->thread = std::thread(&SortedChunksMerger::_merge_group, group.get(), std::move(sub_suppliers),
+                                        is_asc, is_null_first, CurrentThread::mem_tracker());
+            group_suppliers.emplace_back([g = group.get()](Chunk** chunk) -> Status {
+                *chunk = nullptr;
+                ChunkPtr merged;
+                if (g->eos || !g->queue.blocking_get(&merged) || merged == nullptr) {
+                    g->eos = true;
+                    return g->status;
+                }
+                *chunk = new Chunk();
+                (*chunk)->swap_chunk(*merged);
+                return Status::OK();
+            });
+            _groups.emplace_back(std::move(group));
+        }
+        // the groups are merged on the calling thread
+        return init(group_suppliers, sort_exprs, is_asc, is_null_first);
+    }
+
     if (suppliers.size() == 1) {
         _single_supplier = suppliers[0];
     } else {
@@ -30,6 +96,29 @@ Status SortedChunksMerger::init(const ChunkSuppliers& suppliers, const std::vect
     return Status::OK();
 }
 
+void SortedChunksMerger::_merge_group(MergeGroup* group, const ChunkSuppliers& suppliers,
+                                      const std::vector<bool>* is_asc, const std::vector<bool>* is_null_first,
+                                      MemTracker* mem_tracker) {
+    CurrentThread::set_mem_tracker(mem_tracker);
+    Status st = group->merger.init(suppliers, &group->sort_exprs, is_asc, is_null_first);
+    bool eos = false;
+    while (st.ok()) {
+        ChunkPtr chunk;
+        st = group->merger.get_next(&chunk, &eos);
+        if (!st.ok() || eos) {
+            break;
+        }
+        if (!group->queue.blocking_put(std::move(chunk))) {
+            // the merger is closed
+            CurrentThread::set_mem_tracker(nullptr);
+            return;
+        }
+    }
+    group->status = st;
+    group->queue.blocking_put(ChunkPtr());
+    CurrentThread::set_mem_tracker(nullptr);
+}
+
 void SortedChunksMerger::set_profile(RuntimeProfile* profile) {
     _total_timer = ADD_TIMER(profile, "MergeSortedChunks");
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <memory>
 #include <queue>
 
 #include "runtime/vectorized/chunk_cursor.h"
@@ -9,6 +10,8 @@
 
 namespace starrocks {
 
+class MemTracker;
+class RuntimeState;
 class SortExecExprs;
 
 namespace vectorized {
@@ -19,8 +22,13 @@ public:
     SortedChunksMerger();
     ~SortedChunksMerger();
 
+    // If |num_groups| > 1, the suppliers are merged in |num_groups| groups in parallel, each one of which is
+    // merged on a thread of its own, which prefetches the merged chunks of the group into a queue. get_next merges
+    // the chunks of the groups at last. The sort exprs are cloned by |state| for each group, or shared by the
+    // groups if |state| is nullptr, which is only safe for the slot refs.
     Status init(const ChunkSuppliers& suppliers, const std::vector<ExprContext*>* sort_exprs,
-                const std::vector<bool>* is_asc, const std::vector<bool>* is_null_first);
+                const std::vector<bool>* is_asc, const std::vector<bool>* is_null_first,
+                RuntimeState* state = nullptr, size_t num_groups = 1);
 
     void set_profile(RuntimeProfile* profile);
 
@@ -28,6 +36,11 @@ public:
     Status get_next(ChunkPtr* chunk, bool* eos);
 
 private:
+    struct MergeGroup;
+
+    static void _merge_group(MergeGroup* group, const ChunkSuppliers& suppliers, const std::vector<bool>* is_asc,
+                             const std::vector<bool>* is_null_first, MemTracker* mem_tracker);
+
     ChunkSupplier _single_supplier;
     std::vector<std::unique_ptr<ChunkCursor>> _cursors;
 
@@ -39,6 +52,9 @@ private:
     std::vector<ChunkCursor*> _min_heap;
 
     RuntimeProfile::Counter* _total_timer = nullptr;
+
+    RuntimeState* _state = nullptr;
+    std::vector<std::unique_ptr<MergeGroup>> _groups;
 };
 
 } // namespace vectorized
@@ -1,6 +1,7 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 #include "runtime/vectorized/time_types.h"
 
+#include <cstring>
 #include <string>
 
 #include "gutil/strings/substitute.h"
@@ -337,25 +338,39 @@ bool date::from_string(const char* date_str, size_t len, int* year, int* month,
 
 // Get date base on format "%Y-%m-%d", '-' means any char.
 // compare every char.
+// The byte i of the loaded word is ptr[i] on the little endian machines.
+static inline uint64_t load_8_bytes(const char* ptr) {
+    uint64_t word;
+    memcpy(&word, ptr, sizeof(word));
+    return word;
+}
+
+// Whether the bytes of |word| in the lanes of |digit_lanes|, 0xFF for each lane, are all ASCII digits: the high
+// nibble is 3 and the low nibble + 6 doesn't carry to the high nibble. 8 bytes are validated at a time.
+static inline bool is_digits(uint64_t word, uint64_t digit_lanes) {
+    uint64_t high = (word & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL;
+    uint64_t low = ((word & 0x0F0F0F0F0F0F0F0FULL) + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL;
+    return ((high | low) & digit_lanes) == 0;
+}
+
+static inline int to_digit(char c) {
+    return c - '0';
+}
+
+// The digits of "%Y-%m-" in the first 8 bytes.
+static constexpr uint64_t DATE_DIGIT_LANES = 0x00FFFF00FFFFFFFFULL;
+// The digits of "%H:%i:%s".
+static constexpr uint64_t TIME_DIGIT_LANES = 0xFFFF00FFFF00FFFFULL;
+
 bool date::from_string_to_date_internal(const char* ptr, int* year, int* month, int* day) {
-    uint8_t year1;
-    uint8_t year2;
-    uint8_t year3;
-    uint8_t year4;
-    uint8_t month1;
-    uint8_t month2;
-    uint8_t day1;
-    uint8_t day2;
-    if (char_to_digit(ptr, 0, &year1) || char_to_digit(ptr, 1, &year2) || char_to_digit(ptr, 2, &year3) ||
-        char_to_digit(ptr, 3, &year4) || isdigit(ptr[4]) || char_to_digit(ptr, 5, &month1) ||
-        char_to_digit(ptr, 6, &month2) || isdigit(ptr[7]) || char_to_digit(ptr, 8, &day1) ||
-        char_to_digit(ptr, 9, &day2)) {
+    if (!is_digits(load_8_bytes(ptr), DATE_DIGIT_LANES) || isdigit(ptr[4]) || isdigit(ptr[7]) || !isdigit(ptr[8]) ||
+        !isdigit(ptr[9])) {
         return false;
     }
 
-    *year = year1 * 1000 + year2 * 100 + year3 * 10 + year4;
-    *month = month1 * 10 + month2;
-    *day = day1 * 10 + day2;
+    *year = to_digit(ptr[0]) * 1000 + to_digit(ptr[1]) * 100 + to_digit(ptr[2]) * 10 + to_digit(ptr[3]);
+    *month = to_digit(ptr[5]) * 10 + to_digit(ptr[6]);
+    *day = to_digit(ptr[8]) * 10 + to_digit(ptr[9]);
 
     if (*month > 12 || (*day > DAYS_IN_MONTH[is_leap(*year)][*month])) {
         return false;
@@ -423,37 +438,19 @@ bool date::is_standard_datetime_format(const char* ptr, int length, const char**
 // else return false;
 bool date::from_string_to_datetime_internal(const char* ptr_date, const char* ptr_time, int* year, int* month, int* day,
                                             int* hour, int* minute, int* second, int* microsecond) {
-    uint8_t year1;
-    uint8_t year2;
-    uint8_t year3;
-    uint8_t year4;
-    uint8_t month1;
-    uint8_t month2;
-    uint8_t day1;
-    uint8_t day2;
-
-    uint8_t hour1;
-    uint8_t hour2;
-    uint8_t minute1;
-    uint8_t minute2;
-    uint8_t second1;
-    uint8_t second2;
-    if (char_to_digit(ptr_date, 0, &year1) || char_to_digit(ptr_date, 1, &year2) ||
-        char_to_digit(ptr_date, 2, &year3) || char_to_digit(ptr_date, 3, &year4) || isdigit(ptr_date[4]) ||
-        char_to_digit(ptr_date, 5, &month1) || char_to_digit(ptr_date, 6, &month2) || isdigit(ptr_date[7]) ||
-        char_to_digit(ptr_date, 8, &day1) || char_to_digit(ptr_date, 9, &day2) || char_to_digit(ptr_time, 0, &hour1) ||
-        char_to_digit(ptr_time, 1, &hour2) || isdigit(ptr_time[2]) || char_to_digit(ptr_time, 3, &minute1) ||
-        char_to_digit(ptr_time, 4, &minute2) || isdigit(ptr_time[5]) || char_to_digit(ptr_time, 6, &second1) ||
-        char_to_digit(ptr_time, 7, &second2)) {
+    if (!is_digits(load_8_bytes(ptr_date), DATE_DIGIT_LANES) || isdigit(ptr_date[4]) || isdigit(ptr_date[7]) ||
+        !isdigit(ptr_date[8]) || !isdigit(ptr_date[9]) || !is_digits(load_8_bytes(ptr_time), TIME_DIGIT_LANES) ||
+        isdigit(ptr_time[2]) || isdigit(ptr_time[5])) {
         return false;
     }
 
-    *year = year1 * 1000 + year2 * 100 + year3 * 10 + year4;
-    *month = month1 * 10 + month2;
-    *day = day1 * 10 + day2;
-    *hour = hour1 * 10 + hour2;
-    *minute = minute1 * 10 + minute2;
-    *second = second1 * 10 + second2;
+    *year = to_digit(ptr_date[0]) * 1000 + to_digit(ptr_date[1]) * 100 + to_digit(ptr_date[2]) * 10 +
+            to_digit(ptr_date[3]);
+    *month = to_digit(ptr_date[5]) * 10 + to_digit(ptr_date[6]);
+    *day = to_digit(ptr_date[8]) * 10 + to_digit(ptr_date[9]);
+    *hour = to_digit(ptr_time[0]) * 10 + to_digit(ptr_time[1]);
+    *minute = to_digit(ptr_time[3]) * 10 + to_digit(ptr_time[4]);
+    *second = to_digit(ptr_time[6]) * 10 + to_digit(ptr_time[7]);
     *microsecond = 0;
     if (*month > 12 || (*day > DAYS_IN_MONTH[is_leap(*year)][*month]) || *hour > 23 || *minute > 59 || *second > 59) {
         return false;
@@ -27,6 +27,7 @@
 #include "http/action/meta_action.h"
 #include "http/action/metrics_action.h"
 #include "http/action/pprof_actions.h"
+#include "http/action/query_trace_action.h"
 #include "http/action/reload_tablet_action.h"
 #include "http/action/restore_tablet_action.h"
 #include "http/action/snapshot_action.h"
@@ -90,6 +91,9 @@ Status HttpService::start() {
 
     MetaAction* meta_action = new MetaAction(HEADER);
     _ev_http_server->register_handler(HttpMethod::GET, "/api/meta/header/{tablet_id}/{schema_hash}", meta_action);
+    MetaAction* column_stats_action = new MetaAction(COLUMN_STATS);
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/meta/column_stats/{tablet_id}/{schema_hash}",
+                                      column_stats_action);
 
 #ifndef BE_TEST
     // Register BE checksum action
@@ -108,15 +112,20 @@ Status HttpService::start() {
     _ev_http_server->register_handler(HttpMethod::GET, "/api/snapshot", snapshot_action);
 #endif
 
-    // 2 compaction actions
+    // 3 compaction actions
     CompactionAction* show_compaction_action = new CompactionAction(CompactionActionType::SHOW_INFO);
     _ev_http_server->register_handler(HttpMethod::GET, "/api/compaction/show", show_compaction_action);
     CompactionAction* run_compaction_action = new CompactionAction(CompactionActionType::RUN_COMPACTION);
     _ev_http_server->register_handler(HttpMethod::POST, "/api/compaction/run", run_compaction_action);
+    CompactionAction* show_scheduler_action = new CompactionAction(CompactionActionType::SHOW_SCHEDULER);
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/compaction/scheduler", show_scheduler_action);
 
     UpdateConfigAction* update_config_action = new UpdateConfigAction();
     _ev_http_server->register_handler(HttpMethod::POST, "/api/update_config", update_config_action);
 
+    QueryTraceAction* query_trace_action = new QueryTraceAction();
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/query_trace", query_trace_action);
+
     RETURN_IF_ERROR(_ev_http_server->start());
     return Status::OK();
 }
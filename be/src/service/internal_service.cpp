@@ -34,7 +34,10 @@
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_filter_worker.h"
 #include "service/brpc.h"
+#include "util/query_trace.h"
+#include "util/starrocks_metrics.h"
 #include "util/thrift_util.h"
+#include "util/time.h"
 #include "util/uid_util.h"
 
 namespace starrocks {
@@ -85,20 +88,14 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
     // NOTE: we should give a default value to response to avoid concurrent risk
     // If we don't give response here, stream manager will call done->Run before
     // transmit_data(), which will cause a dirty memory access.
+    int64_t start_us = MonotonicMicros();
+    SCOPED_QUERY_TRACE(request->finst_id().hi(), "rpc", "receive_chunk", request->node_id());
     brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
-    PTransmitChunkParams* req = const_cast<PTransmitChunkParams*>(request);
-    if (cntl->request_attachment().size() > 0) {
-        const butil::IOBuf& io_buf = cntl->request_attachment();
-        size_t offset = 0;
-        for (size_t i = 0; i < req->chunks().size(); ++i) {
-            auto chunk = req->mutable_chunks(i);
-            io_buf.copy_to(chunk->mutable_data(), chunk->data_size(), offset);
-            offset += chunk->data_size();
-        }
-    }
+    // the chunks are deserialized from the attachment directly instead of being copied to the request
+    const butil::IOBuf* attachment = cntl->request_attachment().size() > 0 ? &cntl->request_attachment() : nullptr;
     Status st;
     st.to_protobuf(response->mutable_status());
-    st = _exec_env->stream_mgr()->transmit_chunk(*request, &done);
+    st = _exec_env->stream_mgr()->transmit_chunk(*request, attachment, &done);
     if (!st.ok()) {
         LOG(WARNING) << "transmit_data failed, message=" << st.get_error_msg()
                      << ", fragment_instance_id=" << print_id(request->finst_id()) << ", node=" << request->node_id();
@@ -108,6 +105,7 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
         st.to_protobuf(response->mutable_status());
         done->Run();
     }
+    StarRocksMetrics::instance()->transmit_chunk_latency_us.add(MonotonicMicros() - start_us);
 }
 
 template <typename T>
@@ -144,12 +142,28 @@ void PInternalServiceImpl<T>::exec_plan_fragment(google::protobuf::RpcController
                                                  const PExecPlanFragmentRequest* request,
                                                  PExecPlanFragmentResult* response, google::protobuf::Closure* done) {
     brpc::ClosureGuard closure_guard(done);
+    int64_t start_us = MonotonicMicros();
     brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
     auto st = _exec_plan_fragment(cntl);
     if (!st.ok()) {
         LOG(WARNING) << "exec plan fragment failed, errmsg=" << st.get_error_msg();
     }
     st.to_protobuf(response->mutable_status());
+    StarRocksMetrics::instance()->exec_plan_fragment_latency_us.add(MonotonicMicros() - start_us);
+}
+
+template <typename T>
+void PInternalServiceImpl<T>::exec_batch_plan_fragments(google::protobuf::RpcController* cntl_base,
+                                                        const PExecBatchPlanFragmentsRequest* request,
+                                                        PExecBatchPlanFragmentsResult* response,
+                                                        google::protobuf::Closure* done) {
+    brpc::ClosureGuard closure_guard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
+    auto st = _exec_batch_plan_fragments(cntl);
+    if (!st.ok()) {
+        LOG(WARNING) << "exec batch plan fragments failed, errmsg=" << st.get_error_msg();
+    }
+    st.to_protobuf(response->mutable_status());
 }
 
 template <typename T>
@@ -179,6 +193,7 @@ void PInternalServiceImpl<T>::tablet_writer_add_batch(google::protobuf::RpcContr
         }
         response->set_execution_time_us(execution_time_ns / 1000);
         response->set_wait_lock_time_us(wait_lock_time_ns / 1000);
+        StarRocksMetrics::instance()->tablet_writer_add_chunk_latency_us.add(execution_time_ns / 1000);
     });
 }
 
@@ -209,6 +224,7 @@ void PInternalServiceImpl<T>::tablet_writer_add_chunk(google::protobuf::RpcContr
         }
         response->set_execution_time_us(execution_time_ns / 1000);
         response->set_wait_lock_time_us(wait_lock_time_ns / 1000);
+        StarRocksMetrics::instance()->tablet_writer_add_chunk_latency_us.add(execution_time_ns / 1000);
     });
 }
 
@@ -249,6 +265,34 @@ Status PInternalServiceImpl<T>::_exec_plan_fragment(brpc::Controller* cntl) {
     }
 }
 
+template <typename T>
+Status PInternalServiceImpl<T>::_exec_batch_plan_fragments(brpc::Controller* cntl) {
+    auto ser_request = cntl->request_attachment().to_string();
+    TExecBatchPlanFragmentsParams t_batch_request;
+    {
+        const uint8_t* buf = (const uint8_t*)ser_request.data();
+        uint32_t len = ser_request.size();
+        RETURN_IF_ERROR(deserialize_thrift_msg(buf, &len, false, &t_batch_request));
+    }
+    const TExecPlanFragmentParams& common_request = t_batch_request.common_param;
+    bool is_pipeline = common_request.__isset.is_pipeline && common_request.is_pipeline;
+    LOG(INFO) << "exec batch plan fragments, num_instances=" << t_batch_request.unique_param_per_instance.size()
+              << ", coord=" << common_request.coord << " is_pipeline " << is_pipeline;
+    if (is_pipeline) {
+        for (const auto& unique_request : t_batch_request.unique_param_per_instance) {
+            TExecPlanFragmentParams t_request = common_request;
+            t_request.__set_params(unique_request.params);
+            t_request.__set_backend_num(unique_request.backend_num);
+            auto fragment_executor = std::make_unique<starrocks::pipeline::FragmentExecutor>();
+            RETURN_IF_ERROR(fragment_executor->prepare(_exec_env, t_request));
+            RETURN_IF_ERROR(fragment_executor->execute(_exec_env));
+        }
+        return Status::OK();
+    } else {
+        return _exec_env->fragment_mgr()->exec_batch_plan_fragments(t_batch_request);
+    }
+}
+
 inline std::string cancel_reason_to_string(::starrocks::PPlanFragmentCancelReason reason) {
     switch (reason) {
     case LIMIT_REACH:
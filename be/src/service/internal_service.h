@@ -54,6 +54,10 @@ public:
     void exec_plan_fragment(google::protobuf::RpcController* controller, const PExecPlanFragmentRequest* request,
                             PExecPlanFragmentResult* result, google::protobuf::Closure* done) override;
 
+    void exec_batch_plan_fragments(google::protobuf::RpcController* controller,
+                                   const PExecBatchPlanFragmentsRequest* request, PExecBatchPlanFragmentsResult* result,
+                                   google::protobuf::Closure* done) override;
+
     void cancel_plan_fragment(google::protobuf::RpcController* controller, const PCancelPlanFragmentRequest* request,
                               PCancelPlanFragmentResult* result, google::protobuf::Closure* done) override;
 
@@ -84,6 +88,8 @@ public:
 private:
     Status _exec_plan_fragment(brpc::Controller* cntl);
 
+    Status _exec_batch_plan_fragments(brpc::Controller* cntl);
+
 private:
     ExecEnv* _exec_env;
     PriorityThreadPool _tablet_worker_pool;
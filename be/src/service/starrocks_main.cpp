@@ -49,6 +49,7 @@
 #include "service/http_service.h"
 #include "storage/options.h"
 #include "storage/storage_engine.h"
+#include "util/cpu_sampler.h"
 #include "util/debug_util.h"
 #include "util/file_utils.h"
 #include "util/logging.h"
@@ -77,11 +78,15 @@ static void thrift_output(const char* x) {
 } // namespace starrocks
 
 extern int meta_tool_main(int argc, char** argv);
+extern int segment_bench_main(int argc, char** argv);
 
 int main(int argc, char** argv) {
     if (argc > 1 && strcmp(argv[1], "meta_tool") == 0) {
         return meta_tool_main(argc - 1, argv + 1);
     }
+    if (argc > 1 && strcmp(argv[1], "segment_bench") == 0) {
+        return segment_bench_main(argc - 1, argv + 1);
+    }
     // check if print version or help
     if (argc > 1) {
         if (strcmp(argv[1], "--version") == 0 || strcmp(argv[1], "-v") == 0) {
@@ -214,6 +219,14 @@ int main(int argc, char** argv) {
     // SHOULD be called after exec env is initialized.
     EXIT_IF_ERROR(engine->start_bg_threads());
 
+    if (starrocks::config::enable_cpu_sampler) {
+        auto sampler_st = starrocks::CpuSampler::instance()->start(starrocks::config::cpu_sampler_frequency,
+                                                                  starrocks::config::cpu_sampler_buffer_samples);
+        if (!sampler_st.ok()) {
+            LOG(WARNING) << "Fail to start the cpu sampler: " << sampler_st.to_string();
+        }
+    }
+
     // begin to start services
     starrocks::ThriftRpcHelper::setup(exec_env);
     // 1. thrift server with be_port
@@ -19,4 +19,439 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#include "simd/simd.h"
\ No newline at end of file
+#include "simd/simd.h"
+
+#include <algorithm>
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "common/logging.h"
+#include "util/cpu_info.h"
+
+namespace SIMD {
+
+using starrocks::CpuInfo;
+
+// The dispatched kernels.
+struct Kernels {
+    size_t (*filter_range_8)(const uint8_t* filter, uint8_t* data, size_t from, size_t to);
+    size_t (*filter_range_16)(const uint8_t* filter, uint16_t* data, size_t from, size_t to);
+    size_t (*filter_range_32)(const uint8_t* filter, uint32_t* data, size_t from, size_t to);
+    size_t (*filter_range_64)(const uint8_t* filter, uint64_t* data, size_t from, size_t to);
+    uint16_t (*selection_to_indexes)(const uint8_t* selection, uint16_t from, uint16_t to, uint16_t* indexes);
+    void (*bitmap_to_bytes)(const uint8_t* bitmap, size_t num_bits, uint8_t* bytes, bool negate);
+    void (*bytes_to_bitmap)(const uint8_t* bytes, size_t num_bytes, uint8_t* bitmap);
+    void (*gather_32)(const uint32_t* src, const uint32_t* indexes, size_t size, uint32_t* dst);
+    void (*gather_64)(const uint64_t* src, const uint32_t* indexes, size_t size, uint64_t* dst);
+    void (*min_max_32)(const int32_t* data, size_t size, int32_t* min, int32_t* max);
+    void (*min_max_64)(const int64_t* data, size_t size, int64_t* min, int64_t* max);
+    size_t (*find_nonzero)(const uint8_t* data, size_t size);
+    const char* isa;
+};
+
+// The kernels of the build target.
+namespace portable {
+
+static uint16_t selection_to_indexes(const uint8_t* selection, uint16_t from, uint16_t to, uint16_t* indexes) {
+    uint16_t size = 0;
+    for (uint16_t i = from; i < to; ++i) {
+        indexes[size] = i;
+        size += (selection[i] != 0);
+    }
+    return size;
+}
+
+static void bitmap_to_bytes(const uint8_t* bitmap, size_t num_bits, uint8_t* bytes, bool negate) {
+    size_t i = 0;
+#ifdef __AVX2__
+    // byte j of the output takes the byte j / 8 of the 32 bits and tests the bit j % 8 of it.
+    const __m256i shuffle = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3,
+                                             3, 3, 3, 3, 3, 3, 3);
+    const __m256i bit_mask = _mm256_set1_epi64x(0x8040201008040201);
+    const __m256i ones = _mm256_set1_epi8(1);
+    for (; i + 32 <= num_bits; i += 32) {
+        uint32_t bits;
+        memcpy(&bits, bitmap + i / 8, sizeof(bits));
+        __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(bits), shuffle);
+        __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(v, bit_mask), bit_mask);
+        __m256i result = negate ? _mm256_andnot_si256(set, ones) : _mm256_and_si256(set, ones);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(bytes + i), result);
+    }
+#endif
+    for (; i < num_bits; ++i) {
+        bytes[i] = ((bitmap[i / 8] >> (i % 8)) & 1) ^ negate;
+    }
+}
+
+static void bytes_to_bitmap(const uint8_t* bytes, size_t num_bytes, uint8_t* bitmap) {
+    size_t i = 0;
+#ifdef __AVX2__
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 32 <= num_bytes; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+        uint32_t bits = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+        memcpy(bitmap + i / 8, &bits, sizeof(bits));
+    }
+#endif
+    // |i| is a multiple of 8 here.
+    for (; i < num_bytes; ++i) {
+        if (i % 8 == 0) {
+            bitmap[i / 8] = 0;
+        }
+        bitmap[i / 8] |= static_cast<uint8_t>(bytes[i] != 0) << (i % 8);
+    }
+}
+
+template <typename T>
+static void gather(const T* src, const uint32_t* indexes, size_t size, T* dst) {
+    for (size_t i = 0; i < size; i++) {
+        dst[i] = src[indexes[i]];
+    }
+}
+
+template <typename T>
+static void min_max(const T* data, size_t size, T* min, T* max) {
+    // the compiler vectorizes the loop by the build target.
+    T min_value = data[0];
+    T max_value = data[0];
+    for (size_t i = 1; i < size; i++) {
+        min_value = std::min(min_value, data[i]);
+        max_value = std::max(max_value, data[i]);
+    }
+    *min = min_value;
+    *max = max_value;
+}
+
+static size_t find_nonzero(const uint8_t* data, size_t size) {
+    size_t i = 0;
+#ifdef __AVX2__
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (data[i] != 0) {
+            return i;
+        }
+    }
+    return size;
+}
+
+static constexpr Kernels kKernels = {
+        detail::filter_range_default<uint8_t>,
+        detail::filter_range_default<uint16_t>,
+        detail::filter_range_default<uint32_t>,
+        detail::filter_range_default<uint64_t>,
+        selection_to_indexes,
+        bitmap_to_bytes,
+        bytes_to_bitmap,
+        gather<uint32_t>,
+        gather<uint64_t>,
+        min_max<int32_t>,
+        min_max<int64_t>,
+        find_nonzero,
+#ifdef __AVX2__
+        "avx2",
+#else
+        "default",
+#endif
+};
+
+} // namespace portable
+
+#ifdef __x86_64__
+// The kernels of AVX-512, compiled for the instruction sets by the target attributes and selected only on the cpus
+// supporting them. The ones of 8-bit and 16-bit elements need VBMI2.
+namespace avx512 {
+
+#define AVX512_TARGET __attribute__((target("avx512f,avx512bw,avx512vl,popcnt")))
+#define AVX512_VBMI2_TARGET __attribute__((target("avx512f,avx512bw,avx512vl,avx512vbmi2,popcnt")))
+
+// The compressed elements are stored by a full vector at |result_offset|, which does not exceed |start_offset|, so
+// only the elements loaded already are overwritten. The vector is stored instead of vpcompress to the memory, which
+// is much slower on some cpus.
+AVX512_VBMI2_TARGET static size_t filter_range_8(const uint8_t* filter, uint8_t* data, size_t from, size_t to) {
+    size_t start_offset = from;
+    size_t result_offset = from;
+    for (; start_offset + 64 <= to; start_offset += 64) {
+        __m512i f = _mm512_loadu_si512(filter + start_offset);
+        __mmask64 mask = _mm512_test_epi8_mask(f, f);
+        if (mask == 0) {
+            continue;
+        }
+        __m512i v = _mm512_loadu_si512(data + start_offset);
+        _mm512_storeu_si512(data + result_offset, _mm512_maskz_compress_epi8(mask, v));
+        result_offset += _mm_popcnt_u64(mask);
+    }
+    for (size_t i = start_offset; i < to; ++i) {
+        data[result_offset] = data[i];
+        result_offset += (filter[i] != 0);
+    }
+    return result_offset;
+}
+
+AVX512_VBMI2_TARGET static size_t filter_range_16(const uint8_t* filter, uint16_t* data, size_t from, size_t to) {
+    size_t start_offset = from;
+    size_t result_offset = from;
+    for (; start_offset + 32 <= to; start_offset += 32) {
+        __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(filter + start_offset));
+        __mmask32 mask = _mm256_test_epi8_mask(f, f);
+        if (mask == 0) {
+            continue;
+        }
+        __m512i v = _mm512_loadu_si512(data + start_offset);
+        _mm512_storeu_si512(data + result_offset, _mm512_maskz_compress_epi16(mask, v));
+        result_offset += _mm_popcnt_u32(mask);
+    }
+    for (size_t i = start_offset; i < to; ++i) {
+        data[result_offset] = data[i];
+        result_offset += (filter[i] != 0);
+    }
+    return result_offset;
+}
+
+AVX512_TARGET static size_t filter_range_32(const uint8_t* filter, uint32_t* data, size_t from, size_t to) {
+    size_t start_offset = from;
+    size_t result_offset = from;
+    for (; start_offset + 16 <= to; start_offset += 16) {
+        __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(filter + start_offset));
+        __mmask16 mask = _mm_test_epi8_mask(f, f);
+        if (mask == 0) {
+            continue;
+        }
+        __m512i v = _mm512_loadu_si512(data + start_offset);
+        _mm512_storeu_si512(data + result_offset, _mm512_maskz_compress_epi32(mask, v));
+        result_offset += _mm_popcnt_u32(mask);
+    }
+    for (size_t i = start_offset; i < to; ++i) {
+        data[result_offset] = data[i];
+        result_offset += (filter[i] != 0);
+    }
+    return result_offset;
+}
+
+AVX512_TARGET static size_t filter_range_64(const uint8_t* filter, uint64_t* data, size_t from, size_t to) {
+    size_t start_offset = from;
+    size_t result_offset = from;
+    for (; start_offset + 8 <= to; start_offset += 8) {
+        __m128i f = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(filter + start_offset));
+        auto mask = static_cast<__mmask8>(_mm_test_epi8_mask(f, f));
+        if (mask == 0) {
+            continue;
+        }
+        __m512i v = _mm512_loadu_si512(data + start_offset);
+        _mm512_storeu_si512(data + result_offset, _mm512_maskz_compress_epi64(mask, v));
+        result_offset += _mm_popcnt_u32(mask);
+    }
+    for (size_t i = start_offset; i < to; ++i) {
+        data[result_offset] = data[i];
+        result_offset += (filter[i] != 0);
+    }
+    return result_offset;
+}
+
+// The indexes are compressed from the vector of 32 indexes, the vector stored at |size| does not exceed to - from
+// elements since |size| is at most i - from.
+AVX512_VBMI2_TARGET static uint16_t selection_to_indexes(const uint8_t* selection, uint16_t from, uint16_t to,
+                                                         uint16_t* indexes) {
+    alignas(64) static const uint16_t kIota[32] = {0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15,
+                                                   16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31};
+    uint16_t size = 0;
+    uint32_t i = from;
+    __m512i index = _mm512_add_epi16(_mm512_load_si512(kIota), _mm512_set1_epi16(from));
+    const __m512i step = _mm512_set1_epi16(32);
+    for (; i + 32 <= to; i += 32) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(selection + i));
+        __mmask32 mask = _mm256_test_epi8_mask(s, s);
+        _mm512_storeu_si512(indexes + size, _mm512_maskz_compress_epi16(mask, index));
+        size += _mm_popcnt_u32(mask);
+        index = _mm512_add_epi16(index, step);
+    }
+    for (; i < to; ++i) {
+        indexes[size] = i;
+        size += (selection[i] != 0);
+    }
+    return size;
+}
+
+AVX512_TARGET static void bitmap_to_bytes(const uint8_t* bitmap, size_t num_bits, uint8_t* bytes, bool negate) {
+    size_t i = 0;
+    const __m512i ones = _mm512_set1_epi8(1);
+    for (; i + 64 <= num_bits; i += 64) {
+        uint64_t bits;
+        memcpy(&bits, bitmap + i / 8, sizeof(bits));
+        _mm512_storeu_si512(bytes + i, _mm512_maskz_mov_epi8(negate ? ~bits : bits, ones));
+    }
+    portable::bitmap_to_bytes(bitmap + i / 8, num_bits - i, bytes + i, negate);
+}
+
+AVX512_TARGET static void bytes_to_bitmap(const uint8_t* bytes, size_t num_bytes, uint8_t* bitmap) {
+    size_t i = 0;
+    for (; i + 64 <= num_bytes; i += 64) {
+        __m512i v = _mm512_loadu_si512(bytes + i);
+        uint64_t bits = _mm512_test_epi8_mask(v, v);
+        memcpy(bitmap + i / 8, &bits, sizeof(bits));
+    }
+    portable::bytes_to_bitmap(bytes + i, num_bytes - i, bitmap + i / 8);
+}
+
+// The indexes are less than 2^31 and taken as the signed offsets by the instructions.
+AVX512_TARGET static void gather_32(const uint32_t* src, const uint32_t* indexes, size_t size, uint32_t* dst) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m512i index = _mm512_loadu_si512(indexes + i);
+        _mm512_storeu_si512(dst + i, _mm512_i32gather_epi32(index, src, 4));
+    }
+    portable::gather(src, indexes + i, size - i, dst + i);
+}
+
+AVX512_TARGET static void gather_64(const uint64_t* src, const uint32_t* indexes, size_t size, uint64_t* dst) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indexes + i));
+        _mm512_storeu_si512(dst + i, _mm512_i32gather_epi64(index, src, 8));
+    }
+    portable::gather(src, indexes + i, size - i, dst + i);
+}
+
+AVX512_TARGET static void min_max_32(const int32_t* data, size_t size, int32_t* min, int32_t* max) {
+    if (size < 16) {
+        return portable::min_max(data, size, min, max);
+    }
+    __m512i min_value = _mm512_loadu_si512(data);
+    __m512i max_value = min_value;
+    size_t i = 16;
+    for (; i + 16 <= size; i += 16) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        min_value = _mm512_min_epi32(min_value, v);
+        max_value = _mm512_max_epi32(max_value, v);
+    }
+    // the last vector overlaps the ones reduced, which does not change the result.
+    __m512i v = _mm512_loadu_si512(data + size - 16);
+    *min = _mm512_reduce_min_epi32(_mm512_min_epi32(min_value, v));
+    *max = _mm512_reduce_max_epi32(_mm512_max_epi32(max_value, v));
+}
+
+AVX512_TARGET static void min_max_64(const int64_t* data, size_t size, int64_t* min, int64_t* max) {
+    if (size < 8) {
+        return portable::min_max(data, size, min, max);
+    }
+    __m512i min_value = _mm512_loadu_si512(data);
+    __m512i max_value = min_value;
+    size_t i = 8;
+    for (; i + 8 <= size; i += 8) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        min_value = _mm512_min_epi64(min_value, v);
+        max_value = _mm512_max_epi64(max_value, v);
+    }
+    __m512i v = _mm512_loadu_si512(data + size - 8);
+    *min = _mm512_reduce_min_epi64(_mm512_min_epi64(min_value, v));
+    *max = _mm512_reduce_max_epi64(_mm512_max_epi64(max_value, v));
+}
+
+AVX512_TARGET static size_t find_nonzero(const uint8_t* data, size_t size) {
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        __mmask64 mask = _mm512_test_epi8_mask(v, v);
+        if (mask != 0) {
+            return i + __builtin_ctzll(mask);
+        }
+    }
+    return i + portable::find_nonzero(data + i, size - i);
+}
+
+#undef AVX512_TARGET
+#undef AVX512_VBMI2_TARGET
+
+} // namespace avx512
+#endif
+
+static Kernels s_kernels = portable::kKernels;
+
+void init() {
+    Kernels kernels = portable::kKernels;
+#ifdef __x86_64__
+    if (CpuInfo::is_supported(CpuInfo::AVX512F) && CpuInfo::is_supported(CpuInfo::AVX512BW) &&
+        CpuInfo::is_supported(CpuInfo::AVX512VL)) {
+        kernels.filter_range_32 = avx512::filter_range_32;
+        kernels.filter_range_64 = avx512::filter_range_64;
+        kernels.bitmap_to_bytes = avx512::bitmap_to_bytes;
+        kernels.bytes_to_bitmap = avx512::bytes_to_bitmap;
+        kernels.gather_32 = avx512::gather_32;
+        kernels.gather_64 = avx512::gather_64;
+        kernels.min_max_32 = avx512::min_max_32;
+        kernels.min_max_64 = avx512::min_max_64;
+        kernels.find_nonzero = avx512::find_nonzero;
+        kernels.isa = "avx512";
+        if (CpuInfo::is_supported(CpuInfo::AVX512VBMI2)) {
+            kernels.filter_range_8 = avx512::filter_range_8;
+            kernels.filter_range_16 = avx512::filter_range_16;
+            kernels.selection_to_indexes = avx512::selection_to_indexes;
+            kernels.isa = "avx512_vbmi2";
+        }
+    }
+#endif
+    s_kernels = kernels;
+    LOG(INFO) << "SIMD kernels: " << s_kernels.isa;
+}
+
+const char* kernel_isa() {
+    return s_kernels.isa;
+}
+
+size_t filter_range(const uint8_t* filter, uint8_t* data, size_t from, size_t to) {
+    return s_kernels.filter_range_8(filter, data, from, to);
+}
+
+size_t filter_range(const uint8_t* filter, uint16_t* data, size_t from, size_t to) {
+    return s_kernels.filter_range_16(filter, data, from, to);
+}
+
+size_t filter_range(const uint8_t* filter, uint32_t* data, size_t from, size_t to) {
+    return s_kernels.filter_range_32(filter, data, from, to);
+}
+
+size_t filter_range(const uint8_t* filter, uint64_t* data, size_t from, size_t to) {
+    return s_kernels.filter_range_64(filter, data, from, to);
+}
+
+uint16_t selection_to_indexes(const uint8_t* selection, uint16_t from, uint16_t to, uint16_t* indexes) {
+    return s_kernels.selection_to_indexes(selection, from, to, indexes);
+}
+
+void bitmap_to_bytes(const uint8_t* bitmap, size_t num_bits, uint8_t* bytes, bool negate) {
+    s_kernels.bitmap_to_bytes(bitmap, num_bits, bytes, negate);
+}
+
+void bytes_to_bitmap(const uint8_t* bytes, size_t num_bytes, uint8_t* bitmap) {
+    s_kernels.bytes_to_bitmap(bytes, num_bytes, bitmap);
+}
+
+void gather(const uint32_t* src, const uint32_t* indexes, size_t size, uint32_t* dst) {
+    s_kernels.gather_32(src, indexes, size, dst);
+}
+
+void gather(const uint64_t* src, const uint32_t* indexes, size_t size, uint64_t* dst) {
+    s_kernels.gather_64(src, indexes, size, dst);
+}
+
+void min_max(const int32_t* data, size_t size, int32_t* min, int32_t* max) {
+    s_kernels.min_max_32(data, size, min, max);
+}
+
+void min_max(const int64_t* data, size_t size, int64_t* min, int64_t* max) {
+    s_kernels.min_max_64(data, size, min, max);
+}
+
+size_t find_nonzero(const uint8_t* data, size_t size) {
+    return s_kernels.find_nonzero(data, size);
+}
+
+} // namespace SIMD
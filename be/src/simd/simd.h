@@ -22,10 +22,15 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <vector>
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 namespace SIMD {
 
@@ -94,4 +99,134 @@ inline size_t count_nonzero(const std::vector<int8_t>& list) {
     return count_nonzero(list.data(), list.size());
 }
 
+// The kernels below are dispatched at runtime. The ones of the build target, e.g. AVX2 of the default x86 builds,
+// are used until init() selects the AVX-512 ones on the cpus supporting them, so that one portable binary still
+// uses the widest instructions of the host.
+
+// Selects the kernels by the instruction sets of CpuInfo, called at startup after CpuInfo::init().
+void init();
+
+// The instruction set of the kernels selected, e.g. "avx512" or "avx512_vbmi2".
+const char* kernel_isa();
+
+// Moves the elements of data[from, to) whose filter is nonzero to data[from, ...) in order, returns the end of them.
+size_t filter_range(const uint8_t* filter, uint8_t* data, size_t from, size_t to);
+size_t filter_range(const uint8_t* filter, uint16_t* data, size_t from, size_t to);
+size_t filter_range(const uint8_t* filter, uint32_t* data, size_t from, size_t to);
+size_t filter_range(const uint8_t* filter, uint64_t* data, size_t from, size_t to);
+
+namespace detail {
+
+// The filter of the build target, the runs of 32 unselected rows are skipped and the runs of 32 selected rows are
+// moved at a time.
+template <typename T>
+inline size_t filter_range_default(const uint8_t* filter, T* data, size_t from, size_t to) {
+    size_t start_offset = from;
+    size_t result_offset = from;
+#ifdef __AVX2__
+    constexpr size_t kBatchNums = 32;
+    const __m256i all0 = _mm256_setzero_si256();
+    while (start_offset + kBatchNums < to) {
+        __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(filter + start_offset));
+        uint32_t mask = _mm256_movemask_epi8(_mm256_cmpgt_epi8(f, all0));
+        if (mask == 0) {
+            // all no hit, pass
+        } else if (mask == 0xffffffff) {
+            // all hit, copy all
+            memmove(data + result_offset, data + start_offset, kBatchNums * sizeof(T));
+            result_offset += kBatchNums;
+        } else {
+            // skip the rows not hit, which reduces the compares when the filter is sparse like "00010001...".
+            while (mask != 0) {
+                *(data + result_offset) = *(data + start_offset + __builtin_ctz(mask));
+                result_offset++;
+                mask &= mask - 1;
+            }
+        }
+        start_offset += kBatchNums;
+    }
+#endif
+    for (size_t i = start_offset; i < to; ++i) {
+        if (filter[i]) {
+            *(data + result_offset) = *(data + i);
+            result_offset++;
+        }
+    }
+    return result_offset;
+}
+
+template <typename T, size_t size>
+inline constexpr bool is_word_of = std::is_trivially_copyable_v<T> && sizeof(T) == size;
+
+} // namespace detail
+
+template <typename T>
+inline size_t filter_range(const uint8_t* filter, T* data, size_t from, size_t to) {
+    if constexpr (detail::is_word_of<T, 1>) {
+        return filter_range(filter, reinterpret_cast<uint8_t*>(data), from, to);
+    } else if constexpr (detail::is_word_of<T, 2>) {
+        return filter_range(filter, reinterpret_cast<uint16_t*>(data), from, to);
+    } else if constexpr (detail::is_word_of<T, 4>) {
+        return filter_range(filter, reinterpret_cast<uint32_t*>(data), from, to);
+    } else if constexpr (detail::is_word_of<T, 8>) {
+        return filter_range(filter, reinterpret_cast<uint64_t*>(data), from, to);
+    } else {
+        return detail::filter_range_default(filter, data, from, to);
+    }
+}
+
+// Stores the indexes in [from, to) whose selection is nonzero to |indexes| in order, returns the number of them.
+// |indexes| holds at least to - from elements.
+uint16_t selection_to_indexes(const uint8_t* selection, uint16_t from, uint16_t to, uint16_t* indexes);
+
+// Expands the bitmap of |num_bits| bits, the bit i is the bit (i % 8) of the byte (i / 8), to one byte per bit in
+// |bytes|, the byte is 1 for a set bit, or for an unset bit if |negate|.
+void bitmap_to_bytes(const uint8_t* bitmap, size_t num_bits, uint8_t* bytes, bool negate = false);
+
+// Packs |num_bytes| bytes to the bitmap, the bit is set for a nonzero byte. The unused bits of the last byte of the
+// bitmap are cleared.
+void bytes_to_bitmap(const uint8_t* bytes, size_t num_bytes, uint8_t* bitmap);
+
+// dst[i] = src[indexes[i]] for i in [0, size).
+void gather(const uint32_t* src, const uint32_t* indexes, size_t size, uint32_t* dst);
+void gather(const uint64_t* src, const uint32_t* indexes, size_t size, uint64_t* dst);
+
+template <typename T>
+inline void gather(const T* src, const uint32_t* indexes, size_t size, T* dst) {
+    if constexpr (detail::is_word_of<T, 4>) {
+        gather(reinterpret_cast<const uint32_t*>(src), indexes, size, reinterpret_cast<uint32_t*>(dst));
+    } else if constexpr (detail::is_word_of<T, 8>) {
+        gather(reinterpret_cast<const uint64_t*>(src), indexes, size, reinterpret_cast<uint64_t*>(dst));
+    } else {
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = src[indexes[i]];
+        }
+    }
+}
+
+// The min and the max of the |size| values, |size| should be positive.
+void min_max(const int32_t* data, size_t size, int32_t* min, int32_t* max);
+void min_max(const int64_t* data, size_t size, int64_t* min, int64_t* max);
+
+// Returns the index of the first nonzero byte of |data|, or |size| if all the bytes are zero.
+size_t find_nonzero(const uint8_t* data, size_t size);
+
+// Returns the index of the first zero byte of |data|, or |size| if all the bytes are nonzero.
+inline size_t find_zero(const uint8_t* data, size_t size) {
+    const void* p = size > 0 ? memchr(data, 0, size) : nullptr;
+    return p == nullptr ? size : static_cast<const uint8_t*>(p) - data;
+}
+
+inline bool contain_nonzero(const uint8_t* data, size_t size) {
+    return find_nonzero(data, size) < size;
+}
+
+inline bool contain_nonzero(const std::vector<uint8_t>& list) {
+    return contain_nonzero(list.data(), list.size());
+}
+
+inline bool contain_zero(const uint8_t* data, size_t size) {
+    return find_zero(data, size) < size;
+}
+
 } // namespace SIMD
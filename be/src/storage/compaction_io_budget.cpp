@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/compaction_io_budget.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+// The throughputs are smoothed by the exponential moving average updated every second at most.
+static constexpr int64_t kUpdateIntervalMs = 1000;
+static constexpr double kSmoothFactor = 0.5;
+
+void CompactionIOBudget::_refill(int64_t now_ms) {
+    if (_last_refill_ms < 0) {
+        _last_refill_ms = now_ms;
+        _last_update_ms = now_ms;
+        _last_query_bytes = _query_bytes.load(std::memory_order_relaxed);
+    }
+    if (now_ms - _last_update_ms >= kUpdateIntervalMs) {
+        int64_t query_bytes = _query_bytes.load(std::memory_order_relaxed);
+        double elapsed_sec = (now_ms - _last_update_ms) / 1000.0;
+        _query_bytes_per_sec = kSmoothFactor * _query_bytes_per_sec +
+                               (1 - kSmoothFactor) * (query_bytes - _last_query_bytes) / elapsed_sec;
+        _compaction_bytes_per_sec = kSmoothFactor * _compaction_bytes_per_sec +
+                                    (1 - kSmoothFactor) * (_compaction_bytes - _last_compaction_bytes) / elapsed_sec;
+        _last_update_ms = now_ms;
+        _last_query_bytes = query_bytes;
+        _last_compaction_bytes = _compaction_bytes;
+    }
+
+    int64_t budget = config::compaction_io_budget_mb_per_sec * 1024 * 1024;
+    if (budget <= 0) {
+        _rate = 0;
+        _tokens = 0;
+    } else {
+        int64_t min_rate = std::min(budget, config::compaction_io_min_mb_per_sec * 1024 * 1024);
+        _rate = std::max<int64_t>(min_rate, budget - static_cast<int64_t>(_query_bytes_per_sec));
+        _tokens = std::min<double>(_rate, _tokens + _rate * (now_ms - _last_refill_ms) / 1000.0);
+    }
+    _last_refill_ms = now_ms;
+}
+
+bool CompactionIOBudget::can_start_compaction(int64_t now_ms) {
+    std::lock_guard l(_mutex);
+    _refill(now_ms);
+    if (_rate > 0 && _tokens < 0) {
+        _throttled++;
+        return false;
+    }
+    return true;
+}
+
+void CompactionIOBudget::charge_compaction(int64_t bytes, int64_t now_ms) {
+    std::lock_guard l(_mutex);
+    _refill(now_ms);
+    _compaction_bytes += bytes;
+    if (_rate > 0) {
+        _tokens -= bytes;
+    }
+}
+
+CompactionIOBudget::Stats CompactionIOBudget::get_stats(int64_t now_ms) {
+    std::lock_guard l(_mutex);
+    _refill(now_ms);
+    Stats stats;
+    stats.rate = _rate;
+    stats.tokens = static_cast<int64_t>(_tokens);
+    stats.query_bytes_per_sec = static_cast<int64_t>(_query_bytes_per_sec);
+    stats.compaction_bytes_per_sec = static_cast<int64_t>(_compaction_bytes_per_sec);
+    stats.throttled = _throttled;
+    return stats;
+}
+
+} // namespace starrocks
@@ -0,0 +1,67 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "util/time.h"
+
+namespace starrocks {
+
+// The IO budget of the compactions on a DataDir, which is a token bucket refilled at the rate of
+// config::compaction_io_budget_mb_per_sec less the recent read throughput of the queries on the DataDir, but
+// no lower than config::compaction_io_min_mb_per_sec.
+//
+// A compaction is charged the bytes it reads and writes when it starts, and it may start only if the bucket
+// isn't in debt. So a big compaction drives the bucket into debt, which defers the next compactions until the
+// debt is repaid by the refills. The bucket holds at most one second of the refills.
+class CompactionIOBudget {
+public:
+    struct Stats {
+        // The current refill rate in bytes per second, 0 means no limit.
+        int64_t rate = 0;
+        int64_t tokens = 0;
+        int64_t query_bytes_per_sec = 0;
+        int64_t compaction_bytes_per_sec = 0;
+        // The number of times a compaction was deferred by the budget.
+        int64_t throttled = 0;
+    };
+
+    CompactionIOBudget() = default;
+
+    // Called by the scans of the tablets on the DataDir with the bytes they read from the disk.
+    void add_query_bytes(int64_t bytes) { _query_bytes.fetch_add(bytes, std::memory_order_relaxed); }
+
+    // Returns true if a compaction may start now.
+    bool can_start_compaction() { return can_start_compaction(MonotonicMillis()); }
+    bool can_start_compaction(int64_t now_ms);
+
+    // Charge the |bytes| read and written by a starting compaction.
+    void charge_compaction(int64_t bytes) { charge_compaction(bytes, MonotonicMillis()); }
+    void charge_compaction(int64_t bytes, int64_t now_ms);
+
+    Stats get_stats() { return get_stats(MonotonicMillis()); }
+    Stats get_stats(int64_t now_ms);
+
+private:
+    void _refill(int64_t now_ms);
+
+    std::atomic<int64_t> _query_bytes{0};
+
+    std::mutex _mutex;
+    int64_t _last_refill_ms = -1;
+    // The query bytes and the compaction bytes at the last update of the throughputs.
+    int64_t _last_update_ms = -1;
+    int64_t _last_query_bytes = 0;
+    int64_t _last_compaction_bytes = 0;
+    int64_t _compaction_bytes = 0;
+    double _query_bytes_per_sec = 0;
+    double _compaction_bytes_per_sec = 0;
+    int64_t _rate = 0;
+    double _tokens = 0;
+    int64_t _throttled = 0;
+};
+
+} // namespace starrocks
@@ -31,11 +31,15 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <algorithm>
 #include <boost/algorithm/string/trim.hpp>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
+#include <tuple>
 
 #include "env/env.h"
 #include "gen_cpp/version.h"
@@ -454,10 +458,12 @@ OLAPStatus DataDir::load() {
     LOG(INFO) << "begin loading tablet from meta";
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](int64_t tablet_id, int32_t schema_hash,
-                                                                    const std::string& value) -> bool {
+    std::mutex tablet_ids_lock;
+    auto load_tablet = [this, &tablet_ids, &failed_tablet_ids, &tablet_ids_lock](
+                               int64_t tablet_id, int32_t schema_hash, const std::string& value) {
         Status st =
                 _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value, false, false, false, false);
+        std::lock_guard l(tablet_ids_lock);
         if (!st.ok() && !st.is_not_found()) {
             // load_tablet_from_meta() may return NotFound which means the tablet status is DELETED
             // This may happen when the tablet was just deleted before the BE restarted,
@@ -471,9 +477,40 @@ OLAPStatus DataDir::load() {
         } else {
             tablet_ids.insert(tablet_id);
         }
+    };
+    // The tablet metas are parsed and the tablets are initialized by several threads, a batch of the headers at a
+    // time to bound the memory. The headers of a tablet are loaded by the same thread in order, as the serial
+    // loading does, so the one of them kept by the tablet manager is the same.
+    constexpr size_t kLoadTabletBatchSize = 4096;
+    const int num_threads = std::max(1, config::load_tablet_meta_threads_per_dir);
+    std::vector<std::tuple<int64_t, int32_t, std::string>> headers;
+    auto load_headers = [&]() {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                for (const auto& [tablet_id, schema_hash, value] : headers) {
+                    if (tablet_id % num_threads == t) {
+                        load_tablet(tablet_id, schema_hash, value);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        headers.clear();
+    };
+    auto load_tablet_func = [&](int64_t tablet_id, int32_t schema_hash, const std::string& value) -> bool {
+        headers.emplace_back(tablet_id, schema_hash, value);
+        if (headers.size() >= kLoadTabletBatchSize) {
+            load_headers();
+        }
         return true;
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    if (!headers.empty()) {
+        load_headers();
+    }
     if (failed_tablet_ids.size() != 0) {
         LOG(ERROR) << "load tablets from header failed"
                    << ", loaded tablet: " << tablet_ids.size() << ", error tablet: " << failed_tablet_ids.size()
@@ -31,6 +31,7 @@
 #include "common/status.h"
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/olap_file.pb.h"
+#include "storage/compaction_io_budget.h"
 #include "storage/olap_common.h"
 #include "storage/olap_meta.h"
 #include "storage/rowset/rowset_id_generator.h"
@@ -121,6 +122,8 @@ public:
 
     Status update_capacity();
 
+    CompactionIOBudget* compaction_io_budget() { return &_compaction_io_budget; }
+
 private:
     std::string _cluster_id_path() const { return _path + CLUSTER_ID_PREFIX; }
     Status _init_cluster_id();
@@ -174,6 +177,8 @@ private:
 
     std::shared_mutex _pending_path_mutex;
     std::set<std::string> _pending_path_ids;
+
+    CompactionIOBudget _compaction_io_budget;
 };
 
 } // namespace starrocks
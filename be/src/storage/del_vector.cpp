@@ -28,6 +28,7 @@ void DelVector::_add_dels(const std::vector<uint32_t>& dels) {
     } else {
         _roaring->addMany(dels.size(), dels.data());
     }
+    _compact();
     _update_stats();
 }
 
@@ -57,6 +58,7 @@ Status DelVector::load(int64_t version, const char* data, size_t length) {
     _version = version;
     if (length > 0) {
         _roaring = std::make_unique<Roaring>(Roaring::readSafe(data, length));
+        _compact();
     }
     _update_stats();
     return Status::OK();
@@ -67,6 +69,7 @@ void DelVector::init(int64_t version, const uint32_t* data, size_t length) {
     _version = version;
     if (length > 0) {
         _roaring = std::make_unique<Roaring>(length, data);
+        _compact();
     }
     _update_stats();
 }
@@ -86,6 +89,16 @@ string DelVector::to_string() const {
     return strings::Substitute("version:$0 $1", _version, _roaring ? _roaring->toString() : string("null"));
 }
 
+void DelVector::_compact() {
+    // The deleted rows are mostly consecutive, e.g. all the rows of a segment replaced by a later load, so the
+    // containers are converted into runs where they're smaller. The run containers are read directly, and the
+    // serialized form saved into the meta is compact as well.
+    if (_roaring) {
+        _roaring->runOptimize();
+        _roaring->shrinkToFit();
+    }
+}
+
 void DelVector::_update_stats() {
     // TODO(cbl): optimization
     if (_roaring) {
@@ -48,6 +48,8 @@ public:
 private:
     void _add_dels(const std::vector<uint32_t>& dels);
 
+    void _compact();
+
     void _update_stats();
 
     bool _loaded = false;
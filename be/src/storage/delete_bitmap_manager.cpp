@@ -0,0 +1,167 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/delete_bitmap_manager.h"
+
+#include <set>
+#include <shared_mutex>
+
+#include "common/config.h"
+#include "gutil/stl_util.h"
+#include "gutil/strings/substitute.h"
+#include "storage/del_vector.h"
+#include "storage/lru_cache.h"
+#include "storage/rowset/beta_rowset.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/vectorized/segment_options.h"
+#include "storage/tablet.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/delete_predicates.h"
+#include "storage/vectorized/reader.h"
+#include "util/defer_op.h"
+
+namespace starrocks {
+
+static std::string delete_bitmap_cache_key(const RowsetId& rowset_id, uint32_t segment_id) {
+    return strings::Substitute("$0_$1", rowset_id.to_string(), segment_id);
+}
+
+static void delete_bitmap_deleter(const CacheKey& key, void* value) {
+    delete reinterpret_cast<DelVectorPtr*>(value);
+}
+
+DeleteBitmapManager::DeleteBitmapManager(size_t capacity) : _cache(new_lru_cache(capacity)) {}
+
+DeleteBitmapManager::~DeleteBitmapManager() = default;
+
+DelVectorPtr DeleteBitmapManager::get(const RowsetId& rowset_id, uint32_t segment_id) {
+    std::string key = delete_bitmap_cache_key(rowset_id, segment_id);
+    Cache::Handle* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    DelVectorPtr del_vec = *reinterpret_cast<DelVectorPtr*>(_cache->value(handle));
+    _cache->release(handle);
+    return del_vec;
+}
+
+void DeleteBitmapManager::put(const RowsetId& rowset_id, uint32_t segment_id, DelVectorPtr del_vec) {
+    std::string key = delete_bitmap_cache_key(rowset_id, segment_id);
+    size_t charge = sizeof(DelVector) + del_vec->memory_usage();
+    auto* value = new DelVectorPtr(std::move(del_vec));
+    Cache::Handle* handle = _cache->insert(CacheKey(key), value, charge, delete_bitmap_deleter);
+    _cache->release(handle);
+}
+
+size_t DeleteBitmapManager::memory_usage() const {
+    return _cache->get_memory_usage();
+}
+
+Status DeleteBitmapManager::materialize(const TabletSharedPtr& tablet) {
+    if (tablet->keys_type() == PRIMARY_KEYS) {
+        return Status::OK();
+    }
+    std::vector<RowsetSharedPtr> rowsets;
+    int64_t max_version = 0;
+    {
+        std::shared_lock rlock(tablet->get_header_lock());
+        if (tablet->delete_predicates().empty()) {
+            return Status::OK();
+        }
+        max_version = tablet->max_version().second;
+        if (tablet->capture_consistent_rowsets(Version(0, max_version), &rowsets) != OLAP_SUCCESS) {
+            return Status::InternalError(
+                    strings::Substitute("fail to capture the rowsets of tablet $0", tablet->tablet_id()));
+        }
+    }
+
+    vectorized::DeletePredicates dels;
+    std::vector<const vectorized::ColumnPredicate*> preds;
+    DeferOp free_preds([&] { STLDeleteElements(&preds); });
+    RETURN_IF_ERROR(vectorized::Reader::parse_delete_predicates(tablet.get(), max_version, &dels, &preds));
+    // There is no delete predicate between |version| and |max_version|, so the DelVectors of version |version|
+    // are used by the reads of any version from it.
+    const int64_t version = dels.max_version();
+    for (const RowsetSharedPtr& rowset : rowsets) {
+        if (rowset->end_version() > version || rowset->zero_num_rows()) {
+            continue;
+        }
+        vectorized::DisjunctivePredicates rowset_dels = dels.get_predicates(rowset->end_version());
+        if (rowset_dels.empty()) {
+            continue;
+        }
+        RETURN_IF_ERROR(_materialize_rowset(tablet, rowset, rowset_dels, version));
+    }
+    return Status::OK();
+}
+
+Status DeleteBitmapManager::_materialize_rowset(const TabletSharedPtr& tablet, const RowsetSharedPtr& rowset,
+                                                const vectorized::DisjunctivePredicates& dels, int64_t version) {
+    std::set<ColumnId> columns;
+    dels.get_column_ids(&columns);
+    if (columns.empty()) {
+        return Status::OK();
+    }
+    vectorized::Schema schema;
+    for (ColumnId cid : columns) {
+        auto f = vectorized::ChunkHelper::convert_field_to_format_v2(cid, tablet->tablet_schema().column(cid));
+        schema.append(std::make_shared<vectorized::Field>(std::move(f)));
+    }
+
+    RowsetReleaseGuard guard(rowset);
+    RETURN_IF_ERROR(rowset->load());
+    OlapReaderStatistics stats;
+    vectorized::SegmentReadOptions seg_options;
+    seg_options.stats = &stats;
+    seg_options.chunk_size = config::vector_chunk_size;
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, seg_options.chunk_size);
+    std::vector<uint8_t> selection;
+    for (const auto& segment : down_cast<BetaRowset*>(rowset.get())->segments()) {
+        if (segment->num_rows() == 0) {
+            continue;
+        }
+        DelVectorPtr cached = get(rowset->rowset_id(), segment->id());
+        if (cached != nullptr && cached->version() >= version) {
+            continue;
+        }
+
+        // Without the predicates and the ranges, all the rows of the segment are read in order.
+        std::vector<uint32_t> deleted;
+        auto res = segment->new_iterator(schema, seg_options);
+        if (!res.ok()) {
+            return res.status();
+        }
+        auto iter = std::move(res).value();
+        DeferOp close_iter([&] { iter->close(); });
+        uint32_t rowid = 0;
+        while (true) {
+            chunk->reset();
+            Status st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(st);
+            selection.resize(chunk->num_rows());
+            dels.evaluate(chunk.get(), selection.data());
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                if (selection[i]) {
+                    deleted.push_back(rowid + i);
+                }
+            }
+            rowid += chunk->num_rows();
+        }
+        if (rowid != segment->num_rows()) {
+            return Status::InternalError(strings::Substitute("read $0 rows of segment $1 of rowset $2, expect $3",
+                                                             rowid, segment->id(), rowset->rowset_id().to_string(),
+                                                             segment->num_rows()));
+        }
+        auto del_vec = std::make_shared<DelVector>();
+        del_vec->init(version, deleted.data(), deleted.size());
+        VLOG(1) << "materialized the delete predicates of tablet:" << tablet->tablet_id()
+                << " rowset:" << rowset->rowset_id() << " seg:" << segment->id() << " version:" << version << " "
+                << del_vec->cardinality() << "/" << segment->num_rows();
+        put(rowset->rowset_id(), segment->id(), std::move(del_vec));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
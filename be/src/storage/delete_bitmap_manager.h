@@ -0,0 +1,57 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "storage/olap_common.h"
+
+namespace starrocks {
+
+class Cache;
+class DelVector;
+using DelVectorPtr = std::shared_ptr<DelVector>;
+class Rowset;
+using RowsetSharedPtr = std::shared_ptr<Rowset>;
+class Tablet;
+using TabletSharedPtr = std::shared_ptr<Tablet>;
+
+namespace vectorized {
+class DisjunctivePredicates;
+}
+
+// DeleteBitmapManager keeps the rows deleted by the delete predicates of the non-primary-key tablets, materialized
+// as a DelVector of each segment, so the reads skip them by the bitmap instead of evaluating the predicates again.
+//
+// The version of a DelVector is the greatest version of the delete predicates materialized in it, i.e. it covers
+// all the delete predicates of the versions in [rowset's end version, version]. A read of version v can use it
+// if v >= version, and evaluates the delete predicates newer than it only.
+//
+// The bitmaps are kept in an LRU cache and computed again by the background thread after they're evicted or
+// the BE restarts, the correctness doesn't depend on them.
+class DeleteBitmapManager {
+public:
+    explicit DeleteBitmapManager(size_t capacity);
+    ~DeleteBitmapManager();
+
+    // Returns the DelVector materialized of the segment, or nullptr if it's not materialized yet.
+    DelVectorPtr get(const RowsetId& rowset_id, uint32_t segment_id);
+
+    void put(const RowsetId& rowset_id, uint32_t segment_id, DelVectorPtr del_vec);
+
+    // Materialize the delete predicates of |tablet| into the DelVectors of the segments of its rowsets, the
+    // segments whose DelVectors cover the latest delete predicate already are skipped.
+    Status materialize(const TabletSharedPtr& tablet);
+
+    size_t memory_usage() const;
+
+private:
+    Status _materialize_rowset(const TabletSharedPtr& tablet, const RowsetSharedPtr& rowset,
+                               const vectorized::DisjunctivePredicates& dels, int64_t version);
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks
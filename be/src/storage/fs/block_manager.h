@@ -23,11 +23,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "common/status.h"
+#include "env/env.h"
 
 namespace starrocks {
 
@@ -165,6 +167,24 @@ public:
     // If an error was encountered, returns a non-OK status.
     virtual Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // Hints that the 'size' bytes beginning from 'offset' will be read soon, they're read
+    // asynchronously if the block supports it.
+    virtual Status prefetch(uint64_t offset, uint64_t size) const { return Status::OK(); }
+
+    // Reads the "n" requests of the block, which are submitted together by io_uring if it's enabled.
+    // "on_complete" is invoked with the index of a request once its status is set.
+    // Returns the first error of the requests.
+    virtual Status read_batch(ReadRequest* reqs, size_t n,
+                              const std::function<void(size_t)>& on_complete = nullptr) const = 0;
+
+    // If the block is memory-mapped and has the 'size' bytes beginning from 'offset', sets "result" to the
+    // mapped memory of them without reading, which is kept valid by "owner" even after the block is closed,
+    // and returns true. Otherwise returns false, and the bytes should be read.
+    virtual bool read_mapped(uint64_t offset, uint64_t size, Slice* result,
+                             std::shared_ptr<const void>* owner) const {
+        return false;
+    }
+
     // Returns the memory usage of this object including the object itself.
     // virtual size_t memory_footprint() const = 0;
 };
@@ -21,6 +21,11 @@
 
 #include "storage/fs/file_block_manager.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <atomic>
 #include <cstddef>
 #include <memory>
@@ -270,6 +275,10 @@ public:
 
     virtual Status readv(uint64_t offset, const Slice* results, size_t res_cnt) const override;
 
+    Status prefetch(uint64_t offset, uint64_t size) const override;
+
+    Status read_batch(ReadRequest* reqs, size_t n, const std::function<void(size_t)>& on_complete) const override;
+
     void handle_error(const Status& s) const;
 
 private:
@@ -357,6 +366,154 @@ Status FileReadableBlock::readv(uint64_t offset, const Slice* results, size_t re
     return Status::OK();
 }
 
+Status FileReadableBlock::prefetch(uint64_t offset, uint64_t size) const {
+    DCHECK(!_closed.load());
+    return _file->prefetch(offset, size);
+}
+
+Status FileReadableBlock::read_batch(ReadRequest* reqs, size_t n,
+                                     const std::function<void(size_t)>& on_complete) const {
+    DCHECK(!_closed.load());
+
+    RETURN_IF_ERROR(_file->read_at_batch(reqs, n, on_complete));
+
+    if (_block_manager->_metrics) {
+        size_t bytes_read = 0;
+        for (size_t i = 0; i < n; i++) {
+            bytes_read += reqs[i].buf.size;
+        }
+        _block_manager->_metrics->total_bytes_read->increment(bytes_read);
+    }
+    return Status::OK();
+}
+
+////////////////////////////////////////////////////////////
+// MmapReadableBlock
+////////////////////////////////////////////////////////////
+
+// The whole file mapped read-only, unmapped when the last block or page referencing it is released.
+class MappedFile {
+public:
+    MappedFile(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+    ~MappedFile() { munmap(const_cast<uint8_t*>(_data), _size); }
+
+    const uint8_t* data() const { return _data; }
+    size_t size() const { return _size; }
+
+private:
+    const uint8_t* _data;
+    size_t _size;
+};
+
+// A readable block of a local file read by mmap instead of pread, so its pages can be used in the OS page cache
+// directly without copying them into the heap. The file must not be truncated while it's mapped, which holds
+// for the segment files, which are never modified once written.
+class MmapReadableBlock : public ReadableBlock {
+public:
+    MmapReadableBlock(FileBlockManager* block_manager, string path, std::shared_ptr<MappedFile> file)
+            : _block_manager(block_manager), _path(std::move(path)), _file(std::move(file)), _closed(false) {
+        if (_block_manager->_metrics) {
+            _block_manager->_metrics->blocks_open_reading->increment(1);
+            _block_manager->_metrics->total_readable_blocks->increment(1);
+        }
+    }
+
+    ~MmapReadableBlock() override { WARN_IF_ERROR(close(), strings::Substitute("Failed to close block $0", _path)); }
+
+    Status close() override {
+        bool expected = false;
+        if (_closed.compare_exchange_strong(expected, true)) {
+            _file.reset();
+            if (_block_manager->_metrics) {
+                _block_manager->_metrics->blocks_open_reading->increment(-1);
+            }
+        }
+        return Status::OK();
+    }
+
+    BlockManager* block_manager() const override { return _block_manager; }
+
+    const BlockId& id() const override {
+        CHECK(false) << "Not support Block.id(). (TODO)";
+        return _block_id;
+    }
+
+    const std::string& path() const override { return _path; }
+
+    Status size(uint64_t* sz) const override {
+        DCHECK(!_closed.load());
+        *sz = _file->size();
+        return Status::OK();
+    }
+
+    Status read(uint64_t offset, Slice result) const override { return readv(offset, &result, 1); }
+
+    Status readv(uint64_t offset, const Slice* results, size_t res_cnt) const override {
+        DCHECK(!_closed.load());
+        size_t bytes_read = 0;
+        for (size_t i = 0; i < res_cnt; i++) {
+            if (offset + bytes_read + results[i].size > _file->size()) {
+                return Status::IOError(strings::Substitute("Cannot read $0 bytes at $1 of $2 of $3 bytes",
+                                                           results[i].size, offset + bytes_read, _path,
+                                                           _file->size()));
+            }
+            memcpy(results[i].data, _file->data() + offset + bytes_read, results[i].size);
+            bytes_read += results[i].size;
+        }
+        if (_block_manager->_metrics) {
+            _block_manager->_metrics->total_bytes_read->increment(bytes_read);
+        }
+        return Status::OK();
+    }
+
+    Status prefetch(uint64_t offset, uint64_t size) const override {
+        DCHECK(!_closed.load());
+        if (offset >= _file->size()) {
+            return Status::OK();
+        }
+        static const uint64_t kPageSize = sysconf(_SC_PAGESIZE);
+        uint64_t begin = offset / kPageSize * kPageSize;
+        uint64_t end = std::min<uint64_t>(offset + size, _file->size());
+        // madvise is only a hint, its failure is ignored.
+        madvise(const_cast<uint8_t*>(_file->data()) + begin, end - begin, MADV_WILLNEED);
+        return Status::OK();
+    }
+
+    Status read_batch(ReadRequest* reqs, size_t n, const std::function<void(size_t)>& on_complete) const override {
+        Status first_error;
+        for (size_t i = 0; i < n; i++) {
+            reqs[i].status = read(reqs[i].offset, reqs[i].buf);
+            if (!reqs[i].status.ok() && first_error.ok()) {
+                first_error = reqs[i].status;
+            }
+            if (on_complete) {
+                on_complete(i);
+            }
+        }
+        return first_error;
+    }
+
+    bool read_mapped(uint64_t offset, uint64_t size, Slice* result,
+                     std::shared_ptr<const void>* owner) const override {
+        DCHECK(!_closed.load());
+        if (offset + size > _file->size()) {
+            return false;
+        }
+        *result = Slice(_file->data() + offset, size);
+        *owner = _file;
+        return true;
+    }
+
+private:
+    FileBlockManager* _block_manager;
+    const BlockId _block_id;
+    const string _path;
+    std::shared_ptr<MappedFile> _file;
+    std::atomic_bool _closed;
+
+    DISALLOW_COPY_AND_ASSIGN(MmapReadableBlock);
+};
+
 } // namespace internal
 
 ////////////////////////////////////////////////////////////
@@ -398,8 +555,37 @@ Status FileBlockManager::create_block(const CreateBlockOptions& opts, std::uniqu
     return Status::OK();
 }
 
+bool FileBlockManager::_open_mmap_block(const std::string& path, std::unique_ptr<ReadableBlock>* block) {
+    // only the local files of the default env could be mapped.
+    if (!config::storage_read_by_mmap || _env != Env::Default()) {
+        return false;
+    }
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping is kept after the file is closed.
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        PLOG(WARNING) << "Fail to mmap " << path << ", read it by pread";
+        return false;
+    }
+    auto file = std::make_shared<internal::MappedFile>(static_cast<const uint8_t*>(data), st.st_size);
+    block->reset(new internal::MmapReadableBlock(this, path, std::move(file)));
+    return true;
+}
+
 Status FileBlockManager::open_block(const std::string& path, std::unique_ptr<ReadableBlock>* block) {
     VLOG(1) << "Opening block with path at " << path;
+    if (_open_mmap_block(path, block)) {
+        return Status::OK();
+    }
     std::shared_ptr<OpenedFileHandle<RandomAccessFile>> file_handle(new OpenedFileHandle<RandomAccessFile>());
     bool found = _file_cache->lookup(path, file_handle.get());
     if (!found) {
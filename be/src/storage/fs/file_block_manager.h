@@ -42,6 +42,7 @@ namespace fs {
 namespace internal {
 
 class FileReadableBlock;
+class MmapReadableBlock;
 class FileWritableBlock;
 struct BlockManagerMetrics;
 
@@ -83,6 +84,10 @@ public:
 
 private:
     friend class internal::FileReadableBlock;
+    friend class internal::MmapReadableBlock;
+
+    // Opens the block by mmap if config::storage_read_by_mmap, returns false if it isn't opened.
+    bool _open_mmap_block(const std::string& path, std::unique_ptr<ReadableBlock>* block);
     friend class internal::FileWritableBlock;
 
     // Deletes an existing block, allowing its space to be reclaimed by the
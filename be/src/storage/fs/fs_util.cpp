@@ -35,7 +35,9 @@ BlockManager* block_manager() {
 #ifdef BE_TEST
     return block_mgr_for_ut();
 #else
-    return ExecEnv::GetInstance()->storage_engine()->block_manager();
+    StorageEngine* storage_engine = ExecEnv::GetInstance()->storage_engine();
+    // The offline tools, e.g. segment_bench, read the files without a storage engine.
+    return storage_engine != nullptr ? storage_engine->block_manager() : block_mgr_for_ut();
 #endif
 }
 
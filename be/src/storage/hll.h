@@ -168,6 +168,10 @@ public:
 
     void merge(const HyperLogLog& other);
 
+    // The same as merging the |others| one by one, but the registers of all the |others| are merged before
+    // their explicit values.
+    void merge_many(const std::vector<const HyperLogLog*>& others);
+
     // Return max size of serialized binary
     size_t max_serialized_size() const;
 
@@ -7,6 +7,7 @@
 #include <rapidjson/document.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <strings.h>
 
 #include <sstream>
 #include <string>
@@ -158,6 +159,8 @@ LRUCache::LRUCache() : _usage(0), _last_id(0), _lookup_count(0), _hit_count(0) {
     // Make empty circular linked list
     _lru.next = &_lru;
     _lru.prev = &_lru;
+    _protected_lru.next = &_protected_lru;
+    _protected_lru.prev = &_protected_lru;
 }
 
 LRUCache::~LRUCache() {
@@ -165,9 +168,9 @@ LRUCache::~LRUCache() {
 }
 
 bool LRUCache::_unref(LRUHandle* e) {
-    DCHECK(e->refs > 0);
-    e->refs--;
-    return e->refs == 0;
+    // the entries of CLOCK are released without the lock.
+    DCHECK(__atomic_load_n(&e->refs, __ATOMIC_RELAXED) > 0);
+    return __atomic_sub_fetch(&e->refs, 1, __ATOMIC_ACQ_REL) == 0;
 }
 
 void LRUCache::_lru_remove(LRUHandle* e) {
@@ -184,7 +187,37 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
     e->next->prev = e;
 }
 
+void LRUCache::_protect(LRUHandle* e) {
+    if (_policy != CachePolicy::SLRU || e->in_protected) {
+        return;
+    }
+    e->in_protected = true;
+    _protected_usage += e->charge;
+    _demote_protected();
+}
+
+void LRUCache::_demote_protected() {
+    const auto limit = static_cast<size_t>(_capacity * kProtectedRatio);
+    while (_protected_usage > limit && _protected_lru.next != &_protected_lru) {
+        LRUHandle* old = _protected_lru.next;
+        _lru_remove(old);
+        old->in_protected = false;
+        _protected_usage -= old->charge;
+        _lru_append(&_lru, old);
+    }
+}
+
+void LRUCache::_unprotect(LRUHandle* e) {
+    if (e->in_protected) {
+        e->in_protected = false;
+        _protected_usage -= e->charge;
+    }
+}
+
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
+    if (_policy == CachePolicy::CLOCK) {
+        return _lookup_shared(key, hash);
+    }
     std::lock_guard l(_mutex);
     ++_lookup_count;
     LRUHandle* e = _table.lookup(key, hash);
@@ -197,6 +230,22 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
         }
         e->refs++;
         ++_hit_count;
+        _protect(e);
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+Cache::Handle* LRUCache::_lookup_shared(const CacheKey& key, uint32_t hash) {
+    std::shared_lock l(_mutex);
+    ++_lookup_count;
+    LRUHandle* e = _table.lookup(key, hash);
+    if (e != nullptr) {
+        // we get it from _table, so in_cache must be true
+        DCHECK(e->in_cache);
+        // it stays in the LRU list, the eviction checks the visited bit.
+        __atomic_add_fetch(&e->refs, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&e->visited, true, __ATOMIC_RELAXED);
+        ++_hit_count;
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -206,6 +255,18 @@ void LRUCache::release(Cache::Handle* handle) {
         return;
     }
     LRUHandle* e = reinterpret_cast<LRUHandle*>(handle);
+    if (_policy == CachePolicy::CLOCK) {
+        // the entry in cache is kept in the LRU list, only the last reference of the entry removed
+        // from the cache needs the lock.
+        if (_unref(e)) {
+            {
+                std::lock_guard l(_mutex);
+                _usage -= e->charge;
+            }
+            e->free();
+        }
+        return;
+    }
     bool last_ref = false;
     {
         std::lock_guard l(_mutex);
@@ -218,12 +279,14 @@ void LRUCache::release(Cache::Handle* handle) {
                 // take this opportunity and remove the item
                 _table.remove(e->key(), e->hash);
                 e->in_cache = false;
+                _unprotect(e);
                 _unref(e);
                 _usage -= e->charge;
+                ++_evict_count;
                 last_ref = true;
             } else {
                 // put it to LRU free list
-                _lru_append(&_lru, e);
+                _lru_append(e->in_protected ? &_protected_lru : &_lru, e);
             }
         }
     }
@@ -235,23 +298,57 @@ void LRUCache::release(Cache::Handle* handle) {
 }
 
 void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
-    LRUHandle* cur = &_lru;
-    // 1. evict normal cache entries
-    while (_usage + charge > _capacity && cur->next != &_lru) {
+    if (_policy == CachePolicy::CLOCK) {
+        _evict_by_clock(charge, false, deleted);
+        _evict_by_clock(charge, true, deleted);
+        return;
+    }
+    // 1. evict normal cache entries, the probationary ones first
+    _evict_from_list(&_lru, charge, false, deleted);
+    _evict_from_list(&_protected_lru, charge, false, deleted);
+    // 2. evict durable cache entries if need
+    _evict_from_list(&_lru, charge, true, deleted);
+    _evict_from_list(&_protected_lru, charge, true, deleted);
+}
+
+void LRUCache::_evict_from_list(LRUHandle* list, size_t charge, bool durable, std::vector<LRUHandle*>* deleted) {
+    LRUHandle* cur = list;
+    while (_usage + charge > _capacity && cur->next != list) {
         LRUHandle* old = cur->next;
-        if (old->priority == CachePriority::DURABLE) {
+        if (!durable && old->priority == CachePriority::DURABLE) {
             cur = cur->next;
             continue;
         }
         _evict_one_entry(old);
         deleted->push_back(old);
     }
-    // 2. evict durable cache entries if need
-    while (_usage + charge > _capacity && _lru.next != &_lru) {
-        LRUHandle* old = _lru.next;
-        DCHECK(old->priority == CachePriority::DURABLE);
-        _evict_one_entry(old);
-        deleted->push_back(old);
+}
+
+void LRUCache::_evict_by_clock(size_t charge, bool durable, std::vector<LRUHandle*>* deleted) {
+    // the first round moves the visited entries to the newest end and clears their visited bits,
+    // the second round evicts them if they're not visited again.
+    for (int round = 0; round < 2 && _usage + charge > _capacity && _lru.next != &_lru; round++) {
+        LRUHandle* last = _lru.prev;
+        LRUHandle* cur = _lru.next;
+        while (_usage + charge > _capacity) {
+            LRUHandle* next = cur->next;
+            bool is_last = cur == last;
+            // the entries in use can't be evicted.
+            if ((durable || cur->priority != CachePriority::DURABLE) &&
+                __atomic_load_n(&cur->refs, __ATOMIC_ACQUIRE) == 1) {
+                if (__atomic_exchange_n(&cur->visited, false, __ATOMIC_RELAXED)) {
+                    _lru_remove(cur);
+                    _lru_append(&_lru, cur);
+                } else {
+                    _evict_one_entry(cur);
+                    deleted->push_back(cur);
+                }
+            }
+            if (is_last) {
+                break;
+            }
+            cur = next;
+        }
     }
 }
 
@@ -261,8 +358,10 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     _lru_remove(e);
     _table.remove(e->key(), e->hash);
     e->in_cache = false;
+    _unprotect(e);
     _unref(e);
     _usage -= e->charge;
+    ++_evict_count;
 }
 
 Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -277,6 +376,8 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->next = e->prev = nullptr;
     e->in_cache = true;
     e->priority = priority;
+    e->in_protected = false;
+    e->visited = false;
     memcpy(e->key_data, key.data(), key.size());
     std::vector<LRUHandle*> last_ref_list;
     {
@@ -291,13 +392,22 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         // space was freed
         auto old = _table.insert(e);
         _usage += charge;
+        if (_policy == CachePolicy::CLOCK) {
+            _lru_append(&_lru, e);
+        }
         if (old != nullptr) {
             old->in_cache = false;
+            _unprotect(old);
+            if (_policy == CachePolicy::CLOCK) {
+                _lru_remove(old);
+            }
             if (_unref(old)) {
                 _usage -= old->charge;
                 // old is on LRU because it's in cache and its reference count
                 // was just 1 (Unref returned 0)
-                _lru_remove(old);
+                if (_policy != CachePolicy::CLOCK) {
+                    _lru_remove(old);
+                }
                 last_ref_list.push_back(old);
             }
         }
@@ -319,15 +429,20 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
         std::lock_guard l(_mutex);
         e = _table.remove(key, hash);
         if (e != nullptr) {
+            if (_policy == CachePolicy::CLOCK) {
+                // the entries of CLOCK are in the LRU list even if they're in use
+                _lru_remove(e);
+            }
             last_ref = _unref(e);
             if (last_ref) {
                 _usage -= e->charge;
-                if (e->in_cache) {
+                if (e->in_cache && _policy != CachePolicy::CLOCK) {
                     // locate in free list
                     _lru_remove(e);
                 }
             }
             e->in_cache = false;
+            _unprotect(e);
         }
     }
     // free handle out of mutex, when last_ref is true, e must not be nullptr
@@ -340,16 +455,25 @@ int LRUCache::prune() {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
-        while (_lru.next != &_lru) {
-            LRUHandle* old = _lru.next;
-            DCHECK(old->in_cache);
-            DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
-            _lru_remove(old);
-            _table.remove(old->key(), old->hash);
-            old->in_cache = false;
-            _unref(old);
-            _usage -= old->charge;
-            last_ref_list.push_back(old);
+        for (LRUHandle* list : {&_lru, &_protected_lru}) {
+            LRUHandle* next = list->next;
+            while (next != list) {
+                LRUHandle* old = next;
+                next = old->next;
+                DCHECK(old->in_cache);
+                if (__atomic_load_n(&old->refs, __ATOMIC_ACQUIRE) != 1) {
+                    // the entries of CLOCK in use are in the LRU list too
+                    DCHECK(_policy == CachePolicy::CLOCK);
+                    continue;
+                }
+                _lru_remove(old);
+                _table.remove(old->key(), old->hash);
+                old->in_cache = false;
+                _unprotect(old);
+                _unref(old);
+                _usage -= old->charge;
+                last_ref_list.push_back(old);
+            }
         }
     }
     for (auto entry : last_ref_list) {
@@ -366,11 +490,12 @@ uint32_t ShardedLRUCache::_shard(uint32_t hash) {
     return hash >> (32 - kNumShardBits);
 }
 
-ShardedLRUCache::ShardedLRUCache(size_t capacity) : _last_id(0) {
+ShardedLRUCache::ShardedLRUCache(size_t capacity, CachePolicy policy) : _last_id(0) {
     const size_t per_shard = (capacity + (kNumShards - 1)) / kNumShards;
 
     for (int s = 0; s < kNumShards; s++) {
         _shards[s].set_capacity(per_shard);
+        _shards[s].set_policy(policy);
     }
 }
 
@@ -455,12 +580,28 @@ void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
         }
 
         shard_info.AddMember("hit_ratio", hit_ratio, document->GetAllocator());
+        shard_info.AddMember("evict_count", static_cast<double>(_shards[i].get_evict_count()),
+                             document->GetAllocator());
+        shard_info.AddMember("protected_usage", static_cast<double>(_shards[i].get_protected_usage()),
+                             document->GetAllocator());
         document->PushBack(shard_info, document->GetAllocator());
     }
 }
 
-Cache* new_lru_cache(size_t capacity) {
-    return new ShardedLRUCache(capacity);
+CachePolicy cache_policy_from_string(const std::string& name) {
+    if (strcasecmp(name.c_str(), "slru") == 0) {
+        return CachePolicy::SLRU;
+    } else if (strcasecmp(name.c_str(), "clock") == 0) {
+        return CachePolicy::CLOCK;
+    }
+    if (strcasecmp(name.c_str(), "lru") != 0) {
+        LOG(WARNING) << "Unknown cache policy " << name << ", use lru";
+    }
+    return CachePolicy::LRU;
+}
+
+Cache* new_lru_cache(size_t capacity, CachePolicy policy) {
+    return new ShardedLRUCache(capacity, policy);
 }
 
 } // namespace starrocks
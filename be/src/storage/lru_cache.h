@@ -9,7 +9,9 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <atomic>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -45,9 +47,24 @@ namespace starrocks {
 class Cache;
 class CacheKey;
 
+// The eviction policy of the cache.
+//  - LRU: evict the least-recently-used entry.
+//  - SLRU: segmented LRU, the new entries are in the probationary segment and moved to the protected segment
+//    once they're hit again. The probationary entries are evicted first, so a scan touching each entry once
+//    can't flush the entries hit repeatedly. The protected segment is limited to kProtectedRatio of the
+//    capacity, the least-recently-used protected entries are moved back to the probationary segment.
+//  - CLOCK: a hit only sets the visited bit of the entry under the shared lock instead of moving it in the
+//    LRU list, the eviction gives the visited entries a second chance. The concurrent lookups of a shard
+//    don't block each other, only the inserts and evictions take the exclusive lock.
+enum class CachePolicy { LRU = 0, SLRU = 1, CLOCK = 2 };
+
+// Returns the policy of |name|, which is one of "lru", "slru" and "clock" ignoring the case, or LRU if it's
+// unknown.
+CachePolicy cache_policy_from_string(const std::string& name);
+
 // Create a new cache with a fixed size capacity.  This implementation
-// of Cache uses a least-recently-used eviction policy.
-extern Cache* new_lru_cache(size_t capacity);
+// of Cache uses a least-recently-used eviction policy by default.
+extern Cache* new_lru_cache(size_t capacity, CachePolicy policy = CachePolicy::LRU);
 
 class CacheKey {
 public:
@@ -219,7 +236,9 @@ typedef struct LRUHandle {
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
-    char key_data[1]; // Beginning of key
+    bool in_protected; // Whether entry is in the protected segment of SLRU.
+    bool visited;      // Whether entry is hit since it's checked by the eviction of CLOCK.
+    char key_data[1];  // Beginning of key
 
     CacheKey key() const {
         // For cheaper lookups, we allow a temporary Handle object
@@ -278,6 +297,7 @@ public:
 
     // Separate from constructor so caller can easily make an array of LRUCache
     void set_capacity(size_t capacity) { _capacity = capacity; }
+    void set_policy(CachePolicy policy) { _policy = policy; }
 
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -290,33 +310,59 @@ public:
 
     uint64_t get_lookup_count() const { return _lookup_count; }
     uint64_t get_hit_count() const { return _hit_count; }
+    uint64_t get_evict_count() const { return _evict_count; }
     size_t get_usage() const { return _usage; }
+    size_t get_protected_usage() const { return _protected_usage; }
     size_t get_capacity() const { return _capacity; }
 
+    // The max ratio of the capacity used by the protected segment of SLRU.
+    static constexpr double kProtectedRatio = 0.8;
+
 private:
     void _lru_remove(LRUHandle* e);
     void _lru_append(LRUHandle* list, LRUHandle* e);
     bool _unref(LRUHandle* e);
+    Cache::Handle* _lookup_shared(const CacheKey& key, uint32_t hash);
+    void _evict_by_clock(size_t charge, bool durable, std::vector<LRUHandle*>* deleted);
     void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted);
+    void _evict_from_list(LRUHandle* list, size_t charge, bool durable, std::vector<LRUHandle*>* deleted);
     void _evict_one_entry(LRUHandle* e);
+    // Move |e| hit again into the protected segment of SLRU.
+    void _protect(LRUHandle* e);
+    // Move the least-recently-used protected entries back to the probationary segment
+    // until the protected segment is within its limit.
+    void _demote_protected();
+    // Called when |e| is removed from the cache.
+    void _unprotect(LRUHandle* e);
 
     // Initialized before use.
     size_t _capacity;
+    CachePolicy _policy = CachePolicy::LRU;
 
     // _mutex protects the following state.
-    std::mutex _mutex;
+    // The lookups of CLOCK only take the shared lock, which only read the handle table and update the
+    // reference count and the visited bit of the entry atomically.
+    std::shared_mutex _mutex;
     size_t _usage;
     uint64_t _last_id;
 
     // Dummy head of LRU list.
     // lru.prev is newest entry, lru.next is oldest entry.
     // Entries have refs==1 and in_cache==true.
+    // With SLRU, it's the probationary segment.
+    // With CLOCK, it has all the entries with in_cache==true in the order of insertion, including the ones
+    // in use.
     LRUHandle _lru;
+    // Dummy head of the protected segment of SLRU, ordered like |_lru|.
+    LRUHandle _protected_lru;
+    // The total charge of the protected entries, including the ones in use.
+    size_t _protected_usage = 0;
 
     HandleTable _table;
 
-    uint64_t _lookup_count;
-    uint64_t _hit_count;
+    std::atomic<uint64_t> _lookup_count;
+    std::atomic<uint64_t> _hit_count;
+    uint64_t _evict_count = 0;
 };
 
 static const int kNumShardBits = 4;
@@ -324,7 +370,7 @@ static const int kNumShards = 1 << kNumShardBits;
 
 class ShardedLRUCache : public Cache {
 public:
-    explicit ShardedLRUCache(size_t capacity);
+    explicit ShardedLRUCache(size_t capacity, CachePolicy policy = CachePolicy::LRU);
     virtual ~ShardedLRUCache() {}
     virtual Handle* insert(const CacheKey& key, void* value, size_t charge,
                            void (*deleter)(const CacheKey& key, void* value),
@@ -21,9 +21,15 @@
 
 #include "storage/memory/mem_tablet_scan.h"
 
+#include "column/chunk.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "gutil/casts.h"
 #include "storage/memory/column_reader.h"
 #include "storage/memory/mem_sub_tablet.h"
 #include "storage/memory/mem_tablet.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
 
 namespace starrocks {
 namespace memory {
@@ -40,6 +46,14 @@ MemTabletScan::MemTabletScan(std::shared_ptr<MemTablet>&& tablet, std::unique_pt
     _row_block.reset(new RowBlock(_readers.size()));
     _next_block = 0;
     _num_blocks = num_block(_num_rows, Column::BLOCK_SIZE);
+    const TabletSchema& tschema = _schema->get_tablet_schema();
+    const auto& columns = _spec->columns();
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const TabletColumn& tcolumn = tschema.column(tschema.field_index(columns[i]));
+        auto f = vectorized::ChunkHelper::convert_field_to_format_v2(i, tcolumn);
+        _chunk_schema.append(std::make_shared<vectorized::Field>(std::move(f)));
+        _column_byte_sizes.push_back(_schema->get_column_byte_size(_schema->get_by_name(columns[i])->cid()));
+    }
 }
 
 Status MemTabletScan::next_block(const RowBlock** block) {
@@ -57,5 +71,51 @@ Status MemTabletScan::next_block(const RowBlock** block) {
     return Status::OK();
 }
 
+Status MemTabletScan::next_chunk(vectorized::Chunk* chunk) {
+    const auto& preds = _spec->predicates();
+    chunk->reset();
+    while (chunk->num_rows() == 0) {
+        if (_block == nullptr || _block_offset >= _block->num_rows()) {
+            RETURN_IF_ERROR(next_block(&_block));
+            if (_block == nullptr) {
+                return Status::EndOfFile("end of memory tablet scan");
+            }
+            _block_offset = 0;
+        }
+        // A block has up to 64K rows, more than a chunk and the predicates can handle.
+        const size_t nrows = std::min<size_t>(config::vector_chunk_size, _block->num_rows() - _block_offset);
+        for (size_t i = 0; i < _block->num_columns(); ++i) {
+            const ColumnBlock& cb = _block->get_column(i);
+            const uint8_t* data = cb.data().data() + _block_offset * _column_byte_sizes[i];
+            const size_t bytes = nrows * _column_byte_sizes[i];
+            const vectorized::ColumnPtr& column = chunk->get_column_by_index(i);
+            // All the types supported by memory engine have the same layout in memory::ColumnBlock
+            // and vectorized::Column, so the rows are appended as a whole.
+            if (column->is_nullable()) {
+                auto* nullable = down_cast<vectorized::NullableColumn*>(column.get());
+                if (cb.nulls()) {
+                    (void)nullable->mutable_null_column()->append_numbers(cb.nulls().data() + _block_offset, nrows);
+                } else {
+                    nullable->mutable_null_column()->append_default(nrows);
+                }
+                (void)nullable->mutable_data_column()->append_numbers(data, bytes);
+                nullable->update_has_null();
+            } else {
+                (void)column->append_numbers(data, bytes);
+            }
+        }
+        _block_offset += nrows;
+        if (!preds.empty()) {
+            _selection.resize(nrows);
+            preds[0]->evaluate(chunk->get_column_by_id(preds[0]->column_id()).get(), _selection.data());
+            for (size_t i = 1; i < preds.size(); ++i) {
+                preds[i]->evaluate_and(chunk->get_column_by_id(preds[i]->column_id()).get(), _selection.data());
+            }
+            chunk->filter(_selection);
+        }
+    }
+    return Status::OK();
+}
+
 } // namespace memory
 } // namespace starrocks
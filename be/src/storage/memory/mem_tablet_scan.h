@@ -21,9 +21,15 @@
 
 #pragma once
 
+#include "column/vectorized_fwd.h"
 #include "storage/memory/common.h"
 #include "storage/memory/row_block.h"
 #include "storage/memory/schema.h"
+#include "storage/vectorized/schema.h"
+
+namespace starrocks::vectorized {
+class ColumnPredicate;
+} // namespace starrocks::vectorized
 
 namespace starrocks {
 namespace memory {
@@ -39,12 +45,20 @@ public:
 
     const vector<std::string> columns() const { return _columns; }
 
+    // Predicates pushed down to the scan, the column id of a predicate is the index of its
+    // column in columns(). Only used by next_chunk, the caller owns them and must keep them
+    // alive until the scan is destroyed.
+    void add_predicate(const vectorized::ColumnPredicate* pred) { _predicates.push_back(pred); }
+
+    const vector<const vectorized::ColumnPredicate*>& predicates() const { return _predicates; }
+
 private:
     friend class MemTablet;
 
     uint64_t _version = UINT64_MAX;
     uint64_t _limit = UINT64_MAX;
     vector<std::string> _columns;
+    vector<const vectorized::ColumnPredicate*> _predicates;
 };
 
 class HashIndex;
@@ -59,6 +73,16 @@ public:
     // Get next row_block, it will remain valid until next call to next_block.
     Status next_block(const RowBlock** block);
 
+    // The schema of the chunks returned by next_chunk, field i is the i-th column of ScanSpec.
+    const vectorized::Schema& chunk_schema() const { return _chunk_schema; }
+
+    // Get up to config::vector_chunk_size rows satisfying all the predicates of ScanSpec,
+    // the rows filtered out are skipped. |chunk| must be created by chunk_schema(), it's
+    // reset at first. Returns EndOfFile if there is no more row.
+    //
+    // Note: next_block and next_chunk share the scan position, don't mix them.
+    Status next_chunk(vectorized::Chunk* chunk);
+
 private:
     friend class MemTablet;
 
@@ -68,6 +92,8 @@ private:
     std::shared_ptr<MemTablet> _tablet;
     const Schema* _schema = nullptr;
     std::unique_ptr<ScanSpec> _spec;
+    vectorized::Schema _chunk_schema;
+    std::vector<size_t> _column_byte_sizes;
 
     size_t _num_rows = 0;
     size_t _num_blocks = 0;
@@ -77,6 +103,10 @@ private:
     // returned block
     std::unique_ptr<RowBlock> _row_block;
     size_t _next_block = 0;
+    // the block and the position in it of next_chunk
+    const RowBlock* _block = nullptr;
+    size_t _block_offset = 0;
+    vectorized::Buffer<uint8_t> _selection;
 
     DISALLOW_COPY_AND_ASSIGN(MemTabletScan);
 };
@@ -23,8 +23,11 @@
 
 #include <functional>
 
+#include "gutil/strings/substitute.h"
+#include "storage/data_dir.h"
 #include "storage/memtable.h"
 #include "storage/vectorized/memtable.h"
+#include "util/countdown_latch.h"
 #include "util/scoped_cleanup.h"
 
 namespace starrocks {
@@ -52,12 +55,42 @@ Status FlushToken::submit(const std::shared_ptr<vectorized::MemTable>& memtable)
         ss << "tablet_id = " << memtable->tablet_id() << " flush_status error ";
         return Status::InternalError(ss.str());
     }
-    _flush_token->submit_func(std::bind(&FlushToken::_flush_vectorized_memtable, this, memtable));
+    if (_finalize_token == nullptr) {
+        RETURN_IF_ERROR(memtable->finalize());
+        _flush_token->submit_func(std::bind(&FlushToken::_flush_vectorized_memtable, this, memtable));
+        return Status::OK();
+    }
+
+    // The flush task waits for the finalize task, which never waits for anything, so they can't deadlock.
+    auto finalized = std::make_shared<CountDownLatch>(1);
+    auto finalize_status = std::make_shared<Status>();
+    _finalize_token->submit_func([this, memtable, finalized, finalize_status]() mutable {
+        if (_flush_status.load() == OLAP_SUCCESS) {
+            *finalize_status = memtable->finalize();
+        }
+        // Release the memtable before the flush task is woken up, the flush task owns it from now on.
+        memtable.reset();
+        finalized->count_down();
+    });
+    _flush_token->submit_func([this, memtable, finalized, finalize_status]() mutable {
+        finalized->wait();
+        if (!finalize_status->ok()) {
+            LOG(WARNING) << "Fail to finalize memtable. tablet_id=" << memtable->tablet_id()
+                         << " status=" << finalize_status->to_string();
+            _flush_status.store(OLAP_ERR_OTHER_ERROR);
+            return;
+        }
+        _flush_vectorized_memtable(std::move(memtable));
+    });
     return Status::OK();
 }
 
 void FlushToken::cancel() {
+    // The running flush tasks wait for their finalize tasks, so the finalize token is shut down after them.
     _flush_token->shutdown();
+    if (_finalize_token != nullptr) {
+        _finalize_token->shutdown();
+    }
 }
 
 OLAPStatus FlushToken::wait() {
@@ -109,16 +142,46 @@ Status MemTableFlushExecutor::init(const std::vector<DataDir*>& data_dirs) {
     int32_t data_dir_num = data_dirs.size();
     size_t min_threads = std::max(1, config::flush_thread_num_per_store);
     size_t max_threads = data_dir_num * min_threads;
-    return ThreadPoolBuilder("MemTableFlushThreadPool")
-            .set_min_threads(min_threads)
-            .set_max_threads(max_threads)
-            .build(&_flush_pool);
+    RETURN_IF_ERROR(ThreadPoolBuilder("MemTableFlushThreadPool")
+                            .set_min_threads(min_threads)
+                            .set_max_threads(max_threads)
+                            .build(&_flush_pool));
+
+    for (DataDir* data_dir : data_dirs) {
+        int threads = data_dir->storage_medium() == TStorageMedium::SSD ? config::flush_thread_num_per_ssd_store
+                                                                        : config::flush_thread_num_per_store;
+        std::unique_ptr<ThreadPool> pool;
+        RETURN_IF_ERROR(ThreadPoolBuilder(strings::Substitute("MemTableFlush.$0", data_dir->path_hash()))
+                                .set_min_threads(1)
+                                .set_max_threads(std::max(1, threads))
+                                .build(&pool));
+        _data_dir_flush_pools.emplace(data_dir->path_hash(), std::move(pool));
+    }
+
+    if (config::memtable_finalize_threads > 0) {
+        RETURN_IF_ERROR(ThreadPoolBuilder("MemTableFinalizeThreadPool")
+                                .set_min_threads(1)
+                                .set_max_threads(config::memtable_finalize_threads)
+                                .build(&_finalize_pool));
+    }
+    return Status::OK();
 }
 
 // NOTE: we use SERIAL mode here to ensure all mem-tables from one tablet are flushed in order.
 OLAPStatus MemTableFlushExecutor::create_flush_token(std::unique_ptr<FlushToken>* flush_token,
-                                                     ThreadPool::ExecutionMode execution_mode) {
-    flush_token->reset(new FlushToken(_flush_pool->new_token(execution_mode)));
+                                                     ThreadPool::ExecutionMode execution_mode, DataDir* data_dir) {
+    ThreadPool* flush_pool = _flush_pool.get();
+    if (data_dir != nullptr) {
+        auto iter = _data_dir_flush_pools.find(data_dir->path_hash());
+        if (iter != _data_dir_flush_pools.end()) {
+            flush_pool = iter->second.get();
+        }
+    }
+    std::unique_ptr<ThreadPoolToken> finalize_token;
+    if (_finalize_pool != nullptr) {
+        finalize_token = _finalize_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    }
+    flush_token->reset(new FlushToken(flush_pool->new_token(execution_mode), std::move(finalize_token)));
     return OLAP_SUCCESS;
 }
 
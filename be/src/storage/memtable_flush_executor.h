@@ -23,6 +23,7 @@
 
 #include <atomic>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "storage/olap_define.h"
@@ -56,13 +57,22 @@ std::ostream& operator<<(std::ostream& os, const FlushStatistic& stat);
 // 1. Immediately disallow submission of any subsequent memtable
 // 2. For the memtables that have already been submitted, there is no need to flush,
 //    because the entire job will definitely fail;
+//
+// If |finalize_token| is given, the vectorized memtables are sorted and aggregated by it concurrently, and
+// they're written by |flush_pool_token| in the order of submission. So a memtable is finalized while the former
+// ones are being written.
 class FlushToken {
 public:
-    explicit FlushToken(std::unique_ptr<ThreadPoolToken> flush_pool_token)
-            : _flush_token(std::move(flush_pool_token)), _flush_status(OLAP_SUCCESS) {}
+    explicit FlushToken(std::unique_ptr<ThreadPoolToken> flush_pool_token,
+                        std::unique_ptr<ThreadPoolToken> finalize_token = nullptr)
+            : _flush_token(std::move(flush_pool_token)),
+              _finalize_token(std::move(finalize_token)),
+              _flush_status(OLAP_SUCCESS) {}
 
     OLAPStatus submit(const std::shared_ptr<MemTable>& mem_table);
 
+    // Finalize and flush the vectorized memtable, it's finalized on the calling thread if there is no
+    // finalize token.
     Status submit(const std::shared_ptr<vectorized::MemTable>& mem_table);
 
     // error has happpens, so we cancel this token
@@ -81,6 +91,7 @@ private:
     void _flush_vectorized_memtable(std::shared_ptr<vectorized::MemTable> mem_table);
 
     std::unique_ptr<ThreadPoolToken> _flush_token;
+    std::unique_ptr<ThreadPoolToken> _finalize_token;
 
     // Records the current flush status of the tablet.
     // Note: Once its value is set to Failed, it cannot return to SUCCESS.
@@ -107,11 +118,18 @@ public:
     // because it needs path hash of each data dir.
     Status init(const std::vector<DataDir*>& data_dirs);
 
+    // The memtables are written by the flush pool of |data_dir| if it's given, otherwise by the shared pool.
     OLAPStatus create_flush_token(std::unique_ptr<FlushToken>* flush_token,
-                                  ThreadPool::ExecutionMode execution_mode = ThreadPool::ExecutionMode::SERIAL);
+                                  ThreadPool::ExecutionMode execution_mode = ThreadPool::ExecutionMode::SERIAL,
+                                  DataDir* data_dir = nullptr);
 
 private:
     std::unique_ptr<ThreadPool> _flush_pool;
+    // The flush pool of each data dir by path hash, the SSDs have more threads than the HDDs.
+    std::unordered_map<size_t, std::unique_ptr<ThreadPool>> _data_dir_flush_pools;
+    // Sorts and aggregates the vectorized memtables before they're written, null if they're finalized on
+    // the loading threads.
+    std::unique_ptr<ThreadPool> _finalize_pool;
 };
 
 } // namespace starrocks
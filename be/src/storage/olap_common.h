@@ -414,6 +414,10 @@ struct OlapReaderStatistics {
 
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
+    // The pages hit by the compressed tier of the page cache, which are decompressed again.
+    int64_t compressed_cached_pages_num = 0;
+    // The pages used in the memory-mapped files, see config::storage_read_by_mmap.
+    int64_t mapped_pages_num = 0;
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
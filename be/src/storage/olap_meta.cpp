@@ -21,7 +21,10 @@
 
 #include "storage/olap_meta.h"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -51,6 +54,62 @@ const std::string META_POSTFIX = "/meta"; // NOLINT
 const std::string SECOND_POSTFIX = "_secondary";
 const size_t PREFIX_LENGTH = 4;
 
+struct OlapMeta::Writer {
+    explicit Writer(WriteBatch* batch) : batch(batch) {}
+
+    WriteBatch* batch;
+    rocksdb::Status status;
+    bool done = false;
+    std::condition_variable cv;
+};
+
+// Appends the updates of the batches into the batch a group commits.
+class GroupAppender : public rocksdb::WriteBatch::Handler {
+public:
+    GroupAppender(const std::vector<ColumnFamilyHandle*>& handles, WriteBatch* group)
+            : _handles(handles), _group(group) {}
+
+    rocksdb::Status PutCF(uint32_t column_family_id, const rocksdb::Slice& key, const rocksdb::Slice& value) override {
+        ColumnFamilyHandle* handle = _handle(column_family_id);
+        return handle == nullptr ? _unknown(column_family_id) : _group->Put(handle, key, value);
+    }
+
+    rocksdb::Status DeleteCF(uint32_t column_family_id, const rocksdb::Slice& key) override {
+        ColumnFamilyHandle* handle = _handle(column_family_id);
+        return handle == nullptr ? _unknown(column_family_id) : _group->Delete(handle, key);
+    }
+
+    rocksdb::Status SingleDeleteCF(uint32_t column_family_id, const rocksdb::Slice& key) override {
+        ColumnFamilyHandle* handle = _handle(column_family_id);
+        return handle == nullptr ? _unknown(column_family_id) : _group->SingleDelete(handle, key);
+    }
+
+    rocksdb::Status DeleteRangeCF(uint32_t column_family_id, const rocksdb::Slice& begin_key,
+                                  const rocksdb::Slice& end_key) override {
+        ColumnFamilyHandle* handle = _handle(column_family_id);
+        return handle == nullptr ? _unknown(column_family_id) : _group->DeleteRange(handle, begin_key, end_key);
+    }
+
+    void LogData(const rocksdb::Slice& blob) override { _group->PutLogData(blob); }
+
+private:
+    ColumnFamilyHandle* _handle(uint32_t column_family_id) const {
+        for (auto* handle : _handles) {
+            if (handle->GetID() == column_family_id) {
+                return handle;
+            }
+        }
+        return nullptr;
+    }
+
+    static rocksdb::Status _unknown(uint32_t column_family_id) {
+        return rocksdb::Status::InvalidArgument("unknown column family " + std::to_string(column_family_id));
+    }
+
+    const std::vector<ColumnFamilyHandle*>& _handles;
+    WriteBatch* _group;
+};
+
 OlapMeta::OlapMeta(std::string root_path) : _root_path(std::move(root_path)), _db(nullptr) {}
 
 OlapMeta::~OlapMeta() {
@@ -139,47 +198,116 @@ Status OlapMeta::put(ColumnFamilyIndex column_family_index, const std::string& k
     StarRocksMetrics::instance()->meta_write_request_total.increment(1);
     rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
     int64_t duration_ns = 0;
-    rocksdb::Status s;
+    Status st;
     {
         SCOPED_RAW_TIMER(&duration_ns);
-        WriteOptions write_options;
-        write_options.sync = config::sync_tablet_meta;
-        s = _db->Put(write_options, handle, key, value);
+        WriteBatch batch;
+        rocksdb::Status s = batch.Put(handle, key, value);
+        st = s.ok() ? _write(&batch) : to_status(s);
     }
     StarRocksMetrics::instance()->meta_write_request_duration_us.increment(duration_ns / 1000);
-    LOG_IF(WARNING, !s.ok()) << s.ToString();
-    return to_status(s);
+    return st;
 }
 
 Status OlapMeta::write_batch(rocksdb::WriteBatch* batch) {
     StarRocksMetrics::instance()->meta_write_request_total.increment(1);
     int64_t duration_ns = 0;
-    rocksdb::Status s;
+    Status st;
     {
         SCOPED_RAW_TIMER(&duration_ns);
-        WriteOptions write_options;
-        write_options.sync = config::sync_tablet_meta;
-        s = _db->Write(write_options, batch);
+        st = _write(batch);
     }
     StarRocksMetrics::instance()->meta_write_request_duration_us.increment(duration_ns / 1000);
+    return st;
+}
+
+Status OlapMeta::_write(WriteBatch* batch) {
+    if (config::sync_tablet_meta && config::meta_group_commit_window_us > 0) {
+        return _group_write(batch);
+    }
+    WriteOptions write_options;
+    write_options.sync = config::sync_tablet_meta;
+    rocksdb::Status s = _db->Write(write_options, batch);
     LOG_IF(WARNING, !s.ok()) << s.ToString();
     return to_status(s);
 }
 
+Status OlapMeta::_group_write(WriteBatch* batch) {
+    Writer writer(batch);
+    std::unique_lock<std::mutex> l(_writers_lock);
+    _writers.push_back(&writer);
+    writer.cv.wait(l, [&]() { return writer.done || _writers.front() == &writer; });
+    if (writer.done) {
+        return to_status(writer.status);
+    }
+
+    // lead the group.
+    l.unlock();
+    std::this_thread::sleep_for(std::chrono::microseconds(config::meta_group_commit_window_us));
+    l.lock();
+    size_t max_writers = std::max(config::meta_group_commit_max_writes, 1);
+    std::vector<Writer*> members(_writers.begin(), _writers.begin() + std::min(_writers.size(), max_writers));
+    l.unlock();
+
+    WriteOptions write_options;
+    write_options.sync = true;
+    if (members.size() == 1) {
+        writer.status = _db->Write(write_options, batch);
+    } else {
+        WriteBatch group;
+        GroupAppender appender(_handles, &group);
+        rocksdb::Status s;
+        for (Writer* member : members) {
+            s = member->batch->Iterate(&appender);
+            if (!s.ok()) {
+                break;
+            }
+        }
+        if (s.ok()) {
+            s = _db->Write(write_options, &group);
+            for (Writer* member : members) {
+                member->status = s;
+            }
+        } else {
+            // write the batches one by one, so that an invalid batch doesn't fail the others.
+            LOG(WARNING) << "Fail to group the meta writes: " << s.ToString();
+            for (Writer* member : members) {
+                member->status = _db->Write(write_options, member->batch);
+            }
+        }
+    }
+    StarRocksMetrics::instance()->meta_write_group_commit_total.increment(1);
+
+    l.lock();
+    for (Writer* member : members) {
+        DCHECK_EQ(member, _writers.front());
+        _writers.pop_front();
+        if (member != &writer) {
+            member->done = true;
+            member->cv.notify_one();
+        }
+    }
+    if (!_writers.empty()) {
+        _writers.front()->cv.notify_one();
+    }
+    l.unlock();
+    LOG_IF(WARNING, !writer.status.ok()) << writer.status.ToString();
+    return to_status(writer.status);
+}
+
 Status OlapMeta::remove(ColumnFamilyIndex column_family_index, const std::string& key) {
     StarRocksMetrics::instance()->meta_write_request_total.increment(1);
     rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
-    rocksdb::Status s;
+    Status st;
     int64_t duration_ns = 0;
     {
         SCOPED_RAW_TIMER(&duration_ns);
-        WriteOptions write_options;
-        write_options.sync = config::sync_tablet_meta;
-        s = _db->Delete(write_options, handle, key);
+        WriteBatch batch;
+        rocksdb::Status s = batch.Delete(handle, key);
+        st = s.ok() ? _write(&batch) : to_status(s);
     }
     StarRocksMetrics::instance()->meta_write_request_duration_us.increment(duration_ns / 1000);
-    LOG_IF(WARNING, !s.ok()) << s.ToString();
-    return to_status(s);
+    return st;
 }
 
 Status OlapMeta::iterate(ColumnFamilyIndex column_family_index, const std::string& prefix,
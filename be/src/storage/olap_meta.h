@@ -24,8 +24,11 @@
 
 #include <rocksdb/write_batch.h>
 
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -70,9 +73,21 @@ public:
     ColumnFamilyHandle* handle(ColumnFamilyIndex column_family_index) { return _handles[column_family_index]; }
 
 private:
+    struct Writer;
+
+    Status _write(WriteBatch* batch);
+
+    // Commit |batch| along with the ones of the other threads in one synced write. The first of the waiting
+    // writers leads a group, waits config::meta_group_commit_window_us for the others to join, writes the group
+    // and wakes up the members with the result, and then the next waiting one leads the next group.
+    Status _group_write(WriteBatch* batch);
+
     std::string _root_path;
     rocksdb::DB* _db;
     std::vector<rocksdb::ColumnFamilyHandle*> _handles;
+
+    std::mutex _writers_lock;
+    std::deque<Writer*> _writers;
 };
 
 } // namespace starrocks
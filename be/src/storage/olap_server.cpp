@@ -23,6 +23,7 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cmath>
 #include <ctime>
 #include <string>
@@ -30,7 +31,9 @@
 #include "common/status.h"
 #include "storage/olap_common.h"
 #include "storage/olap_define.h"
+#include "storage/delete_bitmap_manager.h"
 #include "storage/storage_engine.h"
+#include "storage/tablet_updates.h"
 #include "storage/update_manager.h"
 #include "storage/vectorized/compaction.h"
 #include "util/time.h"
@@ -61,6 +64,16 @@ Status StorageEngine::start_bg_threads() {
     _unused_rowset_monitor_thread.detach();
     LOG(INFO) << "unused rowset monitor thread started";
 
+    _delete_bitmap_materialize_thread = std::thread([this] { _delete_bitmap_materialize_thread_callback(nullptr); });
+    _delete_bitmap_materialize_thread.detach();
+    LOG(INFO) << "delete bitmap materialize thread started";
+
+    if (config::update_index_prewarm_num_threads > 0) {
+        _primary_index_prewarm_thread = std::thread([this] { _primary_index_prewarm_thread_callback(nullptr); });
+        _primary_index_prewarm_thread.detach();
+        LOG(INFO) << "primary index prewarm thread started";
+    }
+
     // start thread for monitoring the snapshot and trash folder
     _garbage_sweeper_thread = std::thread([this] { _garbage_sweeper_thread_callback(nullptr); });
     _garbage_sweeper_thread.detach();
@@ -342,6 +355,58 @@ void* StorageEngine::_update_cache_expire_thread_callback(void* arg) {
     return nullptr;
 }
 
+void* StorageEngine::_delete_bitmap_materialize_thread_callback(void* arg) {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    while (!_stop_bg_worker) {
+        int32_t interval = config::delete_bitmap_materialize_interval_sec;
+        if (interval <= 0) {
+            LOG(WARNING) << "delete_bitmap_materialize_interval_sec config is illegal: " << interval
+                         << ", force set to 60";
+            interval = 60;
+        }
+        SLEEP_IN_BG_WORKER(interval);
+        if (!config::enable_delete_bitmap_materialization) {
+            continue;
+        }
+        for (const TabletSharedPtr& tablet : _tablet_manager->get_tablets_with_delete_predicates()) {
+            if (_stop_bg_worker) {
+                break;
+            }
+            auto st = _delete_bitmap_manager->materialize(tablet);
+            if (!st.ok()) {
+                LOG(WARNING) << "Fail to materialize the delete predicates of tablet " << tablet->tablet_id() << ": "
+                             << st.to_string();
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void* StorageEngine::_primary_index_prewarm_thread_callback(void* arg) {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    std::vector<TabletSharedPtr> tablets = _tablet_manager->get_primary_key_tablets();
+    // the tablets written recently are likely to be written again soon
+    std::vector<std::pair<int64_t, TabletSharedPtr>> sorted;
+    sorted.reserve(tablets.size());
+    for (auto& tablet : tablets) {
+        sorted.emplace_back(tablet->updates()->max_version_creation_time(), std::move(tablet));
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+    tablets.clear();
+    for (auto& [creation_time, tablet] : sorted) {
+        tablets.emplace_back(std::move(tablet));
+    }
+    _update_manager->prewarm_primary_indexes(tablets, config::update_index_prewarm_num_threads,
+                                             [this]() { return _stop_bg_worker; });
+    return nullptr;
+}
+
 void* StorageEngine::_unused_rowset_monitor_thread_callback(void* arg) {
 #ifdef GOOGLE_PROFILER
     ProfilerRegisterThread();
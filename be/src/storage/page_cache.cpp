@@ -21,6 +21,8 @@
 
 #include "storage/page_cache.h"
 
+#include "common/config.h"
+#include "common/logging.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
 #include "util/metrics.h"
@@ -28,7 +30,9 @@
 
 namespace starrocks {
 
-UIntGauge g_cache_size(MetricUnit::BYTES); // NOLINT
+UIntGauge g_cache_size(MetricUnit::BYTES);            // NOLINT
+UIntGauge g_compressed_cache_size(MetricUnit::BYTES); // NOLINT
+UIntGauge g_in_memory_cache_size(MetricUnit::BYTES);  // NOLINT
 
 [[maybe_unused]] static void update_cache_size() {
     StoragePageCache::instance()->update_memory_usage_statistics();
@@ -36,13 +40,16 @@ UIntGauge g_cache_size(MetricUnit::BYTES); // NOLINT
 
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
-void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity, size_t compressed_capacity,
+                                           size_t in_memory_capacity) {
     if (_s_instance == nullptr) {
-        _s_instance = new StoragePageCache(mem_tracker, capacity);
+        _s_instance = new StoragePageCache(mem_tracker, capacity, compressed_capacity, in_memory_capacity);
 #ifndef BE_TEST
         MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
         reg->register_hook("page_cache_size_hook", update_cache_size);
         reg->register_metric("storage_page_cache_bytes", &g_cache_size);
+        reg->register_metric("storage_compressed_page_cache_bytes", &g_compressed_cache_size);
+        reg->register_metric("storage_in_memory_page_cache_bytes", &g_in_memory_cache_size);
 #endif
     }
 }
@@ -56,19 +63,41 @@ void StoragePageCache::release_global_cache() {
 
 void StoragePageCache::update_memory_usage_statistics() {
     int64_t mem_usage = memory_usage();
+    int64_t compressed_mem_usage = compressed_memory_usage();
+    int64_t in_memory_mem_usage = in_memory_memory_usage();
     g_cache_size.set_value(mem_usage);
-    _mem_tracker->consume(mem_usage - _mem_tracker->consumption());
+    g_compressed_cache_size.set_value(compressed_mem_usage);
+    g_in_memory_cache_size.set_value(in_memory_mem_usage);
+    _mem_tracker->consume(mem_usage + compressed_mem_usage + in_memory_mem_usage - _mem_tracker->consumption());
 }
 
-StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity, size_t compressed_capacity,
+                                   size_t in_memory_capacity)
+        : _mem_tracker(mem_tracker),
+          _cache(new_lru_cache(capacity, cache_policy_from_string(config::storage_cache_eviction_policy))) {
+    if (compressed_capacity > 0) {
+        _compressed_cache.reset(
+                new_lru_cache(compressed_capacity, cache_policy_from_string(config::storage_cache_eviction_policy)));
+    }
+    if (in_memory_capacity > 0) {
+        _in_memory_cache.reset(new_lru_cache(in_memory_capacity));
+    }
+}
 
 StoragePageCache::~StoragePageCache() {
     _mem_tracker->release(_mem_tracker->consumption());
 }
 
 bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
-    auto* lru_handle = _cache->lookup(key.encode());
+    std::string encoded_key = key.encode();
+    if (_in_memory_cache != nullptr) {
+        auto* lru_handle = _in_memory_cache->lookup(encoded_key);
+        if (lru_handle != nullptr) {
+            *handle = PageCacheHandle(_in_memory_cache.get(), lru_handle);
+            return true;
+        }
+    }
+    auto* lru_handle = _cache->lookup(encoded_key);
     if (lru_handle == nullptr) {
         return false;
     }
@@ -79,13 +108,43 @@ bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
 void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory) {
     auto deleter = [](const starrocks::CacheKey& key, void* value) { delete[](uint8_t*) value; };
 
+    Cache* cache = _cache.get();
     CachePriority priority = CachePriority::NORMAL;
     if (in_memory) {
-        priority = CachePriority::DURABLE;
+        if (_in_memory_cache != nullptr) {
+            cache = _in_memory_cache.get();
+        } else {
+            priority = CachePriority::DURABLE;
+        }
     }
 
-    auto* lru_handle = _cache->insert(key.encode(), data.data, data.size, deleter, priority);
-    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    auto* lru_handle = cache->insert(key.encode(), data.data, data.size, deleter, priority);
+    *handle = PageCacheHandle(cache, lru_handle);
+}
+
+bool StoragePageCache::should_cache_compressed(size_t compressed_size, size_t uncompressed_size) const {
+    return _compressed_cache != nullptr && compressed_size > 0 &&
+           static_cast<double>(uncompressed_size) >=
+                   static_cast<double>(compressed_size) * config::storage_compressed_page_cache_min_ratio;
+}
+
+bool StoragePageCache::lookup_compressed(const CacheKey& key, PageCacheHandle* handle) {
+    if (_compressed_cache == nullptr) {
+        return false;
+    }
+    auto* lru_handle = _compressed_cache->lookup(key.encode());
+    if (lru_handle == nullptr) {
+        return false;
+    }
+    *handle = PageCacheHandle(_compressed_cache.get(), lru_handle);
+    return true;
+}
+
+void StoragePageCache::insert_compressed(const CacheKey& key, const Slice& data, PageCacheHandle* handle) {
+    DCHECK(_compressed_cache != nullptr);
+    auto deleter = [](const starrocks::CacheKey& key, void* value) { delete[](uint8_t*) value; };
+    auto* lru_handle = _compressed_cache->insert(key.encode(), data.data, data.size, deleter);
+    *handle = PageCacheHandle(_compressed_cache.get(), lru_handle);
 }
 
 } // namespace starrocks
@@ -58,8 +58,10 @@ public:
         }
     };
 
-    // Create global instance of this class
-    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+    // Create global instance of this class. The compressed tier is disabled if |compressed_capacity| is 0, and
+    // the partition of the in_memory pages is disabled if |in_memory_capacity| is 0.
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity, size_t compressed_capacity = 0,
+                                    size_t in_memory_capacity = 0);
 
     static void release_global_cache();
 
@@ -67,7 +69,8 @@ public:
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(MemTracker* mem_tracker, size_t capacity);
+    StoragePageCache(MemTracker* mem_tracker, size_t capacity, size_t compressed_capacity = 0,
+                     size_t in_memory_capacity = 0);
 
     void update_memory_usage_statistics();
 
@@ -84,16 +87,45 @@ public:
     // Given hanlde will be set to valid reference.
     // This function is thread-safe, and when two clients insert two same key
     // concurrently, this function can assure that only one page is cached.
-    // The in_memory page will have higher priority.
+    // The in_memory page is inserted into the partition of the in_memory pages if it's enabled, otherwise it will
+    // have higher priority.
     void insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory = false);
 
+    // The partition of the in_memory pages has its own capacity, so the pages of the in_memory tables are only
+    // evicted by each other, see config::storage_in_memory_page_cache_limit.
+    bool has_in_memory_partition() const { return _in_memory_cache != nullptr; }
+
+    // The compressed tier holds the pages as they're stored in the file, which are decompressed on each hit
+    // and inserted into the tier of the decompressed pages again. A page compressing well takes much less
+    // memory in this tier, so it's still cached after it's evicted from the tier of the decompressed pages.
+    bool has_compressed_tier() const { return _compressed_cache != nullptr; }
+
+    // Whether to cache a page of |compressed_size| bytes in the compressed tier, which is decided by its
+    // compression ratio and config::storage_compressed_page_cache_min_ratio.
+    bool should_cache_compressed(size_t compressed_size, size_t uncompressed_size) const;
+
+    // Same as lookup() and insert(), on the compressed tier.
+    bool lookup_compressed(const CacheKey& key, PageCacheHandle* handle);
+    void insert_compressed(const CacheKey& key, const Slice& data, PageCacheHandle* handle);
+
+    // Evict all the decompressed pages not in use, the compressed tier is kept.
+    void prune() { _cache->prune(); }
+
     size_t memory_usage() const { return _cache->get_memory_usage(); }
+    size_t compressed_memory_usage() const {
+        return _compressed_cache != nullptr ? _compressed_cache->get_memory_usage() : 0;
+    }
+    size_t in_memory_memory_usage() const {
+        return _in_memory_cache != nullptr ? _in_memory_cache->get_memory_usage() : 0;
+    }
 
 private:
     static StoragePageCache* _s_instance;
 
     MemTracker* _mem_tracker = nullptr;
     std::unique_ptr<Cache> _cache = nullptr;
+    std::unique_ptr<Cache> _compressed_cache = nullptr;
+    std::unique_ptr<Cache> _in_memory_cache = nullptr;
 };
 
 // A handle for StoragePageCache entry. This class make it easy to handle
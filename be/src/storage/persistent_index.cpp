@@ -0,0 +1,846 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/persistent_index.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <set>
+
+#include "column/column.h"
+#include "common/config.h"
+#include "common/logging.h"
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/segment_v2/bloom_filter.h"
+#include "storage/tablet_updates.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/debug_util.h"
+#include "util/faststring.h"
+#include "util/hash_util.hpp"
+#include "util/time.h"
+
+namespace starrocks {
+
+using strings::Substitute;
+using segment_v2::BloomFilter;
+
+static constexpr uint64_t kTombstone = std::numeric_limits<uint64_t>::max();
+static constexpr uint32_t kLogBatchMagic = 0x4C304B50;
+static constexpr uint32_t kFileMagic = 0x4C314B50;
+static constexpr uint32_t kManifestMagic = 0x544D4B50;
+static constexpr size_t kRecordsPerBucket = 16;
+static constexpr double kBloomFilterFpp = 0.01;
+static constexpr size_t kWriteBufferSize = 1024 * 1024;
+// hash, value, key size
+static constexpr size_t kRecordHeaderSize = 8 + 8 + 4;
+// num records, bucket dir offset, bloom filter offset, bloom filter size, bucket bits, checksum, magic
+static constexpr size_t kFileFooterSize = 8 + 8 + 8 + 4 + 4 + 4 + 4;
+// magic, major, minor, size, num records, payload size, checksum
+static constexpr size_t kLogBatchHeaderSize = 4 + 8 + 8 + 8 + 4 + 4 + 4;
+// magic, major, minor, size, next file id, num files, checksum
+static constexpr size_t kManifestFixedSize = 4 + 8 + 8 + 8 + 4 + 4 + 4;
+
+static const char* const kManifestName = "index.meta";
+static const char* const kLogName = "index.l0";
+
+// The hash is persisted in the L1 files, so it must not depend on the CPU.
+static uint64_t key_hash(const Slice& key) {
+    return HashUtil::murmur_hash64A(key.data, static_cast<int32_t>(key.size), 0);
+}
+
+static Status io_error(const std::string& context, int err_number) {
+    return Status::IOError(context, static_cast<int16_t>(err_number), std::strerror(err_number));
+}
+
+static bool is_index_file(const std::string& name) {
+    return name == kManifestName || name == kLogName || name == std::string(kManifestName) + ".tmp" ||
+           (name.size() > 9 && name.compare(0, 6, "index.") == 0 && name.compare(name.size() - 3, 3, ".l1") == 0);
+}
+
+// The keys of a column of the encoded primary keys, i.e. the binaries of a binary column or the bytes of the
+// values of a fixed-size one.
+class KeyReader {
+public:
+    explicit KeyReader(const vectorized::Column& pks)
+            : _binary(pks.is_binary()), _data(pks.raw_data()), _type_size(pks.type_size()) {}
+
+    Slice operator[](size_t i) const {
+        if (_binary) {
+            return reinterpret_cast<const Slice*>(_data)[i];
+        }
+        return Slice(_data + i * _type_size, _type_size);
+    }
+
+private:
+    bool _binary;
+    const uint8_t* _data;
+    size_t _type_size;
+};
+
+// An immutable L1 file of the index, whose layout is:
+//   records:      [hash u64][value u64][key size u32][key], sorted by (hash, key)
+//   bucket dir:   (2^bucket_bits + 1) offsets u64, the first record of each bucket, the last one is the end
+//   bloom filter: the bytes of a block split bloom filter of the hashes
+//   footer:       [num records u64][bucket dir offset u64][bloom filter offset u64][bloom filter size u32]
+//                 [bucket bits u32][checksum u32][magic u32]
+// The checksum covers the bucket dir, the bloom filter and the footer before it, the records are read by mmap
+// on demand and not verified.
+class PersistentIndexFile {
+public:
+    PersistentIndexFile(uint32_t id, std::string path) : _id(id), _path(std::move(path)) {}
+
+    ~PersistentIndexFile() {
+        if (_data != nullptr) {
+            munmap(_data, _file_size);
+        }
+    }
+
+    Status open() {
+        int fd = ::open(_path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return io_error(_path, errno);
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            int err = errno;
+            ::close(fd);
+            return io_error(_path, err);
+        }
+        _file_size = st.st_size;
+        if (_file_size < kFileFooterSize) {
+            ::close(fd);
+            return Status::Corruption(Substitute("bad persistent index file $0 of size $1", _path, _file_size));
+        }
+        void* data = mmap(nullptr, _file_size, PROT_READ, MAP_SHARED, fd, 0);
+        int err = errno;
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            return io_error(_path, err);
+        }
+        _data = data;
+        // The records are read by point lookups, the read ahead is wasted.
+        madvise(_data, _file_size, MADV_RANDOM);
+
+        auto* base = static_cast<const uint8_t*>(_data);
+        const uint8_t* footer = base + _file_size - kFileFooterSize;
+        _num_records = decode_fixed64_le(footer);
+        uint64_t bucket_dir_offset = decode_fixed64_le(footer + 8);
+        uint64_t bf_offset = decode_fixed64_le(footer + 16);
+        uint32_t bf_size = decode_fixed32_le(footer + 24);
+        _bucket_bits = decode_fixed32_le(footer + 28);
+        uint32_t checksum = decode_fixed32_le(footer + 32);
+        uint32_t magic = decode_fixed32_le(footer + 36);
+        if (magic != kFileMagic || _bucket_bits > 32 ||
+            bucket_dir_offset + ((1ULL << _bucket_bits) + 1) * 8 != bf_offset ||
+            bf_offset + bf_size + kFileFooterSize != _file_size || bf_size <= 1) {
+            return Status::Corruption(Substitute("bad footer of persistent index file $0", _path));
+        }
+        uint32_t actual = crc32c::Value(reinterpret_cast<const char*>(base + bucket_dir_offset),
+                                        _file_size - bucket_dir_offset - 8);
+        if (actual != checksum) {
+            return Status::Corruption(
+                    Substitute("bad checksum of persistent index file $0: $1 vs $2", _path, actual, checksum));
+        }
+        _records = base;
+        _records_size = bucket_dir_offset;
+        _bucket_dir = base + bucket_dir_offset;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &_bf));
+        return _bf->init(reinterpret_cast<const char*>(base + bf_offset), bf_size, HASH_MURMUR3_X64_64);
+    }
+
+    uint32_t id() const { return _id; }
+
+    const std::string& path() const { return _path; }
+
+    size_t file_size() const { return _file_size; }
+
+    uint64_t num_records() const { return _num_records; }
+
+    size_t memory_usage() const { return _bf != nullptr ? _bf->size() : 0; }
+
+    bool get(const Slice& key, uint64_t hash, uint64_t* value) const {
+        if (!_bf->test_hash(hash)) {
+            return false;
+        }
+        uint64_t bucket = _bucket_bits == 0 ? 0 : hash >> (64 - _bucket_bits);
+        const uint8_t* pos = _records + decode_fixed64_le(_bucket_dir + bucket * 8);
+        const uint8_t* end = _records + decode_fixed64_le(_bucket_dir + (bucket + 1) * 8);
+        while (pos < end) {
+            uint64_t h = decode_fixed64_le(pos);
+            if (h > hash) {
+                break;
+            }
+            uint32_t key_size = decode_fixed32_le(pos + 16);
+            if (h == hash && key_size == key.size && memcmp(pos + kRecordHeaderSize, key.data, key.size) == 0) {
+                *value = decode_fixed64_le(pos + 8);
+                return true;
+            }
+            pos += kRecordHeaderSize + key_size;
+        }
+        return false;
+    }
+
+    // Iterates the records of the file in order.
+    class Iterator {
+    public:
+        explicit Iterator(const PersistentIndexFile& file)
+                : _pos(file._records), _end(file._records + file._records_size) {}
+
+        bool valid() const { return _pos < _end; }
+        uint64_t hash() const { return decode_fixed64_le(_pos); }
+        uint64_t value() const { return decode_fixed64_le(_pos + 8); }
+        Slice key() const { return Slice(_pos + kRecordHeaderSize, decode_fixed32_le(_pos + 16)); }
+        void next() { _pos += kRecordHeaderSize + decode_fixed32_le(_pos + 16); }
+
+    private:
+        const uint8_t* _pos;
+        const uint8_t* _end;
+    };
+
+private:
+    uint32_t _id;
+    std::string _path;
+    void* _data = nullptr;
+    size_t _file_size = 0;
+    uint64_t _num_records = 0;
+    uint32_t _bucket_bits = 0;
+    const uint8_t* _records = nullptr;
+    uint64_t _records_size = 0;
+    const uint8_t* _bucket_dir = nullptr;
+    std::unique_ptr<BloomFilter> _bf;
+};
+
+// Writes an L1 file of at most |max_records| records, which are added in the order of (hash, key).
+class PersistentIndexFileWriter {
+public:
+    PersistentIndexFileWriter(std::string path, uint64_t max_records)
+            : _path(std::move(path)), _max_records(std::max<uint64_t>(max_records, 1)) {}
+
+    Status open() {
+        while (_bucket_bits < 32 && (1ULL << _bucket_bits) * kRecordsPerBucket < _max_records) {
+            _bucket_bits++;
+        }
+        _bucket_dir.reserve((1ULL << _bucket_bits) + 1);
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &_bf));
+        RETURN_IF_ERROR(_bf->init(_max_records, kBloomFilterFpp, HASH_MURMUR3_X64_64));
+        WritableFileOptions opts;
+        opts.mode = Env::CREATE_OR_OPEN_WITH_TRUNCATE;
+        return Env::Default()->new_writable_file(opts, _path, &_file);
+    }
+
+    Status add(uint64_t hash, const Slice& key, uint64_t value) {
+        DCHECK_LT(_num_records, _max_records);
+        uint64_t bucket = _bucket_bits == 0 ? 0 : hash >> (64 - _bucket_bits);
+        while (_bucket_dir.size() <= bucket) {
+            _bucket_dir.push_back(_offset);
+        }
+        put_fixed64_le(&_buffer, hash);
+        put_fixed64_le(&_buffer, value);
+        put_fixed32_le(&_buffer, key.size);
+        _buffer.append(key.data, key.size);
+        _offset += kRecordHeaderSize + key.size;
+        _num_records++;
+        _bf->add_hash(hash);
+        if (_buffer.size() >= kWriteBufferSize) {
+            RETURN_IF_ERROR(_file->append(_buffer));
+            _buffer.clear();
+        }
+        return Status::OK();
+    }
+
+    Status finish() {
+        uint64_t bucket_dir_offset = _offset;
+        while (_bucket_dir.size() <= (1ULL << _bucket_bits)) {
+            _bucket_dir.push_back(_offset);
+        }
+        RETURN_IF_ERROR(_file->append(_buffer));
+        _buffer.clear();
+        for (uint64_t offset : _bucket_dir) {
+            put_fixed64_le(&_buffer, offset);
+        }
+        _buffer.append(_bf->data(), _bf->size());
+        put_fixed64_le(&_buffer, _num_records);
+        put_fixed64_le(&_buffer, bucket_dir_offset);
+        put_fixed64_le(&_buffer, bucket_dir_offset + _bucket_dir.size() * 8);
+        put_fixed32_le(&_buffer, _bf->size());
+        put_fixed32_le(&_buffer, _bucket_bits);
+        put_fixed32_le(&_buffer, crc32c::Value(reinterpret_cast<const char*>(_buffer.data()), _buffer.size()));
+        put_fixed32_le(&_buffer, kFileMagic);
+        RETURN_IF_ERROR(_file->append(_buffer));
+        RETURN_IF_ERROR(_file->sync());
+        return _file->close();
+    }
+
+private:
+    std::string _path;
+    uint64_t _max_records;
+    uint32_t _bucket_bits = 0;
+    std::vector<uint64_t> _bucket_dir;
+    uint64_t _offset = 0;
+    uint64_t _num_records = 0;
+    faststring _buffer;
+    std::unique_ptr<WritableFile> _file;
+    std::unique_ptr<BloomFilter> _bf;
+};
+
+PersistentIndex::PersistentIndex(std::string dir) : _dir(std::move(dir)) {}
+
+PersistentIndex::~PersistentIndex() {
+    if (_log != nullptr) {
+        WARN_IF_ERROR(_log->close(), "fail to close the log of persistent index " + _dir);
+    }
+}
+
+std::string PersistentIndex::_file_path(uint32_t id) const {
+    return Substitute("$0/index.$1.l1", _dir, id);
+}
+
+Status PersistentIndex::remove_files(const std::string& dir) {
+    Env* env = Env::Default();
+    std::vector<std::string> names;
+    RETURN_IF_ERROR(env->get_children(dir, &names));
+    for (const auto& name : names) {
+        if (is_index_file(name)) {
+            RETURN_IF_ERROR(env->delete_file(dir + "/" + name));
+        }
+    }
+    return Status::OK();
+}
+
+void PersistentIndex::_clear() {
+    decltype(_l0)().swap(_l0);
+    _l0_key_bytes = 0;
+    _pending.clear();
+    _num_pending = 0;
+    _files.clear();
+    _size = 0;
+    if (_log != nullptr) {
+        WARN_IF_ERROR(_log->close(), "fail to close the log of persistent index " + _dir);
+        _log.reset();
+    }
+}
+
+Status PersistentIndex::load(const EditVersion& version) {
+    _clear();
+    _building = false;
+    bool found = false;
+    RETURN_IF_ERROR(_load_manifest(&found));
+    if (!found) {
+        return Status::NotFound(Substitute("no persistent index in $0", _dir));
+    }
+    EditVersion flushed(_flushed_major, _flushed_minor);
+    if (version < flushed) {
+        return Status::NotFound(Substitute("persistent index in $0 is flushed at $1 after $2", _dir,
+                                           flushed.to_string(), version.to_string()));
+    }
+    _major = _flushed_major;
+    _minor = _flushed_minor;
+    RETURN_IF_ERROR(_replay_log(version));
+    if (!(EditVersion(_major, _minor) == version)) {
+        return Status::NotFound(Substitute("persistent index in $0 is committed at $1 before $2", _dir,
+                                           EditVersion(_major, _minor).to_string(), version.to_string()));
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::reset(const EditVersion& version) {
+    _clear();
+    RETURN_IF_ERROR(remove_files(_dir));
+    _building = true;
+    _major = version.major();
+    _minor = version.minor();
+    _flushed_major = 0;
+    _flushed_minor = 0;
+    _next_file_id = 0;
+    return Status::OK();
+}
+
+Status PersistentIndex::_load_manifest(bool* found) {
+    Env* env = Env::Default();
+    std::string path = _dir + "/" + kManifestName;
+    if (!env->path_exists(path).ok()) {
+        *found = false;
+        return Status::OK();
+    }
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(env->get_file_size(path, &file_size));
+    std::unique_ptr<RandomAccessFile> file;
+    RETURN_IF_ERROR(env->new_random_access_file(path, &file));
+    std::string data(file_size, '\0');
+    RETURN_IF_ERROR(file->read_at(0, Slice(data)));
+
+    auto* p = reinterpret_cast<const uint8_t*>(data.data());
+    if (file_size < kManifestFixedSize || decode_fixed32_le(p) != kManifestMagic) {
+        return Status::Corruption(Substitute("bad persistent index manifest $0", path));
+    }
+    uint32_t num_files = decode_fixed32_le(p + 32);
+    if (file_size != kManifestFixedSize + num_files * 4 ||
+        crc32c::Value(data.data(), file_size - 4) != decode_fixed32_le(p + file_size - 4)) {
+        return Status::Corruption(Substitute("bad persistent index manifest $0", path));
+    }
+    _flushed_major = decode_fixed64_le(p + 4);
+    _flushed_minor = decode_fixed64_le(p + 12);
+    _size = decode_fixed64_le(p + 20);
+    _next_file_id = decode_fixed32_le(p + 28);
+    std::set<std::string> live_files;
+    for (uint32_t i = 0; i < num_files; i++) {
+        uint32_t id = decode_fixed32_le(p + 36 + i * 4);
+        auto file = std::make_unique<PersistentIndexFile>(id, _file_path(id));
+        RETURN_IF_ERROR(file->open());
+        live_files.insert(Substitute("index.$0.l1", id));
+        _files.emplace_back(std::move(file));
+    }
+
+    // The files flushed or merged but not recorded by the manifest before a crash.
+    std::vector<std::string> names;
+    RETURN_IF_ERROR(env->get_children(_dir, &names));
+    for (const auto& name : names) {
+        if (is_index_file(name) && name != kManifestName && name != kLogName && live_files.count(name) == 0) {
+            LOG(INFO) << "remove orphan persistent index file " << _dir << "/" << name;
+            WARN_IF_ERROR(env->delete_file(_dir + "/" + name), "fail to remove orphan persistent index file");
+        }
+    }
+    *found = true;
+    return Status::OK();
+}
+
+Status PersistentIndex::_write_manifest() {
+    std::string data;
+    put_fixed32_le(&data, kManifestMagic);
+    put_fixed64_le(&data, _flushed_major);
+    put_fixed64_le(&data, _flushed_minor);
+    put_fixed64_le(&data, _size);
+    put_fixed32_le(&data, _next_file_id);
+    put_fixed32_le(&data, _files.size());
+    for (const auto& file : _files) {
+        put_fixed32_le(&data, file->id());
+    }
+    put_fixed32_le(&data, crc32c::Value(data.data(), data.size()));
+
+    Env* env = Env::Default();
+    std::string path = _dir + "/" + kManifestName;
+    std::string tmp_path = path + ".tmp";
+    std::unique_ptr<WritableFile> file;
+    WritableFileOptions opts;
+    opts.mode = Env::CREATE_OR_OPEN_WITH_TRUNCATE;
+    RETURN_IF_ERROR(env->new_writable_file(opts, tmp_path, &file));
+    RETURN_IF_ERROR(file->append(data));
+    RETURN_IF_ERROR(file->sync());
+    RETURN_IF_ERROR(file->close());
+    RETURN_IF_ERROR(env->rename_file(tmp_path, path));
+    return env->sync_dir(_dir);
+}
+
+Status PersistentIndex::_replay_log(const EditVersion& version) {
+    Env* env = Env::Default();
+    std::string path = _dir + "/" + kLogName;
+    if (!env->path_exists(path).ok()) {
+        return _reset_log();
+    }
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(env->get_file_size(path, &file_size));
+    std::unique_ptr<RandomAccessFile> file;
+    RETURN_IF_ERROR(env->new_random_access_file(path, &file));
+
+    EditVersion flushed(_flushed_major, _flushed_minor);
+    std::string header(kLogBatchHeaderSize, '\0');
+    std::string payload;
+    uint64_t offset = 0;
+    while (offset + kLogBatchHeaderSize <= file_size) {
+        RETURN_IF_ERROR(file->read_at(offset, Slice(header)));
+        auto* p = reinterpret_cast<const uint8_t*>(header.data());
+        EditVersion batch_version(decode_fixed64_le(p + 4), decode_fixed64_le(p + 12));
+        uint64_t size = decode_fixed64_le(p + 20);
+        uint32_t num_records = decode_fixed32_le(p + 28);
+        uint32_t payload_size = decode_fixed32_le(p + 32);
+        uint32_t checksum = decode_fixed32_le(p + 36);
+        if (decode_fixed32_le(p) != kLogBatchMagic || offset + kLogBatchHeaderSize + payload_size > file_size) {
+            // A batch partially written before a crash.
+            LOG(WARNING) << "bad persistent index log batch at " << offset << " of " << path;
+            break;
+        }
+        if (version < batch_version) {
+            // The version isn't applied by the tablet, discard it and the later ones.
+            break;
+        }
+        uint64_t next_offset = offset + kLogBatchHeaderSize + payload_size;
+        if (!(flushed < batch_version)) {
+            offset = next_offset;
+            continue;
+        }
+        payload.resize(payload_size);
+        RETURN_IF_ERROR(file->read_at(offset + kLogBatchHeaderSize, Slice(payload)));
+        uint32_t actual = crc32c::Extend(crc32c::Value(header.data(), kLogBatchHeaderSize - 4), payload.data(),
+                                         payload.size());
+        if (actual != checksum) {
+            LOG(WARNING) << "bad checksum of persistent index log batch at " << offset << " of " << path;
+            break;
+        }
+        auto* pos = reinterpret_cast<const uint8_t*>(payload.data());
+        const uint8_t* end = pos + payload.size();
+        for (uint32_t i = 0; i < num_records; i++) {
+            if (pos + 4 > end || pos + 4 + decode_fixed32_le(pos) + 8 > end) {
+                return Status::Corruption(Substitute("bad persistent index log batch at $0 of $1", offset, path));
+            }
+            uint32_t key_size = decode_fixed32_le(pos);
+            Slice key(pos + 4, key_size);
+            uint64_t value = decode_fixed64_le(pos + 4 + key_size);
+            auto iter = _l0.find(std::string_view(key.data, key.size));
+            if (iter != _l0.end()) {
+                iter->second = value;
+            } else {
+                _l0.emplace(key.to_string(), value);
+                _l0_key_bytes += key_size;
+            }
+            pos += 4 + key_size + 8;
+        }
+        _size = size;
+        _major = batch_version.major();
+        _minor = batch_version.minor();
+        offset = next_offset;
+    }
+    file.reset();
+
+    if (offset < file_size) {
+        LOG(INFO) << "truncate persistent index log " << path << " from " << file_size << " to " << offset;
+        if (::truncate(path.c_str(), offset) != 0) {
+            return io_error(path, errno);
+        }
+    }
+    WritableFileOptions opts;
+    opts.mode = Env::MUST_EXIST;
+    return env->new_writable_file(opts, path, &_log);
+}
+
+Status PersistentIndex::_reset_log() {
+    if (_log != nullptr) {
+        RETURN_IF_ERROR(_log->close());
+        _log.reset();
+    }
+    WritableFileOptions opts;
+    opts.mode = Env::CREATE_OR_OPEN_WITH_TRUNCATE;
+    return Env::Default()->new_writable_file(opts, _dir + "/" + kLogName, &_log);
+}
+
+bool PersistentIndex::_get(const Slice& key, uint64_t* value) const {
+    auto iter = _l0.find(std::string_view(key.data, key.size));
+    if (iter != _l0.end()) {
+        *value = iter->second;
+        return *value != kTombstone;
+    }
+    if (_files.empty()) {
+        return false;
+    }
+    uint64_t hash = key_hash(key);
+    for (auto file = _files.rbegin(); file != _files.rend(); ++file) {
+        if ((*file)->get(key, hash, value)) {
+            return *value != kTombstone;
+        }
+    }
+    return false;
+}
+
+void PersistentIndex::_set(const Slice& key, uint64_t value) {
+    auto iter = _l0.find(std::string_view(key.data, key.size));
+    if (iter != _l0.end()) {
+        iter->second = value;
+    } else {
+        _l0.emplace(key.to_string(), value);
+        _l0_key_bytes += key.size;
+    }
+    if (!_building) {
+        put_fixed32_le(&_pending, key.size);
+        _pending.append(key.data, key.size);
+        put_fixed64_le(&_pending, value);
+        _num_pending++;
+    }
+}
+
+Status PersistentIndex::_flush_l0() {
+    if (_l0.empty()) {
+        return Status::OK();
+    }
+    struct Entry {
+        uint64_t hash;
+        Slice key;
+        uint64_t value;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(_l0.size());
+    for (const auto& [key, value] : _l0) {
+        entries.push_back({key_hash(Slice(key)), Slice(key), value});
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+        return lhs.hash < rhs.hash || (lhs.hash == rhs.hash && lhs.key.compare(rhs.key) < 0);
+    });
+    // The tombstones are useless if there is no older file.
+    bool drop_tombstones = _files.empty();
+    uint32_t id = _next_file_id++;
+    PersistentIndexFileWriter writer(_file_path(id), entries.size());
+    RETURN_IF_ERROR(writer.open());
+    for (const auto& e : entries) {
+        if (drop_tombstones && e.value == kTombstone) {
+            continue;
+        }
+        RETURN_IF_ERROR(writer.add(e.hash, e.key, e.value));
+    }
+    RETURN_IF_ERROR(writer.finish());
+    auto file = std::make_unique<PersistentIndexFile>(id, _file_path(id));
+    RETURN_IF_ERROR(file->open());
+    _files.emplace_back(std::move(file));
+    decltype(_l0)().swap(_l0);
+    _l0_key_bytes = 0;
+    return Status::OK();
+}
+
+// Merges the newest file into the one before it while the older one is no more than twice as large, so the files
+// shrink geometrically from the oldest to the newest and a key is rewritten O(log n) times.
+Status PersistentIndex::_merge_files(std::vector<std::string>* obsolete_files) {
+    while (_files.size() >= 2 && _files[_files.size() - 2]->file_size() <= 2 * _files.back()->file_size()) {
+        const PersistentIndexFile& older = *_files[_files.size() - 2];
+        const PersistentIndexFile& newer = *_files.back();
+        bool drop_tombstones = _files.size() == 2;
+        uint32_t id = _next_file_id++;
+        PersistentIndexFileWriter writer(_file_path(id), older.num_records() + newer.num_records());
+        RETURN_IF_ERROR(writer.open());
+        PersistentIndexFile::Iterator a(newer);
+        PersistentIndexFile::Iterator b(older);
+        while (a.valid() || b.valid()) {
+            int cmp = 0;
+            if (!a.valid()) {
+                cmp = 1;
+            } else if (!b.valid()) {
+                cmp = -1;
+            } else if (a.hash() != b.hash()) {
+                cmp = a.hash() < b.hash() ? -1 : 1;
+            } else {
+                cmp = a.key().compare(b.key());
+            }
+            // The record of the newer file replaces the one of the same key in the older file.
+            auto& it = cmp <= 0 ? a : b;
+            if (!drop_tombstones || it.value() != kTombstone) {
+                RETURN_IF_ERROR(writer.add(it.hash(), it.key(), it.value()));
+            }
+            if (cmp == 0) {
+                b.next();
+            }
+            it.next();
+        }
+        RETURN_IF_ERROR(writer.finish());
+        auto file = std::make_unique<PersistentIndexFile>(id, _file_path(id));
+        RETURN_IF_ERROR(file->open());
+        obsolete_files->push_back(older.path());
+        obsolete_files->push_back(newer.path());
+        _files.pop_back();
+        _files.back() = std::move(file);
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::_maybe_flush_building() {
+    if (!_building || _l0_memory_usage() < config::persistent_index_l0_max_mem_bytes) {
+        return Status::OK();
+    }
+    // No manifest refers to the files being built, so the merged ones are removed at once.
+    std::vector<std::string> obsolete_files;
+    RETURN_IF_ERROR(_flush_l0());
+    RETURN_IF_ERROR(_merge_files(&obsolete_files));
+    for (const auto& path : obsolete_files) {
+        RETURN_IF_ERROR(Env::Default()->delete_file(path));
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::commit(const EditVersion& version) {
+    Env* env = Env::Default();
+    if (!_building) {
+        DCHECK(EditVersion(_major, _minor) < version);
+        std::string header;
+        put_fixed32_le(&header, kLogBatchMagic);
+        put_fixed64_le(&header, version.major());
+        put_fixed64_le(&header, version.minor());
+        put_fixed64_le(&header, _size);
+        put_fixed32_le(&header, _num_pending);
+        put_fixed32_le(&header, _pending.size());
+        put_fixed32_le(&header, crc32c::Extend(crc32c::Value(header.data(), header.size()), _pending.data(),
+                                               _pending.size()));
+        Slice batch[2] = {Slice(header), Slice(_pending)};
+        RETURN_IF_ERROR(_log->appendv(batch, 2));
+        RETURN_IF_ERROR(_log->sync());
+        _pending.clear();
+        _num_pending = 0;
+        _major = version.major();
+        _minor = version.minor();
+        // The log is bounded as well, the same keys may be updated many times in L0.
+        if (_l0_memory_usage() < config::persistent_index_l0_max_mem_bytes &&
+            _log->size() < 2 * config::persistent_index_l0_max_mem_bytes) {
+            return Status::OK();
+        }
+    } else {
+        DCHECK(EditVersion(_major, _minor) == version);
+    }
+
+    int64_t t_start = MonotonicMillis();
+    std::vector<std::string> obsolete_files;
+    RETURN_IF_ERROR(_flush_l0());
+    RETURN_IF_ERROR(_merge_files(&obsolete_files));
+    _flushed_major = version.major();
+    _flushed_minor = version.minor();
+    RETURN_IF_ERROR(_write_manifest());
+    _building = false;
+    for (const auto& path : obsolete_files) {
+        WARN_IF_ERROR(env->delete_file(path), "fail to remove persistent index file " + path);
+    }
+    RETURN_IF_ERROR(_reset_log());
+    LOG(INFO) << "flush persistent index " << _dir << " version:" << version.to_string() << " size:" << _size
+              << " #file:" << _files.size() << " duration:" << MonotonicMillis() - t_start << "ms";
+    return Status::OK();
+}
+
+template <typename RowidAt>
+Status PersistentIndex::_insert(uint32_t rssid, const vectorized::Column& pks, const RowidAt& rowid_at) {
+    KeyReader keys(pks);
+    uint64_t base = ((uint64_t)rssid) << 32;
+    for (size_t i = 0; i < pks.size(); i++) {
+        Slice key = keys[i];
+        uint64_t old = 0;
+        if (_get(key, &old)) {
+            std::string msg = Substitute(
+                    "insert found duplicate key new(rssid=$0 rowid=$1) old(rssid=$2 rowid=$3) key=$4 [$5]", rssid,
+                    rowid_at(i), (uint32_t)(old >> 32), (uint32_t)(old & 0xffffffff), key.to_string(),
+                    hexdump(key.data, key.size));
+            LOG(ERROR) << msg;
+            return Status::InternalError(msg);
+        }
+        _set(key, base + rowid_at(i));
+        _size++;
+    }
+    return _maybe_flush_building();
+}
+
+template <typename RowidAt>
+void PersistentIndex::_upsert(uint32_t rssid, const vectorized::Column& pks, const RowidAt& rowid_at,
+                              DeletesMap* deletes) {
+    KeyReader keys(pks);
+    uint64_t base = ((uint64_t)rssid) << 32;
+    for (size_t i = 0; i < pks.size(); i++) {
+        Slice key = keys[i];
+        uint64_t old = 0;
+        if (_get(key, &old)) {
+            if ((old >> 32) == rssid) {
+                LOG(ERROR) << "found duplicate in upsert data rssid:" << rssid << " key=" << key.to_string() << " ["
+                           << hexdump(key.data, key.size) << "]";
+            }
+            (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+        } else {
+            _size++;
+        }
+        _set(key, base + rowid_at(i));
+    }
+}
+
+template <typename RowidAt>
+void PersistentIndex::_try_replace(uint32_t rssid, const vectorized::Column& pks, const RowidAt& rowid_at,
+                                   const vector<uint32_t>& src_rssid, vector<uint32_t>* failed) {
+    KeyReader keys(pks);
+    uint64_t base = ((uint64_t)rssid) << 32;
+    for (size_t i = 0; i < pks.size(); i++) {
+        Slice key = keys[i];
+        uint64_t old = 0;
+        if (_get(key, &old) && (uint32_t)(old >> 32) == src_rssid[i]) {
+            _set(key, base + rowid_at(i));
+        } else {
+            failed->push_back(rowid_at(i));
+        }
+    }
+}
+
+Status PersistentIndex::insert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks) {
+    return _insert(rssid, pks, [rowid_start](size_t i) { return rowid_start + (uint32_t)i; });
+}
+
+Status PersistentIndex::insert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks) {
+    DCHECK_EQ(rowids.size(), pks.size());
+    return _insert(rssid, pks, [&rowids](size_t i) { return rowids[i]; });
+}
+
+void PersistentIndex::upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
+                             DeletesMap* deletes) {
+    _upsert(rssid, pks, [rowid_start](size_t i) { return rowid_start + (uint32_t)i; }, deletes);
+}
+
+void PersistentIndex::upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                             DeletesMap* deletes) {
+    DCHECK_EQ(rowids.size(), pks.size());
+    _upsert(rssid, pks, [&rowids](size_t i) { return rowids[i]; }, deletes);
+}
+
+void PersistentIndex::try_replace(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
+                                  const vector<uint32_t>& src_rssid, vector<uint32_t>* failed) {
+    _try_replace(rssid, pks, [rowid_start](size_t i) { return rowid_start + (uint32_t)i; }, src_rssid, failed);
+}
+
+void PersistentIndex::try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                                  const vector<uint32_t>& src_rssid, vector<uint32_t>* failed) {
+    DCHECK_EQ(rowids.size(), pks.size());
+    _try_replace(rssid, pks, [&rowids](size_t i) { return rowids[i]; }, src_rssid, failed);
+}
+
+void PersistentIndex::erase(const vectorized::Column& pks, DeletesMap* deletes) {
+    KeyReader keys(pks);
+    for (size_t i = 0; i < pks.size(); i++) {
+        Slice key = keys[i];
+        uint64_t old = 0;
+        if (_get(key, &old)) {
+            (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+            _set(key, kTombstone);
+            _size--;
+        }
+    }
+}
+
+void PersistentIndex::get(const vectorized::Column& pks, vector<uint64_t>* rowids) const {
+    KeyReader keys(pks);
+    rowids->resize(pks.size());
+    for (size_t i = 0; i < pks.size(); i++) {
+        if (!_get(keys[i], &(*rowids)[i])) {
+            (*rowids)[i] = PrimaryIndex::NullIndexValue;
+        }
+    }
+}
+
+size_t PersistentIndex::_l0_memory_usage() const {
+    // The same estimation as the in-memory index, the std::string longer than 15 allocates the key.
+    size_t ret = _l0.capacity() * (1 + sizeof(std::string) + sizeof(uint64_t));
+    if (!_l0.empty() && _l0_key_bytes / _l0.size() > 15) {
+        ret += _l0_key_bytes + _l0.size() * 8;
+    }
+    return ret + _pending.capacity();
+}
+
+size_t PersistentIndex::memory_usage() const {
+    size_t ret = _l0_memory_usage();
+    for (const auto& file : _files) {
+        ret += file->memory_usage();
+    }
+    return ret;
+}
+
+std::string PersistentIndex::memory_info() const {
+    size_t file_bytes = 0;
+    for (const auto& file : _files) {
+        file_bytes += file->file_size();
+    }
+    return Substitute("$0M(l0:$1/$2 l1:$3 files $4M)", memory_usage() / (1024 * 1024), _l0.size(), _l0.capacity(),
+                      _files.size(), file_bytes / (1024 * 1024));
+}
+
+} // namespace starrocks
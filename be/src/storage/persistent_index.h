@@ -0,0 +1,128 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "storage/primary_index.h"
+#include "util/phmap/phmap.h"
+
+namespace starrocks {
+
+struct EditVersion;
+class PersistentIndexFile;
+class WritableFile;
+
+// PersistentIndex is a primary index persisted into the files under a directory, usually the tablet's, so it's
+// opened from the files instead of rebuilt from all the primary keys of the tablet, and only the recent changes
+// and the bloom filters of the files are kept in memory.
+//
+// It's a small LSM tree of two levels:
+//  * L0 is an in-memory hash map of the recent changes. The changes of each committed version are appended into
+//    the write-ahead log "index.l0" first.
+//  * L1 is the immutable files "index.<id>.l1" flushed from L0, which are read by mmap. The records of a file are
+//    sorted by the hash of the keys and addressed by the buckets of the high bits of the hash, and a bloom filter
+//    of the file is kept in memory to skip it.
+// A key is looked up in L0 first and then the L1 files from the newest to the oldest. An erased key is kept as a
+// tombstone until it's merged into the oldest file.
+//
+// The manifest "index.meta" records the L1 files and the version flushed into them, and the log has the changes
+// of the later versions, so the index can be opened as of any version from the flushed to the last committed one.
+class PersistentIndex {
+public:
+    using DeletesMap = PrimaryIndex::DeletesMap;
+
+    explicit PersistentIndex(std::string dir);
+    ~PersistentIndex();
+
+    // Open the index as of |version|, the changes committed after it are discarded. Returns NotFound if the files
+    // don't have the version, the caller should rebuild the index by reset(), insert() and commit() then.
+    Status load(const EditVersion& version);
+
+    // Remove all the files of the index and start building it again as of |version|. The keys inserted are
+    // persisted by commit(|version|).
+    Status reset(const EditVersion& version);
+
+    // Persist the changes since the last commit as the changes of |version|, and flush L0 into a new L1 file if it
+    // exceeds config::persistent_index_l0_max_mem_bytes. It must be called before |version| is applied in the
+    // tablet meta, so the index never has the changes of a version the tablet doesn't have after a restart.
+    Status commit(const EditVersion& version);
+
+    // The same as the ones of PrimaryIndex.
+    Status insert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks);
+    Status insert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks);
+    void upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes);
+    void upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks, DeletesMap* deletes);
+    void try_replace(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
+                     const vector<uint32_t>& src_rssid, vector<uint32_t>* failed);
+    void try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                     const vector<uint32_t>& src_rssid, vector<uint32_t>* failed);
+    void erase(const vectorized::Column& pks, DeletesMap* deletes);
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const;
+
+    // The number of the keys in the index.
+    size_t size() const { return _size; }
+
+    // The capacity of the hash map of L0.
+    size_t capacity() const { return _l0.capacity(); }
+
+    size_t memory_usage() const;
+
+    std::string memory_info() const;
+
+    // Remove all the files of the index under |dir|.
+    static Status remove_files(const std::string& dir);
+
+private:
+    template <typename RowidAt>
+    Status _insert(uint32_t rssid, const vectorized::Column& pks, const RowidAt& rowid_at);
+    template <typename RowidAt>
+    void _upsert(uint32_t rssid, const vectorized::Column& pks, const RowidAt& rowid_at, DeletesMap* deletes);
+    template <typename RowidAt>
+    void _try_replace(uint32_t rssid, const vectorized::Column& pks, const RowidAt& rowid_at,
+                      const vector<uint32_t>& src_rssid, vector<uint32_t>* failed);
+
+    // Returns true and sets |value| if |key| is in the index.
+    bool _get(const Slice& key, uint64_t* value) const;
+
+    void _set(const Slice& key, uint64_t value);
+
+    Status _load_manifest(bool* found);
+    Status _write_manifest();
+    Status _replay_log(const EditVersion& version);
+    Status _reset_log();
+    Status _flush_l0();
+    Status _merge_files(std::vector<std::string>* obsolete_files);
+    // Flush L0 while the index is being rebuilt, so the memory is bounded before it's committed.
+    Status _maybe_flush_building();
+    size_t _l0_memory_usage() const;
+    void _clear();
+
+    std::string _file_path(uint32_t id) const;
+
+    std::string _dir;
+    // Whether the index is being rebuilt by reset(), the changes aren't logged until it's committed.
+    bool _building = false;
+    size_t _size = 0;
+    int64_t _major = 0;
+    int64_t _minor = 0;
+    // The version flushed into the L1 files.
+    int64_t _flushed_major = 0;
+    int64_t _flushed_minor = 0;
+
+    phmap::flat_hash_map<std::string, uint64_t> _l0;
+    size_t _l0_key_bytes = 0;
+    // The records of the changes since the last commit, appended into the log by commit().
+    std::string _pending;
+    size_t _num_pending = 0;
+    std::unique_ptr<WritableFile> _log;
+
+    uint32_t _next_file_id = 0;
+    // From the oldest to the newest.
+    std::vector<std::unique_ptr<PersistentIndexFile>> _files;
+};
+
+} // namespace starrocks
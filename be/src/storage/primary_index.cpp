@@ -2,8 +2,11 @@
 
 #include "storage/primary_index.h"
 
+#include <functional>
 #include <mutex>
 
+#include "common/config.h"
+#include "storage/persistent_index.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset.h"
@@ -12,7 +15,9 @@
 #include "storage/tablet_updates.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/reader.h"
+#include "util/countdown_latch.h"
 #include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -49,6 +54,14 @@ public:
                              const vector<uint32_t>& src_rssid, vector<uint32_t>* failed) = 0;
     virtual void erase(const vectorized::Column& pks, DeletesMap* deletes) = 0;
 
+    // Set (*rowids)[i] to the position of pks[i], or PrimaryIndex::NullIndexValue if it's not in the index.
+    virtual void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const = 0;
+
+    // Split the positions of the keys of |pks| into |num_shards| shards by the sub-maps of the keys, |num_shards|
+    // must be a divisor of the number of the sub-maps. The keys of different shards can be updated concurrently.
+    virtual void split_by_shard(const vectorized::Column& pks, uint32_t num_shards,
+                                vector<vector<uint32_t>>* idxes) const = 0;
+
     // just an estimate value for now.
     virtual std::size_t memory_usage() const = 0;
 
@@ -247,6 +260,27 @@ public:
         }
     }
 
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const override {
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        auto size = pks.size();
+        rowids->resize(size);
+        for (auto i = 0; i < size; i++) {
+            uint32_t prefetch_i = i + PREFETCHN;
+            if (LIKELY(prefetch_i < size)) _map.prefetch(keys[prefetch_i]);
+            auto iter = _map.find(keys[i]);
+            (*rowids)[i] = iter != _map.end() ? iter->second.value : PrimaryIndex::NullIndexValue;
+        }
+    }
+
+    void split_by_shard(const vectorized::Column& pks, uint32_t num_shards,
+                        vector<vector<uint32_t>>* idxes) const override {
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        auto size = pks.size();
+        for (uint32_t i = 0; i < size; i++) {
+            (*idxes)[_map.subidx(_map.hash(keys[i])) % num_shards].push_back(i);
+        }
+    }
+
     std::size_t memory_usage() const final {
         return _map.capacity() * (1 + (sizeof(Key) + 3) / 4 * 4 + sizeof(RowIdPack4));
     }
@@ -525,6 +559,25 @@ public:
         }
     }
 
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint32_t size = pks.size();
+        rowids->resize(size);
+        for (uint32_t i = 0; i < size; i++) {
+            auto iter = _map.find(FixSlice<S>(keys[i]));
+            (*rowids)[i] = iter != _map.end() ? iter->second.value : PrimaryIndex::NullIndexValue;
+        }
+    }
+
+    void split_by_shard(const vectorized::Column& pks, uint32_t num_shards,
+                        vector<vector<uint32_t>>* idxes) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint32_t size = pks.size();
+        for (uint32_t i = 0; i < size; i++) {
+            (*idxes)[_map.subidx(FixSliceHash<S>()(FixSlice<S>(keys[i]))) % num_shards].push_back(i);
+        }
+    }
+
     std::size_t memory_usage() const final { return _map.capacity() * (1 + S * 4 + sizeof(RowIdPack4)); }
 
     std::string memory_info() const {
@@ -550,7 +603,8 @@ private:
                                           phmap::NullMutex, false>;
 
     StringMap _map;
-    size_t _total_length = 0;
+    // updated by the shards concurrently
+    std::atomic<size_t> _total_length{0};
 
 public:
     HashIndexImpl() = default;
@@ -733,6 +787,26 @@ public:
         }
     }
 
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint32_t size = pks.size();
+        rowids->resize(size);
+        for (uint32_t i = 0; i < size; i++) {
+            auto p = _map.find(keys[i].to_string());
+            (*rowids)[i] = p != _map.end() ? p->second : PrimaryIndex::NullIndexValue;
+        }
+    }
+
+    void split_by_shard(const vectorized::Column& pks, uint32_t num_shards,
+                        vector<vector<uint32_t>>* idxes) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint32_t size = pks.size();
+        for (uint32_t i = 0; i < size; i++) {
+            size_t hv = vectorized::crc_hash_64(keys[i].data, keys[i].size, 0x811C9DC5);
+            (*idxes)[_map.subidx(hv) % num_shards].push_back(i);
+        }
+    }
+
     std::size_t memory_usage() const final {
         // TODO(cbl): more accurate value
         size_t ret = _map.capacity() * (1 + 32 + sizeof(tablet_rowid_t));
@@ -837,6 +911,7 @@ void PrimaryIndex::unload() {
     if (_pkey_to_rssid_rowid) {
         _pkey_to_rssid_rowid.reset();
     }
+    _persistent_index.reset();
     _status = Status::OK();
     _loaded = false;
 }
@@ -867,7 +942,7 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
     auto pkey_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, pk_columns);
     _set_schema(pkey_schema);
 
-    int64_t apply_version = 0;
+    EditVersion apply_version;
     std::vector<RowsetSharedPtr> rowsets;
     std::vector<uint32_t> rowset_ids;
     RETURN_IF_ERROR(tablet->updates()->_get_apply_version_and_rowsets(&apply_version, &rowsets, &rowset_ids));
@@ -892,7 +967,20 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
                   << " #rowset:" << rowsets.size() << " #segment:" << total_segments << " #row:" << total_rows << " -"
                   << total_dels << "=" << total_rows - total_dels << " bytes:" << total_data_size;
     }
-    if (total_rows > total_dels) {
+    if (config::enable_persistent_index) {
+        _persistent_index = std::make_unique<PersistentIndex>(tablet->tablet_path());
+        st = _persistent_index->load(apply_version);
+        if (st.ok() && _persistent_index->size() == total_rows - total_dels) {
+            _tablet_id = tablet->tablet_id();
+            LOG(INFO) << "load persistent primary index finish tablet:" << tablet->tablet_id()
+                      << " version:" << apply_version << " size:" << size() << " memory:" << memory_info()
+                      << " duration: " << timer.elapsed_time() / 1000000 << "ms";
+            return Status::OK();
+        }
+        LOG(INFO) << "rebuild persistent primary index tablet:" << tablet->tablet_id() << " version:" << apply_version
+                  << " size:" << _persistent_index->size() << " expect:" << total_rows - total_dels << " " << st;
+        RETURN_IF_ERROR(_persistent_index->reset(apply_version));
+    } else if (total_rows > total_dels) {
         _pkey_to_rssid_rowid->reserve(total_rows - total_dels);
     }
 
@@ -912,7 +1000,8 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
         RowsetReleaseGuard guard(rowset);
         auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
         auto res =
-                beta_rowset->get_segment_iterators2(pkey_schema, tablet->data_dir()->get_meta(), apply_version, &stats);
+                beta_rowset->get_segment_iterators2(pkey_schema, tablet->data_dir()->get_meta(), apply_version.major(),
+                                                    &stats);
         if (!res.ok()) {
             return res.status();
         }
@@ -955,6 +1044,9 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
             itr->close();
         }
     }
+    if (_persistent_index) {
+        RETURN_IF_ERROR(_persistent_index->commit(apply_version));
+    }
     _tablet_id = tablet->tablet_id();
     if (size() != total_rows - total_dels) {
         LOG(WARNING) << Substitute("load primary index row count not match tablet:$0 index:$1 != stats:$2", _tablet_id,
@@ -969,55 +1061,211 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
 
 Status PrimaryIndex::insert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    if (_persistent_index) {
+        return _persistent_index->insert(rssid, rowid_start, pks);
+    }
     return _pkey_to_rssid_rowid->insert(rssid, rowid_start, pks);
 }
 
 Status PrimaryIndex::insert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    if (_persistent_index) {
+        return _persistent_index->insert(rssid, rowids, pks);
+    }
     return _pkey_to_rssid_rowid->insert(rssid, rowids, pks);
 }
 
 void PrimaryIndex::upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    if (_persistent_index) {
+        _persistent_index->upsert(rssid, rowid_start, pks, deletes);
+        return;
+    }
     _pkey_to_rssid_rowid->upsert(rssid, rowid_start, pks, deletes);
 }
 
 void PrimaryIndex::upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
                           DeletesMap* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    if (_persistent_index) {
+        _persistent_index->upsert(rssid, rowids, pks, deletes);
+        return;
+    }
     _pkey_to_rssid_rowid->upsert(rssid, rowids, pks, deletes);
 }
 
+void PrimaryIndex::upsert_rowset(uint32_t rowset_id, const std::vector<std::unique_ptr<Column>>& upserts,
+                                 const std::vector<std::unique_ptr<Column>>& erases, ThreadPool* pool,
+                                 DeletesMap* deletes) {
+    DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    // the number of the sub-maps of the hash maps of the index
+    constexpr uint32_t kMaxShards = 16;
+    // the keys of a small rowset are updated faster than split
+    constexpr size_t kMinKeysPerShard = 16384;
+    size_t num_keys = 0;
+    for (const auto& pks : upserts) {
+        num_keys += pks ? pks->size() : 0;
+    }
+    for (const auto& pks : erases) {
+        num_keys += pks->size();
+    }
+    uint32_t num_shards = 1;
+    while (num_shards < kMaxShards && num_shards * 2 <= config::update_apply_num_shards &&
+           num_keys >= num_shards * 2 * kMinKeysPerShard) {
+        num_shards *= 2;
+    }
+    if (_persistent_index || pool == nullptr || num_shards == 1) {
+        for (uint32_t i = 0; i < upserts.size(); i++) {
+            if (upserts[i] != nullptr) {
+                upsert(rowset_id + i, 0, *upserts[i], deletes);
+            }
+        }
+        for (const auto& pks : erases) {
+            erase(*pks, deletes);
+        }
+        return;
+    }
+
+    struct ShardUpsert {
+        uint32_t rssid;
+        std::vector<uint32_t> rowids;
+        std::unique_ptr<Column> pks;
+    };
+    struct Shard {
+        std::vector<ShardUpsert> upserts;
+        std::vector<std::unique_ptr<Column>> erases;
+        DeletesMap deletes;
+    };
+    std::vector<Shard> shards(num_shards);
+    std::vector<std::vector<uint32_t>> idxes(num_shards);
+    auto split = [&](const Column& pks, const std::function<void(uint32_t, std::unique_ptr<Column>)>& add) {
+        for (auto& e : idxes) {
+            e.clear();
+        }
+        _pkey_to_rssid_rowid->split_by_shard(pks, num_shards, &idxes);
+        for (uint32_t shard = 0; shard < num_shards; shard++) {
+            if (idxes[shard].empty()) {
+                continue;
+            }
+            auto shard_pks = pks.clone_empty();
+            shard_pks->append_selective(pks, idxes[shard].data(), 0, idxes[shard].size());
+            add(shard, std::move(shard_pks));
+        }
+    };
+    for (uint32_t i = 0; i < upserts.size(); i++) {
+        if (upserts[i] == nullptr) {
+            continue;
+        }
+        // the rowids of the segment start from 0, so they're the positions of the keys
+        split(*upserts[i], [&](uint32_t shard, std::unique_ptr<Column> shard_pks) {
+            shards[shard].upserts.push_back({rowset_id + i, idxes[shard], std::move(shard_pks)});
+        });
+    }
+    for (const auto& pks : erases) {
+        split(*pks, [&](uint32_t shard, std::unique_ptr<Column> shard_pks) {
+            shards[shard].erases.emplace_back(std::move(shard_pks));
+        });
+    }
+
+    CountDownLatch latch(num_shards);
+    for (uint32_t i = 0; i < num_shards; i++) {
+        auto task = [&, i]() {
+            auto& shard = shards[i];
+            for (auto& e : shard.upserts) {
+                _pkey_to_rssid_rowid->upsert(e.rssid, e.rowids, *e.pks, &shard.deletes);
+                e.pks.reset();
+            }
+            for (auto& pks : shard.erases) {
+                _pkey_to_rssid_rowid->erase(*pks, &shard.deletes);
+                pks.reset();
+            }
+            latch.count_down();
+        };
+        // the last shard is updated by the calling thread
+        if (i + 1 == num_shards || !pool->submit_func(task).ok()) {
+            task();
+        }
+    }
+    latch.wait();
+    for (auto& shard : shards) {
+        for (auto& [rssid, rowids] : shard.deletes) {
+            auto& dels = (*deletes)[rssid];
+            dels.insert(dels.end(), rowids.begin(), rowids.end());
+        }
+    }
+}
+
+void PrimaryIndex::get(const vectorized::Column& pks, vector<uint64_t>* rowids) const {
+    DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    if (_persistent_index) {
+        _persistent_index->get(pks, rowids);
+        return;
+    }
+    _pkey_to_rssid_rowid->get(pks, rowids);
+}
+
 void PrimaryIndex::try_replace(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
                                const vector<uint32_t>& src_rssid, vector<uint32_t>* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    if (_persistent_index) {
+        _persistent_index->try_replace(rssid, rowid_start, pks, src_rssid, deletes);
+        return;
+    }
     _pkey_to_rssid_rowid->try_replace(rssid, rowid_start, pks, src_rssid, deletes);
 }
 
 void PrimaryIndex::try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
                                const vector<uint32_t>& src_rssid, vector<uint32_t>* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    if (_persistent_index) {
+        _persistent_index->try_replace(rssid, rowids, pks, src_rssid, deletes);
+        return;
+    }
     _pkey_to_rssid_rowid->try_replace(rssid, rowids, pks, src_rssid, deletes);
 }
 
 void PrimaryIndex::erase(const Column& key_col, DeletesMap* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    if (_persistent_index) {
+        _persistent_index->erase(key_col, deletes);
+        return;
+    }
     _pkey_to_rssid_rowid->erase(key_col, deletes);
 }
 
+Status PrimaryIndex::commit(const EditVersion& version) {
+    DCHECK(_status.ok());
+    if (_persistent_index) {
+        return _persistent_index->commit(version);
+    }
+    return Status::OK();
+}
+
 std::size_t PrimaryIndex::memory_usage() const {
+    if (_persistent_index) {
+        return _persistent_index->memory_usage();
+    }
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->memory_usage() : 0;
 }
 
 std::string PrimaryIndex::memory_info() const {
+    if (_persistent_index) {
+        return _persistent_index->memory_info();
+    }
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->memory_info() : "Null";
 }
 
 std::size_t PrimaryIndex::size() const {
+    if (_persistent_index) {
+        return _persistent_index->size();
+    }
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->size() : 0;
 }
 
 std::size_t PrimaryIndex::capacity() const {
+    if (_persistent_index) {
+        return _persistent_index->capacity();
+    }
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->capacity() : 0;
 }
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <limits>
 #include <string>
 #include <unordered_map>
 
@@ -11,15 +12,19 @@
 
 namespace starrocks {
 
+struct EditVersion;
+class PersistentIndex;
 class RowsetUpdateState;
 class Tablet;
 class TabletMeta;
+class ThreadPool;
 using TabletSharedPtr = std::shared_ptr<Tablet>;
 class HashIndex;
 
 // An index to lookup a record's position(rowset->segment->rowid) by primary key.
 // It's only used to handle updates/deletes in the write pipeline for now.
-// Use a simple in-memory hash_map implementation for demo purpose.
+// Use a simple in-memory hash_map implementation for demo purpose, or a PersistentIndex kept in the files of
+// the tablet if config::enable_persistent_index is on.
 class PrimaryIndex {
 public:
     using segment_rowid_t = uint32_t;
@@ -27,6 +32,9 @@ public:
     using tablet_rowid_t = uint64_t;
     using TabletRowidColumn = vectorized::UInt64Column;
 
+    // The position returned by get() for the keys not in the index.
+    static constexpr uint64_t NullIndexValue = std::numeric_limits<uint64_t>::max();
+
     PrimaryIndex();
     PrimaryIndex(const vectorized::Schema& pk_schema);
     ~PrimaryIndex();
@@ -56,6 +64,22 @@ public:
     void upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes);
     void upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks, DeletesMap* deletes);
 
+    // upsert the keys of the segments of the rowset |rowset_id|, i.e. upsert(rowset_id + i, 0, *upserts[i], deletes)
+    // for each segment i in order, and then erase the keys of |erases|. The keys are split by the shards of the
+    // index, which are updated concurrently by |pool| if there are enough keys. The order of the updates of a key is
+    // kept, since it's always in the same shard.
+    //
+    // [not thread-safe]
+    void upsert_rowset(uint32_t rowset_id, const std::vector<std::unique_ptr<vectorized::Column>>& upserts,
+                       const std::vector<std::unique_ptr<vectorized::Column>>& erases, ThreadPool* pool,
+                       DeletesMap* deletes);
+
+    // Get the positions of the *encoded* primary keys |pks|, (rssid << 32) | rowid, or NullIndexValue for the keys
+    // not in the index.
+    //
+    // [not thread-safe]
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const;
+
     // used for compaction, try replace input rowsets' rowid with output segment's rowid, if
     // input rowsets' rowid doesn't exist, this indicates that the row of output rowset is
     // deleted during compaction, so append it's rowid into |deletes|
@@ -76,6 +100,12 @@ public:
     // [not thread-safe]
     void erase(const vectorized::Column& pks, DeletesMap* deletes);
 
+    // Persist the changes since the last commit as the changes of |version| if it's a persistent index. It must be
+    // called before |version| is applied in the tablet meta.
+    //
+    // [not thread-safe]
+    Status commit(const EditVersion& version);
+
     // [not thread-safe]
     std::size_t memory_usage() const;
 
@@ -102,6 +132,7 @@ private:
     vectorized::Schema _pk_schema;
     FieldType _enc_pk_type = OLAP_FIELD_TYPE_UNKNOWN;
     std::unique_ptr<HashIndex> _pkey_to_rssid_rowid;
+    std::unique_ptr<PersistentIndex> _persistent_index;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const PrimaryIndex& o) {
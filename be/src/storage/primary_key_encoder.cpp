@@ -398,6 +398,23 @@ static void prepare_ops_datas(const vectorized::Schema& schema, const vectorized
     }
 }
 
+static void encode_composite(const vectorized::Schema& schema, const vectorized::Chunk& chunk, size_t offset,
+                             size_t len, vectorized::BinaryColumn* dest) {
+    int ncol = schema.num_key_fields();
+    vector<EncodeOp> ops;
+    vector<const void*> datas;
+    prepare_ops_datas(schema, chunk, &ops, &datas);
+    dest->reserve(dest->size() + len);
+    string buff;
+    for (size_t i = 0; i < len; i++) {
+        buff.clear();
+        for (int j = 0; j < ncol; j++) {
+            ops[j](datas[j], offset + i, &buff);
+        }
+        dest->append(buff);
+    }
+}
+
 void PrimaryKeyEncoder::encode(const vectorized::Schema& schema, const vectorized::Chunk& chunk, size_t offset,
                                size_t len, vectorized::Column* dest) {
     if (schema.num_key_fields() == 1) {
@@ -406,23 +423,15 @@ void PrimaryKeyEncoder::encode(const vectorized::Schema& schema, const vectorize
         dest->append(*src, offset, len);
     } else {
         CHECK(dest->is_binary()) << "dest column should be binary";
-        int ncol = schema.num_key_fields();
-        vector<EncodeOp> ops;
-        vector<const void*> datas;
-        prepare_ops_datas(schema, chunk, &ops, &datas);
-        vectorized::BinaryColumn& bdest = down_cast<vectorized::BinaryColumn&>(*dest);
-        bdest.reserve(bdest.size() + len);
-        string buff;
-        for (size_t i = 0; i < len; i++) {
-            buff.clear();
-            for (int j = 0; j < ncol; j++) {
-                ops[j](datas[j], offset + i, &buff);
-            }
-            bdest.append(buff);
-        }
+        encode_composite(schema, chunk, offset, len, down_cast<vectorized::BinaryColumn*>(dest));
     }
 }
 
+void PrimaryKeyEncoder::encode_sort_key(const vectorized::Schema& schema, const vectorized::Chunk& chunk,
+                                        size_t offset, size_t len, vectorized::BinaryColumn* dest) {
+    encode_composite(schema, chunk, offset, len, dest);
+}
+
 void PrimaryKeyEncoder::encode_selective(const vectorized::Schema& schema, const vectorized::Chunk& chunk,
                                          const uint32_t* indexes, size_t len, vectorized::Column* dest) {
     if (schema.num_key_fields() == 1) {
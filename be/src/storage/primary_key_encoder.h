@@ -38,6 +38,12 @@ public:
     static void encode(const vectorized::Schema& schema, const vectorized::Chunk& chunk, size_t offset, size_t len,
                        vectorized::Column* dest);
 
+    // Encode the key columns of the rows into |dest| by the encoding of the composite keys, even if there's only
+    // one key column, so the encoded keys of any |schema| supported are compared by memcmp in the order of the
+    // original keys.
+    static void encode_sort_key(const vectorized::Schema& schema, const vectorized::Chunk& chunk, size_t offset,
+                                size_t len, vectorized::BinaryColumn* dest);
+
     static void encode_selective(const vectorized::Schema& schema, const vectorized::Chunk& chunk,
                                  const uint32_t* indexes, size_t len, vectorized::Column* dest);
 
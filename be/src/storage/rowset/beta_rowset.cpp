@@ -25,12 +25,20 @@
 #include <unistd.h> // for link()
 #include <util/file_utils.h>
 
+#include <cerrno>
 #include <memory>
 #include <set>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
+#include "storage/del_vector.h"
+#include "storage/delete_bitmap_manager.h"
 #include "storage/rowset/beta_rowset_reader.h"
+#include "storage/rowset/segment_v2/segment_footer_cache.h"
+#include "storage/rowset/vectorized/meta_aggregates.h"
+#include "storage/rowset/vectorized/rowid_range_option.h"
 #include "storage/rowset/vectorized/rowset_options.h"
+#include "storage/rowset/vectorized/rowset_zone_map.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/storage_engine.h"
 #include "storage/update_manager.h"
@@ -57,6 +65,10 @@ std::string BetaRowset::segment_del_file_path(const std::string& dir, const Rows
     return strings::Substitute("$0/$1_$2.del", dir, rowset_id.to_string(), segment_id);
 }
 
+std::string BetaRowset::segment_partial_file_path(const std::string& dir, const RowsetId& rowset_id, int segment_id) {
+    return strings::Substitute("$0/$1_$2.dat.partial", dir, rowset_id.to_string(), segment_id);
+}
+
 std::string BetaRowset::segment_srcrssid_file_path(const std::string& dir, const RowsetId& rowset_id, int segment_id) {
     return strings::Substitute("$0/$1_$2.rssid", dir, rowset_id.to_string(), segment_id);
 }
@@ -107,13 +119,27 @@ OLAPStatus BetaRowset::remove() {
     VLOG(1) << "Removing files in rowsset id=" << unique_id() << " version=" << start_version() << "-" << end_version()
             << " tablet_id=" << _rowset_meta->tablet_id();
     bool success = true;
+    auto* footer_cache = segment_v2::SegmentFooterCache::instance();
     for (int i = 0; i < num_segments(); ++i) {
         std::string path = segment_file_path(_rowset_path, rowset_id(), i);
+        if (footer_cache != nullptr) {
+            footer_cache->erase(path);
+        }
         VLOG(1) << "Deleting " << path;
         // TODO(lingbin): use Env API
         if (::remove(path.c_str()) != 0) {
-            PLOG(WARNING) << "Fail to delete " << path;
-            success = false;
+            // the segments of a partial update aren't rewritten before the rowset is applied
+            if (errno != ENOENT || !_rowset_meta->is_partial_update()) {
+                PLOG(WARNING) << "Fail to delete " << path;
+                success = false;
+            }
+        }
+        if (_rowset_meta->is_partial_update()) {
+            std::string partial_path = segment_partial_file_path(_rowset_path, rowset_id(), i);
+            if (::access(partial_path.c_str(), F_OK) == 0 && ::remove(partial_path.c_str()) != 0) {
+                PLOG(WARNING) << "Fail to delete " << partial_path;
+                success = false;
+            }
         }
     }
     for (int i = 0; i < num_delete_files(); ++i) {
@@ -242,6 +268,15 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
                                          std::vector<vectorized::ChunkIteratorPtr>* segment_iterators) {
     RowsetReleaseGuard guard(shared_from_this());
 
+    // Prune the rowset by its rowset-level zone maps before its segments are opened.
+    if (options.tablet_schema != nullptr &&
+        !vectorized::rowset_zone_map_filter(rowset_meta()->get_meta_pb(), *options.tablet_schema, options.predicates)) {
+        if (options.stats != nullptr) {
+            options.stats->rows_stats_filtered += num_rows();
+        }
+        return Status::OK();
+    }
+
     RETURN_IF_ERROR(load());
 
     vectorized::SegmentReadOptions seg_options;
@@ -249,10 +284,16 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     seg_options.stats = options.stats;
     seg_options.ranges = options.ranges;
     seg_options.predicates = options.predicates;
+    seg_options.runtime_predicates = options.runtime_predicates;
     seg_options.use_page_cache = options.use_page_cache;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
     seg_options.chunk_size = options.chunk_size;
+    seg_options.read_ahead_pages = options.read_ahead_pages;
+    if (options.rowid_range_option != nullptr) {
+        seg_options.rowid_range = &options.rowid_range_option->rowid_range;
+    }
+    seg_options.global_dicts = options.global_dicts;
     if (options.delete_predicates != nullptr) {
         seg_options.delete_predicates = options.delete_predicates->get_predicates(end_version());
     }
@@ -264,16 +305,33 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
         seg_options.meta = options.meta;
     }
 
-    auto segment_schema = schema;
     // Append the columns with delete condition to segment schema.
-    std::set<ColumnId> delete_columns;
-    seg_options.delete_predicates.get_column_ids(&delete_columns);
-    for (ColumnId cid : delete_columns) {
-        const TabletColumn& col = options.tablet_schema->column(cid);
-        if (segment_schema.get_field_by_name(col.name()) == nullptr) {
-            auto f = vectorized::ChunkHelper::convert_field_to_format_v2(cid, col);
-            segment_schema.append(std::make_shared<vectorized::Field>(std::move(f)));
+    auto append_delete_columns = [&](const vectorized::DisjunctivePredicates& dels, vectorized::Schema* seg_schema) {
+        std::set<ColumnId> delete_columns;
+        dels.get_column_ids(&delete_columns);
+        for (ColumnId cid : delete_columns) {
+            if (options.global_dicts != nullptr && options.global_dicts->count(cid) > 0) {
+                return Status::NotSupported("delete predicates on the columns of global dicts");
+            }
+            const TabletColumn& col = options.tablet_schema->column(cid);
+            if (seg_schema->get_field_by_name(col.name()) == nullptr) {
+                auto f = vectorized::ChunkHelper::convert_field_to_format_v2(cid, col);
+                seg_schema->append(std::make_shared<vectorized::Field>(std::move(f)));
+            }
         }
+        return Status::OK();
+    };
+    auto segment_schema = schema;
+    RETURN_IF_ERROR(append_delete_columns(seg_options.delete_predicates, &segment_schema));
+
+    // The delete predicates materialized are skipped by the DelVectors of the segments instead. Only the queries use
+    // them, the rows deleted are counted as rows_del_filtered for the row num checks of the compactions and the
+    // schema changes.
+    DeleteBitmapManager* delete_bitmaps = nullptr;
+    if (config::enable_delete_bitmap_materialization && options.reader_type == READER_QUERY &&
+        !options.is_primary_keys && options.version > 0 &&
+        !seg_options.delete_predicates.empty() && StorageEngine::instance() != nullptr) {
+        delete_bitmaps = StorageEngine::instance()->delete_bitmap_manager();
     }
 
     std::vector<vectorized::ChunkIteratorPtr> tmp_seg_iters;
@@ -282,14 +340,39 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
         if (seg_ptr->num_rows() == 0) {
             continue;
         }
-        auto res = seg_ptr->new_iterator(segment_schema, seg_options);
+        if (options.rowid_range_option != nullptr && seg_ptr->id() != options.rowid_range_option->segment_id) {
+            continue;
+        }
+        const vectorized::SegmentReadOptions* read_options = &seg_options;
+        const vectorized::Schema* read_schema = &segment_schema;
+        vectorized::SegmentReadOptions bitmap_options;
+        vectorized::Schema bitmap_schema;
+        DelVectorPtr del_vec = delete_bitmaps != nullptr ? delete_bitmaps->get(rowset_id(), seg_ptr->id()) : nullptr;
+        if (del_vec != nullptr && del_vec->version() <= options.version) {
+            bitmap_options = seg_options;
+            bitmap_options.delete_predicates = options.delete_predicates->get_predicates(
+                    std::max<int64_t>(end_version(), del_vec->version() + 1));
+            bitmap_options.del_vec = std::move(del_vec);
+            bitmap_schema = schema;
+            RETURN_IF_ERROR(append_delete_columns(bitmap_options.delete_predicates, &bitmap_schema));
+            read_options = &bitmap_options;
+            read_schema = &bitmap_schema;
+        }
+        if (options.meta_aggregates != nullptr) {
+            bool answered = false;
+            RETURN_IF_ERROR(options.meta_aggregates->add_segment(seg_ptr.get(), *read_options, &answered));
+            if (answered) {
+                continue;
+            }
+        }
+        auto res = seg_ptr->new_iterator(*read_schema, *read_options);
         if (res.status().is_end_of_file()) {
             continue;
         }
         if (!res.ok()) {
             return res.status();
         }
-        if (segment_schema.num_fields() > schema.num_fields()) {
+        if (read_schema->num_fields() > schema.num_fields()) {
             tmp_seg_iters.emplace_back(vectorized::new_projection_iterator(schema, std::move(res).value()));
         } else {
             tmp_seg_iters.emplace_back(std::move(res).value());
@@ -299,7 +382,7 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     auto this_rowset = shared_from_this();
     if (tmp_seg_iters.empty()) {
         // nothing to do
-    } else if (rowset_meta()->is_segments_overlapping()) {
+    } else if (rowset_meta()->may_segments_overlap()) {
         for (auto& iter : tmp_seg_iters) {
             auto wrapper = std::make_shared<SegmentIteratorWrapper>(this_rowset, std::move(iter));
             segment_iterators->emplace_back(std::move(wrapper));
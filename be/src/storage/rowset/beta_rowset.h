@@ -72,6 +72,10 @@ public:
 
     static std::string segment_del_file_path(const std::string& segment_dir, const RowsetId& rowset_id, int segment_id);
 
+    // The segment of a partial update before it's rewritten into the full segment by the apply.
+    static std::string segment_partial_file_path(const std::string& segment_dir, const RowsetId& rowset_id,
+                                                 int segment_id);
+
     static std::string segment_srcrssid_file_path(const std::string& segment_dir, const RowsetId& rowset_id,
                                                   int segment_id);
 
@@ -89,7 +89,7 @@ OLAPStatus BetaRowsetReader::init(RowsetReaderContext* read_context) {
 
     // merge or union segment iterator
     RowwiseIterator* final_iterator;
-    if (read_context->need_ordered_result && _rowset->rowset_meta()->is_segments_overlapping()) {
+    if (read_context->need_ordered_result && _rowset->rowset_meta()->may_segments_overlap()) {
         final_iterator = new_merge_iterator(iterators);
     } else {
         final_iterator = new_union_iterator(iterators);
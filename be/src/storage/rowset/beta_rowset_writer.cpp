@@ -32,6 +32,7 @@
 #include "runtime/exec_env.h"
 #include "storage/fs/fs_util.h"
 #include "storage/olap_define.h"
+#include "storage/page_cache.h"
 #include "storage/row.h"        // ContiguousRow
 #include "storage/row_cursor.h" // RowCursor
 #include "storage/rowset/beta_rowset.h"
@@ -66,6 +67,7 @@ BetaRowsetWriter::~BetaRowsetWriter() {
     // TODO(lingbin): Should wrapper exception logic, no need to know file ops directly.
     if (!_already_built) {       // abnormal exit, remove all files generated
         _segment_writer.reset(); // ensure all files are closed
+        _segment_writers.clear();
         if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS) {
             for (const auto& tmp_segment_file : _tmp_segment_files) {
                 // Even if an error is encountered, these files that have not been cleaned up
@@ -76,7 +78,7 @@ BetaRowsetWriter::~BetaRowsetWriter() {
             }
             _tmp_segment_files.clear();
             for (auto i = 0; i < _num_segment; ++i) {
-                auto path = BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, i);
+                auto path = _segment_file_path(i);
                 // Even if an error is encountered, these files that have not been cleaned up
                 // will be cleaned up by the GC background. So here we only print the error
                 // message when we encounter an error.
@@ -160,6 +162,13 @@ OLAPStatus BetaRowsetWriter::init() {
         _rowset_meta->set_version_hash(_context.version_hash);
     }
     _rowset_meta->set_tablet_uid(_context.tablet_uid);
+    if (_context.full_tablet_schema != nullptr) {
+        auto* txn_meta = _rowset_meta->mutable_txn_meta();
+        for (uint32_t cid : _context.referenced_column_ids) {
+            txn_meta->add_partial_update_column_ids(cid);
+            txn_meta->add_partial_update_column_unique_ids(_context.full_tablet_schema->column(cid).unique_id());
+        }
+    }
     return OLAP_SUCCESS;
 }
 
@@ -227,7 +236,7 @@ OLAPStatus BetaRowsetWriter::flush() {
 Status BetaRowsetWriter::_final_merge() {
     if (_num_segment == 1) {
         auto old_path = BetaRowset::segment_temp_file_path(_context.rowset_path_prefix, _context.rowset_id, 0);
-        auto new_path = BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, 0);
+        auto new_path = _segment_file_path(0);
         auto st = _context.env->rename_file(old_path, new_path);
         RETURN_IF_ERROR_WITH_WARN(st, "Fail to rename file");
         return Status::OK();
@@ -291,6 +300,8 @@ Status BetaRowsetWriter::_final_merge() {
     _num_rows_written = 0;
     _total_data_size = 0;
     _total_index_size = 0;
+    _zone_map_builder = vectorized::RowsetZoneMapBuilder();
+    _ndv_sketch_builder = vectorized::RowsetNdvSketchBuilder();
 
     // since the segment already NONOVERLAPPING here, make the _create_segment_writer
     // method to create segment data files, rather than temporary segment files.
@@ -353,7 +364,8 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     _rowset_meta->set_total_disk_size(_total_data_size);
     _rowset_meta->set_data_disk_size(_total_data_size);
     _rowset_meta->set_index_disk_size(_total_index_size);
-    // TODO write zonemap to meta
+    _zone_map_builder.finish(_rowset_meta->mutable_column_zone_maps());
+    _ndv_sketch_builder.finish(_rowset_meta->mutable_column_ndv_sketches());
     _rowset_meta->set_empty(_num_rows_written == 0);
     _rowset_meta->set_creation_time(time(nullptr));
     _rowset_meta->set_num_segments(_num_segment);
@@ -379,9 +391,10 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     }
 
     RowsetSharedPtr rowset;
-    auto status =
-            RowsetFactory::create_rowset(ExecEnv::GetInstance()->tablet_meta_mem_tracker(), _context.tablet_schema,
-                                         _context.rowset_path_prefix, _rowset_meta, &rowset);
+    const auto* rowset_schema =
+            _context.full_tablet_schema != nullptr ? _context.full_tablet_schema : _context.tablet_schema;
+    auto status = RowsetFactory::create_rowset(ExecEnv::GetInstance()->tablet_meta_mem_tracker(), rowset_schema,
+                                               _context.rowset_path_prefix, _rowset_meta, &rowset);
     if (status != OLAP_SUCCESS) {
         LOG(WARNING) << "Fail to create rowset, err=" << status;
         return nullptr;
@@ -390,7 +403,15 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     return rowset;
 }
 
-std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
+std::string BetaRowsetWriter::_segment_file_path(int segment_id) const {
+    if (_context.full_tablet_schema != nullptr) {
+        // rewritten into the data file with all the columns when the rowset is applied
+        return BetaRowset::segment_partial_file_path(_context.rowset_path_prefix, _context.rowset_id, segment_id);
+    }
+    return BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, segment_id);
+}
+
+std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer(const std::vector<uint32_t>& column_indexes) {
     std::lock_guard<std::mutex> l(_lock);
     std::string path;
     if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS && _context.segments_overlap != NONOVERLAPPING) {
@@ -400,7 +421,7 @@ std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
         // for update final merge scenario, we marked segments_overlap to NONOVERLAPPING in
         // function _final_merge, so we create segment data file here, rather than
         // temporary segment files.
-        path = BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
+        path = _segment_file_path(_num_segment);
     }
     std::unique_ptr<fs::WritableBlock> wblock;
     fs::CreateBlockOptions opts({path});
@@ -414,11 +435,22 @@ std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
     segment_v2::SegmentWriterOptions writer_options;
     writer_options.storage_format_version = _context.storage_format_version;
     writer_options.mem_tracker = _context.mem_tracker;
+    if (StorageEngine::instance() != nullptr) {
+        writer_options.encode_thread_pool = StorageEngine::instance()->segment_encode_thread_pool();
+    }
+    // The pages of the in_memory tables are written through the page cache, except for the segment files renamed
+    // or rewritten later, whose pages are read from the other paths.
+    auto* page_cache = StoragePageCache::instance();
+    writer_options.cache_pages_in_memory =
+            _context.tablet_schema->is_in_memory() && !config::disable_storage_page_cache && page_cache != nullptr &&
+            page_cache->has_in_memory_partition() &&
+            path == BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
     const auto* schema = _rowset_schema != nullptr ? _rowset_schema.get() : _context.tablet_schema;
     std::unique_ptr<SegmentWriter> segment_writer =
             std::make_unique<segment_v2::SegmentWriter>(std::move(wblock), _num_segment, schema, writer_options);
     // TODO set write_mbytes_per_sec based on writer type (load/base compaction/cumulative compaction)
-    auto s = segment_writer->init(config::push_write_mbytes_per_sec);
+    auto s = column_indexes.empty() ? segment_writer->init(config::push_write_mbytes_per_sec)
+                                    : segment_writer->init(column_indexes, true);
     if (!s.ok()) {
         LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
         segment_writer.reset(nullptr);
@@ -440,9 +472,17 @@ OLAPStatus BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::S
         std::lock_guard<std::mutex> l(_lock);
         _total_data_size += segment_size;
         _total_index_size += index_size;
+        s = _zone_map_builder.add_segment((*segment_writer)->footer());
+        if (s.ok()) {
+            s = _ndv_sketch_builder.add_segment((*segment_writer)->footer());
+        }
+    }
+    if (!s.ok()) {
+        LOG(WARNING) << "Fail to merge the zone maps or the ndv sketches of segment, " << s.to_string();
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
     }
     if (_src_rssids) {
-        Status st = _flush_src_rssids();
+        Status st = _flush_src_rssids((*segment_writer)->segment_id());
         if (!st.ok()) {
             LOG(WARNING) << "_flush_src_rssids error: " << st.to_string();
             return OLAP_ERR_IO_ERROR;
@@ -452,9 +492,8 @@ OLAPStatus BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::S
     return OLAP_SUCCESS;
 }
 
-Status BetaRowsetWriter::_flush_src_rssids() {
-    auto path = BetaRowset::segment_srcrssid_file_path(_context.rowset_path_prefix, _context.rowset_id,
-                                                       _segment_writer->segment_id());
+Status BetaRowsetWriter::_flush_src_rssids(uint32_t segment_id) {
+    auto path = BetaRowset::segment_srcrssid_file_path(_context.rowset_path_prefix, _context.rowset_id, segment_id);
     std::unique_ptr<fs::WritableBlock> wblock;
     fs::CreateBlockOptions opts({path});
     Status st = _context.block_mgr->create_block(opts, &wblock);
@@ -522,6 +561,166 @@ OLAPStatus BetaRowsetWriter::add_chunk_with_rssid(const vectorized::Chunk& chunk
     return OLAP_SUCCESS;
 }
 
+OLAPStatus BetaRowsetWriter::add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                         bool is_key) {
+    if (is_key) {
+        return _add_key_columns(chunk, column_indexes);
+    }
+    return _add_value_columns(chunk, column_indexes);
+}
+
+OLAPStatus BetaRowsetWriter::add_columns_with_rssid(const vectorized::Chunk& chunk,
+                                                    const std::vector<uint32_t>& column_indexes,
+                                                    const vector<uint32_t>& rssid) {
+    RETURN_NOT_OK(_add_key_columns(chunk, column_indexes));
+    if (!_src_rssids) {
+        _src_rssids.reset(new vector<uint32_t>());
+    }
+    _src_rssids->insert(_src_rssids->end(), rssid.begin(), rssid.end());
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::_finalize_columns(segment_v2::SegmentWriter* segment_writer) {
+    uint64_t index_size = 0;
+    Status s = segment_writer->finalize_columns(&index_size);
+    if (!s.ok()) {
+        LOG(WARNING) << "Fail to finalize columns, " << s.to_string();
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    _total_index_size += index_size;
+    return OLAP_SUCCESS;
+}
+
+// The key columns decide the rows of each segment like `add_chunk`, the src rssids are flushed once the key
+// columns of a segment are finalized.
+OLAPStatus BetaRowsetWriter::_add_key_columns(const vectorized::Chunk& chunk,
+                                              const std::vector<uint32_t>& column_indexes) {
+    if (!_segment_writers.empty() && !_current_columns_inited) {
+        LOG(WARNING) << "The key columns must be the first group of the columns";
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    if (!_segment_writers.empty() &&
+        (_segment_writers.back()->estimate_segment_size() >= MAX_SEGMENT_SIZE ||
+         _segment_writers.back()->num_rows_written() + chunk.num_rows() >= _context.max_rows_per_segment)) {
+        RETURN_NOT_OK(_finalize_columns(_segment_writers.back().get()));
+        if (_src_rssids) {
+            Status st = _flush_src_rssids(_segment_writers.back()->segment_id());
+            if (!st.ok()) {
+                LOG(WARNING) << "_flush_src_rssids error: " << st.to_string();
+                return OLAP_ERR_IO_ERROR;
+            }
+        }
+        _current_columns_inited = false;
+    }
+    if (!_current_columns_inited) {
+        auto segment_writer = _create_segment_writer(column_indexes);
+        if (segment_writer == nullptr) {
+            return OLAP_ERR_INIT_FAILED;
+        }
+        _segment_writers.push_back(std::move(segment_writer));
+        _current_writer_index = _segment_writers.size() - 1;
+        _current_columns_inited = true;
+    }
+    auto s = _segment_writers.back()->append_chunk(chunk);
+    if (!s.ok()) {
+        LOG(WARNING) << "Fail to append chunk, " << s.to_string();
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    _num_rows_written += chunk.num_rows();
+    _total_row_size += chunk.bytes_usage();
+    return OLAP_SUCCESS;
+}
+
+// The rows of |chunk| are split into the segments by the rows of their key columns.
+OLAPStatus BetaRowsetWriter::_add_value_columns(const vectorized::Chunk& chunk,
+                                                const std::vector<uint32_t>& column_indexes) {
+    size_t offset = 0;
+    while (offset < chunk.num_rows()) {
+        if (_current_writer_index >= _segment_writers.size()) {
+            LOG(WARNING) << "The value columns have more rows than the key columns";
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        auto* segment_writer = _segment_writers[_current_writer_index].get();
+        if (!_current_columns_inited) {
+            auto s = segment_writer->init(column_indexes, false);
+            if (!s.ok()) {
+                LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
+                return OLAP_ERR_INIT_FAILED;
+            }
+            _current_columns_inited = true;
+        }
+        size_t rows = std::min<size_t>(chunk.num_rows() - offset,
+                                       segment_writer->num_rows() - segment_writer->num_rows_written());
+        if (rows == 0) {
+            RETURN_NOT_OK(_finalize_columns(segment_writer));
+            _current_writer_index++;
+            _current_columns_inited = false;
+            continue;
+        }
+        Status s;
+        if (rows == chunk.num_rows()) {
+            s = segment_writer->append_chunk(chunk);
+        } else {
+            auto part = chunk.clone_empty_with_schema(rows);
+            part->append(chunk, offset, rows);
+            s = segment_writer->append_chunk(*part);
+        }
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to append chunk, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        offset += rows;
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::flush_columns() {
+    if (_segment_writers.empty()) {
+        return OLAP_SUCCESS;
+    }
+    if (!_current_columns_inited || _current_writer_index + 1 != _segment_writers.size()) {
+        LOG(WARNING) << "The group of the columns has less rows than the key columns";
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    RETURN_NOT_OK(_finalize_columns(_segment_writers[_current_writer_index].get()));
+    if (_src_rssids && !_src_rssids->empty()) {
+        // The rest src rssids are of the last segment.
+        Status st = _flush_src_rssids(_segment_writers.back()->segment_id());
+        if (!st.ok()) {
+            LOG(WARNING) << "_flush_src_rssids error: " << st.to_string();
+            return OLAP_ERR_IO_ERROR;
+        }
+    }
+    _current_writer_index = 0;
+    _current_columns_inited = false;
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::final_flush() {
+    for (auto& segment_writer : _segment_writers) {
+        uint64_t segment_size = 0;
+        uint64_t index_size = 0;
+        Status s = segment_writer->finalize_footer(&segment_size, &index_size);
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to finalize segment, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        _total_data_size += segment_size;
+        _total_index_size += index_size;
+        s = _zone_map_builder.add_segment(segment_writer->footer());
+        if (s.ok()) {
+            s = _ndv_sketch_builder.add_segment(segment_writer->footer());
+        }
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to merge the zone maps or the ndv sketches of segment, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        segment_writer.reset();
+    }
+    _segment_writers.clear();
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus BetaRowsetWriter::flush_chunk(const vectorized::Chunk& chunk) {
     // create segment writer
     std::unique_ptr<segment_v2::SegmentWriter> segment_writer = _create_segment_writer();
@@ -26,6 +26,8 @@
 #include <vector>
 
 #include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/vectorized/rowset_ndv_sketch.h"
+#include "storage/rowset/vectorized/rowset_zone_map.h"
 
 namespace starrocks {
 
@@ -54,6 +56,16 @@ public:
 
     OLAPStatus add_chunk_with_rssid(const vectorized::Chunk& chunk, const vector<uint32_t>& rssid);
 
+    OLAPStatus add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                           bool is_key) override;
+
+    OLAPStatus add_columns_with_rssid(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                      const vector<uint32_t>& rssid) override;
+
+    OLAPStatus flush_columns() override;
+
+    OLAPStatus final_flush() override;
+
     OLAPStatus flush_chunk(const vectorized::Chunk& chunk) override;
 
     virtual OLAPStatus flush_chunk_with_deletes(const vectorized::Chunk& upserts,
@@ -81,13 +93,21 @@ private:
     template <typename RowType>
     OLAPStatus _add_row(const RowType& row);
 
-    std::unique_ptr<segment_v2::SegmentWriter> _create_segment_writer();
+    // Create a writer of all the columns, or the ones in |column_indexes| if it's not empty.
+    std::unique_ptr<segment_v2::SegmentWriter> _create_segment_writer(const std::vector<uint32_t>& column_indexes = {});
 
     OLAPStatus _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* segment_writer);
-    Status _flush_src_rssids();
+    Status _flush_src_rssids(uint32_t segment_id);
+
+    OLAPStatus _add_key_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes);
+    OLAPStatus _add_value_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes);
+    OLAPStatus _finalize_columns(segment_v2::SegmentWriter* segment_writer);
 
     Status _final_merge();
 
+    // The path of the final segment file |segment_id|.
+    std::string _segment_file_path(int segment_id) const;
+
     RowsetWriterContext _context;
     std::shared_ptr<RowsetMeta> _rowset_meta;
     std::unique_ptr<TabletSchema> _rowset_schema;
@@ -96,6 +116,11 @@ private:
     vector<bool> _segment_has_deletes;
     vector<std::string> _tmp_segment_files;
     std::unique_ptr<segment_v2::SegmentWriter> _segment_writer;
+    // The segment writers of the vertical writes, and the one of the current group of the columns.
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _segment_writers;
+    size_t _current_writer_index = 0;
+    // Whether the columns of the current group is inited in the current writer.
+    bool _current_columns_inited = false;
     // mutex lock for vectorized add chunk and flush
     std::mutex _lock;
 
@@ -104,7 +129,10 @@ private:
     int64_t _total_row_size;
     int64_t _total_data_size;
     int64_t _total_index_size;
-    // TODO rowset's Zonemap
+    // The segment-level zone maps of the segments flushed merged, guarded by |_lock|.
+    vectorized::RowsetZoneMapBuilder _zone_map_builder;
+    // The ndv sketches of the segments flushed merged, guarded by |_lock|.
+    vectorized::RowsetNdvSketchBuilder _ndv_sketch_builder;
 
     // used for updatable tablet's compaction
     std::unique_ptr<vector<uint32_t>> _src_rssids;
@@ -236,6 +236,12 @@ public:
         return num_segments() > 1 && is_singleton_delta() && segments_overlap() != NONOVERLAPPING;
     }
 
+    // Whether the segments should be merged to read the rows in the order of the key, which is also true for the
+    // rowsets compacted with the clustering, whose segments overlap but count as one rowset in the compactions.
+    bool may_segments_overlap() const {
+        return is_segments_overlapping() || (num_segments() > 1 && segments_overlap() == OVERLAPPING);
+    }
+
     // get the compaction score of this rowset.
     // if segments are overlapping, the score equals to the number of segments,
     // otherwise, score is 1.
@@ -260,6 +266,24 @@ public:
 
     void set_num_delete_files(uint32_t num_delete_files) { _rowset_meta_pb.set_num_delete_files(num_delete_files); }
 
+    // A partial update of a primary-key tablet has only the columns of partial_update_column_ids() of txn_meta() in
+    // its segments before it's applied.
+    bool is_partial_update() const {
+        return _rowset_meta_pb.has_txn_meta() && _rowset_meta_pb.txn_meta().partial_update_column_ids_size() > 0;
+    }
+
+    const RowsetTxnMetaPB& txn_meta() const { return _rowset_meta_pb.txn_meta(); }
+
+    RowsetTxnMetaPB* mutable_txn_meta() { return _rowset_meta_pb.mutable_txn_meta(); }
+
+    google::protobuf::RepeatedPtrField<ColumnZoneMapPB>* mutable_column_zone_maps() {
+        return _rowset_meta_pb.mutable_column_zone_maps();
+    }
+
+    google::protobuf::RepeatedPtrField<ColumnNdvSketchPB>* mutable_column_ndv_sketches() {
+        return _rowset_meta_pb.mutable_column_ndv_sketches();
+    }
+
     const RowsetMetaPB& get_meta_pb() const { return _rowset_meta_pb; }
 
 private:
@@ -39,6 +39,10 @@ public:
     static Status save(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id,
                        const RowsetMetaPB& rowset_meta_pb);
 
+    // Put the rowset meta into |batch| rather than saving it, so it's persisted by OlapMeta::write_batch().
+    static Status put_rowset_meta(OlapMeta* meta, WriteBatch* batch, TabletUid tablet_uid, const RowsetId& rowset_id,
+                                  const RowsetMetaPB& rowset_meta_pb);
+
     static Status remove(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id);
 
     static string get_rowset_meta_key(const TabletUid& tablet_uid, const RowsetId& rowset_id);
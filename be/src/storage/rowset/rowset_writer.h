@@ -88,6 +88,28 @@ public:
         return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
     }
 
+    // The vertical writes used by the vertical compaction: the columns of the rowset are written group by group,
+    // the first group must be the key columns, and the groups must be in the order of the columns. The key columns
+    // decide the rows of each segment, and all the groups must have the same rows. Call `flush_columns` after
+    // each group and `final_flush` after all the groups, instead of `flush`.
+    //
+    // |column_indexes| are the indexes of the columns of |chunk| in the tablet schema.
+    virtual OLAPStatus add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                   bool is_key) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
+    // Same as above, and write the src rssids of the key columns like `add_chunk_with_rssid`.
+    virtual OLAPStatus add_columns_with_rssid(const vectorized::Chunk& chunk,
+                                              const std::vector<uint32_t>& column_indexes,
+                                              const vector<uint32_t>& rssid) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
+    virtual OLAPStatus flush_columns() { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
+    virtual OLAPStatus final_flush() { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
     // This routine is free to modify the content of |chunk|.
     virtual OLAPStatus flush_chunk(const vectorized::Chunk& chunk) = 0;
 
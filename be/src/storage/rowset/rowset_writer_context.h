@@ -52,6 +52,11 @@ public:
     Env* env = Env::Default();
     fs::BlockManager* block_mgr = fs::fs_util::block_manager();
     const TabletSchema* tablet_schema = nullptr;
+    // Set for a partial update of a primary-key tablet, then |tablet_schema| is the schema of the columns
+    // |referenced_column_ids| of |full_tablet_schema| written in the segments, and |full_tablet_schema| is the
+    // schema of the rowset.
+    const TabletSchema* full_tablet_schema = nullptr;
+    std::vector<uint32_t> referenced_column_ids;
 
     RowsetId rowset_id{};
     int64_t tablet_id = 0;
@@ -0,0 +1,471 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/segment_v2/bitshuffle_page.h"
+#include "storage/rowset/segment_v2/options.h"
+#include "storage/rowset/segment_v2/page_builder.h"
+#include "storage/rowset/segment_v2/page_decoder.h"
+#include "storage/types.h"
+#include "util/bit_packing.inline.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/bit_util.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace starrocks {
+namespace segment_v2 {
+
+// The pages of the FLOAT/DOUBLE columns encoded by the adaptive lossless floating-point encoding(ALP).
+//
+// Most of the floating-point values in practice are decimals with a few digits, e.g. the readings of the
+// sensors or the prices. ALP multiplies the values of a page by 10^e, and stores the rounded integers
+// by frame-of-reference and bit-packing if they're decoded back to exactly the same values. The values
+// never decoded back exactly, e.g. NaN, infinities, -0.0 and the values with too many digits, are stored
+// as the exceptions. The page is decoded by unpacking the bits and a division per value, which are both
+// vectorized, instead of the bitshuffle and the lz4 decompression.
+//
+// If a page doesn't benefit from ALP, which is decided by comparing the encoded size with the size of a
+// bitshuffle encoded sample of the page, the values are encoded by bitshuffle into the page instead.
+//
+// The page format is as follows:
+//
+//   <mode> [8-bit]
+//     ALP_MODE_ENCODED or ALP_MODE_BITSHUFFLE. For ALP_MODE_BITSHUFFLE, the mode is followed by a
+//     bitshuffle page of the values, see `BitshufflePageBuilder`.
+//
+//   For ALP_MODE_ENCODED:
+//
+//   <num_elements> [32-bit]
+//   <exponent> [8-bit]
+//   <bit_width> [8-bit]
+//     The number of the bits of each packed value, 0 means all the values are |base|.
+//   <num_exceptions> [32-bit]
+//   <base> [64-bit]
+//     The minimum of the encoded integers.
+//   <packed values> [ceil(num_elements * bit_width / 8) bytes]
+//     The encoded integers minus |base|, the values of the exceptions are 0.
+//   <exception positions> [32-bit * num_exceptions]
+//   <exception values> [sizeof(CppType) * num_exceptions]
+//
+//   NOTE: all on-disk ints are encoded little-endian
+enum { ALP_MODE_ENCODED = 0, ALP_MODE_BITSHUFFLE = 1 };
+enum { ALP_PAGE_HEADER_SIZE = 19 };
+
+template <typename CppType>
+struct AlpCodec {
+    static_assert(std::is_floating_point_v<CppType>, "ALP only encodes the floating-point values");
+
+    // The float has at most 9 significant decimal digits, and the double has at most 17.
+    static constexpr int kMaxExponent = sizeof(CppType) == 4 ? 10 : 18;
+    // The encoded integers are in (-2^52, 2^52), which are represented exactly by the doubles.
+    static constexpr double kMaxEncoded = 4503599627370496.0;
+
+    static constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+
+    static CppType decode(int64_t encoded, int exponent) {
+        return static_cast<CppType>(static_cast<double>(encoded) / kPow10[exponent]);
+    }
+
+    // Return false if |value| is not decoded back exactly, i.e. it's an exception.
+    static bool encode(CppType value, int exponent, int64_t* encoded) {
+        double scaled = static_cast<double>(value) * kPow10[exponent];
+        // NaN fails the comparisons as well.
+        if (!(scaled > -kMaxEncoded && scaled < kMaxEncoded)) {
+            return false;
+        }
+        *encoded = static_cast<int64_t>(std::round(scaled));
+        CppType decoded = decode(*encoded, exponent);
+        // Compare the bits, so that -0.0 is an exception.
+        return memcmp(&decoded, &value, sizeof(CppType)) == 0;
+    }
+
+    // Choose the exponent with the minimum encoded size of the sampled values.
+    static int choose_exponent(const CppType* values, size_t count) {
+        constexpr size_t kMaxSamples = 256;
+        const size_t step = std::max<size_t>(1, count / kMaxSamples);
+        int best_exponent = 0;
+        uint64_t best_bits = std::numeric_limits<uint64_t>::max();
+        for (int e = 0; e <= kMaxExponent; e++) {
+            size_t num_exceptions = 0;
+            size_t num_samples = 0;
+            int64_t min = std::numeric_limits<int64_t>::max();
+            int64_t max = std::numeric_limits<int64_t>::min();
+            for (size_t i = 0; i < count; i += step, num_samples++) {
+                int64_t encoded;
+                if (encode(values[i], e, &encoded)) {
+                    min = std::min(min, encoded);
+                    max = std::max(max, encoded);
+                } else {
+                    num_exceptions++;
+                }
+            }
+            uint64_t bits = num_exceptions * (32 + 8 * sizeof(CppType));
+            if (num_exceptions < num_samples) {
+                const uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+                bits += (num_samples - num_exceptions) * bit_width(range);
+            }
+            if (bits < best_bits) {
+                best_bits = bits;
+                best_exponent = e;
+            }
+        }
+        return best_exponent;
+    }
+
+    static int bit_width(uint64_t range) { return range == 0 ? 0 : BitUtil::Log2Floor64(range) + 1; }
+};
+
+template <FieldType Type>
+class AlpPageBuilder final : public PageBuilder {
+public:
+    explicit AlpPageBuilder(const PageBuilderOptions& options)
+            : _options(options), _max_count(options.data_page_size / SIZE_OF_TYPE) {
+        _data.reserve(_max_count * SIZE_OF_TYPE);
+    }
+
+    bool is_page_full() override { return _count >= _max_count; }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        DCHECK(!_finished);
+        size_t to_add = std::min<size_t>(_max_count - _count, count);
+        _data.append(vals, to_add * SIZE_OF_TYPE);
+        _count += to_add;
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        const auto* values = reinterpret_cast<const CppType*>(_data.data());
+        if (_count > 0) {
+            _first_value = values[0];
+            _last_value = values[_count - 1];
+        }
+        _buf.clear();
+        _buf.push_back(ALP_MODE_ENCODED);
+        _encode(values);
+        if (_buf.size() > _bitshuffle_sample_size(values)) {
+            _buf.clear();
+            _buf.push_back(ALP_MODE_BITSHUFFLE);
+            _encode_bitshuffle();
+        }
+        return &_buf;
+    }
+
+    void reset() override {
+        _count = 0;
+        _data.clear();
+        _buf.clear();
+        _finished = false;
+    }
+
+    size_t count() const override { return _count; }
+
+    uint64_t size() const override { return _data.size(); }
+
+    Status get_first_value(void* value) const override {
+        DCHECK(_finished);
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_first_value, SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        DCHECK(_finished);
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_last_value, SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using Codec = AlpCodec<CppType>;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    void _encode(const CppType* values) {
+        const int exponent = _count > 0 ? Codec::choose_exponent(values, _count) : 0;
+        std::vector<int64_t> encoded(_count);
+        std::vector<uint32_t> exception_positions;
+        int64_t base = std::numeric_limits<int64_t>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+        for (uint32_t i = 0; i < _count; i++) {
+            if (Codec::encode(values[i], exponent, &encoded[i])) {
+                base = std::min(base, encoded[i]);
+                max = std::max(max, encoded[i]);
+            } else {
+                exception_positions.emplace_back(i);
+            }
+        }
+        if (exception_positions.size() == _count) {
+            base = max = 0;
+        }
+        for (uint32_t pos : exception_positions) {
+            encoded[pos] = base;
+        }
+        const int bit_width = Codec::bit_width(static_cast<uint64_t>(max) - static_cast<uint64_t>(base));
+
+        uint8_t header[ALP_PAGE_HEADER_SIZE - 1];
+        encode_fixed32_le(&header[0], _count);
+        header[4] = exponent;
+        header[5] = bit_width;
+        encode_fixed32_le(&header[6], exception_positions.size());
+        encode_fixed64_le(&header[10], base);
+        _buf.append(header, sizeof(header));
+
+        if (bit_width > 0) {
+            faststring packed;
+            BitWriter writer(&packed);
+            for (uint32_t i = 0; i < _count; i++) {
+                writer.PutValue(static_cast<uint64_t>(encoded[i]) - static_cast<uint64_t>(base), bit_width);
+            }
+            writer.Flush();
+            _buf.append(packed.data(), BitUtil::Ceil(_count * bit_width, 8));
+        }
+        for (uint32_t pos : exception_positions) {
+            put_fixed32_le(&_buf, pos);
+        }
+        for (uint32_t pos : exception_positions) {
+            _buf.append(&values[pos], SIZE_OF_TYPE);
+        }
+    }
+
+    // Estimate the size of the page encoded by bitshuffle by the first values.
+    size_t _bitshuffle_sample_size(const CppType* values) {
+        constexpr size_t kSampleSize = 1024;
+        const size_t num_samples = std::min<size_t>(_count, kSampleSize);
+        if (num_samples == 0) {
+            return 0;
+        }
+        const size_t padded_samples = ALIGN_UP(num_samples, 8U);
+        faststring sample;
+        sample.resize(padded_samples * SIZE_OF_TYPE);
+        memset(sample.data(), 0, sample.size());
+        memcpy(sample.data(), values, num_samples * SIZE_OF_TYPE);
+        faststring compressed;
+        compressed.resize(bitshuffle::compress_lz4_bound(padded_samples, SIZE_OF_TYPE, 0));
+        int64_t bytes = bitshuffle::compress_lz4(sample.data(), compressed.data(), padded_samples, SIZE_OF_TYPE, 0);
+        if (bytes < 0) {
+            // Always use ALP if the sample failed to be compressed by bitshuffle.
+            return std::numeric_limits<size_t>::max();
+        }
+        return 1 + BITSHUFFLE_PAGE_HEADER_SIZE + bytes * _count / num_samples;
+    }
+
+    void _encode_bitshuffle() {
+        PageBuilderOptions options = _options;
+        options.data_page_size = std::max<size_t>(options.data_page_size, _count * SIZE_OF_TYPE);
+        BitshufflePageBuilder<Type> builder(options);
+        size_t added = builder.add(_data.data(), _count);
+        DCHECK_EQ(_count, added);
+        faststring* page = builder.finish();
+        _buf.append(page->data(), page->size());
+    }
+
+    PageBuilderOptions _options;
+    uint32_t _max_count;
+    uint32_t _count = 0;
+    bool _finished = false;
+    faststring _data;
+    faststring _buf;
+    CppType _first_value{};
+    CppType _last_value{};
+};
+
+template <FieldType Type>
+class AlpPageDecoder final : public PageDecoder {
+public:
+    AlpPageDecoder(Slice data, const PageDecoderOptions& options) : _data(data), _options(options) {}
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < 1) {
+            return Status::Corruption("alp page is empty");
+        }
+        const auto mode = static_cast<uint8_t>(_data[0]);
+        if (mode == ALP_MODE_BITSHUFFLE) {
+            _bitshuffle_decoder = std::make_unique<BitShufflePageDecoder<Type>>(
+                    Slice(_data.data + 1, _data.size - 1), _options);
+            RETURN_IF_ERROR(_bitshuffle_decoder->init());
+            _parsed = true;
+            return Status::OK();
+        }
+        if (mode != ALP_MODE_ENCODED) {
+            return Status::Corruption(strings::Substitute("invalid alp page mode: $0", mode));
+        }
+        RETURN_IF_ERROR(_decode());
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init()";
+        if (_bitshuffle_decoder != nullptr) {
+            return _bitshuffle_decoder->seek_to_position_in_page(pos);
+        }
+        if (PREDICT_FALSE(_num_elements == 0)) {
+            DCHECK_EQ(0, pos);
+            return Status::InvalidArgument("invalid pos");
+        }
+        DCHECK_LE(pos, _num_elements);
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (_bitshuffle_decoder != nullptr) {
+            return _bitshuffle_decoder->seek_at_or_after_value(value, exact_match);
+        }
+        if (_num_elements == 0) {
+            return Status::NotFound("page is empty");
+        }
+        const auto* values = reinterpret_cast<const CppType*>(_decoded.data());
+        size_t left = 0;
+        size_t right = _num_elements;
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+            if (TypeTraits<Type>::cmp(&values[mid], value) < 0) {
+                left = mid + 1;
+            } else {
+                right = mid;
+            }
+        }
+        if (left >= _num_elements) {
+            return Status::NotFound("all value small than the value");
+        }
+        *exact_match = TypeTraits<Type>::cmp(&values[left], value) == 0;
+        _cur_index = left;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override {
+        DCHECK(_parsed);
+        if (_bitshuffle_decoder != nullptr) {
+            return _bitshuffle_decoder->next_batch(n, dst);
+        }
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t max_fetch = std::min(*n, _num_elements - _cur_index);
+        memcpy(dst->data(), &_decoded[_cur_index * SIZE_OF_TYPE], max_fetch * SIZE_OF_TYPE);
+        *n = max_fetch;
+        _cur_index += max_fetch;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* count, vectorized::Column* dst) override {
+        DCHECK(_parsed);
+        if (_bitshuffle_decoder != nullptr) {
+            return _bitshuffle_decoder->next_batch(count, dst);
+        }
+        if (PREDICT_FALSE(_cur_index >= _num_elements)) {
+            *count = 0;
+            return Status::OK();
+        }
+        *count = std::min(*count, _num_elements - _cur_index);
+        int n = dst->append_numbers(&_decoded[_cur_index * SIZE_OF_TYPE], *count * SIZE_OF_TYPE);
+        DCHECK_EQ(*count, n);
+        _cur_index += *count;
+        return Status::OK();
+    }
+
+    size_t count() const override {
+        return _bitshuffle_decoder != nullptr ? _bitshuffle_decoder->count() : _num_elements;
+    }
+
+    size_t current_index() const override {
+        return _bitshuffle_decoder != nullptr ? _bitshuffle_decoder->current_index() : _cur_index;
+    }
+
+    EncodingTypePB encoding_type() const override { return ALP_ENCODING; }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using Codec = AlpCodec<CppType>;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    Status _decode() {
+        if (_data.size < ALP_PAGE_HEADER_SIZE) {
+            return Status::Corruption(strings::Substitute("invalid alp page size: $0", _data.size));
+        }
+        const auto* header = reinterpret_cast<const uint8_t*>(_data.data) + 1;
+        _num_elements = decode_fixed32_le(&header[0]);
+        const int exponent = header[4];
+        const int bit_width = header[5];
+        const size_t num_exceptions = decode_fixed32_le(&header[6]);
+        const auto base = static_cast<int64_t>(decode_fixed64_le(&header[10]));
+        const size_t packed_bytes = BitUtil::Ceil(_num_elements * bit_width, 8);
+        if (exponent > Codec::kMaxExponent || bit_width > 64 || num_exceptions > _num_elements ||
+            _data.size != ALP_PAGE_HEADER_SIZE + packed_bytes + num_exceptions * (4 + SIZE_OF_TYPE)) {
+            return Status::Corruption(strings::Substitute(
+                    "alp page corrupted: size=$0 num_elements=$1 exponent=$2 bit_width=$3 num_exceptions=$4",
+                    _data.size, _num_elements, exponent, bit_width, num_exceptions));
+        }
+
+        _decoded.resize(_num_elements * SIZE_OF_TYPE);
+        auto* values = reinterpret_cast<CppType*>(_decoded.data());
+        const uint8_t* packed = header + ALP_PAGE_HEADER_SIZE - 1;
+        const double divisor = Codec::kPow10[exponent];
+        if (bit_width == 0) {
+            std::fill(values, values + _num_elements, Codec::decode(base, exponent));
+        } else {
+            // Unpack by batches of the multiple of 32 values, so that each batch ends at a byte boundary.
+            constexpr size_t kBatchSize = 1024;
+            uint64_t deltas[kBatchSize];
+            const uint8_t* in = packed;
+            for (size_t start = 0; start < _num_elements; start += kBatchSize) {
+                const size_t n = std::min(kBatchSize, _num_elements - start);
+                auto [next, num_unpacked] = BitPacking::UnpackValues<uint64_t>(
+                        bit_width, in, packed + packed_bytes - in, n, deltas);
+                DCHECK_EQ(n, num_unpacked);
+                in = next;
+                CppType* out = values + start;
+                for (size_t i = 0; i < n; i++) {
+                    out[i] = static_cast<CppType>(static_cast<double>(base + static_cast<int64_t>(deltas[i])) /
+                                                  divisor);
+                }
+            }
+        }
+
+        const uint8_t* positions = packed + packed_bytes;
+        const uint8_t* exceptions = positions + num_exceptions * 4;
+        for (size_t i = 0; i < num_exceptions; i++) {
+            uint32_t pos = decode_fixed32_le(positions + i * 4);
+            if (pos >= _num_elements) {
+                return Status::Corruption(strings::Substitute("invalid alp exception position: $0", pos));
+            }
+            memcpy(&values[pos], exceptions + i * SIZE_OF_TYPE, SIZE_OF_TYPE);
+        }
+        return Status::OK();
+    }
+
+    Slice _data;
+    PageDecoderOptions _options;
+    bool _parsed = false;
+    size_t _num_elements = 0;
+    size_t _cur_index = 0;
+    faststring _decoded;
+    // Not null if the page is encoded by bitshuffle.
+    std::unique_ptr<BitShufflePageDecoder<Type>> _bitshuffle_decoder;
+};
+
+} // namespace segment_v2
+} // namespace starrocks
@@ -24,8 +24,12 @@
 #include <memory>
 #include <type_traits>
 
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
 #include "common/logging.h"
 #include "gutil/casts.h"
+#include "gutil/strings/fastmem.h"
 #include "gutil/strings/substitute.h" // for Substitute
 #include "storage/rowset/segment_v2/bitshuffle_page.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -201,7 +205,6 @@ Status BinaryDictPageDecoder<Type>::seek_to_position_in_page(size_t pos) {
 template <FieldType Type>
 void BinaryDictPageDecoder<Type>::set_dict_decoder(PageDecoder* dict_decoder) {
     _dict_decoder = down_cast<BinaryPlainPageDecoder<Type>*>(dict_decoder);
-    _max_value_legth = _dict_decoder->max_value_length();
 }
 
 template <FieldType Type>
@@ -255,21 +258,39 @@ Status BinaryDictPageDecoder<Type>::next_batch(size_t* n, vectorized::Column* ds
     RETURN_IF_ERROR(_data_page_decoder->next_batch(n, _vec_code_buf.get()));
     using cast_type = CppTypeTraits<OLAP_FIELD_TYPE_INT>::CppType;
     const cast_type* codewords = reinterpret_cast<const cast_type*>(_vec_code_buf->raw_data());
-    std::vector<Slice> slices;
-    slices.reserve(*n);
-    if constexpr (Type == OLAP_FIELD_TYPE_CHAR) {
-        for (int i = 0; i < *n; ++i) {
-            Slice element = _dict_decoder->string_at_index(codewords[i]);
+    const size_t count = *n;
+
+    // The words are written into the bytes of the BinaryColumn directly: the offsets are computed first, then
+    // the words are copied by the offsets, without building the slices of the words.
+    auto* binary = down_cast<vectorized::BinaryColumn*>(vectorized::ColumnHelper::get_data_column(dst));
+    auto& offsets = binary->get_offset();
+    auto& bytes = binary->get_bytes();
+    const size_t num_offsets = offsets.size();
+    offsets.resize(num_offsets + count);
+    uint32_t* next_offsets = offsets.data() + num_offsets;
+    uint32_t offset = offsets[num_offsets - 1];
+    for (size_t i = 0; i < count; ++i) {
+        Slice element = _dict_decoder->string_at_index(codewords[i]);
+        if constexpr (Type == OLAP_FIELD_TYPE_CHAR) {
             // Strip trailing '\x00'
             element.size = strnlen(element.data, element.size);
-            slices.emplace_back(element);
-        }
-    } else {
-        for (int i = 0; i < *n; ++i) {
-            slices.emplace_back(_dict_decoder->string_at_index(codewords[i]));
         }
+        offset += element.size;
+        next_offsets[i] = offset;
+    }
+    bytes.resize(offset);
+    uint32_t start = offsets[num_offsets - 1];
+    for (size_t i = 0; i < count; ++i) {
+        const Slice element = _dict_decoder->string_at_index(codewords[i]);
+        strings::memcpy_inlined(bytes.data() + start, element.data, next_offsets[i] - start);
+        start = next_offsets[i];
+    }
+    binary->invalidate_slice_cache();
+
+    if (dst->is_nullable()) {
+        auto& null_data = down_cast<vectorized::NullableColumn*>(dst)->null_column_data();
+        null_data.resize(null_data.size() + count, 0);
     }
-    CHECK(dst->append_strings_overflow(slices, _max_value_legth));
     return Status::OK();
 }
 
@@ -145,8 +145,6 @@ private:
     EncodingTypePB _encoding_type;
     std::unique_ptr<ColumnVectorBatch> _batch;
     std::shared_ptr<vectorized::Column> _vec_code_buf;
-
-    uint32_t _max_value_legth = 0;
 };
 
 } // namespace segment_v2
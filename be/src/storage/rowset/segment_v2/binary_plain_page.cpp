@@ -1,6 +1,10 @@
 #include "storage/rowset/segment_v2/binary_plain_page.h"
 
 #include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "gutil/strings/fastmem.h"
 
 namespace starrocks::segment_v2 {
 
@@ -12,27 +16,63 @@ Status BinaryPlainPageDecoder<Type>::next_batch(size_t* count, vectorized::Colum
         return Status::OK();
     }
     *count = std::min(*count, static_cast<size_t>(_num_elems - _cur_idx));
+    if constexpr (Type == OLAP_FIELD_TYPE_CHAR || Type == OLAP_FIELD_TYPE_VARCHAR) {
+        _append_to_binary(*count, dst);
+        return Status::OK();
+    }
     std::vector<Slice> strs;
     strs.reserve(*count);
     size_t end = _cur_idx + *count;
+    for (/**/; _cur_idx < end; _cur_idx++) {
+        strs.emplace_back(string_at_index(_cur_idx));
+    }
+    if (dst->append_continuous_strings(strs)) {
+        return Status::OK();
+    }
+    return Status::InvalidArgument("Column::append_strings() not supported");
+}
+
+template <FieldType Type>
+void BinaryPlainPageDecoder<Type>::_append_to_binary(size_t count, vectorized::Column* dst) {
+    auto* binary = down_cast<vectorized::BinaryColumn*>(vectorized::ColumnHelper::get_data_column(dst));
+    auto& offsets = binary->get_offset();
+    auto& bytes = binary->get_bytes();
+    const size_t num_offsets = offsets.size();
+    const uint32_t base = offsets[num_offsets - 1];
+    const size_t end = _cur_idx + count;
+    offsets.resize(num_offsets + count);
+    uint32_t* next_offsets = offsets.data() + num_offsets;
     if constexpr (Type == OLAP_FIELD_TYPE_CHAR) {
-        for (/**/; _cur_idx < end; _cur_idx++) {
-            Slice s = string_at_index(_cur_idx);
-            s.size = strnlen(s.data, s.size);
-            strs.emplace_back(s);
+        // The trailing '\x00' are stripped, so the words are copied one by one.
+        uint32_t offset = base;
+        for (size_t i = 0; i < count; i++) {
+            Slice s = string_at_index(_cur_idx + i);
+            offset += strnlen(s.data, s.size);
+            next_offsets[i] = offset;
         }
-        if (dst->append_strings(strs)) {
-            return Status::OK();
+        bytes.resize(offset);
+        uint32_t start = base;
+        for (size_t i = 0; i < count; i++) {
+            strings::memcpy_inlined(bytes.data() + start, string_at_index(_cur_idx + i).data, next_offsets[i] - start);
+            start = next_offsets[i];
         }
     } else {
-        for (/**/; _cur_idx < end; _cur_idx++) {
-            strs.emplace_back(string_at_index(_cur_idx));
-        }
-        if (dst->append_continuous_strings(strs)) {
-            return Status::OK();
+        // The words of the page are continuous, they're copied at once.
+        const uint32_t first = offset(_cur_idx);
+        for (size_t i = 0; i < count; i++) {
+            next_offsets[i] = base + (offset(_cur_idx + i + 1) - first);
         }
+        const uint32_t size = offset(end) - first;
+        bytes.resize(base + size);
+        strings::memcpy_inlined(bytes.data() + base, &_data[first], size);
+    }
+    _cur_idx = end;
+    binary->invalidate_slice_cache();
+
+    if (dst->is_nullable()) {
+        auto& null_data = down_cast<vectorized::NullableColumn*>(dst)->null_column_data();
+        null_data.resize(null_data.size() + count, 0);
     }
-    return Status::InvalidArgument("Column::append_strings() not supported");
 }
 
 template class BinaryPlainPageDecoder<OLAP_FIELD_TYPE_CHAR>;
@@ -271,6 +271,9 @@ public:
     }
 
 private:
+    // Appends the next |count| words into |dst| directly, which is a BinaryColumn or a nullable one.
+    void _append_to_binary(size_t count, vectorized::Column* dst);
+
     // Return the offset within '_data' where the string value with index 'idx' can be found.
     uint32_t offset(int idx) const {
         if (idx >= _num_elems) {
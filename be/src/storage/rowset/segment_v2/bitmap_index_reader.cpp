@@ -21,6 +21,7 @@
 
 #include "storage/rowset/segment_v2/bitmap_index_reader.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "storage/types.h"
@@ -39,6 +40,11 @@ Status BitmapIndexReader::load(fs::BlockManager* block_mgr, const std::string& f
     _bitmap_column_reader = std::make_unique<IndexedColumnReader>(block_mgr, file_name, bitmap_meta);
     RETURN_IF_ERROR(_dict_column_reader->load(use_page_cache, kept_in_memory));
     RETURN_IF_ERROR(_bitmap_column_reader->load(use_page_cache, kept_in_memory));
+    if (bitmap_index_meta->has_bit_slice_column()) {
+        _bit_slice_column_reader =
+                std::make_unique<IndexedColumnReader>(block_mgr, file_name, bitmap_index_meta->bit_slice_column());
+        RETURN_IF_ERROR(_bit_slice_column_reader->load(use_page_cache, kept_in_memory));
+    }
     return Status::OK();
 }
 
@@ -46,8 +52,13 @@ Status BitmapIndexReader::new_iterator(BitmapIndexIterator** iterator) {
     std::unique_ptr<IndexedColumnIterator> dict_iter;
     std::unique_ptr<IndexedColumnIterator> bitmap_iter;
     RETURN_IF_ERROR(_dict_column_reader->new_iterator(&dict_iter));
+    std::unique_ptr<IndexedColumnIterator> bit_slice_iter;
     RETURN_IF_ERROR(_bitmap_column_reader->new_iterator(&bitmap_iter));
-    *iterator = new BitmapIndexIterator(this, std::move(dict_iter), std::move(bitmap_iter), _has_null, bitmap_nums());
+    if (_bit_slice_column_reader != nullptr) {
+        RETURN_IF_ERROR(_bit_slice_column_reader->new_iterator(&bit_slice_iter));
+    }
+    *iterator = new BitmapIndexIterator(this, std::move(dict_iter), std::move(bitmap_iter), std::move(bit_slice_iter),
+                                        _has_null, bitmap_nums());
     return Status::OK();
 }
 
@@ -59,16 +70,19 @@ Status BitmapIndexIterator::seek_dictionary(const void* value, bool* exact_match
 
 Status BitmapIndexIterator::read_bitmap(rowid_t ordinal, Roaring* result) {
     DCHECK(0 <= ordinal && ordinal < _reader->bitmap_nums());
+    return _read_bitmap(_bitmap_column_iter.get(), ordinal, result);
+}
 
+Status BitmapIndexIterator::_read_bitmap(IndexedColumnIterator* iter, rowid_t ordinal, Roaring* result) {
     size_t num_to_read = 1;
     std::unique_ptr<ColumnVectorBatch> cvb;
     RETURN_IF_ERROR(ColumnVectorBatch::create(num_to_read, false, _reader->type_info(), nullptr, &cvb));
     ColumnBlock block(cvb.get(), _pool.get());
     ColumnBlockView column_block_view(&block);
 
-    RETURN_IF_ERROR(_bitmap_column_iter->seek_to_ordinal(ordinal));
+    RETURN_IF_ERROR(iter->seek_to_ordinal(ordinal));
     size_t num_read = num_to_read;
-    RETURN_IF_ERROR(_bitmap_column_iter->next_batch(&num_read, &column_block_view));
+    RETURN_IF_ERROR(iter->next_batch(&num_read, &column_block_view));
     DCHECK(num_to_read == num_read);
 
     *result = Roaring::read(reinterpret_cast<const Slice*>(block.data())->data, false);
@@ -88,11 +102,79 @@ Status BitmapIndexIterator::read_union_bitmap(rowid_t from, rowid_t to, Roaring*
 }
 
 Status BitmapIndexIterator::read_union_bitmap(const vectorized::SparseRange& range, Roaring* result) {
+    // the null bitmap is the last one, which has no ordinal in the bit slices.
+    const rowid_t num_values = _num_bitmap - _has_null;
+    for (size_t i = 0; i < range.size(); i++) {
+        const vectorized::Range& r = range[i];
+        rowid_t to = std::min<rowid_t>(r.end(), num_values);
+        if (!_use_bit_slices(r.begin(), to)) {
+            RETURN_IF_ERROR(read_union_bitmap(r.begin(), r.end(), result));
+            continue;
+        }
+        RETURN_IF_ERROR(_load_bit_slices());
+        Roaring less_than_to;
+        Roaring less_than_from;
+        _less_than_by_bit_slices(to, &less_than_to);
+        _less_than_by_bit_slices(r.begin(), &less_than_from);
+        *result |= (less_than_to - less_than_from);
+        if (r.end() > to) {
+            Roaring null_bitmap;
+            RETURN_IF_ERROR(read_null_bitmap(&null_bitmap));
+            *result |= null_bitmap;
+        }
+    }
+    return Status::OK();
+}
+
+size_t BitmapIndexIterator::num_bitmaps_to_read(const vectorized::SparseRange& range) const {
+    const rowid_t num_values = _num_bitmap - _has_null;
+    size_t num_bitmaps = 0;
+    bool read_bit_slices = false;
     for (size_t i = 0; i < range.size(); i++) {
         const vectorized::Range& r = range[i];
-        RETURN_IF_ERROR(read_union_bitmap(r.begin(), r.end(), result));
+        rowid_t to = std::min<rowid_t>(r.end(), num_values);
+        if (_use_bit_slices(r.begin(), to)) {
+            read_bit_slices = true;
+            num_bitmaps += r.end() - to;
+        } else {
+            num_bitmaps += r.span_size();
+        }
     }
+    if (read_bit_slices && _bit_slices.empty()) {
+        num_bitmaps += _reader->_bit_slice_column_reader->num_values();
+    }
+    return num_bitmaps;
+}
+
+Status BitmapIndexIterator::_load_bit_slices() {
+    if (!_bit_slices.empty()) {
+        return Status::OK();
+    }
+    std::vector<Roaring> slices(_reader->_bit_slice_column_reader->num_values());
+    for (rowid_t i = 0; i < slices.size(); i++) {
+        RETURN_IF_ERROR(_read_bitmap(_bit_slice_column_iter.get(), i, &slices[i]));
+    }
+    _bit_slices = std::move(slices);
     return Status::OK();
 }
 
+// The rows less than `ordinal` are found from the highest bit, by the rows equal with the bits of `ordinal` so far,
+// e.g. if the bit i of `ordinal` is 1, the rows of these whose bit i is 0 are less than it.
+void BitmapIndexIterator::_less_than_by_bit_slices(rowid_t ordinal, Roaring* result) const {
+    DCHECK(!_bit_slices.empty());
+    const size_t num_bits = _bit_slices.size() - 1;
+    if (ordinal == 0) {
+        return;
+    }
+    Roaring equal = _bit_slices[num_bits];
+    for (size_t bit = num_bits; bit-- > 0;) {
+        if ((ordinal >> bit) & 1) {
+            *result |= (equal - _bit_slices[bit]);
+            equal &= _bit_slices[bit];
+        } else {
+            equal -= _bit_slices[bit];
+        }
+    }
+}
+
 } // namespace starrocks::segment_v2
@@ -61,6 +61,8 @@ public:
 
     int64_t bitmap_nums() { return _bitmap_column_reader->num_values(); }
 
+    bool has_bit_slices() const { return _bit_slice_column_reader != nullptr; }
+
     const TypeInfoPtr& type_info() { return _typeinfo; }
 
     size_t mem_usage() const {
@@ -71,6 +73,9 @@ public:
         if (_bitmap_column_reader != nullptr) {
             size += _bitmap_column_reader->mem_usage();
         }
+        if (_bit_slice_column_reader != nullptr) {
+            size += _bit_slice_column_reader->mem_usage();
+        }
         return size;
     }
 
@@ -81,15 +86,19 @@ private:
     bool _has_null = false;
     std::unique_ptr<IndexedColumnReader> _dict_column_reader;
     std::unique_ptr<IndexedColumnReader> _bitmap_column_reader;
+    // nullptr if the index has no bit slices
+    std::unique_ptr<IndexedColumnReader> _bit_slice_column_reader;
 };
 
 class BitmapIndexIterator {
 public:
     BitmapIndexIterator(BitmapIndexReader* reader, std::unique_ptr<IndexedColumnIterator> dict_iter,
-                        std::unique_ptr<IndexedColumnIterator> bitmap_iter, bool has_null, rowid_t num_bitmap)
+                        std::unique_ptr<IndexedColumnIterator> bitmap_iter,
+                        std::unique_ptr<IndexedColumnIterator> bit_slice_iter, bool has_null, rowid_t num_bitmap)
             : _reader(reader),
               _dict_column_iter(std::move(dict_iter)),
               _bitmap_column_iter(std::move(bitmap_iter)),
+              _bit_slice_column_iter(std::move(bit_slice_iter)),
               _has_null(has_null),
               _num_bitmap(num_bitmap),
               _current_rowid(0),
@@ -127,16 +136,37 @@ public:
     // for (size_t i = 0; i < range.size(); i++) {
     //     read_union_bitmap(range[i].begin(), range[i].end(), &result);
     // }
+    //
+    // The wide ranges are read by the bit slices if the index has them.
     Status read_union_bitmap(const vectorized::SparseRange& range, Roaring* result);
 
+    // The number of the bitmaps read by `read_union_bitmap(range)`, used to estimate its cost.
+    size_t num_bitmaps_to_read(const vectorized::SparseRange& range) const;
+
     inline rowid_t bitmap_nums() const { return _num_bitmap; }
 
     inline rowid_t current_ordinal() const { return _current_rowid; }
 
 private:
+    Status _read_bitmap(IndexedColumnIterator* iter, rowid_t ordinal, Roaring* result);
+
+    // Read the bit slices once, they are kept for the following ranges.
+    Status _load_bit_slices();
+
+    // Union the rows whose dictionary ordinals are less than `ordinal` into `result` by the bit slices.
+    void _less_than_by_bit_slices(rowid_t ordinal, Roaring* result) const;
+
+    // Whether the range of the dictionary [from, to) is read by the bit slices instead of the union.
+    bool _use_bit_slices(rowid_t from, rowid_t to) const {
+        return _bit_slice_column_iter != nullptr && to - from > 2 * _reader->_bit_slice_column_reader->num_values();
+    }
+
     BitmapIndexReader* _reader;
     std::unique_ptr<IndexedColumnIterator> _dict_column_iter;
     std::unique_ptr<IndexedColumnIterator> _bitmap_column_iter;
+    std::unique_ptr<IndexedColumnIterator> _bit_slice_column_iter;
+    // the bits of the dictionary ordinals followed by the non-null rows, empty until loaded
+    std::vector<Roaring> _bit_slices;
     bool _has_null;
     rowid_t _num_bitmap;
     rowid_t _current_rowid;
@@ -24,6 +24,7 @@
 #include <map>
 #include <roaring/roaring.hh>
 
+#include "common/config.h"
 #include "env/env.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
@@ -62,6 +63,12 @@ struct BitmapIndexTraits<Slice> {
 //   bitmap for ID 1 : [1 1 1 0 0 0 1 0 0 0]
 //   the n-th bit is set to 1 if the n-th row equals to the corresponding value.
 //
+// For a column of many distinct values, the bit slices of the ids are written besides, see
+// config::bitmap_index_bit_slice_min_cardinality. E.g, for the ids [0 1 2 1] of 4 rows, the bit slices are
+//   bitmap for bit 0 : [0 1 0 1]
+//   bitmap for bit 1 : [0 0 1 0]
+//   bitmap of the non-null rows : [1 1 1 1]
+//
 template <FieldType field_type>
 class BitmapIndexWriterImpl : public BitmapIndexWriter {
 public:
@@ -133,39 +140,27 @@ public:
             if (!_null_bitmap.isEmpty()) {
                 bitmaps.push_back(&_null_bitmap);
             }
-
-            uint32_t max_bitmap_size = 0;
-            std::vector<uint32_t> bitmap_sizes;
-            for (auto& bitmap : bitmaps) {
-                bitmap->runOptimize();
-                uint32_t bitmap_size = bitmap->getSizeInBytes(false);
-                if (max_bitmap_size < bitmap_size) {
-                    max_bitmap_size = bitmap_size;
+            RETURN_IF_ERROR(_write_bitmaps(wblock, bitmaps, meta->mutable_bitmap_column()));
+        }
+        int min_cardinality = config::bitmap_index_bit_slice_min_cardinality;
+        if (min_cardinality > 0 && _mem_index.size() >= static_cast<size_t>(min_cardinality)) { // write bit slices
+            size_t num_bits = 64 - __builtin_clzll(_mem_index.size());
+            std::vector<Roaring> slices(num_bits + 1);
+            uint64_t ordinal = 0;
+            for (auto& it : _mem_index) {
+                for (size_t bit = 0; bit < num_bits; bit++) {
+                    if ((ordinal >> bit) & 1) {
+                        slices[bit] |= it.second;
+                    }
                 }
-                bitmap_sizes.push_back(bitmap_size);
+                slices[num_bits] |= it.second;
+                ordinal++;
             }
-
-            TypeInfoPtr bitmap_typeinfo = get_type_info(OLAP_FIELD_TYPE_OBJECT);
-
-            IndexedColumnWriterOptions options;
-            options.write_ordinal_index = true;
-            options.write_value_index = false;
-            options.encoding = EncodingInfo::get_default_encoding(bitmap_typeinfo->type(), false);
-            // we already store compressed bitmap, use NO_COMPRESSION to save some cpu
-            options.compression = NO_COMPRESSION;
-
-            IndexedColumnWriter bitmap_column_writer(options, bitmap_typeinfo, wblock);
-            RETURN_IF_ERROR(bitmap_column_writer.init());
-
-            faststring buf;
-            buf.reserve(max_bitmap_size);
-            for (size_t i = 0; i < bitmaps.size(); ++i) {
-                buf.resize(bitmap_sizes[i]); // so that buf[0..size) can be read and written
-                bitmaps[i]->write(reinterpret_cast<char*>(buf.data()), false);
-                Slice buf_slice(buf);
-                RETURN_IF_ERROR(bitmap_column_writer.add(&buf_slice));
+            std::vector<Roaring*> bitmaps;
+            for (auto& slice : slices) {
+                bitmaps.push_back(&slice);
             }
-            RETURN_IF_ERROR(bitmap_column_writer.finish(meta->mutable_bitmap_column()));
+            RETURN_IF_ERROR(_write_bitmaps(wblock, bitmaps, meta->mutable_bit_slice_column()));
         }
         return Status::OK();
     }
@@ -180,6 +175,42 @@ public:
     }
 
 private:
+    static Status _write_bitmaps(fs::WritableBlock* wblock, const std::vector<Roaring*>& bitmaps,
+                                 IndexedColumnMetaPB* column_meta) {
+        uint32_t max_bitmap_size = 0;
+        std::vector<uint32_t> bitmap_sizes;
+        for (auto& bitmap : bitmaps) {
+            bitmap->runOptimize();
+            uint32_t bitmap_size = bitmap->getSizeInBytes(false);
+            if (max_bitmap_size < bitmap_size) {
+                max_bitmap_size = bitmap_size;
+            }
+            bitmap_sizes.push_back(bitmap_size);
+        }
+
+        TypeInfoPtr bitmap_typeinfo = get_type_info(OLAP_FIELD_TYPE_OBJECT);
+
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = EncodingInfo::get_default_encoding(bitmap_typeinfo->type(), false);
+        // we already store compressed bitmap, use NO_COMPRESSION to save some cpu
+        options.compression = NO_COMPRESSION;
+
+        IndexedColumnWriter bitmap_column_writer(options, bitmap_typeinfo, wblock);
+        RETURN_IF_ERROR(bitmap_column_writer.init());
+
+        faststring buf;
+        buf.reserve(max_bitmap_size);
+        for (size_t i = 0; i < bitmaps.size(); ++i) {
+            buf.resize(bitmap_sizes[i]); // so that buf[0..size) can be read and written
+            bitmaps[i]->write(reinterpret_cast<char*>(buf.data()), false);
+            Slice buf_slice(buf);
+            RETURN_IF_ERROR(bitmap_column_writer.add(&buf_slice));
+        }
+        return bitmap_column_writer.finish(column_meta);
+    }
+
     TypeInfoPtr _typeinfo;
     uint64_t _reverted_index_size;
     rowid_t _rid = 0;
@@ -21,8 +21,11 @@
 
 #include "storage/rowset/segment_v2/bloom_filter_index_writer.h"
 
+#include <cstring>
 #include <map>
 #include <memory>
+#include <unordered_set>
+#include <vector>
 
 #include "env/env.h"
 #include "runtime/mem_pool.h"
@@ -33,6 +36,7 @@
 #include "storage/rowset/segment_v2/encoding_info.h"
 #include "storage/rowset/segment_v2/indexed_column_writer.h"
 #include "storage/types.h"
+#include "util/murmur_hash3.h"
 #include "util/slice.h"
 
 namespace starrocks {
@@ -176,8 +180,106 @@ private:
     std::vector<std::unique_ptr<BloomFilter>> _bfs;
 };
 
+// Builder for the n-gram bloom filters. Each bloom filter contains the hashes of the n-grams of the strings of
+// one data page, so that the pages not containing all the n-grams of a substring could be skipped.
+template <FieldType field_type>
+class NGramBloomFilterIndexWriterImpl : public BloomFilterIndexWriter {
+public:
+    NGramBloomFilterIndexWriterImpl(const BloomFilterOptions& bf_options, uint32_t gram_size)
+            : _bf_options(bf_options), _gram_size(gram_size) {}
+
+    ~NGramBloomFilterIndexWriterImpl() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        const auto* v = reinterpret_cast<const Slice*>(values);
+        for (size_t i = 0; i < count; ++i, ++v) {
+            size_t size = v->size;
+            if constexpr (field_type == OLAP_FIELD_TYPE_CHAR) {
+                // Strip the padding '\x00' of CHAR.
+                size = strnlen(v->data, size);
+            }
+            for (size_t j = 0; j + _gram_size <= size; j++) {
+                uint64_t hash;
+                murmur_hash3_x64_64(v->data + j, _gram_size, BloomFilter::DEFAULT_SEED, &hash);
+                _hashes.insert(hash);
+            }
+        }
+    }
+
+    void add_nulls(uint32_t count) override { _has_null |= (count > 0); }
+
+    Status flush() override {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(_hashes.size(), _bf_options.fpp, _bf_options.strategy));
+        bf->set_has_null(_has_null);
+        for (uint64_t hash : _hashes) {
+            bf->add_hash(hash);
+        }
+        _bf_buffer_size += bf->size();
+        _bfs.push_back(std::move(bf));
+        _hashes.clear();
+        _has_null = false;
+        return Status::OK();
+    }
+
+    Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) override {
+        if (!_hashes.empty()) {
+            RETURN_IF_ERROR(flush());
+        }
+        index_meta->set_type(NGRAM_BLOOM_FILTER_INDEX);
+        BloomFilterIndexPB* meta = index_meta->mutable_ngram_bloom_filter_index();
+        meta->set_hash_strategy(_bf_options.strategy);
+        meta->set_algorithm(BLOCK_BLOOM_FILTER);
+        meta->set_gram_size(_gram_size);
+
+        TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = PLAIN_ENCODING;
+        IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
+        RETURN_IF_ERROR(bf_writer.init());
+        for (auto& bf : _bfs) {
+            Slice data(bf->data(), bf->size());
+            bf_writer.add(&data);
+        }
+        RETURN_IF_ERROR(bf_writer.finish(meta->mutable_bloom_filter()));
+        return Status::OK();
+    }
+
+    uint64_t size() override { return _bf_buffer_size + _hashes.size() * sizeof(uint64_t); }
+
+private:
+    BloomFilterOptions _bf_options;
+    const uint32_t _gram_size;
+    bool _has_null = false;
+    uint64_t _bf_buffer_size = 0;
+    // the distinct hashes of the n-grams of the current page.
+    std::unordered_set<uint64_t> _hashes;
+    std::vector<std::unique_ptr<BloomFilter>> _bfs;
+};
+
 } // namespace
 
+Status BloomFilterIndexWriter::create_ngram(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
+                                            uint32_t gram_size, std::unique_ptr<BloomFilterIndexWriter>* res) {
+    if (gram_size == 0) {
+        return Status::InvalidArgument("the gram size of the n-gram bloom filter must be positive");
+    }
+    switch (typeinfo->type()) {
+    case OLAP_FIELD_TYPE_CHAR:
+        *res = std::make_unique<NGramBloomFilterIndexWriterImpl<OLAP_FIELD_TYPE_CHAR>>(bf_options, gram_size);
+        break;
+    case OLAP_FIELD_TYPE_VARCHAR:
+        *res = std::make_unique<NGramBloomFilterIndexWriterImpl<OLAP_FIELD_TYPE_VARCHAR>>(bf_options, gram_size);
+        break;
+    default:
+        return Status::NotSupported("unsupported type for n-gram bloom filter: " + std::to_string(typeinfo->type()));
+    }
+    return Status::OK();
+}
+
 // TODO currently we don't support bloom filter index for tinyint/hll/float/double
 Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
                                       std::unique_ptr<BloomFilterIndexWriter>* res) {
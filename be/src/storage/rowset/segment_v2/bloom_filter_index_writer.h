@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 
 #include "common/status.h"
@@ -46,6 +47,11 @@ public:
     static Status create(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
                          std::unique_ptr<BloomFilterIndexWriter>* res);
 
+    // Creates the writer of the bloom filters of the |gram_size| bytes n-grams of the strings of each page, which
+    // are probed by the substrings of the `LIKE` patterns.
+    static Status create_ngram(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo, uint32_t gram_size,
+                               std::unique_ptr<BloomFilterIndexWriter>* res);
+
     BloomFilterIndexWriter() = default;
     virtual ~BloomFilterIndexWriter() = default;
 
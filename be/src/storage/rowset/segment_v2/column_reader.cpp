@@ -36,6 +36,7 @@
 #include "gutil/strings/substitute.h" // for Substitute
 #include "storage/column_block.h"     // for ColumnBlockView
 #include "storage/olap_cond.h"
+#include "storage/page_cache.h"
 #include "storage/rowset/segment_v2/binary_dict_page.h" // for BinaryDictPageDecoder
 #include "storage/rowset/segment_v2/bitmap_index_reader.h"
 #include "storage/rowset/segment_v2/bloom_filter_index_reader.h"
@@ -119,6 +120,12 @@ Status ColumnReader::init(const ColumnMetaPB& meta) {
 
     RETURN_IF_ERROR(EncodingInfo::get(delegate_type(_column_type), meta.encoding(), &_encoding_info));
     RETURN_IF_ERROR(get_block_compression_codec(meta.compression(), &_compress_codec));
+    if (meta.has_compression_dict()) {
+        RETURN_IF_ERROR(create_zstd_dict_compression_codec(meta.compression_dict(), &_dict_codec));
+        _compress_codec = _dict_codec.get();
+        // the dictionary is digested for both the compression and the decompression
+        _mem_tracker->consume(2 * meta.compression_dict().size());
+    }
 
     for (int i = 0; i < meta.indexes_size(); i++) {
         const auto& index_meta = meta.indexes(i);
@@ -135,6 +142,9 @@ Status ColumnReader::init(const ColumnMetaPB& meta) {
         case BLOOM_FILTER_INDEX:
             _bf_index_meta = &index_meta.bloom_filter_index();
             break;
+        case NGRAM_BLOOM_FILTER_INDEX:
+            _ngram_bf_index_meta = &index_meta.ngram_bloom_filter_index();
+            break;
         default:
             return Status::Corruption(
                     strings::Substitute("Bad file $0: invalid column index type $1", _file_name, index_meta.type()));
@@ -167,6 +177,33 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     return PageIO::read_and_decompress_page(opts, handle, page_body, footer);
 }
 
+Status ColumnReader::read_pages(const ColumnIteratorOptions& iter_opts, const PagePointer* pps, size_t n,
+                                PageHandle* handles, Slice* page_bodies, PageFooterPB* footers) {
+    iter_opts.sanity_check();
+    PageReadOptions opts;
+    opts.rblock = iter_opts.rblock;
+    opts.codec = _compress_codec;
+    opts.stats = iter_opts.stats;
+    opts.verify_checksum = _opts.verify_checksum;
+    opts.use_page_cache = iter_opts.use_page_cache;
+    opts.kept_in_memory = _opts.kept_in_memory;
+
+    return PageIO::read_and_decompress_pages(opts, pps, n, std::max(config::segment_coalesce_read_max_gap, 0),
+                                             config::segment_coalesce_read_max_size, handles, page_bodies, footers);
+}
+
+Status ColumnReader::prefetch_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp) {
+    iter_opts.sanity_check();
+    if (iter_opts.use_page_cache) {
+        PageCacheHandle cache_handle;
+        StoragePageCache::CacheKey cache_key(iter_opts.rblock->path(), pp.offset);
+        if (StoragePageCache::instance()->lookup(cache_key, &cache_handle)) {
+            return Status::OK();
+        }
+    }
+    return iter_opts.rblock->prefetch(pp.offset, pp.size);
+}
+
 Status ColumnReader::get_row_ranges_by_zone_map(CondColumn* cond_column, CondColumn* delete_condition,
                                                 std::unordered_set<uint32_t>* delete_partial_filtered_pages,
                                                 RowRanges* row_ranges) {
@@ -342,6 +379,45 @@ Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPred
     return Status::OK();
 }
 
+Status ColumnReader::ngram_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                        vectorized::SparseRange* row_ranges) {
+    const size_t gram_size = _ngram_bf_index_meta->gram_size();
+    RETURN_IF(gram_size == 0, Status::OK());
+    vectorized::SparseRange bf_row_ranges;
+    std::unique_ptr<BloomFilterIndexIterator> bf_iter;
+    RETURN_IF_ERROR(_ngram_bloom_filter_index->new_iterator(&bf_iter));
+    size_t range_size = row_ranges->size();
+    // get covered page ids
+    std::set<int32_t> page_ids;
+    for (int i = 0; i < range_size; ++i) {
+        vectorized::Range r = (*row_ranges)[i];
+        int64_t idx = r.begin();
+        auto iter = _ordinal_index->seek_at_or_before(r.begin());
+        while (idx < r.end()) {
+            page_ids.insert(iter.page_index());
+            idx = iter.last_ordinal() + 1;
+            iter.next();
+        }
+    }
+    for (const auto& pid : page_ids) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
+        bool satisfied = true;
+        for (const auto* pred : predicates) {
+            if (pred->support_ngram_bloom_filter() && !pred->ngram_bloom_filter(bf.get(), gram_size)) {
+                satisfied = false;
+                break;
+            }
+        }
+        if (satisfied) {
+            bf_row_ranges.add(vectorized::Range(_ordinal_index->get_first_ordinal(pid),
+                                                _ordinal_index->get_last_ordinal(pid) + 1));
+        }
+    }
+    *row_ranges = row_ranges->intersection(bf_row_ranges);
+    return Status::OK();
+}
+
 Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memory) {
     DCHECK(_ordinal_index_meta != nullptr);
     _ordinal_index = std::make_unique<OrdinalIndexReader>();
@@ -384,6 +460,17 @@ Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_
     return Status::OK();
 }
 
+Status ColumnReader::_load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
+    if (_ngram_bf_index_meta != nullptr) {
+        _ngram_bloom_filter_index = std::make_unique<BloomFilterIndexReader>();
+        Status status = _ngram_bloom_filter_index->load(_opts.block_mgr, _file_name, _ngram_bf_index_meta,
+                                                        use_page_cache, kept_in_memory);
+        _mem_tracker->consume(_ngram_bloom_filter_index->mem_usage());
+        return status;
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::seek_to_first(OrdinalPageIndexIterator* iter) {
     *iter = _ordinal_index->begin();
     if (!iter->valid()) {
@@ -452,6 +539,24 @@ bool ColumnReader::segment_zone_map_filter(const std::vector<const vectorized::C
     return std::all_of(predicates.begin(), predicates.end(), filter);
 }
 
+Status ColumnReader::segment_zone_map(vectorized::Datum* min, vectorized::Datum* max, bool* has_null,
+                                      bool* has_not_null) const {
+    if (_zone_map_index_meta == nullptr) {
+        return Status::NotFound("no zone map");
+    }
+    const ZoneMapPB& zm = _zone_map_index_meta->segment_zone_map();
+    *has_null = zm.has_null();
+    *has_not_null = zm.has_not_null();
+    min->set_null();
+    max->set_null();
+    if (zm.has_not_null()) {
+        TypeInfoPtr type_info = get_type_info(delegate_type(_column_type));
+        RETURN_IF_ERROR(vectorized::datum_from_string(type_info.get(), min, zm.min(), nullptr));
+        RETURN_IF_ERROR(vectorized::datum_from_string(type_info.get(), max, zm.max(), nullptr));
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::new_iterator(ColumnIterator** iterator) {
     if (is_scalar_type(delegate_type(_column_type))) {
         *iterator = new FileColumnIterator(this);
@@ -495,6 +600,7 @@ Status ColumnReader::ensure_index_loaded(ReaderType reader_type) {
             RETURN_IF_ERROR(_load_zone_map_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bitmap_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
+            RETURN_IF_ERROR(_load_ngram_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
             return Status::OK();
         });
     }
@@ -854,11 +960,90 @@ Status FileColumnIterator::_do_init_dict_decoder() {
     return Status::OK();
 }
 
+Status FileColumnIterator::set_read_ahead_range(const vectorized::SparseRange& range, int max_pages) {
+    _read_ahead_pages.clear();
+    _read_ahead_issued = 0;
+    _coalesced_pages.clear();
+    _read_ahead_max_pages = max_pages;
+    RETURN_IF(max_pages <= 0, Status::OK());
+    for (size_t i = 0; i < range.size(); i++) {
+        const vectorized::Range r = range[i];
+        OrdinalPageIndexIterator iter;
+        RETURN_IF_ERROR(_reader->seek_at_or_before(r.begin(), &iter));
+        for (; iter.valid() && iter.first_ordinal() < r.end(); iter.next()) {
+            if (_read_ahead_pages.empty() || _read_ahead_pages.back().first < iter.page_index()) {
+                _read_ahead_pages.emplace_back(iter.page_index(), iter.page());
+            }
+        }
+    }
+    return Status::OK();
+}
+
+void FileColumnIterator::_read_ahead(int32_t page_index) {
+    // skip the pages before the current one, which are either read or skipped by the row ranges.
+    auto next = std::upper_bound(_read_ahead_pages.begin(), _read_ahead_pages.end(), page_index,
+                                 [](int32_t index, const auto& page) { return index < page.first; });
+    size_t first = next - _read_ahead_pages.begin();
+    size_t last = std::min(_read_ahead_pages.size(), first + _read_ahead_max_pages);
+    for (size_t i = std::max(first, _read_ahead_issued); i < last; i++) {
+        // it's only a hint, the page will be read again if the prefetch fails.
+        WARN_IF_ERROR(_reader->prefetch_page(_opts, _read_ahead_pages[i].second), "Fail to prefetch page");
+    }
+    _read_ahead_issued = std::max(_read_ahead_issued, last);
+}
+
+Status FileColumnIterator::_read_coalesced_pages(int32_t page_index, PageHandle* handle, Slice* page_body,
+                                                 PageFooterPB* footer, bool* found) {
+    // drop the pages skipped by the row ranges.
+    while (!_coalesced_pages.empty() && _coalesced_pages.front().page_index < page_index) {
+        _coalesced_pages.pop_front();
+    }
+    if (_coalesced_pages.empty() || _coalesced_pages.front().page_index != page_index) {
+        auto pos = std::lower_bound(_read_ahead_pages.begin(), _read_ahead_pages.end(), page_index,
+                                    [](const auto& page, int32_t index) { return page.first < index; });
+        if (pos == _read_ahead_pages.end() || pos->first != page_index) {
+            *found = false;
+            return Status::OK();
+        }
+        size_t first = pos - _read_ahead_pages.begin();
+        size_t n = std::min<size_t>(_read_ahead_pages.size() - first, std::max(_read_ahead_max_pages, 1));
+        std::vector<PagePointer> pps(n);
+        for (size_t i = 0; i < n; i++) {
+            pps[i] = _read_ahead_pages[first + i].second;
+        }
+        std::vector<PageHandle> handles(n);
+        std::vector<Slice> bodies(n);
+        std::vector<PageFooterPB> footers(n);
+        RETURN_IF_ERROR(_reader->read_pages(_opts, pps.data(), n, handles.data(), bodies.data(), footers.data()));
+        _coalesced_pages.clear();
+        for (size_t i = 0; i < n; i++) {
+            _coalesced_pages.push_back({_read_ahead_pages[first + i].first, std::move(handles[i]), bodies[i],
+                                        std::move(footers[i])});
+        }
+    }
+    CoalescedPage& page = _coalesced_pages.front();
+    *handle = std::move(page.handle);
+    *page_body = page.body;
+    footer->Swap(&page.footer);
+    _coalesced_pages.pop_front();
+    *found = true;
+    return Status::OK();
+}
+
 Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter) {
+    if (_read_ahead_issued < _read_ahead_pages.size()) {
+        _read_ahead(iter.page_index());
+    }
     PageHandle handle;
     Slice page_body;
     PageFooterPB footer;
-    RETURN_IF_ERROR(_reader->read_page(_opts, iter.page(), &handle, &page_body, &footer));
+    bool coalesced = false;
+    if (config::segment_coalesce_read_max_size > 0 && !_read_ahead_pages.empty()) {
+        RETURN_IF_ERROR(_read_coalesced_pages(iter.page_index(), &handle, &page_body, &footer, &coalesced));
+    }
+    if (!coalesced) {
+        RETURN_IF_ERROR(_reader->read_page(_opts, iter.page(), &handle, &page_body, &footer));
+    }
     RETURN_IF_ERROR(parse_page(&_page, std::move(handle), page_body, footer.data_page_footer(),
                                _reader->encoding_info(), iter.page(), iter.page_index()));
 
@@ -914,11 +1099,28 @@ Status FileColumnIterator::get_row_ranges_by_bloom_filter(
     return Status::OK();
 }
 
+Status FileColumnIterator::get_row_ranges_by_ngram_bloom_filter(
+        const std::vector<const vectorized::ColumnPredicate*>& predicates, vectorized::SparseRange* row_ranges) {
+    RETURN_IF(!_reader->has_ngram_bloom_filter_index(), Status::OK());
+    bool support = false;
+    for (const auto* pred : predicates) {
+        support = support | pred->support_ngram_bloom_filter();
+    }
+    RETURN_IF(!support, Status::OK());
+    RETURN_IF_ERROR(_reader->ngram_bloom_filter(predicates, row_ranges));
+    return Status::OK();
+}
+
 int FileColumnIterator::dict_lookup(const Slice& word) {
     DCHECK(all_page_dict_encoded());
     return (this->*_dict_lookup_func)(word);
 }
 
+int FileColumnIterator::dict_size() {
+    DCHECK(all_page_dict_encoded());
+    return _dict_decoder != nullptr ? static_cast<int>(_dict_decoder->count()) : 0;
+}
+
 Status FileColumnIterator::next_dict_codes(size_t* n, vectorized::Column* dst) {
     DCHECK(all_page_dict_encoded());
     return (this->*_next_dict_codes_func)(n, dst);
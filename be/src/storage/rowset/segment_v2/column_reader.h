@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <cstddef> // for size_t
 #include <cstdint> // for uint32_t
+#include <deque>
 #include <memory>  // for unique_ptr
 
 #include "column/datum.h"
@@ -41,6 +42,7 @@
 #include "storage/rowset/segment_v2/page_handle.h"
 #include "storage/rowset/segment_v2/zone_map_index.h"
 #include "storage/vectorized/range.h"
+#include "util/block_compression.h"
 #include "util/once.h"
 
 namespace starrocks {
@@ -134,6 +136,14 @@ public:
     Status read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp, PageHandle* handle,
                      Slice* page_body, PageFooterPB* footer);
 
+    // read the |n| pages of |pps| in the ascending order of the offset, the adjacent ones not in the page cache
+    // are read by one IO, see PageIO::read_and_decompress_pages().
+    Status read_pages(const ColumnIteratorOptions& iter_opts, const PagePointer* pps, size_t n, PageHandle* handles,
+                      Slice* page_bodies, PageFooterPB* footers);
+
+    // read a page into the OS page cache asynchronously, unless it's in the page cache already.
+    Status prefetch_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp);
+
     bool is_nullable() const { return _is_nullable; }
 
     const EncodingInfo* encoding_info() const { return _encoding_info; }
@@ -141,6 +151,7 @@ public:
     bool has_zone_map() const { return _zone_map_index_meta != nullptr; }
     bool has_bitmap_index() const { return _bitmap_index_meta != nullptr; }
     bool has_bloom_filter_index() const { return _bf_index_meta != nullptr; }
+    bool has_ngram_bloom_filter_index() const { return _ngram_bf_index_meta != nullptr; }
 
     // Check if this column could match `cond' using segment zone map.
     // Since segment zone map is stored in metadata, this function is fast without I/O.
@@ -179,10 +190,19 @@ public:
     // same as `match_condition`, used by vector engine.
     bool segment_zone_map_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& predicates) const;
 
+    // The segment zone map, |min| and |max| are the min and the max of the non-null values, they're set to null
+    // if there's no such value. Returns NotFound if the column has no zone map.
+    Status segment_zone_map(vectorized::Datum* min, vectorized::Datum* max, bool* has_null, bool* has_not_null) const;
+
     // prerequisite: at least one predicate in |predicates| support bloom filter.
     Status bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
                         vectorized::SparseRange* ranges);
 
+    // page-level n-gram bloom filter filter, the pages are kept only if all the predicates supporting the n-gram
+    // bloom filter may be satisfied.
+    Status ngram_bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
+                              vectorized::SparseRange* ranges);
+
     uint32_t version() const { return _opts.storage_format_version; }
 
     // Read and load necessary column indexes into memory if it hasn't been loaded.
@@ -199,6 +219,7 @@ private:
     Status _load_ordinal_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bitmap_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
 
     static bool _zone_map_match_condition(const ZoneMapPB& zone_map, WrapperField* min_value_container,
                                           WrapperField* max_value_container, CondColumn* cond);
@@ -238,12 +259,15 @@ private:
     // initialized in init(), used for create PageDecoder
     const EncodingInfo* _encoding_info = nullptr;
     const BlockCompressionCodec* _compress_codec = nullptr; // initialized in init()
+    // the codec of the ZSTD dictionary of the column, which _compress_codec points to if it's not null
+    std::unique_ptr<BlockCompressionCodec> _dict_codec;
 
     // meta for various column indexes (null if the index is absent)
     const ZoneMapIndexPB* _zone_map_index_meta = nullptr;
     const OrdinalIndexPB* _ordinal_index_meta = nullptr;
     const BitmapIndexPB* _bitmap_index_meta = nullptr;
     const BloomFilterIndexPB* _bf_index_meta = nullptr;
+    const BloomFilterIndexPB* _ngram_bf_index_meta = nullptr;
 
     // The read operation comprise of compaction, query, checksum and so on.
     // The ordinal index must be loaded before read operation.
@@ -256,6 +280,7 @@ private:
     std::unique_ptr<OrdinalIndexReader> _ordinal_index;
     std::unique_ptr<BitmapIndexReader> _bitmap_index;
     std::unique_ptr<BloomFilterIndexReader> _bloom_filter_index;
+    std::unique_ptr<BloomFilterIndexReader> _ngram_bloom_filter_index;
 
     std::vector<std::unique_ptr<ColumnReader>> _sub_readers;
 };
@@ -313,6 +338,11 @@ public:
         return Status::OK();
     }
 
+    virtual Status get_row_ranges_by_ngram_bloom_filter(
+            const std::vector<const vectorized::ColumnPredicate*>& predicates, vectorized::SparseRange* row_ranges) {
+        return Status::OK();
+    }
+
     // return true iff all data pages of this column are encoded as dictionary encoding.
     // NOTE: the ColumnIterator must have been initialized with `check_dict_encoding`,
     // otherwise this method will always return false.
@@ -323,6 +353,14 @@ public:
     // NOTE: this method can be invoked only if `all_page_dict_encoded` returns true.
     virtual int dict_lookup(const Slice& word) { return -1; }
 
+    // return the number of the words in the dictionary, whose codes are [0, dict_size()).
+    // NOTE: this method can be invoked only if `all_page_dict_encoded` returns true.
+    virtual int dict_size() { return 0; }
+
+    // Hint the iterator that the rows in |range| will be read in order. The pages covering them are
+    // read ahead asynchronously, at most |max_pages| pages ahead of the page being decoded.
+    virtual Status set_read_ahead_range(const vectorized::SparseRange& range, int max_pages) { return Status::OK(); }
+
     // like `next_batch` but instead of return a batch of column values, this method returns a
     // batch of dictionary codes for dictionary encoded values.
     // this method can be invoked only if `all_page_dict_encoded` returns true.
@@ -394,10 +432,17 @@ public:
     Status get_row_ranges_by_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
                                           vectorized::SparseRange* range) override;
 
+    Status get_row_ranges_by_ngram_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                                vectorized::SparseRange* range) override;
+
     bool all_page_dict_encoded() const override { return _all_dict_encoded; }
 
     int dict_lookup(const Slice& word) override;
 
+    int dict_size() override;
+
+    Status set_read_ahead_range(const vectorized::SparseRange& range, int max_pages) override;
+
     Status next_dict_codes(size_t* n, vectorized::Column* dst) override;
 
     Status decode_dict_codes(const int32_t* codes, size_t size, vectorized::Column* words) override;
@@ -414,6 +459,11 @@ private:
     static void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page);
     Status _load_next_page(bool* eos);
     Status _read_data_page(const OrdinalPageIndexIterator& iter);
+    void _read_ahead(int32_t page_index);
+    // read the page of |page_index| together with the following pages of the read-ahead window,
+    // |*found| is set to false if it's not in the read-ahead window.
+    Status _read_coalesced_pages(int32_t page_index, PageHandle* handle, Slice* page_body, PageFooterPB* footer,
+                                 bool* found);
 
     template <FieldType Type>
     int _do_dict_lookup(const Slice& word);
@@ -461,6 +511,20 @@ private:
     // page indexes those are DEL_PARTIAL_SATISFIED
     std::unordered_set<uint32_t> _delete_partial_satisfied_pages;
 
+    // the pages to read ahead in order, and the ones before |_read_ahead_issued| have been read ahead.
+    std::vector<std::pair<int32_t, PagePointer>> _read_ahead_pages;
+    size_t _read_ahead_issued = 0;
+    int _read_ahead_max_pages = 0;
+
+    // the pages read by the coalesced IO but not parsed yet, in the ascending order of the page index.
+    struct CoalescedPage {
+        int32_t page_index;
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+    };
+    std::deque<CoalescedPage> _coalesced_pages;
+
     int (FileColumnIterator::*_dict_lookup_func)(const Slice&) = nullptr;
     Status (FileColumnIterator::*_next_dict_codes_func)(size_t* n, vectorized::Column* dst) = nullptr;
     Status (FileColumnIterator::*_decode_dict_codes_func)(const int32_t* codes, size_t size,
@@ -38,6 +38,7 @@
 #include "storage/rowset/segment_v2/bloom_filter.h"
 #include "storage/rowset/segment_v2/bloom_filter_index_writer.h"
 #include "storage/rowset/segment_v2/encoding_info.h"
+#include "storage/rowset/segment_v2/ndv_sketch_writer.h"
 #include "storage/rowset/segment_v2/options.h"
 #include "storage/rowset/segment_v2/ordinal_page_index.h"
 #include "storage/rowset/segment_v2/page_builder.h"
@@ -246,6 +247,7 @@ Status ColumnWriter::create(const ColumnWriterOptions& opts, const TabletColumn*
             element_options.need_zone_map = false;
             element_options.need_bloom_filter = element_column.is_bf_column();
             element_options.need_bitmap_index = element_column.has_bitmap_index();
+            element_options.cache_pages_in_memory = opts.cache_pages_in_memory;
             if (element_column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
                 if (element_options.need_bloom_filter) {
                     return Status::NotSupported("Do not support bloom filter for array type");
@@ -269,6 +271,7 @@ Status ColumnWriter::create(const ColumnWriterOptions& opts, const TabletColumn*
                 null_options.meta->set_encoding(DEFAULT_ENCODING);
                 null_options.meta->set_compression(LZ4);
                 null_options.meta->set_is_nullable(false);
+                null_options.cache_pages_in_memory = opts.cache_pages_in_memory;
                 std::unique_ptr<Field> bool_field(FieldFactory::create_by_type(FieldType::OLAP_FIELD_TYPE_BOOL));
                 null_writer = new ScalarColumnWriter(null_options, std::move(bool_field), _wblock);
             }
@@ -285,6 +288,7 @@ Status ColumnWriter::create(const ColumnWriterOptions& opts, const TabletColumn*
             array_size_options.need_zone_map = false;
             array_size_options.need_bloom_filter = false;
             array_size_options.need_bitmap_index = false;
+            array_size_options.cache_pages_in_memory = opts.cache_pages_in_memory;
             std::unique_ptr<Field> bigint_field(FieldFactory::create_by_type(FieldType::OLAP_FIELD_TYPE_INT));
             ScalarColumnWriter* offset_writer =
                     new ScalarColumnWriter(array_size_options, std::move(bigint_field), _wblock);
@@ -332,6 +336,9 @@ ScalarColumnWriter::~ScalarColumnWriter() {
 
 Status ScalarColumnWriter::init() {
     RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), &_compress_codec));
+    FieldType type = get_field()->type();
+    _sampling_compression_dict = _opts.meta->compression() == ZSTD && config::zstd_page_dict_size > 0 &&
+                                 (type == OLAP_FIELD_TYPE_CHAR || type == OLAP_FIELD_TYPE_VARCHAR);
 
     if (!_opts.need_speculate_encoding) {
         set_encoding(_opts.meta->encoding());
@@ -356,6 +363,16 @@ Status ScalarColumnWriter::init() {
         RETURN_IF_ERROR(BloomFilterIndexWriter::create(BloomFilterOptions(), get_field()->type_info(),
                                                        &_bloom_filter_index_builder));
     }
+    if (_opts.ngram_bloom_filter_gram_size > 0) {
+        _has_index_builder = true;
+        RETURN_IF_ERROR(BloomFilterIndexWriter::create_ngram(BloomFilterOptions(), get_field()->type_info(),
+                                                             _opts.ngram_bloom_filter_gram_size,
+                                                             &_ngram_bloom_filter_index_builder));
+    }
+    if (_opts.need_ndv_sketch) {
+        _has_index_builder = true;
+        _ndv_sketch_writer = std::make_unique<NdvSketchWriter>(get_field());
+    }
     return Status::OK();
 }
 
@@ -379,12 +396,21 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
     if (_bloom_filter_index_builder != nullptr) {
         size += _bloom_filter_index_builder->size();
     }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        size += _ngram_bloom_filter_index_builder->size();
+    }
     return size;
 }
 
 Status ScalarColumnWriter::finish() {
     RETURN_IF_ERROR(finish_current_page());
+    if (_sampling_compression_dict) {
+        RETURN_IF_ERROR(_train_compression_dict());
+    }
     _opts.meta->set_num_rows(_next_rowid);
+    if (_ndv_sketch_writer != nullptr) {
+        _ndv_sketch_writer->finish(_opts.meta);
+    }
     return Status::OK();
 }
 
@@ -410,6 +436,9 @@ Status ScalarColumnWriter::write_data() {
         std::vector<Slice> body{Slice(*dict_body)};
         RETURN_IF_ERROR(PageIO::compress_and_write_page(_compress_codec, _opts.compression_min_space_saving, _wblock,
                                                         body, footer, &dict_pp));
+        if (_opts.cache_pages_in_memory) {
+            RETURN_IF_ERROR(PageIO::cache_written_page(_wblock, _compress_codec, body, footer, dict_pp));
+        }
         dict_pp.to_proto(_opts.meta->mutable_dict_page());
     }
     _opts.meta->set_all_dict_encoded(_page_builder->all_dict_encoded());
@@ -461,7 +490,10 @@ Status ScalarColumnWriter::write_bitmap_index() {
 
 Status ScalarColumnWriter::write_bloom_filter_index() {
     if (_bloom_filter_index_builder != nullptr) {
-        return _bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
+    }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
     }
     return Status::OK();
 }
@@ -474,10 +506,63 @@ Status ScalarColumnWriter::_write_data_page(Page* page) {
         compressed_body.push_back(data.slice());
     }
     RETURN_IF_ERROR(PageIO::write_page(_wblock, compressed_body, page->footer, &pp));
+    if (_opts.cache_pages_in_memory) {
+        RETURN_IF_ERROR(PageIO::cache_written_page(_wblock, _compress_codec, compressed_body, page->footer, pp));
+    }
     _ordinal_index_builder->append_entry(page->footer.data_page_footer().first_ordinal(), pp);
     return Status::OK();
 }
 
+Status ScalarColumnWriter::_compress_page(Page* page) {
+    std::vector<Slice> body;
+    for (auto& data : page->data) {
+        body.push_back(data.slice());
+    }
+    faststring compressed_body;
+    RETURN_IF_ERROR(
+            PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body, &compressed_body));
+    if (compressed_body.size() != 0) {
+        for (auto& data : page->data) {
+            _data_size -= data.slice().size;
+        }
+        page->data.clear();
+        page->data.emplace_back(compressed_body.build());
+        _data_size += page->data[0].slice().size;
+    }
+    return Status::OK();
+}
+
+// The pages are split into the samples of 4KB, i.e. the blocks which the dictionary is most effective for.
+Status ScalarColumnWriter::_train_compression_dict() {
+    static constexpr size_t kSampleSize = 4096;
+    _sampling_compression_dict = false;
+    std::vector<Slice> samples;
+    for (Page* page = _pages.head; page != nullptr; page = page->next) {
+        for (auto& data : page->data) {
+            Slice slice = data.slice();
+            for (size_t offset = 0; offset < slice.size; offset += kSampleSize) {
+                samples.emplace_back(slice.data + offset, std::min(kSampleSize, slice.size - offset));
+            }
+        }
+    }
+    std::string dict;
+    Status st = train_zstd_dictionary(samples, config::zstd_page_dict_size, &dict);
+    if (st.ok()) {
+        st = create_zstd_dict_compression_codec(dict, &_dict_codec);
+    }
+    if (st.ok()) {
+        _compress_codec = _dict_codec.get();
+        _opts.meta->set_compression_dict(std::move(dict));
+    } else {
+        VLOG(2) << "Fail to train the compression dictionary of column " << _opts.meta->column_id() << ": "
+                << st.to_string();
+    }
+    for (Page* page = _pages.head; page != nullptr; page = page->next) {
+        RETURN_IF_ERROR(_compress_page(page));
+    }
+    return Status::OK();
+}
+
 Status ScalarColumnWriter::finish_current_page() {
     if (_zone_map_index_builder != nullptr) {
         RETURN_IF_ERROR(_zone_map_index_builder->flush());
@@ -487,6 +572,10 @@ Status ScalarColumnWriter::finish_current_page() {
         RETURN_IF_ERROR(_bloom_filter_index_builder->flush());
     }
 
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->flush());
+    }
+
     // build data page body : encoded values + [nullmap]
     std::vector<Slice> body;
     faststring* encoded_values = _page_builder->finish();
@@ -519,8 +608,10 @@ Status ScalarColumnWriter::finish_current_page() {
     data_page_footer->set_corresponding_element_ordinal(_element_ordinal);
     // trying to compress page body
     faststring compressed_body;
-    RETURN_IF_ERROR(
-            PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body, &compressed_body));
+    if (!_sampling_compression_dict) {
+        RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body,
+                                                   &compressed_body));
+    }
     if (compressed_body.size() == 0) {
         // page body is uncompressed
         page->data.emplace_back(encoded_values->build());
@@ -533,7 +624,11 @@ Status ScalarColumnWriter::finish_current_page() {
         page->data.emplace_back(compressed_body.build());
     }
 
+    _compression_dict_sample_bytes += _sampling_compression_dict ? page->footer.uncompressed_size() : 0;
     _push_back_page(page.release());
+    if (_sampling_compression_dict && _compression_dict_sample_bytes >= config::zstd_page_dict_sample_bytes) {
+        RETURN_IF_ERROR(_train_compression_dict());
+    }
 
     if (is_nullable() && _opts.adaptive_page_format) {
         size_t num_data = (_curr_page_format == 1) ? _page_builder->count() : _null_map_builder_v2->data_count();
@@ -675,10 +770,14 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
                     INDEX_ADD_NULLS(_zone_map_index_builder, run);
                     INDEX_ADD_NULLS(_bitmap_index_builder, run);
                     INDEX_ADD_NULLS(_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_ngram_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_ndv_sketch_writer, run);
                 } else {
                     INDEX_ADD_VALUES(_zone_map_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bitmap_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_ndv_sketch_writer, pdata, run);
                 }
                 pdata += get_field()->size() * run;
             }
@@ -686,6 +785,8 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
             INDEX_ADD_VALUES(_zone_map_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bitmap_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_ndv_sketch_writer, data, num_written);
         }
 
         _next_rowid += num_written;
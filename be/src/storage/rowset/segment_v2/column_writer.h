@@ -31,6 +31,7 @@
 #include "storage/rowset/segment_v2/page_pointer.h" // for PagePointer
 #include "storage/tablet_schema.h"                  // for TabletColumn
 #include "util/bitmap.h"                            // for BitmapChange
+#include "util/block_compression.h"                 // for BlockCompressionCodec
 #include "util/slice.h"                             // for OwnedSlice
 
 namespace starrocks {
@@ -62,6 +63,13 @@ struct ColumnWriterOptions {
     bool need_zone_map = false;
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
+    // whether to write the ndv sketch of the values into the meta, see NdvSketchWriter.
+    bool need_ndv_sketch = false;
+    // whether to insert the data pages and the dictionary page into the page cache as they're written, which is
+    // for the in_memory tables, see PageIO::cache_written_page().
+    bool cache_pages_in_memory = false;
+    // the gram size of the n-gram bloom filter index of the strings, 0 for no n-gram bloom filter index.
+    uint32_t ngram_bloom_filter_gram_size = 0;
     bool adaptive_page_format = false;
     // for char/varchar will speculate encoding in append
     // for others will decide encoding in init method
@@ -75,6 +83,7 @@ class NullMapBitshuffleBuilder;
 class OrdinalIndexWriter;
 class PageBuilder;
 class BloomFilterIndexWriter;
+class NdvSketchWriter;
 class ZoneMapIndexWriter;
 
 class ColumnWriter {
@@ -204,6 +213,13 @@ private:
 
     Status _write_data_page(Page* page);
 
+    // Compress the body of |page| by |_compress_codec| if it saves enough space.
+    Status _compress_page(Page* page);
+
+    // Train the ZSTD dictionary from the pages so far, which are kept uncompressed, then compress them by it,
+    // or by the codec without dictionary if it fails.
+    Status _train_compression_dict();
+
     ColumnWriterOptions _opts;
     fs::WritableBlock* _wblock;
     uint32_t _curr_page_format;
@@ -216,6 +232,12 @@ private:
     ordinal_t _next_rowid = 0;
 
     const BlockCompressionCodec* _compress_codec = nullptr;
+    // the codec of the ZSTD dictionary trained, see config::zstd_page_dict_size
+    std::unique_ptr<BlockCompressionCodec> _dict_codec;
+    // whether the pages are kept uncompressed as the samples of the dictionary to train
+    bool _sampling_compression_dict = false;
+    // the bytes of the pages kept uncompressed
+    size_t _compression_dict_sample_bytes = 0;
     const EncodingInfo* _encoding_info = nullptr;
 
     std::unique_ptr<PageBuilder> _page_builder;
@@ -230,7 +252,10 @@ private:
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
+    std::unique_ptr<BloomFilterIndexWriter> _ngram_bloom_filter_index_builder;
+    std::unique_ptr<NdvSketchWriter> _ndv_sketch_writer;
     // _zone_map_index_builder != NULL || _bitmap_index_builder != NULL || _bloom_filter_index_builder != NULL
+    // || _ngram_bloom_filter_index_builder != NULL || _ndv_sketch_writer != NULL
     bool _has_index_builder = false;
     int64_t _element_ordinal = 0;
     int64_t _previous_ordinal = 0;
@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/ndv_sketch_writer.h"
+
+#include "storage/field.h"
+#include "util/hash_util.hpp"
+#include "util/slice.h"
+
+namespace starrocks::segment_v2 {
+
+NdvSketchWriter::NdvSketchWriter(const Field* field)
+        : _is_slice(is_string_type(field->type())), _value_size(field->size()) {}
+
+bool NdvSketchWriter::is_supported(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_STRUCT:
+    case OLAP_FIELD_TYPE_ARRAY:
+    case OLAP_FIELD_TYPE_MAP:
+    case OLAP_FIELD_TYPE_HLL:
+    case OLAP_FIELD_TYPE_OBJECT:
+    case OLAP_FIELD_TYPE_PERCENTILE:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void NdvSketchWriter::add_values(const void* values, size_t count) {
+    if (_is_slice) {
+        const auto* slices = reinterpret_cast<const Slice*>(values);
+        for (size_t i = 0; i < count; i++) {
+            _hll.update(HashUtil::murmur_hash64A(slices[i].data, slices[i].size, HashUtil::MURMUR_SEED));
+        }
+    } else {
+        const auto* data = reinterpret_cast<const uint8_t*>(values);
+        for (size_t i = 0; i < count; i++) {
+            _hll.update(HashUtil::murmur_hash64A(data + i * _value_size, _value_size, HashUtil::MURMUR_SEED));
+        }
+    }
+}
+
+void NdvSketchWriter::finish(ColumnMetaPB* meta) const {
+    NdvSketchPB* sketch = meta->mutable_ndv_sketch();
+    std::string* hll = sketch->mutable_hll();
+    hll->resize(_hll.max_serialized_size());
+    hll->resize(_hll.serialize(reinterpret_cast<uint8_t*>(hll->data())));
+    sketch->set_num_nulls(_num_nulls);
+}
+
+} // namespace starrocks::segment_v2
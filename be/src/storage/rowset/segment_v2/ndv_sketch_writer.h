@@ -0,0 +1,43 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gen_cpp/segment_v2.pb.h"
+#include "storage/hll.h"
+#include "storage/olap_common.h"
+
+namespace starrocks {
+
+class Field;
+
+namespace segment_v2 {
+
+// The sketch of the number of the distinct values of a column of a segment, i.e. the HyperLogLog of the hashes
+// of the values and the number of the nulls, fed with the values like the index writers. It's written into the
+// ColumnMetaPB of the column, and merged into the rowset meta by the rowset writer, so the statistics collection
+// could merge the sketches of the rowsets instead of scanning the rows.
+class NdvSketchWriter {
+public:
+    explicit NdvSketchWriter(const Field* field);
+
+    // Whether the values of |type| are hashed by their bytes, so the sketches are supported.
+    static bool is_supported(FieldType type);
+
+    void add_values(const void* values, size_t count);
+
+    void add_nulls(uint32_t count) { _num_nulls += count; }
+
+    void finish(ColumnMetaPB* meta) const;
+
+private:
+    bool _is_slice;
+    size_t _value_size;
+    HyperLogLog _hll;
+    uint64_t _num_nulls = 0;
+};
+
+} // namespace segment_v2
+} // namespace starrocks
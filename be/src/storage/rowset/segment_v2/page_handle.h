@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "gutil/macros.h" // for DISALLOW_COPY_AND_ASSIGN
 #include "storage/page_cache.h"
 #include "util/slice.h"
@@ -44,8 +46,12 @@ public:
     // cache_data to a invalid cache handle.
     explicit PageHandle(PageCacheHandle cache_data) : _cache_data(std::move(cache_data)) {}
 
+    // This class will reference the memory-mapped data, which is kept valid by |mapping|.
+    PageHandle(const Slice& data, std::shared_ptr<const void> mapping) : _data(data), _mapping(std::move(mapping)) {}
+
     // Move constructor
-    PageHandle(PageHandle&& other) noexcept : _data(other._data), _cache_data(std::move(other._cache_data)) {
+    PageHandle(PageHandle&& other) noexcept
+            : _data(other._data), _cache_data(std::move(other._cache_data)), _mapping(std::move(other._mapping)) {
         // we can use std::exchange if we switch c++14 on
         std::swap(_is_data_owner, other._is_data_owner);
     }
@@ -54,6 +60,7 @@ public:
         std::swap(_is_data_owner, other._is_data_owner);
         _data = other._data;
         _cache_data = std::move(other._cache_data);
+        _mapping = std::move(other._mapping);
         return *this;
     }
 
@@ -74,13 +81,14 @@ public:
 
     // the return slice contains uncompressed page body, page footer, and footer size
     Slice data() const {
-        if (_is_data_owner) {
+        if (_is_data_owner || _mapping != nullptr) {
             return _data;
         }
         return _cache_data.data();
     }
 
-    int64_t mem_usage() const { return sizeof(PageHandle) + _data.size; }
+    // the memory-mapped data is in the OS page cache, not in the memory of the process
+    int64_t mem_usage() const { return sizeof(PageHandle) + (_mapping != nullptr ? 0 : _data.size); }
 
 private:
     // when this is true, it means this struct own data and _data is valid.
@@ -88,6 +96,8 @@ private:
     bool _is_data_owner = false;
     Slice _data;
     PageCacheHandle _cache_data;
+    // not null if _data is memory-mapped
+    std::shared_ptr<const void> _mapping;
 
     // Don't allow copy and assign
     DISALLOW_COPY_AND_ASSIGN(PageHandle);
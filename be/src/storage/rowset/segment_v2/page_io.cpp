@@ -35,6 +35,7 @@
 #include "util/crc32c.h"
 #include "util/faststring.h"
 #include "util/runtime_profile.h"
+#include "util/starrocks_metrics.h"
 
 namespace starrocks {
 namespace segment_v2 {
@@ -110,48 +111,159 @@ Status PageIO::write_page(fs::WritableBlock* wblock, const std::vector<Slice>& b
     return Status::OK();
 }
 
-Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle, Slice* body,
-                                        PageFooterPB* footer) {
-    opts.sanity_check();
-    opts.stats->total_pages_num++;
+Status PageIO::cache_written_page(fs::WritableBlock* wblock, const BlockCompressionCodec* codec,
+                                  const std::vector<Slice>& body, const PageFooterPB& footer, const PagePointer& pp) {
+    std::string footer_buf; // serialized footer + footer size
+    footer.SerializeToString(&footer_buf);
+    put_fixed32_le(&footer_buf, static_cast<uint32_t>(footer_buf.size()));
 
-    auto cache = StoragePageCache::instance();
-    PageCacheHandle cache_handle;
-    StoragePageCache::CacheKey cache_key(opts.rblock->path(), opts.page_pointer.offset);
-    if (opts.use_page_cache && cache->lookup(cache_key, &cache_handle)) {
-        // we find page in cache, use it
-        *handle = PageHandle(std::move(cache_handle));
-        opts.stats->cached_pages_num++;
-        // parse body and footer
-        Slice page_slice = handle->data();
-        uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
-        std::string footer_buf(page_slice.data + page_slice.size - 4 - footer_size, footer_size);
-        if (!footer->ParseFromString(footer_buf)) {
-            return Status::Corruption("Bad page: invalid footer");
+    size_t body_size = Slice::compute_total_size(body);
+    size_t uncompressed_size = footer.uncompressed_size();
+    size_t page_size = uncompressed_size + footer_buf.size();
+    // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work
+    std::unique_ptr<char[]> page(new char[page_size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
+    if (body_size == uncompressed_size) {
+        char* dst = page.get();
+        for (const auto& slice : body) {
+            memcpy(dst, slice.data, slice.size);
+            dst += slice.size;
+        }
+    } else {
+        if (codec == nullptr) {
+            return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
+        }
+        // The compressed body is always one slice, see compress_and_write_page().
+        faststring buf;
+        Slice compressed_body = body.empty() ? Slice() : body[0];
+        if (body.size() > 1) {
+            for (const auto& slice : body) {
+                buf.append(slice.data, slice.size);
+            }
+            compressed_body = Slice(buf);
+        }
+        Slice decompressed_body(page.get(), uncompressed_size);
+        RETURN_IF_ERROR(codec->decompress(compressed_body, &decompressed_body));
+        if (decompressed_body.size != uncompressed_size) {
+            return Status::Corruption(
+                    strings::Substitute("Bad page: record uncompressed size=$0 vs real decompressed size=$1",
+                                        uncompressed_size, decompressed_body.size));
         }
-        *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-        return Status::OK();
     }
+    memcpy(page.get() + uncompressed_size, footer_buf.data(), footer_buf.size());
 
-    // every page contains 4 bytes footer length and 4 bytes checksum
-    const uint32_t page_size = opts.page_pointer.size;
-    if (page_size < 8) {
-        return Status::Corruption(strings::Substitute("Bad page: too small size ($0)", page_size));
+    PageCacheHandle cache_handle;
+    StoragePageCache::CacheKey cache_key(wblock->path(), pp.offset);
+    StoragePageCache::instance()->insert(cache_key, Slice(page.get(), page_size), &cache_handle, true);
+    page.release(); // memory now managed by the page cache
+    return Status::OK();
+}
+
+// Parse the page found in the page cache.
+static Status parse_cached_page(PageCacheHandle cache_handle, PageHandle* handle, Slice* body, PageFooterPB* footer) {
+    *handle = PageHandle(std::move(cache_handle));
+    // parse body and footer
+    Slice page_slice = handle->data();
+    uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
+    std::string footer_buf(page_slice.data + page_slice.size - 4 - footer_size, footer_size);
+    if (!footer->ParseFromString(footer_buf)) {
+        return Status::Corruption("Bad page: invalid footer");
     }
+    *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
+    return Status::OK();
+}
 
-    // hold compressed page at first, reset to decompressed page later
+// Verify, decompress and parse the page of |page_size| bytes read into |page|, then insert it into the page cache.
+// Decompress the body of |page_slice|, which is a page without the checksum, into |decompressed_page|, which
+// holds the decompressed body, the footer and the footer size.
+static Status decompress_page(const PageReadOptions& opts, const Slice& page_slice, uint32_t footer_size,
+                              const PageFooterPB& footer, std::unique_ptr<char[]>* decompressed_page,
+                              Slice* decompressed_slice) {
+    if (opts.codec == nullptr) {
+        return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
+    }
+    SCOPED_RAW_TIMER(&opts.stats->decompress_ns);
+    uint32_t body_size = page_slice.size - 4 - footer_size;
     // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work
-    std::unique_ptr<char[]> page(new char[page_size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
-    Slice page_slice(page.get(), page_size);
-    {
-        SCOPED_RAW_TIMER(&opts.stats->io_ns);
-        RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
-        opts.stats->compressed_bytes_read += page_size;
+    decompressed_page->reset(
+            new char[footer.uncompressed_size() + footer_size + 4 + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
+
+    // decompress page body
+    Slice compressed_body(page_slice.data, body_size);
+    Slice decompressed_body(decompressed_page->get(), footer.uncompressed_size());
+    RETURN_IF_ERROR(opts.codec->decompress(compressed_body, &decompressed_body));
+    if (decompressed_body.size != footer.uncompressed_size()) {
+        return Status::Corruption(
+                strings::Substitute("Bad page: record uncompressed size=$0 vs real decompressed size=$1",
+                                    footer.uncompressed_size(), decompressed_body.size));
+    }
+    // append footer and footer size
+    memcpy(decompressed_body.data + decompressed_body.size, page_slice.data + body_size, footer_size + 4);
+    *decompressed_slice = Slice(decompressed_page->get(), footer.uncompressed_size() + footer_size + 4);
+    opts.stats->uncompressed_bytes_read += decompressed_slice->size;
+    return Status::OK();
+}
+
+// Return the decompressed page by |handle|, inserting it into the page cache if |opts.use_page_cache|.
+static void set_decompressed_page(const PageReadOptions& opts, const StoragePageCache::CacheKey& cache_key,
+                                  std::unique_ptr<char[]> page, const Slice& page_slice, PageHandle* handle) {
+    if (opts.use_page_cache) {
+        // insert this page into cache and return the cache handle
+        PageCacheHandle cache_handle;
+        StoragePageCache::instance()->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory);
+        *handle = PageHandle(std::move(cache_handle));
+    } else {
+        *handle = PageHandle(page_slice);
+    }
+    page.release(); // memory now managed by handle
+}
+
+// Decompress the page hit by the compressed tier of the page cache, its checksum isn't verified again.
+static Status parse_compressed_cached_page(const PageReadOptions& opts, const StoragePageCache::CacheKey& cache_key,
+                                           PageCacheHandle compressed_handle, PageHandle* handle, Slice* body,
+                                           PageFooterPB* footer) {
+    Slice page_slice = compressed_handle.data();
+    uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
+    if (!footer->ParseFromArray(page_slice.data + page_slice.size - 4 - footer_size, footer_size)) {
+        return Status::Corruption("Bad page: invalid footer");
+    }
+    std::unique_ptr<char[]> page;
+    Slice decompressed_slice;
+    RETURN_IF_ERROR(decompress_page(opts, page_slice, footer_size, *footer, &page, &decompressed_slice));
+    *body = Slice(decompressed_slice.data, decompressed_slice.size - 4 - footer_size);
+    set_decompressed_page(opts, cache_key, std::move(page), decompressed_slice, handle);
+    return Status::OK();
+}
+
+// Look up the page of |cache_key| in the page cache, the compressed tier is looked up after a miss of the
+// decompressed pages.
+static Status lookup_cached_page(const PageReadOptions& opts, const StoragePageCache::CacheKey& cache_key,
+                                 PageHandle* handle, Slice* body, PageFooterPB* footer, bool* found) {
+    *found = false;
+    if (!opts.use_page_cache) {
+        return Status::OK();
+    }
+    auto cache = StoragePageCache::instance();
+    PageCacheHandle cache_handle;
+    if (cache->lookup(cache_key, &cache_handle)) {
+        // we find page in cache, use it
+        *found = true;
+        opts.stats->cached_pages_num++;
+        return parse_cached_page(std::move(cache_handle), handle, body, footer);
+    }
+    if (cache->lookup_compressed(cache_key, &cache_handle)) {
+        *found = true;
+        opts.stats->compressed_cached_pages_num++;
+        return parse_compressed_cached_page(opts, cache_key, std::move(cache_handle), handle, body, footer);
     }
+    return Status::OK();
+}
 
+// Verify the checksum of |page_slice| and remove it, then parse the footer.
+static Status verify_and_parse_footer(const PageReadOptions& opts, Slice* page_slice, uint32_t* footer_size,
+                                      PageFooterPB* footer) {
     if (opts.verify_checksum) {
-        uint32_t expect = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
-        uint32_t actual = crc32c::Value(page_slice.data, page_slice.size - 4);
+        uint32_t expect = decode_fixed32_le((uint8_t*)page_slice->data + page_slice->size - 4);
+        uint32_t actual = crc32c::Value(page_slice->data, page_slice->size - 4);
         if (expect != actual) {
             return Status::Corruption(
                     strings::Substitute("Bad page: checksum mismatch (actual=$0 vs expect=$1)", actual, expect));
@@ -159,51 +271,202 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     }
 
     // remove checksum suffix
-    page_slice.size -= 4;
+    page_slice->size -= 4;
     // parse and set footer
-    uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
-    if (!footer->ParseFromArray(page_slice.data + page_slice.size - 4 - footer_size, footer_size)) {
+    *footer_size = decode_fixed32_le((uint8_t*)page_slice->data + page_slice->size - 4);
+    if (*footer_size + 4 > page_slice->size ||
+        !footer->ParseFromArray(page_slice->data + page_slice->size - 4 - *footer_size, *footer_size)) {
         return Status::Corruption("Bad page: invalid footer");
     }
+    return Status::OK();
+}
+
+// Parse the page |pp| of the memory-mapped block if it's mapped, i.e. *mapped is set. An uncompressed page
+// references the mapped memory, which is in the OS page cache already, so it isn't copied into the page cache.
+static Status read_mapped_page(const PageReadOptions& opts, const StoragePageCache::CacheKey& cache_key,
+                               const PagePointer& pp, PageHandle* handle, Slice* body, PageFooterPB* footer,
+                               bool* mapped) {
+    Slice page_slice;
+    std::shared_ptr<const void> mapping;
+    // the bytes following the page are read by append_strings_overflow, so they must be mapped too
+    *mapped = opts.rblock->read_mapped(pp.offset, pp.size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE,
+                                       &page_slice, &mapping);
+    if (!*mapped) {
+        return Status::OK();
+    }
+    page_slice.size = pp.size;
+    opts.stats->compressed_bytes_read += pp.size;
+    opts.stats->mapped_pages_num++;
+
+    uint32_t footer_size = 0;
+    RETURN_IF_ERROR(verify_and_parse_footer(opts, &page_slice, &footer_size, footer));
+    uint32_t body_size = page_slice.size - 4 - footer_size;
+    if (body_size != footer->uncompressed_size()) {
+        std::unique_ptr<char[]> decompressed_page;
+        Slice decompressed_slice;
+        RETURN_IF_ERROR(
+                decompress_page(opts, page_slice, footer_size, *footer, &decompressed_page, &decompressed_slice));
+        *body = Slice(decompressed_slice.data, decompressed_slice.size - 4 - footer_size);
+        set_decompressed_page(opts, cache_key, std::move(decompressed_page), decompressed_slice, handle);
+    } else {
+        opts.stats->uncompressed_bytes_read += body_size;
+        *body = Slice(page_slice.data, body_size);
+        *handle = PageHandle(page_slice, std::move(mapping));
+    }
+    return Status::OK();
+}
+
+static Status decode_page(const PageReadOptions& opts, const StoragePageCache::CacheKey& cache_key,
+                          std::unique_ptr<char[]> page, uint32_t page_size, PageHandle* handle, Slice* body,
+                          PageFooterPB* footer) {
+    Slice page_slice(page.get(), page_size);
+    uint32_t footer_size = 0;
+    RETURN_IF_ERROR(verify_and_parse_footer(opts, &page_slice, &footer_size, footer));
 
     uint32_t body_size = page_slice.size - 4 - footer_size;
     if (body_size != footer->uncompressed_size()) { // need decompress body
-        if (opts.codec == nullptr) {
-            return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
+        std::unique_ptr<char[]> decompressed_page;
+        Slice decompressed_slice;
+        RETURN_IF_ERROR(
+                decompress_page(opts, page_slice, footer_size, *footer, &decompressed_page, &decompressed_slice));
+        // The compressed page is moved into the compressed tier of the page cache if it compresses well,
+        // otherwise it's freed.
+        auto cache = StoragePageCache::instance();
+        if (opts.use_page_cache && cache->should_cache_compressed(body_size, footer->uncompressed_size())) {
+            PageCacheHandle compressed_handle;
+            cache->insert_compressed(cache_key, page_slice, &compressed_handle);
+            page.release(); // memory now managed by the compressed tier
         }
-        SCOPED_RAW_TIMER(&opts.stats->decompress_ns);
-        // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work
-        std::unique_ptr<char[]> decompressed_page(
-                new char[footer->uncompressed_size() + footer_size + 4 + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
-
-        // decompress page body
-        Slice compressed_body(page_slice.data, body_size);
-        Slice decompressed_body(decompressed_page.get(), footer->uncompressed_size());
-        RETURN_IF_ERROR(opts.codec->decompress(compressed_body, &decompressed_body));
-        if (decompressed_body.size != footer->uncompressed_size()) {
-            return Status::Corruption(
-                    strings::Substitute("Bad page: record uncompressed size=$0 vs real decompressed size=$1",
-                                        footer->uncompressed_size(), decompressed_body.size));
-        }
-        // append footer and footer size
-        memcpy(decompressed_body.data + decompressed_body.size, page_slice.data + body_size, footer_size + 4);
-        // free memory of compressed page
         page = std::move(decompressed_page);
-        page_slice = Slice(page.get(), footer->uncompressed_size() + footer_size + 4);
-        opts.stats->uncompressed_bytes_read += page_slice.size;
+        page_slice = decompressed_slice;
     } else {
         opts.stats->uncompressed_bytes_read += body_size;
     }
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-    if (opts.use_page_cache) {
-        // insert this page into cache and return the cache handle
-        cache->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory);
-        *handle = PageHandle(std::move(cache_handle));
-    } else {
-        *handle = PageHandle(page_slice);
+    set_decompressed_page(opts, cache_key, std::move(page), page_slice, handle);
+    return Status::OK();
+}
+
+Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle, Slice* body,
+                                        PageFooterPB* footer) {
+    opts.sanity_check();
+    opts.stats->total_pages_num++;
+
+    StoragePageCache::CacheKey cache_key(opts.rblock->path(), opts.page_pointer.offset);
+    bool found = false;
+    RETURN_IF_ERROR(lookup_cached_page(opts, cache_key, handle, body, footer, &found));
+    if (found) {
+        return Status::OK();
+    }
+
+    // every page contains 4 bytes footer length and 4 bytes checksum
+    const uint32_t page_size = opts.page_pointer.size;
+    if (page_size < 8) {
+        return Status::Corruption(strings::Substitute("Bad page: too small size ($0)", page_size));
+    }
+    bool mapped = false;
+    RETURN_IF_ERROR(read_mapped_page(opts, cache_key, opts.page_pointer, handle, body, footer, &mapped));
+    if (mapped) {
+        return Status::OK();
+    }
+
+    // hold compressed page at first, reset to decompressed page later
+    // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work
+    std::unique_ptr<char[]> page(new char[page_size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
+    int64_t io_ns = 0;
+    {
+        SCOPED_RAW_TIMER(&io_ns);
+        RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, Slice(page.get(), page_size)));
+        opts.stats->compressed_bytes_read += page_size;
+    }
+    opts.stats->io_ns += io_ns;
+    StarRocksMetrics::instance()->page_read_latency_us.add(io_ns / 1000);
+    return decode_page(opts, cache_key, std::move(page), page_size, handle, body, footer);
+}
+
+Status PageIO::read_and_decompress_pages(const PageReadOptions& opts, const PagePointer* pages, size_t n,
+                                         size_t max_gap, size_t max_io_size, PageHandle* handles, Slice* bodies,
+                                         PageFooterPB* footers) {
+    opts.sanity_check();
+    auto cache = StoragePageCache::instance();
+    const std::string& path = opts.rblock->path();
+
+    // the gaps between the coalesced pages are read into a scratch buffer and dropped.
+    std::unique_ptr<char[]> gap_buf;
+    std::vector<std::unique_ptr<char[]>> buffers;
+    std::vector<Slice> slices;
+    size_t i = 0;
+    while (i < n) {
+        opts.stats->total_pages_num++;
+        bool found = false;
+        RETURN_IF_ERROR(lookup_cached_page(opts, StoragePageCache::CacheKey(path, pages[i].offset), &handles[i],
+                                           &bodies[i], &footers[i], &found));
+        if (found) {
+            i++;
+            continue;
+        }
+        if (pages[i].size >= 8) {
+            RETURN_IF_ERROR(read_mapped_page(opts, StoragePageCache::CacheKey(path, pages[i].offset), pages[i],
+                                             &handles[i], &bodies[i], &footers[i], &found));
+            if (found) {
+                i++;
+                continue;
+            }
+        }
+
+        // coalesce the following pages not in the page cache into one IO.
+        size_t last = i;
+        uint64_t end = pages[i].offset + pages[i].size;
+        while (last + 1 < n) {
+            const PagePointer& next = pages[last + 1];
+            if (next.offset < end || next.offset - end > max_gap ||
+                next.offset + next.size - pages[i].offset > max_io_size) {
+                break;
+            }
+            PageCacheHandle cache_handle;
+            StoragePageCache::CacheKey next_key(path, next.offset);
+            if (opts.use_page_cache &&
+                (cache->lookup(next_key, &cache_handle) || cache->lookup_compressed(next_key, &cache_handle))) {
+                break;
+            }
+            opts.stats->total_pages_num++;
+            end = next.offset + next.size;
+            last++;
+        }
+
+        buffers.clear();
+        slices.clear();
+        for (size_t j = i; j <= last; j++) {
+            // every page contains 4 bytes footer length and 4 bytes checksum
+            if (pages[j].size < 8) {
+                return Status::Corruption(strings::Substitute("Bad page: too small size ($0)", pages[j].size));
+            }
+            if (j > i && pages[j].offset > pages[j - 1].offset + pages[j - 1].size) {
+                if (gap_buf == nullptr) {
+                    gap_buf.reset(new char[max_gap]);
+                }
+                slices.emplace_back(gap_buf.get(), pages[j].offset - pages[j - 1].offset - pages[j - 1].size);
+            }
+            // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work
+            buffers.emplace_back(new char[pages[j].size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
+            slices.emplace_back(buffers.back().get(), pages[j].size);
+            opts.stats->compressed_bytes_read += pages[j].size;
+        }
+        int64_t io_ns = 0;
+        {
+            SCOPED_RAW_TIMER(&io_ns);
+            RETURN_IF_ERROR(opts.rblock->readv(pages[i].offset, slices.data(), slices.size()));
+        }
+        opts.stats->io_ns += io_ns;
+        StarRocksMetrics::instance()->page_read_latency_us.add(io_ns / 1000);
+        for (size_t j = i; j <= last; j++) {
+            RETURN_IF_ERROR(decode_page(opts, StoragePageCache::CacheKey(path, pages[j].offset),
+                                        std::move(buffers[j - i]), pages[j].size, &handles[j], &bodies[j],
+                                        &footers[j]));
+        }
+        i = last + 1;
     }
-    page.release(); // memory now managed by handle
     return Status::OK();
 }
 
@@ -100,6 +100,12 @@ public:
         return write_page(wblock, {Slice(compressed_body)}, footer, result);
     }
 
+    // Insert the page written by write_page() at `pp' of `wblock' into the page cache as an in_memory page, the
+    // same as it's read by read_and_decompress_page(), i.e. `body' is decompressed by `codec' if it's compressed.
+    // It's used to write the pages of the in_memory tables through the page cache.
+    static Status cache_written_page(fs::WritableBlock* wblock, const BlockCompressionCodec* codec,
+                                     const std::vector<Slice>& body, const PageFooterPB& footer, const PagePointer& pp);
+
     // Read and parse a page according to `opts'.
     // On success
     //     `handle' holds the memory of page data,
@@ -107,6 +113,14 @@ public:
     //     `footer' stores the page footer.
     static Status read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle, Slice* body,
                                            PageFooterPB* footer);
+
+    // Read and parse the `n' pages of `pages' in the ascending order of the offset, `opts.page_pointer' is
+    // ignored. The pages not in the page cache are read together by one IO if the gap between them is no
+    // more than `max_gap' bytes and the IO is no larger than `max_io_size' bytes, the gap is dropped.
+    // On success, `handles', `bodies' and `footers' hold the `n' pages like read_and_decompress_page().
+    static Status read_and_decompress_pages(const PageReadOptions& opts, const PagePointer* pages, size_t n,
+                                            size_t max_gap, size_t max_io_size, PageHandle* handles, Slice* bodies,
+                                            PageFooterPB* footers);
 };
 
 } // namespace segment_v2
@@ -320,8 +320,8 @@ Status parse_page_v2(std::unique_ptr<ParsedPage>* result, PageHandle handle, con
     page->_page_index = page_index;
     page->_corresponding_element_ordinal = footer.corresponding_element_ordinal();
 
-    if (encoding->encoding() == EncodingTypePB::BIT_SHUFFLE) {
-        // When using BIT_SHUFFLE encoding, the original data is not used after decoded.
+    if (encoding->encoding() == EncodingTypePB::BIT_SHUFFLE || encoding->encoding() == EncodingTypePB::ALP_ENCODING) {
+        // When using BIT_SHUFFLE or ALP encoding, the original data is not used after decoded.
         // So the memory can be released to reduce the memory usage.
         page->_page_handle.release_memory();
     }
@@ -218,14 +218,14 @@ public:
             *n = 0;
             return Status::OK();
         }
-        CppType value{};
         *n = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
-        for (size_t i = 0; i < *n; i++) {
-            if (PREDICT_FALSE(!_rle_decoder.Get(&value))) {
-                return Status::Corruption("RLE decode failed");
-            }
-            [[maybe_unused]] int r = dst->append_numbers(&value, sizeof(value));
-            DCHECK_EQ(1, r);
+        // The runs are decoded into the column directly.
+        const size_t ori_size = dst->size();
+        dst->resize(ori_size + *n);
+        auto* p = reinterpret_cast<CppType*>(dst->mutable_raw_data()) + ori_size;
+        if (PREDICT_FALSE(_rle_decoder.GetBatch(p, *n) != *n)) {
+            dst->resize(ori_size);
+            return Status::Corruption("RLE decode failed");
         }
         _cur_index += *n;
         return Status::OK();
@@ -30,6 +30,7 @@
 #include "storage/rowset/segment_v2/column_reader.h"
 #include "storage/rowset/segment_v2/empty_segment_iterator.h"
 #include "storage/rowset/segment_v2/page_io.h"
+#include "storage/rowset/segment_v2/segment_footer_cache.h"
 #include "storage/rowset/segment_v2/segment_iterator.h"
 #include "storage/rowset/segment_v2/segment_writer.h" // k_segment_magic_length
 #include "storage/rowset/vectorized/segment_chunk_iterator_adapter.h"
@@ -157,6 +158,15 @@ StatusOr<ChunkIteratorPtr> Segment::new_iterator(const vectorized::Schema& schem
 }
 
 Status Segment::_parse_footer() {
+    auto* footer_cache = SegmentFooterCache::instance();
+    if (footer_cache != nullptr) {
+        _footer = footer_cache->lookup(_fname);
+        if (_footer != nullptr) {
+            _mem_tracker->consume(_footer->SpaceUsedLong());
+            return Status::OK();
+        }
+    }
+
     // Footer := SegmentFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
     std::unique_ptr<fs::ReadableBlock> rblock;
     RETURN_IF_ERROR(_block_mgr->open_block(_fname, &rblock));
@@ -196,12 +206,16 @@ Status Segment::_parse_footer() {
     }
 
     // deserialize footer PB
-    if (!_footer.ParseFromString(footer_buf)) {
+    auto footer = std::make_shared<SegmentFooterPB>();
+    if (!footer->ParseFromString(footer_buf)) {
         return Status::Corruption(strings::Substitute("Bad segment file $0: failed to parse SegmentFooterPB", _fname));
     }
+    _footer = std::move(footer);
     // The memory usage obtained through SpaceUsedLong() is an estimate
-    _mem_tracker->consume(static_cast<int64_t>(_footer.SpaceUsedLong()) -
-                          static_cast<int64_t>(sizeof(SegmentFooterPB)));
+    _mem_tracker->consume(_footer->SpaceUsedLong());
+    if (footer_cache != nullptr) {
+        footer_cache->insert(_fname, _footer);
+    }
     return Status::OK();
 }
 
@@ -214,7 +228,7 @@ Status Segment::_load_index() {
         PageReadOptions opts;
         opts.use_page_cache = !config::disable_storage_page_cache;
         opts.rblock = rblock.get();
-        opts.page_pointer = PagePointer(_footer.short_key_index_page());
+        opts.page_pointer = PagePointer(_footer->short_key_index_page());
         opts.codec = nullptr; // short key index page uses NO_COMPRESSION for now
         OlapReaderStatistics tmp_stats;
         opts.stats = &tmp_stats;
@@ -237,8 +251,8 @@ Status Segment::_load_index() {
 
 Status Segment::_create_column_readers() {
     std::unordered_map<uint32_t, uint32_t> column_id_to_footer_ordinal;
-    for (uint32_t ordinal = 0; ordinal < _footer.columns().size(); ++ordinal) {
-        const auto& column_pb = _footer.columns(ordinal);
+    for (uint32_t ordinal = 0; ordinal < _footer->columns().size(); ++ordinal) {
+        const auto& column_pb = _footer->columns(ordinal);
         column_id_to_footer_ordinal.emplace(column_pb.unique_id(), ordinal);
     }
 
@@ -252,10 +266,10 @@ Status Segment::_create_column_readers() {
 
         ColumnReaderOptions opts;
         opts.block_mgr = _block_mgr;
-        opts.storage_format_version = _footer.version();
+        opts.storage_format_version = _footer->version();
         opts.kept_in_memory = _tablet_schema->is_in_memory();
         std::unique_ptr<ColumnReader> reader;
-        RETURN_IF_ERROR(ColumnReader::create(_mem_tracker, opts, _footer.columns(iter->second), _footer.num_rows(),
+        RETURN_IF_ERROR(ColumnReader::create(_mem_tracker, opts, _footer->columns(iter->second), _footer->num_rows(),
                                              _fname, &reader));
         _column_readers[ordinal] = std::move(reader);
     }
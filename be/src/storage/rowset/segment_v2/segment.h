@@ -49,6 +49,7 @@ class BlockManager;
 
 namespace vectorized {
 class ChunkIterator;
+class MetaAggregates;
 class Schema;
 class SegmentIterator;
 class SegmentReadOptions;
@@ -89,7 +90,7 @@ public:
 
     uint64_t id() const { return _segment_id; }
 
-    uint32_t num_rows() const { return _footer.num_rows(); }
+    uint32_t num_rows() const { return _footer->num_rows(); }
 
     Status new_column_iterator(uint32_t cid, ColumnIterator** iter);
 
@@ -122,7 +123,7 @@ public:
     }
 
     // only used by UT
-    const SegmentFooterPB& footer() const { return _footer; }
+    const SegmentFooterPB& footer() const { return *_footer; }
 
     const std::string& file_name() const { return _fname; }
 
@@ -148,6 +149,7 @@ private:
 
     friend class SegmentIterator;
     friend class vectorized::SegmentIterator;
+    friend class vectorized::MetaAggregates;
 
     MemTracker* _mem_tracker = nullptr;
 
@@ -156,7 +158,8 @@ private:
     uint32_t _segment_id;
     const TabletSchema* _tablet_schema;
 
-    SegmentFooterPB _footer;
+    // Shared with SegmentFooterCache, the column readers keep pointers into it.
+    std::shared_ptr<SegmentFooterPB> _footer;
 
     // ColumnReader for each column in TabletSchema. If ColumnReader is nullptr,
     // This means that this segment has no data for that column, which may be added
@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/segment_footer_cache.h"
+
+#include "common/config.h"
+
+namespace starrocks::segment_v2 {
+
+SegmentFooterCache* SegmentFooterCache::_s_instance = nullptr;
+
+void SegmentFooterCache::create_global_cache(size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new SegmentFooterCache(capacity);
+    }
+}
+
+void SegmentFooterCache::release_global_cache() {
+    delete _s_instance;
+    _s_instance = nullptr;
+}
+
+SegmentFooterCache::SegmentFooterCache(size_t capacity)
+        : _cache(new_lru_cache(capacity, cache_policy_from_string(config::storage_cache_eviction_policy))) {}
+
+std::shared_ptr<SegmentFooterPB> SegmentFooterCache::lookup(const std::string& fname) {
+    auto* handle = _cache->lookup(CacheKey(fname));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    auto footer = *static_cast<std::shared_ptr<SegmentFooterPB>*>(_cache->value(handle));
+    _cache->release(handle);
+    return footer;
+}
+
+void SegmentFooterCache::insert(const std::string& fname, std::shared_ptr<SegmentFooterPB> footer) {
+    auto deleter = [](const CacheKey& key, void* value) {
+        delete static_cast<std::shared_ptr<SegmentFooterPB>*>(value);
+    };
+    // The memory usage obtained through SpaceUsedLong() is an estimate
+    size_t charge = footer->SpaceUsedLong();
+    auto* value = new std::shared_ptr<SegmentFooterPB>(std::move(footer));
+    auto* handle = _cache->insert(CacheKey(fname), value, charge, deleter);
+    _cache->release(handle);
+}
+
+void SegmentFooterCache::erase(const std::string& fname) {
+    _cache->erase(CacheKey(fname));
+}
+
+} // namespace starrocks::segment_v2
@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/macros.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks::segment_v2 {
+
+// A global cache of the parsed SegmentFooterPB, keyed by the segment file name which contains the rowset id
+// and the segment id. The segment files are immutable, so an entry never gets stale, it's erased when the
+// files of the rowset are removed.
+//
+// Reopening a segment after its rowset is closed, e.g. the rowsets evicted by the memory pressure and loaded
+// again by the next query, takes the footer from this cache instead of reading and parsing it again. The
+// column readers keep pointers into the footer, which is shared by the Segment and the cache entry.
+class SegmentFooterCache {
+public:
+    // Create the global instance, no instance is created if |capacity| is 0.
+    static void create_global_cache(size_t capacity);
+
+    static void release_global_cache();
+
+    // Return the global instance, or nullptr if the cache is disabled.
+    static SegmentFooterCache* instance() { return _s_instance; }
+
+    explicit SegmentFooterCache(size_t capacity);
+
+    // Return the cached footer of |fname|, or nullptr if it isn't cached.
+    std::shared_ptr<SegmentFooterPB> lookup(const std::string& fname);
+
+    // Cache |footer| of |fname|, charged by its estimated memory usage.
+    void insert(const std::string& fname, std::shared_ptr<SegmentFooterPB> footer);
+
+    void erase(const std::string& fname);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SegmentFooterCache);
+
+    static SegmentFooterCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks::segment_v2
@@ -21,23 +21,27 @@
 
 #include "storage/rowset/segment_v2/segment_writer.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/chunk.h"
 #include "column/datum_tuple.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "storage/fs/block_manager.h"
 #include "storage/row.h"                             // ContiguousRow
 #include "storage/row_cursor.h"                      // RowCursor
 #include "storage/rowset/segment_v2/column_writer.h" // ColumnWriter
+#include "storage/rowset/segment_v2/ndv_sketch_writer.h"
 #include "storage/rowset/segment_v2/page_io.h"
 #include "storage/schema.h"
 #include "storage/short_key_index.h"
 #include "storage/vectorized/seek_tuple.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
+#include "util/threadpool.h"
 
 namespace starrocks::segment_v2 {
 
@@ -55,6 +59,14 @@ SegmentWriter::~SegmentWriter() {
     _mem_tracker->release(_mem_tracker->consumption());
 }
 
+uint32_t SegmentWriter::_max_column_id(const ColumnMetaPB& meta) {
+    uint32_t id = meta.column_id();
+    for (const auto& child : meta.children_columns()) {
+        id = std::max(id, _max_column_id(child));
+    }
+    return id;
+}
+
 void SegmentWriter::_init_column_meta(ColumnMetaPB* meta, uint32_t* column_id, const TabletColumn& column) {
     // TODO(zc): Do we need this column_id??
     meta->set_column_id((*column_id)++);
@@ -72,13 +84,27 @@ void SegmentWriter::_init_column_meta(ColumnMetaPB* meta, uint32_t* column_id, c
 }
 
 Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))) {
-    uint32_t column_id = 0;
+    std::vector<uint32_t> all_columns(_tablet_schema->num_columns());
+    for (uint32_t i = 0; i < all_columns.size(); ++i) {
+        all_columns[i] = i;
+    }
+    return init(all_columns, true);
+}
+
+Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has_key) {
     if (_opts.storage_format_version != 1 && _opts.storage_format_version != 2) {
         auto v = _opts.storage_format_version;
         return Status::InvalidArgument(strings::Substitute("Invalid storage_format_version $0", v));
     }
-    _column_writers.reserve(_tablet_schema->columns().size());
-    for (const auto& column : _tablet_schema->columns()) {
+    DCHECK(_column_writers.empty());
+    // The column ids in the footer are the ordinals of all the columns and their sub columns.
+    uint32_t column_id = 0;
+    for (const auto& meta : _footer.columns()) {
+        column_id = std::max(column_id, _max_column_id(meta) + 1);
+    }
+    _column_writers.reserve(column_indexes.size());
+    for (uint32_t column_index : column_indexes) {
+        const TabletColumn& column = _tablet_schema->column(column_index);
         ColumnWriterOptions opts;
         opts.page_format = (_opts.storage_format_version == 1) ? 1 : 2;
         opts.adaptive_page_format = (_opts.storage_format_version > 1);
@@ -95,7 +121,13 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
             opts.need_zone_map = false;
         }
         opts.need_bloom_filter = column.is_bf_column();
+        if (opts.need_bloom_filter && (column.type() == FieldType::OLAP_FIELD_TYPE_CHAR ||
+                                       column.type() == FieldType::OLAP_FIELD_TYPE_VARCHAR)) {
+            opts.ngram_bloom_filter_gram_size = std::max(config::ngram_bloom_filter_index_gram_size, 0);
+        }
         opts.need_bitmap_index = column.has_bitmap_index();
+        opts.need_ndv_sketch = config::enable_column_ndv_sketch && NdvSketchWriter::is_supported(column.type());
+        opts.cache_pages_in_memory = _opts.cache_pages_in_memory;
         if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
             if (opts.need_bloom_filter) {
                 return Status::NotSupported("Do not support bloom filter for array type");
@@ -110,7 +142,38 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
     }
-    _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    if (has_key) {
+        _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    }
+    _row_count = 0;
+    if (_opts.encode_thread_pool != nullptr && _column_writers.size() > 1) {
+        _encode_token = _opts.encode_thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    }
+    return Status::OK();
+}
+
+Status SegmentWriter::_for_each_column(const std::function<Status(size_t)>& func) {
+    const size_t num_columns = _column_writers.size();
+    if (_encode_token == nullptr) {
+        for (size_t i = 0; i < num_columns; ++i) {
+            RETURN_IF_ERROR(func(i));
+        }
+        return Status::OK();
+    }
+    // The last column is done by the current thread, which waits for the others anyway.
+    std::vector<Status> statuses(num_columns);
+    for (size_t i = 0; i + 1 < num_columns; ++i) {
+        Status st = _encode_token->submit_func([&func, &statuses, i]() { statuses[i] = func(i); });
+        if (!st.ok()) {
+            // e.g. the pool is shutting down, do it serially.
+            statuses[i] = func(i);
+        }
+    }
+    statuses[num_columns - 1] = func(num_columns - 1);
+    _encode_token->wait();
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
     return Status::OK();
 }
 
@@ -145,20 +208,48 @@ uint64_t SegmentWriter::estimate_segment_size() {
     for (auto& column_writer : _column_writers) {
         size += column_writer->estimate_buffer_size();
     }
-    size += _index_builder->size();
+    if (_index_builder != nullptr) {
+        size += _index_builder->size();
+    }
     return size;
 }
 
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
-    for (auto& column_writer : _column_writers) {
-        RETURN_IF_ERROR(column_writer->finish());
+    uint64_t column_index_size = 0;
+    RETURN_IF_ERROR(finalize_columns(&column_index_size));
+    RETURN_IF_ERROR(finalize_footer(segment_file_size, index_size));
+    *index_size += column_index_size;
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_columns(uint64_t* index_size) {
+    if (!_has_finalized_columns) {
+        _num_rows = _row_count;
+        _has_finalized_columns = true;
+    } else if (_row_count != _num_rows) {
+        return Status::InternalError(strings::Substitute("the group of the columns has $0 rows, but the segment has $1",
+                                                         _row_count, _num_rows));
     }
+    // Finishing the columns encodes and compresses their last pages.
+    RETURN_IF_ERROR(_for_each_column([this](size_t i) { return _column_writers[i]->finish(); }));
     RETURN_IF_ERROR(_write_data());
     uint64_t index_offset = _wblock->bytes_appended();
     RETURN_IF_ERROR(_write_ordinal_index());
     RETURN_IF_ERROR(_write_zone_map());
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
+    *index_size = _wblock->bytes_appended() - index_offset;
+    _encode_token.reset();
+    _column_writers.clear();
+    _mem_tracker->consume(static_cast<int64_t>(estimate_segment_size()) - _mem_tracker->consumption());
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_footer(uint64_t* segment_file_size, uint64_t* index_size) {
+    if (_index_builder == nullptr) {
+        return Status::InternalError("no short key index is built by the key columns");
+    }
+    uint64_t index_offset = _wblock->bytes_appended();
     RETURN_IF_ERROR(_write_short_key_index());
     *index_size = _wblock->bytes_appended() - index_offset;
     RETURN_IF_ERROR(_write_footer());
@@ -207,7 +298,7 @@ Status SegmentWriter::_write_bloom_filter_index() {
 Status SegmentWriter::_write_short_key_index() {
     std::vector<Slice> body;
     PageFooterPB footer;
-    RETURN_IF_ERROR(_index_builder->finalize(_row_count, &body, &footer));
+    RETURN_IF_ERROR(_index_builder->finalize(_num_rows, &body, &footer));
     PagePointer pp;
     // short key index page is not compressed right now
     RETURN_IF_ERROR(PageIO::write_page(_wblock.get(), body, footer, &pp));
@@ -217,7 +308,7 @@ Status SegmentWriter::_write_short_key_index() {
 
 Status SegmentWriter::_write_footer() {
     _footer.set_version(_opts.storage_format_version);
-    _footer.set_num_rows(_row_count);
+    _footer.set_num_rows(_num_rows);
 
     // Footer := SegmentFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
     std::string footer_buf;
@@ -246,14 +337,12 @@ Status SegmentWriter::_write_raw_data(const std::vector<Slice>& slices) {
 
 Status SegmentWriter::append_chunk(const vectorized::Chunk& chunk) {
     DCHECK_EQ(_column_writers.size(), chunk.num_columns());
-    for (size_t i = 0; i < _column_writers.size(); ++i) {
-        const vectorized::Column* col = chunk.get_column_by_index(i).get();
-        RETURN_IF_ERROR(_column_writers[i]->append(*col));
-    }
+    RETURN_IF_ERROR(_for_each_column(
+            [this, &chunk](size_t i) { return _column_writers[i]->append(*chunk.get_column_by_index(i)); }));
 
     for (size_t i = 0; i < chunk.num_rows(); i++) {
         // At the begin of one block, so add a short key index entry
-        if ((_row_count % _opts.num_rows_per_block) == 0) {
+        if (_index_builder != nullptr && (_row_count % _opts.num_rows_per_block) == 0) {
             size_t keys = _tablet_schema->num_short_key_columns();
             vectorized::SeekTuple tuple(*chunk.schema(), chunk.get(i).datums());
             std::string encoded_key = tuple.short_key_encode(keys, 0);
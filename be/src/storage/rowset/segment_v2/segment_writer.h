@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory> // unique_ptr
 #include <string>
 #include <vector>
@@ -38,6 +39,8 @@ class TabletSchema;
 class TabletColumn;
 class ShortKeyIndexBuilder;
 class MemTracker;
+class ThreadPool;
+class ThreadPoolToken;
 
 namespace fs {
 class WritableBlock;
@@ -58,6 +61,12 @@ struct SegmentWriterOptions {
     uint32_t storage_format_version = 1;
     uint32_t num_rows_per_block = 1024;
     MemTracker* mem_tracker = nullptr;
+    // If set, the pages of the columns are encoded and compressed by it in parallel. The pages are still
+    // written to the file column by column, so the file is the same as the one written serially.
+    ThreadPool* encode_thread_pool = nullptr;
+    // Whether to insert the data pages into the page cache as they're written, which is only set for the in_memory
+    // tables and the segment file written at its final path, i.e. the path of the pages read from it.
+    bool cache_pages_in_memory = false;
 };
 
 class SegmentWriter {
@@ -71,6 +80,13 @@ public:
 
     Status init(uint32_t write_mbytes_per_sec);
 
+    // Init the writers of the columns |column_indexes| of the tablet schema only, the short key index is built by
+    // the chunks of them if |has_key|. It's used by the vertical compaction, which writes a segment by the groups
+    // of its columns: the key columns are written first, and then each group of the value columns is written by
+    // `init`, `append_chunk` and `finalize_columns`, until `finalize_footer` is called. The groups must be in the
+    // order of the columns, and have the same number of rows.
+    Status init(const std::vector<uint32_t>& column_indexes, bool has_key);
+
     template <typename RowType>
     Status append_row(const RowType& row);
 
@@ -78,12 +94,25 @@ public:
 
     uint64_t estimate_segment_size();
 
+    // The rows written to the current group of the columns.
     uint32_t num_rows_written() const { return _row_count; }
 
+    // The rows of the segment, which are the rows of the first group of the columns.
+    uint32_t num_rows() const { return _num_rows; }
+
     Status finalize(uint64_t* segment_file_size, uint64_t* index_size);
 
+    // Write the data and the indexes of the current group of the columns, and release their writers.
+    Status finalize_columns(uint64_t* index_size);
+
+    // Write the short key index and the footer after all the groups of the columns are finalized.
+    Status finalize_footer(uint64_t* segment_file_size, uint64_t* index_size);
+
     uint32_t segment_id() const { return _segment_id; }
 
+    // The footer written by finalize_footer(), with the segment-level zone maps of the columns.
+    const SegmentFooterPB& footer() const { return _footer; }
+
 private:
     Status _write_data();
     Status _write_ordinal_index();
@@ -94,6 +123,10 @@ private:
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
     void _init_column_meta(ColumnMetaPB* meta, uint32_t* column_id, const TabletColumn& column);
+    static uint32_t _max_column_id(const ColumnMetaPB& meta);
+    // Invoke |func| with the index of each column writer, in parallel if |_encode_token| is set.
+    // Returns the first error in the order of the columns.
+    Status _for_each_column(const std::function<Status(size_t)>& func);
 
     std::unique_ptr<MemTracker> _mem_tracker = nullptr;
     uint32_t _segment_id;
@@ -105,7 +138,11 @@ private:
     SegmentFooterPB _footer;
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
+    std::unique_ptr<ThreadPoolToken> _encode_token;
     uint32_t _row_count = 0;
+    uint32_t _num_rows = 0;
+    // Whether a group of the columns has been finalized, then |_num_rows| is set.
+    bool _has_finalized_columns = false;
 };
 
 } // namespace segment_v2
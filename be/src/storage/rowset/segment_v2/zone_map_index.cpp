@@ -23,6 +23,7 @@
 
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
+#include "simd/simd.h"
 #include "storage/column_block.h"
 #include "storage/fs/block_manager.h"
 #include "storage/olap_define.h"
@@ -115,12 +116,24 @@ void ZoneMapIndexWriterImpl<type>::add_values(const void* values, size_t count)
     if (count > 0) {
         _page_zone_map.has_not_null = true;
         const CppType* vals = reinterpret_cast<const CppType*>(values);
-        auto [pmin, pmax] = std::minmax_element(vals, vals + count);
-        if (unaligned_load<CppType>(pmin) < unaligned_load<CppType>(_page_zone_map.min_value)) {
-            _field->type_info()->direct_copy(_page_zone_map.min_value, pmin, nullptr);
-        }
-        if (unaligned_load<CppType>(pmax) > unaligned_load<CppType>(_page_zone_map.max_value)) {
-            _field->type_info()->direct_copy(_page_zone_map.max_value, pmax, nullptr);
+        if constexpr (std::is_same_v<CppType, int32_t> || std::is_same_v<CppType, int64_t>) {
+            CppType min;
+            CppType max;
+            SIMD::min_max(vals, count, &min, &max);
+            if (min < unaligned_load<CppType>(_page_zone_map.min_value)) {
+                _field->type_info()->direct_copy(_page_zone_map.min_value, &min, nullptr);
+            }
+            if (max > unaligned_load<CppType>(_page_zone_map.max_value)) {
+                _field->type_info()->direct_copy(_page_zone_map.max_value, &max, nullptr);
+            }
+        } else {
+            auto [pmin, pmax] = std::minmax_element(vals, vals + count);
+            if (unaligned_load<CppType>(pmin) < unaligned_load<CppType>(_page_zone_map.min_value)) {
+                _field->type_info()->direct_copy(_page_zone_map.min_value, pmin, nullptr);
+            }
+            if (unaligned_load<CppType>(pmax) > unaligned_load<CppType>(_page_zone_map.max_value)) {
+                _field->type_info()->direct_copy(_page_zone_map.max_value, pmax, nullptr);
+            }
         }
     }
 }
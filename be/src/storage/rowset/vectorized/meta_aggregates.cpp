@@ -0,0 +1,133 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/vectorized/meta_aggregates.h"
+
+#include "storage/del_vector.h"
+#include "storage/rowset/segment_v2/column_reader.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/vectorized/segment_options.h"
+#include "storage/storage_engine.h"
+#include "storage/types.h"
+#include "storage/update_manager.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+MetaAggregates::MetaAggregates(const Schema& schema) {
+    for (const FieldPtr& f : schema.fields()) {
+        _schema.append(f->with_nullable(true));
+    }
+    _min_max_rows = ChunkHelper::new_chunk(_schema, 0);
+}
+
+// Whether all the values in the zone map [min, max] satisfy |pred|.
+static bool zone_map_covered(const ColumnPredicate* pred, const Datum& min, const Datum& max, bool has_null,
+                             bool has_not_null) {
+    switch (pred->type()) {
+    case PredicateType::kIsNull:
+        return !has_not_null;
+    case PredicateType::kNotNull:
+        return !has_null;
+    default:
+        break;
+    }
+    // the nulls satisfy none of the comparisons.
+    if (has_null || !has_not_null) {
+        return false;
+    }
+    const TypeInfo* type_info = pred->type_info();
+    Datum value = pred->value();
+    switch (pred->type()) {
+    case PredicateType::kEQ:
+        return type_info->cmp(min, value) == 0 && type_info->cmp(max, value) == 0;
+    case PredicateType::kGT:
+        return type_info->cmp(min, value) > 0;
+    case PredicateType::kGE:
+        return type_info->cmp(min, value) >= 0;
+    case PredicateType::kLT:
+        // kLE has the same value as kLT, the strict comparison is right for both of them.
+        return type_info->cmp(max, value) < 0;
+    default:
+        return false;
+    }
+}
+
+bool MetaAggregates::_all_rows_selected(segment_v2::Segment* segment, const SegmentReadOptions& opts) const {
+    for (const auto& [cid, preds] : opts.predicates) {
+        const segment_v2::ColumnReader* reader = segment->_column_readers[cid].get();
+        // The CHAR values in the zone maps are padded with zeros, unlike the ones of the predicates.
+        if (reader == nullptr || reader->column_type() == OLAP_FIELD_TYPE_CHAR) {
+            return false;
+        }
+        Datum min;
+        Datum max;
+        bool has_null = false;
+        bool has_not_null = false;
+        if (!reader->segment_zone_map(&min, &max, &has_null, &has_not_null).ok()) {
+            return false;
+        }
+        for (const ColumnPredicate* pred : preds) {
+            if (!zone_map_covered(pred, min, max, has_null, has_not_null)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Status MetaAggregates::add_segment(segment_v2::Segment* segment, const SegmentReadOptions& opts, bool* answered) {
+    *answered = false;
+    if (segment->_needs_chunk_adapter || !opts.ranges.empty() || opts.rowid_range != nullptr ||
+        !opts.delete_predicates.empty() || !opts.runtime_predicates.empty() || !_all_rows_selected(segment, opts)) {
+        return Status::OK();
+    }
+
+    const size_t num_columns = _schema.num_fields();
+    std::vector<Datum> mins(num_columns);
+    std::vector<Datum> maxes(num_columns);
+    for (size_t i = 0; i < num_columns; i++) {
+        const FieldPtr& field = _schema.field(i);
+        const segment_v2::ColumnReader* reader = segment->_column_readers[field->id()].get();
+        if (reader == nullptr || reader->column_type() != field->type()->type() ||
+            reader->column_type() == OLAP_FIELD_TYPE_CHAR) {
+            return Status::OK();
+        }
+        bool has_null = false;
+        bool has_not_null = false;
+        if (!reader->segment_zone_map(&mins[i], &maxes[i], &has_null, &has_not_null).ok()) {
+            return Status::OK();
+        }
+    }
+
+    int64_t num_deleted = 0;
+    if (opts.is_primary_keys && opts.version > 0) {
+        TabletSegmentId tsid;
+        tsid.tablet_id = opts.tablet_id;
+        tsid.segment_id = opts.rowset_id + segment->id();
+        DelVectorPtr del_vec;
+        RETURN_IF_ERROR(
+                StorageEngine::instance()->update_manager()->get_del_vec(opts.meta, tsid, opts.version, &del_vec));
+        if (del_vec != nullptr) {
+            num_deleted = del_vec->cardinality();
+        }
+    } else if (opts.del_vec != nullptr) {
+        num_deleted = opts.del_vec->cardinality();
+    }
+    // The zone maps cover the deleted rows too.
+    if (num_deleted > 0 && num_columns > 0) {
+        return Status::OK();
+    }
+
+    for (size_t i = 0; i < num_columns; i++) {
+        Column* column = _min_max_rows->get_column_by_index(i).get();
+        column->append_datum(mins[i]);
+        column->append_datum(maxes[i]);
+    }
+    _count += segment->num_rows() - num_deleted;
+    _num_segments++;
+    *answered = true;
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+
+#include "column/chunk.h"
+#include "column/schema.h"
+#include "common/status.h"
+
+namespace starrocks::segment_v2 {
+class Segment;
+}
+
+namespace starrocks::vectorized {
+
+class SegmentReadOptions;
+
+// The COUNT(*) and the MIN/MAX of some columns over the segments answered by their metadata instead of
+// reading their rows, see SegmentReadOptions::meta_aggregates.
+//
+// A segment is answered only if all of its rows are known to be selected, i.e. it's read without the key
+// ranges, the row id range, the delete predicates or the runtime predicates, and its segment zone maps
+// prove that the predicates are satisfied by all the values. Then its COUNT(*) is the number of the rows
+// not deleted by the delete vector, and its MIN/MAX are the min/max of its segment zone maps, which are only
+// used if no row is deleted.
+class MetaAggregates {
+public:
+    // |schema| has the columns of MIN and MAX, it may be empty if only COUNT(*) is computed.
+    explicit MetaAggregates(const Schema& schema);
+
+    // Try to answer |segment| read by |opts|, |*answered| is set to false if its rows must be read.
+    Status add_segment(segment_v2::Segment* segment, const SegmentReadOptions& opts, bool* answered);
+
+    int64_t count() const { return _count; }
+
+    // The min and the max of the columns of the answered segments are appended as two rows for each segment,
+    // so the MIN/MAX over these rows are the MIN/MAX over the segments. A column has a null if all of its
+    // values in a segment are null.
+    const ChunkPtr& min_max_rows() const { return _min_max_rows; }
+
+    int64_t num_segments() const { return _num_segments; }
+
+private:
+    // Whether all the rows of |segment| satisfy the predicates of |opts|.
+    bool _all_rows_selected(segment_v2::Segment* segment, const SegmentReadOptions& opts) const;
+
+    Schema _schema;
+    ChunkPtr _min_max_rows;
+    int64_t _count = 0;
+    int64_t _num_segments = 0;
+};
+
+} // namespace starrocks::vectorized
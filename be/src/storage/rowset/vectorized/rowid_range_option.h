@@ -0,0 +1,24 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+
+#include "storage/vectorized/range.h"
+
+namespace starrocks::vectorized {
+
+// RowidRangeOption selects one segment of a rowset and the row range of it to read, the other segments
+// of the rowset are skipped. It is used to split the scan of a tablet into several parts.
+struct RowidRangeOption {
+    RowidRangeOption(uint32_t segment_id, SparseRange rowid_range)
+            : segment_id(segment_id), rowid_range(std::move(rowid_range)) {}
+
+    uint32_t segment_id;
+    // It is intersected with the rows of the segment, so the end of it can exceed the number of rows.
+    SparseRange rowid_range;
+};
+
+using RowidRangeOptionPtr = std::shared_ptr<RowidRangeOption>;
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/vectorized/rowset_ndv_sketch.h"
+
+#include <algorithm>
+#include <string>
+
+#include "gen_cpp/segment_v2.pb.h"
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+static std::string serialize_hll(const HyperLogLog& hll) {
+    std::string buf;
+    buf.resize(hll.max_serialized_size());
+    buf.resize(hll.serialize(reinterpret_cast<uint8_t*>(buf.data())));
+    return buf;
+}
+
+Status RowsetNdvSketchBuilder::add_segment(const segment_v2::SegmentFooterPB& footer) {
+    _num_segments++;
+    for (const auto& column_meta : footer.columns()) {
+        if (!column_meta.has_ndv_sketch()) {
+            continue;
+        }
+        HyperLogLog hll;
+        if (!hll.deserialize(Slice(column_meta.ndv_sketch().hll()))) {
+            return Status::Corruption("invalid ndv sketch of the segment");
+        }
+        ColumnSketch& column = _sketches[column_meta.unique_id()];
+        column.hll.merge(hll);
+        column.num_nulls += column_meta.ndv_sketch().num_nulls();
+        column.num_segments++;
+    }
+    return Status::OK();
+}
+
+void RowsetNdvSketchBuilder::finish(google::protobuf::RepeatedPtrField<ColumnNdvSketchPB>* sketches) const {
+    sketches->Clear();
+    for (const auto& [unique_id, column] : _sketches) {
+        if (column.num_segments == _num_segments) {
+            ColumnNdvSketchPB* sketch = sketches->Add();
+            sketch->set_unique_id(unique_id);
+            sketch->set_hll(serialize_hll(column.hll));
+            sketch->set_num_nulls(column.num_nulls);
+        }
+    }
+}
+
+bool merge_rowset_ndv_sketches(const std::vector<const RowsetMetaPB*>& rowset_metas, uint32_t unique_id,
+                               HyperLogLog* hll, int64_t* num_nulls) {
+    *num_nulls = 0;
+    for (const RowsetMetaPB* rowset_meta : rowset_metas) {
+        if (rowset_meta->num_rows() == 0) {
+            continue;
+        }
+        auto iter = std::find_if(rowset_meta->column_ndv_sketches().begin(), rowset_meta->column_ndv_sketches().end(),
+                                 [&](const ColumnNdvSketchPB& sketch) { return sketch.unique_id() == unique_id; });
+        HyperLogLog rowset_hll;
+        if (iter == rowset_meta->column_ndv_sketches().end() || !rowset_hll.deserialize(Slice(iter->hll()))) {
+            return false;
+        }
+        hll->merge(rowset_hll);
+        *num_nulls += iter->num_nulls();
+    }
+    return true;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,46 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "storage/hll.h"
+
+namespace starrocks::segment_v2 {
+class SegmentFooterPB;
+} // namespace starrocks::segment_v2
+
+namespace starrocks::vectorized {
+
+// The rowset-level ndv sketches, i.e. the ColumnNdvSketchPBs of RowsetMetaPB, which are the NdvSketchPBs of the
+// segments of a rowset merged. A column has a rowset-level sketch only if every segment of the rowset has one.
+class RowsetNdvSketchBuilder {
+public:
+    // Merge the sketches in |footer| of a segment written.
+    Status add_segment(const segment_v2::SegmentFooterPB& footer);
+
+    // Set the rowset-level sketches of the columns to |sketches|.
+    void finish(google::protobuf::RepeatedPtrField<ColumnNdvSketchPB>* sketches) const;
+
+private:
+    struct ColumnSketch {
+        HyperLogLog hll;
+        uint64_t num_nulls = 0;
+        int64_t num_segments = 0;
+    };
+
+    // By the unique ids of the columns.
+    std::map<uint32_t, ColumnSketch> _sketches;
+    int64_t _num_segments = 0;
+};
+
+// Merge the sketches of the column |unique_id| of the rowsets |rowset_metas| into |hll| and |num_nulls|. Returns
+// false if a rowset with rows has no sketch of the column, e.g. it's written before the sketches are enabled.
+bool merge_rowset_ndv_sketches(const std::vector<const RowsetMetaPB*>& rowset_metas, uint32_t unique_id,
+                               HyperLogLog* hll, int64_t* num_nulls);
+
+} // namespace starrocks::vectorized
@@ -6,8 +6,10 @@
 #include <unordered_map>
 #include <vector>
 
+#include "runtime/vectorized/global_dict.h"
 #include "storage/fs/fs_util.h"
 #include "storage/olap_common.h"
+#include "storage/vectorized/runtime_column_predicate.h"
 #include "storage/vectorized/seek_range.h"
 
 namespace starrocks {
@@ -24,6 +26,8 @@ namespace starrocks::vectorized {
 
 class ColumnPredicate;
 class DeletePredicates;
+class MetaAggregates;
+struct RowidRangeOption;
 class Schema;
 
 class RowsetReadOptions {
@@ -32,13 +36,23 @@ public:
 
     ReaderType reader_type = READER_QUERY;
     int chunk_size = DEFAULT_CHUNK_SIZE;
+    int read_ahead_pages = 0;
 
     fs::BlockManager* block_mgr = fs::fs_util::block_manager();
 
     std::vector<SeekRange> ranges;
 
+    // If set, only the row range of the segment selected by it is read.
+    const RowidRangeOption* rowid_range_option = nullptr;
+
+    // The columns read as the ids of their global dicts.
+    const GlobalDicts* global_dicts = nullptr;
+
     std::unordered_map<ColumnId, PredicateList> predicates;
 
+    // Applied to the zone maps of the rows not read yet whenever their bounds are tightened.
+    RuntimeColumnPredicates runtime_predicates;
+
     // whether rowset should return rows in sorted order.
     bool sorted = true;
 
@@ -48,6 +62,9 @@ public:
 
     const DeletePredicates* delete_predicates = nullptr;
 
+    // If set, the segments answered by their metadata are added to it instead of being read.
+    MetaAggregates* meta_aggregates = nullptr;
+
     const TabletSchema* tablet_schema = nullptr;
 
     bool is_primary_keys = false;
@@ -0,0 +1,124 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/vectorized/rowset_zone_map.h"
+
+#include <algorithm>
+
+#include "column/datum.h"
+#include "column/datum_convert.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "storage/tablet_schema.h"
+#include "storage/types.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+// Parse the min and the max of |zm| as ColumnReader does, the min is null if the column has a null.
+static Status parse_zone_map(const TypeInfoPtr& type_info, const ColumnZoneMapPB& zm, Datum* min, Datum* max) {
+    min->set_null();
+    max->set_null();
+    if (!zm.has_null() && zm.has_not_null()) {
+        RETURN_IF_ERROR(datum_from_string(type_info.get(), min, zm.min(), nullptr));
+    }
+    if (zm.has_not_null()) {
+        RETURN_IF_ERROR(datum_from_string(type_info.get(), max, zm.max(), nullptr));
+    }
+    return Status::OK();
+}
+
+Status RowsetZoneMapBuilder::add_segment(const segment_v2::SegmentFooterPB& footer) {
+    _num_segments++;
+    for (const auto& column_meta : footer.columns()) {
+        const segment_v2::ZoneMapPB* segment_zone_map = nullptr;
+        for (const auto& index_meta : column_meta.indexes()) {
+            if (index_meta.type() == segment_v2::ZONE_MAP_INDEX) {
+                segment_zone_map = &index_meta.zone_map_index().segment_zone_map();
+                break;
+            }
+        }
+        if (segment_zone_map == nullptr) {
+            continue;
+        }
+        auto type = static_cast<FieldType>(column_meta.type());
+        ColumnZoneMap& column = _zone_maps[column_meta.unique_id()];
+        ColumnZoneMapPB& zm = column.zone_map;
+        if (column.num_segments++ == 0) {
+            zm.set_unique_id(column_meta.unique_id());
+            zm.set_type(type);
+            zm.set_has_null(false);
+            zm.set_has_not_null(false);
+        } else if (zm.type() != static_cast<int32_t>(type)) {
+            return Status::InternalError("the segments of a rowset have the columns of different types");
+        }
+        zm.set_has_null(zm.has_null() || segment_zone_map->has_null());
+        if (!segment_zone_map->has_not_null()) {
+            continue;
+        }
+        if (!zm.has_not_null()) {
+            zm.set_min(segment_zone_map->min());
+            zm.set_max(segment_zone_map->max());
+            zm.set_has_not_null(true);
+            continue;
+        }
+        TypeInfoPtr type_info = get_type_info(delegate_type(type));
+        Datum min;
+        Datum max;
+        Datum segment_min;
+        Datum segment_max;
+        RETURN_IF_ERROR(datum_from_string(type_info.get(), &min, zm.min(), nullptr));
+        RETURN_IF_ERROR(datum_from_string(type_info.get(), &max, zm.max(), nullptr));
+        RETURN_IF_ERROR(datum_from_string(type_info.get(), &segment_min, segment_zone_map->min(), nullptr));
+        RETURN_IF_ERROR(datum_from_string(type_info.get(), &segment_max, segment_zone_map->max(), nullptr));
+        bool less_min = type_info->cmp(segment_min, min) < 0;
+        bool greater_max = type_info->cmp(segment_max, max) > 0;
+        // The datums of the strings point to the strings of the zone maps, so they're set after the comparisons.
+        if (less_min) {
+            zm.set_min(segment_zone_map->min());
+        }
+        if (greater_max) {
+            zm.set_max(segment_zone_map->max());
+        }
+    }
+    return Status::OK();
+}
+
+void RowsetZoneMapBuilder::finish(google::protobuf::RepeatedPtrField<ColumnZoneMapPB>* zone_maps) const {
+    zone_maps->Clear();
+    for (const auto& [unique_id, column] : _zone_maps) {
+        if (column.num_segments == _num_segments) {
+            *zone_maps->Add() = column.zone_map;
+        }
+    }
+}
+
+bool rowset_zone_map_filter(const RowsetMetaPB& rowset_meta_pb, const TabletSchema& tablet_schema,
+                            const std::unordered_map<ColumnId, std::vector<const ColumnPredicate*>>& predicates) {
+    if (rowset_meta_pb.column_zone_maps_size() == 0) {
+        return true;
+    }
+    for (const auto& [cid, column_predicates] : predicates) {
+        if (cid >= tablet_schema.num_columns()) {
+            continue;
+        }
+        const TabletColumn& column = tablet_schema.column(cid);
+        auto unique_id = static_cast<uint32_t>(column.unique_id());
+        auto iter = std::find_if(rowset_meta_pb.column_zone_maps().begin(), rowset_meta_pb.column_zone_maps().end(),
+                                 [&](const ColumnZoneMapPB& zm) { return zm.unique_id() == unique_id; });
+        // The values written before a schema change of the column may not be compared as the values of its type.
+        if (iter == rowset_meta_pb.column_zone_maps().end() || iter->type() != static_cast<int32_t>(column.type())) {
+            continue;
+        }
+        Datum min;
+        Datum max;
+        if (!parse_zone_map(get_type_info(delegate_type(column.type())), *iter, &min, &max).ok()) {
+            continue;
+        }
+        auto filter = [&](const ColumnPredicate* pred) { return pred->zone_map_filter(min, max); };
+        if (!std::all_of(column_predicates.begin(), column_predicates.end(), filter)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "storage/olap_common.h"
+
+namespace starrocks {
+class TabletSchema;
+namespace segment_v2 {
+class SegmentFooterPB;
+}
+} // namespace starrocks
+
+namespace starrocks::vectorized {
+
+class ColumnPredicate;
+
+// The rowset-level zone maps, i.e. the ColumnZoneMapPBs of RowsetMetaPB, which are the segment-level zone maps
+// of the segments of a rowset merged, so a rowset could be pruned by the predicates before its segments are
+// opened. A column has a rowset-level zone map only if every segment of the rowset has a zone map of it.
+class RowsetZoneMapBuilder {
+public:
+    // Merge the segment-level zone maps in |footer| of a segment written.
+    Status add_segment(const segment_v2::SegmentFooterPB& footer);
+
+    // Set the rowset-level zone maps of the columns to |zone_maps|.
+    void finish(google::protobuf::RepeatedPtrField<ColumnZoneMapPB>* zone_maps) const;
+
+private:
+    struct ColumnZoneMap {
+        ColumnZoneMapPB zone_map;
+        int64_t num_segments = 0;
+    };
+
+    // By the unique ids of the columns.
+    std::map<uint32_t, ColumnZoneMap> _zone_maps;
+    int64_t _num_segments = 0;
+};
+
+// Whether the rows of a rowset may satisfy |predicates| on the columns of |tablet_schema|, by the rowset-level
+// zone maps |rowset_meta_pb|, which is false only if some predicate is false on all the values of a column.
+bool rowset_zone_map_filter(const RowsetMetaPB& rowset_meta_pb, const TabletSchema& tablet_schema,
+                            const std::unordered_map<ColumnId, std::vector<const ColumnPredicate*>>& predicates);
+
+} // namespace starrocks::vectorized
@@ -17,8 +17,17 @@ SegmentChunkIteratorAdapter::SegmentChunkIteratorAdapter(const TabletSchema& tab
           _convert_timer(nullptr) {}
 
 Status SegmentChunkIteratorAdapter::prepare(const SegmentReadOptions& options) {
-    _schema.convert_to(&_in_schema, _new_types);
-    RETURN_IF_ERROR(options.convert_to(&_in_read_options, _new_types, &_obj_pool));
+    std::vector<FieldType> new_types = _new_types;
+    // The columns of the global dicts are read as the INT dict ids, which need no conversion.
+    if (options.global_dicts != nullptr) {
+        for (const auto& [cid, dict] : *options.global_dicts) {
+            if (static_cast<size_t>(cid) < new_types.size()) {
+                new_types[cid] = OLAP_FIELD_TYPE_INT;
+            }
+        }
+    }
+    _schema.convert_to(&_in_schema, new_types);
+    RETURN_IF_ERROR(options.convert_to(&_in_read_options, new_types, &_obj_pool));
     RETURN_IF_ERROR(_converter.init(_in_schema, _schema));
     if (options.profile != nullptr) {
         _convert_timer = ADD_TIMER(options.profile, "ConvertV2Time");
@@ -2,6 +2,7 @@
 
 #include "storage/rowset/vectorized/segment_iterator.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "butil/containers/flat_map.h"
@@ -33,6 +34,7 @@
 #include "storage/vectorized/projection_iterator.h"
 #include "storage/vectorized/range.h"
 #include "storage/vectorized/roaring2range.h"
+#include "storage/vectorized/runtime_column_predicate.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks::vectorized {
@@ -103,6 +105,8 @@ public:
 
     int dict_lookup(const Slice& word) override { return _col_iter->dict_lookup(word); }
 
+    int dict_size() override { return _col_iter->dict_size(); }
+
     Status next_dict_codes(size_t* n, vectorized::Column* dst) override { return _col_iter->next_dict_codes(n, dst); }
 
     Status decode_dict_codes(const int32_t* codes, size_t size, vectorized::Column* words) override {
@@ -150,23 +154,45 @@ private:
         }
 
         Status seek_columns(ordinal_t pos) {
-            for (auto iter : _column_iterators) {
-                RETURN_IF_ERROR(iter->seek_to_ordinal(pos));
+            for (size_t i = 0; i < _column_iterators.size(); i++) {
+                if (!_is_lazy_column[i]) {
+                    RETURN_IF_ERROR(_column_iterators[i]->seek_to_ordinal(pos));
+                }
             }
             return Status::OK();
         }
 
-        Status read_columns(Chunk* chunk, size_t n) {
+        // The time of reading each column is added to |read_ns| if it's not null.
+        Status read_columns(Chunk* chunk, size_t n, int64_t* read_ns) {
             bool may_has_del_row = chunk->delete_state() != DEL_NOT_SATISFIED;
             for (size_t i = 0; i < _column_iterators.size(); i++) {
+                if (_is_lazy_column[i]) {
+                    continue;
+                }
                 const ColumnPtr& col = chunk->get_column_by_index(i);
-                RETURN_IF_ERROR(_column_iterators[i]->next_batch(&n, col.get()));
+                size_t nread = n;
+                if (read_ns != nullptr) {
+                    SCOPED_RAW_TIMER(&read_ns[i]);
+                    RETURN_IF_ERROR(_column_iterators[i]->next_batch(&nread, col.get()));
+                } else {
+                    RETURN_IF_ERROR(_column_iterators[i]->next_batch(&nread, col.get()));
+                }
                 may_has_del_row |= (col->delete_state() != DEL_NOT_SATISFIED);
             }
             chunk->set_delete_state(may_has_del_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
             return Status::OK();
         }
 
+        // The first column read sequentially, whose ordinal is the ordinal of all the sequentially read columns.
+        ColumnIterator* first_read_iterator() const {
+            for (size_t i = 0; i < _column_iterators.size(); i++) {
+                if (!_is_lazy_column[i]) {
+                    return _column_iterators[i];
+                }
+            }
+            return nullptr;
+        }
+
         int64_t memory_usage() const {
             int64_t usage = 0;
             usage += (_read_chunk != nullptr) ? _read_chunk->memory_usage() : 0;
@@ -178,6 +204,9 @@ private:
         Schema _read_schema;
         Schema _dict_decode_schema;
         std::vector<bool> _is_dict_column;
+        // true iff the column isn't read sequentially but fetched by the rowids of the rows selected by the
+        // predicates of the other columns, see `_filter`.
+        std::vector<bool> _is_lazy_column;
         std::vector<ColumnIterator*> _column_iterators;
         ScanContext* _next;
 
@@ -198,9 +227,16 @@ private:
     Status _do_get_next(Chunk* result, vector<rowid_t>* rowid);
 
     Status _init_column_iterators(const Schema& schema);
+    Status _init_global_dicts();
     Status _get_row_ranges_by_keys();
+    void _apply_rowid_range();
     Status _get_row_ranges_by_zone_map();
     Status _get_row_ranges_by_bloom_filter();
+    Status _get_row_ranges_by_ngram_bloom_filter();
+    // Prune the rows not read yet by the zone maps if the bounds of the runtime predicates are tightened.
+    Status _apply_runtime_predicates();
+    // Read ahead the pages of the columns covering |_scan_range|.
+    Status _init_read_ahead();
 
     uint32_t segment_id() const { return _segment->id(); }
     uint32_t num_rows() const { return _segment->num_rows(); }
@@ -209,7 +245,24 @@ private:
     Status _seek_columns(const Schema& schema, rowid_t pos);
     Status _read_columns(const Schema& schema, Chunk* chunk, size_t nrows);
 
-    uint16_t _filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to);
+    Status _filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to, uint16_t* chunk_size);
+
+    // Evaluates the predicates on the rows [from, to) of |chunk| into |selection|. If |selected| is true, they're
+    // evaluated on the rows already selected by |selection| only.
+    void _evaluate_predicates(Chunk* chunk, const std::vector<const ColumnPredicate*>& vectorized_preds,
+                              const std::vector<const ColumnPredicate*>& branchless_preds, bool selected,
+                              uint8_t* selection, uint16_t from, uint16_t to);
+
+    // Samples the rows selected by the predicates of each predicate column on the rows [from, to) of |chunk|.
+    void _sample_predicate_columns(Chunk* chunk, uint16_t from, uint16_t to);
+
+    // Reorders the predicate columns by the sampled statistics, and makes the columns after the first one lazy
+    // if the first one is selective enough.
+    void _reorder_predicate_columns();
+
+    // Fetches the rows [from, to) of the lazy column of |chunk| at |index|, only the values of the rows selected
+    // by |_selection| are read.
+    Status _read_lazy_column(Chunk* chunk, size_t index, uint16_t from, uint16_t to);
 
     void _init_column_predicates();
 
@@ -222,8 +275,15 @@ private:
 
     bool _rewrite_predicate(const FieldPtr& field);
 
+    // Evaluates the predicates of the dict-encoded |field| on all the words of its dict, and rewrites them into
+    // one predicate on the dict codes of the words selected.
+    bool _rewrite_predicates_by_dict(const FieldPtr& field, PredicateList* preds);
+
     Status _decode_dict_codes(ScanContext* ctx);
 
+    // Translates the local dict codes of the column |cid| into the ids of its global dict.
+    Status _translate_dict_codes(ColumnId cid, const Column& codes, Column* ids);
+
     void _check_low_cardinality_optimization();
 
     Status _finish_late_materialization(ScanContext* ctx);
@@ -256,8 +316,35 @@ private:
     SparseRange _scan_range;
     SparseRangeIterator _range_iter;
 
+    // The predicates of one predicate column, and the statistics sampled on the first reads to decide the order
+    // of reading and evaluating the predicate columns.
+    struct PredicateColumn {
+        // the index of the column in |_schema| and the read chunks.
+        size_t index = 0;
+        std::vector<const ColumnPredicate*> vectorized_preds;
+        std::vector<const ColumnPredicate*> branchless_preds;
+        int64_t selected_rows = 0;
+    };
+
+    // The number of reads sampled before reordering the predicate columns.
+    static constexpr int kNumSampleReads = 4;
+
+    // The predicates of the columns read sequentially.
     std::vector<const ColumnPredicate*> _vectorized_preds;
     std::vector<const ColumnPredicate*> _branchless_preds;
+
+    std::vector<PredicateColumn> _predicate_column_list;
+    // The lazy predicate columns in the order of evaluation, which are fetched only for the rows selected
+    // by the predicates evaluated before them.
+    std::vector<const PredicateColumn*> _lazy_predicate_columns;
+    bool _sampling = false;
+    int _sample_reads = 0;
+    int64_t _sample_rows = 0;
+    // the time of reading each column of the read chunks while sampling.
+    std::vector<int64_t> _sample_read_ns;
+    Buffer<uint8_t> _sample_selection;
+    std::vector<rowid_t> _lazy_rowids;
+    std::vector<uint32_t> _lazy_indexes;
     // _selection is used to accelerate
     Buffer<uint8_t> _selection;
 
@@ -273,8 +360,16 @@ private:
     // a mapping from column id to a indicate whether it's predicate need rewrite.
     std::vector<uint8_t> _predicate_need_rewrite;
 
+    // a mapping from column id to its global dict, null if the column isn't read as the global dict ids.
+    std::vector<const GlobalDict*> _global_dicts;
+    // a mapping from column id to the global dict ids of its local dict codes, -1 if not translated yet.
+    std::vector<std::vector<DictId>> _local_to_global_ids;
+
     ObjectPool _obj_pool;
 
+    // the versions of the bounds of |_opts.runtime_predicates| which have been applied.
+    std::vector<int64_t> _runtime_predicate_versions;
+
     // initial size of |_opts.predicates|.
     int _predicate_columns = 0;
 
@@ -303,18 +398,20 @@ Status SegmentIterator::_init() {
         tsid.segment_id = _opts.rowset_id + segment_id();
         RETURN_IF_ERROR(
                 StorageEngine::instance()->update_manager()->get_del_vec(_opts.meta, tsid, _opts.version, &_del_vec));
-        if (_del_vec && _del_vec->empty()) {
-            _del_vec.reset();
-        }
-        if (_del_vec) {
-            if (_segment->num_rows() == _del_vec->cardinality()) {
-                return Status::EndOfFile("all rows deleted");
-            }
-            VLOG(1) << "seg_iter init delvec tablet:" << _opts.tablet_id << " rowset:" << _opts.rowset_id
-                    << " seg:" << segment_id() << " version req:" << _opts.version << " actual:" << _del_vec->version()
-                    << " " << _del_vec->cardinality() << "/" << _segment->num_rows();
-            roaring_init_iterator(&_del_vec->roaring()->roaring, &_roaring_iter);
+    } else {
+        _del_vec = _opts.del_vec;
+    }
+    if (_del_vec && _del_vec->empty()) {
+        _del_vec.reset();
+    }
+    if (_del_vec) {
+        if (_segment->num_rows() == _del_vec->cardinality()) {
+            return Status::EndOfFile("all rows deleted");
         }
+        VLOG(1) << "seg_iter init delvec tablet:" << _opts.tablet_id << " rowset:" << _opts.rowset_id
+                << " seg:" << segment_id() << " version req:" << _opts.version << " actual:" << _del_vec->version()
+                << " " << _del_vec->cardinality() << "/" << _segment->num_rows();
+        roaring_init_iterator(&_del_vec->roaring()->roaring, &_roaring_iter);
     }
 
     RETURN_IF_ERROR(_segment->_load_index());
@@ -329,6 +426,7 @@ Status SegmentIterator::_init() {
 
     /// the calling order matters, do not change unless you know why.
 
+    RETURN_IF_ERROR(_init_global_dicts());
     _check_low_cardinality_optimization();
     RETURN_IF_ERROR(_init_column_iterators(_schema));
     RETURN_IF_ERROR(_init_bitmap_index_iterators());
@@ -336,10 +434,14 @@ Status SegmentIterator::_init() {
     RETURN_IF_ERROR(_apply_bitmap_index());
     RETURN_IF_ERROR(_get_row_ranges_by_zone_map());
     RETURN_IF_ERROR(_get_row_ranges_by_bloom_filter());
+    RETURN_IF_ERROR(_get_row_ranges_by_ngram_bloom_filter());
     _rewrite_predicates();
     _init_context();
     _init_column_predicates();
     _range_iter = _scan_range.new_iterator();
+    _runtime_predicate_versions.resize(_opts.runtime_predicates.size(), 0);
+    RETURN_IF_ERROR(_apply_runtime_predicates());
+    RETURN_IF_ERROR(_init_read_ahead());
 
     return Status::OK();
 }
@@ -354,7 +456,10 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
         const ColumnId cid = f->id();
         if (_column_iterators[cid] == nullptr) {
             bool check_dict_enc;
-            if (_opts.predicates.count(cid)) {
+            if (_global_dicts[cid] != nullptr) {
+                // the local dict codes are translated into the global dict ids if all pages are dict-encoded.
+                check_dict_enc = true;
+            } else if (_opts.predicates.count(cid)) {
                 check_dict_enc = _predicate_need_rewrite[cid];
             } else {
                 check_dict_enc = has_predicate;
@@ -376,25 +481,64 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
     return Status::OK();
 }
 
+Status SegmentIterator::_init_global_dicts() {
+    const size_t n = 1 + ChunkHelper::max_column_id(_schema);
+    _global_dicts.resize(n, nullptr);
+    if (_opts.global_dicts == nullptr) {
+        return Status::OK();
+    }
+    _local_to_global_ids.resize(n);
+    for (const FieldPtr& f : _schema.fields()) {
+        auto iter = _opts.global_dicts->find(f->id());
+        if (iter == _opts.global_dicts->end()) {
+            continue;
+        }
+        if (f->type()->type() != OLAP_FIELD_TYPE_INT || _opts.predicates.count(f->id()) > 0) {
+            return Status::InternalError("the columns of global dicts must be INT fields without predicates");
+        }
+        _global_dicts[f->id()] = iter->second.get();
+    }
+    return Status::OK();
+}
+
 void SegmentIterator::_init_column_predicates() {
     DCHECK_EQ(_predicate_columns, _opts.predicates.size());
-    for (const auto& pair : _opts.predicates) {
-        for (const ColumnPredicate* pred : pair.second) {
+    for (size_t i = 0; i < _predicate_columns; i++) {
+        auto iter = _opts.predicates.find(_schema.field(i)->id());
+        DCHECK(iter != _opts.predicates.end());
+        PredicateColumn column;
+        column.index = i;
+        for (const ColumnPredicate* pred : iter->second) {
             // If this predicate is generated by join runtime filter,
             // We only use it to compute segment row range.
             if (pred->is_index_filter_only()) {
                 continue;
             }
             if (pred->can_vectorized()) {
-                _vectorized_preds.emplace_back(pred);
+                column.vectorized_preds.emplace_back(pred);
             } else {
-                _branchless_preds.emplace_back(pred);
+                column.branchless_preds.emplace_back(pred);
             }
         }
+        if (column.vectorized_preds.empty() && column.branchless_preds.empty()) {
+            continue;
+        }
+        _vectorized_preds.insert(_vectorized_preds.end(), column.vectorized_preds.begin(),
+                                 column.vectorized_preds.end());
+        _branchless_preds.insert(_branchless_preds.end(), column.branchless_preds.begin(),
+                                 column.branchless_preds.end());
+        _predicate_column_list.emplace_back(std::move(column));
     }
     if (_vectorized_preds.empty() && _branchless_preds.empty()) {
         _opts.predicates.clear();
     }
+
+    // The order of the predicate columns is decided by the statistics sampled on the first reads.
+    _sampling = _predicate_column_list.size() > 1 && config::lazy_predicate_column_ratio > 0;
+    if (_sampling) {
+        _sample_read_ns.assign(_schema.num_fields() + 1, 0);
+        _sample_selection.resize(_opts.chunk_size);
+    }
 }
 
 Status SegmentIterator::_get_row_ranges_by_keys() {
@@ -402,6 +546,7 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
 
     if (_opts.ranges.empty()) {
         _scan_range.add(Range(0, num_rows()));
+        _apply_rowid_range();
         return Status::OK();
     }
     DCHECK_EQ(0, _scan_range.span_size());
@@ -423,9 +568,17 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
     }
     _opts.stats->rows_key_range_filtered += num_rows() - _scan_range.span_size();
     StarRocksMetrics::instance()->segment_rows_by_short_key.increment(_scan_range.span_size());
+    _apply_rowid_range();
     return Status::OK();
 }
 
+void SegmentIterator::_apply_rowid_range() {
+    // The rows out of |_opts.rowid_range| are read by other scans, so they aren't counted as filtered.
+    if (_opts.rowid_range != nullptr) {
+        _scan_range = _scan_range.intersection(*_opts.rowid_range);
+    }
+}
+
 Status SegmentIterator::_get_row_ranges_by_zone_map() {
     SparseRange zm_range(0, num_rows());
 
@@ -478,6 +631,37 @@ Status SegmentIterator::_get_row_ranges_by_zone_map() {
     return Status::OK();
 }
 
+Status SegmentIterator::_apply_runtime_predicates() {
+    for (size_t i = 0; i < _opts.runtime_predicates.size(); i++) {
+        const RuntimeColumnPredicate* runtime_pred = _opts.runtime_predicates[i];
+        if (runtime_pred->version() == _runtime_predicate_versions[i] || !_range_iter.has_more()) {
+            continue;
+        }
+        FieldPtr field = _schema.get_field_by_name(runtime_pred->column_name());
+        if (field == nullptr) {
+            _runtime_predicate_versions[i] = runtime_pred->version();
+            continue;
+        }
+        // The predicate is only used to prune the rows here.
+        ObjectPool pool;
+        const ColumnId cid = field->id();
+        const ColumnPredicate* pred =
+                runtime_pred->new_predicate(field->type(), cid, &pool, &_runtime_predicate_versions[i]);
+        if (pred == nullptr) {
+            continue;
+        }
+        SparseRange zm_range;
+        RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map({pred}, nullptr, &zm_range));
+        // The rows before |_range_iter| have been read.
+        SparseRange remain_range = _scan_range.intersection(SparseRange(_range_iter.begin(), num_rows()));
+        size_t prev_size = remain_range.span_size();
+        _scan_range = remain_range.intersection(zm_range);
+        _range_iter = _scan_range.new_iterator();
+        _opts.stats->rows_stats_filtered += (prev_size - _scan_range.span_size());
+    }
+    return Status::OK();
+}
+
 // if |lower| is true, return the first row in the range [0, end) that is not less than |key|,
 // or end if no such row is found.
 // if |lower| is false, return the first row in the range [0, end) that is greater than |key|,
@@ -577,7 +761,7 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowid, size_
     {
         _opts.stats->blocks_load += 1;
         SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
-        RETURN_IF_ERROR(_context->read_columns(chunk, nread));
+        RETURN_IF_ERROR(_context->read_columns(chunk, nread, _sampling ? _sample_read_ns.data() : nullptr));
     }
     _chunk_rowid_start = _cur_rowid;
     if (rowid != nullptr) {
@@ -587,7 +771,10 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowid, size_
     }
     _cur_rowid += nread;
     _opts.stats->raw_rows_read += nread;
-    chunk->check_or_die();
+    // the lazy columns are not read yet.
+    if (_lazy_predicate_columns.empty()) {
+        chunk->check_or_die();
+    }
     return Status::OK();
 }
 
@@ -642,13 +829,16 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
 
     Chunk* chunk = _context->_read_chunk.get();
 
+    if (!_opts.runtime_predicates.empty()) {
+        RETURN_IF_ERROR(_apply_runtime_predicates());
+    }
     while ((chunk_start < chunk_capacity) & _range_iter.has_more()) {
         RETURN_IF_ERROR(_read(chunk, rowid, chunk_capacity - chunk_start));
-        chunk->check_or_die();
-        size_t next_start = chunk->num_rows();
+        // not chunk->num_rows(), since the lazy columns are not read yet.
+        uint16_t next_start = chunk_start + (_cur_rowid - _chunk_rowid_start);
 
         if (has_predicate || _del_vec) {
-            next_start = _filter(chunk, rowid, chunk_start, next_start);
+            RETURN_IF_ERROR(_filter(chunk, rowid, chunk_start, next_start, &next_start));
             chunk->check_or_die();
         }
         chunk_start = next_start;
@@ -727,10 +917,8 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
 
 void SegmentIterator::_switch_context(ScanContext* to) {
     if (_context != nullptr) {
-        const ordinal_t ordinal = _context->_column_iterators[0]->get_current_ordinal();
-        for (ColumnIterator* iter : to->_column_iterators) {
-            iter->seek_to_ordinal(ordinal);
-        }
+        const ordinal_t ordinal = _context->first_read_iterator()->get_current_ordinal();
+        to->seek_columns(ordinal);
         _context->close();
     }
 
@@ -760,35 +948,99 @@ void SegmentIterator::_switch_context(ScanContext* to) {
     _context = to;
 }
 
-uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to) {
+Status SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to,
+                                uint16_t* chunk_size) {
     // There must be one predicate, either vectorized or branchless.
     DCHECK(_vectorized_preds.size() + _branchless_preds.size() > 0 || _del_vec);
 
     SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
 
-    // first evaluate
-    if (!_vectorized_preds.empty()) {
+    if (_sampling) {
+        _sample_predicate_columns(chunk, from, to);
+    }
+
+    const bool has_preds = !_vectorized_preds.empty() || !_branchless_preds.empty();
+    if (has_preds) {
+        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
+        _evaluate_predicates(chunk, _vectorized_preds, _branchless_preds, false, _selection.data(), from, to);
+    }
+
+    // The lazy columns are read after the predicates of the other columns have been evaluated, and only the
+    // values of the rows still selected are read.
+    for (const PredicateColumn* column : _lazy_predicate_columns) {
+        RETURN_IF_ERROR(_read_lazy_column(chunk, column->index, from, to));
         SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
-        const ColumnPredicate* pred = _vectorized_preds[0];
+        _evaluate_predicates(chunk, column->vectorized_preds, column->branchless_preds, true, _selection.data(),
+                             from, to);
+    }
+
+    int64_t del_vec_filtered = 0;
+    if (_del_vec) {
+        if (!has_preds) {
+            // setup selection vector
+            memset(_selection.data() + from, 1, to - from);
+        }
+        // TODO: filter del_vec early if most of the rows are deleted
+        uint32_t& cur_value = _roaring_iter.current_value;
+        while (_roaring_iter.has_value && cur_value < _cur_rowid) {
+            if (cur_value >= _chunk_rowid_start) {
+                // valid delete
+                auto& del = _selection[cur_value - _chunk_rowid_start + from];
+                del_vec_filtered += del;
+                del = 0;
+            }
+            roaring_advance_uint32_iterator(&_roaring_iter);
+        }
+    }
+
+    auto hit_count = SIMD::count_nonzero(&_selection[from], to - from);
+
+    *chunk_size = to;
+    {
+        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_chunk_copy_ns);
+        if (hit_count == 0) {
+            *chunk_size = from;
+            chunk->set_num_rows(*chunk_size);
+            if (rowid != nullptr) {
+                rowid->resize(*chunk_size);
+            }
+        } else if (hit_count != to - from) {
+            *chunk_size = chunk->filter_range(_selection, from, to);
+            if (rowid != nullptr) {
+                auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), from, to);
+                rowid->resize(size);
+            }
+        }
+    }
+    _opts.stats->rows_del_vec_filtered += del_vec_filtered;
+    _opts.stats->rows_vec_cond_filtered += (to - *chunk_size) - del_vec_filtered;
+
+    // The columns read for this range are not changed, the new order is applied from the next read.
+    if (_sampling && _sample_reads >= kNumSampleReads) {
+        _sampling = false;
+        _reorder_predicate_columns();
+    }
+    return Status::OK();
+}
+
+void SegmentIterator::_evaluate_predicates(Chunk* chunk, const std::vector<const ColumnPredicate*>& vectorized_preds,
+                                           const std::vector<const ColumnPredicate*>& branchless_preds, bool selected,
+                                           uint8_t* selection, uint16_t from, uint16_t to) {
+    for (size_t i = 0; i < vectorized_preds.size(); ++i) {
+        const ColumnPredicate* pred = vectorized_preds[i];
         Column* c = chunk->get_column_by_id(pred->column_id()).get();
-        pred->evaluate(c, _selection.data(), from, to);
-        for (int i = 1; i < _vectorized_preds.size(); ++i) {
-            pred = _vectorized_preds[i];
-            c = chunk->get_column_by_id(pred->column_id()).get();
-            pred->evaluate_and(c, _selection.data(), from, to);
+        if (i == 0 && !selected) {
+            pred->evaluate(c, selection, from, to);
+        } else {
+            pred->evaluate_and(c, selection, from, to);
         }
     }
 
     // evaluate brachless
-    if (!_branchless_preds.empty()) {
-        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
-
+    if (!branchless_preds.empty()) {
         uint16_t selected_size = 0;
-        if (!_vectorized_preds.empty()) {
-            for (uint16_t i = from; i < to; ++i) {
-                _selected_idx[selected_size] = i;
-                selected_size += _selection[i];
-            }
+        if (selected || !vectorized_preds.empty()) {
+            selected_size = SIMD::selection_to_indexes(selection, from, to, _selected_idx.data());
         } else {
             // when there is no vectorized predicates, should initialize _selected_idx
             // in a vectorized way
@@ -798,61 +1050,107 @@ uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t
             }
         }
 
-        for (size_t i = 0; selected_size > 0 && i < _branchless_preds.size(); ++i) {
-            const ColumnPredicate* pred = _branchless_preds[i];
+        for (size_t i = 0; selected_size > 0 && i < branchless_preds.size(); ++i) {
+            const ColumnPredicate* pred = branchless_preds[i];
             ColumnPtr& c = chunk->get_column_by_id(pred->column_id());
             selected_size = pred->evaluate_branchless(c.get(), _selected_idx.data(), selected_size);
         }
 
-        memset(&_selection[from], 0, to - from);
+        memset(&selection[from], 0, to - from);
         for (uint16_t i = 0; i < selected_size; ++i) {
-            _selection[_selected_idx[i]] = 1;
+            selection[_selected_idx[i]] = 1;
         }
     }
+}
 
-    int64_t del_vec_filtered = 0;
-    if (_del_vec) {
-        if (_vectorized_preds.empty() && _branchless_preds.empty()) {
-            // setup selection vector
-            memset(_selection.data() + from, 1, to - from);
-        }
-        // TODO: filter del_vec early if most of the rows are deleted
-        uint32_t& cur_value = _roaring_iter.current_value;
-        while (_roaring_iter.has_value && cur_value < _cur_rowid) {
-            if (cur_value >= _chunk_rowid_start) {
-                // valid delete
-                auto& del = _selection[cur_value - _chunk_rowid_start + from];
-                del_vec_filtered += del;
-                del = 0;
+void SegmentIterator::_sample_predicate_columns(Chunk* chunk, uint16_t from, uint16_t to) {
+    for (PredicateColumn& column : _predicate_column_list) {
+        _evaluate_predicates(chunk, column.vectorized_preds, column.branchless_preds, false, _sample_selection.data(),
+                             from, to);
+        column.selected_rows += SIMD::count_nonzero(&_sample_selection[from], to - from);
+    }
+    _sample_rows += to - from;
+    _sample_reads++;
+}
+
+void SegmentIterator::_reorder_predicate_columns() {
+    DCHECK_GE(_predicate_column_list.size(), 2);
+    if (_sample_rows == 0) {
+        return;
+    }
+    // The read time per row filtered out, the columns reading less to filter out more rows go first.
+    auto cost = [this](const PredicateColumn& column) {
+        int64_t filtered_rows = std::max<int64_t>(_sample_rows - column.selected_rows, 1);
+        return static_cast<double>(_sample_read_ns[column.index] + 1) / filtered_rows;
+    };
+    std::vector<const PredicateColumn*> columns;
+    columns.reserve(_predicate_column_list.size());
+    for (const PredicateColumn& column : _predicate_column_list) {
+        columns.emplace_back(&column);
+    }
+    std::stable_sort(columns.begin(), columns.end(),
+                     [&](const PredicateColumn* lhs, const PredicateColumn* rhs) { return cost(*lhs) < cost(*rhs); });
+
+    // The other columns are fetched by the rowids only if the first column filters out most rows, since fetching
+    // the values by the rowids is slower than reading them sequentially for each row read.
+    const PredicateColumn* first = columns[0];
+    const bool lazy = first->selected_rows * 1000 <= _sample_rows * config::lazy_predicate_column_ratio;
+    _vectorized_preds.clear();
+    _branchless_preds.clear();
+    for (const PredicateColumn* column : columns) {
+        // the dict codes and the global dict ids can't be fetched by the rowids.
+        if (lazy && column != first && !_context->_is_dict_column[column->index]) {
+            _lazy_predicate_columns.emplace_back(column);
+            for (ScanContext& ctx : _context_list) {
+                if (column->index < ctx._is_lazy_column.size()) {
+                    ctx._is_lazy_column[column->index] = true;
+                }
             }
-            roaring_advance_uint32_iterator(&_roaring_iter);
+        } else {
+            _vectorized_preds.insert(_vectorized_preds.end(), column->vectorized_preds.begin(),
+                                     column->vectorized_preds.end());
+            _branchless_preds.insert(_branchless_preds.end(), column->branchless_preds.begin(),
+                                     column->branchless_preds.end());
         }
     }
+}
 
-    auto hit_count = SIMD::count_nonzero(&_selection[from], to - from);
-
-    uint16_t chunk_size = to;
-    SCOPED_RAW_TIMER(&_opts.stats->vec_cond_chunk_copy_ns);
-    if (hit_count == 0) {
-        chunk_size = from;
-        chunk->set_num_rows(chunk_size);
-        if (rowid != nullptr) {
-            rowid->resize(chunk_size);
-        }
-    } else if (hit_count != to - from) {
-        chunk_size = chunk->filter_range(_selection, from, to);
-        if (rowid != nullptr) {
-            auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), from, to);
-            rowid->resize(size);
+Status SegmentIterator::_read_lazy_column(Chunk* chunk, size_t index, uint16_t from, uint16_t to) {
+    SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
+    ColumnPtr& column = chunk->get_column_by_index(index);
+    DCHECK_EQ(from, column->size());
+    const uint16_t n = to - from;
+    _lazy_rowids.clear();
+    _lazy_indexes.resize(n);
+    for (uint16_t i = 0; i < n; i++) {
+        if (_selection[from + i]) {
+            _lazy_indexes[i] = _lazy_rowids.size();
+            _lazy_rowids.emplace_back(_chunk_rowid_start + i);
+        } else {
+            // the rows not selected will be filtered out, any value could be used for them.
+            _lazy_indexes[i] = 0;
         }
     }
-    _opts.stats->rows_del_vec_filtered += del_vec_filtered;
-    _opts.stats->rows_vec_cond_filtered += (to - chunk_size) - del_vec_filtered;
-    return chunk_size;
+    if (_lazy_rowids.empty()) {
+        column->append_default(n);
+        return Status::OK();
+    }
+
+    auto values = column->clone_empty();
+    RETURN_IF_ERROR(
+            _context->_column_iterators[index]->fetch_values_by_rowid(_lazy_rowids.data(), _lazy_rowids.size(),
+                                                                      values.get()));
+    column->append_selective(*values, _lazy_indexes.data(), 0, n);
+    if (values->delete_state() != DEL_NOT_SATISFIED) {
+        chunk->set_delete_state(DEL_PARTIAL_SATISFIED);
+    }
+    return Status::OK();
 }
 
 inline bool SegmentIterator::_can_using_dict_code(const FieldPtr& field) const {
-    if (_opts.predicates.find(field->id()) != _opts.predicates.end()) {
+    if (_global_dicts[field->id()] != nullptr) {
+        return _column_iterators[field->id()]->all_page_dict_encoded();
+    } else if (_opts.predicates.find(field->id()) != _opts.predicates.end()) {
         return _predicate_need_rewrite[field->id()];
     } else {
         return (_has_bitmap_index || !_opts.predicates.empty()) &&
@@ -871,6 +1169,7 @@ void SegmentIterator::_build_context(ScanContext* ctx) {
     ctx->_read_schema.reserve(ctx_fields);
     ctx->_dict_decode_schema.reserve(ctx_fields);
     ctx->_is_dict_column.reserve(ctx_fields);
+    ctx->_is_lazy_column.reserve(ctx_fields);
     ctx->_column_iterators.reserve(ctx_fields);
 
     for (size_t i = 0; i < early_materialize_fields; i++) {
@@ -885,11 +1184,21 @@ void SegmentIterator::_build_context(ScanContext* ctx) {
             ctx->_read_schema.append(f2);
             ctx->_column_iterators.emplace_back(iter);
             ctx->_is_dict_column.emplace_back(true);
+            ctx->_is_lazy_column.emplace_back(false);
+            ctx->_has_dict_column = true;
+        } else if (_global_dicts[cid] != nullptr) {
+            // read the strings and encode them into the global dict ids.
+            auto f2 = std::make_shared<Field>(cid, f->name(), OLAP_FIELD_TYPE_VARCHAR, -1, -1, f->is_nullable());
+            ctx->_read_schema.append(f2);
+            ctx->_column_iterators.emplace_back(_column_iterators[cid]);
+            ctx->_is_dict_column.emplace_back(true);
+            ctx->_is_lazy_column.emplace_back(false);
             ctx->_has_dict_column = true;
         } else {
             ctx->_read_schema.append(f);
             ctx->_column_iterators.emplace_back(_column_iterators[cid]);
             ctx->_is_dict_column.emplace_back(false);
+            ctx->_is_lazy_column.emplace_back(false);
         }
         ctx->_dict_decode_schema.append(f);
     }
@@ -904,6 +1213,7 @@ void SegmentIterator::_build_context(ScanContext* ctx) {
         ctx->_dict_decode_schema.append(f);
         ctx->_column_iterators.emplace_back(iter);
         ctx->_is_dict_column.emplace_back(false);
+        ctx->_is_lazy_column.emplace_back(false);
         ctx->_late_materialize = true;
     }
 }
@@ -960,6 +1270,11 @@ bool SegmentIterator::_rewrite_predicate(const FieldPtr& field) {
     // the predicate has been erased, because of bitmap index filter.
     RETURN_IF(preds.empty(), false);
     const ColumnPredicate* pred = preds[0];
+    if (preds.size() > 1 ||
+        (pred->type() != PredicateType::kEQ && pred->type() != PredicateType::kNE &&
+         pred->type() != PredicateType::kInList && pred->type() != PredicateType::kNotInList)) {
+        return _rewrite_predicates_by_dict(field, &preds);
+    }
     if (PredicateType::kEQ == pred->type()) {
         Datum value = pred->value();
         int code = _column_iterators[cid]->dict_lookup(value.get_slice());
@@ -1045,6 +1360,80 @@ bool SegmentIterator::_rewrite_predicate(const FieldPtr& field) {
     return false;
 }
 
+bool SegmentIterator::_rewrite_predicates_by_dict(const FieldPtr& field, PredicateList* preds) {
+    ColumnId cid = field->id();
+    ColumnIterator* iter = _column_iterators[cid];
+    const int num_words = iter->dict_size();
+    RETURN_IF(num_words <= 0, false);
+
+    // the words are evaluated by batches, since the predicates evaluate at most UINT16_MAX rows at once.
+    const int batch_size = std::max<int>(_opts.chunk_size, 1);
+    std::vector<int32_t> codes(num_words);
+    for (int i = 0; i < num_words; i++) {
+        codes[i] = i;
+    }
+    ColumnPtr words = ChunkHelper::column_from_field_type(field->type()->type(), false);
+    Buffer<uint8_t> selection(batch_size);
+    std::vector<int> selected_codes;
+    std::vector<int> unselected_codes;
+    for (int start = 0; start < num_words; start += batch_size) {
+        const int n = std::min(batch_size, num_words - start);
+        words->resize(0);
+        if (!iter->decode_dict_codes(codes.data() + start, n, words.get()).ok()) {
+            return false;
+        }
+        (*preds)[0]->evaluate(words.get(), selection.data(), 0, n);
+        for (size_t i = 1; i < preds->size(); i++) {
+            (*preds)[i]->evaluate_and(words.get(), selection.data(), 0, n);
+        }
+        for (int i = 0; i < n; i++) {
+            if (selection[i]) {
+                selected_codes.emplace_back(start + i);
+            } else {
+                unselected_codes.emplace_back(start + i);
+            }
+        }
+    }
+
+    if (selected_codes.empty()) {
+        // predicate always false, clear scan range.
+        _scan_range = _scan_range.intersection(SparseRange());
+        return false;
+    }
+    if (unselected_codes.empty()) {
+        preds->resize(1);
+        if (!field->is_nullable()) {
+            // predicate always true, clear this predicate.
+            preds->clear();
+        } else {
+            // convert this predicate to `not null` predicate.
+            auto ptr = new_column_null_predicate(get_type_info(OLAP_FIELD_TYPE_VARCHAR), cid, false);
+            (*preds)[0] = _obj_pool.add(ptr);
+        }
+        return false;
+    }
+
+    // the smaller one of the codes selected and the codes filtered out is used.
+    const bool selected = selected_codes.size() <= unselected_codes.size();
+    const std::vector<int>& codewords = selected ? selected_codes : unselected_codes;
+    std::vector<std::string> str_codewords;
+    str_codewords.reserve(codewords.size());
+    for (int code : codewords) {
+        str_codewords.emplace_back(std::to_string(code));
+    }
+    ColumnPredicate* ptr;
+    if (codewords.size() == 1) {
+        ptr = selected ? new_column_eq_predicate(get_type_info(kDictCodeType), cid, str_codewords[0])
+                       : new_column_ne_predicate(get_type_info(kDictCodeType), cid, str_codewords[0]);
+    } else {
+        ptr = selected ? new_column_in_predicate(get_type_info(kDictCodeType), cid, str_codewords)
+                       : new_column_not_in_predicate(get_type_info(kDictCodeType), cid, str_codewords);
+    }
+    preds->resize(1);
+    (*preds)[0] = _obj_pool.add(ptr);
+    return true;
+}
+
 Status SegmentIterator::_decode_dict_codes(ScanContext* ctx) {
     DCHECK_NE(ctx->_read_chunk, ctx->_dict_chunk);
     const Schema& decode_schema = ctx->_dict_decode_schema;
@@ -1060,6 +1449,16 @@ Status SegmentIterator::_decode_dict_codes(ScanContext* ctx) {
             ColumnPtr& dict_values = ctx->_dict_chunk->get_column_by_index(i);
             dict_values->resize(0);
 
+            if (_global_dicts[cid] != nullptr) {
+                if (ctx->_read_schema.field(i)->type()->type() == kDictCodeType) {
+                    RETURN_IF_ERROR(_translate_dict_codes(cid, *dict_codes, dict_values.get()));
+                } else {
+                    RETURN_IF_ERROR(_global_dicts[cid]->encode(*dict_codes, dict_values.get()));
+                }
+                DCHECK_EQ(dict_codes->size(), dict_values->size());
+                continue;
+            }
+
             RETURN_IF_ERROR(_column_iterators[cid]->decode_dict_codes(*dict_codes, dict_values.get()));
             DCHECK_EQ(dict_codes->size(), dict_values->size());
             may_has_del_row |= (dict_values->delete_state() != DEL_NOT_SATISFIED);
@@ -1075,6 +1474,62 @@ Status SegmentIterator::_decode_dict_codes(ScanContext* ctx) {
     return Status::OK();
 }
 
+Status SegmentIterator::_translate_dict_codes(ColumnId cid, const Column& codes, Column* ids) {
+    const auto& code_data = down_cast<const Int32Column*>(ColumnHelper::get_data_column(&codes))->get_data();
+    const uint8_t* nulls = nullptr;
+    if (codes.is_nullable()) {
+        nulls = down_cast<const NullableColumn*>(&codes)->immutable_null_column_data().data();
+    }
+    const size_t num_rows = codes.size();
+    std::vector<DictId>& global_ids = _local_to_global_ids[cid];
+
+    // decode the codes not translated yet once, and look up their words in the global dict.
+    std::vector<int32_t> new_codes;
+    for (size_t i = 0; i < num_rows; i++) {
+        if (nulls != nullptr && nulls[i]) {
+            continue;
+        }
+        const int32_t code = code_data[i];
+        DCHECK_GE(code, 0);
+        if (static_cast<size_t>(code) >= global_ids.size()) {
+            global_ids.resize(code + 1, -1);
+        }
+        if (global_ids[code] == -1) {
+            // mark it, so that it's decoded only once.
+            global_ids[code] = -2;
+            new_codes.emplace_back(code);
+        }
+    }
+    if (!new_codes.empty()) {
+        auto words = BinaryColumn::create();
+        RETURN_IF_ERROR(_column_iterators[cid]->decode_dict_codes(new_codes.data(), new_codes.size(), words.get()));
+        for (size_t i = 0; i < new_codes.size(); i++) {
+            const Slice word = words->get_slice(i);
+            DictId id = _global_dicts[cid]->lookup(word);
+            if (UNLIKELY(id < 0)) {
+                // keep the codes untranslated, since the ids are invalid.
+                for (int32_t code : new_codes) {
+                    global_ids[code] = -1;
+                }
+                return Status::InternalError(word.to_string() + " is not in the global dict");
+            }
+            global_ids[new_codes[i]] = id;
+        }
+    }
+
+    auto& id_data = down_cast<Int32Column*>(ColumnHelper::get_data_column(ids))->get_data();
+    id_data.resize(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        id_data[i] = (nulls != nullptr && nulls[i]) ? 0 : global_ids[code_data[i]];
+    }
+    if (nulls != nullptr) {
+        auto* nullable_ids = down_cast<NullableColumn*>(ids);
+        nullable_ids->null_column_data().assign(nulls, nulls + num_rows);
+        nullable_ids->update_has_null();
+    }
+    return Status::OK();
+}
+
 void SegmentIterator::_check_low_cardinality_optimization() {
     DCHECK_EQ(_predicate_columns, _opts.predicates.size());
     _predicate_need_rewrite.resize(1 + ChunkHelper::max_column_id(_schema), false);
@@ -1089,12 +1544,22 @@ void SegmentIterator::_check_low_cardinality_optimization() {
         auto iter = _opts.predicates.find(cid);
         DCHECK(iter != _opts.predicates.end());
         const PredicateList& preds = iter->second;
-        if (preds.size() != 1) {
+        if (preds.empty()) {
             continue;
         }
+        // The predicates comparing the values are evaluated on the dict words once, and rewritten into the
+        // predicates on the dict codes, see `_rewrite_predicate`. The nulls never satisfy them.
+        // The contains predicates pushed down by LIKE are only index filters, but they're exact on the words,
+        // so they're rewritten as well instead of disabling the optimization.
         _predicate_need_rewrite[cid] =
-                preds[0]->type() == PredicateType::kEQ || preds[0]->type() == PredicateType::kInList ||
-                preds[0]->type() == PredicateType::kNE || preds[0]->type() == PredicateType::kNotInList;
+                std::all_of(preds.begin(), preds.end(), [](const ColumnPredicate* pred) {
+                    const PredicateType type = pred->type();
+                    return type == PredicateType::kContains ||
+                           (!pred->is_index_filter_only() &&
+                            (type == PredicateType::kEQ || type == PredicateType::kNE || type == PredicateType::kGT ||
+                             type == PredicateType::kGE || type == PredicateType::kLT || type == PredicateType::kLE ||
+                             type == PredicateType::kInList || type == PredicateType::kNotInList));
+                });
     }
 }
 
@@ -1119,6 +1584,14 @@ Status SegmentIterator::_finish_late_materialization(ScanContext* ctx) {
         col->reserve(ordinals->size());
         col->resize(0);
 
+        if (_global_dicts[cid] != nullptr) {
+            auto words = ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_VARCHAR, f->is_nullable());
+            RETURN_IF_ERROR(_column_iterators[cid]->fetch_values_by_rowid(*ordinals, words.get()));
+            RETURN_IF_ERROR(_global_dicts[cid]->encode(*words, col.get()));
+            DCHECK_EQ(ordinals->size(), col->size());
+            may_has_del_row |= (words->delete_state() != DEL_NOT_SATISFIED);
+            continue;
+        }
         RETURN_IF_ERROR(_column_iterators[cid]->fetch_values_by_rowid(*ordinals, col.get()));
         DCHECK_EQ(ordinals->size(), col->size());
         may_has_del_row |= (col->delete_state() != DEL_NOT_SATISFIED);
@@ -1168,12 +1641,13 @@ Status SegmentIterator::_apply_bitmap_index() {
         size_t cardinality = bitmap_iter->bitmap_nums();
         SparseRange selected(0, cardinality);
         bool has_is_null = false;
+        std::vector<const ColumnPredicate*> seeked_preds;
         for (const ColumnPredicate* pred : pred_list) {
             SparseRange r;
             Status st = pred->seek_bitmap_dictionary(bitmap_iter, &r);
             if (st.ok()) {
                 selected &= r;
-                erased_preds.emplace_back(pred);
+                seeked_preds.emplace_back(pred);
                 has_is_null |= (pred->type() == PredicateType::kIsNull);
             } else if (!st.is_cancelled()) {
                 return st;
@@ -1184,6 +1658,12 @@ Status SegmentIterator::_apply_bitmap_index() {
             _scan_range.clear();
             return Status::OK();
         }
+        // A wide range of a column of many distinct values, without the bit slices, costs more to union the bitmaps
+        // than to evaluate the predicates after the zone maps.
+        if (bitmap_iter->num_bitmaps_to_read(selected) > static_cast<size_t>(config::bitmap_max_read_bitmaps)) {
+            continue;
+        }
+        erased_preds.insert(erased_preds.end(), seeked_preds.begin(), seeked_preds.end());
         if (selected.span_size() < cardinality) {
             bitmap_columns.emplace_back(cid);
             bitmap_ranges.emplace_back(selected);
@@ -1247,6 +1727,27 @@ Status SegmentIterator::_get_row_ranges_by_bloom_filter() {
     return Status::OK();
 }
 
+Status SegmentIterator::_init_read_ahead() {
+    RETURN_IF(_opts.read_ahead_pages <= 0 || _scan_range.empty(), Status::OK());
+    for (ColumnIterator* iter : _column_iterators) {
+        if (iter != nullptr) {
+            RETURN_IF_ERROR(iter->set_read_ahead_range(_scan_range, _opts.read_ahead_pages));
+        }
+    }
+    return Status::OK();
+}
+
+Status SegmentIterator::_get_row_ranges_by_ngram_bloom_filter() {
+    RETURN_IF(_opts.predicates.empty(), Status::OK());
+    size_t prev_size = _scan_range.span_size();
+    for (const auto& [cid, preds] : _opts.predicates) {
+        ColumnIterator* column_iter = _column_iterators[cid];
+        RETURN_IF_ERROR(column_iter->get_row_ranges_by_ngram_bloom_filter(preds, &_scan_range));
+    }
+    _opts.stats->rows_bf_filtered += (prev_size - _scan_range.span_size());
+    return Status::OK();
+}
+
 void SegmentIterator::close() {
     _context_list[0].close();
     _context_list[1].close();
@@ -12,6 +12,8 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
     for (int i = 0; i < num_ranges; ++i) {
         ranges[i].convert_to(&dst->ranges[i], new_types);
     }
+    dst->rowid_range = rowid_range;
+    dst->global_dicts = global_dicts;
 
     // predicates
     for (auto& pair : predicates) {
@@ -26,9 +28,11 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
 
     // delete predicates
     RETURN_IF_ERROR(delete_predicates.convert_to(&dst->delete_predicates, new_types, obj_pool));
+    dst->del_vec = del_vec;
 
     dst->stats = stats;
     dst->use_page_cache = use_page_cache;
+    dst->read_ahead_pages = read_ahead_pages;
     dst->profile = profile;
     return Status::OK();
 }
@@ -2,16 +2,21 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
 #include "column/datum.h"
+#include "runtime/vectorized/global_dict.h"
 #include "storage/fs/fs_util.h"
 #include "storage/vectorized/disjunctive_predicates.h"
+#include "storage/vectorized/runtime_column_predicate.h"
 #include "storage/vectorized/seek_range.h"
 
 namespace starrocks {
 class Condition;
+class DelVector;
+using DelVectorPtr = std::shared_ptr<DelVector>;
 struct OlapReaderStatistics;
 class RuntimeProfile;
 class TabletSchema;
@@ -21,6 +26,8 @@ class OlapMeta;
 namespace starrocks::vectorized {
 
 class ColumnPredicate;
+class MetaAggregates;
+class SparseRange;
 
 class SegmentReadOptions {
 public:
@@ -30,10 +37,28 @@ public:
 
     std::vector<SeekRange> ranges;
 
+    // If set, only the rows in it are read.
+    const SparseRange* rowid_range = nullptr;
+
+    // The columns read as the ids of their global dicts, they have no predicates or delete predicates.
+    const GlobalDicts* global_dicts = nullptr;
+
     std::unordered_map<ColumnId, PredicateList> predicates;
 
+    // Applied to the zone maps of the rows not read yet whenever their bounds are tightened.
+    // They are not converted by `convert_to`, i.e. not applied to the segments of the old formats.
+    RuntimeColumnPredicates runtime_predicates;
+
     DisjunctivePredicates delete_predicates;
 
+    // The rows deleted by the delete predicates materialized, they're skipped without evaluating the predicates.
+    // Unused by the primary key tablets, whose delvecs are got from the update manager.
+    DelVectorPtr del_vec;
+
+    // If set, the segments whose COUNT(*) and MIN/MAX could be answered by the metadata are added to it
+    // instead of being read.
+    MetaAggregates* meta_aggregates = nullptr;
+
     // used for updatable tablet to get delvec
     bool is_primary_keys = false;
     uint64_t tablet_id = 0;
@@ -55,6 +80,8 @@ public:
 
     ReaderType reader_type = READER_QUERY;
     int chunk_size = DEFAULT_CHUNK_SIZE;
+    // The max number of the pages of each column read ahead asynchronously, 0 disables read-ahead.
+    int read_ahead_pages = 0;
 };
 
 } // namespace starrocks::vectorized
@@ -2,15 +2,149 @@
 
 #include "rowset_update_state.h"
 
+#include <algorithm>
+#include <map>
+
+#include "common/config.h"
+#include "env/env.h"
+#include "storage/fs/fs_util.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset.h"
+#include "storage/rowset/segment_v2/column_reader.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/segment_v2/segment_writer.h"
 #include "storage/rowset/vectorized/rowset_options.h"
+#include "storage/rowset/vectorized/segment_options.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_updates.h"
+#include "storage/types.h"
+#include "storage/update_manager.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "util/file_utils.h"
 
 namespace starrocks {
 
 using vectorized::ChunkHelper;
+using vectorized::ColumnPtr;
+
+static vectorized::Schema primary_key_schema(const TabletSchema& schema) {
+    vector<uint32_t> pk_columns;
+    for (size_t i = 0; i < schema.num_key_columns(); i++) {
+        pk_columns.push_back((uint32_t)i);
+    }
+    return vectorized::ChunkHelper::convert_schema_to_format_v2(schema, pk_columns);
+}
+
+// The segments of a partial update are in the partial files until they're rewritten by apply(), which may be
+// interrupted by a crash, so the rewritten ones are opened from the data files. They're opened by the schema of the
+// tablet, the columns not in the files aren't read.
+static Status open_partial_segments(Rowset* rowset, std::vector<segment_v2::SegmentSharedPtr>* segments) {
+    auto block_mgr = fs::fs_util::block_manager();
+    auto mem_tracker = StorageEngine::instance()->update_manager()->mem_tracker();
+    for (int i = 0; i < rowset->num_segments(); i++) {
+        auto path = BetaRowset::segment_partial_file_path(rowset->rowset_path(), rowset->rowset_id(), i);
+        if (!FileUtils::check_exist(path)) {
+            path = BetaRowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), i);
+        }
+        segment_v2::SegmentSharedPtr segment;
+        RETURN_IF_ERROR(segment_v2::Segment::open(mem_tracker, block_mgr, path, i, &rowset->schema(), &segment));
+        segments->emplace_back(std::move(segment));
+    }
+    return Status::OK();
+}
+
+// The value of |column| of the rows of the new keys of a partial update, i.e. the value read for a column added by
+// a schema change, or the zero value of the type if it has no default value and isn't nullable.
+static Status append_default_value(const TabletColumn& column, vectorized::Column* dst) {
+    if (!column.has_default_value() && !column.is_nullable()) {
+        dst->append_default();
+        return Status::OK();
+    }
+    segment_v2::DefaultValueColumnIterator iter(column.has_default_value(), column.default_value(),
+                                                column.is_nullable(), get_type_info(column), column.length(), 1);
+    segment_v2::ColumnIteratorOptions iter_opts;
+    RETURN_IF_ERROR(iter.init(iter_opts));
+    size_t n = 1;
+    return iter.next_batch(&n, dst);
+}
+
+// Write the columns |update_column_ids| of |segment| and the columns |read_column_ids| of |read_columns| into the
+// data file of the segment, through a temporary file so a crash never leaves a half-written data file.
+static Status rewrite_partial_segment(Rowset* rowset, const segment_v2::SegmentSharedPtr& segment,
+                                      const std::vector<uint32_t>& update_column_ids,
+                                      const std::vector<uint32_t>& read_column_ids,
+                                      const std::vector<ColumnPtr>& read_columns) {
+    const auto& tablet_schema = rowset->schema();
+    auto full_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    auto update_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, update_column_ids);
+    uint32_t segment_id = segment->id();
+    auto path = BetaRowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), segment_id);
+    auto tmp_path = BetaRowset::segment_temp_file_path(rowset->rowset_path(), rowset->rowset_id(), segment_id);
+    if (FileUtils::check_exist(tmp_path)) {
+        RETURN_IF_ERROR(Env::Default()->delete_file(tmp_path));
+    }
+
+    std::unique_ptr<fs::WritableBlock> wblock;
+    fs::CreateBlockOptions opts({tmp_path});
+    RETURN_IF_ERROR(fs::fs_util::block_manager()->create_block(opts, &wblock));
+    segment_v2::SegmentWriterOptions writer_options;
+    writer_options.storage_format_version = config::storage_format_version;
+    writer_options.mem_tracker = StorageEngine::instance()->update_manager()->mem_tracker();
+    writer_options.encode_thread_pool = StorageEngine::instance()->segment_encode_thread_pool();
+    segment_v2::SegmentWriter writer(std::move(wblock), segment_id, &tablet_schema, writer_options);
+    RETURN_IF_ERROR(writer.init(config::push_write_mbytes_per_sec));
+
+    size_t offset = 0;
+    if (segment->num_rows() > 0) {
+        OlapReaderStatistics stats;
+        vectorized::SegmentReadOptions seg_options;
+        seg_options.stats = &stats;
+        auto res = segment->new_iterator(update_schema, seg_options);
+        if (!res.ok()) {
+            return res.status();
+        }
+        auto itr = std::move(res).value();
+        auto chunk = ChunkHelper::new_chunk(update_schema, config::vector_chunk_size);
+        auto full_chunk = ChunkHelper::new_chunk(full_schema, config::vector_chunk_size);
+        auto char_field_indexes = ChunkHelper::get_char_field_indexes(full_schema);
+        while (true) {
+            chunk->reset();
+            auto st = itr->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            } else if (!st.ok()) {
+                itr->close();
+                return st;
+            }
+            size_t n = chunk->num_rows();
+            full_chunk->reset();
+            for (size_t i = 0; i < update_column_ids.size(); i++) {
+                full_chunk->get_column_by_index(update_column_ids[i])->append(*chunk->get_column_by_index(i), 0, n);
+            }
+            for (size_t i = 0; i < read_column_ids.size(); i++) {
+                full_chunk->get_column_by_index(read_column_ids[i])->append(*read_columns[i], offset, n);
+            }
+            ChunkHelper::padding_char_columns(char_field_indexes, full_schema, tablet_schema, full_chunk.get());
+            RETURN_IF_ERROR(writer.append_chunk(*full_chunk));
+            offset += n;
+        }
+        itr->close();
+    }
+    if (offset != segment->num_rows()) {
+        return Status::InternalError(Substitute("rewrite partial segment $0: read $1 rows, expect $2",
+                                                segment->file_name(), offset, segment->num_rows()));
+    }
+    uint64_t segment_size = 0;
+    uint64_t index_size = 0;
+    RETURN_IF_ERROR(writer.finalize(&segment_size, &index_size));
+    RETURN_IF_ERROR(Env::Default()->rename_file(tmp_path, path));
+    if (segment->file_name() != path) {
+        RETURN_IF_ERROR(Env::Default()->delete_file(segment->file_name()));
+    }
+    return Status::OK();
+}
 
 RowsetUpdateState::RowsetUpdateState() {}
 
@@ -28,12 +162,7 @@ Status RowsetUpdateState::load(int64_t tablet_id, Rowset* rowset) {
 }
 
 Status RowsetUpdateState::_do_load(Rowset* rowset) {
-    auto& schema = rowset->schema();
-    vector<uint32_t> pk_columns;
-    for (size_t i = 0; i < schema.num_key_columns(); i++) {
-        pk_columns.push_back((uint32_t)i);
-    }
-    vectorized::Schema pkey_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(schema, pk_columns);
+    vectorized::Schema pkey_schema = primary_key_schema(rowset->schema());
     std::unique_ptr<vectorized::Column> pk_column;
     if (!PrimaryKeyEncoder::create_column(pkey_schema, &pk_column).ok()) {
         CHECK(false) << "create column for primary key encoder failed";
@@ -59,12 +188,39 @@ Status RowsetUpdateState::_do_load(Rowset* rowset) {
     RowsetReleaseGuard guard(rowset->shared_from_this());
     OlapReaderStatistics stats;
     auto beta_rowset = down_cast<BetaRowset*>(rowset);
-    auto res = beta_rowset->get_segment_iterators2(pkey_schema, NULL, 0, &stats);
-    if (!res.ok()) {
-        return res.status();
+    std::vector<vectorized::ChunkIteratorPtr> itrs;
+    std::vector<uint32_t> segment_rows;
+    if (rowset->rowset_meta()->is_partial_update()) {
+        // the rowset isn't loaded before the segments are rewritten
+        std::vector<segment_v2::SegmentSharedPtr> segments;
+        RETURN_IF_ERROR(open_partial_segments(rowset, &segments));
+        vectorized::SegmentReadOptions seg_options;
+        seg_options.stats = &stats;
+        for (const auto& segment : segments) {
+            segment_rows.push_back(segment->num_rows());
+            itrs.emplace_back(nullptr);
+            if (segment->num_rows() == 0) {
+                continue;
+            }
+            auto res = segment->new_iterator(pkey_schema, seg_options);
+            if (res.status().is_end_of_file()) {
+                continue;
+            } else if (!res.ok()) {
+                return res.status();
+            }
+            itrs.back() = std::move(res).value();
+        }
+    } else {
+        auto res = beta_rowset->get_segment_iterators2(pkey_schema, NULL, 0, &stats);
+        if (!res.ok()) {
+            return res.status();
+        }
+        itrs = std::move(res).value();
+        for (const auto& segment : beta_rowset->segments()) {
+            segment_rows.push_back(segment->num_rows());
+        }
     }
     // TODO(cbl): auto close iterators on failure
-    auto& itrs = res.value();
     CHECK(itrs.size() == rowset->num_segments()) << "itrs.size != num_segments";
     _upserts.resize(rowset->num_segments());
     // only hold pkey, so can use larger chunk size
@@ -77,7 +233,7 @@ Status RowsetUpdateState::_do_load(Rowset* rowset) {
         }
         auto& dest = _upserts[i];
         auto col = pk_column->clone();
-        auto num_rows = beta_rowset->segments()[i]->num_rows();
+        auto num_rows = segment_rows[i];
         col->reserve(num_rows);
         while (true) {
             chunk->reset();
@@ -103,6 +259,135 @@ Status RowsetUpdateState::_do_load(Rowset* rowset) {
     return Status::OK();
 }
 
+Status RowsetUpdateState::apply(Tablet* tablet, Rowset* rowset, const PrimaryIndex& index) {
+    if (!rowset->rowset_meta()->is_partial_update()) {
+        return Status::OK();
+    }
+    const auto& tablet_schema = rowset->schema();
+    const auto& txn_meta = rowset->rowset_meta()->txn_meta();
+    // the columns are located by the unique ids, which are kept by the schema changes
+    std::vector<bool> updated(tablet_schema.num_columns(), false);
+    std::vector<uint32_t> update_column_ids;
+    for (auto unique_id : txn_meta.partial_update_column_unique_ids()) {
+        uint32_t cid = 0;
+        while (cid < tablet_schema.num_columns() && tablet_schema.column(cid).unique_id() != unique_id) {
+            cid++;
+        }
+        if (cid == tablet_schema.num_columns()) {
+            return Status::InternalError(
+                    Substitute("partial update column $0 not in tablet $1", unique_id, tablet->tablet_id()));
+        }
+        updated[cid] = true;
+        update_column_ids.push_back(cid);
+    }
+    std::vector<uint32_t> read_column_ids;
+    for (uint32_t cid = 0; cid < tablet_schema.num_columns(); cid++) {
+        if (!updated[cid]) {
+            read_column_ids.push_back(cid);
+        }
+    }
+
+    std::vector<segment_v2::SegmentSharedPtr> segments;
+    RETURN_IF_ERROR(open_partial_segments(rowset, &segments));
+    if (segments.size() != _upserts.size()) {
+        return Status::InternalError(Substitute("partial update rowset $0 has $1 segments, $2 loaded",
+                                                rowset->rowset_id().to_string(), segments.size(), _upserts.size()));
+    }
+    // the keys of the previous segments of this rowset, by the segment ids
+    PrimaryIndex rowset_index(primary_key_schema(tablet_schema));
+    // the values of the missing columns of each segment, kept for the later segments updating the same keys
+    std::vector<std::vector<ColumnPtr>> filled_columns(segments.size());
+    for (uint32_t i = 0; i < segments.size(); i++) {
+        RETURN_IF_ERROR(_fill_partial_columns(tablet, tablet_schema, read_column_ids, index, rowset_index, i,
+                                              filled_columns, &filled_columns[i]));
+        RETURN_IF_ERROR(rewrite_partial_segment(rowset, segments[i], update_column_ids, read_column_ids,
+                                                filled_columns[i]));
+        if (_upserts[i] != nullptr) {
+            PrimaryIndex::DeletesMap deletes;
+            rowset_index.upsert(i, 0, *_upserts[i], &deletes);
+        }
+    }
+    LOG(INFO) << "apply partial update tablet:" << tablet->tablet_id() << " rowset:" << rowset->rowset_id()
+              << " segments:" << segments.size() << " updated columns:" << update_column_ids.size()
+              << " filled columns:" << read_column_ids.size();
+    return Status::OK();
+}
+
+Status RowsetUpdateState::_fill_partial_columns(Tablet* tablet, const TabletSchema& tablet_schema,
+                                                const std::vector<uint32_t>& read_column_ids,
+                                                const PrimaryIndex& index, const PrimaryIndex& rowset_index,
+                                                uint32_t segment_id,
+                                                const std::vector<std::vector<ColumnPtr>>& filled_columns,
+                                                std::vector<ColumnPtr>* columns) {
+    auto full_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    columns->resize(read_column_ids.size());
+    for (size_t i = 0; i < read_column_ids.size(); i++) {
+        (*columns)[i] = ChunkHelper::column_from_field(*full_schema.field(read_column_ids[i]));
+    }
+    const auto& pks = _upserts[segment_id];
+    if (pks == nullptr || pks->empty() || read_column_ids.empty()) {
+        return Status::OK();
+    }
+    size_t num_rows = pks->size();
+    std::vector<uint64_t> old_rowids;
+    index.get(*pks, &old_rowids);
+    std::vector<uint64_t> new_rowids;
+    rowset_index.get(*pks, &new_rowids);
+    // (position, row) of the rows updated from the rows before this rowset, or the previous segments of it
+    std::vector<std::pair<uint64_t, uint32_t>> old_rows;
+    std::vector<std::pair<uint64_t, uint32_t>> new_rows;
+    for (uint32_t i = 0; i < num_rows; i++) {
+        if (new_rowids[i] != PrimaryIndex::NullIndexValue) {
+            new_rows.emplace_back(new_rowids[i], i);
+        } else if (old_rowids[i] != PrimaryIndex::NullIndexValue) {
+            old_rows.emplace_back(old_rowids[i], i);
+        }
+    }
+    // the rowids of a segment are read in order
+    std::sort(old_rows.begin(), old_rows.end());
+    std::sort(new_rows.begin(), new_rows.end());
+
+    // The source of the values: the default value, the old values, and then the values of the previous segments.
+    std::vector<ColumnPtr> sources(read_column_ids.size());
+    for (size_t i = 0; i < read_column_ids.size(); i++) {
+        sources[i] = (*columns)[i]->clone_empty();
+        RETURN_IF_ERROR(append_default_value(tablet_schema.column(read_column_ids[i]), sources[i].get()));
+    }
+    std::vector<uint32_t> source_idxes(num_rows, 0);
+    uint32_t next_idx = 1;
+    if (!old_rows.empty()) {
+        std::map<uint32_t, std::vector<uint32_t>> rowids_by_rssid;
+        for (const auto& [pos, row] : old_rows) {
+            rowids_by_rssid[(uint32_t)(pos >> 32)].push_back((uint32_t)(pos & 0xffffffff));
+            source_idxes[row] = next_idx++;
+        }
+        RETURN_IF_ERROR(tablet->updates()->get_column_values(read_column_ids, rowids_by_rssid, &sources));
+    }
+    for (size_t start = 0; start < new_rows.size();) {
+        uint32_t prev_segment = (uint32_t)(new_rows[start].first >> 32);
+        std::vector<uint32_t> rowids;
+        size_t end = start;
+        for (; end < new_rows.size() && (uint32_t)(new_rows[end].first >> 32) == prev_segment; end++) {
+            rowids.push_back((uint32_t)(new_rows[end].first & 0xffffffff));
+            source_idxes[new_rows[end].second] = next_idx++;
+        }
+        for (size_t i = 0; i < read_column_ids.size(); i++) {
+            sources[i]->append_selective(*filled_columns[prev_segment][i], rowids.data(), 0, rowids.size());
+        }
+        start = end;
+    }
+    for (size_t i = 0; i < read_column_ids.size(); i++) {
+        if (sources[i]->size() != next_idx) {
+            return Status::InternalError(Substitute("partial update of tablet $0: read $1 values of column $2, "
+                                                    "expect $3",
+                                                    tablet->tablet_id(), sources[i]->size(), read_column_ids[i],
+                                                    next_idx));
+        }
+        (*columns)[i]->append_selective(*sources[i], source_idxes.data(), 0, num_rows);
+    }
+    return Status::OK();
+}
+
 std::string RowsetUpdateState::to_string() const {
     return Substitute("RowsetUpdateState tablet:$0", _tablet_id);
 }
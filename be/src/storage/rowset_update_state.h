@@ -14,6 +14,7 @@ class Rowset;
 using RowsetSharedPtr = std::shared_ptr<Rowset>;
 class Tablet;
 class TabletMeta;
+class TabletSchema;
 using TabletSharedPtr = std::shared_ptr<Tablet>;
 
 class RowsetUpdateState {
@@ -25,6 +26,13 @@ public:
 
     Status load(int64_t tablet_id, Rowset* rowset);
 
+    // Rewrite the segments of a partial update into the segments of all the columns, the missing columns of a row
+    // are filled by the values of the row of the same key located by |index|, i.e. the latest row before this
+    // rowset, or by the ones of the previous segments of this rowset, or by the default values for the new keys.
+    // It must be called when the rowset is applied, before its keys are upserted into |index|. It's a no-op for
+    // the other rowsets.
+    Status apply(Tablet* tablet, Rowset* rowset, const PrimaryIndex& index);
+
     const std::vector<ColumnUniquePtr>& upserts() const { return _upserts; }
     const std::vector<ColumnUniquePtr>& deletes() const { return _deletes; }
 
@@ -35,6 +43,13 @@ public:
 private:
     Status _do_load(Rowset* rowset);
 
+    // Fill the columns |read_column_ids| of the rows of segment |segment_id| into |columns|.
+    Status _fill_partial_columns(Tablet* tablet, const TabletSchema& tablet_schema,
+                                 const std::vector<uint32_t>& read_column_ids, const PrimaryIndex& index,
+                                 const PrimaryIndex& rowset_index, uint32_t segment_id,
+                                 const std::vector<std::vector<vectorized::ColumnPtr>>& filled_columns,
+                                 std::vector<vectorized::ColumnPtr>* columns);
+
     std::once_flag _load_once_flag;
     Status _status;
     // one for each segment file
@@ -25,9 +25,18 @@
 #include <util/defer_op.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <vector>
 
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/datum_convert.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/exec_env.h"
 #include "runtime/heartbeat_flags.h"
 #include "runtime/mem_pool.h"
@@ -41,7 +50,9 @@
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_updates.h"
+#include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/convert_helper.h"
+#include "storage/vectorized/reader.h"
 #include "storage/wrapper_field.h"
 #include "util/unaligned_access.h"
 
@@ -757,6 +768,189 @@ bool RowBlockChanger::change_row_block(const RowBlock* ref_block, int32_t data_v
 #undef TYPE_REINTERPRET_CAST
 #undef ASSIGN_DEFAULT_VALUE
 
+template <typename FromType, typename ToType>
+static void cast_column(const vectorized::Column& src, vectorized::Column* dst) {
+    const auto& src_data = down_cast<const vectorized::FixedLengthColumn<FromType>&>(src).get_data();
+    auto& dst_data = down_cast<vectorized::FixedLengthColumn<ToType>*>(dst)->get_data();
+    const size_t offset = dst_data.size();
+    dst_data.resize(offset + src_data.size());
+    for (size_t i = 0; i < src_data.size(); i++) {
+        dst_data[offset + i] = static_cast<ToType>(src_data[i]);
+    }
+}
+
+using CastColumnFunc = void (*)(const vectorized::Column& src, vectorized::Column* dst);
+
+template <typename FromType>
+static CastColumnFunc get_cast_func(FieldType to_type) {
+    switch (to_type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+        return cast_column<FromType, int8_t>;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        return cast_column<FromType, int16_t>;
+    case OLAP_FIELD_TYPE_INT:
+        return cast_column<FromType, int32_t>;
+    case OLAP_FIELD_TYPE_BIGINT:
+        return cast_column<FromType, int64_t>;
+    case OLAP_FIELD_TYPE_LARGEINT:
+        return cast_column<FromType, int128_t>;
+    case OLAP_FIELD_TYPE_DOUBLE:
+        return cast_column<FromType, double>;
+    default:
+        return nullptr;
+    }
+}
+
+// The unsigned integers aren't supported by the chunks, so only the signed ones of CONVERT_FROM_TYPE are cast.
+static CastColumnFunc get_cast_func(FieldType from_type, FieldType to_type) {
+    switch (from_type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+        return get_cast_func<int8_t>(to_type);
+    case OLAP_FIELD_TYPE_SMALLINT:
+        return get_cast_func<int16_t>(to_type);
+    case OLAP_FIELD_TYPE_INT:
+        return get_cast_func<int32_t>(to_type);
+    case OLAP_FIELD_TYPE_BIGINT:
+        return get_cast_func<int64_t>(to_type);
+    default:
+        return nullptr;
+    }
+}
+
+// Convert the non-null values of |src| into |dst|, the data column of the new column, and leave the null ones zero.
+static Status convert_column(const vectorized::TypeConverter* converter, const vectorized::Column& src,
+                             vectorized::Column* dst) {
+    const vectorized::Column* src_data = vectorized::ColumnHelper::get_data_column(&src);
+    const size_t num_rows = src.size();
+    const size_t offset = dst->size();
+    dst->resize(offset + num_rows);
+    uint8_t* dst_ptr = dst->mutable_raw_data() + offset * dst->type_size();
+    for (size_t i = 0; i < num_rows; i++, dst_ptr += dst->type_size()) {
+        if (src.is_null(i)) {
+            continue;
+        }
+        if (src_data->is_binary()) {
+            Slice slice = down_cast<const vectorized::BinaryColumn*>(src_data)->get_slice(i);
+            RETURN_IF_ERROR(converter->convert(dst_ptr, &slice, nullptr));
+        } else {
+            RETURN_IF_ERROR(converter->convert(dst_ptr, src_data->raw_data() + i * src_data->type_size(), nullptr));
+        }
+    }
+    return Status::OK();
+}
+
+ChunkChanger::ChunkChanger(const TabletSchema& base_schema, const TabletSchema& new_schema,
+                           const SchemaMapping& schema_mapping)
+        : _base_tablet_schema(base_schema),
+          _new_tablet_schema(new_schema),
+          _schema_mapping(schema_mapping),
+          _base_schema(vectorized::ChunkHelper::convert_schema_to_format_v2(base_schema)),
+          _new_schema(vectorized::ChunkHelper::convert_schema_to_format_v2(new_schema)) {}
+
+bool ChunkChanger::init() {
+    _changes.resize(_schema_mapping.size());
+    for (size_t i = 0; i < _schema_mapping.size(); i++) {
+        if (!_init_column_change(i, &_changes[i])) {
+            VLOG(3) << "column " << _new_tablet_schema.column(i).name() << " can't be changed by the chunks";
+            return false;
+        }
+    }
+    return true;
+}
+
+// The same order of the cases as RowBlockChanger::change_row_block.
+bool ChunkChanger::_init_column_change(size_t column_index, ColumnChange* change) {
+    const ColumnMapping& mapping = _schema_mapping[column_index];
+    const TabletColumn& new_column = _new_tablet_schema.column(column_index);
+    const vectorized::Field& new_field = *_new_schema.field(column_index);
+    change->ref_column = mapping.ref_column;
+    if (mapping.ref_column < 0) {
+        change->default_column = vectorized::ChunkHelper::column_from_field(new_field);
+        if (mapping.default_value == nullptr || mapping.default_value->is_null()) {
+            return change->default_column->append_nulls(1);
+        }
+        MemTracker tracker;
+        MemPool mem_pool(&tracker);
+        vectorized::Datum datum;
+        const std::string& value = new_column.default_value();
+        if (!vectorized::datum_from_string(new_field.type().get(), &datum, value, &mem_pool).ok()) {
+            return false;
+        }
+        change->default_column->append_datum(datum);
+        return true;
+    }
+    if (!mapping.materialized_function.empty()) {
+        return false;
+    }
+
+    const TabletColumn& ref_column = _base_tablet_schema.column(mapping.ref_column);
+    const vectorized::Field& ref_field = *_base_schema.field(mapping.ref_column);
+    FieldType reftype = ref_column.type();
+    FieldType newtype = new_column.type();
+    if (newtype == reftype) {
+        // The decimals of different precisions or scales are converted by convert_from() of the row cursors.
+        return !is_decimalv3_field_type(newtype) ||
+               (ref_column.precision() == new_column.precision() && ref_column.scale() == new_column.scale());
+    }
+    if (newtype == OLAP_FIELD_TYPE_VARCHAR && reftype == OLAP_FIELD_TYPE_CHAR) {
+        // The trailing zeros of the CHARs are removed by the reader already.
+        return true;
+    }
+    if (ConvertTypeResolver::instance()->get_convert_type_info(reftype, newtype)) {
+        change->converter = vectorized::get_type_converter(ref_field.type()->type(), new_field.type()->type());
+        return change->converter != nullptr;
+    }
+    if (ref_field.type()->type() == new_field.type()->type()) {
+        // DATE to DATE_V2, DECIMAL to DECIMAL_V2 and so on, they're the same in the format v2 chunks.
+        return true;
+    }
+    change->cast = get_cast_func(reftype, newtype);
+    return change->cast != nullptr;
+}
+
+Status ChunkChanger::change_chunk(const vectorized::Chunk& base_chunk, vectorized::Chunk* new_chunk) const {
+    const size_t num_rows = base_chunk.num_rows();
+    for (size_t i = 0; i < _changes.size(); i++) {
+        const ColumnChange& change = _changes[i];
+        vectorized::Column* dst = new_chunk->get_column_by_index(i).get();
+        if (change.ref_column < 0) {
+            dst->append_value_multiple_times(*change.default_column, 0, num_rows);
+            continue;
+        }
+        const vectorized::Column& src = *base_chunk.get_column_by_index(change.ref_column);
+        if (src.is_nullable() && !dst->is_nullable() && src.has_null()) {
+            return Status::InvalidArgument(
+                    strings::Substitute("null values of column $0 can't be changed into not null column $1",
+                                        _base_schema.field(change.ref_column)->name(), _new_schema.field(i)->name()));
+        }
+        if (change.converter == nullptr && change.cast == nullptr) {
+            if (src.is_nullable() && !dst->is_nullable()) {
+                dst->append(*down_cast<const vectorized::NullableColumn&>(src).data_column());
+            } else {
+                dst->append(src);
+            }
+            continue;
+        }
+        if (dst->is_nullable()) {
+            auto* nullable_dst = down_cast<vectorized::NullableColumn*>(dst);
+            vectorized::NullColumn* null_column = nullable_dst->mutable_null_column();
+            if (src.is_nullable()) {
+                null_column->append(*down_cast<const vectorized::NullableColumn&>(src).null_column());
+            } else {
+                null_column->resize(null_column->size() + num_rows);
+            }
+            nullable_dst->update_has_null();
+        }
+        vectorized::Column* dst_data = vectorized::ColumnHelper::get_data_column(dst);
+        if (change.cast != nullptr) {
+            change.cast(*vectorized::ColumnHelper::get_data_column(&src), dst_data);
+        } else {
+            RETURN_IF_ERROR(convert_column(change.converter, src, dst_data));
+        }
+    }
+    return Status::OK();
+}
+
 RowBlockSorter::RowBlockSorter(RowBlockAllocator* row_block_allocator)
         : _row_block_allocator(row_block_allocator), _swap_row_block(nullptr) {}
 
@@ -1794,6 +1988,17 @@ OLAPStatus SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangePa
         goto PROCESS_ALTER_EXIT;
     }
 
+    if (sc_directly && !sc_sorting && config::enable_vectorized_schema_change && _can_convert_by_chunks(sc_params)) {
+        ChunkChanger chunk_changer(sc_params.base_tablet->tablet_schema(), sc_params.new_tablet->tablet_schema(),
+                                   rb_changer.get_schema_mapping());
+        if (chunk_changer.init()) {
+            LOG(INFO) << "doing vectorized schema change directly for base_tablet "
+                      << sc_params.base_tablet->full_name();
+            res = _convert_historical_rowsets_by_chunks(sc_params, chunk_changer, end_version);
+            goto PROCESS_ALTER_EXIT;
+        }
+    }
+
     // b. create converter for history data
     if (sc_sorting) {
         size_t memory_limitation = config::memory_limitation_per_thread_for_schema_change;
@@ -1912,6 +2117,168 @@ PROCESS_ALTER_EXIT : {
     return res;
 }
 
+// Read |rowset| of |base_tablet| in the order of the keys, change the chunks and add them into |rowset_writer|. The
+// rows deleted by the delete predicates of the versions up to |end_version| are filtered by the reader.
+static Status change_rowset_chunks(const TabletSharedPtr& base_tablet, const TabletSharedPtr& new_tablet,
+                                   const ChunkChanger& chunk_changer, const RowsetSharedPtr& rowset,
+                                   int64_t end_version, RowsetWriter* rowset_writer) {
+    RowsetReleaseGuard guard(rowset);
+    RETURN_IF_ERROR(rowset->load());
+
+    vectorized::Reader reader(chunk_changer.base_schema());
+    vectorized::ReaderParams params;
+    params.tablet = base_tablet;
+    params.reader_type = READER_ALTER_TABLE;
+    params.version = Version(0, end_version);
+    params.rowsets.push_back(rowset);
+    params.chunk_size = config::vector_chunk_size;
+    RETURN_IF_ERROR(reader.init(params));
+
+    auto base_chunk = vectorized::ChunkHelper::new_chunk(chunk_changer.base_schema(), params.chunk_size);
+    auto new_chunk = vectorized::ChunkHelper::new_chunk(chunk_changer.new_schema(), params.chunk_size);
+    auto char_field_indexes = vectorized::ChunkHelper::get_char_field_indexes(chunk_changer.new_schema());
+    while (true) {
+        base_chunk->reset();
+        Status st = reader.get_next(base_chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(st);
+        new_chunk->reset();
+        RETURN_IF_ERROR(chunk_changer.change_chunk(*base_chunk, new_chunk.get()));
+        vectorized::ChunkHelper::padding_char_columns(char_field_indexes, chunk_changer.new_schema(),
+                                                      new_tablet->tablet_schema(), new_chunk.get());
+        if (rowset_writer->add_chunk(*new_chunk) != OLAP_SUCCESS) {
+            return Status::InternalError("failed to add chunk to rowset writer");
+        }
+    }
+
+    // Check row num changes
+    uint64_t merged_rows = reader.merged_rows();
+    uint64_t filtered_rows = reader.stats().rows_del_filtered;
+    LOG(INFO) << "all row nums. source_rows=" << rowset->num_rows() << ", merged_rows=" << merged_rows
+              << ", filtered_rows=" << filtered_rows << ", new_index_rows=" << rowset_writer->num_rows();
+    if (config::row_nums_check && rowset->num_rows() != rowset_writer->num_rows() + merged_rows + filtered_rows) {
+        return Status::InternalError(
+                strings::Substitute("row num of rowset $0 mismatched", rowset->rowset_id().to_string()));
+    }
+    return Status::OK();
+}
+
+bool SchemaChangeHandler::_can_convert_by_chunks(const SchemaChangeParams& sc_params) {
+    if (sc_params.new_tablet->tablet_meta()->preferred_rowset_type() != BETA_ROWSET) {
+        return false;
+    }
+    for (auto& rs_reader : sc_params.ref_rowset_readers) {
+        if (rs_reader->rowset()->rowset_meta()->rowset_type() != BETA_ROWSET) {
+            return false;
+        }
+    }
+    return true;
+}
+
+OLAPStatus SchemaChangeHandler::_convert_historical_rowsets_by_chunks(const SchemaChangeParams& sc_params,
+                                                                      const ChunkChanger& chunk_changer,
+                                                                      int64_t end_version) {
+    const auto& rs_readers = sc_params.ref_rowset_readers;
+    std::atomic<size_t> next_rowset{0};
+    std::atomic<bool> failed{false};
+    auto convert_rowsets = [&]() {
+        while (!failed.load()) {
+            size_t i = next_rowset.fetch_add(1);
+            if (i >= rs_readers.size()) {
+                break;
+            }
+            if (_convert_rowset_by_chunks(sc_params, chunk_changer, rs_readers[i]->rowset(), end_version) !=
+                OLAP_SUCCESS) {
+                failed.store(true);
+            }
+        }
+    };
+    size_t num_threads = std::min<size_t>(std::max(1, config::schema_change_max_parallel_rowsets), rs_readers.size());
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 1; i < num_threads; i++) {
+        threads.emplace_back(convert_rowsets);
+    }
+    convert_rowsets();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return failed.load() ? OLAP_ERR_INPUT_PARAMETER_ERROR : OLAP_SUCCESS;
+}
+
+OLAPStatus SchemaChangeHandler::_convert_rowset_by_chunks(const SchemaChangeParams& sc_params,
+                                                          const ChunkChanger& chunk_changer,
+                                                          const RowsetSharedPtr& rowset, int64_t end_version) {
+    const TabletSharedPtr& new_tablet = sc_params.new_tablet;
+    VLOG(10) << "begin to convert a history rowset by chunks. version=" << rowset->start_version() << "-"
+             << rowset->end_version();
+
+    RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
+    writer_context.mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
+    writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+    writer_context.tablet_uid = new_tablet->tablet_uid();
+    writer_context.tablet_id = new_tablet->tablet_id();
+    writer_context.partition_id = new_tablet->partition_id();
+    writer_context.tablet_schema_hash = new_tablet->schema_hash();
+    writer_context.rowset_type = BETA_ROWSET;
+    writer_context.rowset_path_prefix = new_tablet->tablet_path();
+    writer_context.tablet_schema = &(new_tablet->tablet_schema());
+    writer_context.rowset_state = VISIBLE;
+    writer_context.version = rowset->version();
+    writer_context.version_hash = rowset->version_hash();
+    writer_context.segments_overlap = rowset->rowset_meta()->segments_overlap();
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    if (RowsetFactory::create_rowset_writer(writer_context, &rowset_writer) != OLAP_SUCCESS) {
+        return OLAP_ERR_ROWSET_BUILDER_INIT;
+    }
+    DeferOp remove_pending_ids([&] {
+        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
+    });
+
+    Status st = Status::OK();
+    if (!rowset->empty() && rowset->num_rows() > 0) {
+        st = change_rowset_chunks(sc_params.base_tablet, new_tablet, chunk_changer, rowset, end_version,
+                                  rowset_writer.get());
+    }
+    if (st.ok() && rowset_writer->flush() != OLAP_SUCCESS) {
+        st = Status::InternalError("failed to flush rowset writer");
+    }
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to convert rowset by chunks. version=" << rowset->start_version() << "-"
+                     << rowset->end_version() << ", new_tablet=" << new_tablet->full_name()
+                     << ", status=" << st.to_string();
+        return OLAP_ERR_INPUT_PARAMETER_ERROR;
+    }
+
+    // The rowsets are converted concurrently, so are added one at a time under the push lock of the new tablet.
+    std::lock_guard push_lock(new_tablet->get_push_lock());
+    RowsetSharedPtr new_rowset = rowset_writer->build();
+    if (new_rowset == nullptr) {
+        LOG(WARNING) << "failed to build rowset, exit alter process";
+        return OLAP_ERR_MALLOC_ERROR;
+    }
+    OLAPStatus res = new_tablet->add_rowset(new_rowset, false);
+    if (res == OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+        LOG(WARNING) << "version already exist, version revert occured. "
+                     << "tablet=" << new_tablet->full_name() << ", version='" << rowset->start_version() << "-"
+                     << rowset->end_version();
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+        res = OLAP_SUCCESS;
+    } else if (res != OLAP_SUCCESS) {
+        LOG(WARNING) << "failed to register new version. "
+                     << " tablet=" << new_tablet->full_name() << ", version=" << rowset->start_version() << "-"
+                     << rowset->end_version();
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+    } else {
+        VLOG(3) << "register new version. tablet=" << new_tablet->full_name() << ", version=" << rowset->start_version()
+                << "-" << rowset->end_version();
+    }
+    return res;
+}
+
 // @static
 OLAPStatus SchemaChangeHandler::_parse_request(
         TabletSharedPtr base_tablet, TabletSharedPtr new_tablet, RowBlockChanger* rb_changer, bool* sc_sorting,
@@ -26,6 +26,8 @@
 #include <queue>
 #include <vector>
 
+#include "column/schema.h"
+#include "column/vectorized_fwd.h"
 #include "gen_cpp/AgentService_types.h"
 #include "storage/column_mapping.h"
 #include "storage/delete_handler.h"
@@ -76,6 +78,53 @@ private:
     DISALLOW_COPY_AND_ASSIGN(RowBlockChanger);
 };
 
+namespace vectorized {
+class TypeConverter;
+}
+
+// ChunkChanger changes the chunks of the base tablet, read by the vectorized reader, into the chunks of the new
+// tablet, a column at a time. It supports the same mappings as RowBlockChanger except the materialized view
+// functions and the type conversions that have no vectorized converter, init() returns false for them and the
+// schema change falls back to the row blocks.
+class ChunkChanger {
+public:
+    ChunkChanger(const TabletSchema& base_schema, const TabletSchema& new_schema, const SchemaMapping& schema_mapping);
+
+    // Returns false if any column of the new schema can't be changed by the chunks.
+    bool init();
+
+    // The format v2 schemas of all the columns of the base and the new tablets.
+    const vectorized::Schema& base_schema() const { return _base_schema; }
+    const vectorized::Schema& new_schema() const { return _new_schema; }
+
+    // Append the rows of |base_chunk| of base_schema() into |new_chunk| of new_schema().
+    Status change_chunk(const vectorized::Chunk& base_chunk, vectorized::Chunk* new_chunk) const;
+
+private:
+    using CastFunc = void (*)(const vectorized::Column& src, vectorized::Column* dst);
+
+    struct ColumnChange {
+        int32_t ref_column = -1;
+        // Set if the value is converted by the TypeConverter of the format v2 types.
+        const vectorized::TypeConverter* converter = nullptr;
+        // Set if the integer is cast the same as TYPE_REINTERPRET_CAST of RowBlockChanger.
+        CastFunc cast = nullptr;
+        // The default value of a single row, set if |ref_column| < 0.
+        vectorized::ColumnPtr default_column;
+    };
+
+    bool _init_column_change(size_t column_index, ColumnChange* change);
+
+    const TabletSchema& _base_tablet_schema;
+    const TabletSchema& _new_tablet_schema;
+    SchemaMapping _schema_mapping;
+    vectorized::Schema _base_schema;
+    vectorized::Schema _new_schema;
+    std::vector<ColumnChange> _changes;
+
+    DISALLOW_COPY_AND_ASSIGN(ChunkChanger);
+};
+
 class RowBlockAllocator {
 public:
     RowBlockAllocator(const TabletSchema& tablet_schema, size_t memory_limitation);
@@ -217,6 +266,17 @@ private:
 
     static OLAPStatus _convert_historical_rowsets(const SchemaChangeParams& sc_params);
 
+    // Whether the rowsets can be converted by ChunkChanger, i.e. they're all read and written as beta rowsets.
+    static bool _can_convert_by_chunks(const SchemaChangeParams& sc_params);
+
+    // Convert the rowsets by |chunk_changer|, at most config::schema_change_max_parallel_rowsets rowsets are
+    // converted concurrently, each into a rowset of the same version of the new tablet.
+    static OLAPStatus _convert_historical_rowsets_by_chunks(const SchemaChangeParams& sc_params,
+                                                            const ChunkChanger& chunk_changer, int64_t end_version);
+
+    static OLAPStatus _convert_rowset_by_chunks(const SchemaChangeParams& sc_params, const ChunkChanger& chunk_changer,
+                                                const RowsetSharedPtr& rowset, int64_t end_version);
+
     static OLAPStatus _parse_request(
             TabletSharedPtr base_tablet, TabletSharedPtr new_tablet, RowBlockChanger* rb_changer, bool* sc_sorting,
             bool* sc_directly,
@@ -21,13 +21,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <string>
 #include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/segment_v2.pb.h"
+#include "gutil/endian.h"
 #include "util/debug_util.h"
 #include "util/faststring.h"
 #include "util/slice.h"
@@ -256,18 +259,46 @@ public:
     }
 
     int64_t mem_usage() const {
-        return sizeof(ShortKeyIndexDecoder) + sizeof(uint32_t) * _offsets.size() + _key_data.size +
-               _footer.ByteSizeLong() - sizeof(_footer);
+        return sizeof(ShortKeyIndexDecoder) + sizeof(uint32_t) * _offsets.size() +
+               sizeof(uint64_t) * _prefixes.size() + _key_data.size + _footer.ByteSizeLong() - sizeof(_footer);
+    }
+
+    // The first 8 bytes of |key| as a big endian integer, padded with zeros, so the prefixes are in the order of
+    // the keys, i.e. a key is less than another whose prefix is greater.
+    static uint64_t key_prefix(const Slice& key) {
+        uint64_t prefix = 0;
+        memcpy(&prefix, key.data, std::min<size_t>(key.size, sizeof(prefix)));
+        return BigEndian::ToHost64(prefix);
     }
 
 private:
+    // The keys whose prefixes are equal with the one of |key| are found by a branchless binary search of the
+    // prefixes, which are contiguous, and only these keys are compared.
     template <bool lower_bound>
     ShortKeyIndexIterator seek(const Slice& key) const {
+        const uint64_t prefix = key_prefix(key);
+        const uint64_t* first = _prefixes.data();
+        size_t n = _prefixes.size();
+        // the first item whose prefix isn't less than |prefix|
+        const uint64_t* low = first;
+        while (n > 1) {
+            size_t half = n / 2;
+            low = (low[half - 1] < prefix) ? low + half : low;
+            n -= half;
+        }
+        low += (n == 1 && *low < prefix);
+        const uint64_t* high = low;
+        while (high != first + _prefixes.size() && *high == prefix) {
+            ++high;
+        }
+
         auto comparator = [](const Slice& lhs, const Slice& rhs) { return lhs.compare(rhs) < 0; };
+        ShortKeyIndexIterator range_begin(this, low - first);
+        ShortKeyIndexIterator range_end(this, high - first);
         if (lower_bound) {
-            return std::lower_bound(begin(), end(), key, comparator);
+            return std::lower_bound(range_begin, range_end, key, comparator);
         } else {
-            return std::upper_bound(begin(), end(), key, comparator);
+            return std::upper_bound(range_begin, range_end, key, comparator);
         }
     }
 
@@ -276,6 +307,8 @@ private:
     // All following fields are only valid after parse has been executed successfully
     segment_v2::ShortKeyFooterPB _footer;
     std::vector<uint32_t> _offsets;
+    // the key_prefix() of the items
+    std::vector<uint64_t> _prefixes;
     Slice _key_data;
 };
 
@@ -40,6 +40,7 @@
 #include "env/env.h"
 #include "runtime/exec_env.h"
 #include "storage/data_dir.h"
+#include "storage/delete_bitmap_manager.h"
 #include "storage/fs/file_block_manager.h"
 #include "storage/lru_cache.h"
 #include "storage/memtable_flush_executor.h"
@@ -60,6 +61,7 @@
 #include "util/pretty_printer.h"
 #include "util/scoped_cleanup.h"
 #include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 #include "util/trace.h"
 
@@ -114,6 +116,7 @@ StorageEngine::StorageEngine(const EngineOptions& options)
           _memtable_flush_executor(nullptr),
           _block_manager(nullptr),
           _update_manager(new UpdateManager(options.update_mem_tracker)),
+          _delete_bitmap_manager(new DeleteBitmapManager(config::delete_bitmap_cache_capacity)),
           _heartbeat_flags(nullptr) {
     if (_s_instance == nullptr) {
         _s_instance = this;
@@ -155,7 +158,8 @@ Status StorageEngine::_open() {
 
     RETURN_IF_ERROR_WITH_WARN(_check_file_descriptor_number(), "check fd number failed");
 
-    _index_stream_lru_cache = new_lru_cache(config::index_stream_cache_capacity);
+    _index_stream_lru_cache = new_lru_cache(config::index_stream_cache_capacity,
+                                            cache_policy_from_string(config::storage_cache_eviction_policy));
 
     _file_cache.reset(new_lru_cache(config::file_descriptor_cache_capacity));
 
@@ -173,6 +177,22 @@ Status StorageEngine::_open() {
     // `load_data_dirs` depend on |_update_manager|.
     load_data_dirs(dirs);
 
+    if (config::segment_writer_encode_threads > 0) {
+        RETURN_IF_ERROR_WITH_WARN(ThreadPoolBuilder("SegmentEncodeThreadPool")
+                                          .set_min_threads(1)
+                                          .set_max_threads(config::segment_writer_encode_threads)
+                                          .build(&_segment_encode_thread_pool),
+                                  "init segment encode thread pool failed");
+    }
+
+    if (config::publish_version_tablet_threads > 0) {
+        RETURN_IF_ERROR_WITH_WARN(ThreadPoolBuilder("PublishVersionThreadPool")
+                                          .set_min_threads(1)
+                                          .set_max_threads(config::publish_version_tablet_threads)
+                                          .build(&_publish_version_thread_pool),
+                                  "init publish version thread pool failed");
+    }
+
     _memtable_flush_executor.reset(new MemTableFlushExecutor());
     RETURN_IF_ERROR_WITH_WARN(_memtable_flush_executor->init(dirs), "init memtable_flush_executor failed");
 
@@ -511,6 +531,10 @@ Status StorageEngine::_perform_cumulative_compaction(DataDir* data_dir) {
     });
     ADOPT_TRACE(trace.get());
     TRACE("start to perform cumulative compaction");
+    CompactionIOBudget* io_budget = data_dir->compaction_io_budget();
+    if (!io_budget->can_start_compaction()) {
+        return Status::TooManyTasks("the io budget of the compaction is used up");
+    }
     TabletSharedPtr best_tablet =
             _tablet_manager->find_best_tablet_to_compaction(CompactionType::CUMULATIVE_COMPACTION, data_dir);
     if (best_tablet == nullptr) {
@@ -547,6 +571,10 @@ Status StorageEngine::_perform_base_compaction(DataDir* data_dir) {
     });
     ADOPT_TRACE(trace.get());
     TRACE("start to perform base compaction");
+    CompactionIOBudget* io_budget = data_dir->compaction_io_budget();
+    if (!io_budget->can_start_compaction()) {
+        return Status::TooManyTasks("the io budget of the compaction is used up");
+    }
     TabletSharedPtr best_tablet =
             _tablet_manager->find_best_tablet_to_compaction(CompactionType::BASE_COMPACTION, data_dir);
     if (best_tablet == nullptr) {
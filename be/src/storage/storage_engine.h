@@ -55,10 +55,12 @@
 namespace starrocks {
 
 class DataDir;
+class DeleteBitmapManager;
 class EngineTask;
 class BlockManager;
 class MemTableFlushExecutor;
 class Tablet;
+class ThreadPool;
 class UpdateManager;
 
 // StorageEngine singleton to manage all Table pointers.
@@ -149,6 +151,11 @@ public:
     MemTableFlushExecutor* memtable_flush_executor() { return _memtable_flush_executor.get(); }
     fs::BlockManager* block_manager() { return _block_manager.get(); }
     UpdateManager* update_manager() { return _update_manager.get(); }
+    DeleteBitmapManager* delete_bitmap_manager() { return _delete_bitmap_manager.get(); }
+    // The pool to encode the columns of the segment writers, or nullptr if they're encoded serially.
+    ThreadPool* segment_encode_thread_pool() { return _segment_encode_thread_pool.get(); }
+    // The pool to publish the versions of the tablets, or nullptr if they're published serially.
+    ThreadPool* publish_version_thread_pool() { return _publish_version_thread_pool.get(); }
 
     bool check_rowset_id_in_unused_rowsets(const RowsetId& rowset_id);
 
@@ -195,6 +202,12 @@ private:
     // unused rowset monitor thread
     void* _unused_rowset_monitor_thread_callback(void* arg);
 
+    // delete bitmap materialize thread
+    void* _delete_bitmap_materialize_thread_callback(void* arg);
+
+    // primary index prewarm thread
+    void* _primary_index_prewarm_thread_callback(void* arg);
+
     // base compaction thread process function
     void* _base_compaction_thread_callback(void* arg, DataDir* data_dir);
     // cumulative process function
@@ -279,6 +292,10 @@ private:
     // thread to expire update cache;
     std::thread _update_cache_expire_thread;
     std::thread _unused_rowset_monitor_thread;
+    // thread to materialize the delete predicates into the delete bitmaps
+    std::thread _delete_bitmap_materialize_thread;
+    // thread to load the primary indexes after the BE starts
+    std::thread _primary_index_prewarm_thread;
     // thread to monitor snapshot expiry
     std::thread _garbage_sweeper_thread;
     // thread to monitor disk stat
@@ -310,12 +327,19 @@ private:
 
     std::unique_ptr<RowsetIdGenerator> _rowset_id_generator;
 
+    // |_memtable_flush_executor| depends on it, so it's destroyed after the executor.
+    std::unique_ptr<ThreadPool> _segment_encode_thread_pool;
+
+    std::unique_ptr<ThreadPool> _publish_version_thread_pool;
+
     std::unique_ptr<MemTableFlushExecutor> _memtable_flush_executor;
 
     std::unique_ptr<fs::BlockManager> _block_manager;
 
     std::unique_ptr<UpdateManager> _update_manager;
 
+    std::unique_ptr<DeleteBitmapManager> _delete_bitmap_manager;
+
     HeartbeatFlags* _heartbeat_flags = nullptr;
 
     DISALLOW_COPY_AND_ASSIGN(StorageEngine);
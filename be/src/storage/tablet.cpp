@@ -712,8 +712,9 @@ bool Tablet::can_do_compaction() {
     return true;
 }
 
-const uint32_t Tablet::calc_cumulative_compaction_score() const {
+const uint32_t Tablet::calc_cumulative_compaction_score(int64_t* rewrite_bytes) const {
     uint32_t score = 0;
+    int64_t bytes = 0;
     bool base_rowset_exist = false;
     const int64_t point = cumulative_layer_point();
     for (auto& rs_meta : _tablet_meta->all_rs_metas()) {
@@ -726,14 +727,19 @@ const uint32_t Tablet::calc_cumulative_compaction_score() const {
         }
 
         score += rs_meta->get_compaction_score();
+        bytes += rs_meta->data_disk_size();
+    }
+    if (rewrite_bytes != nullptr) {
+        *rewrite_bytes = bytes;
     }
 
     // If base doesn't exist, tablet may be altering, skip it, set score to 0
     return base_rowset_exist ? score : 0;
 }
 
-const uint32_t Tablet::calc_base_compaction_score() const {
+const uint32_t Tablet::calc_base_compaction_score(int64_t* rewrite_bytes) const {
     uint32_t score = 0;
+    int64_t bytes = 0;
     const int64_t point = cumulative_layer_point();
     bool base_rowset_exist = false;
     for (auto& rs_meta : _tablet_meta->all_rs_metas()) {
@@ -746,6 +752,10 @@ const uint32_t Tablet::calc_base_compaction_score() const {
         }
 
         score += rs_meta->get_compaction_score();
+        bytes += rs_meta->data_disk_size();
+    }
+    if (rewrite_bytes != nullptr) {
+        *rewrite_bytes = bytes;
     }
 
     return base_rowset_exist ? score : 0;
@@ -1206,8 +1216,18 @@ bool Tablet::_contains_rowset(const RowsetId rowset_id) {
     return false;
 }
 
-void Tablet::build_tablet_report_info(TTabletInfo* tablet_info) {
+void Tablet::build_tablet_report_info(TTabletInfo* tablet_info, bool use_cache) {
     std::shared_lock rdlock(_meta_lock);
+    // The infos of the updatable tablets are of their TabletUpdates, whose changes aren't tracked by the stamps.
+    const bool cacheable = _updates == nullptr;
+    const int64_t report_stamp = _tablet_meta->report_stamp();
+    if (use_cache && cacheable) {
+        std::lock_guard l(_report_info_lock);
+        if (_report_info_stamp == report_stamp) {
+            *tablet_info = _report_info;
+            return;
+        }
+    }
     tablet_info->__set_tablet_id(_tablet_meta->tablet_id());
     tablet_info->__set_schema_hash(_tablet_meta->schema_hash());
     tablet_info->__set_partition_id(_tablet_meta->partition_id());
@@ -1241,6 +1261,11 @@ void Tablet::build_tablet_report_info(TTabletInfo* tablet_info) {
         tablet_info->__set_row_count(_tablet_meta->num_rows());
         tablet_info->__set_data_size(_tablet_meta->tablet_footprint());
     }
+    if (cacheable) {
+        std::lock_guard l(_report_info_lock);
+        _report_info = *tablet_info;
+        _report_info_stamp = report_stamp;
+    }
 }
 
 // should use this method to get a copy of current tablet meta
@@ -173,8 +173,10 @@ public:
 
     // operation for compaction
     bool can_do_compaction();
-    const uint32_t calc_cumulative_compaction_score() const;
-    const uint32_t calc_base_compaction_score() const;
+    // If |rewrite_bytes| isn't null, it's set to the disk size of the rowsets counted by the score, which are
+    // rewritten by the compaction.
+    const uint32_t calc_cumulative_compaction_score(int64_t* rewrite_bytes = nullptr) const;
+    const uint32_t calc_base_compaction_score(int64_t* rewrite_bytes = nullptr) const;
     static void compute_version_hash_from_rowsets(const std::vector<RowsetSharedPtr>& rowsets,
                                                   VersionHash* version_hash);
 
@@ -227,7 +229,9 @@ public:
 
     bool rowset_meta_is_useful(RowsetMetaSharedPtr rowset_meta);
 
-    void build_tablet_report_info(TTabletInfo* tablet_info);
+    // Build the reported info of the tablet. If |use_cache|, the info cached by the last build is taken as it is if
+    // the tablet is unchanged since then, see TabletMeta::report_stamp().
+    void build_tablet_report_info(TTabletInfo* tablet_info, bool use_cache = false);
 
     void generate_tablet_meta_copy(TabletMetaSharedPtr new_tablet_meta) const;
     // caller should hold the _meta_lock before calling this method
@@ -275,6 +279,10 @@ private:
     // TODO(lingbin): There is a _meta_lock TabletMeta too, there should be a comment to
     // explain how these two locks work together.
     mutable std::shared_mutex _meta_lock;
+    // The reported info of the last build, of the report stamp of the tablet meta then, -1 if none.
+    std::mutex _report_info_lock;
+    TTabletInfo _report_info;
+    int64_t _report_info_stamp = -1;
     // A new load job will produce a new rowset, which will be inserted into both _rs_version_map
     // and _inc_rs_version_map. Only the most recent rowsets are kept in _inc_rs_version_map to
     // reduce the amount of data that needs to be copied during the clone task.
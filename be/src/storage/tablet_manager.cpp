@@ -24,6 +24,7 @@
 #include <re2/re2.h>
 #include <thrift/protocol/TDebugProtocol.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <memory>
@@ -645,12 +646,18 @@ void TabletManager::get_tablet_stat(TTabletStatResult* result) {
     result->__set_tablets_stats(_tablet_stat_cache);
 }
 
-TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType compaction_type, DataDir* data_dir) {
+double TabletManager::compaction_priority(uint32_t score, int64_t rewrite_bytes) {
+    if (!config::enable_compaction_priority_by_rewrite_bytes) {
+        return score;
+    }
+    // The score of the tablet drops to about 1 after the compaction.
+    return (score - 1.0) / (rewrite_bytes / (1024.0 * 1024.0) + 1.0);
+}
+
+void TabletManager::_collect_compaction_candidates(CompactionType compaction_type, DataDir* data_dir,
+                                                   std::vector<CompactionCandidate>* candidates) {
     int64_t now_ms = UnixMillis();
     const std::string& compaction_type_str = compaction_type == CompactionType::BASE_COMPACTION ? "base" : "cumulative";
-    // only do compaction if compaction #rowset > 1
-    uint32_t highest_score = 1;
-    TabletSharedPtr best_tablet;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rlock(*tablets_shard.lock);
         for (const auto& tablet_map : tablets_shard.tablet_map) {
@@ -701,36 +708,112 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType com
                     tablet_ptr->get_cumulative_lock().unlock();
                 }
 
-                uint32_t table_score = 0;
+                CompactionCandidate candidate;
                 {
                     std::shared_lock rdlock(tablet_ptr->get_header_lock());
                     if (compaction_type == CompactionType::BASE_COMPACTION) {
-                        table_score = tablet_ptr->calc_base_compaction_score();
+                        candidate.score = tablet_ptr->calc_base_compaction_score(&candidate.rewrite_bytes);
                     } else if (compaction_type == CompactionType::CUMULATIVE_COMPACTION) {
-                        table_score = tablet_ptr->calc_cumulative_compaction_score();
+                        candidate.score = tablet_ptr->calc_cumulative_compaction_score(&candidate.rewrite_bytes);
                     }
                 }
-                if (table_score > highest_score) {
-                    highest_score = table_score;
-                    best_tablet = tablet_ptr;
+                // only do compaction if compaction #rowset > 1
+                if (candidate.score > 1) {
+                    candidate.tablet = tablet_ptr;
+                    candidate.priority = compaction_priority(candidate.score, candidate.rewrite_bytes);
+                    candidates->emplace_back(std::move(candidate));
                 }
             }
         }
     }
+}
 
-    if (best_tablet != nullptr) {
-        LOG(INFO) << "Found the best tablet to compact. "
-                  << "compaction_type=" << compaction_type_str << " tablet_id=" << best_tablet->tablet_id()
-                  << " highest_score=" << highest_score;
-        // TODO(lingbin): Remove 'max' from metric name, it would be misunderstood as the
-        // biggest in history(like peak), but it is really just the value at current moment.
-        if (compaction_type == CompactionType::BASE_COMPACTION) {
-            StarRocksMetrics::instance()->tablet_base_max_compaction_score.set_value(highest_score);
-        } else {
-            StarRocksMetrics::instance()->tablet_cumulative_max_compaction_score.set_value(highest_score);
+TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType compaction_type, DataDir* data_dir) {
+    const std::string& compaction_type_str = compaction_type == CompactionType::BASE_COMPACTION ? "base" : "cumulative";
+    std::vector<CompactionCandidate> candidates;
+    _collect_compaction_candidates(compaction_type, data_dir, &candidates);
+    if (candidates.empty()) {
+        return nullptr;
+    }
+    uint32_t highest_score = 0;
+    const CompactionCandidate* best = &candidates[0];
+    for (const auto& candidate : candidates) {
+        highest_score = std::max(highest_score, candidate.score);
+        if (candidate.priority > best->priority) {
+            best = &candidate;
         }
     }
-    return best_tablet;
+
+    LOG(INFO) << "Found the best tablet to compact. "
+              << "compaction_type=" << compaction_type_str << " tablet_id=" << best->tablet->tablet_id()
+              << " score=" << best->score << " rewrite_bytes=" << best->rewrite_bytes
+              << " highest_score=" << highest_score;
+    // TODO(lingbin): Remove 'max' from metric name, it would be misunderstood as the
+    // biggest in history(like peak), but it is really just the value at current moment.
+    if (compaction_type == CompactionType::BASE_COMPACTION) {
+        StarRocksMetrics::instance()->tablet_base_max_compaction_score.set_value(highest_score);
+    } else {
+        StarRocksMetrics::instance()->tablet_cumulative_max_compaction_score.set_value(highest_score);
+    }
+    return best->tablet;
+}
+
+std::vector<CompactionCandidate> TabletManager::get_compaction_candidates(CompactionType compaction_type,
+                                                                          DataDir* data_dir, size_t limit) {
+    std::vector<CompactionCandidate> candidates;
+    _collect_compaction_candidates(compaction_type, data_dir, &candidates);
+    auto by_priority = [](const CompactionCandidate& a, const CompactionCandidate& b) {
+        return a.priority > b.priority;
+    };
+    if (candidates.size() > limit) {
+        std::partial_sort(candidates.begin(), candidates.begin() + limit, candidates.end(), by_priority);
+        candidates.resize(limit);
+    } else {
+        std::sort(candidates.begin(), candidates.end(), by_priority);
+    }
+    return candidates;
+}
+
+std::vector<TabletSharedPtr> TabletManager::get_tablets_with_delete_predicates() {
+    std::vector<TabletSharedPtr> candidates;
+    for (const auto& tablets_shard : _tablets_shards) {
+        std::shared_lock rlock(*tablets_shard.lock);
+        for (const auto& tablet_map : tablets_shard.tablet_map) {
+            for (const TabletSharedPtr& tablet_ptr : tablet_map.second.table_arr) {
+                if (tablet_ptr->keys_type() == PRIMARY_KEYS || tablet_ptr->tablet_state() != TABLET_RUNNING ||
+                    !tablet_ptr->is_used() || !tablet_ptr->init_succeeded()) {
+                    continue;
+                }
+                candidates.emplace_back(tablet_ptr);
+            }
+        }
+    }
+    // The header lock of the tablets isn't taken under the lock of the shards.
+    std::vector<TabletSharedPtr> tablets;
+    for (auto& tablet : candidates) {
+        std::shared_lock rlock(tablet->get_header_lock());
+        if (!tablet->delete_predicates().empty()) {
+            tablets.emplace_back(std::move(tablet));
+        }
+    }
+    return tablets;
+}
+
+std::vector<TabletSharedPtr> TabletManager::get_primary_key_tablets() {
+    std::vector<TabletSharedPtr> tablets;
+    for (const auto& tablets_shard : _tablets_shards) {
+        std::shared_lock rlock(*tablets_shard.lock);
+        for (const auto& tablet_map : tablets_shard.tablet_map) {
+            for (const TabletSharedPtr& tablet_ptr : tablet_map.second.table_arr) {
+                if (tablet_ptr->keys_type() != PRIMARY_KEYS || tablet_ptr->tablet_state() != TABLET_RUNNING ||
+                    !tablet_ptr->is_used() || !tablet_ptr->init_succeeded()) {
+                    continue;
+                }
+                tablets.emplace_back(tablet_ptr);
+            }
+        }
+    }
+    return tablets;
 }
 
 TabletSharedPtr TabletManager::find_best_tablet_to_do_update_compaction(DataDir* data_dir) {
@@ -945,6 +1028,8 @@ Status TabletManager::report_all_tablets_info(std::map<TTabletId, TTablet>* tabl
 
     StarRocksMetrics::instance()->report_all_tablets_requests_total.increment(1);
 
+    const int64_t full_build_rounds = std::max(config::report_tablet_full_build_rounds, 1);
+    const bool use_cache = _report_all_tablets_rounds++ % full_build_rounds != 0;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rlock(*tablets_shard.lock);
         for (const auto& item : tablets_shard.tablet_map) {
@@ -956,7 +1041,7 @@ Status TabletManager::report_all_tablets_info(std::map<TTabletId, TTablet>* tabl
             TTablet t_tablet;
             for (const TabletSharedPtr& tablet_ptr : item.second.table_arr) {
                 TTabletInfo tablet_info;
-                tablet_ptr->build_tablet_report_info(&tablet_info);
+                tablet_ptr->build_tablet_report_info(&tablet_info, use_cache);
 
                 // find expired transaction corresponding to this tablet
                 TabletInfo tinfo(tablet_id, tablet_ptr->schema_hash(), tablet_ptr->tablet_uid());
@@ -973,7 +1058,7 @@ Status TabletManager::report_all_tablets_info(std::map<TTabletId, TTablet>* tabl
             }
         }
     }
-    LOG(INFO) << "Reported all " << tablets_info->size() << " tablets info";
+    LOG(INFO) << "Reported all " << tablets_info->size() << " tablets info" << (use_cache ? "" : ", fully built");
     return Status::OK();
 }
 
@@ -22,6 +22,7 @@
 #ifndef STARROCKS_BE_SRC_OLAP_TABLET_MANAGER_H
 #define STARROCKS_BE_SRC_OLAP_TABLET_MANAGER_H
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <mutex>
@@ -45,6 +46,16 @@ namespace starrocks {
 class Tablet;
 class DataDir;
 
+// A tablet waiting for the base or cumulative compaction.
+struct CompactionCandidate {
+    TabletSharedPtr tablet;
+    uint32_t score = 0;
+    // The disk size of the rowsets rewritten by the compaction.
+    int64_t rewrite_bytes = 0;
+    // The candidates of the higher priority are compacted first, see `compaction_priority`.
+    double priority = 0;
+};
+
 // TabletManager provides get, add, delete tablet method for storage engine
 // NOTE: If you want to add a method that needs to hold meta-lock before you can call it,
 // please uniformly name the method in "xxx_unlocked()" mode
@@ -68,8 +79,22 @@ public:
 
     TabletSharedPtr find_best_tablet_to_compaction(CompactionType compaction_type, DataDir* data_dir);
 
+    // Returns at most |limit| candidates of the compaction on |data_dir|, in the descending order of priority.
+    std::vector<CompactionCandidate> get_compaction_candidates(CompactionType compaction_type, DataDir* data_dir,
+                                                               size_t limit);
+
+    // The compaction score gained per MB rewritten if config::enable_compaction_priority_by_rewrite_bytes is
+    // true, otherwise the score.
+    static double compaction_priority(uint32_t score, int64_t rewrite_bytes);
+
     TabletSharedPtr find_best_tablet_to_do_update_compaction(DataDir* data_dir);
 
+    // Returns the running non-primary-key tablets which have delete predicates.
+    std::vector<TabletSharedPtr> get_tablets_with_delete_predicates();
+
+    // Returns the running primary-key tablets.
+    std::vector<TabletSharedPtr> get_primary_key_tablets();
+
     TabletSharedPtr get_tablet(TTabletId tablet_id, SchemaHash schema_hash, bool include_deleted = false,
                                std::string* err = nullptr);
 
@@ -112,6 +137,8 @@ public:
     // Returns NotFound if the corresponding tablet does not exist.
     Status report_tablet_info(TTabletInfo* tablet_info);
 
+    // The tablets unchanged since the last report are reported by their cached infos, except in every
+    // config::report_tablet_full_build_rounds-th report, see Tablet::build_tablet_report_info().
     Status report_all_tablets_info(std::map<TTabletId, TTablet>* tablets_info);
 
     Status start_trash_sweep();
@@ -148,6 +175,9 @@ private:
 
     Status _drop_tablet_unlocked(TTabletId tablet_id, SchemaHash schema_hash, bool keep_state);
 
+    void _collect_compaction_candidates(CompactionType compaction_type, DataDir* data_dir,
+                                        std::vector<CompactionCandidate>* candidates);
+
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id, SchemaHash schema_hash);
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id, SchemaHash schema_hash, bool include_deleted,
                                          std::string* err);
@@ -212,6 +242,9 @@ private:
     // last update time of tablet stat cache
     int64_t _last_update_stat_ms;
 
+    // the number of the reports of all tablets
+    std::atomic<int64_t> _report_all_tablets_rounds{0};
+
     tablet_map_t& _get_tablet_map(TTabletId tablet_id);
 
     tablets_shard& _get_tablets_shard(TTabletId tabletId);
@@ -21,6 +21,7 @@
 
 #include "storage/tablet_meta.h"
 
+#include <atomic>
 #include <boost/algorithm/string.hpp>
 #include <memory>
 #include <sstream>
@@ -185,6 +186,9 @@ static Status TColumn2ColumnPB(int32_t unique_id, const TColumn& t_column, Field
         if (depth == 0 && t_column.__isset.is_bloom_filter_column) {
             column_pb->set_is_bf_column(t_column.is_bloom_filter_column);
         }
+        if (depth == 0 && t_column.__isset.is_cluster_column) {
+            column_pb->set_is_cluster_column(t_column.is_cluster_column);
+        }
         return Status::OK();
     }
     case TTypeNodeType::ARRAY:
@@ -235,6 +239,11 @@ OLAPStatus TabletMeta::create(MemTracker* mem_tracker, const TCreateTabletReq& r
     return OLAP_SUCCESS;
 }
 
+int64_t TabletMeta::_next_report_stamp() {
+    static std::atomic<int64_t> s_report_stamp{0};
+    return ++s_report_stamp;
+}
+
 TabletMeta::TabletMeta(MemTracker* mem_tracker) : _tablet_uid(0, 0) {
     _mem_tracker = std::make_unique<MemTracker>(-1, "", mem_tracker);
 }
@@ -496,6 +505,7 @@ void TabletMeta::init_from_pb(TabletMetaPB* ptablet_meta_pb) {
     if (tablet_meta_pb.has_updates()) {
         _updatesPB.reset(tablet_meta_pb.release_updates());
     }
+    _report_stamp = _next_report_stamp();
 }
 
 void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
@@ -588,6 +598,7 @@ OLAPStatus TabletMeta::add_rs_meta(const RowsetMetaSharedPtr& rs_meta) {
     if (rs_meta->has_delete_predicate()) {
         add_delete_predicate(rs_meta->delete_predicate(), rs_meta->version().first);
     }
+    _report_stamp = _next_report_stamp();
 
     return OLAP_SUCCESS;
 }
@@ -601,6 +612,7 @@ void TabletMeta::delete_rs_meta_by_version(const Version& version, std::vector<R
             }
             _mem_tracker->release((*it)->mem_usage());
             _rs_metas.erase(it);
+            _report_stamp = _next_report_stamp();
             return;
         }
         ++it;
@@ -632,6 +644,7 @@ void TabletMeta::modify_rs_metas(const std::vector<RowsetMetaSharedPtr>& to_add,
     // put to_add rowsets in _rs_metas.
     _mem_tracker->consume(calc_mem_usage_of_rs_metas(to_add));
     _rs_metas.insert(_rs_metas.end(), to_add.begin(), to_add.end());
+    _report_stamp = _next_report_stamp();
 }
 
 void TabletMeta::revise_rs_metas(std::vector<RowsetMetaSharedPtr> rs_metas) {
@@ -640,6 +653,7 @@ void TabletMeta::revise_rs_metas(std::vector<RowsetMetaSharedPtr> rs_metas) {
     _alter_task.reset();
 
     _rs_metas = std::move(rs_metas);
+    _report_stamp = _next_report_stamp();
 }
 
 void TabletMeta::revise_inc_rs_metas(std::vector<RowsetMetaSharedPtr> rs_metas) {
@@ -806,6 +820,7 @@ OLAPStatus TabletMeta::set_partition_id(int64_t partition_id) {
         LOG(FATAL) << "cur partition id=" << _partition_id << " new partition id=" << partition_id << " not equal";
     }
     _partition_id = partition_id;
+    _report_stamp = _next_report_stamp();
     return OLAP_SUCCESS;
 }
 
@@ -169,9 +169,19 @@ public:
         }
         _schema = tablet_schema;
         _mem_tracker->consume(_schema->mem_usage());
+        _report_stamp = _next_report_stamp();
     }
 
-    inline std::shared_ptr<TabletSchema>& mutable_tablet_schema() { return _schema; }
+    // The schema may be modified by the caller, e.g. to set it in memory, so the tablet info is reported again.
+    // The stamp of the reported infos of the tablet, a new one is taken whenever the rowsets, the state, the
+    // partition or the schema of the tablet change, so the tablets whose stamps are unchanged since the last
+    // report are reported by the cached infos.
+    int64_t report_stamp() const { return _report_stamp; }
+
+    inline std::shared_ptr<TabletSchema>& mutable_tablet_schema() {
+        _report_stamp = _next_report_stamp();
+        return _schema;
+    }
 
     inline const std::vector<RowsetMetaSharedPtr>& all_rs_metas() const;
     OLAPStatus add_rs_meta(const RowsetMetaSharedPtr& rs_meta);
@@ -219,6 +229,8 @@ public:
 private:
     OLAPStatus _save_meta(DataDir* data_dir);
 
+    static int64_t _next_report_stamp();
+
     static int64_t calc_mem_usage_of_rs_metas(const std::vector<RowsetMetaSharedPtr>& rs_metas) {
         int64_t mem_usage = 0;
         for (const auto& rs_meta : rs_metas) {
@@ -244,6 +256,7 @@ private:
     TabletTypePB _tablet_type = TabletTypePB::TABLET_TYPE_DISK;
 
     TabletState _tablet_state = TABLET_NOTREADY;
+    int64_t _report_stamp = _next_report_stamp();
     // Note: Segment store the pointer of TabletSchema,
     // so this point should never change
     std::shared_ptr<TabletSchema> _schema = nullptr;
@@ -341,6 +354,7 @@ inline TabletState TabletMeta::tablet_state() const {
 
 inline void TabletMeta::set_tablet_state(TabletState state) {
     _tablet_state = state;
+    _report_stamp = _next_report_stamp();
 }
 
 inline bool TabletMeta::in_restore_mode() const {
@@ -286,6 +286,7 @@ void TabletColumn::init_from_pb(const ColumnPB& column) {
     } else {
         _has_bitmap_index = false;
     }
+    _is_cluster_column = column.is_cluster_column();
     _has_referenced_column = column.has_referenced_column_id();
     if (_has_referenced_column) {
         _referenced_column_id = column.referenced_column_id();
@@ -328,6 +329,9 @@ void TabletColumn::to_schema_pb(ColumnPB* column) const {
     if (_has_bitmap_index) {
         column->set_has_bitmap_index(_has_bitmap_index);
     }
+    if (_is_cluster_column) {
+        column->set_is_cluster_column(_is_cluster_column);
+    }
     for (const auto& sub_column : _sub_columns) {
         sub_column.to_schema_pb(column->add_children_columns());
     }
@@ -425,6 +429,18 @@ std::unique_ptr<TabletSchema> TabletSchema::convert_to_format(DataFormatVersion
     return schema;
 }
 
+std::unique_ptr<TabletSchema> TabletSchema::create_partial_schema(const std::vector<uint32_t>& column_ids) const {
+    TabletSchemaPB schema_pb;
+    to_schema_pb(&schema_pb);
+    schema_pb.clear_column();
+    for (uint32_t cid : column_ids) {
+        column(cid).to_schema_pb(schema_pb.add_column());
+    }
+    auto schema = std::make_unique<TabletSchema>();
+    schema->init_from_pb(schema_pb);
+    return schema;
+}
+
 size_t TabletSchema::row_size() const {
     size_t size = 0;
     for (auto& column : _cols) {
@@ -482,6 +498,7 @@ bool operator==(const TabletColumn& a, const TabletColumn& b) {
         if (a._referenced_column != b._referenced_column) return false;
     }
     if (a._has_bitmap_index != b._has_bitmap_index) return false;
+    if (a._is_cluster_column != b._is_cluster_column) return false;
     return true;
 }
 
@@ -518,7 +535,8 @@ std::string TabletColumn::debug_string() const {
        << ",is_decimal=" << _is_decimal << ",precision=" << _precision << ",frac=" << _scale << ",length=" << _length
        << ",index_length=" << _index_length << ",is_bf_column=" << _is_bf_column
        << ",has_reference_column=" << _has_referenced_column << ",referenced_column_id=" << _referenced_column_id
-       << ",referenced_column=" << _referenced_column << ",has_bitmap_index=" << _has_bitmap_index << ")";
+       << ",referenced_column=" << _referenced_column << ",has_bitmap_index=" << _has_bitmap_index
+       << ",is_cluster_column=" << _is_cluster_column << ")";
     return ss.str();
 }
 
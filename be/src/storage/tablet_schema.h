@@ -55,6 +55,8 @@ public:
     inline bool is_nullable() const { return _is_nullable; }
     inline bool is_bf_column() const { return _is_bf_column; }
     inline bool has_bitmap_index() const { return _has_bitmap_index; }
+    // Whether the rows are clustered by the column in the compactions, see Compaction::should_cluster().
+    inline bool is_cluster_column() const { return _is_cluster_column; }
     bool has_default_value() const { return _has_default_value; }
     std::string default_value() const { return _default_value; }
     bool has_reference_column() const { return _has_referenced_column; }
@@ -118,6 +120,7 @@ private:
     std::string _referenced_column;
 
     bool _has_bitmap_index = false;
+    bool _is_cluster_column = false;
 
     // for hidded column, which is transparent to user
     bool _visible = true;
@@ -153,6 +156,9 @@ public:
 
     std::unique_ptr<TabletSchema> convert_to_format(DataFormatVersion format) const;
 
+    // Returns the schema of the columns |column_ids| of this schema, in the order of |column_ids|.
+    std::unique_ptr<TabletSchema> create_partial_schema(const std::vector<uint32_t>& column_ids) const;
+
     std::string debug_string() const;
 
     int64_t mem_usage() const {
@@ -5,6 +5,7 @@
 #include <time.h>
 
 #include <algorithm>
+#include <functional>
 
 #include "common/status.h"
 #include "gen_cpp/MasterService_types.h"
@@ -15,11 +16,15 @@
 #include "rocksdb/write_batch.h"
 #include "runtime/exec_env.h"
 #include "storage/del_vector.h"
+#include "storage/persistent_index.h"
 #include "storage/primary_key_encoder.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
+#include "storage/rowset/segment_v2/column_reader.h"
+#include "storage/rowset/segment_v2/segment.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/rowset_update_state.h"
 #include "storage/snapshot_meta.h"
@@ -31,8 +36,10 @@
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/chunk_iterator.h"
 #include "storage/vectorized/rowset_merger.h"
+#include "util/countdown_latch.h"
 #include "util/defer_op.h"
 #include "util/pretty_printer.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -311,6 +318,11 @@ int64_t TabletUpdates::max_version() const {
     return _versions.empty() ? 0 : _versions.back()->version.major();
 }
 
+int64_t TabletUpdates::max_version_creation_time() const {
+    std::lock_guard rl(_lock);
+    return _versions.empty() ? 0 : _versions.back()->creation_time;
+}
+
 Status TabletUpdates::get_rowsets_total_stats(const std::vector<uint32_t>& rowsets, size_t* total_rows,
                                               size_t* total_dels) {
     string err_rowsets;
@@ -375,7 +387,7 @@ void TabletUpdates::_redo_edit_version_log(const EditVersionMetaPB& v) {
     _next_rowset_id += v.rowsetid_add();
 }
 
-Status TabletUpdates::_get_apply_version_and_rowsets(int64_t* version, std::vector<RowsetSharedPtr>* rowsets,
+Status TabletUpdates::_get_apply_version_and_rowsets(EditVersion* version, std::vector<RowsetSharedPtr>* rowsets,
                                                      std::vector<uint32_t>* rowset_ids) {
     std::lock_guard rl(_lock);
     EditVersionInfo* v = nullptr;
@@ -389,12 +401,12 @@ Status TabletUpdates::_get_apply_version_and_rowsets(int64_t* version, std::vect
             rowsets->emplace_back(itr->second);
         } else {
             return Status::NotFound(
-                    Substitute("get_apply_version_and_rowsets rowset not found: version:$0 rowset:$1 $2", version, rsid,
-                               _debug_string(false, true)));
+                    Substitute("get_apply_version_and_rowsets rowset not found: version:$0 rowset:$1 $2",
+                               v->version.to_string(), rsid, _debug_string(false, true)));
         }
     }
     rowset_ids->assign(v->rowsets.begin(), v->rowsets.end());
-    *version = v->version.major();
+    *version = v->version;
     return Status::OK();
 }
 
@@ -679,6 +691,36 @@ void TabletUpdates::_stop_and_wait_apply_done() {
     }
 }
 
+// Run task(0) ... task(n - 1) by at most config::update_apply_num_shards threads of |pool|, the calling thread
+// runs a part of them too. Returns the first error of the tasks.
+static Status run_apply_tasks(ThreadPool* pool, size_t n, const std::function<Status(size_t)>& task) {
+    size_t num_workers = std::min<size_t>(n, std::max(1, config::update_apply_num_shards));
+    if (pool == nullptr || num_workers <= 1) {
+        for (size_t i = 0; i < n; i++) {
+            RETURN_IF_ERROR(task(i));
+        }
+        return Status::OK();
+    }
+    vector<Status> status(num_workers);
+    CountDownLatch latch(num_workers);
+    for (size_t w = 0; w < num_workers; w++) {
+        auto worker = [&, w]() {
+            for (size_t i = w; i < n && status[w].ok(); i += num_workers) {
+                status[w] = task(i);
+            }
+            latch.count_down();
+        };
+        if (w + 1 == num_workers || !pool->submit_func(worker).ok()) {
+            worker();
+        }
+    }
+    latch.wait();
+    for (auto& st : status) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
 void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     // NOTE: after commit, apply must success or fatal crash
     int64_t t_start = MonotonicMillis();
@@ -716,6 +758,16 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         _set_error();
         return;
     }
+    // fill the missing columns of a partial update before its keys are upserted
+    st = state.apply(&_tablet, rowset.get(), index);
+    if (!st.ok()) {
+        LOG(ERROR) << "_apply_rowset_commit error: apply rowset update state failed: " << st << " "
+                   << debug_string();
+        manager->update_state_cache().remove(state_entry);
+        manager->index_cache().release(index_entry);
+        _set_error();
+        return;
+    }
     int64_t t_load = MonotonicMillis();
 
     // 3. generate delvec
@@ -727,21 +779,26 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     size_t old_total_del = 0;
     size_t total_del = 0;
     size_t new_del = 0;
-    auto& upserts = state.upserts();
-    for (uint32_t i = 0; i < upserts.size(); i++) {
-        if (upserts[i] != nullptr) {
-            index.upsert(rowset_id + i, 0, *upserts[i], &new_deletes);
-            manager->index_cache().update_object_size(index_entry, index.memory_usage());
-            if (mem_tracker->limit_exceeded()) {
-                // TODO: handle this
-                LOG(WARNING) << "apply_rowset_commit memory limit exceeded tablet:" << _tablet.tablet_id()
-                             << " rowset:" << rowset_id << " seg:" << i << " index:" << index.memory_info()
-                             << " total:" << manager->memory_stats();
-            }
-        }
+    {
+        std::unique_lock<std::shared_mutex> wl(_index_lock);
+        index.upsert_rowset(rowset_id, state.upserts(), state.deletes(), manager->apply_worker_thread_pool(),
+                            &new_deletes);
+        manager->index_cache().update_object_size(index_entry, index.memory_usage());
+        if (mem_tracker->limit_exceeded()) {
+            // TODO: handle this
+            LOG(WARNING) << "apply_rowset_commit memory limit exceeded tablet:" << _tablet.tablet_id()
+                         << " rowset:" << rowset_id << " index:" << index.memory_info()
+                         << " total:" << manager->memory_stats();
+        }
+        // the changes of a persistent index is persisted before the version is applied in the meta
+        st = index.commit(version);
     }
-    for (const auto& one_delete : state.deletes()) {
-        index.erase(*one_delete.get(), &new_deletes);
+    if (!st.ok()) {
+        LOG(ERROR) << "_apply_rowset_commit error: commit primary index failed: " << st << " " << debug_string();
+        manager->update_state_cache().remove(state_entry);
+        manager->index_cache().remove(index_entry);
+        _set_error();
+        return;
     }
     manager->index_cache().update_object_size(index_entry, index.memory_usage());
     // release resource
@@ -754,36 +811,50 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     size_t ndelvec = new_deletes.size();
     string delvec_change_info;
     vector<std::pair<uint32_t, DelVectorPtr>> new_del_vecs(new_deletes.size());
-    size_t idx = 0;
+    // the delvecs of the segments are generated concurrently, old_del_vecs[i] is null for the new segments
+    vector<DelVectorPtr> old_del_vecs(new_deletes.size());
+    vector<PrimaryIndex::DeletesMap::value_type*> delete_entries;
+    delete_entries.reserve(new_deletes.size());
     for (auto& e : new_deletes) {
-        uint32_t rssid = e.first;
+        delete_entries.push_back(&e);
+    }
+    auto gen_delvec = [&](size_t i) -> Status {
+        uint32_t rssid = delete_entries[i]->first;
+        auto& del_ids = delete_entries[i]->second;
+        new_del_vecs[i].first = rssid;
         if (rssid >= rowset_id && rssid < rowset_id + rowset->num_segments()) {
             // it's newly added rowset's segment, do not have latest delvec yet
-            new_del_vecs[idx].first = rssid;
-            new_del_vecs[idx].second = std::make_shared<DelVector>();
-            auto& del_ids = e.second;
-            new_del_vecs[idx].second->init(version.major(), del_ids.data(), del_ids.size());
+            new_del_vecs[i].second = std::make_shared<DelVector>();
+            new_del_vecs[i].second->init(version.major(), del_ids.data(), del_ids.size());
+            return Status::OK();
+        }
+        TabletSegmentId tsid;
+        tsid.tablet_id = tablet_id;
+        tsid.segment_id = rssid;
+        // TODO(cbl): should get the version before this apply version, to be safe
+        RETURN_IF_ERROR(manager->get_latest_del_vec(meta, tsid, &old_del_vecs[i]));
+        old_del_vecs[i]->add_dels_as_new_version(del_ids, version.major(), &(new_del_vecs[i].second));
+        return Status::OK();
+    };
+    st = run_apply_tasks(manager->apply_worker_thread_pool(), delete_entries.size(), gen_delvec);
+    if (!st.ok()) {
+        LOG(ERROR) << "_apply_rowset_commit error: get_latest_del_vec failed: " << st << " " << debug_string();
+        _set_error();
+        return;
+    }
+    for (size_t idx = 0; idx < delete_entries.size(); idx++) {
+        uint32_t rssid = delete_entries[idx]->first;
+        auto& del_ids = delete_entries[idx]->second;
+        if (old_del_vecs[idx] == nullptr) {
             if (VLOG_IS_ON(1)) {
                 StringAppendF(&delvec_change_info, " %u:+%zu", rssid, del_ids.size());
             }
             new_del += del_ids.size();
             total_del += del_ids.size();
         } else {
-            TabletSegmentId tsid;
-            tsid.tablet_id = tablet_id;
-            tsid.segment_id = rssid;
-            DelVectorPtr old_del_vec;
-            // TODO(cbl): should get the version before this apply version, to be safe
-            st = manager->get_latest_del_vec(meta, tsid, &old_del_vec);
-            if (!st.ok()) {
-                LOG(ERROR) << "_apply_rowset_commit error: get_latest_del_vec failed: " << st << " " << debug_string();
-                _set_error();
-                return;
-            }
-            new_del_vecs[idx].first = rssid;
-            old_del_vec->add_dels_as_new_version(e.second, version.major(), &(new_del_vecs[idx].second));
+            auto& old_del_vec = old_del_vecs[idx];
             size_t cur_old = old_del_vec->cardinality();
-            size_t cur_add = e.second.size();
+            size_t cur_add = del_ids.size();
             size_t cur_new = new_del_vecs[idx].second->cardinality();
             if (cur_old + cur_add != cur_new) {
                 // should not happen, data inconsistent
@@ -801,8 +872,6 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
             total_del += cur_new;
         }
 
-        idx++;
-
         // Update the stats of affected rowsets.
         std::lock_guard lg(_rowset_stats_lock);
         auto iter = _rowset_stats.upper_bound(rssid);
@@ -818,7 +887,7 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
             DCHECK(false) << msg;
             LOG(ERROR) << msg;
         } else {
-            iter->second->num_dels += e.second.size();
+            iter->second->num_dels += del_ids.size();
             _calc_compaction_score(iter->second.get());
             DCHECK_LE(iter->second->num_dels, iter->second->num_rows);
         }
@@ -1120,7 +1189,10 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
         uint32_t rssid = rowset_id + i;
         tmp_deletes.clear();
         // replace will not grow hashtable, so don't need to check memory limit
-        index.try_replace(rssid, 0, *sstate.pkeys, sstate.src_rssids, &tmp_deletes);
+        {
+            std::unique_lock<std::shared_mutex> wl(_index_lock);
+            index.try_replace(rssid, 0, *sstate.pkeys, sstate.src_rssids, &tmp_deletes);
+        }
         DelVectorPtr dv = std::make_shared<DelVector>();
         if (tmp_deletes.empty()) {
             dv->init(version.major(), nullptr, 0);
@@ -1135,6 +1207,18 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
     }
     // release memory
     _compaction_state.reset();
+    // the changes of a persistent index is persisted before the version is applied in the meta
+    {
+        std::unique_lock<std::shared_mutex> wl(_index_lock);
+        st = index.commit(version);
+    }
+    if (!st.ok()) {
+        LOG(ERROR) << "_apply_compaction_commit error: commit primary index failed: " << st << " " << debug_string();
+        manager->index_cache().remove(index_entry);
+        _set_error();
+        return;
+    }
+    manager->index_cache().update_object_size(index_entry, index.memory_usage());
     // index may be used for later commits, so keep in cache
     manager->index_cache().release(index_entry);
     int64_t t_index_delvec = MonotonicMillis();
@@ -1691,6 +1775,145 @@ Status TabletUpdates::get_applied_rowsets(int64_t version, std::vector<RowsetSha
     return Status::NotFound(strings::Substitute("rowset version $0 not found", version));
 }
 
+Status TabletUpdates::get_column_values(const std::vector<uint32_t>& column_ids,
+                                        const std::map<uint32_t, std::vector<uint32_t>>& rowids_by_rssid,
+                                        std::vector<std::shared_ptr<vectorized::Column>>* columns) {
+    DCHECK_EQ(column_ids.size(), columns->size());
+    std::map<uint32_t, RowsetSharedPtr> rowsets;
+    {
+        std::lock_guard rl(_lock);
+        std::lock_guard<std::mutex> lg(_rowsets_lock);
+        for (uint32_t rsid : _versions[_apply_version_idx]->rowsets) {
+            auto itr = _rowsets.find(rsid);
+            if (itr == _rowsets.end()) {
+                return Status::NotFound(Substitute("get_column_values rowset not found: rowset:$0 $1", rsid,
+                                                   _debug_string(false, true)));
+            }
+            rowsets.emplace(rsid, itr->second);
+        }
+    }
+    return _get_column_values(rowsets, column_ids, rowids_by_rssid, columns);
+}
+
+Status TabletUpdates::_get_column_values(const std::map<uint32_t, RowsetSharedPtr>& rowsets,
+                                         const std::vector<uint32_t>& column_ids,
+                                         const std::map<uint32_t, std::vector<uint32_t>>& rowids_by_rssid,
+                                         std::vector<std::shared_ptr<vectorized::Column>>* columns) {
+    OlapReaderStatistics stats;
+    for (const auto& [rssid, rowids] : rowids_by_rssid) {
+        auto itr = rowsets.upper_bound(rssid);
+        if (itr == rowsets.begin()) {
+            return Status::NotFound(Substitute("get_column_values segment not found: rssid:$0", rssid));
+        }
+        --itr;
+        auto& rowset = itr->second;
+        uint32_t segment_id = rssid - itr->first;
+        if (segment_id >= rowset->num_segments()) {
+            return Status::NotFound(Substitute("get_column_values segment not found: rssid:$0", rssid));
+        }
+        RowsetReleaseGuard guard(rowset);
+        RETURN_IF_ERROR(rowset->load());
+        auto& segment = down_cast<BetaRowset*>(rowset.get())->segments()[segment_id];
+        std::unique_ptr<fs::ReadableBlock> rblock;
+        RETURN_IF_ERROR(fs::fs_util::block_manager()->open_block(segment->file_name(), &rblock));
+        for (size_t i = 0; i < column_ids.size(); i++) {
+            segment_v2::ColumnIterator* raw_iter = nullptr;
+            RETURN_IF_ERROR(segment->new_column_iterator(column_ids[i], &raw_iter));
+            std::unique_ptr<segment_v2::ColumnIterator> iter(raw_iter);
+            segment_v2::ColumnIteratorOptions iter_opts;
+            iter_opts.stats = &stats;
+            iter_opts.use_page_cache = !config::disable_storage_page_cache;
+            iter_opts.rblock = rblock.get();
+            RETURN_IF_ERROR(iter->init(iter_opts));
+            RETURN_IF_ERROR(iter->fetch_values_by_rowid(rowids.data(), rowids.size(), (*columns)[i].get()));
+        }
+    }
+    return Status::OK();
+}
+
+Status TabletUpdates::get_rows_by_keys(const vectorized::Chunk& keys, const std::vector<uint32_t>& column_ids,
+                                       std::vector<uint8_t>* found,
+                                       std::vector<std::shared_ptr<vectorized::Column>>* columns) {
+    DCHECK_EQ(column_ids.size(), columns->size());
+    const TabletSchema& tablet_schema = _tablet.tablet_schema();
+    vector<uint32_t> pk_columns(tablet_schema.num_key_columns());
+    for (uint32_t i = 0; i < pk_columns.size(); i++) {
+        pk_columns[i] = i;
+    }
+    auto pk_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, pk_columns);
+    std::unique_ptr<vectorized::Column> pk_column;
+    RETURN_IF_ERROR(PrimaryKeyEncoder::create_column(pk_schema, &pk_column));
+    PrimaryKeyEncoder::encode(pk_schema, keys, 0, keys.num_rows(), pk_column.get());
+
+    // 1. resolve the keys to their positions, (rssid << 32) | rowid
+    vector<uint64_t> positions;
+    std::map<uint32_t, RowsetSharedPtr> rowsets;
+    {
+        std::shared_lock<std::shared_mutex> rl(_index_lock);
+        auto manager = StorageEngine::instance()->update_manager();
+        auto index_entry = manager->index_cache().get_or_create(_tablet.tablet_id());
+        index_entry->update_expire_time(MonotonicMillis() + manager->get_cache_expire_ms());
+        auto& index = index_entry->value();
+        auto st = index.load(&_tablet);
+        manager->index_cache().update_object_size(index_entry, index.memory_usage());
+        if (!st.ok()) {
+            manager->index_cache().remove(index_entry);
+            return st;
+        }
+        index.get(*pk_column, &positions);
+        manager->index_cache().release(index_entry);
+        // the segments of the positions in the index are of the rowsets not removed yet, including the ones
+        // being applied.
+        std::lock_guard<std::mutex> lg(_rowsets_lock);
+        for (const auto& [rsid, rowset] : _rowsets) {
+            rowsets.emplace(rsid, rowset);
+        }
+    }
+
+    // 2. fetch the rows in the order of the positions, each distinct position once
+    vector<uint32_t> found_keys;
+    found->assign(keys.num_rows(), 0);
+    for (uint32_t i = 0; i < positions.size(); i++) {
+        if (positions[i] != PrimaryIndex::NullIndexValue) {
+            (*found)[i] = 1;
+            found_keys.push_back(i);
+        }
+    }
+    if (found_keys.empty()) {
+        return Status::OK();
+    }
+    vector<uint32_t> sorted_keys = found_keys;
+    std::sort(sorted_keys.begin(), sorted_keys.end(),
+              [&](uint32_t lhs, uint32_t rhs) { return positions[lhs] < positions[rhs]; });
+    std::map<uint32_t, std::vector<uint32_t>> rowids_by_rssid;
+    // the index of the row fetched of each key
+    vector<uint32_t> fetched(keys.num_rows());
+    uint32_t num_fetched = 0;
+    for (size_t i = 0; i < sorted_keys.size(); i++) {
+        uint64_t position = positions[sorted_keys[i]];
+        if (i == 0 || position != positions[sorted_keys[i - 1]]) {
+            rowids_by_rssid[(uint32_t)(position >> 32)].push_back((uint32_t)(position & 0xffffffff));
+            num_fetched++;
+        }
+        fetched[sorted_keys[i]] = num_fetched - 1;
+    }
+    std::vector<std::shared_ptr<vectorized::Column>> fetched_columns(columns->size());
+    for (size_t i = 0; i < columns->size(); i++) {
+        fetched_columns[i] = (*columns)[i]->clone_empty();
+    }
+    RETURN_IF_ERROR(_get_column_values(rowsets, column_ids, rowids_by_rssid, &fetched_columns));
+
+    // 3. reorder the rows fetched by the keys
+    vector<uint32_t> selection(found_keys.size());
+    for (size_t i = 0; i < found_keys.size(); i++) {
+        selection[i] = fetched[found_keys[i]];
+    }
+    for (size_t i = 0; i < columns->size(); i++) {
+        (*columns)[i]->append_selective(*fetched_columns[i], selection.data(), 0, selection.size());
+    }
+    return Status::OK();
+}
+
 struct RowsetLoadInfo {
     uint32_t rowset_id = 0;
     uint32_t num_segments = 0;
@@ -1813,8 +2036,13 @@ Status TabletUpdates::load_from_base_tablet(int64_t request_version, Tablet* bas
     auto index_entry = update_manager->index_cache().get_or_create(tablet_id);
     index_entry->update_expire_time(MonotonicMillis() + update_manager->get_cache_expire_ms());
     auto& index = index_entry->value();
-    index.unload();
+    {
+        std::unique_lock<std::shared_mutex> wl(_index_lock);
+        index.unload();
+    }
     update_manager->index_cache().release(index_entry);
+    // the persistent index of the old data is rebuilt by the next load
+    WARN_IF_ERROR(PersistentIndex::remove_files(_tablet.tablet_path()), "fail to remove persistent index");
     _tablet.set_tablet_state(TabletState::TABLET_RUNNING);
     LOG(INFO) << "load_from_base_tablet finish tablet:" << _tablet.tablet_id() << " version:" << this->max_version()
               << " #pending:" << _pending_commits.size();
@@ -2075,8 +2303,13 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
         auto& index_cache = manager->index_cache();
         auto index_entry = index_cache.get_or_create(tablet_id);
         index_entry->update_expire_time(MonotonicMillis() + manager->get_cache_expire_ms());
-        index_entry->value().unload();
+        {
+            std::unique_lock<std::shared_mutex> wl(_index_lock);
+            index_entry->value().unload();
+        }
         index_cache.release(index_entry);
+        // the persistent index of the old data is rebuilt by the next load
+        WARN_IF_ERROR(PersistentIndex::remove_files(_tablet.tablet_path()), "fail to remove persistent index");
 
         _apply_version_changed.notify_all();
         return Status::OK();
@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <map>
 #include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
@@ -26,7 +27,9 @@ class Tablet;
 class TTabletInfo;
 
 namespace vectorized {
+class Chunk;
 class ChunkIterator;
+class Column;
 class CompactionState;
 class RowsetReadOptions;
 class Schema;
@@ -81,6 +84,9 @@ public:
     // get latest version's version
     int64_t max_version() const;
 
+    // get latest version's creation time
+    int64_t max_version_creation_time() const;
+
     // get total number of committed and pending rowsets
     size_t version_count() const;
 
@@ -149,6 +155,20 @@ public:
     Status get_applied_rowsets(int64_t version, std::vector<RowsetSharedPtr>* rowsets,
                                EditVersion* full_version = nullptr);
 
+    // Append the values of the columns |column_ids| of the rows |rowids_by_rssid| of the last applied version into
+    // |columns|, in the order of the segments and then the rowids, which must be ascending in a segment.
+    Status get_column_values(const std::vector<uint32_t>& column_ids,
+                             const std::map<uint32_t, std::vector<uint32_t>>& rowids_by_rssid,
+                             std::vector<std::shared_ptr<vectorized::Column>>* columns);
+
+    // The point lookups of the primary keys |keys|, whose columns are the key columns of the tablet. The rows of
+    // the keys are resolved by the primary index to their segments without a scan, and the values of the columns
+    // |column_ids| of the rows are appended into |columns| in the order of |keys|. The keys not found are skipped,
+    // and |found| is set to whether each key is found. The rows are the latest ones upserted into the index, which
+    // may be of a version being applied.
+    Status get_rows_by_keys(const vectorized::Chunk& keys, const std::vector<uint32_t>& column_ids,
+                            std::vector<uint8_t>* found, std::vector<std::shared_ptr<vectorized::Column>>* columns);
+
     void to_updates_pb(TabletUpdatesPB* updates_pb) const;
 
     // Used for schema change, migrate another tablet's version&rowsets to this tablet
@@ -194,7 +214,7 @@ private:
     Status _get_rowsets(int64_t version, std::vector<RowsetSharedPtr>* rowsets, EditVersion* full_version);
 
     // used for PrimaryIndex load
-    Status _get_apply_version_and_rowsets(int64_t* version, std::vector<RowsetSharedPtr>* rowsets,
+    Status _get_apply_version_and_rowsets(EditVersion* version, std::vector<RowsetSharedPtr>* rowsets,
                                           std::vector<uint32_t>* rowset_ids);
 
     void _redo_edit_version_log(const EditVersionMetaPB& v);
@@ -217,6 +237,12 @@ private:
 
     RowsetSharedPtr _get_rowset(uint32_t rowset_id);
 
+    // The same as get_column_values(), of the segments of |rowsets| by their rowset ids.
+    Status _get_column_values(const std::map<uint32_t, RowsetSharedPtr>& rowsets,
+                              const std::vector<uint32_t>& column_ids,
+                              const std::map<uint32_t, std::vector<uint32_t>>& rowids_by_rssid,
+                              std::vector<std::shared_ptr<vectorized::Column>>* columns);
+
     // wait a version to be applied, so reader can read this version
     // assuming _lock already hold
     Status _wait_for_version(const EditVersion& version, int64_t timeout_ms);
@@ -281,6 +307,10 @@ private:
     mutable std::mutex _rowsets_lock;
     std::unordered_map<uint32_t, RowsetSharedPtr> _rowsets;
 
+    // The updates and the unloads of the primary index hold it exclusively, and the point lookups hold it shared,
+    // since the index is not thread-safe.
+    mutable std::shared_mutex _index_lock;
+
     // used for async apply, make sure at most 1 thread is doing applying
     mutable std::mutex _apply_running_lock;
     // apply process is running currently
@@ -21,8 +21,13 @@
 
 #include "storage/task/engine_clone_task.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <unordered_map>
 
 #include "env/env.h"
 #include "gen_cpp/BackendService.h"
@@ -53,6 +58,61 @@ const uint32_t DOWNLOAD_FILE_MAX_RETRY = 3;
 const uint32_t LIST_REMOTE_FILE_TIMEOUT = 15;
 const uint32_t GET_LENGTH_TIMEOUT = 10;
 
+// Limits the concurrent downloads of all the clones into a data dir to config::clone_download_concurrency_per_disk.
+class DiskDownloadLimiter {
+public:
+    static DiskDownloadLimiter* instance() {
+        static DiskDownloadLimiter s_limiter;
+        return &s_limiter;
+    }
+
+    void acquire(DataDir* data_dir) {
+        std::unique_lock l(_mutex);
+        _cv.wait(l, [&] { return _downloads[data_dir] < std::max(1, config::clone_download_concurrency_per_disk); });
+        _downloads[data_dir]++;
+    }
+
+    void release(DataDir* data_dir) {
+        std::lock_guard l(_mutex);
+        _downloads[data_dir]--;
+        _cv.notify_all();
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::unordered_map<DataDir*, int> _downloads;
+};
+
+static uint64_t estimate_download_timeout(uint64_t bytes) {
+    uint64_t estimate_timeout = bytes / config::download_low_speed_limit_kbps / 1024;
+    return std::max<uint64_t>(estimate_timeout, config::download_low_speed_time);
+}
+
+static Status download_whole_file(const std::string& remote_file_url, const std::string& local_file_path,
+                                  uint64_t file_size) {
+    uint64_t estimate_timeout = estimate_download_timeout(file_size);
+    LOG(INFO) << "Downloading " << remote_file_url << " to " << local_file_path << ". bytes=" << file_size
+              << " timeout=" << estimate_timeout;
+
+    auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(remote_file_url));
+        client->set_timeout_ms(estimate_timeout * 1000);
+        RETURN_IF_ERROR(client->download(local_file_path));
+
+        // Check file length
+        uint64_t local_file_size = std::filesystem::file_size(local_file_path);
+        if (local_file_size != file_size) {
+            LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
+                         << file_size;
+            return Status::InternalError("mismatched file size");
+        }
+        chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
+        return Status::OK();
+    };
+    return HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+}
+
 EngineCloneTask::EngineCloneTask(MemTracker* tablet_meta_mem_tracker, const TCloneReq& clone_req,
                                  const TMasterInfo& master_info, int64_t signature, std::vector<string>* error_msgs,
                                  std::vector<TTabletInfo>* tablet_infos, AgentStatus* res_status)
@@ -360,56 +420,75 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
         }
     }
 
-    // Get copy from remote
+    // Get the file sizes from remote
+    std::vector<uint64_t> file_sizes(file_name_list.size(), 0);
     uint64_t total_file_size = 0;
-    MonotonicStopWatch watch;
-    watch.start();
-    for (auto& file_name : file_name_list) {
-        auto remote_file_url = remote_url_prefix + file_name;
-
-        // get file length
-        uint64_t file_size = 0;
-        auto get_file_size_cb = [&remote_file_url, &file_size](HttpClient* client) {
+    for (size_t i = 0; i < file_name_list.size(); ++i) {
+        auto remote_file_url = remote_url_prefix + file_name_list[i];
+        uint64_t* file_size = &file_sizes[i];
+        auto get_file_size_cb = [&remote_file_url, file_size](HttpClient* client) {
             RETURN_IF_ERROR(client->init(remote_file_url));
             client->set_timeout_ms(GET_LENGTH_TIMEOUT * 1000);
             RETURN_IF_ERROR(client->head());
-            file_size = client->get_content_length();
+            *file_size = client->get_content_length();
             return Status::OK();
         };
         RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, get_file_size_cb));
-        // check disk capacity
-        if (data_dir->reach_capacity_limit(file_size)) {
-            return Status::InternalError("Disk reach capacity limit");
-        }
+        total_file_size += *file_size;
+    }
+    // check disk capacity
+    if (data_dir->reach_capacity_limit(total_file_size)) {
+        return Status::InternalError("Disk reach capacity limit");
+    }
 
-        total_file_size += file_size;
-        uint64_t estimate_timeout = file_size / config::download_low_speed_limit_kbps / 1024;
-        if (estimate_timeout < config::download_low_speed_time) {
-            estimate_timeout = config::download_low_speed_time;
+    // Get copy from remote. The data files are downloaded by the ranges concurrently, and the header file is
+    // downloaded at last after all of them.
+    MonotonicStopWatch watch;
+    watch.start();
+    size_t num_data_files = file_name_list.size();
+    if (num_data_files > 0 && StringPiece(file_name_list.back()).ends_with(".hdr")) {
+        num_data_files--;
+    }
+    std::vector<DownloadRange> ranges;
+    std::vector<size_t> whole_files;
+    const uint64_t range_bytes = std::max<int64_t>(config::clone_download_range_bytes, 1024 * 1024);
+    for (size_t i = 0; i < num_data_files; ++i) {
+        if (file_sizes[i] == 0) {
+            whole_files.push_back(i);
+            continue;
         }
-
-        std::string local_file_path = local_path + file_name;
-
-        LOG(INFO) << "Downloading " << remote_file_url << " to " << local_file_path << ". bytes=" << file_size
-                  << " timeout=" << estimate_timeout;
-
-        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size](HttpClient* client) {
-            RETURN_IF_ERROR(client->init(remote_file_url));
-            client->set_timeout_ms(estimate_timeout * 1000);
-            RETURN_IF_ERROR(client->download(local_file_path));
-
-            // Check file length
-            uint64_t local_file_size = std::filesystem::file_size(local_file_path);
-            if (local_file_size != file_size) {
-                LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
-                             << file_size;
-                return Status::InternalError("mismatched file size");
-            }
-            chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
-            return Status::OK();
-        };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
-    } // Clone files from remote backend
+        for (uint64_t offset = 0; offset < file_sizes[i]; offset += range_bytes) {
+            ranges.push_back({i, offset, std::min(range_bytes, file_sizes[i] - offset)});
+        }
+    }
+    Status st = _download_ranges(data_dir, remote_url_prefix, local_path, file_name_list, ranges);
+    if (st.is_not_supported()) {
+        // The source BE doesn't support the ranges, download the files one by one.
+        LOG(INFO) << "Downloading the whole files of tablet " << _signature << " from " << remote_url_prefix;
+        whole_files.clear();
+        for (size_t i = 0; i < num_data_files; ++i) {
+            whole_files.push_back(i);
+        }
+    } else if (!st.ok()) {
+        return st;
+    }
+    for (size_t i = num_data_files; i < file_name_list.size(); ++i) {
+        whole_files.push_back(i);
+    }
+    for (size_t i : whole_files) {
+        RETURN_IF_ERROR(download_whole_file(remote_url_prefix + file_name_list[i], local_path + file_name_list[i],
+                                            file_sizes[i]));
+    }
+    for (size_t i = 0; i < num_data_files; ++i) {
+        std::string local_file_path = local_path + file_name_list[i];
+        uint64_t local_file_size = std::filesystem::file_size(local_file_path);
+        if (local_file_size != file_sizes[i]) {
+            LOG(WARNING) << "Fail to download " << remote_url_prefix << file_name_list[i]
+                         << ". file_size=" << local_file_size << "/" << file_sizes[i];
+            return Status::InternalError("mismatched file size");
+        }
+        chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
+    }
 
     uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
     total_time_ms = total_time_ms > 0 ? total_time_ms : 0;
@@ -422,6 +501,64 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
     return Status::OK();
 }
 
+Status EngineCloneTask::_download_ranges(DataDir* data_dir, const std::string& remote_url_prefix,
+                                         const std::string& local_path, const std::vector<string>& file_names,
+                                         const std::vector<DownloadRange>& ranges) {
+    if (ranges.empty()) {
+        return Status::OK();
+    }
+    const size_t num_threads =
+            std::min<size_t>(std::max(1, config::clone_download_concurrency_per_disk), ranges.size());
+    // The max download speed is shared by the concurrent downloads.
+    const int64_t max_speed_kbps = std::max<int64_t>(1, config::max_download_speed_kbps / num_threads);
+    LOG(INFO) << "Downloading " << ranges.size() << " ranges of " << remote_url_prefix << " by " << num_threads
+              << " threads, max_speed_kbps=" << max_speed_kbps;
+
+    std::atomic<size_t> next_range{0};
+    std::mutex status_mutex;
+    Status status;
+    std::atomic<bool> failed{false};
+    auto download = [&]() {
+        while (!failed.load()) {
+            size_t i = next_range.fetch_add(1);
+            if (i >= ranges.size()) {
+                break;
+            }
+            const DownloadRange& range = ranges[i];
+            std::string remote_file_url = remote_url_prefix + file_names[range.file_index];
+            std::string local_file_path = local_path + file_names[range.file_index];
+            uint64_t estimate_timeout = estimate_download_timeout(range.length);
+            auto download_cb = [&](HttpClient* client) {
+                RETURN_IF_ERROR(client->init(remote_file_url));
+                client->set_timeout_ms(estimate_timeout * 1000);
+                return client->download_range(local_file_path, range.offset, range.length, max_speed_kbps);
+            };
+            DiskDownloadLimiter::instance()->acquire(data_dir);
+            Status st = HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+            DiskDownloadLimiter::instance()->release(data_dir);
+            if (!st.ok()) {
+                LOG(WARNING) << "Fail to download " << remote_file_url << " range " << range.offset << "+"
+                             << range.length << ": " << st.to_string();
+                std::lock_guard l(status_mutex);
+                if (status.ok()) {
+                    status = st;
+                }
+                failed.store(true);
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(download);
+    }
+    download();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return status;
+}
+
 Status EngineCloneTask::_finish_clone(Tablet* tablet, const string& clone_dir, int64_t committed_version,
                                       bool incremental_clone) {
     if (tablet->updates() != nullptr) {
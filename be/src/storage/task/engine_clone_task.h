@@ -61,6 +61,18 @@ private:
     // Download tablet files from
     Status _download_files(DataDir* data_dir, const std::string& remote_url_prefix, const std::string& local_path);
 
+    // The |length| bytes from |offset| of the file |file_index| of a snapshot.
+    struct DownloadRange {
+        size_t file_index;
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    // Download the ranges concurrently, by at most config::clone_download_concurrency_per_disk threads. Returns
+    // NotSupported if the source BE doesn't support the ranges.
+    Status _download_ranges(DataDir* data_dir, const std::string& remote_url_prefix, const std::string& local_path,
+                            const std::vector<std::string>& file_names, const std::vector<DownloadRange>& ranges);
+
     Status _make_snapshot(const std::string& ip, int port, TTableId tablet_id, TSchemaHash schema_hash, int timeout_s,
                           const std::vector<Version>* missed_versions, std::string* snapshot_path,
                           int32_t* snapshot_version);
@@ -22,121 +22,196 @@
 #include "storage/task/engine_publish_version_task.h"
 
 #include <map>
+#include <set>
 
 #include "storage/data_dir.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/tablet_manager.h"
 #include "storage/update_manager.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
 using std::map;
 
-EnginePublishVersionTask::EnginePublishVersionTask(TPublishVersionRequest& publish_version_req,
-                                                   std::vector<TTabletId>* error_tablet_ids)
-        : _publish_version_req(publish_version_req), _error_tablet_ids(error_tablet_ids) {}
+// The publish of a transaction on a tablet.
+struct EnginePublishVersionTask::TabletPublish {
+    size_t req_index;
+    // the index of the partition in the partitions of the requests
+    size_t partition_index;
+    TPartitionId partition_id;
+    TTransactionId transaction_id;
+    TabletInfo tablet_info;
+    TabletSharedPtr tablet;
+    RowsetSharedPtr rowset;
+    Version version;
+    VersionHash version_hash;
+    OLAPStatus status = OLAP_SUCCESS;
+};
+
+namespace {
+
+// The tablets of a partition to check if they have the version published, in the strict mode.
+struct PartitionPublish {
+    size_t req_index;
+    Version version;
+    std::set<TabletInfo> related_tablet_infos;
+};
+
+} // namespace
+
+EnginePublishVersionTask::EnginePublishVersionTask(
+        const std::vector<const TPublishVersionRequest*>& publish_version_reqs,
+        std::vector<std::vector<TTabletId>>* error_tablet_ids, std::vector<OLAPStatus>* results)
+        : _publish_version_reqs(publish_version_reqs), _error_tablet_ids(error_tablet_ids), _results(results) {}
 
 OLAPStatus EnginePublishVersionTask::finish() {
-    OLAPStatus res = OLAP_SUCCESS;
-    int64_t transaction_id = _publish_version_req.transaction_id;
-
-    // each partition
-    for (auto& par_ver_info : _publish_version_req.partition_version_infos) {
-        int64_t partition_id = par_ver_info.partition_id;
-        // get all partition related tablets and check whether the tablet have the related version
-        std::set<TabletInfo> partition_related_tablet_infos;
-        StorageEngine::instance()->tablet_manager()->get_partition_related_tablets(partition_id,
-                                                                                   &partition_related_tablet_infos);
-        if (_publish_version_req.strict_mode && partition_related_tablet_infos.empty()) {
-            VLOG(1) << "could not find related tablet for partition " << partition_id << ", skip publish version";
-            continue;
-        }
+    const size_t num_reqs = _publish_version_reqs.size();
+    _error_tablet_ids->assign(num_reqs, std::vector<TTabletId>());
+    _results->assign(num_reqs, OLAP_SUCCESS);
+    TabletManager* tablet_manager = StorageEngine::instance()->tablet_manager();
+    TxnManager* txn_manager = StorageEngine::instance()->txn_manager();
 
-        map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
-        StorageEngine::instance()->txn_manager()->get_txn_related_tablets(transaction_id, partition_id,
-                                                                          &tablet_related_rs);
-
-        Version version(par_ver_info.version, par_ver_info.version);
-        VersionHash version_hash = par_ver_info.version_hash;
-
-        // each tablet
-        for (auto& tablet_rs : tablet_related_rs) {
-            OLAPStatus publish_status = OLAP_SUCCESS;
-            const TabletInfo& tablet_info = tablet_rs.first;
-            const RowsetSharedPtr& rowset = tablet_rs.second;
-            VLOG(1) << "begin to publish version on tablet. "
-                    << "tablet_id=" << tablet_info.tablet_id << ", schema_hash=" << tablet_info.schema_hash
-                    << ", version=" << version.first << ", version_hash=" << version_hash
-                    << ", transaction_id=" << transaction_id;
-            // if rowset is null, it means this be received write task, but failed during write
-            // and receive fe's publish version task
-            // this be must return as an error tablet
-            if (rowset == nullptr) {
-                LOG(WARNING) << "could not find related rowset for tablet " << tablet_info.tablet_id << " txn id "
-                             << transaction_id;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
-                res = OLAP_ERR_PUSH_ROWSET_NOT_FOUND;
-                continue;
-            }
-            TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(
-                    tablet_info.tablet_id, tablet_info.schema_hash, tablet_info.tablet_uid);
-            if (tablet == nullptr) {
-                LOG(WARNING) << "can't get tablet when publish version. tablet_id=" << tablet_info.tablet_id
-                             << " schema_hash=" << tablet_info.schema_hash;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
-                res = OLAP_ERR_PUSH_TABLE_NOT_EXIST;
+    std::vector<PartitionPublish> partitions;
+    // the publishes of each tablet, in the order of the requests
+    map<TTabletId, std::vector<TabletPublish>> tablet_publishes;
+    for (size_t i = 0; i < num_reqs; ++i) {
+        const TPublishVersionRequest& publish_version_req = *_publish_version_reqs[i];
+        int64_t transaction_id = publish_version_req.transaction_id;
+
+        // each partition
+        for (auto& par_ver_info : publish_version_req.partition_version_infos) {
+            int64_t partition_id = par_ver_info.partition_id;
+            // get all partition related tablets and check whether the tablet have the related version
+            std::set<TabletInfo> partition_related_tablet_infos;
+            tablet_manager->get_partition_related_tablets(partition_id, &partition_related_tablet_infos);
+            if (publish_version_req.strict_mode && partition_related_tablet_infos.empty()) {
+                VLOG(1) << "could not find related tablet for partition " << partition_id << ", skip publish version";
                 continue;
             }
 
-            if (tablet->keys_type() == KeysType::PRIMARY_KEYS) {
-                VLOG(1) << "UpdateManager::on_rowset_published tablet:" << tablet->tablet_id()
-                        << " rowset: " << rowset->rowset_id().to_string() << " version: " << version.second;
-                publish_status = StorageEngine::instance()->txn_manager()->publish_txn2(transaction_id, partition_id,
-                                                                                        tablet, version.second);
-            } else {
-                publish_status = StorageEngine::instance()->txn_manager()->publish_txn(
-                        partition_id, tablet, transaction_id, version, version_hash);
+            map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+            txn_manager->get_txn_related_tablets(transaction_id, partition_id, &tablet_related_rs);
+
+            Version version(par_ver_info.version, par_ver_info.version);
+            VersionHash version_hash = par_ver_info.version_hash;
+            size_t partition_index = partitions.size();
+            partitions.push_back({i, version, std::move(partition_related_tablet_infos)});
+
+            // each tablet
+            for (auto& tablet_rs : tablet_related_rs) {
+                const TabletInfo& tablet_info = tablet_rs.first;
+                const RowsetSharedPtr& rowset = tablet_rs.second;
+                VLOG(1) << "begin to publish version on tablet. "
+                        << "tablet_id=" << tablet_info.tablet_id << ", schema_hash=" << tablet_info.schema_hash
+                        << ", version=" << version.first << ", version_hash=" << version_hash
+                        << ", transaction_id=" << transaction_id;
+                // if rowset is null, it means this be received write task, but failed during write
+                // and receive fe's publish version task
+                // this be must return as an error tablet
+                if (rowset == nullptr) {
+                    LOG(WARNING) << "could not find related rowset for tablet " << tablet_info.tablet_id
+                                 << " txn id " << transaction_id;
+                    (*_error_tablet_ids)[i].push_back(tablet_info.tablet_id);
+                    (*_results)[i] = OLAP_ERR_PUSH_ROWSET_NOT_FOUND;
+                    continue;
+                }
+                TabletSharedPtr tablet = tablet_manager->get_tablet(tablet_info.tablet_id, tablet_info.schema_hash,
+                                                                    tablet_info.tablet_uid);
+                if (tablet == nullptr) {
+                    LOG(WARNING) << "can't get tablet when publish version. tablet_id=" << tablet_info.tablet_id
+                                 << " schema_hash=" << tablet_info.schema_hash;
+                    (*_error_tablet_ids)[i].push_back(tablet_info.tablet_id);
+                    (*_results)[i] = OLAP_ERR_PUSH_TABLE_NOT_EXIST;
+                    continue;
+                }
+                tablet_publishes[tablet_info.tablet_id].push_back({i, partition_index, partition_id, transaction_id,
+                                                                    tablet_info, tablet, rowset, version,
+                                                                    version_hash});
             }
-            if (publish_status != OLAP_SUCCESS) {
-                LOG(WARNING) << "failed to publish version. rowset_id=" << rowset->rowset_id()
-                             << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
-                res = publish_status;
+        }
+    }
+
+    // make the rowsets visible and put their metas into the write batches of their data dirs, the updatable
+    // tablets commit the rowsets by themselves.
+    map<DataDir*, WriteBatch> batches;
+    for (auto& [tablet_id, publishes] : tablet_publishes) {
+        for (auto& publish : publishes) {
+            if (publish.tablet->keys_type() == KeysType::PRIMARY_KEYS) {
                 continue;
             }
-
-            if (tablet->keys_type() != KeysType::PRIMARY_KEYS) {
-                // add visible rowset to tablet
-                publish_status = tablet->add_inc_rowset(rowset);
-                if (publish_status != OLAP_SUCCESS && publish_status != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
-                    LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id=" << rowset->rowset_id()
-                                 << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id
-                                 << ", res=" << publish_status;
-                    _error_tablet_ids->push_back(tablet_info.tablet_id);
-                    res = publish_status;
-                    continue;
+            publish.status = txn_manager->prepare_publish_txn(publish.partition_id, publish.tablet,
+                                                              publish.transaction_id, publish.version,
+                                                              publish.version_hash,
+                                                              &batches[publish.tablet->data_dir()]);
+        }
+    }
+    std::set<DataDir*> failed_data_dirs;
+    for (auto& [data_dir, batch] : batches) {
+        Status st = data_dir->get_meta()->write_batch(&batch);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to save the rowset metas published on " << data_dir->path() << ": "
+                         << st.to_string();
+            failed_data_dirs.insert(data_dir);
+        }
+    }
+    if (!failed_data_dirs.empty()) {
+        for (auto& [tablet_id, publishes] : tablet_publishes) {
+            for (auto& publish : publishes) {
+                if (publish.tablet->keys_type() != KeysType::PRIMARY_KEYS && publish.status == OLAP_SUCCESS &&
+                    failed_data_dirs.count(publish.tablet->data_dir()) > 0) {
+                    publish.status = OLAP_ERR_ROWSET_SAVE_FAILED;
                 }
             }
-            partition_related_tablet_infos.erase(tablet_info);
-            VLOG(1) << "publish version successfully on tablet. tablet=" << tablet->full_name()
-                    << ", transaction_id=" << transaction_id << ", version=" << version.first
-                    << ", res=" << publish_status;
         }
+    }
 
-        // check if the related tablet remained all have the version
-        for (auto& tablet_info : partition_related_tablet_infos) {
-            // has to use strict mode to check if check all tablets
-            if (!_publish_version_req.strict_mode) {
-                break;
+    ThreadPool* thread_pool = StorageEngine::instance()->publish_version_thread_pool();
+    if (thread_pool != nullptr && tablet_publishes.size() > 1) {
+        auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+        for (auto& [tablet_id, publishes] : tablet_publishes) {
+            auto* tablet_publish = &publishes;
+            if (!token->submit_func([this, tablet_publish]() { _publish_tablet(tablet_publish); }).ok()) {
+                _publish_tablet(tablet_publish);
             }
-            TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_info.tablet_id,
-                                                                                             tablet_info.schema_hash);
+        }
+        token->wait();
+    } else {
+        for (auto& [tablet_id, publishes] : tablet_publishes) {
+            _publish_tablet(&publishes);
+        }
+    }
+
+    for (auto& [tablet_id, publishes] : tablet_publishes) {
+        for (auto& publish : publishes) {
+            if (publish.status != OLAP_SUCCESS) {
+                LOG(WARNING) << "failed to publish version. rowset_id=" << publish.rowset->rowset_id()
+                             << ", tablet_id=" << tablet_id << ", txn_id=" << publish.transaction_id
+                             << ", res=" << publish.status;
+                (*_error_tablet_ids)[publish.req_index].push_back(tablet_id);
+                (*_results)[publish.req_index] = publish.status;
+                continue;
+            }
+            partitions[publish.partition_index].related_tablet_infos.erase(publish.tablet_info);
+            VLOG(1) << "publish version successfully on tablet. tablet=" << publish.tablet->full_name()
+                    << ", transaction_id=" << publish.transaction_id << ", version=" << publish.version.first;
+        }
+    }
+
+    // check if the related tablet remained all have the version
+    for (auto& partition : partitions) {
+        // has to use strict mode to check if check all tablets
+        if (!_publish_version_reqs[partition.req_index]->strict_mode) {
+            continue;
+        }
+        for (auto& tablet_info : partition.related_tablet_infos) {
+            TabletSharedPtr tablet = tablet_manager->get_tablet(tablet_info.tablet_id, tablet_info.schema_hash);
             if (tablet == nullptr) {
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
+                (*_error_tablet_ids)[partition.req_index].push_back(tablet_info.tablet_id);
             } else {
                 // check if the version exist, if not exist, then set publish failed
-                if (!tablet->check_version_exist(version)) {
-                    _error_tablet_ids->push_back(tablet_info.tablet_id);
+                if (!tablet->check_version_exist(partition.version)) {
+                    (*_error_tablet_ids)[partition.req_index].push_back(tablet_info.tablet_id);
                     // TODO(zc)
                     // generate a pull rowset meta task to pull rowset from remote meta store and storage
                     // pull rowset meta using tablet_id + txn_id
@@ -146,9 +221,43 @@ OLAPStatus EnginePublishVersionTask::finish() {
         }
     }
 
-    VLOG(1) << "finish to publish version on transaction."
-            << "transaction_id=" << transaction_id << ", error_tablet_size=" << _error_tablet_ids->size();
+    OLAPStatus res = OLAP_SUCCESS;
+    for (size_t i = 0; i < num_reqs; ++i) {
+        VLOG(1) << "finish to publish version on transaction."
+                << "transaction_id=" << _publish_version_reqs[i]->transaction_id
+                << ", error_tablet_size=" << (*_error_tablet_ids)[i].size();
+        if (res == OLAP_SUCCESS) {
+            res = (*_results)[i];
+        }
+    }
     return res;
 }
 
+void EnginePublishVersionTask::_publish_tablet(std::vector<TabletPublish>* publishes) {
+    TxnManager* txn_manager = StorageEngine::instance()->txn_manager();
+    for (auto& publish : *publishes) {
+        if (publish.status != OLAP_SUCCESS) {
+            continue;
+        }
+        const TabletSharedPtr& tablet = publish.tablet;
+        if (tablet->keys_type() == KeysType::PRIMARY_KEYS) {
+            VLOG(1) << "UpdateManager::on_rowset_published tablet:" << tablet->tablet_id()
+                    << " rowset: " << publish.rowset->rowset_id().to_string()
+                    << " version: " << publish.version.second;
+            publish.status = txn_manager->publish_txn2(publish.transaction_id, publish.partition_id, tablet,
+                                                       publish.version.second);
+            continue;
+        }
+        // the rowset meta is persisted, remove the txn and add the visible rowset to the tablet
+        txn_manager->finish_publish_txn(publish.partition_id, tablet, publish.transaction_id, publish.version);
+        OLAPStatus st = tablet->add_inc_rowset(publish.rowset);
+        if (st != OLAP_SUCCESS && st != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+            LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id=" << publish.rowset->rowset_id()
+                         << ", tablet_id=" << tablet->tablet_id() << ", txn_id=" << publish.transaction_id
+                         << ", res=" << st;
+            publish.status = st;
+        }
+    }
+}
+
 } // namespace starrocks
@@ -22,22 +22,37 @@
 #ifndef STARROCKS_BE_SRC_OLAP_TASK_ENGINE_PUBLISH_VERSION_TASK_H
 #define STARROCKS_BE_SRC_OLAP_TASK_ENGINE_PUBLISH_VERSION_TASK_H
 
+#include <vector>
+
 #include "gen_cpp/AgentService_types.h"
 #include "storage/olap_define.h"
 #include "storage/task/engine_task.h"
 
 namespace starrocks {
 
+// Publish the versions of a batch of transactions. The publishes of the transactions are grouped by the tablets,
+// and the tablets are published in parallel on StorageEngine::publish_version_thread_pool(), while the publishes on
+// the same tablet are in the order of the transactions. The rowset metas of the tablets on the same data dir are
+// persisted in one write batch.
 class EnginePublishVersionTask : public EngineTask {
 public:
-    EnginePublishVersionTask(TPublishVersionRequest& publish_version_req, vector<TTabletId>* error_tablet_ids);
-    virtual ~EnginePublishVersionTask() override {}
+    // The tablets failed to publish the i-th request are appended to (*error_tablet_ids)[i], and its result is set to
+    // (*results)[i].
+    EnginePublishVersionTask(const std::vector<const TPublishVersionRequest*>& publish_version_reqs,
+                             std::vector<std::vector<TTabletId>>* error_tablet_ids, std::vector<OLAPStatus>* results);
+    ~EnginePublishVersionTask() override = default;
 
+    // Return OLAP_SUCCESS if all the requests are published.
     OLAPStatus finish() override;
 
 private:
-    const TPublishVersionRequest& _publish_version_req;
-    vector<TTabletId>* _error_tablet_ids;
+    struct TabletPublish;
+
+    void _publish_tablet(std::vector<TabletPublish>* publishes);
+
+    const std::vector<const TPublishVersionRequest*>& _publish_version_reqs;
+    std::vector<std::vector<TTabletId>>* _error_tablet_ids;
+    std::vector<OLAPStatus>* _results;
 };
 
 } // namespace starrocks
@@ -238,22 +238,8 @@ OLAPStatus TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id, TT
                                    const Version& version, VersionHash version_hash) {
     pair<int64_t, int64_t> key(partition_id, transaction_id);
     TabletInfo tablet_info(tablet_id, schema_hash, tablet_uid);
-    RowsetSharedPtr rowset_ptr = nullptr;
     std::lock_guard txn_lock(_get_txn_lock(transaction_id));
-    {
-        std::shared_lock rlock(_get_txn_map_lock(transaction_id));
-        txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
-        auto it = txn_tablet_map.find(key);
-        if (it != txn_tablet_map.end()) {
-            auto load_itr = it->second.find(tablet_info);
-            if (load_itr != it->second.end()) {
-                // found load for txn,tablet
-                // case 1: user commit rowset, then the load id must be equal
-                TabletTxnInfo& load_info = load_itr->second;
-                rowset_ptr = load_info.rowset;
-            }
-        }
-    }
+    RowsetSharedPtr rowset_ptr = _get_txn_rowset(key, tablet_info);
     // save meta need access disk, it maybe very slow, so that it is not in global txn lock
     // it is under a single txn lock
     if (rowset_ptr != nullptr) {
@@ -270,22 +256,73 @@ OLAPStatus TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id, TT
     } else {
         return OLAP_ERR_TRANSACTION_NOT_EXIST;
     }
-    {
-        std::unique_lock wrlock(_get_txn_map_lock(transaction_id));
-        txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
-        auto it = txn_tablet_map.find(key);
-        if (it != txn_tablet_map.end()) {
-            it->second.erase(tablet_info);
-            LOG(INFO) << "publish txn successfully."
-                      << " partition_id: " << key.first << ", txn_id: " << key.second
-                      << ", tablet: " << tablet_info.to_string() << ", rowsetid: " << rowset_ptr->rowset_id()
-                      << ", version: " << version.first << "," << version.second;
-            if (it->second.empty()) {
-                txn_tablet_map.erase(it);
-                _clear_txn_partition_map_unlocked(transaction_id, partition_id);
-            }
+    _remove_published_txn(key, tablet_info, rowset_ptr, version);
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus TxnManager::prepare_publish_txn(TPartitionId partition_id, const TabletSharedPtr& tablet,
+                                           TTransactionId transaction_id, const Version& version,
+                                           VersionHash version_hash, WriteBatch* batch) {
+    pair<int64_t, int64_t> key(partition_id, transaction_id);
+    TabletInfo tablet_info(tablet->tablet_id(), tablet->schema_hash(), tablet->tablet_uid());
+    std::lock_guard txn_lock(_get_txn_lock(transaction_id));
+    RowsetSharedPtr rowset_ptr = _get_txn_rowset(key, tablet_info);
+    if (rowset_ptr == nullptr) {
+        return OLAP_ERR_TRANSACTION_NOT_EXIST;
+    }
+    rowset_ptr->make_visible(version, version_hash);
+    auto& rowset_meta_pb = rowset_ptr->rowset_meta()->get_meta_pb();
+    Status st = RowsetMetaManager::put_rowset_meta(tablet->data_dir()->get_meta(), batch, tablet_info.tablet_uid,
+                                                   rowset_ptr->rowset_id(), rowset_meta_pb);
+    if (!st.ok()) {
+        LOG(WARNING) << "put committed rowset failed. when publish txn rowset_id:" << rowset_ptr->rowset_id()
+                     << ", tablet id: " << tablet_info.tablet_id << ", txn id:" << transaction_id;
+        return OLAP_ERR_ROWSET_SAVE_FAILED;
+    }
+    return OLAP_SUCCESS;
+}
+
+void TxnManager::finish_publish_txn(TPartitionId partition_id, const TabletSharedPtr& tablet,
+                                    TTransactionId transaction_id, const Version& version) {
+    pair<int64_t, int64_t> key(partition_id, transaction_id);
+    TabletInfo tablet_info(tablet->tablet_id(), tablet->schema_hash(), tablet->tablet_uid());
+    std::lock_guard txn_lock(_get_txn_lock(transaction_id));
+    RowsetSharedPtr rowset_ptr = _get_txn_rowset(key, tablet_info);
+    if (rowset_ptr != nullptr) {
+        _remove_published_txn(key, tablet_info, rowset_ptr, version);
+    }
+}
+
+RowsetSharedPtr TxnManager::_get_txn_rowset(const TxnKey& key, const TabletInfo& tablet_info) {
+    std::shared_lock rlock(_get_txn_map_lock(key.second));
+    txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(key.second);
+    auto it = txn_tablet_map.find(key);
+    if (it != txn_tablet_map.end()) {
+        auto load_itr = it->second.find(tablet_info);
+        if (load_itr != it->second.end()) {
+            // found load for txn,tablet
+            // case 1: user commit rowset, then the load id must be equal
+            return load_itr->second.rowset;
+        }
+    }
+    return nullptr;
+}
+
+void TxnManager::_remove_published_txn(const TxnKey& key, const TabletInfo& tablet_info,
+                                       const RowsetSharedPtr& rowset, const Version& version) {
+    std::unique_lock wrlock(_get_txn_map_lock(key.second));
+    txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(key.second);
+    auto it = txn_tablet_map.find(key);
+    if (it != txn_tablet_map.end()) {
+        it->second.erase(tablet_info);
+        LOG(INFO) << "publish txn successfully."
+                  << " partition_id: " << key.first << ", txn_id: " << key.second
+                  << ", tablet: " << tablet_info.to_string() << ", rowsetid: " << rowset->rowset_id()
+                  << ", version: " << version.first << "," << version.second;
+        if (it->second.empty()) {
+            txn_tablet_map.erase(it);
+            _clear_txn_partition_map_unlocked(key.second, key.first);
         }
-        return OLAP_SUCCESS;
     }
 }
 
@@ -85,6 +85,17 @@ public:
     OLAPStatus publish_txn(TPartitionId partition_id, const TabletSharedPtr& tablet, TTransactionId transaction_id,
                            const Version& version, VersionHash version_hash);
 
+    // The first phase of publish_txn: make the rowset of the txn visible and put its meta into |batch|, instead of
+    // persisting it, so the metas of many publishes are written together. The txn is removed by
+    // finish_publish_txn() once |batch| is written.
+    OLAPStatus prepare_publish_txn(TPartitionId partition_id, const TabletSharedPtr& tablet,
+                                   TTransactionId transaction_id, const Version& version, VersionHash version_hash,
+                                   WriteBatch* batch);
+
+    // The second phase of publish_txn: remove the txn whose rowset meta is persisted.
+    void finish_publish_txn(TPartitionId partition_id, const TabletSharedPtr& tablet, TTransactionId transaction_id,
+                            const Version& version);
+
     // publish_txn for updatable tablet
     OLAPStatus publish_txn2(TTransactionId transaction_id, TPartitionId partition_id, const TabletSharedPtr& tablet,
                             int64_t version);
@@ -169,6 +180,13 @@ private:
 
     inline std::mutex& _get_txn_lock(TTransactionId transactionId);
 
+    // get the rowset of the txn on the tablet, or nullptr if it's not committed
+    RowsetSharedPtr _get_txn_rowset(const TxnKey& key, const TabletInfo& tablet_info);
+
+    // remove the txn on the tablet published
+    void _remove_published_txn(const TxnKey& key, const TabletInfo& tablet_info, const RowsetSharedPtr& rowset,
+                               const Version& version);
+
     // insert or remove (transaction_id, partition_id) from _txn_partition_map
     // get _txn_map_lock before calling
     void _insert_txn_partition_map_unlocked(int64_t transaction_id, int64_t partition_id);
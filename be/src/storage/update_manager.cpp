@@ -2,8 +2,10 @@
 
 #include "storage/update_manager.h"
 
+#include <algorithm>
 #include <limits>
 
+#include "common/config.h"
 #include "gutil/endian.h"
 #include "storage/del_vector.h"
 #include "storage/olap_meta.h"
@@ -12,6 +14,7 @@
 #include "storage/tablet_meta_manager.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/coding.h"
+#include "util/cpu_info.h"
 #include "util/pretty_printer.h"
 #include "util/starrocks_metrics.h"
 #include "util/time.h"
@@ -47,8 +50,10 @@ UpdateManager::~UpdateManager() {
 }
 
 Status UpdateManager::init() {
-    auto st = ThreadPoolBuilder("UpdateApplyThreadPool").build(&_apply_thread_pool);
-    return st;
+    RETURN_IF_ERROR(ThreadPoolBuilder("UpdateApplyThreadPool").build(&_apply_thread_pool));
+    return ThreadPoolBuilder("UpdateApplyWorkerPool")
+            .set_max_threads(std::max(1, CpuInfo::num_cores()))
+            .build(&_apply_worker_thread_pool);
 }
 
 Status UpdateManager::get_del_vec_in_meta(OlapMeta* meta, const TabletSegmentId& tsid, int64_t version,
@@ -64,16 +69,14 @@ Status UpdateManager::set_del_vec_in_meta(OlapMeta* meta, const TabletSegmentId&
 Status UpdateManager::get_del_vec(OlapMeta* meta, const TabletSegmentId& tsid, int64_t version, DelVectorPtr* pdelvec) {
     {
         std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-        auto itr = _del_vec_cache.find(tsid);
-        if (itr != _del_vec_cache.end()) {
-            if (version >= itr->second->version()) {
-                VLOG(3) << strings::Substitute("get_del_vec cached tablet_segment=$0 version=$1 actual_version=$2",
-                                               tsid.to_string(), version, itr->second->version());
-                // cache valid
-                // TODO(cbl): add cache hit stats
-                *pdelvec = itr->second;
-                return Status::OK();
-            }
+        auto cached = _lookup_cached_del_vec(tsid);
+        if (cached != nullptr && version >= cached->version()) {
+            VLOG(3) << strings::Substitute("get_del_vec cached tablet_segment=$0 version=$1 actual_version=$2",
+                                           tsid.to_string(), version, cached->version());
+            // cache valid
+            // TODO(cbl): add cache hit stats
+            *pdelvec = std::move(cached);
+            return Status::OK();
         }
     }
     (*pdelvec).reset(new DelVector());
@@ -82,14 +85,9 @@ Status UpdateManager::get_del_vec(OlapMeta* meta, const TabletSegmentId& tsid, i
     if ((*pdelvec)->version() == latest_version) {
         std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
         auto itr = _del_vec_cache.find(tsid);
-        if (itr == _del_vec_cache.end()) {
-            _del_vec_cache.emplace(tsid, *pdelvec);
-            _del_vec_cache_mem_tracker->consume((*pdelvec)->memory_usage());
-        } else if (latest_version > itr->second->version()) {
-            // should happen rarely
-            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
-            itr->second = (*pdelvec);
-            _del_vec_cache_mem_tracker->consume(itr->second->memory_usage());
+        // replacing a cached one should happen rarely
+        if (itr == _del_vec_cache.end() || latest_version > itr->second.delvec->version()) {
+            _insert_cached_del_vec(tsid, *pdelvec);
         }
     }
     return Status::OK();
@@ -109,6 +107,7 @@ void UpdateManager::clear_cache() {
     {
         std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
         _del_vec_cache.clear();
+        _del_vec_cache_lru.clear();
         if (_del_vec_cache_mem_tracker) {
             _del_vec_cache_mem_tracker->release(_del_vec_cache_mem_tracker->consumption());
         }
@@ -120,11 +119,7 @@ void UpdateManager::clear_cache() {
 void UpdateManager::clear_cached_del_vec(const std::vector<TabletSegmentId>& tsids) {
     std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
     for (const auto& tsid : tsids) {
-        auto itr = _del_vec_cache.find(tsid);
-        if (itr != _del_vec_cache.end()) {
-            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
-            _del_vec_cache.erase(itr);
-        }
+        _erase_cached_del_vec(tsid);
     }
 }
 
@@ -136,7 +131,7 @@ void UpdateManager::expire_cache() {
         StarRocksMetrics::instance()->update_del_vector_num.set_value(_del_vec_cache.size());
         StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(std::accumulate(
                 _del_vec_cache.cbegin(), _del_vec_cache.cend(), 0,
-                [](const int& accumulated, const auto& p) { return accumulated + p.second->memory_usage(); }));
+                [](const int& accumulated, const auto& p) { return accumulated + p.second.delvec->memory_usage(); }));
     }
     if (MonotonicMillis() - _last_clear_expired_cache_millis > _cache_expire_ms) {
         _update_state_cache.clear_expired();
@@ -165,18 +160,25 @@ string UpdateManager::memory_stats() {
 }
 
 Status UpdateManager::get_latest_del_vec(OlapMeta* meta, const TabletSegmentId& tsid, DelVectorPtr* pdelvec) {
+    {
+        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
+        auto cached = _lookup_cached_del_vec(tsid);
+        if (cached != nullptr) {
+            *pdelvec = std::move(cached);
+            return Status::OK();
+        }
+    }
+    // read the meta out of the lock, so the delvecs of the segments are loaded concurrently by an apply
+    auto delvec = std::make_shared<DelVector>();
+    int64_t latest_version = 0;
+    RETURN_IF_ERROR(get_del_vec_in_meta(meta, tsid, INT64_MAX, delvec.get(), &latest_version));
     std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-    auto itr = _del_vec_cache.find(tsid);
-    if (itr != _del_vec_cache.end()) {
-        *pdelvec = itr->second;
-        return Status::OK();
+    auto cached = _lookup_cached_del_vec(tsid);
+    if (cached != nullptr) {
+        *pdelvec = std::move(cached);
     } else {
-        // TODO(cbl): move get_del_vec_in_meta out of lock
-        (*pdelvec).reset(new DelVector());
-        int64_t latest_version = 0;
-        RETURN_IF_ERROR(get_del_vec_in_meta(meta, tsid, INT64_MAX, pdelvec->get(), &latest_version));
-        _del_vec_cache.emplace(tsid, *pdelvec);
-        _del_vec_cache_mem_tracker->consume((*pdelvec)->memory_usage());
+        _insert_cached_del_vec(tsid, delvec);
+        *pdelvec = std::move(delvec);
     }
     return Status::OK();
 }
@@ -186,22 +188,55 @@ Status UpdateManager::set_cached_del_vec(const TabletSegmentId& tsid, DelVectorP
             << " version:" << delvec->version() << " #del:" << delvec->cardinality();
     std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
     auto itr = _del_vec_cache.find(tsid);
+    if (itr != _del_vec_cache.end() && delvec->version() <= itr->second.delvec->version()) {
+        string msg = strings::Substitute("UpdateManager::set_cached_del_vec: new version($0) < old version($1)",
+                                         delvec->version(), itr->second.delvec->version());
+        LOG(ERROR) << msg;
+        return Status::InternalError(msg);
+    }
+    _insert_cached_del_vec(tsid, std::move(delvec));
+    return Status::OK();
+}
+
+DelVectorPtr UpdateManager::_lookup_cached_del_vec(const TabletSegmentId& tsid) {
+    auto itr = _del_vec_cache.find(tsid);
+    if (itr == _del_vec_cache.end()) {
+        return nullptr;
+    }
+    _del_vec_cache_lru.splice(_del_vec_cache_lru.begin(), _del_vec_cache_lru, itr->second.lru_itr);
+    return itr->second.delvec;
+}
+
+void UpdateManager::_insert_cached_del_vec(const TabletSegmentId& tsid, DelVectorPtr delvec) {
+    _del_vec_cache_mem_tracker->consume(delvec->memory_usage());
+    auto itr = _del_vec_cache.find(tsid);
     if (itr != _del_vec_cache.end()) {
-        if (delvec->version() <= itr->second->version()) {
-            string msg = strings::Substitute("UpdateManager::set_cached_del_vec: new version($0) < old version($1)",
-                                             delvec->version(), itr->second->version());
-            LOG(ERROR) << msg;
-            return Status::InternalError(msg);
-        } else {
-            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
-            itr->second = delvec;
-            _del_vec_cache_mem_tracker->consume(itr->second->memory_usage());
-        }
+        _del_vec_cache_mem_tracker->release(itr->second.delvec->memory_usage());
+        itr->second.delvec = std::move(delvec);
+        _del_vec_cache_lru.splice(_del_vec_cache_lru.begin(), _del_vec_cache_lru, itr->second.lru_itr);
     } else {
-        _del_vec_cache.emplace(tsid, delvec);
-        _del_vec_cache_mem_tracker->consume(delvec->memory_usage());
+        _del_vec_cache_lru.push_front(tsid);
+        _del_vec_cache.emplace(tsid, DelVecCacheEntry{std::move(delvec), _del_vec_cache_lru.begin()});
+    }
+    _evict_cached_del_vecs();
+}
+
+void UpdateManager::_erase_cached_del_vec(const TabletSegmentId& tsid) {
+    auto itr = _del_vec_cache.find(tsid);
+    if (itr != _del_vec_cache.end()) {
+        _del_vec_cache_mem_tracker->release(itr->second.delvec->memory_usage());
+        _del_vec_cache_lru.erase(itr->second.lru_itr);
+        _del_vec_cache.erase(itr);
+    }
+}
+
+void UpdateManager::_evict_cached_del_vecs() {
+    // the most recently used one is kept even if it exceeds the capacity alone
+    while (_del_vec_cache_lru.size() > 1 &&
+           _del_vec_cache_mem_tracker->consumption() > config::update_del_vec_cache_capacity_bytes) {
+        TabletSegmentId tsid = _del_vec_cache_lru.back();
+        _erase_cached_del_vec(tsid);
     }
-    return Status::OK();
 }
 
 Status UpdateManager::on_rowset_finished(Tablet* tablet, Rowset* rowset) {
@@ -237,4 +272,50 @@ Status UpdateManager::on_rowset_finished(Tablet* tablet, Rowset* rowset) {
     return st;
 }
 
+void UpdateManager::prewarm_primary_indexes(const std::vector<TabletSharedPtr>& tablets, int num_threads,
+                                            const std::function<bool()>& stopped) {
+    if (tablets.empty() || num_threads <= 0) {
+        return;
+    }
+    std::unique_ptr<ThreadPool> pool;
+    auto st = ThreadPoolBuilder("PrimaryIndexPrewarm").set_max_threads(num_threads).build(&pool);
+    if (!st.ok()) {
+        LOG(WARNING) << "prewarm primary indexes failed to build thread pool: " << st;
+        return;
+    }
+    int64_t t_start = MonotonicMillis();
+    auto& pending = StarRocksMetrics::instance()->update_primary_index_prewarm_pending;
+    pending.set_value(tablets.size());
+    std::atomic<size_t> num_loaded{0};
+    for (const auto& tablet : tablets) {
+        st = pool->submit_func([&, tablet]() {
+            // the tablets left are still counted as pending if the loads stop
+            if (stopped() || _update_mem_tracker->any_limit_exceeded()) {
+                return;
+            }
+            auto index_entry = _index_cache.get_or_create(tablet->tablet_id());
+            auto load_st = index_entry->value().load(tablet.get());
+            index_entry->update_expire_time(MonotonicMillis() + _cache_expire_ms);
+            _index_cache.update_object_size(index_entry, index_entry->value().memory_usage());
+            if (load_st.ok()) {
+                _index_cache.release(index_entry);
+                num_loaded++;
+                StarRocksMetrics::instance()->update_primary_index_prewarm_loaded.increment(1);
+            } else {
+                LOG(WARNING) << "prewarm primary index failed tablet:" << tablet->tablet_id() << " " << load_st;
+                _index_cache.remove(index_entry);
+            }
+            pending.increment(-1);
+        });
+        if (!st.ok()) {
+            LOG(WARNING) << "prewarm primary indexes failed to submit task: " << st;
+            break;
+        }
+    }
+    pool->wait();
+    LOG(INFO) << "prewarm primary indexes loaded:" << num_loaded << "/" << tablets.size()
+              << " memory:" << PrettyPrinter::print_bytes(_index_cache_mem_tracker->consumption())
+              << " duration:" << MonotonicMillis() - t_start << "ms";
+}
+
 } // namespace starrocks
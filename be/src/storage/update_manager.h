@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <functional>
+#include <list>
 #include <string>
 #include <unordered_map>
 
@@ -53,8 +55,18 @@ public:
 
     Status on_rowset_finished(Tablet* tablet, Rowset* rowset);
 
+    // Load the primary indexes of |tablets| into the index cache by |num_threads| threads, in the order of
+    // |tablets|, and returns when they're all loaded or |stopped| returns true. An apply needing one being loaded
+    // waits for the load instead of loading it again. The loads stop when the update memory exceeds its limit.
+    void prewarm_primary_indexes(const std::vector<TabletSharedPtr>& tablets, int num_threads,
+                                 const std::function<bool()>& stopped);
+
     ThreadPool* apply_thread_pool() { return _apply_thread_pool.get(); }
 
+    // The threads running the concurrent parts of the applies, apart from the apply threads, so an apply never waits
+    // for the tasks queued behind it.
+    ThreadPool* apply_worker_thread_pool() { return _apply_worker_thread_pool.get(); }
+
     DynamicCache<uint64_t, PrimaryIndex>& index_cache() { return _index_cache; }
 
     DynamicCache<string, RowsetUpdateState>& update_state_cache() { return _update_state_cache; }
@@ -72,6 +84,13 @@ public:
     string memory_stats();
 
 private:
+    // The DelVector cache is an LRU list bounded by config::update_del_vec_cache_capacity_bytes, the methods below
+    // must be called with _del_vec_cache_lock held. The evicted ones are loaded from the meta again.
+    DelVectorPtr _lookup_cached_del_vec(const TabletSegmentId& tsid);
+    void _insert_cached_del_vec(const TabletSegmentId& tsid, DelVectorPtr delvec);
+    void _erase_cached_del_vec(const TabletSegmentId& tsid);
+    void _evict_cached_del_vecs();
+
     // default 6min
     int64_t _cache_expire_ms = 360000;
 
@@ -89,10 +108,17 @@ private:
 
     // DelVector related states
     std::mutex _del_vec_cache_lock;
-    std::unordered_map<TabletSegmentId, DelVectorPtr> _del_vec_cache;
+    struct DelVecCacheEntry {
+        DelVectorPtr delvec;
+        std::list<TabletSegmentId>::iterator lru_itr;
+    };
+    std::unordered_map<TabletSegmentId, DelVecCacheEntry> _del_vec_cache;
+    // From the most recently used to the least.
+    std::list<TabletSegmentId> _del_vec_cache_lru;
     std::unique_ptr<MemTracker> _del_vec_cache_mem_tracker;
 
     std::unique_ptr<ThreadPool> _apply_thread_pool;
+    std::unique_ptr<ThreadPool> _apply_worker_thread_pool;
 
     DISALLOW_COPY_AND_ASSIGN(UpdateManager);
 };
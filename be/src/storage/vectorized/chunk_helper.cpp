@@ -29,6 +29,16 @@ vectorized::Schema ChunkHelper::convert_schema(const starrocks::TabletSchema& sc
     return starrocks::vectorized::Schema(std::move(fields));
 }
 
+vectorized::Schema ChunkHelper::convert_schema(const starrocks::TabletSchema& schema,
+                                               const std::vector<ColumnId>& cids) {
+    starrocks::vectorized::Fields fields;
+    for (ColumnId cid : cids) {
+        auto f = convert_field(cid, schema.column(cid));
+        fields.emplace_back(std::make_shared<starrocks::vectorized::Field>(std::move(f)));
+    }
+    return starrocks::vectorized::Schema(std::move(fields));
+}
+
 starrocks::vectorized::Field ChunkHelper::convert_field_to_format_v2(ColumnId id, const TabletColumn& c) {
     FieldType type = TypeUtils::to_storage_format_v2(c.type());
 
@@ -83,6 +93,26 @@ starrocks::vectorized::Schema ChunkHelper::convert_schema_to_format_v2(const sta
     return starrocks::vectorized::Schema(std::move(fields));
 }
 
+starrocks::vectorized::Schema ChunkHelper::convert_schema_to_format_v2(const starrocks::TabletSchema& schema,
+                                                                       const std::vector<ColumnId>& cids,
+                                                                       const GlobalDicts& global_dicts) {
+    starrocks::vectorized::Fields fields;
+    for (ColumnId cid : cids) {
+        const TabletColumn& c = schema.column(cid);
+        if (global_dicts.count(cid) > 0) {
+            auto f = std::make_shared<starrocks::vectorized::Field>(cid, c.name(), OLAP_FIELD_TYPE_INT, -1, -1,
+                                                                    c.is_nullable());
+            f->set_is_key(c.is_key());
+            f->set_aggregate_method(c.aggregation());
+            fields.emplace_back(std::move(f));
+        } else {
+            auto f = convert_field_to_format_v2(cid, c);
+            fields.emplace_back(std::make_shared<starrocks::vectorized::Field>(std::move(f)));
+        }
+    }
+    return starrocks::vectorized::Schema(std::move(fields));
+}
+
 ColumnId ChunkHelper::max_column_id(const starrocks::vectorized::Schema& schema) {
     ColumnId id = 0;
     for (const auto& field : schema.fields()) {
@@ -290,7 +320,8 @@ void ChunkHelper::padding_char_columns(const std::vector<size_t>& char_column_in
         vectorized::Offsets& new_offset = new_binary->get_offset();
         vectorized::Bytes& new_bytes = new_binary->get_bytes();
 
-        uint32_t len = tschema.column(field_index).length();
+        // The schema may have only a part of the columns, e.g. the ones of a group of the vertical compaction.
+        uint32_t len = tschema.column(schema.field(field_index)->id()).length();
 
         new_offset.resize(num_rows + 1);
         new_bytes.assign(num_rows * len, 0); // padding 0
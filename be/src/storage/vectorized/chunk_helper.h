@@ -15,6 +15,7 @@
 #include "column/object_column.h"
 #include "column/schema.h"
 #include "column/vectorized_fwd.h"
+#include "runtime/vectorized/global_dict.h"
 #include "storage/schema.h"
 
 namespace starrocks {
@@ -37,6 +38,9 @@ public:
 
     static vectorized::Schema convert_schema(const starrocks::TabletSchema& schema);
 
+    // Same as above, but only the columns in |cids| are converted.
+    static vectorized::Schema convert_schema(const starrocks::TabletSchema& schema, const std::vector<ColumnId>& cids);
+
     // Convert starrocks::TabletColumn to vectorized::Field. This function will generate format
     // V2 type: DATE_V2, TIMESTAMP, DECIMAL_V2
     static vectorized::Field convert_field_to_format_v2(ColumnId id, const TabletColumn& c);
@@ -48,6 +52,11 @@ public:
     static vectorized::Schema convert_schema_to_format_v2(const starrocks::TabletSchema& schema,
                                                           const std::vector<ColumnId>& cids);
 
+    // Same as above, except that the columns in |global_dicts| are the INT fields of their global dict ids.
+    static vectorized::Schema convert_schema_to_format_v2(const starrocks::TabletSchema& schema,
+                                                          const std::vector<ColumnId>& cids,
+                                                          const GlobalDicts& global_dicts);
+
     static ColumnId max_column_id(const vectorized::Schema& schema);
 
     // Create an empty chunk according to the |schema| and reserve it of size |n|.
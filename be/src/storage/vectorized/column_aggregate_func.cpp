@@ -280,7 +280,7 @@ public:
         _null_child->finalize();
 
         auto p = down_cast<NullableColumn*>(_aggregate_column);
-        p->set_has_null(SIMD::count_nonzero(p->null_column()->get_data()));
+        p->set_has_null(SIMD::contain_nonzero(p->null_column()->get_data()));
         _aggregate_column = nullptr;
     }
 
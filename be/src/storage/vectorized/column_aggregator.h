@@ -213,7 +213,8 @@ public:
     void finalize() override {
         _child->finalize();
         _aggregate_nulls->append(_row_is_null);
-        down_cast<NullableColumn*>(_aggregate_column)->set_has_null(SIMD::count_nonzero(_aggregate_nulls->get_data()));
+        down_cast<NullableColumn*>(_aggregate_column)
+                ->set_has_null(SIMD::contain_nonzero(_aggregate_nulls->get_data()));
 
         _aggregate_nulls = nullptr;
         _aggregate_column = nullptr;
@@ -0,0 +1,114 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <cstring>
+#include <string>
+
+#include "column/binary_column.h"
+#include "column/column.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "storage/rowset/segment_v2/bloom_filter.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+// The value contains |_operand| as a substring, i.e. `LIKE '%operand%'`. It's mainly pushed down to prune the
+// pages by the n-gram bloom filter index, the values are still filtered by the LIKE predicate afterwards.
+class ColumnContainsPredicate : public ColumnPredicate {
+public:
+    ColumnContainsPredicate(const TypeInfoPtr& type_info, ColumnId id, const Slice& operand)
+            : ColumnPredicate(type_info, id), _operand(operand.data, operand.size) {}
+
+    void evaluate(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        auto* v = reinterpret_cast<const Slice*>(column->raw_data());
+        if (!column->has_null()) {
+            for (uint16_t i = from; i < to; i++) {
+                selection[i] = _contains(v[i]);
+            }
+        } else {
+            const uint8_t* is_null = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (uint16_t i = from; i < to; i++) {
+                selection[i] = !is_null[i] && _contains(v[i]);
+            }
+        }
+    }
+
+    void evaluate_and(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        auto* v = reinterpret_cast<const Slice*>(column->raw_data());
+        if (!column->has_null()) {
+            for (uint16_t i = from; i < to; i++) {
+                selection[i] = selection[i] && _contains(v[i]);
+            }
+        } else {
+            const uint8_t* is_null = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (uint16_t i = from; i < to; i++) {
+                selection[i] = selection[i] && !is_null[i] && _contains(v[i]);
+            }
+        }
+    }
+
+    void evaluate_or(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        auto* v = reinterpret_cast<const Slice*>(column->raw_data());
+        if (!column->has_null()) {
+            for (uint16_t i = from; i < to; i++) {
+                selection[i] = selection[i] || _contains(v[i]);
+            }
+        } else {
+            const uint8_t* is_null = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (uint16_t i = from; i < to; i++) {
+                selection[i] = selection[i] || (!is_null[i] && _contains(v[i]));
+            }
+        }
+    }
+
+    bool support_ngram_bloom_filter() const override { return true; }
+
+    bool ngram_bloom_filter(const segment_v2::BloomFilter* bf, size_t gram_size) const override {
+        if (gram_size == 0 || _operand.size() < gram_size) {
+            return true;
+        }
+        // Every gram of the operand should be in the page.
+        for (size_t i = 0; i + gram_size <= _operand.size(); i++) {
+            if (!bf->test_bytes(_operand.data() + i, gram_size)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    PredicateType type() const override { return PredicateType::kContains; }
+
+    Datum value() const override { return Datum(Slice(_operand)); }
+
+    std::vector<Datum> values() const override { return std::vector<Datum>{Datum(Slice(_operand))}; }
+
+    bool can_vectorized() const override { return false; }
+
+    Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                      ObjectPool* obj_pool) const override {
+        *output = this;
+        return Status::OK();
+    }
+
+    std::string debug_string() const override {
+        std::stringstream ss;
+        ss << "(column_id=" << column_id() << " contains '" << _operand << "')";
+        return ss.str();
+    }
+
+private:
+    bool _contains(const Slice& s) const {
+        if (_operand.empty()) {
+            return true;
+        }
+        return memmem(s.data, s.size, _operand.data(), _operand.size()) != nullptr;
+    }
+
+    std::string _operand;
+};
+
+ColumnPredicate* new_column_contains_predicate(const TypeInfoPtr& type_info, ColumnId id, const Slice& operand) {
+    return new ColumnContainsPredicate(type_info, id, operand);
+}
+
+} // namespace starrocks::vectorized
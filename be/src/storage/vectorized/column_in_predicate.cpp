@@ -183,6 +183,7 @@ public:
         for (const std::string& s : _zero_padded_strs) {
             _slices.emplace(Slice(s));
         }
+        _build_perfect_hash_set();
     }
 
     ~BinaryColumnInPredicate() override = default;
@@ -199,13 +200,13 @@ public:
         }
         if (!column->has_null()) {
             for (size_t i = from; i < to; i++) {
-                sel[i] = _slices.contains(binary_column->get_slice(i));
+                sel[i] = _contains(binary_column->get_slice(i));
             }
         } else {
             /* must use uint8_t* to make vectorized effect */
             const uint8_t* null_data = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
             for (size_t i = from; i < to; i++) {
-                sel[i] = !null_data[i] && _slices.contains(binary_column->get_slice(i));
+                sel[i] = !null_data[i] && _contains(binary_column->get_slice(i));
             }
         }
     }
@@ -222,13 +223,13 @@ public:
         }
         if (!column->has_null()) {
             for (size_t i = from; i < to; i++) {
-                sel[i] = (sel[i] && _slices.contains(binary_column->get_slice(i)));
+                sel[i] = (sel[i] && _contains(binary_column->get_slice(i)));
             }
         } else {
             /* must use uint8_t* to make vectorized effect */
             const uint8_t* null_data = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
             for (size_t i = from; i < to; i++) {
-                sel[i] = (sel[i] && !null_data[i] && _slices.contains(binary_column->get_slice(i)));
+                sel[i] = (sel[i] && !null_data[i] && _contains(binary_column->get_slice(i)));
             }
         }
     }
@@ -245,13 +246,13 @@ public:
         }
         if (!column->has_null()) {
             for (size_t i = from; i < to; i++) {
-                sel[i] = (sel[i] || _slices.contains(binary_column->get_slice(i)));
+                sel[i] = (sel[i] || _contains(binary_column->get_slice(i)));
             }
         } else {
             /* must use uint8_t* to make vectorized effect */
             const uint8_t* null_data = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
             for (size_t i = from; i < to; i++) {
-                sel[i] = (sel[i] || (!null_data[i] && _slices.contains(binary_column->get_slice(i))));
+                sel[i] = (sel[i] || (!null_data[i] && _contains(binary_column->get_slice(i))));
             }
         }
     }
@@ -272,7 +273,7 @@ public:
             for (uint16_t i = 0; i < sel_size; ++i) {
                 uint16_t data_idx = sel[i];
                 sel[new_size] = data_idx;
-                new_size += _slices.contains(binary_column->get_slice(data_idx));
+                new_size += _contains(binary_column->get_slice(data_idx));
             }
         } else {
             /* must use uint8_t* to make vectorized effect */
@@ -280,7 +281,7 @@ public:
             for (uint16_t i = 0; i < sel_size; ++i) {
                 uint16_t data_idx = sel[i];
                 sel[new_size] = data_idx;
-                new_size += !null_data[data_idx] && _slices.contains(binary_column->get_slice(data_idx));
+                new_size += !null_data[data_idx] && _contains(binary_column->get_slice(data_idx));
             }
         }
         return new_size;
@@ -353,12 +354,25 @@ public:
             str.append(len > old_sz ? len - old_sz : 0, '\0');
             _slices.emplace(str.data(), old_sz);
         }
+        _build_perfect_hash_set();
         return true;
     }
 
 private:
+    void _build_perfect_hash_set() {
+        std::vector<Slice> values(_slices.begin(), _slices.end());
+        _use_perfect_hash_set = _perfect_hash_set.init(values);
+    }
+
+    bool _contains(const Slice& v) const {
+        return _use_perfect_hash_set ? _perfect_hash_set.contains(v) : _slices.contains(v);
+    }
+
     std::vector<std::string> _zero_padded_strs;
     ItemHashSet<Slice> _slices;
+    // Probed instead of _slices if the values fit.
+    SlicePerfectHashSet _perfect_hash_set;
+    bool _use_perfect_hash_set = false;
 };
 
 template <template <typename, size_t...> typename Set, size_t... Args>
@@ -489,13 +503,61 @@ ColumnPredicate* new_column_in_predicate_small(const TypeInfoPtr& type_info, Col
     return nullptr;
 }
 
+template <FieldType field_type>
+ColumnPredicate* new_dense_column_in_predicate(const TypeInfoPtr& type_info, ColumnId id,
+                                               const std::vector<std::string>& strs) {
+    using CppType = typename CppTypeTraits<field_type>::CppType;
+    auto converter = [&]() {
+        if constexpr (field_type == OLAP_FIELD_TYPE_DECIMAL32 || field_type == OLAP_FIELD_TYPE_DECIMAL64) {
+            return predicate_internal::strings_to_decimal_set<field_type>(type_info->precision(), type_info->scale(),
+                                                                          strs);
+        } else {
+            return predicate_internal::strings_to_set<field_type>(strs);
+        }
+    }();
+    std::vector<CppType> values = converter;
+    DenseBitmapSet<CppType> bitmap_set;
+    if (!bitmap_set.init(values)) {
+        return nullptr;
+    }
+    return new ColumnInPredicate<field_type, DenseBitmapSet<CppType>>(type_info, id, std::move(bitmap_set));
+}
+
+// Returns nullptr if the field is not an integer or the values are not in a small range.
+ColumnPredicate* new_column_in_predicate_dense(const TypeInfoPtr& type_info, ColumnId id,
+                                               const std::vector<std::string>& strs) {
+    switch (type_info->type()) {
+    case OLAP_FIELD_TYPE_TINYINT:
+        return new_dense_column_in_predicate<OLAP_FIELD_TYPE_TINYINT>(type_info, id, strs);
+    case OLAP_FIELD_TYPE_SMALLINT:
+        return new_dense_column_in_predicate<OLAP_FIELD_TYPE_SMALLINT>(type_info, id, strs);
+    case OLAP_FIELD_TYPE_INT:
+        return new_dense_column_in_predicate<OLAP_FIELD_TYPE_INT>(type_info, id, strs);
+    case OLAP_FIELD_TYPE_BIGINT:
+        return new_dense_column_in_predicate<OLAP_FIELD_TYPE_BIGINT>(type_info, id, strs);
+    case OLAP_FIELD_TYPE_DECIMAL32:
+        return new_dense_column_in_predicate<OLAP_FIELD_TYPE_DECIMAL32>(type_info, id, strs);
+    case OLAP_FIELD_TYPE_DECIMAL64:
+        return new_dense_column_in_predicate<OLAP_FIELD_TYPE_DECIMAL64>(type_info, id, strs);
+    case OLAP_FIELD_TYPE_DATE_V2:
+        return new_dense_column_in_predicate<OLAP_FIELD_TYPE_DATE_V2>(type_info, id, strs);
+    default:
+        return nullptr;
+    }
+}
+
 ColumnPredicate* new_column_in_predicate(const TypeInfoPtr& type_info, ColumnId id,
                                          const std::vector<std::string>& strs) {
-    if (strs.size() > 3) {
-        return new_column_in_predicate_generic<ItemHashSet>(type_info, id, strs);
-    } else {
+    if (strs.size() <= 3) {
         return new_column_in_predicate_small(type_info, id, strs);
     }
+    if (ColumnPredicate* pred = new_column_in_predicate_dense(type_info, id, strs); pred != nullptr) {
+        return pred;
+    }
+    if (strs.size() <= 8) {
+        return new_column_in_predicate_generic<FixedArraySet, 8>(type_info, id, strs);
+    }
+    return new_column_in_predicate_generic<ItemHashSet>(type_info, id, strs);
 }
 
 } //namespace starrocks::vectorized
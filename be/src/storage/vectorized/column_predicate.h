@@ -45,6 +45,7 @@ enum class PredicateType {
     kNotNull = 9,
     kAnd = 10,
     kOr = 11,
+    kContains = 12,
 };
 
 template <typename T>
@@ -104,6 +105,11 @@ public:
     // Return false to filter out a data page.
     virtual bool bloom_filter(const segment_v2::BloomFilter* bf) const { return true; }
 
+    virtual bool support_ngram_bloom_filter() const { return false; }
+
+    // Return false to filter out a data page, |bf| is built on the |gram_size|-grams of the values of the page.
+    virtual bool ngram_bloom_filter(const segment_v2::BloomFilter* bf, size_t gram_size) const { return true; }
+
     virtual Status seek_bitmap_dictionary(segment_v2::BitmapIndexIterator* iter, SparseRange* range) const {
         return Status::Cancelled("not implemented");
     }
@@ -269,6 +275,8 @@ ColumnPredicate* new_column_in_predicate(const TypeInfoPtr& type, ColumnId id,
 ColumnPredicate* new_column_not_in_predicate(const TypeInfoPtr& type, ColumnId id,
                                              const std::vector<std::string>& operands);
 ColumnPredicate* new_column_null_predicate(const TypeInfoPtr& type, ColumnId, bool is_null);
+// Whether the CHAR/VARCHAR value contains |operand| as a substring, which is pushed down by the LIKE predicates.
+ColumnPredicate* new_column_contains_predicate(const TypeInfoPtr& type, ColumnId id, const Slice& operand);
 
 template <FieldType field_type, template <FieldType> typename Predicate, typename NewColumnPredicateFunc>
 Status predicate_convert_to(Predicate<field_type> const& input_predicate,
@@ -7,7 +7,10 @@
 #include "storage/rowset/rowset_factory.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/reader.h"
+#include "storage/vectorized/rowset_merger.h"
+#include "storage/vectorized/zorder.h"
 #include "util/defer_op.h"
+#include "util/starrocks_metrics.h"
 #include "util/time.h"
 #include "util/trace.h"
 
@@ -54,6 +57,8 @@ Status Compaction::do_compaction_impl() {
     TRACE_COUNTER_INCREMENT("input_rowsets_data_size", _input_rowsets_size);
     TRACE_COUNTER_INCREMENT("input_row_num", _input_row_num);
     TRACE_COUNTER_INCREMENT("input_segments_num", segments_num);
+    // The input rowsets are read and about the same bytes are written.
+    _tablet->data_dir()->compaction_io_budget()->charge_compaction(_input_rowsets_size * 2);
 
     _output_version = Version(_input_rowsets.front()->start_version(), _input_rowsets.back()->end_version());
     _tablet->compute_version_hash_from_rowsets(_input_rowsets, &_output_version_hash);
@@ -66,7 +71,16 @@ Status Compaction::do_compaction_impl() {
 
     // 2. write combined rows to output rowset
     Statistics stats;
-    auto res = merge_rowsets(_mem_tracker.get(), &stats);
+    std::vector<ColumnId> cluster_columns;
+    std::vector<std::vector<uint32_t>> column_groups;
+    Status res;
+    if (should_cluster(&cluster_columns)) {
+        res = merge_rowsets_clustered(_mem_tracker.get(), cluster_columns, &stats);
+    } else if (should_compact_vertically(&column_groups)) {
+        res = merge_rowsets_vertically(_mem_tracker.get(), column_groups, &stats);
+    } else {
+        res = merge_rowsets(_mem_tracker.get(), &stats);
+    }
 
     if (!res.ok()) {
         LOG(WARNING) << "fail to do " << compaction_name() << ". res=" << res.to_string()
@@ -106,6 +120,7 @@ Status Compaction::do_compaction_impl() {
         _tablet->set_last_base_compaction_success_time(now);
     }
 
+    StarRocksMetrics::instance()->compaction_latency_us.add(watch.get_elapse_time_us());
     LOG(INFO) << "succeed to do " << compaction_name() << ". tablet=" << _tablet->full_name()
               << ", output_version=" << _output_version.first << "-" << _output_version.second
               << ", segments=" << segments_num << ". elapsed time=" << watch.get_elapse_second() << "s.";
@@ -128,6 +143,24 @@ Status Compaction::construct_output_rowset_writer() {
     context.version = _output_version;
     context.version_hash = _output_version_hash;
     context.segments_overlap = NONOVERLAPPING;
+    std::vector<ColumnId> cluster_columns;
+    std::vector<std::vector<uint32_t>> column_groups;
+    if (should_cluster(&cluster_columns)) {
+        // The segments are the ranges of the Z-order curve, which overlap on the key.
+        context.segments_overlap = OVERLAPPING;
+    } else if (should_compact_vertically(&column_groups)) {
+        // The segment size can't be estimated by the key columns written first, so the segments are split by
+        // the rows, estimated by the disk size of the input rows.
+        int64_t num_rows = 0;
+        int64_t data_size = 0;
+        for (auto& rowset : _input_rowsets) {
+            num_rows += rowset->num_rows();
+            data_size += rowset->data_disk_size();
+        }
+        int64_t avg_row_size = (data_size + 1) / (num_rows + 1);
+        int64_t max_segment_size = OLAP_MAX_COLUMN_SEGMENT_FILE_SIZE * OLAP_COLUMN_FILE_SEGMENT_SIZE_SCALE;
+        context.max_rows_per_segment = std::max<int64_t>(1, max_segment_size / (avg_row_size + 1));
+    }
     OLAPStatus olap_status = RowsetFactory::create_rowset_writer(context, &_output_rs_writer);
     if (olap_status != OLAPStatus::OLAP_SUCCESS) {
         std::stringstream ss;
@@ -148,22 +181,7 @@ Status Compaction::merge_rowsets(MemTracker* mem_tracker, Statistics* stats_outp
     reader_params.version = _output_rs_writer->version();
     reader_params.profile = _runtime_profile.create_child("merge_rowsets");
 
-    int64_t num_rows = 0;
-    int64_t total_row_size = 0;
-    uint64_t chunk_size = DEFAULT_CHUNK_SIZE;
-    if (mem_tracker->limit() > 0) {
-        for (auto& rowset : _input_rowsets) {
-            num_rows += rowset->num_rows();
-            total_row_size += rowset->total_row_size();
-        }
-        int64_t avg_row_size = (total_row_size + 1) / (num_rows + 1);
-        // The result of thie division operation be zero, so added one
-        chunk_size = 1 + mem_tracker->limit() / (_input_rowsets.size() * avg_row_size + 1);
-    }
-    if (chunk_size > config::vector_chunk_size) {
-        chunk_size = config::vector_chunk_size;
-    }
-    reader_params.chunk_size = chunk_size;
+    reader_params.chunk_size = merge_chunk_size(mem_tracker);
     RETURN_IF_ERROR(reader.init(reader_params));
 
     int64_t output_rows = 0;
@@ -213,6 +231,216 @@ Status Compaction::merge_rowsets(MemTracker* mem_tracker, Statistics* stats_outp
     return Status::OK();
 }
 
+Status Compaction::merge_rowsets_vertically(MemTracker* mem_tracker,
+                                            const std::vector<std::vector<uint32_t>>& column_groups,
+                                            Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
+    auto tracker = std::make_unique<MemTracker>(-1, "merge_rowsets", mem_tracker, true);
+    DeferOp memory_tracker_releaser([&tracker] { return tracker->release(tracker->consumption()); });
+
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    int chunk_size = merge_chunk_size(mem_tracker);
+    std::vector<uint16_t> row_sources;
+    int64_t output_rows = 0;
+    for (size_t i = 0; i < column_groups.size(); ++i) {
+        bool is_key = (i == 0);
+        Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, column_groups[i]);
+        Reader reader(schema);
+        ReaderParams reader_params;
+        reader_params.tablet = _tablet;
+        reader_params.reader_type = compaction_type();
+        reader_params.version = _output_rs_writer->version();
+        reader_params.profile = _runtime_profile.create_child(strings::Substitute("merge_rowsets_group_$0", i));
+        reader_params.chunk_size = chunk_size;
+        // The rowsets are fixed, so the segments are read in the same order by all the groups.
+        reader_params.rowsets = _input_rowsets;
+        reader_params.row_sources = &row_sources;
+        reader_params.replay_row_sources = !is_key;
+        RETURN_IF_ERROR(reader.init(reader_params));
+
+        auto chunk = ChunkHelper::new_chunk(schema, chunk_size);
+        auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
+        int64_t group_rows = 0;
+        while (true) {
+            chunk->reset();
+            Status status = reader.get_next(chunk.get());
+            if (!status.ok()) {
+                if (status.is_end_of_file()) {
+                    break;
+                } else {
+                    return Status::InternalError("reader get_next error.");
+                }
+            }
+
+            ChunkHelper::padding_char_columns(char_field_indexes, schema, tablet_schema, chunk.get());
+
+            OLAPStatus olap_status = _output_rs_writer->add_columns(*chunk, column_groups[i], is_key);
+            if (olap_status != OLAP_SUCCESS) {
+                LOG(WARNING) << "writer add_columns error, err=" << olap_status;
+                return Status::InternalError("writer add_columns error.");
+            }
+            group_rows += chunk->num_rows();
+        }
+
+        if (is_key) {
+            output_rows = group_rows;
+            if (stats_output != nullptr) {
+                stats_output->output_rows = output_rows;
+                stats_output->merged_rows = reader.merged_rows();
+                stats_output->filtered_rows = reader.stats().rows_del_filtered;
+            }
+        } else if (group_rows != output_rows) {
+            LOG(WARNING) << "rows of the column group " << i << " is " << group_rows << ", but the key rows is "
+                         << output_rows << ", tablet=" << _tablet->full_name();
+            return Status::InternalError("vertical compaction rows error.");
+        }
+
+        OLAPStatus olap_status = _output_rs_writer->flush_columns();
+        if (olap_status != OLAP_SUCCESS) {
+            LOG(WARNING) << "failed to flush columns when merging rowsets of tablet " + _tablet->full_name()
+                         << ", err=" << olap_status;
+            return Status::InternalError("failed to flush columns when merging rowsets of tablet error.");
+        }
+    }
+
+    OLAPStatus olap_status = _output_rs_writer->final_flush();
+    if (olap_status != OLAP_SUCCESS) {
+        LOG(WARNING) << "failed to flush rowset when merging rowsets of tablet " + _tablet->full_name()
+                     << ", err=" << olap_status;
+        return Status::InternalError("failed to flush rowset when merging rowsets of tablet error.");
+    }
+    TRACE_COUNTER_INCREMENT("column_groups", column_groups.size());
+    return Status::OK();
+}
+
+Status Compaction::merge_rowsets_clustered(MemTracker* mem_tracker, const std::vector<ColumnId>& cluster_columns,
+                                           Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema());
+    Reader reader(schema);
+    ReaderParams reader_params;
+    reader_params.tablet = _tablet;
+    reader_params.reader_type = compaction_type();
+    reader_params.version = _output_rs_writer->version();
+    reader_params.profile = _runtime_profile.create_child("merge_rowsets_clustered");
+    reader_params.chunk_size = merge_chunk_size(mem_tracker);
+    RETURN_IF_ERROR(reader.init(reader_params));
+
+    auto tracker = std::make_unique<MemTracker>(-1, "merge_rowsets", mem_tracker, true);
+    DeferOp memory_tracker_releaser([&tracker] { return tracker->release(tracker->consumption()); });
+
+    auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
+    auto chunk = ChunkHelper::new_chunk(schema, reader_params.chunk_size);
+    auto rows = ChunkHelper::new_chunk(schema, _input_row_num);
+    while (true) {
+        chunk->reset();
+        Status status = reader.get_next(chunk.get());
+        if (!status.ok()) {
+            if (status.is_end_of_file()) {
+                break;
+            } else {
+                return Status::InternalError("reader get_next error.");
+            }
+        }
+        ChunkHelper::padding_char_columns(char_field_indexes, schema, _tablet->tablet_schema(), chunk.get());
+        int64_t old_mem_usage = rows->memory_usage();
+        rows->append(*chunk);
+        tracker->consume(static_cast<int64_t>(rows->memory_usage()) - old_mem_usage);
+    }
+
+    std::vector<const Column*> columns;
+    for (ColumnId cid : cluster_columns) {
+        columns.push_back(rows->get_column_by_index(cid).get());
+    }
+    std::vector<uint32_t> order;
+    zorder_permutation(columns, rows->num_rows(), &order);
+
+    // The reader merged the rows by the key, so the rows of a range are sorted by the key in their positions.
+    auto rows_per_segment = static_cast<size_t>(std::max<int64_t>(1, config::compaction_cluster_rows_per_segment));
+    auto segment = rows->clone_empty_with_schema();
+    for (size_t from = 0; from < order.size(); from += rows_per_segment) {
+        size_t size = std::min(rows_per_segment, order.size() - from);
+        std::sort(order.begin() + from, order.begin() + from + size);
+        segment->reset();
+        segment->append_selective(*rows, order.data(), from, size);
+        OLAPStatus olap_status = _output_rs_writer->flush_chunk(*segment);
+        if (olap_status != OLAP_SUCCESS) {
+            LOG(WARNING) << "writer flush_chunk error, err=" << olap_status;
+            return Status::InternalError("writer flush_chunk error.");
+        }
+    }
+
+    if (stats_output != nullptr) {
+        stats_output->output_rows = rows->num_rows();
+        stats_output->merged_rows = reader.merged_rows();
+        stats_output->filtered_rows = reader.stats().rows_del_filtered;
+    }
+    TRACE_COUNTER_INCREMENT("cluster_columns", cluster_columns.size());
+    return Status::OK();
+}
+
+bool Compaction::should_compact_vertically(std::vector<std::vector<uint32_t>>* column_groups) {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    // The rows of AGG_KEYS and UNIQUE_KEYS are aggregated by all the columns, which can't be replayed.
+    if (tablet_schema.keys_type() != DUP_KEYS) {
+        return false;
+    }
+    if (!split_columns_into_groups(tablet_schema.num_columns(), tablet_schema.num_key_columns(), column_groups)) {
+        return false;
+    }
+    int64_t segments_num = 0;
+    for (auto& rowset : _input_rowsets) {
+        segments_num += rowset->num_segments();
+    }
+    if (segments_num > std::numeric_limits<uint16_t>::max()) {
+        return false;
+    }
+    // The delete predicates filter the rows by the columns which may be in other groups.
+    std::shared_lock rdlock(_tablet->get_header_lock());
+    for (const DeletePredicatePB& pred_pb : _tablet->delete_predicates()) {
+        if (pred_pb.version() <= _output_version.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Compaction::should_cluster(std::vector<ColumnId>* cluster_columns) const {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    // The rows of the other keys types are aggregated or deduplicated by the key, which needs the segments of a
+    // rowset not to overlap.
+    if (tablet_schema.keys_type() != DUP_KEYS) {
+        return false;
+    }
+    for (ColumnId cid = 0; cid < tablet_schema.num_columns(); cid++) {
+        if (tablet_schema.column(cid).is_cluster_column()) {
+            cluster_columns->push_back(cid);
+        }
+    }
+    // The rows are reordered in memory, and the rows fitting in one segment gain nothing from the clustering.
+    return !cluster_columns->empty() && _input_row_num <= config::compaction_cluster_max_rows &&
+           _input_row_num > config::compaction_cluster_rows_per_segment;
+}
+
+uint64_t Compaction::merge_chunk_size(MemTracker* mem_tracker) const {
+    int64_t num_rows = 0;
+    int64_t total_row_size = 0;
+    uint64_t chunk_size = DEFAULT_CHUNK_SIZE;
+    if (mem_tracker->limit() > 0) {
+        for (auto& rowset : _input_rowsets) {
+            num_rows += rowset->num_rows();
+            total_row_size += rowset->total_row_size();
+        }
+        int64_t avg_row_size = (total_row_size + 1) / (num_rows + 1);
+        // The result of thie division operation be zero, so added one
+        chunk_size = 1 + mem_tracker->limit() / (_input_rowsets.size() * avg_row_size + 1);
+    }
+    if (chunk_size > config::vector_chunk_size) {
+        chunk_size = config::vector_chunk_size;
+    }
+    return chunk_size;
+}
+
 void Compaction::modify_rowsets() {
     std::vector<RowsetSharedPtr> output_rowsets;
     output_rowsets.push_back(_output_rowset);
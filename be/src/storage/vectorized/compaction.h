@@ -57,6 +57,16 @@ protected:
     // return others on error
     Status merge_rowsets(MemTracker* mem_tracker, Statistics* stats_output);
 
+    // merge the key columns first and record the source of each row, then merge each group of the value columns
+    // by the recorded sources, so only the columns of a group are in memory at a time.
+    Status merge_rowsets_vertically(MemTracker* mem_tracker, const std::vector<std::vector<uint32_t>>& column_groups,
+                                    Statistics* stats_output);
+
+    // merge all the rows in memory and write the rows of each range of the Z-order curve on |cluster_columns|
+    // into a segment, sorted by the key.
+    Status merge_rowsets_clustered(MemTracker* mem_tracker, const std::vector<ColumnId>& cluster_columns,
+                                   Statistics* stats_output);
+
     void modify_rowsets();
 
     Status construct_output_rowset_writer();
@@ -64,6 +74,12 @@ protected:
     Status check_version_continuity(const std::vector<RowsetSharedPtr>& rowsets);
     Status check_correctness(const Statistics& stats);
 
+    // Returns true and splits the columns into |column_groups| if the rowsets should be merged vertically.
+    bool should_compact_vertically(std::vector<std::vector<uint32_t>>* column_groups);
+    // Returns true and sets the cluster columns to |cluster_columns| if the rowsets should be merged clustered.
+    bool should_cluster(std::vector<ColumnId>* cluster_columns) const;
+    uint64_t merge_chunk_size(MemTracker* mem_tracker) const;
+
     // semaphore used to limit the concurrency of running compaction tasks
     static Semaphore _concurrency_sem;
 
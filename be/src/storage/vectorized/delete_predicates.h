@@ -18,6 +18,9 @@ public:
     // Return all the predicates with version greater than or equal to |min_version|.
     DisjunctivePredicates get_predicates(int32_t min_version) const;
 
+    // The greatest version of the predicates, or 0 if there is none.
+    int32_t max_version() const { return _version_predicates.empty() ? 0 : _version_predicates.back()._version; }
+
 private:
     struct VersionAndPredicate {
         VersionAndPredicate(int32_t v, ConjunctivePredicates preds) : _version(v), _preds(std::move(preds)) {}
@@ -15,6 +15,8 @@
 namespace starrocks {
 namespace vectorized {
 
+static const std::string LOAD_OP_COLUMN = "__op";
+
 Status DeltaWriter::open(WriteRequest* req, MemTracker* mem_tracker, DeltaWriter** writer) {
     *writer = new DeltaWriter(req, mem_tracker, StorageEngine::instance());
     return Status::OK();
@@ -93,6 +95,14 @@ Status DeltaWriter::init() {
                      << ", version count=" << _tablet->version_count() << ", limit=" << config::tablet_max_versions;
         return Status::ServiceUnavailable("too many tablet versions");
     }
+    const TabletSchema* tablet_schema = &(_tablet->tablet_schema());
+    std::vector<uint32_t> partial_column_ids;
+    if (tablet_schema->keys_type() == KeysType::PRIMARY_KEYS) {
+        RETURN_IF_ERROR(_get_partial_update_columns(&partial_column_ids));
+        if (!partial_column_ids.empty()) {
+            _partial_tablet_schema = tablet_schema->create_partial_schema(partial_column_ids);
+        }
+    }
     {
         std::shared_lock base_migration_rlock(_tablet->get_migration_lock(), std::try_to_lock);
         if (!base_migration_rlock.owns_lock()) {
@@ -121,7 +131,13 @@ Status DeltaWriter::init() {
     writer_context.tablet_schema_hash = _req.schema_hash;
     writer_context.rowset_type = BETA_ROWSET;
     writer_context.rowset_path_prefix = _tablet->tablet_path();
-    writer_context.tablet_schema = &(_tablet->tablet_schema());
+    writer_context.tablet_schema = tablet_schema;
+    if (_partial_tablet_schema != nullptr) {
+        // the segments have only the columns of the partial update until the rowset is applied
+        writer_context.tablet_schema = _partial_tablet_schema.get();
+        writer_context.full_tablet_schema = tablet_schema;
+        writer_context.referenced_column_ids = std::move(partial_column_ids);
+    }
     writer_context.rowset_state = PREPARED;
     writer_context.txn_id = _req.txn_id;
     writer_context.load_id = _req.load_id;
@@ -134,11 +150,12 @@ Status DeltaWriter::init() {
         return Status::InternalError(ss.str());
     }
 
-    _tablet_schema = &(_tablet->tablet_schema());
+    _tablet_schema = writer_context.tablet_schema;
     _reset_mem_table();
 
     // create flush handler
-    olap_status = _storage_engine->memtable_flush_executor()->create_flush_token(&_flush_token);
+    olap_status = _storage_engine->memtable_flush_executor()->create_flush_token(
+            &_flush_token, ThreadPool::ExecutionMode::SERIAL, _tablet->data_dir());
     if (olap_status != OLAPStatus::OLAP_SUCCESS) {
         std::stringstream ss;
         ss << "Fail to create flush token. tablet_id=" << _req.tablet_id;
@@ -150,6 +167,34 @@ Status DeltaWriter::init() {
     return Status::OK();
 }
 
+Status DeltaWriter::_get_partial_update_columns(std::vector<uint32_t>* column_ids) const {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    size_t num_slots = _req.slots->size();
+    if (num_slots > 0 && _req.slots->back()->col_name() == LOAD_OP_COLUMN) {
+        num_slots--;
+    }
+    if (num_slots >= tablet_schema.num_columns()) {
+        return Status::OK();
+    }
+    for (size_t i = 0; i < num_slots; i++) {
+        const auto& name = (*_req.slots)[i]->col_name();
+        size_t cid = tablet_schema.field_index(name);
+        if (cid >= tablet_schema.num_columns()) {
+            return Status::InvalidArgument(
+                    Substitute("partial update column $0 not in tablet $1", name, _tablet->tablet_id()));
+        }
+        column_ids->push_back(cid);
+    }
+    // the updated rows are located by the keys
+    for (size_t i = 0; i < tablet_schema.num_key_columns(); i++) {
+        if (i >= column_ids->size() || (*column_ids)[i] != i) {
+            return Status::InvalidArgument(
+                    Substitute("partial update of tablet $0 requires all the key columns", _tablet->tablet_id()));
+        }
+    }
+    return Status::OK();
+}
+
 Status DeltaWriter::write(Chunk* chunk, const uint32_t* indexes, uint32_t from, uint32_t size) {
     if (_is_cancelled) {
         return Status::OK();
@@ -170,7 +215,6 @@ Status DeltaWriter::write(Chunk* chunk, const uint32_t* indexes, uint32_t from,
 }
 
 Status DeltaWriter::_flush_memtable_async() {
-    RETURN_IF_ERROR(_mem_table->finalize());
     return _flush_token->submit(_mem_table);
 }
 
@@ -76,6 +76,10 @@ private:
 
     void _reset_mem_table();
 
+    // A load of a primary-key tablet with the slots of a part of the columns is a partial update, the missing
+    // columns of the updated rows keep their old values. Returns the columns of the slots if it's a partial update.
+    Status _get_partial_update_columns(std::vector<uint32_t>* column_ids) const;
+
     bool _is_init = false;
     WriteRequest _req;
     TabletSharedPtr _tablet;
@@ -83,6 +87,8 @@ private:
     std::unique_ptr<RowsetWriter> _rowset_writer;
     std::shared_ptr<MemTable> _mem_table;
     const TabletSchema* _tablet_schema;
+    // the schema of the columns written by a partial update
+    std::unique_ptr<TabletSchema> _partial_tablet_schema;
     bool _delta_written_success;
 
     StorageEngine* _storage_engine;
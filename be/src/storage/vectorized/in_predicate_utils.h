@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "column/fixed_value_set.h"
 #include "column/hash_set.h"
 #include "storage/types.h"
 #include "util/string_parser.hpp"
@@ -83,6 +84,15 @@ private:
         }
     };
 
+    template <size_t N>
+    struct convert_to_container<FixedArraySet<T, N>> {
+        FixedArraySet<T, N> operator()(const std::vector<T>& elems) {
+            FixedArraySet<T, N> c;
+            CHECK(c.init(elems));
+            return c;
+        }
+    };
+
     std::vector<T> _elements;
 };
 
@@ -2,14 +2,17 @@
 
 #include "storage/vectorized/memtable.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/type_traits.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/schema.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "util/bit_util.h"
 #include "util/orlp/pdqsort.h"
 #include "util/starrocks_metrics.h"
 #include "util/time.h"
@@ -45,6 +48,17 @@ MemTable::MemTable(int64_t tablet_id, const TabletSchema* tablet_schema, const s
         // otherwise it will take up a lot of memory and may not be released.
         _aggregator = std::make_unique<ChunkAggregator>(&_vectorized_schema, 0, INT_MAX, 0);
     }
+
+    _normalized_key_supported = PrimaryKeyEncoder::is_supported(_vectorized_schema);
+    if (_normalized_key_supported) {
+        _normalized_key_fixed_size = PrimaryKeyEncoder::get_encoded_fixed_size(_vectorized_schema);
+    }
+    if (_keys_type == KeysType::UNIQUE_KEYS || _keys_type == KeysType::PRIMARY_KEYS) {
+        _replace_only = true;
+        for (size_t i = _vectorized_schema.num_key_fields(); i < _vectorized_schema.num_fields(); i++) {
+            _replace_only &= _vectorized_schema.field(i)->aggregate_method() == OLAP_FIELD_AGGREGATION_REPLACE;
+        }
+    }
 }
 
 MemTable::~MemTable() {
@@ -57,6 +71,8 @@ size_t MemTable::memory_usage() const {
     // used for sort
     size += sizeof(PermutationItem) * _permutations.size();
     size += sizeof(uint32_t) * _selective_values.size();
+    size += _normalized_keys.memory_usage();
+    size += sizeof(NormalizedKeyItem) * (_normalized_items.size() + _radix_buffer.size());
 
     // _result_chunk is the final result before flush
     if (_result_chunk != nullptr && _result_chunk->num_rows() > 0) {
@@ -252,13 +268,20 @@ void MemTable::_sort(bool is_final) {
     for (uint32_t i = 0; i < _chunk->num_rows(); ++i) {
         _permutations[i] = {i, i};
     }
-    if (_tablet_schema->num_key_columns() <= 3) {
+    bool normalized = _sort_chunk_by_normalized_keys();
+    if (normalized) {
+        // sorted already.
+    } else if (_tablet_schema->num_key_columns() <= 3) {
         _sort_chunk_by_columns();
     } else {
         _sort_chunk_by_rows();
     }
     _result_chunk = _chunk->clone_empty_with_schema();
-    _append_to_sorted_chunk(_chunk.get(), _result_chunk.get());
+    if (normalized && _replace_only) {
+        _append_deduplicated_to_sorted_chunk(_chunk.get(), _result_chunk.get());
+    } else {
+        _append_to_sorted_chunk(_chunk.get(), _result_chunk.get());
+    }
     if (is_final) {
         _chunk.reset();
     } else {
@@ -277,6 +300,22 @@ void MemTable::_append_to_sorted_chunk(Chunk* src, Chunk* dest) {
     dest->append_selective(*src, _selective_values.data(), 0, src->num_rows());
 }
 
+void MemTable::_append_deduplicated_to_sorted_chunk(Chunk* src, Chunk* dest) {
+    const size_t n = src->num_rows();
+    _selective_values.clear();
+    _selective_values.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t index = _permutations[i].index_in_chunk;
+        // The rows of the same key are in their original order, the last one replaces the others.
+        if (i + 1 < n &&
+            _normalized_keys.get_slice(index) == _normalized_keys.get_slice(_permutations[i + 1].index_in_chunk)) {
+            continue;
+        }
+        _selective_values.push_back(index);
+    }
+    dest->append_selective(*src, _selective_values.data(), 0, _selective_values.size());
+}
+
 void MemTable::_split_upserts_deletes(ChunkPtr& src, ChunkPtr* upserts, std::unique_ptr<Column>* deletes) {
     size_t op_column_id = src->num_columns() - 1;
     auto op_column = src->get_column_by_index(op_column_id);
@@ -424,12 +463,13 @@ private:
                                                             size_t count = 0) {
         const size_t row_num = (count == 0 || offset + count > perm->size()) ? (perm->size() - offset) : count;
         auto* binary_column = reinterpret_cast<BinaryColumn*>(column);
-        auto& data = binary_column->get_data();
-        std::vector<SortItem<Slice>> sort_items(row_num);
+        // The order of most strings is decided by the prefixes of their views.
+        const auto& data = binary_column->get_string_views();
+        std::vector<SortItem<StringView>> sort_items(row_num);
         for (uint32_t i = 0; i < row_num; ++i) {
             sort_items[i] = {data[(*perm)[i + offset].index_in_chunk], (*perm)[i + offset].index_in_chunk, i};
         }
-        auto less_fn = [](const SortItem<Slice>& l, const SortItem<Slice>& r) -> bool {
+        auto less_fn = [](const SortItem<StringView>& l, const SortItem<StringView>& r) -> bool {
             int res = l.value.compare(r.value);
             if (res == 0) {
                 return l.permutation_index < r.permutation_index;
@@ -541,6 +581,73 @@ void MemTable::_sort_chunk_by_columns() {
     }
 }
 
+// Stable LSD radix sort of the items by the highest |key_bytes| bytes of their prefixes, the rest bytes are 0.
+void MemTable::_radix_sort_by_prefix(std::vector<NormalizedKeyItem>* items, std::vector<NormalizedKeyItem>* buffer,
+                                     size_t key_bytes) {
+    const size_t n = items->size();
+    buffer->resize(n);
+    for (size_t shift = 64 - key_bytes * 8; shift < 64; shift += 8) {
+        uint32_t counts[257] = {0};
+        for (const auto& item : *items) {
+            counts[((item.prefix >> shift) & 0xFF) + 1]++;
+        }
+        // All the items have the same byte, the pass changes nothing.
+        if (std::any_of(counts + 1, counts + 257, [n](uint32_t c) { return c == n; })) {
+            continue;
+        }
+        for (size_t i = 1; i < 257; i++) {
+            counts[i] += counts[i - 1];
+        }
+        for (const auto& item : *items) {
+            (*buffer)[counts[(item.prefix >> shift) & 0xFF]++] = item;
+        }
+        items->swap(*buffer);
+    }
+}
+
+bool MemTable::_sort_chunk_by_normalized_keys() {
+    if (!config::enable_memtable_normalized_key_sort || !_normalized_key_supported) {
+        return false;
+    }
+    for (size_t i = 0; i < _tablet_schema->num_key_columns(); i++) {
+        if (_chunk->get_column_by_index(i)->is_nullable()) {
+            return false;
+        }
+    }
+    const size_t n = _chunk->num_rows();
+    _normalized_keys.reset_column();
+    PrimaryKeyEncoder::encode_sort_key(_vectorized_schema, *_chunk, 0, n, &_normalized_keys);
+    _normalized_items.resize(n);
+    for (uint32_t i = 0; i < n; i++) {
+        Slice key = _normalized_keys.get_slice(i);
+        uint64_t prefix = 0;
+        memcpy(&prefix, key.data, std::min<size_t>(key.size, sizeof(prefix)));
+        _normalized_items[i] = {BitUtil::byte_swap(prefix), i};
+    }
+
+    if (_normalized_key_fixed_size <= sizeof(uint64_t)) {
+        // The prefixes are the whole keys.
+        _radix_sort_by_prefix(&_normalized_items, &_radix_buffer, _normalized_key_fixed_size);
+    } else {
+        pdqsort(_normalized_items.begin(), _normalized_items.end(),
+                [this](const NormalizedKeyItem& l, const NormalizedKeyItem& r) {
+                    if (l.prefix != r.prefix) {
+                        return l.prefix < r.prefix;
+                    }
+                    int c = _normalized_keys.get_slice(l.index_in_chunk).compare(
+                            _normalized_keys.get_slice(r.index_in_chunk));
+                    if (c != 0) {
+                        return c < 0;
+                    }
+                    return l.index_in_chunk < r.index_in_chunk;
+                });
+    }
+    for (size_t i = 0; i < n; i++) {
+        _permutations[i].index_in_chunk = _normalized_items[i].index_in_chunk;
+    }
+    return true;
+}
+
 void MemTable::_sort_chunk_by_rows() {
     pdqsort(_permutations.begin(), _permutations.end(),
             [this](const MemTable::PermutationItem& l, const MemTable::PermutationItem& r) {
@@ -4,6 +4,7 @@
 
 #include <ostream>
 
+#include "column/binary_column.h"
 #include "column/chunk.h"
 #include "gen_cpp/olap_file.pb.h"
 #include "storage/olap_define.h"
@@ -44,7 +45,12 @@ private:
     void _sort(bool is_final);
     void _sort_chunk_by_columns();
     void _sort_chunk_by_rows();
+    // Sort the row indexes by the memcomparable encoding of the keys, radix sort if the keys are encoded into
+    // 8 bytes at most. Returns false if the keys can't be encoded.
+    bool _sort_chunk_by_normalized_keys();
     void _append_to_sorted_chunk(Chunk* src, Chunk* dest);
+    // Append the last row of each key only, which is the result of aggregating the rows by REPLACE.
+    void _append_deduplicated_to_sorted_chunk(Chunk* src, Chunk* dest);
 
     void _aggregate(bool is_final);
 
@@ -58,6 +64,15 @@ private:
     };
     using Permutation = std::vector<PermutationItem>;
 
+    struct NormalizedKeyItem {
+        // The first 8 bytes of the encoded key in big endian, 0 padded.
+        uint64_t prefix;
+        uint32_t index_in_chunk;
+    };
+
+    static void _radix_sort_by_prefix(std::vector<NormalizedKeyItem>* items, std::vector<NormalizedKeyItem>* buffer,
+                                      size_t key_bytes);
+
     ChunkPtr _chunk;
     ChunkPtr _result_chunk;
     vector<uint8_t> _result_deletes;
@@ -67,6 +82,17 @@ private:
     std::vector<uint32_t> _selective_values;
     Schema _vectorized_schema;
 
+    // for sort by normalized keys
+    bool _normalized_key_supported = false;
+    // The size of the encoded keys if they're of the fixed size, otherwise -1.
+    size_t _normalized_key_fixed_size = -1;
+    // Whether all the value columns are aggregated by REPLACE, so the rows of the same key are deduplicated
+    // by the sort.
+    bool _replace_only = false;
+    BinaryColumn _normalized_keys;
+    std::vector<NormalizedKeyItem> _normalized_items;
+    std::vector<NormalizedKeyItem> _radix_buffer;
+
     int64_t _tablet_id;
     const TabletSchema* _tablet_schema;
     // the slot in _slot_descs are in order of tablet's schema
@@ -7,10 +7,13 @@
 #include <vector>
 
 #include "boost/heap/skew_heap.hpp"
+#include "column/binary_column.h"
 #include "column/chunk.h"
 #include "common/config.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/current_mem_tracker.h"
 #include "storage/iterators.h" // StorageReadOptions
+#include "storage/primary_key_encoder.h"
 #include "storage/vectorized/chunk_helper.h"
 
 namespace starrocks::vectorized {
@@ -66,10 +69,11 @@ private:
 
 class HeapMergeIterator final : public ChunkIterator {
 public:
-    explicit HeapMergeIterator(std::vector<ChunkIteratorPtr> children)
+    explicit HeapMergeIterator(std::vector<ChunkIteratorPtr> children, std::vector<uint16_t>* row_sources = nullptr)
             : ChunkIterator(children[0]->schema(), children[0]->chunk_size()),
               _children(std::move(children)),
-              _chunk_pool(_children.size()) {
+              _chunk_pool(_children.size()),
+              _row_sources(row_sources) {
 #ifndef NDEBUG
         // ensure that the children's schemas are all the same.
         for (size_t i = 1; i < _children.size(); i++) {
@@ -109,6 +113,7 @@ private:
     std::vector<ChunkIteratorPtr> _children;
     std::vector<ChunkPtr> _chunk_pool;
     ChunkHeap _heap;
+    std::vector<uint16_t>* _row_sources;
     size_t _merged_rows = 0;
     bool _inited = false;
 };
@@ -143,6 +148,9 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
         if (offset == 0 && (_heap.empty() || min_chunk.less_than_all(_heap.top()))) {
             if (rows == 0) {
                 chunk->swap_chunk(*min_chunk._chunk);
+                if (_row_sources != nullptr) {
+                    _row_sources->insert(_row_sources->end(), chunk->num_rows(), min_chunk._order);
+                }
                 return _fill_heap(min_chunk._order);
             } else {
                 // retrieve |min_chunk| next time to avoid memory copy.
@@ -152,6 +160,9 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
         }
 
         chunk->append(*min_chunk._chunk, offset, 1);
+        if (_row_sources != nullptr) {
+            _row_sources->push_back(min_chunk._order);
+        }
         min_chunk.advance(1);
         rows += 1;
         if (min_chunk.remaining_rows() > 0) {
@@ -214,6 +225,342 @@ inline void HeapMergeIterator::close() {
     _chunk_pool.clear();
 }
 
+// Merge the children by a loser tree on the normalized keys, i.e. the key columns of the rows encoded into the
+// memcomparable binaries by `PrimaryKeyEncoder::encode_sort_key`, so two rows are compared by one memcmp.
+// The rows of the winner less than the least row of the other children are appended to the output at once,
+// and they are found by a binary search since the rows of each child are sorted.
+class LoserTreeMergeIterator final : public ChunkIterator {
+public:
+    explicit LoserTreeMergeIterator(std::vector<ChunkIteratorPtr> children, std::vector<uint16_t>* row_sources)
+            : ChunkIterator(children[0]->schema(), children[0]->chunk_size()),
+              _children(std::move(children)),
+              _inputs(_children.size()),
+              _tree(_children.size(), 0),
+              _row_sources(row_sources) {}
+
+    ~LoserTreeMergeIterator() override { close(); }
+
+    void close() override;
+
+    size_t merged_rows() const override { return _merged_rows; }
+
+protected:
+    Status do_get_next(Chunk* chunk) override;
+
+private:
+    struct Input {
+        ChunkPtr chunk;
+        std::unique_ptr<BinaryColumn> keys;
+        // The rows before it have been output.
+        size_t offset = 0;
+    };
+
+    Status _init();
+    Status _fill(size_t child);
+    void _close_child(size_t child);
+
+    bool _exhausted(size_t child) const { return _inputs[child].chunk == nullptr; }
+
+    // Whether the |row| of |a| goes before the current row of |b|, the rows of the equal keys are ordered by
+    // the index of their children.
+    bool _less(size_t a, size_t row, size_t b) const {
+        if (_exhausted(b)) {
+            return true;
+        }
+        const Input& rhs = _inputs[b];
+        int r = _inputs[a].keys->get_slice(row).compare(rhs.keys->get_slice(rhs.offset));
+        return (r < 0) | ((r == 0) & (a < b));
+    }
+
+    bool _less(size_t a, size_t b) const { return !_exhausted(a) && _less(a, _inputs[a].offset, b); }
+
+    // Replay the matches from the leaf of |child| to the root after its current row is changed.
+    void _replay(size_t child);
+
+    // The child of the least current row except the winner, which is one of the losers to the winner.
+    size_t _runner_up() const;
+
+    std::vector<ChunkIteratorPtr> _children;
+    std::vector<Input> _inputs;
+    // |_tree[0]| is the winner, and |_tree[i]| is the loser of the match of the node |i|. The leaf of the child
+    // |i| is the node |size + i|, so the parent of the node |i| is |i / 2|.
+    std::vector<size_t> _tree;
+    std::vector<uint16_t>* _row_sources;
+    size_t _merged_rows = 0;
+    bool _inited = false;
+};
+
+inline Status LoserTreeMergeIterator::_init() {
+    DCHECK(_chunk_size > 0);
+    const size_t k = _children.size();
+    for (size_t i = 0; i < k; i++) {
+        _inputs[i].chunk = ChunkHelper::new_chunk(_schema, _chunk_size);
+        _inputs[i].keys = std::make_unique<BinaryColumn>();
+        CurrentMemTracker::consume(_inputs[i].chunk->memory_usage() + _inputs[i].keys->memory_usage());
+        RETURN_IF_ERROR(_fill(i));
+    }
+    // Build the tree bottom-up by the winners of the subtrees.
+    std::vector<size_t> winners(2 * k);
+    for (size_t i = 0; i < k; i++) {
+        winners[k + i] = i;
+    }
+    for (size_t i = k - 1; i >= 1; i--) {
+        size_t a = winners[2 * i];
+        size_t b = winners[2 * i + 1];
+        bool a_wins = _less(a, b);
+        winners[i] = a_wins ? a : b;
+        _tree[i] = a_wins ? b : a;
+    }
+    _tree[0] = winners[1];
+    _inited = true;
+    return Status::OK();
+}
+
+inline void LoserTreeMergeIterator::_replay(size_t child) {
+    size_t winner = child;
+    for (size_t i = (_children.size() + child) / 2; i >= 1; i /= 2) {
+        if (_less(_tree[i], winner)) {
+            std::swap(_tree[i], winner);
+        }
+    }
+    _tree[0] = winner;
+}
+
+inline size_t LoserTreeMergeIterator::_runner_up() const {
+    size_t winner = _tree[0];
+    size_t best = winner;
+    for (size_t i = (_children.size() + winner) / 2; i >= 1; i /= 2) {
+        if (best == winner || _less(_tree[i], best)) {
+            best = _tree[i];
+        }
+    }
+    return best;
+}
+
+inline Status LoserTreeMergeIterator::do_get_next(Chunk* chunk) {
+    if (!_inited) {
+        RETURN_IF_ERROR(_init());
+    }
+    size_t rows = 0;
+    size_t prev_mem_usage = chunk->memory_usage();
+    Status st;
+    while (rows < _chunk_size) {
+        size_t winner = _tree[0];
+        if (_exhausted(winner)) {
+            break;
+        }
+        Input& input = _inputs[winner];
+        size_t num_rows = input.chunk->num_rows();
+        size_t offset = input.offset;
+        // Find the end of the rows less than the least row of the others.
+        size_t end = num_rows;
+        size_t runner_up = _runner_up();
+        if (runner_up != winner && !_exhausted(runner_up)) {
+            size_t lo = offset + 1;
+            size_t hi = num_rows;
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                if (_less(winner, mid, runner_up)) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            end = lo;
+        }
+
+        if (offset == 0 && end == num_rows) {
+            if (rows == 0) {
+                // no overlapping with the others, output the whole chunk without copy.
+                chunk->swap_chunk(*input.chunk);
+                if (_row_sources != nullptr) {
+                    _row_sources->insert(_row_sources->end(), chunk->num_rows(), winner);
+                }
+                rows = chunk->num_rows();
+                st = _fill(winner);
+                _replay(winner);
+                break;
+            }
+            // retrieve the chunk next time to avoid memory copy.
+            break;
+        }
+
+        size_t n = std::min(end - offset, _chunk_size - rows);
+        chunk->append(*input.chunk, offset, n);
+        if (_row_sources != nullptr) {
+            _row_sources->insert(_row_sources->end(), n, winner);
+        }
+        input.offset += n;
+        rows += n;
+        if (input.offset == num_rows) {
+            st = _fill(winner);
+            if (!st.ok()) {
+                break;
+            }
+        }
+        _replay(winner);
+    }
+    CurrentMemTracker::consume(static_cast<int64_t>(chunk->memory_usage()) - static_cast<int64_t>(prev_mem_usage));
+    if (!st.ok()) {
+        return st;
+    } else if (rows > 0) {
+        return Status::OK();
+    } else {
+        return Status::EndOfFile("End of merge iterator");
+    }
+}
+
+inline Status LoserTreeMergeIterator::_fill(size_t child) {
+    Input& input = _inputs[child];
+    CurrentMemTracker::release(input.chunk->memory_usage() + input.keys->memory_usage());
+    input.chunk->reset();
+    input.keys->reset_column();
+    input.offset = 0;
+
+    Status st = _children[child]->get_next(input.chunk.get());
+    if (st.ok()) {
+        DCHECK_GT(input.chunk->num_rows(), 0u);
+        PrimaryKeyEncoder::encode_sort_key(_schema, *input.chunk, 0, input.chunk->num_rows(), input.keys.get());
+        CurrentMemTracker::consume(input.chunk->memory_usage() + input.keys->memory_usage());
+    } else if (st.is_end_of_file()) {
+        // ignore Status::EndOfFile.
+        _close_child(child);
+    } else {
+        _close_child(child);
+        return st;
+    }
+    return Status::OK();
+}
+
+inline void LoserTreeMergeIterator::_close_child(size_t child) {
+    if (_children[child] == nullptr) {
+        return;
+    }
+    if (_inputs[child].chunk != nullptr) {
+        CurrentMemTracker::release(_inputs[child].chunk->memory_usage() + _inputs[child].keys->memory_usage());
+    }
+    _inputs[child].chunk.reset();
+    _inputs[child].keys.reset();
+    _merged_rows += _children[child]->merged_rows();
+    _children[child]->close();
+    _children[child].reset();
+}
+
+inline void LoserTreeMergeIterator::close() {
+    for (size_t i = 0; i < _children.size(); i++) {
+        _close_child(i);
+    }
+    _children.clear();
+    _inputs.clear();
+}
+
+class RowSourceMergeIterator final : public ChunkIterator {
+public:
+    RowSourceMergeIterator(std::vector<ChunkIteratorPtr> children, const std::vector<uint16_t>* row_sources)
+            : ChunkIterator(children[0]->schema(), children[0]->chunk_size()),
+              _children(std::move(children)),
+              _chunk_pool(_children.size()),
+              _offsets(_children.size(), 0),
+              _row_sources(row_sources) {}
+
+    ~RowSourceMergeIterator() override { close(); }
+
+    void close() override;
+
+protected:
+    Status do_get_next(Chunk* chunk) override;
+
+private:
+    // Make sure the chunk of |child| has the rows not output yet.
+    Status _fill_chunk(size_t child);
+
+    std::vector<ChunkIteratorPtr> _children;
+    std::vector<ChunkPtr> _chunk_pool;
+    // The rows of the chunk of each child before it have been output.
+    std::vector<size_t> _offsets;
+    const std::vector<uint16_t>* _row_sources;
+    // The rows of |_row_sources| before it have been output.
+    size_t _pos = 0;
+};
+
+inline Status RowSourceMergeIterator::_fill_chunk(size_t child) {
+    if (child >= _children.size() || _children[child] == nullptr) {
+        return Status::InternalError(strings::Substitute("invalid row source $0", child));
+    }
+    if (_chunk_pool[child] == nullptr) {
+        _chunk_pool[child] = ChunkHelper::new_chunk(_schema, _chunk_size);
+    }
+    Chunk* chunk = _chunk_pool[child].get();
+    if (_offsets[child] < chunk->num_rows()) {
+        return Status::OK();
+    }
+    chunk->reset();
+    _offsets[child] = 0;
+    Status st = _children[child]->get_next(chunk);
+    if (st.is_end_of_file()) {
+        return Status::InternalError(strings::Substitute("the child $0 has less rows than the row sources", child));
+    }
+    return st;
+}
+
+inline Status RowSourceMergeIterator::do_get_next(Chunk* chunk) {
+    const std::vector<uint16_t>& sources = *_row_sources;
+    size_t rows = 0;
+    while (_pos < sources.size() && rows < _chunk_size) {
+        uint16_t child = sources[_pos];
+        RETURN_IF_ERROR(_fill_chunk(child));
+        Chunk* src = _chunk_pool[child].get();
+        // Output the consecutive rows of the same child at once.
+        size_t limit = std::min(src->num_rows() - _offsets[child], _chunk_size - rows);
+        size_t n = 1;
+        while (n < limit && _pos + n < sources.size() && sources[_pos + n] == child) {
+            n++;
+        }
+        chunk->append(*src, _offsets[child], n);
+        _offsets[child] += n;
+        _pos += n;
+        rows += n;
+    }
+    return rows > 0 ? Status::OK() : Status::EndOfFile("End of row source merge iterator");
+}
+
+inline void RowSourceMergeIterator::close() {
+    for (auto& child : _children) {
+        if (child != nullptr) {
+            child->close();
+            child.reset();
+        }
+    }
+    _children.clear();
+    _chunk_pool.clear();
+}
+
+static ChunkIteratorPtr new_sorted_merge_iterator(const std::vector<ChunkIteratorPtr>& children,
+                                                std::vector<uint16_t>* row_sources) {
+    if (config::enable_normalized_key_merge && PrimaryKeyEncoder::is_supported(children[0]->schema())) {
+        return std::make_shared<LoserTreeMergeIterator>(children, row_sources);
+    }
+    return std::make_shared<HeapMergeIterator>(children, row_sources);
+}
+
+ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children, std::vector<uint16_t>* row_sources) {
+    DCHECK(!children.empty());
+    DCHECK_LE(children.size(), std::numeric_limits<uint16_t>::max());
+    if (children.size() == 1) {
+        return children[0];
+    }
+    return new_sorted_merge_iterator(children, row_sources);
+}
+
+ChunkIteratorPtr new_row_source_merge_iterator(const std::vector<ChunkIteratorPtr>& children,
+                                               const std::vector<uint16_t>* row_sources) {
+    DCHECK(!children.empty());
+    if (children.size() == 1) {
+        return children[0];
+    }
+    return std::make_shared<RowSourceMergeIterator>(children, row_sources);
+}
+
 ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children) {
     DCHECK(!children.empty());
     if (children.size() == 1) {
@@ -225,7 +572,7 @@ ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& childre
     const static size_t kMaxChildrenSize = std::numeric_limits<uint16_t>::max();
 
     if (children.size() <= kMaxChildrenSize) {
-        return std::make_shared<HeapMergeIterator>(children);
+        return new_sorted_merge_iterator(children, nullptr);
     }
     std::vector<ChunkIteratorPtr> sub_merge_iterators;
     sub_merge_iterators.reserve((children.size() + kMaxChildrenSize - 1) / kMaxChildrenSize);
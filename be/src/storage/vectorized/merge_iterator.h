@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "storage/vectorized/chunk_iterator.h"
@@ -20,6 +21,23 @@ namespace starrocks::vectorized {
 //  - |children| are sorted iterators, i.e, each iterator in |children|
 //    should return rows in an ascending order based on the key columns.
 // one typical usage of this iterator is merging rows of the segments in the same `rowset`.
+// if the key columns are supported by `PrimaryKeyEncoder`, the rows are merged by their encoded keys, see
+// config::enable_normalized_key_merge.
 ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children);
 
+// Same as above, except that the index of the child of each output row is appended to |row_sources|, so the
+// other columns of the same rows could be merged in the same order by `new_row_source_merge_iterator`, which
+// is used by the vertical compaction. If |children| has only one element, nothing is appended.
+//
+// REQUIRES: the size of |children| is no more than UINT16_MAX.
+ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children, std::vector<uint16_t>* row_sources);
+
+// new_row_source_merge_iterator merges the rows of |children| by |row_sources| instead of comparing the keys,
+// i.e. the i-th output row is the next row of the child of index |row_sources[i]|. |row_sources| must be
+// kept until the iterator is closed, and if |children| has only one element, it's returned directly.
+//
+// REQUIRES: |children| output the same rows as the ones merged to |row_sources|.
+ChunkIteratorPtr new_row_source_merge_iterator(const std::vector<ChunkIteratorPtr>& children,
+                                               const std::vector<uint16_t>* row_sources);
+
 } // namespace starrocks::vectorized
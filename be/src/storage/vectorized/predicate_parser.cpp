@@ -49,6 +49,9 @@ ColumnPredicate* PredicateParser::parse(const TCondition& condition) const {
                (condition.condition_op.size() == 2 && strcasecmp(condition.condition_op.c_str(), "is") == 0)) {
         bool is_null = strcasecmp(condition.condition_values[0].c_str(), "null") == 0;
         pred = new_column_null_predicate(type_info, index, is_null);
+    } else if (condition.condition_op == "contains" && condition.condition_values.size() == 1) {
+        RETURN_IF(type != OLAP_FIELD_TYPE_CHAR && type != OLAP_FIELD_TYPE_VARCHAR, nullptr);
+        pred = new_column_contains_predicate(type_info, index, condition.condition_values[0]);
     } else {
         LOG(WARNING) << "unknown condition: " << condition.condition_op;
         return pred;
@@ -31,7 +31,8 @@ void Reader::close() {
 
 Status Reader::init(const ReaderParams& read_params) {
     read_params.check_validation();
-    if (read_params.reader_type != ReaderType::READER_QUERY && !is_compaction(read_params.reader_type)) {
+    if (read_params.reader_type != ReaderType::READER_QUERY && !is_compaction(read_params.reader_type) &&
+        read_params.reader_type != ReaderType::READER_ALTER_TABLE) {
         return Status::NotSupported("reader type not supported now");
     }
     RETURN_IF_ERROR(_init_load_bf_columns(read_params));
@@ -66,6 +67,15 @@ Status Reader::_get_segment_iterators(const TabletSharedPtr& tablet, const Versi
     return Status::OK();
 }
 
+Status Reader::_get_segment_iterators(const std::vector<RowsetSharedPtr>& rowsets, const RowsetReadOptions& options,
+                                      std::vector<ChunkIteratorPtr>* iters) {
+    SCOPED_RAW_TIMER(&_stats.capture_rowset_ns);
+    for (auto& rowset : rowsets) {
+        RETURN_IF_ERROR(rowset->get_segment_iterators(schema(), options, iters));
+    }
+    return Status::OK();
+}
+
 Status Reader::_init_collector(const ReaderParams& params) {
     RowsetReadOptions rs_opts;
     KeysType keys_type = params.tablet->tablet_schema().keys_type();
@@ -73,24 +83,35 @@ Status Reader::_init_collector(const ReaderParams& params) {
     RETURN_IF_ERROR(_init_delete_predicates(params, &_delete_predicates));
     RETURN_IF_ERROR(_parse_seek_range(params, &rs_opts.ranges));
     rs_opts.predicates = _pushdown_predicates;
+    rs_opts.runtime_predicates = params.runtime_predicates;
     rs_opts.sorted = (keys_type != DUP_KEYS && keys_type != PRIMARY_KEYS) && !params.skip_aggregation;
     rs_opts.load_bf_columns = &_load_bf_columns;
     rs_opts.reader_type = params.reader_type;
     rs_opts.chunk_size = params.chunk_size;
+    rs_opts.read_ahead_pages = params.read_ahead_pages;
     rs_opts.delete_predicates = &_delete_predicates;
     rs_opts.stats = &_stats;
     rs_opts.runtime_state = params.runtime_state;
     rs_opts.profile = params.profile;
     rs_opts.use_page_cache = params.use_page_cache;
     rs_opts.tablet_schema = &(params.tablet->tablet_schema());
+    rs_opts.rowid_range_option = params.rowid_range_option.get();
+    rs_opts.global_dicts = params.global_dicts;
+    if (params.reader_type == READER_QUERY && (keys_type == DUP_KEYS || keys_type == PRIMARY_KEYS)) {
+        rs_opts.meta_aggregates = params.meta_aggregates;
+    }
+    rs_opts.version = params.version.second;
     if (keys_type == KeysType::PRIMARY_KEYS) {
         rs_opts.is_primary_keys = true;
-        rs_opts.version = params.version.second;
         rs_opts.meta = params.tablet->data_dir()->get_meta();
     }
 
     std::vector<ChunkIteratorPtr> seg_iters;
-    RETURN_IF_ERROR(_get_segment_iterators(params.tablet, params.version, rs_opts, &seg_iters));
+    if (params.rowsets.empty()) {
+        RETURN_IF_ERROR(_get_segment_iterators(params.tablet, params.version, rs_opts, &seg_iters));
+    } else {
+        RETURN_IF_ERROR(_get_segment_iterators(params.rowsets, rs_opts, &seg_iters));
+    }
 
     // Put each SegmentIterator into a TimedChunkIterator, if a profile is provided.
     if (params.profile != nullptr) {
@@ -111,7 +132,8 @@ Status Reader::_init_collector(const ReaderParams& params) {
 
     if (seg_iters.empty()) {
         _collect_iter = new_empty_iterator(_schema, params.chunk_size);
-    } else if (is_compaction(params.reader_type) && keys_type == DUP_KEYS) {
+    } else if ((is_compaction(params.reader_type) || params.reader_type == READER_ALTER_TABLE) &&
+               keys_type == DUP_KEYS) {
         //             MergeIterator
         //                   |
         //       +-----------+-----------+
@@ -120,7 +142,16 @@ Status Reader::_init_collector(const ReaderParams& params) {
         //       |           |           |
         // SegmentIterator  ...    SegmentIterator
         //
-        _collect_iter = new_merge_iterator(std::move(seg_iters));
+        if (params.row_sources != nullptr && params.replay_row_sources) {
+            _collect_iter = new_row_source_merge_iterator(seg_iters, params.row_sources);
+        } else if (params.row_sources != nullptr) {
+            if (seg_iters.size() > std::numeric_limits<uint16_t>::max()) {
+                return Status::NotSupported("too many segments to record the row sources");
+            }
+            _collect_iter = new_merge_iterator(seg_iters, params.row_sources);
+        } else {
+            _collect_iter = new_merge_iterator(std::move(seg_iters));
+        }
     } else if (keys_type == PRIMARY_KEYS || keys_type == DUP_KEYS || (keys_type == UNIQUE_KEYS && skip_aggr) ||
                (select_all_keys && seg_iters.size() == 1)) {
         //             UnionIterator
@@ -132,6 +163,37 @@ Status Reader::_init_collector(const ReaderParams& params) {
         // SegmentIterator  ...    SegmentIterator
         //
         _collect_iter = new_union_iterator(std::move(seg_iters));
+    } else if (keys_type == AGG_KEYS && skip_aggr && config::enable_prefix_pre_aggregation &&
+               _schema.num_key_fields() > 0 && _is_key_prefix()) {
+        // The key columns read are a prefix of the sort key, so the merged rows are sorted by them, and the rows
+        // of the same prefix are aggregated into one row before being returned.
+        //                 Timer
+        //                   |
+        //           AggregateIterator (factor = 0)
+        //                   |
+        //                 Timer
+        //                   |
+        //             MergeIterator
+        //                   |
+        //       +-----------+-----------+
+        //       |           |           |
+        //     Timer        ...        Timer
+        //       |           |           |
+        // SegmentIterator  ...    SegmentIterator
+        //
+        if (params.profile != nullptr && params.profile->parent() != nullptr) {
+            RuntimeProfile* p = params.profile->parent()->create_child("MERGE", true, true);
+            RuntimeProfile::Counter* sort_timer = ADD_TIMER(p, "sort");
+            RuntimeProfile::Counter* aggr_timer = ADD_TIMER(p, "aggr");
+
+            _collect_iter = new_merge_iterator(seg_iters);
+            _collect_iter = timed_chunk_iterator(std::move(_collect_iter), sort_timer);
+            _collect_iter = new_aggregate_iterator(std::move(_collect_iter), 0);
+            _collect_iter = timed_chunk_iterator(std::move(_collect_iter), aggr_timer);
+        } else {
+            _collect_iter = new_merge_iterator(seg_iters);
+            _collect_iter = new_aggregate_iterator(std::move(_collect_iter), 0);
+        }
     } else if ((keys_type == AGG_KEYS || keys_type == UNIQUE_KEYS) && !skip_aggr) {
         //                 Timer
         //                   |
@@ -196,6 +258,15 @@ Status Reader::_init_collector(const ReaderParams& params) {
     return Status::OK();
 }
 
+bool Reader::_is_key_prefix() const {
+    for (size_t i = 0; i < _schema.num_key_fields(); i++) {
+        if (_schema.field(i)->id() != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status Reader::_init_predicates(const ReaderParams& params) {
     for (const ColumnPredicate* pred : params.predicates) {
         _pushdown_predicates[pred->column_id()].emplace_back(pred);
@@ -209,14 +280,19 @@ Status Reader::_init_load_bf_columns(const ReaderParams& read_params) {
 }
 
 Status Reader::_init_delete_predicates(const ReaderParams& params, DeletePredicates* dels) {
-    PredicateParser pred_parser(params.tablet->tablet_schema());
+    return parse_delete_predicates(params.tablet.get(), params.version.second, dels, &_predicate_free_list);
+}
+
+Status Reader::parse_delete_predicates(Tablet* tablet, int64_t max_version, DeletePredicates* dels,
+                                       std::vector<const ColumnPredicate*>* preds) {
+    PredicateParser pred_parser(tablet->tablet_schema());
 
     Status st;
 
-    params.tablet->obtain_header_rdlock();
+    tablet->obtain_header_rdlock();
 
-    for (const DeletePredicatePB& pred_pb : params.tablet->delete_predicates()) {
-        if (pred_pb.version() > params.version.second) {
+    for (const DeletePredicatePB& pred_pb : tablet->delete_predicates()) {
+        if (pred_pb.version() > max_version) {
             continue;
         }
 
@@ -228,8 +304,8 @@ Status Reader::_init_delete_predicates(const ReaderParams& params, DeletePredica
                 st = Status::InternalError("invalid delete condition string");
                 break;
             }
-            size_t idx = params.tablet->tablet_schema().field_index(cond.column_name);
-            if (idx >= params.tablet->num_key_columns() && params.tablet->keys_type() != DUP_KEYS) {
+            size_t idx = tablet->tablet_schema().field_index(cond.column_name);
+            if (idx >= tablet->num_key_columns() && tablet->keys_type() != DUP_KEYS) {
                 LOG(WARNING) << "ignore delete condition of non-key column: " << pred_pb.sub_predicates(i);
                 continue;
             }
@@ -242,7 +318,7 @@ Status Reader::_init_delete_predicates(const ReaderParams& params, DeletePredica
             }
             conjunctions.add(pred);
             // save for memory release.
-            _predicate_free_list.emplace_back(pred);
+            preds->emplace_back(pred);
         }
 
         for (int i = 0; i != pred_pb.in_predicates_size(); ++i) {
@@ -266,13 +342,13 @@ Status Reader::_init_delete_predicates(const ReaderParams& params, DeletePredica
             }
             conjunctions.add(pred);
             // save for memory release.
-            _predicate_free_list.emplace_back(pred);
+            preds->emplace_back(pred);
         }
 
         dels->add(pred_pb.version(), conjunctions);
     }
 
-    params.tablet->release_header_lock();
+    tablet->release_header_lock();
     return st;
 }
 
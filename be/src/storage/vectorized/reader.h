@@ -30,6 +30,11 @@ public:
 
     size_t merged_rows() const override { return _collect_iter->merged_rows(); }
 
+    // Parse the delete predicates of |tablet| of the versions no greater than |max_version| into |dels|.
+    // The column predicates parsed are appended to |preds|, and they should be deleted by the caller.
+    static Status parse_delete_predicates(Tablet* tablet, int64_t max_version, DeletePredicates* dels,
+                                          std::vector<const ColumnPredicate*>* preds);
+
 protected:
     Status do_get_next(Chunk* chunk) override;
 
@@ -42,9 +47,13 @@ private:
     Status _init_load_bf_columns(const ReaderParams& read_params);
     Status _init_delete_predicates(const ReaderParams& read_params, DeletePredicates* dels);
     Status _init_collector(const ReaderParams& read_params);
+    // Whether the key columns read are a prefix of the sort key of the tablet.
+    bool _is_key_prefix() const;
     Status _to_seek_tuple(const TabletSchema& tablet_schema, const OlapTuple& input, SeekTuple* tuple);
     Status _get_segment_iterators(const TabletSharedPtr& tablet, const Version& version,
                                   const RowsetReadOptions& options, std::vector<ChunkIteratorPtr>* iters);
+    Status _get_segment_iterators(const std::vector<RowsetSharedPtr>& rowsets, const RowsetReadOptions& options,
+                                  std::vector<ChunkIteratorPtr>* iters);
 
     MemTracker _memtracker;
     MemPool _mempool;
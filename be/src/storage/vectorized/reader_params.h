@@ -5,10 +5,13 @@
 #include <string>
 #include <vector>
 
+#include "runtime/vectorized/global_dict.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/vectorized/rowid_range_option.h"
 #include "storage/tablet.h"
 #include "storage/tuple.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/runtime_column_predicate.h"
 
 namespace starrocks {
 
@@ -18,6 +21,7 @@ class RuntimeState;
 namespace vectorized {
 
 class ColumnPredicate;
+class MetaAggregates;
 
 // Params for reader
 struct ReaderParams {
@@ -43,6 +47,26 @@ struct ReaderParams {
     std::vector<OlapTuple> start_key;
     std::vector<OlapTuple> end_key;
     std::vector<const ColumnPredicate*> predicates;
+    // The predicates whose bounds are tightened during the scan, they are applied to the zone maps only,
+    // the caller is responsible to filter the rows by them.
+    RuntimeColumnPredicates runtime_predicates;
+
+    // If not empty, the rowsets are read instead of the ones captured from |tablet| by |version|.
+    std::vector<RowsetSharedPtr> rowsets;
+    // If set, only the row range of the segment selected by it is read, |rowsets| must have only one rowset.
+    RowidRangeOptionPtr rowid_range_option;
+    // If set, the columns in it are read as the ids of their global dicts, which are INT fields in the schema.
+    const GlobalDicts* global_dicts = nullptr;
+    // If set, the segments whose COUNT(*) and MIN/MAX are answered by their metadata are added to it instead of
+    // being read. It's ignored unless the rows of the segments are read without merging, i.e. the tablet is of
+    // DUP_KEYS or PRIMARY_KEYS.
+    MetaAggregates* meta_aggregates = nullptr;
+    // If set, the segments of a DUP_KEYS compaction are merged by the keys and the index of the segment of each
+    // output row is appended to it, or they are merged by it if |replay_row_sources| is true, which is used by
+    // the vertical compaction, see `new_row_source_merge_iterator`. |rowsets| must be set to read the segments
+    // in the same order.
+    std::vector<uint16_t>* row_sources = nullptr;
+    bool replay_row_sources = false;
 
     RuntimeState* runtime_state = nullptr;
 
@@ -51,6 +75,8 @@ struct ReaderParams {
     void check_validation() const;
     std::string to_string() const;
     int chunk_size = 1024;
+    // The max number of the pages of each column read ahead asynchronously, 0 disables read-ahead.
+    int read_ahead_pages = 0;
 };
 
 } // namespace vectorized
@@ -2,12 +2,16 @@
 
 #include "storage/vectorized/rowset_merger.h"
 
+#include "common/config.h"
 #include "gutil/stl_util.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset_writer.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/tablet.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/empty_iterator.h"
+#include "storage/vectorized/merge_iterator.h"
+#include "storage/vectorized/union_iterator.h"
 #include "util/pretty_printer.h"
 #include "util/starrocks_metrics.h"
 
@@ -32,6 +36,8 @@ struct MergeEntry {
     const T* pk_start = nullptr;
     uint32_t cur_segment_idx = 0;
     uint32_t rowset_seg_id = 0;
+    // The index of the entry, which is the row source of its rows.
+    uint16_t order = 0;
     ColumnPtr chunk_pk_column;
     ChunkPtr chunk;
     vector<ChunkIteratorPtr> segment_itrs;
@@ -154,7 +160,8 @@ public:
         return Status::OK();
     }
 
-    Status get_next(Chunk* chunk, vector<uint32_t>* rssids) {
+    // The entries of the output rows are appended to |row_sources| if it's not null.
+    Status get_next(Chunk* chunk, vector<uint32_t>* rssids, vector<uint16_t>* row_sources = nullptr) {
         size_t nrow = 0;
         while (!_heap.empty() && nrow < _chunk_size) {
             MergeEntry<T>& top = *_heap.top();
@@ -165,6 +172,9 @@ public:
                 if (nrow == 0 && top.at_start()) {
                     chunk->swap_chunk(*top.chunk);
                     rssids->insert(rssids->end(), chunk->num_rows(), top.rowset_seg_id);
+                    if (row_sources != nullptr) {
+                        row_sources->insert(row_sources->end(), chunk->num_rows(), top.order);
+                    }
                     top.pk_cur = top.pk_last + 1;
                     return _fill_heap(&top);
                 } else {
@@ -173,6 +183,9 @@ public:
                     auto start_offset = top.offset(top.pk_cur);
                     chunk->append(*top.chunk, start_offset, nappend);
                     rssids->insert(rssids->end(), nappend, top.rowset_seg_id);
+                    if (row_sources != nullptr) {
+                        row_sources->insert(row_sources->end(), nappend, top.order);
+                    }
                     top.pk_cur += nappend;
                     if (top.pk_cur > top.pk_last) {
                         //LOG(INFO) << "  append all " << nappend << "  get_next batch";
@@ -190,6 +203,9 @@ public:
                 nrow++;
                 top.pk_cur++;
                 rssids->push_back(top.rowset_seg_id);
+                if (row_sources != nullptr) {
+                    row_sources->push_back(top.order);
+                }
                 if (top.pk_cur > top.pk_last) {
                     auto start_offset = top.offset(start);
                     auto end_offset = top.offset(top.pk_cur);
@@ -220,31 +236,28 @@ public:
         return Status::EndOfFile("merge end");
     }
 
-    Status do_merge(Tablet& tablet, int64_t version, const Schema& schema, const vector<RowsetSharedPtr>& rowsets,
-                    RowsetWriter* writer, const MergeConfig& cfg) {
-        MonotonicStopWatch timer;
-        timer.start();
-        _chunk_size = cfg.chunk_size;
-        OlapReaderStatistics stats;
+    // Create an entry of each rowset reading the columns of |schema|, and push them into the heap.
+    Status _init_entries(Tablet& tablet, int64_t version, const Schema& schema, const vector<RowsetSharedPtr>& rowsets,
+                         OlapReaderStatistics* stats, size_t* total_input_size) {
         std::unique_ptr<vectorized::Column> pk_column;
         if (schema.num_key_fields() > 1) {
             if (!PrimaryKeyEncoder::create_column(schema, &pk_column).ok()) {
                 LOG(FATAL) << "create column for primary key encoder failed";
             }
         }
-        size_t total_input_size = 0;
         for (int i = 0; i < rowsets.size(); i++) {
-            total_input_size += rowsets[i]->data_disk_size();
+            *total_input_size += rowsets[i]->data_disk_size();
             _entries.emplace_back(new MergeEntry<T>());
             MergeEntry<T>& entry = *_entries.back();
             entry.rowset_release_guard = std::make_unique<RowsetReleaseGuard>(rowsets[i]);
             auto rowset = rowsets[i].get();
             auto beta_rowset = down_cast<BetaRowset*>(rowset);
-            auto res = beta_rowset->get_segment_iterators2(schema, tablet.data_dir()->get_meta(), version, &stats);
+            auto res = beta_rowset->get_segment_iterators2(schema, tablet.data_dir()->get_meta(), version, stats);
             if (!res.ok()) {
                 return res.status();
             }
             entry.rowset_seg_id = rowset->rowset_meta()->get_rowset_seg_id();
+            entry.order = i;
             entry.segment_itrs.swap(res.value());
             entry.chunk = ChunkHelper::new_chunk(schema, _chunk_size);
             if (pk_column) {
@@ -263,6 +276,22 @@ public:
                 _heap.push(&entry);
             }
         }
+        return Status::OK();
+    }
+
+    Status do_merge(Tablet& tablet, int64_t version, const Schema& schema, const vector<RowsetSharedPtr>& rowsets,
+                    RowsetWriter* writer, const MergeConfig& cfg) {
+        std::vector<std::vector<uint32_t>> column_groups;
+        if (rowsets.size() <= std::numeric_limits<uint16_t>::max() &&
+            split_columns_into_groups(schema.num_fields(), schema.num_key_fields(), &column_groups)) {
+            return _do_merge_vertically(tablet, version, rowsets, writer, cfg, column_groups);
+        }
+        MonotonicStopWatch timer;
+        timer.start();
+        _chunk_size = cfg.chunk_size;
+        OlapReaderStatistics stats;
+        size_t total_input_size = 0;
+        RETURN_IF_ERROR(_init_entries(tablet, version, schema, rowsets, &stats, &total_input_size));
 
         auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
 
@@ -322,6 +351,127 @@ public:
         return Status::OK();
     }
 
+    // Merge the key columns by the heap first, and record the entry of each row. Then merge each group of the
+    // value columns by replaying the recorded entries, which read the rows in the same order.
+    Status _do_merge_vertically(Tablet& tablet, int64_t version, const vector<RowsetSharedPtr>& rowsets,
+                                RowsetWriter* writer, const MergeConfig& cfg,
+                                const std::vector<std::vector<uint32_t>>& column_groups) {
+        MonotonicStopWatch timer;
+        timer.start();
+        _chunk_size = cfg.chunk_size;
+        const TabletSchema& tablet_schema = tablet.tablet_schema();
+        OlapReaderStatistics stats;
+        size_t total_input_size = 0;
+        size_t total_rows = 0;
+        size_t total_chunk = 0;
+        vector<uint16_t> row_sources;
+        {
+            Schema schema = ChunkHelper::convert_schema(tablet_schema, column_groups[0]);
+            RETURN_IF_ERROR(_init_entries(tablet, version, schema, rowsets, &stats, &total_input_size));
+            auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
+            auto chunk = ChunkHelper::new_chunk(schema, _chunk_size);
+            vector<uint32_t> rssids;
+            rssids.reserve(_chunk_size);
+            while (true) {
+                chunk->reset();
+                rssids.clear();
+                Status status = get_next(chunk.get(), &rssids, &row_sources);
+                if (status.is_end_of_file()) {
+                    break;
+                } else if (!status.ok()) {
+                    return Status::InternalError("reader get_next error.");
+                }
+                ChunkHelper::padding_char_columns(char_field_indexes, schema, tablet_schema, chunk.get());
+                total_rows += chunk->num_rows();
+                total_chunk++;
+                if (writer->add_columns_with_rssid(*chunk, column_groups[0], rssids) != OLAP_SUCCESS) {
+                    return Status::InternalError("writer add_columns_with_rssid error.");
+                }
+            }
+            if (writer->flush_columns() != OLAP_SUCCESS) {
+                return Status::InternalError("writer flush_columns error.");
+            }
+            _entries.clear();
+        }
+        if (stats.raw_rows_read - stats.rows_del_vec_filtered != total_rows) {
+            string msg = Substitute("update compaction rows read($0) != rows written($1)",
+                                    stats.raw_rows_read - stats.rows_del_vec_filtered, total_rows);
+            DCHECK(false) << msg;
+            LOG(WARNING) << msg;
+        }
+
+        for (size_t i = 1; i < column_groups.size(); i++) {
+            Schema schema = ChunkHelper::convert_schema(tablet_schema, column_groups[i]);
+            OlapReaderStatistics group_stats;
+            std::vector<std::unique_ptr<RowsetReleaseGuard>> guards;
+            std::vector<ChunkIteratorPtr> iterators;
+            for (const auto& rowset : rowsets) {
+                guards.emplace_back(std::make_unique<RowsetReleaseGuard>(rowset));
+                auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
+                auto res = beta_rowset->get_segment_iterators2(schema, tablet.data_dir()->get_meta(), version,
+                                                               &group_stats);
+                if (!res.ok()) {
+                    return res.status();
+                }
+                std::vector<ChunkIteratorPtr> segment_iters;
+                for (auto& iter : res.value()) {
+                    if (iter != nullptr) {
+                        segment_iters.emplace_back(std::move(iter));
+                    }
+                }
+                if (segment_iters.empty()) {
+                    iterators.emplace_back(new_empty_iterator(schema, _chunk_size));
+                } else {
+                    iterators.emplace_back(new_union_iterator(std::move(segment_iters)));
+                }
+            }
+            auto iter = new_row_source_merge_iterator(iterators, &row_sources);
+            auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
+            auto chunk = ChunkHelper::new_chunk(schema, _chunk_size);
+            size_t group_rows = 0;
+            while (true) {
+                chunk->reset();
+                Status status = iter->get_next(chunk.get());
+                if (status.is_end_of_file()) {
+                    break;
+                } else if (!status.ok()) {
+                    return status;
+                }
+                ChunkHelper::padding_char_columns(char_field_indexes, schema, tablet_schema, chunk.get());
+                group_rows += chunk->num_rows();
+                if (writer->add_columns(*chunk, column_groups[i], false) != OLAP_SUCCESS) {
+                    return Status::InternalError("writer add_columns error.");
+                }
+            }
+            iter->close();
+            if (group_rows != total_rows) {
+                return Status::InternalError(
+                        Substitute("update compaction group $0 rows($1) != key rows($2)", i, group_rows, total_rows));
+            }
+            if (writer->flush_columns() != OLAP_SUCCESS) {
+                return Status::InternalError("writer flush_columns error.");
+            }
+        }
+        if (writer->final_flush() != OLAP_SUCCESS) {
+            LOG(WARNING) << "failed to flush rowset when merging rowsets of tablet " + tablet.full_name();
+            return Status::InternalError("failed to flush rowset when merging rowsets of tablet error.");
+        }
+        timer.stop();
+        StarRocksMetrics::instance()->update_compaction_deltas_total.increment(rowsets.size());
+        StarRocksMetrics::instance()->update_compaction_bytes_total.increment(total_input_size);
+        StarRocksMetrics::instance()->update_compaction_outputs_total.increment(1);
+        StarRocksMetrics::instance()->update_compaction_outputs_bytes_total.increment(writer->total_data_size());
+        LOG(INFO) << "vertical compaction merge finished. tablet:" << tablet.tablet_id()
+                  << " #key:" << column_groups[0].size() << " #group:" << column_groups.size() << " input("
+                  << "entry=" << rowsets.size() << " rows=" << stats.raw_rows_read
+                  << " del=" << stats.rows_del_vec_filtered
+                  << " bytes=" << PrettyPrinter::print(total_input_size, TUnit::BYTES) << ") output(rows=" << total_rows
+                  << " chunk=" << total_chunk
+                  << " bytes=" << PrettyPrinter::print(writer->total_data_size(), TUnit::BYTES)
+                  << ") duration: " << timer.elapsed_time() / 1000000 << "ms";
+        return Status::OK();
+    }
+
 private:
     size_t _chunk_size = 0;
     std::vector<std::unique_ptr<MergeEntry<T>>> _entries;
@@ -329,6 +479,26 @@ private:
     Heap _heap;
 };
 
+bool split_columns_into_groups(size_t num_columns, size_t num_key_columns,
+                               std::vector<std::vector<uint32_t>>* column_groups) {
+    const size_t max_columns_per_group = std::max(config::vertical_compaction_max_columns_per_group, 1);
+    if (!config::enable_vertical_compaction || num_columns <= num_key_columns + max_columns_per_group) {
+        return false;
+    }
+    column_groups->clear();
+    column_groups->emplace_back();
+    for (uint32_t i = 0; i < num_key_columns; i++) {
+        column_groups->back().push_back(i);
+    }
+    for (uint32_t i = num_key_columns; i < num_columns; i++) {
+        if ((i - num_key_columns) % max_columns_per_group == 0) {
+            column_groups->emplace_back();
+        }
+        column_groups->back().push_back(i);
+    }
+    return true;
+}
+
 Status compaction_merge_rowsets(Tablet& tablet, int64_t version, const vector<RowsetSharedPtr>& rowsets,
                                 RowsetWriter* writer, const MergeConfig& cfg) {
     Schema schema = ChunkHelper::convert_schema(tablet.tablet_schema());
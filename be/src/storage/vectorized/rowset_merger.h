@@ -18,6 +18,13 @@ struct MergeConfig {
 Status compaction_merge_rowsets(Tablet& tablet, int64_t version, const vector<RowsetSharedPtr>& rowsets,
                                 RowsetWriter* writer, const MergeConfig& cfg);
 
+// Split the columns into the groups of the vertical compaction if it's enabled and there are more value columns
+// than config::vertical_compaction_max_columns_per_group. The key columns are the first group, and the value
+// columns are split into the groups of at most the configured columns in order. Returns false if the columns
+// should be merged horizontally.
+bool split_columns_into_groups(size_t num_columns, size_t num_key_columns,
+                               std::vector<std::vector<uint32_t>>* column_groups);
+
 } // namespace vectorized
 
 } // namespace starrocks
@@ -0,0 +1,71 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/runtime_column_predicate.h"
+
+#include "common/object_pool.h"
+#include "storage/vectorized/column_or_predicate.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+bool RuntimeColumnPredicate::support_type(PrimitiveType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_DATE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::string RuntimeColumnPredicate::format_bound(PrimitiveType type, const Datum& value) {
+    switch (type) {
+    case TYPE_TINYINT:
+        return std::to_string(value.get_int8());
+    case TYPE_SMALLINT:
+        return std::to_string(value.get_int16());
+    case TYPE_INT:
+        return std::to_string(value.get_int32());
+    case TYPE_BIGINT:
+        return std::to_string(value.get_int64());
+    case TYPE_DATE:
+        return value.get_date().to_string();
+    default:
+        DCHECK(false) << "unsupported type of runtime predicate: " << type;
+        return "";
+    }
+}
+
+void RuntimeColumnPredicate::update(std::string bound) {
+    std::lock_guard<std::mutex> l(_mutex);
+    _bound = std::move(bound);
+    _version.fetch_add(1, std::memory_order_release);
+}
+
+const ColumnPredicate* RuntimeColumnPredicate::new_predicate(const TypeInfoPtr& type_info, ColumnId cid,
+                                                             ObjectPool* pool, int64_t* version) const {
+    std::string bound;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        *version = _version.load(std::memory_order_acquire);
+        if (*version == 0) {
+            return nullptr;
+        }
+        bound = _bound;
+    }
+    ColumnPredicate* pred = _is_upper_bound ? new_column_le_predicate(type_info, cid, bound)
+                                            : new_column_ge_predicate(type_info, cid, bound);
+    pool->add(pred);
+    if (!_keep_null) {
+        return pred;
+    }
+    auto* or_pred = pool->add(new ColumnOrPredicate(type_info, cid));
+    or_pred->add_child(pred);
+    or_pred->add_child(pool->add(new_column_null_predicate(type_info, cid, true)));
+    return or_pred;
+}
+
+} // namespace starrocks::vectorized
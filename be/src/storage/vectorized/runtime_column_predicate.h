@@ -0,0 +1,67 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "column/datum.h"
+#include "runtime/primitive_type.h"
+#include "storage/olap_common.h" // ColumnId
+#include "storage/types.h"
+
+namespace starrocks {
+class ObjectPool;
+} // namespace starrocks
+
+namespace starrocks::vectorized {
+
+class ColumnPredicate;
+
+// RuntimeColumnPredicate is a range predicate on a column whose bound is published by the consumer of the
+// scanned rows while the column is being scanned, e.g. the boundary of the heap of a top-n, the rows out of
+// the bound are never needed by the consumer.
+//
+// The bound only gets tighter, so the readers could apply any snapshot of it to the zone maps and the rows
+// read after the snapshot, and the readers check the version to pick up a tighter bound.
+class RuntimeColumnPredicate {
+public:
+    // If |is_upper_bound| is true, the rows <= the bound are kept, otherwise the rows >= the bound are kept.
+    // If |keep_null| is true, the null rows are kept too.
+    RuntimeColumnPredicate(std::string column_name, bool is_upper_bound, bool keep_null)
+            : _column_name(std::move(column_name)), _is_upper_bound(is_upper_bound), _keep_null(keep_null) {}
+
+    // Whether the bounds on the columns of |type| could be formatted by format_bound().
+    static bool support_type(PrimitiveType type);
+    // Format the non-null |value| of |type| as a bound.
+    static std::string format_bound(PrimitiveType type, const Datum& value);
+
+    const std::string& column_name() const { return _column_name; }
+
+    // Publish a new bound, which is formatted as the operand of the predicates parsed by PredicateParser.
+    // It must be at least as tight as the previous one.
+    void update(std::string bound);
+
+    // The version is increased by each update, 0 means that no bound has been published yet.
+    int64_t version() const { return _version.load(std::memory_order_acquire); }
+
+    // Create the predicate of the current bound on the column |cid| of |type_info|, it's owned by |pool|.
+    // Return nullptr if no bound has been published. The version of the bound is returned by |version|.
+    const ColumnPredicate* new_predicate(const TypeInfoPtr& type_info, ColumnId cid, ObjectPool* pool,
+                                         int64_t* version) const;
+
+private:
+    const std::string _column_name;
+    const bool _is_upper_bound;
+    const bool _keep_null;
+
+    mutable std::mutex _mutex;
+    std::string _bound;
+    std::atomic<int64_t> _version{0};
+};
+
+using RuntimeColumnPredicates = std::vector<const RuntimeColumnPredicate*>;
+
+} // namespace starrocks::vectorized
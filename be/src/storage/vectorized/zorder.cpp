@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/zorder.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "column/column.h"
+
+namespace starrocks::vectorized {
+
+// The dense ranks of the values of |column|, the nulls first.
+static void column_ranks(const Column& column, size_t num_rows, std::vector<uint64_t>* ranks) {
+    std::vector<uint32_t> rows(num_rows);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(),
+                     [&](uint32_t lhs, uint32_t rhs) { return column.compare_at(lhs, rhs, column, -1) < 0; });
+    ranks->resize(num_rows);
+    uint64_t rank = 0;
+    for (size_t i = 0; i < num_rows; i++) {
+        if (i > 0 && column.compare_at(rows[i - 1], rows[i], column, -1) != 0) {
+            rank++;
+        }
+        (*ranks)[rows[i]] = rank;
+    }
+}
+
+void zorder_permutation(const std::vector<const Column*>& columns, size_t num_rows, std::vector<uint32_t>* order) {
+    order->resize(num_rows);
+    std::iota(order->begin(), order->end(), 0);
+    size_t num_dims = std::min<size_t>(columns.size(), 64);
+    if (num_dims == 0 || num_rows <= 1) {
+        return;
+    }
+    const size_t bits = 64 / num_dims;
+    const uint64_t max_value = bits >= 64 ? ~0ULL : (1ULL << bits) - 1;
+    std::vector<uint64_t> zvalues(num_rows, 0);
+    std::vector<uint64_t> ranks;
+    for (size_t d = 0; d < num_dims; d++) {
+        column_ranks(*columns[d], num_rows, &ranks);
+        uint64_t max_rank = *std::max_element(ranks.begin(), ranks.end());
+        for (size_t i = 0; i < num_rows; i++) {
+            uint64_t value = ranks[i];
+            if (max_rank > max_value) {
+                value = static_cast<uint64_t>(static_cast<unsigned __int128>(value) * max_value / max_rank);
+            }
+            // The bit b of the dimension d is the bit (num_dims * b + num_dims - 1 - d) of the Z-order value.
+            uint64_t z = 0;
+            for (size_t b = 0; b < bits; b++) {
+                z |= ((value >> b) & 1) << (num_dims * b + num_dims - 1 - d);
+            }
+            zvalues[i] |= z;
+        }
+    }
+    std::stable_sort(order->begin(), order->end(),
+                     [&](uint32_t lhs, uint32_t rhs) { return zvalues[lhs] < zvalues[rhs]; });
+}
+
+} // namespace starrocks::vectorized
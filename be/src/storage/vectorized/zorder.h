@@ -0,0 +1,19 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starrocks::vectorized {
+
+class Column;
+
+// Set |order| to the positions of the |num_rows| rows of |columns| sorted by their Z-order values, i.e. the bits
+// of the ranks of the values of the columns interleaved, so the rows of a range of the order are close on all the
+// columns. The ranks of a column are scaled down if they don't fit in its bits, 64 / columns.size() bits, and
+// only the first 64 columns are used. The rows of the same Z-order values are in their positions.
+void zorder_permutation(const std::vector<const Column*>& columns, size_t num_rows, std::vector<uint32_t>* order);
+
+} // namespace starrocks::vectorized
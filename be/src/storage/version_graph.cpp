@@ -236,6 +236,7 @@ std::vector<TimestampedVersionSharedPtr>& TimestampedVersionPathContainer::times
 }
 
 void VersionGraph::construct_version_graph(const std::vector<RowsetMetaSharedPtr>& rs_metas, int64_t* max_version) {
+    _invalidate_cached_path();
     if (rs_metas.empty()) {
         VLOG(3) << "there is no version in the header.";
         return;
@@ -304,6 +305,7 @@ void VersionGraph::add_version_to_graph(const Version& version) {
 
     // We add reverse edge(from end_version to start_version) to graph
     _version_graph[end_vertex_index].edges.push_front(start_vertex_index);
+    _invalidate_cached_path();
 }
 
 OLAPStatus VersionGraph::delete_version_from_graph(const Version& version) {
@@ -338,6 +340,7 @@ OLAPStatus VersionGraph::delete_version_from_graph(const Version& version) {
         }
         end_edges_iter++;
     }
+    _invalidate_cached_path();
 
     return OLAP_SUCCESS;
 }
@@ -353,8 +356,41 @@ void VersionGraph::_add_vertex_to_graph(int64_t vertex_value) {
     _vertex_index_map[vertex_value] = _version_graph.size() - 1;
 }
 
+void VersionGraph::_invalidate_cached_path() {
+    std::lock_guard l(_cached_path_lock);
+    _has_cached_path = false;
+    _cached_path.clear();
+}
+
 OLAPStatus VersionGraph::capture_consistent_versions(const Version& spec_version,
                                                      std::vector<Version>* version_path) const {
+    {
+        std::lock_guard l(_cached_path_lock);
+        if (_has_cached_path && _cached_spec_version == spec_version) {
+            if (version_path != nullptr) {
+                version_path->insert(version_path->end(), _cached_path.begin(), _cached_path.end());
+            }
+            return OLAP_SUCCESS;
+        }
+    }
+
+    std::vector<Version> path;
+    OLAPStatus status = _find_consistent_versions(spec_version, &path);
+    if (status != OLAP_SUCCESS) {
+        return status;
+    }
+    if (version_path != nullptr) {
+        version_path->insert(version_path->end(), path.begin(), path.end());
+    }
+    std::lock_guard l(_cached_path_lock);
+    _has_cached_path = true;
+    _cached_spec_version = spec_version;
+    _cached_path = std::move(path);
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus VersionGraph::_find_consistent_versions(const Version& spec_version,
+                                                   std::vector<Version>* version_path) const {
     if (spec_version.first > spec_version.second) {
         LOG(WARNING) << "invalid specfied version. "
                      << "spec_version=" << spec_version.first << "-" << spec_version.second;
@@ -375,13 +411,13 @@ OLAPStatus VersionGraph::capture_consistent_versions(const Version& spec_version
     // -1 is valid vertex index.
     int64_t end_vertex_index = -1;
 
-    for (size_t i = 0; i < _version_graph.size(); ++i) {
-        if (_version_graph[i].value == start_vertex_value) {
-            start_vertex_index = i;
-        }
-        if (_version_graph[i].value == end_vertex_value) {
-            end_vertex_index = i;
-        }
+    auto start_iter = _vertex_index_map.find(start_vertex_value);
+    if (start_iter != _vertex_index_map.end()) {
+        start_vertex_index = start_iter->second;
+    }
+    auto end_iter = _vertex_index_map.find(end_vertex_value);
+    if (end_iter != _vertex_index_map.end()) {
+        end_vertex_index = end_iter->second;
     }
 
     if (start_vertex_index < 0 || end_vertex_index < 0) {
@@ -26,6 +26,9 @@
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 
+#include <mutex>
+#include <vector>
+
 #include "storage/olap_common.h"
 #include "storage/olap_define.h"
 #include "storage/rowset/rowset_meta.h"
@@ -50,12 +53,20 @@ public:
     OLAPStatus delete_version_from_graph(const Version& version);
     /// Given a spec_version, this method can find a version path which is the shortest path
     /// in the graph. The version paths are added to version_path as return info.
+    /// The path of the last spec_version found is cached until the graph is changed, as the versions
+    /// captured by the queries are mostly the same, i.e. [0, max_version].
     OLAPStatus capture_consistent_versions(const Version& spec_version, std::vector<Version>* version_path) const;
 
 private:
     /// Private method add a version to graph.
     void _add_vertex_to_graph(int64_t vertex_value);
 
+    /// Find the shortest path of spec_version in the graph.
+    OLAPStatus _find_consistent_versions(const Version& spec_version, std::vector<Version>* version_path) const;
+
+    /// Drop the cached path once the graph is changed.
+    void _invalidate_cached_path();
+
     // OLAP version contains two parts, [start_version, end_version]. In order
     // to construct graph, the OLAP version has two corresponding vertex, one
     // vertex's value is version.start_version, the other is
@@ -66,6 +77,13 @@ private:
     // vertex value --> vertex_index of _version_graph
     // It is easy to find vertex index according to vertex value.
     std::unordered_map<int64_t, int64_t> _vertex_index_map;
+
+    // The path of the last spec_version captured, the captures are under the shared header lock of the tablet
+    // so the cache is guarded by its own lock.
+    mutable std::mutex _cached_path_lock;
+    mutable bool _has_cached_path = false;
+    mutable Version _cached_spec_version;
+    mutable std::vector<Version> _cached_path;
 };
 
 /// TimestampedVersion class which is implemented to maintain multi-version path of rowsets.
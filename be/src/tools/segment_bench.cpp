@@ -0,0 +1,415 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "common/status.h"
+#include "gen_cpp/InternalService_types.h"
+#include "gutil/strings/split.h"
+#include "gutil/strings/strip.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/mem_tracker.h"
+#include "storage/data_dir.h"
+#include "storage/fs/fs_util.h"
+#include "storage/olap_common.h"
+#include "storage/olap_define.h"
+#include "storage/options.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/beta_rowset.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/vectorized/segment_options.h"
+#include "storage/tablet_meta.h"
+#include "storage/tablet_meta_manager.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/predicate_parser.h"
+#include "util/file_utils.h"
+#include "util/path_util.h"
+#include "util/stopwatch.hpp"
+
+// The flags shared with meta_tool, both tools are built into starrocks_be.
+DECLARE_string(root_path);
+DECLARE_int64(tablet_id);
+DECLARE_int32(schema_hash);
+DECLARE_string(pb_meta_path);
+
+DEFINE_string(segment_files, "", "comma separated segment files to scan, their schema is read from --pb_meta_path");
+DEFINE_string(columns, "", "comma separated columns to read, all the columns if empty");
+DEFINE_string(predicates, "",
+              "semicolon separated predicates pushed down to the segments, e.g. 'k1>=10;k2 in a,b;k3 is not null'");
+DEFINE_bool(use_page_cache, false, "whether to read the pages through the storage page cache");
+DEFINE_int64(page_cache_mb, 1024, "capacity of the storage page cache in MB, used with --use_page_cache");
+DEFINE_string(late_materialization, "default", "valid value: on, off, default (follow be.conf)");
+DEFINE_int32(threads, 1, "threads to scan the segments, which are shared round robin by the threads");
+DEFINE_int32(iterations, 3, "times to scan all the segments");
+DEFINE_int32(chunk_size, 4096, "rows of a chunk read by the segment iterators");
+
+namespace starrocks::vectorized {
+
+using segment_v2::Segment;
+using SegmentSharedPtr = std::shared_ptr<Segment>;
+
+static std::string get_usage(const std::string& progname) {
+    std::stringstream ss;
+    ss << progname << " is the StarRocks BE segment scan benchmark tool.\n";
+    ss << "Stop BE first or use a copy of the storage path before use this tool.\n";
+    ss << "Usage:\n";
+    ss << "./segment_bench --root_path=/path/to/storage/path --tablet_id=tabletid --schema_hash=schemahash "
+          "[options]\n";
+    ss << "./segment_bench --pb_meta_path=path --segment_files=/path/to/segment/file[,...] [options]\n";
+    ss << "Options:\n";
+    ss << "  --columns=k1,v1 --predicates='k1>=10;k2 in a,b' --use_page_cache=true --page_cache_mb=1024\n";
+    ss << "  --late_materialization=on|off|default --threads=1 --iterations=3 --chunk_size=4096\n";
+    return ss.str();
+}
+
+// The tablet meta and the segments to scan.
+struct ScanTarget {
+    TabletMetaSharedPtr tablet_meta;
+    std::vector<std::string> segment_files;
+    std::vector<SegmentSharedPtr> segments;
+};
+
+static Status init_data_dir(const std::string& dir, std::unique_ptr<DataDir>* ret) {
+    std::string root_path;
+    RETURN_IF_ERROR(FileUtils::canonicalize(dir, &root_path));
+    StorePath path;
+    if (parse_root_path(root_path, &path) != OLAP_SUCCESS) {
+        return Status::InvalidArgument(strings::Substitute("parse root path failed: $0", root_path));
+    }
+    auto data_dir = std::make_unique<DataDir>(path.path, path.capacity_bytes, path.storage_medium);
+    RETURN_IF_ERROR(data_dir->init(true));
+    *ret = std::move(data_dir);
+    return Status::OK();
+}
+
+// Collects the segment files of the visible rowsets of the tablet in the storage path.
+static Status load_tablet(MemTracker* mem_tracker, ScanTarget* target) {
+    std::unique_ptr<DataDir> data_dir;
+    RETURN_IF_ERROR(init_data_dir(FLAGS_root_path, &data_dir));
+    target->tablet_meta = std::make_shared<TabletMeta>(mem_tracker);
+    RETURN_IF_ERROR(TabletMetaManager::get_tablet_meta(data_dir.get(), FLAGS_tablet_id, FLAGS_schema_hash,
+                                                       target->tablet_meta));
+    std::string tablet_path = data_dir->path() + DATA_PREFIX;
+    tablet_path = path_util::join_path_segments(tablet_path, std::to_string(target->tablet_meta->shard_id()));
+    tablet_path = path_util::join_path_segments(tablet_path, std::to_string(FLAGS_tablet_id));
+    tablet_path = path_util::join_path_segments(tablet_path, std::to_string(FLAGS_schema_hash));
+    for (const auto& rs_meta : target->tablet_meta->all_rs_metas()) {
+        if (rs_meta->rowset_type() != BETA_ROWSET) {
+            return Status::NotSupported(
+                    strings::Substitute("rowset $0 is not a beta rowset", rs_meta->rowset_id().to_string()));
+        }
+        for (int64_t i = 0; i < rs_meta->num_segments(); i++) {
+            target->segment_files.emplace_back(
+                    BetaRowset::segment_file_path(tablet_path, rs_meta->rowset_id(), static_cast<int>(i)));
+        }
+    }
+    return Status::OK();
+}
+
+static Status load_segment_files(MemTracker* mem_tracker, ScanTarget* target) {
+    target->tablet_meta = std::make_shared<TabletMeta>(mem_tracker);
+    if (target->tablet_meta->create_from_file(FLAGS_pb_meta_path) != OLAP_SUCCESS) {
+        return Status::InvalidArgument(strings::Substitute("load pb meta file $0 failed", FLAGS_pb_meta_path));
+    }
+    target->segment_files = strings::Split(FLAGS_segment_files, ",", strings::SkipWhitespace());
+    return Status::OK();
+}
+
+// Parses the predicate like 'k1>=10', 'k1 in 1,2,3', 'k1 not in 1,2' or 'k1 is null' into the condition which the
+// scan nodes push down to the storage.
+static Status parse_condition(const std::string& text, TCondition* condition) {
+    std::string column;
+    std::string op;
+    std::string values;
+    // the operators of the words first, then the ones of the symbols, '<=' is checked before '<' and so on.
+    static const std::vector<std::pair<std::string, std::string>> kOperators = {
+            {" not in ", "!*="}, {" in ", "*="}, {" is ", "is"}, {"!=", "!="}, {"<=", "<="},
+            {">=", ">="},        {"=", "="},     {"<", "<<"},   {">", ">>"}};
+    for (const auto& [token, condition_op] : kOperators) {
+        size_t pos = text.find(token);
+        if (pos == std::string::npos) {
+            continue;
+        }
+        column = text.substr(0, pos);
+        values = text.substr(pos + token.size());
+        op = condition_op;
+        break;
+    }
+    StripWhiteSpace(&column);
+    StripWhiteSpace(&values);
+    if (op.empty() || column.empty() || values.empty()) {
+        return Status::InvalidArgument(strings::Substitute("invalid predicate: $0", text));
+    }
+    condition->__set_column_name(column);
+    condition->__set_condition_op(op);
+    if (op == "*=" || op == "!*=") {
+        std::vector<std::string> in_values = strings::Split(values, ",", strings::SkipWhitespace());
+        condition->__set_condition_values(in_values);
+    } else {
+        condition->__set_condition_values({values});
+    }
+    return Status::OK();
+}
+
+static Status parse_predicates(const TabletSchema& tablet_schema, ObjectPool* pool,
+                               std::unordered_map<ColumnId, PredicateList>* predicates) {
+    PredicateParser parser(tablet_schema);
+    std::vector<std::string> texts = strings::Split(FLAGS_predicates, ";", strings::SkipWhitespace());
+    for (const auto& text : texts) {
+        TCondition condition;
+        RETURN_IF_ERROR(parse_condition(text, &condition));
+        if (static_cast<int32_t>(tablet_schema.field_index(condition.column_name)) < 0) {
+            return Status::InvalidArgument(strings::Substitute("unknown column of predicate: $0", text));
+        }
+        ColumnPredicate* predicate = parser.parse(condition);
+        if (predicate == nullptr) {
+            return Status::InvalidArgument(strings::Substitute("can not push down predicate: $0", text));
+        }
+        pool->add(predicate);
+        (*predicates)[predicate->column_id()].emplace_back(predicate);
+    }
+    return Status::OK();
+}
+
+// The projected columns and the columns of the predicates, which the segment iterators read too.
+static Status parse_columns(const TabletSchema& tablet_schema,
+                            const std::unordered_map<ColumnId, PredicateList>& predicates,
+                            std::vector<ColumnId>* column_ids) {
+    std::set<ColumnId> cids;
+    if (FLAGS_columns.empty()) {
+        for (ColumnId cid = 0; cid < tablet_schema.num_columns(); cid++) {
+            cids.insert(cid);
+        }
+    }
+    std::vector<std::string> names = strings::Split(FLAGS_columns, ",", strings::SkipWhitespace());
+    for (const auto& name : names) {
+        auto cid = static_cast<int32_t>(tablet_schema.field_index(name));
+        if (cid < 0) {
+            return Status::InvalidArgument(strings::Substitute("unknown column: $0", name));
+        }
+        cids.insert(cid);
+    }
+    for (const auto& [cid, _] : predicates) {
+        cids.insert(cid);
+    }
+    column_ids->assign(cids.begin(), cids.end());
+    return Status::OK();
+}
+
+static void merge_stats(const OlapReaderStatistics& src, OlapReaderStatistics* dst) {
+    dst->io_ns += src.io_ns;
+    dst->compressed_bytes_read += src.compressed_bytes_read;
+    dst->decompress_ns += src.decompress_ns;
+    dst->uncompressed_bytes_read += src.uncompressed_bytes_read;
+    dst->bytes_read += src.bytes_read;
+    dst->block_load_ns += src.block_load_ns;
+    dst->blocks_load += src.blocks_load;
+    dst->block_seek_num += src.block_seek_num;
+    dst->block_seek_ns += src.block_seek_ns;
+    dst->decode_dict_ns += src.decode_dict_ns;
+    dst->late_materialize_ns += src.late_materialize_ns;
+    dst->raw_rows_read += src.raw_rows_read;
+    dst->rows_vec_cond_filtered += src.rows_vec_cond_filtered;
+    dst->vec_cond_ns += src.vec_cond_ns;
+    dst->vec_cond_evaluate_ns += src.vec_cond_evaluate_ns;
+    dst->vec_cond_chunk_copy_ns += src.vec_cond_chunk_copy_ns;
+    dst->segment_init_ns += src.segment_init_ns;
+    dst->segment_create_chunk_ns += src.segment_create_chunk_ns;
+    dst->rows_key_range_filtered += src.rows_key_range_filtered;
+    dst->rows_stats_filtered += src.rows_stats_filtered;
+    dst->rows_bf_filtered += src.rows_bf_filtered;
+    dst->index_load_ns += src.index_load_ns;
+    dst->total_pages_num += src.total_pages_num;
+    dst->cached_pages_num += src.cached_pages_num;
+    dst->compressed_cached_pages_num += src.compressed_cached_pages_num;
+    dst->rows_bitmap_index_filtered += src.rows_bitmap_index_filtered;
+    dst->bitmap_index_filter_timer += src.bitmap_index_filter_timer;
+}
+
+// Scans the segments of |segment_indexes| to the end, the rows returned are added to |num_rows|.
+static Status scan_segments(const ScanTarget& target, const Schema& schema,
+                            const std::unordered_map<ColumnId, PredicateList>& predicates,
+                            const std::vector<size_t>& segment_indexes, OlapReaderStatistics* stats,
+                            int64_t* num_rows) {
+    for (size_t index : segment_indexes) {
+        SegmentReadOptions opts;
+        opts.block_mgr = fs::fs_util::block_manager();
+        opts.stats = stats;
+        opts.predicates = predicates;
+        opts.use_page_cache = FLAGS_use_page_cache;
+        opts.chunk_size = FLAGS_chunk_size;
+        auto res = target.segments[index]->new_iterator(schema, opts);
+        if (res.status().is_end_of_file()) {
+            // all the rows are filtered by the zone maps or the bloom filters.
+            continue;
+        }
+        RETURN_IF_ERROR(res.status());
+        ChunkIteratorPtr iter = std::move(res).value();
+        ChunkPtr chunk = ChunkHelper::new_chunk(iter->schema(), FLAGS_chunk_size);
+        while (true) {
+            chunk->reset();
+            Status st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(st);
+            *num_rows += chunk->num_rows();
+        }
+        iter->close();
+    }
+    return Status::OK();
+}
+
+static double to_ms(int64_t ns) {
+    return ns / 1000000.0;
+}
+
+static void print_report(int iteration, int64_t wall_ns, int64_t num_rows, const OlapReaderStatistics& stats) {
+    double seconds = std::max<double>(wall_ns, 1) / 1e9;
+    std::cout << strings::Substitute("iteration $0: $1 ms, $2 rows, $3 rows/s, $4 MB/s", iteration, to_ms(wall_ns),
+                                     num_rows, static_cast<int64_t>(num_rows / seconds),
+                                     static_cast<int64_t>(stats.bytes_read / seconds / 1024 / 1024))
+              << std::endl;
+    std::cout << strings::Substitute("  rows: raw=$0 vec_cond_filtered=$1 key_range_filtered=$2 stats_filtered=$3 "
+                                     "bf_filtered=$4 bitmap_index_filtered=$5",
+                                     stats.raw_rows_read, stats.rows_vec_cond_filtered, stats.rows_key_range_filtered,
+                                     stats.rows_stats_filtered, stats.rows_bf_filtered,
+                                     stats.rows_bitmap_index_filtered)
+              << std::endl;
+    std::cout << strings::Substitute("  pages: total=$0 cached=$1 compressed_cached=$2 blocks_load=$3 seeks=$4",
+                                     stats.total_pages_num, stats.cached_pages_num, stats.compressed_cached_pages_num,
+                                     stats.blocks_load, stats.block_seek_num)
+              << std::endl;
+    std::cout << strings::Substitute("  bytes: compressed=$0 uncompressed=$1 in_memory=$2", stats.compressed_bytes_read,
+                                     stats.uncompressed_bytes_read, stats.bytes_read)
+              << std::endl;
+    // the timers are summed by the threads.
+    std::cout << strings::Substitute("  stages(ms): segment_init=$0 index_load=$1 bitmap_index_filter=$2 "
+                                     "block_seek=$3 block_load=$4 (io=$5 decompress=$6) vec_cond=$7 (evaluate=$8 "
+                                     "chunk_copy=$9)",
+                                     to_ms(stats.segment_init_ns), to_ms(stats.index_load_ns),
+                                     to_ms(stats.bitmap_index_filter_timer), to_ms(stats.block_seek_ns),
+                                     to_ms(stats.block_load_ns), to_ms(stats.io_ns), to_ms(stats.decompress_ns),
+                                     to_ms(stats.vec_cond_ns), to_ms(stats.vec_cond_evaluate_ns),
+                                     to_ms(stats.vec_cond_chunk_copy_ns))
+              << strings::Substitute(" late_materialize=$0 decode_dict=$1 create_chunk=$2",
+                                     to_ms(stats.late_materialize_ns), to_ms(stats.decode_dict_ns),
+                                     to_ms(stats.segment_create_chunk_ns))
+              << std::endl;
+}
+
+static Status run_bench() {
+    auto mem_tracker = std::make_unique<MemTracker>();
+    ScanTarget target;
+    if (!FLAGS_segment_files.empty()) {
+        RETURN_IF_ERROR(load_segment_files(mem_tracker.get(), &target));
+    } else if (!FLAGS_root_path.empty() && FLAGS_tablet_id != 0 && FLAGS_schema_hash != 0) {
+        RETURN_IF_ERROR(load_tablet(mem_tracker.get(), &target));
+    } else {
+        return Status::InvalidArgument(
+                "either --segment_files or --root_path, --tablet_id and --schema_hash is needed");
+    }
+    if (FLAGS_threads <= 0 || FLAGS_iterations <= 0 || FLAGS_chunk_size <= 0) {
+        return Status::InvalidArgument("--threads, --iterations and --chunk_size should be positive");
+    }
+
+    if (FLAGS_late_materialization == "on") {
+        config::late_materialization_ratio = 1000;
+        config::metric_late_materialization_ratio = 1000;
+    } else if (FLAGS_late_materialization == "off") {
+        config::late_materialization_ratio = 0;
+        config::metric_late_materialization_ratio = 0;
+    } else if (FLAGS_late_materialization != "default") {
+        return Status::InvalidArgument(
+                strings::Substitute("invalid --late_materialization: $0", FLAGS_late_materialization));
+    }
+    // the page readers look up the cache even if it is not used by the scans.
+    StoragePageCache::create_global_cache(mem_tracker.get(), (FLAGS_use_page_cache ? FLAGS_page_cache_mb : 1) << 20);
+
+    const TabletSchema& tablet_schema = target.tablet_meta->tablet_schema();
+    if (tablet_schema.keys_type() != DUP_KEYS) {
+        // the rows of the aggregate, unique and primary keys are not merged, nor the deletes are applied.
+        std::cout << "WARNING: the rows of the segments are scanned without merging" << std::endl;
+    }
+    ObjectPool pool;
+    std::unordered_map<ColumnId, PredicateList> predicates;
+    RETURN_IF_ERROR(parse_predicates(tablet_schema, &pool, &predicates));
+    std::vector<ColumnId> column_ids;
+    RETURN_IF_ERROR(parse_columns(tablet_schema, predicates, &column_ids));
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, column_ids);
+
+    int64_t total_rows = 0;
+    for (uint32_t i = 0; i < target.segment_files.size(); i++) {
+        SegmentSharedPtr segment;
+        RETURN_IF_ERROR(Segment::open(mem_tracker.get(), fs::fs_util::block_manager(), target.segment_files[i], i,
+                                      &tablet_schema, &segment));
+        total_rows += segment->num_rows();
+        target.segments.emplace_back(std::move(segment));
+    }
+    std::cout << strings::Substitute("segments: $0, rows: $1, columns: $2, predicates: $3, threads: $4",
+                                     target.segments.size(), total_rows, schema.num_fields(), predicates.size(),
+                                     FLAGS_threads)
+              << std::endl;
+
+    std::vector<std::vector<size_t>> thread_segments(FLAGS_threads);
+    for (size_t i = 0; i < target.segments.size(); i++) {
+        thread_segments[i % FLAGS_threads].emplace_back(i);
+    }
+    for (int iteration = 0; iteration < FLAGS_iterations; iteration++) {
+        std::vector<OlapReaderStatistics> thread_stats(FLAGS_threads);
+        std::vector<int64_t> thread_rows(FLAGS_threads, 0);
+        std::vector<Status> thread_status(FLAGS_threads);
+        MonotonicStopWatch watch;
+        watch.start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < FLAGS_threads; t++) {
+            threads.emplace_back([&, t]() {
+                thread_status[t] = scan_segments(target, schema, predicates, thread_segments[t], &thread_stats[t],
+                                                 &thread_rows[t]);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        int64_t wall_ns = watch.elapsed_time();
+
+        OlapReaderStatistics stats;
+        int64_t num_rows = 0;
+        for (int t = 0; t < FLAGS_threads; t++) {
+            RETURN_IF_ERROR(thread_status[t]);
+            merge_stats(thread_stats[t], &stats);
+            num_rows += thread_rows[t];
+        }
+        print_report(iteration, wall_ns, num_rows, stats);
+    }
+    StoragePageCache::release_global_cache();
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
+
+int segment_bench_main(int argc, char** argv) {
+    std::string usage = starrocks::vectorized::get_usage(argv[0]);
+    gflags::SetUsageMessage(usage);
+    google::ParseCommandLineFlags(&argc, &argv, true);
+
+    starrocks::Status st = starrocks::vectorized::run_bench();
+    if (!st.ok()) {
+        std::cout << "segment bench failed: " << st.to_string() << "\n" << usage << std::endl;
+        return -1;
+    }
+    gflags::ShutDownCommandLineFlags();
+    return 0;
+}
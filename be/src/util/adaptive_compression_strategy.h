@@ -0,0 +1,68 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace starrocks {
+
+// AdaptiveCompressionStrategy decides whether to compress the data sent to the network. It measures the time
+// to compress a byte, the bytes saved by the compression and the time to transmit a byte on the way, and turns
+// the compression on only if the time saved on the wire exceeds the time to compress, e.g. it's on for a 1G link
+// and off for a 10G one if the data doesn't compress well or is expensive to compress.
+//
+// While the compression is off, one of |probe_interval| requests is still compressed to follow the changes of
+// the data and the link.
+//
+// Not thread-safe.
+class AdaptiveCompressionStrategy {
+public:
+    explicit AdaptiveCompressionStrategy(int probe_interval)
+            : _probe_interval(probe_interval > 0 ? probe_interval : 1) {}
+
+    // Whether to compress the data sent to |num_receivers| receivers, each one of which saves the bytes.
+    bool should_compress(int num_receivers) {
+        if (_compress_ns_per_byte < 0 || _transmit_ns_per_byte < 0) {
+            // compress until both of the costs are measured
+            return true;
+        }
+        if (_compress_ns_per_byte < _saved_ratio * _transmit_ns_per_byte * num_receivers) {
+            _num_skipped = 0;
+            return true;
+        }
+        return ++_num_skipped % _probe_interval == 0;
+    }
+
+    // |uncompressed_bytes| are compressed to |compressed_bytes| in |compress_ns|.
+    void update_compression(size_t uncompressed_bytes, size_t compressed_bytes, int64_t compress_ns) {
+        if (uncompressed_bytes == 0) {
+            return;
+        }
+        double saved_ratio = compressed_bytes < uncompressed_bytes
+                                     ? static_cast<double>(uncompressed_bytes - compressed_bytes) / uncompressed_bytes
+                                     : 0;
+        _update(&_saved_ratio, saved_ratio);
+        _update(&_compress_ns_per_byte, static_cast<double>(compress_ns) / uncompressed_bytes);
+    }
+
+    // |bytes| are transmitted in |transmit_ns|.
+    void update_transmission(size_t bytes, int64_t transmit_ns) {
+        if (bytes == 0) {
+            return;
+        }
+        _update(&_transmit_ns_per_byte, static_cast<double>(transmit_ns) / bytes);
+    }
+
+private:
+    // the moving average of the recent measurements
+    static void _update(double* avg, double value) { *avg = *avg < 0 ? value : *avg * 0.8 + value * 0.2; }
+
+    int _probe_interval;
+    int64_t _num_skipped = 0;
+    double _compress_ns_per_byte = -1;
+    double _transmit_ns_per_byte = -1;
+    double _saved_ratio = -1;
+};
+
+} // namespace starrocks
@@ -0,0 +1,176 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/arrow/chunk.h"
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/large_int_value.h"
+#include "runtime/vectorized/time_types.h"
+#include "util/arrow/row_batch.h"
+#include "util/arrow/utils.h"
+
+namespace starrocks {
+
+using vectorized::Column;
+using vectorized::ColumnPtr;
+
+Status convert_to_arrow_schema(const std::vector<TypeDescriptor>& types, const std::vector<std::string>& names,
+                               std::shared_ptr<arrow::Schema>* result) {
+    DCHECK_EQ(types.size(), names.size());
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    for (size_t i = 0; i < types.size(); ++i) {
+        std::shared_ptr<arrow::DataType> type;
+        RETURN_IF_ERROR(convert_to_arrow_type(types[i], &type));
+        fields.push_back(arrow::field(names[i], type, true));
+    }
+    *result = arrow::schema(std::move(fields));
+    return Status::OK();
+}
+
+// The numbers are appended to the builder in bulk, |valid| is nullptr if all of them are valid.
+template <PrimitiveType PT, typename BuilderType>
+static arrow::Status append_numbers(const Column& data_column, const uint8_t* valid, BuilderType* builder) {
+    const auto& data = down_cast<const vectorized::RunTimeColumnType<PT>&>(data_column).get_data();
+    return builder->AppendValues(data.data(), data.size(), valid);
+}
+
+// The layout of DecimalV2Value is the same as arrow::Decimal128 on little-endian machines.
+static arrow::Status append_decimals(const Column& data_column, const uint8_t* valid,
+                                     arrow::Decimal128Builder* builder) {
+    const auto& data = down_cast<const vectorized::DecimalColumn&>(data_column).get_data();
+    static_assert(sizeof(DecimalV2Value) == arrow::Decimal128Type::kByteWidth);
+    return builder->AppendValues(reinterpret_cast<const uint8_t*>(data.data()), data.size(), valid);
+}
+
+// The values are appended to the builder as strings formatted by |to_string|, which writes the value of |row|
+// to the buffer and returns the length written.
+template <typename ToString>
+static arrow::Status append_strings(size_t num_rows, const uint8_t* valid, arrow::StringBuilder* builder,
+                                    ToString to_string) {
+    char buf[64];
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (valid != nullptr && !valid[i]) {
+            ARROW_RETURN_NOT_OK(builder->AppendNull());
+        } else {
+            ARROW_RETURN_NOT_OK(builder->Append(buf, to_string(i, buf)));
+        }
+    }
+    return arrow::Status::OK();
+}
+
+static Status convert_to_arrow_array(const ColumnPtr& column, const TypeDescriptor& type,
+                                     const std::shared_ptr<arrow::DataType>& arrow_type, arrow::MemoryPool* pool,
+                                     std::shared_ptr<arrow::Array>* result) {
+    const Column* data_column = column.get();
+    const size_t num_rows = column->size();
+    std::vector<uint8_t> valid;
+    if (column->is_nullable()) {
+        const auto* nullable_column = down_cast<const vectorized::NullableColumn*>(column.get());
+        data_column = nullable_column->data_column().get();
+        if (nullable_column->has_null()) {
+            const auto& nulls = nullable_column->null_column()->get_data();
+            valid.resize(num_rows);
+            for (size_t i = 0; i < num_rows; ++i) {
+                valid[i] = !nulls[i];
+            }
+        }
+    }
+    const uint8_t* valid_bytes = valid.empty() ? nullptr : valid.data();
+
+    std::unique_ptr<arrow::ArrayBuilder> builder;
+    RETURN_IF_ERROR(to_status(arrow::MakeBuilder(pool, arrow_type, &builder)));
+    RETURN_IF_ERROR(to_status(builder->Reserve(num_rows)));
+    arrow::Status st;
+    switch (type.type) {
+#define APPEND_NUMBERS(PT, BUILDER)                                                                    \
+    case PT:                                                                                           \
+        st = append_numbers<PT>(*data_column, valid_bytes, down_cast<arrow::BUILDER*>(builder.get())); \
+        break;
+        APPEND_NUMBERS(TYPE_TINYINT, Int8Builder)
+        APPEND_NUMBERS(TYPE_SMALLINT, Int16Builder)
+        APPEND_NUMBERS(TYPE_INT, Int32Builder)
+        APPEND_NUMBERS(TYPE_BIGINT, Int64Builder)
+        APPEND_NUMBERS(TYPE_FLOAT, FloatBuilder)
+        APPEND_NUMBERS(TYPE_DOUBLE, DoubleBuilder)
+        APPEND_NUMBERS(TYPE_TIME, DoubleBuilder)
+#undef APPEND_NUMBERS
+    case TYPE_DECIMALV2:
+        st = append_decimals(*data_column, valid_bytes, down_cast<arrow::Decimal128Builder*>(builder.get()));
+        break;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR: {
+        const auto& binary_column = down_cast<const vectorized::BinaryColumn&>(*data_column);
+        auto* string_builder = down_cast<arrow::StringBuilder*>(builder.get());
+        st = string_builder->ReserveData(binary_column.get_bytes().size());
+        for (size_t i = 0; st.ok() && i < num_rows; ++i) {
+            if (valid_bytes != nullptr && !valid_bytes[i]) {
+                st = string_builder->AppendNull();
+            } else {
+                Slice slice = binary_column.get_slice(i);
+                st = string_builder->Append(slice.data, slice.size);
+            }
+        }
+        break;
+    }
+    case TYPE_DATE: {
+        const auto& data = down_cast<const vectorized::DateColumn&>(*data_column).get_data();
+        st = append_strings(num_rows, valid_bytes, down_cast<arrow::StringBuilder*>(builder.get()),
+                            [&data](size_t row, char* buf) {
+                                int year, month, day;
+                                data[row].to_date(&year, &month, &day);
+                                vectorized::date::to_string(year, month, day, buf);
+                                return 10;
+                            });
+        break;
+    }
+    case TYPE_DATETIME: {
+        const auto& data = down_cast<const vectorized::TimestampColumn&>(*data_column).get_data();
+        st = append_strings(num_rows, valid_bytes, down_cast<arrow::StringBuilder*>(builder.get()),
+                            [&data](size_t row, char* buf) { return data[row].to_string(buf, 64); });
+        break;
+    }
+    case TYPE_LARGEINT: {
+        const auto& data = down_cast<const vectorized::Int128Column&>(*data_column).get_data();
+        st = append_strings(num_rows, valid_bytes, down_cast<arrow::StringBuilder*>(builder.get()),
+                            [&data](size_t row, char* buf) {
+                                int len = 64;
+                                char* str = LargeIntValue::to_string(data[row], buf, &len);
+                                memmove(buf, str, len);
+                                return len;
+                            });
+        break;
+    }
+    default:
+        return Status::NotSupported(strings::Substitute("Unsupported column type($0) to arrow", type.type));
+    }
+    RETURN_IF_ERROR(to_status(st));
+    return to_status(builder->Finish(result));
+}
+
+Status convert_to_arrow_batch(const vectorized::Columns& columns, const std::vector<TypeDescriptor>& types,
+                              const std::shared_ptr<arrow::Schema>& schema, arrow::MemoryPool* pool,
+                              std::shared_ptr<arrow::RecordBatch>* result) {
+    if (columns.size() != types.size() || columns.size() != schema->num_fields()) {
+        return Status::InvalidArgument("number fields not match");
+    }
+    const size_t num_rows = columns.empty() ? 0 : columns[0]->size();
+    std::vector<std::shared_ptr<arrow::Array>> arrays(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        ColumnPtr column = vectorized::ColumnHelper::unpack_and_duplicate_const_column(num_rows, columns[i]);
+        RETURN_IF_ERROR(convert_to_arrow_array(column, types[i], schema->field(i)->type(), pool, &arrays[i]));
+    }
+    *result = arrow::RecordBatch::Make(schema, num_rows, std::move(arrays));
+    return Status::OK();
+}
+
+} // namespace starrocks
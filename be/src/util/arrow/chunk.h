@@ -0,0 +1,37 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "runtime/types.h"
+
+// This file converts the columns of a StarRocks Chunk to an Arrow RecordBatch. The columns are
+// converted one by one, and the fixed-width ones are appended to the Arrow builders in bulk.
+
+namespace arrow {
+
+class MemoryPool;
+class RecordBatch;
+class Schema;
+
+} // namespace arrow
+
+namespace starrocks {
+
+// Convert the |types| of the columns named |names| to an Arrow Schema, the types are mapped in
+// the same way as the RowDescriptor version.
+Status convert_to_arrow_schema(const std::vector<TypeDescriptor>& types, const std::vector<std::string>& names,
+                               std::shared_ptr<arrow::Schema>* result);
+
+// Convert |columns| of |types| to an Arrow RecordBatch of |schema|, which is created from |types|
+// by the above function. Memory used by result RecordBatch will be allocated from input pool.
+Status convert_to_arrow_batch(const vectorized::Columns& columns, const std::vector<TypeDescriptor>& types,
+                              const std::shared_ptr<arrow::Schema>& schema, arrow::MemoryPool* pool,
+                              std::shared_ptr<arrow::RecordBatch>* result);
+
+} // namespace starrocks
@@ -31,6 +31,7 @@
 
 namespace arrow {
 
+class DataType;
 class MemoryPool;
 class RecordBatch;
 class Schema;
@@ -43,6 +44,10 @@ class MemTracker;
 class ObjectPool;
 class RowBatch;
 class RowDescriptor;
+struct TypeDescriptor;
+
+// Convert a StarRocks type to an Arrow DataType.
+Status convert_to_arrow_type(const TypeDescriptor& type, std::shared_ptr<arrow::DataType>* result);
 
 // Convert StarRocks RowDescriptor to Arrow Schema.
 Status convert_to_arrow_schema(const RowDescriptor& row_desc, std::shared_ptr<arrow::Schema>* result);
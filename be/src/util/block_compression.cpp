@@ -26,6 +26,7 @@
 #include <snappy/snappy-sinksource.h>
 #include <snappy/snappy.h>
 #include <zlib.h>
+#include <zstd/zdict.h>
 #include <zstd/zstd.h>
 #include <zstd/zstd_errors.h>
 
@@ -445,6 +446,84 @@ public:
     size_t max_compressed_len(size_t len) const override { return ZSTD_compressBound(len); }
 };
 
+// The contexts are reused by the threads, creating them for each page costs more than compressing a small page.
+class ZstdDictBlockCompression final : public BlockCompressionCodec {
+public:
+    ZstdDictBlockCompression(ZSTD_CDict* cdict, ZSTD_DDict* ddict) : _cdict(cdict), _ddict(ddict) {}
+
+    ~ZstdDictBlockCompression() override {
+        ZSTD_freeCDict(_cdict);
+        ZSTD_freeDDict(_ddict);
+    }
+
+    Status compress(const Slice& input, Slice* output) const override {
+        static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> s_cctx{ZSTD_createCCtx(),
+                                                                                     &ZSTD_freeCCtx};
+        size_t ret = ZSTD_compress_usingCDict(s_cctx.get(), output->data, output->size, input.data, input.size,
+                                              _cdict);
+        if (ZSTD_isError(ret)) {
+            return Status::InvalidArgument(
+                    strings::Substitute("ZSTD compress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+        }
+        output->size = ret;
+        return Status::OK();
+    }
+
+    Status decompress(const Slice& input, Slice* output) const override {
+        static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> s_dctx{ZSTD_createDCtx(),
+                                                                                     &ZSTD_freeDCtx};
+        if (output->data == nullptr) {
+            static uint8_t empty_buffer;
+            output->data = (char*)&empty_buffer;
+            output->size = 0;
+        }
+        size_t ret = ZSTD_decompress_usingDDict(s_dctx.get(), output->data, output->size, input.data, input.size,
+                                                _ddict);
+        if (ZSTD_isError(ret)) {
+            return Status::InvalidArgument(
+                    strings::Substitute("ZSTD decompress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+        }
+        output->size = ret;
+        return Status::OK();
+    }
+
+    size_t max_compressed_len(size_t len) const override { return ZSTD_compressBound(len); }
+
+private:
+    ZSTD_CDict* _cdict;
+    ZSTD_DDict* _ddict;
+};
+
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t dict_size, std::string* dict) {
+    faststring buf;
+    std::vector<size_t> sample_sizes;
+    for (auto& sample : samples) {
+        buf.append(sample.data, sample.size);
+        sample_sizes.push_back(sample.size);
+    }
+    dict->resize(dict_size);
+    size_t ret = ZDICT_trainFromBuffer(dict->data(), dict_size, buf.data(), sample_sizes.data(), sample_sizes.size());
+    if (ZDICT_isError(ret)) {
+        dict->clear();
+        return Status::InvalidArgument(
+                strings::Substitute("ZSTD train dictionary failed: $0", ZDICT_getErrorName(ret)));
+    }
+    dict->resize(ret);
+    return Status::OK();
+}
+
+Status create_zstd_dict_compression_codec(const Slice& dict, std::unique_ptr<BlockCompressionCodec>* codec) {
+    ZSTD_CDict* cdict = ZSTD_createCDict(dict.data, dict.size, ZSTD_CLEVEL_DEFAULT);
+    ZSTD_DDict* ddict = ZSTD_createDDict(dict.data, dict.size);
+    if (cdict == nullptr || ddict == nullptr) {
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+        return Status::InvalidArgument("ZSTD create dictionary failed");
+    }
+    *codec = std::make_unique<ZstdDictBlockCompression>(cdict, ddict);
+    return Status::OK();
+}
+
 Status get_block_compression_codec(CompressionTypePB type, const BlockCompressionCodec** codec) {
     switch (type) {
     case CompressionTypePB::NO_COMPRESSION:
@@ -22,6 +22,8 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "common/status.h"
@@ -73,4 +75,13 @@ public:
 // Return not OK, if error happens.
 Status get_block_compression_codec(CompressionTypePB type, const BlockCompressionCodec** codec);
 
+// Train a ZSTD dictionary of at most |dict_size| bytes from |samples| into |dict|.
+// Return not OK if the samples are too few or too small to train a dictionary.
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t dict_size, std::string* dict);
+
+// Create a ZSTD codec which compresses and decompresses by the dictionary |dict| trained by
+// train_zstd_dictionary(), which is digested once here. The blocks compressed by it can only be
+// decompressed by a codec of the same dictionary.
+Status create_zstd_dict_compression_codec(const Slice& dict, std::unique_ptr<BlockCompressionCodec>* codec);
+
 } // namespace starrocks
@@ -103,6 +103,8 @@ static struct {
 } flag_mappings[] = {
         {"ssse3", CpuInfo::SSSE3},   {"sse4_1", CpuInfo::SSE4_1}, {"sse4_2", CpuInfo::SSE4_2},
         {"popcnt", CpuInfo::POPCNT}, {"avx", CpuInfo::AVX},       {"avx2", CpuInfo::AVX2},
+        {"avx512f", CpuInfo::AVX512F}, {"avx512bw", CpuInfo::AVX512BW}, {"avx512vl", CpuInfo::AVX512VL},
+        {"avx512_vbmi2", CpuInfo::AVX512VBMI2},
 };
 static const long num_flags = sizeof(flag_mappings) / sizeof(flag_mappings[0]);
 
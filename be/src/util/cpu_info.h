@@ -43,6 +43,10 @@ public:
     static const int64_t POPCNT = (1 << 4);
     static const int64_t AVX = (1 << 5);
     static const int64_t AVX2 = (1 << 6);
+    static const int64_t AVX512F = (1 << 7);
+    static const int64_t AVX512BW = (1 << 8);
+    static const int64_t AVX512VL = (1 << 9);
+    static const int64_t AVX512VBMI2 = (1 << 10);
 
     /// Cache enums for L1 (data), L2 and L3
     enum CacheLevel {
@@ -0,0 +1,181 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/cpu_sampler.h"
+
+#include <sys/time.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
+
+namespace google {
+int GetStackTrace(void** result, int max_depth, int skip_count);
+} // namespace google
+
+namespace starrocks {
+
+// CLOCK_MONOTONIC_COARSE is cheap and safe to read in a signal handler.
+static int64_t coarse_monotonic_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000;
+}
+
+CpuSampler* CpuSampler::instance() {
+    static CpuSampler s_instance;
+    return &s_instance;
+}
+
+CpuSampler::~CpuSampler() {
+    stop();
+}
+
+Status CpuSampler::start(int frequency, size_t capacity) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_running) {
+        return Status::OK();
+    }
+    if (frequency <= 0 || frequency > 1000000) {
+        return Status::InvalidArgument(strings::Substitute("Invalid sampling frequency $0", frequency));
+    }
+    if (_samples == nullptr) {
+        _capacity = std::max<size_t>(capacity, 1);
+        _samples.reset(new Sample[_capacity]);
+        _buffer.store(_samples.get(), std::memory_order_release);
+    }
+    // the first stack trace may allocate, which must not happen in the signal handler.
+    void* frames[kMaxDepth];
+    google::GetStackTrace(frames, kMaxDepth, 0);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = _signal_handler;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &_old_action) != 0) {
+        return Status::InternalError(
+                strings::Substitute("Fail to install the handler of SIGPROF: $0", strerror(errno)));
+    }
+    int64_t interval_us = 1000000 / frequency;
+    struct itimerval timer;
+    timer.it_interval.tv_sec = interval_us / 1000000;
+    timer.it_interval.tv_usec = interval_us % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        int err = errno;
+        sigaction(SIGPROF, &_old_action, nullptr);
+        return Status::InternalError(strings::Substitute("Fail to set the profiling timer: $0", strerror(err)));
+    }
+    _running = true;
+    return Status::OK();
+}
+
+void CpuSampler::stop() {
+    std::lock_guard<std::mutex> l(_lock);
+    if (!_running) {
+        return;
+    }
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    // a pending SIGPROF terminates the process by default.
+    if ((_old_action.sa_flags & SA_SIGINFO) == 0 && _old_action.sa_handler == SIG_DFL) {
+        _old_action.sa_handler = SIG_IGN;
+    }
+    sigaction(SIGPROF, &_old_action, nullptr);
+    _running = false;
+}
+
+void CpuSampler::_signal_handler(int signo, siginfo_t* info, void* context) {
+    int saved_errno = errno;
+    instance()->_record();
+    errno = saved_errno;
+}
+
+void CpuSampler::_record() {
+    Sample* buffer = _buffer.load(std::memory_order_acquire);
+    if (buffer == nullptr) {
+        return;
+    }
+    Sample& sample = buffer[_next.fetch_add(1, std::memory_order_relaxed) % _capacity];
+    uint64_t version = sample.version.load(std::memory_order_relaxed);
+    // skip the sample if another thread is writing the same slot after the buffer wraps around.
+    if ((version & 1) != 0 || !sample.version.compare_exchange_strong(version, version + 1)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    sample.data.time_ms = coarse_monotonic_ms();
+    CurrentThread::query_id_for_signal(&sample.data.query_hi, &sample.data.query_lo);
+    // skip the frames of the handler.
+    sample.data.depth = google::GetStackTrace(sample.data.frames, kMaxDepth, 2);
+    sample.version.store(version + 2, std::memory_order_release);
+}
+
+void CpuSampler::_for_each_sample(int64_t seconds, const std::function<void(const SampleData&)>& fn) const {
+    const Sample* buffer = _buffer.load(std::memory_order_acquire);
+    if (buffer == nullptr) {
+        return;
+    }
+    int64_t min_time_ms = coarse_monotonic_ms() - seconds * 1000;
+    for (size_t i = 0; i < _capacity; i++) {
+        const Sample& sample = buffer[i];
+        uint64_t version = sample.version.load(std::memory_order_acquire);
+        if (version == 0 || (version & 1) != 0) {
+            continue;
+        }
+        SampleData data;
+        memcpy(&data, &sample.data, sizeof(data));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sample.version.load(std::memory_order_relaxed) != version) {
+            continue;
+        }
+        if (data.time_ms >= min_time_ms && data.depth > 0) {
+            fn(data);
+        }
+    }
+}
+
+void CpuSampler::folded_stacks(int64_t seconds, const UniqueId* query_id,
+                               const std::function<std::string(void*)>& symbolize, std::string* out) const {
+    std::map<std::vector<void*>, int64_t> stacks;
+    _for_each_sample(seconds, [&](const SampleData& data) {
+        if (query_id != nullptr && (data.query_hi != query_id->hi || data.query_lo != query_id->lo)) {
+            return;
+        }
+        // the outermost frame first.
+        std::vector<void*> frames(data.frames, data.frames + std::min<int32_t>(data.depth, kMaxDepth));
+        std::reverse(frames.begin(), frames.end());
+        stacks[std::move(frames)]++;
+    });
+
+    std::unordered_map<void*, std::string> names;
+    for (const auto& [frames, count] : stacks) {
+        for (size_t i = 0; i < frames.size(); i++) {
+            auto iter = names.find(frames[i]);
+            if (iter == names.end()) {
+                // the return addresses but the innermost one are after the calls.
+                void* pc = i + 1 < frames.size() ? static_cast<char*>(frames[i]) - 1 : frames[i];
+                iter = names.emplace(frames[i], symbolize(pc)).first;
+            }
+            if (i > 0) {
+                out->push_back(';');
+            }
+            out->append(iter->second);
+        }
+        out->append(" ").append(std::to_string(count)).push_back('\n');
+    }
+}
+
+std::map<UniqueId, int64_t> CpuSampler::query_samples(int64_t seconds) const {
+    std::map<UniqueId, int64_t> samples;
+    _for_each_sample(seconds, [&](const SampleData& data) { samples[UniqueId(data.query_hi, data.query_lo)]++; });
+    return samples;
+}
+
+} // namespace starrocks
@@ -0,0 +1,88 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <signal.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/status.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+// A sampling CPU profiler running along with the process. Every 1/frequency seconds of the CPU time of the
+// process, SIGPROF interrupts the thread running on the CPU, whose stack is recorded along with the query the
+// thread works for, see CurrentThread::set_query_id. The samples are kept in a ring buffer, so the ones of the
+// last few minutes are always there to be aggregated into the flame graphs of the process or of a query.
+//
+// SIGPROF is the signal of the gperftools CPU profiler too, so the sampler must be stopped while it's running.
+class CpuSampler {
+public:
+    static constexpr int kMaxDepth = 48;
+
+    static CpuSampler* instance();
+
+    ~CpuSampler();
+
+    // Start to sample at |frequency| per second of the CPU time into a buffer of |capacity| samples. The buffer is
+    // allocated at the first start, and the later ones keep using it.
+    Status start(int frequency, size_t capacity);
+
+    // Stop the sampling, the samples are kept.
+    void stop();
+
+    bool running() const {
+        std::lock_guard<std::mutex> l(_lock);
+        return _running;
+    }
+
+    // Append the folded stacks of the samples in the last |seconds| to |out|, one line "f0;f1;...;fn count" per
+    // distinct stack with the outermost frame first, which is the input of flamegraph.pl and the similar tools.
+    // Only the samples of |query_id| are aggregated if it's not null. |symbolize| names the frames.
+    void folded_stacks(int64_t seconds, const UniqueId* query_id, const std::function<std::string(void*)>& symbolize,
+                       std::string* out) const;
+
+    // The number of the samples of each query in the last |seconds|, the ones of no query are of UniqueId(0, 0).
+    std::map<UniqueId, int64_t> query_samples(int64_t seconds) const;
+
+private:
+    struct SampleData {
+        int64_t time_ms;
+        int64_t query_hi;
+        int64_t query_lo;
+        int32_t depth;
+        void* frames[kMaxDepth];
+    };
+
+    struct Sample {
+        // odd while the sample is being written, and increased by 2 every time it's rewritten.
+        std::atomic<uint64_t> version{0};
+        SampleData data;
+    };
+
+    CpuSampler() = default;
+
+    static void _signal_handler(int signo, siginfo_t* info, void* context);
+
+    void _record();
+
+    // Call |fn| with the consistent copies of the samples in the last |seconds|.
+    void _for_each_sample(int64_t seconds, const std::function<void(const SampleData&)>& fn) const;
+
+    mutable std::mutex _lock;
+    bool _running = false;
+    struct sigaction _old_action;
+
+    std::unique_ptr<Sample[]> _samples;
+    std::atomic<Sample*> _buffer{nullptr};
+    size_t _capacity = 0;
+    std::atomic<uint64_t> _next{0};
+};
+
+} // namespace starrocks
@@ -0,0 +1,121 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/fair_thread_pool.h"
+
+#include <algorithm>
+
+#include "common/logging.h"
+
+namespace starrocks {
+
+FairThreadPool::FairThreadPool(uint32_t num_threads, uint32_t queue_size) : _queue_size(queue_size) {
+    _threads.reserve(num_threads);
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        _threads.emplace_back(&FairThreadPool::_work_thread, this);
+    }
+}
+
+FairThreadPool::~FairThreadPool() {
+    shutdown();
+    join();
+}
+
+bool FairThreadPool::offer(int64_t group, int weight, WorkFunction func) {
+    std::unique_lock<std::mutex> l(_lock);
+    _put_cv.wait(l, [this] { return _shutdown || _num_tasks < _queue_size; });
+    return _put(l, group, weight, std::move(func));
+}
+
+bool FairThreadPool::try_offer(int64_t group, int weight, WorkFunction func) {
+    std::unique_lock<std::mutex> l(_lock);
+    if (_num_tasks >= _queue_size) {
+        return false;
+    }
+    return _put(l, group, weight, std::move(func));
+}
+
+bool FairThreadPool::_put(std::unique_lock<std::mutex>& l, int64_t group, int weight, WorkFunction func) {
+    if (_shutdown) {
+        return false;
+    }
+    Group& g = _groups[group];
+    if (g.tasks.empty()) {
+        // a group joining the round starts without any credit, so it can't save the credits up while idle
+        g.deficit = 0;
+        _round.push_back(group);
+    }
+    g.weight = std::max(1, weight);
+    g.tasks.emplace_back(std::move(func));
+    _num_tasks++;
+    l.unlock();
+    _get_cv.notify_one();
+    return true;
+}
+
+FairThreadPool::WorkFunction FairThreadPool::_pop() {
+    DCHECK(!_round.empty());
+    int64_t id = _round.front();
+    Group& g = _groups[id];
+    if (g.deficit <= 0) {
+        g.deficit += g.weight;
+    }
+    WorkFunction func = std::move(g.tasks.front());
+    g.tasks.pop_front();
+    g.deficit--;
+    _num_tasks--;
+    _round.pop_front();
+    if (g.tasks.empty()) {
+        _groups.erase(id);
+    } else if (g.deficit > 0) {
+        // keep the head of the round until the credits are used up
+        _round.push_front(id);
+    } else {
+        _round.push_back(id);
+    }
+    return func;
+}
+
+void FairThreadPool::_work_thread() {
+    while (true) {
+        WorkFunction func;
+        {
+            std::unique_lock<std::mutex> l(_lock);
+            _get_cv.wait(l, [this] { return _shutdown || _num_tasks > 0; });
+            if (_shutdown) {
+                return;
+            }
+            func = _pop();
+        }
+        _put_cv.notify_one();
+        func();
+    }
+}
+
+void FairThreadPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _shutdown = true;
+    }
+    _get_cv.notify_all();
+    _put_cv.notify_all();
+}
+
+void FairThreadPool::join() {
+    for (auto& t : _threads) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+uint32_t FairThreadPool::get_queue_size() const {
+    std::lock_guard<std::mutex> l(_lock);
+    return _num_tasks;
+}
+
+size_t FairThreadPool::num_groups() const {
+    std::lock_guard<std::mutex> l(_lock);
+    return _groups.size();
+}
+
+} // namespace starrocks
@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace starrocks {
+
+// FairThreadPool shares its threads among the groups of the tasks, e.g. the queries, instead of running the tasks
+// in the order of a static priority. Each group has a queue of its own, and the groups are served by deficit round
+// robin: a group at the head of the round gains |weight| credits, runs one task for a credit and goes back to the
+// tail of the round when the credits are used up. So a group with many tasks can't take every thread from the
+// others, and a group offering a task is served after at most one round of the others.
+//
+// The weight is given on each offer, so the submitter can adjust the share of a group on the fly, e.g. by how
+// fast the results of it are consumed.
+class FairThreadPool {
+public:
+    using WorkFunction = std::function<void()>;
+
+    // Start |num_threads| threads, at most |queue_size| tasks of all the groups can be queued.
+    FairThreadPool(uint32_t num_threads, uint32_t queue_size);
+
+    // Shuts down the pool and waits for the threads.
+    ~FairThreadPool();
+
+    FairThreadPool(const FairThreadPool&) = delete;
+    FairThreadPool& operator=(const FairThreadPool&) = delete;
+
+    // Queue |func| of |group| with the weight |weight|, which is at least 1, blocking while the queue is full.
+    // Returns false if the pool is shut down.
+    bool offer(int64_t group, int weight, WorkFunction func);
+
+    // Same as offer, but returns false instead of blocking if the queue is full.
+    bool try_offer(int64_t group, int weight, WorkFunction func);
+
+    // Stop accepting the tasks, the threads exit after the task running, the tasks queued are dropped.
+    void shutdown();
+
+    // Blocks until all threads are finished.
+    void join();
+
+    uint32_t get_queue_size() const;
+
+    size_t num_groups() const;
+
+private:
+    struct Group {
+        std::deque<WorkFunction> tasks;
+        int weight = 1;
+        int deficit = 0;
+    };
+
+    bool _put(std::unique_lock<std::mutex>& l, int64_t group, int weight, WorkFunction func);
+
+    // Pop the next task by deficit round robin, _lock is held and the queue is not empty.
+    WorkFunction _pop();
+
+    void _work_thread();
+
+    const uint32_t _queue_size;
+    std::vector<std::thread> _threads;
+
+    // _lock protects all the members below.
+    mutable std::mutex _lock;
+    std::condition_variable _get_cv;
+    std::condition_variable _put_cv;
+    std::unordered_map<int64_t, Group> _groups;
+    // The groups having tasks, in the order of the round.
+    std::list<int64_t> _round;
+    uint32_t _num_tasks = 0;
+    bool _shutdown = false;
+};
+
+} // namespace starrocks
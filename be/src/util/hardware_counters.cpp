@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/hardware_counters.h"
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include "common/logging.h"
+
+namespace starrocks {
+
+static int perf_event_open(perf_event_attr* attr, int group_fd) {
+    attr->size = sizeof(*attr);
+    // the calling thread on any cpu
+    return syscall(__NR_perf_event_open, attr, 0, -1, group_fd, 0);
+}
+
+ThreadHardwareCounters* ThreadHardwareCounters::current() {
+    // nullptr after the counters fail to open, they're not retried for the thread
+    static thread_local std::unique_ptr<ThreadHardwareCounters> tls_counters;
+    static thread_local bool tls_opened = false;
+    if (!tls_opened) {
+        tls_opened = true;
+        std::unique_ptr<ThreadHardwareCounters> counters(new ThreadHardwareCounters());
+        if (counters->_open()) {
+            tls_counters = std::move(counters);
+        }
+    }
+    return tls_counters.get();
+}
+
+ThreadHardwareCounters::~ThreadHardwareCounters() {
+    for (int fd : _fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+bool ThreadHardwareCounters::_open() {
+    static const uint64_t configs[kNumCounters] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                   PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int i = 0; i < kNumCounters; ++i) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        _fds[i] = perf_event_open(&attr, _fds[0]);
+        if (_fds[i] < 0) {
+            LOG_FIRST_N(WARNING, 1) << "hardware counters are not available, perf_event_open failed: "
+                                    << strerror(errno);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ThreadHardwareCounters::read(HardwareCounterValues* values) const {
+    // the layout of PERF_FORMAT_GROUP: the number of the counters followed by the values of them
+    uint64_t buf[1 + kNumCounters];
+    if (::read(_fds[0], buf, sizeof(buf)) != sizeof(buf) || buf[0] != kNumCounters) {
+        return false;
+    }
+    values->cycles = buf[1];
+    values->instructions = buf[2];
+    values->llc_misses = buf[3];
+    values->branch_misses = buf[4];
+    return true;
+}
+
+} // namespace starrocks
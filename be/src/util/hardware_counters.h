@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+
+namespace starrocks {
+
+// The values of the hardware counters of a thread.
+struct HardwareCounterValues {
+    int64_t cycles = 0;
+    int64_t instructions = 0;
+    int64_t llc_misses = 0;
+    int64_t branch_misses = 0;
+
+    HardwareCounterValues& operator+=(const HardwareCounterValues& rhs) {
+        cycles += rhs.cycles;
+        instructions += rhs.instructions;
+        llc_misses += rhs.llc_misses;
+        branch_misses += rhs.branch_misses;
+        return *this;
+    }
+
+    HardwareCounterValues operator-(const HardwareCounterValues& rhs) const {
+        HardwareCounterValues values;
+        values.cycles = cycles - rhs.cycles;
+        values.instructions = instructions - rhs.instructions;
+        values.llc_misses = llc_misses - rhs.llc_misses;
+        values.branch_misses = branch_misses - rhs.branch_misses;
+        return values;
+    }
+};
+
+// ThreadHardwareCounters counts the cycles, instructions, LLC misses and branch misses of the calling thread in
+// the user space by a group of the perf events, which are read together by one syscall. Unlike PerfCounters
+// counting the whole process, they can be read around a piece of work, e.g. an operator pulling a chunk, to tell
+// whether the work is bound by the memory.
+//
+// The values are not scaled if the counters are multiplexed with the other users of the perf events.
+class ThreadHardwareCounters {
+public:
+    // The counters of the calling thread, opened on the first call. Returns nullptr if the perf events are not
+    // available, e.g. denied by perf_event_paranoid or not supported by the virtual machine.
+    static ThreadHardwareCounters* current();
+
+    ~ThreadHardwareCounters();
+
+    ThreadHardwareCounters(const ThreadHardwareCounters&) = delete;
+    ThreadHardwareCounters& operator=(const ThreadHardwareCounters&) = delete;
+
+    // Returns false if the counters can't be read.
+    bool read(HardwareCounterValues* values) const;
+
+private:
+    static constexpr int kNumCounters = 4;
+
+    ThreadHardwareCounters() = default;
+
+    bool _open();
+
+    // the first one is the leader of the group
+    int _fds[kNumCounters] = {-1, -1, -1, -1};
+};
+
+} // namespace starrocks
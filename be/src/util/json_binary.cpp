@@ -0,0 +1,301 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/json_binary.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "util/coding.h"
+
+namespace starrocks {
+
+// The bytes of the type, the size and the number of the entries of an array or an object.
+static constexpr size_t kContainerHeaderSize = 9;
+
+static void set_fixed32_le(std::string* dst, size_t pos, uint32_t val) {
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(&(*dst)[pos]), val);
+}
+
+static void encode_value(const rapidjson::Value& value, std::string* dst) {
+    switch (value.GetType()) {
+    case rapidjson::kNullType:
+        dst->push_back(JsonBinaryValue::NULL_VALUE);
+        break;
+    case rapidjson::kFalseType:
+        dst->push_back(JsonBinaryValue::FALSE_VALUE);
+        break;
+    case rapidjson::kTrueType:
+        dst->push_back(JsonBinaryValue::TRUE_VALUE);
+        break;
+    case rapidjson::kNumberType:
+        if (value.IsInt64()) {
+            dst->push_back(JsonBinaryValue::INT64);
+            put_fixed64_le(dst, static_cast<uint64_t>(value.GetInt64()));
+        } else if (value.IsUint64()) {
+            dst->push_back(JsonBinaryValue::UINT64);
+            put_fixed64_le(dst, value.GetUint64());
+        } else {
+            double d = value.GetDouble();
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(bits));
+            dst->push_back(JsonBinaryValue::DOUBLE);
+            put_fixed64_le(dst, bits);
+        }
+        break;
+    case rapidjson::kStringType:
+        dst->push_back(JsonBinaryValue::STRING);
+        put_fixed32_le(dst, value.GetStringLength());
+        dst->append(value.GetString(), value.GetStringLength());
+        break;
+    case rapidjson::kArrayType: {
+        dst->push_back(JsonBinaryValue::ARRAY);
+        size_t size_pos = dst->size();
+        uint32_t n = value.Size();
+        put_fixed32_le(dst, 0);
+        put_fixed32_le(dst, n);
+        size_t offsets_pos = dst->size();
+        dst->resize(offsets_pos + 4 * n);
+        size_t begin = dst->size();
+        for (uint32_t i = 0; i < n; i++) {
+            set_fixed32_le(dst, offsets_pos + 4 * i, dst->size() - begin);
+            encode_value(value[i], dst);
+        }
+        set_fixed32_le(dst, size_pos, dst->size() - size_pos - 4);
+        break;
+    }
+    case rapidjson::kObjectType: {
+        dst->push_back(JsonBinaryValue::OBJECT);
+        size_t size_pos = dst->size();
+        uint32_t n = value.MemberCount();
+        put_fixed32_le(dst, 0);
+        put_fixed32_le(dst, n);
+
+        auto members = value.MemberBegin();
+        std::vector<uint32_t> sorted(n);
+        std::iota(sorted.begin(), sorted.end(), 0);
+        std::stable_sort(sorted.begin(), sorted.end(), [&](uint32_t lhs, uint32_t rhs) {
+            const auto& l = members[lhs].name;
+            const auto& r = members[rhs].name;
+            return Slice(l.GetString(), l.GetStringLength()).compare(Slice(r.GetString(), r.GetStringLength())) < 0;
+        });
+        for (uint32_t i : sorted) {
+            put_fixed32_le(dst, i);
+        }
+
+        size_t offsets_pos = dst->size();
+        dst->resize(offsets_pos + 4 * n);
+        size_t begin = dst->size();
+        for (uint32_t i = 0; i < n; i++) {
+            set_fixed32_le(dst, offsets_pos + 4 * i, dst->size() - begin);
+            const auto& name = members[i].name;
+            put_fixed32_le(dst, name.GetStringLength());
+            dst->append(name.GetString(), name.GetStringLength());
+            encode_value(members[i].value, dst);
+        }
+        set_fixed32_le(dst, size_pos, dst->size() - size_pos - 4);
+        break;
+    }
+    }
+}
+
+void JsonBinaryValue::encode(const rapidjson::Value& value, std::string* dst) {
+    dst->push_back('\0');
+    dst->push_back(kVersion);
+    encode_value(value, dst);
+}
+
+bool JsonBinaryValue::from_binary(const Slice& data, JsonBinaryValue* value) {
+    if (!is_binary(data) || static_cast<uint8_t>(data.data[1]) != kVersion) {
+        return false;
+    }
+    return init(reinterpret_cast<const uint8_t*>(data.data) + 2, data.size - 2, value);
+}
+
+bool JsonBinaryValue::init(const uint8_t* data, size_t max_size, JsonBinaryValue* value) {
+    if (max_size < 1) {
+        return false;
+    }
+    size_t size = 0;
+    switch (data[0]) {
+    case NULL_VALUE:
+    case FALSE_VALUE:
+    case TRUE_VALUE:
+        size = 1;
+        break;
+    case INT64:
+    case UINT64:
+    case DOUBLE:
+        size = 9;
+        break;
+    case STRING:
+        if (max_size < 5) {
+            return false;
+        }
+        size = 5 + static_cast<size_t>(decode_fixed32_le(data + 1));
+        break;
+    case ARRAY:
+    case OBJECT: {
+        if (max_size < kContainerHeaderSize) {
+            return false;
+        }
+        size = 5 + static_cast<size_t>(decode_fixed32_le(data + 1));
+        size_t n = decode_fixed32_le(data + 5);
+        size_t tables = (data[0] == ARRAY ? 4 : 8) * n;
+        if (size < kContainerHeaderSize + tables) {
+            return false;
+        }
+        break;
+    }
+    default:
+        return false;
+    }
+    if (size > max_size) {
+        return false;
+    }
+    *value = JsonBinaryValue(data, size);
+    return true;
+}
+
+uint32_t JsonBinaryValue::num_elements() const {
+    if (type() != ARRAY && type() != OBJECT) {
+        return 0;
+    }
+    return decode_fixed32_le(_data + 5);
+}
+
+bool JsonBinaryValue::entry_at(uint32_t index, const uint8_t** entry, size_t* size) const {
+    uint32_t n = num_elements();
+    if (index >= n) {
+        return false;
+    }
+    const uint8_t* offsets = _data + kContainerHeaderSize + (type() == OBJECT ? 4 * n : 0);
+    const uint8_t* begin = offsets + 4 * n;
+    size_t area_size = _size - (begin - _data);
+    size_t entry_begin = decode_fixed32_le(offsets + 4 * index);
+    size_t entry_end = index + 1 < n ? decode_fixed32_le(offsets + 4 * (index + 1)) : area_size;
+    if (entry_begin > entry_end || entry_end > area_size) {
+        return false;
+    }
+    *entry = begin + entry_begin;
+    *size = entry_end - entry_begin;
+    return true;
+}
+
+bool JsonBinaryValue::element_at(uint32_t index, JsonBinaryValue* element) const {
+    const uint8_t* entry = nullptr;
+    size_t size = 0;
+    if (type() != ARRAY || !entry_at(index, &entry, &size)) {
+        return false;
+    }
+    return init(entry, size, element);
+}
+
+bool JsonBinaryValue::member_at(uint32_t index, Slice* key, JsonBinaryValue* value) const {
+    const uint8_t* entry = nullptr;
+    size_t size = 0;
+    if (!entry_at(index, &entry, &size) || size < 4) {
+        return false;
+    }
+    size_t key_size = decode_fixed32_le(entry);
+    if (4 + key_size > size) {
+        return false;
+    }
+    *key = Slice(reinterpret_cast<const char*>(entry) + 4, key_size);
+    return init(entry + 4 + key_size, size - 4 - key_size, value);
+}
+
+bool JsonBinaryValue::find_member(const Slice& key, JsonBinaryValue* member) const {
+    if (type() != OBJECT) {
+        return false;
+    }
+    uint32_t n = num_elements();
+    const uint8_t* sorted = _data + kContainerHeaderSize;
+    // The first member whose key isn't less than |key|.
+    uint32_t low = 0;
+    uint32_t high = n;
+    Slice found_key;
+    JsonBinaryValue found;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        Slice mid_key;
+        JsonBinaryValue mid_value;
+        if (!member_at(decode_fixed32_le(sorted + 4 * mid), &mid_key, &mid_value)) {
+            return false;
+        }
+        if (mid_key.compare(key) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+            found_key = mid_key;
+            found = mid_value;
+        }
+    }
+    if (low == n || found_key != key) {
+        return false;
+    }
+    *member = found;
+    return true;
+}
+
+bool JsonBinaryValue::to_rapidjson(rapidjson::Value* value, rapidjson::Document::AllocatorType& allocator) const {
+    switch (type()) {
+    case NULL_VALUE:
+        value->SetNull();
+        return true;
+    case FALSE_VALUE:
+        value->SetBool(false);
+        return true;
+    case TRUE_VALUE:
+        value->SetBool(true);
+        return true;
+    case INT64:
+        value->SetInt64(static_cast<int64_t>(decode_fixed64_le(_data + 1)));
+        return true;
+    case UINT64:
+        value->SetUint64(decode_fixed64_le(_data + 1));
+        return true;
+    case DOUBLE: {
+        uint64_t bits = decode_fixed64_le(_data + 1);
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        value->SetDouble(d);
+        return true;
+    }
+    case STRING:
+        value->SetString(rapidjson::StringRef(reinterpret_cast<const char*>(_data) + 5, _size - 5));
+        return true;
+    case ARRAY: {
+        uint32_t n = num_elements();
+        value->SetArray();
+        value->Reserve(n, allocator);
+        for (uint32_t i = 0; i < n; i++) {
+            JsonBinaryValue element;
+            rapidjson::Value v;
+            if (!element_at(i, &element) || !element.to_rapidjson(&v, allocator)) {
+                return false;
+            }
+            value->PushBack(v, allocator);
+        }
+        return true;
+    }
+    case OBJECT: {
+        uint32_t n = num_elements();
+        value->SetObject();
+        for (uint32_t i = 0; i < n; i++) {
+            Slice key;
+            JsonBinaryValue member;
+            rapidjson::Value v;
+            if (!member_at(i, &key, &member) || !member.to_rapidjson(&v, allocator)) {
+                return false;
+            }
+            value->AddMember(rapidjson::Value(rapidjson::StringRef(key.data, key.size)), v, allocator);
+        }
+        return true;
+    }
+    }
+    return false;
+}
+
+} // namespace starrocks
@@ -0,0 +1,92 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "common/compiler_util.h"
+DIAGNOSTIC_PUSH
+DIAGNOSTIC_IGNORE("-Wclass-memaccess")
+#include <rapidjson/document.h>
+DIAGNOSTIC_POP
+
+#include <cstdint>
+#include <string>
+
+#include "util/slice.h"
+
+namespace starrocks {
+
+// A JSON value in a pre-parsed binary form, so the values of a path are found without parsing the text, i.e. the
+// members of an object by a binary search of the keys and the elements of an array by the offsets. The form is
+//
+//   "\0" | version (1 byte) | value
+//
+// and a value is its type (1 byte) followed by
+//   NULL_VALUE, FALSE_VALUE, TRUE_VALUE: nothing
+//   INT64, UINT64, DOUBLE: the number (8 bytes)
+//   STRING: length (4 bytes) | bytes
+//   ARRAY: size (4 bytes) | n (4 bytes) | the offsets of the elements (4 bytes each) | elements
+//   OBJECT: size (4 bytes) | n (4 bytes) | the members sorted by the keys (4 bytes each) |
+//           the offsets of the members (4 bytes each) | members, each of them key length (4 bytes) | key | value
+// where the size is the bytes following it and the offsets are from the first element or member. The members are
+// in the order of the text, and the duplicate keys are sorted by it, so the first of them is found as rapidjson.
+// All the integers are little endian.
+//
+// The form is never a valid JSON text, which never begins with "\0", so a VARCHAR column may have both of them.
+class JsonBinaryValue {
+public:
+    enum Type : uint8_t {
+        NULL_VALUE = 0,
+        FALSE_VALUE = 1,
+        TRUE_VALUE = 2,
+        INT64 = 3,
+        UINT64 = 4,
+        DOUBLE = 5,
+        STRING = 6,
+        ARRAY = 7,
+        OBJECT = 8,
+    };
+
+    static constexpr uint8_t kVersion = 1;
+
+    // Append the binary form of |value| to |dst|.
+    static void encode(const rapidjson::Value& value, std::string* dst);
+
+    static bool is_binary(const Slice& data) { return data.size >= 2 && data.data[0] == '\0'; }
+
+    // Set |value| to the root value of |data| in the binary form, return false if |data| is malformed.
+    static bool from_binary(const Slice& data, JsonBinaryValue* value);
+
+    JsonBinaryValue() = default;
+
+    Type type() const { return static_cast<Type>(_data[0]); }
+
+    // The elements of an array or the members of an object.
+    uint32_t num_elements() const;
+
+    // Set |element| to the |index|-th element of an array, return false if it's out of the range or malformed.
+    bool element_at(uint32_t index, JsonBinaryValue* element) const;
+
+    // Set |member| to the value of the first member |key| of an object, return false if it's not found.
+    bool find_member(const Slice& key, JsonBinaryValue* member) const;
+
+    // Set |value| to the DOM of the value, whose strings reference the binary form, so it must outlive |value|.
+    // Return false if it's malformed.
+    bool to_rapidjson(rapidjson::Value* value, rapidjson::Document::AllocatorType& allocator) const;
+
+private:
+    JsonBinaryValue(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+    // Check the value and set |_size| to its bytes, which are at most |max_size|.
+    static bool init(const uint8_t* data, size_t max_size, JsonBinaryValue* value);
+
+    // The |index|-th member of an object, i.e. its key and value.
+    bool member_at(uint32_t index, Slice* key, JsonBinaryValue* value) const;
+
+    // The |index|-th element of an array or member of an object.
+    bool entry_at(uint32_t index, const uint8_t** entry, size_t* size) const;
+
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+};
+
+} // namespace starrocks
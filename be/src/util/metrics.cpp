@@ -21,6 +21,12 @@
 
 #include "util/metrics.h"
 
+#include <sched.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
 namespace starrocks {
 
 MetricLabels MetricLabels::EmptyLabels;
@@ -80,6 +86,142 @@ const char* unit_name(MetricUnit unit) {
     }
 }
 
+// The percentiles are exported instead of the buckets, so it's a summary rather than a histogram of prometheus.
+HistogramMetric::HistogramMetric(MetricUnit unit) : Metric(MetricType::SUMMARY, unit) {
+    size_t num_cpus = std::thread::hardware_concurrency();
+    _num_shards = 1;
+    while (_num_shards < num_cpus && _num_shards < 64) {
+        _num_shards <<= 1;
+    }
+    _shards.reset(new Shard[_num_shards]);
+    for (size_t i = 0; i < _num_shards; ++i) {
+        for (auto& count : _shards[i].counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        _shards[i].sum.store(0, std::memory_order_relaxed);
+        _shards[i].max.store(0, std::memory_order_relaxed);
+    }
+}
+
+HistogramMetric::~HistogramMetric() = default;
+
+int HistogramMetric::bucket_index(uint64_t value) {
+    constexpr uint64_t kSubBuckets = 1 << kSubBucketBits;
+    if (value < kSubBuckets) {
+        return static_cast<int>(value);
+    }
+    int exponent = 63 - __builtin_clzll(value);
+    int mantissa = static_cast<int>((value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1));
+    return ((exponent - kSubBucketBits + 1) << kSubBucketBits) + mantissa;
+}
+
+uint64_t HistogramMetric::bucket_upper_bound(int index) {
+    constexpr int kSubBuckets = 1 << kSubBucketBits;
+    if (index < kSubBuckets) {
+        return index;
+    }
+    int exponent = (index >> kSubBucketBits) + kSubBucketBits - 1;
+    uint64_t mantissa = index & (kSubBuckets - 1);
+    uint64_t lower = (uint64_t(1) << exponent) | (mantissa << (exponent - kSubBucketBits));
+    return lower + ((uint64_t(1) << (exponent - kSubBucketBits)) - 1);
+}
+
+HistogramMetric::Shard* HistogramMetric::_local_shard() const {
+    return &_shards[static_cast<size_t>(sched_getcpu()) & (_num_shards - 1)];
+}
+
+void HistogramMetric::add(uint64_t value) {
+    Shard* shard = _local_shard();
+    shard->counts[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    shard->sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = shard->max.load(std::memory_order_relaxed);
+    while (value > max && !shard->max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t HistogramMetric::count() const {
+    uint64_t count = 0;
+    for (size_t i = 0; i < _num_shards; ++i) {
+        for (const auto& c : _shards[i].counts) {
+            count += c.load(std::memory_order_relaxed);
+        }
+    }
+    return count;
+}
+
+uint64_t HistogramMetric::sum() const {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < _num_shards; ++i) {
+        sum += _shards[i].sum.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+uint64_t HistogramMetric::max() const {
+    uint64_t max = 0;
+    for (size_t i = 0; i < _num_shards; ++i) {
+        max = std::max(max, _shards[i].max.load(std::memory_order_relaxed));
+    }
+    return max;
+}
+
+std::vector<uint64_t> HistogramMetric::percentiles(const std::vector<double>& quantiles) const {
+    std::vector<uint64_t> counts(kNumBuckets, 0);
+    uint64_t total = 0;
+    for (size_t i = 0; i < _num_shards; ++i) {
+        for (int j = 0; j < kNumBuckets; ++j) {
+            uint64_t c = _shards[i].counts[j].load(std::memory_order_relaxed);
+            counts[j] += c;
+            total += c;
+        }
+    }
+    const uint64_t max_value = max();
+    std::vector<uint64_t> values(quantiles.size(), 0);
+    if (total == 0) {
+        return values;
+    }
+    for (size_t i = 0; i < quantiles.size(); ++i) {
+        double q = std::min(std::max(quantiles[i], 0.0), 1.0);
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * total)));
+        uint64_t seen = 0;
+        for (int j = 0; j < kNumBuckets; ++j) {
+            seen += counts[j];
+            if (seen >= rank) {
+                values[i] = std::min(bucket_upper_bound(j), max_value);
+                break;
+            }
+        }
+    }
+    return values;
+}
+
+static const char* const kQuantileNames[] = {"p50", "p90", "p99", "p999"};
+
+const std::vector<double>& HistogramMetric::exported_quantiles() {
+    static const std::vector<double> quantiles{0.5, 0.9, 0.99, 0.999};
+    return quantiles;
+}
+
+std::string HistogramMetric::to_string() const {
+    std::stringstream ss;
+    ss << "count=" << count() << " sum=" << sum() << " max=" << max();
+    auto values = percentiles(exported_quantiles());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ss << " " << kQuantileNames[i] << "=" << values[i];
+    }
+    return ss.str();
+}
+
+void HistogramMetric::write_value(rj::Value& metric_obj, rj::Document::AllocatorType& allocator) {
+    metric_obj.AddMember("count", rj::Value(count()), allocator);
+    metric_obj.AddMember("sum", rj::Value(sum()), allocator);
+    metric_obj.AddMember("max", rj::Value(max()), allocator);
+    auto values = percentiles(exported_quantiles());
+    for (size_t i = 0; i < values.size(); ++i) {
+        metric_obj.AddMember(rj::StringRef(kQuantileNames[i]), rj::Value(values[i]), allocator);
+    }
+}
+
 void Metric::hide() {
     if (_registry == nullptr) {
         return;
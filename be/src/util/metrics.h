@@ -33,11 +33,13 @@ DIAGNOSTIC_POP
 #include <atomic>
 #include <functional>
 #include <iomanip>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "common/config.h"
 #include "util/core_local.h"
@@ -181,6 +183,53 @@ protected:
     CoreLocalValue<T> _value;
 };
 
+// HistogramMetric records the distribution of the values, e.g. the latencies, to report the percentiles which
+// the averages hide. Like HdrHistogram, the values are counted in the log-linear buckets: each power of two is
+// split into 2^kSubBucketBits buckets, so a percentile is reported within 25% above the real value. The
+// buckets are sharded by the core like CoreLocalCounter, and updated by the relaxed atomic adds without locks.
+class HistogramMetric : public Metric {
+public:
+    static constexpr int kSubBucketBits = 2;
+    static constexpr int kNumBuckets = (64 - kSubBucketBits + 1) << kSubBucketBits;
+
+    explicit HistogramMetric(MetricUnit unit);
+    ~HistogramMetric() override;
+
+    void add(uint64_t value);
+
+    uint64_t count() const;
+    uint64_t sum() const;
+    uint64_t max() const;
+
+    // The value at |quantile| in [0, 1], which is the upper bound of the bucket it falls in and at most the max
+    // value, or 0 if no value is added.
+    uint64_t percentile(double quantile) const { return percentiles({quantile})[0]; }
+    std::vector<uint64_t> percentiles(const std::vector<double>& quantiles) const;
+
+    // e.g. count=3 sum=60 max=30 p50=20 p90=30 p99=30 p999=30
+    std::string to_string() const override;
+    void write_value(rj::Value& metric_obj, rj::Document::AllocatorType& allocator) override;
+
+    // The quantiles exported.
+    static const std::vector<double>& exported_quantiles();
+
+    static int bucket_index(uint64_t value);
+    // The max value counted in the bucket |index|.
+    static uint64_t bucket_upper_bound(int index);
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::atomic<uint64_t> counts[kNumBuckets];
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+    };
+
+    Shard* _local_shard() const;
+
+    size_t _num_shards;
+    std::unique_ptr<Shard[]> _shards;
+};
+
 template <typename T>
 class AtomicCounter : public AtomicMetric<T> {
 public:
@@ -434,3 +483,6 @@ private:
 
 #define METRIC_DEFINE_TCMALLOC_GAUGE(metric_name, tcmalloc_var) \
     starrocks::TcmallocMetric metric_name { tcmalloc_var }
+
+#define METRIC_DEFINE_HISTOGRAM(metric_name, unit) \
+    starrocks::HistogramMetric metric_name { unit }
@@ -23,6 +23,15 @@ public:
 
     void add(float value) { _tdigest.add(value); }
 
+    void add(const float* values, size_t size) { _tdigest.add(values, size); }
+
+    // Merge the buffered values into the centroids, which makes the serialized digest smaller.
+    void compress() {
+        if (_tdigest.haveUnprocessed()) {
+            _tdigest.compress();
+        }
+    }
+
     void merge(const PercentileValue* other) { _tdigest.merge(&other->_tdigest); }
 
     uint64_t serialize_size() const {
@@ -2584,6 +2584,17 @@ public:
         inner.set_.clear();
     }
 
+    // extension - access the internal submaps by index under the lock protection
+    // ex: m.with_submap(i, [&](const Map::EmbeddedSet& set) {
+    //        for (auto& p : set) { ...; }});
+    // ----------------------------------------
+    template <class F>
+    void with_submap(size_t idx, F&& fCallback) const {
+        const Inner& inner = sets_[idx];
+        typename Lockable::SharedLock m(const_cast<Inner&>(inner));
+        fCallback(inner.set_);
+    }
+
     // This overload kicks in when the argument is an rvalue of insertable and
     // decomposable type other than init_type.
     //
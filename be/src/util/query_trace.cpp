@@ -0,0 +1,133 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/query_trace.h"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "common/compiler_util.h"
+
+namespace starrocks {
+
+QueryTrace* QueryTrace::instance() {
+    static QueryTrace s_instance;
+    return &s_instance;
+}
+
+QueryTrace::ThreadBufferHolder::~ThreadBufferHolder() {
+    if (buffer != nullptr) {
+        QueryTrace::instance()->_release_buffer(buffer);
+    }
+}
+
+QueryTrace::ThreadBuffer* QueryTrace::_local_buffer() {
+    static thread_local ThreadBufferHolder holder;
+    if (UNLIKELY(holder.buffer == nullptr)) {
+        holder.buffer = _acquire_buffer();
+    }
+    return holder.buffer;
+}
+
+QueryTrace::ThreadBuffer* QueryTrace::_acquire_buffer() {
+    std::lock_guard<std::mutex> l(_lock);
+    ThreadBuffer* buffer = nullptr;
+    for (auto& b : _buffers) {
+        if (!b->owned) {
+            buffer = b.get();
+            break;
+        }
+    }
+    if (buffer == nullptr) {
+        _buffers.emplace_back(new ThreadBuffer());
+        buffer = _buffers.back().get();
+    }
+    std::lock_guard<std::mutex> bl(buffer->lock);
+    // drop the spans of the previous owner, which are labeled by its tid
+    buffer->events.resize(std::max(1, config::query_trace_buffer_size));
+    buffer->num_added = 0;
+    buffer->tid = syscall(SYS_gettid);
+    buffer->owned = true;
+    return buffer;
+}
+
+void QueryTrace::_release_buffer(ThreadBuffer* buffer) {
+    std::lock_guard<std::mutex> l(_lock);
+    buffer->owned = false;
+}
+
+void QueryTrace::add(int64_t query_hi, const char* category, const char* name, int64_t start_ns, int64_t duration_ns,
+                     int64_t id) {
+    ThreadBuffer* buffer = _local_buffer();
+    std::lock_guard<std::mutex> l(buffer->lock);
+    QueryTraceEvent& event = buffer->events[buffer->num_added++ % buffer->events.size()];
+    event.query_hi = query_hi;
+    event.category = category;
+    event.name = name;
+    event.start_ns = start_ns;
+    event.duration_ns = duration_ns;
+    event.id = id;
+}
+
+// e.g.
+// {"traceEvents":[{"name":"driver","cat":"pipeline","ph":"X","ts":1024.5,"dur":100.0,"pid":0,"tid":1234,
+//  "args":{"id":3}}],"displayTimeUnit":"ns"}
+// the timestamps are in microseconds
+std::string QueryTrace::to_chrome_trace(const TUniqueId& query_id) {
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+    std::vector<QueryTraceEvent> events;
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto& buffer : _buffers) {
+        int64_t tid;
+        {
+            std::lock_guard<std::mutex> bl(buffer->lock);
+            size_t n = std::min<uint64_t>(buffer->num_added, buffer->events.size());
+            events.clear();
+            for (size_t i = 0; i < n; ++i) {
+                if (buffer->events[i].query_hi == query_id.hi) {
+                    events.push_back(buffer->events[i]);
+                }
+            }
+            tid = buffer->tid;
+        }
+        for (const auto& event : events) {
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(event.name);
+            writer.Key("cat");
+            writer.String(event.category);
+            writer.Key("ph");
+            writer.String("X");
+            writer.Key("ts");
+            writer.Double(event.start_ns / 1000.0);
+            writer.Key("dur");
+            writer.Double(event.duration_ns / 1000.0);
+            writer.Key("pid");
+            writer.Int(0);
+            writer.Key("tid");
+            writer.Int64(tid);
+            if (event.id >= 0) {
+                writer.Key("args");
+                writer.StartObject();
+                writer.Key("id");
+                writer.Int64(event.id);
+                writer.EndObject();
+            }
+            writer.EndObject();
+        }
+    }
+    writer.EndArray();
+    writer.Key("displayTimeUnit");
+    writer.String("ns");
+    writer.EndObject();
+    return buf.GetString();
+}
+
+} // namespace starrocks
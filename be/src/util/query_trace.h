@@ -0,0 +1,114 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "gen_cpp/Types_types.h"
+#include "gutil/macros.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+struct QueryTraceEvent {
+    // the high bits of the query id
+    int64_t query_hi = 0;
+    // the static strings naming the span
+    const char* category = nullptr;
+    const char* name = nullptr;
+    int64_t start_ns = 0;
+    int64_t duration_ns = 0;
+    // e.g. the driver id or the tablet id, -1 if none
+    int64_t id = -1;
+};
+
+// QueryTrace records the timestamped spans of the queries, e.g. the fragment prepare, the time slices of the
+// drivers, the scans, the rpcs and the spills, to show the scheduling gaps and the stragglers among the drivers
+// which the profile sums up.
+//
+// Each thread adds the spans into a ring buffer of its own, so adding a span takes an uncontended lock only. The
+// buffers of the exited threads are reused by the new ones.
+//
+// The spans are keyed by the high bits of the query id, which are shared by the ids of the fragment instances of
+// the query, so the spans having only a fragment instance id, e.g. the rpcs of the data streams, are traced too.
+class QueryTrace {
+public:
+    static QueryTrace* instance();
+
+    static bool enabled() { return config::enable_query_trace; }
+
+    void add(int64_t query_hi, const char* category, const char* name, int64_t start_ns, int64_t duration_ns,
+             int64_t id);
+
+    // The spans kept of the query, in the json format of the chrome trace events, which can be opened by
+    // chrome://tracing or perfetto.
+    std::string to_chrome_trace(const TUniqueId& query_id);
+
+private:
+    struct ThreadBuffer {
+        // taken by the owner thread to add the spans and the exporter to read them
+        std::mutex lock;
+        std::vector<QueryTraceEvent> events;
+        // the number of the events ever added since the buffer is acquired by the thread
+        uint64_t num_added = 0;
+        int64_t tid = 0;
+        bool owned = false;
+    };
+
+    // Releases the buffer of the thread when it exits.
+    struct ThreadBufferHolder {
+        ~ThreadBufferHolder();
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    QueryTrace() = default;
+
+    ThreadBuffer* _local_buffer();
+    ThreadBuffer* _acquire_buffer();
+    void _release_buffer(ThreadBuffer* buffer);
+
+    // _lock protects _buffers and the owned of them.
+    std::mutex _lock;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+
+    DISALLOW_COPY_AND_ASSIGN(QueryTrace);
+};
+
+// Adds a span of the scope into QueryTrace if it's enabled.
+class ScopedQueryTrace {
+public:
+    // |query_hi| is the high bits of the query id or a fragment instance id of it.
+    ScopedQueryTrace(int64_t query_hi, const char* category, const char* name, int64_t span_id = -1)
+            : _query_hi(query_hi), _category(category), _name(name), _span_id(span_id) {
+        if (QueryTrace::enabled()) {
+            _start_ns = MonotonicNanos();
+        }
+    }
+
+    ScopedQueryTrace(const TUniqueId& id, const char* category, const char* name, int64_t span_id = -1)
+            : ScopedQueryTrace(id.hi, category, name, span_id) {}
+
+    ~ScopedQueryTrace() {
+        if (_start_ns > 0) {
+            QueryTrace::instance()->add(_query_hi, _category, _name, _start_ns, MonotonicNanos() - _start_ns,
+                                        _span_id);
+        }
+    }
+
+private:
+    int64_t _query_hi;
+    const char* _category;
+    const char* _name;
+    int64_t _span_id;
+    int64_t _start_ns = 0;
+};
+
+#define SCOPED_QUERY_TRACE(id, category, name, ...) \
+    ScopedQueryTrace VARNAME_LINENUM(query_trace)(id, category, name, ##__VA_ARGS__)
+
+} // namespace starrocks
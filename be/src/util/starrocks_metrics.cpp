@@ -39,6 +39,9 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     // You can put StarRocksMetrics's metrics initial code here
     REGISTER_STARROCKS_METRIC(fragment_requests_total);
     REGISTER_STARROCKS_METRIC(fragment_request_duration_us);
+    REGISTER_STARROCKS_METRIC(fragment_admission_queued_total);
+    REGISTER_STARROCKS_METRIC(fragment_admission_rejected_total);
+    REGISTER_STARROCKS_METRIC(fragment_admission_timeout_total);
     REGISTER_STARROCKS_METRIC(http_requests_total);
     REGISTER_STARROCKS_METRIC(http_request_send_bytes);
     REGISTER_STARROCKS_METRIC(query_scan_bytes);
@@ -53,6 +56,8 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     REGISTER_STARROCKS_METRIC(update_rowset_commit_apply_duration_us);
     REGISTER_STARROCKS_METRIC(update_primary_index_num);
     REGISTER_STARROCKS_METRIC(update_primary_index_bytes_total);
+    REGISTER_STARROCKS_METRIC(update_primary_index_prewarm_pending);
+    REGISTER_STARROCKS_METRIC(update_primary_index_prewarm_loaded);
     REGISTER_STARROCKS_METRIC(update_del_vector_num);
     REGISTER_STARROCKS_METRIC(update_del_vector_dels_num);
     REGISTER_STARROCKS_METRIC(update_del_vector_bytes_total);
@@ -129,6 +134,7 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
                              &meta_write_request_duration_us);
     _metrics.register_metric("meta_request_duration", MetricLabels().add("type", "read"),
                              &meta_read_request_duration_us);
+    REGISTER_STARROCKS_METRIC(meta_write_group_commit_total);
 
     _metrics.register_metric("segment_read", MetricLabels().add("type", "segment_total_read_times"),
                              &segment_read_total);
@@ -148,6 +154,17 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     _metrics.register_metric("load_rows", &load_rows_total);
     _metrics.register_metric("load_bytes", &load_bytes_total);
 
+    REGISTER_STARROCKS_METRIC(fragment_request_latency_us);
+    REGISTER_STARROCKS_METRIC(tablet_scan_latency_us);
+    REGISTER_STARROCKS_METRIC(page_read_latency_us);
+    REGISTER_STARROCKS_METRIC(compaction_latency_us);
+    _metrics.register_metric("brpc_request_latency_us", MetricLabels().add("method", "exec_plan_fragment"),
+                             &exec_plan_fragment_latency_us);
+    _metrics.register_metric("brpc_request_latency_us", MetricLabels().add("method", "transmit_chunk"),
+                             &transmit_chunk_latency_us);
+    _metrics.register_metric("brpc_request_latency_us", MetricLabels().add("method", "tablet_writer_add_chunk"),
+                             &tablet_writer_add_chunk_latency_us);
+
     // Gauge
     REGISTER_STARROCKS_METRIC(memory_pool_bytes_total);
     REGISTER_STARROCKS_METRIC(process_thread_num);
@@ -60,6 +60,9 @@ public:
     // counters
     METRIC_DEFINE_INT_COUNTER(fragment_requests_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(fragment_request_duration_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_INT_COUNTER(fragment_admission_queued_total, MetricUnit::REQUESTS);
+    METRIC_DEFINE_INT_COUNTER(fragment_admission_rejected_total, MetricUnit::REQUESTS);
+    METRIC_DEFINE_INT_COUNTER(fragment_admission_timeout_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(http_requests_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(http_request_send_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_COUNTER(query_scan_bytes, MetricUnit::BYTES);
@@ -117,6 +120,7 @@ public:
 
     METRIC_DEFINE_INT_COUNTER(meta_write_request_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(meta_write_request_duration_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_INT_COUNTER(meta_write_group_commit_total, MetricUnit::OPERATIONS);
     METRIC_DEFINE_INT_COUNTER(meta_read_request_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(meta_read_request_duration_us, MetricUnit::MICROSECONDS);
 
@@ -149,12 +153,25 @@ public:
     METRIC_DEFINE_INT_COUNTER(update_rowset_commit_apply_duration_us, MetricUnit::MICROSECONDS);
     METRIC_DEFINE_UINT_GAUGE(update_primary_index_num, MetricUnit::OPERATIONS);
     METRIC_DEFINE_UINT_GAUGE(update_primary_index_bytes_total, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_GAUGE(update_primary_index_prewarm_pending, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_UINT_COUNTER(update_primary_index_prewarm_loaded, MetricUnit::OPERATIONS);
     METRIC_DEFINE_UINT_GAUGE(update_del_vector_num, MetricUnit::OPERATIONS);
     METRIC_DEFINE_UINT_GAUGE(update_del_vector_dels_num, MetricUnit::OPERATIONS);
     METRIC_DEFINE_UINT_GAUGE(update_del_vector_bytes_total, MetricUnit::BYTES);
     METRIC_DEFINE_UINT_COUNTER(update_del_vector_deletes_total, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_COUNTER(update_del_vector_deletes_new, MetricUnit::NOUNIT);
 
+    // Histograms of the latencies, exported as the percentiles
+    METRIC_DEFINE_HISTOGRAM(fragment_request_latency_us, MetricUnit::MICROSECONDS);
+    // the time to scan a tablet by an olap scanner
+    METRIC_DEFINE_HISTOGRAM(tablet_scan_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(page_read_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(compaction_latency_us, MetricUnit::MICROSECONDS);
+    // the time to handle the brpc requests of the methods
+    METRIC_DEFINE_HISTOGRAM(exec_plan_fragment_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(transmit_chunk_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_HISTOGRAM(tablet_writer_add_chunk_latency_us, MetricUnit::MICROSECONDS);
+
     // Gauges
     METRIC_DEFINE_INT_GAUGE(memory_pool_bytes_total, MetricUnit::BYTES);
     METRIC_DEFINE_INT_GAUGE(process_thread_num, MetricUnit::NOUNIT);
@@ -204,6 +221,8 @@ public:
     METRIC_DEFINE_UINT_GAUGE(fragment_endpoint_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(active_scan_context_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(plan_fragment_count, MetricUnit::NOUNIT);
+    METRIC_DEFINE_UINT_GAUGE(fragment_admission_queue_length, MetricUnit::NOUNIT);
+    METRIC_DEFINE_INT_GAUGE(fragment_admission_reserved_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_UINT_GAUGE(load_channel_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(result_buffer_block_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(result_block_queue_count, MetricUnit::NOUNIT);
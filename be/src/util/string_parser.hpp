@@ -189,6 +189,23 @@ private:
     template <typename T>
     static inline T string_to_int_no_overflow(const char* s, int len, ParseResult* result);
 
+    // Whether the 8 chars loaded into |chunk| are all ascii digits.
+    static inline bool is_eight_digits(uint64_t chunk) {
+        return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+               0x3333333333333333ULL;
+    }
+
+    // Converts the 8 ascii digits loaded into |chunk| on the little endian machines, by multiplying the adjacent
+    // digits, then the adjacent pairs and the adjacent quads in parallel, instead of 8 multiply-adds in sequence.
+    static inline uint32_t eight_digits_to_int(uint64_t chunk) {
+        chunk -= 0x3030303030303030ULL;
+        chunk = (chunk * 10) + (chunk >> 8);
+        chunk = (((chunk & 0x000000FF000000FFULL) * 0x000F424000000064ULL) +
+                 (((chunk >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >>
+                32;
+        return static_cast<uint32_t>(chunk);
+    }
+
     // This is considerably faster than glibc's implementation (>100x why???)
     // No special case handling needs to be done for overflows, the floating point spec
     // already does it and will cap the values to -inf/inf
@@ -399,14 +416,29 @@ inline T StringParser::string_to_int_no_overflow(const char* s, int len, ParseRe
         *result = PARSE_SUCCESS;
         return val;
     }
-    // Factor out the first char for error handling speeds up the loop.
-    if (LIKELY(s[0] >= '0' && s[0] <= '9')) {
-        val = s[0] - '0';
-    } else {
-        *result = PARSE_FAILURE;
-        return 0;
+    int i = 0;
+    if constexpr (sizeof(T) >= sizeof(uint32_t)) {
+        // Convert 8 digits at a time until the chars left are fewer or not all digits, e.g. trailing whitespaces.
+        for (; i + 8 <= len; i += 8) {
+            uint64_t chunk;
+            memcpy(&chunk, s + i, sizeof(chunk));
+            if (!is_eight_digits(chunk)) {
+                break;
+            }
+            val = val * 100000000 + eight_digits_to_int(chunk);
+        }
+    }
+    if (i == 0) {
+        // Factor out the first char for error handling speeds up the loop.
+        if (LIKELY(s[0] >= '0' && s[0] <= '9')) {
+            val = s[0] - '0';
+        } else {
+            *result = PARSE_FAILURE;
+            return 0;
+        }
+        i = 1;
     }
-    for (int i = 1; i < len; ++i) {
+    for (; i < len; ++i) {
         if (LIKELY(s[i] >= '0' && s[i] <= '9')) {
             T digit = s[i] - '0';
             val = val * 10 + digit;
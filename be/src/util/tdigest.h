@@ -420,6 +420,23 @@ public:
         return true;
     }
 
+    // add a batch of values, which are buffered in the unprocessed vector and sorted and merged with the processed
+    // centroids in one pass whenever the buffer is full.
+    void add(const Value* values, size_t size) {
+        _unprocessed.reserve(std::min(_unprocessed.size() + size, _max_unprocessed));
+        for (size_t i = 0; i < size; i++) {
+            if (std::isnan(values[i])) {
+                continue;
+            }
+            _unprocessed.emplace_back(values[i], 1);
+            _unprocessed_weight += 1;
+            if (_unprocessed.size() >= _max_unprocessed) {
+                process();
+            }
+        }
+        processIfNecessary();
+    }
+
     inline void add(std::vector<Centroid>::const_iterator iter, std::vector<Centroid>::const_iterator end) {
         while (iter != end) {
             const size_t diff = std::distance(iter, end);
@@ -432,9 +449,11 @@ public:
         }
     }
 
+    // The cumulative weights are not serialized but rebuilt from the processed centroids by deserialize(), only
+    // their size 0 is kept to be compatible with the digests serialized with them.
     uint64_t serialize_size() const {
-        return sizeof(Value) * 5 + sizeof(Index) * 2 + sizeof(size_t) * 3 + _processed.size() * sizeof(Centroid) +
-               _unprocessed.size() * sizeof(Centroid) + _cumulative.size() * sizeof(Weight);
+        return sizeof(Value) * 5 + sizeof(Index) * 2 + sizeof(uint32_t) * 3 + _processed.size() * sizeof(Centroid) +
+               _unprocessed.size() * sizeof(Centroid);
     }
 
     size_t serialize(uint8_t* writer) const {
@@ -469,13 +488,8 @@ public:
             writer += sizeof(Centroid);
         }
 
-        size = _cumulative.size();
+        size = 0;
         memcpy(writer, &size, sizeof(uint32_t));
-        writer += sizeof(uint32_t);
-        for (int i = 0; i < size; i++) {
-            memcpy(writer, &_cumulative[i], sizeof(Weight));
-            writer += sizeof(Weight);
-        }
 
         return serialize_size();
     }
@@ -519,6 +533,9 @@ public:
             memcpy(&_cumulative[i], type_reader, sizeof(Weight));
             type_reader += sizeof(Weight);
         }
+        if (_cumulative.empty() && !_processed.empty()) {
+            updateCumulative();
+        }
     }
 
 private:
@@ -199,6 +199,9 @@ public:
         return _num_threads + _num_threads_pending_start;
     }
 
+    // Return the maximum number of threads of this thread pool.
+    int max_threads() const { return _max_threads; }
+
 private:
     friend class ThreadPoolBuilder;
     friend class ThreadPoolToken;
@@ -245,6 +245,33 @@ PARALLEL_TEST(BinaryColumnTest, test_filter_range) {
     ASSERT_EQ(data[64], "c");
 }
 
+// NOLINTNEXTLINE
+PARALLEL_TEST(BinaryColumnTest, test_filter_range_runs) {
+    // the runs of the surviving rows start and end inside and across the bitmaps of 64 rows.
+    for (int percent : {0, 5, 50, 95, 100}) {
+        auto column = BinaryColumn::create();
+        std::vector<std::string> values;
+        Buffer<uint8_t> filter;
+        for (size_t i = 0; i < 1000; i++) {
+            values.emplace_back(std::string(i % 7, 'a' + i % 26));
+            column->append(Slice(values.back()));
+            filter.emplace_back((i * 37 + i / 64) % 100 < percent);
+        }
+        std::vector<std::string> expected(values.begin(), values.begin() + 3);
+        for (size_t i = 3; i < values.size(); i++) {
+            if (filter[i]) {
+                expected.emplace_back(values[i]);
+            }
+        }
+
+        ASSERT_EQ(expected.size(), column->filter_range(filter, 3, values.size()));
+        ASSERT_EQ(expected.size(), column->size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQ(expected[i], column->get_slice(i).to_string());
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 PARALLEL_TEST(BinaryColumnTest, test_resize) {
     auto c = BinaryColumn::create();
@@ -495,4 +522,25 @@ PARALLEL_TEST(BinaryColumnTest, test_clone_empty) {
     ASSERT_EQ(0, c2->size());
 }
 
+// NOLINTNEXTLINE
+PARALLEL_TEST(BinaryColumnTest, test_string_views) {
+    auto c1 = BinaryColumn::create();
+    c1->append_string("abc");
+    c1->append_string("starrocks_starrocks");
+    const auto& views = c1->get_string_views();
+    ASSERT_EQ(2, views.size());
+    ASSERT_EQ("abc", views[0].to_slice());
+    ASSERT_EQ("starrocks_starrocks", views[1].to_slice());
+
+    // The views are rebuilt after the column changes.
+    c1->append_string("def");
+    c1->get_bytes().reserve(c1->get_bytes().capacity() * 4);
+    c1->invalidate_slice_cache();
+    const auto& new_views = c1->get_string_views();
+    ASSERT_EQ(3, new_views.size());
+    ASSERT_EQ("starrocks_starrocks", new_views[1].to_slice());
+    ASSERT_EQ("def", new_views[2].to_slice());
+    ASSERT_LT(new_views[0].compare(new_views[2]), 0);
+}
+
 } // namespace starrocks::vectorized
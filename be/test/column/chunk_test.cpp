@@ -173,6 +173,41 @@ TEST_F(ChunkTest, test_serde) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_serde_v2) {
+    auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
+
+    std::string buffer;
+    size_t size = chunk->serialize(&buffer, Chunk::kSerdeVersion2);
+    ASSERT_EQ(buffer.size(), size);
+
+    RuntimeChunkMeta meta;
+    meta.slot_id_to_index.init(2);
+    meta.slot_id_to_index.insert(0, 0);
+    meta.slot_id_to_index.insert(1, 1);
+    meta.is_nulls.resize(2, false);
+    meta.is_consts.resize(2, false);
+    meta.types.resize(2);
+    meta.types[0] = TypeDescriptor(PrimitiveType::TYPE_INT);
+    meta.types[1] = TypeDescriptor(PrimitiveType::TYPE_INT);
+
+    std::unique_ptr<Chunk> new_chunk = chunk->clone_empty_with_schema();
+    ASSERT_TRUE(new_chunk->deserialize((uint8_t*)buffer.data(), buffer.size(), meta).ok());
+
+    ASSERT_EQ(new_chunk->num_rows(), chunk->num_rows());
+    for (size_t i = 0; i < chunk->columns().size(); ++i) {
+        ASSERT_EQ(chunk->columns()[i]->size(), new_chunk->columns()[i]->size());
+        for (size_t j = 0; j < chunk->columns()[i]->size(); ++j) {
+            ASSERT_EQ(chunk->columns()[i]->get(j).get_int32(), new_chunk->columns()[i]->get(j).get_int32());
+        }
+    }
+
+    // The unknown versions are rejected.
+    buffer[0] = 3;
+    new_chunk = chunk->clone_empty_with_schema();
+    ASSERT_FALSE(new_chunk->deserialize((uint8_t*)buffer.data(), buffer.size(), meta).ok());
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunkTest, test_copy_one_row) {
     auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
@@ -251,4 +286,85 @@ TEST_F(ChunkTest, test_append_chunk_safe) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_select) {
+    auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
+    Column::Filter filter(100, 0);
+    for (size_t i = 0; i < 100; i += 3) {
+        filter[i] = 1;
+    }
+    chunk->select(filter);
+    ASSERT_TRUE(chunk->has_selection());
+    ASSERT_EQ(100, chunk->num_rows());
+    ASSERT_EQ(34, chunk->num_selected_rows());
+
+    // The second filter narrows the selection, the rows out of it are ignored.
+    filter.assign(100, 1);
+    filter[3] = 0;
+    filter[4] = 0;
+    chunk->select(filter);
+    ASSERT_EQ(33, chunk->num_selected_rows());
+    ASSERT_EQ(0, chunk->selection()[0]);
+    ASSERT_EQ(6, chunk->selection()[1]);
+
+    chunk->materialize_selection();
+    ASSERT_FALSE(chunk->has_selection());
+    ASSERT_EQ(33, chunk->num_rows());
+    for (size_t c = 0; c < 2; c++) {
+        const auto* column = down_cast<const FixedLengthColumn<int32_t>*>(chunk->get_column_by_index(c).get());
+        ASSERT_EQ(static_cast<int32_t>(c), column->get_data()[0]);
+        for (size_t i = 1; i < 33; i++) {
+            ASSERT_EQ(static_cast<int32_t>(c + (i + 1) * 3), column->get_data()[i]);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_select_none) {
+    auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
+    chunk->select(Column::Filter(100, 0));
+    ASSERT_FALSE(chunk->has_selection());
+    ASSERT_EQ(0, chunk->num_rows());
+    ASSERT_EQ(0, chunk->num_selected_rows());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_filter_with_selection) {
+    auto chunk = std::make_unique<Chunk>(make_columns(1), make_schema(1));
+    Column::Filter filter(100, 0);
+    for (size_t i = 0; i < 50; i++) {
+        filter[i] = 1;
+    }
+    chunk->select(filter);
+
+    filter.assign(100, 0);
+    for (size_t i = 40; i < 100; i++) {
+        filter[i] = 1;
+    }
+    ASSERT_EQ(10, chunk->filter(filter));
+    ASSERT_FALSE(chunk->has_selection());
+    const auto& data = down_cast<const FixedLengthColumn<int32_t>*>(chunk->get_column_by_index(0).get())->get_data();
+    for (size_t i = 0; i < 10; i++) {
+        ASSERT_EQ(static_cast<int32_t>(40 + i), data[i]);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_materialize_shared_column) {
+    auto chunk = std::make_shared<Chunk>();
+    auto column = make_column(0);
+    chunk->append_column(column, 0);
+    chunk->append_column(column, 1);
+
+    Buffer<uint32_t> selection{1, 2, 99};
+    chunk->set_selection(selection);
+    ASSERT_EQ(3, chunk->num_selected_rows());
+    chunk->materialize_selection();
+    ASSERT_EQ(3, chunk->num_rows());
+    const auto& data = down_cast<const FixedLengthColumn<int32_t>*>(column.get())->get_data();
+    ASSERT_EQ(1, data[0]);
+    ASSERT_EQ(2, data[1]);
+    ASSERT_EQ(99, data[2]);
+}
+
 } // namespace starrocks::vectorized
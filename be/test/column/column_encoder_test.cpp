@@ -0,0 +1,154 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/column_encoder.h"
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/const_column.h"
+#include "column/dict_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "testutil/parallel_test.h"
+
+namespace starrocks::vectorized {
+
+// Encode |src| and decode it into |dst|, return the encoding.
+static ColumnEncoder::Encoding encode_and_decode(const Column& src, Column* dst) {
+    std::string buffer;
+    ColumnEncoder::encode(src, &buffer);
+    const auto* begin = reinterpret_cast<const uint8_t*>(buffer.data());
+    EXPECT_EQ(begin + buffer.size(), ColumnEncoder::decode(begin, dst));
+    return static_cast<ColumnEncoder::Encoding>(buffer[0]);
+}
+
+static void check_equal(const Column& expected, const Column& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected.debug_item(i), actual.debug_item(i)) << "row " << i;
+    }
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnEncoderTest, test_fixed_length) {
+    auto src = Int32Column::create();
+    for (int32_t i = 0; i < 100; i++) {
+        src->append(i);
+    }
+    auto dst = Int32Column::create();
+    ASSERT_EQ(ColumnEncoder::kPlain, encode_and_decode(*src, dst.get()));
+    check_equal(*src, *dst);
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnEncoderTest, test_constant) {
+    // A constant column.
+    auto data = Int64Column::create();
+    data->append(7);
+    auto src = ConstColumn::create(data, 1000);
+    auto dst = ConstColumn::create(Int64Column::create());
+    ASSERT_EQ(ColumnEncoder::kConstant, encode_and_decode(*src, dst.get()));
+    ASSERT_EQ(1000, dst->size());
+    ASSERT_EQ(7, dst->get(999).get_int64());
+
+    // A column of the same strings.
+    auto strings = BinaryColumn::create();
+    Slice city("shanghai");
+    strings->append_value_multiple_times(&city, 1000);
+    auto dst_strings = BinaryColumn::create();
+    ASSERT_EQ(ColumnEncoder::kConstant, encode_and_decode(*strings, dst_strings.get()));
+    check_equal(*strings, *dst_strings);
+
+    // A column of all nulls.
+    auto nulls = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    nulls->append_nulls(100);
+    auto dst_nulls = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    ASSERT_EQ(ColumnEncoder::kConstant, encode_and_decode(*nulls, dst_nulls.get()));
+    ASSERT_EQ(100, dst_nulls->size());
+    ASSERT_TRUE(dst_nulls->has_null());
+    ASSERT_TRUE(dst_nulls->is_null(99));
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnEncoderTest, test_nullable) {
+    auto src = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    for (int32_t i = 0; i < 100; i++) {
+        if (i % 3 == 0) {
+            src->append_nulls(1);
+        } else {
+            src->append_datum(i);
+        }
+    }
+    auto dst = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    ASSERT_EQ(ColumnEncoder::kNullable, encode_and_decode(*src, dst.get()));
+    ASSERT_TRUE(dst->has_null());
+    check_equal(*src, *dst);
+
+    auto no_null = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    for (int32_t i = 0; i < 100; i++) {
+        no_null->append_datum(i);
+    }
+    dst = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    ASSERT_EQ(ColumnEncoder::kNullable, encode_and_decode(*no_null, dst.get()));
+    ASSERT_FALSE(dst->has_null());
+    check_equal(*no_null, *dst);
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnEncoderTest, test_binary) {
+    auto src = BinaryColumn::create();
+    for (int32_t i = 0; i < 100; i++) {
+        src->append_string(std::string(i * 10, 'a' + i % 26));
+    }
+    auto dst = BinaryColumn::create();
+    std::string buffer;
+    ColumnEncoder::encode(*src, &buffer);
+    ASSERT_EQ(ColumnEncoder::kBinary, buffer[0]);
+    // The lengths are less than 2^16.
+    ASSERT_EQ(sizeof(uint16_t), buffer[5]);
+    ASSERT_EQ(reinterpret_cast<const uint8_t*>(buffer.data() + buffer.size()),
+              ColumnEncoder::decode(reinterpret_cast<const uint8_t*>(buffer.data()), dst.get()));
+    check_equal(*src, *dst);
+    ASSERT_EQ(std::string(990, 'a' + 99 % 26), dst->get_slice(99).to_string());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnEncoderTest, test_dict) {
+    auto src = BinaryColumn::create();
+    const std::vector<std::string> cities{"beijing", "shanghai", "shenzhen", "hangzhou"};
+    for (int32_t i = 0; i < 1000; i++) {
+        src->append_string(cities[i % cities.size()]);
+    }
+    auto dst = BinaryColumn::create();
+    ASSERT_EQ(ColumnEncoder::kDict, encode_and_decode(*src, dst.get()));
+    check_equal(*src, *dst);
+
+    // A DictColumn is decoded into a BinaryColumn.
+    auto strings = BinaryColumn::create();
+    for (const auto& city : cities) {
+        strings->append_string(city);
+    }
+    auto dict_column = DictColumn::create(std::make_shared<ColumnDict>(std::move(strings)));
+    for (int32_t i = 0; i < 1000; i++) {
+        dict_column->codes_column()->append(i % 3);
+    }
+    dst = BinaryColumn::create();
+    ASSERT_EQ(ColumnEncoder::kDict, encode_and_decode(*dict_column, dst.get()));
+    check_equal(*dict_column, *dst);
+}
+
+// NOLINTNEXTLINE
+TEST(ColumnEncoderTest, test_dict_disabled) {
+    config::chunk_serde_dict_encoding = false;
+    auto src = BinaryColumn::create();
+    for (int32_t i = 0; i < 1000; i++) {
+        src->append_string(std::to_string(i % 2));
+    }
+    auto dst = BinaryColumn::create();
+    ASSERT_EQ(ColumnEncoder::kBinary, encode_and_decode(*src, dst.get()));
+    check_equal(*src, *dst);
+    config::chunk_serde_dict_encoding = true;
+}
+
+} // namespace starrocks::vectorized
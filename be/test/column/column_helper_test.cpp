@@ -21,6 +21,9 @@
 
 #include "column/column_helper.h"
 
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 #include "gtest/gtest.h"
 
 namespace starrocks::vectorized {
@@ -31,4 +34,49 @@ public:
     virtual void TearDown() {}
 };
 
+// NOLINTNEXTLINE
+TEST_F(ColumnHelperTest, test_mark_adjacent_differences) {
+    auto ints = Int32Column::create();
+    for (int32_t value : {1, 1, 2, 2, 2, 3}) {
+        ints->append(value);
+    }
+    std::vector<uint8_t> differences(5, 0);
+    ColumnHelper::mark_adjacent_differences(*ints, 1, 6, differences.data());
+    ASSERT_EQ((std::vector<uint8_t>{0, 1, 0, 0, 1}), differences);
+
+    // The differences of the columns are merged.
+    auto strings = BinaryColumn::create();
+    for (const char* str : {"a", "b", "b", "b", "c", "c"}) {
+        strings->append(Slice(str));
+    }
+    ColumnHelper::mark_adjacent_differences(*strings, 1, 6, differences.data());
+    ASSERT_EQ((std::vector<uint8_t>{1, 1, 0, 1, 1}), differences);
+
+    // The nulls are equal, whatever their data are.
+    auto nullable = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    nullable->append_datum(Datum(int32_t(1)));
+    ASSERT_TRUE(nullable->append_nulls(1));
+    nullable->append_datum(Datum(int32_t(1)));
+    nullable->append_datum(Datum(int32_t(1)));
+    ASSERT_TRUE(nullable->append_nulls(2));
+    down_cast<Int32Column*>(nullable->mutable_data_column())->get_data()[5] = 7;
+    differences.assign(5, 0);
+    ColumnHelper::mark_adjacent_differences(*nullable, 1, 6, differences.data());
+    ASSERT_EQ((std::vector<uint8_t>{1, 1, 0, 1, 0}), differences);
+
+    // Only the rows from |from| are marked.
+    differences.assign(2, 0);
+    ColumnHelper::mark_adjacent_differences(*ints, 4, 6, differences.data());
+    ASSERT_EQ((std::vector<uint8_t>{0, 1}), differences);
+
+    // 0.0 and -0.0 are equal.
+    auto doubles = DoubleColumn::create();
+    for (double value : {0.0, -0.0, 1.5}) {
+        doubles->append(value);
+    }
+    differences.assign(2, 0);
+    ColumnHelper::mark_adjacent_differences(*doubles, 1, 3, differences.data());
+    ASSERT_EQ((std::vector<uint8_t>{0, 1}), differences);
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,88 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/column_recycler.h"
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "testutil/parallel_test.h"
+
+namespace starrocks::vectorized {
+
+static Columns create_columns() {
+    auto c0 = Int32Column::create();
+    auto c1 = BinaryColumn::create();
+    for (int32_t i = 0; i < 100; i++) {
+        c0->append(i);
+        c1->append_string(std::to_string(i));
+    }
+    return {c0, c1};
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnRecyclerTest, test_reuse_released) {
+    ColumnRecycler recycler;
+    Columns columns = create_columns();
+    const Column* c0 = columns[0].get();
+    size_t capacity = down_cast<Int32Column*>(columns[0].get())->get_data().capacity();
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(columns[0], 1);
+    chunk->append_column(columns[1], 2);
+    recycler.keep(std::move(columns));
+
+    Columns reused;
+    // The chunk is still held by the consumer.
+    ASSERT_FALSE(recycler.reuse(&reused));
+    chunk.reset();
+    ASSERT_TRUE(recycler.reuse(&reused));
+    ASSERT_EQ(0, recycler.num_kept());
+    ASSERT_EQ(2, reused.size());
+    ASSERT_EQ(c0, reused[0].get());
+    ASSERT_EQ(0, reused[0]->size());
+    ASSERT_EQ(0, reused[1]->size());
+    ASSERT_EQ(capacity, down_cast<Int32Column*>(reused[0].get())->get_data().capacity());
+    ASSERT_FALSE(recycler.reuse(&reused));
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnRecyclerTest, test_column_shared_by_consumer) {
+    ColumnRecycler recycler;
+    Columns columns = create_columns();
+    // e.g. a projection keeps a column of its input chunk.
+    ColumnPtr projected = columns[1];
+    recycler.keep(std::move(columns));
+
+    Columns reused;
+    ASSERT_FALSE(recycler.reuse(&reused));
+    ASSERT_EQ(100, projected->size());
+    projected.reset();
+    ASSERT_TRUE(recycler.reuse(&reused));
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnRecyclerTest, test_capacity) {
+    ColumnRecycler recycler(2);
+    Columns first = create_columns();
+    const Column* c0 = first[0].get();
+    ColumnPtr held = first[0];
+    recycler.keep(std::move(first));
+    recycler.keep(create_columns());
+    recycler.keep(create_columns());
+    ASSERT_EQ(2, recycler.num_kept());
+    held.reset();
+
+    // The first columns were released by the recycler.
+    Columns reused;
+    ASSERT_TRUE(recycler.reuse(&reused));
+    ASSERT_NE(c0, reused[0].get());
+    ASSERT_TRUE(recycler.reuse(&reused));
+    ASSERT_FALSE(recycler.reuse(&reused));
+
+    ColumnRecycler disabled(0);
+    disabled.keep(create_columns());
+    ASSERT_EQ(0, disabled.num_kept());
+}
+
+} // namespace starrocks::vectorized
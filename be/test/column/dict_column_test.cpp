@@ -0,0 +1,134 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/dict_column.h"
+
+#include <gtest/gtest.h>
+
+#include "column/column_helper.h"
+#include "testutil/parallel_test.h"
+
+namespace starrocks::vectorized {
+
+static ColumnDictPtr create_dict(const std::vector<std::string>& strings) {
+    auto column = BinaryColumn::create();
+    for (const auto& s : strings) {
+        column->append_string(s);
+    }
+    return std::make_shared<ColumnDict>(std::move(column));
+}
+
+static DictColumn::Ptr create_column(const ColumnDictPtr& dict, const std::vector<int32_t>& codes) {
+    auto column = DictColumn::create(dict);
+    for (int32_t code : codes) {
+        column->codes_column()->append(code);
+    }
+    return column;
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(DictColumnTest, test_append) {
+    auto dict = create_dict({"beijing", "shanghai", "shenzhen"});
+    ASSERT_TRUE(dict->is_sorted());
+    ASSERT_EQ(1, dict->find("shanghai"));
+    ASSERT_EQ(-1, dict->find("hangzhou"));
+
+    auto c1 = create_column(dict, {2, 0, 1, 0});
+    auto c2 = DictColumn::create(dict);
+    c2->append(*c1, 1, 3);
+    uint32_t indexes[] = {0, 3};
+    c2->append_selective(*c1, indexes, 0, 2);
+    c2->append_value_multiple_times(*c1, 2, 2);
+    // The codes of the same dictionary are appended as is.
+    ASSERT_EQ(dict, c2->dict());
+    std::vector<int32_t> expected = {0, 1, 0, 2, 0, 1, 1};
+    ASSERT_EQ(expected, c2->codes());
+
+    // The strings out of the dictionary are added to a copy of it.
+    auto strings = BinaryColumn::create();
+    strings->append_string("shenzhen");
+    strings->append_string("hangzhou");
+    c2->append(*strings, 0, 2);
+    c2->append_default();
+    ASSERT_NE(dict, c2->dict());
+    ASSERT_EQ(3, dict->size());
+    ASSERT_EQ(5, c2->dict()->size());
+    ASSERT_EQ(10, c2->size());
+    ASSERT_EQ("shenzhen", c2->get_slice(7));
+    ASSERT_EQ("hangzhou", c2->get_slice(8));
+    ASSERT_EQ("", c2->get_slice(9));
+    ASSERT_EQ("beijing", c2->get_slice(0));
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(DictColumnTest, test_materialize_and_filter) {
+    auto dict = create_dict({"b", "a", "c"});
+    auto column = create_column(dict, {0, 1, 2, 1, 0});
+    Column::Filter filter = {1, 0, 1, 1, 0};
+    ASSERT_EQ(3, column->filter(filter));
+
+    auto strings = column->materialize();
+    ASSERT_EQ(3, strings->size());
+    ASSERT_EQ("b", strings->get_slice(0));
+    ASSERT_EQ("c", strings->get_slice(1));
+    ASSERT_EQ("a", strings->get_slice(2));
+}
+
+static int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(DictColumnTest, test_compare) {
+    auto sorted = create_column(create_dict({"a", "b", "c"}), {2, 0, 1});
+    auto unsorted = create_column(create_dict({"c", "a", "b"}), {0, 1, 2});
+    ASSERT_FALSE(unsorted->dict()->is_sorted());
+    auto strings = sorted->materialize();
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 3; j++) {
+            int expected = sign(strings->compare_at(i, j, *strings, 1));
+            ASSERT_EQ(expected, sign(sorted->compare_at(i, j, *sorted, 1)));
+            ASSERT_EQ(expected, sign(unsorted->compare_at(i, j, *unsorted, 1)));
+            ASSERT_EQ(expected, sign(sorted->compare_at(i, j, *unsorted, 1)));
+            ASSERT_EQ(expected, sign(sorted->compare_at(i, j, *strings, 1)));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(DictColumnTest, test_hash) {
+    auto column = create_column(create_dict({"", "starrocks", "dict"}), {1, 0, 2, 1});
+    auto strings = column->materialize();
+    std::vector<uint32_t> expected(4, 1);
+    std::vector<uint32_t> hashes(4, 1);
+    strings->fvn_hash(expected.data(), 0, 4);
+    column->fvn_hash(hashes.data(), 0, 4);
+    ASSERT_EQ(expected, hashes);
+
+    expected.assign(4, 1);
+    hashes.assign(4, 1);
+    strings->crc32_hash(expected.data(), 0, 4);
+    column->crc32_hash(hashes.data(), 0, 4);
+    ASSERT_EQ(expected, hashes);
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(DictColumnTest, test_serialize) {
+    auto column = create_column(create_dict({"starrocks", "dict"}), {1, 0, 0});
+    std::vector<uint8_t> buffer(column->serialize_size());
+    ASSERT_EQ(buffer.data() + buffer.size(), column->serialize_column(buffer.data()));
+
+    auto dst = DictColumn::create(create_dict({}));
+    ASSERT_EQ(buffer.data() + buffer.size(), dst->deserialize_column(buffer.data()));
+    ASSERT_EQ(column->debug_string(), dst->debug_string());
+
+    // The rows are serialized like the strings of BinaryColumn.
+    std::vector<uint8_t> row(column->max_one_element_serialize_size());
+    auto strings = BinaryColumn::create();
+    for (size_t i = 0; i < column->size(); i++) {
+        column->serialize(i, row.data());
+        strings->deserialize_and_append(row.data());
+    }
+    ASSERT_EQ(column->materialize()->debug_string(), strings->debug_string());
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,81 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/fixed_value_set.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+
+namespace starrocks::vectorized {
+
+TEST(FixedValueSetTest, fixed_array_set) {
+    FixedArraySet<int64_t, 8> set;
+    ASSERT_FALSE(set.init({}));
+    ASSERT_FALSE(set.init({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    ASSERT_TRUE(set.init({5, -3, 1000000}));
+    ASSERT_EQ(3, set.size());
+    ASSERT_EQ(std::vector<int64_t>({5, -3, 1000000}), std::vector<int64_t>(set.begin(), set.end()));
+    ASSERT_TRUE(set.contains(5));
+    ASSERT_TRUE(set.contains(-3));
+    ASSERT_TRUE(set.contains(1000000));
+    ASSERT_FALSE(set.contains(0));
+    ASSERT_FALSE(set.contains(4));
+}
+
+TEST(FixedValueSetTest, dense_bitmap_set) {
+    static_assert(!DenseBitmapSet<bool>::is_supported);
+    static_assert(!DenseBitmapSet<double>::is_supported);
+
+    DenseBitmapSet<int32_t> set;
+    ASSERT_FALSE(set.init({}));
+    ASSERT_FALSE(set.init({0, static_cast<int32_t>(DenseBitmapSet<int32_t>::kMaxBits)}));
+    ASSERT_FALSE(set.init({std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()}));
+
+    std::vector<int32_t> values;
+    for (int32_t v = -1000; v <= 1000; v += 7) {
+        values.emplace_back(v);
+    }
+    ASSERT_TRUE(set.init(values));
+    ASSERT_EQ(values.size(), set.size());
+    for (int32_t v = -2000; v <= 2000; v++) {
+        ASSERT_EQ(v >= -1000 && v <= 1000 && (v + 1000) % 7 == 0, set.contains(v)) << v;
+    }
+    ASSERT_FALSE(set.contains(std::numeric_limits<int32_t>::min()));
+    ASSERT_FALSE(set.contains(std::numeric_limits<int32_t>::max()));
+
+    DenseBitmapSet<int64_t> max_set;
+    int64_t max = std::numeric_limits<int64_t>::max();
+    ASSERT_TRUE(max_set.init({max, max - 64, max - 65}));
+    ASSERT_TRUE(max_set.contains(max));
+    ASSERT_TRUE(max_set.contains(max - 64));
+    ASSERT_FALSE(max_set.contains(max - 1));
+    ASSERT_FALSE(max_set.contains(std::numeric_limits<int64_t>::min()));
+    ASSERT_FALSE(max_set.contains(0));
+}
+
+TEST(FixedValueSetTest, slice_perfect_hash_set) {
+    SlicePerfectHashSet set;
+    ASSERT_FALSE(set.init({}));
+
+    std::vector<std::string> strings;
+    strings.emplace_back("");
+    for (int i = 0; i < 1000; i++) {
+        strings.emplace_back("value" + std::to_string(i * 3));
+    }
+    std::vector<Slice> values(strings.begin(), strings.end());
+    ASSERT_TRUE(set.init(values));
+    ASSERT_EQ(values.size(), set.size());
+    ASSERT_TRUE(set.contains(Slice()));
+    for (int i = 0; i < 3000; i++) {
+        std::string str = "value" + std::to_string(i);
+        ASSERT_EQ(i % 3 == 0, set.contains(Slice(str))) << str;
+    }
+    ASSERT_FALSE(set.contains(Slice("value")));
+
+    // The duplicated values always collide.
+    ASSERT_FALSE(set.init({Slice("a"), Slice("a")}));
+}
+
+} // namespace starrocks::vectorized
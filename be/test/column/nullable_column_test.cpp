@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include "column/fixed_length_column.h"
+#include "common/config.h"
 #include "testutil/parallel_test.h"
 
 namespace starrocks::vectorized {
@@ -197,4 +198,80 @@ PARALLEL_TEST(NullableColumnTest, test_clone_empty) {
     ASSERT_EQ(0, down_cast<NullableColumn*>(c2.get())->null_column()->size());
 }
 
+// NOLINTNEXTLINE
+PARALLEL_TEST(NullableColumnTest, test_crc32c_hash) {
+    auto c0 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    c0->append_datum({(int32_t)1});
+    c0->append_datum({}); // NULL
+    c0->append_datum({}); // NULL
+    c0->append_datum({(int32_t)2});
+
+    auto c1 = Int32Column::create();
+    c1->append(1);
+    c1->append(0);
+    c1->append(0);
+    c1->append(2);
+
+    std::vector<uint32_t> hash0(4, 0);
+    std::vector<uint32_t> hash1(4, 0);
+    c0->crc32c_hash(hash0.data(), 0, 4);
+    c1->crc32c_hash(hash1.data(), 0, 4);
+    ASSERT_EQ(hash1[0], hash0[0]);
+    ASSERT_EQ(hash1[3], hash0[3]);
+    ASSERT_NE(hash0[0], hash0[3]);
+    ASSERT_EQ(hash0[1], hash0[2]);
+
+    // The same as the column without nulls.
+    auto c2 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    c2->append_datum({(int32_t)1});
+    c2->append_datum({(int32_t)2});
+    std::vector<uint32_t> hash2(2, 0);
+    c2->crc32c_hash(hash2.data(), 0, 2);
+    ASSERT_EQ(hash0[0], hash2[0]);
+    ASSERT_EQ(hash0[3], hash2[1]);
+}
+
+// NOLINTNEXTLINE
+TEST(NullableColumnTest, test_serialize_null_bitmap) {
+    auto c0 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    for (int32_t i = 0; i < 100; i++) {
+        if (i % 3 == 0) {
+            c0->append_nulls(1);
+        } else {
+            c0->append_datum(i);
+        }
+    }
+    auto c1 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    c1->append_datum((int32_t)1);
+
+    auto check = [&](bool use_bitmap) {
+        config::serialize_null_bitmap = use_bitmap;
+        for (const auto& src : {c0, c1}) {
+            std::vector<uint8_t> buffer(src->serialize_size());
+            ASSERT_EQ(buffer.data() + buffer.size(), src->serialize_column(buffer.data()));
+
+            // The null flags are deserialized in both formats whatever the config is.
+            config::serialize_null_bitmap = !use_bitmap;
+            auto dst = NullableColumn::create(Int32Column::create(), NullColumn::create());
+            ASSERT_EQ(buffer.data() + buffer.size(), dst->deserialize_column(buffer.data()));
+            config::serialize_null_bitmap = use_bitmap;
+
+            ASSERT_EQ(src->size(), dst->size());
+            ASSERT_EQ(src->has_null(), dst->has_null());
+            for (size_t i = 0; i < src->size(); i++) {
+                ASSERT_EQ(src->is_null(i), dst->is_null(i));
+                if (!src->is_null(i)) {
+                    ASSERT_EQ(src->get(i).get_int32(), dst->get(i).get_int32());
+                }
+            }
+        }
+    };
+    check(false);
+    check(true);
+    // 4 bytes of the header and 13 bytes of the bitmap, instead of 100 bytes of the flags.
+    ASSERT_EQ(c0->data_column()->serialize_size() + 17, c0->serialize_size());
+    ASSERT_EQ(c1->data_column()->serialize_size() + 4, c1->serialize_size());
+    config::serialize_null_bitmap = false;
+}
+
 } // namespace starrocks::vectorized
\ No newline at end of file
@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/string_view.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace starrocks::vectorized {
+
+static int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+// NOLINTNEXTLINE
+TEST(StringViewTest, test_inline) {
+    std::string short_str = "starrocks";
+    std::string long_str = "starrocks_starrocks";
+    StringView short_view(short_str);
+    StringView long_view(long_str);
+    ASSERT_TRUE(short_view.is_inline());
+    ASSERT_FALSE(long_view.is_inline());
+    ASSERT_EQ(short_str, short_view.to_slice().to_string());
+    ASSERT_EQ(long_str, long_view.to_slice().to_string());
+    // The long string is referred, and the short one is copied.
+    ASSERT_EQ(long_str.data(), long_view.data());
+    ASSERT_NE(short_str.data(), short_view.data());
+    ASSERT_EQ(0, StringView(Slice()).size());
+}
+
+// NOLINTNEXTLINE
+TEST(StringViewTest, test_compare) {
+    // The strings sharing the prefixes, with the zero bytes and the bytes greater than 127.
+    std::vector<std::string> strings = {"",
+                                        std::string(1, '\0'),
+                                        std::string(2, '\0'),
+                                        "a",
+                                        std::string("a\0", 2),
+                                        "ab",
+                                        "abc",
+                                        "abcd",
+                                        "abcde",
+                                        "abcd\xff",
+                                        "abcdefghijkl",
+                                        "abcdefghijklm",
+                                        "abcdefghijklmn",
+                                        "abcdefghijkz",
+                                        "abcdefghijklmz",
+                                        "\xff\xff\xff\xff",
+                                        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"};
+    std::mt19937 rng(0);
+    for (int i = 0; i < 1000; i++) {
+        std::string s(rng() % 20, 'a');
+        for (auto& c : s) {
+            c = static_cast<char>('a' + rng() % 3);
+        }
+        strings.emplace_back(std::move(s));
+    }
+
+    for (const auto& l : strings) {
+        for (const auto& r : strings) {
+            StringView lv(l);
+            StringView rv(r);
+            ASSERT_EQ(sign(Slice(l).compare(Slice(r))), sign(lv.compare(rv))) << l << " " << r;
+            ASSERT_EQ(l == r, lv == rv) << l << " " << r;
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -3,10 +3,12 @@
 #include "env/compressed_file.h"
 
 #include <gtest/gtest.h>
+#include <zlib.h>
 
 #include "env/env_memory.h"
 #include "exec/decompressor.h"
 #include "util/block_compression.h"
+#include "util/coding.h"
 #include "util/random.h"
 
 namespace starrocks {
@@ -46,6 +48,53 @@ protected:
         return std::shared_ptr<Decompressor>(dec);
     }
 
+    static std::string compress(CompressionTypePB type, const Slice& content) {
+        const BlockCompressionCodec* codec = nullptr;
+        CHECK(get_block_compression_codec(type, &codec).ok());
+        std::string compressed_data(codec->max_compressed_len(content.size), '\0');
+        Slice buff(compressed_data);
+        CHECK(codec->compress(content, &buff).ok());
+        compressed_data.resize(buff.size);
+        return compressed_data;
+    }
+
+    // A BGZF block, i.e. a gzip member of the raw deflate data with the BSIZE field.
+    static std::string bgzf_compress(const Slice& content) {
+        z_stream strm{};
+        CHECK_EQ(Z_OK, deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY));
+        std::string deflated(deflateBound(&strm, content.size), '\0');
+        strm.next_in = (Bytef*)content.data;
+        strm.avail_in = content.size;
+        strm.next_out = (Bytef*)deflated.data();
+        strm.avail_out = deflated.size();
+        CHECK_EQ(Z_STREAM_END, deflate(&strm, Z_FINISH));
+        deflated.resize(strm.total_out);
+        deflateEnd(&strm);
+
+        std::string block("\x1f\x8b\x08\x04\0\0\0\0\0\xff\x06\0BC\x02\0", 16);
+        size_t bsize = 18 + deflated.size() + 8 - 1;
+        block.push_back(bsize & 0xff);
+        block.push_back(bsize >> 8);
+        block.append(deflated);
+        put_fixed32_le(&block, crc32(0, (const Bytef*)content.data, content.size));
+        put_fixed32_le(&block, content.size);
+        return block;
+    }
+
+    static std::string read_all(SequentialFile* f, size_t read_buff_len) {
+        std::string data;
+        std::string own_buff(read_buff_len, '\0');
+        Slice buff(own_buff);
+        Status st = f->read(&buff);
+        while (st.ok() && buff.size > 0) {
+            data.append(buff.data, buff.size);
+            buff = Slice(own_buff);
+            st = f->read(&buff);
+        }
+        EXPECT_TRUE(st.ok()) << st.to_string();
+        return data;
+    }
+
     void test(const TestCase& t) {
         auto f = std::make_shared<CompressedSequentialFile>(LZ4F_compress_to_file(t.data), LZ4F_decompressor(),
                                                             t.compressed_buff_len);
@@ -88,4 +137,80 @@ TEST_F(CompressedSequentialFileTest, test_LZ4F) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompressedSequentialFileTest, test_parallel) {
+    const size_t M1 = 1024 * 1024;
+    std::string content;
+    // Some frames of each type, one of the zstd and lz4 frames larger than the compressed data buffer.
+    std::vector<std::string> frames;
+    for (int i = 0; i < 40; i++) {
+        frames.emplace_back(random_string(i == 25 ? 3 * M1 : 100 * 1024 + i));
+        content.append(frames.back());
+    }
+    for (auto type : {CompressionTypePB::ZSTD, CompressionTypePB::LZ4_FRAME, CompressionTypePB::GZIP}) {
+        std::string compressed_data;
+        for (const auto& frame : frames) {
+            if (type != CompressionTypePB::GZIP) {
+                compressed_data.append(compress(type, frame));
+                continue;
+            }
+            // A BGZF block has at most 64KB.
+            for (size_t i = 0; i < frame.size(); i += 32 * 1024) {
+                compressed_data.append(bgzf_compress(Slice(frame.data() + i, std::min(frame.size() - i, 32 * 1024UL))));
+            }
+        }
+        for (int num_threads : {1, 4}) {
+            auto f = std::make_shared<ParallelCompressedSequentialFile>(
+                    std::make_shared<StringSequentialFile>(compressed_data), type, num_threads, M1);
+            ASSERT_EQ(content, read_all(f.get(), 300 * 1024)) << type;
+        }
+    }
+
+    // A zlib stream isn't split, so it's decompressed by the read-ahead thread.
+    auto f = std::make_shared<ParallelCompressedSequentialFile>(
+            std::make_shared<StringSequentialFile>(compress(CompressionTypePB::ZLIB, content)),
+            CompressionTypePB::GZIP, 4, M1);
+    std::string head(1000, '\0');
+    Slice buff(head);
+    ASSERT_TRUE(f->read(&buff).ok());
+    ASSERT_EQ(Slice(content.data(), buff.size), buff);
+    ASSERT_TRUE(f->skip(2 * M1).ok());
+    ASSERT_EQ(content.substr(buff.size + 2 * M1), read_all(f.get(), 64 * 1024));
+
+    // An error of the decompression is returned by the reads.
+    std::string corrupted = compress(CompressionTypePB::ZSTD, content);
+    corrupted[0] ^= 0xff;
+    f = std::make_shared<ParallelCompressedSequentialFile>(std::make_shared<StringSequentialFile>(corrupted),
+                                                           CompressionTypePB::ZSTD, 4, M1);
+    Status st;
+    do {
+        buff = Slice(head);
+        st = f->read(&buff);
+    } while (st.ok() && buff.size > 0);
+    ASSERT_FALSE(st.ok());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompressedSequentialFileTest, test_frame_size) {
+    std::string frame = compress(CompressionTypePB::ZSTD, "StarRocks");
+    auto data = (const uint8_t*)frame.data();
+    ASSERT_EQ(frame.size(), Decompressor::frame_size(CompressionTypePB::ZSTD, data, frame.size()));
+    ASSERT_EQ(0, Decompressor::frame_size(CompressionTypePB::ZSTD, data, frame.size() - 1));
+
+    frame = compress(CompressionTypePB::LZ4_FRAME, "StarRocks");
+    data = (const uint8_t*)frame.data();
+    ASSERT_EQ(frame.size(), Decompressor::frame_size(CompressionTypePB::LZ4_FRAME, data, frame.size()));
+    ASSERT_EQ(0, Decompressor::frame_size(CompressionTypePB::LZ4_FRAME, data, frame.size() - 1));
+
+    frame = bgzf_compress("StarRocks");
+    data = (const uint8_t*)frame.data();
+    ASSERT_EQ(frame.size(), Decompressor::frame_size(CompressionTypePB::GZIP, data, frame.size()));
+    ASSERT_EQ(0, Decompressor::frame_size(CompressionTypePB::GZIP, data, frame.size() - 1));
+
+    frame = compress(CompressionTypePB::ZLIB, "StarRocks");
+    data = (const uint8_t*)frame.data();
+    ASSERT_EQ(-1, Decompressor::frame_size(CompressionTypePB::GZIP, data, frame.size()));
+    ASSERT_EQ(-1, Decompressor::frame_size(CompressionTypePB::BZIP2, data, frame.size()));
+}
+
 } // namespace starrocks
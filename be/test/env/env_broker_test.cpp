@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 
+#include "common/config.h"
 #include "env/env_memory.h"
 #include "gen_cpp/FileBrokerService_types.h"
 #include "gen_cpp/TFileBrokerService.h"
@@ -371,6 +372,45 @@ TEST_F(EnvBrokerTest, test_sequential_read) {
     ASSERT_EQ("", read(f, 1));
 }
 
+// NOLINTNEXTLINE
+TEST_F(EnvBrokerTest, test_parallel_sequential_read) {
+    const std::string path = "/tmp/1.txt";
+    const std::string content = "abcdefghijklmnopqrstuvwxyz0123456789";
+    ASSERT_OK(_env_mem->create_file(path));
+    ASSERT_OK(_env_mem->append_file(path, content));
+
+    int32_t old_connections = config::broker_read_connections_per_file;
+    int64_t old_range_bytes = config::broker_read_range_bytes;
+    // 4 ranges fetched by 3 readers.
+    config::broker_read_connections_per_file = 3;
+    config::broker_read_range_bytes = 10;
+
+    std::unique_ptr<SequentialFile> f;
+    ASSERT_OK(_env.new_sequential_file(path, &f));
+    ASSERT_EQ("", read(f, 0));
+    ASSERT_EQ("a", read(f, 1));
+    ASSERT_EQ("bcdefghij", read(f, 100));
+    ASSERT_EQ("klm", read(f, 3));
+    ASSERT_OK(f->skip(2));
+    ASSERT_EQ("pqrst", read(f, 100));
+    ASSERT_OK(f->skip(12));
+    ASSERT_EQ("6789", read(f, 100));
+    ASSERT_EQ("", read(f, 1));
+
+    // Skip before the first read, as the scanner of a split range.
+    ASSERT_OK(_env.new_sequential_file(path, &f));
+    ASSERT_OK(f->skip(15));
+    std::string s;
+    for (std::string part = read(f, 4); !part.empty(); part = read(f, 4)) {
+        s.append(part);
+    }
+    ASSERT_EQ(content.substr(15), s);
+    f.reset();
+
+    config::broker_read_connections_per_file = old_connections;
+    config::broker_read_range_bytes = old_range_bytes;
+}
+
 // NOLINTNEXTLINE
 TEST_F(EnvBrokerTest, test_random_read) {
     const std::string path = "/tmp/1.txt";
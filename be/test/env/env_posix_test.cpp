@@ -23,8 +23,10 @@
 
 #include <algorithm>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
+#include "env/io_uring.h"
 #include "util/file_utils.h"
 
 namespace starrocks {
@@ -90,6 +92,9 @@ TEST_F(EnvPosixTest, random_access) {
         ASSERT_STREQ("123456789", std::string(slice1.data, slice1.size).c_str());
         ASSERT_STREQ("abc", std::string(slice3.data, slice3.size).c_str());
 
+        st = rfile->prefetch(9, 100);
+        ASSERT_TRUE(st.ok());
+
         Slice slice4(mem, 3);
         st = rfile->read_at(112, slice4);
         ASSERT_TRUE(st.ok());
@@ -132,6 +137,60 @@ TEST_F(EnvPosixTest, random_access) {
     }
 }
 
+TEST_F(EnvPosixTest, read_at_batch) {
+    std::string fname = "./ut_dir/env_posix/read_at_batch";
+    auto env = Env::Default();
+    std::unique_ptr<WritableFile> wfile;
+    ASSERT_TRUE(env->new_writable_file(fname, &wfile).ok());
+    std::string data;
+    for (int i = 0; i < 100000; ++i) {
+        data.push_back((char)(i * 7));
+    }
+    ASSERT_TRUE(wfile->append(data).ok());
+    ASSERT_TRUE(wfile->close().ok());
+
+    std::unique_ptr<RandomAccessFile> rfile;
+    ASSERT_TRUE(env->new_random_access_file(fname, &rfile).ok());
+    // Read by pread and io_uring, more requests than the queue depth.
+    for (bool enable_io_uring : {false, true}) {
+        config::enable_io_uring = enable_io_uring;
+        std::vector<std::string> bufs(100, std::string(3000, '\0'));
+        std::vector<ReadRequest> reqs(bufs.size());
+        for (size_t i = 0; i < reqs.size(); i++) {
+            reqs[i].offset = i * 997;
+            reqs[i].buf = Slice(bufs[i]);
+        }
+        std::vector<size_t> completed;
+        ASSERT_TRUE(rfile->read_at_batch(reqs.data(), reqs.size(), [&](size_t i) { completed.push_back(i); }).ok());
+        ASSERT_EQ(reqs.size(), completed.size());
+        for (size_t i = 0; i < reqs.size(); i++) {
+            ASSERT_TRUE(reqs[i].status.ok());
+            ASSERT_EQ(data.substr(reqs[i].offset, 3000), bufs[i]);
+        }
+
+        // The registered buffer.
+        IoUring* ring = IoUring::thread_local_ring();
+        if (ring != nullptr) {
+            Slice buf(bufs[0]);
+            ASSERT_TRUE(ring->register_buffers(&buf, 1).ok());
+            reqs[0].offset = 12345;
+            reqs[0].buf_index = 0;
+            ASSERT_TRUE(rfile->read_at_batch(reqs.data(), 1).ok());
+            ASSERT_EQ(data.substr(12345, 3000), bufs[0]);
+            ASSERT_TRUE(ring->unregister_buffers().ok());
+            reqs[0].buf_index = -1;
+        }
+
+        // Reading beyond the end of file.
+        reqs[1].offset = data.size() - 10;
+        Status st = rfile->read_at_batch(reqs.data(), 2);
+        ASSERT_TRUE(reqs[0].status.ok());
+        ASSERT_TRUE(st.is_end_of_file());
+        ASSERT_TRUE(reqs[1].status.is_end_of_file());
+    }
+    config::enable_io_uring = false;
+}
+
 TEST_F(EnvPosixTest, random_rw) {
     std::string fname = "./ut_dir/env_posix/random_rw";
     WritableFileOptions ops;
@@ -26,8 +26,11 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "exec/es/es_predicate.h"
+#include "exec/es/es_scan_reader.h"
+#include "exec/es/es_scroll_query.h"
 #include "rapidjson/document.h"
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/stringbuffer.h"
@@ -599,4 +602,42 @@ TEST_F(BooleanQueryBuilderTest, validate_compound_and) {
             "{\"fv\":[\"8.0\",\"16.0\"]}}]}}]}}]}},{\"wildcard\":{\"content\":\"a*e*g?\"}}]}}]}}";
     ASSERT_STREQ(expected_json.c_str(), actual_bool_json.c_str());
 }
+
+TEST_F(BooleanQueryBuilderTest, sliced_scroll) {
+    std::map<std::string, std::string> properties;
+    properties[ESScanReader::KEY_BATCH_SIZE] = "100";
+    std::vector<std::string> fields{"k1"};
+    std::vector<EsPredicate*> predicates;
+    std::map<std::string, std::string> docvalue_context;
+    bool doc_value_mode = false;
+
+    rapidjson::Document dsl;
+    std::string body = ESScrollQueryBuilder::build(properties, fields, predicates, docvalue_context, &doc_value_mode);
+    dsl.Parse(body.c_str());
+    ASSERT_FALSE(dsl.HasMember("slice"));
+
+    properties[ESScanReader::KEY_SLICE_ID] = "2";
+    properties[ESScanReader::KEY_SLICE_MAX] = "4";
+    body = ESScrollQueryBuilder::build(properties, fields, predicates, docvalue_context, &doc_value_mode);
+    dsl.Parse(body.c_str());
+    ASSERT_TRUE(dsl.HasMember("slice"));
+    ASSERT_FALSE(dsl["slice"].HasMember("field"));
+    ASSERT_EQ(2, dsl["slice"]["id"].GetInt());
+    ASSERT_EQ(4, dsl["slice"]["max"].GetInt());
+    ASSERT_EQ(100, dsl["size"].GetInt());
+
+    config::es_scroll_slice_field = "k1";
+    body = ESScrollQueryBuilder::build(properties, fields, predicates, docvalue_context, &doc_value_mode);
+    config::es_scroll_slice_field = "";
+    dsl.Parse(body.c_str());
+    ASSERT_STREQ("k1", dsl["slice"]["field"].GetString());
+
+    // the search of the limit pushed down isn't sliced
+    properties[ESScanReader::KEY_TERMINATE_AFTER] = "10";
+    body = ESScrollQueryBuilder::build(properties, fields, predicates, docvalue_context, &doc_value_mode);
+    dsl.Parse(body.c_str());
+    ASSERT_FALSE(dsl.HasMember("slice"));
+    ASSERT_EQ(10, dsl["size"].GetInt());
+}
+
 } // namespace starrocks
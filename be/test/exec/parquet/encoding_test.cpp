@@ -195,6 +195,50 @@ TEST_F(ParquetEncodingTest, Int32) {
     }
 }
 
+TEST_F(ParquetEncodingTest, Skip) {
+    std::vector<int32_t> values;
+    for (int i = 0; i < 20; i++) {
+        values.push_back(i);
+    }
+
+    const EncodingInfo* plain_encoding = nullptr;
+    EncodingInfo::get(tparquet::Type::INT32, tparquet::Encoding::PLAIN, &plain_encoding);
+    ASSERT_TRUE(plain_encoding != nullptr);
+
+    std::unique_ptr<Decoder> decoder;
+    auto st = plain_encoding->create_decoder(&decoder);
+    ASSERT_TRUE(st.ok());
+
+    std::unique_ptr<Encoder> encoder;
+    st = plain_encoding->create_encoder(&encoder);
+    ASSERT_TRUE(st.ok());
+
+    st = encoder->append(reinterpret_cast<uint8_t*>(&values[0]), 20);
+    ASSERT_TRUE(st.ok());
+
+    decoder->set_data(encoder->build());
+    st = decoder->skip(5);
+    ASSERT_TRUE(st.ok());
+
+    std::vector<int32_t> checks(10);
+    st = decoder->next_batch(10, (uint8_t*)&checks[0]);
+    ASSERT_TRUE(st.ok());
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(values[i + 5], checks[i]);
+    }
+
+    st = decoder->skip(3);
+    ASSERT_TRUE(st.ok());
+    st = decoder->next_batch(2, (uint8_t*)&checks[0]);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(18, checks[0]);
+    ASSERT_EQ(19, checks[1]);
+
+    // out-of-bounds skip
+    st = decoder->skip(1);
+    ASSERT_FALSE(st.ok());
+}
+
 TEST_F(ParquetEncodingTest, String) {
     std::vector<std::string> values;
     for (int i = 0; i < 20; i++) {
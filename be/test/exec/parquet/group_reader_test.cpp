@@ -116,6 +116,33 @@ private:
     tparquet::Type::type _type = tparquet::Type::type::INT32;
 };
 
+// Reads the int32 values of the row numbers, and skips rows.
+class MockSkipColumnReader : public ColumnReader {
+public:
+    MockSkipColumnReader() = default;
+    ~MockSkipColumnReader() override = default;
+
+    Status prepare_batch(size_t* num_records, ColumnContentType content_type, vectorized::Column* column) override {
+        for (size_t i = 0; i < *num_records; i++) {
+            column->append_datum(static_cast<int32_t>(_next_row + i));
+        }
+        _next_row += *num_records;
+        return Status::OK();
+    }
+
+    Status finish_batch() override { return Status::OK(); }
+
+    void get_levels(int16_t** def_levels, int16_t** rep_levels, size_t* num_levels) override {}
+
+    Status skip_rows(size_t num_rows) override {
+        _next_row += num_rows;
+        return Status::OK();
+    }
+
+private:
+    size_t _next_row = 0;
+};
+
 class GroupReaderTest : public ::testing::Test {
 protected:
     void SetUp() override {}
@@ -411,4 +438,56 @@ TEST_F(GroupReaderTest, TestGetNext) {
     _check_chunk(param, chunk, 8, 4);
 }
 
+TEST_F(GroupReaderTest, TestReadLazyColumns) {
+    auto* file = _create_file();
+    auto* param = _create_group_reader_param();
+    FileMetaData* file_meta;
+    Status status = _create_filemeta(&file_meta, param);
+    ASSERT_TRUE(status.ok());
+    auto* group_reader = _pool.add(new GroupReader(file, file_meta, 0));
+
+    vectorized::HdfsScanStats stats;
+    group_reader->_param.stats = &stats;
+    auto column = _create_group_reader_param_of_column(0, tparquet::Type::type::INT32, PrimitiveType::TYPE_INT);
+    group_reader->_lazy_read_columns.emplace_back(column);
+    group_reader->_column_readers[0] = std::make_unique<MockSkipColumnReader>();
+    group_reader->_read_chunk = std::make_shared<vectorized::Chunk>();
+    group_reader->_read_chunk->append_column(vectorized::ColumnHelper::create_column(column.col_type_in_chunk, true),
+                                             0);
+    group_reader->_active_chunk = std::make_shared<vectorized::Chunk>();
+    auto active_column = vectorized::ColumnHelper::create_column(column.col_type_in_chunk, true);
+    group_reader->_active_chunk->append_column(active_column, 1);
+
+    // select [0, 10), [20, 30) and [150, 160) of 200 rows, [10, 20) is read and filtered out,
+    // the others are skipped.
+    group_reader->_active_filter.assign(200, 0);
+    for (size_t i = 0; i < 200; i++) {
+        if (i < 10 || (i >= 20 && i < 30) || (i >= 150 && i < 160)) {
+            group_reader->_active_filter[i] = 1;
+        }
+    }
+    active_column->append_default(30);
+    status = group_reader->_read_lazy_columns(200);
+    ASSERT_TRUE(status.ok());
+    auto* result = group_reader->_read_chunk->get_column_by_slot_id(0).get();
+    ASSERT_EQ(30, result->size());
+    for (size_t i = 0; i < 10; i++) {
+        ASSERT_EQ(static_cast<int32_t>(i), result->get(i).get_int32());
+        ASSERT_EQ(static_cast<int32_t>(i + 20), result->get(i + 10).get_int32());
+        ASSERT_EQ(static_cast<int32_t>(i + 150), result->get(i + 20).get_int32());
+    }
+    ASSERT_EQ(160, stats.late_materialize_skip_rows);
+
+    // the next batch starts after the rows skipped.
+    group_reader->_read_chunk->reset();
+    active_column->resize(10);
+    group_reader->_active_filter.assign(10, 1);
+    status = group_reader->_read_lazy_columns(10);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(10, result->size());
+    for (size_t i = 0; i < 10; i++) {
+        ASSERT_EQ(static_cast<int32_t>(i + 200), result->get(i).get_int32());
+    }
+}
+
 } // namespace starrocks::parquet
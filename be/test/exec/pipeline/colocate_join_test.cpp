@@ -0,0 +1,88 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include "exec/pipeline/morsel.h"
+#include "exec/vectorized/hash_joiner.h"
+#include "gutil/casts.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks::pipeline {
+
+// NOLINTNEXTLINE
+TEST(ColocateJoinTest, test_bucket_admission) {
+    TPlanNode tnode;
+    tnode.__isset.hash_join_node = true;
+    tnode.hash_join_node.join_op = TJoinOp::INNER_JOIN;
+    RowDescriptor row_desc;
+    auto factory = std::make_shared<vectorized::HashJoinerFactory>(tnode, row_desc, row_desc, row_desc);
+    ASSERT_FALSE(factory->is_bucketed());
+    // The builder is shared by all the drivers without buckets.
+    ASSERT_EQ(factory->builder(0), factory->builder(1));
+
+    const int32_t num_buckets = 5;
+    factory = std::make_shared<vectorized::HashJoinerFactory>(tnode, row_desc, row_desc, row_desc);
+    factory->set_bucketed(2);
+    ASSERT_TRUE(factory->is_bucketed());
+    for (int32_t i = 0; i < num_buckets; i++) {
+        ASSERT_NE(nullptr, factory->builder(i));
+        for (int32_t j = 0; j < i; j++) {
+            ASSERT_NE(factory->builder(i), factory->builder(j));
+        }
+    }
+
+    // At most 2 buckets beyond the released ones are built at a time, in the order of the driver sequences.
+    for (int32_t released = 0; released <= num_buckets; released++) {
+        for (int32_t i = 0; i < num_buckets; i++) {
+            ASSERT_EQ(i < released + 2, factory->is_bucket_admitted(i)) << "bucket " << i << ", released " << released;
+        }
+        factory->release_bucket();
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ColocateJoinTest, test_partitioned_builders) {
+    TPlanNode tnode;
+    tnode.__isset.hash_join_node = true;
+    tnode.hash_join_node.join_op = TJoinOp::INNER_JOIN;
+    RowDescriptor row_desc;
+    auto factory = std::make_shared<vectorized::HashJoinerFactory>(tnode, row_desc, row_desc, row_desc);
+    factory->set_partitioned();
+    // Each partition of a shuffle join has its own builder, and all of them are built at the same time.
+    ASSERT_TRUE(factory->has_builder_per_driver());
+    ASSERT_FALSE(factory->is_bucketed());
+    ASSERT_NE(factory->builder(0), factory->builder(1));
+    ASSERT_EQ(factory->builder(1), factory->builder(1));
+}
+
+static TScanRangeParams bucket_scan_range(int64_t tablet_id, int32_t bucket) {
+    TScanRangeParams scan_range;
+    scan_range.scan_range.__isset.internal_scan_range = true;
+    scan_range.scan_range.internal_scan_range.tablet_id = tablet_id;
+    scan_range.__set_bucket_sequence(bucket);
+    return scan_range;
+}
+
+// NOLINTNEXTLINE
+TEST(ColocateJoinTest, test_bucket_morsel_queues) {
+    std::vector<TScanRangeParams> scan_ranges{bucket_scan_range(10, 3), bucket_scan_range(11, 0),
+                                              bucket_scan_range(12, 3), bucket_scan_range(13, 1)};
+    // Bucket 2 has no tablet on this instance of the probe side, but the build side has it.
+    std::set<int32_t> buckets{0, 1, 2, 3};
+    auto queues = create_bucket_morsel_queues(1, scan_ranges, buckets);
+    ASSERT_EQ(4U, queues.size());
+
+    std::vector<std::vector<int64_t>> expected{{11}, {13}, {}, {10, 12}};
+    for (size_t i = 0; i < queues.size(); i++) {
+        ASSERT_EQ(expected[i].size(), queues[i]->num_morsels());
+        std::vector<int64_t> tablet_ids;
+        while (auto morsel = queues[i]->try_get()) {
+            auto* olap_morsel = down_cast<OlapMorsel*>(morsel.value().get());
+            ASSERT_EQ(1, olap_morsel->get_plan_node_id());
+            tablet_ids.push_back(olap_morsel->get_scan_range()->tablet_id);
+        }
+        ASSERT_EQ(expected[i], tablet_ids);
+    }
+}
+
+} // namespace starrocks::pipeline
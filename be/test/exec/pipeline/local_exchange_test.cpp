@@ -0,0 +1,177 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/local_exchange.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/object_pool.h"
+#include "exprs/expr_context.h"
+#include "exprs/vectorized/column_ref.h"
+#include "runtime/primitive_type.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+class LocalExchangeTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        TUniqueId fragment_id;
+        TQueryOptions query_options;
+        TQueryGlobals query_globals;
+        _runtime_state = std::make_shared<RuntimeState>(fragment_id, query_options, query_globals, nullptr);
+        _runtime_state->init_instance_mem_tracker();
+    }
+
+protected:
+    ExprContext* _create_slot_ref(SlotId slot_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        node.num_children = 0;
+        TSlotRef ref;
+        ref.slot_id = slot_id;
+        ref.tuple_id = 0;
+        node.__set_slot_ref(ref);
+        auto* expr = _pool.add(new vectorized::ColumnRef(node));
+        return _pool.add(new ExprContext(expr));
+    }
+
+    // The keys of the rows pulled from every source.
+    std::vector<std::set<int32_t>> _pull_keys(LocalExchangeSourceOperatorFactory* source_factory, SlotId slot_id,
+                                              size_t* num_rows) {
+        std::vector<std::set<int32_t>> keys;
+        for (auto* source : source_factory->get_sources()) {
+            std::set<int32_t> source_keys;
+            while (source->has_output()) {
+                auto chunk_or = source->pull_chunk(_runtime_state.get());
+                EXPECT_TRUE(chunk_or.ok());
+                vectorized::ChunkPtr chunk = std::move(chunk_or.value());
+                const auto& column = chunk->get_column_by_slot_id(slot_id);
+                for (size_t i = 0; i < column->size(); i++) {
+                    auto datum = column->get(i);
+                    if (!datum.is_null()) {
+                        source_keys.emplace(datum.get_int32());
+                    }
+                }
+                *num_rows += chunk->num_rows();
+            }
+            EXPECT_TRUE(source->is_finished());
+            keys.emplace_back(std::move(source_keys));
+        }
+        return keys;
+    }
+
+    ObjectPool _pool;
+    std::shared_ptr<RuntimeState> _runtime_state;
+};
+
+// NOLINTNEXTLINE
+TEST_F(LocalExchangeTest, test_partition_exchange) {
+    const size_t num_partitions = 3;
+    const size_t num_sinks = 2;
+    const SlotId slot_id = 1;
+    auto memory_manager = std::make_shared<LocalExchangeMemoryManager>(config::vector_chunk_size * num_partitions);
+    auto source_factory = std::make_shared<LocalExchangeSourceOperatorFactory>(1, memory_manager);
+    std::vector<OperatorPtr> sources;
+    for (size_t i = 0; i < num_partitions; i++) {
+        sources.emplace_back(source_factory->create(num_partitions, i));
+    }
+    std::vector<ExprContext*> partition_expr_ctxs{_create_slot_ref(slot_id)};
+    PartitionExchanger exchanger(memory_manager, source_factory.get(), true, partition_expr_ctxs);
+    exchanger.set_num_sinks(num_sinks);
+    for (size_t i = 0; i < num_sinks; i++) {
+        exchanger.increment_sink_number();
+        ASSERT_TRUE(exchanger.prepare(_runtime_state.get()).ok());
+    }
+
+    // The sinks accept the same keys, from a non-nullable column and a nullable one, e.g. the two sides of a join.
+    const int32_t num_keys = 100;
+    const int32_t num_rows_per_sink = 1000;
+    for (size_t sink = 0; sink < num_sinks; sink++) {
+        vectorized::ColumnPtr column;
+        if (sink == 0) {
+            auto data_column = vectorized::Int32Column::create();
+            for (int32_t i = 0; i < num_rows_per_sink; i++) {
+                data_column->append(i % num_keys);
+            }
+            column = data_column;
+        } else {
+            auto data_column = vectorized::Int32Column::create();
+            auto null_column = vectorized::NullColumn::create();
+            for (int32_t i = 0; i < num_rows_per_sink; i++) {
+                data_column->append(i % num_keys);
+                null_column->append(i % 7 == 0);
+            }
+            column = vectorized::NullableColumn::create(data_column, null_column);
+        }
+        auto chunk = std::make_shared<vectorized::Chunk>();
+        chunk->append_column(column, slot_id);
+        ASSERT_TRUE(exchanger.accept(chunk, sink).ok());
+    }
+    ASSERT_TRUE(exchanger.need_input());
+    for (size_t i = 0; i < num_sinks; i++) {
+        exchanger.finish(_runtime_state.get());
+    }
+
+    size_t num_rows = 0;
+    auto keys = _pull_keys(source_factory.get(), slot_id, &num_rows);
+    ASSERT_EQ(num_sinks * num_rows_per_sink, num_rows);
+    ASSERT_EQ(num_partitions, keys.size());
+    // Every key is owned by exactly one source, whichever column it comes from.
+    std::set<int32_t> all_keys;
+    for (const auto& source_keys : keys) {
+        ASSERT_FALSE(source_keys.empty());
+        for (int32_t key : source_keys) {
+            ASSERT_TRUE(all_keys.emplace(key).second) << "key " << key << " is in more than one partition";
+        }
+    }
+    ASSERT_EQ(static_cast<size_t>(num_keys), all_keys.size());
+    // All the rows are released from the memory manager after they are pulled.
+    ASSERT_TRUE(exchanger.need_input());
+}
+
+// NOLINTNEXTLINE
+TEST_F(LocalExchangeTest, test_partition_exchange_full) {
+    const size_t num_partitions = 2;
+    const SlotId slot_id = 1;
+    auto memory_manager = std::make_shared<LocalExchangeMemoryManager>(config::vector_chunk_size * num_partitions);
+    auto source_factory = std::make_shared<LocalExchangeSourceOperatorFactory>(1, memory_manager);
+    std::vector<OperatorPtr> sources;
+    for (size_t i = 0; i < num_partitions; i++) {
+        sources.emplace_back(source_factory->create(num_partitions, i));
+    }
+    std::vector<ExprContext*> partition_expr_ctxs{_create_slot_ref(slot_id)};
+    PartitionExchanger exchanger(memory_manager, source_factory.get(), true, partition_expr_ctxs);
+    exchanger.set_num_sinks(1);
+    exchanger.increment_sink_number();
+    ASSERT_TRUE(exchanger.prepare(_runtime_state.get()).ok());
+
+    // The sink is blocked once the sources hold about a chunk of rows of every partition.
+    size_t num_input_rows = 0;
+    while (exchanger.need_input()) {
+        auto column = vectorized::Int32Column::create();
+        for (int32_t i = 0; i < config::vector_chunk_size; i++) {
+            column->append(i);
+        }
+        auto chunk = std::make_shared<vectorized::Chunk>();
+        chunk->append_column(column, slot_id);
+        ASSERT_TRUE(exchanger.accept(chunk, 0).ok());
+        num_input_rows += chunk->num_rows();
+    }
+    ASSERT_EQ(num_partitions * config::vector_chunk_size, num_input_rows);
+
+    // The sink is unblocked by pulling the chunks, including the partial ones flushed after finishing.
+    exchanger.finish(_runtime_state.get());
+    for (auto* source : source_factory->get_sources()) {
+        ASSERT_TRUE(source->has_output());
+    }
+    size_t num_rows = 0;
+    auto keys = _pull_keys(source_factory.get(), slot_id, &num_rows);
+    ASSERT_EQ(num_input_rows, num_rows);
+    ASSERT_TRUE(exchanger.need_input());
+}
+
+} // namespace starrocks::pipeline
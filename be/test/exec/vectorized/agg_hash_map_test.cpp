@@ -5,9 +5,13 @@
 #include <gtest/gtest.h>
 
 #include <any>
+#include <set>
+#include <thread>
 #include <variant>
 
+#include "column/nullable_column.h"
 #include "exec/vectorized/aggregate/agg_hash_set.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -203,5 +207,112 @@ TEST(HashMapTest, TwoLevelConvert) {
     }
 }
 
+// The sub-maps of a two-level hash map are iterated by the threads of their own.
+TEST(HashMapTest, TwoLevelSubMaps) {
+    Int32AggTwoLevelHashMap<PhmapSeed1> hash_map;
+    for (int32_t i = 0; i < 10000; i++) {
+        hash_map.emplace(i, nullptr);
+    }
+
+    std::vector<std::vector<int32_t>> sub_keys(hash_map.subcnt());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < hash_map.subcnt(); i++) {
+        threads.emplace_back([&, i]() {
+            hash_map.with_submap(i, [&](const auto& sub_map) {
+                for (const auto& [key, agg_state] : sub_map) {
+                    sub_keys[i].push_back(key);
+                }
+            });
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<int32_t> keys;
+    for (const auto& sub : sub_keys) {
+        ASSERT_FALSE(sub.empty());
+        keys.insert(sub.begin(), sub.end());
+    }
+    ASSERT_EQ(hash_map.size(), keys.size());
+    ASSERT_EQ(0, *keys.begin());
+    ASSERT_EQ(9999, *keys.rbegin());
+}
+
+// A hash map/set reserved for the estimated keys isn't rehashed as they are inserted.
+TEST(HashMapTest, VariantReserve) {
+    std::vector<std::string> keys(10000);
+    for (int i = 0; i < 10000; i++) {
+        keys[i] = std::to_string(i);
+    }
+
+    HashMapVariant map_variant;
+    map_variant.init(HashMapVariant::Type::phase2_slice_two_level);
+    map_variant.reserve(keys.size());
+    const size_t map_capacity = map_variant.capacity();
+    ASSERT_GE(map_capacity, keys.size());
+    for (auto& key : keys) {
+        map_variant.phase2_slice_two_level->hash_map.emplace(Slice(key.data(), key.size()), nullptr);
+    }
+    ASSERT_EQ(keys.size(), map_variant.size());
+    ASSERT_EQ(map_capacity, map_variant.capacity());
+
+    HashSetVariant set_variant;
+    set_variant.init(HashSetVariant::Type::phase2_int32);
+    set_variant.reserve(keys.size());
+    const size_t set_capacity = set_variant.capacity();
+    for (int32_t i = 0; i < 10000; i++) {
+        set_variant.phase2_int32->hash_set.emplace(i);
+    }
+    ASSERT_EQ(keys.size(), set_variant.size());
+    ASSERT_EQ(set_capacity, set_variant.capacity());
+}
+
+TEST(HashMapTest, FixedSizeSerializedKey) {
+    // Group by (int32, nullable int16), the packed key is 4 + 1 + 2 bytes.
+    auto key1 = Int32Column::create();
+    auto key2 = NullableColumn::create(Int16Column::create(), NullColumn::create());
+    for (int32_t i = 0; i < 100; i++) {
+        key1->append(i % 10);
+        if (i % 20 < 10) {
+            key2->append_datum(Datum(static_cast<int16_t>(i % 10)));
+        } else {
+            ASSERT_TRUE(key2->append_nulls(1));
+        }
+    }
+    Columns key_columns{key1, key2};
+
+    AggHashMapWithSerializedKeyFixedSize<Int64AggHashMap<PhmapSeed1>> hash_map_with_key;
+    std::vector<int64_t> states(100);
+    size_t num_states = 0;
+    Buffer<AggDataPtr> agg_states(100);
+    hash_map_with_key.compute_agg_states(
+            100, key_columns, nullptr, [&]() { return reinterpret_cast<AggDataPtr>(&states[num_states++]); },
+            &agg_states);
+    // The same key1 with key2 null or not null are different keys.
+    ASSERT_EQ(20, hash_map_with_key.hash_map.size());
+    ASSERT_EQ(20, num_states);
+    for (size_t i = 0; i < 100; i++) {
+        ASSERT_EQ(agg_states[i % 20], agg_states[i]);
+    }
+
+    std::vector<int64_t> keys;
+    for (const auto& [key, value] : hash_map_with_key.hash_map) {
+        keys.emplace_back(key);
+    }
+    Columns result_columns{Int32Column::create(),
+                           NullableColumn::create(Int16Column::create(), NullColumn::create())};
+    hash_map_with_key.insert_keys_to_columns(keys, result_columns, keys.size());
+    ASSERT_EQ(20, result_columns[0]->size());
+    ASSERT_EQ(20, result_columns[1]->size());
+    std::set<std::string> result_keys;
+    for (size_t i = 0; i < 20; i++) {
+        result_keys.emplace(result_columns[0]->debug_item(i) + "," + result_columns[1]->debug_item(i));
+    }
+    ASSERT_EQ(20, result_keys.size());
+    ASSERT_TRUE(result_keys.count("3,3") > 0);
+    ASSERT_TRUE(result_keys.count("3,NULL") > 0);
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/aggregate/agg_result_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+
+namespace starrocks::vectorized {
+
+static std::shared_ptr<const AggResultCache::Chunks> create_chunks(int num_rows) {
+    auto column = Int64Column::create();
+    for (int i = 0; i < num_rows; i++) {
+        column->append(i);
+    }
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(column, 0);
+    return std::make_shared<const AggResultCache::Chunks>(AggResultCache::Chunks{chunk});
+}
+
+// NOLINTNEXTLINE
+TEST(AggResultCacheTest, test_lookup) {
+    AggResultCache cache(1024 * 1024);
+    ASSERT_EQ(nullptr, cache.lookup("digest", 10001, 2));
+
+    cache.insert("digest", 10001, 2, create_chunks(10));
+    ASSERT_GT(cache.memory_usage(), 0);
+    auto chunks = cache.lookup("digest", 10001, 2);
+    ASSERT_NE(nullptr, chunks);
+    ASSERT_EQ(1, chunks->size());
+    ASSERT_EQ(10, (*chunks)[0]->num_rows());
+
+    // another version, tablet or plan
+    ASSERT_EQ(nullptr, cache.lookup("digest", 10001, 3));
+    ASSERT_EQ(nullptr, cache.lookup("digest", 10002, 2));
+    ASSERT_EQ(nullptr, cache.lookup("other", 10001, 2));
+}
+
+// NOLINTNEXTLINE
+TEST(AggResultCacheTest, test_evict) {
+    AggResultCache cache(1024 * 1024);
+    // about 8M in total
+    for (int version = 0; version < 1000; version++) {
+        cache.insert("digest", 10001, version, create_chunks(1024));
+    }
+    ASSERT_LE(cache.memory_usage(), 1024 * 1024);
+    ASSERT_EQ(nullptr, cache.lookup("digest", 10001, 0));
+    ASSERT_NE(nullptr, cache.lookup("digest", 10001, 999));
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,208 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "common/object_pool.h"
+#include "exec/vectorized/aggregator.h"
+#include "exec/vectorized/spill_test_helper.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/primitive_type.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized {
+
+// SELECT k, SUM(v) FROM t GROUP BY k, the input slots are k (0) and v (1) of tuple 0, and the intermediate
+// and output slots are k (2) and SUM(v) (3) of tuple 1.
+class AggregatorSpillTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        TDescriptorTableBuilder desc_tbl_builder;
+        for (int i = 0; i < 2; i++) {
+            TTupleDescriptorBuilder tuple_builder;
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false).column_name("k").build());
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).nullable(false).column_name("v").build());
+            tuple_builder.build(&desc_tbl_builder);
+        }
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &_desc_tbl).ok());
+
+        _tnode.node_id = 1;
+        _tnode.node_type = TPlanNodeType::AGGREGATION_NODE;
+        _tnode.num_children = 1;
+        _tnode.limit = -1;
+        _tnode.row_tuples.push_back(1);
+        _tnode.nullable_tuples.push_back(false);
+        _tnode.agg_node.need_finalize = true;
+        _tnode.agg_node.intermediate_tuple_id = 1;
+        _tnode.agg_node.output_tuple_id = 1;
+        _tnode.agg_node.grouping_exprs.emplace_back(_create_slot_ref(TPrimitiveType::INT, 0));
+
+        TFunction fn;
+        fn.name.function_name = "sum";
+        fn.binary_type = TFunctionBinaryType::BUILTIN;
+        fn.arg_types.emplace_back(gen_type_desc(TPrimitiveType::BIGINT));
+        fn.ret_type = gen_type_desc(TPrimitiveType::BIGINT);
+        fn.has_var_args = false;
+        fn.aggregate_fn.intermediate_type = gen_type_desc(TPrimitiveType::BIGINT);
+        TExprNode sum_node;
+        sum_node.node_type = TExprNodeType::AGG_EXPR;
+        sum_node.type = gen_type_desc(TPrimitiveType::BIGINT);
+        sum_node.num_children = 1;
+        sum_node.__set_fn(fn);
+        sum_node.__set_agg_expr(TAggregateExpr());
+        sum_node.agg_expr.is_merge_agg = false;
+        sum_node.is_nullable = false;
+        sum_node.has_nullable_child = false;
+        TExpr sum_expr = _create_slot_ref(TPrimitiveType::BIGINT, 1);
+        sum_expr.nodes.insert(sum_expr.nodes.begin(), sum_node);
+        _tnode.agg_node.aggregate_functions.emplace_back(std::move(sum_expr));
+    }
+
+protected:
+    static TExpr _create_slot_ref(TPrimitiveType::type type, SlotId slot_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = gen_type_desc(type);
+        node.num_children = 0;
+        node.is_nullable = false;
+        TSlotRef ref;
+        ref.slot_id = slot_id;
+        ref.tuple_id = 0;
+        node.__set_slot_ref(ref);
+        TExpr expr;
+        expr.nodes.emplace_back(node);
+        return expr;
+    }
+
+    // The input of num_rows rows over num_keys keys, and the expected sums of the keys.
+    static std::vector<ChunkPtr> _create_input(int32_t num_rows, int32_t num_keys, std::map<int32_t, int64_t>* sums) {
+        std::vector<ChunkPtr> chunks;
+        for (int32_t row = 0; row < num_rows;) {
+            auto col_k = Int32Column::create();
+            auto col_v = Int64Column::create();
+            for (int32_t i = 0; i < config::vector_chunk_size && row < num_rows; i++, row++) {
+                int32_t k = static_cast<int32_t>((static_cast<int64_t>(row) * 7919) % num_keys);
+                col_k->append(k);
+                col_v->append(row);
+                (*sums)[k] += row;
+            }
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(col_k, 0);
+            chunk->append_column(col_v, 1);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    // Aggregate the input as AggregateBlockingNode::open() does, the hash map is spilled if it exceeds the
+    // memory limit of the mem tracker.
+    static void _consume(RuntimeState* state, Aggregator* aggregator, const std::vector<ChunkPtr>& chunks) {
+        for (const auto& chunk : chunks) {
+            aggregator->evaluate_exprs(chunk.get());
+            aggregator->build_hash_map(chunk->num_rows());
+            ASSERT_TRUE(aggregator->check_hash_map_memory_usage(state).ok());
+            aggregator->try_convert_to_two_level_map();
+            aggregator->compute_agg_states(chunk->num_rows());
+            aggregator->update_num_input_rows(chunk->num_rows());
+            ASSERT_TRUE(aggregator->try_spill_hash_map(state).ok());
+        }
+        if (aggregator->has_spilled()) {
+            ASSERT_TRUE(aggregator->finish_spill(state).ok());
+            ASSERT_TRUE(aggregator->restore_next_spilled_partition(state).ok());
+        } else {
+            aggregator->init_hash_map_iterator();
+        }
+    }
+
+    // Output the groups as AggregateBlockingNode::get_next() does, each group must be output only once.
+    static void _output(RuntimeState* state, Aggregator* aggregator, std::map<int32_t, int64_t>* groups) {
+        while (true) {
+            while (aggregator->is_finished() && aggregator->has_unrestored_spilled_partitions()) {
+                ASSERT_TRUE(aggregator->restore_next_spilled_partition(state).ok());
+            }
+            if (aggregator->is_finished()) {
+                return;
+            }
+            ChunkPtr chunk;
+            aggregator->convert_hash_map_to_chunk(config::vector_chunk_size, &chunk);
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                int32_t k = chunk->get_column_by_index(0)->get(i).get_int32();
+                int64_t sum = chunk->get_column_by_index(1)->get(i).get_int64();
+                ASSERT_TRUE(groups->emplace(k, sum).second) << "group " << k << " is output more than once";
+            }
+        }
+    }
+
+    std::unique_ptr<Aggregator> _create_aggregator(RuntimeState* state, MemTracker* mem_tracker) {
+        auto aggregator = std::make_unique<Aggregator>(_tnode);
+        EXPECT_TRUE(aggregator->prepare(state, &_pool, &_profile, mem_tracker).ok());
+        EXPECT_TRUE(aggregator->open(state).ok());
+        return aggregator;
+    }
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    TPlanNode _tnode;
+    RuntimeProfile _profile{"AggregatorSpillTest"};
+};
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorSpillTest, test_spill_and_restore) {
+    auto state = create_spill_runtime_state(11, _desc_tbl);
+    std::map<int32_t, int64_t> expected;
+    auto chunks = _create_input(64 * config::vector_chunk_size, 100003, &expected);
+
+    // The groups aggregated in memory.
+    std::map<int32_t, int64_t> in_memory_groups;
+    {
+        MemTracker mem_tracker(-1, "in_memory");
+        auto aggregator = _create_aggregator(state.get(), &mem_tracker);
+        _consume(state.get(), aggregator.get(), chunks);
+        ASSERT_FALSE(aggregator->has_spilled());
+        _output(state.get(), aggregator.get(), &in_memory_groups);
+        ASSERT_TRUE(aggregator->close(state.get()).ok());
+    }
+    ASSERT_EQ(expected, in_memory_groups);
+
+    // The groups regrouped from the spilled partitions are the same.
+    std::map<int32_t, int64_t> spilled_groups;
+    {
+        MemTracker mem_tracker(1024 * 1024, "spilled");
+        auto aggregator = _create_aggregator(state.get(), &mem_tracker);
+        _consume(state.get(), aggregator.get(), chunks);
+        ASSERT_TRUE(aggregator->has_spilled());
+        ASSERT_GT(count_spill_files(state->query_id()), 0U);
+        _output(state.get(), aggregator.get(), &spilled_groups);
+        ASSERT_TRUE(aggregator->close(state.get()).ok());
+        ASSERT_EQ(0U, count_spill_files(state->query_id()));
+    }
+    ASSERT_EQ(in_memory_groups, spilled_groups);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorSpillTest, test_cancel_after_spill) {
+    auto state = create_spill_runtime_state(12, _desc_tbl);
+    std::map<int32_t, int64_t> expected;
+    auto chunks = _create_input(64 * config::vector_chunk_size, 100003, &expected);
+
+    MemTracker mem_tracker(1024 * 1024, "cancelled");
+    auto aggregator = _create_aggregator(state.get(), &mem_tracker);
+    _consume(state.get(), aggregator.get(), chunks);
+    ASSERT_TRUE(aggregator->has_spilled());
+    ASSERT_TRUE(aggregator->has_unrestored_spilled_partitions());
+
+    // The query is cancelled before all the partitions are restored, the node is closed without output.
+    state->set_is_cancelled(true);
+    ASSERT_GT(count_spill_files(state->query_id()), 0U);
+    ASSERT_TRUE(aggregator->close(state.get()).ok());
+    ASSERT_EQ(0U, count_spill_files(state->query_id()));
+}
+
+} // namespace starrocks::vectorized
@@ -8,6 +8,7 @@
 #include <util/guard.h>
 
 #include "exec/vectorized/arrow_to_starrocks_converter.h"
+#include "simd/simd.h"
 
 #define ASSERT_STATUS_OK(stmt)    \
     do {                          \
@@ -97,6 +98,50 @@ void add_arrow_to_nullable_column(Column* column, size_t num_elements, ArrowCppT
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ArrowConverterTest, test_fill_null_column_and_filter) {
+    arrow::Int32Builder builder;
+    for (int i = 0; i < 200; ++i) {
+        if (i % 3 == 0 || i % 7 == 0) {
+            ASSERT_TRUE(builder.AppendNull().ok());
+        } else {
+            ASSERT_TRUE(builder.Append(i).ok());
+        }
+    }
+    std::shared_ptr<arrow::Array> array;
+    ASSERT_TRUE(builder.Finish(&array).ok());
+    // the slice isn't aligned to a byte of the bitmap
+    for (size_t offset : {0, 3, 13}) {
+        auto sliced = array->Slice(offset);
+        for (size_t start : {0, 5, 8}) {
+            size_t num_elements = sliced->length() - start;
+            auto null_column = NullColumn::create(2, 0);
+            size_t null_count = fill_null_column(sliced.get(), start, num_elements, null_column.get(), 2);
+            ASSERT_EQ(2 + num_elements, null_column->size());
+            Column::Filter filter(3 + num_elements, 0);
+            fill_filter(sliced.get(), start, num_elements, &filter, 3);
+            size_t expect_null_count = 0;
+            for (size_t i = 0; i < num_elements; ++i) {
+                bool is_null = sliced->IsNull(start + i);
+                expect_null_count += is_null;
+                ASSERT_EQ(is_null, null_column->get_data()[2 + i]);
+                ASSERT_EQ(!is_null, filter[3 + i]);
+            }
+            ASSERT_EQ(expect_null_count, null_count);
+        }
+    }
+
+    // an array without nulls has no bitmap
+    arrow::Int32Builder not_null_builder;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(not_null_builder.Append(i).ok());
+    }
+    ASSERT_TRUE(not_null_builder.Finish(&array).ok());
+    auto null_column = NullColumn::create();
+    ASSERT_EQ(0, fill_null_column(array.get(), 10, 90, null_column.get(), 0));
+    ASSERT_EQ(0, SIMD::count_nonzero(null_column->get_data().data(), null_column->size()));
+}
+
 TEST_F(ArrowConverterTest, test_copyable_converter_int8) {
     auto col = Int8Column::create();
     col->reserve(4096);
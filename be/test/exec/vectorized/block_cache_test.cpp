@@ -0,0 +1,138 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/block_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "util/file_utils.h"
+
+namespace starrocks::vectorized {
+
+// A file of the bytes of i % 251 at offset i, which counts the reads.
+class RemoteFile : public RandomAccessFile {
+public:
+    explicit RemoteFile(uint64_t size) : _size(size) {}
+    ~RemoteFile() override = default;
+
+    Status read(uint64_t offset, Slice* res) const override { return read_at(offset, *res); }
+
+    Status read_at(uint64_t offset, const Slice& res) const override {
+        if (offset + res.size > _size) {
+            return Status::IOError("read out of the file");
+        }
+        for (size_t i = 0; i < res.size; i++) {
+            res.data[i] = static_cast<char>((offset + i) % 251);
+        }
+        _num_reads++;
+        return Status::OK();
+    }
+
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
+        return Status::NotSupported("readv_at");
+    }
+
+    Status size(uint64_t* size) const override {
+        *size = _size;
+        return Status::OK();
+    }
+
+    const std::string& file_name() const override { return _name; }
+
+    int num_reads() const { return _num_reads; }
+
+private:
+    uint64_t _size;
+    std::string _name = "hdfs://nameservice/user/hive/warehouse/t/part-0.parquet";
+    mutable std::atomic<int> _num_reads{0};
+};
+
+class BlockCacheTest : public testing::Test {
+public:
+    void SetUp() override {
+        FileUtils::remove_all(_dir);
+        _cache = std::make_unique<BlockCache>(_dir + ",1", kBlockSize);
+        ASSERT_TRUE(_cache->init().ok());
+    }
+
+    void TearDown() override {
+        _cache.reset();
+        FileUtils::remove_all(_dir);
+    }
+
+protected:
+    static constexpr size_t kBlockSize = 4096;
+
+    // the blocks are populated asynchronously
+    void wait_cached_blocks(size_t num_blocks) {
+        for (int i = 0; i < 1000 && _cache->num_cached_blocks() < num_blocks; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        ASSERT_EQ(num_blocks, _cache->num_cached_blocks());
+    }
+
+    static void check_data(uint64_t offset, const std::string& data) {
+        for (size_t i = 0; i < data.size(); i++) {
+            ASSERT_EQ(static_cast<char>((offset + i) % 251), data[i]);
+        }
+    }
+
+    std::string _dir = "./ut_dir/block_cache_test";
+    std::unique_ptr<BlockCache> _cache;
+};
+
+// NOLINTNEXTLINE
+TEST_F(BlockCacheTest, test_read) {
+    auto remote_file = std::make_shared<RemoteFile>(50000);
+    BlockCacheFile file(remote_file, _cache.get(), 1000, 50000);
+
+    // the blocks [0, 2] are read by one remote read
+    std::string data(10000, 0);
+    ASSERT_TRUE(file.read_at(100, Slice(data)).ok());
+    check_data(100, data);
+    ASSERT_EQ(1, remote_file->num_reads());
+    ASSERT_EQ(10000, file.miss_bytes());
+    wait_cached_blocks(3);
+
+    ASSERT_TRUE(file.read_at(100, Slice(data)).ok());
+    check_data(100, data);
+    ASSERT_EQ(1, remote_file->num_reads());
+    ASSERT_EQ(10000, file.hit_bytes());
+
+    // the blocks [1, 2] are hit and the block 3 is missed
+    ASSERT_TRUE(file.read_at(5000, Slice(data)).ok());
+    check_data(5000, data);
+    ASSERT_EQ(2, remote_file->num_reads());
+    wait_cached_blocks(4);
+
+    // the last block is shorter than the others
+    std::string tail(2000, 0);
+    Slice slice(tail);
+    ASSERT_TRUE(file.read(49000, &slice).ok());
+    ASSERT_EQ(1000, slice.size);
+    check_data(49000, slice.to_string());
+    wait_cached_blocks(5);
+    ASSERT_TRUE(file.read_at(49500, Slice(tail.data(), 500)).ok());
+    check_data(49500, tail.substr(0, 500));
+    ASSERT_EQ(3, remote_file->num_reads());
+
+    // the file is rewritten
+    BlockCacheFile new_file(remote_file, _cache.get(), 2000, 50000);
+    ASSERT_TRUE(new_file.read_at(100, Slice(data)).ok());
+    check_data(100, data);
+    ASSERT_EQ(4, remote_file->num_reads());
+    ASSERT_EQ(0, new_file.hit_bytes());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BlockCacheTest, test_invalid_disks) {
+    ASSERT_FALSE(BlockCache(_dir, kBlockSize).init().ok());
+    ASSERT_FALSE(BlockCache(_dir + ",abc", kBlockSize).init().ok());
+    ASSERT_FALSE(BlockCache("", kBlockSize).init().ok());
+}
+
+} // namespace starrocks::vectorized
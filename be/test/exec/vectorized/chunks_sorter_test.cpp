@@ -6,7 +6,12 @@
 #include "column/datum_tuple.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
+#include "exec/vectorized/spill_test_helper.h"
 #include "exprs/slot_ref.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/mem_tracker.h"
+#include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/runtime_column_predicate.h"
 
 namespace starrocks::vectorized {
 
@@ -156,10 +161,10 @@ TEST_F(ChunksSorterTest, full_sort_by_2_columns_null_first) {
 
     bool eos = false;
     ChunkPtr page_1, page_2;
-    sorter.get_next(&page_1, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_1, &eos).ok());
     ASSERT_FALSE(eos);
     ASSERT_TRUE(page_1 != nullptr);
-    sorter.get_next(&page_2, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_2, &eos).ok());
     ASSERT_TRUE(eos);
     ASSERT_TRUE(page_2 == nullptr);
 
@@ -176,6 +181,51 @@ TEST_F(ChunksSorterTest, full_sort_by_2_columns_null_first) {
     clear_sort_exprs(sort_exprs);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, full_sort_by_normalized_keys) {
+    ColumnPtr col_a = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+    ColumnPtr col_b = ColumnHelper::create_column(TypeDescriptor(TYPE_BIGINT), false);
+    std::vector<std::pair<Datum, int64_t>> rows = {{Datum(int32_t(1)), 5},  {Datum(), 3},
+                                                   {Datum(int32_t(1)), -2}, {Datum(int32_t(-3)), 7},
+                                                   {Datum(), 1},            {Datum(int32_t(2)), -4}};
+    for (const auto& row : rows) {
+        col_a->append_datum(row.first);
+        col_b->append_datum(Datum(row.second));
+    }
+    butil::FlatMap<SlotId, size_t> map;
+    map.init(4);
+    map[0] = 0;
+    map[1] = 1;
+    ChunkPtr chunk = std::make_shared<Chunk>(Columns{col_a, col_b}, map);
+
+    SlotRef expr_a(TypeDescriptor(TYPE_INT), 0, 0);
+    SlotRef expr_b(TypeDescriptor(TYPE_BIGINT), 0, 1);
+    std::vector<bool> is_asc{true, false};
+    std::vector<bool> is_null_first{true, false};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(&expr_a));
+    sort_exprs.push_back(new ExprContext(&expr_b));
+
+    ChunksSorterFullSort sorter(&sort_exprs, &is_asc, &is_null_first, 2);
+    sorter.update(nullptr, chunk);
+    sorter.done(nullptr);
+
+    bool eos = false;
+    ChunkPtr page;
+    ASSERT_TRUE(sorter.get_next(&page, &eos).ok());
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(rows.size(), page->num_rows());
+    // a asc nulls first, b desc
+    std::vector<int64_t> expected_b = {3, 1, 7, 5, -2, -4};
+    for (size_t i = 0; i < expected_b.size(); ++i) {
+        ASSERT_EQ(expected_b[i], page->get(i).get(1).get_int64());
+    }
+    ASSERT_TRUE(page->get(0).get(0).is_null());
+    ASSERT_EQ(-3, page->get(2).get(0).get_int32());
+
+    clear_sort_exprs(sort_exprs);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunksSorterTest, full_sort_by_2_columns_null_last) {
     std::vector<bool> is_asc, is_null_first;
@@ -196,10 +246,10 @@ TEST_F(ChunksSorterTest, full_sort_by_2_columns_null_last) {
 
     bool eos = false;
     ChunkPtr page_1, page_2;
-    sorter.get_next(&page_1, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_1, &eos).ok());
     ASSERT_FALSE(eos);
     ASSERT_TRUE(page_1 != nullptr);
-    sorter.get_next(&page_2, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_2, &eos).ok());
     ASSERT_TRUE(eos);
     ASSERT_TRUE(page_2 == nullptr);
 
@@ -239,10 +289,10 @@ TEST_F(ChunksSorterTest, full_sort_by_3_columns) {
 
     bool eos = false;
     ChunkPtr page_1, page_2;
-    sorter.get_next(&page_1, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_1, &eos).ok());
     ASSERT_FALSE(eos);
     ASSERT_TRUE(page_1 != nullptr);
-    sorter.get_next(&page_2, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_2, &eos).ok());
     ASSERT_TRUE(eos);
     ASSERT_TRUE(page_2 == nullptr);
 
@@ -283,10 +333,10 @@ TEST_F(ChunksSorterTest, full_sort_by_4_columns) {
 
     bool eos = false;
     ChunkPtr page_1, page_2;
-    sorter.get_next(&page_1, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_1, &eos).ok());
     ASSERT_FALSE(eos);
     ASSERT_TRUE(page_1 != nullptr);
-    sorter.get_next(&page_2, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_2, &eos).ok());
     ASSERT_TRUE(eos);
     ASSERT_TRUE(page_2 == nullptr);
 
@@ -326,10 +376,10 @@ TEST_F(ChunksSorterTest, part_sort_by_3_columns_null_fisrt) {
 
     bool eos = false;
     ChunkPtr page_1, page_2;
-    sorter.get_next(&page_1, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_1, &eos).ok());
     ASSERT_FALSE(eos);
     ASSERT_TRUE(page_1 != nullptr);
-    sorter.get_next(&page_2, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_2, &eos).ok());
     ASSERT_TRUE(eos);
     ASSERT_TRUE(page_2 == nullptr);
 
@@ -368,10 +418,10 @@ TEST_F(ChunksSorterTest, part_sort_by_3_columns_null_last) {
 
     bool eos = false;
     ChunkPtr page_1, page_2;
-    sorter.get_next(&page_1, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_1, &eos).ok());
     ASSERT_FALSE(eos);
     ASSERT_TRUE(page_1 != nullptr);
-    sorter.get_next(&page_2, &eos);
+    ASSERT_TRUE(sorter.get_next(&page_2, &eos).ok());
     ASSERT_TRUE(eos);
     ASSERT_TRUE(page_2 == nullptr);
 
@@ -392,7 +442,7 @@ TEST_F(ChunksSorterTest, part_sort_by_3_columns_null_last) {
     sorter2.done(nullptr);
     eos = false;
     page_1->reset();
-    sorter2.get_next(&page_1, &eos);
+    ASSERT_TRUE(sorter2.get_next(&page_1, &eos).ok());
     ASSERT_TRUE(eos);
     ASSERT_TRUE(page_1 == nullptr);
 
@@ -425,10 +475,10 @@ TEST_F(ChunksSorterTest, order_by_with_unequal_sized_chunks) {
 
     bool eos = false;
     ChunkPtr page_1, page_2;
-    full_sorter.get_next(&page_1, &eos);
+    ASSERT_TRUE(full_sorter.get_next(&page_1, &eos).ok());
     ASSERT_FALSE(eos);
     ASSERT_TRUE(page_1 != nullptr);
-    full_sorter.get_next(&page_2, &eos);
+    ASSERT_TRUE(full_sorter.get_next(&page_2, &eos).ok());
     ASSERT_TRUE(eos);
     ASSERT_TRUE(page_2 == nullptr);
     ASSERT_EQ(6, page_1->num_rows());
@@ -441,4 +491,109 @@ TEST_F(ChunksSorterTest, order_by_with_unequal_sized_chunks) {
     clear_sort_exprs(sort_exprs);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, topn_runtime_predicate) {
+    ASSERT_TRUE(ChunksSorterTopn::support_runtime_predicate(TYPE_INT));
+    ASSERT_FALSE(ChunksSorterTopn::support_runtime_predicate(TYPE_VARCHAR));
+
+    std::vector<bool> is_asc{true};
+    std::vector<bool> is_null_first{false};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    RuntimeColumnPredicate runtime_pred("cust_key", true, false);
+    ChunksSorterTopn sorter(&sort_exprs, &is_asc, &is_null_first, 1, 3, 2);
+    sorter.set_runtime_predicate(&runtime_pred, TYPE_INT);
+    sorter.update(nullptr, _chunk_1);
+    sorter.update(nullptr, _chunk_2);
+    sorter.done(nullptr);
+
+    // The top 4 rows are 2, 4, 6 and 12.
+    ASSERT_EQ(1, runtime_pred.version());
+    ObjectPool pool;
+    int64_t version = 0;
+    const ColumnPredicate* pred = runtime_pred.new_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, &pool, &version);
+    ASSERT_TRUE(pred != nullptr);
+    ASSERT_EQ(1, version);
+
+    // 6, 24, 52, 56, 70
+    const Column* column = _chunk_3->get_column_by_index(0).get();
+    std::vector<uint8_t> selection(column->size());
+    pred->evaluate(column, selection.data(), 0, column->size());
+    std::vector<uint8_t> expected{1, 0, 0, 0, 0};
+    ASSERT_EQ(expected, selection);
+
+    clear_sort_exprs(sort_exprs);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, full_sort_with_spill) {
+    TDescriptorTableBuilder desc_tbl_builder;
+    TTupleDescriptorBuilder tuple_builder;
+    tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false).column_name("a").build());
+    tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).nullable(false).column_name("b").build());
+    tuple_builder.build(&desc_tbl_builder);
+    ObjectPool pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    ASSERT_TRUE(DescriptorTbl::create(&pool, desc_tbl_builder.desc_tbl(), &desc_tbl).ok());
+    auto state = create_spill_runtime_state(13, desc_tbl);
+
+    SlotRef expr_a(TypeDescriptor(TYPE_INT), 0, 0);
+    std::vector<bool> is_asc{true};
+    std::vector<bool> is_null_first{true};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(&expr_a));
+
+    // The memory limit holds a few chunks, so the input is spilled to several sorted runs.
+    const int32_t num_chunks = 16;
+    MemTracker mem_tracker(64 * 1024, "full_sort_with_spill");
+    RuntimeProfile profile("full_sort_with_spill");
+    ADD_TIMER(&profile, "ChunksSorter");
+    auto sorter = std::make_unique<ChunksSorterFullSort>(&sort_exprs, &is_asc, &is_null_first, 2);
+    sorter->setup_runtime(&mem_tracker, &profile, "ChunksSorter");
+
+    std::vector<int32_t> expected;
+    for (int32_t i = 0; i < num_chunks; i++) {
+        auto col_a = Int32Column::create();
+        auto col_b = Int64Column::create();
+        for (int32_t j = 0; j < config::vector_chunk_size; j++) {
+            int32_t row = i * config::vector_chunk_size + j;
+            int32_t a = (row * 7919) % 100003;
+            col_a->append(a);
+            col_b->append(static_cast<int64_t>(a) * 2);
+            expected.push_back(a);
+        }
+        butil::FlatMap<SlotId, size_t> map;
+        map.init(4);
+        map[0] = 0;
+        map[1] = 1;
+        ASSERT_TRUE(sorter->update(state.get(), std::make_shared<Chunk>(Columns{col_a, col_b}, map)).ok());
+    }
+    ASSERT_TRUE(sorter->done(state.get()).ok());
+    ASSERT_GT(count_spill_files(state->query_id()), 1U);
+
+    // The rows of all the runs and the rows left in memory are merged in order.
+    std::sort(expected.begin(), expected.end());
+    size_t num_rows = 0;
+    bool eos = false;
+    while (!eos) {
+        ChunkPtr page;
+        ASSERT_TRUE(sorter->get_next(&page, &eos).ok());
+        if (eos) {
+            break;
+        }
+        for (size_t i = 0; i < page->num_rows(); ++i, ++num_rows) {
+            int32_t a = page->get(i).get(0).get_int32();
+            ASSERT_EQ(expected[num_rows], a) << "row " << num_rows;
+            ASSERT_EQ(static_cast<int64_t>(a) * 2, page->get(i).get(1).get_int64());
+        }
+    }
+    ASSERT_EQ(expected.size(), num_rows);
+
+    // The sorted runs are removed with the sorter.
+    sorter.reset();
+    ASSERT_EQ(0U, count_spill_files(state->query_id()));
+    clear_sort_exprs(sort_exprs);
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,131 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/coalesced_read_file.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+
+#include "exec/vectorized/hdfs_scanner.h"
+#include "util/priority_thread_pool.hpp"
+
+namespace starrocks::vectorized {
+
+// A file of the bytes of i % 256 at offset i, which counts the reads.
+class CountedFile : public RandomAccessFile {
+public:
+    explicit CountedFile(uint64_t size) : _size(size) {}
+    ~CountedFile() override = default;
+
+    Status read(uint64_t offset, Slice* res) const override { return read_at(offset, *res); }
+
+    Status read_at(uint64_t offset, const Slice& res) const override {
+        if (offset + res.size > _size) {
+            return Status::IOError("read out of the file");
+        }
+        for (size_t i = 0; i < res.size; i++) {
+            res.data[i] = static_cast<char>((offset + i) % 256);
+        }
+        _num_reads++;
+        return Status::OK();
+    }
+
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
+        for (size_t i = 0; i < res_cnt; i++) {
+            RETURN_IF_ERROR(read_at(offset, res[i]));
+            offset += res[i].size;
+        }
+        return Status::OK();
+    }
+
+    Status size(uint64_t* size) const override {
+        *size = _size;
+        return Status::OK();
+    }
+
+    const std::string& file_name() const override { return _name; }
+
+    int num_reads() const { return _num_reads; }
+
+private:
+    uint64_t _size;
+    std::string _name = "counted_file";
+    mutable std::atomic<int> _num_reads{0};
+};
+
+static void check_data(uint64_t offset, const std::string& data) {
+    for (size_t i = 0; i < data.size(); i++) {
+        ASSERT_EQ(static_cast<char>((offset + i) % 256), data[i]);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(CoalescedReadFileTest, test_coalesce) {
+    auto file = std::make_shared<CountedFile>(64 << 20);
+    HdfsScanStats stats;
+    CoalescedReadFile coalesced_file(file, nullptr, &stats);
+    // [0, 100) and [150, 250) are merged, [32MB, 32MB + 100) is far from them.
+    coalesced_file.plan({{150, 100}, {0, 100}, {32 << 20, 100}});
+    coalesced_file.plan({{200, 100}, {48 << 20, 100}});
+
+    // not prefetched yet
+    std::string data(30, 0);
+    ASSERT_TRUE(coalesced_file.read_at(20, Slice(data)).ok());
+    ASSERT_EQ(1, file->num_reads());
+
+    coalesced_file.prefetch(0, 40 << 20);
+    ASSERT_TRUE(coalesced_file.read_at(20, Slice(data)).ok());
+    check_data(20, data);
+    ASSERT_EQ(2, file->num_reads());
+    Slice slice(data);
+    ASSERT_TRUE(coalesced_file.read(210, &slice).ok());
+    check_data(210, data);
+    ASSERT_TRUE(coalesced_file.read_at((32 << 20) + 10, Slice(data)).ok());
+    check_data((32 << 20) + 10, data);
+    ASSERT_EQ(3, file->num_reads());
+    ASSERT_EQ(2, stats.io_coalesced_count);
+    ASSERT_EQ(350, stats.io_coalesced_bytes);
+
+    // out of the planned ranges
+    ASSERT_TRUE(coalesced_file.read_at(240, Slice(data)).ok());
+    check_data(240, data);
+    ASSERT_TRUE(coalesced_file.read_at(48 << 20, Slice(data)).ok());
+    ASSERT_EQ(5, file->num_reads());
+
+    coalesced_file.release(0, 1000);
+    ASSERT_TRUE(coalesced_file.read_at(20, Slice(data)).ok());
+    check_data(20, data);
+    ASSERT_EQ(6, file->num_reads());
+}
+
+// NOLINTNEXTLINE
+TEST(CoalescedReadFileTest, test_prefetch) {
+    auto file = std::make_shared<CountedFile>(64 << 20);
+    PriorityThreadPool io_threads(2, 16);
+    HdfsScanStats stats;
+    {
+        CoalescedReadFile coalesced_file(file, &io_threads, &stats);
+        std::vector<CoalescedReadFile::IORange> ranges;
+        // The gaps between them are too large to merge them.
+        for (uint64_t i = 0; i < 8; i++) {
+            ranges.emplace_back(i * (4 << 20), 1 << 20);
+        }
+        coalesced_file.plan(ranges);
+        coalesced_file.prefetch(0, 64 << 20);
+
+        std::string data(1000, 0);
+        for (uint64_t i = 0; i < 8; i++) {
+            ASSERT_TRUE(coalesced_file.read_at(i * (4 << 20) + 100, Slice(data)).ok());
+            check_data(i * (4 << 20) + 100, data);
+        }
+        std::vector<std::string> datas(3, std::string(10, 0));
+        std::vector<Slice> slices{Slice(datas[0]), Slice(datas[1]), Slice(datas[2])};
+        ASSERT_TRUE(coalesced_file.readv_at(5 * (4 << 20), slices.data(), slices.size()).ok());
+        check_data(5 * (4 << 20), datas[0] + datas[1] + datas[2]);
+    }
+    ASSERT_EQ(8, file->num_reads());
+    ASSERT_EQ(8 << 20, stats.io_coalesced_bytes);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,277 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "common/object_pool.h"
+#include "exec/vectorized/hash_join_node.h"
+#include "exec/vectorized/spill_test_helper.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/primitive_type.h"
+
+namespace starrocks::vectorized {
+
+// The chunks of a side of the join, they are copied when output, because the join node merges the small
+// chunks of the probe side in place.
+class MockChunkSourceNode : public ExecNode {
+public:
+    MockChunkSourceNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                        const std::vector<ChunkPtr>& chunks)
+            : ExecNode(pool, tnode, descs), _chunks(chunks) {}
+
+    Status init(const TPlanNode& tnode, RuntimeState* state) override { return Status::OK(); }
+    Status prepare(RuntimeState* state) override { return Status::OK(); }
+    Status open(RuntimeState* state) override { return Status::OK(); }
+    Status close(RuntimeState* state) override { return Status::OK(); }
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("get_next for row_batch is not supported");
+    }
+
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override {
+        *eos = _next_chunk == _chunks.size();
+        if (!*eos) {
+            const ChunkPtr& next_chunk = _chunks[_next_chunk++];
+            *chunk = next_chunk->clone_empty_with_slot(next_chunk->num_rows());
+            (*chunk)->append(*next_chunk);
+        }
+        return Status::OK();
+    }
+
+private:
+    const std::vector<ChunkPtr>& _chunks;
+    size_t _next_chunk = 0;
+};
+
+// The probe side is k (0) and v (1) of tuple 0, and the build side is k (2) and v (3) of tuple 1, they are
+// joined on probe.k = build.k.
+class HashJoinNodeSpillTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        TDescriptorTableBuilder desc_tbl_builder;
+        for (int i = 0; i < 2; i++) {
+            TTupleDescriptorBuilder tuple_builder;
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false).column_name("k").build());
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).nullable(false).column_name("v").build());
+            tuple_builder.build(&desc_tbl_builder);
+        }
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &_desc_tbl).ok());
+
+        // About half of the probe rows match one or two build rows.
+        _probe_chunks = _create_chunks(0, 32 * config::vector_chunk_size, 104729, 262139);
+        _build_chunks = _create_chunks(2, 48 * config::vector_chunk_size, 7919, 131071);
+    }
+
+protected:
+    // The v of the probe side and the v of the build side of the joined rows, -1 if the build side is null
+    // or isn't output.
+    using JoinedRows = std::vector<std::pair<int64_t, int64_t>>;
+
+    static std::vector<ChunkPtr> _create_chunks(SlotId slot_id, int32_t num_rows, int64_t multiplier,
+                                                int32_t num_keys) {
+        std::vector<ChunkPtr> chunks;
+        for (int32_t row = 0; row < num_rows;) {
+            auto col_k = Int32Column::create();
+            auto col_v = Int64Column::create();
+            for (int32_t i = 0; i < config::vector_chunk_size && row < num_rows; i++, row++) {
+                col_k->append(static_cast<int32_t>(row * multiplier % num_keys));
+                col_v->append(row);
+            }
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(col_k, slot_id);
+            chunk->append_column(col_v, slot_id + 1);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    static TExpr _create_slot_ref(SlotId slot_id, TupleId tuple_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        node.num_children = 0;
+        TSlotRef ref;
+        ref.slot_id = slot_id;
+        ref.tuple_id = tuple_id;
+        node.__set_slot_ref(ref);
+        TExpr expr;
+        expr.nodes.emplace_back(node);
+        return expr;
+    }
+
+    static TPlanNode _create_join_tnode(TJoinOp::type join_op) {
+        const bool outputs_build_side = join_op == TJoinOp::INNER_JOIN || join_op == TJoinOp::LEFT_OUTER_JOIN;
+        TPlanNode tnode;
+        tnode.node_id = 1;
+        tnode.node_type = TPlanNodeType::HASH_JOIN_NODE;
+        tnode.num_children = 2;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(0);
+        tnode.nullable_tuples.push_back(false);
+        if (outputs_build_side) {
+            tnode.row_tuples.push_back(1);
+            tnode.nullable_tuples.push_back(join_op == TJoinOp::LEFT_OUTER_JOIN);
+        }
+        tnode.hash_join_node.join_op = join_op;
+        TEqJoinCondition eq_join_conjunct;
+        eq_join_conjunct.left = _create_slot_ref(0, 0);
+        eq_join_conjunct.right = _create_slot_ref(2, 1);
+        eq_join_conjunct.__set_opcode(TExprOpcode::EQ);
+        tnode.hash_join_node.eq_join_conjuncts.emplace_back(std::move(eq_join_conjunct));
+        tnode.hash_join_node.__set_is_push_down(false);
+        tnode.hash_join_node.__set_is_rewritten_from_not_in(false);
+        return tnode;
+    }
+
+    static TPlanNode _create_child_tnode(TPlanNodeId node_id, TupleId tuple_id) {
+        TPlanNode tnode;
+        tnode.node_id = node_id;
+        tnode.node_type = TPlanNodeType::EXCHANGE_NODE;
+        tnode.num_children = 0;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(tuple_id);
+        tnode.nullable_tuples.push_back(false);
+        return tnode;
+    }
+
+    // Join the two sides by a hash join node, the memory of the fragment instance is limited by mem_limit
+    // if it's positive. The partition level is the level of the first spilled partition probed, or -1 if
+    // the join isn't spilled.
+    void _join(TJoinOp::type join_op, int64_t mem_limit, int64_t query_id_lo, JoinedRows* rows,
+               int* partition_level) {
+        auto state = create_spill_runtime_state(query_id_lo, _desc_tbl);
+        if (mem_limit > 0) {
+            state->_instance_mem_tracker = std::make_unique<MemTracker>(mem_limit, "HashJoinNodeSpillTest");
+        }
+        TPlanNode tnode = _create_join_tnode(join_op);
+        HashJoinNode join_node(&_pool, tnode, *_desc_tbl);
+        MockChunkSourceNode probe_node(&_pool, _create_child_tnode(2, 0), *_desc_tbl, _probe_chunks);
+        MockChunkSourceNode build_node(&_pool, _create_child_tnode(3, 1), *_desc_tbl, _build_chunks);
+        join_node._children.push_back(&probe_node);
+        join_node._children.push_back(&build_node);
+        ASSERT_TRUE(join_node.init(tnode, state.get()).ok());
+        ASSERT_TRUE(join_node.prepare(state.get()).ok());
+        ASSERT_TRUE(join_node.open(state.get()).ok());
+
+        const auto& build_spiller = join_node._probing_partition.build_spiller;
+        *partition_level = build_spiller == nullptr ? -1 : static_cast<int>(build_spiller->partition_level());
+        if (build_spiller != nullptr) {
+            ASSERT_GT(count_spill_files(state->query_id()), 0U);
+        }
+
+        bool eos = false;
+        while (!eos) {
+            ChunkPtr chunk;
+            ASSERT_TRUE(join_node.get_next(state.get(), &chunk, &eos).ok());
+            if (eos) {
+                break;
+            }
+            const bool has_build_side = chunk->is_slot_exist(3);
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                int64_t probe_v = chunk->get_column_by_slot_id(1)->get(i).get_int64();
+                int64_t build_v = -1;
+                if (has_build_side) {
+                    Datum datum = chunk->get_column_by_slot_id(3)->get(i);
+                    build_v = datum.is_null() ? -1 : datum.get_int64();
+                }
+                rows->emplace_back(probe_v, build_v);
+            }
+        }
+        std::sort(rows->begin(), rows->end());
+
+        // The temporary files of the spilled partitions are removed after they are joined.
+        ASSERT_TRUE(join_node.close(state.get()).ok());
+        ASSERT_EQ(0U, count_spill_files(state->query_id()));
+    }
+
+    // Join the two sides by one pass over all the rows in memory, and compare the results of the hash join
+    // node with and without spilling with it.
+    void _test_join(TJoinOp::type join_op, int64_t mem_limit, int expected_partition_level) {
+        std::unordered_map<int32_t, std::vector<int64_t>> build_rows;
+        for (const auto& chunk : _build_chunks) {
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                build_rows[chunk->get(i).get(0).get_int32()].emplace_back(chunk->get(i).get(1).get_int64());
+            }
+        }
+        JoinedRows expected;
+        for (const auto& chunk : _probe_chunks) {
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                auto it = build_rows.find(chunk->get(i).get(0).get_int32());
+                int64_t probe_v = chunk->get(i).get(1).get_int64();
+                const bool matched = it != build_rows.end();
+                if (join_op == TJoinOp::INNER_JOIN || join_op == TJoinOp::LEFT_OUTER_JOIN) {
+                    if (matched) {
+                        for (int64_t build_v : it->second) {
+                            expected.emplace_back(probe_v, build_v);
+                        }
+                    } else if (join_op == TJoinOp::LEFT_OUTER_JOIN) {
+                        expected.emplace_back(probe_v, -1);
+                    }
+                } else if (matched == (join_op == TJoinOp::LEFT_SEMI_JOIN)) {
+                    expected.emplace_back(probe_v, -1);
+                }
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        ASSERT_FALSE(expected.empty());
+
+        JoinedRows in_memory_rows;
+        int partition_level = 0;
+        _join(join_op, -1, 100 + join_op * 2, &in_memory_rows, &partition_level);
+        ASSERT_EQ(-1, partition_level);
+        ASSERT_EQ(expected, in_memory_rows);
+
+        JoinedRows spilled_rows;
+        _join(join_op, mem_limit, 101 + join_op * 2, &spilled_rows, &partition_level);
+        ASSERT_EQ(expected_partition_level, partition_level);
+        ASSERT_EQ(in_memory_rows, spilled_rows);
+    }
+
+    // The hash table of the build side is spilled once it's about half of the limit, and a spilled
+    // partition, about 1/32 of the build side, fits in the limit.
+    static constexpr int64_t spill_mem_limit = 1024 * 1024;
+    // A chunk of the build side is about the limit, so the spilled partitions are partitioned again.
+    static constexpr int64_t repartition_mem_limit = 64 * 1024;
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::vector<ChunkPtr> _probe_chunks;
+    std::vector<ChunkPtr> _build_chunks;
+};
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinNodeSpillTest, test_inner_join) {
+    _test_join(TJoinOp::INNER_JOIN, spill_mem_limit, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinNodeSpillTest, test_left_outer_join) {
+    _test_join(TJoinOp::LEFT_OUTER_JOIN, spill_mem_limit, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinNodeSpillTest, test_left_semi_join) {
+    _test_join(TJoinOp::LEFT_SEMI_JOIN, spill_mem_limit, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinNodeSpillTest, test_left_anti_join) {
+    _test_join(TJoinOp::LEFT_ANTI_JOIN, spill_mem_limit, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinNodeSpillTest, test_repartition) {
+    _test_join(TJoinOp::INNER_JOIN, repartition_mem_limit, 1);
+    _test_join(TJoinOp::LEFT_OUTER_JOIN, repartition_mem_limit, 1);
+}
+
+} // namespace starrocks::vectorized
@@ -495,7 +495,6 @@ void JoinHashMapTest::prepare_table_items(JoinHashTableItems* table_items, uint3
     table_items->row_count = row_count;
     table_items->next.resize(row_count + 1);
     table_items->build_pool = std::make_unique<MemPool>(_mem_tracker.get());
-    table_items->probe_pool = std::make_unique<MemPool>(_mem_tracker.get());
     table_items->mem_tracker = _mem_tracker.get();
     table_items->search_ht_timer = ADD_TIMER(_runtime_profile, "SearchHashTableTimer");
     table_items->output_build_column_timer = ADD_TIMER(_runtime_profile, "OutputBuildColumnTimer");
@@ -912,6 +911,184 @@ TEST_F(JoinHashMapTest, JoinBuildProbeFunc) {
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
+// The build rows inserted partition by partition have the same bucket chains as the ones inserted in order.
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, RadixPartitionedBuild) {
+    const uint32_t row_count = 9000;
+    auto build_column = ColumnHelper::create_column(TypeDescriptor::from_primtive_type(TYPE_INT), true);
+    build_column->append_default();
+    for (uint32_t i = 0; i < row_count; i++) {
+        if (i % 10 == 0) {
+            build_column->append_nulls(1);
+        } else {
+            build_column->append_datum(Datum(static_cast<int32_t>(i % 3000)));
+        }
+    }
+
+    auto build = [&](uint32_t radix_bits, JoinHashTableItems* table_items) {
+        HashTableProbeState probe_state;
+        table_items->key_columns.emplace_back(build_column);
+        table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(row_count + 1);
+        table_items->row_count = row_count;
+        table_items->first.resize(table_items->bucket_size, 0);
+        table_items->next.resize(row_count + 1, 0);
+        table_items->radix_bits = radix_bits;
+        if (radix_bits > 0) {
+            table_items->build_buckets.resize(row_count + 1, JoinHashMapHelper::kNullBucket);
+        }
+        probe_state.buckets.resize(config::vector_chunk_size);
+        ASSERT_TRUE(JoinBuildFunc<TYPE_INT>::construct_hash_table(table_items, &probe_state).ok());
+        if (radix_bits > 0) {
+            JoinHashMapHelper::insert_partitioned_rows(table_items);
+        }
+    };
+
+    JoinHashTableItems in_order;
+    build(0, &in_order);
+    JoinHashTableItems partitioned;
+    build(4, &partitioned);
+    ASSERT_EQ(in_order.first, partitioned.first);
+    ASSERT_EQ(in_order.next, partitioned.next);
+    ASSERT_TRUE(partitioned.build_buckets.empty());
+
+    // The null rows aren't inserted.
+    ASSERT_EQ(0, partitioned.next[1]);
+    for (uint32_t head : partitioned.first) {
+        ASSERT_NE(1, head);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, CalcRadixBits) {
+    const int64_t partition_bytes = config::join_hash_table_radix_partition_bytes;
+    config::join_hash_table_radix_partition_bytes = 1024;
+    ASSERT_EQ(0, JoinHashMapHelper::calc_radix_bits(256));
+    ASSERT_EQ(2, JoinHashMapHelper::calc_radix_bits(1024));
+    ASSERT_EQ(JoinHashMapHelper::kMaxRadixBits, JoinHashMapHelper::calc_radix_bits(1U << 30));
+    config::join_hash_table_radix_partition_bytes = 0;
+    ASSERT_EQ(0, JoinHashMapHelper::calc_radix_bits(1U << 30));
+    config::join_hash_table_radix_partition_bytes = partition_bytes;
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, GroupHeavyBuckets) {
+    const uint32_t row_count = 6000;
+    const uint32_t bucket_size = JoinHashMapHelper::calc_bucket_size(row_count + 1);
+    // The heavy key 7, and two keys of the same bucket.
+    const uint32_t heavy_bucket = JoinHashMapHelper::calc_bucket_num<int32_t>(7, bucket_size);
+    std::vector<int32_t> colliding_keys;
+    for (int32_t key = 100000; colliding_keys.size() < 2; key++) {
+        if (JoinHashMapHelper::calc_bucket_num<int32_t>(key, bucket_size) == heavy_bucket) {
+            colliding_keys.emplace_back(key);
+        }
+    }
+
+    auto build_column = ColumnHelper::create_column(TypeDescriptor::from_primtive_type(TYPE_INT), false);
+    build_column->append_default();
+    for (uint32_t i = 0; i < row_count; i++) {
+        int32_t key = static_cast<int32_t>(10000 + i);
+        if (i % 2 == 0) {
+            key = 7;
+        } else if (i % 101 == 1) {
+            key = colliding_keys[i % 3 == 0 ? 0 : 1];
+        }
+        build_column->append_datum(Datum(key));
+    }
+
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+    table_items.key_columns.emplace_back(build_column);
+    table_items.bucket_size = bucket_size;
+    table_items.row_count = row_count;
+    table_items.first.resize(bucket_size, 0);
+    table_items.next.resize(row_count + 1, 0);
+    probe_state.buckets.resize(config::vector_chunk_size);
+    ASSERT_TRUE(JoinBuildFunc<TYPE_INT>::construct_hash_table(&table_items, &probe_state).ok());
+    std::vector<uint32_t> chain;
+    for (uint32_t row = table_items.first[heavy_bucket]; row != 0; row = table_items.next[row]) {
+        chain.emplace_back(row);
+    }
+    ASSERT_EQ(table_items.next.data(), table_items.mismatch_next());
+
+    const int64_t heavy_bucket_rows = config::join_hash_table_heavy_bucket_rows;
+    config::join_hash_table_heavy_bucket_rows = 1000;
+    const auto& build_data = JoinBuildFunc<TYPE_INT>::get_key_data(table_items);
+    JoinHashMapHelper::group_heavy_buckets<int32_t>(&table_items, build_data);
+    config::join_hash_table_heavy_bucket_rows = heavy_bucket_rows;
+    ASSERT_EQ(1, table_items.heavy_bucket_count);
+    ASSERT_EQ(table_items.key_next.data(), table_items.mismatch_next());
+
+    // The chain has the same rows, grouped by the keys in the order of their first rows, and the rows of a key
+    // keep their order.
+    std::vector<uint32_t> grouped_chain;
+    for (uint32_t row = table_items.first[heavy_bucket]; row != 0; row = table_items.next[row]) {
+        grouped_chain.emplace_back(row);
+    }
+    std::vector<int32_t> chain_keys;
+    for (uint32_t row : chain) {
+        if (std::find(chain_keys.begin(), chain_keys.end(), build_data[row]) == chain_keys.end()) {
+            chain_keys.emplace_back(build_data[row]);
+        }
+    }
+    ASSERT_GE(chain_keys.size(), 3);
+    ASSERT_EQ(7, chain_keys[0]);
+    std::vector<uint32_t> expected_chain;
+    for (int32_t key : chain_keys) {
+        for (uint32_t row : chain) {
+            if (build_data[row] == key) {
+                expected_chain.emplace_back(row);
+            }
+        }
+    }
+    ASSERT_EQ(expected_chain, grouped_chain);
+
+    // A probe row of another key skips the rows of a key.
+    std::vector<int32_t> keys;
+    for (uint32_t row = table_items.first[heavy_bucket]; row != 0; row = table_items.mismatch_next()[row]) {
+        keys.emplace_back(build_data[row]);
+    }
+    ASSERT_EQ(chain_keys, keys);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, DirectMappingJoinBuildProbeFunc) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+
+    // The build keys are 100..109, and the probe keys are 95..114.
+    auto type = TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_INT);
+    auto build_column = ColumnHelper::create_column(type, false);
+    build_column->append_default();
+    build_column->append(*JoinHashMapTest::create_int32_column(10, 100), 0, 10);
+    auto probe_column = JoinHashMapTest::create_int32_column(20, 95);
+    table_items.direct_mapping_min = 100;
+    table_items.direct_mapping_max = 109;
+    table_items.first.resize(10, 0);
+    table_items.key_columns.emplace_back(build_column);
+    table_items.bucket_size = 10;
+    table_items.row_count = 10;
+    table_items.next.resize(11);
+    probe_state.probe_row_count = 20;
+    probe_state.buckets.resize(config::vector_chunk_size);
+    probe_state.next.resize(config::vector_chunk_size, 0);
+    Columns probe_columns{probe_column};
+    probe_state.key_columns = &probe_columns;
+
+    DirectMappingJoinBuildFunc<PrimitiveType::TYPE_INT>::construct_hash_table(&table_items, &probe_state);
+    DirectMappingJoinProbeFunc<PrimitiveType::TYPE_INT>::prepare(&table_items, &probe_state);
+    DirectMappingJoinProbeFunc<PrimitiveType::TYPE_INT>::lookup_init(table_items, &probe_state);
+
+    for (size_t i = 0; i < 20; i++) {
+        int32_t key = 95 + i;
+        if (key < 100 || key > 109) {
+            ASSERT_EQ(probe_state.next[i], 0);
+        } else {
+            ASSERT_EQ(probe_state.next[i], key - 100 + 1);
+            ASSERT_EQ(table_items.next[probe_state.next[i]], 0);
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, JoinBuildProbeFuncNullable) {
     JoinHashTableItems table_items;
@@ -1114,7 +1291,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
     table_items.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
     table_items.mem_tracker = runtime_state->instance_mem_tracker();
     table_items.build_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
-    table_items.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
+    probe_state.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
     probe_state.probe_row_count = 10;
     probe_state.buckets.resize(config::vector_chunk_size);
     probe_state.next.resize(config::vector_chunk_size, 0);
@@ -1143,7 +1320,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
         ASSERT_EQ(found_count, 1);
     }
     table_items.build_pool.reset();
-    table_items.probe_pool.reset();
+    probe_state.probe_pool.reset();
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
@@ -1177,7 +1354,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFuncNullable) {
     table_items.next.resize(11);
     table_items.mem_tracker = runtime_state->instance_mem_tracker();
     table_items.build_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
-    table_items.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
+    probe_state.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
     probe_state.probe_row_count = 10;
     probe_state.buckets.resize(config::vector_chunk_size);
     probe_state.next.resize(config::vector_chunk_size, 0);
@@ -1216,7 +1393,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFuncNullable) {
         }
     }
     table_items.build_pool.reset();
-    table_items.probe_pool.reset();
+    probe_state.probe_pool.reset();
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
@@ -1619,6 +1796,150 @@ TEST_F(JoinHashMapTest, OneKeyJoinHashTable) {
     hash_table.close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, LateBuildColumnsJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.late_build_slots = {4, 5};
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+    ASSERT_TRUE(hash_table.has_late_build_columns());
+
+    auto build_chunk = create_int32_build_chunk(10, false);
+    auto probe_chunk = create_int32_probe_chunk(5, 1, false);
+    Columns probe_key_columns;
+    probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+
+    ASSERT_TRUE(hash_table.probe(probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+
+    // The late build columns aren't output by the probe.
+    ASSERT_EQ(result_chunk->num_columns(), 4);
+    check_int32_column(result_chunk->get_column_by_slot_id(3), 5, 1);
+
+    auto build_index = UInt32Column::create();
+    hash_table.append_output_build_index(build_index.get());
+    ASSERT_EQ(build_index->size(), 5);
+
+    // Keep the rows 1 and 3, as if the others were filtered by the conjuncts.
+    Column::Filter filter{0, 1, 0, 1, 0};
+    result_chunk->filter(filter);
+    build_index->filter(filter);
+    hash_table.materialize_late_build_columns(build_index->get_data(), &result_chunk);
+
+    ASSERT_EQ(result_chunk->num_columns(), 6);
+    ColumnPtr column4 = result_chunk->get_column_by_slot_id(4);
+    ASSERT_EQ(column4->size(), 2);
+    ASSERT_EQ(column4->get(0).get_int32(), 12);
+    ASSERT_EQ(column4->get(1).get_int32(), 14);
+    ColumnPtr column5 = result_chunk->get_column_by_slot_id(5);
+    ASSERT_EQ(column5->size(), 2);
+    ASSERT_EQ(column5->get(0).get_int32(), 22);
+    ASSERT_EQ(column5->get(1).get_int32(), 24);
+
+    hash_table.close();
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, ShareReadableJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    auto build_chunk = create_int32_build_chunk(10, false);
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+
+    // Two probers share the built table, each one probes with its own probe state.
+    JoinHashTable prober1;
+    JoinHashTable prober2;
+    prober1.share_readable_table(hash_table);
+    prober2.share_readable_table(hash_table);
+
+    auto probe_chunk1 = create_int32_probe_chunk(5, 1, false);
+    auto probe_chunk2 = create_int32_probe_chunk(3, 6, false);
+    Columns probe_key_columns1{probe_chunk1->columns()[0]};
+    Columns probe_key_columns2{probe_chunk2->columns()[0]};
+
+    ChunkPtr result_chunk1 = std::make_shared<Chunk>();
+    ChunkPtr result_chunk2 = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_TRUE(prober1.probe(probe_key_columns1, &probe_chunk1, &result_chunk1, &eos).ok());
+    ASSERT_TRUE(prober2.probe(probe_key_columns2, &probe_chunk2, &result_chunk2, &eos).ok());
+
+    ASSERT_EQ(result_chunk1->num_columns(), 6);
+    ASSERT_EQ(result_chunk2->num_columns(), 6);
+    check_int32_column(result_chunk1->get_column_by_slot_id(0), 5, 1);
+    check_int32_column(result_chunk1->get_column_by_slot_id(3), 5, 1);
+    check_int32_column(result_chunk2->get_column_by_slot_id(0), 3, 6);
+    check_int32_column(result_chunk2->get_column_by_slot_id(3), 3, 6);
+
+    // Closing the probers must not release the table of the owner.
+    prober1.close();
+    prober2.close();
+    ASSERT_EQ(hash_table.get_row_count(), 10);
+
+    hash_table.close();
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, OneNullableKeyJoinHashTable) {
     auto runtime_profile = create_runtime_profile();
@@ -150,6 +150,47 @@ TEST_F(JsonScannerTest, test_json_with_path) {
     EXPECT_EQ("['v2', 'server', '10.20.1.1', 20]", chunk->debug_row(1));
 }
 
+TEST_F(JsonScannerTest, test_json_with_unordered_members) {
+    std::vector<TypeDescriptor> types;
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+
+    // the members are found at the positions of the last row first
+    for (bool with_path : {false, true}) {
+        std::vector<TBrokerRangeDesc> ranges;
+        TBrokerRangeDesc range;
+        range.format_type = TFileFormatType::FORMAT_JSON;
+        range.strip_outer_array = true;
+        range.__isset.strip_outer_array = true;
+        range.__isset.jsonpaths = with_path;
+        range.jsonpaths = "[\"$.k1\", \"$.kind\", \"$.keyname.ip\", \"$.keyname.value\"]";
+        range.__isset.json_root = false;
+        range.__set_path("./be/test/exec/test_data/json_scanner/test_unordered.json");
+        ranges.emplace_back(range);
+
+        auto scanner = create_json_scanner(types, ranges, {"k1", "kind", "ip", "value"});
+        ASSERT_TRUE(scanner->open().ok());
+
+        ChunkPtr chunk = scanner->get_next().value();
+        EXPECT_EQ(4, chunk->num_columns());
+        EXPECT_EQ(4, chunk->num_rows());
+        if (with_path) {
+            EXPECT_EQ("['v1', 'server', '10.10.0.1', '20']", chunk->debug_row(0));
+            EXPECT_EQ("['v2', 'client', '10.20.1.1', '30']", chunk->debug_row(1));
+            EXPECT_EQ("['v3', NULL, '10.30.2.1', NULL]", chunk->debug_row(2));
+            // the members of the objects in an array are collected into an array
+            EXPECT_EQ("['v4', 'server', '[\"10.40.3.1\"]', '[40]']", chunk->debug_row(3));
+        } else {
+            EXPECT_EQ("['v1', 'server', NULL, NULL]", chunk->debug_row(0));
+            EXPECT_EQ("['v2', 'client', NULL, NULL]", chunk->debug_row(1));
+            EXPECT_EQ("['v3', NULL, NULL, NULL]", chunk->debug_row(2));
+            EXPECT_EQ("['v4', 'server', NULL, NULL]", chunk->debug_row(3));
+        }
+    }
+}
+
 TEST_F(JsonScannerTest, test_one_level_array) {
     std::vector<TypeDescriptor> types;
     TypeDescriptor t1(TYPE_ARRAY);
@@ -0,0 +1,105 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/parquet_chunk_writer.h"
+
+#include <arrow/io/memory.h>
+#include <arrow/table.h>
+#include <gtest/gtest.h>
+#include <parquet/arrow/reader.h>
+
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "runtime/date_value.h"
+#include "runtime/timestamp_value.h"
+
+namespace starrocks::vectorized {
+
+class ParquetChunkWriterTest : public testing::Test {
+public:
+    void SetUp() override {
+        _row_group_rows = config::parquet_writer_row_group_rows;
+        config::parquet_writer_row_group_rows = 3;
+    }
+
+    void TearDown() override { config::parquet_writer_row_group_rows = _row_group_rows; }
+
+protected:
+    // The rows [start, start + 4): (i, "v<i>" or null for the odd i, 2021-01-<i + 1>, 2021-01-01 00:00:<i>).
+    static Columns create_columns(int start) {
+        auto ints = Int32Column::create();
+        auto strings = BinaryColumn::create();
+        auto nulls = NullColumn::create();
+        auto dates = DateColumn::create();
+        auto datetimes = TimestampColumn::create();
+        for (int i = start; i < start + 4; i++) {
+            ints->append(i);
+            strings->append(Slice("v" + std::to_string(i)));
+            nulls->append(i % 2);
+            dates->append(DateValue::create(2021, 1, i + 1));
+            datetimes->append(TimestampValue::create(2021, 1, 1, 0, 0, i));
+        }
+        return {ints, NullableColumn::create(strings, nulls), dates, datetimes};
+    }
+
+    int64_t _row_group_rows = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(ParquetChunkWriterTest, test_write) {
+    std::shared_ptr<arrow::io::BufferOutputStream> output;
+    ASSERT_TRUE(arrow::io::BufferOutputStream::Create(1024, arrow::default_memory_pool(), &output).ok());
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_INT), TypeDescriptor::create_varchar_type(10),
+                                      TypeDescriptor(TYPE_DATE), TypeDescriptor(TYPE_DATETIME)};
+    ParquetChunkWriter writer(output, types);
+    ASSERT_TRUE(writer.init().ok());
+    ASSERT_FALSE(writer.write({Int32Column::create()}).ok());
+    // each chunk exceeds the rows of a row group
+    ASSERT_TRUE(writer.write(create_columns(0)).ok());
+    ASSERT_GT(writer.written_bytes(), 0);
+    ASSERT_TRUE(writer.write(create_columns(4)).ok());
+    ASSERT_TRUE(writer.close().ok());
+
+    std::shared_ptr<arrow::Buffer> buffer;
+    ASSERT_TRUE(output->Finish(&buffer).ok());
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    ASSERT_TRUE(parquet::arrow::OpenFile(std::make_shared<arrow::io::BufferReader>(buffer),
+                                         arrow::default_memory_pool(), &reader)
+                        .ok());
+    ASSERT_EQ(2, reader->num_row_groups());
+    std::shared_ptr<arrow::Table> table;
+    ASSERT_TRUE(reader->ReadTable(&table).ok());
+    ASSERT_EQ(8, table->num_rows());
+    ASSERT_EQ(4, table->num_columns());
+
+    int row = 0;
+    for (int c = 0; c < table->column(0)->num_chunks(); c++) {
+        auto ints = std::static_pointer_cast<arrow::Int32Array>(table->column(0)->chunk(c));
+        auto strings = std::static_pointer_cast<arrow::StringArray>(table->column(1)->chunk(c));
+        auto dates = std::static_pointer_cast<arrow::Date32Array>(table->column(2)->chunk(c));
+        auto datetimes = std::static_pointer_cast<arrow::TimestampArray>(table->column(3)->chunk(c));
+        for (int64_t i = 0; i < ints->length(); i++, row++) {
+            ASSERT_EQ(row, ints->Value(i));
+            if (row % 2) {
+                ASSERT_TRUE(strings->IsNull(i));
+            } else {
+                ASSERT_EQ("v" + std::to_string(row), strings->GetString(i));
+            }
+            // 2021-01-01 is the 18628th day since 1970-01-01
+            ASSERT_EQ(18628 + row, dates->Value(i));
+            ASSERT_EQ((18628LL * 86400 + row) * 1000000, datetimes->Value(i));
+        }
+    }
+    ASSERT_EQ(8, row);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ParquetChunkWriterTest, test_unsupported_type) {
+    std::shared_ptr<arrow::io::BufferOutputStream> output;
+    ASSERT_TRUE(arrow::io::BufferOutputStream::Create(1024, arrow::default_memory_pool(), &output).ok());
+    ParquetChunkWriter writer(output, {TypeDescriptor(TYPE_HLL)});
+    ASSERT_FALSE(writer.init().ok());
+}
+
+} // namespace starrocks::vectorized
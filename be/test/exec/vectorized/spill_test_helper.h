@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gen_cpp/InternalService_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "runtime/tmp_file_mgr.h"
+#include "storage/storage_engine.h"
+
+namespace starrocks::vectorized {
+
+// The ExecEnv whose TmpFileMgr holds the spilled files, it's initialized by the first spill test.
+inline ExecEnv* get_spill_exec_env() {
+    ExecEnv* exec_env = ExecEnv::GetInstance();
+    if (exec_env->tmp_file_mgr() == nullptr) {
+        auto* engine = StorageEngine::instance();
+        ExecEnv::init(exec_env, engine->engine_options()->store_paths);
+        exec_env->set_storage_engine(engine);
+    }
+    return exec_env;
+}
+
+// A RuntimeState of the query with spilling enabled, the slots of the spilled chunks must be in desc_tbl.
+inline std::shared_ptr<RuntimeState> create_spill_runtime_state(int64_t query_id_lo, DescriptorTbl* desc_tbl) {
+    TExecPlanFragmentParams fragment_params;
+    fragment_params.params.query_id.hi = 0x5b111;
+    fragment_params.params.query_id.lo = query_id_lo;
+    TQueryOptions query_options;
+    query_options.__set_enable_spilling(true);
+    auto state = std::make_shared<RuntimeState>(fragment_params, query_options, TQueryGlobals(), get_spill_exec_env());
+    state->init_instance_mem_tracker();
+    state->set_desc_tbl(desc_tbl);
+    return state;
+}
+
+// The number of the spilled files of the query which are not removed, see TmpFileMgr::get_file().
+inline size_t count_spill_files(const TUniqueId& query_id) {
+    TmpFileMgr* tmp_file_mgr = get_spill_exec_env()->tmp_file_mgr();
+    std::stringstream prefix;
+    prefix << std::hex << query_id.hi << '-' << query_id.lo << std::dec << "_";
+    size_t num_files = 0;
+    for (auto device_id : tmp_file_mgr->active_tmp_devices()) {
+        for (const auto& entry : std::filesystem::directory_iterator(tmp_file_mgr->get_tmp_dir_path(device_id))) {
+            if (entry.path().filename().string().rfind(prefix.str(), 0) == 0) {
+                num_files++;
+            }
+        }
+    }
+    return num_files;
+}
+
+} // namespace starrocks::vectorized
@@ -666,6 +666,49 @@ TEST_F(AggregateTest, test_sum_nullable) {
     ASSERT_EQ(4950, result_data.get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_sum_nullable_slide) {
+    const AggregateFunction* sum_null = get_aggregate_function("sum", TYPE_INT, TYPE_BIGINT, true);
+    ASSERT_TRUE(sum_null->is_removable());
+    std::unique_ptr<ManagedAggregateState> slid_state = ManagedAggregateState::Make(sum_null);
+
+    // The rows [40, 60) are null.
+    auto data_column = Int32Column::create();
+    auto null_column = NullColumn::create();
+    for (int i = 0; i < 100; i++) {
+        data_column->append(i);
+        null_column->append(i >= 40 && i < 60);
+    }
+    auto column = NullableColumn::create(std::move(data_column), std::move(null_column));
+    const Column* row_column = column.get();
+
+    // ROWS BETWEEN 1 PRECEDING AND 2 FOLLOWING
+    auto slid_result = NullableColumn::create(Int64Column::create(), NullColumn::create());
+    auto expected_result = NullableColumn::create(Int64Column::create(), NullColumn::create());
+    int64_t prev_frame_start = 0;
+    int64_t prev_frame_end = 0;
+    for (int64_t i = 0; i < 100; i++) {
+        int64_t frame_start = std::max<int64_t>(i - 1, 0);
+        int64_t frame_end = std::min<int64_t>(i + 3, 100);
+        sum_null->slide_batch_single_state(ctx, slid_state->mutable_data(), &row_column, prev_frame_start,
+                                           prev_frame_end, frame_start, frame_end);
+        sum_null->finalize_to_column(ctx, slid_state->data(), slid_result.get());
+        prev_frame_start = frame_start;
+        prev_frame_end = frame_end;
+
+        std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(sum_null);
+        sum_null->update_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 100, frame_start,
+                                            frame_end);
+        sum_null->finalize_to_column(ctx, state->data(), expected_result.get());
+    }
+
+    ASSERT_EQ(100, slid_result->size());
+    for (size_t i = 0; i < 100; i++) {
+        ASSERT_EQ(expected_result->debug_item(i), slid_result->debug_item(i));
+    }
+    ASSERT_TRUE(slid_result->is_null(45));
+    ASSERT_FALSE(slid_result->is_null(39));
+}
+
 TEST_F(AggregateTest, test_count_nullable) {
     const AggregateFunction* func = get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, true);
     std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
@@ -738,6 +781,48 @@ TEST_F(AggregateTest, test_group_concat) {
     ASSERT_EQ("starrocks0, starrocks1, starrocks2, starrocks3, starrocks4, starrocks5", result_column->get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_group_concat_state_in_mem_pool) {
+    const AggregateFunction* group_concat_function =
+            get_aggregate_function("group_concat", TYPE_VARCHAR, TYPE_VARCHAR, false);
+    ASSERT_TRUE(group_concat_function->is_state_trivially_destructible());
+    ASSERT_FALSE(get_aggregate_function("percentile_approx", TYPE_DOUBLE, TYPE_DOUBLE, false)
+                         ->is_state_trivially_destructible());
+
+    auto data_column = BinaryColumn::create();
+    for (int i = 0; i < 100; i++) {
+        data_column->append("starrocks" + std::to_string(i));
+    }
+    const Column* row_column = data_column.get();
+
+    // The buffer of the state grows many times.
+    std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(group_concat_function);
+    for (size_t i = 0; i < data_column->size(); i++) {
+        group_concat_function->update(ctx, &row_column, state->mutable_data(), i);
+    }
+
+    auto serialized_column = BinaryColumn::create();
+    group_concat_function->serialize_to_column(ctx, state->data(), serialized_column.get());
+    std::unique_ptr<ManagedAggregateState> merged_state = ManagedAggregateState::Make(group_concat_function);
+    group_concat_function->merge(ctx, serialized_column.get(), merged_state->mutable_data(), 0);
+    group_concat_function->merge(ctx, serialized_column.get(), merged_state->mutable_data(), 0);
+
+    std::string expected;
+    for (size_t i = 0; i < data_column->size(); i++) {
+        expected.append(i == 0 ? "" : ", ").append(data_column->get_slice(i).to_string());
+    }
+    auto result_column = BinaryColumn::create();
+    group_concat_function->finalize_to_column(ctx, state->data(), result_column.get());
+    group_concat_function->finalize_to_column(ctx, merged_state->data(), result_column.get());
+    ASSERT_EQ(expected, result_column->get_slice(0).to_string());
+    ASSERT_EQ(expected + ", " + expected, result_column->get_slice(1).to_string());
+
+    // The reset state reuses its buffer.
+    group_concat_function->reset(ctx, {}, state->mutable_data());
+    group_concat_function->update(ctx, &row_column, state->mutable_data(), 0);
+    group_concat_function->finalize_to_column(ctx, state->data(), result_column.get());
+    ASSERT_EQ("starrocks0", result_column->get_slice(2).to_string());
+}
+
 TEST_F(AggregateTest, test_intersect_count) {
     const AggregateFunction* group_concat_function =
             get_aggregate_function("intersect_count", TYPE_INT, TYPE_BIGINT, false);
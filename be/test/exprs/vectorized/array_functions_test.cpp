@@ -1652,4 +1652,110 @@ TEST_F(ArrayFunctionsTest, array_all_null) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_contains_const_target) {
+    // array_contains([1, 2, 3], 3)        : 1
+    // array_contains([], 3)               : 0
+    // array_contains([NULL, 3], 3)        : 1
+    // array_contains([NULL, 4, NULL], 3)  : 0
+    auto array = ColumnHelper::create_column(TYPE_ARRAY_INT, false);
+    array->append_datum(DatumArray{1, 2, 3});
+    array->append_datum(Datum(DatumArray{}));
+    array->append_datum(DatumArray{Datum(), 3});
+    array->append_datum(DatumArray{Datum(), 4, Datum()});
+
+    auto target = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false, true, 4);
+    target->append_datum(Datum{(int32_t)3});
+
+    auto result = ArrayFunctions::array_contains(nullptr, {array, target});
+    EXPECT_EQ(4, result->size());
+    EXPECT_EQ(1, result->get(0).get_int8());
+    EXPECT_EQ(0, result->get(1).get_int8());
+    EXPECT_EQ(1, result->get(2).get_int8());
+    EXPECT_EQ(0, result->get(3).get_int8());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_distinct) {
+    // array_distinct([3, 1, 3, NULL, 1, NULL]) -> [3, 1, NULL]
+    // array_distinct([])                       -> []
+    // array_distinct(NULL)                     -> NULL
+    // array_distinct([2, 2])                   -> [2]
+    {
+        auto array = ColumnHelper::create_column(TYPE_ARRAY_INT, true);
+        array->append_datum(DatumArray{3, 1, 3, Datum(), 1, Datum()});
+        array->append_datum(Datum(DatumArray{}));
+        array->append_datum(Datum());
+        array->append_datum(DatumArray{2, 2});
+
+        auto result = ArrayFunctions::array_distinct(nullptr, {array});
+        EXPECT_EQ(4, result->size());
+        EXPECT_EQ("[3, 1, NULL]", result->debug_item(0));
+        EXPECT_EQ("[]", result->debug_item(1));
+        EXPECT_TRUE(result->is_null(2));
+        EXPECT_EQ("[2]", result->debug_item(3));
+    }
+    // array_distinct(['b', 'a', 'b']) -> ['b', 'a']
+    {
+        auto array = ColumnHelper::create_column(TYPE_ARRAY_VARCHAR, false);
+        array->append_datum(DatumArray{"b", "a", "b"});
+
+        auto result = ArrayFunctions::array_distinct(nullptr, {array});
+        EXPECT_EQ(1, result->size());
+        EXPECT_EQ("['b', 'a']", result->debug_item(0));
+    }
+    // array_distinct([[1, 2], NULL, [1, 2], [3], NULL]) -> [[1, 2], NULL, [3]]
+    {
+        auto array = ColumnHelper::create_column(TYPE_ARRAY_ARRAY_INT, false);
+        array->append_datum(DatumArray{DatumArray{1, 2}, Datum(), DatumArray{1, 2}, DatumArray{3}, Datum()});
+
+        auto result = ArrayFunctions::array_distinct(nullptr, {array});
+        EXPECT_EQ(1, result->size());
+        EXPECT_EQ("[[1, 2], NULL, [3]]", result->debug_item(0));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_sort) {
+    // array_sort([3, NULL, 1, 2, NULL]) -> [NULL, NULL, 1, 2, 3]
+    // array_sort([])                    -> []
+    // array_sort(NULL)                  -> NULL
+    // array_sort([5, 4])                -> [4, 5]
+    {
+        auto array = ColumnHelper::create_column(TYPE_ARRAY_INT, true);
+        array->append_datum(DatumArray{3, Datum(), 1, 2, Datum()});
+        array->append_datum(Datum(DatumArray{}));
+        array->append_datum(Datum());
+        array->append_datum(DatumArray{5, 4});
+
+        auto result = ArrayFunctions::array_sort(nullptr, {array});
+        EXPECT_EQ(4, result->size());
+        EXPECT_EQ("[NULL, NULL, 1, 2, 3]", result->debug_item(0));
+        EXPECT_EQ("[]", result->debug_item(1));
+        EXPECT_TRUE(result->is_null(2));
+        EXPECT_EQ("[4, 5]", result->debug_item(3));
+    }
+    // array_sort(['b', 'c', 'a']) -> ['a', 'b', 'c']
+    // array_sort(['z'])           -> ['z']
+    {
+        auto array = ColumnHelper::create_column(TYPE_ARRAY_VARCHAR, false);
+        array->append_datum(DatumArray{"b", "c", "a"});
+        array->append_datum(DatumArray{"z"});
+
+        auto result = ArrayFunctions::array_sort(nullptr, {array});
+        EXPECT_EQ(2, result->size());
+        EXPECT_EQ("['a', 'b', 'c']", result->debug_item(0));
+        EXPECT_EQ("['z']", result->debug_item(1));
+    }
+    // array_sort([[3], NULL, [1, 2]]) -> [NULL, [1, 2], [3]]
+    {
+        auto array = ColumnHelper::create_column(TYPE_ARRAY_ARRAY_INT, false);
+        array->append_datum(DatumArray{DatumArray{3}, Datum(), DatumArray{1, 2}});
+
+        auto result = ArrayFunctions::array_sort(nullptr, {array});
+        EXPECT_EQ(1, result->size());
+        EXPECT_EQ("[NULL, [1, 2], [3]]", result->debug_item(0));
+    }
+}
+
 } // namespace starrocks::vectorized
@@ -5,9 +5,15 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include "column/binary_column.h"
 #include "column/column_helper.h"
+#include "column/column_viewer.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/object_pool.h"
+#include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
+#include "runtime/descriptors.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -24,8 +30,34 @@ public:
         expr_node.type = gen_type_desc(TPrimitiveType::BIGINT);
     }
 
+    Expr* slot_ref(SlotId slot_id, TPrimitiveType::type type) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = gen_type_desc(type);
+        node.num_children = 0;
+        TSlotRef ref;
+        ref.slot_id = slot_id;
+        ref.tuple_id = 0;
+        node.__set_slot_ref(ref);
+        return pool.add(new ColumnRef(node));
+    }
+
+    Expr* case_expr(TPrimitiveType::type type, bool has_else, const std::vector<Expr*>& children) {
+        TExprNode node = expr_node;
+        node.node_type = TExprNodeType::CASE_EXPR;
+        node.type = gen_type_desc(type);
+        node.case_expr.has_case_expr = false;
+        node.case_expr.has_else_expr = has_else;
+        Expr* expr = pool.add(VectorizedCaseExprFactory::from_thrift(node));
+        for (Expr* child : children) {
+            expr->_children.push_back(child);
+        }
+        return expr;
+    }
+
 public:
     TExprNode expr_node;
+    ObjectPool pool;
 };
 
 TEST_F(VectorizedCaseExprTest, whenSliceCase) {
@@ -428,5 +460,95 @@ TEST_F(VectorizedCaseExprTest, NoCaseWhenNullReturnIntElse) {
     }
 }
 
+TEST_F(VectorizedCaseExprTest, blendBranches) {
+    // CASE WHEN s1 THEN s2 WHEN s3 THEN s4 END
+    Expr* expr = case_expr(TPrimitiveType::INT, false,
+                           {slot_ref(1, TPrimitiveType::BOOLEAN), slot_ref(2, TPrimitiveType::INT),
+                            slot_ref(3, TPrimitiveType::BOOLEAN), slot_ref(4, TPrimitiveType::INT)});
+    RowDescriptor row_desc;
+    ASSERT_TRUE(expr->prepare(nullptr, row_desc, nullptr).ok());
+
+    const int num_rows = 50;
+    auto s1 = BooleanColumn::create();
+    auto s1_nulls = NullColumn::create();
+    auto s2 = Int32Column::create();
+    auto s2_nulls = NullColumn::create();
+    auto s3 = BooleanColumn::create();
+    auto s4 = Int32Column::create();
+    for (int i = 0; i < num_rows; i++) {
+        s1->append(i % 3 == 0);
+        s1_nulls->append(i % 5 == 0);
+        s2->append(i);
+        s2_nulls->append(i % 7 == 0);
+        s3->append(i % 2 == 0);
+        s4->append(-i);
+    }
+    Chunk chunk;
+    chunk.append_column(NullableColumn::create(s1, s1_nulls), 1);
+    chunk.append_column(NullableColumn::create(s2, s2_nulls), 2);
+    chunk.append_column(s3, 3);
+    chunk.append_column(s4, 4);
+
+    ColumnPtr result = expr->evaluate(nullptr, &chunk);
+    ASSERT_EQ(num_rows, result->size());
+    ColumnViewer<TYPE_INT> viewer(result);
+    for (int i = 0; i < num_rows; i++) {
+        if (i % 3 == 0 && i % 5 != 0) {
+            ASSERT_EQ(i % 7 == 0, viewer.is_null(i)) << i;
+            if (i % 7 != 0) {
+                ASSERT_EQ(i, viewer.value(i));
+            }
+        } else if (i % 2 == 0) {
+            ASSERT_FALSE(viewer.is_null(i)) << i;
+            ASSERT_EQ(-i, viewer.value(i));
+        } else {
+            ASSERT_TRUE(viewer.is_null(i)) << i;
+        }
+    }
+}
+
+TEST_F(VectorizedCaseExprTest, selectiveBranches) {
+    // CASE WHEN s1 THEN (CASE WHEN s2 THEN s3 END) ELSE s4 END
+    Expr* then_expr =
+            case_expr(TPrimitiveType::VARCHAR, false,
+                      {slot_ref(2, TPrimitiveType::BOOLEAN), slot_ref(3, TPrimitiveType::VARCHAR)});
+    Expr* expr = case_expr(TPrimitiveType::VARCHAR, true,
+                           {slot_ref(1, TPrimitiveType::BOOLEAN), then_expr, slot_ref(4, TPrimitiveType::VARCHAR)});
+    RowDescriptor row_desc;
+    ASSERT_TRUE(expr->prepare(nullptr, row_desc, nullptr).ok());
+
+    const int num_rows = 100;
+    auto s1 = BooleanColumn::create();
+    auto s2 = BooleanColumn::create();
+    auto s3 = BinaryColumn::create();
+    auto s4 = BinaryColumn::create();
+    for (int i = 0; i < num_rows; i++) {
+        s1->append(i % 5 == 0);
+        s2->append(i % 2 == 0);
+        s3->append(Slice("then" + std::to_string(i)));
+        s4->append(Slice("else" + std::to_string(i)));
+    }
+    Chunk chunk;
+    chunk.append_column(s1, 1);
+    chunk.append_column(s2, 2);
+    chunk.append_column(s3, 3);
+    chunk.append_column(s4, 4);
+
+    ColumnPtr result = expr->evaluate(nullptr, &chunk);
+    ASSERT_EQ(num_rows, result->size());
+    ColumnViewer<TYPE_VARCHAR> viewer(result);
+    for (int i = 0; i < num_rows; i++) {
+        if (i % 5 != 0) {
+            ASSERT_FALSE(viewer.is_null(i)) << i;
+            ASSERT_EQ("else" + std::to_string(i), viewer.value(i).to_string());
+        } else if (i % 2 == 0) {
+            ASSERT_FALSE(viewer.is_null(i)) << i;
+            ASSERT_EQ("then" + std::to_string(i), viewer.value(i).to_string());
+        } else {
+            ASSERT_TRUE(viewer.is_null(i)) << i;
+        }
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -901,6 +901,30 @@ TEST_F(VectorizedCastExprTest, stringCastTimestmap) {
     }
 }
 
+
+TEST_F(VectorizedCastExprTest, stringCastTimestmapInvalidStandardLayout) {
+    expr_node.child_type = TPrimitiveType::VARCHAR;
+    expr_node.type = gen_type_desc(TPrimitiveType::DATETIME);
+
+    std::unique_ptr<Expr> expr(VectorizedCastExprFactory::from_thrift(expr_node));
+
+    // In the layout of "%Y-%m-%d %H:%i:%s" but not a valid date.
+    std::string p("2022-02-29 11:23:45");
+
+    MockVectorizedExpr<TYPE_VARCHAR> col1(expr_node, 10, Slice(p));
+
+    expr->_children.push_back(&col1);
+
+    {
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+
+        ASSERT_TRUE(ptr->is_nullable());
+        ASSERT_EQ(10, ptr->size());
+        for (int j = 0; j < ptr->size(); ++j) {
+            ASSERT_TRUE(ptr->is_null(j));
+        }
+    }
+}
 TEST_F(VectorizedCastExprTest, stringCastTimestmap2) {
     expr_node.child_type = TPrimitiveType::VARCHAR;
     expr_node.type = gen_type_desc(TPrimitiveType::DATETIME);
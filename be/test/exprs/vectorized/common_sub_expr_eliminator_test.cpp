@@ -0,0 +1,130 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/common_sub_expr_eliminator.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/primitive_type.h"
+
+namespace starrocks::vectorized {
+
+class CommonSubExprEliminatorTest : public ::testing::Test {
+protected:
+    static TExprNode slot_ref(SlotId slot_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        node.num_children = 0;
+        node.output_scale = -1;
+        TSlotRef ref;
+        ref.slot_id = slot_id;
+        ref.tuple_id = 0;
+        node.__set_slot_ref(ref);
+        return node;
+    }
+
+    static TExprNode int_literal(int64_t value) {
+        TExprNode node;
+        node.node_type = TExprNodeType::INT_LITERAL;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        node.num_children = 0;
+        node.output_scale = -1;
+        TIntLiteral literal;
+        literal.value = value;
+        node.__set_int_literal(literal);
+        return node;
+    }
+
+    static TExprNode function_call(const std::string& name, int num_children) {
+        TExprNode node;
+        node.node_type = TExprNodeType::FUNCTION_CALL;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        node.num_children = num_children;
+        node.output_scale = -1;
+        TFunctionName function_name;
+        function_name.__set_function_name(name);
+        TFunction fn;
+        fn.__set_name(function_name);
+        node.__set_fn(fn);
+        return node;
+    }
+
+    static TExpr make_expr(std::vector<TExprNode> nodes) {
+        TExpr expr;
+        expr.nodes = std::move(nodes);
+        return expr;
+    }
+
+    // f(g(slot 1), 2)
+    static std::vector<TExprNode> nested(const std::string& f) {
+        return {function_call(f, 2), function_call("g", 1), slot_ref(1), int_literal(2)};
+    }
+};
+
+TEST_F(CommonSubExprEliminatorTest, extract_largest_first) {
+    std::map<SlotId, TExpr> slot_map;
+    // h(f(g(slot 1), 2)), f(g(slot 1), 2), k(g(slot 1))
+    std::vector<TExprNode> first = {function_call("h", 1)};
+    for (const auto& node : nested("f")) {
+        first.emplace_back(node);
+    }
+    slot_map.emplace(10, make_expr(first));
+    slot_map.emplace(11, make_expr(nested("f")));
+    slot_map.emplace(12, make_expr({function_call("k", 1), function_call("g", 1), slot_ref(1)}));
+
+    CommonSubExprEliminator::CommonSubExprs common_sub_exprs;
+    ASSERT_TRUE(CommonSubExprEliminator::eliminate(&slot_map, &common_sub_exprs).ok());
+
+    // g(slot 1) is evaluated into slot -2 first, then f(slot -2, 2) into slot -1.
+    ASSERT_EQ(2, common_sub_exprs.size());
+    ASSERT_EQ(-2, common_sub_exprs[0].first);
+    const auto& g = common_sub_exprs[0].second.nodes;
+    ASSERT_EQ(2, g.size());
+    ASSERT_EQ("g", g[0].fn.name.function_name);
+    ASSERT_EQ(1, g[1].slot_ref.slot_id);
+
+    ASSERT_EQ(-1, common_sub_exprs[1].first);
+    const auto& f = common_sub_exprs[1].second.nodes;
+    ASSERT_EQ(3, f.size());
+    ASSERT_EQ("f", f[0].fn.name.function_name);
+    ASSERT_EQ(-2, f[1].slot_ref.slot_id);
+
+    ASSERT_EQ(2, slot_map[10].nodes.size());
+    ASSERT_EQ(-1, slot_map[10].nodes[1].slot_ref.slot_id);
+    ASSERT_EQ(1, slot_map[11].nodes.size());
+    ASSERT_EQ(-1, slot_map[11].nodes[0].slot_ref.slot_id);
+    ASSERT_EQ(2, slot_map[12].nodes.size());
+    ASSERT_EQ(-2, slot_map[12].nodes[1].slot_ref.slot_id);
+}
+
+TEST_F(CommonSubExprEliminatorTest, keep_unique_constant_and_random) {
+    std::map<SlotId, TExpr> slot_map;
+    slot_map.emplace(10, make_expr(nested("f")));
+    slot_map.emplace(11, make_expr(nested("h")));
+    // The constant sub exprs are kept.
+    slot_map.emplace(12, make_expr({function_call("abs", 1), int_literal(2)}));
+    slot_map.emplace(13, make_expr({function_call("abs", 1), int_literal(2)}));
+    // The non-deterministic sub exprs are kept.
+    slot_map.emplace(14, make_expr({function_call("rand", 1), slot_ref(1)}));
+    slot_map.emplace(15, make_expr({function_call("rand", 1), slot_ref(1)}));
+
+    // The common sub exprs of the planner are considered too.
+    CommonSubExprEliminator::CommonSubExprs common_sub_exprs;
+    common_sub_exprs.emplace_back(20, make_expr({function_call("k", 1), function_call("g", 1), slot_ref(1)}));
+    ASSERT_TRUE(CommonSubExprEliminator::eliminate(&slot_map, &common_sub_exprs).ok());
+
+    ASSERT_EQ(2, common_sub_exprs.size());
+    ASSERT_EQ(-1, common_sub_exprs[0].first);
+    ASSERT_EQ("g", common_sub_exprs[0].second.nodes[0].fn.name.function_name);
+    ASSERT_EQ(20, common_sub_exprs[1].first);
+    ASSERT_EQ(-1, common_sub_exprs[1].second.nodes[1].slot_ref.slot_id);
+
+    ASSERT_EQ(3, slot_map[10].nodes.size());
+    ASSERT_EQ(3, slot_map[11].nodes.size());
+    ASSERT_EQ(2, slot_map[12].nodes.size());
+    ASSERT_EQ(2, slot_map[14].nodes.size());
+    ASSERT_EQ(TExprNodeType::SLOT_REF, slot_map[14].nodes[1].node_type);
+    ASSERT_EQ(1, slot_map[14].nodes[1].slot_ref.slot_id);
+}
+
+} // namespace starrocks::vectorized
@@ -5,7 +5,14 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <optional>
+
+#include "column/chunk.h"
+#include "column/column_viewer.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/object_pool.h"
+#include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
 
 namespace starrocks {
@@ -387,5 +394,82 @@ TEST_F(VectorizedCompoundPredicateTest, testOnlyNullAndZeroRow) {
     }
 }
 
+TEST_F(VectorizedCompoundPredicateTest, selectiveAndExpr) {
+    ObjectPool pool;
+    auto slot_ref = [&](SlotId slot_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = gen_type_desc(TPrimitiveType::BOOLEAN);
+        node.num_children = 0;
+        TSlotRef ref;
+        ref.slot_id = slot_id;
+        ref.tuple_id = 0;
+        node.__set_slot_ref(ref);
+        return pool.add(new ColumnRef(node));
+    };
+    auto compound = [&](TExprOpcode::type opcode, std::vector<Expr*> children) {
+        TExprNode node = expr_node;
+        node.opcode = opcode;
+        node.node_type = TExprNodeType::COMPOUND_PRED;
+        Expr* expr = pool.add(VectorizedCompoundPredicateFactory::from_thrift(node));
+        for (Expr* child : children) {
+            expr->_children.push_back(child);
+        }
+        return expr;
+    };
+
+    // (s1 AND NOT s2) AND NOT s3, s1 and s3 are nullable.
+    Expr* expr = compound(TExprOpcode::COMPOUND_AND,
+                          {compound(TExprOpcode::COMPOUND_AND,
+                                    {slot_ref(1), compound(TExprOpcode::COMPOUND_NOT, {slot_ref(2)})}),
+                           compound(TExprOpcode::COMPOUND_NOT, {slot_ref(3)})});
+    ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FRAGMENT_LOCAL).ok());
+
+    const int num_rows = 100;
+    std::vector<std::optional<bool>> s1, s2, s3;
+    auto c1 = BooleanColumn::create();
+    auto n1 = NullColumn::create();
+    auto c2 = BooleanColumn::create();
+    auto c3 = BooleanColumn::create();
+    auto n3 = NullColumn::create();
+    for (int i = 0; i < num_rows; i++) {
+        s1.emplace_back(i % 10 == 5 ? std::nullopt : std::optional<bool>(i % 10 == 0));
+        s2.emplace_back(i % 3 == 0);
+        s3.emplace_back(i % 7 == 0 ? std::nullopt : std::optional<bool>(i % 2 == 0));
+        c1->append(s1.back().value_or(false));
+        n1->append(!s1.back().has_value());
+        c2->append(*s2.back());
+        c3->append(s3.back().value_or(false));
+        n3->append(!s3.back().has_value());
+    }
+    Chunk chunk;
+    chunk.append_column(NullableColumn::create(c1, n1), 1);
+    chunk.append_column(c2, 2);
+    chunk.append_column(NullableColumn::create(c3, n3), 3);
+
+    // The operands are reordered by their stats after the first chunk.
+    for (int round = 0; round < 3; round++) {
+        ColumnPtr result = expr->evaluate(nullptr, &chunk);
+        ASSERT_EQ(num_rows, result->size());
+        for (int i = 0; i < num_rows; i++) {
+            std::optional<bool> expected = true;
+            for (const auto& v : {s1[i], std::optional<bool>(!*s2[i]),
+                                  s3[i].has_value() ? std::optional<bool>(!*s3[i]) : std::nullopt}) {
+                if (v.has_value() && !*v) {
+                    expected = false;
+                    break;
+                }
+                if (!v.has_value()) {
+                    expected = std::nullopt;
+                }
+            }
+            ASSERT_EQ(!expected.has_value(), result->is_null(i)) << i;
+            if (expected.has_value()) {
+                ASSERT_EQ(*expected, ColumnViewer<TYPE_BOOLEAN>(result).value(i) != 0) << i;
+            }
+        }
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
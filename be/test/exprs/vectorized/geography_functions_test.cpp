@@ -408,5 +408,53 @@ TEST_F(geographyFunctionsTest, st_containsConstTest) {
     GeoFunctions::st_contains_close(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
 }
 
+TEST_F(geographyFunctionsTest, st_containsRepeatedTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    Columns columns;
+
+    // The rows of a polygon are followed by the rows of the other one, as a cross join outputs.
+    auto polygon_column = BinaryColumn::create();
+    for (int i = 0; i < 3; ++i) {
+        polygon_column->append("POLYGON ((10 10, 50 10, 50 50, 10 50, 10 10))");
+    }
+    for (int i = 0; i < 3; ++i) {
+        polygon_column->append("POLYGON ((0 0, 20 0, 20 20, 0 20, 0 0))");
+    }
+    columns.emplace_back(polygon_column);
+    ctx->impl()->set_constant_columns(columns);
+    GeoFunctions::st_from_wkt_prepare(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+    auto result1 = GeoFunctions::st_from_wkt(ctx.get(), columns);
+    GeoFunctions::st_from_wkt_close(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+
+    columns.clear();
+    auto point_column = BinaryColumn::create();
+    for (int i = 0; i < 2; ++i) {
+        point_column->append("POINT (25 25)");
+        point_column->append("POINT (5 5)");
+        point_column->append("POINT (15 15)");
+    }
+    columns.emplace_back(point_column);
+    ctx->impl()->set_constant_columns(columns);
+    GeoFunctions::st_from_wkt_prepare(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+    auto result2 = GeoFunctions::st_from_wkt(ctx.get(), columns);
+    GeoFunctions::st_from_wkt_close(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+
+    columns.clear();
+    columns.emplace_back(result1);
+    columns.emplace_back(result2);
+    ctx->impl()->set_constant_columns(columns);
+    GeoFunctions::st_contains_prepare(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+
+    auto res = GeoFunctions::st_contains(ctx.get(), columns);
+    auto bools = ColumnHelper::cast_to<TYPE_BOOLEAN>(res);
+    std::vector<uint8_t> expected{1, 0, 1, 0, 1, 1};
+    ASSERT_EQ(expected.size(), res->size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_FALSE(res->is_null(i));
+        ASSERT_EQ(expected[i], bools->get_data()[i]) << i;
+    }
+    GeoFunctions::st_contains_close(ctx.get(), FunctionContext::FRAGMENT_LOCAL);
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -233,5 +233,108 @@ TEST_F(VectorizedInPredicateTest, sliceNotInNull) {
     }
 }
 
+TEST_F(VectorizedInPredicateTest, intInDenseBitmap) {
+    expr_node.child_type = TPrimitiveType::INT;
+    expr_node.opcode = TExprOpcode::FILTER_IN;
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    expr_node.in_predicate.is_not_in = false;
+
+    auto expr = std::unique_ptr<Expr>(VectorizedInPredicateFactory::from_thrift(expr_node));
+
+    // The values less than min and larger than max are both out of the bitmap.
+    MockMultiVectorizedExpr<TYPE_INT> col1(expr_node, 10, 300, -1300);
+    expr->_children.push_back(&col1);
+    std::vector<std::unique_ptr<MockConstVectorizedExpr<TYPE_INT>>> values;
+    for (int i = 0; i < 20; ++i) {
+        values.emplace_back(std::make_unique<MockConstVectorizedExpr<TYPE_INT>>(expr_node, i * 100 - 1000));
+        expr->_children.push_back(values.back().get());
+    }
+
+    {
+        starrocks::RowDescriptor rd;
+        ASSERT_TRUE(expr->prepare(nullptr, rd, nullptr).ok());
+        ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+        ASSERT_TRUE(ptr->is_numeric());
+
+        auto v = ColumnHelper::cast_to_raw<TYPE_BOOLEAN>(ptr);
+        for (int j = 0; j < ptr->size(); ++j) {
+            ASSERT_EQ(j % 2 == 0, v->get_data()[j]);
+        }
+    }
+}
+
+TEST_F(VectorizedInPredicateTest, bigintNotInFixedArray) {
+    expr_node.child_type = TPrimitiveType::BIGINT;
+    expr_node.opcode = TExprOpcode::FILTER_IN;
+    expr_node.type = gen_type_desc(TPrimitiveType::BIGINT);
+    expr_node.in_predicate.is_not_in = true;
+
+    auto expr = std::unique_ptr<Expr>(VectorizedInPredicateFactory::from_thrift(expr_node));
+
+    // The values are too sparse for a bitmap.
+    MockMultiVectorizedExpr<TYPE_BIGINT> col1(expr_node, 10, 5000000, 7);
+    expr->_children.push_back(&col1);
+    std::vector<std::unique_ptr<MockConstVectorizedExpr<TYPE_BIGINT>>> values;
+    for (int i = 0; i < 6; ++i) {
+        values.emplace_back(std::make_unique<MockConstVectorizedExpr<TYPE_BIGINT>>(expr_node, i * 1000000));
+        expr->_children.push_back(values.back().get());
+    }
+
+    {
+        starrocks::RowDescriptor rd;
+        ASSERT_TRUE(expr->prepare(nullptr, rd, nullptr).ok());
+        ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+        ASSERT_TRUE(ptr->is_numeric());
+
+        auto v = ColumnHelper::cast_to_raw<TYPE_BOOLEAN>(ptr);
+        for (int j = 0; j < ptr->size(); ++j) {
+            ASSERT_EQ(j % 2 == 1, v->get_data()[j]);
+        }
+    }
+}
+
+TEST_F(VectorizedInPredicateTest, nullSliceInPerfectHash) {
+    expr_node.child_type = TPrimitiveType::VARCHAR;
+    expr_node.opcode = TExprOpcode::FILTER_IN;
+    expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+    expr_node.in_predicate.is_not_in = false;
+
+    auto expr = std::unique_ptr<Expr>(VectorizedInPredicateFactory::from_thrift(expr_node));
+
+    std::string v1("test37");
+    MockNullVectorizedExpr<TYPE_VARCHAR> col1(expr_node, 10, Slice(v1));
+    expr->_children.push_back(&col1);
+    std::vector<std::string> strings;
+    for (int i = 0; i < 100; ++i) {
+        strings.emplace_back("test" + std::to_string(i));
+    }
+    std::vector<std::unique_ptr<MockConstVectorizedExpr<TYPE_VARCHAR>>> values;
+    for (const auto& str : strings) {
+        values.emplace_back(std::make_unique<MockConstVectorizedExpr<TYPE_VARCHAR>>(expr_node, Slice(str)));
+        expr->_children.push_back(values.back().get());
+    }
+
+    {
+        starrocks::RowDescriptor rd;
+        ASSERT_TRUE(expr->prepare(nullptr, rd, nullptr).ok());
+        ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+        ASSERT_TRUE(ptr->is_nullable());
+
+        auto v = ColumnHelper::cast_to_raw<TYPE_BOOLEAN>(
+                ColumnHelper::as_raw_column<NullableColumn>(ptr)->data_column());
+        for (int j = 0; j < ptr->size(); ++j) {
+            if (j % 2 == 0) {
+                ASSERT_FALSE(ptr->is_null(j));
+                ASSERT_TRUE(v->get_data()[j]);
+            } else {
+                ASSERT_TRUE(ptr->is_null(j));
+            }
+        }
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
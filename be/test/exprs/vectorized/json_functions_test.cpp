@@ -236,5 +236,88 @@ TEST_F(JsonFunctionsTest, get_json_emptyTest) {
     }
 }
 
+TEST_F(JsonFunctionsTest, get_json_string_const_path) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    Columns columns;
+    auto strings = BinaryColumn::create();
+
+    // The DOM of the last row doesn't fit in the reused parse buffer.
+    std::string large_value(JsonFunctions::kJsonParseBufferSize, 'x');
+    std::string values[] = {"{\"k1\":\"v1\", \"k2\":2}", "{\"k1\":{\"k3\":[1, 2]}}", "{\"k2\":\"v2\"}", "invalid",
+                            "{\"k1\":\"" + large_value + "\"}"};
+    for (const auto& value : values) {
+        strings->append(value);
+    }
+    columns.emplace_back(strings);
+    columns.emplace_back(ColumnHelper::create_const_column<TYPE_VARCHAR>("$.k1", strings->size()));
+
+    ctx.get()->impl()->set_constant_columns(columns);
+    ASSERT_TRUE(JsonFunctions::json_path_prepare(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+    ASSERT_NE(nullptr, ctx->get_function_state(FunctionContext::FunctionStateScope::FRAGMENT_LOCAL));
+
+    ColumnPtr result = JsonFunctions::get_json_string(ctx.get(), columns);
+    ASSERT_EQ(5, result->size());
+    ASSERT_EQ("v1", result->get(0).get_slice().to_string());
+    ASSERT_EQ("{\"k3\":[1,2]}", result->get(1).get_slice().to_string());
+    ASSERT_TRUE(result->is_null(2));
+    ASSERT_TRUE(result->is_null(3));
+    ASSERT_EQ(large_value, result->get(4).get_slice().to_string());
+
+    ASSERT_TRUE(JsonFunctions::json_path_close(ctx.get(),
+                                               FunctionContext::FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                        .ok());
+}
+
+TEST_F(JsonFunctionsTest, get_json_binaryTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    auto strings = BinaryColumn::create();
+    std::string values[] = {"{\"k1\":\"v1\", \"k2\":{\"k3\":[1, 2.5]}}", "[{\"k1\":\"v2\"}, {\"k1\":\"v3\"}]",
+                            "invalid"};
+    for (const auto& value : values) {
+        strings->append(value);
+    }
+    ColumnPtr binaries = JsonFunctions::json_binary(ctx.get(), {strings});
+    ASSERT_EQ(3, binaries->size());
+    ASSERT_TRUE(binaries->is_null(2));
+    // Converting the binary form again doesn't change it.
+    ColumnPtr binaries2 = JsonFunctions::json_binary(ctx.get(), {binaries});
+    ASSERT_EQ(binaries->get(0).get_slice(), binaries2->get(0).get_slice());
+
+    std::string paths[] = {"$.k1", "$.k2.k3[1]", "$.k2", "$.k2.k3[*]", "$.k4", "$"};
+    // The expected values of the first two rows, empty for null.
+    std::string expected[][2] = {{"v1", "[\"v2\",\"v3\"]"},
+                                 {"2.5", ""},
+                                 {"{\"k3\":[1,2.5]}", ""},
+                                 {"[1,2.5]", ""},
+                                 {"", ""},
+                                 {"{\"k1\":\"v1\",\"k2\":{\"k3\":[1,2.5]}}", "[{\"k1\":\"v2\"},{\"k1\":\"v3\"}]"}};
+    for (int i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        Columns columns{binaries, ColumnHelper::create_const_column<TYPE_VARCHAR>(paths[i], binaries->size())};
+        ctx.get()->impl()->set_constant_columns(columns);
+        ASSERT_TRUE(
+                JsonFunctions::json_path_prepare(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+        ColumnPtr result = JsonFunctions::get_json_string(ctx.get(), columns);
+        for (int row = 0; row < 2; row++) {
+            if (expected[i][row].empty()) {
+                ASSERT_TRUE(result->is_null(row)) << paths[i];
+            } else {
+                ASSERT_EQ(expected[i][row], result->get(row).get_slice().to_string()) << paths[i];
+            }
+        }
+        ASSERT_TRUE(result->is_null(2));
+        ASSERT_TRUE(
+                JsonFunctions::json_path_close(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+    }
+
+    Columns columns{binaries, ColumnHelper::create_const_column<TYPE_VARCHAR>("$.k2.k3[1]", binaries->size())};
+    ctx.get()->impl()->set_constant_columns(columns);
+    ASSERT_TRUE(JsonFunctions::json_path_prepare(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+    ColumnPtr doubles = JsonFunctions::get_json_double(ctx.get(), columns);
+    ASSERT_EQ(2.5, doubles->get(0).get_double());
+    ColumnPtr ints = JsonFunctions::get_json_int(ctx.get(), columns);
+    ASSERT_TRUE(ints->is_null(0));
+    ASSERT_TRUE(JsonFunctions::json_path_close(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -6,6 +6,7 @@
 #include "butil/time.h"
 #include "exprs/vectorized/like_predicate.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
+#include "runtime/vectorized/Volnitsky.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -404,5 +405,58 @@ TEST_F(LikeTest, rowsPatternRegex) {
                         .ok());
 }
 
+TEST_F(LikeTest, substringPattern) {
+    std::string search_string;
+    ASSERT_TRUE(LikePredicate::is_substring_pattern("%abc\\%%", true, &search_string));
+    ASSERT_EQ("abc%", search_string);
+    ASSERT_FALSE(LikePredicate::is_substring_pattern("abc%", true, &search_string));
+    ASSERT_FALSE(LikePredicate::is_substring_pattern("%a_c%", true, &search_string));
+
+    search_string.clear();
+    ASSERT_TRUE(LikePredicate::is_substring_pattern(".*abc", false, &search_string));
+    ASSERT_EQ("abc", search_string);
+    ASSERT_FALSE(LikePredicate::is_substring_pattern("^abc", false, &search_string));
+}
+
+TEST_F(LikeTest, multiSubstringMatch) {
+    // The short, hashed and long needles.
+    std::vector<std::string> needles = {"ab", "error", "timeout", std::string(300, 'x')};
+    MultiVolnitsky searcher(needles);
+
+    auto str = BinaryColumn::create();
+    auto null = NullColumn::create();
+    std::vector<std::string> values = {"no match",
+                                       "xxabyy",
+                                       "an error occurred",
+                                       "read timeout",
+                                       "time out",
+                                       "erro",
+                                       std::string(300, 'x') + "!",
+                                       std::string(299, 'x'),
+                                       "ERROR",
+                                       "",
+                                       "prefix...timeou",
+                                       "crab"};
+    for (size_t i = 0; i < values.size(); ++i) {
+        str->append(values[i]);
+        null->append(i == 0);
+    }
+    std::vector<bool> expected = {false, true, true, true, false, false, true, false, false, false, false, true};
+
+    auto result = LikePredicate::multi_substring_match(searcher, NullableColumn::create(str, null));
+    ASSERT_TRUE(result->is_nullable());
+    ASSERT_TRUE(result->is_null(0));
+    auto v = ColumnHelper::cast_to<TYPE_BOOLEAN>(ColumnHelper::as_column<NullableColumn>(result)->data_column());
+    for (size_t i = 1; i < values.size(); ++i) {
+        ASSERT_EQ(expected[i], v->get_data()[i]) << values[i];
+    }
+
+    auto const_value = ColumnHelper::create_const_column<TYPE_VARCHAR>("a timeout", 3);
+    auto const_result = LikePredicate::multi_substring_match(searcher, const_value);
+    ASSERT_TRUE(const_result->is_constant());
+    ASSERT_EQ(3, const_result->size());
+    ASSERT_TRUE(ColumnHelper::get_const_value<TYPE_BOOLEAN>(const_result));
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -1070,6 +1070,31 @@ PARALLEL_TEST(VecStringFunctionsTest, utf8LengthChineseTest) {
     }
 }
 
+PARALLEL_TEST(VecStringFunctionsTest, utf8LengthNullableTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    Columns columns;
+    auto str = BinaryColumn::create();
+    auto null = NullColumn::create();
+    for (int j = 0; j < 20; ++j) {
+        str->append(std::string(j * 3, j % 2 == 0 ? 'a' : ' '));
+        null->append(j % 5 == 0);
+    }
+
+    columns.emplace_back(NullableColumn::create(str, null));
+
+    ColumnPtr result = StringFunctions::utf8_length(ctx.get(), columns);
+    ASSERT_EQ(20, result->size());
+
+    auto v = ColumnHelper::cast_to<TYPE_INT>(ColumnHelper::as_raw_column<NullableColumn>(result)->data_column());
+
+    for (int k = 0; k < 20; ++k) {
+        ASSERT_EQ(k % 5 == 0, result->is_null(k));
+        if (k % 5 != 0) {
+            ASSERT_EQ(k * 3, v->get_data()[k]);
+        }
+    }
+}
+
 PARALLEL_TEST(VecStringFunctionsTest, upperTest) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     Columns columns;
@@ -0,0 +1,48 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "formats/csv/delimiter_finder.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace starrocks::vectorized::csv {
+
+// NOLINTNEXTLINE
+TEST(DelimiterFinderTest, test_find_delimiters) {
+    std::vector<uint32_t> offsets;
+    find_delimiters("", 0, '\n', ',', 0, &offsets);
+    ASSERT_TRUE(offsets.empty());
+
+    std::string data = "a,bc,\nd,,e\n";
+    find_delimiters(data.data(), data.size(), '\n', ',', 100, &offsets);
+    ASSERT_EQ((std::vector<uint32_t>{101, 104, 105, 107, 108, 110}), offsets);
+}
+
+// NOLINTNEXTLINE
+TEST(DelimiterFinderTest, test_find_delimiters_long) {
+    // cross the boundaries of the 32 bytes compared at a time, and the tail
+    std::string data;
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < 1000; i++) {
+        if (i % 7 == 0) {
+            data.push_back('|');
+            expected.push_back(i);
+        } else if (i % 31 == 0) {
+            data.push_back('\n');
+            expected.push_back(i);
+        } else {
+            data.push_back(static_cast<char>('a' + i % 26));
+        }
+    }
+    std::vector<uint32_t> offsets{0};
+    find_delimiters(data.data(), data.size(), '\n', '|', 0, &offsets);
+    offsets.erase(offsets.begin());
+    ASSERT_EQ(expected, offsets);
+
+    offsets.clear();
+    find_delimiters(data.data() + 3, data.size() - 3, '\n', '|', 3, &offsets);
+    ASSERT_EQ(std::vector<uint32_t>(expected.begin() + 1, expected.end()), offsets);
+}
+
+} // namespace starrocks::vectorized::csv
@@ -27,6 +27,7 @@
 #include "geo/geo_types.h"
 #include "geo/wkt_parse.h"
 #include "geo/wkt_parse_ctx.h"
+#include "gutil/casts.h"
 #include "s2/s2debug.h"
 
 namespace starrocks {
@@ -184,6 +185,25 @@ TEST_F(GeoTypesTest, polygon_hole_contains) {
     }
 }
 
+TEST_F(GeoTypesTest, polygon_coverings_contains) {
+    const char* wkt = "POLYGON ((10 10, 50 10, 50 50, 10 50, 10 10), (20 20, 40 20, 40 40, 20 40, 20 20))";
+    GeoParseStatus status;
+    std::unique_ptr<GeoShape> polygon(GeoShape::from_wkt(wkt, strlen(wkt), &status));
+    ASSERT_EQ(GEO_PARSE_OK, status);
+    std::unique_ptr<GeoShape> covered(GeoShape::from_wkt(wkt, strlen(wkt), &status));
+    ASSERT_EQ(GEO_PARSE_OK, status);
+    down_cast<GeoPolygon*>(covered.get())->build_coverings();
+
+    // The coverings decide the same as the exact test, including the points on the edges.
+    for (double x = 0; x <= 60; x += 2.5) {
+        for (double y = 0; y <= 60; y += 2.5) {
+            GeoPoint point;
+            ASSERT_EQ(GEO_PARSE_OK, point.from_coord(x, y));
+            ASSERT_EQ(polygon->contains(&point), covered->contains(&point)) << x << " " << y;
+        }
+    }
+}
+
 TEST_F(GeoTypesTest, circle) {
     GeoCircle circle;
     auto res = circle.init(110.123, 64, 1000);
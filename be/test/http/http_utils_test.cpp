@@ -93,4 +93,26 @@ TEST_F(HttpUtilsTest, parse_basic_auth) {
     }
 }
 
+TEST_F(HttpUtilsTest, parse_range_header) {
+    int64_t offset = 0;
+    int64_t length = 0;
+    ASSERT_TRUE(parse_range_header("bytes=0-99", 1000, &offset, &length));
+    ASSERT_EQ(0, offset);
+    ASSERT_EQ(100, length);
+    ASSERT_TRUE(parse_range_header("bytes=900-", 1000, &offset, &length));
+    ASSERT_EQ(900, offset);
+    ASSERT_EQ(100, length);
+    // the last byte is bounded by the file size.
+    ASSERT_TRUE(parse_range_header("bytes=500-2000", 1000, &offset, &length));
+    ASSERT_EQ(500, offset);
+    ASSERT_EQ(500, length);
+
+    ASSERT_FALSE(parse_range_header("bytes=1000-1200", 1000, &offset, &length));
+    ASSERT_FALSE(parse_range_header("bytes=100-99", 1000, &offset, &length));
+    ASSERT_FALSE(parse_range_header("bytes=-100", 1000, &offset, &length));
+    ASSERT_FALSE(parse_range_header("bytes=0-1,5-9", 1000, &offset, &length));
+    ASSERT_FALSE(parse_range_header("bytes=a-9", 1000, &offset, &length));
+    ASSERT_FALSE(parse_range_header("lines=0-9", 1000, &offset, &length));
+}
+
 } // namespace starrocks
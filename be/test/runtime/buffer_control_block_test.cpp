@@ -24,6 +24,7 @@
 #include <gtest/gtest.h>
 #include <pthread.h>
 
+#include "common/config.h"
 #include "gen_cpp/InternalService_types.h"
 
 namespace starrocks {
@@ -83,6 +84,39 @@ TEST_F(BufferControlBlockTest, get_add_after_cancel) {
     ASSERT_FALSE(control_block.get_batch(&get_result).ok());
 }
 
+TEST_F(BufferControlBlockTest, try_add_over_max_bytes) {
+    int64_t max_bytes = config::result_buffer_max_bytes;
+    config::result_buffer_max_bytes = 1;
+    BufferControlBlock control_block(TUniqueId(), 1024);
+    config::result_buffer_max_bytes = max_bytes;
+    ASSERT_TRUE(control_block.init().ok());
+
+    TFetchDataResult* add_result = new TFetchDataResult();
+    add_result->result_batch.rows.push_back("hello test1");
+    auto res = control_block.try_add_batch(add_result);
+    ASSERT_TRUE(res.ok());
+    ASSERT_TRUE(res.value());
+
+    // the buffer holds more than the max bytes, the batch is given back.
+    add_result = new TFetchDataResult();
+    add_result->result_batch.rows.push_back("hello test2");
+    res = control_block.try_add_batch(add_result);
+    ASSERT_TRUE(res.ok());
+    ASSERT_FALSE(res.value());
+
+    TFetchDataResult get_result;
+    ASSERT_TRUE(control_block.get_batch(&get_result).ok());
+    ASSERT_EQ(1U, get_result.result_batch.rows.size());
+    ASSERT_STREQ("hello test1", get_result.result_batch.rows[0].c_str());
+
+    res = control_block.try_add_batch(add_result);
+    ASSERT_TRUE(res.ok());
+    ASSERT_TRUE(res.value());
+    ASSERT_TRUE(control_block.get_batch(&get_result).ok());
+    ASSERT_EQ(1U, get_result.result_batch.rows.size());
+    ASSERT_STREQ("hello test2", get_result.result_batch.rows[0].c_str());
+}
+
 void* cancel_thread(void* param) {
     BufferControlBlock* control_block = static_cast<BufferControlBlock*>(param);
     sleep(1);
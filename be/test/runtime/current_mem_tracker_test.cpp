@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/current_mem_tracker.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(CurrentMemTrackerTest, test_batch) {
+    MemTracker parent;
+    MemTracker tracker(-1, "test", &parent);
+    CurrentThread::set_mem_tracker(&tracker);
+
+    // accumulated in the thread
+    CurrentMemTracker::consume(1024);
+    ASSERT_EQ(0, tracker.consumption());
+    CurrentMemTracker::consume(CurrentThread::kMemBatchBytes);
+    ASSERT_EQ(CurrentThread::kMemBatchBytes + 1024, tracker.consumption());
+    ASSERT_EQ(CurrentThread::kMemBatchBytes + 1024, parent.consumption());
+
+    CurrentMemTracker::release(1024);
+    ASSERT_EQ(CurrentThread::kMemBatchBytes + 1024, tracker.consumption());
+    // committed on switching the tracker
+    ASSERT_EQ(&tracker, CurrentThread::set_mem_tracker(nullptr));
+    ASSERT_EQ(CurrentThread::kMemBatchBytes, tracker.consumption());
+
+    tracker.release(CurrentThread::kMemBatchBytes);
+    ASSERT_EQ(0, parent.consumption());
+}
+
+// NOLINTNEXTLINE
+TEST(CurrentMemTrackerTest, test_exact_near_limit) {
+    MemTracker parent(CurrentThread::kMemExactMarginBytes + 2 * CurrentThread::kMemBatchBytes);
+    MemTracker tracker(-1, "test", &parent);
+    CurrentThread::set_mem_tracker(&tracker);
+
+    CurrentMemTracker::consume(3 * CurrentThread::kMemBatchBytes);
+    ASSERT_EQ(3 * CurrentThread::kMemBatchBytes, parent.consumption());
+    // the spare capacity is less than the margin, so every consumption is committed
+    CurrentMemTracker::consume(1024);
+    ASSERT_EQ(3 * CurrentThread::kMemBatchBytes + 1024, parent.consumption());
+    CurrentMemTracker::release(3 * CurrentThread::kMemBatchBytes + 1024);
+    ASSERT_EQ(0, parent.consumption());
+
+    // batched again after the consumption drops
+    CurrentMemTracker::consume(1024);
+    ASSERT_EQ(0, parent.consumption());
+    CurrentThread::set_mem_tracker(nullptr);
+    ASSERT_EQ(1024, parent.consumption());
+    tracker.release(1024);
+}
+
+} // namespace starrocks
@@ -485,4 +485,42 @@ TEST_F(TestDecimalV3, testParseDecimalStringWithLeadingZeros) {
     }
 }
 
+template <typename T>
+void test_batch_arithmetics() {
+    // More than the lanes of AVX2, so both the vectorized loop and the tail loop run.
+    const size_t num_rows = 37;
+    std::vector<T> lhs(num_rows), rhs(num_rows), result(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        lhs[i] = static_cast<T>(i) * 1000 - 7;
+        rhs[i] = static_cast<T>(num_rows - i) * 3;
+    }
+    using BatchArithmetics = DecimalV3BatchArithmetics<T>;
+    ASSERT_FALSE((BatchArithmetics::template add<false, false>(lhs.data(), rhs.data(), result.data(), num_rows)));
+    for (size_t i = 0; i < num_rows; i++) {
+        ASSERT_TRUE(lhs[i] + rhs[i] == result[i]);
+    }
+    ASSERT_FALSE((BatchArithmetics::template sub<false, true>(lhs.data(), rhs.data(), result.data(), num_rows)));
+    for (size_t i = 0; i < num_rows; i++) {
+        ASSERT_TRUE(lhs[i] - rhs[0] == result[i]);
+    }
+    ASSERT_FALSE((BatchArithmetics::template mul<true, false>(lhs.data(), rhs.data(), result.data(), num_rows)));
+    for (size_t i = 0; i < num_rows; i++) {
+        ASSERT_TRUE(lhs[0] * rhs[i] == result[i]);
+    }
+
+    // Only one row overflows.
+    lhs[num_rows - 2] = get_max<T>();
+    ASSERT_TRUE((BatchArithmetics::template add<false, false>(lhs.data(), rhs.data(), result.data(), num_rows)));
+    rhs[num_rows - 2] = 2;
+    ASSERT_TRUE((BatchArithmetics::template mul<false, false>(lhs.data(), rhs.data(), result.data(), num_rows)));
+    lhs[num_rows - 2] = get_min<T>();
+    ASSERT_TRUE((BatchArithmetics::template sub<false, false>(lhs.data(), rhs.data(), result.data(), num_rows)));
+}
+
+TEST_F(TestDecimalV3, testBatchArithmetics) {
+    test_batch_arithmetics<int32_t>();
+    test_batch_arithmetics<int64_t>();
+    test_batch_arithmetics<int128_t>();
+}
+
 } // namespace starrocks
@@ -43,6 +43,11 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request) {
     return s_prepare_status;
 }
 
+Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request, const TPlanFragment& fragment,
+                                     std::shared_ptr<DescriptorTbl> desc_tbl) {
+    return desc_tbl != nullptr ? s_prepare_status : Status::InternalError("no shared desc tbl");
+}
+
 Status PlanFragmentExecutor::open() {
     SleepFor(MonoDelta::FromMilliseconds(50));
     return s_open_status;
@@ -66,6 +71,10 @@ protected:
         config::fragment_pool_thread_num_min = 32;
         config::fragment_pool_thread_num_max = 32;
         config::fragment_pool_queue_size = 1024;
+        config::fragment_admission_mem_reserve_percent = 0;
+        config::fragment_admission_mem_limit = -1;
+        config::fragment_admission_queue_size = 1024;
+        config::fragment_admission_timeout_ms = 60000;
     }
     virtual void TearDown() {}
 };
@@ -122,6 +131,27 @@ TEST_F(FragmentMgrTest, PrepareFailed) {
     ASSERT_FALSE(mgr.exec_plan_fragment(params).ok());
 }
 
+TEST_F(FragmentMgrTest, BatchNormal) {
+    FragmentMgr mgr(nullptr);
+    TExecBatchPlanFragmentsParams batch_params;
+    // the fragment and desc_tbl are required
+    batch_params.unique_param_per_instance.resize(8);
+    ASSERT_FALSE(mgr.exec_batch_plan_fragments(batch_params).ok());
+
+    batch_params.common_param.__set_fragment(TPlanFragment());
+    batch_params.common_param.__set_desc_tbl(TDescriptorTable());
+    for (int i = 0; i < 8; ++i) {
+        auto& params = batch_params.unique_param_per_instance[i];
+        params.params.fragment_instance_id = TUniqueId();
+        params.params.fragment_instance_id.__set_hi(100 + i);
+        params.params.fragment_instance_id.__set_lo(200);
+        params.__set_backend_num(i);
+    }
+    ASSERT_TRUE(mgr.exec_batch_plan_fragments(batch_params).ok());
+    // Duplicated
+    ASSERT_TRUE(mgr.exec_batch_plan_fragments(batch_params).ok());
+}
+
 TEST_F(FragmentMgrTest, OfferPoolFailed) {
     config::fragment_pool_thread_num_min = 1;
     config::fragment_pool_thread_num_max = 1;
@@ -144,4 +174,43 @@ TEST_F(FragmentMgrTest, OfferPoolFailed) {
     }
 }
 
+static TExecPlanFragmentParams admission_params(int64_t hi, int64_t mem_limit) {
+    TExecPlanFragmentParams params;
+    params.params.fragment_instance_id = TUniqueId();
+    params.params.fragment_instance_id.__set_hi(hi);
+    params.params.fragment_instance_id.__set_lo(200);
+    params.query_options.__set_mem_limit(mem_limit);
+    return params;
+}
+
+TEST_F(FragmentMgrTest, AdmissionWait) {
+    config::fragment_admission_mem_reserve_percent = 100;
+    config::fragment_admission_mem_limit = 150;
+    FragmentMgr mgr(nullptr);
+
+    // the first plan reserves at most the limit.
+    ASSERT_TRUE(mgr.exec_plan_fragment(admission_params(100, 200)).ok());
+    // the next one waits for the first one to finish in 50ms.
+    ASSERT_TRUE(mgr.exec_plan_fragment(admission_params(101, 100)).ok());
+    // the small one is admitted along with the running one.
+    ASSERT_TRUE(mgr.exec_plan_fragment(admission_params(102, 50)).ok());
+}
+
+TEST_F(FragmentMgrTest, AdmissionTimeout) {
+    config::fragment_admission_mem_reserve_percent = 100;
+    config::fragment_admission_mem_limit = 150;
+    config::fragment_admission_timeout_ms = 10;
+    FragmentMgr mgr(nullptr);
+
+    ASSERT_TRUE(mgr.exec_plan_fragment(admission_params(100, 100)).ok());
+    auto st = mgr.exec_plan_fragment(admission_params(101, 100));
+    ASSERT_EQ(TStatusCode::TIMEOUT, st.code()) << st.to_string();
+
+    config::fragment_admission_queue_size = 0;
+    st = mgr.exec_plan_fragment(admission_params(102, 100));
+    ASSERT_EQ(TStatusCode::TOO_MANY_TASKS, st.code()) << st.to_string();
+    // the rejected ones release nothing.
+    ASSERT_TRUE(mgr.exec_plan_fragment(admission_params(103, 50)).ok());
+}
+
 } // namespace starrocks
@@ -67,4 +67,28 @@ TEST_F(KafkaConsumerPipeTest, append_read) {
     ASSERT_EQ(eof, true);
 }
 
+TEST_F(KafkaConsumerPipeTest, pipe_group) {
+    std::vector<std::shared_ptr<KafkaConsumerPipe>> pipes{std::make_shared<KafkaConsumerPipe>(),
+                                                          std::make_shared<KafkaConsumerPipe>()};
+    KafkaConsumerPipeGroup group(pipes);
+    ASSERT_EQ(2, group.size());
+    ASSERT_FALSE(group.append("a", 1).ok());
+
+    std::string msg = "from partition 1";
+    ASSERT_TRUE(group.pipe(1)->append_with_row_delimiter(msg.c_str(), msg.length(), '\n').ok());
+    ASSERT_TRUE(group.finish().ok());
+
+    char buf[1024];
+    size_t data_size = 1024;
+    bool eof = false;
+    ASSERT_TRUE(pipes[0]->read((uint8_t*)buf, &data_size, &eof).ok());
+    ASSERT_EQ(0, data_size);
+    ASSERT_TRUE(eof);
+
+    data_size = 1024;
+    ASSERT_TRUE(pipes[1]->read((uint8_t*)buf, &data_size, &eof).ok());
+    ASSERT_EQ(msg.length() + 1, data_size);
+    ASSERT_FALSE(eof);
+}
+
 } // namespace starrocks
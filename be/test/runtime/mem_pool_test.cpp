@@ -25,6 +25,7 @@
 
 #include <string>
 
+#include "common/config.h"
 #include "runtime/mem_tracker.h"
 #include "util/logging.h"
 
@@ -131,6 +132,25 @@ TEST(MemPoolTest, Keep) {
     }
 }
 
+TEST(MemPoolTest, HugePageChunk) {
+    config::enable_huge_page_mem_pool = true;
+    MemTracker tracker(-1);
+    MemPool p(&tracker);
+    p.allocate(512 * 1024);
+    p.allocate(512 * 1024);
+    EXPECT_EQ((512 + 1024) * 1024, p.total_reserved_bytes());
+    // the chunks grow up to 2MB
+    p.allocate(1024 * 1024);
+    EXPECT_EQ((512 + 1024 + 2048) * 1024, p.total_reserved_bytes());
+    p.allocate(1024 * 1024);
+    p.allocate(1024 * 1024);
+    EXPECT_EQ((512 + 1024 + 2048 + 2048) * 1024, p.total_reserved_bytes());
+    EXPECT_EQ(p.total_reserved_bytes(), tracker.consumption());
+    p.free_all();
+    EXPECT_EQ(0, tracker.consumption());
+    config::enable_huge_page_mem_pool = false;
+}
+
 // Maximum allocation size which exceeds 32-bit.
 #define LARGE_ALLOC_SIZE (1LL << 32)
 
@@ -49,4 +49,14 @@ TEST(SystemAllocatorTest, TestNormal) {
     test_normal<false>();
 }
 
+TEST(SystemAllocatorTest, TestHugePage) {
+    config::use_mmap_allocate_chunk = false;
+    config::enable_huge_page_mem_pool = true;
+    auto ptr = SystemAllocator::allocate(2 * SystemAllocator::HUGE_PAGE_SIZE);
+    ASSERT_NE(nullptr, ptr);
+    ASSERT_EQ(0, (uint64_t)ptr % SystemAllocator::HUGE_PAGE_SIZE);
+    SystemAllocator::free(ptr, 2 * SystemAllocator::HUGE_PAGE_SIZE);
+    config::enable_huge_page_mem_pool = false;
+}
+
 } // namespace starrocks
@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <filesystem>
 
 #include "runtime/exec_env.h"
@@ -106,4 +107,32 @@ TEST_F(SnapshotLoaderTest, NormalCase) {
     ASSERT_EQ(10005, tablet_id);
 }
 
+TEST_F(SnapshotLoaderTest, RunTransfers) {
+    SnapshotLoader loader(_exec_env, 1L, 2L);
+
+    // less than 10 transfers, so nothing is reported to the frontend.
+    std::atomic<int> num_transferred{0};
+    std::vector<std::function<Status()>> transfers;
+    std::vector<int> transfer_tablets;
+    for (int i = 0; i < 8; i++) {
+        transfers.emplace_back([&]() {
+            num_transferred++;
+            return Status::OK();
+        });
+        transfer_tablets.push_back(i % 3);
+    }
+    // the 4th tablet has no files.
+    Status st = loader._run_transfers(transfers, transfer_tablets, 4, TTaskType::type::UPLOAD);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(8, num_transferred);
+
+    transfers[5] = []() { return Status::InternalError("transfer failed"); };
+    st = loader._run_transfers(transfers, transfer_tablets, 4, TTaskType::type::UPLOAD);
+    ASSERT_FALSE(st.ok());
+    ASSERT_EQ("transfer failed", st.get_error_msg());
+
+    st = loader._run_transfers({}, {}, 2, TTaskType::type::DOWNLOAD);
+    ASSERT_TRUE(st.ok());
+}
+
 } // namespace starrocks
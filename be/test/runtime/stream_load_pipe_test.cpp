@@ -201,6 +201,41 @@ TEST_F(StreamLoadPipeTest, append_mix) {
     t1.join();
 }
 
+TEST_F(StreamLoadPipeTest, read_buffer) {
+    StreamLoadPipe pipe(66, 64);
+
+    auto appender = [&pipe] {
+        for (int i = 0; i < 128; ++i) {
+            char buf = '0' + (i % 10);
+            pipe.append(&buf, 1);
+        }
+        pipe.finish();
+    };
+    std::thread t1(appender);
+
+    // the buffer partially read is taken from the rest
+    char buf[10];
+    size_t buf_len = 10;
+    bool eof = false;
+    ASSERT_TRUE(pipe.read((uint8_t*)buf, &buf_len, &eof).ok());
+    ASSERT_EQ(10, buf_len);
+
+    int k = 10;
+    ByteBufferPtr byte_buf;
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_TRUE(pipe.read_buffer(&byte_buf).ok());
+        ASSERT_TRUE(byte_buf != nullptr);
+        for (; byte_buf->has_remaining(); ++k) {
+            ASSERT_EQ('0' + (k % 10), byte_buf->ptr[byte_buf->pos++]);
+        }
+    }
+    ASSERT_EQ(128, k);
+    ASSERT_TRUE(pipe.read_buffer(&byte_buf).ok());
+    ASSERT_TRUE(byte_buf == nullptr);
+
+    t1.join();
+}
+
 TEST_F(StreamLoadPipeTest, cancel) {
     StreamLoadPipe pipe(66, 64);
 
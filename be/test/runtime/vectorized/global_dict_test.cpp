@@ -0,0 +1,114 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/vectorized/global_dict.h"
+
+#include <gtest/gtest.h>
+
+#include "column/const_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
+namespace starrocks::vectorized {
+
+class GlobalDictTest : public ::testing::Test {
+protected:
+    void SetUp() override { ASSERT_TRUE(_dict.init({"beijing", "shanghai", "shenzhen"}, {2, 1, 5}).ok()); }
+
+    GlobalDict _dict;
+};
+
+TEST_F(GlobalDictTest, init) {
+    ASSERT_EQ(3, _dict.size());
+    ASSERT_EQ(2, _dict.lookup("beijing"));
+    ASSERT_EQ(5, _dict.lookup("shenzhen"));
+    ASSERT_EQ(-1, _dict.lookup("hangzhou"));
+
+    GlobalDict dict;
+    ASSERT_FALSE(dict.init({"a", "b"}, {1}).ok());
+    ASSERT_FALSE(GlobalDict().init({"a", "b"}, {1, 1}).ok());
+    ASSERT_FALSE(GlobalDict().init({"a", "a"}, {1, 2}).ok());
+    ASSERT_FALSE(GlobalDict().init({"a"}, {-1}).ok());
+    ASSERT_FALSE(GlobalDict().init({"a"}, {GlobalDict::kMaxDictSize}).ok());
+}
+
+TEST_F(GlobalDictTest, encode_and_decode) {
+    auto words = BinaryColumn::create();
+    words->append(Slice("shanghai"));
+    words->append(Slice("beijing"));
+    words->append(Slice("shenzhen"));
+    words->append(Slice("shanghai"));
+
+    auto ids = Int32Column::create();
+    ASSERT_TRUE(_dict.encode(*words, ids.get()).ok());
+    ASSERT_EQ(std::vector<int32_t>({1, 2, 5, 1}), ids->get_data());
+
+    auto decoded = BinaryColumn::create();
+    ASSERT_TRUE(_dict.decode(*ids, decoded.get()).ok());
+    ASSERT_EQ(4, decoded->size());
+    for (size_t i = 0; i < words->size(); i++) {
+        ASSERT_EQ(words->get_slice(i).to_string(), decoded->get_slice(i).to_string());
+    }
+
+    words->append(Slice("hangzhou"));
+    ASSERT_FALSE(_dict.encode(*words, ids.get()).ok());
+    ids->append(3);
+    ASSERT_FALSE(_dict.decode(*ids, decoded.get()).ok());
+}
+
+TEST_F(GlobalDictTest, nullable) {
+    auto words = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    words->append_datum(Datum(Slice("shenzhen")));
+    words->append_nulls(1);
+    words->append_datum(Datum(Slice("beijing")));
+
+    auto ids = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    ASSERT_TRUE(_dict.encode(*words, ids.get()).ok());
+    ASSERT_EQ(3, ids->size());
+    ASSERT_TRUE(ids->has_null());
+    ASSERT_TRUE(ids->is_null(1));
+    ASSERT_EQ(5, ids->get(0).get_int32());
+    ASSERT_EQ(2, ids->get(2).get_int32());
+
+    auto decoded = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    ASSERT_TRUE(_dict.decode(*ids, decoded.get()).ok());
+    ASSERT_EQ(3, decoded->size());
+    ASSERT_EQ("shenzhen", decoded->get(0).get_slice().to_string());
+    ASSERT_TRUE(decoded->is_null(1));
+    ASSERT_EQ("beijing", decoded->get(2).get_slice().to_string());
+}
+
+TEST_F(GlobalDictTest, decode_dict_slots) {
+    GlobalDicts dicts;
+    auto dict = std::make_shared<GlobalDict>();
+    ASSERT_TRUE(dict->init({"web", "app"}, {0, 1}).ok());
+
+    auto ids = Int32Column::create();
+    ids->append(1);
+    ids->append(0);
+    auto const_ids = Int32Column::create();
+    const_ids->append(0);
+
+    Chunk chunk;
+    chunk.append_column(ids, 1);
+    chunk.append_column(ConstColumn::create(const_ids, 2), 2);
+
+    std::vector<DictDecodeSlot> slots(2);
+    slots[0].id_slot = 1;
+    slots[0].string_slot = 3;
+    slots[0].dict = dict;
+    slots[1].id_slot = 2;
+    slots[1].string_slot = 4;
+    slots[1].dict = dict;
+    ASSERT_TRUE(decode_dict_slots(slots, &chunk).ok());
+
+    ASSERT_EQ(4, chunk.num_columns());
+    const ColumnPtr& words = chunk.get_column_by_slot_id(3);
+    ASSERT_EQ("app", words->get(0).get_slice().to_string());
+    ASSERT_EQ("web", words->get(1).get_slice().to_string());
+    const ColumnPtr& const_words = chunk.get_column_by_slot_id(4);
+    ASSERT_TRUE(const_words->is_constant());
+    ASSERT_EQ(2, const_words->size());
+    ASSERT_EQ("web", const_words->get(1).get_slice().to_string());
+}
+
+} // namespace starrocks::vectorized
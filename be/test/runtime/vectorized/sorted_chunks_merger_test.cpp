@@ -270,4 +270,46 @@ TEST_F(SortedChunksMergerTest, three_suppliers) {
     }
 }
 
+TEST_F(SortedChunksMergerTest, parallel_groups) {
+    ChunkSuppliers suppliers;
+    std::vector<ChunkPtr> chunks = {_chunk_1, _chunk_2, _chunk_3};
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto supplier = [&chunks, i](Chunk** cnk) -> Status {
+            if (chunks[i] != nullptr) {
+                ChunkPtr& src_chunk = chunks[i];
+                size_t row_num = src_chunk->num_rows();
+                *cnk = src_chunk->clone_empty_with_slot(row_num).release();
+                for (size_t c = 0; c < src_chunk->num_columns(); ++c) {
+                    (*cnk)->get_column_by_index(c)->append(*(src_chunk->get_column_by_index(c)), 0, row_num);
+                }
+                chunks[i] = nullptr;
+            } else {
+                *cnk = nullptr;
+            }
+            return Status::OK();
+        };
+        suppliers.push_back(supplier);
+    }
+
+    // the suppliers [0, 1] and [2] are merged by two threads, the slot refs are shared by them
+    SortedChunksMerger merger;
+    ASSERT_TRUE(merger.init(suppliers, &_sort_exprs, &_is_asc, &_is_null_first, nullptr, 2).ok());
+
+    bool eos = false;
+    ChunkPtr page_1, page_2;
+    ASSERT_TRUE(merger.get_next(&page_1, &eos).ok());
+    ASSERT_FALSE(eos);
+    ASSERT_TRUE(page_1 != nullptr);
+    ASSERT_TRUE(merger.get_next(&page_2, &eos).ok());
+    ASSERT_TRUE(eos);
+    ASSERT_TRUE(page_2 == nullptr);
+
+    const size_t Size = 16;
+    ASSERT_EQ(Size, page_1->num_rows());
+    int32_t permutation[Size] = {71, 70, 69, 54, 4, 56, 55, 49, 41, 16, 52, 58, 24, 12, 2, 6};
+    for (size_t i = 0; i < Size; ++i) {
+        ASSERT_EQ(permutation[i], page_1->get(i).get(0).get_int32());
+    }
+}
+
 } // namespace starrocks::vectorized
@@ -21,16 +21,32 @@
 
 #include "simd/simd.h"
 
+#include <algorithm>
+#include <random>
+
 #include "gtest/gtest.h"
+#include "util/cpu_info.h"
 
 namespace starrocks::vectorized {
 
 class SIMDTest : public testing::Test {
 public:
-    virtual void SetUp() {}
-    virtual void TearDown() {}
+    virtual void SetUp() { CpuInfo::init(); }
+    virtual void TearDown() { SIMD::init(); }
 };
 
+// Runs |func| by the kernels of the build target, then by the AVX-512 ones if the cpu supports them.
+template <typename Func>
+static void for_each_kernels(Func func) {
+    {
+        CpuInfo::TempDisable disable(CpuInfo::AVX512F);
+        SIMD::init();
+        func();
+    }
+    SIMD::init();
+    func();
+}
+
 TEST_F(SIMDTest, count_zeros) {
     EXPECT_EQ(0u, SIMD::count_zero(std::vector<int8_t>{}));
     EXPECT_EQ(3u, SIMD::count_zero(std::vector<int8_t>{0, 0, 0}));
@@ -76,4 +92,167 @@ TEST_F(SIMDTest, count_nonzero) {
     EXPECT_EQ(30u, SIMD::count_nonzero(numbers));
 }
 
+template <typename T>
+static void check_filter_range(std::mt19937* rng) {
+    for (size_t size : {0, 1, 7, 8, 16, 31, 32, 33, 64, 65, 100, 4096}) {
+        for (int percent : {0, 10, 50, 100}) {
+            size_t from = std::min<size_t>(size, 3);
+            std::vector<T> data(size);
+            std::vector<uint8_t> filter(size);
+            for (size_t i = 0; i < size; i++) {
+                data[i] = static_cast<T>((*rng)());
+                filter[i] = static_cast<int>((*rng)() % 100) < percent;
+            }
+            std::vector<T> expected(data.begin(), data.begin() + from);
+            for (size_t i = from; i < size; i++) {
+                if (filter[i]) {
+                    expected.emplace_back(data[i]);
+                }
+            }
+            ASSERT_EQ(expected.size(), SIMD::filter_range(filter.data(), data.data(), from, size));
+            data.resize(expected.size());
+            ASSERT_EQ(expected, data);
+        }
+    }
+}
+
+TEST_F(SIMDTest, filter_range) {
+    for_each_kernels([]() {
+        std::mt19937 rng(0);
+        check_filter_range<int8_t>(&rng);
+        check_filter_range<int16_t>(&rng);
+        check_filter_range<int32_t>(&rng);
+        check_filter_range<int64_t>(&rng);
+        check_filter_range<double>(&rng);
+        check_filter_range<__int128>(&rng);
+    });
+}
+
+TEST_F(SIMDTest, selection_to_indexes) {
+    for_each_kernels([]() {
+        std::mt19937 rng(0);
+        for (uint16_t size : {0, 1, 31, 32, 33, 100, 4096}) {
+            uint16_t from = std::min<uint16_t>(size, 5);
+            std::vector<uint8_t> selection(size);
+            std::vector<uint16_t> expected;
+            for (uint16_t i = 0; i < size; i++) {
+                selection[i] = rng() % 2;
+                if (i >= from && selection[i]) {
+                    expected.emplace_back(i);
+                }
+            }
+            std::vector<uint16_t> indexes(size - from);
+            indexes.resize(SIMD::selection_to_indexes(selection.data(), from, size, indexes.data()));
+            ASSERT_EQ(expected, indexes);
+        }
+    });
+}
+
+TEST_F(SIMDTest, bitmap_and_bytes) {
+    for_each_kernels([]() {
+        std::mt19937 rng(0);
+        for (size_t num_bits : {0, 1, 9, 32, 63, 64, 65, 1000}) {
+            std::vector<uint8_t> bitmap((num_bits + 7) / 8);
+            for (auto& b : bitmap) {
+                b = rng();
+            }
+            for (bool negate : {false, true}) {
+                std::vector<uint8_t> bytes(num_bits);
+                SIMD::bitmap_to_bytes(bitmap.data(), num_bits, bytes.data(), negate);
+                for (size_t i = 0; i < num_bits; i++) {
+                    ASSERT_EQ(((bitmap[i / 8] >> (i % 8)) & 1) ^ negate, bytes[i]);
+                }
+            }
+
+            std::vector<uint8_t> bytes(num_bits);
+            for (auto& b : bytes) {
+                b = rng() % 3;
+            }
+            std::vector<uint8_t> packed(bitmap.size(), 0xff);
+            SIMD::bytes_to_bitmap(bytes.data(), num_bits, packed.data());
+            for (size_t i = 0; i < num_bits; i++) {
+                ASSERT_EQ(bytes[i] != 0, (packed[i / 8] >> (i % 8)) & 1);
+            }
+            if (num_bits % 8 != 0) {
+                // the unused bits are cleared.
+                ASSERT_EQ(0, packed.back() >> (num_bits % 8));
+            }
+        }
+    });
+}
+
+TEST_F(SIMDTest, gather) {
+    for_each_kernels([]() {
+        std::mt19937 rng(0);
+        for (size_t size : {0, 1, 15, 16, 17, 1000}) {
+            std::vector<int32_t> src32(size + 1);
+            std::vector<int64_t> src64(size + 1);
+            std::vector<uint32_t> indexes(size);
+            for (size_t i = 0; i <= size; i++) {
+                src32[i] = rng();
+                src64[i] = (static_cast<int64_t>(rng()) << 32) | rng();
+            }
+            for (auto& index : indexes) {
+                index = rng() % (size + 1);
+            }
+            std::vector<int32_t> dst32(size);
+            std::vector<int64_t> dst64(size);
+            SIMD::gather(src32.data(), indexes.data(), size, dst32.data());
+            SIMD::gather(src64.data(), indexes.data(), size, dst64.data());
+            for (size_t i = 0; i < size; i++) {
+                ASSERT_EQ(src32[indexes[i]], dst32[i]);
+                ASSERT_EQ(src64[indexes[i]], dst64[i]);
+            }
+        }
+    });
+}
+
+TEST_F(SIMDTest, min_max) {
+    for_each_kernels([]() {
+        std::mt19937 rng(0);
+        for (size_t size : {1, 7, 8, 15, 16, 17, 1000}) {
+            std::vector<int32_t> values32(size);
+            std::vector<int64_t> values64(size);
+            for (size_t i = 0; i < size; i++) {
+                values32[i] = rng();
+                values64[i] = (static_cast<int64_t>(rng()) << 32) | rng();
+            }
+            int32_t min32;
+            int32_t max32;
+            SIMD::min_max(values32.data(), size, &min32, &max32);
+            ASSERT_EQ(*std::min_element(values32.begin(), values32.end()), min32);
+            ASSERT_EQ(*std::max_element(values32.begin(), values32.end()), max32);
+            int64_t min64;
+            int64_t max64;
+            SIMD::min_max(values64.data(), size, &min64, &max64);
+            ASSERT_EQ(*std::min_element(values64.begin(), values64.end()), min64);
+            ASSERT_EQ(*std::max_element(values64.begin(), values64.end()), max64);
+        }
+    });
+}
+
+TEST_F(SIMDTest, find_nonzero) {
+    for_each_kernels([]() {
+        for (size_t size : {0, 1, 63, 64, 65, 1000}) {
+            std::vector<uint8_t> zeros(size, 0);
+            ASSERT_EQ(size, SIMD::find_nonzero(zeros.data(), size));
+            ASSERT_FALSE(SIMD::contain_nonzero(zeros));
+            std::vector<uint8_t> ones(size, 1);
+            ASSERT_EQ(size, SIMD::find_zero(ones.data(), size));
+            for (size_t pos : {size_t(0), size / 2, size - 1}) {
+                if (pos >= size) {
+                    continue;
+                }
+                zeros[pos] = 2;
+                ASSERT_EQ(pos, SIMD::find_nonzero(zeros.data(), size));
+                ASSERT_TRUE(SIMD::contain_nonzero(zeros));
+                zeros[pos] = 0;
+                ones[pos] = 0;
+                ASSERT_EQ(pos, SIMD::find_zero(ones.data(), size));
+                ones[pos] = 1;
+            }
+        }
+    });
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,112 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "storage/schema_change.h"
+#include "storage/tablet_schema.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/wrapper_field.h"
+
+namespace starrocks {
+
+class ChunkChangerTest : public testing::Test {
+public:
+    void TearDown() override {
+        for (auto& mapping : _mapping) {
+            delete mapping.default_value;
+        }
+    }
+
+protected:
+    static void add_column(TabletSchemaPB* schema_pb, int32_t id, const std::string& name, const std::string& type,
+                           int32_t length, bool is_key, bool is_nullable, const std::string& default_value = "") {
+        ColumnPB* column = schema_pb->add_column();
+        column->set_unique_id(id);
+        column->set_name(name);
+        column->set_type(type);
+        column->set_length(length);
+        column->set_is_key(is_key);
+        column->set_is_nullable(is_nullable);
+        column->set_aggregation(is_key ? "NONE" : "REPLACE");
+        if (!default_value.empty()) {
+            column->set_default_value(default_value);
+        }
+    }
+
+    void init_schemas() {
+        TabletSchemaPB base_pb;
+        base_pb.set_keys_type(UNIQUE_KEYS);
+        base_pb.set_num_short_key_columns(1);
+        add_column(&base_pb, 0, "k1", "INT", 4, true, false);
+        add_column(&base_pb, 1, "v1", "SMALLINT", 2, false, true);
+        add_column(&base_pb, 2, "v2", "CHAR", 4, false, false);
+        _base_schema.init_from_pb(base_pb);
+
+        TabletSchemaPB new_pb;
+        new_pb.set_keys_type(UNIQUE_KEYS);
+        new_pb.set_num_short_key_columns(1);
+        add_column(&new_pb, 0, "k1", "BIGINT", 8, true, false);
+        add_column(&new_pb, 1, "v1", "INT", 4, false, true);
+        add_column(&new_pb, 2, "v2", "VARCHAR", 8, false, false);
+        add_column(&new_pb, 3, "v3", "INT", 4, false, true, "7");
+        _new_schema.init_from_pb(new_pb);
+
+        _mapping.resize(4);
+        _mapping[0].ref_column = 0;
+        _mapping[1].ref_column = 1;
+        _mapping[2].ref_column = 2;
+        _mapping[3].default_value = WrapperField::create(_new_schema.column(3));
+        _mapping[3].default_value->from_string("7");
+    }
+
+    TabletSchema _base_schema;
+    TabletSchema _new_schema;
+    SchemaMapping _mapping;
+};
+
+// NOLINTNEXTLINE
+TEST_F(ChunkChangerTest, test_change_chunk) {
+    init_schemas();
+    ChunkChanger changer(_base_schema, _new_schema, _mapping);
+    ASSERT_TRUE(changer.init());
+
+    auto base_chunk = vectorized::ChunkHelper::new_chunk(changer.base_schema(), 3);
+    for (int32_t i = 0; i < 3; i++) {
+        base_chunk->get_column_by_index(0)->append_datum(vectorized::Datum(i));
+        if (i == 1) {
+            ASSERT_TRUE(base_chunk->get_column_by_index(1)->append_nulls(1));
+        } else {
+            base_chunk->get_column_by_index(1)->append_datum(vectorized::Datum(static_cast<int16_t>(i * 10)));
+        }
+        std::string str = "s" + std::to_string(i);
+        base_chunk->get_column_by_index(2)->append_datum(vectorized::Datum(Slice(str)));
+    }
+
+    auto new_chunk = vectorized::ChunkHelper::new_chunk(changer.new_schema(), 3);
+    ASSERT_TRUE(changer.change_chunk(*base_chunk, new_chunk.get()).ok());
+    ASSERT_EQ(3, new_chunk->num_rows());
+    for (int32_t i = 0; i < 3; i++) {
+        ASSERT_EQ(i, new_chunk->get_column_by_index(0)->get(i).get_int64());
+        if (i == 1) {
+            ASSERT_TRUE(new_chunk->get_column_by_index(1)->is_null(i));
+        } else {
+            ASSERT_EQ(i * 10, new_chunk->get_column_by_index(1)->get(i).get_int32());
+        }
+        ASSERT_EQ("s" + std::to_string(i), new_chunk->get_column_by_index(2)->get(i).get_slice().to_string());
+        ASSERT_EQ(7, new_chunk->get_column_by_index(3)->get(i).get_int32());
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunkChangerTest, test_unsupported_mapping) {
+    init_schemas();
+    _mapping[1].materialized_function = "to_bitmap";
+    ChunkChanger changer(_base_schema, _new_schema, _mapping);
+    ASSERT_FALSE(changer.init());
+}
+
+} // namespace starrocks
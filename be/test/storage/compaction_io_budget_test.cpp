@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/compaction_io_budget.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+class CompactionIOBudgetTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _budget = config::compaction_io_budget_mb_per_sec;
+        _min_rate = config::compaction_io_min_mb_per_sec;
+        config::compaction_io_budget_mb_per_sec = 100;
+        config::compaction_io_min_mb_per_sec = 10;
+    }
+
+    void TearDown() override {
+        config::compaction_io_budget_mb_per_sec = _budget;
+        config::compaction_io_min_mb_per_sec = _min_rate;
+    }
+
+    static constexpr int64_t MB = 1024 * 1024;
+
+    int64_t _budget = 0;
+    int64_t _min_rate = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CompactionIOBudgetTest, test_throttle) {
+    CompactionIOBudget budget;
+    ASSERT_TRUE(budget.can_start_compaction(0));
+    budget.charge_compaction(300 * MB, 0);
+    // the debt is repaid by 100MB per second.
+    ASSERT_FALSE(budget.can_start_compaction(1000));
+    ASSERT_FALSE(budget.can_start_compaction(2000));
+    ASSERT_TRUE(budget.can_start_compaction(3000));
+
+    auto stats = budget.get_stats(3000);
+    ASSERT_EQ(100 * MB, stats.rate);
+    ASSERT_EQ(0, stats.tokens);
+    ASSERT_EQ(2, stats.throttled);
+    ASSERT_GT(stats.compaction_bytes_per_sec, 0);
+
+    // the tokens are capped by one second of the refills.
+    ASSERT_EQ(100 * MB, budget.get_stats(60000).tokens);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompactionIOBudgetTest, test_query_io) {
+    CompactionIOBudget budget;
+    ASSERT_EQ(100 * MB, budget.get_stats(0).rate);
+    budget.add_query_bytes(95 * MB);
+    // the query throughput is smoothed.
+    ASSERT_EQ(100 * MB - 95 * MB / 2, budget.get_stats(1000).rate);
+    budget.add_query_bytes(190 * MB);
+    ASSERT_EQ(10 * MB, budget.get_stats(2000).rate);
+    ASSERT_GT(budget.get_stats(2000).query_bytes_per_sec, 100 * MB);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompactionIOBudgetTest, test_no_limit) {
+    config::compaction_io_budget_mb_per_sec = 0;
+    CompactionIOBudget budget;
+    budget.charge_compaction(1024 * MB, 0);
+    ASSERT_TRUE(budget.can_start_compaction(0));
+    ASSERT_EQ(0, budget.get_stats(0).rate);
+}
+
+} // namespace starrocks
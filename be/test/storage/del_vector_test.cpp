@@ -41,4 +41,24 @@ TEST(DelVector, testLoadSave) {
     ASSERT_EQ(dv2.cardinality(), dels.size());
 };
 
+// NOLINTNEXTLINE
+TEST(DelVector, testConsecutiveDels) {
+    std::vector<uint32_t> dels;
+    for (uint32_t i = 0; i < 100000; i++) {
+        dels.push_back(i);
+    }
+    DelVector dv;
+    dv.init(1, dels.data(), dels.size());
+    ASSERT_EQ(dels.size(), dv.cardinality());
+    // kept as the runs of the rows instead of the array or bitset containers
+    ASSERT_LT(dv.memory_usage(), 64);
+    std::string raw = dv.save();
+    ASSERT_LT(raw.size(), 64);
+    DelVector dv2;
+    ASSERT_TRUE(dv2.load(1, raw.data(), raw.size()).ok());
+    ASSERT_EQ(dels.size(), dv2.cardinality());
+    ASSERT_TRUE(dv2.roaring()->contains(99999));
+    ASSERT_FALSE(dv2.roaring()->contains(100000));
+}
+
 } // namespace starrocks
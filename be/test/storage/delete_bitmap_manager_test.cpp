@@ -0,0 +1,40 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/delete_bitmap_manager.h"
+
+#include <gtest/gtest.h>
+
+#include "storage/del_vector.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(DeleteBitmapManagerTest, test_get_and_put) {
+    DeleteBitmapManager manager(1024 * 1024);
+    RowsetId rowset_id;
+    rowset_id.init(2, 1, 0, 0);
+    ASSERT_EQ(nullptr, manager.get(rowset_id, 0));
+
+    std::vector<uint32_t> dels{1, 3, 5};
+    auto del_vec = std::make_shared<DelVector>();
+    del_vec->init(10, dels.data(), dels.size());
+    manager.put(rowset_id, 0, del_vec);
+
+    DelVectorPtr cached = manager.get(rowset_id, 0);
+    ASSERT_NE(nullptr, cached);
+    ASSERT_EQ(10, cached->version());
+    ASSERT_EQ(3, cached->cardinality());
+    ASSERT_EQ(nullptr, manager.get(rowset_id, 1));
+    ASSERT_GT(manager.memory_usage(), 0);
+
+    // The empty DelVector records no row is deleted up to its version.
+    auto empty = std::make_shared<DelVector>();
+    empty->init(12, nullptr, 0);
+    manager.put(rowset_id, 0, empty);
+    cached = manager.get(rowset_id, 0);
+    ASSERT_NE(nullptr, cached);
+    ASSERT_EQ(12, cached->version());
+    ASSERT_TRUE(cached->empty());
+}
+
+} // namespace starrocks
@@ -196,6 +196,49 @@ TEST_F(TestHll, Normal) {
     }
 }
 
+TEST_F(TestHll, MergeMany) {
+    HyperLogLog explicit_hll;
+    for (int i = 0; i < 100; ++i) {
+        explicit_hll.update(hash(i));
+    }
+    HyperLogLog explicit_hll2;
+    for (int i = 100; i < 200; ++i) {
+        explicit_hll2.update(hash(i));
+    }
+    HyperLogLog full_hll;
+    for (int i = 0; i < 64 * 1024; ++i) {
+        full_hll.update(hash(64 * 1024 + i));
+    }
+    HyperLogLog empty_hll;
+
+    // the explicit values only
+    {
+        HyperLogLog hll;
+        hll.merge_many({&explicit_hll, &empty_hll});
+        ASSERT_EQ(100, hll.estimate_cardinality());
+    }
+    // the same as merging one by one
+    {
+        HyperLogLog expected_hll;
+        expected_hll.merge(explicit_hll);
+        expected_hll.merge(full_hll);
+        expected_hll.merge(empty_hll);
+        expected_hll.merge(explicit_hll2);
+
+        HyperLogLog hll;
+        hll.merge_many({&explicit_hll, &full_hll, &empty_hll, &explicit_hll2});
+        ASSERT_EQ(expected_hll.estimate_cardinality(), hll.estimate_cardinality());
+        auto cardinality = hll.estimate_cardinality();
+        // 2% error rate
+        ASSERT_TRUE(cardinality > 63 * 1024 && cardinality < 67 * 1024);
+
+        HyperLogLog explicit_state;
+        explicit_state.merge(explicit_hll);
+        explicit_state.merge_many({&explicit_hll2, &full_hll});
+        ASSERT_EQ(expected_hll.estimate_cardinality(), explicit_state.estimate_cardinality());
+    }
+}
+
 TEST_F(TestHll, InvalidPtr) {
     {
         HyperLogLog hll(Slice((char*)nullptr, 0));
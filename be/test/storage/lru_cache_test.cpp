@@ -257,6 +257,95 @@ TEST_F(CacheTest, Usage) {
     ASSERT_EQ(950, cache.get_usage());
 }
 
+TEST_F(CacheTest, ScanResistant) {
+    for (CachePolicy policy : {CachePolicy::LRU, CachePolicy::SLRU}) {
+        LRUCache cache;
+        cache.set_capacity(1000);
+        cache.set_policy(policy);
+
+        CacheKey hot("hot");
+        uint32_t hot_hash = hot.hash(hot.data(), hot.size(), 0);
+        insert_LRUCache(cache, hot, 100, CachePriority::NORMAL);
+        cache.release(cache.lookup(hot, hot_hash));
+        ASSERT_EQ(policy == CachePolicy::SLRU ? 100 : 0, cache.get_protected_usage());
+
+        // a scan reading each entry once.
+        for (int i = 0; i < 20; i++) {
+            std::string key = "scan" + std::to_string(i);
+            insert_LRUCache(cache, CacheKey(key), 100, CachePriority::NORMAL);
+        }
+        Cache::Handle* h = cache.lookup(hot, hot_hash);
+        ASSERT_EQ(policy == CachePolicy::SLRU, h != nullptr);
+        cache.release(h);
+        ASSERT_EQ(1000, cache.get_usage());
+        ASSERT_EQ(11, cache.get_evict_count());
+    }
+}
+
+TEST_F(CacheTest, ProtectedLimit) {
+    LRUCache cache;
+    cache.set_capacity(1000);
+    cache.set_policy(CachePolicy::SLRU);
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 10; i++) {
+        keys.push_back("key" + std::to_string(i));
+        insert_LRUCache(cache, CacheKey(keys.back()), 100, CachePriority::NORMAL);
+    }
+    // hit all entries, the protected segment keeps the latest 800.
+    for (auto& key : keys) {
+        CacheKey k(key);
+        cache.release(cache.lookup(k, k.hash(k.data(), k.size(), 0)));
+    }
+    ASSERT_EQ(800, cache.get_protected_usage());
+    ASSERT_EQ(1000, cache.get_usage());
+
+    // the demoted entries are evicted before the protected ones.
+    insert_LRUCache(cache, CacheKey("new"), 200, CachePriority::NORMAL);
+    for (int i = 0; i < 2; i++) {
+        CacheKey k(keys[i]);
+        ASSERT_EQ(nullptr, cache.lookup(k, k.hash(k.data(), k.size(), 0)));
+    }
+    for (int i = 2; i < 10; i++) {
+        CacheKey k(keys[i]);
+        Cache::Handle* h = cache.lookup(k, k.hash(k.data(), k.size(), 0));
+        ASSERT_NE(nullptr, h);
+        cache.release(h);
+    }
+}
+
+TEST_F(CacheTest, Clock) {
+    LRUCache cache;
+    cache.set_capacity(1000);
+    cache.set_policy(CachePolicy::CLOCK);
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 10; i++) {
+        keys.push_back("key" + std::to_string(i));
+        insert_LRUCache(cache, CacheKey(keys.back()), 100, CachePriority::NORMAL);
+    }
+    // the visited entry gets a second chance, and the one in use can't be evicted.
+    CacheKey key0(keys[0]);
+    cache.release(cache.lookup(key0, key0.hash(key0.data(), key0.size(), 0)));
+    CacheKey key1(keys[1]);
+    Cache::Handle* h1 = cache.lookup(key1, key1.hash(key1.data(), key1.size(), 0));
+    insert_LRUCache(cache, CacheKey("new"), 100, CachePriority::NORMAL);
+    ASSERT_EQ(1000, cache.get_usage());
+    CacheKey key2(keys[2]);
+    ASSERT_EQ(nullptr, cache.lookup(key2, key2.hash(key2.data(), key2.size(), 0)));
+    Cache::Handle* h0 = cache.lookup(key0, key0.hash(key0.data(), key0.size(), 0));
+    ASSERT_NE(nullptr, h0);
+    cache.release(h0);
+
+    // the entry erased in use is freed by the last release.
+    cache.erase(key1, key1.hash(key1.data(), key1.size(), 0));
+    ASSERT_EQ(1000, cache.get_usage());
+    cache.release(h1);
+    ASSERT_EQ(900, cache.get_usage());
+    ASSERT_EQ(9, cache.prune());
+    ASSERT_EQ(0, cache.get_usage());
+}
+
 TEST_F(CacheTest, HeavyEntries) {
     // Add a bunch of light and heavy entries and then count the combined
     // size of items still in the cache, which must be approximately the
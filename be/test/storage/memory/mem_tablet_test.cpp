@@ -23,9 +23,14 @@
 
 #include <gtest/gtest.h>
 
+#include "column/chunk.h"
+#include "common/config.h"
 #include "storage/memory/mem_tablet_scan.h"
 #include "storage/memory/write_txn.h"
 #include "storage/tablet_meta.h"
+#include "storage/types.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
 
 namespace starrocks {
 namespace memory {
@@ -185,6 +190,42 @@ TEST(MemTablet, writescan) {
         EXPECT_EQ(curidx, (size_t)num_insert);
         scan.reset();
     }
+
+    // chunk scan with predicates
+    {
+        std::unique_ptr<vectorized::ColumnPredicate> pred(
+                vectorized::new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 1, "5000"));
+        std::unique_ptr<ScanSpec> scanspec(new ScanSpec({"id", "pv", "city"}, cur_version));
+        scanspec->add_predicate(pred.get());
+        std::unique_ptr<MemTabletScan> scan;
+        ASSERT_TRUE(tablet->scan(&scanspec, &scan).ok());
+        auto chunk = vectorized::ChunkHelper::new_chunk(scan->chunk_schema(), config::vector_chunk_size);
+        size_t num_expected = 0;
+        for (const TData& d : alldata) {
+            num_expected += d.pv < 5000;
+        }
+        size_t num_read = 0;
+        while (true) {
+            Status st = scan->next_chunk(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok());
+            ASSERT_GT(chunk->num_rows(), 0);
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                const TData& d = alldata[chunk->get_column_by_index(0)->get(i).get_int32()];
+                EXPECT_EQ(d.pv, chunk->get_column_by_index(1)->get(i).get_int32());
+                EXPECT_LT(d.pv, 5000);
+                if (d.city % 2 == 0) {
+                    EXPECT_TRUE(chunk->get_column_by_index(2)->is_null(i));
+                } else {
+                    EXPECT_EQ(d.city, chunk->get_column_by_index(2)->get(i).get_int8());
+                }
+            }
+            num_read += chunk->num_rows();
+        }
+        EXPECT_EQ(num_expected, num_read);
+    }
 }
 
 } // namespace memory
@@ -26,7 +26,10 @@
 #include <filesystem>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "common/config.h"
 #include "storage/olap_define.h"
 #include "util/file_utils.h"
 
@@ -112,4 +115,45 @@ TEST_F(OlapMetaTest, TestIterate) {
     ASSERT_EQ(false, error_flag);
 }
 
+TEST_F(OlapMetaTest, TestGroupCommit) {
+    bool sync_tablet_meta = config::sync_tablet_meta;
+    config::sync_tablet_meta = true;
+    config::meta_group_commit_window_us = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([this, t]() {
+            for (int i = 0; i < 20; i++) {
+                std::string key = "key_" + std::to_string(t) + "_" + std::to_string(i);
+                ASSERT_TRUE(_meta->put(META_COLUMN_FAMILY_INDEX, key, key).ok());
+            }
+            // the keys removed by the range deletion of a batch are removed along with the other writes.
+            WriteBatch batch;
+            std::string prefix = "key_" + std::to_string(t) + "_1";
+            ASSERT_TRUE(batch.DeleteRange(_meta->handle(META_COLUMN_FAMILY_INDEX), prefix, prefix + "~").ok());
+            ASSERT_TRUE(batch.Put(_meta->handle(META_COLUMN_FAMILY_INDEX), "batch_" + std::to_string(t), "v").ok());
+            ASSERT_TRUE(_meta->write_batch(&batch).ok());
+            ASSERT_TRUE(_meta->remove(META_COLUMN_FAMILY_INDEX, "key_" + std::to_string(t) + "_0").ok());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    config::sync_tablet_meta = sync_tablet_meta;
+
+    for (int t = 0; t < 8; t++) {
+        std::string value;
+        ASSERT_TRUE(_meta->get(META_COLUMN_FAMILY_INDEX, "batch_" + std::to_string(t), &value).ok());
+        for (int i = 0; i < 20; i++) {
+            std::string key = "key_" + std::to_string(t) + "_" + std::to_string(i);
+            // key_t_0, key_t_1 and key_t_1x are removed
+            if (i <= 1 || i / 10 == 1) {
+                ASSERT_TRUE(_meta->get(META_COLUMN_FAMILY_INDEX, key, &value).is_not_found()) << key;
+            } else {
+                ASSERT_TRUE(_meta->get(META_COLUMN_FAMILY_INDEX, key, &value).ok()) << key;
+                ASSERT_EQ(key, value);
+            }
+        }
+    }
+}
+
 } // namespace starrocks
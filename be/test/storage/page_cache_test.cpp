@@ -94,4 +94,42 @@ TEST_F(StoragePageCacheTest, normal) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, in_memory_partition) {
+    StoragePageCache cache(_mem_tracker.get(), kNumShards * 2048, 0, kNumShards * 2048);
+    ASSERT_TRUE(cache.has_in_memory_partition());
+
+    StoragePageCache::CacheKey memory_key("mem", 0);
+    {
+        char* buf = new char[1024];
+        PageCacheHandle handle;
+        cache.insert(memory_key, Slice(buf, 1024), &handle, true);
+        ASSERT_EQ(buf, handle.data().data);
+    }
+    ASSERT_EQ(0, cache.memory_usage());
+    ASSERT_GT(cache.in_memory_memory_usage(), 0);
+
+    // the normal pages don't evict the pages in the partition.
+    for (int i = 0; i < 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key("bcd", i);
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, false);
+    }
+    {
+        PageCacheHandle handle;
+        ASSERT_TRUE(cache.lookup(memory_key, &handle));
+    }
+
+    // but the other in_memory pages do.
+    for (int i = 0; i < 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key("mem", i + 1);
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, true);
+    }
+    {
+        PageCacheHandle handle;
+        ASSERT_FALSE(cache.lookup(memory_key, &handle));
+    }
+}
+
 } // namespace starrocks
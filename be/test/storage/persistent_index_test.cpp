@@ -0,0 +1,140 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/persistent_index.h"
+
+#include <gtest/gtest.h>
+
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "storage/tablet_updates.h"
+#include "util/file_utils.h"
+
+namespace starrocks {
+
+class PersistentIndexTest : public testing::Test {
+public:
+    void SetUp() override {
+        _root_path = "./ut_dir/persistent_index_test";
+        FileUtils::remove_all(_root_path);
+        FileUtils::create_dir(_root_path);
+        _l0_max_mem_bytes = config::persistent_index_l0_max_mem_bytes;
+    }
+
+    void TearDown() override {
+        config::persistent_index_l0_max_mem_bytes = _l0_max_mem_bytes;
+        FileUtils::remove_all(_root_path);
+    }
+
+protected:
+    static vectorized::Int64Column keys(int64_t start, int64_t end) {
+        vectorized::Int64Column col;
+        for (int64_t i = start; i < end; i++) {
+            col.append(i);
+        }
+        return col;
+    }
+
+    // Returns the (rssid, rowid) of |key| by upserting it again.
+    static std::pair<uint32_t, uint32_t> position(PersistentIndex* index, int64_t key) {
+        PersistentIndex::DeletesMap deletes;
+        index->upsert(1000, 0, keys(key, key + 1), &deletes);
+        EXPECT_EQ(1, deletes.size());
+        auto& [rssid, rowids] = *deletes.begin();
+        EXPECT_EQ(1, rowids.size());
+        return {rssid, rowids[0]};
+    }
+
+    std::string _root_path;
+    int64_t _l0_max_mem_bytes = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(PersistentIndexTest, test_load_and_commit) {
+    // flush L0 by every commit.
+    config::persistent_index_l0_max_mem_bytes = 1;
+    {
+        PersistentIndex index(_root_path);
+        ASSERT_TRUE(index.load(EditVersion(1, 0)).is_not_found());
+        ASSERT_TRUE(index.reset(EditVersion(1, 0)).ok());
+        ASSERT_TRUE(index.insert(0, 0, keys(0, 1000)).ok());
+        ASSERT_FALSE(index.insert(1, 0, keys(999, 1000)).ok());
+        ASSERT_TRUE(index.commit(EditVersion(1, 0)).ok());
+        ASSERT_EQ(1000, index.size());
+
+        // [500, 1500) of rssid 1 replace [500, 1000) of rssid 0.
+        PrimaryIndex::DeletesMap deletes;
+        index.upsert(1, 0, keys(500, 1500), &deletes);
+        ASSERT_EQ(1, deletes.size());
+        ASSERT_EQ(500, deletes[0].size());
+        ASSERT_TRUE(index.commit(EditVersion(2, 0)).ok());
+        ASSERT_EQ(1500, index.size());
+
+        deletes.clear();
+        index.erase(keys(0, 100), &deletes);
+        index.erase(keys(2000, 2100), &deletes);
+        ASSERT_EQ(100, deletes[0].size());
+        ASSERT_TRUE(index.commit(EditVersion(3, 0)).ok());
+        ASSERT_EQ(1400, index.size());
+
+        // compaction of rssid 0 into rssid 2, the rows of [100, 500) are still in rssid 0.
+        std::vector<uint32_t> src_rssids(900, 0);
+        std::vector<uint32_t> failed;
+        index.try_replace(2, 0, keys(100, 1000), src_rssids, &failed);
+        ASSERT_EQ(500, failed.size());
+        ASSERT_EQ(400, failed[0]);
+        ASSERT_TRUE(index.commit(EditVersion(3, 1)).ok());
+        ASSERT_EQ(1400, index.size());
+    }
+
+    // keep the changes in L0 and the log.
+    config::persistent_index_l0_max_mem_bytes = _l0_max_mem_bytes;
+    {
+        PersistentIndex index(_root_path);
+        ASSERT_TRUE(index.load(EditVersion(3, 1)).ok());
+        ASSERT_EQ(1400, index.size());
+        PrimaryIndex::DeletesMap deletes;
+        index.erase(keys(1400, 1500), &deletes);
+        ASSERT_EQ(100, deletes[1].size());
+        ASSERT_TRUE(index.commit(EditVersion(4, 0)).ok());
+        ASSERT_EQ(1300, index.size());
+    }
+    {
+        PersistentIndex index(_root_path);
+        ASSERT_TRUE(index.load(EditVersion(4, 0)).ok());
+        ASSERT_EQ(1300, index.size());
+        ASSERT_EQ(std::make_pair(2u, 0u), position(&index, 100));
+        ASSERT_EQ(std::make_pair(1u, 0u), position(&index, 500));
+        ASSERT_EQ(std::make_pair(1u, 899u), position(&index, 1399));
+        PrimaryIndex::DeletesMap deletes;
+        index.upsert(1000, 0, keys(1400, 1401), &deletes);
+        ASSERT_TRUE(deletes.empty());
+        index.upsert(1000, 0, keys(0, 1), &deletes);
+        ASSERT_TRUE(deletes.empty());
+    }
+
+    // the version 4 isn't applied by the tablet, so it's discarded.
+    {
+        PersistentIndex index(_root_path);
+        ASSERT_TRUE(index.load(EditVersion(3, 1)).ok());
+        ASSERT_EQ(1400, index.size());
+        ASSERT_EQ(std::make_pair(1u, 900u), position(&index, 1400));
+    }
+    {
+        PersistentIndex index(_root_path);
+        ASSERT_TRUE(index.load(EditVersion(4, 0)).is_not_found());
+    }
+
+    // the version flushed into the files can't be rolled back.
+    {
+        PersistentIndex index(_root_path);
+        ASSERT_TRUE(index.load(EditVersion(2, 0)).is_not_found());
+    }
+
+    ASSERT_TRUE(PersistentIndex::remove_files(_root_path).ok());
+    {
+        PersistentIndex index(_root_path);
+        ASSERT_TRUE(index.load(EditVersion(3, 1)).is_not_found());
+    }
+}
+
+} // namespace starrocks
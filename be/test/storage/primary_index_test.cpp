@@ -6,10 +6,12 @@
 
 #include "column/fixed_length_column.h"
 #include "column/schema.h"
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "testutil/parallel_test.h"
+#include "util/threadpool.h"
 
 using namespace starrocks::vectorized;
 
@@ -246,6 +248,83 @@ PARALLEL_TEST(PrimaryIndexTest, test_composite_key) {
     ASSERT_EQ(deletes[1].size(), kSegmentSize);
 }
 
+// NOLINTNEXTLINE
+TEST(PrimaryIndexTest, test_upsert_rowset_by_shards) {
+    auto f = std::make_shared<vectorized::Field>(0, "c0", OLAP_FIELD_TYPE_BIGINT, false);
+    f->set_is_key(true);
+    auto schema = std::make_shared<vectorized::Schema>(Fields{f});
+    auto serial_index = TEST_create_primary_index(*schema);
+    auto sharded_index = TEST_create_primary_index(*schema);
+
+    constexpr int64_t kNumRows = 100000;
+    auto keys = [](int64_t start, int64_t end) {
+        auto col = Int64Column::create_mutable();
+        for (int64_t i = start; i < end; i++) {
+            col->append(i);
+        }
+        return col;
+    };
+    ASSERT_TRUE(serial_index->insert(0, 0, *keys(0, kNumRows)).ok());
+    ASSERT_TRUE(sharded_index->insert(0, 0, *keys(0, kNumRows)).ok());
+
+    // the segments of rowset 1 overlap each other and the rowset 0.
+    std::vector<std::unique_ptr<Column>> upserts;
+    upserts.emplace_back(keys(kNumRows / 2, kNumRows * 3 / 2));
+    upserts.emplace_back(nullptr);
+    upserts.emplace_back(keys(kNumRows, kNumRows * 2));
+    std::vector<std::unique_ptr<Column>> erases;
+    erases.emplace_back(keys(0, kNumRows / 4));
+
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_TRUE(ThreadPoolBuilder("primary_index_test").set_max_threads(4).build(&pool).ok());
+    int32_t num_shards = config::update_apply_num_shards;
+    config::update_apply_num_shards = 4;
+    PrimaryIndex::DeletesMap serial_deletes;
+    PrimaryIndex::DeletesMap sharded_deletes;
+    serial_index->upsert_rowset(1, upserts, erases, nullptr, &serial_deletes);
+    sharded_index->upsert_rowset(1, upserts, erases, pool.get(), &sharded_deletes);
+    config::update_apply_num_shards = num_shards;
+
+    ASSERT_EQ(serial_deletes.size(), sharded_deletes.size());
+    for (auto& [rssid, rowids] : serial_deletes) {
+        auto& sharded_rowids = sharded_deletes[rssid];
+        std::sort(rowids.begin(), rowids.end());
+        std::sort(sharded_rowids.begin(), sharded_rowids.end());
+        ASSERT_EQ(rowids, sharded_rowids) << "rssid:" << rssid;
+    }
+    ASSERT_EQ(kNumRows * 3 / 4, sharded_deletes[0].size());
+    ASSERT_EQ(kNumRows / 2, sharded_deletes[1].size());
+    ASSERT_EQ(serial_index->size(), sharded_index->size());
+    ASSERT_EQ(kNumRows * 7 / 4, sharded_index->size());
+}
+
+// NOLINTNEXTLINE
+TEST(PrimaryIndexTest, test_get) {
+    auto f = std::make_shared<vectorized::Field>(0, "c0", OLAP_FIELD_TYPE_BIGINT, false);
+    f->set_is_key(true);
+    auto schema = std::make_shared<vectorized::Schema>(Fields{f});
+    auto pk_index = TEST_create_primary_index(*schema);
+
+    auto keys = Int64Column::create_mutable();
+    for (int64_t i = 0; i < 100; i++) {
+        keys->append(i * 2);
+    }
+    ASSERT_TRUE(pk_index->insert(3, 10, *keys).ok());
+
+    auto lookups = Int64Column::create_mutable();
+    lookups->append(0);
+    lookups->append(1);
+    lookups->append(198);
+    lookups->append(200);
+    std::vector<uint64_t> rowids;
+    pk_index->get(*lookups, &rowids);
+    ASSERT_EQ(4, rowids.size());
+    ASSERT_EQ((3UL << 32) | 10, rowids[0]);
+    ASSERT_EQ(PrimaryIndex::NullIndexValue, rowids[1]);
+    ASSERT_EQ((3UL << 32) | 109, rowids[2]);
+    ASSERT_EQ(PrimaryIndex::NullIndexValue, rowids[3]);
+}
+
 // TODO: test composite primary key
 
 } // namespace starrocks
@@ -36,6 +36,8 @@
 #include "storage/rowset/rowset_reader_context.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
+#include "storage/rowset/vectorized/rowid_range_option.h"
+#include "storage/rowset/vectorized/rowset_ndv_sketch.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/storage_engine.h"
@@ -755,4 +757,184 @@ TEST_F(BetaRowsetTest, FinalMergeTest) {
     }
 }
 
+TEST_F(BetaRowsetTest, RowidRangeOptionTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetSharedPtr rowset;
+    const int num_segments = 2;
+    const uint32_t rows_per_segment = 1024;
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(writer_context, &rowset_writer));
+
+        for (int seg = 0; seg < num_segments; ++seg) {
+            auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+            auto& cols = chunk->columns();
+            for (auto i = 0; i < rows_per_segment; i++) {
+                auto value = static_cast<int32_t>(seg * rows_per_segment + i);
+                cols[0]->append_datum(vectorized::Datum(value));
+                cols[1]->append_datum(vectorized::Datum(value));
+                cols[2]->append_datum(vectorized::Datum(value));
+            }
+            rowset_writer->add_chunk(*chunk.get());
+            ASSERT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+        }
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_EQ(num_segments, rowset->rowset_meta()->num_segments());
+    }
+
+    // Only read the rows in [100, 300) of the second segment.
+    vectorized::RowidRangeOption rowid_range_option(1, vectorized::SparseRange(100, 300));
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &stats;
+    rs_opts.tablet_schema = &tablet_schema;
+    rs_opts.rowid_range_option = &rowid_range_option;
+
+    std::vector<vectorized::ChunkIteratorPtr> seg_iters;
+    ASSERT_TRUE(rowset->get_segment_iterators(schema, rs_opts, &seg_iters).ok());
+    ASSERT_EQ(1, seg_iters.size());
+
+    auto chunk = vectorized::ChunkHelper::new_chunk(seg_iters[0]->schema(), 100);
+    size_t count = 0;
+    while (true) {
+        auto st = seg_iters[0]->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (auto i = 0; i < chunk->num_rows(); i++) {
+            EXPECT_EQ(rows_per_segment + 100 + count + i, chunk->get(i)[0].get_int32());
+        }
+        count += chunk->num_rows();
+        chunk->reset();
+    }
+    EXPECT_EQ(200, count);
+}
+
+
+TEST_F(BetaRowsetTest, RowsetZoneMapTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetSharedPtr rowset;
+    const int num_segments = 2;
+    const uint32_t rows_per_segment = 1024;
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(writer_context, &rowset_writer));
+
+        for (int seg = 0; seg < num_segments; ++seg) {
+            auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+            auto& cols = chunk->columns();
+            for (auto i = 0; i < rows_per_segment; i++) {
+                auto value = static_cast<int32_t>(seg * rows_per_segment + i);
+                cols[0]->append_datum(vectorized::Datum(value));
+                cols[1]->append_datum(vectorized::Datum(value));
+                cols[2]->append_datum(vectorized::Datum(value));
+            }
+            rowset_writer->add_chunk(*chunk.get());
+            ASSERT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+        }
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+    }
+
+    // The zone maps of the columns are merged from the two segments.
+    const auto& meta_pb = rowset->rowset_meta()->get_meta_pb();
+    ASSERT_EQ(3, meta_pb.column_zone_maps_size());
+    EXPECT_EQ(1, meta_pb.column_zone_maps(0).unique_id());
+    EXPECT_EQ("0", meta_pb.column_zone_maps(0).min());
+    EXPECT_EQ("2047", meta_pb.column_zone_maps(0).max());
+    EXPECT_FALSE(meta_pb.column_zone_maps(0).has_null());
+    EXPECT_TRUE(meta_pb.column_zone_maps(0).has_not_null());
+
+    auto read = [&](const vectorized::ColumnPredicate* predicate, size_t* num_iters) {
+        OlapReaderStatistics stats;
+        vectorized::RowsetReadOptions rs_opts;
+        rs_opts.sorted = false;
+        rs_opts.stats = &stats;
+        rs_opts.tablet_schema = &tablet_schema;
+        rs_opts.predicates[predicate->column_id()].emplace_back(predicate);
+        std::vector<vectorized::ChunkIteratorPtr> seg_iters;
+        ASSERT_TRUE(rowset->get_segment_iterators(schema, rs_opts, &seg_iters).ok());
+        *num_iters = seg_iters.size();
+    };
+
+    size_t num_iters = 0;
+    std::unique_ptr<vectorized::ColumnPredicate> pruned(
+            vectorized::new_column_gt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, "2047"));
+    read(pruned.get(), &num_iters);
+    EXPECT_EQ(0, num_iters);
+
+    std::unique_ptr<vectorized::ColumnPredicate> selected(
+            vectorized::new_column_gt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, "2000"));
+    read(selected.get(), &num_iters);
+    EXPECT_EQ(1, num_iters);
+}
+
+TEST_F(BetaRowsetTest, RowsetNdvSketchTest) {
+    bool old_enable_column_ndv_sketch = config::enable_column_ndv_sketch;
+    config::enable_column_ndv_sketch = true;
+    DeferOp defer([&]() { config::enable_column_ndv_sketch = old_enable_column_ndv_sketch; });
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetSharedPtr rowset;
+    const int num_segments = 2;
+    const uint32_t rows_per_segment = 1024;
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(writer_context, &rowset_writer));
+
+        for (int seg = 0; seg < num_segments; ++seg) {
+            auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+            auto& cols = chunk->columns();
+            for (auto i = 0; i < rows_per_segment; i++) {
+                auto value = static_cast<int32_t>(seg * rows_per_segment + i);
+                cols[0]->append_datum(vectorized::Datum(value));
+                cols[1]->append_datum(vectorized::Datum(value % 10));
+                cols[2]->append_datum(vectorized::Datum(i));
+            }
+            rowset_writer->add_chunk(*chunk.get());
+            ASSERT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+        }
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+    }
+
+    // The sketches of the two segments are merged, so the values of both segments are counted once.
+    const auto& meta_pb = rowset->rowset_meta()->get_meta_pb();
+    ASSERT_EQ(3, meta_pb.column_ndv_sketches_size());
+    std::vector<const RowsetMetaPB*> rowset_metas{&meta_pb};
+    std::vector<int64_t> expected_ndvs{2048, 10, 1024};
+    for (int i = 0; i < 3; i++) {
+        HyperLogLog hll;
+        int64_t num_nulls = -1;
+        ASSERT_TRUE(vectorized::merge_rowset_ndv_sketches(rowset_metas, tablet_schema.column(i).unique_id(), &hll,
+                                                          &num_nulls));
+        EXPECT_EQ(0, num_nulls);
+        EXPECT_NEAR(expected_ndvs[i], hll.estimate_cardinality(), expected_ndvs[i] * 0.05);
+    }
+
+    HyperLogLog hll;
+    int64_t num_nulls = 0;
+    EXPECT_FALSE(vectorized::merge_rowset_ndv_sketches(rowset_metas, 100, &hll, &num_nulls));
+}
+
 } // namespace starrocks
@@ -0,0 +1,154 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/alp_page.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "column/fixed_length_column.h"
+#include "storage/rowset/segment_v2/options.h"
+
+namespace starrocks::segment_v2 {
+
+class AlpPageTest : public testing::Test {
+protected:
+    template <FieldType Type>
+    OwnedSlice encode(const std::vector<typename TypeTraits<Type>::CppType>& values) {
+        PageBuilderOptions options;
+        options.data_page_size = 256 * 1024;
+        AlpPageBuilder<Type> builder(options);
+        size_t added = builder.add(reinterpret_cast<const uint8_t*>(values.data()), values.size());
+        EXPECT_EQ(values.size(), added);
+        OwnedSlice page = builder.finish()->build();
+
+        typename TypeTraits<Type>::CppType first;
+        typename TypeTraits<Type>::CppType last;
+        EXPECT_TRUE(builder.get_first_value(&first).ok());
+        EXPECT_TRUE(builder.get_last_value(&last).ok());
+        EXPECT_EQ(0, memcmp(&first, &values.front(), sizeof(first)));
+        EXPECT_EQ(0, memcmp(&last, &values.back(), sizeof(last)));
+        return page;
+    }
+
+    template <FieldType Type>
+    void check_decode(const Slice& page, const std::vector<typename TypeTraits<Type>::CppType>& values) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        AlpPageDecoder<Type> decoder(page, PageDecoderOptions());
+        ASSERT_TRUE(decoder.init().ok());
+        ASSERT_EQ(values.size(), decoder.count());
+        ASSERT_EQ(ALP_ENCODING, decoder.encoding_type());
+
+        // Decode by two batches.
+        vectorized::FixedLengthColumn<CppType> column;
+        size_t n = values.size() / 3;
+        ASSERT_TRUE(decoder.next_batch(&n, &column).ok());
+        n = values.size();
+        ASSERT_TRUE(decoder.next_batch(&n, &column).ok());
+        ASSERT_EQ(values.size() - values.size() / 3, n);
+        ASSERT_EQ(values.size(), column.size());
+        ASSERT_EQ(0, memcmp(column.get_data().data(), values.data(), values.size() * sizeof(CppType)));
+
+        size_t pos = values.size() / 2;
+        ASSERT_TRUE(decoder.seek_to_position_in_page(pos).ok());
+        ASSERT_EQ(pos, decoder.current_index());
+        column.resize(0);
+        n = 1;
+        ASSERT_TRUE(decoder.next_batch(&n, &column).ok());
+        ASSERT_EQ(0, memcmp(&column.get_data()[0], &values[pos], sizeof(CppType)));
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, test_decimals) {
+    std::vector<double> values;
+    for (int i = 0; i < 10000; i++) {
+        values.emplace_back((i % 1000 - 350) / 100.0);
+    }
+    OwnedSlice page = encode<OLAP_FIELD_TYPE_DOUBLE>(values);
+    ASSERT_EQ(ALP_MODE_ENCODED, page.slice()[0]);
+    // 17 bits per value at most.
+    ASSERT_LT(page.slice().size, values.size() * 17 / 8 + ALP_PAGE_HEADER_SIZE + 1);
+    check_decode<OLAP_FIELD_TYPE_DOUBLE>(page.slice(), values);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, test_exceptions) {
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++) {
+        values.emplace_back(i * 0.5);
+    }
+    values[3] = std::numeric_limits<double>::quiet_NaN();
+    values[10] = std::numeric_limits<double>::infinity();
+    values[20] = -std::numeric_limits<double>::infinity();
+    values[30] = -0.0;
+    values[40] = M_PI;
+    values[50] = 1e300;
+    OwnedSlice page = encode<OLAP_FIELD_TYPE_DOUBLE>(values);
+    ASSERT_EQ(ALP_MODE_ENCODED, page.slice()[0]);
+    check_decode<OLAP_FIELD_TYPE_DOUBLE>(page.slice(), values);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, test_fallback_to_bitshuffle) {
+    std::mt19937_64 rng(0);
+    std::uniform_real_distribution<double> dist(0, 1);
+    std::vector<double> values;
+    for (int i = 0; i < 10000; i++) {
+        values.emplace_back(dist(rng));
+    }
+    OwnedSlice page = encode<OLAP_FIELD_TYPE_DOUBLE>(values);
+    ASSERT_EQ(ALP_MODE_BITSHUFFLE, page.slice()[0]);
+    check_decode<OLAP_FIELD_TYPE_DOUBLE>(page.slice(), values);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, test_float) {
+    std::vector<float> values;
+    for (int i = 0; i < 5000; i++) {
+        values.emplace_back(static_cast<float>(i % 300) / 10);
+    }
+    values[7] = std::numeric_limits<float>::quiet_NaN();
+    OwnedSlice page = encode<OLAP_FIELD_TYPE_FLOAT>(values);
+    ASSERT_EQ(ALP_MODE_ENCODED, page.slice()[0]);
+    check_decode<OLAP_FIELD_TYPE_FLOAT>(page.slice(), values);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, test_same_values) {
+    std::vector<double> values(100, 42.25);
+    OwnedSlice page = encode<OLAP_FIELD_TYPE_DOUBLE>(values);
+    ASSERT_EQ(ALP_MODE_ENCODED, page.slice()[0]);
+    ASSERT_EQ(ALP_PAGE_HEADER_SIZE, page.slice().size);
+    check_decode<OLAP_FIELD_TYPE_DOUBLE>(page.slice(), values);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, test_seek_at_or_after_value) {
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++) {
+        values.emplace_back(i * 0.25);
+    }
+    OwnedSlice page = encode<OLAP_FIELD_TYPE_DOUBLE>(values);
+    AlpPageDecoder<OLAP_FIELD_TYPE_DOUBLE> decoder(page.slice(), PageDecoderOptions());
+    ASSERT_TRUE(decoder.init().ok());
+
+    bool exact_match = false;
+    double target = 10.25;
+    ASSERT_TRUE(decoder.seek_at_or_after_value(&target, &exact_match).ok());
+    ASSERT_TRUE(exact_match);
+    ASSERT_EQ(41, decoder.current_index());
+
+    target = 10.3;
+    ASSERT_TRUE(decoder.seek_at_or_after_value(&target, &exact_match).ok());
+    ASSERT_FALSE(exact_match);
+    ASSERT_EQ(42, decoder.current_index());
+
+    target = 1000;
+    ASSERT_TRUE(decoder.seek_at_or_after_value(&target, &exact_match).is_not_found());
+}
+
+} // namespace starrocks::segment_v2
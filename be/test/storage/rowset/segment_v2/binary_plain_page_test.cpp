@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "column/binary_column.h"
+#include "column/nullable_column.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "storage/olap_common.h"
@@ -133,6 +134,52 @@ TEST_F(BinaryPlainPageTest, test_seek_by_value) {
     TestBinarySeekByValueSmallPage<BinaryPlainPageBuilder, BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR>, true>();
 }
 
+// NOLINTNEXTLINE
+TEST_F(BinaryPlainPageTest, test_next_batch_nullable) {
+    std::vector<std::string> words{std::string("ab\0\0", 4), "", std::string("xyz\0", 4)};
+    std::vector<Slice> slices(words.begin(), words.end());
+
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    BinaryPlainPageBuilder page_builder(options);
+    ASSERT_EQ(3, page_builder.add(reinterpret_cast<const uint8_t*>(slices.data()), slices.size()));
+    OwnedSlice owned_slice = page_builder.finish()->build();
+
+    auto decode = [&](auto* page_decoder, vectorized::Column* column) {
+        ASSERT_TRUE(page_decoder->init().ok());
+        size_t size = 2;
+        ASSERT_TRUE(page_decoder->next_batch(&size, column).ok());
+        ASSERT_EQ(2, size);
+        size = 1024;
+        ASSERT_TRUE(page_decoder->next_batch(&size, column).ok());
+        ASSERT_EQ(1, size);
+    };
+
+    PageDecoderOptions decoder_options;
+    BinaryPlainPageDecoder<OLAP_FIELD_TYPE_CHAR> char_decoder(owned_slice.slice(), decoder_options);
+    auto chars = vectorized::NullableColumn::create(vectorized::BinaryColumn::create(),
+                                                    vectorized::NullColumn::create());
+    chars->append_nulls(1);
+    decode(&char_decoder, chars.get());
+    ASSERT_EQ(4, chars->size());
+    ASSERT_TRUE(chars->is_null(0));
+    ASSERT_FALSE(chars->is_null(1));
+    ASSERT_FALSE(chars->is_null(3));
+    ASSERT_EQ("ab", chars->get(1).get_slice().to_string());
+    ASSERT_EQ("", chars->get(2).get_slice().to_string());
+    ASSERT_EQ("xyz", chars->get(3).get_slice().to_string());
+
+    BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR> varchar_decoder(owned_slice.slice(), decoder_options);
+    auto varchars = vectorized::BinaryColumn::create();
+    varchars->append(Slice("hello"));
+    decode(&varchar_decoder, varchars.get());
+    ASSERT_EQ(4, varchars->size());
+    ASSERT_EQ("hello", varchars->get_slice(0).to_string());
+    for (size_t i = 0; i < words.size(); i++) {
+        ASSERT_EQ(words[i], varchars->get_slice(i + 1).to_string());
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(BinaryPlainPageTest, test_reserve_head) {
     PageBuilderOptions options;
@@ -32,6 +32,7 @@
 #include "storage/rowset/segment_v2/bitmap_index_reader.h"
 #include "storage/rowset/segment_v2/bitmap_index_writer.h"
 #include "storage/types.h"
+#include "storage/vectorized/range.h"
 #include "util/file_utils.h"
 
 namespace starrocks {
@@ -236,5 +237,56 @@ TEST_F(BitmapIndexTest, test_null) {
     delete[] val;
 }
 
+TEST_F(BitmapIndexTest, test_bit_slices) {
+    size_t num_rows = 1000;
+    int* val = new int[num_rows];
+    for (int i = 0; i < num_rows; ++i) {
+        val[i] = (i % 200) * 3;
+    }
+
+    std::string file_name = kTestDir + "/bit_slices";
+    ColumnIndexMetaPB meta;
+    write_index_file<OLAP_FIELD_TYPE_INT>(file_name, val, num_rows, 10, &meta);
+    ASSERT_TRUE(meta.bitmap_index().has_bit_slice_column());
+    {
+        BitmapIndexReader* reader = nullptr;
+        BitmapIndexIterator* iter = nullptr;
+        get_bitmap_reader_iter(file_name, meta, &reader, &iter);
+        ASSERT_TRUE(reader->has_bit_slices());
+        ASSERT_EQ(201, iter->bitmap_nums());
+
+        // 8 bits of the ordinals and the non-null rows
+        vectorized::SparseRange wide(10, 150);
+        ASSERT_EQ(9, iter->num_bitmaps_to_read(wide));
+        ASSERT_EQ(2, iter->num_bitmaps_to_read(vectorized::SparseRange(10, 12)));
+
+        Roaring bitmap;
+        ASSERT_TRUE(iter->read_union_bitmap(wide, &bitmap).ok());
+        Roaring expected;
+        ASSERT_TRUE(iter->read_union_bitmap(10, 150, &expected).ok());
+        ASSERT_EQ(700, bitmap.cardinality());
+        ASSERT_TRUE(expected == bitmap);
+
+        // with the null bitmap
+        vectorized::SparseRange with_null(0, 201);
+        Roaring all;
+        ASSERT_TRUE(iter->read_union_bitmap(with_null, &all).ok());
+        ASSERT_EQ(1010, all.cardinality());
+
+        vectorized::SparseRange two_ranges(0, 60);
+        two_ranges.add(vectorized::Range(100, 200));
+        Roaring bitmap2;
+        ASSERT_TRUE(iter->read_union_bitmap(two_ranges, &bitmap2).ok());
+        Roaring expected2;
+        ASSERT_TRUE(iter->read_union_bitmap(0, 60, &expected2).ok());
+        ASSERT_TRUE(iter->read_union_bitmap(100, 200, &expected2).ok());
+        ASSERT_TRUE(expected2 == bitmap2);
+
+        delete reader;
+        delete iter;
+    }
+    delete[] val;
+}
+
 } // namespace segment_v2
 } // namespace starrocks
@@ -30,6 +30,7 @@
 #include "column/fixed_length_column.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "env/env_memory.h"
 #include "gen_cpp/segment_v2.pb.h"
 #include "runtime/date_value.h"
@@ -64,7 +65,8 @@ protected:
 
     void TearDown() override { _tracker.release(_tracker.consumption()); }
 
-    template <FieldType type, EncodingTypePB encoding, uint32_t version, bool adaptive = true>
+    template <FieldType type, EncodingTypePB encoding, uint32_t version, bool adaptive = true,
+              CompressionTypePB compression = LZ4_FRAME>
     void test_nullable_data(const vectorized::Column& src) {
         using Type = typename TypeTraits<type>::CppType;
         TypeInfoPtr type_info = get_type_info(type);
@@ -97,7 +99,7 @@ protected:
                 writer_opts.meta->set_length(0);
             }
             writer_opts.meta->set_encoding(encoding);
-            writer_opts.meta->set_compression(starrocks::LZ4_FRAME);
+            writer_opts.meta->set_compression(compression);
             writer_opts.meta->set_is_nullable(true);
             writer_opts.need_zone_map = true;
 
@@ -427,6 +429,20 @@ TEST_F(ColumnReaderWriterTest, test_binary) {
     test_nullable_data<OLAP_FIELD_TYPE_CHAR, DICT_ENCODING, 2>(*c);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_binary_zstd_dict) {
+    config::zstd_page_dict_size = 4096;
+    config::zstd_page_dict_sample_bytes = 16384;
+    auto c = high_cardinality_strings(100);
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, PLAIN_ENCODING, 2, true, ZSTD>(*c);
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, DICT_ENCODING, 2, true, ZSTD>(*c);
+    // the column ends before the samples are enough
+    config::zstd_page_dict_sample_bytes = 1024 * 1024 * 1024;
+    test_nullable_data<OLAP_FIELD_TYPE_CHAR, PLAIN_ENCODING, 2, true, ZSTD>(*c);
+    config::zstd_page_dict_size = 0;
+    config::zstd_page_dict_sample_bytes = 1048576;
+}
+
 // NOLINTNEXTLINE
 TEST_F(ColumnReaderWriterTest, test_default_value) {
     std::string v_int("1");
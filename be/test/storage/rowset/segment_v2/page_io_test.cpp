@@ -0,0 +1,314 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/page_io.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "env/env_memory.h"
+#include "runtime/mem_tracker.h"
+#include "storage/fs/file_block_manager.h"
+#include "storage/olap_common.h"
+#include "storage/page_cache.h"
+#include "util/block_compression.h"
+#include "util/faststring.h"
+#include "util/file_utils.h"
+
+namespace starrocks::segment_v2 {
+
+class PageIOTest : public testing::Test {
+public:
+    const std::string kTestDir = "/page_io_test";
+
+    void SetUp() override {
+        _mem_tracker = std::make_unique<MemTracker>();
+        StoragePageCache::create_global_cache(_mem_tracker.get(), 1000000000);
+        _env = new EnvMemory();
+        _block_mgr = new fs::FileBlockManager(_env, fs::BlockManagerOptions());
+        ASSERT_TRUE(_env->create_dir(kTestDir).ok());
+    }
+
+    void TearDown() override {
+        delete _block_mgr;
+        delete _env;
+        StoragePageCache::release_global_cache();
+    }
+
+protected:
+    std::unique_ptr<MemTracker> _mem_tracker = nullptr;
+    EnvMemory* _env = nullptr;
+    fs::FileBlockManager* _block_mgr = nullptr;
+};
+
+// NOLINTNEXTLINE
+TEST_F(PageIOTest, test_read_coalesced_pages) {
+    std::string filename = kTestDir + "/pages";
+    std::vector<std::string> bodies;
+    std::vector<PagePointer> pages;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        ASSERT_TRUE(_block_mgr->create_block(fs::CreateBlockOptions({filename}), &wblock).ok());
+        for (int i = 0; i < 10; i++) {
+            bodies.emplace_back(100 + i * 10, 'a' + i);
+            PageFooterPB footer;
+            footer.set_type(DATA_PAGE);
+            footer.set_uncompressed_size(bodies.back().size());
+            footer.mutable_data_page_footer()->set_num_values(i);
+            PagePointer pp;
+            ASSERT_TRUE(PageIO::write_page(wblock.get(), {Slice(bodies.back())}, footer, &pp).ok());
+            pages.push_back(pp);
+            // a small gap after the 4th page and a large one after the 7th page.
+            if (i == 3) {
+                ASSERT_TRUE(wblock->append(std::string(50, 'x')).ok());
+            } else if (i == 6) {
+                ASSERT_TRUE(wblock->append(std::string(1000, 'x')).ok());
+            }
+        }
+        ASSERT_TRUE(wblock->close().ok());
+    }
+
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    ASSERT_TRUE(_block_mgr->open_block(filename, &rblock).ok());
+    for (bool use_page_cache : {false, true}) {
+        OlapReaderStatistics stats;
+        PageReadOptions opts;
+        opts.rblock = rblock.get();
+        opts.stats = &stats;
+        opts.use_page_cache = use_page_cache;
+
+        // read the 2nd page into the page cache first.
+        if (use_page_cache) {
+            PageHandle handle;
+            Slice body;
+            PageFooterPB footer;
+            opts.page_pointer = pages[1];
+            ASSERT_TRUE(PageIO::read_and_decompress_page(opts, &handle, &body, &footer).ok());
+            stats = OlapReaderStatistics();
+        }
+
+        std::vector<PageHandle> handles(pages.size());
+        std::vector<Slice> page_bodies(pages.size());
+        std::vector<PageFooterPB> footers(pages.size());
+        ASSERT_TRUE(PageIO::read_and_decompress_pages(opts, pages.data(), pages.size(), 100, 1 << 20, handles.data(),
+                                                      page_bodies.data(), footers.data())
+                            .ok());
+        for (size_t i = 0; i < pages.size(); i++) {
+            ASSERT_EQ(bodies[i], page_bodies[i].to_string());
+            ASSERT_EQ(i, footers[i].data_page_footer().num_values());
+        }
+        ASSERT_EQ(pages.size(), stats.total_pages_num);
+        ASSERT_EQ(use_page_cache ? 1 : 0, stats.cached_pages_num);
+    }
+
+    // the IO is limited by the max IO size.
+    OlapReaderStatistics stats;
+    PageReadOptions opts;
+    opts.rblock = rblock.get();
+    opts.stats = &stats;
+    opts.use_page_cache = false;
+    std::vector<PageHandle> handles(3);
+    std::vector<Slice> page_bodies(3);
+    std::vector<PageFooterPB> footers(3);
+    ASSERT_TRUE(PageIO::read_and_decompress_pages(opts, pages.data(), 3, 0, pages[0].size, handles.data(),
+                                                  page_bodies.data(), footers.data())
+                        .ok());
+    for (size_t i = 0; i < 3; i++) {
+        ASSERT_EQ(bodies[i], page_bodies[i].to_string());
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(PageIOTest, test_compressed_page_cache) {
+    StoragePageCache::release_global_cache();
+    StoragePageCache::create_global_cache(_mem_tracker.get(), 1000000000, 1000000000);
+    const BlockCompressionCodec* codec = nullptr;
+    ASSERT_TRUE(get_block_compression_codec(LZ4_FRAME, &codec).ok());
+
+    std::string filename = kTestDir + "/compressed_pages";
+    std::string body(64 * 1024, 'a');
+    PagePointer pp;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        ASSERT_TRUE(_block_mgr->create_block(fs::CreateBlockOptions({filename}), &wblock).ok());
+        faststring compressed;
+        ASSERT_TRUE(PageIO::compress_page_body(codec, 0.1, {Slice(body)}, &compressed).ok());
+        ASSERT_FALSE(compressed.empty());
+        PageFooterPB footer;
+        footer.set_type(DATA_PAGE);
+        footer.set_uncompressed_size(body.size());
+        footer.mutable_data_page_footer()->set_num_values(1);
+        ASSERT_TRUE(PageIO::write_page(wblock.get(), {Slice(compressed)}, footer, &pp).ok());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    ASSERT_TRUE(_block_mgr->open_block(filename, &rblock).ok());
+    OlapReaderStatistics stats;
+    PageReadOptions opts;
+    opts.rblock = rblock.get();
+    opts.page_pointer = pp;
+    opts.codec = codec;
+    opts.stats = &stats;
+    opts.use_page_cache = true;
+    auto* cache = StoragePageCache::instance();
+    {
+        PageHandle handle;
+        Slice page_body;
+        PageFooterPB footer;
+        ASSERT_TRUE(PageIO::read_and_decompress_page(opts, &handle, &page_body, &footer).ok());
+        ASSERT_EQ(body, page_body.to_string());
+    }
+    // the page compresses well, so it's cached by both tiers.
+    ASSERT_GT(cache->compressed_memory_usage(), 0);
+    ASSERT_LT(cache->compressed_memory_usage(), body.size() / 2);
+
+    // the page is decompressed again after it's evicted from the tier of the decompressed pages.
+    cache->prune();
+    for (int i = 0; i < 2; i++) {
+        PageHandle handle;
+        Slice page_body;
+        PageFooterPB footer;
+        ASSERT_TRUE(PageIO::read_and_decompress_page(opts, &handle, &page_body, &footer).ok());
+        ASSERT_EQ(body, page_body.to_string());
+        ASSERT_EQ(1, footer.data_page_footer().num_values());
+    }
+    ASSERT_EQ(3, stats.total_pages_num);
+    ASSERT_EQ(1, stats.compressed_cached_pages_num);
+    ASSERT_EQ(1, stats.cached_pages_num);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PageIOTest, test_cache_written_page) {
+    StoragePageCache::release_global_cache();
+    StoragePageCache::create_global_cache(_mem_tracker.get(), 1000000000, 0, 1000000000);
+    auto* cache = StoragePageCache::instance();
+    ASSERT_TRUE(cache->has_in_memory_partition());
+    const BlockCompressionCodec* codec = nullptr;
+    ASSERT_TRUE(get_block_compression_codec(LZ4_FRAME, &codec).ok());
+
+    std::string filename = kTestDir + "/cached_pages";
+    std::vector<std::string> bodies{std::string(64 * 1024, 'a'), std::string(100, 'b')};
+    std::vector<PagePointer> pages(bodies.size());
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        ASSERT_TRUE(_block_mgr->create_block(fs::CreateBlockOptions({filename}), &wblock).ok());
+        for (size_t i = 0; i < bodies.size(); i++) {
+            PageFooterPB footer;
+            footer.set_type(DATA_PAGE);
+            footer.set_uncompressed_size(bodies[i].size());
+            footer.mutable_data_page_footer()->set_num_values(i);
+            // the first page is compressed, the second one isn't.
+            faststring compressed;
+            std::vector<Slice> body{Slice(bodies[i])};
+            if (i == 0) {
+                ASSERT_TRUE(PageIO::compress_page_body(codec, 0.1, body, &compressed).ok());
+                ASSERT_FALSE(compressed.empty());
+                body = {Slice(compressed)};
+            }
+            ASSERT_TRUE(PageIO::write_page(wblock.get(), body, footer, &pages[i]).ok());
+            ASSERT_TRUE(PageIO::cache_written_page(wblock.get(), codec, body, footer, pages[i]).ok());
+        }
+        ASSERT_TRUE(wblock->close().ok());
+    }
+    // the pages are only in the partition of the in_memory pages.
+    ASSERT_GT(cache->in_memory_memory_usage(), 0);
+    ASSERT_EQ(0, cache->memory_usage());
+
+    // the pages are read from the page cache without reading the file.
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    ASSERT_TRUE(_block_mgr->open_block(filename, &rblock).ok());
+    OlapReaderStatistics stats;
+    PageReadOptions opts;
+    opts.rblock = rblock.get();
+    opts.codec = codec;
+    opts.stats = &stats;
+    opts.use_page_cache = true;
+    opts.kept_in_memory = true;
+    for (size_t i = 0; i < bodies.size(); i++) {
+        PageHandle handle;
+        Slice page_body;
+        PageFooterPB footer;
+        opts.page_pointer = pages[i];
+        ASSERT_TRUE(PageIO::read_and_decompress_page(opts, &handle, &page_body, &footer).ok());
+        ASSERT_EQ(bodies[i], page_body.to_string());
+        ASSERT_EQ(i, footer.data_page_footer().num_values());
+    }
+    ASSERT_EQ(2, stats.cached_pages_num);
+    ASSERT_EQ(0, stats.compressed_bytes_read);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PageIOTest, test_read_mapped_pages) {
+    const std::string dir = "./ut_dir/page_io_test";
+    ASSERT_TRUE(FileUtils::create_dir(dir).ok());
+    fs::FileBlockManager block_mgr(Env::Default(), fs::BlockManagerOptions());
+    const BlockCompressionCodec* codec = nullptr;
+    ASSERT_TRUE(get_block_compression_codec(LZ4_FRAME, &codec).ok());
+
+    // an uncompressed page, a compressed page and an uncompressed page at the end of the file.
+    std::string filename = dir + "/pages";
+    std::vector<std::string> bodies{std::string(1000, 'a'), std::string(1000, 'b'), std::string(200, 'c')};
+    std::vector<PagePointer> pages(bodies.size());
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        ASSERT_TRUE(block_mgr.create_block(fs::CreateBlockOptions({filename}), &wblock).ok());
+        for (size_t i = 0; i < bodies.size(); i++) {
+            PageFooterPB footer;
+            footer.set_type(DATA_PAGE);
+            footer.set_uncompressed_size(bodies[i].size());
+            ASSERT_TRUE(PageIO::compress_and_write_page(i == 1 ? codec : nullptr, 0.1, wblock.get(), {Slice(bodies[i])},
+                                                        footer, &pages[i])
+                                .ok());
+        }
+        ASSERT_TRUE(wblock->close().ok());
+    }
+
+    config::storage_read_by_mmap = true;
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    ASSERT_TRUE(block_mgr.open_block(filename, &rblock).ok());
+    config::storage_read_by_mmap = false;
+
+    OlapReaderStatistics stats;
+    PageReadOptions opts;
+    opts.rblock = rblock.get();
+    opts.stats = &stats;
+    opts.codec = codec;
+    std::vector<PageHandle> handles(pages.size());
+    std::vector<Slice> page_bodies(pages.size());
+    std::vector<PageFooterPB> footers(pages.size());
+    for (size_t i = 0; i < pages.size(); i++) {
+        opts.page_pointer = pages[i];
+        ASSERT_TRUE(PageIO::read_and_decompress_page(opts, &handles[i], &page_bodies[i], &footers[i]).ok());
+    }
+    // the last page is read, because the bytes following it aren't mapped.
+    ASSERT_EQ(2, stats.mapped_pages_num);
+    ASSERT_EQ(0, stats.cached_pages_num);
+
+    // the mapped pages are valid after the block is closed.
+    ASSERT_TRUE(rblock->close().ok());
+    rblock.reset();
+    for (size_t i = 0; i < pages.size(); i++) {
+        ASSERT_EQ(bodies[i], page_bodies[i].to_string());
+    }
+
+    // only the decompressed page is in the page cache.
+    ASSERT_TRUE(block_mgr.open_block(filename, &rblock).ok());
+    stats = OlapReaderStatistics();
+    opts.rblock = rblock.get();
+    for (size_t i = 0; i < pages.size(); i++) {
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+        opts.page_pointer = pages[i];
+        ASSERT_TRUE(PageIO::read_and_decompress_page(opts, &handle, &body, &footer).ok());
+        ASSERT_EQ(bodies[i], body.to_string());
+    }
+    ASSERT_EQ(2, stats.cached_pages_num);
+    ASSERT_TRUE(FileUtils::remove_all(dir).ok());
+}
+
+} // namespace starrocks::segment_v2
@@ -37,11 +37,17 @@
 #include "storage/olap_common.h"
 #include "storage/row_block2.h"
 #include "storage/row_cursor.h"
+#include "storage/rowset/segment_v2/segment_footer_cache.h"
 #include "storage/rowset/segment_v2/segment_iterator.h"
 #include "storage/rowset/segment_v2/segment_writer.h"
+#include "storage/rowset/vectorized/meta_aggregates.h"
+#include "storage/rowset/vectorized/segment_options.h"
 #include "storage/tablet_schema.h"
 #include "storage/tablet_schema_helper.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
 #include "util/file_utils.h"
+#include "util/threadpool.h"
 
 #define ASSERT_OK(expr)                                   \
     do {                                                  \
@@ -607,6 +613,130 @@ TEST_F(SegmentReaderWriterTest, TestIndex) {
     }
 }
 
+TEST_F(SegmentReaderWriterTest, TestFooterCache) {
+    SegmentFooterCache::create_global_cache(1 << 20);
+    TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_key(2), create_int_value(3)});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+    opts.mem_tracker = _mem_tracker.get();
+
+    std::shared_ptr<Segment> segment;
+    build_segment(
+            opts, tablet_schema, tablet_schema, 4096,
+            [](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+                cell.set_not_null();
+                *(int*)cell.mutable_cell_ptr() = rid * 10 + cid;
+            },
+            &segment);
+
+    // reopening the segment takes the footer cached by the first open.
+    auto* footer_cache = SegmentFooterCache::instance();
+    ASSERT_GT(footer_cache->memory_usage(), 0);
+    std::shared_ptr<Segment> reopened;
+    ASSERT_OK(Segment::open(_mem_tracker.get(), _block_mgr, segment->file_name(), 0, &tablet_schema, &reopened));
+    ASSERT_EQ(&segment->footer(), &reopened->footer());
+    ASSERT_EQ(4096, reopened->num_rows());
+
+    // the footer is kept by the segments after it's erased from the cache.
+    footer_cache->erase(segment->file_name());
+    ASSERT_EQ(nullptr, footer_cache->lookup(segment->file_name()));
+    ASSERT_EQ(3, reopened->footer().columns_size());
+    SegmentFooterCache::release_global_cache();
+}
+
+TEST_F(SegmentReaderWriterTest, TestMetaAggregates) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_key(2), create_int_value(3)});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+    opts.mem_tracker = _mem_tracker.get();
+
+    std::shared_ptr<Segment> segment;
+    build_segment(
+            opts, tablet_schema, tablet_schema, 4096,
+            [](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+                cell.set_not_null();
+                *(int*)cell.mutable_cell_ptr() = rid * 10 + cid;
+            },
+            &segment);
+
+    // MIN/MAX of the 2nd column.
+    vectorized::Schema schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, {1});
+    TypeInfoPtr type_info = get_type_info(OLAP_FIELD_TYPE_INT);
+    OlapReaderStatistics stats;
+    vectorized::SegmentReadOptions read_opts;
+    read_opts.block_mgr = _block_mgr;
+    read_opts.stats = &stats;
+
+    // the zone map proves that all the rows satisfy the predicate.
+    std::unique_ptr<vectorized::ColumnPredicate> ge(vectorized::new_column_ge_predicate(type_info, 0, "0"));
+    read_opts.predicates[0].push_back(ge.get());
+    vectorized::MetaAggregates meta_aggregates(schema);
+    bool answered = false;
+    ASSERT_OK(meta_aggregates.add_segment(segment.get(), read_opts, &answered));
+    ASSERT_TRUE(answered);
+    ASSERT_EQ(4096, meta_aggregates.count());
+    ASSERT_EQ(1, meta_aggregates.num_segments());
+    const auto& rows = meta_aggregates.min_max_rows();
+    ASSERT_EQ(2, rows->num_rows());
+    ASSERT_EQ(1, rows->get_column_by_index(0)->get(0).get_int32());
+    ASSERT_EQ(4095 * 10 + 1, rows->get_column_by_index(0)->get(1).get_int32());
+
+    // some of the rows may not satisfy the predicate, so they must be read.
+    std::unique_ptr<vectorized::ColumnPredicate> gt(vectorized::new_column_gt_predicate(type_info, 0, "100"));
+    read_opts.predicates[0].push_back(gt.get());
+    ASSERT_OK(meta_aggregates.add_segment(segment.get(), read_opts, &answered));
+    ASSERT_FALSE(answered);
+    ASSERT_EQ(4096, meta_aggregates.count());
+    ASSERT_EQ(2, rows->num_rows());
+}
+
+TEST_F(SegmentReaderWriterTest, TestParallelEncode) {
+    std::vector<TabletColumn> columns;
+    for (int i = 0; i < 8; i++) {
+        columns.push_back(i < 2 ? create_int_key(i + 1) : create_int_value(i + 1));
+    }
+    TabletSchema tablet_schema = create_schema(columns);
+    vectorized::Schema schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_OK(ThreadPoolBuilder("segment_test_encode").set_max_threads(4).build(&pool));
+
+    // The segments encoded serially and in parallel are the same.
+    std::vector<std::string> contents;
+    for (ThreadPool* encode_pool : {static_cast<ThreadPool*>(nullptr), pool.get()}) {
+        std::string filename = strings::Substitute("$0/parallel_encode_$1.dat", kSegmentDir, contents.size());
+        std::unique_ptr<fs::WritableBlock> wblock;
+        ASSERT_OK(_block_mgr->create_block(fs::CreateBlockOptions({filename}), &wblock));
+        SegmentWriterOptions opts;
+        opts.storage_format_version = 2;
+        opts.mem_tracker = _mem_tracker.get();
+        opts.encode_thread_pool = encode_pool;
+        SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+        ASSERT_OK(writer.init(10));
+        for (int batch = 0; batch < 10; batch++) {
+            auto chunk = vectorized::ChunkHelper::new_chunk(schema, 1000);
+            for (int rid = batch * 1000; rid < (batch + 1) * 1000; rid++) {
+                for (size_t cid = 0; cid < columns.size(); cid++) {
+                    chunk->get_column_by_index(cid)->append_datum(vectorized::Datum(int32_t(rid * 10 + cid)));
+                }
+            }
+            ASSERT_OK(writer.append_chunk(*chunk));
+        }
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        ASSERT_OK(writer.finalize(&file_size, &index_size));
+
+        std::unique_ptr<fs::ReadableBlock> rblock;
+        ASSERT_OK(_block_mgr->open_block(filename, &rblock));
+        std::string content(file_size, '\0');
+        ASSERT_OK(rblock->read(0, Slice(content)));
+        contents.push_back(std::move(content));
+    }
+    ASSERT_EQ(contents[0], contents[1]);
+}
+
 TEST_F(SegmentReaderWriterTest, estimate_segment_size) {
     size_t num_rows_per_block = 10;
 
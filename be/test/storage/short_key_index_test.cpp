@@ -97,6 +97,52 @@ TEST_F(ShortKeyIndexTest, buider) {
     }
 }
 
+TEST_F(ShortKeyIndexTest, seek_by_prefixes) {
+    // Keys shorter and longer than the prefixes, and many of them with the same prefix.
+    std::vector<std::string> keys;
+    for (int i = 0; i < 300; i++) {
+        std::string key = "k" + std::to_string(i / 100);
+        if (i % 100 >= 10) {
+            key.append(8, 'x');
+            key.append(std::to_string(i % 100));
+        } else if (i % 100 > 0) {
+            key.append(std::string(1, '\0'));
+            key.append(std::to_string(i % 100));
+        }
+        keys.emplace_back(std::move(key));
+    }
+    std::sort(keys.begin(), keys.end());
+
+    ShortKeyIndexBuilder builder(0, 1024);
+    for (auto& key : keys) {
+        builder.add_item(key);
+    }
+    std::vector<Slice> slices;
+    segment_v2::PageFooterPB footer;
+    ASSERT_TRUE(builder.finalize(300 * 1024, &slices, &footer).ok());
+    std::string buf;
+    for (auto& slice : slices) {
+        buf.append(slice.data, slice.size);
+    }
+    ShortKeyIndexDecoder decoder;
+    ASSERT_TRUE(decoder.parse(buf, footer.short_key_page_footer()).ok());
+
+    std::vector<std::string> targets = keys;
+    for (auto& key : keys) {
+        targets.emplace_back(key + "0");
+        targets.emplace_back(key.substr(0, key.size() - 1));
+    }
+    targets.emplace_back("");
+    targets.emplace_back("a");
+    targets.emplace_back("z");
+    for (auto& target : targets) {
+        auto expected_lower = std::lower_bound(keys.begin(), keys.end(), target) - keys.begin();
+        auto expected_upper = std::upper_bound(keys.begin(), keys.end(), target) - keys.begin();
+        ASSERT_EQ(expected_lower, decoder.lower_bound(target).ordinal()) << target;
+        ASSERT_EQ(expected_upper, decoder.upper_bound(target).ordinal()) << target;
+    }
+}
+
 TEST_F(ShortKeyIndexTest, enocde) {
     TabletSchema tablet_schema;
     tablet_schema._cols.push_back(create_int_key(0));
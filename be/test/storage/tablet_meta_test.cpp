@@ -209,4 +209,30 @@ TEST(TabletMetaTest, test_create) {
     ASSERT_EQ(0, c2_1.get_sub_column(0).get_subtype_count());
 }
 
+// NOLINTNEXTLINE
+TEST(TabletMetaTest, test_report_stamp) {
+    auto mem_tracker = std::make_unique<MemTracker>();
+    TabletMeta tablet_meta(mem_tracker.get());
+    int64_t stamp = tablet_meta.report_stamp();
+    ASSERT_EQ(stamp, tablet_meta.report_stamp());
+
+    tablet_meta.set_tablet_state(TABLET_RUNNING);
+    ASSERT_NE(stamp, tablet_meta.report_stamp());
+    stamp = tablet_meta.report_stamp();
+
+    auto rs_meta = std::make_shared<RowsetMeta>();
+    rs_meta->set_version(Version(0, 1));
+    ASSERT_EQ(OLAP_SUCCESS, tablet_meta.add_rs_meta(rs_meta));
+    ASSERT_NE(stamp, tablet_meta.report_stamp());
+    stamp = tablet_meta.report_stamp();
+
+    tablet_meta.delete_rs_meta_by_version(Version(0, 1), nullptr);
+    ASSERT_NE(stamp, tablet_meta.report_stamp());
+    ASSERT_TRUE(tablet_meta.all_rs_metas().empty());
+
+    // a different tablet meta never has the same stamp, e.g. the one revised by a clone
+    TabletMeta other_tablet_meta(mem_tracker.get());
+    ASSERT_NE(tablet_meta.report_stamp(), other_tablet_meta.report_stamp());
+}
+
 } // namespace starrocks
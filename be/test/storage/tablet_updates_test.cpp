@@ -322,6 +322,40 @@ TEST_F(TabletUpdatesTest, writeread) {
     ASSERT_EQ(N, read_tablet(_tablet, 2));
 }
 
+TEST_F(TabletUpdatesTest, get_rows_by_keys) {
+    _tablet = create_tablet(rand(), rand());
+    std::vector<int64_t> keys;
+    for (int i = 0; i < 1000; i++) {
+        keys.push_back(i);
+    }
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys)).ok());
+    std::vector<int64_t> updates{5, 105, 205};
+    ASSERT_TRUE(_tablet->rowset_commit(3, create_rowset(_tablet, updates)).ok());
+    std::vector<RowsetSharedPtr> rowsets;
+    ASSERT_TRUE(_tablet->updates()->get_applied_rowsets(3, &rowsets).ok());
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema());
+    auto key_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema(), {0});
+    auto lookups = vectorized::ChunkHelper::new_chunk(key_schema, 4);
+    std::vector<int64_t> lookup_keys{105, 2000, 7, 105};
+    for (int64_t key : lookup_keys) {
+        lookups->get_column_by_index(0)->append_datum(vectorized::Datum(key));
+    }
+    std::vector<uint8_t> found;
+    std::vector<std::shared_ptr<vectorized::Column>> columns{
+            vectorized::ChunkHelper::column_from_field(*schema.field(1)),
+            vectorized::ChunkHelper::column_from_field(*schema.field(2))};
+    ASSERT_TRUE(_tablet->updates()->get_rows_by_keys(*lookups, {1, 2}, &found, &columns).ok());
+    ASSERT_EQ((std::vector<uint8_t>{1, 0, 1, 1}), found);
+    ASSERT_EQ(3, columns[0]->size());
+    ASSERT_EQ(3, columns[1]->size());
+    std::vector<int64_t> expected{105, 7, 105};
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i] % 100 + 1, columns[0]->get(i).get_int16());
+        EXPECT_EQ(expected[i] % 1000 + 2, columns[1]->get(i).get_int32());
+    }
+}
+
 TEST_F(TabletUpdatesTest, writeread_with_delete) {
     _tablet = create_tablet(rand(), rand());
     // write
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
 #include "runtime/mem_tracker.h"
 #include "storage/del_vector.h"
 #include "storage/olap_define.h"
@@ -13,6 +14,7 @@
 #include "storage/rowset/rowset_writer_context.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/storage_engine.h"
+#include "storage/tablet_updates.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/file_utils.h"
 
@@ -146,6 +148,45 @@ TEST_F(UpdateManagerTest, testDelVec) {
     ASSERT_EQ(5, tmp->version());
 }
 
+TEST_F(UpdateManagerTest, testDelVecCacheCapacity) {
+    int64_t capacity = config::update_del_vec_cache_capacity_bytes;
+    std::vector<DelVectorPtr> delvecs;
+    for (uint32_t i = 0; i < 3; i++) {
+        TabletSegmentId rssid;
+        rssid.tablet_id = 0;
+        rssid.segment_id = i;
+        DelVector empty;
+        DelVectorPtr delvec;
+        vector<uint32_t> dels = {1, 3, 5, 70, 9000};
+        empty.add_dels_as_new_version(dels, 2, &delvec);
+        _update_manager->set_del_vec_in_meta(_meta.get(), rssid, *delvec);
+        delvecs.push_back(delvec);
+    }
+    // room for two of them
+    config::update_del_vec_cache_capacity_bytes = delvecs[0]->memory_usage() * 2;
+    for (uint32_t i = 0; i < 3; i++) {
+        TabletSegmentId rssid;
+        rssid.tablet_id = 0;
+        rssid.segment_id = i;
+        ASSERT_TRUE(_update_manager->set_cached_del_vec(rssid, delvecs[i]).ok());
+    }
+    config::update_del_vec_cache_capacity_bytes = capacity;
+    ASSERT_EQ(delvecs[0]->memory_usage() * 2, _root_mem_tracker->consumption());
+
+    // segment 0 is evicted, and it's loaded from the meta again.
+    TabletSegmentId rssid;
+    rssid.tablet_id = 0;
+    rssid.segment_id = 0;
+    DelVectorPtr tmp;
+    ASSERT_TRUE(_update_manager->get_latest_del_vec(_meta.get(), rssid, &tmp).ok());
+    ASSERT_NE(delvecs[0].get(), tmp.get());
+    ASSERT_EQ(2, tmp->version());
+    ASSERT_EQ(5, tmp->cardinality());
+    rssid.segment_id = 2;
+    ASSERT_TRUE(_update_manager->get_latest_del_vec(_meta.get(), rssid, &tmp).ok());
+    ASSERT_EQ(delvecs[2].get(), tmp.get());
+}
+
 TEST_F(UpdateManagerTest, testExpireEntry) {
     srand(time(NULL));
     create_tablet(rand(), rand());
@@ -182,4 +223,30 @@ TEST_F(UpdateManagerTest, testExpireEntry) {
     ASSERT_EQ(peak_size - expiring_size, remaining_size);
 }
 
+TEST_F(UpdateManagerTest, testPrewarmPrimaryIndexes) {
+    srand(time(NULL));
+    create_tablet(rand(), rand());
+    std::vector<int64_t> keys;
+    for (int i = 0; i < 1000; i++) {
+        keys.push_back(i);
+    }
+    auto rs0 = create_rowset(keys);
+    ASSERT_TRUE(_tablet->rowset_commit(2, rs0).ok());
+    ASSERT_EQ(2, _tablet->updates()->max_version());
+    std::vector<RowsetSharedPtr> rowsets;
+    ASSERT_TRUE(_tablet->updates()->get_applied_rowsets(2, &rowsets).ok());
+    ASSERT_EQ(0, _update_manager->index_cache().object_size());
+
+    // stopped before any of them is loaded
+    _update_manager->prewarm_primary_indexes({_tablet}, 2, []() { return true; });
+    ASSERT_EQ(0, _update_manager->index_cache().object_size());
+
+    _update_manager->prewarm_primary_indexes({_tablet}, 2, []() { return false; });
+    ASSERT_EQ(1, _update_manager->index_cache().object_size());
+    auto index_entry = _update_manager->index_cache().get(_tablet->tablet_id());
+    ASSERT_TRUE(index_entry != nullptr);
+    ASSERT_EQ(keys.size(), index_entry->value().size());
+    _update_manager->index_cache().release(index_entry);
+}
+
 } // namespace starrocks
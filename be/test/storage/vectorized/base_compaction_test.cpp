@@ -5,6 +5,8 @@
 #include <gtest/gtest.h>
 
 #include "runtime/exec_env.h"
+#include "storage/del_vector.h"
+#include "storage/delete_bitmap_manager.h"
 #include "storage/row_cursor.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_writer.h"
@@ -316,4 +318,80 @@ TEST_F(BaseCompactionTest, test_compact_succeed) {
     ASSERT_TRUE(base_compaction.compact().ok());
 }
 
+TEST_F(BaseCompactionTest, test_compact_with_delete_bitmap) {
+    config::storage_format_version = 2;
+    create_tablet_schema(UNIQUE_KEYS);
+
+    TabletMetaSharedPtr tablet_meta(new TabletMeta(_tablet_meta_mem_tracker.get()));
+    create_tablet_meta(tablet_meta.get());
+
+    RowsetWriterContext rowset_writer_context(kDataFormatUnknown, config::storage_format_version);
+    create_rowset_writer_context(&rowset_writer_context);
+    std::vector<RowsetId> rowset_ids;
+    for (int i = 0; i < 2; i++) {
+        RowsetId src_rowset_id;
+        src_rowset_id.init(10000 + i);
+        rowset_writer_context.rowset_id = src_rowset_id;
+        rowset_writer_context.version = Version(2 * i, 2 * i + 1);
+
+        std::unique_ptr<RowsetWriter> _rowset_writer;
+        ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer));
+        rowset_writer_add_rows(_rowset_writer);
+        _rowset_writer->flush();
+        RowsetSharedPtr src_rowset = _rowset_writer->build();
+        ASSERT_TRUE(src_rowset != nullptr);
+        ASSERT_EQ(1024, src_rowset->num_rows());
+        tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+        rowset_ids.push_back(src_rowset_id);
+    }
+
+    // the delete of version 4 removes the rows of k1 < 100 from both rowsets.
+    DeletePredicatePB del_pred;
+    del_pred.add_sub_predicates("k1<<100");
+    del_pred.set_version(4);
+    {
+        RowsetId src_rowset_id;
+        src_rowset_id.init(10002);
+        rowset_writer_context.rowset_id = src_rowset_id;
+        rowset_writer_context.version = Version(4, 4);
+
+        std::unique_ptr<RowsetWriter> _rowset_writer;
+        ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer));
+        _rowset_writer->flush();
+        RowsetSharedPtr src_rowset = _rowset_writer->build();
+        ASSERT_TRUE(src_rowset != nullptr);
+        src_rowset->rowset_meta()->set_delete_predicate(del_pred);
+        tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+        tablet_meta->add_delete_predicate(del_pred, 4);
+    }
+
+    TabletSharedPtr tablet =
+            Tablet::create_tablet_from_meta(_tablet_meta_mem_tracker.get(), tablet_meta,
+                                            starrocks::ExecEnv::GetInstance()->storage_engine()->get_stores()[0]);
+    tablet->init();
+    tablet->calculate_cumulative_point();
+
+    bool enable_materialization = config::enable_delete_bitmap_materialization;
+    config::enable_delete_bitmap_materialization = true;
+    DeleteBitmapManager* delete_bitmaps = k_engine->delete_bitmap_manager();
+    ASSERT_TRUE(delete_bitmaps->materialize(tablet).ok());
+    for (const RowsetId& rowset_id : rowset_ids) {
+        DelVectorPtr del_vec = delete_bitmaps->get(rowset_id, 0);
+        ASSERT_NE(nullptr, del_vec);
+        ASSERT_EQ(4, del_vec->version());
+        ASSERT_EQ(100U, del_vec->cardinality());
+    }
+
+    // The compaction doesn't skip the rows by the bitmaps, the rows deleted are counted as filtered, so the row
+    // num check passes.
+    BaseCompaction base_compaction(_compaction_mem_tracker.get(), tablet);
+    Status st = base_compaction.compact();
+    config::enable_delete_bitmap_materialization = enable_materialization;
+    ASSERT_TRUE(st.ok()) << st.to_string();
+
+    RowsetSharedPtr output_rowset = tablet->get_rowset_by_version(Version(0, 4));
+    ASSERT_NE(nullptr, output_rowset);
+    ASSERT_EQ(1024 - 100, output_rowset->num_rows());
+}
+
 } // namespace starrocks::vectorized
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "storage/rowset/segment_v2/bloom_filter.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/column_or_predicate.h"
 
@@ -1630,6 +1631,68 @@ TEST(ColumnPredicateTest, test_in) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST(ColumnPredicateTest, test_in_many_values) {
+    // The integers of a small range.
+    {
+        std::vector<std::string> values;
+        for (int i = -10; i <= 100; i += 10) {
+            values.emplace_back(std::to_string(i));
+        }
+        std::unique_ptr<ColumnPredicate> p(new_column_in_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, values));
+        auto c = ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, true);
+        c->append_datum(Datum(-20));
+        c->append_datum(Datum(-10));
+        c->append_datum(Datum(55));
+        (void)c->append_nulls(1);
+        c->append_datum(Datum(100));
+        c->append_datum(Datum(110));
+
+        ASSERT_EQ(values.size(), p->values().size());
+        std::vector<uint8_t> buff(6);
+        p->evaluate(c.get(), buff.data(), 0, 6);
+        ASSERT_EQ("0,1,0,0,1,0", to_string(buff));
+    }
+    // The sparse integers.
+    {
+        std::unique_ptr<ColumnPredicate> p(new_column_in_predicate(get_type_info(OLAP_FIELD_TYPE_BIGINT), 0,
+                                                                   {"1", "1000000", "2000000", "3000000", "4000000"}));
+        auto c = ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_BIGINT, false);
+        c->append_datum(Datum(int64_t(1)));
+        c->append_datum(Datum(int64_t(2)));
+        c->append_datum(Datum(int64_t(3000000)));
+        c->append_datum(Datum(int64_t(5000000)));
+
+        ASSERT_EQ(5, p->values().size());
+        std::vector<uint8_t> buff(4);
+        p->evaluate(c.get(), buff.data(), 0, 4);
+        ASSERT_EQ("1,0,1,0", to_string(buff));
+
+        std::vector<uint16_t> sel{0, 1, 2, 3};
+        ASSERT_EQ(2, p->evaluate_branchless(c.get(), sel.data(), sel.size()));
+        ASSERT_EQ(0, sel[0]);
+        ASSERT_EQ(2, sel[1]);
+    }
+    // The strings.
+    {
+        std::vector<std::string> values;
+        for (int i = 0; i < 100; i++) {
+            values.emplace_back("value" + std::to_string(i));
+        }
+        std::unique_ptr<ColumnPredicate> p(new_column_in_predicate(get_type_info(OLAP_FIELD_TYPE_VARCHAR), 0, values));
+        auto c = ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_VARCHAR, true);
+        c->append_datum(Datum("value7"));
+        c->append_datum(Datum("value100"));
+        (void)c->append_nulls(1);
+        c->append_datum(Datum("value99"));
+        c->append_datum(Datum(""));
+
+        std::vector<uint8_t> buff(5);
+        p->evaluate(c.get(), buff.data(), 0, 5);
+        ASSERT_EQ("1,0,0,1,0", to_string(buff));
+    }
+}
+
 // NOLINTNEXTLINE
 TEST(ColumnPredicateTest, test_no_in) {
     {
@@ -1878,6 +1941,47 @@ TEST(ColumnPredicateTest, test_not_null) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST(ColumnPredicateTest, test_contains) {
+    std::unique_ptr<ColumnPredicate> p(
+            new_column_contains_predicate(get_type_info(OLAP_FIELD_TYPE_VARCHAR), 0, Slice("bcd")));
+    ASSERT_EQ(PredicateType::kContains, p->type());
+    ASSERT_TRUE(p->support_ngram_bloom_filter());
+
+    auto c = ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_VARCHAR, true);
+    c->append_datum(Datum(Slice("abcde")));
+    c->append_datum(Datum(Slice("bcd")));
+    c->append_datum(Datum(Slice("bc")));
+    (void)c->append_nulls(1);
+    c->append_datum(Datum(Slice("xxbcd")));
+
+    std::vector<uint8_t> buff(5);
+    p->evaluate(c.get(), buff.data(), 0, 5);
+    ASSERT_EQ("1,1,0,0,1", to_string(buff));
+
+    buff.assign(5, 1);
+    buff[1] = 0;
+    p->evaluate_and(c.get(), buff.data(), 0, 5);
+    ASSERT_EQ("1,0,0,0,1", to_string(buff));
+
+    buff.assign(5, 0);
+    buff[2] = 1;
+    p->evaluate_or(c.get(), buff.data(), 0, 5);
+    ASSERT_EQ("1,1,1,0,1", to_string(buff));
+
+    // The pages are pruned by the grams of the operand.
+    std::unique_ptr<segment_v2::BloomFilter> bf;
+    ASSERT_TRUE(segment_v2::BloomFilter::create(segment_v2::BLOCK_BLOOM_FILTER, &bf).ok());
+    ASSERT_TRUE(bf->init(64, 0.01, segment_v2::HASH_MURMUR3_X64_64).ok());
+    bf->add_bytes("ab", 2);
+    bf->add_bytes("bc", 2);
+    ASSERT_FALSE(p->ngram_bloom_filter(bf.get(), 2));
+    bf->add_bytes("cd", 2);
+    ASSERT_TRUE(p->ngram_bloom_filter(bf.get(), 2));
+    // The operand shorter than the grams can't be pruned.
+    ASSERT_TRUE(p->ngram_bloom_filter(bf.get(), 4));
+}
+
 // NOLINTNEXTLINE
 TEST(ColumnPredicateTest, test_or) {
     {
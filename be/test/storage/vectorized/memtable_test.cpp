@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <map>
 
 #include "gutil/strings/split.h"
 #include "runtime/descriptor_helper.h"
@@ -310,6 +311,62 @@ TEST_F(MemTableTest, testUniqKeysInsertFlushRead) {
     ASSERT_EQ(n, pkey_read);
 }
 
+TEST_F(MemTableTest, testUniqKeysCompositeKeysDeduplicate) {
+    const string path = "./ut_dir/MemTableTest_testUniqKeysCompositeKeysDeduplicate";
+    MySetUp("k1 int,k2 varchar,v int", "k1 int,k2 varchar,v int", 2, KeysType::UNIQUE_KEYS, path);
+    const size_t n = 3000;
+    shared_ptr<Chunk> chunk = ChunkHelper::new_chunk(*_slots, n);
+    // The value of the last row of each key.
+    std::map<std::pair<int32_t, std::string>, int32_t> expected;
+    for (int i = 0; i < n; i++) {
+        int32_t k1 = (i * 7919) % 50 - 25;
+        std::string k2 = StringPrintf("s%d", i % 3);
+        Datum v;
+        v.set_int32(k1);
+        chunk->get_column_by_index(0)->append_datum(v);
+        v.set_slice(k2);
+        chunk->get_column_by_index(1)->append_datum(v);
+        v.set_int32(i);
+        chunk->get_column_by_index(2)->append_datum(v);
+        expected[{k1, k2}] = i;
+    }
+    vector<uint32_t> indexes;
+    indexes.reserve(n);
+    for (int i = 0; i < n; i++) {
+        indexes.emplace_back(i);
+    }
+    _mem_table->insert(chunk.get(), indexes.data(), 0, indexes.size());
+    ASSERT_TRUE(_mem_table->finalize().ok());
+    ASSERT_EQ(OLAP_SUCCESS, _mem_table->flush());
+    RowsetSharedPtr rowset = _writer->build();
+    unique_ptr<Schema> read_schema = create_schema("k1 int,k2 varchar,v int", 2);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<vectorized::Chunk> read_chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    auto iter = expected.begin();
+    while (true) {
+        Status st = (*itr)->get_next(read_chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < read_chunk->num_rows(); i++) {
+            ASSERT_TRUE(iter != expected.end());
+            ASSERT_EQ(iter->first.first, read_chunk->get_column_by_index(0)->get(i).get_int32());
+            ASSERT_EQ(iter->first.second, read_chunk->get_column_by_index(1)->get(i).get_slice().to_string());
+            ASSERT_EQ(iter->second, read_chunk->get_column_by_index(2)->get(i).get_int32());
+            ++iter;
+        }
+        read_chunk->reset();
+    }
+    ASSERT_TRUE(iter == expected.end());
+}
+
 TEST_F(MemTableTest, testPrimaryKeysWithDeletes) {
     const string path = "./ut_dir/MemTableTest_testPrimaryKeysWithDeletes";
     MySetUp("pk bigint,v1 int", "pk bigint,v1 int,__op tinyint", 1, KeysType::PRIMARY_KEYS, path);
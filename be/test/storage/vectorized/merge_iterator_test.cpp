@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "column/column_pool.h"
@@ -138,4 +139,110 @@ TEST_F(MergeIteratorTest, test_issue_DSDB_2715) {
     iter->close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(MergeIteratorTest, merge_by_row_sources) {
+    std::vector<int32_t> v1{1, 1, 2, 3, 4, 5};
+    std::vector<int32_t> v2{2, 3, 3, 6, 7};
+    std::vector<int32_t> v3{0, 4, 8};
+    std::vector<uint16_t> row_sources;
+    auto iter = new_merge_iterator(
+            std::vector<ChunkIteratorPtr>{std::make_shared<VectorChunkIterator>(_schema, COL_INT(v1)),
+                                          std::make_shared<VectorChunkIterator>(_schema, COL_INT(v2)),
+                                          std::make_shared<VectorChunkIterator>(_schema, COL_INT(v3))},
+            &row_sources);
+    std::vector<int32_t> keys;
+    ChunkPtr chunk = ChunkHelper::new_chunk(iter->schema(), config::vector_chunk_size);
+    while (iter->get_next(chunk.get()).ok()) {
+        ColumnPtr& c = chunk->get_column_by_index(0);
+        for (size_t i = 0; i < c->size(); i++) {
+            keys.push_back(c->get(i).get_int32());
+        }
+        chunk->reset();
+    }
+    ASSERT_EQ(v1.size() + v2.size() + v3.size(), keys.size());
+    ASSERT_EQ(keys.size(), row_sources.size());
+    ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+    // The values are the keys plus 100 times the source, so the replayed values must match the merged keys.
+    auto f = std::make_shared<Field>(1, "v1", get_type_info(OLAP_FIELD_TYPE_INT), false);
+    Schema value_schema(std::vector<FieldPtr>{f});
+    std::vector<ChunkIteratorPtr> children;
+    for (int i = 0; i < 3; i++) {
+        std::vector<int32_t> values = (i == 0) ? v1 : (i == 1 ? v2 : v3);
+        for (auto& v : values) {
+            v += 100 * i;
+        }
+        children.emplace_back(std::make_shared<VectorChunkIterator>(value_schema, COL_INT(values)));
+    }
+    auto replay_iter = new_row_source_merge_iterator(children, &row_sources);
+    std::vector<int32_t> values;
+    chunk = ChunkHelper::new_chunk(replay_iter->schema(), config::vector_chunk_size);
+    while (replay_iter->get_next(chunk.get()).ok()) {
+        ColumnPtr& c = chunk->get_column_by_index(0);
+        for (size_t i = 0; i < c->size(); i++) {
+            values.push_back(c->get(i).get_int32());
+        }
+        chunk->reset();
+    }
+    ASSERT_EQ(keys.size(), values.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        EXPECT_EQ(keys[i] + 100 * row_sources[i], values[i]);
+    }
+    replay_iter->close();
+    iter->close();
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeIteratorTest, merge_composite_keys) {
+    auto k1 = std::make_shared<Field>(0, "k1", get_type_info(OLAP_FIELD_TYPE_INT), false);
+    auto k2 = std::make_shared<Field>(1, "k2", get_type_info(OLAP_FIELD_TYPE_BIGINT), false);
+    k1->set_is_key(true);
+    k2->set_is_key(true);
+    Schema schema(std::vector<FieldPtr>{k1, k2});
+
+    // 7 children of the sorted random keys, including the negative ones.
+    std::mt19937 rng(0);
+    std::vector<std::pair<int32_t, int64_t>> expected;
+    std::vector<std::shared_ptr<VectorChunkIterator>> children;
+    for (int i = 0; i < 7; i++) {
+        std::vector<std::pair<int32_t, int64_t>> keys;
+        for (int j = 0; j < 100 + i * 37; j++) {
+            keys.emplace_back(static_cast<int32_t>(rng() % 20) - 10, static_cast<int64_t>(rng() % 1000) - 500);
+        }
+        std::sort(keys.begin(), keys.end());
+        expected.insert(expected.end(), keys.begin(), keys.end());
+        std::vector<int32_t> c1;
+        std::vector<int64_t> c2;
+        for (auto& [a, b] : keys) {
+            c1.push_back(a);
+            c2.push_back(b);
+        }
+        auto child = std::make_shared<VectorChunkIterator>(schema, COL_INT(c1), COL_BIGINT(c2));
+        child->chunk_size(16 + i);
+        children.emplace_back(std::move(child));
+    }
+    std::sort(expected.begin(), expected.end());
+
+    for (bool normalized : {true, false}) {
+        config::enable_normalized_key_merge = normalized;
+        std::vector<ChunkIteratorPtr> inputs;
+        for (auto& child : children) {
+            child->next_row(0);
+            inputs.emplace_back(child);
+        }
+        auto iter = new_merge_iterator(inputs);
+        std::vector<std::pair<int32_t, int64_t>> real;
+        ChunkPtr chunk = ChunkHelper::new_chunk(iter->schema(), config::vector_chunk_size);
+        while (iter->get_next(chunk.get()).ok()) {
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                real.emplace_back(chunk->get_column_by_index(0)->get(i).get_int32(),
+                                  chunk->get_column_by_index(1)->get(i).get_int64());
+            }
+            chunk->reset();
+        }
+        ASSERT_EQ(expected, real);
+    }
+    config::enable_normalized_key_merge = true;
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,41 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/zorder.h"
+
+#include "column/fixed_length_column.h"
+#include "gtest/gtest.h"
+
+namespace starrocks::vectorized {
+
+TEST(ZOrderTest, test_two_columns) {
+    // The rows of the 4x4 grid sorted by (x, y), where x is 10, 20, 30 or 40.
+    auto x = Int32Column::create();
+    auto y = Int32Column::create();
+    for (int32_t i = 0; i < 4; i++) {
+        for (int32_t j = 0; j < 4; j++) {
+            x->append(10 * (i + 1));
+            y->append(j);
+        }
+    }
+    std::vector<uint32_t> order;
+    zorder_permutation({x.get(), y.get()}, x->size(), &order);
+    std::vector<uint32_t> expected{0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15};
+    ASSERT_EQ(expected, order);
+}
+
+TEST(ZOrderTest, test_one_column) {
+    auto x = Int32Column::create();
+    for (int32_t v : {3, 1, 2, 1, 0}) {
+        x->append(v);
+    }
+    std::vector<uint32_t> order;
+    zorder_permutation({x.get()}, x->size(), &order);
+    std::vector<uint32_t> expected{4, 1, 3, 2, 0};
+    ASSERT_EQ(expected, order);
+
+    zorder_permutation({}, x->size(), &order);
+    expected = {0, 1, 2, 3, 4};
+    ASSERT_EQ(expected, order);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,45 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/adaptive_compression_strategy.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(AdaptiveCompressionStrategyTest, test_should_compress) {
+    AdaptiveCompressionStrategy strategy(4);
+    // compress until the costs are measured
+    ASSERT_TRUE(strategy.should_compress(1));
+    strategy.update_compression(1000, 500, 1000);
+    ASSERT_TRUE(strategy.should_compress(1));
+
+    // a slow link, 10ns per byte: the 500 bytes saved take 5000ns, more than the 1000ns to compress
+    strategy.update_transmission(1000, 10000);
+    ASSERT_TRUE(strategy.should_compress(1));
+
+    // a fast link, 1ns per byte
+    AdaptiveCompressionStrategy fast(4);
+    fast.update_compression(1000, 500, 1000);
+    fast.update_transmission(1000, 1000);
+    ASSERT_FALSE(fast.should_compress(1));
+    ASSERT_FALSE(fast.should_compress(1));
+    ASSERT_FALSE(fast.should_compress(1));
+    // a probe
+    ASSERT_TRUE(fast.should_compress(1));
+    ASSERT_FALSE(fast.should_compress(1));
+    // the bytes saved are transmitted to each one of the receivers
+    ASSERT_TRUE(fast.should_compress(4));
+}
+
+// NOLINTNEXTLINE
+TEST(AdaptiveCompressionStrategyTest, test_incompressible) {
+    AdaptiveCompressionStrategy strategy(1000);
+    strategy.update_transmission(1000, 100000);
+    for (int i = 0; i < 100; i++) {
+        strategy.update_compression(1000, 1004, 100);
+    }
+    ASSERT_FALSE(strategy.should_compress(10));
+}
+
+} // namespace starrocks
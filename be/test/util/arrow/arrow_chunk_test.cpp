@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/arrow/chunk.h"
+
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/const_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "runtime/date_value.h"
+#include "runtime/timestamp_value.h"
+
+namespace starrocks {
+
+using namespace vectorized;
+
+// NOLINTNEXTLINE
+TEST(ArrowChunkTest, test_convert) {
+    auto ints = Int32Column::create();
+    auto strings = BinaryColumn::create();
+    auto nulls = NullColumn::create();
+    auto dates = DateColumn::create();
+    auto datetimes = TimestampColumn::create();
+    auto decimals = DecimalColumn::create();
+    for (int i = 0; i < 4; i++) {
+        ints->append(i);
+        strings->append(Slice("v" + std::to_string(i)));
+        nulls->append(i % 2);
+        dates->append(DateValue::create(2021, 1, i + 1));
+        datetimes->append(TimestampValue::create(2021, 1, 1, 0, 0, i));
+        decimals->append(DecimalV2Value(i, 500000000));
+    }
+    Columns columns{ints,
+                    NullableColumn::create(strings, nulls),
+                    dates,
+                    datetimes,
+                    decimals,
+                    ConstColumn::create(Int64Column::create(1, 7), 4)};
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_INT),      TypeDescriptor::create_varchar_type(10),
+                                      TypeDescriptor(TYPE_DATE),     TypeDescriptor(TYPE_DATETIME),
+                                      TypeDescriptor(TYPE_DECIMALV2), TypeDescriptor(TYPE_BIGINT)};
+    std::vector<std::string> names{"c0", "c1", "c2", "c3", "c4", "c5"};
+
+    std::shared_ptr<arrow::Schema> schema;
+    ASSERT_TRUE(convert_to_arrow_schema(types, names, &schema).ok());
+    ASSERT_EQ(6, schema->num_fields());
+    ASSERT_EQ("c1", schema->field(1)->name());
+    std::shared_ptr<arrow::RecordBatch> batch;
+    ASSERT_TRUE(convert_to_arrow_batch(columns, types, schema, arrow::default_memory_pool(), &batch).ok());
+    ASSERT_EQ(4, batch->num_rows());
+
+    auto ints_array = std::static_pointer_cast<arrow::Int32Array>(batch->column(0));
+    auto strings_array = std::static_pointer_cast<arrow::StringArray>(batch->column(1));
+    auto dates_array = std::static_pointer_cast<arrow::StringArray>(batch->column(2));
+    auto datetimes_array = std::static_pointer_cast<arrow::StringArray>(batch->column(3));
+    auto decimals_array = std::static_pointer_cast<arrow::Decimal128Array>(batch->column(4));
+    auto consts_array = std::static_pointer_cast<arrow::Int64Array>(batch->column(5));
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(i, ints_array->Value(i));
+        if (i % 2) {
+            ASSERT_TRUE(strings_array->IsNull(i));
+        } else {
+            ASSERT_EQ("v" + std::to_string(i), strings_array->GetString(i));
+        }
+        ASSERT_EQ("2021-01-0" + std::to_string(i + 1), dates_array->GetString(i));
+        ASSERT_EQ("2021-01-01 00:00:0" + std::to_string(i), datetimes_array->GetString(i));
+        ASSERT_EQ(std::to_string(i) + ".500000000", decimals_array->FormatValue(i));
+        ASSERT_EQ(7, consts_array->Value(i));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ArrowChunkTest, test_unsupported_type) {
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_BOOLEAN)};
+    std::shared_ptr<arrow::Schema> schema;
+    ASSERT_FALSE(convert_to_arrow_schema(types, {"c0"}, &schema).ok());
+}
+
+} // namespace starrocks
@@ -66,6 +66,32 @@ TEST(BitmapValueTest, bitmap_union) {
     ASSERT_EQ(5, bitmap2.cardinality());
 }
 
+TEST(BitmapValueTest, bitmap_fast_union) {
+    BitmapValue empty;
+    BitmapValue single(1024);
+    BitmapValue bitmap({1024, 1025, 1026});
+    // The values of different high bytes.
+    BitmapValue bitmap2({1026, 4096, (1ull << 32) + 1});
+
+    BitmapValue singles;
+    singles.fast_union({&empty, &single, &single});
+    ASSERT_EQ(BitmapValue::SINGLE, singles._type);
+    ASSERT_EQ(1, singles.cardinality());
+
+    BitmapValue value(1);
+    value.fast_union({&empty, &single, &bitmap, &bitmap2});
+    ASSERT_EQ(BitmapValue::BITMAP, value._type);
+    ASSERT_EQ(6, value.cardinality());
+    ASSERT_TRUE(value.contains(1));
+    ASSERT_TRUE(value.contains((1ull << 32) + 1));
+
+    value.fast_union({&bitmap2});
+    ASSERT_EQ(6, value.cardinality());
+    // The inputs are not modified.
+    ASSERT_EQ(3, bitmap.cardinality());
+    ASSERT_EQ(3, bitmap2.cardinality());
+}
+
 TEST(BitmapValueTest, bitmap_intersect) {
     BitmapValue empty;
     BitmapValue single(1024);
@@ -165,4 +165,49 @@ TEST_F(BlockCompressionTest, multi) {
     test_multi_slices(starrocks::CompressionTypePB::ZSTD);
 }
 
+TEST_F(BlockCompressionTest, zstd_dict) {
+    // the samples of a few templates of log lines
+    std::vector<std::string> lines;
+    for (int i = 0; i < 2000; ++i) {
+        lines.emplace_back("2021-09-01 12:00:" + std::to_string(i % 60) + " INFO [worker-" + std::to_string(i % 7) +
+                           "] request " + generate_str(8) + " finished in " + std::to_string(i % 100) + " ms");
+    }
+    std::vector<Slice> samples;
+    for (auto& line : lines) {
+        samples.emplace_back(line);
+    }
+    std::string dict;
+    ASSERT_TRUE(train_zstd_dictionary(samples, 4096, &dict).ok());
+    ASSERT_FALSE(dict.empty());
+    ASSERT_LE(dict.size(), 4096);
+
+    std::unique_ptr<BlockCompressionCodec> codec;
+    ASSERT_TRUE(create_zstd_dict_compression_codec(dict, &codec).ok());
+    const BlockCompressionCodec* zstd = nullptr;
+    ASSERT_TRUE(get_block_compression_codec(starrocks::CompressionTypePB::ZSTD, &zstd).ok());
+
+    std::string orig = lines[1] + lines[2] + lines[3];
+    std::string compressed(codec->max_compressed_len(orig.size()), '\0');
+    Slice compressed_slice(compressed);
+    ASSERT_TRUE(codec->compress(orig, &compressed_slice).ok());
+
+    std::string plain(zstd->max_compressed_len(orig.size()), '\0');
+    Slice plain_slice(plain);
+    ASSERT_TRUE(zstd->compress(orig, &plain_slice).ok());
+    ASSERT_LT(compressed_slice.size, plain_slice.size);
+
+    std::string uncompressed(orig.size(), '\0');
+    Slice uncompressed_slice(uncompressed);
+    ASSERT_TRUE(codec->decompress(compressed_slice, &uncompressed_slice).ok());
+    ASSERT_EQ(orig, uncompressed);
+
+    // the blocks compressed by the dictionary can't be decompressed without it
+    uncompressed_slice = Slice(uncompressed);
+    ASSERT_FALSE(zstd->decompress(compressed_slice, &uncompressed_slice).ok());
+
+    // too few samples
+    std::string no_dict;
+    ASSERT_FALSE(train_zstd_dictionary({Slice(lines[0])}, 4096, &no_dict).ok());
+}
+
 } // namespace starrocks
@@ -0,0 +1,62 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/cpu_sampler.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/current_thread.h"
+#include "util/monotime.h"
+
+namespace starrocks {
+
+static volatile uint64_t s_sink = 0;
+
+static void burn_cpu(int64_t ms) {
+    MonoTime deadline = MonoTime::Now() + MonoDelta::FromMilliseconds(ms);
+    uint64_t x = 1;
+    while (MonoTime::Now() < deadline) {
+        for (int i = 0; i < 10000; i++) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+    }
+    s_sink = x;
+}
+
+TEST(CpuSamplerTest, test_query_samples) {
+    CpuSampler* sampler = CpuSampler::instance();
+    ASSERT_FALSE(sampler->start(0, 1024).ok());
+    ASSERT_TRUE(sampler->start(1000, 1024).ok());
+    ASSERT_TRUE(sampler->running());
+
+    TUniqueId query_id;
+    query_id.__set_hi(100);
+    query_id.__set_lo(200);
+    CurrentThread::set_query_id(query_id);
+    burn_cpu(300);
+    CurrentThread::set_query_id(TUniqueId());
+    sampler->stop();
+    ASSERT_FALSE(sampler->running());
+
+    auto samples = sampler->query_samples(60);
+    ASSERT_GT(samples[UniqueId(100, 200)], 0);
+
+    UniqueId id(100, 200);
+    std::string stacks;
+    sampler->folded_stacks(60, &id, [](void* pc) { return std::string("f"); }, &stacks);
+    ASSERT_FALSE(stacks.empty());
+    // "f;f;...;f count" per line
+    size_t end = stacks.find('\n');
+    ASSERT_NE(std::string::npos, end);
+    std::string line = stacks.substr(0, end);
+    size_t space = line.rfind(' ');
+    ASSERT_NE(std::string::npos, space);
+    ASSERT_EQ('f', line[0]);
+    ASSERT_GT(std::stoll(line.substr(space + 1)), 0);
+
+    UniqueId other(300, 400);
+    std::string other_stacks;
+    sampler->folded_stacks(60, &other, [](void* pc) { return std::string("f"); }, &other_stacks);
+    ASSERT_TRUE(other_stacks.empty());
+}
+
+} // namespace starrocks
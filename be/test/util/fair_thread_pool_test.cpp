@@ -0,0 +1,81 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/fair_thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(FairThreadPoolTest, test_round_robin) {
+    FairThreadPool pool(1, 100);
+    // block the only thread until all the tasks are queued
+    std::promise<void> started;
+    std::promise<void> blocker;
+    std::shared_future<void> blocked = blocker.get_future().share();
+    ASSERT_TRUE(pool.offer(0, 1, [&started, blocked] {
+        started.set_value();
+        blocked.wait();
+    }));
+    started.get_future().wait();
+
+    std::mutex mutex;
+    std::vector<int64_t> order;
+    std::promise<void> done;
+    auto record = [&](int64_t group) {
+        return [&, group] {
+            std::lock_guard<std::mutex> l(mutex);
+            order.push_back(group);
+            if (order.size() == 8) {
+                done.set_value();
+            }
+        };
+    };
+    // the big query with weight 2 queues 6 tasks before the small one with weight 1 queues 2 tasks
+    for (int i = 0; i < 6; i++) {
+        ASSERT_TRUE(pool.offer(1, 2, record(1)));
+    }
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(pool.offer(2, 1, record(2)));
+    }
+    ASSERT_EQ(8, pool.get_queue_size());
+    ASSERT_EQ(2, pool.num_groups());
+
+    blocker.set_value();
+    done.get_future().wait();
+
+    std::vector<int64_t> expected{1, 1, 2, 1, 1, 2, 1, 1};
+    ASSERT_EQ(expected, order);
+    ASSERT_EQ(0, pool.get_queue_size());
+    ASSERT_EQ(0, pool.num_groups());
+}
+
+// NOLINTNEXTLINE
+TEST(FairThreadPoolTest, test_queue_full) {
+    FairThreadPool pool(1, 1);
+    std::promise<void> started;
+    std::promise<void> blocker;
+    std::shared_future<void> blocked = blocker.get_future().share();
+    ASSERT_TRUE(pool.offer(0, 1, [&started, blocked] {
+        started.set_value();
+        blocked.wait();
+    }));
+    started.get_future().wait();
+
+    std::atomic<int> num_done{0};
+    ASSERT_TRUE(pool.try_offer(1, 1, [&num_done] { num_done++; }));
+    ASSERT_FALSE(pool.try_offer(1, 1, [&num_done] { num_done++; }));
+    blocker.set_value();
+    // blocks until the task queued is taken
+    ASSERT_TRUE(pool.offer(1, 1, [&num_done] { num_done++; }));
+    pool.shutdown();
+    pool.join();
+    ASSERT_FALSE(pool.offer(1, 1, [&num_done] { num_done++; }));
+    ASSERT_LE(num_done.load(), 2);
+}
+
+} // namespace starrocks
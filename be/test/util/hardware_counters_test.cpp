@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/hardware_counters.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(HardwareCountersTest, test_values) {
+    HardwareCounterValues start;
+    start.cycles = 100;
+    start.instructions = 200;
+    HardwareCounterValues end;
+    end.cycles = 150;
+    end.instructions = 300;
+    end.llc_misses = 3;
+    end.branch_misses = 4;
+    HardwareCounterValues sum;
+    sum += end - start;
+    sum += end - start;
+    ASSERT_EQ(100, sum.cycles);
+    ASSERT_EQ(200, sum.instructions);
+    ASSERT_EQ(6, sum.llc_misses);
+    ASSERT_EQ(8, sum.branch_misses);
+}
+
+// NOLINTNEXTLINE
+TEST(HardwareCountersTest, test_read) {
+    auto* counters = ThreadHardwareCounters::current();
+    if (counters == nullptr) {
+        // e.g. perf_event_paranoid denies the perf events in the container
+        return;
+    }
+    ASSERT_EQ(counters, ThreadHardwareCounters::current());
+    HardwareCounterValues start;
+    ASSERT_TRUE(counters->read(&start));
+    std::vector<int64_t> values(1024 * 1024);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = i * i;
+    }
+    HardwareCounterValues end;
+    ASSERT_TRUE(counters->read(&end));
+    auto delta = end - start;
+    ASSERT_GT(delta.cycles, 0);
+    ASSERT_GT(delta.instructions, values.size());
+    ASSERT_EQ((values.size() - 1) * (values.size() - 1), values.back());
+}
+
+} // namespace starrocks
@@ -0,0 +1,85 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/json_binary.h"
+
+#include <gtest/gtest.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace starrocks {
+
+static std::string to_binary(const std::string& json) {
+    rapidjson::Document document;
+    document.Parse(json.data(), json.size());
+    EXPECT_FALSE(document.HasParseError());
+    std::string binary;
+    JsonBinaryValue::encode(document, &binary);
+    return binary;
+}
+
+static std::string to_text(const JsonBinaryValue& value) {
+    rapidjson::Document document;
+    EXPECT_TRUE(value.to_rapidjson(&document, document.GetAllocator()));
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+    document.Accept(writer);
+    return std::string(buf.GetString(), buf.GetSize());
+}
+
+TEST(JsonBinaryTest, test_round_trip) {
+    std::string json = R"({"z":1,"a":[true,false,null,-3,18446744073709551615,1.5,"s"],"m":{"k":"v"},"e":{}})";
+    std::string binary = to_binary(json);
+    ASSERT_TRUE(JsonBinaryValue::is_binary(binary));
+    ASSERT_FALSE(JsonBinaryValue::is_binary(json));
+
+    JsonBinaryValue root;
+    ASSERT_TRUE(JsonBinaryValue::from_binary(binary, &root));
+    ASSERT_EQ(JsonBinaryValue::OBJECT, root.type());
+    ASSERT_EQ(4, root.num_elements());
+    // The members are in the order of the text.
+    ASSERT_EQ(json, to_text(root));
+}
+
+TEST(JsonBinaryTest, test_find_member) {
+    std::string binary = to_binary(R"({"k3":3,"k1":{"x":[10,20,30]},"k2":"v2","k1":"dup"})");
+    JsonBinaryValue root;
+    ASSERT_TRUE(JsonBinaryValue::from_binary(binary, &root));
+
+    JsonBinaryValue value;
+    ASSERT_TRUE(root.find_member("k3", &value));
+    ASSERT_EQ("3", to_text(value));
+    ASSERT_TRUE(root.find_member("k2", &value));
+    ASSERT_EQ(JsonBinaryValue::STRING, value.type());
+    ASSERT_EQ("\"v2\"", to_text(value));
+    ASSERT_FALSE(root.find_member("k0", &value));
+    ASSERT_FALSE(root.find_member("k4", &value));
+
+    // The first one of the duplicate keys.
+    ASSERT_TRUE(root.find_member("k1", &value));
+    ASSERT_EQ(JsonBinaryValue::OBJECT, value.type());
+    JsonBinaryValue array;
+    ASSERT_TRUE(value.find_member("x", &array));
+    ASSERT_EQ(3, array.num_elements());
+    JsonBinaryValue element;
+    ASSERT_TRUE(array.element_at(2, &element));
+    ASSERT_EQ("30", to_text(element));
+    ASSERT_FALSE(array.element_at(3, &element));
+    ASSERT_FALSE(array.find_member("x", &element));
+}
+
+TEST(JsonBinaryTest, test_malformed) {
+    std::string binary = to_binary(R"({"k1":[1,2,3],"k2":"v2"})");
+    JsonBinaryValue root;
+    ASSERT_FALSE(JsonBinaryValue::from_binary(Slice(binary.data(), binary.size() - 1), &root));
+    ASSERT_FALSE(JsonBinaryValue::from_binary(Slice(binary.data(), 1), &root));
+
+    std::string bad_version = binary;
+    bad_version[1] = JsonBinaryValue::kVersion + 1;
+    ASSERT_FALSE(JsonBinaryValue::from_binary(bad_version, &root));
+
+    std::string bad_type = binary;
+    bad_type[2] = 100;
+    ASSERT_FALSE(JsonBinaryValue::from_binary(bad_type, &root));
+}
+
+} // namespace starrocks
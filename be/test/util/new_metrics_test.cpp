@@ -185,6 +185,67 @@ TEST_F(MetricsTest, Gauge) {
     }
 }
 
+TEST_F(MetricsTest, Histogram) {
+    {
+        HistogramMetric histogram(MetricUnit::MICROSECONDS);
+        ASSERT_EQ(0, histogram.count());
+        ASSERT_EQ(0, histogram.percentile(0.99));
+        ASSERT_STREQ("count=0 sum=0 max=0 p50=0 p90=0 p99=0 p999=0", histogram.to_string().c_str());
+    }
+    {
+        HistogramMetric histogram(MetricUnit::MICROSECONDS);
+        for (int i = 1; i <= 100; ++i) {
+            histogram.add(i);
+        }
+        ASSERT_EQ(100, histogram.count());
+        ASSERT_EQ(5050, histogram.sum());
+        ASSERT_EQ(100, histogram.max());
+        // 50 is in the bucket [48, 55], 90 is in [80, 95]
+        ASSERT_EQ(55, histogram.percentile(0.5));
+        ASSERT_EQ(95, histogram.percentile(0.9));
+        // bounded by the max value
+        ASSERT_EQ(100, histogram.percentile(0.99));
+        ASSERT_EQ(1, histogram.percentile(0));
+    }
+    {
+        // the tail is not hidden by the average
+        HistogramMetric histogram(MetricUnit::MICROSECONDS);
+        for (int i = 0; i < 999; ++i) {
+            histogram.add(10);
+        }
+        histogram.add(1000000);
+        ASSERT_EQ(11, histogram.percentile(0.99));
+        ASSERT_EQ(1000000, histogram.percentile(0.9999));
+    }
+    // the buckets cover all the values
+    for (int i = 0; i < HistogramMetric::kNumBuckets; ++i) {
+        uint64_t upper = HistogramMetric::bucket_upper_bound(i);
+        ASSERT_EQ(i, HistogramMetric::bucket_index(upper));
+        if (i + 1 < HistogramMetric::kNumBuckets) {
+            ASSERT_EQ(i + 1, HistogramMetric::bucket_index(upper + 1));
+        }
+    }
+    ASSERT_EQ(HistogramMetric::kNumBuckets - 1, HistogramMetric::bucket_index(UINT64_MAX));
+}
+
+TEST_F(MetricsTest, HistogramMultiThread) {
+    HistogramMetric histogram(MetricUnit::MICROSECONDS);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&histogram] {
+            for (int j = 0; j < 100000; ++j) {
+                histogram.add(j % 100);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    ASSERT_EQ(800000, histogram.count());
+    ASSERT_EQ(8 * 1000 * 4950, histogram.sum());
+    ASSERT_EQ(99, histogram.max());
+}
+
 TEST_F(MetricsTest, MetricLabel) {
     std::string put("put");
     MetricLabel label("type", put);
@@ -0,0 +1,89 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/query_trace.h"
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include <thread>
+
+namespace starrocks {
+
+class QueryTraceTest : public testing::Test {
+public:
+    void SetUp() override { config::enable_query_trace = true; }
+    void TearDown() override { config::enable_query_trace = false; }
+};
+
+// NOLINTNEXTLINE
+TEST_F(QueryTraceTest, test_chrome_trace) {
+    TUniqueId query_id;
+    query_id.hi = 1001;
+    query_id.lo = 1;
+    TUniqueId other_query_id;
+    other_query_id.hi = 1002;
+    other_query_id.lo = 1;
+    { SCOPED_QUERY_TRACE(query_id, "fragment", "prepare"); }
+    std::thread t([&] {
+        SCOPED_QUERY_TRACE(query_id, "pipeline", "driver", 3);
+        SCOPED_QUERY_TRACE(other_query_id, "pipeline", "driver", 4);
+    });
+    t.join();
+
+    rapidjson::Document doc;
+    doc.Parse(QueryTrace::instance()->to_chrome_trace(query_id).c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    const auto& events = doc["traceEvents"];
+    ASSERT_EQ(2, events.Size());
+    int num_drivers = 0;
+    for (const auto& event : events.GetArray()) {
+        ASSERT_STREQ("X", event["ph"].GetString());
+        ASSERT_GE(event["dur"].GetDouble(), 0);
+        if (std::string(event["name"].GetString()) == "driver") {
+            ASSERT_STREQ("pipeline", event["cat"].GetString());
+            ASSERT_EQ(3, event["args"]["id"].GetInt64());
+            num_drivers++;
+        } else {
+            ASSERT_STREQ("prepare", event["name"].GetString());
+            ASSERT_FALSE(event.HasMember("args"));
+        }
+    }
+    ASSERT_EQ(1, num_drivers);
+}
+
+// NOLINTNEXTLINE
+TEST_F(QueryTraceTest, test_ring_buffer) {
+    TUniqueId query_id;
+    query_id.hi = 2001;
+    query_id.lo = 1;
+    std::thread t([&] {
+        for (int i = 0; i < config::query_trace_buffer_size + 10; ++i) {
+            QueryTrace::instance()->add(query_id.hi, "scan", "olap_scanner", i + 1, 1, i);
+        }
+    });
+    t.join();
+
+    rapidjson::Document doc;
+    doc.Parse(QueryTrace::instance()->to_chrome_trace(query_id).c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    // the oldest spans are overwritten
+    const auto& events = doc["traceEvents"];
+    ASSERT_EQ(config::query_trace_buffer_size, events.Size());
+    for (const auto& event : events.GetArray()) {
+        ASSERT_GE(event["args"]["id"].GetInt64(), 10);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(QueryTraceTest, test_disabled) {
+    config::enable_query_trace = false;
+    TUniqueId query_id;
+    query_id.hi = 3001;
+    query_id.lo = 1;
+    { SCOPED_QUERY_TRACE(query_id, "fragment", "prepare"); }
+    rapidjson::Document doc;
+    doc.Parse(QueryTrace::instance()->to_chrome_trace(query_id).c_str());
+    ASSERT_EQ(0, doc["traceEvents"].Size());
+}
+
+} // namespace starrocks
@@ -205,6 +205,20 @@ TEST(StringToInt, Basic) {
     test_int_value<int64_t>("-0", 0, StringParser::PARSE_SUCCESS);
 }
 
+TEST(StringToInt, EightDigitsAtATime) {
+    test_int_value<int32_t>("123456789", 123456789, StringParser::PARSE_SUCCESS);
+    test_int_value<int32_t>("-00000001", -1, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("123456789012345678", 123456789012345678, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("-98765432109876543", -98765432109876543, StringParser::PARSE_SUCCESS);
+    __int128 large_value = static_cast<__int128>(1234567890123456789) * 10000000000 + 123456789;
+    test_int_value<__int128>("12345678901234567890123456789", large_value, StringParser::PARSE_SUCCESS);
+
+    // A non-digit in the first or the second 8 chars.
+    test_int_value<int64_t>("1234:678901234", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("12345678/01234", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("123456789012 4", 0, StringParser::PARSE_FAILURE);
+}
+
 TEST(StringToInt, InvalidLeadingTrailing) {
     // Test that trailing garbage is not allowed.
     test_int_value<int8_t>("123xyz   ", 0, StringParser::PARSE_FAILURE);
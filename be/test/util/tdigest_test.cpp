@@ -239,4 +239,41 @@ TEST_F(TDigestTest, Montonicity) {
     }
 }
 
+TEST_F(TDigestTest, BatchAdd) {
+    TDigest digest(1000);
+    TDigest batch_digest(1000);
+    std::vector<Value> values;
+    std::uniform_real_distribution<> reals(0.0, 1.0);
+    std::random_device gen;
+    for (int i = 0; i < 100000; i++) {
+        values.emplace_back(reals(gen));
+        digest.add(values.back());
+    }
+    values.emplace_back(NAN);
+    batch_digest.add(values.data(), values.size());
+
+    EXPECT_EQ(digest.totalWeight(), batch_digest.totalWeight());
+    for (double q : {0.01, 0.5, 0.99}) {
+        EXPECT_NEAR(digest.quantile(q), batch_digest.quantile(q), 0.01) << "q = " << q;
+    }
+}
+
+TEST_F(TDigestTest, SerializeWithoutCumulative) {
+    TDigest digest(1000);
+    std::uniform_real_distribution<> reals(0.0, 1.0);
+    std::random_device gen;
+    for (int i = 0; i < 100000; i++) {
+        digest.add(reals(gen));
+    }
+    digest.compress();
+
+    std::vector<uint8_t> buf(digest.serialize_size());
+    ASSERT_EQ(buf.size(), digest.serialize(buf.data()));
+    TDigest digest2(reinterpret_cast<const char*>(buf.data()));
+    ASSERT_FALSE(digest2.haveUnprocessed());
+    for (double q : {0.01, 0.5, 0.99}) {
+        EXPECT_FLOAT_EQ(digest.quantile(q), digest2.quantile(q)) << "q = " << q;
+    }
+}
+
 } // namespace starrocks
@@ -60,6 +60,8 @@ Usage: $0 <options>
      --without-lzo      disable LZO compress  support
      --with-hdfs        enable hdfs support
      --without-hdfs     disable hdfs support
+     --with-benchmark   build the micro benchmarks of Backend
+     --without-benchmark  disable the micro benchmarks(default)
 
   Eg.
     $0                                      build all
@@ -89,6 +91,8 @@ OPTS=$(getopt \
   -l 'without-lzo' \
   -l 'with-hdfs' \
   -l 'without-hdfs' \
+  -l 'with-benchmark' \
+  -l 'without-benchmark' \
   -l 'help' \
   -- "$@")
 
@@ -107,7 +111,7 @@ WITH_MYSQL=ON
 WITH_LZO=ON
 WITH_GCOV=OFF
 WITH_HDFS=ON
-WITH_BENCHMARK=ON
+WITH_BENCHMARK=OFF
 
 HELP=0
 if [ $# == 1 ] ; then
@@ -138,6 +142,8 @@ else
             --without-lzo) WITH_LZO=OFF; shift ;;
             --with-hdfs) WITH_HDFS=ON; shift ;;
             --without-hdfs) WITH_HDFS=OFF; shift ;;
+            --with-benchmark) WITH_BENCHMARK=ON; shift ;;
+            --without-benchmark) WITH_BENCHMARK=OFF; shift ;;
             -h) HELP=1; shift ;;
             --help) HELP=1; shift ;;
             --) shift ;  break ;;
@@ -844,6 +844,8 @@ visible_functions = [
     [['array_length'], 'INT', ['ANY_ARRAY'], ''],
     [['array_append'], 'ANY_ARRAY', ['ANY_ARRAY', 'ANY_ELEMENT'], ''],
     [['array_contains'], 'BOOLEAN', ['ANY_ARRAY', 'ANY_ELEMENT'], ''],
+    [['array_distinct'], 'ANY_ARRAY', ['ANY_ARRAY'], ''],
+    [['array_sort'], 'ANY_ARRAY', ['ANY_ARRAY'], ''],
 ]
 
 # Except the following functions, other function will directly return
@@ -463,6 +463,7 @@ vectorized_functions = [
      "JsonFunctions::json_path_prepare", "JsonFunctions::json_path_close"],
     [110002, "get_json_string", "VARCHAR", ["VARCHAR", "VARCHAR"], "JsonFunctions::get_json_string",
      "JsonFunctions::json_path_prepare", "JsonFunctions::json_path_close"],
+    [110003, "json_binary", "VARCHAR", ["VARCHAR"], "JsonFunctions::json_binary"],
 
     # aes and base64 function
     [120100, "aes_encrypt", "VARCHAR", ["VARCHAR", "VARCHAR"], "EncryptionFunctions::aes_encrypt"],
@@ -564,4 +565,7 @@ vectorized_functions = [
     #[150012, 'array_max', 'DECIMAL64', ['ARRAY_DECIMAL32'], 'ArrayFunctions::array_max'],
     #[150013, 'array_max', 'DECIMAL64', ['ARRAY_DECIMAL64'], 'ArrayFunctions::array_max'],
     #[150014, 'array_max', 'DECIMAL128', ['ARRAY_DECIMAL128'], 'ArrayFunctions::array_max'],
+
+    [150080, 'array_distinct', 'ANY_ARRAY', ['ANY_ARRAY'], 'ArrayFunctions::array_distinct'],
+    [150081, 'array_sort', 'ANY_ARRAY', ['ANY_ARRAY'], 'ArrayFunctions::array_sort'],
 ]
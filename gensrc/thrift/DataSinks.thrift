@@ -98,6 +98,8 @@ struct TExportSink {
 
     // export file name prefix
     30: optional string file_name_prefix
+    // the format of the exported files, csv if not set
+    31: optional PlanNodes.TFileFormatType file_format
 }
 
 struct TOlapTableSink {
@@ -130,6 +130,8 @@ struct TColumn {
     6: optional string default_value               
     7: optional bool is_bloom_filter_column     
     8: optional Exprs.TExpr define_expr                                                               
+    // Whether the rows of a DUP_KEYS table are clustered by the column in the compactions.
+    9: optional bool is_cluster_column
                                                                                                       
     // How many bytes used for short key index encoding.
     // For fixed-length column, this value may be ignored by BE when creating a tablet.
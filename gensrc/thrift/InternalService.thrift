@@ -159,6 +159,8 @@ struct TQueryOptions {
 struct TScanRangeParams {
   1: required PlanNodes.TScanRange scan_range
   2: optional i32 volume_id = -1
+  // The bucket of the tablet scanned, it's set for the scans of the colocate joins.
+  3: optional i32 bucket_sequence
 }
 
 struct TRuntimeFilterProberParams {
@@ -299,6 +301,14 @@ struct TExecPlanFragmentParams {
   50: optional bool is_pipeline
 }
 
+// The instances of a fragment launched on a backend by one rpc. The fragment, the descriptor table and the
+// other fields common to the instances are carried once by common_param, and each one of
+// unique_param_per_instance carries the params and the backend_num of an instance.
+struct TExecBatchPlanFragmentsParams {
+  1: optional TExecPlanFragmentParams common_param
+  2: optional list<TExecPlanFragmentParams> unique_param_per_instance
+}
+
 struct TExecPlanFragmentResult {
   // required in V1
   1: optional Status.TStatus status
@@ -59,6 +59,7 @@ enum TPlanNodeType {
   HDFS_SCAN_NODE,
   PROJECT_NODE,
   TABLE_FUNCTION_NODE,
+  DECODE_NODE,
 }
 
 // phases of an execution node
@@ -325,6 +326,30 @@ struct TMetaScanNode {
   5: optional string user
 }
 
+// The global dictionary of a low cardinality string column, the strings are encoded into ids
+// and the ids are decoded back to the strings by DecodeNode.
+struct TGlobalDict {
+  1: optional i32 column_id
+  2: optional list<string> strings
+  3: optional list<i32> ids
+}
+
+enum TPushdownAggOp {
+  COUNT,
+  MIN,
+  MAX
+}
+
+// An aggregate computed by the scan of each tablet, the scan outputs one row of the partial aggregates, which
+// are merged by the aggregation above it, i.e. COUNT by SUM, MIN by MIN and MAX by MAX.
+struct TPushdownAgg {
+  1: optional TPushdownAggOp op
+  // The column of MIN and MAX, unset for COUNT(*).
+  2: optional string column_name
+  // The output slot of the partial aggregate.
+  3: optional Types.TSlotId slot_id
+}
+
 struct TOlapScanNode {
   1: required Types.TTupleId tuple_id
   2: required list<string> key_column_name
@@ -334,6 +359,11 @@ struct TOlapScanNode {
   // For profile attributes' printing: `Rollup` `Predicates`
   20: optional string rollup_name
   21: optional string sql_predicates
+  // The columns are read as the ids of the global dicts, column_id of TGlobalDict is the slot id.
+  22: optional list<TGlobalDict> global_dicts
+  // If set, the scan outputs the partial aggregates instead of the rows, the segments are answered by their
+  // metadata if possible.
+  23: optional list<TPushdownAgg> pushdown_aggs
 }
 struct TEqJoinCondition {
   // left-hand side of "<a> = <b>"
@@ -370,6 +400,16 @@ enum TJoinOp {
   NULL_AWARE_LEFT_ANTI_JOIN
 }
 
+// How the rows of the two sides of a join are distributed to the fragment instances.
+enum TJoinDistributionMode {
+  NONE,
+  BROADCAST,
+  PARTITIONED,
+  BUCKET_SHUFFLE,
+  // both sides are bucketed by the join keys in the same way, and each instance joins its buckets locally.
+  COLOCATE
+}
+
 struct THashJoinNode {
   1: required TJoinOp join_op
 
@@ -395,6 +435,11 @@ struct THashJoinNode {
   // runtime filters built by this node.
   50: optional list<TRuntimeFilterDescription> build_runtime_filters;
   51: optional bool build_runtime_filters_from_planner;
+
+  // The planner's estimate of the rows of the build side, to pre-size the hash table.
+  52: optional i64 estimated_build_rows
+
+  53: optional TJoinDistributionMode distribution_mode
 }
 
 struct TMergeJoinNode {
@@ -404,6 +449,9 @@ struct TMergeJoinNode {
   // anything from the ON or USING clauses (but *not* the WHERE clause) that's not an
   // equi-join predicate
   2: optional list<Exprs.TExpr> other_join_conjuncts
+
+  // the children are sorted by the join keys in ascending order, INNER_JOIN if not set
+  3: optional TJoinOp join_op
 }
 
 enum TAggregationOp {
@@ -467,6 +515,14 @@ struct TAggregationNode {
   // For profile attributes' printing: `Grouping Keys` `Aggregate Functions`
   22: optional string sql_grouping_keys
   23: optional string sql_aggregate_functions
+
+  // The digest of the plan of this aggregation and its input, set if the partial results of a tablet are
+  // determined by the tablet version, so they can be cached on BE.
+  24: optional string cache_digest
+
+  // The planner's estimates of the number of groups and of the input rows, to pre-size the hash table.
+  25: optional i64 estimated_ndv
+  26: optional i64 estimated_input_rows
 }
 
 struct TRepeatNode {
@@ -781,6 +837,13 @@ struct TRuntimeFilterDescription {
   10: optional Types.TUniqueId sender_finst_id;
 }
 
+struct TDecodeNode {
+    // The slot of the dict ids to the slot of the decoded strings.
+    1: optional map<Types.TSlotId, Types.TSlotId> dict_id_to_string_ids
+    // column_id of TGlobalDict is the slot id of the dict ids.
+    2: optional list<TGlobalDict> global_dicts
+}
+
 struct TTableFunctionNode {
     1: optional Exprs.TExpr table_function
     2: optional list<Types.TSlotId> param_columns
@@ -837,6 +900,7 @@ struct TPlanNode {
   54: optional TTableFunctionNode table_function_node
   // runtime filters be probed by this node.
   55: optional list<TRuntimeFilterDescription> probe_runtime_filters
+  56: optional TDecodeNode decode_node
 }
 
 // A flattened representation of a tree of PlanNodes, obtained by depth-first